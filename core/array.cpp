@@ -32,6 +32,7 @@
 
 #include "core/hashfuncs.h"
 #include "core/object.h"
+#include "core/parallel_sort_array.h"
 #include "core/variant.h"
 #include "core/vector.h"
 
@@ -296,7 +297,9 @@ struct _ArrayVariantSort {
 
 Array &Array::sort() {
 
-	_p->array.sort_custom<_ArrayVariantSort>();
+	// comparing variants has no side effects, unlike sort_custom() which calls into scripts
+	ParallelSortArray<Variant, _ArrayVariantSort> sorter;
+	sorter.sort(_p->array.ptrw(), _p->array.size());
 	return *this;
 }
 
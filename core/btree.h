@@ -0,0 +1,805 @@
+/*************************************************************************/
+/*  btree.h                                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef BTREE_H
+#define BTREE_H
+
+#include "core/error_macros.h"
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <string.h>
+
+/**
+ * B+tree shared by BTreeMap and BTreeSet.
+ *
+ * Elements are stored sorted in leaves of about NODE_BYTES, linked to each other for
+ * iteration, and inner nodes only hold separator keys. Compared to the red-black tree
+ * of Map and Set this means one allocation per leaf instead of per element, and lookups
+ * and iteration walk contiguous memory.
+ *
+ * Elements move when others are inserted or erased next to them, so unlike with Map and
+ * Set, Element pointers are only valid until the container is modified.
+ *
+ * TElement must provide _get_key() and a void *_leaf member, which is kept pointing at
+ * the leaf holding it so next() and prev() can find their neighbours.
+ */
+template <class TElement, class TKey, class C>
+class BTree {
+
+public:
+	struct Leaf {
+		Leaf *prev;
+		Leaf *next;
+		uint32_t count;
+	};
+
+	enum {
+		NODE_BYTES = 512,
+		LEAF_HEADER_SIZE = (sizeof(Leaf) + 15) & ~15, // keep elements aligned like memalloc does
+		LEAF_CAPACITY = (NODE_BYTES / sizeof(TElement)) > 4 ? (NODE_BYTES / sizeof(TElement)) : 4,
+		INNER_CAPACITY = 15,
+		MAX_HEIGHT = 32,
+	};
+
+	struct Inner {
+		uint32_t count; // keys, there is one child more
+		TKey keys[INNER_CAPACITY];
+		void *children[INNER_CAPACITY + 1];
+	};
+
+	static _FORCE_INLINE_ TElement *_elements(Leaf *p_leaf) {
+		return (TElement *)((uint8_t *)p_leaf + LEAF_HEADER_SIZE);
+	}
+
+	static _FORCE_INLINE_ TElement *next_of(const TElement *p_element) {
+
+		Leaf *leaf = (Leaf *)p_element->_leaf;
+		TElement *elements = _elements(leaf);
+		uint32_t index = p_element - elements;
+		if (index + 1 < leaf->count) {
+			return &elements[index + 1];
+		}
+		return leaf->next ? _elements(leaf->next) : NULL; // leaves are never empty
+	}
+
+	static _FORCE_INLINE_ TElement *prev_of(const TElement *p_element) {
+
+		Leaf *leaf = (Leaf *)p_element->_leaf;
+		TElement *elements = _elements(leaf);
+		uint32_t index = p_element - elements;
+		if (index > 0) {
+			return &elements[index - 1];
+		}
+		return leaf->prev ? &_elements(leaf->prev)[leaf->prev->count - 1] : NULL;
+	}
+
+private:
+	void *root;
+	uint32_t height; // inner levels above the leaves
+	Leaf *first;
+	Leaf *last;
+	int size_cache;
+
+	struct Path {
+		Inner *nodes[MAX_HEIGHT];
+		uint32_t indices[MAX_HEIGHT];
+	};
+
+	//elements relocated inside or between leaves are copied and the source destroyed
+	static _FORCE_INLINE_ void _relocate(TElement *p_to, TElement *p_from, Leaf *p_leaf) {
+
+		if (__has_trivial_copy(TElement)) {
+			memcpy((void *)p_to, (const void *)p_from, sizeof(TElement));
+		} else {
+			memnew_placement(p_to, TElement(*p_from));
+			p_from->~TElement();
+		}
+		p_to->_leaf = p_leaf;
+	}
+
+	_FORCE_INLINE_ uint32_t _inner_child(const Inner *p_inner, const TKey &p_key) const {
+
+		//first separator greater than the key, equal keys go right
+		C less;
+		uint32_t low = 0;
+		uint32_t high = p_inner->count;
+		while (low < high) {
+			uint32_t middle = (low + high) / 2;
+			if (less(p_key, p_inner->keys[middle])) {
+				high = middle;
+			} else {
+				low = middle + 1;
+			}
+		}
+		return low;
+	}
+
+	_FORCE_INLINE_ uint32_t _leaf_lower_bound(Leaf *p_leaf, const TKey &p_key) const {
+
+		C less;
+		const TElement *elements = _elements(p_leaf);
+		uint32_t low = 0;
+		uint32_t high = p_leaf->count;
+		while (low < high) {
+			uint32_t middle = (low + high) / 2;
+			if (less(elements[middle]._get_key(), p_key)) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+		return low;
+	}
+
+	_FORCE_INLINE_ Leaf *_find_leaf(const TKey &p_key, Path *r_path = NULL) const {
+
+		void *node = root;
+		for (uint32_t level = 0; level < height; level++) {
+			Inner *inner = (Inner *)node;
+			uint32_t index = _inner_child(inner, p_key);
+			if (r_path) {
+				r_path->nodes[level] = inner;
+				r_path->indices[level] = index;
+			}
+			node = inner->children[index];
+		}
+		return (Leaf *)node;
+	}
+
+	Leaf *_create_leaf() {
+
+		Leaf *leaf = (Leaf *)memalloc(LEAF_HEADER_SIZE + sizeof(TElement) * LEAF_CAPACITY);
+		leaf->prev = NULL;
+		leaf->next = NULL;
+		leaf->count = 0;
+		return leaf;
+	}
+
+	void _insert_separator(Path &p_path, uint32_t p_level, TKey p_key, void *p_child) {
+
+		//p_child goes right of p_key, in the inner node above p_level
+		while (true) {
+
+			if (p_level == 0) {
+				Inner *new_root = memnew(Inner);
+				new_root->count = 1;
+				new_root->keys[0] = p_key;
+				new_root->children[0] = root;
+				new_root->children[1] = p_child;
+				root = new_root;
+				height++;
+				ERR_FAIL_COND(height >= MAX_HEIGHT);
+				return;
+			}
+
+			Inner *parent = p_path.nodes[p_level - 1];
+			uint32_t index = p_path.indices[p_level - 1];
+
+			if (parent->count < INNER_CAPACITY) {
+				for (uint32_t i = parent->count; i > index; i--) {
+					parent->keys[i] = parent->keys[i - 1];
+					parent->children[i + 1] = parent->children[i];
+				}
+				parent->keys[index] = p_key;
+				parent->children[index + 1] = p_child;
+				parent->count++;
+				return;
+			}
+
+			//full, split it and push the middle key up
+			TKey keys[INNER_CAPACITY + 1];
+			void *children[INNER_CAPACITY + 2];
+			for (uint32_t i = 0, j = 0; i <= INNER_CAPACITY; i++) {
+				keys[i] = i == index ? p_key : parent->keys[j++];
+			}
+			for (uint32_t i = 0, j = 0; i <= INNER_CAPACITY + 1; i++) {
+				children[i] = i == index + 1 ? p_child : parent->children[j++];
+			}
+
+			uint32_t middle = (INNER_CAPACITY + 1) / 2;
+			Inner *right = memnew(Inner);
+
+			parent->count = middle;
+			for (uint32_t i = 0; i < middle; i++) {
+				parent->keys[i] = keys[i];
+				parent->children[i] = children[i];
+			}
+			parent->children[middle] = children[middle];
+
+			right->count = INNER_CAPACITY - middle;
+			for (uint32_t i = 0; i < right->count; i++) {
+				right->keys[i] = keys[middle + 1 + i];
+				right->children[i] = children[middle + 1 + i];
+			}
+			right->children[right->count] = children[INNER_CAPACITY + 1];
+
+			p_key = keys[middle];
+			p_child = right;
+			p_level--;
+		}
+	}
+
+	void _remove_leaf(Leaf *p_leaf, Path &p_path) {
+
+		if (p_leaf->prev) {
+			p_leaf->prev->next = p_leaf->next;
+		} else {
+			first = p_leaf->next;
+		}
+		if (p_leaf->next) {
+			p_leaf->next->prev = p_leaf->prev;
+		} else {
+			last = p_leaf->prev;
+		}
+		memfree(p_leaf);
+
+		if (height == 0) {
+			root = NULL;
+			return;
+		}
+
+		//remove the child from its parent, and parents left without children from theirs
+		int level = height - 1;
+		while (level >= 0) {
+
+			Inner *parent = p_path.nodes[level];
+			uint32_t index = p_path.indices[level];
+
+			if (parent->count == 0) {
+				memdelete(parent);
+				if (level == 0) {
+					root = NULL;
+					height = 0;
+					return;
+				}
+				level--;
+				continue;
+			}
+
+			uint32_t key_index = index > 0 ? index - 1 : 0;
+			for (uint32_t i = key_index; i + 1 < parent->count; i++) {
+				parent->keys[i] = parent->keys[i + 1];
+			}
+			for (uint32_t i = index; i < parent->count; i++) {
+				parent->children[i] = parent->children[i + 1];
+			}
+			parent->count--;
+			break;
+		}
+
+		//a root with a single child is not needed
+		while (height > 0 && ((Inner *)root)->count == 0) {
+			Inner *old_root = (Inner *)root;
+			root = old_root->children[0];
+			memdelete(old_root);
+			height--;
+		}
+	}
+
+	void _free_node(void *p_node, uint32_t p_level) {
+
+		if (p_level == height) {
+			Leaf *leaf = (Leaf *)p_node;
+			if (!__has_trivial_destructor(TElement)) {
+				TElement *elements = _elements(leaf);
+				for (uint32_t i = 0; i < leaf->count; i++) {
+					elements[i].~TElement();
+				}
+			}
+			memfree(leaf);
+			return;
+		}
+
+		Inner *inner = (Inner *)p_node;
+		for (uint32_t i = 0; i <= inner->count; i++) {
+			_free_node(inner->children[i], p_level + 1);
+		}
+		memdelete(inner);
+	}
+
+public:
+	_FORCE_INLINE_ TElement *front() const { return first ? _elements(first) : NULL; }
+	_FORCE_INLINE_ TElement *back() const { return last ? &_elements(last)[last->count - 1] : NULL; }
+	_FORCE_INLINE_ int size() const { return size_cache; }
+
+	TElement *find(const TKey &p_key) const {
+
+		if (!root) {
+			return NULL;
+		}
+
+		Leaf *leaf = _find_leaf(p_key);
+		uint32_t pos = _leaf_lower_bound(leaf, p_key);
+		if (pos < leaf->count && !C()(p_key, _elements(leaf)[pos]._get_key())) {
+			return &_elements(leaf)[pos];
+		}
+		return NULL;
+	}
+
+	//first element not less than the key
+	TElement *lower_bound(const TKey &p_key) const {
+
+		if (!root) {
+			return NULL;
+		}
+
+		Leaf *leaf = _find_leaf(p_key);
+		uint32_t pos = _leaf_lower_bound(leaf, p_key);
+		if (pos < leaf->count) {
+			return &_elements(leaf)[pos];
+		}
+		return leaf->next ? _elements(leaf->next) : NULL;
+	}
+
+	//last element not greater than the key
+	TElement *find_closest(const TKey &p_key) const {
+
+		if (!root) {
+			return NULL;
+		}
+
+		Leaf *leaf = _find_leaf(p_key);
+		uint32_t pos = _leaf_lower_bound(leaf, p_key);
+		if (pos < leaf->count && !C()(p_key, _elements(leaf)[pos]._get_key())) {
+			return &_elements(leaf)[pos];
+		}
+		if (pos > 0) {
+			return &_elements(leaf)[pos - 1];
+		}
+		return leaf->prev ? &_elements(leaf->prev)[leaf->prev->count - 1] : NULL;
+	}
+
+	TElement *insert(const TElement &p_element, bool p_replace) {
+
+		const TKey &key = p_element._get_key();
+
+		if (!root) {
+			first = last = _create_leaf();
+			root = first;
+			height = 0;
+		}
+
+		Path path;
+		Leaf *leaf = _find_leaf(key, &path);
+		TElement *elements = _elements(leaf);
+		uint32_t pos = _leaf_lower_bound(leaf, key);
+
+		if (pos < leaf->count && !C()(key, elements[pos]._get_key())) {
+			if (p_replace) {
+				elements[pos] = p_element;
+				elements[pos]._leaf = leaf;
+			}
+			return &elements[pos];
+		}
+
+		if (leaf->count == LEAF_CAPACITY) {
+
+			Leaf *right = _create_leaf();
+			TElement *right_elements = _elements(right);
+			uint32_t half = LEAF_CAPACITY / 2;
+			for (uint32_t i = half; i < LEAF_CAPACITY; i++) {
+				_relocate(&right_elements[i - half], &elements[i], right);
+			}
+			right->count = LEAF_CAPACITY - half;
+			leaf->count = half;
+
+			right->prev = leaf;
+			right->next = leaf->next;
+			if (leaf->next) {
+				leaf->next->prev = right;
+			} else {
+				last = right;
+			}
+			leaf->next = right;
+
+			_insert_separator(path, height, right_elements[0]._get_key(), right);
+
+			if (pos > half) {
+				leaf = right;
+				elements = right_elements;
+				pos -= half;
+			}
+		}
+
+		for (uint32_t i = leaf->count; i > pos; i--) {
+			_relocate(&elements[i], &elements[i - 1], leaf);
+		}
+		memnew_placement(&elements[pos], TElement(p_element));
+		elements[pos]._leaf = leaf;
+		leaf->count++;
+		size_cache++;
+
+		return &elements[pos];
+	}
+
+	bool erase(const TKey &p_key) {
+
+		if (!root) {
+			return false;
+		}
+
+		Path path;
+		Leaf *leaf = _find_leaf(p_key, &path);
+		TElement *elements = _elements(leaf);
+		uint32_t pos = _leaf_lower_bound(leaf, p_key);
+
+		if (pos >= leaf->count || C()(p_key, elements[pos]._get_key())) {
+			return false;
+		}
+
+		//p_key may belong to the element, don't use it from here on
+		elements[pos].~TElement();
+		for (uint32_t i = pos + 1; i < leaf->count; i++) {
+			_relocate(&elements[i - 1], &elements[i], leaf);
+		}
+		leaf->count--;
+		size_cache--;
+
+		if (leaf->count == 0) {
+			_remove_leaf(leaf, path);
+			return true;
+		}
+
+		//separators stay valid when the first element goes, but nearly empty leaves are merged with the next sibling
+		if (height > 0 && leaf->count < LEAF_CAPACITY / 4) {
+			Inner *parent = path.nodes[height - 1];
+			uint32_t index = path.indices[height - 1];
+			if (index < parent->count) {
+				Leaf *right = (Leaf *)parent->children[index + 1];
+				if (leaf->count + right->count <= LEAF_CAPACITY * 3 / 4) {
+					TElement *right_elements = _elements(right);
+					for (uint32_t i = 0; i < right->count; i++) {
+						_relocate(&elements[leaf->count + i], &right_elements[i], leaf);
+					}
+					leaf->count += right->count;
+					right->count = 0;
+					path.indices[height - 1] = index + 1;
+					_remove_leaf(right, path);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void clear() {
+
+		if (root) {
+			_free_node(root, 0);
+		}
+		root = NULL;
+		height = 0;
+		first = NULL;
+		last = NULL;
+		size_cache = 0;
+	}
+
+	BTree() {
+
+		root = NULL;
+		height = 0;
+		first = NULL;
+		last = NULL;
+		size_cache = 0;
+	}
+
+	~BTree() {
+
+		clear();
+	}
+};
+
+template <class K, class V, class C = Comparator<K> >
+class BTreeMap {
+
+public:
+	class Element {
+
+	private:
+		friend class BTreeMap<K, V, C>;
+		friend class BTree<Element, K, C>;
+
+		void *_leaf;
+		K _key;
+		V _value;
+
+		_FORCE_INLINE_ const K &_get_key() const { return _key; }
+
+		Element(const K &p_key, const V &p_value) :
+				_leaf(NULL),
+				_key(p_key),
+				_value(p_value) {
+		}
+
+	public:
+		const Element *next() const {
+
+			return BTree<Element, K, C>::next_of(this);
+		}
+		Element *next() {
+
+			return BTree<Element, K, C>::next_of(this);
+		}
+		const Element *prev() const {
+
+			return BTree<Element, K, C>::prev_of(this);
+		}
+		Element *prev() {
+
+			return BTree<Element, K, C>::prev_of(this);
+		}
+		const K &key() const {
+			return _key;
+		};
+		V &value() {
+			return _value;
+		};
+		const V &value() const {
+			return _value;
+		};
+		V &get() {
+			return _value;
+		};
+		const V &get() const {
+			return _value;
+		};
+	};
+
+private:
+	BTree<Element, K, C> tree;
+
+	void _copy_from(const BTreeMap &p_map) {
+
+		clear();
+		for (const Element *E = p_map.front(); E; E = E->next()) {
+			tree.insert(*E, false);
+		}
+	}
+
+public:
+	const Element *find(const K &p_key) const {
+
+		return tree.find(p_key);
+	}
+
+	Element *find(const K &p_key) {
+
+		return tree.find(p_key);
+	}
+
+	const Element *find_closest(const K &p_key) const {
+
+		return tree.find_closest(p_key);
+	}
+
+	Element *find_closest(const K &p_key) {
+
+		return tree.find_closest(p_key);
+	}
+
+	bool has(const K &p_key) const {
+
+		return tree.find(p_key) != NULL;
+	}
+
+	Element *insert(const K &p_key, const V &p_value) {
+
+		return tree.insert(Element(p_key, p_value), true);
+	}
+
+	void erase(Element *p_element) {
+
+		if (!p_element)
+			return;
+
+		tree.erase(p_element->_key);
+	}
+
+	bool erase(const K &p_key) {
+
+		return tree.erase(p_key);
+	}
+
+	const V &operator[](const K &p_key) const {
+
+		const Element *e = find(p_key);
+		CRASH_COND(!e);
+		return e->_value;
+	}
+
+	V &operator[](const K &p_key) {
+
+		Element *e = find(p_key);
+		if (!e)
+			e = tree.insert(Element(p_key, V()), false);
+
+		return e->_value;
+	}
+
+	Element *front() const {
+
+		return tree.front();
+	}
+
+	Element *back() const {
+
+		return tree.back();
+	}
+
+	inline bool empty() const { return tree.size() == 0; }
+	inline int size() const { return tree.size(); }
+
+	void clear() {
+
+		tree.clear();
+	}
+
+	void operator=(const BTreeMap &p_map) {
+
+		if (this != &p_map)
+			_copy_from(p_map);
+	}
+
+	BTreeMap(const BTreeMap &p_map) {
+
+		_copy_from(p_map);
+	}
+
+	_FORCE_INLINE_ BTreeMap() {
+	}
+};
+
+template <class T, class C = Comparator<T> >
+class BTreeSet {
+
+public:
+	class Element {
+
+	private:
+		friend class BTreeSet<T, C>;
+		friend class BTree<Element, T, C>;
+
+		void *_leaf;
+		T value;
+
+		_FORCE_INLINE_ const T &_get_key() const { return value; }
+
+		Element(const T &p_value) :
+				_leaf(NULL),
+				value(p_value) {
+		}
+
+	public:
+		const Element *next() const {
+
+			return BTree<Element, T, C>::next_of(this);
+		}
+		Element *next() {
+
+			return BTree<Element, T, C>::next_of(this);
+		}
+		const Element *prev() const {
+
+			return BTree<Element, T, C>::prev_of(this);
+		}
+		Element *prev() {
+
+			return BTree<Element, T, C>::prev_of(this);
+		}
+		const T &get() const {
+			return value;
+		};
+	};
+
+private:
+	BTree<Element, T, C> tree;
+
+	void _copy_from(const BTreeSet &p_set) {
+
+		clear();
+		for (const Element *E = p_set.front(); E; E = E->next()) {
+			tree.insert(*E, false);
+		}
+	}
+
+public:
+	const Element *find(const T &p_value) const {
+
+		return tree.find(p_value);
+	}
+
+	Element *find(const T &p_value) {
+
+		return tree.find(p_value);
+	}
+
+	Element *lower_bound(const T &p_value) const {
+
+		return tree.lower_bound(p_value);
+	}
+
+	_FORCE_INLINE_ bool has(const T &p_value) const {
+
+		return tree.find(p_value) != NULL;
+	}
+
+	Element *insert(const T &p_value) {
+
+		return tree.insert(Element(p_value), false);
+	}
+
+	void erase(Element *p_element) {
+
+		if (!p_element)
+			return;
+
+		tree.erase(p_element->value);
+	}
+
+	bool erase(const T &p_value) {
+
+		return tree.erase(p_value);
+	}
+
+	Element *front() const {
+
+		return tree.front();
+	}
+
+	Element *back() const {
+
+		return tree.back();
+	}
+
+	inline bool empty() const { return tree.size() == 0; }
+	inline int size() const { return tree.size(); }
+
+	void clear() {
+
+		tree.clear();
+	}
+
+	void operator=(const BTreeSet &p_set) {
+
+		if (this != &p_set)
+			_copy_from(p_set);
+	}
+
+	BTreeSet(const BTreeSet &p_set) {
+
+		_copy_from(p_set);
+	}
+
+	_FORCE_INLINE_ BTreeSet() {
+	}
+};
+
+#endif // BTREE_H
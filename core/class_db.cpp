@@ -270,6 +270,93 @@ ClassDB::ClassInfo::ClassInfo() {
 ClassDB::ClassInfo::~ClassInfo() {
 }
 
+SafeNumeric<uint32_t> ClassDB::flat_version;
+Mutex *ClassDB::flat_mutex = NULL;
+Vector<ClassDB::FlatTables *> ClassDB::retired_flat_tables;
+
+const ClassDB::FlatTables *ClassDB::_build_flat_tables(ClassInfo *p_class) {
+
+	MutexLock flat_lock(flat_mutex);
+
+	uint32_t version = flat_version.get();
+	FlatTables *old = p_class->flat_tables.ptr.get();
+	if (old && old->version == version) {
+		return old; //another thread built them meanwhile
+	}
+
+	FlatTables *tables = memnew(FlatTables);
+	tables->version = version;
+	tables->class_key = p_class->name.data_unique_pointer();
+
+	//walk from the class to the root, the closest declaration wins
+	for (ClassInfo *check = p_class; check; check = check->inherits_ptr) {
+
+		const StringName *K = NULL;
+		while ((K = check->method_map.next(K))) {
+
+			MethodBind *method = check->method_map.get(*K);
+			if (method && !tables->methods.has(*K)) {
+				FlatMethod fm;
+				fm.method = method;
+				fm.tables = tables;
+				tables->methods.set(*K, fm);
+			}
+		}
+
+		K = NULL;
+		while ((K = check->property_setget.next(K))) {
+
+			FlatProperty *fp = tables->properties.getptr(*K);
+			if (!fp) {
+				FlatProperty np;
+				np.setget = check->property_setget.getptr(*K);
+				np.constant = NULL;
+				np.constant_first = false;
+				np.tables = tables;
+				tables->properties.set(*K, np);
+			} else if (!fp->setget) {
+				fp->setget = check->property_setget.getptr(*K); //a constant shadows it in a derived class
+			}
+		}
+
+		K = NULL;
+		while ((K = check->constant_map.next(K))) {
+
+			FlatProperty *fp = tables->properties.getptr(*K);
+			if (!fp) {
+				FlatProperty np;
+				np.setget = NULL;
+				np.constant = check->constant_map.getptr(*K);
+				np.constant_first = true;
+				np.tables = tables;
+				tables->properties.set(*K, np);
+			} else if (!fp->constant) {
+				fp->constant = check->constant_map.getptr(*K);
+			}
+		}
+	}
+
+	p_class->flat_tables.ptr.set(tables);
+	if (old) {
+		retired_flat_tables.push_back(old); //may still be in use by readers or call caches
+	}
+
+	return tables;
+}
+
+MethodBind *ClassDB::_find_method(ClassInfo *p_class, const StringName &p_name) {
+
+	ClassInfo *check = p_class;
+	while (check) {
+
+		MethodBind **method = check->method_map.getptr(p_name);
+		if (method && *method)
+			return *method;
+		check = check->inherits_ptr;
+	}
+	return NULL;
+}
+
 bool ClassDB::is_parent_class(const StringName &p_class, const StringName &p_inherits) {
 
 	OBJTYPE_RLOCK;
@@ -547,6 +634,25 @@ Object *ClassDB::instance(const StringName &p_class) {
 #endif
 	return ti->creation_func();
 }
+ClassDB::InstanceFunc ClassDB::get_instance_func(const StringName &p_class) {
+
+	OBJTYPE_RLOCK;
+
+	ClassInfo *ti = classes.getptr(p_class);
+	if (!ti || ti->disabled || !ti->creation_func) {
+		if (compat_classes.has(p_class)) {
+			ti = classes.getptr(compat_classes[p_class]);
+		}
+	}
+	if (!ti || ti->disabled)
+		return NULL;
+#ifdef TOOLS_ENABLED
+	if (ti->api == API_EDITOR && !Engine::get_singleton()->is_editor_hint())
+		return NULL;
+#endif
+	return ti->creation_func;
+}
+
 bool ClassDB::can_instance(const StringName &p_class) {
 
 	OBJTYPE_RLOCK;
@@ -583,6 +689,8 @@ void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherit
 	} else {
 		ti.inherits_ptr = NULL;
 	}
+
+	_invalidate_flat_tables();
 }
 
 void ClassDB::get_method_list(StringName p_class, List<MethodInfo> *p_methods, bool p_no_inheritance, bool p_exclude_from_properties) {
@@ -663,15 +771,32 @@ MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
 	OBJTYPE_RLOCK;
 
 	ClassInfo *type = classes.getptr(p_class);
+	if (!type)
+		return NULL;
 
-	while (type) {
+	const FlatMethod *method = _get_flat_tables(type)->methods.getptr(p_name);
+	return method ? method->method : NULL;
+}
 
-		MethodBind **method = type->method_map.getptr(p_name);
-		if (method && *method)
-			return *method;
-		type = type->inherits_ptr;
+MethodBind *ClassDB::get_method_cached(MethodCallCache &r_cache, const StringName &p_class, const StringName &p_name) {
+
+	const FlatMethod *entry = (const FlatMethod *)r_cache.entry.get();
+	if (likely(entry && entry->tables->class_key == p_class.data_unique_pointer() && entry->tables->version == flat_version.get())) {
+		return entry->method;
 	}
-	return NULL;
+
+	OBJTYPE_RLOCK;
+
+	ClassInfo *type = classes.getptr(p_class);
+	if (!type)
+		return NULL;
+
+	entry = _get_flat_tables(type)->methods.getptr(p_name);
+	if (!entry)
+		return NULL;
+
+	r_cache.entry.set(entry);
+	return entry->method;
 }
 
 void ClassDB::bind_integer_constant(const StringName &p_class, const StringName &p_enum, const StringName &p_name, int p_constant) {
@@ -688,6 +813,7 @@ void ClassDB::bind_integer_constant(const StringName &p_class, const StringName
 	}
 
 	type->constant_map[p_name] = p_constant;
+	_invalidate_flat_tables();
 
 	String enum_name = p_enum;
 	if (enum_name != String()) {
@@ -924,9 +1050,12 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 
 	ERR_FAIL_COND(!type);
 
+	//registration invalidates the flat tables, so look up without building them
 	MethodBind *mb_set = NULL;
 	if (p_setter) {
-		mb_set = get_method(p_class, p_setter);
+		lock->read_lock();
+		mb_set = _find_method(type, p_setter);
+		lock->read_unlock();
 #ifdef DEBUG_METHODS_ENABLED
 
 		ERR_FAIL_COND_MSG(!mb_set, "Invalid setter '" + p_class + "::" + p_setter + "' for property '" + p_pinfo.name + "'.");
@@ -939,7 +1068,9 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 	MethodBind *mb_get = NULL;
 	if (p_getter) {
 
-		mb_get = get_method(p_class, p_getter);
+		lock->read_lock();
+		mb_get = _find_method(type, p_getter);
+		lock->read_unlock();
 #ifdef DEBUG_METHODS_ENABLED
 
 		ERR_FAIL_COND_MSG(!mb_get, "Invalid getter '" + p_class + "::" + p_getter + "' for property '" + p_pinfo.name + "'.");
@@ -973,6 +1104,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 	psg.type = p_pinfo.type;
 
 	type->property_setget[p_pinfo.name] = psg;
+	_invalidate_flat_tables();
 }
 
 void ClassDB::set_property_default_value(StringName p_class, const StringName &p_name, const Variant &p_default) {
@@ -1006,109 +1138,146 @@ void ClassDB::get_property_list(StringName p_class, List<PropertyInfo> *p_list,
 		check = check->inherits_ptr;
 	}
 }
-bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
+bool ClassDB::_set_flat_property(const FlatProperty *p_property, Object *p_object, const Variant &p_value, bool *r_valid) {
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
+	const PropertySetGet *psg = p_property ? p_property->setget : NULL;
+	if (!psg)
+		return false;
 
-			if (!psg->setter) {
-				if (r_valid)
-					*r_valid = false;
-				return true; //return true but do nothing
-			}
+	if (!psg->setter) {
+		if (r_valid)
+			*r_valid = false;
+		return true; //return true but do nothing
+	}
+
+	Variant::CallError ce;
+
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->call(psg->setter, arg, 2, ce);
+		}
+
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->call(psg->setter, arg, 1, ce);
+		}
+	}
+
+	if (r_valid)
+		*r_valid = ce.error == Variant::CallError::CALL_OK;
+
+	return true;
+}
+
+bool ClassDB::_get_flat_property(const FlatProperty *p_property, Object *p_object, Variant &r_value) {
+
+	if (!p_property)
+		return false;
 
+	const PropertySetGet *psg = p_property->constant_first ? NULL : p_property->setget;
+	if (psg) {
+		if (!psg->getter)
+			return true; //return true but do nothing
+
+		if (psg->index >= 0) {
+			Variant index = psg->index;
+			const Variant *arg[1] = { &index };
 			Variant::CallError ce;
+			r_value = p_object->call(psg->getter, arg, 1, ce);
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->call(psg->setter, arg, 2, ce);
-				}
+		} else {
+
+			Variant::CallError ce;
+			if (psg->_getptr) {
 
+				r_value = psg->_getptr->call(p_object, NULL, 0, ce);
 			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->call(psg->setter, arg, 1, ce);
-				}
+				r_value = p_object->call(psg->getter, NULL, 0, ce);
 			}
-
-			if (r_valid)
-				*r_valid = ce.error == Variant::CallError::CALL_OK;
-
-			return true;
 		}
+		return true;
+	}
 
-		check = check->inherits_ptr;
+	if (p_property->constant) {
+
+		r_value = *p_property->constant;
+		return true;
 	}
 
 	return false;
 }
-bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->getter)
-				return true; //return true but do nothing
+const ClassDB::FlatProperty *ClassDB::_get_flat_property_cached(MethodCallCache &r_cache, const StringName &p_class, const StringName &p_property) {
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[1] = { &index };
-				Variant::CallError ce;
-				r_value = p_object->call(psg->getter, arg, 1, ce);
+	const FlatProperty *entry = (const FlatProperty *)r_cache.entry.get();
+	if (likely(entry && entry->tables->class_key == p_class.data_unique_pointer() && entry->tables->version == flat_version.get())) {
+		return entry;
+	}
 
-			} else {
+	OBJTYPE_RLOCK;
 
-				Variant::CallError ce;
-				if (psg->_getptr) {
+	ClassInfo *type = classes.getptr(p_class);
+	if (!type)
+		return NULL;
 
-					r_value = psg->_getptr->call(p_object, NULL, 0, ce);
-				} else {
-					r_value = p_object->call(psg->getter, NULL, 0, ce);
-				}
-			}
-			return true;
-		}
+	entry = _get_flat_tables(type)->properties.getptr(p_property);
+	if (!entry)
+		return NULL;
 
-		const int *c = check->constant_map.getptr(p_property);
-		if (c) {
+	r_cache.entry.set(entry);
+	return entry;
+}
 
-			r_value = *c;
-			return true;
-		}
+bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
 
-		check = check->inherits_ptr;
+	ClassInfo *type = classes.getptr(p_object->get_class_name());
+	if (type) {
+		return _set_flat_property(_get_flat_tables(type)->properties.getptr(p_property), p_object, p_value, r_valid);
 	}
 
 	return false;
 }
 
+bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
+
+	ClassInfo *type = classes.getptr(p_object->get_class_name());
+	if (type) {
+		return _get_flat_property(_get_flat_tables(type)->properties.getptr(p_property), p_object, r_value);
+	}
+
+	return false;
+}
+
+bool ClassDB::set_property_cached(MethodCallCache &r_cache, Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
+
+	return _set_flat_property(_get_flat_property_cached(r_cache, p_object->get_class_name(), p_property), p_object, p_value, r_valid);
+}
+
+bool ClassDB::get_property_cached(MethodCallCache &r_cache, Object *p_object, const StringName &p_property, Variant &r_value) {
+
+	return _get_flat_property(_get_flat_property_cached(r_cache, p_object->get_class_name(), p_property), p_object, r_value);
+}
+
 int ClassDB::get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
 
 	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
+	if (type) {
+		const FlatProperty *fp = _get_flat_tables(type)->properties.getptr(p_property);
+		if (fp && fp->setget) {
 
 			if (r_is_valid)
 				*r_is_valid = true;
 
-			return psg->index;
+			return fp->setget->index;
 		}
-
-		check = check->inherits_ptr;
 	}
 	if (r_is_valid)
 		*r_is_valid = false;
@@ -1119,18 +1288,15 @@ int ClassDB::get_property_index(const StringName &p_class, const StringName &p_p
 Variant::Type ClassDB::get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
 
 	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
+	if (type) {
+		const FlatProperty *fp = _get_flat_tables(type)->properties.getptr(p_property);
+		if (fp && fp->setget) {
 
 			if (r_is_valid)
 				*r_is_valid = true;
 
-			return psg->type;
+			return fp->setget->type;
 		}
-
-		check = check->inherits_ptr;
 	}
 	if (r_is_valid)
 		*r_is_valid = false;
@@ -1201,6 +1367,10 @@ void ClassDB::set_method_flags(StringName p_class, StringName p_method, int p_fl
 bool ClassDB::has_method(StringName p_class, StringName p_method, bool p_no_inheritance) {
 
 	ClassInfo *type = classes.getptr(p_class);
+	if (type && !p_no_inheritance) {
+		return _get_flat_tables(type)->methods.has(p_method);
+	}
+
 	ClassInfo *check = type;
 	while (check) {
 		if (check->method_map.has(p_method))
@@ -1229,7 +1399,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const c
 
 #ifdef DEBUG_ENABLED
 
-	ERR_FAIL_COND_V_MSG(has_method(instance_type, mdname), NULL, "Class " + String(instance_type) + " already has a method " + String(mdname) + ".");
+	ERR_FAIL_COND_V_MSG(_find_method(classes.getptr(instance_type), mdname), NULL, "Class " + String(instance_type) + " already has a method " + String(mdname) + ".");
 #endif
 
 	ClassInfo *type = classes.getptr(instance_type);
@@ -1257,6 +1427,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const c
 #endif
 
 	type->method_map[mdname] = p_bind;
+	_invalidate_flat_tables();
 
 	Vector<Variant> defvals;
 
@@ -1441,6 +1612,7 @@ RWLock *ClassDB::lock = NULL;
 void ClassDB::init() {
 
 	lock = RWLock::create();
+	flat_mutex = Mutex::create();
 }
 
 void ClassDB::cleanup_defaults() {
@@ -1464,12 +1636,23 @@ void ClassDB::cleanup() {
 
 			memdelete(ti.method_map[*m]);
 		}
+
+		FlatTables *tables = ti.flat_tables.ptr.get();
+		if (tables) {
+			memdelete(tables);
+		}
 	}
 	classes.clear();
+
+	for (int i = 0; i < retired_flat_tables.size(); i++) {
+		memdelete(retired_flat_tables[i]);
+	}
+	retired_flat_tables.clear();
 	resource_base_extensions.clear();
 	compat_classes.clear();
 
 	memdelete(lock);
+	memdelete(flat_mutex);
 }
 
 //
@@ -33,6 +33,7 @@
 
 #include "core/method_bind.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
 #include "core/print_string.h"
 
 /**	To bind more then 6 parameters include this:
@@ -110,12 +111,52 @@ public:
 		Variant::Type type;
 	};
 
+	struct FlatTables;
+
+	struct FlatMethod {
+
+		MethodBind *method;
+		const FlatTables *tables;
+	};
+
+	struct FlatProperty {
+
+		const PropertySetGet *setget; //closest in the inheritance chain
+		const int *constant; //closest constant with the same name
+		bool constant_first; //the constant is declared closer than the property
+		const FlatTables *tables;
+	};
+
+	// every method and property of a class including the inherited ones, so a single
+	// lookup resolves them. built on demand and never modified once published, a
+	// registration change makes all of them stale and they are rebuilt on next use
+	struct FlatTables {
+
+		uint32_t version;
+		const void *class_key;
+		FlatHashMap<StringName, FlatMethod> methods;
+		FlatHashMap<StringName, FlatProperty> properties;
+	};
+
+	// classes are copied into the map on registration, the tables are never carried over
+	struct FlatTablesRef {
+
+		SafePointer<FlatTables> ptr;
+
+		FlatTablesRef() :
+				ptr(NULL) {}
+		FlatTablesRef(const FlatTablesRef &) :
+				ptr(NULL) {}
+		FlatTablesRef &operator=(const FlatTablesRef &) { return *this; }
+	};
+
 	struct ClassInfo {
 
 		APIType api;
 		ClassInfo *inherits_ptr;
+		FlatTablesRef flat_tables;
 		void *class_ptr;
-		HashMap<StringName, MethodBind *> method_map;
+		FlatHashMap<StringName, MethodBind *> method_map;
 		HashMap<StringName, int> constant_map;
 		HashMap<StringName, List<StringName> > enum_map;
 		HashMap<StringName, MethodInfo> signal_map;
@@ -138,6 +179,24 @@ public:
 		~ClassInfo();
 	};
 
+	static SafeNumeric<uint32_t> flat_version;
+	static Mutex *flat_mutex;
+	static Vector<FlatTables *> retired_flat_tables;
+
+	_FORCE_INLINE_ static void _invalidate_flat_tables() { flat_version.increment(); }
+	static const FlatTables *_build_flat_tables(ClassInfo *p_class);
+	static MethodBind *_find_method(ClassInfo *p_class, const StringName &p_name);
+	static bool _set_flat_property(const FlatProperty *p_property, Object *p_object, const Variant &p_value, bool *r_valid);
+	static bool _get_flat_property(const FlatProperty *p_property, Object *p_object, Variant &r_value);
+	static const FlatProperty *_get_flat_property_cached(MethodCallCache &r_cache, const StringName &p_class, const StringName &p_property);
+	_FORCE_INLINE_ static const FlatTables *_get_flat_tables(ClassInfo *p_class) {
+		const FlatTables *tables = p_class->flat_tables.ptr.get();
+		if (likely(tables && tables->version == flat_version.get())) {
+			return tables;
+		}
+		return _build_flat_tables(p_class);
+	}
+
 	template <class T>
 	static Object *creator() {
 		return memnew(T);
@@ -222,6 +281,9 @@ public:
 	static bool is_parent_class(const StringName &p_class, const StringName &p_inherits);
 	static bool can_instance(const StringName &p_class);
 	static Object *instance(const StringName &p_class);
+	typedef Object *(*InstanceFunc)();
+	// the constructor instance() would call for p_class, NULL if it can't be instanced
+	static InstanceFunc get_instance_func(const StringName &p_class);
 	static APIType get_api_type(const StringName &p_class);
 
 	static uint64_t get_api_hash(APIType p_api);
@@ -331,6 +393,7 @@ public:
 			ERR_FAIL_V_MSG(NULL, "Method already bound: " + instance_type + "::" + p_name + ".");
 		}
 		type->method_map[p_name] = bind;
+		_invalidate_flat_tables();
 #ifdef DEBUG_METHODS_ENABLED
 		// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 		//bind->set_return_type("Variant");
@@ -351,6 +414,9 @@ public:
 	static void get_property_list(StringName p_class, List<PropertyInfo> *p_list, bool p_no_inheritance = false, const Object *p_validator = NULL);
 	static bool set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid = NULL);
 	static bool get_property(Object *p_object, const StringName &p_property, Variant &r_value);
+	// same as above, resolving the property through r_cache while the class and registrations are unchanged
+	static bool set_property_cached(MethodCallCache &r_cache, Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid = NULL);
+	static bool get_property_cached(MethodCallCache &r_cache, Object *p_object, const StringName &p_property, Variant &r_value);
 	static bool has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance = false);
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = NULL);
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = NULL);
@@ -362,6 +428,8 @@ public:
 
 	static void get_method_list(StringName p_class, List<MethodInfo> *p_methods, bool p_no_inheritance = false, bool p_exclude_from_properties = false);
 	static MethodBind *get_method(StringName p_class, StringName p_name);
+	// resolves through r_cache while the class and registrations are unchanged
+	static MethodBind *get_method_cached(MethodCallCache &r_cache, const StringName &p_class, const StringName &p_name);
 
 	static void add_virtual_method(const StringName &p_class, const MethodInfo &p_method, bool p_virtual = true);
 	static void get_virtual_methods(const StringName &p_class, List<MethodInfo> *p_methods, bool p_no_inheritance = false);
@@ -101,12 +101,124 @@ tryagain:
 	return true;
 }
 
+void CommandQueueMT::_next_record_block(uint32_t p_min_size) {
+
+	if (record_block && record_block->used) {
+		submit();
+	}
+
+	if (record_block && record_block->size >= p_min_size) {
+		return; //empty and large enough
+	}
+
+	if (record_block) {
+		memfree(record_block);
+		record_block = NULL;
+	}
+
+	while (!record_block) {
+
+		if (!record_free) {
+			record_free = record_returned.exchange(NULL);
+		}
+
+		if (!record_free) {
+			uint32_t size = MAX((uint32_t)RECORD_BLOCK_SIZE, p_min_size);
+			record_block = (RecordBlock *)memalloc(_block_header_size() + size);
+			record_block->size = size;
+			break;
+		}
+
+		RecordBlock *block = record_free;
+		record_free = block->next;
+		if (block->size >= p_min_size) {
+			record_block = block;
+		} else {
+			memfree(block);
+		}
+	}
+
+	record_block->used = 0;
+	record_block->next = NULL;
+}
+
+void CommandQueueMT::_run_block(RecordBlock *p_block) {
+
+	uint8_t *data = _block_data(p_block);
+	uint32_t pos = 0;
+
+	while (pos < p_block->used) {
+
+		uint32_t size = *(uint32_t *)&data[pos];
+		CommandBase *cmd = reinterpret_cast<CommandBase *>(&data[pos + 8]);
+		cmd->call();
+		cmd->~CommandBase();
+		pos += size + 8;
+	}
+
+	// hand the block back to the recording thread
+	do {
+		p_block->next = record_returned.get();
+	} while (!record_returned.compare_exchange(p_block->next, p_block));
+}
+
+void CommandQueueMT::set_recording_thread(bool p_enable, Thread::ID p_thread) {
+
+	if (recording && !p_enable) {
+		submit();
+	}
+
+	recording = p_enable;
+	recording_thread = p_thread;
+}
+
+void CommandQueueMT::submit() {
+
+	if (!record_block || !record_block->used) {
+		return;
+	}
+
+	CommandBatch *cmd = allocate_and_lock<CommandBatch>();
+	cmd->queue = this;
+	cmd->block = record_block;
+	unlock();
+
+	record_block = NULL;
+
+	if (sync)
+		sync->post();
+}
+
+void CommandQueueMT::end_frame() {
+
+	lock();
+	frame_commands = record_commands + locked_commands;
+	frame_bytes = record_bytes + locked_bytes;
+	locked_commands = 0;
+	locked_bytes = 0;
+	record_commands = 0;
+	record_bytes = 0;
+	unlock();
+}
+
 CommandQueueMT::CommandQueueMT(bool p_sync) {
 
 	read_ptr = 0;
 	write_ptr = 0;
 	dealloc_ptr = 0;
 	mutex = Mutex::create();
+
+	recording = false;
+	recording_thread = 0;
+	record_block = NULL;
+	record_free = NULL;
+	record_returned.set(NULL);
+	record_commands = 0;
+	record_bytes = 0;
+	locked_commands = 0;
+	locked_bytes = 0;
+	frame_commands = 0;
+	frame_bytes = 0;
 	command_mem = (uint8_t *)memalloc(COMMAND_MEM_SIZE);
 
 	for (int i = 0; i < SYNC_SEMAPHORES; i++) {
@@ -130,4 +242,16 @@ CommandQueueMT::~CommandQueueMT() {
 		memdelete(sync_sems[i].sem);
 	}
 	memfree(command_mem);
+
+	if (record_block) {
+		memfree(record_block);
+	}
+	RecordBlock *lists[2] = { record_free, record_returned.get() };
+	for (int i = 0; i < 2; i++) {
+		while (lists[i]) {
+			RecordBlock *next = lists[i]->next;
+			memfree(lists[i]);
+			lists[i] = next;
+		}
+	}
 }
@@ -34,6 +34,8 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
 #include "core/simple_type.h"
 #include "core/typedefs.h"
 
@@ -228,12 +230,20 @@
 #define DECL_PUSH(N)                                                         \
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>       \
 	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
-		CMD_TYPE(N) *cmd = allocate_and_lock<CMD_TYPE(N)>();                 \
+		bool recorded = is_recording();                                      \
+		CMD_TYPE(N) *cmd;                                                    \
+		if (recorded) {                                                      \
+			cmd = record<CMD_TYPE(N)>();                                     \
+		} else {                                                             \
+			cmd = allocate_and_lock<CMD_TYPE(N)>();                          \
+		}                                                                    \
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
-		if (sync) sync->post();                                              \
+		if (!recorded) {                                                     \
+			unlock();                                                        \
+			if (sync) sync->post();                                          \
+		}                                                                    \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -241,6 +251,7 @@
 #define DECL_PUSH_AND_RET(N)                                                                   \
 	template <class T, class M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) class R>                \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
+		if (is_recording()) submit();                                                          \
 		SyncSemaphore *ss = _alloc_sync_sem();                                                 \
 		CMD_RET_TYPE(N) *cmd = allocate_and_lock<CMD_RET_TYPE(N)>();                           \
 		cmd->instance = p_instance;                                                            \
@@ -259,6 +270,7 @@
 #define DECL_PUSH_AND_SYNC(N)                                                         \
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>                \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
+		if (is_recording()) submit();                                                 \
 		SyncSemaphore *ss = _alloc_sync_sem();                                        \
 		CMD_SYNC_TYPE(N) *cmd = allocate_and_lock<CMD_SYNC_TYPE(N)>();                \
 		cmd->instance = p_instance;                                                   \
@@ -308,11 +320,31 @@ class CommandQueueMT {
 	DECL_CMD_SYNC(0)
 	SPACE_SEP_LIST(DECL_CMD_SYNC, 13)
 
+	/* recorded commands, submitted as one */
+
+	struct RecordBlock {
+
+		RecordBlock *next;
+		uint32_t used;
+		uint32_t size;
+	};
+
+	struct CommandBatch : public CommandBase {
+
+		CommandQueueMT *queue;
+		RecordBlock *block;
+
+		virtual void call() {
+			queue->_run_block(block);
+		}
+	};
+
 	/***** BASE *******/
 
 	enum {
 		COMMAND_MEM_SIZE_KB = 256,
 		COMMAND_MEM_SIZE = COMMAND_MEM_SIZE_KB * 1024,
+		RECORD_BLOCK_SIZE = 64 * 1024,
 		SYNC_SEMAPHORES = 8
 	};
 
@@ -324,6 +356,44 @@ class CommandQueueMT {
 	Mutex *mutex;
 	Semaphore *sync;
 
+	// one thread may record its commands without locking, they are queued as a single
+	// batch on submit(), before any command of that thread that has to wait for the server
+	bool recording;
+	Thread::ID recording_thread;
+	RecordBlock *record_block;
+	RecordBlock *record_free; //only touched by the recording thread
+	SafePointer<RecordBlock> record_returned; //blocks handed back by the server thread
+
+	uint32_t record_commands;
+	uint32_t record_bytes;
+	uint32_t locked_commands; //guarded by mutex
+	uint32_t locked_bytes;
+	uint32_t frame_commands;
+	uint32_t frame_bytes;
+
+	_FORCE_INLINE_ static uint32_t _block_header_size() { return (sizeof(RecordBlock) + 7) & ~7; }
+	_FORCE_INLINE_ static uint8_t *_block_data(RecordBlock *p_block) { return ((uint8_t *)p_block) + _block_header_size(); }
+
+	void _next_record_block(uint32_t p_min_size);
+	void _run_block(RecordBlock *p_block);
+
+	template <class T>
+	T *record() {
+
+		// same layout as the ring buffer, size header then the command
+		uint32_t size = (sizeof(T) + 8 - 1) & ~(8 - 1);
+		if (!record_block || record_block->used + size + 8 > record_block->size) {
+			_next_record_block(size + 8);
+		}
+
+		uint8_t *ptr = _block_data(record_block) + record_block->used;
+		*(uint32_t *)ptr = size;
+		record_block->used += size + 8;
+		record_commands++;
+		record_bytes += size + 8;
+		return memnew_placement(ptr + 8, T);
+	}
+
 	template <class T>
 	T *allocate() {
 
@@ -374,6 +444,8 @@ class CommandQueueMT {
 		uint32_t *p = (uint32_t *)&command_mem[write_ptr];
 		*p = (size << 1) | 1;
 		write_ptr += 8;
+		locked_commands++;
+		locked_bytes += size + 8;
 		// allocate the command
 		T *cmd = memnew_placement(&command_mem[write_ptr], T);
 		write_ptr += size;
@@ -441,6 +513,17 @@ class CommandQueueMT {
 	bool dealloc_one();
 
 public:
+	_FORCE_INLINE_ bool is_recording() const { return recording && Thread::get_caller_id() == recording_thread; }
+
+	// commands pushed from p_thread are recorded until submit(), pass false to stop and submit
+	void set_recording_thread(bool p_enable, Thread::ID p_thread = 0);
+	void submit();
+
+	// closes the frame statistics, call once per frame from the recording thread
+	void end_frame();
+	uint32_t get_frame_command_count() const { return frame_commands; }
+	uint32_t get_frame_command_bytes() const { return frame_bytes; }
+
 	/* NORMAL PUSH COMMANDS */
 	DECL_PUSH(0)
 	SPACE_SEP_LIST(DECL_PUSH, 13)
@@ -30,86 +30,391 @@
 
 #include "dictionary.h"
 
-#include "core/ordered_hash_map.h"
+#include "core/hashfuncs.h"
+#include "core/os/memory.h"
 #include "core/safe_refcount.h"
 #include "core/variant.h"
 
+#define DICTIONARY_FIRST_PAGE_SHIFT 3
+#define DICTIONARY_MAX_PAGES 30
+#define DICTIONARY_MIN_INDEX_SHIFT 3
+#define DICTIONARY_INDEX_EMPTY 0xFFFFFFFF
+#define DICTIONARY_INDEX_ERASED 0xFFFFFFFE
+
+struct DictionaryEntry {
+
+	Variant key;
+	Variant value;
+	uint32_t hash;
+	bool erased;
+};
+
+/* Ordered hash in the style of CPython's dict: entries are appended in insertion order to a dense
+ * entry list, and lookups go through an open addressing table that only holds entry indices.
+ * The entry list is split in pages that double in size and never move, so references returned by
+ * operator[] stay valid while the dictionary grows; only compaction (when erased entries pile up
+ * on insertion) or clear() moves or frees entries. */
 struct DictionaryPrivate {
 
 	SafeRefCount refcount;
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> variant_map;
+
+	DictionaryEntry *pages[DICTIONARY_MAX_PAGES];
+	uint32_t page_count;
+	uint32_t entry_count; //constructed entries, including erased ones
+	uint32_t erased_count;
+
+	uint32_t *indices;
+	uint32_t index_shift; //the index table has 1 << index_shift slots, 0 when not allocated
+	uint32_t used_slots; //slots holding an entry or an erased marker
+
+	_FORCE_INLINE_ static uint32_t _get_page(uint32_t p_entry, uint32_t &r_offset) {
+
+		uint32_t chunk = p_entry >> DICTIONARY_FIRST_PAGE_SHIFT;
+		if (chunk == 0) {
+			r_offset = p_entry;
+			return 0;
+		}
+		//page n > 0 starts at entry FIRST_PAGE_SIZE << (n - 1) and is that big
+#if defined(__GNUC__) || defined(__clang__)
+		uint32_t page = 32 - __builtin_clz(chunk);
+#else
+		uint32_t page = 0;
+		while (chunk) {
+			chunk >>= 1;
+			page++;
+		}
+#endif
+		r_offset = p_entry - ((1 << DICTIONARY_FIRST_PAGE_SHIFT) << (page - 1));
+		return page;
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_page_size(uint32_t p_page) {
+		return p_page == 0 ? (1 << DICTIONARY_FIRST_PAGE_SHIFT) : ((1 << DICTIONARY_FIRST_PAGE_SHIFT) << (p_page - 1));
+	}
+
+	_FORCE_INLINE_ DictionaryEntry &get_entry(uint32_t p_entry) const {
+
+		uint32_t offset;
+		uint32_t page = _get_page(p_entry, offset);
+		return pages[page][offset];
+	}
+
+	_FORCE_INLINE_ uint32_t _get_slot(uint32_t p_hash) const {
+		//fibonacci hashing spreads int keys that differ only in their high bits
+		return (p_hash * 2654435769U) >> (32 - index_shift);
+	}
+
+	_FORCE_INLINE_ uint32_t size() const {
+		return entry_count - erased_count;
+	}
+
+	int find_slot(const Variant &p_key, uint32_t p_hash) const {
+
+		if (index_shift == 0) {
+			return -1;
+		}
+
+		uint32_t mask = (1 << index_shift) - 1;
+		uint32_t slot = _get_slot(p_hash);
+		while (true) {
+			uint32_t idx = indices[slot];
+			if (idx == DICTIONARY_INDEX_EMPTY) {
+				return -1;
+			}
+			if (idx != DICTIONARY_INDEX_ERASED) {
+				const DictionaryEntry &e = get_entry(idx);
+				if (e.hash == p_hash && VariantComparator::compare(e.key, p_key)) {
+					return slot;
+				}
+			}
+			slot = (slot + 1) & mask;
+		}
+	}
+
+	_FORCE_INLINE_ DictionaryEntry *find(const Variant &p_key) const {
+
+		if (entry_count == erased_count) {
+			return NULL;
+		}
+		int slot = find_slot(p_key, VariantHasher::hash(p_key));
+		return slot == -1 ? NULL : &get_entry(indices[slot]);
+	}
+
+	int find_index(const Variant &p_key) const {
+
+		if (entry_count == erased_count) {
+			return -1;
+		}
+		int slot = find_slot(p_key, VariantHasher::hash(p_key));
+		return slot == -1 ? -1 : int(indices[slot]);
+	}
+
+	void _rebuild_indices(uint32_t p_shift) {
+
+		if (indices) {
+			memfree(indices);
+		}
+
+		index_shift = p_shift;
+		uint32_t slots = 1 << index_shift;
+		uint32_t mask = slots - 1;
+		indices = (uint32_t *)memalloc(sizeof(uint32_t) * slots);
+		for (uint32_t i = 0; i < slots; i++) {
+			indices[i] = DICTIONARY_INDEX_EMPTY;
+		}
+
+		for (uint32_t i = 0; i < entry_count; i++) {
+			const DictionaryEntry &e = get_entry(i);
+			if (e.erased) {
+				continue;
+			}
+			uint32_t slot = _get_slot(e.hash);
+			while (indices[slot] != DICTIONARY_INDEX_EMPTY) {
+				slot = (slot + 1) & mask;
+			}
+			indices[slot] = i;
+		}
+		used_slots = size();
+	}
+
+	void _compact() {
+
+		uint32_t to = 0;
+		for (uint32_t from = 0; from < entry_count; from++) {
+			DictionaryEntry &e = get_entry(from);
+			if (e.erased) {
+				continue;
+			}
+			if (to != from) {
+				DictionaryEntry &dst = get_entry(to);
+				dst.key = e.key;
+				dst.value = e.value;
+				dst.hash = e.hash;
+				dst.erased = false;
+			}
+			to++;
+		}
+
+		for (uint32_t i = to; i < entry_count; i++) {
+			get_entry(i).~DictionaryEntry();
+		}
+
+		entry_count = to;
+		erased_count = 0;
+	}
+
+	Variant &insert(const Variant &p_key) {
+
+		uint32_t hash = VariantHasher::hash(p_key);
+		if (entry_count != erased_count) {
+			int slot = find_slot(p_key, hash);
+			if (slot != -1) {
+				return get_entry(indices[slot]).value;
+			}
+		}
+
+		//keep the table at most 3/4 full, counting erased markers, so probing always ends
+		if (index_shift == 0 || (used_slots + 1) * 4 > (3U << index_shift)) {
+			uint32_t shift = MAX(index_shift, (uint32_t)DICTIONARY_MIN_INDEX_SHIFT);
+			if (erased_count > 0 && erased_count * 2 >= entry_count) {
+				_compact();
+			}
+			while ((size() + 1) * 4 > (3U << shift)) {
+				shift++;
+			}
+			_rebuild_indices(shift);
+		}
+
+		uint32_t offset;
+		uint32_t page = _get_page(entry_count, offset);
+		if (page >= page_count) {
+			CRASH_COND(page >= DICTIONARY_MAX_PAGES);
+			pages[page] = (DictionaryEntry *)memalloc(sizeof(DictionaryEntry) * _get_page_size(page));
+			page_count = page + 1;
+		}
+
+		DictionaryEntry *e = memnew_placement(&pages[page][offset], DictionaryEntry);
+		e->key = p_key;
+		e->hash = hash;
+		e->erased = false;
+
+		uint32_t mask = (1 << index_shift) - 1;
+		uint32_t slot = _get_slot(hash);
+		while (indices[slot] != DICTIONARY_INDEX_EMPTY && indices[slot] != DICTIONARY_INDEX_ERASED) {
+			slot = (slot + 1) & mask;
+		}
+		if (indices[slot] == DICTIONARY_INDEX_EMPTY) {
+			used_slots++;
+		}
+		indices[slot] = entry_count;
+		entry_count++;
+
+		return e->value;
+	}
+
+	bool erase(const Variant &p_key) {
+
+		if (entry_count == erased_count) {
+			return false;
+		}
+
+		int slot = find_slot(p_key, VariantHasher::hash(p_key));
+		if (slot == -1) {
+			return false;
+		}
+
+		DictionaryEntry &e = get_entry(indices[slot]);
+		e.key = Variant();
+		e.value = Variant();
+		e.erased = true;
+		indices[slot] = DICTIONARY_INDEX_ERASED;
+		erased_count++;
+
+		//entries erased from the end can be dropped right away
+		while (entry_count > 0 && get_entry(entry_count - 1).erased) {
+			get_entry(entry_count - 1).~DictionaryEntry();
+			entry_count--;
+			erased_count--;
+		}
+
+		if (entry_count == 0) {
+			//no entries left, the erased markers can go too
+			for (uint32_t i = 0; i < (1U << index_shift); i++) {
+				indices[i] = DICTIONARY_INDEX_EMPTY;
+			}
+			used_slots = 0;
+		}
+
+		return true;
+	}
+
+	_FORCE_INLINE_ int next_index(int p_from) const {
+
+		for (uint32_t i = p_from; i < entry_count; i++) {
+			if (!get_entry(i).erased) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	//index of the p_index-th live entry
+	int get_nth(int p_index) const {
+
+		if (p_index < 0 || p_index >= (int)size()) {
+			return -1;
+		}
+		if (erased_count == 0) {
+			return p_index;
+		}
+		int count = 0;
+		for (uint32_t i = 0; i < entry_count; i++) {
+			if (get_entry(i).erased) {
+				continue;
+			}
+			if (count == p_index) {
+				return i;
+			}
+			count++;
+		}
+		return -1;
+	}
+
+	void clear() {
+
+		for (uint32_t i = 0; i < entry_count; i++) {
+			get_entry(i).~DictionaryEntry();
+		}
+		for (uint32_t i = 0; i < page_count; i++) {
+			memfree(pages[i]);
+		}
+		if (indices) {
+			memfree(indices);
+		}
+
+		page_count = 0;
+		entry_count = 0;
+		erased_count = 0;
+		indices = NULL;
+		index_shift = 0;
+		used_slots = 0;
+	}
+
+	DictionaryPrivate() {
+		page_count = 0;
+		entry_count = 0;
+		erased_count = 0;
+		indices = NULL;
+		index_shift = 0;
+		used_slots = 0;
+	}
+
+	~DictionaryPrivate() {
+		clear();
+	}
 };
 
 void Dictionary::get_key_list(List<Variant> *p_keys) const {
 
-	if (_p->variant_map.empty())
-		return;
-
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		p_keys->push_back(E.key());
+	for (int i = _p->next_index(0); i != -1; i = _p->next_index(i + 1)) {
+		p_keys->push_back(_p->get_entry(i).key);
 	}
 }
 
 Variant Dictionary::get_key_at_index(int p_index) const {
 
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.key();
-		}
-		index++;
+	int idx = _p->get_nth(p_index);
+	if (idx == -1) {
+		return Variant();
 	}
-
-	return Variant();
+	return _p->get_entry(idx).key;
 }
 
 Variant Dictionary::get_value_at_index(int p_index) const {
 
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.value();
-		}
-		index++;
+	int idx = _p->get_nth(p_index);
+	if (idx == -1) {
+		return Variant();
 	}
-
-	return Variant();
+	return _p->get_entry(idx).value;
 }
 
 Variant &Dictionary::operator[](const Variant &p_key) {
 
-	return _p->variant_map[p_key];
+	return _p->insert(p_key);
 }
 
 const Variant &Dictionary::operator[](const Variant &p_key) const {
 
-	return _p->variant_map[p_key];
+	DictionaryEntry *e = _p->find(p_key);
+	CRASH_COND(!e);
+	return e->value;
 }
 const Variant *Dictionary::getptr(const Variant &p_key) const {
 
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
+	DictionaryEntry *e = _p->find(p_key);
 
-	if (!E)
+	if (!e)
 		return NULL;
-	return &E.get();
+	return &e->value;
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
 
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(p_key);
+	DictionaryEntry *e = _p->find(p_key);
 
-	if (!E)
+	if (!e)
 		return NULL;
-	return &E.get();
+	return &e->value;
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
 
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
+	DictionaryEntry *e = _p->find(p_key);
 
-	if (!E)
+	if (!e)
 		return Variant();
-	return E.get();
+	return e->value;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -123,16 +428,16 @@ Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
 
 int Dictionary::size() const {
 
-	return _p->variant_map.size();
+	return _p->size();
 }
 bool Dictionary::empty() const {
 
-	return !_p->variant_map.size();
+	return !_p->size();
 }
 
 bool Dictionary::has(const Variant &p_key) const {
 
-	return _p->variant_map.has(p_key);
+	return _p->find(p_key) != NULL;
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
@@ -146,7 +451,7 @@ bool Dictionary::has_all(const Array &p_keys) const {
 
 bool Dictionary::erase(const Variant &p_key) {
 
-	return _p->variant_map.erase(p_key);
+	return _p->erase(p_key);
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -177,7 +482,7 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 
 void Dictionary::clear() {
 
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 void Dictionary::_unref() const {
@@ -192,9 +497,10 @@ uint32_t Dictionary::hash() const {
 
 	uint32_t h = hash_djb2_one_32(Variant::DICTIONARY);
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		h = hash_djb2_one_32(E.key().hash(), h);
-		h = hash_djb2_one_32(E.value().hash(), h);
+	for (int i = _p->next_index(0); i != -1; i = _p->next_index(i + 1)) {
+		const DictionaryEntry &e = _p->get_entry(i);
+		h = hash_djb2_one_32(e.key.hash(), h);
+		h = hash_djb2_one_32(e.value.hash(), h);
 	}
 
 	return h;
@@ -203,15 +509,15 @@ uint32_t Dictionary::hash() const {
 Array Dictionary::keys() const {
 
 	Array varr;
-	if (_p->variant_map.empty())
+	if (!_p->size())
 		return varr;
 
 	varr.resize(size());
 
-	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.key();
-		i++;
+	int n = 0;
+	for (int i = _p->next_index(0); i != -1; i = _p->next_index(i + 1)) {
+		varr[n] = _p->get_entry(i).key;
+		n++;
 	}
 
 	return varr;
@@ -220,15 +526,15 @@ Array Dictionary::keys() const {
 Array Dictionary::values() const {
 
 	Array varr;
-	if (_p->variant_map.empty())
+	if (!_p->size())
 		return varr;
 
 	varr.resize(size());
 
-	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.get();
-		i++;
+	int n = 0;
+	for (int i = _p->next_index(0); i != -1; i = _p->next_index(i + 1)) {
+		varr[n] = _p->get_entry(i).value;
+		n++;
 	}
 
 	return varr;
@@ -236,25 +542,28 @@ Array Dictionary::values() const {
 
 const Variant *Dictionary::next(const Variant *p_key) const {
 
-	if (p_key == NULL) {
-		// caller wants to get the first element
-		if (_p->variant_map.front())
-			return &_p->variant_map.front().key();
-		return NULL;
+	int from = 0;
+	if (p_key != NULL) {
+		int idx = _p->find_index(*p_key);
+		if (idx == -1)
+			return NULL;
+		from = idx + 1;
 	}
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(*p_key);
+	// p_key == NULL means the caller wants to get the first element
 
-	if (E && E.next())
-		return &E.next().key();
-	return NULL;
+	int idx = _p->next_index(from);
+	if (idx == -1)
+		return NULL;
+	return &_p->get_entry(idx).key;
 }
 
 Dictionary Dictionary::duplicate(bool p_deep) const {
 
 	Dictionary n;
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		n[E.key()] = p_deep ? E.value().duplicate(true) : E.value();
+	for (int i = _p->next_index(0); i != -1; i = _p->next_index(i + 1)) {
+		const DictionaryEntry &e = _p->get_entry(i);
+		n[e.key] = p_deep ? e.value.duplicate(true) : e.value;
 	}
 
 	return n;
@@ -266,7 +575,7 @@ void Dictionary::operator=(const Dictionary &p_dictionary) {
 }
 
 const void *Dictionary::id() const {
-	return _p->variant_map.id();
+	return _p;
 }
 
 Dictionary::Dictionary(const Dictionary &p_from) {
@@ -0,0 +1,543 @@
+/*************************************************************************/
+/*  flat_hash_map.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "core/hashfuncs.h"
+#include "core/list.h"
+#include "core/os/memory.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FLAT_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * Control bytes of a FlatHashMap group, matched all at once with SSE2 or NEON where available.
+ * Each function returns a mask with bit i set when control byte i matches.
+ */
+struct FlatHashMapGroup {
+
+	enum {
+		WIDTH = 16,
+	};
+
+	static const int8_t EMPTY = -128;
+	static const int8_t DELETED = -2;
+	static const int8_t SENTINEL = -1; // padding of tables smaller than a group, never used
+
+#if defined(FLAT_HASH_MAP_SSE2)
+
+	static _FORCE_INLINE_ uint32_t match(const int8_t *p_ctrl, int8_t p_h2) {
+		__m128i ctrl = _mm_loadu_si128((const __m128i *)p_ctrl);
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(p_h2), ctrl));
+	}
+
+	static _FORCE_INLINE_ uint32_t match_empty(const int8_t *p_ctrl) {
+		return match(p_ctrl, EMPTY);
+	}
+
+	static _FORCE_INLINE_ uint32_t match_empty_or_deleted(const int8_t *p_ctrl) {
+		__m128i ctrl = _mm_loadu_si128((const __m128i *)p_ctrl);
+		return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(SENTINEL), ctrl));
+	}
+
+#elif defined(FLAT_HASH_MAP_NEON)
+
+	static _FORCE_INLINE_ uint32_t _to_mask(uint8x16_t p_bytes) {
+		static const uint8_t bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		uint8x16_t masked = vandq_u8(p_bytes, vld1q_u8(bits));
+		uint8x8_t sum = vpadd_u8(vget_low_u8(masked), vget_high_u8(masked));
+		sum = vpadd_u8(sum, sum);
+		sum = vpadd_u8(sum, sum);
+		return vget_lane_u16(vreinterpret_u16_u8(sum), 0);
+	}
+
+	static _FORCE_INLINE_ uint32_t match(const int8_t *p_ctrl, int8_t p_h2) {
+		return _to_mask(vceqq_s8(vld1q_s8(p_ctrl), vdupq_n_s8(p_h2)));
+	}
+
+	static _FORCE_INLINE_ uint32_t match_empty(const int8_t *p_ctrl) {
+		return match(p_ctrl, EMPTY);
+	}
+
+	static _FORCE_INLINE_ uint32_t match_empty_or_deleted(const int8_t *p_ctrl) {
+		return _to_mask(vcltq_s8(vld1q_s8(p_ctrl), vdupq_n_s8(SENTINEL)));
+	}
+
+#else
+
+	static _FORCE_INLINE_ uint32_t match(const int8_t *p_ctrl, int8_t p_h2) {
+		uint32_t mask = 0;
+		for (int i = 0; i < WIDTH; i++) {
+			mask |= uint32_t(p_ctrl[i] == p_h2) << i;
+		}
+		return mask;
+	}
+
+	static _FORCE_INLINE_ uint32_t match_empty(const int8_t *p_ctrl) {
+		return match(p_ctrl, EMPTY);
+	}
+
+	static _FORCE_INLINE_ uint32_t match_empty_or_deleted(const int8_t *p_ctrl) {
+		uint32_t mask = 0;
+		for (int i = 0; i < WIDTH; i++) {
+			mask |= uint32_t(p_ctrl[i] < SENTINEL) << i;
+		}
+		return mask;
+	}
+
+#endif
+
+	static _FORCE_INLINE_ uint32_t lowest_bit(uint32_t p_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(p_mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, p_mask);
+		return index;
+#else
+		uint32_t index = 0;
+		while (!(p_mask & 1)) {
+			p_mask >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+};
+
+/**
+ * A HashMap implementation using open addressing in the style of SwissTable.
+ *
+ * Next to the slots, a control byte per slot says whether it's empty, deleted, or holds an
+ * element, in which case it stores 7 bits of the element's hash. Lookups probe groups of 16
+ * control bytes at once, so most keys are found comparing a single key and missing keys are
+ * usually rejected without comparing any.
+ *
+ * Control bytes, keys and values live in a single allocation, made on the first insertion
+ * and released when the map becomes empty, so empty maps cost no memory. Inserting can move
+ * elements: pointers to keys or values are only valid until the next insertion.
+ *
+ * The interface follows HashMap, so it can replace it where those pointers aren't kept.
+ */
+template <class TKey, class TValue,
+		class Hasher = HashMapHasherDefault,
+		class Comparator = HashMapComparatorDefault<TKey> >
+class FlatHashMap {
+
+	enum {
+		MIN_CAPACITY = 2,
+	};
+
+	uint8_t *data;
+	uint32_t capacity; // power of two
+	uint32_t num_elements;
+	uint32_t num_deleted;
+
+	static _FORCE_INLINE_ uint32_t _ctrl_size(uint32_t p_capacity) { return MAX(p_capacity, (uint32_t)FlatHashMapGroup::WIDTH); }
+	static _FORCE_INLINE_ uint32_t _keys_offset(uint32_t p_capacity) {
+		return (_ctrl_size(p_capacity) + alignof(TKey) - 1) & ~(uint32_t)(alignof(TKey) - 1);
+	}
+	static _FORCE_INLINE_ uint32_t _values_offset(uint32_t p_capacity) {
+		return (_keys_offset(p_capacity) + sizeof(TKey) * p_capacity + alignof(TValue) - 1) & ~(uint32_t)(alignof(TValue) - 1);
+	}
+
+	//tables that fit in a group can fill up, lookups visit every group at most once anyway
+	static _FORCE_INLINE_ uint32_t _max_load(uint32_t p_capacity) {
+		return p_capacity < (uint32_t)FlatHashMapGroup::WIDTH ? p_capacity : p_capacity - p_capacity / 8;
+	}
+
+	_FORCE_INLINE_ int8_t *_ctrl() const { return (int8_t *)data; }
+	_FORCE_INLINE_ TKey *_keys() const { return (TKey *)(data + _keys_offset(capacity)); }
+	_FORCE_INLINE_ TValue *_values() const { return (TValue *)(data + _values_offset(capacity)); }
+	_FORCE_INLINE_ uint32_t _group_mask() const { return (_ctrl_size(capacity) / FlatHashMapGroup::WIDTH) - 1; }
+
+	int32_t _lookup_pos(const TKey &p_key) const {
+
+		if (unlikely(!data)) {
+			return -1;
+		}
+
+		uint32_t hash = Hasher::hash(p_key);
+		int8_t h2 = hash & 0x7F;
+		uint32_t group_mask = _group_mask();
+		uint32_t group = (hash >> 7) & group_mask;
+		const int8_t *ctrl = _ctrl();
+		const TKey *keys = _keys();
+
+		for (uint32_t probe = 0; probe <= group_mask; probe++) {
+
+			const int8_t *group_ctrl = ctrl + group * FlatHashMapGroup::WIDTH;
+			uint32_t match = FlatHashMapGroup::match(group_ctrl, h2);
+			while (match) {
+				uint32_t pos = group * FlatHashMapGroup::WIDTH + FlatHashMapGroup::lowest_bit(match);
+				if (Comparator::compare(keys[pos], p_key)) {
+					return pos;
+				}
+				match &= match - 1;
+			}
+
+			if (FlatHashMapGroup::match_empty(group_ctrl)) {
+				return -1;
+			}
+
+			group = (group + probe + 1) & group_mask; // triangular probing visits every group
+		}
+
+		return -1;
+	}
+
+	uint32_t _find_free_pos(uint32_t p_hash) const {
+
+		uint32_t group_mask = _group_mask();
+		uint32_t group = (p_hash >> 7) & group_mask;
+		const int8_t *ctrl = _ctrl();
+
+		for (uint32_t probe = 0; probe <= group_mask; probe++) {
+
+			uint32_t free = FlatHashMapGroup::match_empty_or_deleted(ctrl + group * FlatHashMapGroup::WIDTH);
+			if (free) {
+				return group * FlatHashMapGroup::WIDTH + FlatHashMapGroup::lowest_bit(free);
+			}
+
+			group = (group + probe + 1) & group_mask;
+		}
+
+		CRASH_NOW_MSG("FlatHashMap has no free slot, the load factor is broken.");
+		return 0;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+
+		uint8_t *old_data = data;
+		uint32_t old_capacity = capacity;
+		int8_t *old_ctrl = _ctrl();
+		TKey *old_keys = old_data ? _keys() : NULL;
+		TValue *old_values = old_data ? _values() : NULL;
+
+		capacity = p_new_capacity;
+		data = (uint8_t *)memalloc(_values_offset(capacity) + sizeof(TValue) * capacity);
+		num_deleted = 0;
+
+		int8_t *ctrl = _ctrl();
+		for (uint32_t i = 0; i < _ctrl_size(capacity); i++) {
+			ctrl[i] = i < capacity ? FlatHashMapGroup::EMPTY : FlatHashMapGroup::SENTINEL;
+		}
+
+		if (!old_data) {
+			return;
+		}
+
+		TKey *keys = _keys();
+		TValue *values = _values();
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+
+			if (old_ctrl[i] < 0) {
+				continue;
+			}
+
+			uint32_t hash = Hasher::hash(old_keys[i]);
+			uint32_t pos = _find_free_pos(hash);
+			ctrl[pos] = hash & 0x7F;
+			memnew_placement(&keys[pos], TKey(old_keys[i]));
+			memnew_placement(&values[pos], TValue(old_values[i]));
+			old_keys[i].~TKey();
+			old_values[i].~TValue();
+		}
+
+		memfree(old_data);
+	}
+
+	uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+
+		if (num_elements + num_deleted + 1 > _max_load(capacity)) {
+
+			uint32_t new_capacity = MAX(capacity, (uint32_t)MIN_CAPACITY);
+			//only grow when dropping the deleted slots doesn't leave enough room
+			if (!capacity || num_elements + 1 > _max_load(capacity) * 3 / 4) {
+				new_capacity = capacity ? capacity * 2 : (uint32_t)MIN_CAPACITY;
+			}
+			_resize_and_rehash(new_capacity);
+		}
+
+		uint32_t hash = Hasher::hash(p_key);
+		uint32_t pos = _find_free_pos(hash);
+
+		int8_t *ctrl = _ctrl();
+		if (ctrl[pos] == FlatHashMapGroup::DELETED) {
+			num_deleted--;
+		}
+		ctrl[pos] = hash & 0x7F;
+		memnew_placement(&_keys()[pos], TKey(p_key));
+		memnew_placement(&_values()[pos], TValue(p_value));
+		num_elements++;
+
+		return pos;
+	}
+
+	void _copy_from(const FlatHashMap &p_other) {
+
+		capacity = p_other.capacity;
+		num_elements = p_other.num_elements;
+		num_deleted = p_other.num_deleted;
+		data = NULL;
+
+		if (!p_other.data) {
+			return;
+		}
+
+		data = (uint8_t *)memalloc(_values_offset(capacity) + sizeof(TValue) * capacity);
+
+		int8_t *ctrl = _ctrl();
+		const int8_t *other_ctrl = p_other._ctrl();
+		TKey *keys = _keys();
+		TValue *values = _values();
+		const TKey *other_keys = p_other._keys();
+		const TValue *other_values = p_other._values();
+
+		for (uint32_t i = 0; i < _ctrl_size(capacity); i++) {
+			ctrl[i] = other_ctrl[i];
+			if (i < capacity && ctrl[i] >= 0) {
+				memnew_placement(&keys[i], TKey(other_keys[i]));
+				memnew_placement(&values[i], TValue(other_values[i]));
+			}
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ unsigned int size() const { return num_elements; }
+	_FORCE_INLINE_ bool empty() const { return num_elements == 0; }
+
+	void clear() {
+
+		if (!data) {
+			return;
+		}
+
+		const int8_t *ctrl = _ctrl();
+		TKey *keys = _keys();
+		TValue *values = _values();
+		for (uint32_t i = 0; i < capacity; i++) {
+			if (ctrl[i] >= 0) {
+				keys[i].~TKey();
+				values[i].~TValue();
+			}
+		}
+
+		memfree(data);
+		data = NULL;
+		capacity = 0;
+		num_elements = 0;
+		num_deleted = 0;
+	}
+
+	void set(const TKey &p_key, const TValue &p_value) {
+
+		int32_t pos = _lookup_pos(p_key);
+		if (pos >= 0) {
+			_values()[pos] = p_value;
+		} else {
+			_insert(p_key, p_value);
+		}
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+
+		return _lookup_pos(p_key) >= 0;
+	}
+
+	/**
+	 * Same as get, except it can return NULL when item was not found.
+	 * The pointer is only valid until the next insertion.
+	 */
+	_FORCE_INLINE_ TValue *getptr(const TKey &p_key) {
+
+		int32_t pos = _lookup_pos(p_key);
+		return pos >= 0 ? &_values()[pos] : NULL;
+	}
+
+	_FORCE_INLINE_ const TValue *getptr(const TKey &p_key) const {
+
+		int32_t pos = _lookup_pos(p_key);
+		return pos >= 0 ? &_values()[pos] : NULL;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+
+		const TValue *res = getptr(p_key);
+		CRASH_COND_MSG(!res, "FlatHashMap key not found.");
+		return *res;
+	}
+
+	TValue &get(const TKey &p_key) {
+
+		TValue *res = getptr(p_key);
+		CRASH_COND_MSG(!res, "FlatHashMap key not found.");
+		return *res;
+	}
+
+	inline const TValue &operator[](const TKey &p_key) const {
+
+		return get(p_key);
+	}
+
+	inline TValue &operator[](const TKey &p_key) {
+
+		int32_t pos = _lookup_pos(p_key);
+		if (pos < 0) {
+			pos = _insert(p_key, TValue());
+		}
+		return _values()[pos];
+	}
+
+	bool erase(const TKey &p_key) {
+
+		int32_t pos = _lookup_pos(p_key);
+		if (pos < 0) {
+			return false;
+		}
+
+		//a group that still has an empty slot never made a probe move past it, so no tombstone is needed
+		int8_t *ctrl = _ctrl();
+		if (FlatHashMapGroup::match_empty(ctrl + (pos & ~(FlatHashMapGroup::WIDTH - 1)))) {
+			ctrl[pos] = FlatHashMapGroup::EMPTY;
+		} else {
+			ctrl[pos] = FlatHashMapGroup::DELETED;
+			num_deleted++;
+		}
+
+		//p_key may point to the key being destroyed, don't use it from here on
+		_keys()[pos].~TKey();
+		_values()[pos].~TValue();
+		num_elements--;
+
+		if (num_elements == 0) {
+			clear();
+		}
+
+		return true;
+	}
+
+	/**
+	 * Get the next key to p_key, and the first key if p_key is null.
+	 * Returns a pointer to the next key if found, NULL otherwise.
+	 * Adding/Removing elements while iterating will, of course, have unexpected results, don't do it.
+	 */
+	const TKey *next(const TKey *p_key) const {
+
+		if (unlikely(!data)) {
+			return NULL;
+		}
+
+		const TKey *keys = _keys();
+		uint32_t from = 0;
+
+		if (p_key) {
+			if (p_key >= keys && p_key < keys + capacity) {
+				from = (p_key - keys) + 1;
+			} else {
+				int32_t pos = _lookup_pos(*p_key);
+				ERR_FAIL_COND_V_MSG(pos < 0, NULL, "Invalid key supplied.");
+				from = pos + 1;
+			}
+		}
+
+		const int8_t *ctrl = _ctrl();
+		for (uint32_t i = from; i < capacity; i++) {
+			if (ctrl[i] >= 0) {
+				return &keys[i];
+			}
+		}
+
+		return NULL;
+	}
+
+	void get_key_list(List<TKey> *p_keys) const {
+
+		for (const TKey *k = next(NULL); k; k = next(k)) {
+			p_keys->push_back(*k);
+		}
+	}
+
+	/**
+	 * reserves space for a number of elements, useful to avoid many resizes and rehashes
+	 * if adding a known (possibly large) number of elements at once.
+	 */
+	void reserve(uint32_t p_elements) {
+
+		uint32_t new_capacity = MAX(capacity, (uint32_t)MIN_CAPACITY);
+		while (_max_load(new_capacity) < p_elements) {
+			new_capacity *= 2;
+		}
+		if (new_capacity != capacity) {
+			_resize_and_rehash(new_capacity);
+		}
+	}
+
+	void operator=(const FlatHashMap &p_other) {
+
+		if (this == &p_other) {
+			return;
+		}
+		clear();
+		_copy_from(p_other);
+	}
+
+	FlatHashMap(const FlatHashMap &p_other) {
+
+		_copy_from(p_other);
+	}
+
+	FlatHashMap() {
+
+		data = NULL;
+		capacity = 0;
+		num_elements = 0;
+		num_deleted = 0;
+	}
+
+	~FlatHashMap() {
+
+		clear();
+	}
+};
+
+#endif // FLAT_HASH_MAP_H
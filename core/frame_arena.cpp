@@ -0,0 +1,152 @@
+/*************************************************************************/
+/*  frame_arena.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "frame_arena.h"
+
+#include <stdlib.h>
+
+struct FrameArenaChunk {
+	FrameArenaChunk *next;
+	size_t capacity;
+	size_t used;
+};
+
+// the chunk header is padded so allocations after it stay aligned
+#define CHUNK_HEADER_SIZE ((sizeof(FrameArenaChunk) + FrameArena::ALIGNMENT - 1) & ~(size_t)(FrameArena::ALIGNMENT - 1))
+
+struct FrameArenaThread {
+
+	FrameArenaChunk *chunks; //the first chunk is the one being filled
+	size_t used;
+	size_t capacity;
+
+	static FrameArenaChunk *create_chunk(size_t p_capacity) {
+
+		//arena memory churns with whole chunks only, so ask the system directly instead of going through Memory
+		FrameArenaChunk *chunk = (FrameArenaChunk *)::malloc(CHUNK_HEADER_SIZE + p_capacity);
+		ERR_FAIL_COND_V(!chunk, NULL);
+		chunk->next = NULL;
+		chunk->capacity = p_capacity;
+		chunk->used = 0;
+		return chunk;
+	}
+
+	void free_chunks() {
+
+		while (chunks) {
+			FrameArenaChunk *next = chunks->next;
+			::free(chunks);
+			chunks = next;
+		}
+		capacity = 0;
+	}
+
+	FrameArenaThread() {
+
+		chunks = NULL;
+		used = 0;
+		capacity = 0;
+	}
+
+	~FrameArenaThread() {
+
+		free_chunks();
+	}
+};
+
+static thread_local FrameArenaThread frame_arena;
+
+void *FrameArena::alloc(size_t p_bytes) {
+
+	FrameArenaThread &arena = frame_arena;
+	size_t size = (p_bytes + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+
+	FrameArenaChunk *chunk = arena.chunks;
+	if (unlikely(!chunk || chunk->used + size > chunk->capacity)) {
+
+		chunk = FrameArenaThread::create_chunk(MAX(size, (size_t)CHUNK_SIZE));
+		ERR_FAIL_COND_V(!chunk, NULL);
+		chunk->next = arena.chunks;
+		arena.chunks = chunk;
+		arena.capacity += chunk->capacity;
+	}
+
+	void *ptr = (uint8_t *)chunk + CHUNK_HEADER_SIZE + chunk->used;
+	chunk->used += size;
+	arena.used += size;
+	return ptr;
+}
+
+void FrameArena::release(void *p_memory, size_t p_bytes) {
+
+	FrameArenaThread &arena = frame_arena;
+	FrameArenaChunk *chunk = arena.chunks;
+	if (!p_memory || !chunk) {
+		return;
+	}
+
+	size_t size = (p_bytes + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+	uint8_t *top = (uint8_t *)chunk + CHUNK_HEADER_SIZE + chunk->used;
+	if ((uint8_t *)p_memory + size == top) {
+		chunk->used -= size;
+		arena.used -= size;
+	}
+}
+
+void FrameArena::reset() {
+
+	FrameArenaThread &arena = frame_arena;
+
+	if (arena.chunks && arena.chunks->next) {
+		//needed more than one chunk this frame, replace them with a single one that fits it all
+		size_t capacity = arena.capacity;
+		arena.free_chunks();
+		if (capacity <= MAX_RETAINED_SIZE) {
+			arena.chunks = FrameArenaThread::create_chunk(capacity);
+			if (arena.chunks) {
+				arena.capacity = capacity;
+			}
+		}
+	} else if (arena.chunks) {
+		arena.chunks->used = 0;
+	}
+
+	arena.used = 0;
+}
+
+size_t FrameArena::get_used() {
+
+	return frame_arena.used;
+}
+
+size_t FrameArena::get_capacity() {
+
+	return frame_arena.capacity;
+}
@@ -0,0 +1,201 @@
+/*************************************************************************/
+/*  frame_arena.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/error_macros.h"
+#include "core/os/memory.h"
+#include "core/vector.h"
+
+#include <string.h>
+
+/**
+ * Linear allocator for data that only lives until the end of the current frame.
+ *
+ * Every thread owns its own arena, so allocating takes no lock and costs a pointer bump.
+ * Memory is never freed individually: the whole arena is reset once per frame by the
+ * thread that owns it (Main::iteration for the main thread, the render loop for the
+ * visual server thread). Threads that never reset get their memory back when they exit.
+ *
+ * free() is a no-op, so FrameArena can be used as the allocator of List or Map for
+ * containers that don't outlive the frame.
+ */
+class FrameArena {
+
+	FrameArena();
+
+public:
+	enum {
+		ALIGNMENT = 16,
+		CHUNK_SIZE = 64 * 1024,
+		MAX_RETAINED_SIZE = 16 * 1024 * 1024, // a spike above this is not kept for the next frame
+	};
+
+	static void *alloc(size_t p_bytes);
+	static void free(void *p_memory) {}
+
+	//gives back the most recent allocation right away, so stack-like scratch can be reused within the frame;
+	//does nothing if something else was allocated after it
+	static void release(void *p_memory, size_t p_bytes);
+
+	//only call from the thread that owns the arena, once nothing allocated from it is in use
+	static void reset();
+
+	static size_t get_used();
+	static size_t get_capacity();
+};
+
+/**
+ * Growable array allocated from the FrameArena of the calling thread.
+ *
+ * Unlike Vector it does not share or reference count its data, so writing to it never
+ * triggers a copy. It must not outlive the frame, nor be passed to other threads that
+ * may resize it.
+ */
+template <class T>
+class FrameVector {
+
+	T *data;
+	int count;
+	int capacity;
+
+	void _grow(int p_capacity) {
+
+		T *new_data = (T *)FrameArena::alloc(sizeof(T) * p_capacity);
+		if (__has_trivial_copy(T)) {
+			if (count) {
+				memcpy(new_data, data, sizeof(T) * count);
+			}
+		} else {
+			for (int i = 0; i < count; i++) {
+				memnew_placement(&new_data[i], T(data[i]));
+				data[i].~T();
+			}
+		}
+		data = new_data; //old block stays in the arena until reset
+		capacity = p_capacity;
+	}
+
+public:
+	_FORCE_INLINE_ int size() const { return count; }
+	_FORCE_INLINE_ bool empty() const { return count == 0; }
+	_FORCE_INLINE_ T *ptr() { return data; }
+	_FORCE_INLINE_ const T *ptr() const { return data; }
+
+	_FORCE_INLINE_ T &operator[](int p_index) {
+		CRASH_BAD_INDEX(p_index, count);
+		return data[p_index];
+	}
+	_FORCE_INLINE_ const T &operator[](int p_index) const {
+		CRASH_BAD_INDEX(p_index, count);
+		return data[p_index];
+	}
+
+	void reserve(int p_capacity) {
+
+		if (p_capacity > capacity) {
+			_grow(p_capacity);
+		}
+	}
+
+	_FORCE_INLINE_ void push_back(const T &p_value) {
+
+		if (unlikely(count == capacity)) {
+			_grow(capacity ? capacity * 2 : 16);
+		}
+		memnew_placement(&data[count++], T(p_value));
+	}
+
+	void resize(int p_size) {
+
+		ERR_FAIL_COND(p_size < 0);
+		reserve(p_size);
+
+		if (!__has_trivial_destructor(T)) {
+			for (int i = p_size; i < count; i++) {
+				data[i].~T();
+			}
+		}
+		if (!__has_trivial_constructor(T)) {
+			for (int i = count; i < p_size; i++) {
+				memnew_placement(&data[i], T);
+			}
+		}
+		count = p_size;
+	}
+
+	void clear() { resize(0); }
+
+	FrameVector(const FrameVector &) = delete;
+	FrameVector &operator=(const FrameVector &) = delete;
+
+	FrameVector() {
+
+		data = NULL;
+		count = 0;
+		capacity = 0;
+	}
+
+	//snapshot of a Vector, e.g. to iterate it while it may be modified
+	explicit FrameVector(const Vector<T> &p_from) {
+
+		data = NULL;
+		count = 0;
+		capacity = 0;
+
+		int from_count = p_from.size();
+		if (from_count == 0) {
+			return;
+		}
+
+		_grow(from_count);
+		const T *from = p_from.ptr();
+		if (__has_trivial_copy(T)) {
+			memcpy(data, from, sizeof(T) * from_count);
+		} else {
+			for (int i = 0; i < from_count; i++) {
+				memnew_placement(&data[i], T(from[i]));
+			}
+		}
+		count = from_count;
+	}
+
+	~FrameVector() {
+
+		if (!__has_trivial_destructor(T)) {
+			for (int i = 0; i < count; i++) {
+				data[i].~T();
+			}
+		}
+	}
+};
+
+#endif // FRAME_ARENA_H
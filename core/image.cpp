@@ -34,13 +34,58 @@
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
+#include "core/message_queue.h"
 #include "core/os/copymem.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/print_string.h"
 
 #include "thirdparty/misc/hq2x.h"
 
 #include <stdio.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define IMAGE_NEON
+#include <arm_neon.h>
+#endif
+
+// Rows are processed in bands of about this many pixels, spread over the worker threads.
+#define IMAGE_ROW_BAND_PIXELS 16384
+
+template <class F>
+struct ImageRowBands {
+
+	F *func;
+	uint32_t rows;
+	uint32_t band;
+
+	void process(uint32_t p_band, void *) {
+
+		uint32_t from = p_band * band;
+		func->process_rows(from, MIN(from + band, rows));
+	}
+};
+
+//calls p_func.process_rows(from, to) over all rows, in parallel when there is enough work
+template <class F>
+static void _process_rows(F &p_func, uint32_t p_rows, uint32_t p_row_pixels) {
+
+	uint32_t band = MAX(1u, IMAGE_ROW_BAND_PIXELS / MAX(1u, p_row_pixels));
+	uint32_t bands = (p_rows + band - 1) / band;
+
+	if (bands > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		ImageRowBands<F> rb;
+		rb.func = &p_func;
+		rb.rows = p_rows;
+		rb.band = band;
+		WorkerThreadPool::get_singleton()->parallel_for(bands, &rb, &ImageRowBands<F>::process, (void *)NULL);
+	} else {
+		p_func.process_rows(0, p_rows);
+	}
+}
+
 const char *Image::format_names[Image::FORMAT_MAX] = {
 	"Lum8", //luminance
 	"LumAlpha8", //luminance-alpha
@@ -528,7 +573,7 @@ static double _bicubic_interp_kernel(double x) {
 }
 
 template <int CC, class T>
-static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
 	// get source image size
 	int width = p_src_width;
@@ -544,7 +589,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
+	for (uint32_t y = p_from_row; y < p_to_row; y++) {
 		// Y coordinates
 		oy = (double)y * yfac - 0.5f;
 		oy1 = (int)oy;
@@ -612,7 +657,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 }
 
 template <int CC, class T>
-static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
 	enum {
 		FRAC_BITS = 8,
@@ -621,7 +666,7 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 
 	};
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 
 		uint32_t src_yofs_up_fp = (i * p_src_height * FRAC_LEN / p_dst_height);
 		uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
@@ -703,9 +748,9 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 }
 
 template <int CC, class T>
-static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 
 		uint32_t src_yofs = i * p_src_height / p_dst_height;
 		uint32_t y_ofs = src_yofs * p_src_width * CC;
@@ -727,112 +772,151 @@ static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict
 	}
 }
 
-#define LANCZOS_TYPE 3
+struct ImageScaleRows {
 
-static float _lanczos(float p_x) {
-	return Math::abs(p_x) >= LANCZOS_TYPE ? 0 : Math::sincn(p_x) * Math::sincn(p_x / LANCZOS_TYPE);
-}
+	typedef void (*ScaleFunc)(const uint8_t *, uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
 
-template <int CC, class T>
-static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	ScaleFunc func;
+	const uint8_t *src;
+	uint8_t *dst;
+	uint32_t src_width;
+	uint32_t src_height;
+	uint32_t dst_width;
+	uint32_t dst_height;
 
-	int32_t src_width = p_src_width;
-	int32_t src_height = p_src_height;
-	int32_t dst_height = p_dst_height;
-	int32_t dst_width = p_dst_width;
-
-	uint32_t buffer_size = src_height * dst_width * CC;
-	float *buffer = memnew_arr(float, buffer_size); // Store the first pass in a buffer
+	void process_rows(uint32_t p_from, uint32_t p_to) {
+		func(src, dst, src_width, src_height, dst_width, dst_height, p_from, p_to);
+	}
+};
 
-	{ // FIRST PASS (horizontal)
+static void _scale(ImageScaleRows::ScaleFunc p_func, const uint8_t *p_src, uint8_t *p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
 
-		float x_scale = float(src_width) / float(dst_width);
+	ImageScaleRows sr;
+	sr.func = p_func;
+	sr.src = p_src;
+	sr.dst = p_dst;
+	sr.src_width = p_src_width;
+	sr.src_height = p_src_height;
+	sr.dst_width = p_dst_width;
+	sr.dst_height = p_dst_height;
+	_process_rows(sr, p_dst_height, p_dst_width);
+}
 
-		float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
-		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
+#define LANCZOS_TYPE 3
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+static float _lanczos(float p_x) {
+	return Math::abs(p_x) >= LANCZOS_TYPE ? 0 : Math::sincn(p_x) * Math::sincn(p_x / LANCZOS_TYPE);
+}
 
-		for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
+//normalized weights of the source pixels contributing to each destination pixel along one axis
+struct ImageLanczosKernel {
 
-			// The corresponding point on the source image
-			float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
-			int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
-			int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
+	int32_t size; //weights per destination pixel, unused ones are zero
+	Vector<int32_t> starts;
+	Vector<float> weights;
 
-			// Create the kernel used by all the pixels of the column
-			for (int32_t target_x = start_x; target_x <= end_x; target_x++)
-				kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
+	ImageLanczosKernel(int32_t p_src_size, int32_t p_dst_size) {
 
-			for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
+		float scale = float(p_src_size) / float(p_dst_size);
+		float scale_factor = MAX(scale, 1); // A larger kernel is required only when downscaling
+		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-				float pixel[CC] = { 0 };
-				float weight = 0;
+		size = half_kernel * 2;
+		starts.resize(p_dst_size);
+		weights.resize(p_dst_size * size);
+		int32_t *sw = starts.ptrw();
+		float *ww = weights.ptrw();
 
-				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+		for (int32_t dst = 0; dst < p_dst_size; dst++) {
 
-					float lanczos_val = kernel[target_x - start_x];
-					weight += lanczos_val;
+			// The corresponding point on the source image
+			float src = (dst + 0.5f) * scale; // Offset by 0.5 so it uses the pixel's center
+			int32_t start = MAX(0, int32_t(src) - half_kernel + 1);
+			int32_t end = MIN(p_src_size - 1, int32_t(src) + half_kernel);
+
+			float *w = &ww[dst * size];
+			float weight = 0;
+			for (int32_t i = 0; i < size; i++) {
+				w[i] = start + i <= end ? _lanczos((start + i + 0.5f - src) / scale_factor) : 0;
+				weight += w[i];
+			}
+			for (int32_t i = 0; i < size; i++) {
+				w[i] /= weight; // Normalize the sum of all the samples
+			}
 
-					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+			sw[dst] = start;
+		}
+	}
+};
 
-					for (uint32_t i = 0; i < CC; i++) {
-						if (sizeof(T) == 2) //half float
-							pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
-						else
-							pixel[i] += src_data[i] * lanczos_val;
+template <int CC, class T>
+struct ImageLanczosRows {
+
+	const T *src;
+	float *buffer;
+	T *dst;
+	int32_t src_width;
+	int32_t src_height;
+	int32_t dst_width;
+	const ImageLanczosKernel *kernel_x;
+	const ImageLanczosKernel *kernel_y;
+	bool vertical;
+
+	void process_rows(uint32_t p_from, uint32_t p_to) {
+
+		if (!vertical) {
+			// FIRST PASS (horizontal), rows of the source into the buffer
+			for (uint32_t buffer_y = p_from; buffer_y < p_to; buffer_y++) {
+				for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
+
+					int32_t start_x = kernel_x->starts.ptr()[buffer_x];
+					int32_t end_x = MIN(src_width, start_x + kernel_x->size);
+					const float *kernel = kernel_x->weights.ptr() + buffer_x * kernel_x->size;
+
+					float pixel[CC] = { 0 };
+					for (int32_t target_x = start_x; target_x < end_x; target_x++) {
+
+						float lanczos_val = kernel[target_x - start_x];
+						const T *__restrict src_data = src + (buffer_y * src_width + target_x) * CC;
+
+						for (uint32_t i = 0; i < CC; i++) {
+							if (sizeof(T) == 2) //half float
+								pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
+							else
+								pixel[i] += src_data[i] * lanczos_val;
+						}
 					}
-				}
-
-				float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++)
-					dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					float *dst_data = buffer + (buffer_y * dst_width + buffer_x) * CC;
+					for (uint32_t i = 0; i < CC; i++)
+						dst_data[i] = pixel[i];
+				}
 			}
+			return;
 		}
 
-		memdelete_arr(kernel);
-	} // End of first pass
-
-	{ // SECOND PASS (vertical + result)
-
-		float y_scale = float(src_height) / float(dst_height);
-
-		float scale_factor = MAX(y_scale, 1);
-		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
-
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		// SECOND PASS (vertical + result)
+		for (uint32_t dst_y = p_from; dst_y < p_to; dst_y++) {
 
-		for (int32_t dst_y = 0; dst_y < dst_height; dst_y++) {
-
-			float buffer_y = (dst_y + 0.5f) * y_scale;
-			int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
-			int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
-
-			for (int32_t target_y = start_y; target_y <= end_y; target_y++)
-				kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
+			int32_t start_y = kernel_y->starts.ptr()[dst_y];
+			int32_t end_y = MIN(src_height, start_y + kernel_y->size);
+			const float *kernel = kernel_y->weights.ptr() + dst_y * kernel_y->size;
 
 			for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
 
 				float pixel[CC] = { 0 };
-				float weight = 0;
-
-				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+				for (int32_t target_y = start_y; target_y < end_y; target_y++) {
 
 					float lanczos_val = kernel[target_y - start_y];
-					weight += lanczos_val;
-
-					float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
+					const float *buffer_data = buffer + (target_y * dst_width + dst_x) * CC;
 
 					for (uint32_t i = 0; i < CC; i++)
 						pixel[i] += buffer_data[i] * lanczos_val;
 				}
 
-				T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
+				T *dst_data = dst + (dst_y * dst_width + dst_x) * CC;
 
 				for (uint32_t i = 0; i < CC; i++) {
-					pixel[i] /= weight;
-
 					if (sizeof(T) == 1) //byte
 						dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
 					else if (sizeof(T) == 2) //half float
@@ -842,9 +926,31 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 				}
 			}
 		}
+	}
+};
+
+template <int CC, class T>
+static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
 
-		memdelete_arr(kernel);
-	} // End of second pass
+	ImageLanczosKernel kernel_x(p_src_width, p_dst_width);
+	ImageLanczosKernel kernel_y(p_src_height, p_dst_height);
+
+	float *buffer = memnew_arr(float, p_src_height * p_dst_width * CC); // Store the first pass in a buffer
+
+	ImageLanczosRows<CC, T> lr;
+	lr.src = (const T *)p_src;
+	lr.buffer = buffer;
+	lr.dst = (T *)p_dst;
+	lr.src_width = p_src_width;
+	lr.src_height = p_src_height;
+	lr.dst_width = p_dst_width;
+	lr.kernel_x = &kernel_x;
+	lr.kernel_y = &kernel_y;
+
+	lr.vertical = false;
+	_process_rows(lr, p_src_height, p_dst_width * kernel_x.size);
+	lr.vertical = true;
+	_process_rows(lr, p_dst_height, p_dst_width * kernel_y.size);
 
 	memdelete_arr(buffer);
 }
@@ -936,25 +1042,25 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 			if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 				switch (get_format_pixel_size(format)) {
-					case 1: _scale_nearest<1, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 2: _scale_nearest<2, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 3: _scale_nearest<3, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_nearest<4, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 1: _scale(_scale_nearest<1, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _scale(_scale_nearest<2, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 3: _scale(_scale_nearest<3, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _scale(_scale_nearest<4, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 				switch (get_format_pixel_size(format)) {
-					case 4: _scale_nearest<1, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_nearest<2, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 12: _scale_nearest<3, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 16: _scale_nearest<4, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _scale(_scale_nearest<1, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _scale(_scale_nearest<2, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 12: _scale(_scale_nearest<3, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 16: _scale(_scale_nearest<4, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 
 			} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 				switch (get_format_pixel_size(format)) {
-					case 2: _scale_nearest<1, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_nearest<2, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 6: _scale_nearest<3, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_nearest<4, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _scale(_scale_nearest<1, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _scale(_scale_nearest<2, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 6: _scale(_scale_nearest<3, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _scale(_scale_nearest<4, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			}
 
@@ -1000,24 +1106,24 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 				if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 					switch (get_format_pixel_size(format)) {
-						case 1: _scale_bilinear<1, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 2: _scale_bilinear<2, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 3: _scale_bilinear<3, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 4: _scale_bilinear<4, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 1: _scale(_scale_bilinear<1, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 2: _scale(_scale_bilinear<2, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 3: _scale(_scale_bilinear<3, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 4: _scale(_scale_bilinear<4, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
 					}
 				} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 					switch (get_format_pixel_size(format)) {
-						case 4: _scale_bilinear<1, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 8: _scale_bilinear<2, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 12: _scale_bilinear<3, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 16: _scale_bilinear<4, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 4: _scale(_scale_bilinear<1, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 8: _scale(_scale_bilinear<2, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 12: _scale(_scale_bilinear<3, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 16: _scale(_scale_bilinear<4, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
 					}
 				} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 					switch (get_format_pixel_size(format)) {
-						case 2: _scale_bilinear<1, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 4: _scale_bilinear<2, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 6: _scale_bilinear<3, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 8: _scale_bilinear<4, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 2: _scale(_scale_bilinear<1, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 4: _scale(_scale_bilinear<2, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 6: _scale(_scale_bilinear<3, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 8: _scale(_scale_bilinear<4, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
 					}
 				}
 			}
@@ -1033,24 +1139,24 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 			if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 				switch (get_format_pixel_size(format)) {
-					case 1: _scale_cubic<1, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 2: _scale_cubic<2, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 3: _scale_cubic<3, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_cubic<4, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 1: _scale(_scale_cubic<1, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _scale(_scale_cubic<2, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 3: _scale(_scale_cubic<3, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _scale(_scale_cubic<4, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 				switch (get_format_pixel_size(format)) {
-					case 4: _scale_cubic<1, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_cubic<2, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 12: _scale_cubic<3, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 16: _scale_cubic<4, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _scale(_scale_cubic<1, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _scale(_scale_cubic<2, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 12: _scale(_scale_cubic<3, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 16: _scale(_scale_cubic<4, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 				switch (get_format_pixel_size(format)) {
-					case 2: _scale_cubic<1, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_cubic<2, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 6: _scale_cubic<3, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_cubic<4, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _scale(_scale_cubic<1, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _scale(_scale_cubic<2, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 6: _scale(_scale_cubic<3, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _scale(_scale_cubic<4, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			}
 		} break;
@@ -1267,40 +1373,119 @@ bool Image::_can_modify(Format p_format) const {
 	return p_format <= FORMAT_RGBE9995;
 }
 
+//2x2 box filter of whole pixels, returns how many destination pixels of the row it did
+template <class Component, int CC>
+static _FORCE_INLINE_ uint32_t _average_row_simd(const Component *p_up, const Component *p_down, Component *p_dst, uint32_t p_count) {
+	return 0;
+}
+
+#if defined(IMAGE_SSE2) || defined(IMAGE_NEON)
+template <>
+_FORCE_INLINE_ uint32_t _average_row_simd<uint8_t, 4>(const uint8_t *p_up, const uint8_t *p_down, uint8_t *p_dst, uint32_t p_count) {
+
+	//two destination pixels from four source pixels of each row, rounded like average_4_uint8
+	uint32_t done = 0;
+	for (; done + 2 <= p_count; done += 2) {
+#ifdef IMAGE_SSE2
+		__m128i zero = _mm_setzero_si128();
+		__m128i up = _mm_loadu_si128((const __m128i *)&p_up[done * 8]);
+		__m128i down = _mm_loadu_si128((const __m128i *)&p_down[done * 8]);
+		__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(up, zero), _mm_unpacklo_epi8(down, zero));
+		__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(up, zero), _mm_unpackhi_epi8(down, zero));
+		__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+		sum = _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+		_mm_storel_epi64((__m128i *)&p_dst[done * 4], _mm_packus_epi16(sum, sum));
+#else
+		uint8x16_t up = vld1q_u8(&p_up[done * 8]);
+		uint8x16_t down = vld1q_u8(&p_down[done * 8]);
+		uint16x8_t lo = vaddl_u8(vget_low_u8(up), vget_low_u8(down));
+		uint16x8_t hi = vaddl_u8(vget_high_u8(up), vget_high_u8(down));
+		uint16x8_t sum = vcombine_u16(vadd_u16(vget_low_u16(lo), vget_high_u16(lo)), vadd_u16(vget_low_u16(hi), vget_high_u16(hi)));
+		vst1_u8(&p_dst[done * 4], vrshrn_n_u16(sum, 2));
+#endif
+	}
+	return done;
+}
+
+template <>
+_FORCE_INLINE_ uint32_t _average_row_simd<float, 4>(const float *p_up, const float *p_down, float *p_dst, uint32_t p_count) {
+
+	//summed in the same order as average_4_float, so results don't change
+	for (uint32_t i = 0; i < p_count; i++) {
+#ifdef IMAGE_SSE2
+		__m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_loadu_ps(&p_up[i * 8]), _mm_loadu_ps(&p_up[i * 8 + 4])), _mm_loadu_ps(&p_down[i * 8])), _mm_loadu_ps(&p_down[i * 8 + 4]));
+		_mm_storeu_ps(&p_dst[i * 4], _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+		float32x4_t sum = vaddq_f32(vaddq_f32(vaddq_f32(vld1q_f32(&p_up[i * 8]), vld1q_f32(&p_up[i * 8 + 4])), vld1q_f32(&p_down[i * 8])), vld1q_f32(&p_down[i * 8 + 4]));
+		vst1q_f32(&p_dst[i * 4], vmulq_n_f32(sum, 0.25f));
+#endif
+	}
+	return p_count;
+}
+#endif
+
 template <class Component, int CC, bool renormalize,
 		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
 		void (*renormalize_func)(Component *)>
-static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+struct ImageMipmapRows {
 
-	//fast power of 2 mipmap generation
-	uint32_t dst_w = MAX(p_width >> 1, 1);
-	uint32_t dst_h = MAX(p_height >> 1, 1);
+	const Component *src;
+	Component *dst;
+	uint32_t width;
+	uint32_t height;
 
-	int right_step = (p_width == 1) ? 0 : CC;
-	int down_step = (p_height == 1) ? 0 : (p_width * CC);
+	void process_rows(uint32_t p_from, uint32_t p_to) {
 
-	for (uint32_t i = 0; i < dst_h; i++) {
+		uint32_t dst_w = MAX(width >> 1, 1);
 
-		const Component *rup_ptr = &p_src[i * 2 * down_step];
-		const Component *rdown_ptr = rup_ptr + down_step;
-		Component *dst_ptr = &p_dst[i * dst_w * CC];
-		uint32_t count = dst_w;
+		int right_step = (width == 1) ? 0 : CC;
+		int down_step = (height == 1) ? 0 : (width * CC);
 
-		while (count) {
-			count--;
-			for (int j = 0; j < CC; j++) {
-				average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
-			}
+		for (uint32_t i = p_from; i < p_to; i++) {
+
+			const Component *rup_ptr = &src[i * 2 * down_step];
+			const Component *rdown_ptr = rup_ptr + down_step;
+			Component *dst_ptr = &dst[i * dst_w * CC];
+			uint32_t count = dst_w;
 
-			if (renormalize) {
-				renormalize_func(dst_ptr);
+			if (!renormalize && right_step) {
+				uint32_t done = _average_row_simd<Component, CC>(rup_ptr, rdown_ptr, dst_ptr, count);
+				count -= done;
+				dst_ptr += done * CC;
+				rup_ptr += done * CC * 2;
+				rdown_ptr += done * CC * 2;
 			}
 
-			dst_ptr += CC;
-			rup_ptr += right_step * 2;
-			rdown_ptr += right_step * 2;
+			while (count) {
+				count--;
+				for (int j = 0; j < CC; j++) {
+					average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
+				}
+
+				if (renormalize) {
+					renormalize_func(dst_ptr);
+				}
+
+				dst_ptr += CC;
+				rup_ptr += right_step * 2;
+				rdown_ptr += right_step * 2;
+			}
 		}
 	}
+};
+
+template <class Component, int CC, bool renormalize,
+		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
+		void (*renormalize_func)(Component *)>
+static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+
+	//fast power of 2 mipmap generation
+	ImageMipmapRows<Component, CC, renormalize, average_func, renormalize_func> mr;
+	mr.src = p_src;
+	mr.dst = p_dst;
+	mr.width = p_width;
+	mr.height = p_height;
+	_process_rows(mr, MAX(p_height >> 1, 1), MAX(p_width >> 1, 1) * 4);
 }
 
 void Image::expand_x2_hq2x() {
@@ -1444,7 +1629,68 @@ void Image::normalize() {
 	}
 }
 
-Error Image::generate_mipmaps(bool p_renormalize) {
+template <class T, int CC>
+static void _renormalize_pixels(T *p_data, uint32_t p_count, void (*p_renormalize)(T *)) {
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_renormalize(&p_data[i * CC]);
+	}
+}
+
+bool Image::_generate_mipmap_lanczos(Format p_format, bool p_renormalize, const uint8_t *p_src, uint8_t *p_dst, int p_src_width, int p_src_height, int p_dst_width, int p_dst_height) {
+
+	uint32_t count = p_dst_width * p_dst_height;
+
+	switch (p_format) {
+
+		case FORMAT_L8:
+		case FORMAT_R8: _scale_lanczos<1, uint8_t>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height); break;
+		case FORMAT_LA8:
+		case FORMAT_RG8: _scale_lanczos<2, uint8_t>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height); break;
+		case FORMAT_RGB8:
+			_scale_lanczos<3, uint8_t>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height);
+			if (p_renormalize)
+				_renormalize_pixels<uint8_t, 3>(p_dst, count, renormalize_uint8);
+			break;
+		case FORMAT_RGBA8:
+			_scale_lanczos<4, uint8_t>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height);
+			if (p_renormalize)
+				_renormalize_pixels<uint8_t, 4>(p_dst, count, renormalize_uint8);
+			break;
+		case FORMAT_RF: _scale_lanczos<1, float>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height); break;
+		case FORMAT_RGF: _scale_lanczos<2, float>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height); break;
+		case FORMAT_RGBF:
+			_scale_lanczos<3, float>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height);
+			if (p_renormalize)
+				_renormalize_pixels<float, 3>(reinterpret_cast<float *>(p_dst), count, renormalize_float);
+			break;
+		case FORMAT_RGBAF:
+			_scale_lanczos<4, float>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height);
+			if (p_renormalize)
+				_renormalize_pixels<float, 4>(reinterpret_cast<float *>(p_dst), count, renormalize_float);
+			break;
+		case FORMAT_RH: _scale_lanczos<1, uint16_t>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height); break;
+		case FORMAT_RGH: _scale_lanczos<2, uint16_t>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height); break;
+		case FORMAT_RGBH:
+			_scale_lanczos<3, uint16_t>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height);
+			if (p_renormalize)
+				_renormalize_pixels<uint16_t, 3>(reinterpret_cast<uint16_t *>(p_dst), count, renormalize_half);
+			break;
+		case FORMAT_RGBAH:
+			_scale_lanczos<4, uint16_t>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height);
+			if (p_renormalize)
+				_renormalize_pixels<uint16_t, 4>(reinterpret_cast<uint16_t *>(p_dst), count, renormalize_half);
+			break;
+		default: {
+			//shared exponent formats can't be filtered per channel, use the box filter
+			return false;
+		}
+	}
+
+	return true;
+}
+
+Error Image::generate_mipmaps(bool p_renormalize, Interpolation p_filter) {
 
 	ERR_FAIL_COND_V_MSG(!_can_modify(format), ERR_UNAVAILABLE, "Cannot generate mipmaps in compressed or custom image formats.");
 
@@ -1467,6 +1713,13 @@ Error Image::generate_mipmaps(bool p_renormalize) {
 		int ofs, w, h;
 		_get_mipmap_offset_and_size(i, ofs, w, h);
 
+		if (p_filter == INTERPOLATE_LANCZOS && _generate_mipmap_lanczos(format, p_renormalize, &wp[prev_ofs], &wp[ofs], prev_w, prev_h, w, h)) {
+			prev_ofs = ofs;
+			prev_w = w;
+			prev_h = h;
+			continue;
+		}
+
 		switch (format) {
 
 			case FORMAT_L8:
@@ -1985,6 +2238,7 @@ Error Image::compress(CompressMode p_mode, CompressSource p_source, float p_loss
 
 Image::Image(const char **p_xpm) {
 
+	threaded_load = NULL;
 	width = 0;
 	height = 0;
 	mipmaps = false;
@@ -1995,6 +2249,7 @@ Image::Image(const char **p_xpm) {
 
 Image::Image(int p_width, int p_height, bool p_use_mipmaps, Format p_format) {
 
+	threaded_load = NULL;
 	width = 0;
 	height = 0;
 	mipmaps = p_use_mipmaps;
@@ -2005,6 +2260,7 @@ Image::Image(int p_width, int p_height, bool p_use_mipmaps, Format p_format) {
 
 Image::Image(int p_width, int p_height, bool p_mipmaps, Format p_format, const PoolVector<uint8_t> &p_data) {
 
+	threaded_load = NULL;
 	width = 0;
 	height = 0;
 	mipmaps = p_mipmaps;
@@ -2316,6 +2572,8 @@ void Image::fill(const Color &c) {
 ImageMemLoadFunc Image::_png_mem_loader_func = NULL;
 ImageMemLoadFunc Image::_jpg_mem_loader_func = NULL;
 ImageMemLoadFunc Image::_webp_mem_loader_func = NULL;
+ImageMemLoadShrinkFunc Image::_jpg_mem_shrink_loader_func = NULL;
+ImageMemLoadShrinkFunc Image::_webp_mem_shrink_loader_func = NULL;
 
 void (*Image::_image_compress_bc_func)(Image *, float, Image::CompressSource) = NULL;
 void (*Image::_image_compress_bptc_func)(Image *, float, Image::CompressSource) = NULL;
@@ -2713,7 +2971,7 @@ void Image::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("crop", "width", "height"), &Image::crop);
 	ClassDB::bind_method(D_METHOD("flip_x"), &Image::flip_x);
 	ClassDB::bind_method(D_METHOD("flip_y"), &Image::flip_y);
-	ClassDB::bind_method(D_METHOD("generate_mipmaps", "renormalize"), &Image::generate_mipmaps, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("generate_mipmaps", "renormalize", "filter"), &Image::generate_mipmaps, DEFVAL(false), DEFVAL(INTERPOLATE_BILINEAR));
 	ClassDB::bind_method(D_METHOD("clear_mipmaps"), &Image::clear_mipmaps);
 
 	ClassDB::bind_method(D_METHOD("create", "width", "height", "use_mipmaps", "format"), &Image::_create_empty);
@@ -2763,6 +3021,12 @@ void Image::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_png_from_buffer", "buffer"), &Image::load_png_from_buffer);
 	ClassDB::bind_method(D_METHOD("load_jpg_from_buffer", "buffer"), &Image::load_jpg_from_buffer);
 	ClassDB::bind_method(D_METHOD("load_webp_from_buffer", "buffer"), &Image::load_webp_from_buffer);
+	ClassDB::bind_method(D_METHOD("load_from_buffer_threaded", "buffer", "shrink"), &Image::load_from_buffer_threaded, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("is_loading_threaded"), &Image::is_loading_threaded);
+
+	ClassDB::bind_method(D_METHOD("_threaded_load_done"), &Image::_threaded_load_done);
+
+	ADD_SIGNAL(MethodInfo("threaded_load_completed", PropertyInfo(Variant::INT, "error")));
 
 	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "_set_data", "_get_data");
 
@@ -3094,6 +3358,104 @@ Error Image::_load_from_buffer(const PoolVector<uint8_t> &p_array, ImageMemLoadF
 	return OK;
 }
 
+Ref<Image> Image::decode_buffer(const uint8_t *p_data, int p_size, int p_shrink) {
+
+	ERR_FAIL_COND_V(p_size < 4, Ref<Image>());
+	ERR_FAIL_COND_V(p_shrink < 0, Ref<Image>());
+
+	static const uint8_t png_signature[4] = { 0x89, 'P', 'N', 'G' };
+	static const uint8_t jpg_signature[3] = { 0xFF, 0xD8, 0xFF };
+
+	ImageMemLoadFunc loader = NULL;
+	ImageMemLoadShrinkFunc shrink_loader = NULL;
+	if (memcmp(p_data, png_signature, 4) == 0) {
+		loader = _png_mem_loader_func;
+	} else if (memcmp(p_data, jpg_signature, 3) == 0) {
+		loader = _jpg_mem_loader_func;
+		shrink_loader = _jpg_mem_shrink_loader_func;
+	} else if (p_size >= 12 && memcmp(p_data, "RIFF", 4) == 0 && memcmp(p_data + 8, "WEBP", 4) == 0) {
+		loader = _webp_mem_loader_func;
+		shrink_loader = _webp_mem_shrink_loader_func;
+	}
+
+	ERR_FAIL_COND_V_MSG(!loader, Ref<Image>(), "Unrecognized or unsupported image format.");
+
+	if (p_shrink > 0 && shrink_loader) {
+		return shrink_loader(p_data, p_size, p_shrink);
+	}
+
+	Ref<Image> image = loader(p_data, p_size);
+	for (int i = 0; i < p_shrink && image.is_valid() && image->get_width() > 1 && image->get_height() > 1; i++) {
+		image->shrink_x2();
+	}
+
+	return image;
+}
+
+struct Image::ThreadedLoad {
+
+	ObjectID image;
+	PoolVector<uint8_t> buffer;
+	int shrink;
+	Ref<Image> result;
+	WorkerThreadPool::TaskID task;
+};
+
+void Image::_threaded_load_task(void *p_userdata, uint32_t p_index) {
+
+	//the target image is never touched here, it might be freed while this runs
+	ThreadedLoad *load = (ThreadedLoad *)p_userdata;
+
+	{
+		PoolVector<uint8_t>::Read r = load->buffer.read();
+		load->result = decode_buffer(r.ptr(), load->buffer.size(), load->shrink);
+	}
+	load->buffer = PoolVector<uint8_t>();
+
+	MessageQueue::get_singleton()->push_call(load->image, "_threaded_load_done");
+}
+
+void Image::_threaded_load_done() {
+
+	ERR_FAIL_COND(!threaded_load);
+
+	ThreadedLoad *load = threaded_load;
+	threaded_load = NULL;
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(load->task);
+
+	Ref<Image> result = load->result;
+	memdelete(load);
+
+	if (result.is_valid()) {
+		copy_internals_from(result);
+		emit_changed();
+	}
+
+	emit_signal("threaded_load_completed", result.is_valid() ? OK : ERR_PARSE_ERROR);
+}
+
+Error Image::load_from_buffer_threaded(const PoolVector<uint8_t> &p_array, int p_shrink) {
+
+	ERR_FAIL_COND_V(p_array.size() == 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_shrink < 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(threaded_load, ERR_BUSY, "A threaded load is already in progress for this image.");
+
+	ThreadedLoad *load = memnew(ThreadedLoad);
+	load->image = get_instance_id();
+	load->buffer = p_array;
+	load->shrink = p_shrink;
+
+	threaded_load = load;
+	load->task = WorkerThreadPool::get_singleton()->add_native_task(&Image::_threaded_load_task, load);
+
+	return OK;
+}
+
+bool Image::is_loading_threaded() const {
+
+	return threaded_load != NULL;
+}
+
 void Image::average_4_uint8(uint8_t &p_out, const uint8_t &p_a, const uint8_t &p_b, const uint8_t &p_c, const uint8_t &p_d) {
 	p_out = static_cast<uint8_t>((p_a + p_b + p_c + p_d + 2) >> 2);
 }
@@ -3145,6 +3507,7 @@ void Image::renormalize_rgbe9995(uint32_t *p_rgb) {
 
 Image::Image(const uint8_t *p_mem_png_jpg, int p_len) {
 
+	threaded_load = NULL;
 	width = 0;
 	height = 0;
 	mipmaps = false;
@@ -3169,6 +3532,7 @@ Ref<Resource> Image::duplicate(bool p_subresources) const {
 
 Image::Image() {
 
+	threaded_load = NULL;
 	width = 0;
 	height = 0;
 	mipmaps = false;
@@ -3180,4 +3544,10 @@ Image::~Image() {
 	if (write_lock.ptr()) {
 		unlock();
 	}
+
+	if (threaded_load) {
+		//the completion call is dropped along with this image
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(threaded_load->task);
+		memdelete(threaded_load);
+	}
 }
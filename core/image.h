@@ -48,6 +48,7 @@ class Image;
 
 typedef Error (*SavePNGFunc)(const String &p_path, const Ref<Image> &p_img);
 typedef Ref<Image> (*ImageMemLoadFunc)(const uint8_t *p_png, int p_size);
+typedef Ref<Image> (*ImageMemLoadShrinkFunc)(const uint8_t *p_data, int p_size, int p_shrink);
 
 typedef Error (*SaveEXRFunc)(const String &p_path, const Ref<Image> &p_img, bool p_grayscale);
 
@@ -130,6 +131,10 @@ public:
 	static ImageMemLoadFunc _jpg_mem_loader_func;
 	static ImageMemLoadFunc _webp_mem_loader_func;
 
+	//optional, decode straight to a size reduced by 1 << p_shrink, otherwise the full decode is shrunk
+	static ImageMemLoadShrinkFunc _jpg_mem_shrink_loader_func;
+	static ImageMemLoadShrinkFunc _webp_mem_shrink_loader_func;
+
 	static void (*_image_compress_bc_func)(Image *, float, CompressSource p_source);
 	static void (*_image_compress_bptc_func)(Image *, float p_lossy_quality, CompressSource p_source);
 	static void (*_image_compress_pvrtc2_func)(Image *);
@@ -188,6 +193,12 @@ private:
 
 	Error _load_from_buffer(const PoolVector<uint8_t> &p_array, ImageMemLoadFunc p_loader);
 
+	struct ThreadedLoad;
+	ThreadedLoad *threaded_load;
+
+	static void _threaded_load_task(void *p_userdata, uint32_t p_index);
+	void _threaded_load_done();
+
 	static void average_4_uint8(uint8_t &p_out, const uint8_t &p_a, const uint8_t &p_b, const uint8_t &p_c, const uint8_t &p_d);
 	static void average_4_float(float &p_out, const float &p_a, const float &p_b, const float &p_c, const float &p_d);
 	static void average_4_half(uint16_t &p_out, const uint16_t &p_a, const uint16_t &p_b, const uint16_t &p_c, const uint16_t &p_d);
@@ -197,6 +208,8 @@ private:
 	static void renormalize_half(uint16_t *p_rgb);
 	static void renormalize_rgbe9995(uint32_t *p_rgb);
 
+	static bool _generate_mipmap_lanczos(Format p_format, bool p_renormalize, const uint8_t *p_src, uint8_t *p_dst, int p_src_width, int p_src_height, int p_dst_width, int p_dst_height);
+
 public:
 	int get_width() const; ///< Get image width
 	int get_height() const; ///< Get image height
@@ -237,8 +250,9 @@ public:
 
 	/**
 	 * Generate a mipmap to an image (creates an image 1/4 the size, with averaging of 4->1)
+	 * INTERPOLATE_LANCZOS filters each level with a lanczos kernel instead of the 2x2 box
 	 */
-	Error generate_mipmaps(bool p_renormalize = false);
+	Error generate_mipmaps(bool p_renormalize = false, Interpolation p_filter = INTERPOLATE_BILINEAR);
 
 	void clear_mipmaps();
 	void normalize(); //for normal maps
@@ -329,10 +343,15 @@ public:
 	Error load_jpg_from_buffer(const PoolVector<uint8_t> &p_array);
 	Error load_webp_from_buffer(const PoolVector<uint8_t> &p_array);
 
+	static Ref<Image> decode_buffer(const uint8_t *p_data, int p_size, int p_shrink = 0);
+	Error load_from_buffer_threaded(const PoolVector<uint8_t> &p_array, int p_shrink = 0);
+	bool is_loading_threaded() const;
+
 	Image(const uint8_t *p_mem_png_jpg, int p_len = -1);
 	Image(const char **p_xpm);
 
 	virtual Ref<Resource> duplicate(bool p_subresources = false) const;
+	virtual uint64_t get_memory_usage() const { return data.size(); }
 
 	void lock();
 	void unlock();
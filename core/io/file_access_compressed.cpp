@@ -30,7 +30,10 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
+#include "core/os/copymem.h"
 #include "core/print_string.h"
+#include "core/project_settings.h"
 
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, int p_block_size) {
 
@@ -43,7 +46,65 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	}
 
 	cmode = p_mode;
-	block_size = p_block_size;
+	block_size = p_block_size > 0 ? p_block_size : MAX(int(GLOBAL_GET("compression/formats/compressed_files/block_size")), 256);
+}
+
+void FileAccessCompressed::_decompress_slot(void *p_slot, uint32_t p_index) {
+
+	ReadAheadSlot *slot = (ReadAheadSlot *)p_slot;
+	Compression::decompress(slot->data.ptrw(), slot->size, slot->comp.ptr(), slot->csize, slot->mode);
+}
+
+void FileAccessCompressed::_fill_slot(ReadAheadSlot &p_slot, int p_block) const {
+
+	p_slot.block = p_block;
+	p_slot.csize = read_blocks[p_block].csize;
+	p_slot.size = read_blocks.size() == 1 ? read_total : block_size;
+	p_slot.mode = cmode;
+	f->seek(read_blocks[p_block].offset);
+	f->get_buffer(p_slot.comp.ptrw(), p_slot.csize);
+}
+
+void FileAccessCompressed::_wait_slot(ReadAheadSlot &p_slot) const {
+
+	if (p_slot.task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_slot.task);
+		p_slot.task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+void FileAccessCompressed::_read_block(int p_block) const {
+
+	read_block = p_block;
+	read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+
+	if (!read_ahead) {
+		f->seek(read_blocks[p_block].offset);
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[p_block].csize);
+		Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[p_block].csize, cmode);
+		return;
+	}
+
+	ReadAheadSlot &slot = read_ahead[p_block % READ_AHEAD_BLOCKS];
+	_wait_slot(slot);
+	if (slot.block != p_block) {
+		//not read ahead (first block or a seek), decompress it right away
+		_fill_slot(slot, p_block);
+		_decompress_slot(&slot, 0);
+	}
+	read_ptr = slot.data.ptrw();
+
+	//queue the blocks that follow, their compressed data is read here so the file is only used by this thread
+	for (int i = 1; i < READ_AHEAD_BLOCKS && p_block + i < read_block_count; i++) {
+
+		ReadAheadSlot &next = read_ahead[(p_block + i) % READ_AHEAD_BLOCKS];
+		if (next.block == p_block + i) {
+			continue;
+		}
+		_wait_slot(next);
+		_fill_slot(next, p_block + i);
+		next.task = WorkerThreadPool::get_singleton()->add_native_task(&_decompress_slot, &next);
+	}
 }
 
 #define WRITE_FIT(m_bytes)                                  \
@@ -77,22 +138,103 @@ Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 		read_blocks.push_back(rb);
 	}
 
-	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
 
-	Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
+	if (bc > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		read_ahead = memnew_arr(ReadAheadSlot, READ_AHEAD_BLOCKS);
+		for (int i = 0; i < READ_AHEAD_BLOCKS; i++) {
+			read_ahead[i].block = -1;
+			read_ahead[i].comp.resize(max_bs);
+			read_ahead[i].data.resize(block_size);
+			read_ahead[i].task = WorkerThreadPool::INVALID_TASK_ID;
+		}
+	} else {
+		comp_buffer.resize(max_bs);
+		buffer.resize(block_size);
+		read_ptr = buffer.ptrw();
+	}
+
+	_read_block(0);
 	read_pos = 0;
 
 	return OK;
 }
 
+struct FileAccessCompressedBlocks {
+
+	const uint8_t *src;
+	uint32_t size;
+	uint32_t block_size;
+	Compression::Mode mode;
+	Vector<uint8_t> *blocks;
+
+	void compress_block(uint32_t p_index, void *) {
+
+		uint32_t ofs = p_index * block_size;
+		int bl = MIN(block_size, size - ofs);
+		Vector<uint8_t> &cblock = blocks[p_index];
+		cblock.resize(Compression::get_max_compressed_buffer_size(bl, mode));
+		int s = Compression::compress(cblock.ptrw(), &src[ofs], bl, mode);
+		cblock.resize(s);
+	}
+};
+
+Vector<uint8_t> FileAccessCompressed::compress_buffer(const String &p_magic, const uint8_t *p_data, uint32_t p_size, Compression::Mode p_mode, int p_block_size) {
+
+	FileAccessCompressed fac;
+	fac.configure(p_magic, p_mode, p_block_size); //pads the magic and resolves the block size
+
+	uint32_t bc = (p_size / fac.block_size) + 1;
+
+	//blocks are independent, so they are compressed in parallel
+	Vector<Vector<uint8_t> > blocks;
+	blocks.resize(bc);
+
+	FileAccessCompressedBlocks cb;
+	cb.src = p_data;
+	cb.size = p_size;
+	cb.block_size = fac.block_size;
+	cb.mode = p_mode;
+	cb.blocks = blocks.ptrw();
+
+	if (bc > 1 && WorkerThreadPool::get_singleton()) {
+		WorkerThreadPool::get_singleton()->parallel_for(bc, &cb, &FileAccessCompressedBlocks::compress_block, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < bc; i++) {
+			cb.compress_block(i, NULL);
+		}
+	}
+
+	uint32_t total = 4 + 4 + 4 + 4 + bc * 4 + 4;
+	for (uint32_t i = 0; i < bc; i++) {
+		total += blocks[i].size();
+	}
+
+	Vector<uint8_t> ret;
+	ret.resize(total);
+	uint8_t *w = ret.ptrw();
+
+	CharString mgc = fac.magic.utf8();
+	copymem(w, mgc.get_data(), 4); //write header 4
+	encode_uint32(p_mode, &w[4]); //write compression mode 4
+	encode_uint32(fac.block_size, &w[8]); //write block size 4
+	encode_uint32(p_size, &w[12]); //max amount of data written 4
+	uint32_t ofs = 16;
+	for (uint32_t i = 0; i < bc; i++) {
+		encode_uint32(blocks[i].size(), &w[ofs]); //compressed sizes
+		ofs += 4;
+	}
+	for (uint32_t i = 0; i < bc; i++) {
+		copymem(&w[ofs], blocks[i].ptr(), blocks[i].size());
+		ofs += blocks[i].size();
+	}
+	copymem(&w[ofs], mgc.get_data(), 4); //magic at the end too
+
+	return ret;
+}
+
 Error FileAccessCompressed::_open(const String &p_path, int p_mode_flags) {
 
 	ERR_FAIL_COND_V(p_mode_flags == READ_WRITE, ERR_UNAVAILABLE);
@@ -144,41 +286,20 @@ void FileAccessCompressed::close() {
 	if (writing) {
 		//save block table and all compressed blocks
 
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		int bc = (write_max / block_size) + 1;
-
-		for (int i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		Vector<int> block_sizes;
-		for (int i = 0; i < bc; i++) {
-
-			int bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (int i = 0; i < bc; i++)
-			f->store_32(block_sizes[i]);
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+		Vector<uint8_t> data = compress_buffer(magic, write_ptr, write_max, cmode, block_size);
+		f->store_buffer(data.ptr(), data.size());
 
 		buffer.clear();
 
 	} else {
 
+		if (read_ahead) {
+			for (int i = 0; i < READ_AHEAD_BLOCKS; i++) {
+				_wait_slot(read_ahead[i]);
+			}
+			memdelete_arr(read_ahead);
+			read_ahead = NULL;
+		}
 		comp_buffer.clear();
 		buffer.clear();
 		read_blocks.clear();
@@ -213,11 +334,7 @@ void FileAccessCompressed::seek(size_t p_position) {
 			int block_idx = p_position / block_size;
 			if (block_idx != read_block) {
 
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				_read_block(block_idx);
 			}
 
 			read_pos = p_position % block_size;
@@ -282,17 +399,13 @@ uint8_t FileAccessCompressed::get_8() const {
 
 	read_pos++;
 	if (read_pos >= read_block_size) {
-		read_block++;
 
-		if (read_block < read_block_count) {
+		if (read_block + 1 < read_block_count) {
 			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+			_read_block(read_block + 1);
 			read_pos = 0;
 
 		} else {
-			read_block--;
 			at_end = true;
 		}
 	}
@@ -309,26 +422,26 @@ int FileAccessCompressed::get_buffer(uint8_t *p_dst, int p_length) const {
 		return 0;
 	}
 
-	for (int i = 0; i < p_length; i++) {
+	int read = 0;
+	while (read < p_length) {
+
+		int to_copy = MIN(read_block_size - read_pos, p_length - read);
+		copymem(&p_dst[read], &read_ptr[read_pos], to_copy);
+		read += to_copy;
+		read_pos += to_copy;
 
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
 		if (read_pos >= read_block_size) {
-			read_block++;
 
-			if (read_block < read_block_count) {
+			if (read_block + 1 < read_block_count) {
 				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				_read_block(read_block + 1);
 				read_pos = 0;
 
 			} else {
-				read_block--;
 				at_end = true;
-				if (i < p_length - 1)
+				if (read < p_length)
 					read_eof = true;
-				return i;
+				return read;
 			}
 		}
 	}
@@ -402,6 +515,7 @@ FileAccessCompressed::FileAccessCompressed() :
 		read_block_size(0),
 		read_pos(0),
 		read_total(0),
+		read_ahead(NULL),
 		magic("GCMP"),
 		f(NULL) {
 }
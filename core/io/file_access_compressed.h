@@ -33,6 +33,7 @@
 
 #include "core/io/compression.h"
 #include "core/os/file_access.h"
+#include "core/os/worker_thread_pool.h"
 
 class FileAccessCompressed : public FileAccess {
 
@@ -52,7 +53,7 @@ class FileAccessCompressed : public FileAccess {
 	};
 
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr;
+	mutable uint8_t *read_ptr;
 	mutable int read_block;
 	int read_block_count;
 	mutable int read_block_size;
@@ -60,15 +61,39 @@ class FileAccessCompressed : public FileAccess {
 	Vector<ReadBlock> read_blocks;
 	uint32_t read_total;
 
+	enum {
+		READ_AHEAD_BLOCKS = 4 //the block being read plus the ones decompressed ahead of it on worker threads
+	};
+
+	struct ReadAheadSlot {
+		int block;
+		Vector<uint8_t> comp;
+		Vector<uint8_t> data;
+		int csize;
+		int size;
+		Compression::Mode mode;
+		WorkerThreadPool::TaskID task;
+	};
+
+	ReadAheadSlot *read_ahead; //NULL when blocks are decompressed on demand only
+
+	static void _decompress_slot(void *p_slot, uint32_t p_index);
+	void _fill_slot(ReadAheadSlot &p_slot, int p_block) const;
+	void _wait_slot(ReadAheadSlot &p_slot) const;
+	void _read_block(int p_block) const;
+
 	String magic;
 	mutable Vector<uint8_t> buffer;
 	FileAccess *f;
 
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 4096);
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 0); //a block size of 0 uses the project setting
 
 	Error open_after_magic(FileAccess *p_base);
 
+	//the layout written on close, including the magic at both ends, built from a buffer in memory
+	static Vector<uint8_t> compress_buffer(const String &p_magic, const uint8_t *p_data, uint32_t p_size, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 0);
+
 	virtual Error _open(const String &p_path, int p_mode_flags); ///< open a file
 	virtual void close(); ///< close a file
 	virtual bool is_open() const; ///< true when file is open
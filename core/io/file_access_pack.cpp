@@ -30,12 +30,17 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
+#include "core/io/marshalls.h"
+#include "core/os/copymem.h"
 #include "core/version.h"
 
 #include <stdio.h>
 
 Error PackedData::add_pack(const String &p_path, bool p_replace_files) {
 
+	current_layer++;
+
 	for (int i = 0; i < sources.size(); i++) {
 
 		if (sources[i]->try_open_pack(p_path, p_replace_files)) {
@@ -47,7 +52,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files) {
 	return ERR_FILE_UNRECOGNIZED;
 };
 
-void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files) {
+void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, uint32_t p_flags) {
 
 	PathMD5 pmd5(path.md5_buffer());
 	//printf("adding path %ls, %lli, %lli\n", path.c_str(), pmd5.a, pmd5.b);
@@ -60,40 +65,222 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 	pf.size = size;
 	for (int i = 0; i < 16; i++)
 		pf.md5[i] = p_md5[i];
+	pf.flags = p_flags;
 	pf.src = p_src;
+	pf.layer = current_layer;
+	pf.replace_files = p_replace_files;
 
 	if (!exists || p_replace_files)
 		files[pmd5] = pf;
 
 	if (!exists) {
-		//search for dir
-		String p = path.replace_first("res://", "");
-		PackedDir *cd = root;
+		_add_dir_path(path);
+	}
+}
+
+void PackedData::_add_dir_path(const String &p_path) {
+
+	//search for dir
+	String p = p_path.replace_first("res://", "");
+	PackedDir *cd = root;
+
+	if (p.find("/") != -1) { //in a subdir
+
+		Vector<String> ds = p.get_base_dir().split("/");
+
+		for (int j = 0; j < ds.size(); j++) {
+
+			if (!cd->subdirs.has(ds[j])) {
+
+				PackedDir *pd = memnew(PackedDir);
+				pd->name = ds[j];
+				pd->parent = cd;
+				cd->subdirs[pd->name] = pd;
+				cd = pd;
+			} else {
+				cd = cd->subdirs[ds[j]];
+			}
+		}
+	}
+	String filename = p_path.get_file();
+	// Don't add as a file if the path points to a directory
+	if (!filename.empty()) {
+		cd->files.insert(filename);
+	}
+}
+
+void PackedData::add_pack_index(const String &p_pack, uint32_t p_version, const uint8_t *p_slots, const Vector<uint8_t> &p_buffer, uint32_t p_capacity, uint64_t p_dir_offset, uint32_t p_file_count, PackSource *p_src, bool p_replace_files) {
+
+	PackIndex *pi = memnew(PackIndex);
+	pi->pack = p_pack;
+	pi->version = p_version;
+	pi->buffer = p_buffer;
+	pi->slots = p_slots ? p_slots : pi->buffer.ptr();
+	pi->capacity = p_capacity;
+	pi->dir_offset = p_dir_offset;
+	pi->file_count = p_file_count;
+	pi->src = p_src;
+	pi->layer = current_layer;
+	pi->replace_files = p_replace_files;
+	pi->dirs_loaded = false;
+
+	indices.push_back(pi);
+	dirs_pending = true;
+}
+
+bool PackedData::_index_lookup(const PackIndex *p_index, const uint8_t *p_path_md5, PackedFile &r_file) const {
+
+	uint32_t pos = decode_uint64(p_path_md5) % p_index->capacity;
+	uint32_t slot_size = p_index->version >= 3 ? PACK_INDEX_SLOT_SIZE : PACK_INDEX_SLOT_SIZE_V2;
+
+	for (uint32_t i = 0; i < p_index->capacity; i++) {
+
+		const uint8_t *slot = p_index->slots + uint64_t(pos) * slot_size;
+		uint64_t ofs = decode_uint64(&slot[16]);
+		if (ofs == 0) {
+			return false; //empty slot ends the probe
+		}
+
+		if (memcmp(slot, p_path_md5, 16) == 0) {
+			r_file.pack = p_index->pack;
+			r_file.offset = ofs;
+			r_file.size = decode_uint64(&slot[24]);
+			copymem(r_file.md5, &slot[32], 16);
+			r_file.flags = p_index->version >= 3 ? decode_uint32(&slot[48]) : 0;
+			r_file.src = p_index->src;
+			r_file.layer = p_index->layer;
+			r_file.replace_files = p_index->replace_files;
+			return true;
+		}
+
+		pos = (pos + 1) % p_index->capacity;
+	}
+
+	return false;
+}
+
+bool PackedData::_find_file(const String &p_path, PackedFile &r_file) const {
 
-		if (p.find("/") != -1) { //in a subdir
+	Vector<uint8_t> md5 = p_path.md5_buffer();
+	const Map<PathMD5, PackedFile>::Element *E = files.find(PathMD5(md5));
+
+	if (indices.empty()) {
+		if (!E)
+			return false;
+		r_file = E->get();
+		return true;
+	}
 
-			Vector<String> ds = p.get_base_dir().split("/");
+	//walk the packs from the newest mount to the oldest, the first one found that
+	//replaces files wins, otherwise the file comes from the oldest pack having it
+	bool found = false;
+	bool map_pending = E != NULL;
+	PackedFile pf;
 
-			for (int j = 0; j < ds.size(); j++) {
+	for (int i = indices.size() - 1; i >= -1; i--) {
 
-				if (!cd->subdirs.has(ds[j])) {
+		int layer = i >= 0 ? indices[i]->layer : -1;
 
-					PackedDir *pd = memnew(PackedDir);
-					pd->name = ds[j];
-					pd->parent = cd;
-					cd->subdirs[pd->name] = pd;
-					cd = pd;
-				} else {
-					cd = cd->subdirs[ds[j]];
-				}
+		if (map_pending && E->get().layer > layer) {
+			map_pending = false;
+			r_file = E->get();
+			if (r_file.replace_files) {
+				return true;
 			}
+			found = true;
+		}
+
+		if (i < 0) {
+			break;
+		}
+
+		if (_index_lookup(indices[i], md5.ptr(), pf)) {
+			r_file = pf;
+			if (pf.replace_files) {
+				return true;
+			}
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+void PackedData::_load_dirs() {
+
+	for (int i = 0; i < indices.size(); i++) {
+
+		PackIndex *pi = indices[i];
+		if (pi->dirs_loaded) {
+			continue;
 		}
-		String filename = path.get_file();
-		// Don't add as a file if the path points to a directory
-		if (!filename.empty()) {
-			cd->files.insert(filename);
+		pi->dirs_loaded = true;
+
+		FileAccess *f = FileAccess::open(pi->pack, FileAccess::READ);
+		ERR_CONTINUE_MSG(!f, "Can't open pack '" + pi->pack + "' to list its files.");
+
+		f->seek(pi->dir_offset);
+
+		CharString cs;
+		for (uint32_t j = 0; j < pi->file_count; j++) {
+
+			uint32_t sl = f->get_32();
+			cs.resize(sl + 1);
+			f->get_buffer((uint8_t *)cs.ptr(), sl);
+			cs[sl] = 0;
+			f->seek(f->get_position() + 8 + 8 + 16 + (pi->version >= 3 ? 4 : 0)); //offset, size, md5 and flags are in the index
+
+			String path;
+			path.parse_utf8(cs.ptr());
+			_add_dir_path(path);
+		}
+
+		f->close();
+		memdelete(f);
+	}
+}
+
+PackedData::PackedDir *PackedData::_get_root() {
+
+	MutexLock lock(dirs_mutex);
+	if (dirs_pending) {
+		_load_dirs();
+		dirs_pending = false;
+	}
+
+	return root;
+}
+
+uint32_t PackedData::get_index_capacity(uint32_t p_file_count) {
+
+	//keeps the load factor around 0.75
+	return p_file_count + p_file_count / 3 + 1;
+}
+
+void PackedData::store_index_slot(uint8_t *r_slots, uint32_t p_capacity, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, uint32_t p_flags) {
+
+	ERR_FAIL_COND(p_ofs == 0);
+
+	Vector<uint8_t> path_md5 = p_path.md5_buffer();
+	uint32_t pos = decode_uint64(path_md5.ptr()) % p_capacity;
+
+	for (uint32_t i = 0; i < p_capacity; i++) {
+
+		uint8_t *slot = r_slots + uint64_t(pos) * PACK_INDEX_SLOT_SIZE;
+		if (decode_uint64(&slot[16]) == 0 || memcmp(slot, path_md5.ptr(), 16) == 0) {
+			copymem(slot, path_md5.ptr(), 16);
+			encode_uint64(p_ofs, &slot[16]);
+			encode_uint64(p_size, &slot[24]);
+			copymem(&slot[32], p_md5, 16);
+			encode_uint32(p_flags, &slot[48]);
+			encode_uint32(0, &slot[52]); //reserved
+			return;
 		}
+
+		pos = (pos + 1) % p_capacity;
 	}
+
+	ERR_FAIL_MSG("Pack index is full.");
 }
 
 void PackedData::add_pack_source(PackSource *p_source) {
@@ -111,6 +298,9 @@ PackedData::PackedData() {
 	root = memnew(PackedDir);
 	root->parent = NULL;
 	disabled = false;
+	current_layer = 0;
+	dirs_pending = false;
+	dirs_mutex = Mutex::create();
 
 	add_pack_source(memnew(PackedSourcePCK));
 }
@@ -127,7 +317,11 @@ PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
+	for (int i = 0; i < indices.size(); i++) {
+		memdelete(indices[i]);
+	}
 	_free_packed_dirs(root);
+	memdelete(dirs_mutex);
 }
 
 //////////////////////////////////////////////////////////////////
@@ -165,12 +359,14 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 		}
 	}
 
+	uint64_t pack_start = f->get_position() - 4;
+
 	uint32_t version = f->get_32();
 	uint32_t ver_major = f->get_32();
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	if (version != PACK_FORMAT_VERSION) {
+	if (version < 1 || version > PACK_FORMAT_VERSION) {
 		f->close();
 		memdelete(f);
 		ERR_FAIL_V_MSG(false, "Pack version unsupported: " + itos(version) + ".");
@@ -181,13 +377,60 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 		ERR_FAIL_V_MSG(false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 	}
 
-	for (int i = 0; i < 16; i++) {
+	//version 2 keeps the index offset (relative to the pack start) and its capacity in the first reserved fields
+	uint64_t index_ofs = f->get_64();
+	uint32_t index_capacity = f->get_32();
+	for (int i = 3; i < 16; i++) {
 		//reserved
 		f->get_32();
 	}
 
 	int file_count = f->get_32();
 
+	//keep the pack open and mapped when the platform allows it, reads then become memcpy
+	const uint8_t *data = NULL;
+	bool keep_open = false;
+	if (!mapped_packs.has(p_path)) {
+		data = f->map_read_only();
+		if (data) {
+			MappedPack mp;
+			mp.f = f;
+			mp.data = data;
+			mp.len = f->get_len();
+			mapped_packs[p_path] = mp;
+			keep_open = true;
+		}
+	} else {
+		data = mapped_packs[p_path].data;
+	}
+
+	if (version >= 2 && index_capacity > 0) {
+
+		uint64_t index_size = uint64_t(index_capacity) * (version >= 3 ? PACK_INDEX_SLOT_SIZE : PACK_INDEX_SLOT_SIZE_V2);
+		uint64_t index_pos = pack_start + index_ofs;
+		bool valid = index_pos + index_size <= f->get_len();
+
+		if (valid) {
+			Vector<uint8_t> buffer;
+			if (!data) {
+				buffer.resize(index_size);
+				f->seek(index_pos);
+				valid = f->get_buffer(buffer.ptrw(), index_size) == int64_t(index_size);
+			}
+
+			if (valid) {
+				PackedData::get_singleton()->add_pack_index(p_path, version, data ? data + index_pos : NULL, buffer, index_capacity, pack_start + PACK_HEADER_SIZE, file_count, this, p_replace_files);
+			}
+		}
+
+		if (!keep_open) {
+			f->close();
+			memdelete(f);
+		}
+		ERR_FAIL_COND_V_MSG(!valid, false, "Pack '" + p_path + "' has a truncated file index.");
+		return true;
+	}
+
 	for (int i = 0; i < file_count; i++) {
 
 		uint32_t sl = f->get_32();
@@ -203,19 +446,51 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 		uint64_t size = f->get_64();
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
-		PackedData::get_singleton()->add_path(p_path, path, ofs, size, md5, this, p_replace_files);
+		uint32_t flags = version >= 3 ? f->get_32() : 0;
+		PackedData::get_singleton()->add_path(p_path, path, ofs, size, md5, this, p_replace_files, flags);
 	};
 
-	f->close();
-	memdelete(f);
+	if (!keep_open) {
+		f->close();
+		memdelete(f);
+	}
+
 	return true;
 };
 
 FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
 
-	return memnew(FileAccessPack(p_path, *p_file));
+	FileAccess *fa;
+	Map<String, MappedPack>::Element *E = mapped_packs.find(p_file->pack);
+	if (E && p_file->offset + p_file->size <= E->get().len) {
+		fa = memnew(FileAccessPack(p_path, *p_file, E->get().data));
+	} else {
+		fa = memnew(FileAccessPack(p_path, *p_file));
+	}
+
+	if (p_file->flags & PACK_FILE_COMPRESSED) {
+		//decompressed transparently, the stream takes over the packed file
+		uint8_t magic[4];
+		if (fa->get_buffer(magic, 4) != 4 || memcmp(magic, PACK_COMPRESSED_MAGIC, 4) != 0) {
+			memdelete(fa);
+			ERR_FAIL_V_MSG(NULL, "Compressed file '" + p_path + "' in pack '" + p_file->pack + "' is corrupt.");
+		}
+		FileAccessCompressed *fac = memnew(FileAccessCompressed);
+		fac->open_after_magic(fa);
+		return fac;
+	}
+
+	return fa;
 };
 
+PackedSourcePCK::~PackedSourcePCK() {
+
+	for (Map<String, MappedPack>::Element *E = mapped_packs.front(); E; E = E->next()) {
+		E->get().f->close();
+		memdelete(E->get().f);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
@@ -226,12 +501,18 @@ Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
 
 void FileAccessPack::close() {
 
-	f->close();
+	if (f) {
+		f->close();
+	}
+	data = NULL;
 }
 
 bool FileAccessPack::is_open() const {
 
-	return f->is_open();
+	if (f) {
+		return f->is_open();
+	}
+	return data != NULL;
 }
 
 void FileAccessPack::seek(size_t p_position) {
@@ -242,7 +523,9 @@ void FileAccessPack::seek(size_t p_position) {
 		eof = false;
 	}
 
-	f->seek(pf.offset + p_position);
+	if (f) {
+		f->seek(pf.offset + p_position);
+	}
 	pos = p_position;
 }
 void FileAccessPack::seek_end(int64_t p_position) {
@@ -270,6 +553,10 @@ uint8_t FileAccessPack::get_8() const {
 		return 0;
 	}
 
+	if (data) {
+		return data[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
@@ -285,18 +572,26 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 		to_read = int64_t(pf.size) - int64_t(pos);
 	}
 
+	size_t from = pos;
 	pos += p_length;
 
 	if (to_read <= 0)
 		return 0;
-	f->get_buffer(p_dst, to_read);
+
+	if (data) {
+		copymem(p_dst, data + from, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
-	f->set_endian_swap(p_swap);
+	if (f) {
+		f->set_endian_swap(p_swap);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -326,15 +621,22 @@ bool FileAccessPack::file_exists(const String &p_name) {
 	return false;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_pack_data) :
 		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pos(0),
+		eof(false),
+		f(NULL),
+		data(NULL) {
+
+	if (p_pack_data) {
+		data = p_pack_data + pf.offset;
+		return;
+	}
 
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(!f, "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	pos = 0;
-	eof = false;
 }
 
 FileAccessPack::~FileAccessPack() {
@@ -348,6 +650,8 @@ FileAccessPack::~FileAccessPack() {
 
 Error DirAccessPack::list_dir_begin() {
 
+	PackedData::get_singleton()->_get_root();
+
 	list_dirs.clear();
 	list_files.clear();
 
@@ -423,11 +727,9 @@ Error DirAccessPack::change_dir(String p_dir) {
 
 	Vector<String> paths = nd.split("/");
 
-	PackedData::PackedDir *pd;
+	PackedData::PackedDir *pd = PackedData::get_singleton()->_get_root();
 
-	if (absolute)
-		pd = PackedData::get_singleton()->root;
-	else
+	if (!absolute)
 		pd = current;
 
 	for (int i = 0; i < paths.size(); i++) {
@@ -471,6 +773,7 @@ bool DirAccessPack::file_exists(String p_file) {
 
 	p_file = fix_path(p_file);
 
+	PackedData::get_singleton()->_get_root();
 	return current->files.has(p_file);
 }
 
@@ -478,6 +781,7 @@ bool DirAccessPack::dir_exists(String p_dir) {
 
 	p_dir = fix_path(p_dir);
 
+	PackedData::get_singleton()->_get_root();
 	return current->subdirs.has(p_dir);
 }
 
@@ -33,6 +33,7 @@
 
 #include "core/list.h"
 #include "core/map.h"
+#include "core/os/mutex.h"
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
 #include "core/print_string.h"
@@ -40,7 +41,23 @@
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION 1
+// Version 2 adds a precomputed hash index of the files, version 3 adds per file flags.
+// Older packs are still read.
+#define PACK_FORMAT_VERSION 3
+// Size of the fixed header (magic, versions, reserved fields and file count), the directory follows it.
+#define PACK_HEADER_SIZE 88
+// Size of one slot of the hash index: path md5, offset, size, file md5, flags and a reserved field.
+#define PACK_INDEX_SLOT_SIZE 56
+// Slots of version 2 packs have no flags.
+#define PACK_INDEX_SLOT_SIZE_V2 48
+
+enum PackFileFlags {
+	// The stored data is a FileAccessCompressed stream, size is the stored size and md5 the one of the uncompressed data.
+	PACK_FILE_COMPRESSED = 1 << 0,
+};
+
+// Magic of the compressed streams stored in packs.
+#define PACK_COMPRESSED_MAGIC "GCPK"
 
 class PackSource;
 
@@ -56,7 +73,10 @@ public:
 		uint64_t offset; //if offset is ZERO, the file was ERASED
 		uint64_t size;
 		uint8_t md5[16];
+		uint32_t flags;
 		PackSource *src;
+		int layer; //order in which the owning pack was mounted
+		bool replace_files;
 	};
 
 private:
@@ -93,7 +113,24 @@ private:
 		};
 	};
 
+	//a version 2 pack, files are looked up in its hash index directly and
+	//the directory tree is only built from it when listing is needed
+	struct PackIndex {
+		String pack;
+		const uint8_t *slots;
+		Vector<uint8_t> buffer; //holds the slots when the pack is not mapped
+		uint32_t capacity;
+		uint32_t version;
+		uint64_t dir_offset;
+		uint32_t file_count;
+		PackSource *src;
+		int layer;
+		bool replace_files;
+		bool dirs_loaded;
+	};
+
 	Map<PathMD5, PackedFile> files;
+	Vector<PackIndex *> indices;
 
 	Vector<PackSource *> sources;
 
@@ -102,12 +139,25 @@ private:
 
 	static PackedData *singleton;
 	bool disabled;
+	int current_layer;
+	bool dirs_pending;
+	Mutex *dirs_mutex;
 
 	void _free_packed_dirs(PackedDir *p_dir);
+	void _add_dir_path(const String &p_path);
+	void _load_dirs();
+	PackedDir *_get_root();
+	bool _index_lookup(const PackIndex *p_index, const uint8_t *p_path_md5, PackedFile &r_file) const;
+	bool _find_file(const String &p_path, PackedFile &r_file) const;
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files); // for PackSource
+	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, uint32_t p_flags = 0); // for PackSource
+	void add_pack_index(const String &p_pack, uint32_t p_version, const uint8_t *p_slots, const Vector<uint8_t> &p_buffer, uint32_t p_capacity, uint64_t p_dir_offset, uint32_t p_file_count, PackSource *p_src, bool p_replace_files); // for PackSource, p_slots may point into p_buffer or a mapping
+
+	//helpers for the writers of the hash index (PCKPacker and the exporter)
+	static uint32_t get_index_capacity(uint32_t p_file_count);
+	static void store_index_slot(uint8_t *r_slots, uint32_t p_capacity, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, uint32_t p_flags = 0);
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -132,9 +182,20 @@ public:
 
 class PackedSourcePCK : public PackSource {
 
+	//packs kept open and mapped read only, files inside them are served as pointer ranges
+	struct MappedPack {
+		FileAccess *f;
+		const uint8_t *data;
+		uint64_t len;
+	};
+
+	Map<String, MappedPack> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files);
 	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file);
+
+	~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -145,6 +206,7 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 
 	FileAccess *f;
+	const uint8_t *data; //file contents when the pack is mapped, f is NULL then
 	virtual Error _open(const String &p_path, int p_mode_flags);
 	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
 	virtual uint32_t _get_unix_permissions(const String &p_file) { return 0; }
@@ -164,6 +226,7 @@ public:
 	virtual uint8_t get_8() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual const uint8_t *get_mapped_data() const { return data; }
 
 	virtual void set_endian_swap(bool p_swap);
 
@@ -176,25 +239,25 @@ public:
 
 	virtual bool file_exists(const String &p_name);
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_pack_data = NULL);
 	~FileAccessPack();
 };
 
 FileAccess *PackedData::try_open_path(const String &p_path) {
 
-	PathMD5 pmd5(p_path.md5_buffer());
-	Map<PathMD5, PackedFile>::Element *E = files.find(pmd5);
-	if (!E)
+	PackedFile pf;
+	if (!_find_file(p_path, pf))
 		return NULL; //not found
-	if (E->get().offset == 0)
+	if (pf.offset == 0)
 		return NULL; //was erased
 
-	return E->get().src->get_file(p_path, &E->get());
+	return pf.src->get_file(p_path, &pf);
 }
 
 bool PackedData::has_path(const String &p_path) {
 
-	return files.has(PathMD5(p_path.md5_buffer()));
+	PackedFile pf;
+	return _find_file(p_path, pf);
 }
 
 class DirAccessPack : public DirAccess {
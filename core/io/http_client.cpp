@@ -451,7 +451,7 @@ Error HTTPClient::poll() {
 						if (s.length() == 0)
 							continue;
 						if (s.begins_with("content-length:")) {
-							body_size = s.substr(s.find(":") + 1, s.length()).strip_edges().to_int();
+							body_size = s.substr(s.find(":") + 1, s.length()).strip_edges().to_int64();
 							body_left = body_size;
 
 						} else if (s.begins_with("transfer-encoding:")) {
@@ -512,7 +512,7 @@ Error HTTPClient::poll() {
 	return OK;
 }
 
-int HTTPClient::get_response_body_length() const {
+int64_t HTTPClient::get_response_body_length() const {
 
 	return body_size;
 }
@@ -633,7 +633,7 @@ PoolByteArray HTTPClient::read_response_body_chunk() {
 
 	} else {
 
-		int to_read = !read_until_eof ? MIN(body_left, read_chunk_size) : read_chunk_size;
+		int to_read = !read_until_eof ? (int)MIN(body_left, (int64_t)read_chunk_size) : read_chunk_size;
 		ret.resize(to_read);
 		int _offset = 0;
 		while (to_read > 0) {
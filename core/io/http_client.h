@@ -174,8 +174,8 @@ private:
 	Vector<uint8_t> chunk;
 	int chunk_left;
 	bool chunk_trailer_part;
-	int body_size;
-	int body_left;
+	int64_t body_size;
+	int64_t body_left;
 	bool read_until_eof;
 
 	Ref<StreamPeerTCP> tcp_connection;
@@ -213,7 +213,7 @@ public:
 	bool is_response_chunked() const;
 	int get_response_code() const;
 	Error get_response_headers(List<String> *r_response);
-	int get_response_body_length() const;
+	int64_t get_response_body_length() const;
 
 	PoolByteArray read_response_body_chunk(); // Can't get body as partial text because of most encodings UTF8, gzip, etc.
 
@@ -30,6 +30,7 @@
 
 #include "json.h"
 
+#include "core/os/file_access.h"
 #include "core/print_string.h"
 
 const char *JSON::tk_name[TK_MAX] = {
@@ -45,82 +46,12 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-static String _make_indent(const String &p_indent, int p_size) {
-
-	String indent_text = "";
-	if (!p_indent.empty()) {
-		for (int i = 0; i < p_size; i++)
-			indent_text += p_indent;
-	}
-	return indent_text;
-}
-
-String JSON::_print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys) {
-
-	String colon = ":";
-	String end_statement = "";
-
-	if (!p_indent.empty()) {
-		colon += " ";
-		end_statement += "\n";
-	}
-
-	switch (p_var.get_type()) {
-
-		case Variant::NIL: return "null";
-		case Variant::BOOL: return p_var.operator bool() ? "true" : "false";
-		case Variant::INT: return itos(p_var);
-		case Variant::REAL: return rtos(p_var);
-		case Variant::POOL_INT_ARRAY:
-		case Variant::POOL_REAL_ARRAY:
-		case Variant::POOL_STRING_ARRAY:
-		case Variant::ARRAY: {
-
-			String s = "[";
-			s += end_statement;
-			Array a = p_var;
-			for (int i = 0; i < a.size(); i++) {
-				if (i > 0) {
-					s += ",";
-					s += end_statement;
-				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(a[i], p_indent, p_cur_indent + 1, p_sort_keys);
-			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
-			return s;
-		};
-		case Variant::DICTIONARY: {
-
-			String s = "{";
-			s += end_statement;
-			Dictionary d = p_var;
-			List<Variant> keys;
-			d.get_key_list(&keys);
-
-			if (p_sort_keys)
-				keys.sort();
-
-			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
-
-				if (E != keys.front()) {
-					s += ",";
-					s += end_statement;
-				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(String(E->get()), p_indent, p_cur_indent + 1, p_sort_keys);
-				s += colon;
-				s += _print_var(d[E->get()], p_indent, p_cur_indent + 1, p_sort_keys);
-			}
-
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
-			return s;
-		};
-		default: return "\"" + String(p_var).json_escape() + "\"";
-	}
-}
-
 String JSON::print(const Variant &p_var, const String &p_indent, bool p_sort_keys) {
 
-	return _print_var(p_var, p_indent, 0, p_sort_keys);
+	JSONWriter writer;
+	writer.set_indent(p_indent);
+	writer.write_value(p_var, p_sort_keys);
+	return writer.as_string();
 }
 
 Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
@@ -473,3 +404,717 @@ Error JSON::parse(const String &p_json, Variant &r_ret, String &r_err_str, int &
 
 	return err;
 }
+
+/////////////////////////////////
+
+void JSONReader::_reset() {
+
+	file = NULL;
+	peer = Ref<StreamPeer>();
+	src = NULL;
+	src_len = 0;
+
+	buf = NULL;
+	buf_len = 0;
+	buf_pos = 0;
+
+	stack.clear();
+	expect = EXPECT_VALUE;
+	last_event = EVENT_END;
+
+	key = String();
+	value = Variant();
+	scratch_len = 0;
+
+	line = 0;
+	error = OK;
+	error_text = String();
+}
+
+bool JSONReader::_fill() {
+
+	if (src) {
+		return false; //memory is read in place, all of it is in the buffer already
+	}
+
+	if (chunk.size() < READ_CHUNK_SIZE) {
+		chunk.resize(READ_CHUNK_SIZE);
+	}
+
+	int read = 0;
+	if (file) {
+
+		read = file->get_buffer(chunk.ptrw(), READ_CHUNK_SIZE);
+	} else if (peer.is_valid()) {
+
+		Error err = peer->get_partial_data(chunk.ptrw(), READ_CHUNK_SIZE, read);
+		if (err == OK && read == 0) {
+			//nothing arrived yet, block until at least one byte does
+			err = peer->get_data(chunk.ptrw(), 1);
+			read = 1;
+		}
+		if (err != OK) {
+			read = 0;
+		}
+	}
+
+	buf = chunk.ptr();
+	buf_len = MAX(read, 0);
+	buf_pos = 0;
+	return buf_len > 0;
+}
+
+int JSONReader::_skip_whitespace() {
+
+	while (true) {
+		int c = _peek();
+		if (c < 0 || c > 32) {
+			return c;
+		}
+		if (c == '\n') {
+			line++;
+		}
+		buf_pos++;
+	}
+}
+
+Error JSONReader::_set_error(const String &p_text) {
+
+	error = ERR_PARSE_ERROR;
+	error_text = p_text;
+	return error;
+}
+
+void JSONReader::_scratch_push_utf8(uint32_t p_code) {
+
+	if (p_code < 0x80) {
+		_scratch_push(p_code);
+	} else if (p_code < 0x800) {
+		_scratch_push(0xC0 | (p_code >> 6));
+		_scratch_push(0x80 | (p_code & 0x3F));
+	} else if (p_code < 0x10000) {
+		_scratch_push(0xE0 | (p_code >> 12));
+		_scratch_push(0x80 | ((p_code >> 6) & 0x3F));
+		_scratch_push(0x80 | (p_code & 0x3F));
+	} else {
+		_scratch_push(0xF0 | (p_code >> 18));
+		_scratch_push(0x80 | ((p_code >> 12) & 0x3F));
+		_scratch_push(0x80 | ((p_code >> 6) & 0x3F));
+		_scratch_push(0x80 | (p_code & 0x3F));
+	}
+}
+
+bool JSONReader::_read_hex4(uint32_t &r_code) {
+
+	r_code = 0;
+	for (int j = 0; j < 4; j++) {
+		int c = _peek();
+		uint32_t v;
+		if (c >= '0' && c <= '9') {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else if (c >= 'A' && c <= 'F') {
+			v = c - 'A' + 10;
+		} else {
+			return false;
+		}
+		r_code = (r_code << 4) | v;
+		buf_pos++;
+	}
+	return true;
+}
+
+Error JSONReader::_read_string(String &r_str) {
+
+	buf_pos++; //opening quote
+	scratch_len = 0;
+
+	while (true) {
+
+		int c = _peek();
+		if (c < 0) {
+			return _set_error("Unterminated String");
+		}
+		buf_pos++;
+
+		if (c == '"') {
+			break;
+		}
+
+		if (c != '\\') {
+			if (c == '\n') {
+				line++;
+			}
+			_scratch_push(c);
+			continue;
+		}
+
+		//escaped characters...
+		c = _peek();
+		if (c < 0) {
+			return _set_error("Unterminated String");
+		}
+		buf_pos++;
+
+		switch (c) {
+
+			case 'b': _scratch_push(8); break;
+			case 't': _scratch_push(9); break;
+			case 'n': _scratch_push(10); break;
+			case 'f': _scratch_push(12); break;
+			case 'r': _scratch_push(13); break;
+			case 'u': {
+
+				uint32_t code;
+				if (!_read_hex4(code)) {
+					return _set_error("Malformed hex constant in string");
+				}
+
+				if (code >= 0xD800 && code <= 0xDBFF && _peek() == '\\') {
+					//surrogate pair, combine it if the low half follows
+					buf_pos++;
+					uint32_t low;
+					if (_peek() != 'u') {
+						return _set_error("Invalid escape sequence after high surrogate");
+					}
+					buf_pos++;
+					if (!_read_hex4(low)) {
+						return _set_error("Malformed hex constant in string");
+					}
+					if (low >= 0xDC00 && low <= 0xDFFF) {
+						code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+					} else {
+						_scratch_push_utf8(0xFFFD);
+						code = low;
+					}
+				}
+
+				if (code >= 0xD800 && code <= 0xDFFF) {
+					code = 0xFFFD; //lone surrogate
+				}
+				_scratch_push_utf8(code);
+
+			} break;
+			default: {
+				_scratch_push(c);
+			} break;
+		}
+	}
+
+	if (scratch_len == 0) {
+		r_str = String();
+	} else if (r_str.parse_utf8(scratch.ptr(), scratch_len)) {
+		return _set_error("Invalid UTF-8 in string");
+	}
+	return OK;
+}
+
+Error JSONReader::_read_number(Variant &r_value) {
+
+	scratch_len = 0;
+	while (true) {
+		int c = _peek();
+		if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')) {
+			break;
+		}
+		_scratch_push(c);
+		buf_pos++;
+	}
+	_scratch_push(0);
+
+	r_value = String::to_double(scratch.ptr());
+	return OK;
+}
+
+Error JSONReader::_read_identifier(Variant &r_value) {
+
+	scratch_len = 0;
+	while (true) {
+		int c = _peek();
+		if (!((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))) {
+			break;
+		}
+		_scratch_push(c);
+		buf_pos++;
+	}
+	_scratch_push(0);
+
+	const char *id = scratch.ptr();
+	if (strcmp(id, "true") == 0) {
+		r_value = true;
+	} else if (strcmp(id, "false") == 0) {
+		r_value = false;
+	} else if (strcmp(id, "null") == 0) {
+		r_value = Variant();
+	} else {
+		return _set_error("Expected 'true','false' or 'null', got '" + String(id) + "'.");
+	}
+	return OK;
+}
+
+Error JSONReader::next(Event &r_event) {
+
+	if (error != OK) {
+		return error;
+	}
+
+	while (true) {
+
+		if (expect == EXPECT_DONE) {
+			//don't read past the document, streams may carry more data after it
+			last_event = EVENT_END;
+			r_event = EVENT_END;
+			return OK;
+		}
+
+		int c = _skip_whitespace();
+		bool in_object = !stack.empty() && stack[stack.size() - 1] == '{';
+
+		switch (expect) {
+
+			case EXPECT_COMMA_OR_CLOSE: {
+
+				if (c == ',') {
+					buf_pos++;
+					expect = in_object ? EXPECT_KEY_OR_CLOSE : EXPECT_VALUE_OR_CLOSE; //trailing commas are accepted, like JSON::parse()
+					continue;
+				}
+				if (c == (in_object ? '}' : ']')) {
+					buf_pos++;
+					stack.resize(stack.size() - 1);
+					_value_done();
+					last_event = in_object ? EVENT_OBJECT_END : EVENT_ARRAY_END;
+					r_event = last_event;
+					return OK;
+				}
+				return _set_error(in_object ? "Expected '}' or ','" : "Expected ']' or ','");
+			} break;
+			case EXPECT_KEY_OR_CLOSE: {
+
+				if (c == '}') {
+					buf_pos++;
+					stack.resize(stack.size() - 1);
+					_value_done();
+					last_event = EVENT_OBJECT_END;
+					r_event = last_event;
+					return OK;
+				}
+				if (c != '"') {
+					return _set_error("Expected key");
+				}
+
+				Error err = _read_string(key);
+				if (err != OK) {
+					return err;
+				}
+				if (_skip_whitespace() != ':') {
+					return _set_error("Expected ':'");
+				}
+				buf_pos++;
+
+				expect = EXPECT_VALUE;
+				last_event = EVENT_KEY;
+				r_event = last_event;
+				return OK;
+			} break;
+			case EXPECT_VALUE_OR_CLOSE:
+			case EXPECT_VALUE: {
+
+				if (c == ']' && expect == EXPECT_VALUE_OR_CLOSE) {
+					buf_pos++;
+					stack.resize(stack.size() - 1);
+					_value_done();
+					last_event = EVENT_ARRAY_END;
+					r_event = last_event;
+					return OK;
+				}
+
+				Error err = OK;
+				if (c < 0) {
+					return _set_error("Expected value, got EOF.");
+				} else if (c == '{') {
+					buf_pos++;
+					stack.push_back('{');
+					expect = EXPECT_KEY_OR_CLOSE;
+					last_event = EVENT_OBJECT_BEGIN;
+					r_event = last_event;
+					return OK;
+				} else if (c == '[') {
+					buf_pos++;
+					stack.push_back('[');
+					expect = EXPECT_VALUE_OR_CLOSE;
+					last_event = EVENT_ARRAY_BEGIN;
+					r_event = last_event;
+					return OK;
+				} else if (c == '"') {
+					String str;
+					err = _read_string(str);
+					value = str;
+				} else if (c == '-' || (c >= '0' && c <= '9')) {
+					err = _read_number(value);
+				} else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+					err = _read_identifier(value);
+				} else {
+					return _set_error("Unexpected character.");
+				}
+
+				if (err != OK) {
+					return err;
+				}
+				_value_done();
+				last_event = EVENT_VALUE;
+				r_event = last_event;
+				return OK;
+			} break;
+			case EXPECT_DONE: {
+			} break;
+		}
+	}
+}
+
+Error JSONReader::read_value(Variant &r_value) {
+
+	Event event;
+	if (last_event == EVENT_KEY) {
+		Error err = next(event);
+		if (err != OK) {
+			return err;
+		}
+	}
+
+	switch (last_event) {
+
+		case EVENT_VALUE: {
+
+			r_value = value;
+			return OK;
+		} break;
+		case EVENT_OBJECT_BEGIN: {
+
+			Dictionary d;
+			while (true) {
+				Error err = next(event);
+				if (err != OK) {
+					return err;
+				}
+				if (event == EVENT_OBJECT_END) {
+					break;
+				}
+
+				String k = key;
+				Variant v;
+				err = read_value(v);
+				if (err != OK) {
+					return err;
+				}
+				d[k] = v;
+			}
+			r_value = d;
+			return OK;
+		} break;
+		case EVENT_ARRAY_BEGIN: {
+
+			Array a;
+			while (true) {
+				Error err = next(event);
+				if (err != OK) {
+					return err;
+				}
+				if (event == EVENT_ARRAY_END) {
+					break;
+				}
+
+				Variant v;
+				err = read_value(v);
+				if (err != OK) {
+					return err;
+				}
+				a.push_back(v);
+			}
+			r_value = a;
+			return OK;
+		} break;
+		default: {
+			ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "The last event does not start a value.");
+		}
+	}
+}
+
+Error JSONReader::skip_value() {
+
+	Event event;
+	if (last_event == EVENT_KEY) {
+		Error err = next(event);
+		if (err != OK) {
+			return err;
+		}
+	}
+
+	if (last_event != EVENT_OBJECT_BEGIN && last_event != EVENT_ARRAY_BEGIN) {
+		return OK;
+	}
+
+	int depth = stack.size();
+	while (stack.size() >= depth) {
+		Error err = next(event);
+		if (err != OK) {
+			return err;
+		}
+	}
+	return OK;
+}
+
+template <class T>
+Error JSONReader::_read_number_array(PoolVector<T> &r_array) {
+
+	Event event;
+	if (last_event == EVENT_KEY) {
+		Error err = next(event);
+		if (err != OK) {
+			return err;
+		}
+	}
+	ERR_FAIL_COND_V_MSG(last_event != EVENT_ARRAY_BEGIN, ERR_INVALID_PARAMETER, "The last event does not start an array.");
+
+	Vector<T> numbers;
+	while (true) {
+		Error err = next(event);
+		if (err != OK) {
+			return err;
+		}
+		if (event == EVENT_ARRAY_END) {
+			break;
+		}
+		if (event != EVENT_VALUE || value.get_type() != Variant::REAL) {
+			return _set_error("Expected a number in the array.");
+		}
+		numbers.push_back(T(value.operator double()));
+	}
+
+	r_array.resize(numbers.size());
+	if (numbers.size()) {
+		typename PoolVector<T>::Write w = r_array.write();
+		copymem(w.ptr(), numbers.ptr(), numbers.size() * sizeof(T));
+	}
+	return OK;
+}
+
+Error JSONReader::read_int_array(PoolVector<int> &r_array) {
+
+	return _read_number_array(r_array);
+}
+
+Error JSONReader::read_real_array(PoolVector<real_t> &r_array) {
+
+	return _read_number_array(r_array);
+}
+
+void JSONReader::open_file(FileAccess *p_file) {
+
+	_reset();
+	file = p_file;
+}
+
+void JSONReader::open_stream(const Ref<StreamPeer> &p_peer) {
+
+	_reset();
+	peer = p_peer;
+}
+
+void JSONReader::open_buffer(const uint8_t *p_buffer, int p_len) {
+
+	_reset();
+	src = p_buffer;
+	src_len = p_len;
+	buf = src;
+	buf_len = p_len;
+}
+
+JSONReader::JSONReader() {
+
+	_reset();
+}
+
+/////////////////////////////////
+
+void JSONWriter::_flush_if_needed() {
+
+	if (file && builder.get_string_length() >= FLUSH_SIZE) {
+		flush();
+	}
+}
+
+void JSONWriter::_indent(int p_depth) {
+
+	if (indent.empty()) {
+		return;
+	}
+	for (int i = 0; i < p_depth; i++) {
+		builder.append(indent);
+	}
+}
+
+void JSONWriter::_begin_item() {
+
+	if (after_key) {
+		after_key = false; //value goes right after the colon
+		return;
+	}
+
+	int depth = first_in_scope.size();
+	if (depth == 0) {
+		return;
+	}
+
+	if (first_in_scope[depth - 1]) {
+		first_in_scope.write[depth - 1] = false;
+	} else {
+		builder.append(",");
+		if (!indent.empty()) {
+			builder.append("\n");
+		}
+	}
+	_indent(depth);
+}
+
+void JSONWriter::_write_string(const String &p_str) {
+
+	builder.append("\"");
+	builder.append(p_str.json_escape());
+	builder.append("\"");
+}
+
+void JSONWriter::begin_object() {
+
+	_begin_item();
+	builder.append("{");
+	if (!indent.empty()) {
+		builder.append("\n");
+	}
+	first_in_scope.push_back(true);
+}
+
+void JSONWriter::end_object() {
+
+	ERR_FAIL_COND(first_in_scope.empty());
+	first_in_scope.resize(first_in_scope.size() - 1);
+	if (!indent.empty()) {
+		builder.append("\n");
+	}
+	_indent(first_in_scope.size());
+	builder.append("}");
+	_flush_if_needed();
+}
+
+void JSONWriter::begin_array() {
+
+	_begin_item();
+	builder.append("[");
+	if (!indent.empty()) {
+		builder.append("\n");
+	}
+	first_in_scope.push_back(true);
+}
+
+void JSONWriter::end_array() {
+
+	ERR_FAIL_COND(first_in_scope.empty());
+	first_in_scope.resize(first_in_scope.size() - 1);
+	if (!indent.empty()) {
+		builder.append("\n");
+	}
+	_indent(first_in_scope.size());
+	builder.append("]");
+	_flush_if_needed();
+}
+
+void JSONWriter::write_key(const String &p_key) {
+
+	_begin_item();
+	_write_string(p_key);
+	builder.append(indent.empty() ? ":" : ": ");
+	after_key = true;
+}
+
+void JSONWriter::write_value(const Variant &p_value, bool p_sort_keys) {
+
+	switch (p_value.get_type()) {
+
+		case Variant::NIL: {
+			_begin_item();
+			builder.append("null");
+		} break;
+		case Variant::BOOL: {
+			_begin_item();
+			builder.append(p_value.operator bool() ? "true" : "false");
+		} break;
+		case Variant::INT: {
+			_begin_item();
+			builder.append(itos(p_value));
+		} break;
+		case Variant::REAL: {
+			_begin_item();
+			builder.append(rtos(p_value));
+		} break;
+		case Variant::POOL_INT_ARRAY:
+		case Variant::POOL_REAL_ARRAY:
+		case Variant::POOL_STRING_ARRAY:
+		case Variant::ARRAY: {
+
+			begin_array();
+			Array a = p_value;
+			for (int i = 0; i < a.size(); i++) {
+				write_value(a[i], p_sort_keys);
+			}
+			end_array();
+		} break;
+		case Variant::DICTIONARY: {
+
+			begin_object();
+			Dictionary d = p_value;
+			List<Variant> keys;
+			d.get_key_list(&keys);
+
+			if (p_sort_keys)
+				keys.sort();
+
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+
+				write_key(String(E->get()));
+				write_value(d[E->get()], p_sort_keys);
+			}
+			end_object();
+		} break;
+		default: {
+			_begin_item();
+			_write_string(String(p_value));
+		} break;
+	}
+
+	_flush_if_needed();
+}
+
+String JSONWriter::as_string() const {
+
+	return builder.as_string();
+}
+
+void JSONWriter::flush() {
+
+	if (file && builder.get_string_length()) {
+		file->store_string(builder.as_string());
+		builder = StringBuilder();
+	}
+}
+
+JSONWriter::JSONWriter() {
+
+	file = NULL;
+	after_key = false;
+}
+
+JSONWriter::~JSONWriter() {
+
+	flush();
+}
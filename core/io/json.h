@@ -31,8 +31,12 @@
 #ifndef JSON_H
 #define JSON_H
 
+#include "core/io/stream_peer.h"
+#include "core/string_builder.h"
 #include "core/variant.h"
 
+class FileAccess;
+
 class JSON {
 
 	enum TokenType {
@@ -65,8 +69,6 @@ class JSON {
 
 	static const char *tk_name[TK_MAX];
 
-	static String _print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys);
-
 	static Error _get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
 	static Error _parse_value(Variant &value, Token &token, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
 	static Error _parse_array(Array &array, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
@@ -77,4 +79,142 @@ public:
 	static Error parse(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line);
 };
 
+// pull parser reading UTF-8 JSON incrementally from a file, a stream peer or memory,
+// so documents never need to be held whole as a String or as a Variant tree
+class JSONReader {
+
+public:
+	enum Event {
+		EVENT_OBJECT_BEGIN,
+		EVENT_OBJECT_END,
+		EVENT_ARRAY_BEGIN,
+		EVENT_ARRAY_END,
+		EVENT_KEY, //key is in get_key(), its value follows
+		EVENT_VALUE, //string, number, bool or null, in get_value()
+		EVENT_END, //the document is complete
+	};
+
+private:
+	enum Expect {
+		EXPECT_VALUE,
+		EXPECT_VALUE_OR_CLOSE,
+		EXPECT_KEY_OR_CLOSE,
+		EXPECT_COMMA_OR_CLOSE,
+		EXPECT_DONE,
+	};
+
+	enum {
+		READ_CHUNK_SIZE = 65536
+	};
+
+	FileAccess *file;
+	Ref<StreamPeer> peer;
+	const uint8_t *src;
+	int src_len;
+
+	Vector<uint8_t> chunk;
+	const uint8_t *buf;
+	int buf_len;
+	int buf_pos;
+
+	Vector<char> stack;
+	Expect expect;
+	Event last_event;
+
+	String key;
+	Variant value;
+	Vector<char> scratch;
+	int scratch_len;
+
+	int line;
+	Error error;
+	String error_text;
+
+	void _reset();
+	bool _fill();
+	_FORCE_INLINE_ int _peek() {
+		if (unlikely(buf_pos >= buf_len) && !_fill()) {
+			return -1;
+		}
+		return buf[buf_pos];
+	}
+	int _skip_whitespace();
+	_FORCE_INLINE_ void _scratch_push(char p_char) {
+		if (unlikely(scratch_len >= scratch.size())) {
+			scratch.resize(MAX(64, scratch.size() * 2));
+		}
+		scratch.write[scratch_len++] = p_char;
+	}
+	void _scratch_push_utf8(uint32_t p_code);
+	bool _read_hex4(uint32_t &r_code);
+	Error _read_string(String &r_str);
+	Error _read_number(Variant &r_value);
+	Error _read_identifier(Variant &r_value);
+	Error _set_error(const String &p_text);
+	_FORCE_INLINE_ void _value_done() { expect = stack.empty() ? EXPECT_DONE : EXPECT_COMMA_OR_CLOSE; }
+
+	template <class T>
+	Error _read_number_array(PoolVector<T> &r_array);
+
+public:
+	void open_file(FileAccess *p_file); //does not take ownership
+	void open_stream(const Ref<StreamPeer> &p_peer);
+	void open_buffer(const uint8_t *p_buffer, int p_len); //buffer must outlive the reader
+
+	Error next(Event &r_event);
+
+	_FORCE_INLINE_ const String &get_key() const { return key; }
+	_FORCE_INLINE_ const Variant &get_value() const { return value; }
+	_FORCE_INLINE_ int get_depth() const { return stack.size(); }
+
+	// act on the value started by the last event: build it whole, skip it or read a numeric array into typed storage
+	Error read_value(Variant &r_value);
+	Error skip_value();
+	Error read_int_array(PoolVector<int> &r_array);
+	Error read_real_array(PoolVector<real_t> &r_array);
+
+	_FORCE_INLINE_ int get_error_line() const { return line; }
+	_FORCE_INLINE_ const String &get_error_text() const { return error_text; }
+
+	JSONReader();
+};
+
+// writes JSON in the same format as JSON::print() through a StringBuilder,
+// optionally flushing it to a file in chunks as it grows
+class JSONWriter {
+
+	enum {
+		FLUSH_SIZE = 65536
+	};
+
+	StringBuilder builder;
+	FileAccess *file;
+
+	String indent;
+	Vector<bool> first_in_scope;
+	bool after_key;
+
+	void _flush_if_needed();
+	void _indent(int p_depth);
+	void _begin_item();
+	void _write_string(const String &p_str);
+
+public:
+	void set_indent(const String &p_indent) { indent = p_indent; }
+	void set_file(FileAccess *p_file) { file = p_file; } //does not take ownership
+
+	void begin_object();
+	void end_object();
+	void begin_array();
+	void end_array();
+	void write_key(const String &p_key);
+	void write_value(const Variant &p_value, bool p_sort_keys = true);
+
+	String as_string() const; //whatever was not flushed to the file yet
+	void flush();
+
+	JSONWriter();
+	~JSONWriter();
+};
+
 #endif // JSON_H
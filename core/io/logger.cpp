@@ -32,6 +32,8 @@
 
 #include "core/os/dir_access.h"
 #include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/print_string.h"
 
 // va_copy was defined in the C99, but not in C++ standards before C++11.
@@ -218,6 +220,12 @@ void RotatedFileLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 	}
 }
 
+void RotatedFileLogger::flush() {
+	if (file) {
+		file->flush();
+	}
+}
+
 RotatedFileLogger::~RotatedFileLogger() {
 	close_file();
 }
@@ -239,6 +247,168 @@ void StdLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 
 StdLogger::~StdLogger() {}
 
+void AsyncLogger::logv(const char *p_format, va_list p_list, bool p_err) {
+	if (!should_log(p_err)) {
+		return;
+	}
+
+	//claim a slot, a slot is free once its sequence has caught up with the position
+	uint32_t pos = write_pos.get();
+	Slot *slot;
+	while (true) {
+		slot = &slots[pos & SLOT_MASK];
+		uint32_t seq = slot->sequence.get();
+		int32_t diff = (int32_t)(seq - pos);
+		if (diff == 0) {
+			if (write_pos.compare_exchange(pos, pos + 1)) {
+				break;
+			}
+			pos = write_pos.get();
+		} else if (diff < 0) {
+			//full, the writer is behind
+			dropped.increment();
+			return;
+		} else {
+			pos = write_pos.get();
+		}
+	}
+
+	va_list list_copy;
+	va_copy(list_copy, p_list);
+	int len = vsnprintf(slot->text, SLOT_TEXT_SIZE, p_format, p_list);
+	slot->long_text = NULL;
+	if (len < 0) {
+		len = 0;
+		slot->text[0] = 0;
+	} else if (len >= SLOT_TEXT_SIZE) {
+		len = MIN(len, (int)MESSAGE_MAX_SIZE - 1);
+		slot->long_text = (char *)Memory::alloc_static(len + 1);
+		vsnprintf(slot->long_text, len + 1, p_format, list_copy);
+	}
+	va_end(list_copy);
+	slot->length = len;
+	slot->err = p_err;
+
+	slot->sequence.set(pos + 1);
+	semaphore->post();
+}
+
+void AsyncLogger::_flush_batch() {
+	if (batch_length == 0) {
+		return;
+	}
+	batch[batch_length] = 0;
+	if (batch_err) {
+		logger->logf_error("%s", batch);
+	} else {
+		logger->logf("%s", batch);
+	}
+	batch_length = 0;
+}
+
+bool AsyncLogger::_drain() {
+	//producers never block on draining, only one drain can run at a time
+	if (draining.test_and_set()) {
+		return false;
+	}
+
+	while (true) {
+		Slot &slot = slots[read_pos & SLOT_MASK];
+		if (slot.sequence.get() != read_pos + 1) {
+			break; //empty
+		}
+
+		const char *text = slot.long_text ? slot.long_text : slot.text;
+		if (slot.err != batch_err || batch_length + slot.length >= BATCH_SIZE) {
+			_flush_batch();
+			batch_err = slot.err;
+		}
+		if (slot.length >= BATCH_SIZE) {
+			if (slot.err) {
+				logger->logf_error("%s", text);
+			} else {
+				logger->logf("%s", text);
+			}
+		} else {
+			memcpy(batch + batch_length, text, slot.length);
+			batch_length += slot.length;
+		}
+
+		if (slot.long_text) {
+			Memory::free_static(slot.long_text);
+			slot.long_text = NULL;
+		}
+		slot.sequence.set(read_pos + SLOT_COUNT);
+		read_pos++;
+	}
+	_flush_batch();
+
+	uint32_t lost = dropped.exchange(0);
+	if (lost > 0) {
+		logger->logf_error("AsyncLogger: %u messages were dropped, the log writer could not keep up.\n", lost);
+	}
+
+	draining.clear();
+	return true;
+}
+
+void AsyncLogger::_thread_func(void *p_userdata) {
+	AsyncLogger *async_logger = (AsyncLogger *)p_userdata;
+	while (!async_logger->exit_thread.is_set()) {
+		async_logger->semaphore->wait();
+		async_logger->_drain();
+	}
+}
+
+void AsyncLogger::flush() {
+	if (_drain()) {
+		logger->flush();
+	}
+}
+
+uint32_t AsyncLogger::get_dropped_count() const {
+	return dropped.get();
+}
+
+AsyncLogger::AsyncLogger(Logger *p_logger) :
+		logger(p_logger),
+		write_pos(0),
+		read_pos(0),
+		dropped(0),
+		draining(false),
+		batch_length(0),
+		batch_err(false),
+		exit_thread(false) {
+
+	slots = memnew_arr(Slot, SLOT_COUNT);
+	for (uint32_t i = 0; i < SLOT_COUNT; i++) {
+		slots[i].sequence.set(i);
+		slots[i].long_text = NULL;
+	}
+	batch = (char *)Memory::alloc_static(BATCH_SIZE);
+	semaphore = Semaphore::create();
+	Thread::Settings settings;
+	settings.priority = Thread::PRIORITY_LOW;
+	settings.name = "AsyncLogger";
+	thread = Thread::create(_thread_func, this, settings);
+}
+
+AsyncLogger::~AsyncLogger() {
+	exit_thread.set();
+	semaphore->post();
+	Thread::wait_to_finish(thread);
+	memdelete(thread);
+	memdelete(semaphore);
+
+	//write whatever was queued after the thread's last pass
+	_drain();
+	logger->flush();
+
+	memdelete_arr(slots);
+	Memory::free_static(batch);
+	memdelete(logger);
+}
+
 CompositeLogger::CompositeLogger(Vector<Logger *> p_loggers) :
 		loggers(p_loggers) {
 }
@@ -270,6 +440,12 @@ void CompositeLogger::add_logger(Logger *p_logger) {
 	loggers.push_back(p_logger);
 }
 
+void CompositeLogger::flush() {
+	for (int i = 0; i < loggers.size(); ++i) {
+		loggers[i]->flush();
+	}
+}
+
 CompositeLogger::~CompositeLogger() {
 	for (int i = 0; i < loggers.size(); ++i) {
 		memdelete(loggers[i]);
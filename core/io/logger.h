@@ -32,11 +32,15 @@
 #define LOGGER_H
 
 #include "core/os/file_access.h"
+#include "core/safe_refcount.h"
 #include "core/ustring.h"
 #include "core/vector.h"
 
 #include <stdarg.h>
 
+class Thread;
+class Semaphore;
+
 class Logger {
 protected:
 	bool should_log(bool p_err);
@@ -55,6 +59,8 @@ public:
 	void logf(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 	void logf_error(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 
+	virtual void flush() {} ///< Write out anything buffered. May be called from a crash handler, so it must not block.
+
 	virtual ~Logger();
 };
 
@@ -89,10 +95,64 @@ public:
 	RotatedFileLogger(const String &p_base_path, int p_max_files = 10);
 
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void flush();
 
 	virtual ~RotatedFileLogger();
 };
 
+/**
+ * Moves the writes of the wrapped logger to a background thread. Messages are formatted on the
+ * calling thread into a fixed ring of slots, claimed without locking; the writer thread drains the
+ * ring in batches. When the ring is full, messages are dropped and counted, and the count is
+ * written once the writer catches up. Takes ownership of the wrapped logger.
+ */
+class AsyncLogger : public Logger {
+
+	enum {
+		SLOT_COUNT = 1024, //must be a power of 2
+		SLOT_MASK = SLOT_COUNT - 1,
+		SLOT_TEXT_SIZE = 496,
+		MESSAGE_MAX_SIZE = 64 * 1024, //longer messages are truncated
+		BATCH_SIZE = 32 * 1024,
+	};
+
+	struct Slot {
+		SafeNumeric<uint32_t> sequence;
+		bool err;
+		int length;
+		char *long_text; //allocated when the message doesn't fit in text
+		char text[SLOT_TEXT_SIZE];
+	};
+
+	Logger *logger;
+	Slot *slots;
+	SafeNumeric<uint32_t> write_pos;
+	uint32_t read_pos; //only touched while draining
+	SafeNumeric<uint32_t> dropped;
+	SafeFlag draining;
+
+	char *batch;
+	int batch_length;
+	bool batch_err;
+
+	Thread *thread;
+	Semaphore *semaphore;
+	SafeFlag exit_thread;
+
+	void _flush_batch();
+	bool _drain();
+	static void _thread_func(void *p_userdata);
+
+public:
+	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void flush();
+
+	uint32_t get_dropped_count() const;
+
+	AsyncLogger(Logger *p_logger);
+	virtual ~AsyncLogger();
+};
+
 class CompositeLogger : public Logger {
 	Vector<Logger *> loggers;
 
@@ -104,6 +164,8 @@ public:
 
 	void add_logger(Logger *p_logger);
 
+	virtual void flush();
+
 	virtual ~CompositeLogger();
 };
 
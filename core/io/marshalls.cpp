@@ -549,10 +549,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			if (count) {
 				data.resize(count);
 				PoolVector<uint8_t>::Write w = data.write();
-				for (int32_t i = 0; i < count; i++) {
-
-					w[i] = buf[i];
-				}
+				copymem(w.ptr(), buf, count);
 			}
 
 			r_variant = data;
@@ -579,10 +576,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				PoolVector<int>::Write w = data.write();
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(w.ptr(), buf, count * 4);
+#else
 				for (int32_t i = 0; i < count; i++) {
 
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -605,10 +606,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const float*rbuf=(const float*)buf;
 				data.resize(count);
 				PoolVector<float>::Write w = data.write();
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(w.ptr(), buf, count * 4);
+#else
 				for (int32_t i = 0; i < count; i++) {
 
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#endif
 			}
 			r_variant = data;
 
@@ -662,11 +667,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				varray.resize(count);
 				PoolVector<Vector2>::Write w = varray.write();
 
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+				copymem(w.ptr(), buf, count * 4 * 2);
+#else
 				for (int32_t i = 0; i < count; i++) {
 
 					w[i].x = decode_float(buf + i * 4 * 2 + 4 * 0);
 					w[i].y = decode_float(buf + i * 4 * 2 + 4 * 1);
 				}
+#endif
 
 				int adv = 4 * 2 * count;
 
@@ -697,12 +706,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				varray.resize(count);
 				PoolVector<Vector3>::Write w = varray.write();
 
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+				copymem(w.ptr(), buf, count * 4 * 3);
+#else
 				for (int32_t i = 0; i < count; i++) {
 
 					w[i].x = decode_float(buf + i * 4 * 3 + 4 * 0);
 					w[i].y = decode_float(buf + i * 4 * 3 + 4 * 1);
 					w[i].z = decode_float(buf + i * 4 * 3 + 4 * 2);
 				}
+#endif
 
 				int adv = 4 * 3 * count;
 
@@ -733,6 +746,9 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				carray.resize(count);
 				PoolVector<Color>::Write w = carray.write();
 
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(w.ptr(), buf, count * 4 * 4);
+#else
 				for (int32_t i = 0; i < count; i++) {
 
 					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
@@ -740,6 +756,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
 					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
 				}
+#endif
 
 				int adv = 4 * 4 * count;
 
@@ -1218,7 +1235,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				PoolVector<uint8_t>::Read r = data.read();
-				copymem(buf, &r[0], datalen * datasize);
+				copymem(buf, r.ptr(), datalen * datasize);
 				buf += datalen * datasize;
 			}
 
@@ -1240,8 +1257,12 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				PoolVector<int>::Read r = data.read();
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(buf, r.ptr(), datalen * datasize);
+#else
 				for (int i = 0; i < datalen; i++)
 					encode_uint32(r[i], &buf[i * datasize]);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1257,8 +1278,12 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				PoolVector<real_t>::Read r = data.read();
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+				copymem(buf, r.ptr(), datalen * datasize);
+#else
 				for (int i = 0; i < datalen; i++)
 					encode_float(r[i], &buf[i * datasize]);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1310,14 +1335,20 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			if (buf) {
 
+				PoolVector<Vector2>::Read r = data.read();
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+				copymem(buf, r.ptr(), len * 4 * 2);
+				buf += len * 4 * 2;
+#else
 				for (int i = 0; i < len; i++) {
 
-					Vector2 v = data.get(i);
+					const Vector2 &v = r[i];
 
 					encode_float(v.x, &buf[0]);
 					encode_float(v.y, &buf[4]);
 					buf += 4 * 2;
 				}
+#endif
 			}
 
 			r_len += 4 * 2 * len;
@@ -1337,15 +1368,21 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			if (buf) {
 
+				PoolVector<Vector3>::Read r = data.read();
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+				copymem(buf, r.ptr(), len * 4 * 3);
+				buf += len * 4 * 3;
+#else
 				for (int i = 0; i < len; i++) {
 
-					Vector3 v = data.get(i);
+					const Vector3 &v = r[i];
 
 					encode_float(v.x, &buf[0]);
 					encode_float(v.y, &buf[4]);
 					encode_float(v.z, &buf[8]);
 					buf += 4 * 3;
 				}
+#endif
 			}
 
 			r_len += 4 * 3 * len;
@@ -1365,9 +1402,14 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			if (buf) {
 
+				PoolVector<Color>::Read r = data.read();
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(buf, r.ptr(), len * 4 * 4);
+				buf += len * 4 * 4;
+#else
 				for (int i = 0; i < len; i++) {
 
-					Color c = data.get(i);
+					const Color &c = r[i];
 
 					encode_float(c.r, &buf[0]);
 					encode_float(c.g, &buf[4]);
@@ -1375,6 +1417,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					encode_float(c.a, &buf[12]);
 					buf += 4 * 4;
 				}
+#endif
 			}
 
 			r_len += 4 * 4 * len;
@@ -37,6 +37,15 @@
 #include "core/os/os.h"
 #endif
 
+// Replication packets carry the command, the snapshot id and the packet index and count within the snapshot.
+#define REPLICATION_HEADER_SIZE 9
+// Properties are flagged in a 32-bit change mask.
+#define REPLICATION_MAX_PROPERTIES 32
+// Snapshots kept for a peer that does not acknowledge any before everything is sent in full again.
+#define REPLICATION_MAX_SNAPSHOTS 64
+// RPCs queued for a peer are sent as soon as they would exceed this size, or on the next poll.
+#define RPC_BATCH_MAX_SIZE 1200
+
 _FORCE_INLINE_ bool _should_call_local(MultiplayerAPI::RPCMode mode, bool is_master, bool &r_skip_rpc) {
 
 	switch (mode) {
@@ -97,6 +106,9 @@ void MultiplayerAPI::poll() {
 	if (!network_peer.is_valid() || network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED)
 		return;
 
+	// Send the RPCs queued since the last poll, so they go out with this network update.
+	_flush_rpc_batches();
+
 	network_peer->poll();
 
 	if (!network_peer.is_valid()) // It's possible that polling might have resulted in a disconnection, so check here.
@@ -130,6 +142,12 @@ void MultiplayerAPI::clear() {
 	path_send_cache.clear();
 	packet_cache.clear();
 	last_send_cache_id = 1;
+	name_send_cache.clear();
+	last_name_cache_id = 1;
+	rpc_reliable_batches.clear();
+	rpc_unreliable_batches.clear();
+	replication_peers.clear();
+	replication_snapshot = 0;
 }
 
 void MultiplayerAPI::set_root_node(Node *p_node) {
@@ -180,6 +198,11 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 	}
 #endif
 
+	_process_command(p_from, p_packet, p_packet_len);
+}
+
+void MultiplayerAPI::_process_command(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
 	uint8_t packet_type = p_packet[0];
 
 	switch (packet_type) {
@@ -194,34 +217,62 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 			_process_confirm_path(p_from, p_packet, p_packet_len);
 		} break;
 
+		case NETWORK_COMMAND_CONFIRM_NAME: {
+
+			_process_confirm_name(p_from, p_packet, p_packet_len);
+		} break;
+
 		case NETWORK_COMMAND_REMOTE_CALL:
 		case NETWORK_COMMAND_REMOTE_SET: {
 
-			ERR_FAIL_COND_MSG(p_packet_len < 6, "Invalid packet received. Size too small.");
+			ERR_FAIL_COND_MSG(p_packet_len < 8, "Invalid packet received. Size too small.");
 
 			Node *node = _process_get_node(p_from, p_packet, p_packet_len);
 
 			ERR_FAIL_COND_MSG(node == NULL, "Invalid packet received. Requested node was not found.");
 
-			// Detect cstring end.
-			int len_end = 5;
-			for (; len_end < p_packet_len; len_end++) {
-				if (p_packet[len_end] == 0) {
-					break;
+			Map<int, PathGetCache>::Element *E = path_get_cache.find(p_from);
+			ERR_FAIL_COND_MSG(!E, "Invalid packet received. Requests invalid peer cache.");
+
+			int name_id = decode_uint16(&p_packet[5]);
+			int ofs = 7;
+			StringName name;
+
+			if (name_id & 0x8000) {
+				// Name sent in full, learn its id.
+
+				// Detect cstring end.
+				int len_end = ofs;
+				for (; len_end < p_packet_len; len_end++) {
+					if (p_packet[len_end] == 0) {
+						break;
+					}
 				}
-			}
 
-			ERR_FAIL_COND_MSG(len_end >= p_packet_len, "Invalid packet received. Size too small.");
+				ERR_FAIL_COND_MSG(len_end >= p_packet_len, "Invalid packet received. Size too small.");
+
+				name = String::utf8((const char *)&p_packet[ofs]);
+				ofs = len_end + 1;
 
-			StringName name = String::utf8((const char *)&p_packet[5]);
+				name_id &= 0x7FFF;
+				if (name_id) {
+					E->get().names[name_id] = name;
+					_send_confirm_name(p_from, name);
+				}
+			} else {
+				// Use cached name.
+				Map<int, StringName>::Element *F = E->get().names.find(name_id);
+				ERR_FAIL_COND_MSG(!F, "Invalid packet received. Unabled to find requested cached name.");
+				name = F->get();
+			}
 
 			if (packet_type == NETWORK_COMMAND_REMOTE_CALL) {
 
-				_process_rpc(node, name, p_from, p_packet, p_packet_len, len_end + 1);
+				_process_rpc(node, name, p_from, p_packet, p_packet_len, ofs);
 
 			} else {
 
-				_process_rset(node, name, p_from, p_packet, p_packet_len, len_end + 1);
+				_process_rset(node, name, p_from, p_packet, p_packet_len, ofs);
 			}
 
 		} break;
@@ -230,6 +281,21 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 
 			_process_raw(p_from, p_packet, p_packet_len);
 		} break;
+
+		case NETWORK_COMMAND_REPLICATE: {
+
+			_process_replicate(p_from, p_packet, p_packet_len);
+		} break;
+
+		case NETWORK_COMMAND_REPLICATE_ACK: {
+
+			_process_replicate_ack(p_from, p_packet, p_packet_len);
+		} break;
+
+		case NETWORK_COMMAND_BATCH: {
+
+			_process_batch(p_from, p_packet, p_packet_len);
+		} break;
 	}
 }
 
@@ -418,6 +484,64 @@ void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet,
 	E->get() = true;
 }
 
+void MultiplayerAPI::_send_confirm_name(int p_to, const StringName &p_name) {
+
+	// Encode name to send ack.
+	CharString pname = String(p_name).utf8();
+	int len = encode_cstring(pname.get_data(), NULL);
+
+	Vector<uint8_t> packet;
+
+	packet.resize(1 + len);
+	packet.write[0] = NETWORK_COMMAND_CONFIRM_NAME;
+	encode_cstring(pname.get_data(), &packet.write[1]);
+
+	network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	network_peer->set_target_peer(p_to);
+	network_peer->put_packet(packet.ptr(), packet.size());
+}
+
+void MultiplayerAPI::_process_confirm_name(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_FAIL_COND_MSG(p_packet_len < 2, "Invalid packet received. Size too small.");
+
+	String names;
+	names.parse_utf8((const char *)&p_packet[1], p_packet_len - 1);
+
+	PathSentCache *nsc = name_send_cache.getptr(names);
+	ERR_FAIL_COND_MSG(!nsc, "Invalid packet received. Tries to confirm a name which was not found in cache.");
+
+	Map<int, bool>::Element *E = nsc->confirmed_peers.find(p_from);
+	ERR_FAIL_COND_MSG(!E, "Invalid packet received. Source peer was not found in cache for the given name.");
+	E->get() = true;
+}
+
+void MultiplayerAPI::_process_batch(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	int ofs = 1;
+	while (ofs < p_packet_len) {
+
+		ERR_FAIL_COND_MSG(ofs + 2 > p_packet_len, "Invalid packet received. Size too small.");
+		int len = decode_uint16(&p_packet[ofs]);
+		ofs += 2;
+		if (len == 0xFFFF) {
+			ERR_FAIL_COND_MSG(ofs + 4 > p_packet_len, "Invalid packet received. Size too small.");
+			len = decode_uint32(&p_packet[ofs]);
+			ofs += 4;
+		}
+
+		ERR_FAIL_COND_MSG(len < 1 || len > p_packet_len - ofs, "Invalid packet received. Size smaller than declared.");
+		ERR_FAIL_COND_MSG(p_packet[ofs] == NETWORK_COMMAND_BATCH, "Invalid packet received. Nested batch.");
+
+		_process_command(p_from, &p_packet[ofs], len);
+		ofs += len;
+
+		if (!network_peer.is_valid()) {
+			break; // An RPC might have caused a disconnection.
+		}
+	}
+}
+
 bool MultiplayerAPI::_send_confirm_path(NodePath p_path, PathSentCache *psc, int p_target) {
 	bool has_all_peers = true;
 	List<int> peers_to_add; // If one is missing, take note to add it.
@@ -468,6 +592,45 @@ bool MultiplayerAPI::_send_confirm_path(NodePath p_path, PathSentCache *psc, int
 	return has_all_peers;
 }
 
+void MultiplayerAPI::_send_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_packet, int p_packet_len) {
+
+#ifdef DEBUG_ENABLED
+	if (profiling) {
+		bandwidth_outgoing_data.write[bandwidth_outgoing_pointer].timestamp = OS::get_singleton()->get_ticks_msec();
+		bandwidth_outgoing_data.write[bandwidth_outgoing_pointer].packet_size = p_packet_len;
+		bandwidth_outgoing_pointer = (bandwidth_outgoing_pointer + 1) % bandwidth_outgoing_data.size();
+	}
+#endif
+
+	network_peer->set_target_peer(p_to);
+	network_peer->set_transfer_mode(p_mode);
+	network_peer->put_packet(p_packet, p_packet_len);
+}
+
+MultiplayerAPI::PathSentCache *MultiplayerAPI::_get_name_send_cache(const StringName &p_name) {
+
+	PathSentCache *nsc = name_send_cache.getptr(p_name);
+	if (!nsc) {
+		name_send_cache[p_name] = PathSentCache();
+		nsc = name_send_cache.getptr(p_name);
+		nsc->id = last_name_cache_id <= 0x7FFF ? last_name_cache_id++ : 0; // Out of ids, this name is always sent in full.
+	}
+	return nsc;
+}
+
+MultiplayerAPI::PathSentCache *MultiplayerAPI::_get_path_send_cache(const NodePath &p_path) {
+
+	// See if the path is cached.
+	PathSentCache *psc = path_send_cache.getptr(p_path);
+	if (!psc) {
+		// Path is not cached, create.
+		path_send_cache[p_path] = PathSentCache();
+		psc = path_send_cache.getptr(p_path);
+		psc->id = last_send_cache_id++;
+	}
+	return psc;
+}
+
 void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount) {
 
 	ERR_FAIL_COND_MSG(network_peer.is_null(), "Attempt to remote call/set when networking is not active in SceneTree.");
@@ -487,39 +650,18 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	NodePath from_path = (root_node->get_path()).rel_path_to(p_from->get_path());
 	ERR_FAIL_COND_MSG(from_path.is_empty(), "Unable to send RPC. Relative path is empty. THIS IS LIKELY A BUG IN THE ENGINE!");
 
-	// See if the path is cached.
-	PathSentCache *psc = path_send_cache.getptr(from_path);
-	if (!psc) {
-		// Path is not cached, create.
-		path_send_cache[from_path] = PathSentCache();
-		psc = path_send_cache.getptr(from_path);
-		psc->id = last_send_cache_id++;
-	}
+	PathSentCache *psc = _get_path_send_cache(from_path);
+
+	PathSentCache *nsc = _get_name_send_cache(p_name);
 
-	// Create base packet, lots of hardcode because it must be tight.
+	// Encode the arguments once, the header in front of them differs per peer depending on what it cached already.
 
 	int ofs = 0;
 
 #define MAKE_ROOM(m_amount) \
 	if (packet_cache.size() < m_amount) packet_cache.resize(m_amount);
 
-	// Encode type.
-	MAKE_ROOM(1);
-	packet_cache.write[0] = p_set ? NETWORK_COMMAND_REMOTE_SET : NETWORK_COMMAND_REMOTE_CALL;
-	ofs += 1;
-
-	// Encode ID.
-	MAKE_ROOM(ofs + 4);
-	encode_uint32(psc->id, &(packet_cache.write[ofs]));
-	ofs += 4;
-
-	// Encode function name.
-	CharString name = String(p_name).utf8();
-	int len = encode_cstring(name.get_data(), NULL);
-	MAKE_ROOM(ofs + len);
-	encode_cstring(name.get_data(), &(packet_cache.write[ofs]));
-	ofs += len;
-
+	int len = 0;
 	if (p_set) {
 		// Set argument.
 		Error err = encode_variant(*p_arg[0], NULL, len, allow_object_decoding || network_peer->is_object_decoding_allowed());
@@ -542,57 +684,118 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 		}
 	}
 
-#ifdef DEBUG_ENABLED
-	if (profiling) {
-		bandwidth_outgoing_data.write[bandwidth_outgoing_pointer].timestamp = OS::get_singleton()->get_ticks_msec();
-		bandwidth_outgoing_data.write[bandwidth_outgoing_pointer].packet_size = ofs;
-		bandwidth_outgoing_pointer = (bandwidth_outgoing_pointer + 1) % bandwidth_outgoing_data.size();
+	int args_len = ofs;
+
+	// Have all peers cache the path, messages carry it in full until they confirm.
+	_send_confirm_path(from_path, psc, p_to);
+
+	CharString pname = String(from_path).utf8();
+	CharString mname = String(p_name).utf8();
+
+	for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+
+		if (p_to < 0 && E->get() == -p_to)
+			continue; // Continue, excluded.
+
+		if (p_to > 0 && E->get() != p_to)
+			continue; // Continue, not for this peer.
+
+		Map<int, bool>::Element *F = psc->confirmed_peers.find(E->get());
+		ERR_CONTINUE(!F); // Should never happen.
+		bool path_cached = F->get();
+
+		// The name is sent along with its id until the peer confirms it, unless ids ran out.
+		bool name_cached = false;
+		if (nsc->id) {
+			Map<int, bool>::Element *G = nsc->confirmed_peers.find(E->get());
+			if (G) {
+				name_cached = G->get();
+			} else {
+				nsc->confirmed_peers.insert(E->get(), false);
+			}
+		}
+
+		int name_len = name_cached ? 0 : encode_cstring(mname.get_data(), NULL);
+		int path_len = path_cached ? 0 : encode_cstring(pname.get_data(), NULL);
+		int path_ofs = 1 + 4 + 2 + name_len + args_len;
+
+		// Encode type, path id or path offset, name id and optional name, arguments and optional path.
+		uint8_t *w = _get_rpc_batch_room(E->get(), p_unreliable, path_ofs + path_len);
+		w[0] = p_set ? NETWORK_COMMAND_REMOTE_SET : NETWORK_COMMAND_REMOTE_CALL;
+		encode_uint32(path_cached ? psc->id : (0x80000000 | path_ofs), &w[1]);
+		encode_uint16(name_cached ? nsc->id : (0x8000 | nsc->id), &w[5]);
+		if (!name_cached) {
+			encode_cstring(mname.get_data(), &w[7]);
+		}
+		memcpy(&w[7 + name_len], packet_cache.ptr(), args_len);
+		if (!path_cached) {
+			encode_cstring(pname.get_data(), &w[path_ofs]);
+		}
 	}
-#endif
+}
+
+uint8_t *MultiplayerAPI::_get_rpc_batch_room(int p_peer, bool p_unreliable, int p_len) {
 
-	// See if all peers have cached path (is so, call can be fast).
-	bool has_all_peers = _send_confirm_path(from_path, psc, p_to);
+	RPCBatch &batch = p_unreliable ? rpc_unreliable_batches[p_peer] : rpc_reliable_batches[p_peer];
 
-	// Take chance and set transfer mode, since all send methods will use it.
-	network_peer->set_transfer_mode(p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	int header = p_len < 0xFFFF ? 2 : 6;
 
-	if (has_all_peers) {
+	if (batch.size && batch.size + header + p_len > RPC_BATCH_MAX_SIZE) {
+		_send_rpc_batch(p_peer, p_unreliable, batch);
+	}
+
+	if (!batch.size) {
+		if (batch.data.size() < 1) batch.data.resize(1);
+		batch.data.write[0] = NETWORK_COMMAND_BATCH;
+		batch.size = 1;
+	}
 
-		// They all have verified paths, so send fast.
-		network_peer->set_target_peer(p_to); // To all of you.
-		network_peer->put_packet(packet_cache.ptr(), ofs); // A message with love.
+	// Each message is prefixed by its length, long ones escape to 32 bits.
+	int ofs = batch.size;
+	if (batch.data.size() < ofs + header + p_len) batch.data.resize(ofs + header + p_len);
+	if (header == 2) {
+		encode_uint16(p_len, &batch.data.write[ofs]);
 	} else {
-		// Not all verified path, so send one by one.
+		encode_uint16(0xFFFF, &batch.data.write[ofs]);
+		encode_uint32(p_len, &batch.data.write[ofs + 2]);
+	}
+	batch.size = ofs + header + p_len;
 
-		// Append path at the end, since we will need it for some packets.
-		CharString pname = String(from_path).utf8();
-		int path_len = encode_cstring(pname.get_data(), NULL);
-		MAKE_ROOM(ofs + path_len);
-		encode_cstring(pname.get_data(), &(packet_cache.write[ofs]));
+	return &batch.data.write[ofs + header];
+}
+
+void MultiplayerAPI::_send_rpc_batch(int p_peer, bool p_unreliable, RPCBatch &r_batch) {
+
+	if (!r_batch.size) {
+		return;
+	}
 
-		for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+	NetworkedMultiplayerPeer::TransferMode mode = p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE;
 
-			if (p_to < 0 && E->get() == -p_to)
-				continue; // Continue, excluded.
+	int header = 2;
+	int len = decode_uint16(&r_batch.data[1]);
+	if (len == 0xFFFF) {
+		header = 6;
+		len = decode_uint32(&r_batch.data[3]);
+	}
 
-			if (p_to > 0 && E->get() != p_to)
-				continue; // Continue, not for this peer.
+	if (1 + header + len == r_batch.size) {
+		// A lone message doesn't need the batch framing.
+		_send_packet(p_peer, mode, &r_batch.data[1 + header], len);
+	} else {
+		_send_packet(p_peer, mode, r_batch.data.ptr(), r_batch.size);
+	}
 
-			Map<int, bool>::Element *F = psc->confirmed_peers.find(E->get());
-			ERR_CONTINUE(!F); // Should never happen.
+	r_batch.size = 0;
+}
 
-			network_peer->set_target_peer(E->get()); // To this one specifically.
+void MultiplayerAPI::_flush_rpc_batches() {
 
-			if (F->get()) {
-				// This one confirmed path, so use id.
-				encode_uint32(psc->id, &(packet_cache.write[1]));
-				network_peer->put_packet(packet_cache.ptr(), ofs);
-			} else {
-				// This one did not confirm path yet, so use entire path (sorry!).
-				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				network_peer->put_packet(packet_cache.ptr(), ofs + path_len);
-			}
-		}
+	for (Map<int, RPCBatch>::Element *E = rpc_reliable_batches.front(); E; E = E->next()) {
+		_send_rpc_batch(E->key(), false, E->get());
+	}
+	for (Map<int, RPCBatch>::Element *E = rpc_unreliable_batches.front(); E; E = E->next()) {
+		_send_rpc_batch(E->key(), true, E->get());
 	}
 }
 
@@ -606,6 +809,9 @@ void MultiplayerAPI::_del_peer(int p_id) {
 	connected_peers.erase(p_id);
 	// Cleanup get cache.
 	path_get_cache.erase(p_id);
+	replication_peers.erase(p_id);
+	rpc_reliable_batches.erase(p_id);
+	rpc_unreliable_batches.erase(p_id);
 	// Cleanup sent cache.
 	// Some refactoring is needed to make this faster and do paths GC.
 	List<NodePath> keys;
@@ -614,6 +820,12 @@ void MultiplayerAPI::_del_peer(int p_id) {
 		PathSentCache *psc = path_send_cache.getptr(E->get());
 		psc->confirmed_peers.erase(p_id);
 	}
+	List<StringName> names;
+	name_send_cache.get_key_list(&names);
+	for (List<StringName>::Element *E = names.front(); E; E = E->next()) {
+		PathSentCache *nsc = name_send_cache.getptr(E->get());
+		nsc->confirmed_peers.erase(p_id);
+	}
 	emit_signal("network_peer_disconnected", p_id);
 }
 
@@ -784,6 +996,9 @@ Error MultiplayerAPI::send_bytes(PoolVector<uint8_t> p_data, int p_to, Networked
 	ERR_FAIL_COND_V_MSG(!network_peer.is_valid(), ERR_UNCONFIGURED, "Trying to send a raw packet while no network peer is active.");
 	ERR_FAIL_COND_V_MSG(network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, ERR_UNCONFIGURED, "Trying to send a raw packet via a network peer which is not connected.");
 
+	// Keep raw packets ordered after the RPCs sent before them.
+	_flush_rpc_batches();
+
 	MAKE_ROOM(p_data.size() + 1);
 	PoolVector<uint8_t>::Read r = p_data.read();
 	packet_cache.write[0] = NETWORK_COMMAND_RAW;
@@ -809,6 +1024,342 @@ void MultiplayerAPI::_process_raw(int p_from, const uint8_t *p_packet, int p_pac
 	emit_signal("network_peer_packet", p_from, out);
 }
 
+void MultiplayerAPI::add_replicated_node(Node *p_node, const Vector<String> &p_properties) {
+
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_properties.empty(), "A replicated node needs at least one property.");
+	ERR_FAIL_COND_MSG(p_properties.size() > REPLICATION_MAX_PROPERTIES, "A replicated node can't have more than " + itos(REPLICATION_MAX_PROPERTIES) + " properties.");
+
+	// Keep the visibility when only the properties are reconfigured.
+	ReplicationNode &rn = replication_nodes[p_node->get_instance_id()];
+	rn.properties.clear();
+	for (int i = 0; i < p_properties.size(); i++) {
+		rn.properties.push_back(p_properties[i]);
+	}
+}
+
+void MultiplayerAPI::remove_replicated_node(Node *p_node) {
+
+	ERR_FAIL_NULL(p_node);
+	replication_nodes.erase(p_node->get_instance_id());
+}
+
+bool MultiplayerAPI::is_node_replicated(Node *p_node) const {
+
+	ERR_FAIL_NULL_V(p_node, false);
+	return replication_nodes.has(p_node->get_instance_id());
+}
+
+void MultiplayerAPI::set_replication_visibility(Node *p_node, int p_peer_id, bool p_visible) {
+
+	ERR_FAIL_NULL(p_node);
+	Map<ObjectID, ReplicationNode>::Element *E = replication_nodes.find(p_node->get_instance_id());
+	ERR_FAIL_COND_MSG(!E, "Node " + String(p_node->get_name()) + " is not replicated.");
+
+	if (p_visible) {
+		E->get().hidden_peers.erase(p_peer_id);
+	} else {
+		E->get().hidden_peers.insert(p_peer_id);
+	}
+}
+
+bool MultiplayerAPI::is_replication_visible(Node *p_node, int p_peer_id) const {
+
+	ERR_FAIL_NULL_V(p_node, false);
+	const Map<ObjectID, ReplicationNode>::Element *E = replication_nodes.find(p_node->get_instance_id());
+	ERR_FAIL_COND_V_MSG(!E, false, "Node " + String(p_node->get_name()) + " is not replicated.");
+
+	return !E->get().hidden_peers.has(p_peer_id);
+}
+
+void MultiplayerAPI::replicate() {
+
+	ERR_FAIL_COND_MSG(root_node == NULL, "Multiplayer root node was not initialized. If you are using custom multiplayer, remember to set the root node via MultiplayerAPI.set_root_node before using it.");
+	ERR_FAIL_COND_MSG(!network_peer.is_valid(), "Trying to replicate while no network peer is active.");
+	ERR_FAIL_COND_MSG(network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, "Trying to replicate via a network peer which is not connected.");
+
+	struct SnapshotNode {
+		ObjectID id;
+		NodePath path;
+		PathSentCache *psc;
+		const ReplicationNode *config;
+		Vector<Variant> values;
+	};
+
+	// Read every property once, all peers are compared against the same values.
+	Vector<SnapshotNode> snapshot;
+	List<ObjectID> freed;
+
+	for (Map<ObjectID, ReplicationNode>::Element *E = replication_nodes.front(); E; E = E->next()) {
+
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(E->key()));
+		if (!node) {
+			freed.push_back(E->key());
+			continue;
+		}
+
+		if (!node->is_inside_tree() || !node->is_network_master()) {
+			continue;
+		}
+
+		SnapshotNode sn;
+		sn.id = E->key();
+		sn.path = root_node->get_path().rel_path_to(node->get_path());
+		sn.psc = _get_path_send_cache(sn.path);
+		sn.config = &E->get();
+		sn.values.resize(sn.config->properties.size());
+		for (int i = 0; i < sn.config->properties.size(); i++) {
+			sn.values.write[i] = node->get(sn.config->properties[i]);
+		}
+		snapshot.push_back(sn);
+	}
+
+	for (List<ObjectID>::Element *E = freed.front(); E; E = E->next()) {
+		replication_nodes.erase(E->get());
+	}
+
+	if (snapshot.empty()) {
+		return;
+	}
+
+	replication_snapshot++;
+
+	bool allow_objects = allow_object_decoding || network_peer->is_object_decoding_allowed();
+
+	for (Set<int>::Element *P = connected_peers.front(); P; P = P->next()) {
+
+		int peer = P->get();
+		ReplicationPeer &rp = replication_peers[peer];
+
+		if (rp.sent_snapshots.size() >= REPLICATION_MAX_SNAPSHOTS) {
+			// The peer stopped acknowledging, forget the baseline and send everything again.
+			rp.sent_snapshots.clear();
+			rp.acked_snapshot = 0;
+		}
+
+		// Values are compared with the acknowledged baseline and every snapshot sent after it, since the peer may
+		// have applied any of those. Whatever matches all of them already holds on the peer.
+		const Map<ObjectID, Vector<Variant> > *baseline = NULL;
+		if (rp.acked_snapshot) {
+			Map<uint32_t, Map<ObjectID, Vector<Variant> > >::Element *B = rp.sent_snapshots.find(rp.acked_snapshot);
+			if (B) {
+				baseline = &B->get();
+			}
+		}
+
+		Map<ObjectID, Vector<Variant> > sent;
+		Vector<Vector<uint8_t> > packets;
+		Vector<uint8_t> packet;
+		packet.resize(REPLICATION_HEADER_SIZE);
+
+		for (int i = 0; i < snapshot.size(); i++) {
+
+			const SnapshotNode &sn = snapshot[i];
+
+			if (sn.config->hidden_peers.has(peer)) {
+				continue;
+			}
+
+			if (!_send_confirm_path(sn.path, sn.psc, peer)) {
+				continue; // The peer can't resolve the path id yet, it will get the node in full once it does.
+			}
+
+			sent[sn.id] = sn.values;
+
+			int value_count = sn.values.size();
+			uint32_t mask = 0;
+			const Map<ObjectID, Vector<Variant> >::Element *N = baseline ? baseline->find(sn.id) : NULL;
+
+			if (!N || N->get().size() != value_count) {
+				mask = value_count == REPLICATION_MAX_PROPERTIES ? 0xFFFFFFFF : (1U << value_count) - 1;
+			} else {
+				for (Map<uint32_t, Map<ObjectID, Vector<Variant> > >::Element *S = rp.sent_snapshots.find(rp.acked_snapshot); S; S = S->next()) {
+
+					const Map<ObjectID, Vector<Variant> >::Element *V = S->get().find(sn.id);
+					if (!V) {
+						continue;
+					}
+
+					const Vector<Variant> &old_values = V->get();
+					for (int j = 0; j < value_count && j < old_values.size(); j++) {
+						if (sn.values[j] != old_values[j]) {
+							mask |= 1U << j;
+						}
+					}
+				}
+			}
+
+			if (!mask) {
+				continue;
+			}
+
+			// Encode path id, change mask and changed values.
+			int len = 8;
+			for (int j = 0; j < value_count; j++) {
+				if (mask & (1U << j)) {
+					int vlen;
+					Error err = encode_variant(sn.values[j], NULL, vlen, allow_objects);
+					ERR_FAIL_COND_MSG(err != OK, "Unable to encode replicated value. THIS IS LIKELY A BUG IN THE ENGINE!");
+					len += vlen;
+				}
+			}
+
+			if (packet.size() > REPLICATION_HEADER_SIZE && packet.size() + len > replication_max_packet_size) {
+				packets.push_back(packet);
+				packet.resize(REPLICATION_HEADER_SIZE);
+			}
+
+			int ofs = packet.size();
+			packet.resize(ofs + len);
+			encode_uint32(sn.psc->id, &packet.write[ofs]);
+			encode_uint32(mask, &packet.write[ofs + 4]);
+			ofs += 8;
+			for (int j = 0; j < value_count; j++) {
+				if (mask & (1U << j)) {
+					int vlen;
+					encode_variant(sn.values[j], &packet.write[ofs], vlen, allow_objects);
+					ofs += vlen;
+				}
+			}
+		}
+
+		if (packet.size() > REPLICATION_HEADER_SIZE) {
+			packets.push_back(packet);
+		}
+
+		if (packets.empty()) {
+			continue; // Nothing changed for this peer, no need to track a snapshot either.
+		}
+
+		ERR_CONTINUE_MSG(packets.size() > 0xFFFF, "Too many replication packets in one snapshot.");
+
+		rp.sent_snapshots[replication_snapshot] = sent;
+
+		for (int i = 0; i < packets.size(); i++) {
+			Vector<uint8_t> &p = packets.write[i];
+			p.write[0] = NETWORK_COMMAND_REPLICATE;
+			encode_uint32(replication_snapshot, &p.write[1]);
+			encode_uint16(i, &p.write[5]);
+			encode_uint16(packets.size(), &p.write[7]);
+			_send_packet(peer, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, p.ptr(), p.size());
+		}
+	}
+}
+
+void MultiplayerAPI::_process_replicate(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_FAIL_COND_MSG(p_packet_len < REPLICATION_HEADER_SIZE, "Invalid packet received. Size too small.");
+
+	uint32_t snapshot = decode_uint32(&p_packet[1]);
+	int index = decode_uint16(&p_packet[5]);
+	int count = decode_uint16(&p_packet[7]);
+	ERR_FAIL_COND_MSG(index >= count, "Invalid packet received. Replication packet index out of range.");
+
+	ReplicationPeer &rp = replication_peers[p_from];
+	if (snapshot < rp.received_snapshot) {
+		return; // Superseded, a newer snapshot carries every change since the baseline.
+	}
+	if (snapshot > rp.received_snapshot) {
+		rp.received_snapshot = snapshot;
+		rp.received_packets = 0;
+	}
+
+	Map<int, PathGetCache>::Element *E = path_get_cache.find(p_from);
+	ERR_FAIL_COND_MSG(!E, "Invalid packet received. Requests invalid peer cache.");
+
+	bool allow_objects = allow_object_decoding || network_peer->is_object_decoding_allowed();
+	int ofs = REPLICATION_HEADER_SIZE;
+
+	while (ofs < p_packet_len) {
+
+		ERR_FAIL_COND_MSG(ofs + 8 > p_packet_len, "Invalid packet received. Size too small.");
+		int id = decode_uint32(&p_packet[ofs]);
+		uint32_t mask = decode_uint32(&p_packet[ofs + 4]);
+		ofs += 8;
+
+		Map<int, PathGetCache::NodeInfo>::Element *F = E->get().nodes.find(id);
+		ERR_FAIL_COND_MSG(!F, "Invalid packet received. Unabled to find requested cached node.");
+
+		// Values are still decoded for nodes that can't take them, to reach the next node.
+		Node *node = root_node->get_node_or_null(F->get().path);
+		const ReplicationNode *config = NULL;
+		if (node) {
+			Map<ObjectID, ReplicationNode>::Element *R = replication_nodes.find(node->get_instance_id());
+			if (!R) {
+				ERR_PRINT("Replication of node " + String(node->get_path()) + " is not configured on this peer.");
+			} else if (node->get_network_master() != p_from) {
+				ERR_PRINT("Replication of node " + String(node->get_path()) + " is not allowed from: " + itos(p_from) + ", master is " + itos(node->get_network_master()) + ".");
+			} else {
+				config = &R->get();
+			}
+		}
+
+		for (int i = 0; i < REPLICATION_MAX_PROPERTIES; i++) {
+
+			if (!(mask & (1U << i))) {
+				continue;
+			}
+
+			ERR_FAIL_COND_MSG(ofs >= p_packet_len, "Invalid packet received. Size too small.");
+
+			Variant value;
+			int vlen;
+			Error err = decode_variant(value, &p_packet[ofs], p_packet_len - ofs, &vlen, allow_objects);
+			ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode replicated value.");
+			ofs += vlen;
+
+			if (config && i < config->properties.size()) {
+				node->set(config->properties[i], value);
+			}
+		}
+	}
+
+	rp.received_packets++;
+	if (rp.received_packets != count) {
+		return;
+	}
+
+	// Only a complete snapshot can become the baseline of the sender.
+	uint8_t ack[5];
+	ack[0] = NETWORK_COMMAND_REPLICATE_ACK;
+	encode_uint32(snapshot, &ack[1]);
+
+	_send_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, ack, 5);
+}
+
+void MultiplayerAPI::_process_replicate_ack(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_FAIL_COND_MSG(p_packet_len < 5, "Invalid packet received. Size too small.");
+
+	uint32_t snapshot = decode_uint32(&p_packet[1]);
+
+	Map<int, ReplicationPeer>::Element *E = replication_peers.find(p_from);
+	if (!E) {
+		return;
+	}
+
+	ReplicationPeer &rp = E->get();
+	if (snapshot <= rp.acked_snapshot || !rp.sent_snapshots.has(snapshot)) {
+		return; // Late, or dropped when the snapshots were reset.
+	}
+
+	rp.acked_snapshot = snapshot;
+	while (rp.sent_snapshots.front()->key() < snapshot) {
+		rp.sent_snapshots.erase(rp.sent_snapshots.front());
+	}
+}
+
+void MultiplayerAPI::set_replication_max_packet_size(int p_size) {
+
+	ERR_FAIL_COND_MSG(p_size < REPLICATION_HEADER_SIZE + 8, "Replication packet size is too small.");
+	replication_max_packet_size = p_size;
+}
+
+int MultiplayerAPI::get_replication_max_packet_size() const {
+
+	return replication_max_packet_size;
+}
+
 int MultiplayerAPI::get_network_unique_id() const {
 
 	ERR_FAIL_COND_V_MSG(!network_peer.is_valid(), 0, "No network peer is assigned. Unable to get unique network ID.");
@@ -967,10 +1518,19 @@ void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_refusing_new_network_connections"), &MultiplayerAPI::is_refusing_new_network_connections);
 	ClassDB::bind_method(D_METHOD("set_allow_object_decoding", "enable"), &MultiplayerAPI::set_allow_object_decoding);
 	ClassDB::bind_method(D_METHOD("is_object_decoding_allowed"), &MultiplayerAPI::is_object_decoding_allowed);
+	ClassDB::bind_method(D_METHOD("add_replicated_node", "node", "properties"), &MultiplayerAPI::add_replicated_node);
+	ClassDB::bind_method(D_METHOD("remove_replicated_node", "node"), &MultiplayerAPI::remove_replicated_node);
+	ClassDB::bind_method(D_METHOD("is_node_replicated", "node"), &MultiplayerAPI::is_node_replicated);
+	ClassDB::bind_method(D_METHOD("set_replication_visibility", "node", "peer_id", "visible"), &MultiplayerAPI::set_replication_visibility);
+	ClassDB::bind_method(D_METHOD("is_replication_visible", "node", "peer_id"), &MultiplayerAPI::is_replication_visible);
+	ClassDB::bind_method(D_METHOD("replicate"), &MultiplayerAPI::replicate);
+	ClassDB::bind_method(D_METHOD("set_replication_max_packet_size", "size"), &MultiplayerAPI::set_replication_max_packet_size);
+	ClassDB::bind_method(D_METHOD("get_replication_max_packet_size"), &MultiplayerAPI::get_replication_max_packet_size);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_network_connections"), "set_refuse_new_network_connections", "is_refusing_new_network_connections");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "network_peer", PROPERTY_HINT_RESOURCE_TYPE, "NetworkedMultiplayerPeer", 0), "set_network_peer", "get_network_peer");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "replication_max_packet_size"), "set_replication_max_packet_size", "get_replication_max_packet_size");
 	ADD_PROPERTY_DEFAULT("refuse_new_network_connections", false);
 
 	ADD_SIGNAL(MethodInfo("network_peer_connected", PropertyInfo(Variant::INT, "id")));
@@ -995,6 +1555,8 @@ MultiplayerAPI::MultiplayerAPI() :
 		allow_object_decoding(false) {
 	rpc_sender_id = 0;
 	root_node = NULL;
+	replication_snapshot = 0;
+	replication_max_packet_size = 1200;
 #ifdef DEBUG_ENABLED
 	profiling = false;
 #endif
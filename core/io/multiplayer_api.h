@@ -63,6 +63,37 @@ private:
 		};
 
 		Map<int, NodeInfo> nodes;
+		Map<int, StringName> names;
+	};
+
+	//rpcs queued for a peer until the next poll
+	struct RPCBatch {
+		Vector<uint8_t> data;
+		int size;
+
+		RPCBatch() {
+			size = 0;
+		}
+	};
+
+	//replicated node properties, configured identically on every peer
+	struct ReplicationNode {
+		Vector<StringName> properties;
+		Set<int> hidden_peers;
+	};
+
+	//values sent in every snapshot the peer has not acknowledged yet, the oldest one is the acknowledged baseline
+	struct ReplicationPeer {
+		uint32_t acked_snapshot;
+		Map<uint32_t, Map<ObjectID, Vector<Variant> > > sent_snapshots;
+		uint32_t received_snapshot;
+		int received_packets;
+
+		ReplicationPeer() {
+			acked_snapshot = 0;
+			received_snapshot = 0;
+			received_packets = 0;
+		}
 	};
 
 #ifdef DEBUG_ENABLED
@@ -88,23 +119,44 @@ private:
 	HashMap<NodePath, PathSentCache> path_send_cache;
 	Map<int, PathGetCache> path_get_cache;
 	int last_send_cache_id;
+	HashMap<StringName, PathSentCache> name_send_cache;
+	int last_name_cache_id;
+	Map<int, RPCBatch> rpc_reliable_batches;
+	Map<int, RPCBatch> rpc_unreliable_batches;
 	Vector<uint8_t> packet_cache;
 	Node *root_node;
 	bool allow_object_decoding;
 
+	Map<ObjectID, ReplicationNode> replication_nodes;
+	Map<int, ReplicationPeer> replication_peers;
+	uint32_t replication_snapshot;
+	int replication_max_packet_size;
+
 protected:
 	static void _bind_methods();
 
 	void _process_packet(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_command(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_batch(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_confirm_name(int p_from, const uint8_t *p_packet, int p_packet_len);
 	void _process_simplify_path(int p_from, const uint8_t *p_packet, int p_packet_len);
 	void _process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len);
 	Node *_process_get_node(int p_from, const uint8_t *p_packet, int p_packet_len);
 	void _process_rpc(Node *p_node, const StringName &p_name, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_rset(Node *p_node, const StringName &p_name, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_raw(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_replicate(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_replicate_ack(int p_from, const uint8_t *p_packet, int p_packet_len);
 
 	void _send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount);
 	bool _send_confirm_path(NodePath p_path, PathSentCache *psc, int p_target);
+	void _send_confirm_name(int p_to, const StringName &p_name);
+	PathSentCache *_get_path_send_cache(const NodePath &p_path);
+	PathSentCache *_get_name_send_cache(const StringName &p_name);
+	void _send_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_packet, int p_packet_len);
+	uint8_t *_get_rpc_batch_room(int p_peer, bool p_unreliable, int p_len);
+	void _send_rpc_batch(int p_peer, bool p_unreliable, RPCBatch &r_batch);
+	void _flush_rpc_batches();
 
 public:
 	enum NetworkCommands {
@@ -113,6 +165,10 @@ public:
 		NETWORK_COMMAND_SIMPLIFY_PATH,
 		NETWORK_COMMAND_CONFIRM_PATH,
 		NETWORK_COMMAND_RAW,
+		NETWORK_COMMAND_REPLICATE,
+		NETWORK_COMMAND_REPLICATE_ACK,
+		NETWORK_COMMAND_CONFIRM_NAME,
+		NETWORK_COMMAND_BATCH,
 	};
 
 	enum RPCMode {
@@ -157,6 +213,16 @@ public:
 	void set_allow_object_decoding(bool p_enable);
 	bool is_object_decoding_allowed() const;
 
+	void add_replicated_node(Node *p_node, const Vector<String> &p_properties);
+	void remove_replicated_node(Node *p_node);
+	bool is_node_replicated(Node *p_node) const;
+	void set_replication_visibility(Node *p_node, int p_peer_id, bool p_visible);
+	bool is_replication_visible(Node *p_node, int p_peer_id) const;
+	void replicate();
+
+	void set_replication_max_packet_size(int p_size);
+	int get_replication_max_packet_size() const;
+
 	void profiling_start();
 	void profiling_end();
 
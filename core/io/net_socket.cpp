@@ -40,3 +40,52 @@ NetSocket *NetSocket::create() {
 	ERR_PRINT("Unable to create network socket, platform not supported");
 	return NULL;
 }
+
+NetSocketPoller *(*NetSocketPoller::_create)() = NULL;
+
+NetSocketPoller *NetSocketPoller::create() {
+
+	if (_create)
+		return _create();
+
+	ERR_PRINT("Unable to create network socket poller, platform not supported");
+	return NULL;
+}
+
+Error NetSocket::recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received) {
+
+	r_received = 0;
+	while (r_received < p_count) {
+
+		Datagram &d = p_datagrams[r_received];
+		int read;
+		Error err = recvfrom(d.buffer, d.len, read, d.ip, d.port);
+		if (err != OK) {
+			// Errors after the first datagram show up again on the next call.
+			return r_received ? OK : err;
+		}
+
+		d.len = read;
+		r_received++;
+	}
+
+	return OK;
+}
+
+Error NetSocket::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent) {
+
+	r_sent = 0;
+	while (r_sent < p_count) {
+
+		const Datagram &d = p_datagrams[r_sent];
+		int sent;
+		Error err = sendto(d.buffer, d.len, sent, d.ip, d.port);
+		if (err != OK) {
+			return r_sent ? OK : err;
+		}
+
+		r_sent++;
+	}
+
+	return OK;
+}
@@ -66,6 +66,19 @@ public:
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port) = 0;
 	virtual Ref<NetSocket> accept(IP_Address &r_ip, uint16_t &r_port) = 0;
 
+	struct Datagram {
+		uint8_t *buffer;
+		int len; // Buffer capacity when receiving, replaced by the size read. Size to send when sending.
+		IP_Address ip;
+		uint16_t port;
+	};
+
+	// Batched UDP transfers. These receive or send as many of p_count datagrams as possible without blocking in as
+	// few system calls as the platform allows, and only return ERR_BUSY when not a single one could be transferred.
+	// The defaults loop over recvfrom/sendto.
+	virtual Error recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received);
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent);
+
 	virtual bool is_open() const = 0;
 	virtual int get_available_bytes() const = 0;
 
@@ -74,8 +87,36 @@ public:
 	virtual void set_ipv6_only_enabled(bool p_enabled) = 0;
 	virtual void set_tcp_no_delay_enabled(bool p_enabled) = 0;
 	virtual void set_reuse_address_enabled(bool p_enabled) = 0;
+	virtual void set_reuse_port_enabled(bool p_enabled) = 0; // Lets several sockets bind the same port, the system spreads incoming datagrams among them.
 	virtual Error join_multicast_group(const IP_Address &p_multi_address, String p_if_name) = 0;
 	virtual Error leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) = 0;
 };
 
+// Waits on many sockets with a single system call and reports the ones that are ready.
+class NetSocketPoller : public Reference {
+
+protected:
+	static NetSocketPoller *(*_create)();
+
+public:
+	static NetSocketPoller *create();
+
+	struct Event {
+		uint64_t id; // As given when the socket was added.
+		bool readable;
+		bool writable;
+		bool hangup; // Closed by the other end, or failed.
+	};
+
+	// Sockets are not referenced by the poller, they must be removed before closing them.
+	virtual Error add_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, uint64_t p_id) = 0;
+	virtual Error modify_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, uint64_t p_id) = 0;
+	virtual void remove_socket(const Ref<NetSocket> &p_socket) = 0;
+	virtual int get_socket_count() const = 0;
+
+	// Returns ERR_BUSY if nothing got ready within p_timeout milliseconds (-1 waits forever). A socket may be
+	// reported in more than one event.
+	virtual Error wait(int p_timeout, Vector<Event> &r_events) = 0;
+};
+
 #endif // NET_SOCKET_H
@@ -77,8 +77,7 @@ Error PacketPeer::get_packet_buffer(PoolVector<uint8_t> &r_buffer) {
 		return OK;
 
 	PoolVector<uint8_t>::Write w = r_buffer.write();
-	for (int i = 0; i < buffer_size; i++)
-		w[i] = buffer[i];
+	copymem(w.ptr(), buffer, buffer_size);
 
 	return OK;
 }
@@ -114,6 +113,13 @@ Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
 	if (len == 0)
 		return OK;
 
+	uint8_t *dst = _begin_put_packet(len);
+	if (dst) {
+		err = encode_variant(p_packet, dst, len, p_full_objects || allow_object_decoding);
+		ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to encode Variant.");
+		return _end_put_packet(len);
+	}
+
 	ERR_FAIL_COND_V_MSG(len > encode_buffer_max_size, ERR_OUT_OF_MEMORY, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
 
 	if (unlikely(encode_buffer.size() < len)) {
@@ -272,13 +278,26 @@ Error PacketPeerStream::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 	ERR_FAIL_COND_V(p_buffer_size + 4 > output_buffer.size(), ERR_INVALID_PARAMETER);
 
 	encode_uint32(p_buffer_size, output_buffer.ptrw());
-	uint8_t *dst = &output_buffer.write[4];
-	for (int i = 0; i < p_buffer_size; i++)
-		dst[i] = p_buffer[i];
+	copymem(&output_buffer.write[4], p_buffer, p_buffer_size);
 
 	return peer->put_data(&output_buffer[0], p_buffer_size + 4);
 }
 
+uint8_t *PacketPeerStream::_begin_put_packet(int p_size) {
+
+	if (peer.is_null() || _poll_buffer() != OK || p_size < 0 || p_size + 4 > output_buffer.size()) {
+		return NULL; //let put_packet() report it
+	}
+
+	return &output_buffer.write[4];
+}
+
+Error PacketPeerStream::_end_put_packet(int p_size) {
+
+	encode_uint32(p_size, output_buffer.ptrw());
+	return peer->put_data(&output_buffer[0], p_size + 4);
+}
+
 int PacketPeerStream::get_max_packet_size() const {
 
 	return output_buffer.size();
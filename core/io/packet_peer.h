@@ -54,6 +54,11 @@ class PacketPeer : public Reference {
 	int encode_buffer_max_size;
 	PoolVector<uint8_t> encode_buffer;
 
+protected:
+	//peers staging outgoing packets can expose that storage, put_var() then encodes straight into it
+	virtual uint8_t *_begin_put_packet(int p_size) { return NULL; }
+	virtual Error _end_put_packet(int p_size) { return ERR_UNAVAILABLE; }
+
 public:
 	virtual int get_available_packet_count() const = 0;
 	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) = 0; ///< buffer is GONE after next get_packet
@@ -93,6 +98,9 @@ class PacketPeerStream : public PacketPeer {
 	Error _poll_buffer() const;
 
 protected:
+	virtual uint8_t *_begin_put_packet(int p_size);
+	virtual Error _end_put_packet(int p_size);
+
 	void _set_stream_peer(REF p_peer);
 	static void _bind_methods();
 
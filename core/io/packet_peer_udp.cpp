@@ -181,6 +181,7 @@ Error PacketPeerUDP::listen(int p_port, const IP_Address &p_bind_address, int p_
 		return err;
 	}
 	rb.resize(nearest_shift(p_recv_buffer_size));
+	recv_batch_buffer.resize(PACKET_BATCH_SIZE * PACKET_BUFFER_SIZE);
 	return OK;
 }
 
@@ -189,6 +190,7 @@ void PacketPeerUDP::close() {
 	if (_sock.is_valid())
 		_sock->close();
 	rb.resize(16);
+	recv_batch_buffer.clear();
 	queue_count = 0;
 }
 
@@ -207,12 +209,25 @@ Error PacketPeerUDP::_poll() {
 	}
 
 	Error err;
-	int read;
-	IP_Address ip;
-	uint16_t port;
+	NetSocket::Datagram datagrams[PACKET_BATCH_SIZE];
+	int batch_size = 1;
+	datagrams[0].buffer = recv_buffer;
+
+	if (recv_batch_buffer.size()) {
+		batch_size = PACKET_BATCH_SIZE;
+		uint8_t *w = recv_batch_buffer.ptrw();
+		for (int i = 0; i < batch_size; i++) {
+			datagrams[i].buffer = &w[i * PACKET_BUFFER_SIZE];
+		}
+	}
 
 	while (true) {
-		err = _sock->recvfrom(recv_buffer, sizeof(recv_buffer), read, ip, port);
+		for (int i = 0; i < batch_size; i++) {
+			datagrams[i].len = PACKET_BUFFER_SIZE;
+		}
+
+		int received;
+		err = _sock->recvfrom_batch(datagrams, batch_size, received);
 
 		if (err != OK) {
 			if (err == ERR_BUSY)
@@ -220,19 +235,27 @@ Error PacketPeerUDP::_poll() {
 			return FAILED;
 		}
 
-		if (rb.space_left() < read + 24) {
+		for (int i = 0; i < received; i++) {
+			int read = datagrams[i].len;
+
+			if (rb.space_left() < read + 24) {
 #ifdef TOOLS_ENABLED
-			WARN_PRINT("Buffer full, dropping packets!");
+				WARN_PRINT("Buffer full, dropping packets!");
 #endif
-			continue;
+				continue;
+			}
+
+			uint32_t port32 = datagrams[i].port;
+			rb.write(datagrams[i].ip.get_ipv6(), 16);
+			rb.write((uint8_t *)&port32, 4);
+			rb.write((uint8_t *)&read, 4);
+			rb.write(datagrams[i].buffer, read);
+			++queue_count;
 		}
 
-		uint32_t port32 = port;
-		rb.write(ip.get_ipv6(), 16);
-		rb.write((uint8_t *)&port32, 4);
-		rb.write((uint8_t *)&read, 4);
-		rb.write(recv_buffer, read);
-		++queue_count;
+		if (received < batch_size) {
+			break; // Drained, no need to ask again.
+		}
 	}
 
 	return OK;
@@ -40,11 +40,13 @@ class PacketPeerUDP : public PacketPeer {
 
 protected:
 	enum {
-		PACKET_BUFFER_SIZE = 65536
+		PACKET_BUFFER_SIZE = 65536,
+		PACKET_BATCH_SIZE = 8
 	};
 
 	RingBuffer<uint8_t> rb;
 	uint8_t recv_buffer[PACKET_BUFFER_SIZE];
+	Vector<uint8_t> recv_batch_buffer; // Only listening peers receive in batches.
 	uint8_t packet_buffer[PACKET_BUFFER_SIZE];
 	IP_Address packet_ip;
 	int packet_port;
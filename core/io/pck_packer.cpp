@@ -101,6 +101,7 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src) {
 	pf.src_path = p_src;
 	pf.size = f->get_len();
 	pf.offset_offset = 0;
+	pf.ofs = 0;
 
 	files.push_back(pf);
 
@@ -130,6 +131,8 @@ Error PCKPacker::flush(bool p_verbose) {
 		file->store_32(0);
 		file->store_32(0);
 		file->store_32(0);
+
+		file->store_32(0); // flags
 	};
 
 	uint64_t ofs = file->get_position();
@@ -156,6 +159,7 @@ Error PCKPacker::flush(bool p_verbose) {
 		file->seek(files[i].offset_offset); // go back to store the file's offset
 		file->store_64(ofs);
 		file->seek(pos);
+		files.write[i].ofs = ofs;
 
 		ofs = _align(ofs + files[i].size, alignment);
 		_pad(file, ofs - pos);
@@ -174,6 +178,24 @@ Error PCKPacker::flush(bool p_verbose) {
 	if (p_verbose)
 		printf("\n");
 
+	// write the hash index after the data and point the header to it
+
+	uint8_t empty_md5[16] = {};
+	uint32_t capacity = PackedData::get_index_capacity(files.size());
+	Vector<uint8_t> index;
+	index.resize(capacity * PACK_INDEX_SLOT_SIZE);
+	zeromem(index.ptrw(), index.size());
+	for (int i = 0; i < files.size(); i++) {
+		PackedData::store_index_slot(index.ptrw(), capacity, files[i].path, files[i].ofs, files[i].size, empty_md5);
+	}
+
+	uint64_t index_ofs = file->get_position();
+	file->store_buffer(index.ptr(), index.size());
+
+	file->seek(5 * 4); // first reserved field
+	file->store_64(index_ofs);
+	file->store_32(capacity);
+
 	file->close();
 	memdelete_arr(buf);
 
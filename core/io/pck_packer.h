@@ -50,6 +50,7 @@ class PCKPacker : public Reference {
 		String src_path;
 		int size;
 		uint64_t offset_offset;
+		uint64_t ofs;
 	};
 	Vector<File> files;
 
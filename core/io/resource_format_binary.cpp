@@ -30,8 +30,10 @@
 
 #include "resource_format_binary.h"
 
+#include "core/engine.h"
 #include "core/image.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/marshalls.h"
 #include "core/os/dir_access.h"
 #include "core/project_settings.h"
@@ -310,6 +312,8 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 					RES res = ResourceLoader::load(path);
 					if (res.is_null()) {
 						WARN_PRINT(String("Couldn't load resource: " + path).utf8().get_data());
+					} else if (scan_dependencies) {
+						scan_dependencies->push_back(res);
 					}
 					r_v = res;
 
@@ -333,6 +337,8 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 					if (res.is_null()) {
 						WARN_PRINT(String("Couldn't load resource: " + path).utf8().get_data());
+					} else if (scan_dependencies) {
+						scan_dependencies->push_back(res);
 					}
 					r_v = res;
 
@@ -358,6 +364,8 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 						if (res.is_null()) {
 							WARN_PRINT(String("Couldn't load resource: " + path).utf8().get_data());
+						} else if (scan_dependencies) {
+							scan_dependencies->push_back(res);
 						}
 						r_v = res;
 					}
@@ -405,6 +413,12 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 			uint32_t len = f->get_32();
 
+			if (scan_dependencies) {
+				f->seek(f->get_position() + len);
+				_advance_padding(len);
+				break;
+			}
+
 			PoolVector<uint8_t> array;
 			array.resize(len);
 			PoolVector<uint8_t>::Write w = array.write();
@@ -418,6 +432,11 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 			uint32_t len = f->get_32();
 
+			if (scan_dependencies) {
+				f->seek(f->get_position() + len * 4);
+				break;
+			}
+
 			PoolVector<int> array;
 			array.resize(len);
 			PoolVector<int>::Write w = array.write();
@@ -439,6 +458,11 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 			uint32_t len = f->get_32();
 
+			if (scan_dependencies) {
+				f->seek(f->get_position() + len * sizeof(real_t));
+				break;
+			}
+
 			PoolVector<real_t> array;
 			array.resize(len);
 			PoolVector<real_t>::Write w = array.write();
@@ -473,6 +497,11 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 			uint32_t len = f->get_32();
 
+			if (scan_dependencies) {
+				f->seek(f->get_position() + len * sizeof(real_t) * 2);
+				break;
+			}
+
 			PoolVector<Vector2> array;
 			array.resize(len);
 			PoolVector<Vector2>::Write w = array.write();
@@ -500,6 +529,11 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 			uint32_t len = f->get_32();
 
+			if (scan_dependencies) {
+				f->seek(f->get_position() + len * sizeof(real_t) * 3);
+				break;
+			}
+
 			PoolVector<Vector3> array;
 			array.resize(len);
 			PoolVector<Vector3>::Write w = array.write();
@@ -527,6 +561,11 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 			uint32_t len = f->get_32();
 
+			if (scan_dependencies) {
+				f->seek(f->get_position() + len * sizeof(real_t) * 4);
+				break;
+			}
+
 			PoolVector<Color> array;
 			array.resize(len);
 			PoolVector<Color>::Write w = array.write();
@@ -625,6 +664,13 @@ void ResourceInteractiveLoaderBinary::set_local_path(const String &p_local_path)
 	res_path = p_local_path;
 }
 
+String ResourceInteractiveLoaderBinary::_get_external_path(int p_index) const {
+
+	String path = external_resources[p_index].path;
+	const Map<String, String>::Element *E = remaps.find(path);
+	return E ? E->get() : path;
+}
+
 Ref<Resource> ResourceInteractiveLoaderBinary::get_resource() {
 
 	return resource;
@@ -636,14 +682,25 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 	int s = stage;
 
+	if (s == 0 && external_resources.size() && ResourceLoader::is_loading_with_sub_threads()) {
+		//load all dependencies in parallel, they are fetched in order below
+		for (int i = 0; i < external_resources.size(); i++) {
+			ResourceLoader::load_threaded_request(_get_external_path(i), external_resources[i].type, true);
+		}
+		external_requested = true;
+	}
+
 	if (s < external_resources.size()) {
 
-		String path = external_resources[s].path;
+		String path = _get_external_path(s);
 
-		if (remaps.has(path)) {
-			path = remaps[path];
+		RES res;
+		if (external_requested) {
+			res = ResourceLoader::load_threaded_get(path);
+			external_fetched = s + 1;
+		} else {
+			res = ResourceLoader::load(path, external_resources[s].type);
 		}
-		RES res = ResourceLoader::load(path, external_resources[s].type);
 		if (res.is_null()) {
 
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -723,26 +780,21 @@ Error ResourceInteractiveLoaderBinary::poll() {
 	r->set_path(path);
 	r->set_subindex(subindex);
 
-	int pc = f->get_32();
-
-	//set properties
-
-	for (int i = 0; i < pc; i++) {
-
-		StringName name = _get_string();
-
-		if (name == StringName()) {
-			error = ERR_FILE_CORRUPT;
-			ERR_FAIL_V(ERR_FILE_CORRUPT);
-		}
+	if (lazy_load && !main && r->is_lazy_load_supported()) {
+		//only look for the resources it uses now, its properties are read the first time it's needed
+		DeferredResource dr;
+		dr.resource = res;
+		dr.offset = f->get_position();
+		error = _scan_properties(&dr.dependencies);
+		if (error)
+			return error;
+		deferred_resources.push_back(dr);
 
-		Variant value;
+	} else {
 
-		error = parse_variant(value);
+		error = _parse_properties(r);
 		if (error)
 			return error;
-
-		res->set(name, value);
 	}
 #ifdef TOOLS_ENABLED
 	res->set_edited(false);
@@ -753,7 +805,11 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 	if (main) {
 
-		f->close();
+		if (deferred_resources.size()) {
+			_defer_resources();
+		} else {
+			f->close();
+		}
 		resource = res;
 		resource->set_as_translation_remapped(translation_remapped);
 		error = ERR_FILE_EOF;
@@ -764,6 +820,138 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 	return OK;
 }
+Error ResourceInteractiveLoaderBinary::_parse_properties(Resource *p_resource) {
+
+	int pc = f->get_32();
+
+	for (int i = 0; i < pc; i++) {
+
+		StringName name = _get_string();
+
+		if (name == StringName()) {
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
+
+		Variant value;
+
+		Error err = parse_variant(value);
+		if (err)
+			return err;
+
+		p_resource->set(name, value);
+	}
+
+	return OK;
+}
+
+Error ResourceInteractiveLoaderBinary::_scan_properties(List<RES> *r_dependencies) {
+
+	scan_dependencies = r_dependencies;
+
+	Error err = OK;
+	int pc = f->get_32();
+
+	for (int i = 0; i < pc; i++) {
+
+		if (_get_string() == StringName()) {
+			err = ERR_FILE_CORRUPT;
+			break;
+		}
+
+		Variant value;
+		err = parse_variant(value);
+		if (err)
+			break;
+	}
+
+	scan_dependencies = NULL;
+	ERR_FAIL_COND_V_MSG(err != OK, err, local_path + ": Corrupt resource properties.");
+	return OK;
+}
+
+class ResourceDeferredDataBinary : public ResourceDeferredData {
+public:
+	Ref<ResourceInteractiveLoaderBinary> source; //never changes, so it can be read before locking
+	uint64_t offset;
+	List<RES> dependencies; //resources the properties refer to, kept alive until they are read
+
+	virtual void load(Resource *p_resource) {
+
+		MutexLock lock(source->deferred_mutex);
+		if (loaded.is_set()) {
+			return; //another thread read it while this one waited
+		}
+		source->_load_deferred(p_resource, offset);
+		dependencies.clear();
+		loaded.set();
+	}
+};
+
+void ResourceInteractiveLoaderBinary::_defer_resources() {
+
+	//reads are left to a copy holding only what parsing needs, so the loaded resources aren't kept by it
+	Ref<ResourceInteractiveLoaderBinary> source = memnew(ResourceInteractiveLoaderBinary);
+	source->local_path = local_path;
+	source->res_path = res_path;
+	source->ver_format = ver_format;
+	source->string_map = string_map;
+	source->external_resources = external_resources;
+	source->remaps = remaps;
+	source->deferred_mutex = Mutex::create();
+	source->deferred_pending = deferred_resources.size();
+
+	source->f = f;
+	f = NULL;
+
+	if (!source->f->get_mapped_data() && source->f->get_len() <= 0x7FFFFFFF) {
+		const uint8_t *data = source->f->map_read_only();
+		if (data) {
+			//served from the mapping from now on, the file stays open until that's done
+			FileAccessMemory *fm = memnew(FileAccessMemory);
+			fm->open_custom(data, source->f->get_len());
+			fm->set_endian_swap(source->f->get_endian_swap());
+			source->mapped_file = source->f;
+			source->f = fm;
+		}
+	}
+
+	for (List<DeferredResource>::Element *E = deferred_resources.front(); E; E = E->next()) {
+
+		ResourceDeferredDataBinary *dd = memnew(ResourceDeferredDataBinary);
+		dd->source = source;
+		dd->offset = E->get().offset;
+		dd->dependencies = E->get().dependencies;
+		E->get().resource->set_deferred_data(dd);
+	}
+
+	deferred_resources.clear();
+}
+
+void ResourceInteractiveLoaderBinary::_load_deferred(Resource *p_resource, uint64_t p_offset) {
+
+	ERR_FAIL_COND(!f);
+
+	f->seek(p_offset);
+	Error err = _parse_properties(p_resource);
+	if (err != OK) {
+		ERR_PRINT("Failed to read the lazily loaded resource '" + p_resource->get_path() + "'.");
+	}
+#ifdef TOOLS_ENABLED
+	p_resource->set_edited(false);
+#endif
+
+	deferred_pending--;
+	if (deferred_pending == 0) {
+		//everything was read, no need to keep the file around
+		memdelete(f);
+		f = NULL;
+		if (mapped_file) {
+			memdelete(mapped_file);
+			mapped_file = NULL;
+		}
+	}
+}
+
 int ResourceInteractiveLoaderBinary::get_stage() const {
 
 	return stage;
@@ -966,13 +1154,31 @@ ResourceInteractiveLoaderBinary::ResourceInteractiveLoaderBinary() :
 		translation_remapped(false),
 		f(NULL),
 		error(OK),
-		stage(0) {
+		stage(0),
+		external_requested(false),
+		external_fetched(0),
+		lazy_load(false),
+		scan_dependencies(NULL),
+		mapped_file(NULL),
+		deferred_mutex(NULL),
+		deferred_pending(0) {
 }
 
 ResourceInteractiveLoaderBinary::~ResourceInteractiveLoaderBinary() {
 
+	if (external_requested) {
+		//fetch what an error left behind, so the threaded loads are released
+		for (int i = external_fetched; i < external_resources.size(); i++) {
+			ResourceLoader::load_threaded_get(_get_external_path(i));
+		}
+	}
+
 	if (f)
 		memdelete(f);
+	if (mapped_file)
+		memdelete(mapped_file);
+	if (deferred_mutex)
+		memdelete(deferred_mutex);
 }
 
 Ref<ResourceInteractiveLoader> ResourceFormatLoaderBinary::load_interactive(const String &p_path, const String &p_original_path, Error *r_error) {
@@ -989,6 +1195,8 @@ Ref<ResourceInteractiveLoader> ResourceFormatLoaderBinary::load_interactive(cons
 	String path = p_original_path != "" ? p_original_path : p_path;
 	ria->local_path = ProjectSettings::get_singleton()->localize_path(path);
 	ria->res_path = ria->local_path;
+	//the editor edits and reimports what it loads, so it always reads everything
+	ria->lazy_load = !Engine::get_singleton()->is_editor_hint() && GLOBAL_GET("filesystem/binary_resources/lazy_load");
 	//ria->set_local_path( Globals::get_singleton()->localize_path(p_path) );
 	ria->open(f);
 
@@ -1271,6 +1479,20 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(FileAccess *f, int p_bytes)
 	}
 }
 
+//pool arrays are stored as their raw memory when it already matches the file layout
+static _FORCE_INLINE_ bool _store_raw_array(FileAccess *f, const void *p_data, uint64_t p_bytes) {
+
+#ifdef BIG_ENDIAN_ENABLED
+	return false;
+#else
+	if (f->get_endian_swap()) {
+		return false;
+	}
+	f->store_buffer((const uint8_t *)p_data, p_bytes);
+	return true;
+#endif
+}
+
 void ResourceFormatSaverBinaryInstance::_write_variant(const Variant &p_property, const PropertyInfo &p_hint) {
 
 	write_variant(f, p_property, resource_set, external_resources, string_map, p_hint);
@@ -1546,6 +1768,9 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			int len = arr.size();
 			f->store_32(len);
 			PoolVector<int>::Read r = arr.read();
+			if (_store_raw_array(f, r.ptr(), len * sizeof(int))) {
+				break;
+			}
 			for (int i = 0; i < len; i++)
 				f->store_32(r[i]);
 
@@ -1557,6 +1782,9 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			int len = arr.size();
 			f->store_32(len);
 			PoolVector<real_t>::Read r = arr.read();
+			if (_store_raw_array(f, r.ptr(), len * sizeof(real_t))) {
+				break;
+			}
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i]);
 			}
@@ -1581,6 +1809,9 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			int len = arr.size();
 			f->store_32(len);
 			PoolVector<Vector3>::Read r = arr.read();
+			if (_store_raw_array(f, r.ptr(), len * sizeof(Vector3))) {
+				break;
+			}
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].x);
 				f->store_real(r[i].y);
@@ -1595,6 +1826,9 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			int len = arr.size();
 			f->store_32(len);
 			PoolVector<Vector2>::Read r = arr.read();
+			if (_store_raw_array(f, r.ptr(), len * sizeof(Vector2))) {
+				break;
+			}
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].x);
 				f->store_real(r[i].y);
@@ -1608,6 +1842,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			int len = arr.size();
 			f->store_32(len);
 			PoolVector<Color>::Read r = arr.read();
+#ifndef REAL_T_IS_DOUBLE
+			//colors are always float, so they only match when real_t is too
+			if (_store_raw_array(f, r.ptr(), len * sizeof(Color))) {
+				break;
+			}
+#endif
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].r);
 				f->store_real(r[i].g);
@@ -1646,6 +1886,8 @@ void ResourceFormatSaverBinaryInstance::_find_resources(const Variant &p_variant
 			if (resource_set.has(res))
 				return;
 
+			res->ensure_loaded();
+
 			List<PropertyInfo> property_list;
 
 			res->get_property_list(&property_list);
@@ -77,8 +77,33 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
 	Error error;
 
 	int stage;
+	bool external_requested; //external resources were requested as threaded loads
+	int external_fetched;
+
+	String _get_external_path(int p_index) const;
+
+	bool lazy_load; //sub-resources that support it are read the first time they are used
+
+	struct DeferredResource {
+		RES resource;
+		uint64_t offset;
+		List<RES> dependencies;
+	};
+
+	List<DeferredResource> deferred_resources;
+	List<RES> *scan_dependencies; //when set, parse_variant skips array payloads and collects the resources referenced
+
+	FileAccess *mapped_file; //kept open while f reads from its mapping
+	Mutex *deferred_mutex;
+	int deferred_pending;
+
+	Error _parse_properties(Resource *p_resource);
+	Error _scan_properties(List<RES> *r_dependencies);
+	void _defer_resources();
+	void _load_deferred(Resource *p_resource, uint64_t p_offset);
 
 	friend class ResourceFormatLoaderBinary;
+	friend class ResourceDeferredDataBinary;
 
 	Error parse_variant(Variant &r_v);
 
@@ -33,12 +33,18 @@
 #include "core/io/resource_importer.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/path_remap.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
 #include "core/translation.h"
 #include "core/variant_parser.h"
 
+#define THREAD_LOAD_LOCK \
+	if (thread_load_mutex) thread_load_mutex->lock()
+#define THREAD_LOAD_UNLOCK \
+	if (thread_load_mutex) thread_load_mutex->unlock()
+
 Ref<ResourceFormatLoader> ResourceLoader::loader[ResourceLoader::MAX_LOADERS];
 
 int ResourceLoader::loader_count = 0;
@@ -342,16 +348,69 @@ void ResourceLoader::_remove_from_loading_map_and_thread(const String &p_path, T
 	}
 }
 
+String ResourceLoader::_localize(const String &p_path) {
+
+	if (p_path.is_rel_path())
+		return "res://" + p_path;
+	return ProjectSettings::get_singleton()->localize_path(p_path);
+}
+
 RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
 
 	if (r_error)
 		*r_error = ERR_CANT_OPEN;
 
-	String local_path;
-	if (p_path.is_rel_path())
-		local_path = "res://" + p_path;
-	else
-		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	String local_path = _localize(p_path);
+
+	if (!p_no_cache) {
+
+		//share a threaded load of this path if there is one. loads done from inside a
+		//threaded load are registered too, so threads needing the same one wait for it
+		ThreadLoadTask *task = NULL;
+		bool run_here = false;
+
+		THREAD_LOAD_LOCK;
+		ThreadLoadTask **E = thread_load_tasks.getptr(local_path);
+		if (E) {
+			task = *E;
+			task->users++;
+		} else if (current_load_task && !ResourceCache::has(local_path)) {
+			task = memnew(ThreadLoadTask);
+			task->local_path = local_path;
+			task->type_hint = p_type_hint;
+			task->status = THREAD_LOAD_IN_PROGRESS;
+			task->error = OK;
+			task->use_sub_threads = current_load_task->use_sub_threads;
+			task->started = true;
+			task->requests = 0;
+			task->users = 1;
+			task->waiters = 0;
+			task->done = NULL;
+			task->waiting_for = NULL;
+			thread_load_tasks[local_path] = task;
+			run_here = true;
+		}
+		THREAD_LOAD_UNLOCK;
+
+		if (task) {
+			if (run_here) {
+				_run_load_task(task);
+			}
+			RES res = _wait_for_load_task(task, r_error);
+			_unref_load_task(task);
+			return res;
+		}
+	}
+
+	return _load_local(local_path, p_type_hint, p_no_cache, r_error);
+}
+
+RES ResourceLoader::_load_local(const String &p_local_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
+
+	if (r_error)
+		*r_error = ERR_CANT_OPEN;
+
+	const String &local_path = p_local_path;
 
 	if (!p_no_cache) {
 
@@ -379,6 +438,7 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 					ResourceCache::lock->read_unlock();
 				}
 				_remove_from_loading_map(local_path);
+				ResourceCache::soft_cache_touch(res);
 				return res;
 			}
 		}
@@ -424,15 +484,246 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 
 	if (!p_no_cache) {
 		_remove_from_loading_map(local_path);
+		ResourceCache::soft_cache_touch(res);
 	}
 
 	if (_loaded_callback) {
-		_loaded_callback(res, p_path);
+		_loaded_callback(res, local_path);
+	}
+
+	return res;
+}
+
+////////////////////////////////////////////////
+
+void ResourceLoader::_run_load_task(ThreadLoadTask *p_task) {
+
+	ThreadLoadTask *parent = current_load_task;
+	if (parent) {
+		THREAD_LOAD_LOCK;
+		parent->waiting_for = p_task;
+		THREAD_LOAD_UNLOCK;
+	}
+	current_load_task = p_task;
+
+	Error err = OK;
+	RES res = _load_local(p_task->local_path, p_task->type_hint, false, &err);
+
+	current_load_task = parent;
+
+	THREAD_LOAD_LOCK;
+	if (parent) {
+		parent->waiting_for = NULL;
+	}
+	p_task->resource = res;
+	if (res.is_valid()) {
+		p_task->status = THREAD_LOAD_LOADED;
+		p_task->error = OK;
+	} else {
+		p_task->status = THREAD_LOAD_FAILED;
+		p_task->error = err != OK ? err : FAILED;
+	}
+	for (int i = 0; i < p_task->waiters; i++) {
+		p_task->done->post();
+	}
+	THREAD_LOAD_UNLOCK;
+}
+
+void ResourceLoader::_thread_load_function(void *p_userdata, uint32_t p_index) {
+
+	ThreadLoadTask *task = (ThreadLoadTask *)p_userdata;
+
+	THREAD_LOAD_LOCK;
+	bool run = !task->started;
+	task->started = true;
+	THREAD_LOAD_UNLOCK;
+
+	if (run) {
+		_run_load_task(task);
+	}
+	_unref_load_task(task);
+}
+
+RES ResourceLoader::_wait_for_load_task(ThreadLoadTask *p_task, Error *r_error) {
+
+	THREAD_LOAD_LOCK;
+
+	if (!p_task->started) {
+		//nobody picked it up yet, run it here instead of waiting for a free worker
+		p_task->started = true;
+		THREAD_LOAD_UNLOCK;
+		_run_load_task(p_task);
+		THREAD_LOAD_LOCK;
+
+	} else if (p_task->status == THREAD_LOAD_IN_PROGRESS) {
+
+		ThreadLoadTask *current = current_load_task;
+		if (current) {
+			//waiting for a load that (indirectly) waits for this one would never end
+			for (ThreadLoadTask *t = p_task; t; t = t->waiting_for) {
+				if (t == current) {
+					THREAD_LOAD_UNLOCK;
+					if (r_error)
+						*r_error = ERR_CYCLIC_LINK;
+					ERR_FAIL_V_MSG(RES(), "Resource: '" + p_task->local_path + "' is already being loaded. Cyclic reference?");
+				}
+			}
+			current->waiting_for = p_task;
+		}
+
+		if (!p_task->done) {
+			p_task->done = Semaphore::create();
+		}
+		while (p_task->status == THREAD_LOAD_IN_PROGRESS) {
+			p_task->waiters++;
+			THREAD_LOAD_UNLOCK;
+			p_task->done->wait();
+			THREAD_LOAD_LOCK;
+			p_task->waiters--;
+		}
+
+		if (current) {
+			current->waiting_for = NULL;
+		}
+	}
+
+	RES res = p_task->resource;
+	Error err = p_task->error;
+	THREAD_LOAD_UNLOCK;
+
+	if (r_error)
+		*r_error = err;
+	return res;
+}
+
+void ResourceLoader::_unref_load_task(ThreadLoadTask *p_task) {
+
+	THREAD_LOAD_LOCK;
+	p_task->users--;
+	bool free = p_task->users == 0;
+	if (free) {
+		thread_load_tasks.erase(p_task->local_path);
+	}
+	THREAD_LOAD_UNLOCK;
+
+	if (free) {
+		if (p_task->done) {
+			memdelete(p_task->done);
+		}
+		memdelete(p_task);
+	}
+}
+
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads) {
+
+	ERR_FAIL_COND_V(p_path.empty(), ERR_INVALID_PARAMETER);
+
+	String local_path = _localize(p_path);
+
+	THREAD_LOAD_LOCK;
+
+	if (current_load_task) {
+		current_load_task->sub_tasks.push_back(local_path);
+	}
+
+	ThreadLoadTask **E = thread_load_tasks.getptr(local_path);
+	if (E) {
+		//already loading, or loaded and not fetched yet
+		(*E)->requests++;
+		(*E)->users++;
+		THREAD_LOAD_UNLOCK;
+		return OK;
+	}
+
+	ThreadLoadTask *task = memnew(ThreadLoadTask);
+	task->local_path = local_path;
+	task->type_hint = p_type_hint;
+	task->status = THREAD_LOAD_IN_PROGRESS;
+	task->error = OK;
+	task->use_sub_threads = p_use_sub_threads;
+	task->started = false;
+	task->requests = 1;
+	task->users = 2; //the request and the pool job
+	task->waiters = 0;
+	task->done = NULL;
+	task->waiting_for = NULL;
+	thread_load_tasks[local_path] = task;
+
+	THREAD_LOAD_UNLOCK;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	pool->release_task(pool->add_native_task(&_thread_load_function, task));
+
+	return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const String &p_path, float *r_progress) {
+
+	String local_path = _localize(p_path);
+
+	THREAD_LOAD_LOCK;
+
+	ThreadLoadTask **E = thread_load_tasks.getptr(local_path);
+	if (!E || (*E)->requests == 0) {
+		THREAD_LOAD_UNLOCK;
+		if (r_progress)
+			*r_progress = 0;
+		return THREAD_LOAD_INVALID_RESOURCE;
+	}
+
+	ThreadLoadTask *task = *E;
+	ThreadLoadStatus status = task->status;
+
+	if (r_progress) {
+		if (status != THREAD_LOAD_IN_PROGRESS) {
+			*r_progress = 1.0;
+		} else {
+			//the dependencies requested so far, plus the resource itself
+			int loaded = 0;
+			for (int i = 0; i < task->sub_tasks.size(); i++) {
+				ThreadLoadTask **S = thread_load_tasks.getptr(task->sub_tasks[i]);
+				if (!S || (*S)->status != THREAD_LOAD_IN_PROGRESS) {
+					loaded++;
+				}
+			}
+			*r_progress = float(loaded) / (task->sub_tasks.size() + 1);
+		}
+	}
+
+	THREAD_LOAD_UNLOCK;
+
+	return status;
+}
+
+RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
+
+	String local_path = _localize(p_path);
+
+	THREAD_LOAD_LOCK;
+
+	ThreadLoadTask **E = thread_load_tasks.getptr(local_path);
+	if (!E || (*E)->requests == 0) {
+		THREAD_LOAD_UNLOCK;
+		if (r_error)
+			*r_error = ERR_INVALID_PARAMETER;
+		ERR_FAIL_V_MSG(RES(), "Attempted to get a resource that was not requested with load_threaded_request(): " + local_path + ".");
 	}
 
+	ThreadLoadTask *task = *E;
+	task->requests--;
+	THREAD_LOAD_UNLOCK;
+
+	//the reference taken by the request is dropped here
+	RES res = _wait_for_load_task(task, r_error);
+	_unref_load_task(task);
 	return res;
 }
 
+bool ResourceLoader::is_loading_with_sub_threads() {
+
+	return current_load_task && current_load_task->use_sub_threads;
+}
+
 bool ResourceLoader::exists(const String &p_path, const String &p_type_hint) {
 
 	String local_path;
@@ -1003,13 +1294,22 @@ void ResourceLoader::remove_custom_loaders() {
 Mutex *ResourceLoader::loading_map_mutex = NULL;
 HashMap<ResourceLoader::LoadingMapKey, int, ResourceLoader::LoadingMapKeyHasher> ResourceLoader::loading_map;
 
+Mutex *ResourceLoader::thread_load_mutex = NULL;
+HashMap<String, ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_tasks;
+thread_local ResourceLoader::ThreadLoadTask *ResourceLoader::current_load_task = NULL;
+
 void ResourceLoader::initialize() {
 #ifndef NO_THREADS
 	loading_map_mutex = Mutex::create();
+	thread_load_mutex = Mutex::create();
 #endif
 }
 
 void ResourceLoader::finalize() {
+	const String *T = NULL;
+	while ((T = thread_load_tasks.next(T))) {
+		ERR_PRINT("Exited with a threaded load never fetched with load_threaded_get(): " + *T);
+	}
 #ifndef NO_THREADS
 	const LoadingMapKey *K = NULL;
 	while ((K = loading_map.next(K))) {
@@ -1018,6 +1318,8 @@ void ResourceLoader::finalize() {
 	loading_map.clear();
 	memdelete(loading_map_mutex);
 	loading_map_mutex = NULL;
+	memdelete(thread_load_mutex);
+	thread_load_mutex = NULL;
 #endif
 }
 
@@ -31,6 +31,7 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/resource.h"
 
@@ -95,6 +96,16 @@ class ResourceLoader {
 		MAX_LOADERS = 64
 	};
 
+public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_RESOURCE,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
+
+private:
+
 	static Ref<ResourceFormatLoader> loader[MAX_LOADERS];
 	static int loader_count;
 	static bool timestamp_on_load;
@@ -141,11 +152,45 @@ class ResourceLoader {
 	static void _remove_from_loading_map(const String &p_path);
 	static void _remove_from_loading_map_and_thread(const String &p_path, Thread::ID p_thread);
 
+	//threaded loads, keyed by local path so every thread asking for a path shares
+	//the same load. a task not yet started is run by the first thread needing it.
+	struct ThreadLoadTask {
+		String local_path;
+		String type_hint;
+		ThreadLoadStatus status;
+		Error error;
+		RES resource;
+		bool use_sub_threads;
+		bool started;
+		int requests; //load_threaded_request calls not yet matched by load_threaded_get
+		int users; //requests, the queued pool job and threads waiting inside loads
+		int waiters;
+		Semaphore *done;
+		ThreadLoadTask *waiting_for; //to detect cyclic dependencies between threads
+		Vector<String> sub_tasks; //dependencies requested while loading, for progress
+	};
+
+	static Mutex *thread_load_mutex;
+	static HashMap<String, ThreadLoadTask *> thread_load_tasks;
+	static thread_local ThreadLoadTask *current_load_task;
+
+	static RES _load_local(const String &p_local_path, const String &p_type_hint, bool p_no_cache, Error *r_error);
+	static String _localize(const String &p_path);
+	static void _thread_load_function(void *p_userdata, uint32_t p_index);
+	static void _run_load_task(ThreadLoadTask *p_task);
+	static RES _wait_for_load_task(ThreadLoadTask *p_task, Error *r_error);
+	static void _unref_load_task(ThreadLoadTask *p_task);
+
 public:
 	static Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
+	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false);
+	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = NULL);
+	static RES load_threaded_get(const String &p_path, Error *r_error = NULL);
+	static bool is_loading_with_sub_threads(); //true inside a threaded load that wants its dependencies requested in parallel
+
 	static void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions);
 	static void add_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader, bool p_at_front = false);
 	static void remove_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader);
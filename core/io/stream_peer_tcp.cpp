@@ -251,11 +251,36 @@ bool StreamPeerTCP::is_connected_to_host() const {
 	return _sock.is_valid() && _sock->is_open() && (status == STATUS_CONNECTED || status == STATUS_CONNECTING);
 }
 
+void StreamPeerTCP::_set_poller(Ref<NetSocketPoller> p_poller) {
+
+	ERR_FAIL_COND(_poller.is_valid() || !_sock.is_valid() || !_sock->is_open());
+
+	if (p_poller->add_socket(_sock, NetSocket::POLL_TYPE_IN, get_instance_id()) == OK) {
+		_poller = p_poller;
+	}
+}
+
+void StreamPeerTCP::_poller_event(const NetSocketPoller::Event &p_event) {
+
+	if (status != STATUS_CONNECTED) {
+		return;
+	}
+
+	// Same checks as get_status(), done once per event instead of on every call.
+	if (p_event.readable && _sock->get_available_bytes() == 0) {
+		// FIN received
+		disconnect_from_host();
+	} else if (p_event.hangup && !p_event.readable) {
+		disconnect_from_host();
+		status = STATUS_ERROR;
+	}
+}
+
 StreamPeerTCP::Status StreamPeerTCP::get_status() {
 
 	if (status == STATUS_CONNECTING) {
 		_poll_connection();
-	} else if (status == STATUS_CONNECTED) {
+	} else if (status == STATUS_CONNECTED && _poller.is_null()) {
 		Error err;
 		err = _sock->poll(NetSocket::POLL_TYPE_IN, 0);
 		if (err == OK) {
@@ -279,6 +304,11 @@ StreamPeerTCP::Status StreamPeerTCP::get_status() {
 
 void StreamPeerTCP::disconnect_from_host() {
 
+	if (_poller.is_valid()) {
+		_poller->remove_socket(_sock);
+		_poller.unref();
+	}
+
 	if (_sock.is_valid() && _sock->is_open())
 		_sock->close();
 
@@ -41,6 +41,8 @@ class StreamPeerTCP : public StreamPeer {
 	GDCLASS(StreamPeerTCP, StreamPeer);
 	OBJ_CATEGORY("Networking");
 
+	friend class TCP_Server;
+
 public:
 	enum Status {
 
@@ -56,6 +58,10 @@ protected:
 	Status status;
 	IP_Address peer_host;
 	uint16_t peer_port;
+	Ref<NetSocketPoller> _poller; // Set while a server polls this connection, status then comes from its events.
+
+	void _set_poller(Ref<NetSocketPoller> p_poller);
+	void _poller_event(const NetSocketPoller::Event &p_event);
 
 	Error _connect(const String &p_address, int p_port);
 	Error _poll_connection();
@@ -75,6 +81,7 @@ public:
 
 	int get_available_bytes() const;
 	Status get_status();
+	bool is_polled_by_server() const { return _poller.is_valid(); }
 
 	void set_no_delay(bool p_enabled);
 
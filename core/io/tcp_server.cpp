@@ -36,6 +36,7 @@ void TCP_Server::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_connection_available"), &TCP_Server::is_connection_available);
 	ClassDB::bind_method(D_METHOD("is_listening"), &TCP_Server::is_listening);
 	ClassDB::bind_method(D_METHOD("take_connection"), &TCP_Server::take_connection);
+	ClassDB::bind_method(D_METHOD("poll", "timeout_msec"), &TCP_Server::_poll, DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("stop"), &TCP_Server::stop);
 }
 
@@ -73,6 +74,10 @@ Error TCP_Server::listen(uint16_t p_port, const IP_Address &p_bind_address) {
 		_sock->close();
 		return FAILED;
 	}
+
+	if (_poller.is_valid()) {
+		_poller->add_socket(_sock, NetSocket::POLL_TYPE_IN, 0);
+	}
 	return OK;
 }
 
@@ -89,6 +94,9 @@ bool TCP_Server::is_connection_available() const {
 	if (!_sock->is_open())
 		return false;
 
+	if (_poller.is_valid() && _connection_pending)
+		return true;
+
 	Error err = _sock->poll(NetSocket::POLL_TYPE_IN, 0);
 	return (err == OK);
 }
@@ -104,23 +112,84 @@ Ref<StreamPeerTCP> TCP_Server::take_connection() {
 	IP_Address ip;
 	uint16_t port = 0;
 	ns = _sock->accept(ip, port);
+	_connection_pending = false; // Known again on the next poll, or asked to the socket.
 	if (!ns.is_valid())
 		return conn;
 
 	conn = Ref<StreamPeerTCP>(memnew(StreamPeerTCP));
 	conn->accept_socket(ns, ip, port);
+	if (_poller.is_valid()) {
+		conn->_set_poller(_poller);
+	}
 	return conn;
 }
 
+Error TCP_Server::poll(int p_timeout_msec, Vector<Ref<StreamPeerTCP> > &r_active) {
+
+	r_active.clear();
+
+	if (_poller.is_null()) {
+		_poller = Ref<NetSocketPoller>(NetSocketPoller::create());
+		ERR_FAIL_COND_V(_poller.is_null(), ERR_UNAVAILABLE);
+		if (_sock.is_valid() && _sock->is_open()) {
+			_poller->add_socket(_sock, NetSocket::POLL_TYPE_IN, 0);
+		}
+	}
+
+	Vector<NetSocketPoller::Event> events;
+	Error err = _poller->wait(p_timeout_msec, events);
+	if (err != OK) {
+		return err;
+	}
+
+	for (int i = 0; i < events.size(); i++) {
+
+		const NetSocketPoller::Event &event = events[i];
+
+		// Id 0 is the listening socket, no object has that id.
+		if (event.id == 0) {
+			_connection_pending = true;
+			continue;
+		}
+
+		StreamPeerTCP *peer = Object::cast_to<StreamPeerTCP>(ObjectDB::get_instance(event.id));
+		if (!peer) {
+			continue;
+		}
+
+		peer->_poller_event(event);
+		r_active.push_back(Ref<StreamPeerTCP>(peer));
+	}
+
+	return OK;
+}
+
+Array TCP_Server::_poll(int p_timeout_msec) {
+
+	Array ret;
+	Vector<Ref<StreamPeerTCP> > active;
+	if (poll(p_timeout_msec, active) == OK) {
+		for (int i = 0; i < active.size(); i++) {
+			ret.push_back(active[i]);
+		}
+	}
+	return ret;
+}
+
 void TCP_Server::stop() {
 
 	if (_sock.is_valid()) {
+		if (_poller.is_valid() && _sock->is_open()) {
+			_poller->remove_socket(_sock);
+		}
 		_sock->close();
 	}
+	_connection_pending = false;
 }
 
 TCP_Server::TCP_Server() :
-		_sock(Ref<NetSocket>(NetSocket::create())) {
+		_sock(Ref<NetSocket>(NetSocket::create())),
+		_connection_pending(false) {
 }
 
 TCP_Server::~TCP_Server() {
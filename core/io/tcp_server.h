@@ -46,6 +46,10 @@ protected:
 	};
 
 	Ref<NetSocket> _sock;
+	Ref<NetSocketPoller> _poller; // Created by the first poll(), watches the listening socket and every connection taken after it.
+	bool _connection_pending;
+
+	Array _poll(int p_timeout_msec);
 	static void _bind_methods();
 
 public:
@@ -54,6 +58,9 @@ public:
 	bool is_connection_available() const;
 	Ref<StreamPeerTCP> take_connection();
 
+	// Waits once on all watched sockets, returns the connections that got data, were closed, or failed.
+	Error poll(int p_timeout_msec, Vector<Ref<StreamPeerTCP> > &r_active);
+
 	void stop(); // Stop listening
 
 	TCP_Server();
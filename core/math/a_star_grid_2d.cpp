@@ -0,0 +1,1183 @@
+/*************************************************************************/
+/*  a_star_grid_2d.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "a_star_grid_2d.h"
+
+#include "core/os/worker_thread_pool.h"
+#include "core/sort_array.h"
+
+void AStarGrid2D::Search::begin(int p_x, int p_y, int p_width, int p_height) {
+
+	x = p_x;
+	y = p_y;
+	width = p_width;
+	height = p_height;
+
+	int count = p_width * p_height;
+	if (states.size() < count) {
+		int old_count = states.size();
+		states.resize(count);
+		CellState *w = states.ptrw();
+		for (int i = old_count; i < count; i++) {
+			w[i].pass = 0; // Never visited.
+		}
+	}
+
+	if (closed_pass >= 0xFFFFFFF0) {
+		CellState *w = states.ptrw();
+		for (int i = 0; i < states.size(); i++) {
+			w[i].pass = 0;
+		}
+		closed_pass = 0;
+	}
+
+	open_pass = closed_pass + 1;
+	closed_pass = open_pass + 1;
+}
+
+real_t AStarGrid2D::_estimate_cost(int p_from_x, int p_from_y, int p_to_x, int p_to_y) const {
+
+	real_t dx = ABS(p_to_x - p_from_x) * cell_size.x;
+	real_t dy = ABS(p_to_y - p_from_y) * cell_size.y;
+
+	switch (heuristic) {
+		case HEURISTIC_MANHATTAN: {
+			return dx + dy;
+		} break;
+		case HEURISTIC_OCTILE: {
+			real_t f = Math_SQRT2 - 1;
+			return dx < dy ? f * dx + dy : f * dy + dx;
+		} break;
+		case HEURISTIC_CHEBYSHEV: {
+			return MAX(dx, dy);
+		} break;
+		default: {
+			return Math::sqrt(dx * dx + dy * dy);
+		}
+	}
+}
+
+real_t AStarGrid2D::_compute_cost(int p_from_x, int p_from_y, int p_to_x, int p_to_y) const {
+
+	real_t dx = (p_to_x - p_from_x) * cell_size.x;
+	real_t dy = (p_to_y - p_from_y) * cell_size.y;
+	return Math::sqrt(dx * dx + dy * dy);
+}
+
+#define WALKABLE(m_x, m_y) _is_walkable(p_search, m_x, m_y)
+
+int AStarGrid2D::_jump(const Search &p_search, int p_x, int p_y, int p_dx, int p_dy, int p_end_x, int p_end_y) const {
+
+	// Walks from the given cell along the direction until it reaches a cell with a forced neighbour (a jump point),
+	// the end or an obstacle. Returns the local index of the jump point, or -1 when there is none.
+	int x = p_x;
+	int y = p_y;
+	int dx = p_dx;
+	int dy = p_dy;
+
+	while (true) {
+
+		if (!WALKABLE(x, y)) {
+			return -1;
+		}
+
+		int idx = (y - p_search.y) * p_search.width + (x - p_search.x);
+		if (x == p_end_x && y == p_end_y) {
+			return idx;
+		}
+
+		switch (diagonal_mode) {
+			case DIAGONAL_MODE_ALWAYS: {
+				if (dx != 0 && dy != 0) {
+					if ((WALKABLE(x - dx, y + dy) && !WALKABLE(x - dx, y)) || (WALKABLE(x + dx, y - dy) && !WALKABLE(x, y - dy))) {
+						return idx;
+					}
+					if (_jump(p_search, x + dx, y, dx, 0, p_end_x, p_end_y) != -1 || _jump(p_search, x, y + dy, 0, dy, p_end_x, p_end_y) != -1) {
+						return idx;
+					}
+				} else if (dx != 0) {
+					if ((WALKABLE(x + dx, y + 1) && !WALKABLE(x, y + 1)) || (WALKABLE(x + dx, y - 1) && !WALKABLE(x, y - 1))) {
+						return idx;
+					}
+				} else {
+					if ((WALKABLE(x + 1, y + dy) && !WALKABLE(x + 1, y)) || (WALKABLE(x - 1, y + dy) && !WALKABLE(x - 1, y))) {
+						return idx;
+					}
+				}
+			} break;
+			case DIAGONAL_MODE_NEVER: {
+				if (dx != 0) {
+					if ((WALKABLE(x, y - 1) && !WALKABLE(x - dx, y - 1)) || (WALKABLE(x, y + 1) && !WALKABLE(x - dx, y + 1))) {
+						return idx;
+					}
+				} else {
+					if ((WALKABLE(x - 1, y) && !WALKABLE(x - 1, y - dy)) || (WALKABLE(x + 1, y) && !WALKABLE(x + 1, y - dy))) {
+						return idx;
+					}
+					// Moving vertically, horizontal jump points make this cell a turning point.
+					if (_jump(p_search, x + 1, y, 1, 0, p_end_x, p_end_y) != -1 || _jump(p_search, x - 1, y, -1, 0, p_end_x, p_end_y) != -1) {
+						return idx;
+					}
+				}
+			} break;
+			case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES: {
+				if (dx != 0 && dy != 0) {
+					if (_jump(p_search, x + dx, y, dx, 0, p_end_x, p_end_y) != -1 || _jump(p_search, x, y + dy, 0, dy, p_end_x, p_end_y) != -1) {
+						return idx;
+					}
+					if (!WALKABLE(x + dx, y) || !WALKABLE(x, y + dy)) {
+						return -1; // Cannot cut the corner.
+					}
+				} else if (dx != 0) {
+					if ((WALKABLE(x, y - 1) && !WALKABLE(x - dx, y - 1)) || (WALKABLE(x, y + 1) && !WALKABLE(x - dx, y + 1))) {
+						return idx;
+					}
+				} else {
+					if ((WALKABLE(x - 1, y) && !WALKABLE(x - 1, y - dy)) || (WALKABLE(x + 1, y) && !WALKABLE(x + 1, y - dy))) {
+						return idx;
+					}
+				}
+			} break;
+			default: {
+				ERR_FAIL_V(-1);
+			}
+		}
+
+		x += dx;
+		y += dy;
+	}
+}
+
+int AStarGrid2D::_get_neighbours(const Search &p_search, int p_x, int p_y, int p_dx, int p_dy, int r_dirs[8][2]) const {
+
+	int count = 0;
+	int x = p_x;
+	int y = p_y;
+	int dx = p_dx;
+	int dy = p_dy;
+
+#define PUSH_DIR(m_dx, m_dy)    \
+	{                           \
+		r_dirs[count][0] = m_dx; \
+		r_dirs[count][1] = m_dy; \
+		count++;                 \
+	}
+
+	if (dx == 0 && dy == 0) {
+		// No parent direction, all the natural neighbours.
+		static const int dirs[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+		for (int i = 0; i < 8; i++) {
+			int ndx = dirs[i][0];
+			int ndy = dirs[i][1];
+			if (!WALKABLE(x + ndx, y + ndy)) {
+				continue;
+			}
+			if (ndx != 0 && ndy != 0) {
+				if (diagonal_mode == DIAGONAL_MODE_NEVER) {
+					continue;
+				}
+				if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES && (!WALKABLE(x + ndx, y) || !WALKABLE(x, y + ndy))) {
+					continue;
+				}
+			}
+			PUSH_DIR(ndx, ndy);
+		}
+		return count;
+	}
+
+	// Jump point search, prune the neighbours that are reached at least as cheaply without passing through this cell.
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS: {
+			if (dx != 0 && dy != 0) {
+				if (WALKABLE(x, y + dy)) PUSH_DIR(0, dy);
+				if (WALKABLE(x + dx, y)) PUSH_DIR(dx, 0);
+				if (WALKABLE(x + dx, y + dy)) PUSH_DIR(dx, dy);
+				if (!WALKABLE(x - dx, y)) PUSH_DIR(-dx, dy);
+				if (!WALKABLE(x, y - dy)) PUSH_DIR(dx, -dy);
+			} else if (dx == 0) {
+				if (WALKABLE(x, y + dy)) PUSH_DIR(0, dy);
+				if (!WALKABLE(x + 1, y)) PUSH_DIR(1, dy);
+				if (!WALKABLE(x - 1, y)) PUSH_DIR(-1, dy);
+			} else {
+				if (WALKABLE(x + dx, y)) PUSH_DIR(dx, 0);
+				if (!WALKABLE(x, y + 1)) PUSH_DIR(dx, 1);
+				if (!WALKABLE(x, y - 1)) PUSH_DIR(dx, -1);
+			}
+		} break;
+		case DIAGONAL_MODE_NEVER: {
+			if (dx != 0) {
+				if (WALKABLE(x, y - 1)) PUSH_DIR(0, -1);
+				if (WALKABLE(x, y + 1)) PUSH_DIR(0, 1);
+				if (WALKABLE(x + dx, y)) PUSH_DIR(dx, 0);
+			} else {
+				if (WALKABLE(x - 1, y)) PUSH_DIR(-1, 0);
+				if (WALKABLE(x + 1, y)) PUSH_DIR(1, 0);
+				if (WALKABLE(x, y + dy)) PUSH_DIR(0, dy);
+			}
+		} break;
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES: {
+			if (dx != 0 && dy != 0) {
+				bool next_x = WALKABLE(x + dx, y);
+				bool next_y = WALKABLE(x, y + dy);
+				if (next_y) PUSH_DIR(0, dy);
+				if (next_x) PUSH_DIR(dx, 0);
+				if (next_x && next_y) PUSH_DIR(dx, dy);
+			} else if (dx != 0) {
+				bool next = WALKABLE(x + dx, y);
+				bool up = WALKABLE(x, y - 1);
+				bool down = WALKABLE(x, y + 1);
+				if (next) {
+					PUSH_DIR(dx, 0);
+					if (down) PUSH_DIR(dx, 1);
+					if (up) PUSH_DIR(dx, -1);
+				}
+				if (down) PUSH_DIR(0, 1);
+				if (up) PUSH_DIR(0, -1);
+			} else {
+				bool next = WALKABLE(x, y + dy);
+				bool right = WALKABLE(x + 1, y);
+				bool left = WALKABLE(x - 1, y);
+				if (next) {
+					PUSH_DIR(0, dy);
+					if (right) PUSH_DIR(1, dy);
+					if (left) PUSH_DIR(-1, dy);
+				}
+				if (right) PUSH_DIR(1, 0);
+				if (left) PUSH_DIR(-1, 0);
+			}
+		} break;
+		default: {
+		}
+	}
+
+#undef PUSH_DIR
+#undef WALKABLE
+
+	return count;
+}
+
+bool AStarGrid2D::_solve(Search &p_search, int p_from_x, int p_from_y, int p_to_x, int p_to_y, bool p_jump, const int *p_targets, int p_target_count) const {
+
+	// A negative destination explores the reachable cells of the search rectangle without heuristic, until
+	// the given target cells are closed. Targets are transitions, so they lie on the border of the rectangle.
+	bool explore = p_to_x < 0;
+	int targets_left = p_target_count;
+
+	CellState *states = p_search.states.ptrw();
+	SortArray<OpenCell, SortOpenCells> sorter;
+	const real_t *weights = (p_jump || weight_scales.empty()) ? NULL : weight_scales.ptr();
+
+	int from_idx = (p_from_y - p_search.y) * p_search.width + (p_from_x - p_search.x);
+	int to_idx = explore ? -1 : (p_to_y - p_search.y) * p_search.width + (p_to_x - p_search.x);
+
+	states[from_idx].g_score = 0;
+	states[from_idx].prev = -1;
+	states[from_idx].pass = p_search.open_pass;
+
+	if (p_search.open_list.size() < 64) {
+		p_search.open_list.resize(64);
+	}
+	OpenCell *open_list = p_search.open_list.ptrw();
+	int open_count = 1;
+	open_list[0].idx = from_idx;
+	open_list[0].g_score = 0;
+	open_list[0].f_score = explore ? 0 : _estimate_cost(p_from_x, p_from_y, p_to_x, p_to_y);
+
+	while (open_count > 0) {
+
+		OpenCell current = open_list[0];
+		sorter.pop_heap(0, open_count, open_list);
+		open_count--;
+
+		CellState &state = states[current.idx];
+		if (state.pass == p_search.closed_pass || current.g_score > state.g_score) {
+			continue; // Outdated entry, the cell was reached more cheaply since it was queued.
+		}
+		if (current.idx == to_idx) {
+			return true;
+		}
+		state.pass = p_search.closed_pass;
+
+		int x = p_search.x + current.idx % p_search.width;
+		int y = p_search.y + current.idx / p_search.width;
+
+		if (p_targets && (x == p_search.x || y == p_search.y || x == p_search.x + p_search.width - 1 || y == p_search.y + p_search.height - 1)) {
+			for (int i = 0; i < p_target_count; i++) {
+				if (p_targets[i] == y * width + x) {
+					targets_left--;
+					break;
+				}
+			}
+			if (targets_left == 0) {
+				return false;
+			}
+		}
+
+		int dx = 0;
+		int dy = 0;
+		if (p_jump && state.prev != -1) {
+			int prev_x = p_search.x + state.prev % p_search.width;
+			int prev_y = p_search.y + state.prev / p_search.width;
+			dx = SGN(x - prev_x);
+			dy = SGN(y - prev_y);
+		}
+
+		int dirs[8][2];
+		int dir_count = _get_neighbours(p_search, x, y, dx, dy, dirs);
+
+		for (int i = 0; i < dir_count; i++) {
+
+			int n_x = x + dirs[i][0];
+			int n_y = y + dirs[i][1];
+			int n_idx;
+
+			if (p_jump) {
+				n_idx = _jump(p_search, n_x, n_y, dirs[i][0], dirs[i][1], p_to_x, p_to_y);
+				if (n_idx == -1) {
+					continue;
+				}
+				n_x = p_search.x + n_idx % p_search.width;
+				n_y = p_search.y + n_idx / p_search.width;
+			} else {
+				n_idx = (n_y - p_search.y) * p_search.width + (n_x - p_search.x);
+			}
+
+			CellState &n_state = states[n_idx];
+			if (n_state.pass == p_search.closed_pass) {
+				continue;
+			}
+
+			real_t cost = _compute_cost(x, y, n_x, n_y);
+			if (weights) {
+				cost *= weights[n_y * width + n_x];
+			}
+			real_t g_score = state.g_score + cost;
+
+			if (n_state.pass == p_search.open_pass && g_score >= n_state.g_score) {
+				continue; // The new path is worse than the previous.
+			}
+
+			n_state.pass = p_search.open_pass;
+			n_state.g_score = g_score;
+			n_state.prev = current.idx;
+
+			if (open_count == p_search.open_list.size()) {
+				p_search.open_list.resize(open_count * 2);
+				open_list = p_search.open_list.ptrw();
+			}
+
+			OpenCell entry;
+			entry.idx = n_idx;
+			entry.g_score = g_score;
+			entry.f_score = g_score + (explore ? 0 : _estimate_cost(n_x, n_y, p_to_x, p_to_y));
+			open_list[open_count] = entry;
+			sorter.push_heap(0, open_count, 0, entry, open_list);
+			open_count++;
+		}
+	}
+
+	return false;
+}
+
+void AStarGrid2D::_append_path(const Search &p_search, int p_to_idx, Vector<int> &r_path) const {
+
+	Vector<int> points;
+	for (int idx = p_to_idx; idx != -1; idx = p_search.states[idx].prev) {
+		points.push_back(idx);
+	}
+
+	int prev_x = 0;
+	int prev_y = 0;
+	for (int i = points.size() - 1; i >= 0; i--) {
+		int x = p_search.x + points[i] % p_search.width;
+		int y = p_search.y + points[i] / p_search.width;
+
+		if (i == points.size() - 1) {
+			// Paths of consecutive searches share their joint cell.
+			if (r_path.empty() || r_path[r_path.size() - 1] != y * width + x) {
+				r_path.push_back(y * width + x);
+			}
+		} else {
+			// Jump points are joined by straight or diagonal segments, fill in the cells between them.
+			int dx = SGN(x - prev_x);
+			int dy = SGN(y - prev_y);
+			while (prev_x != x || prev_y != y) {
+				prev_x += dx;
+				prev_y += dy;
+				r_path.push_back(prev_y * width + prev_x);
+			}
+		}
+
+		prev_x = x;
+		prev_y = y;
+	}
+}
+
+void AStarGrid2D::_setup_clusters() {
+
+	clusters.clear();
+	clusters_x = 0;
+	clusters_y = 0;
+	clusters_dirty = false;
+
+	if (cluster_size <= 0 || width == 0 || height == 0) {
+		return;
+	}
+
+	clusters_x = (width + cluster_size - 1) / cluster_size;
+	clusters_y = (height + cluster_size - 1) / cluster_size;
+	clusters.resize(clusters_x * clusters_y);
+
+	Cluster *w = clusters.ptrw();
+	for (int i = 0; i < clusters.size(); i++) {
+		w[i].dirty = true;
+	}
+	clusters_dirty = true;
+}
+
+void AStarGrid2D::_get_cluster_rect(int p_cluster, int &r_x, int &r_y, int &r_width, int &r_height) const {
+
+	r_x = (p_cluster % clusters_x) * cluster_size;
+	r_y = (p_cluster / clusters_x) * cluster_size;
+	r_width = MIN(cluster_size, width - r_x);
+	r_height = MIN(cluster_size, height - r_y);
+}
+
+void AStarGrid2D::_mark_clusters_dirty(int p_x, int p_y) {
+
+	if (clusters.empty()) {
+		return;
+	}
+
+	// Transitions on the borders are shared with the neighbouring clusters, so they change as well.
+	int cx = p_x / cluster_size;
+	int cy = p_y / cluster_size;
+	static const int offsets[5][2] = { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+	for (int i = 0; i < 5; i++) {
+		int x = cx + offsets[i][0];
+		int y = cy + offsets[i][1];
+		if (x < 0 || y < 0 || x >= clusters_x || y >= clusters_y) {
+			continue;
+		}
+		clusters.write[y * clusters_x + x].dirty = true;
+	}
+	clusters_dirty = true;
+}
+
+void AStarGrid2D::_add_transition(Cluster &r_cluster, int p_cell, int p_partner) const {
+
+	int node = -1;
+	for (int i = 0; i < r_cluster.nodes.size(); i++) {
+		if (r_cluster.nodes[i].cell == p_cell) {
+			node = i;
+			break;
+		}
+	}
+	if (node == -1) {
+		ClusterNode n;
+		n.cell = p_cell;
+		n.partner_count = 0;
+		r_cluster.nodes.push_back(n);
+		node = r_cluster.nodes.size() - 1;
+	}
+
+	ClusterNode &n = r_cluster.nodes.write[node];
+	for (int i = 0; i < n.partner_count; i++) {
+		if (n.partners[i] == p_partner) {
+			return;
+		}
+	}
+	ERR_FAIL_COND(n.partner_count == 4);
+	n.partners[n.partner_count++] = p_partner;
+}
+
+void AStarGrid2D::_add_transitions(Cluster &r_cluster, int p_cluster_x, int p_cluster_y, int p_side) const {
+
+	static const int sides[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+	int nx = p_cluster_x + sides[p_side][0];
+	int ny = p_cluster_y + sides[p_side][1];
+	if (nx < 0 || ny < 0 || nx >= clusters_x || ny >= clusters_y) {
+		return;
+	}
+
+	int x, y, w, h;
+	_get_cluster_rect(p_cluster_y * clusters_x + p_cluster_x, x, y, w, h);
+
+	// Walk the border in the same order from both sides, so both clusters pick the same transitions.
+	int length;
+	int from_x, from_y;
+	int step_x, step_y;
+	if (sides[p_side][0] != 0) {
+		length = h;
+		from_x = sides[p_side][0] > 0 ? x + w - 1 : x;
+		from_y = y;
+		step_x = 0;
+		step_y = 1;
+	} else {
+		length = w;
+		from_x = x;
+		from_y = sides[p_side][1] > 0 ? y + h - 1 : y;
+		step_x = 1;
+		step_y = 0;
+	}
+
+	int run_start = -1;
+	for (int i = 0; i <= length; i++) {
+
+		bool open = false;
+		if (i < length) {
+			int ax = from_x + step_x * i;
+			int ay = from_y + step_y * i;
+			open = !solid[ay * width + ax] && !solid[(ay + sides[p_side][1]) * width + ax + sides[p_side][0]];
+		}
+
+		if (open) {
+			if (run_start == -1) {
+				run_start = i;
+			}
+			continue;
+		}
+		if (run_start == -1) {
+			continue;
+		}
+
+		// Short openings get one transition in the middle, long ones one at each end.
+		int run_end = i - 1;
+		int picks[2];
+		int pick_count = 0;
+		if (run_end - run_start < 5) {
+			picks[pick_count++] = (run_start + run_end) / 2;
+		} else {
+			picks[pick_count++] = run_start;
+			picks[pick_count++] = run_end;
+		}
+		run_start = -1;
+
+		for (int j = 0; j < pick_count; j++) {
+			int ax = from_x + step_x * picks[j];
+			int ay = from_y + step_y * picks[j];
+			_add_transition(r_cluster, ay * width + ax, (ay + sides[p_side][1]) * width + ax + sides[p_side][0]);
+		}
+	}
+
+	if (diagonal_mode != DIAGONAL_MODE_ALWAYS) {
+		return;
+	}
+
+	// Diagonal moves can squeeze between two obstacles, where no straight transition joins the clusters.
+	for (int i = 0; i < length; i++) {
+		int ax = from_x + step_x * i;
+		int ay = from_y + step_y * i;
+		if (solid[ay * width + ax] || !solid[(ay + sides[p_side][1]) * width + ax + sides[p_side][0]]) {
+			continue;
+		}
+
+		for (int k = -1; k <= 1; k += 2) {
+			int cx = ax + step_x * k;
+			int cy = ay + step_y * k;
+			int bx = cx + sides[p_side][0];
+			int by = cy + sides[p_side][1];
+			if (!is_in_bounds(cx, cy) || !is_in_bounds(bx, by)) {
+				continue;
+			}
+			if (solid[cy * width + cx] && !solid[by * width + bx]) {
+				_add_transition(r_cluster, ay * width + ax, by * width + bx);
+			}
+		}
+	}
+}
+
+void AStarGrid2D::_build_cluster(uint32_t p_index, ClusterBuild *p_build) {
+
+	int index = p_build->indices[p_index];
+	Cluster &cluster = p_build->clusters[index];
+	int cluster_x = index % clusters_x;
+	int cluster_y = index / clusters_x;
+
+	cluster.nodes.clear();
+	for (int i = 0; i < 4; i++) {
+		_add_transitions(cluster, cluster_x, cluster_y, i);
+	}
+
+	int x, y, w, h;
+	_get_cluster_rect(index, x, y, w, h);
+
+	int node_count = cluster.nodes.size();
+	cluster.costs.resize(node_count * node_count);
+	real_t *costs = cluster.costs.ptrw();
+
+	Vector<int> targets;
+	targets.resize(node_count);
+	for (int i = 0; i < node_count; i++) {
+		targets.write[i] = cluster.nodes[i].cell;
+	}
+
+	// Without weight scales costs are the same both ways, so each search only needs the nodes after its own.
+	bool symmetric = weight_scales.empty();
+
+	Search local_search;
+	for (int i = 0; i < node_count; i++) {
+		costs[i * node_count + i] = 0;
+
+		int first = symmetric ? i + 1 : 0;
+		if (first == node_count) {
+			continue;
+		}
+
+		const ClusterNode &from = cluster.nodes[i];
+		local_search.begin(x, y, w, h);
+		_solve(local_search, from.cell % width, from.cell / width, -1, -1, false, targets.ptr() + first, node_count - first);
+
+		for (int j = first; j < node_count; j++) {
+			if (j == i) {
+				continue;
+			}
+			const ClusterNode &to = cluster.nodes[j];
+			int local = (to.cell / width - y) * w + (to.cell % width - x);
+			const CellState &state = local_search.states[local];
+			costs[i * node_count + j] = state.pass == local_search.closed_pass ? state.g_score : INFINITY;
+			if (symmetric) {
+				costs[j * node_count + i] = costs[i * node_count + j];
+			}
+		}
+	}
+
+	cluster.dirty = false;
+}
+
+void AStarGrid2D::_update_clusters() {
+
+	if (!clusters_dirty) {
+		return;
+	}
+
+	Vector<int> dirty;
+	for (int i = 0; i < clusters.size(); i++) {
+		if (clusters[i].dirty) {
+			dirty.push_back(i);
+		}
+	}
+
+	ClusterBuild build;
+	build.indices = dirty.ptr();
+	build.clusters = clusters.ptrw();
+
+	if (WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0 && dirty.size() > 1) {
+		WorkerThreadPool::get_singleton()->parallel_for(dirty.size(), this, &AStarGrid2D::_build_cluster, &build);
+	} else {
+		for (int i = 0; i < dirty.size(); i++) {
+			_build_cluster(i, &build);
+		}
+	}
+
+	clusters_dirty = false;
+}
+
+void AStarGrid2D::_push_abstract(HashMap<int, AbstractState> &r_states, Vector<OpenCell> &r_open_list, int &r_open_count, int p_cell, real_t p_g_score, int p_prev, int p_to_x, int p_to_y) const {
+
+	AbstractState *state = r_states.getptr(p_cell);
+	if (state) {
+		if (state->closed || p_g_score >= state->g_score) {
+			return;
+		}
+	} else {
+		state = &r_states[p_cell];
+		state->closed = false;
+	}
+	state->g_score = p_g_score;
+	state->prev = p_prev;
+
+	OpenCell entry;
+	entry.idx = p_cell;
+	entry.g_score = p_g_score;
+	entry.f_score = p_g_score + _estimate_cost(p_cell % width, p_cell / width, p_to_x, p_to_y);
+
+	if (r_open_count == r_open_list.size()) {
+		r_open_list.resize(MAX(64, r_open_count * 2));
+	}
+	SortArray<OpenCell, SortOpenCells> sorter;
+	r_open_list.write[r_open_count] = entry;
+	sorter.push_heap(0, r_open_count, 0, entry, r_open_list.ptrw());
+	r_open_count++;
+}
+
+bool AStarGrid2D::_solve_hierarchical(int p_from_x, int p_from_y, int p_to_x, int p_to_y, Vector<int> &r_path) {
+
+	_update_clusters();
+
+	int from_cluster = (p_from_y / cluster_size) * clusters_x + p_from_x / cluster_size;
+	int to_cluster = (p_to_y / cluster_size) * clusters_x + p_to_x / cluster_size;
+	int x, y, w, h;
+
+	if (from_cluster == to_cluster) {
+		_get_cluster_rect(from_cluster, x, y, w, h);
+		search.begin(x, y, w, h);
+		if (_solve(search, p_from_x, p_from_y, p_to_x, p_to_y, jumping_enabled)) {
+			_append_path(search, (p_to_y - y) * w + (p_to_x - x), r_path);
+			return true;
+		}
+		// The way around may leave the cluster, go through the abstract graph.
+	}
+
+	// Cost from the start to the transitions of its cluster, and from the transitions of the destination cluster to the end.
+	const Cluster &from_c = clusters[from_cluster];
+	const Cluster &to_c = clusters[to_cluster];
+
+	Vector<int> targets;
+	targets.resize(from_c.nodes.size());
+	for (int i = 0; i < from_c.nodes.size(); i++) {
+		targets.write[i] = from_c.nodes[i].cell;
+	}
+
+	Vector<real_t> from_costs;
+	from_costs.resize(from_c.nodes.size());
+	_get_cluster_rect(from_cluster, x, y, w, h);
+	search.begin(x, y, w, h);
+	_solve(search, p_from_x, p_from_y, -1, -1, false, targets.ptr(), targets.size());
+	for (int i = 0; i < from_c.nodes.size(); i++) {
+		int cell = from_c.nodes[i].cell;
+		const CellState &state = search.states[(cell / width - y) * w + (cell % width - x)];
+		from_costs.write[i] = state.pass == search.closed_pass ? state.g_score : INFINITY;
+	}
+
+	targets.resize(to_c.nodes.size());
+	for (int i = 0; i < to_c.nodes.size(); i++) {
+		targets.write[i] = to_c.nodes[i].cell;
+	}
+
+	Vector<real_t> to_costs;
+	to_costs.resize(to_c.nodes.size());
+	_get_cluster_rect(to_cluster, x, y, w, h);
+	search.begin(x, y, w, h);
+	_solve(search, p_to_x, p_to_y, -1, -1, false, targets.ptr(), targets.size());
+	for (int i = 0; i < to_c.nodes.size(); i++) {
+		int cell = to_c.nodes[i].cell;
+		const CellState &state = search.states[(cell / width - y) * w + (cell % width - x)];
+		to_costs.write[i] = state.pass == search.closed_pass ? state.g_score : INFINITY;
+	}
+
+	// A* over the transitions, nodes are identified by their cell and -1 stands for the end.
+	HashMap<int, AbstractState> states;
+	Vector<OpenCell> open_list;
+	int open_count = 0;
+	SortArray<OpenCell, SortOpenCells> sorter;
+
+	for (int i = 0; i < from_c.nodes.size(); i++) {
+		if (from_costs[i] < INFINITY) {
+			_push_abstract(states, open_list, open_count, from_c.nodes[i].cell, from_costs[i], -1, p_to_x, p_to_y);
+		}
+	}
+
+	real_t end_g_score = INFINITY;
+	int end_prev = -1;
+	bool found_route = false;
+
+	while (open_count > 0) {
+
+		OpenCell current = open_list[0];
+		sorter.pop_heap(0, open_count, open_list.ptrw());
+		open_count--;
+
+		if (current.idx == -1) {
+			if (current.g_score <= end_g_score) {
+				found_route = true;
+				break;
+			}
+			continue;
+		}
+
+		AbstractState *state = states.getptr(current.idx);
+		if (state->closed || current.g_score > state->g_score) {
+			continue;
+		}
+		state->closed = true;
+		real_t g_score = state->g_score;
+
+		int cell = current.idx;
+		int cell_x = cell % width;
+		int cell_y = cell / width;
+		int c = (cell_y / cluster_size) * clusters_x + cell_x / cluster_size;
+		const Cluster &cluster = clusters[c];
+
+		int node = -1;
+		for (int i = 0; i < cluster.nodes.size(); i++) {
+			if (cluster.nodes[i].cell == cell) {
+				node = i;
+				break;
+			}
+		}
+		ERR_CONTINUE(node == -1);
+
+		if (c == to_cluster && to_costs[node] < INFINITY && g_score + to_costs[node] < end_g_score) {
+			end_g_score = g_score + to_costs[node];
+			end_prev = cell;
+
+			OpenCell entry;
+			entry.idx = -1;
+			entry.g_score = end_g_score;
+			entry.f_score = end_g_score;
+			if (open_count == open_list.size()) {
+				open_list.resize(MAX(64, open_count * 2));
+			}
+			open_list.write[open_count] = entry;
+			sorter.push_heap(0, open_count, 0, entry, open_list.ptrw());
+			open_count++;
+		}
+
+		int node_count = cluster.nodes.size();
+		for (int i = 0; i < node_count; i++) {
+			real_t cost = cluster.costs[node * node_count + i];
+			if (i != node && cost < INFINITY) {
+				_push_abstract(states, open_list, open_count, cluster.nodes[i].cell, g_score + cost, cell, p_to_x, p_to_y);
+			}
+		}
+
+		const ClusterNode &n = cluster.nodes[node];
+		for (int i = 0; i < n.partner_count; i++) {
+			int partner = n.partners[i];
+			real_t cost = _compute_cost(cell_x, cell_y, partner % width, partner / width);
+			if (!weight_scales.empty()) {
+				cost *= weight_scales[partner];
+			}
+			_push_abstract(states, open_list, open_count, partner, g_score + cost, cell, p_to_x, p_to_y);
+		}
+	}
+
+	if (!found_route) {
+		return false;
+	}
+
+	Vector<int> nodes;
+	for (int cell = end_prev; cell != -1; cell = states[cell].prev) {
+		nodes.push_back(cell);
+	}
+
+	// Refine the abstract path, searching inside one cluster at a time.
+	int current_x = p_from_x;
+	int current_y = p_from_y;
+	int current_cluster = from_cluster;
+	for (int i = nodes.size(); i >= 0; i--) {
+		int next_x = i > 0 ? nodes[i - 1] % width : p_to_x;
+		int next_y = i > 0 ? nodes[i - 1] / width : p_to_y;
+		int next_cluster = (next_y / cluster_size) * clusters_x + next_x / cluster_size;
+
+		if (next_cluster == current_cluster) {
+			_get_cluster_rect(current_cluster, x, y, w, h);
+			search.begin(x, y, w, h);
+			ERR_FAIL_COND_V(!_solve(search, current_x, current_y, next_x, next_y, jumping_enabled), false);
+			_append_path(search, (next_y - y) * w + (next_x - x), r_path);
+		} else {
+			// A transition, the cells are next to each other.
+			if (r_path.empty()) {
+				r_path.push_back(current_y * width + current_x);
+			}
+			r_path.push_back(next_y * width + next_x);
+		}
+
+		current_x = next_x;
+		current_y = next_y;
+		current_cluster = next_cluster;
+	}
+
+	return true;
+}
+
+bool AStarGrid2D::_find_path(const Vector2 &p_from, const Vector2 &p_to, Vector<int> &r_path) {
+
+	int from_x = (int)p_from.x;
+	int from_y = (int)p_from.y;
+	int to_x = (int)p_to.x;
+	int to_y = (int)p_to.y;
+
+	ERR_FAIL_COND_V_MSG(!is_in_bounds(from_x, from_y), false, vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s)", p_from.x, width, p_from.y, height));
+	ERR_FAIL_COND_V_MSG(!is_in_bounds(to_x, to_y), false, vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s)", p_to.x, width, p_to.y, height));
+
+	if (solid[to_y * width + to_x]) {
+		return false;
+	}
+
+	if (!clusters.empty()) {
+		return _solve_hierarchical(from_x, from_y, to_x, to_y, r_path);
+	}
+
+	search.begin(0, 0, width, height);
+	if (!_solve(search, from_x, from_y, to_x, to_y, jumping_enabled)) {
+		return false;
+	}
+	_append_path(search, to_y * width + to_x, r_path);
+	return true;
+}
+
+void AStarGrid2D::set_size(const Vector2 &p_size) {
+
+	int new_width = (int)p_size.x;
+	int new_height = (int)p_size.y;
+	ERR_FAIL_COND(new_width < 0 || new_height < 0);
+	ERR_FAIL_COND_MSG((int64_t)new_width * new_height > (1 << 30), "Grid is too large.");
+
+	width = new_width;
+	height = new_height;
+
+	solid.resize(width * height);
+	if (solid.size()) {
+		memset(solid.ptrw(), 0, solid.size());
+	}
+	weight_scales.clear();
+	search = Search();
+
+	_setup_clusters();
+}
+
+Vector2 AStarGrid2D::get_size() const {
+	return Vector2(width, height);
+}
+
+void AStarGrid2D::set_offset(const Vector2 &p_offset) {
+	offset = p_offset;
+}
+
+Vector2 AStarGrid2D::get_offset() const {
+	return offset;
+}
+
+void AStarGrid2D::set_cell_size(const Vector2 &p_cell_size) {
+	cell_size = p_cell_size;
+	_setup_clusters(); // Transition costs depend on it.
+}
+
+Vector2 AStarGrid2D::get_cell_size() const {
+	return cell_size;
+}
+
+void AStarGrid2D::set_default_heuristic(Heuristic p_heuristic) {
+	ERR_FAIL_INDEX(p_heuristic, HEURISTIC_MAX);
+	heuristic = p_heuristic;
+}
+
+AStarGrid2D::Heuristic AStarGrid2D::get_default_heuristic() const {
+	return heuristic;
+}
+
+void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
+	ERR_FAIL_INDEX(p_diagonal_mode, DIAGONAL_MODE_MAX);
+	diagonal_mode = p_diagonal_mode;
+	_setup_clusters(); // Transition costs depend on it.
+}
+
+AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
+	return diagonal_mode;
+}
+
+void AStarGrid2D::set_jumping_enabled(bool p_enabled) {
+	jumping_enabled = p_enabled;
+}
+
+bool AStarGrid2D::is_jumping_enabled() const {
+	return jumping_enabled;
+}
+
+void AStarGrid2D::set_cluster_size(int p_cluster_size) {
+	ERR_FAIL_COND(p_cluster_size < 0);
+	cluster_size = p_cluster_size;
+	_setup_clusters();
+}
+
+int AStarGrid2D::get_cluster_size() const {
+	return cluster_size;
+}
+
+bool AStarGrid2D::is_in_bounds(int p_x, int p_y) const {
+	return p_x >= 0 && p_x < width && p_y >= 0 && p_y < height;
+}
+
+void AStarGrid2D::set_point_solid(const Vector2 &p_id, bool p_solid) {
+
+	int x = (int)p_id.x;
+	int y = (int)p_id.y;
+	ERR_FAIL_COND_MSG(!is_in_bounds(x, y), vformat("Can't set if point is solid. Point out of bounds (%s/%s, %s/%s)", p_id.x, width, p_id.y, height));
+
+	uint8_t value = p_solid ? 1 : 0;
+	if (solid[y * width + x] == value) {
+		return;
+	}
+	solid.write[y * width + x] = value;
+	_mark_clusters_dirty(x, y);
+}
+
+bool AStarGrid2D::is_point_solid(const Vector2 &p_id) const {
+
+	int x = (int)p_id.x;
+	int y = (int)p_id.y;
+	ERR_FAIL_COND_V_MSG(!is_in_bounds(x, y), false, vformat("Can't get if point is solid. Point out of bounds (%s/%s, %s/%s)", p_id.x, width, p_id.y, height));
+
+	return solid[y * width + x];
+}
+
+void AStarGrid2D::set_point_weight_scale(const Vector2 &p_id, real_t p_weight_scale) {
+
+	int x = (int)p_id.x;
+	int y = (int)p_id.y;
+	ERR_FAIL_COND_MSG(!is_in_bounds(x, y), vformat("Can't set point's weight scale. Point out of bounds (%s/%s, %s/%s)", p_id.x, width, p_id.y, height));
+	ERR_FAIL_COND(p_weight_scale < 1);
+
+	if (weight_scales.empty()) {
+		if (p_weight_scale == 1) {
+			return;
+		}
+		weight_scales.resize(width * height);
+		real_t *w = weight_scales.ptrw();
+		for (int i = 0; i < weight_scales.size(); i++) {
+			w[i] = 1;
+		}
+	}
+	weight_scales.write[y * width + x] = p_weight_scale;
+	_mark_clusters_dirty(x, y);
+}
+
+real_t AStarGrid2D::get_point_weight_scale(const Vector2 &p_id) const {
+
+	int x = (int)p_id.x;
+	int y = (int)p_id.y;
+	ERR_FAIL_COND_V_MSG(!is_in_bounds(x, y), 0, vformat("Can't get point's weight scale. Point out of bounds (%s/%s, %s/%s)", p_id.x, width, p_id.y, height));
+
+	return weight_scales.empty() ? 1 : weight_scales[y * width + x];
+}
+
+Vector2 AStarGrid2D::get_point_position(const Vector2 &p_id) const {
+
+	return offset + Vector2((int)p_id.x, (int)p_id.y) * cell_size;
+}
+
+void AStarGrid2D::clear() {
+
+	set_size(Vector2());
+}
+
+PoolVector<Vector2> AStarGrid2D::get_point_path(const Vector2 &p_from_id, const Vector2 &p_to_id) {
+
+	Vector<int> cells;
+	if (!_find_path(p_from_id, p_to_id, cells)) {
+		return PoolVector<Vector2>();
+	}
+
+	PoolVector<Vector2> path;
+	path.resize(cells.size());
+	{
+		PoolVector<Vector2>::Write w = path.write();
+		for (int i = 0; i < cells.size(); i++) {
+			w[i] = offset + Vector2(cells[i] % width, cells[i] / width) * cell_size;
+		}
+	}
+	return path;
+}
+
+PoolVector<Vector2> AStarGrid2D::get_id_path(const Vector2 &p_from_id, const Vector2 &p_to_id) {
+
+	Vector<int> cells;
+	if (!_find_path(p_from_id, p_to_id, cells)) {
+		return PoolVector<Vector2>();
+	}
+
+	PoolVector<Vector2> path;
+	path.resize(cells.size());
+	{
+		PoolVector<Vector2>::Write w = path.write();
+		for (int i = 0; i < cells.size(); i++) {
+			w[i] = Vector2(cells[i] % width, cells[i] / width);
+		}
+	}
+	return path;
+}
+
+void AStarGrid2D::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("set_size", "size"), &AStarGrid2D::set_size);
+	ClassDB::bind_method(D_METHOD("get_size"), &AStarGrid2D::get_size);
+	ClassDB::bind_method(D_METHOD("set_offset", "offset"), &AStarGrid2D::set_offset);
+	ClassDB::bind_method(D_METHOD("get_offset"), &AStarGrid2D::get_offset);
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &AStarGrid2D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &AStarGrid2D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_default_heuristic", "heuristic"), &AStarGrid2D::set_default_heuristic);
+	ClassDB::bind_method(D_METHOD("get_default_heuristic"), &AStarGrid2D::get_default_heuristic);
+	ClassDB::bind_method(D_METHOD("set_diagonal_mode", "mode"), &AStarGrid2D::set_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("get_diagonal_mode"), &AStarGrid2D::get_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("set_jumping_enabled", "enabled"), &AStarGrid2D::set_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("is_jumping_enabled"), &AStarGrid2D::is_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("set_cluster_size", "size"), &AStarGrid2D::set_cluster_size);
+	ClassDB::bind_method(D_METHOD("get_cluster_size"), &AStarGrid2D::get_cluster_size);
+
+	ClassDB::bind_method(D_METHOD("is_in_bounds", "x", "y"), &AStarGrid2D::is_in_bounds);
+	ClassDB::bind_method(D_METHOD("set_point_solid", "id", "solid"), &AStarGrid2D::set_point_solid, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_point_solid", "id"), &AStarGrid2D::is_point_solid);
+	ClassDB::bind_method(D_METHOD("set_point_weight_scale", "id", "weight_scale"), &AStarGrid2D::set_point_weight_scale);
+	ClassDB::bind_method(D_METHOD("get_point_weight_scale", "id"), &AStarGrid2D::get_point_weight_scale);
+	ClassDB::bind_method(D_METHOD("get_point_position", "id"), &AStarGrid2D::get_point_position);
+	ClassDB::bind_method(D_METHOD("clear"), &AStarGrid2D::clear);
+
+	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
+	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarGrid2D::get_id_path);
+
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "size"), "set_size", "get_size");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "cell_size"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "default_heuristic", PROPERTY_HINT_ENUM, "Euclidean,Manhattan,Octile,Chebyshev"), "set_default_heuristic", "get_default_heuristic");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "diagonal_mode", PROPERTY_HINT_ENUM, "Always,Never,Only If No Obstacles"), "set_diagonal_mode", "get_diagonal_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "jumping_enabled"), "set_jumping_enabled", "is_jumping_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "cluster_size", PROPERTY_HINT_RANGE, "0,256,1,or_greater"), "set_cluster_size", "get_cluster_size");
+
+	BIND_ENUM_CONSTANT(HEURISTIC_EUCLIDEAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_MANHATTAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_OCTILE);
+	BIND_ENUM_CONSTANT(HEURISTIC_CHEBYSHEV);
+	BIND_ENUM_CONSTANT(HEURISTIC_MAX);
+
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ALWAYS);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_NEVER);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_MAX);
+}
+
+AStarGrid2D::AStarGrid2D() {
+
+	width = 0;
+	height = 0;
+	cell_size = Vector2(1, 1);
+	heuristic = HEURISTIC_EUCLIDEAN;
+	diagonal_mode = DIAGONAL_MODE_ALWAYS;
+	jumping_enabled = false;
+
+	cluster_size = 0;
+	clusters_x = 0;
+	clusters_y = 0;
+	clusters_dirty = false;
+}
+
+AStarGrid2D::~AStarGrid2D() {
+}
@@ -0,0 +1,228 @@
+/*************************************************************************/
+/*  a_star_grid_2d.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef A_STAR_GRID_2D_H
+#define A_STAR_GRID_2D_H
+
+#include "core/hash_map.h"
+#include "core/reference.h"
+
+/**
+	A* pathfinding specialized for uniform 2D grids.
+
+	Neighbours are implicit and all per cell data lives in contiguous arrays. Searches can use
+	jump point search, and very large grids can be searched through a hierarchy of clusters.
+*/
+
+class AStarGrid2D : public Reference {
+
+	GDCLASS(AStarGrid2D, Reference);
+
+public:
+	enum Heuristic {
+		HEURISTIC_EUCLIDEAN,
+		HEURISTIC_MANHATTAN,
+		HEURISTIC_OCTILE,
+		HEURISTIC_CHEBYSHEV,
+		HEURISTIC_MAX
+	};
+
+	enum DiagonalMode {
+		DIAGONAL_MODE_ALWAYS,
+		DIAGONAL_MODE_NEVER,
+		DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES,
+		DIAGONAL_MODE_MAX
+	};
+
+private:
+	struct CellState {
+		real_t g_score;
+		int32_t prev; // Local index of the previous cell, -1 for the start.
+		uint32_t pass; // Open when equal to the open pass of the search, closed when equal to its closed pass.
+	};
+
+	struct OpenCell {
+		int32_t idx;
+		real_t f_score;
+		real_t g_score;
+	};
+
+	struct SortOpenCells {
+		_FORCE_INLINE_ bool operator()(const OpenCell &A, const OpenCell &B) const { // Returns true when the cell A is worse than cell B.
+			if (A.f_score > B.f_score) {
+				return true;
+			} else if (A.f_score < B.f_score) {
+				return false;
+			} else {
+				return A.g_score < B.g_score;
+			}
+		}
+	};
+
+	// Search state over a rectangle of the grid, either the whole grid or a cluster.
+	struct Search {
+		int x;
+		int y;
+		int width;
+		int height;
+		Vector<CellState> states;
+		Vector<OpenCell> open_list;
+		uint32_t open_pass;
+		uint32_t closed_pass;
+
+		void begin(int p_x, int p_y, int p_width, int p_height);
+
+		Search() {
+			x = 0;
+			y = 0;
+			width = 0;
+			height = 0;
+			open_pass = 0;
+			closed_pass = 0;
+		}
+	};
+
+	struct ClusterNode {
+		int cell;
+		int partners[4]; // Cells in the neighbouring clusters this node is a transition to.
+		int partner_count;
+	};
+
+	struct Cluster {
+		bool dirty;
+		Vector<ClusterNode> nodes;
+		Vector<real_t> costs; // Cost between every pair of nodes inside the cluster, INFINITY when unreachable.
+	};
+
+	struct AbstractState {
+		real_t g_score;
+		int prev; // Cell of the previous node, -1 for the start.
+		bool closed;
+	};
+
+	struct ClusterBuild {
+		const int *indices;
+		Cluster *clusters;
+	};
+
+	int width;
+	int height;
+	Vector2 offset;
+	Vector2 cell_size;
+	Heuristic heuristic;
+	DiagonalMode diagonal_mode;
+	bool jumping_enabled;
+
+	Vector<uint8_t> solid;
+	Vector<real_t> weight_scales; // Empty until a weight scale other than 1 is set.
+
+	int cluster_size;
+	int clusters_x;
+	int clusters_y;
+	Vector<Cluster> clusters;
+	bool clusters_dirty;
+
+	Search search;
+
+	_FORCE_INLINE_ bool _is_walkable(const Search &p_search, int p_x, int p_y) const {
+		if (p_x < p_search.x || p_y < p_search.y || p_x >= p_search.x + p_search.width || p_y >= p_search.y + p_search.height) {
+			return false;
+		}
+		return !solid[p_y * width + p_x];
+	}
+
+	real_t _estimate_cost(int p_from_x, int p_from_y, int p_to_x, int p_to_y) const;
+	real_t _compute_cost(int p_from_x, int p_from_y, int p_to_x, int p_to_y) const;
+
+	int _jump(const Search &p_search, int p_x, int p_y, int p_dx, int p_dy, int p_end_x, int p_end_y) const;
+	int _get_neighbours(const Search &p_search, int p_x, int p_y, int p_dx, int p_dy, int r_dirs[8][2]) const;
+	bool _solve(Search &p_search, int p_from_x, int p_from_y, int p_to_x, int p_to_y, bool p_jump, const int *p_targets = NULL, int p_target_count = 0) const;
+	void _append_path(const Search &p_search, int p_to_idx, Vector<int> &r_path) const;
+
+	void _setup_clusters();
+	void _get_cluster_rect(int p_cluster, int &r_x, int &r_y, int &r_width, int &r_height) const;
+	void _mark_clusters_dirty(int p_x, int p_y);
+	void _add_transition(Cluster &r_cluster, int p_cell, int p_partner) const;
+	void _add_transitions(Cluster &r_cluster, int p_cluster_x, int p_cluster_y, int p_side) const;
+	void _build_cluster(uint32_t p_index, ClusterBuild *p_build);
+	void _update_clusters();
+	void _push_abstract(HashMap<int, AbstractState> &r_states, Vector<OpenCell> &r_open_list, int &r_open_count, int p_cell, real_t p_g_score, int p_prev, int p_to_x, int p_to_y) const;
+	bool _solve_hierarchical(int p_from_x, int p_from_y, int p_to_x, int p_to_y, Vector<int> &r_path);
+
+	bool _find_path(const Vector2 &p_from, const Vector2 &p_to, Vector<int> &r_path);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_size(const Vector2 &p_size);
+	Vector2 get_size() const;
+
+	void set_offset(const Vector2 &p_offset);
+	Vector2 get_offset() const;
+
+	void set_cell_size(const Vector2 &p_cell_size);
+	Vector2 get_cell_size() const;
+
+	void set_default_heuristic(Heuristic p_heuristic);
+	Heuristic get_default_heuristic() const;
+
+	void set_diagonal_mode(DiagonalMode p_diagonal_mode);
+	DiagonalMode get_diagonal_mode() const;
+
+	void set_jumping_enabled(bool p_enabled);
+	bool is_jumping_enabled() const;
+
+	void set_cluster_size(int p_cluster_size);
+	int get_cluster_size() const;
+
+	bool is_in_bounds(int p_x, int p_y) const;
+
+	void set_point_solid(const Vector2 &p_id, bool p_solid = true);
+	bool is_point_solid(const Vector2 &p_id) const;
+
+	void set_point_weight_scale(const Vector2 &p_id, real_t p_weight_scale);
+	real_t get_point_weight_scale(const Vector2 &p_id) const;
+
+	Vector2 get_point_position(const Vector2 &p_id) const;
+
+	void clear();
+
+	PoolVector<Vector2> get_point_path(const Vector2 &p_from_id, const Vector2 &p_to_id);
+	PoolVector<Vector2> get_id_path(const Vector2 &p_from_id, const Vector2 &p_to_id);
+
+	AStarGrid2D();
+	~AStarGrid2D();
+};
+
+VARIANT_ENUM_CAST(AStarGrid2D::Heuristic)
+VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode)
+
+#endif // A_STAR_GRID_2D_H
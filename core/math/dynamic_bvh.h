@@ -0,0 +1,1077 @@
+/*************************************************************************/
+/*  dynamic_bvh.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef DYNAMIC_BVH_H
+#define DYNAMIC_BVH_H
+
+#include "core/list.h"
+#include "core/math/aabb.h"
+#include "core/math/vector3.h"
+#include "core/os/memory.h"
+#include "core/vector.h"
+
+/**
+ * Dynamic AABB tree, drop-in alternative to Octree.
+ *
+ * Leaves store a fattened AABB so small movements don't touch the tree at all,
+ * new leaves are inserted by descending along the cheapest surface area cost
+ * and the tree is kept balanced with AVL style rotations. Every node caches the
+ * union of the types and masks of the elements below it, so culls and pair
+ * searches can skip whole branches that can't contain a match.
+ *
+ * Pairable elements live in their own tree, as they are usually few (lights,
+ * probes) and non-pairable elements only need to search that one for pairs.
+ * Pairs are tracked between elements whose fattened leaves overlap and are only
+ * searched for again when a leaf is reinserted. Moving inside the leaf just checks
+ * the existing pairs, calling the pair/unpair callbacks when the real AABBs start
+ * or stop touching, same as Octree.
+ */
+
+typedef uint32_t BVHElementID;
+
+#define BVH_ELEMENT_INVALID_ID 0
+
+template <class T, bool use_pairs = false>
+class DynamicBVH {
+public:
+	typedef void *(*PairCallback)(void *, BVHElementID, T *, int, BVHElementID, T *, int);
+	typedef void (*UnpairCallback)(void *, BVHElementID, T *, int, BVHElementID, T *, int, void *);
+
+private:
+	enum {
+		NODE_NULL = -1,
+		ELEMENT_PAGE_BITS = 8,
+		ELEMENT_PAGE_SIZE = 1 << ELEMENT_PAGE_BITS,
+		ELEMENT_PAGE_MASK = ELEMENT_PAGE_SIZE - 1,
+		MAX_STACK = 128, // trees are balanced, this allows for way more elements than can be addressed
+	};
+
+	enum Tree {
+		TREE_GENERAL,
+		TREE_PAIRABLE,
+		TREE_MAX
+	};
+
+	struct Node {
+
+		AABB aabb; // fattened for leaves
+		int32_t parent; // next free node when unused
+		int32_t children[2];
+		int32_t height; // 0 for leaves, -1 for unused nodes
+		BVHElementID element;
+
+		// unions of the elements below, used to prune branches
+		uint32_t type_mask;
+		uint32_t pair_mask;
+
+		_FORCE_INLINE_ bool is_leaf() const { return children[0] == NODE_NULL; }
+	};
+
+	struct PairData;
+
+	struct Element {
+
+		T *userdata;
+		int subindex;
+		bool pairable;
+		bool used;
+		uint32_t pairable_type;
+		uint32_t pairable_mask;
+		uint64_t last_pass;
+		int32_t leaf;
+		AABB aabb;
+
+		List<PairData *> pair_list;
+
+		Element() {
+			userdata = NULL;
+			subindex = 0;
+			pairable = false;
+			used = false;
+			pairable_type = 0;
+			pairable_mask = 0;
+			last_pass = 0;
+			leaf = NODE_NULL;
+		}
+	};
+
+	struct PairData {
+
+		BVHElementID A;
+		BVHElementID B;
+		bool intersect;
+		void *ud;
+		typename List<PairData *>::Element *eA, *eB;
+	};
+
+	Node *nodes;
+	int32_t node_capacity;
+	int32_t node_count;
+	int32_t free_node;
+	int32_t roots[TREE_MAX];
+
+	Element **element_pages;
+	uint32_t element_page_count;
+	uint32_t element_max;
+	Vector<BVHElementID> free_elements;
+
+	Vector<BVHElementID> pair_candidates;
+
+	PairCallback pair_callback;
+	UnpairCallback unpair_callback;
+	void *pair_callback_userdata;
+	void *unpair_callback_userdata;
+
+	uint64_t pass;
+	real_t margin_ratio;
+	int pair_count;
+
+	_FORCE_INLINE_ Element &_get_element(BVHElementID p_id) const {
+
+		uint32_t idx = p_id - 1;
+		return element_pages[idx >> ELEMENT_PAGE_BITS][idx & ELEMENT_PAGE_MASK];
+	}
+
+	_FORCE_INLINE_ bool _is_valid_element(BVHElementID p_id) const {
+
+		return p_id != BVH_ELEMENT_INVALID_ID && p_id <= element_max && _get_element(p_id).used;
+	}
+
+	_FORCE_INLINE_ static Tree _get_tree(const Element &p_element) {
+
+		return (use_pairs && p_element.pairable) ? TREE_PAIRABLE : TREE_GENERAL;
+	}
+
+	_FORCE_INLINE_ static real_t _surface_area(const AABB &p_aabb) {
+
+		const Vector3 &s = p_aabb.size;
+		return s.x * s.y + s.y * s.z + s.z * s.x;
+	}
+
+	_FORCE_INLINE_ static AABB _merge(const AABB &p_a, const AABB &p_b) {
+
+		Vector3 min(MIN(p_a.position.x, p_b.position.x), MIN(p_a.position.y, p_b.position.y), MIN(p_a.position.z, p_b.position.z));
+		Vector3 end_a = p_a.position + p_a.size;
+		Vector3 end_b = p_b.position + p_b.size;
+		Vector3 max(MAX(end_a.x, end_b.x), MAX(end_a.y, end_b.y), MAX(end_a.z, end_b.z));
+		return AABB(min, max - min);
+	}
+
+	_FORCE_INLINE_ AABB _fatten(const AABB &p_aabb) const {
+
+		real_t margin = p_aabb.get_longest_axis_size() * margin_ratio + CMP_EPSILON;
+		return AABB(p_aabb.position - Vector3(margin, margin, margin), p_aabb.size + Vector3(margin, margin, margin) * 2.0);
+	}
+
+	_FORCE_INLINE_ static bool _can_pair(const Element &p_A, const Element &p_B) {
+
+		if (!p_A.pairable && !p_B.pairable)
+			return false;
+		if (p_A.userdata == p_B.userdata && p_A.userdata)
+			return false;
+		return (p_A.pairable_type & p_B.pairable_mask) || (p_B.pairable_type & p_A.pairable_mask);
+	}
+
+	int32_t _allocate_node();
+	void _free_node(int32_t p_node);
+	void _refit_node(int32_t p_node);
+	int32_t _balance(Tree p_tree, int32_t p_node);
+	void _insert_leaf(Tree p_tree, int32_t p_leaf);
+	void _remove_leaf(Tree p_tree, int32_t p_leaf);
+	void _create_leaf(BVHElementID p_id);
+	void _destroy_leaf(BVHElementID p_id);
+
+	void _pair_add(BVHElementID p_A, BVHElementID p_B);
+	void _pair_remove(PairData *p_pair);
+	void _pair_check(PairData *p_pair);
+	void _check_pairs(BVHElementID p_id);
+	void _update_pairs(BVHElementID p_id);
+	void _remove_pairs(BVHElementID p_id);
+
+public:
+	BVHElementID create(T *p_userdata, const AABB &p_aabb = AABB(), int p_subindex = 0, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t p_pairable_mask = 1);
+	void move(BVHElementID p_id, const AABB &p_aabb);
+	void set_pairable(BVHElementID p_id, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t p_pairable_mask = 1);
+	void erase(BVHElementID p_id);
+
+	bool is_pairable(BVHElementID p_id) const;
+	T *get(BVHElementID p_id) const;
+	int get_subindex(BVHElementID p_id) const;
+
+	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+
+	void set_pair_callback(PairCallback p_callback, void *p_userdata);
+	void set_unpair_callback(UnpairCallback p_callback, void *p_userdata);
+
+	// fraction of an element's longest axis that its leaf is grown by, bigger values make moves cheaper but culls looser
+	void set_margin_ratio(real_t p_ratio) { margin_ratio = p_ratio; }
+	real_t get_margin_ratio() const { return margin_ratio; }
+
+	int get_node_count() const { return node_count; }
+	int get_pair_count() const { return pair_count; } // only pairs whose AABBs actually touch
+
+	DynamicBVH();
+	~DynamicBVH();
+};
+
+/* PRIVATE FUNCTIONS */
+
+template <class T, bool use_pairs>
+int32_t DynamicBVH<T, use_pairs>::_allocate_node() {
+
+	if (free_node == NODE_NULL) {
+
+		int32_t new_capacity = node_capacity ? node_capacity * 2 : 32;
+		nodes = (Node *)memrealloc(nodes, sizeof(Node) * new_capacity);
+
+		for (int32_t i = node_capacity; i < new_capacity; i++) {
+			nodes[i].parent = i + 1 < new_capacity ? i + 1 : (int32_t)NODE_NULL;
+			nodes[i].height = -1;
+		}
+		free_node = node_capacity;
+		node_capacity = new_capacity;
+	}
+
+	int32_t idx = free_node;
+	Node &n = nodes[idx];
+	free_node = n.parent;
+
+	n.parent = NODE_NULL;
+	n.children[0] = NODE_NULL;
+	n.children[1] = NODE_NULL;
+	n.height = 0;
+	n.element = BVH_ELEMENT_INVALID_ID;
+	n.type_mask = 0;
+	n.pair_mask = 0;
+	node_count++;
+
+	return idx;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_free_node(int32_t p_node) {
+
+	nodes[p_node].parent = free_node;
+	nodes[p_node].height = -1;
+	free_node = p_node;
+	node_count--;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_refit_node(int32_t p_node) {
+
+	Node &n = nodes[p_node];
+	const Node &a = nodes[n.children[0]];
+	const Node &b = nodes[n.children[1]];
+
+	n.aabb = _merge(a.aabb, b.aabb);
+	n.height = 1 + MAX(a.height, b.height);
+	n.type_mask = a.type_mask | b.type_mask;
+	n.pair_mask = a.pair_mask | b.pair_mask;
+}
+
+template <class T, bool use_pairs>
+int32_t DynamicBVH<T, use_pairs>::_balance(Tree p_tree, int32_t p_node) {
+
+	int32_t iA = p_node;
+	Node *A = &nodes[iA];
+
+	if (A->is_leaf() || A->height < 2)
+		return iA;
+
+	int32_t iB = A->children[0];
+	int32_t iC = A->children[1];
+	Node *B = &nodes[iB];
+	Node *C = &nodes[iC];
+
+	int32_t balance = C->height - B->height;
+
+	if (balance > 1) {
+		// rotate C up
+		int32_t iF = C->children[0];
+		int32_t iG = C->children[1];
+
+		C->children[0] = iA;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		if (C->parent != NODE_NULL) {
+			Node &P = nodes[C->parent];
+			if (P.children[0] == iA) {
+				P.children[0] = iC;
+			} else {
+				P.children[1] = iC;
+			}
+		} else {
+			roots[p_tree] = iC;
+		}
+
+		if (nodes[iF].height > nodes[iG].height) {
+			C->children[1] = iF;
+			A->children[1] = iG;
+			nodes[iG].parent = iA;
+		} else {
+			C->children[1] = iG;
+			A->children[1] = iF;
+			nodes[iF].parent = iA;
+		}
+
+		_refit_node(iA);
+		_refit_node(iC);
+		return iC;
+	}
+
+	if (balance < -1) {
+		// rotate B up
+		int32_t iD = B->children[0];
+		int32_t iE = B->children[1];
+
+		B->children[0] = iA;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		if (B->parent != NODE_NULL) {
+			Node &P = nodes[B->parent];
+			if (P.children[0] == iA) {
+				P.children[0] = iB;
+			} else {
+				P.children[1] = iB;
+			}
+		} else {
+			roots[p_tree] = iB;
+		}
+
+		if (nodes[iD].height > nodes[iE].height) {
+			B->children[1] = iD;
+			A->children[0] = iE;
+			nodes[iE].parent = iA;
+		} else {
+			B->children[1] = iE;
+			A->children[0] = iD;
+			nodes[iD].parent = iA;
+		}
+
+		_refit_node(iA);
+		_refit_node(iB);
+		return iB;
+	}
+
+	return iA;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_insert_leaf(Tree p_tree, int32_t p_leaf) {
+
+	if (roots[p_tree] == NODE_NULL) {
+		roots[p_tree] = p_leaf;
+		nodes[p_leaf].parent = NODE_NULL;
+		return;
+	}
+
+	// find the best sibling, descending along the cheapest surface area cost
+	AABB leaf_aabb = nodes[p_leaf].aabb;
+	int32_t index = roots[p_tree];
+
+	while (!nodes[index].is_leaf()) {
+
+		const Node &n = nodes[index];
+
+		real_t area = _surface_area(n.aabb);
+		real_t combined_area = _surface_area(_merge(n.aabb, leaf_aabb));
+
+		// cost of creating a new parent for this node and the new leaf
+		real_t cost = 2.0 * combined_area;
+		// minimum cost of pushing the leaf further down the tree
+		real_t inheritance_cost = 2.0 * (combined_area - area);
+
+		real_t child_cost[2];
+		for (int i = 0; i < 2; i++) {
+			const Node &c = nodes[n.children[i]];
+			real_t merged_area = _surface_area(_merge(c.aabb, leaf_aabb));
+			child_cost[i] = (c.is_leaf() ? merged_area : merged_area - _surface_area(c.aabb)) + inheritance_cost;
+		}
+
+		if (cost < child_cost[0] && cost < child_cost[1])
+			break;
+
+		index = child_cost[0] < child_cost[1] ? n.children[0] : n.children[1];
+	}
+
+	int32_t sibling = index;
+	int32_t new_parent = _allocate_node(); // may reallocate, don't hold node references across this
+	int32_t old_parent = nodes[sibling].parent;
+
+	nodes[new_parent].parent = old_parent;
+	nodes[new_parent].children[0] = sibling;
+	nodes[new_parent].children[1] = p_leaf;
+	nodes[sibling].parent = new_parent;
+	nodes[p_leaf].parent = new_parent;
+
+	if (old_parent != NODE_NULL) {
+		if (nodes[old_parent].children[0] == sibling) {
+			nodes[old_parent].children[0] = new_parent;
+		} else {
+			nodes[old_parent].children[1] = new_parent;
+		}
+	} else {
+		roots[p_tree] = new_parent;
+	}
+
+	for (index = new_parent; index != NODE_NULL; index = nodes[index].parent) {
+		_refit_node(index);
+		index = _balance(p_tree, index);
+	}
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_remove_leaf(Tree p_tree, int32_t p_leaf) {
+
+	if (p_leaf == roots[p_tree]) {
+		roots[p_tree] = NODE_NULL;
+		return;
+	}
+
+	int32_t parent = nodes[p_leaf].parent;
+	int32_t grand_parent = nodes[parent].parent;
+	int32_t sibling = nodes[parent].children[0] == p_leaf ? nodes[parent].children[1] : nodes[parent].children[0];
+
+	_free_node(parent);
+
+	if (grand_parent == NODE_NULL) {
+		roots[p_tree] = sibling;
+		nodes[sibling].parent = NODE_NULL;
+		return;
+	}
+
+	if (nodes[grand_parent].children[0] == parent) {
+		nodes[grand_parent].children[0] = sibling;
+	} else {
+		nodes[grand_parent].children[1] = sibling;
+	}
+	nodes[sibling].parent = grand_parent;
+
+	for (int32_t index = grand_parent; index != NODE_NULL; index = nodes[index].parent) {
+		_refit_node(index);
+		index = _balance(p_tree, index);
+	}
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_create_leaf(BVHElementID p_id) {
+
+	int32_t leaf = _allocate_node();
+	Element &e = _get_element(p_id);
+	Node &n = nodes[leaf];
+
+	n.aabb = _fatten(e.aabb);
+	n.element = p_id;
+	n.type_mask = e.pairable_type;
+	n.pair_mask = e.pairable_mask;
+	e.leaf = leaf;
+
+	_insert_leaf(_get_tree(e), leaf);
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_destroy_leaf(BVHElementID p_id) {
+
+	Element &e = _get_element(p_id);
+	_remove_leaf(_get_tree(e), e.leaf);
+	_free_node(e.leaf);
+	e.leaf = NODE_NULL;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_pair_add(BVHElementID p_A, BVHElementID p_B) {
+
+	Element &A = _get_element(p_A);
+	Element &B = _get_element(p_B);
+
+	PairData *pd = memnew(PairData);
+	pd->A = p_A;
+	pd->B = p_B;
+	pd->intersect = false;
+	pd->ud = NULL;
+	pd->eA = A.pair_list.push_back(pd);
+	pd->eB = B.pair_list.push_back(pd);
+
+	_pair_check(pd);
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_pair_remove(PairData *p_pair) {
+
+	Element &A = _get_element(p_pair->A);
+	Element &B = _get_element(p_pair->B);
+
+	if (p_pair->intersect) {
+		if (unpair_callback) {
+			unpair_callback(unpair_callback_userdata, p_pair->A, A.userdata, A.subindex, p_pair->B, B.userdata, B.subindex, p_pair->ud);
+		}
+		pair_count--;
+	}
+
+	A.pair_list.erase(p_pair->eA);
+	B.pair_list.erase(p_pair->eB);
+	memdelete(p_pair);
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_pair_check(PairData *p_pair) {
+
+	Element &A = _get_element(p_pair->A);
+	Element &B = _get_element(p_pair->B);
+
+	bool intersect = A.aabb.intersects_inclusive(B.aabb);
+
+	if (intersect == p_pair->intersect)
+		return;
+
+	if (intersect) {
+		if (pair_callback) {
+			p_pair->ud = pair_callback(pair_callback_userdata, p_pair->A, A.userdata, A.subindex, p_pair->B, B.userdata, B.subindex);
+		}
+		pair_count++;
+	} else {
+		if (unpair_callback) {
+			unpair_callback(unpair_callback_userdata, p_pair->A, A.userdata, A.subindex, p_pair->B, B.userdata, B.subindex, p_pair->ud);
+		}
+		pair_count--;
+	}
+
+	p_pair->intersect = intersect;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_check_pairs(BVHElementID p_id) {
+
+	for (typename List<PairData *>::Element *E = _get_element(p_id).pair_list.front(); E; E = E->next()) {
+		_pair_check(E->get());
+	}
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_update_pairs(BVHElementID p_id) {
+
+	// candidates get tagged with the current pass, ones that turn out to be paired already get pass + 1
+	pass += 2;
+	pair_candidates.clear();
+
+	Element &e = _get_element(p_id);
+
+	if (e.leaf != NODE_NULL) {
+
+		const AABB fat = nodes[e.leaf].aabb;
+
+		// non-pairable elements can only pair with pairable ones
+		int32_t stack[MAX_STACK];
+		int sp = 0;
+		if (roots[TREE_PAIRABLE] != NODE_NULL)
+			stack[sp++] = roots[TREE_PAIRABLE];
+		if (e.pairable && roots[TREE_GENERAL] != NODE_NULL)
+			stack[sp++] = roots[TREE_GENERAL];
+
+		while (sp) {
+
+			const Node &n = nodes[stack[--sp]];
+
+			if (!((n.type_mask & e.pairable_mask) || (n.pair_mask & e.pairable_type)) || !n.aabb.intersects_inclusive(fat))
+				continue;
+
+			if (n.is_leaf()) {
+
+				if (n.element == p_id)
+					continue;
+
+				Element &other = _get_element(n.element);
+				if (_can_pair(e, other)) {
+					other.last_pass = pass;
+					pair_candidates.push_back(n.element);
+				}
+			} else {
+
+				ERR_CONTINUE(sp + 2 > MAX_STACK);
+				stack[sp++] = n.children[0];
+				stack[sp++] = n.children[1];
+			}
+		}
+	}
+
+	typename List<PairData *>::Element *E = e.pair_list.front();
+	while (E) {
+
+		typename List<PairData *>::Element *N = E->next();
+		PairData *pd = E->get();
+		Element &other = _get_element(pd->A == p_id ? pd->B : pd->A);
+
+		if (other.last_pass == pass) {
+			other.last_pass = pass + 1; // leaves still overlap, keep it
+			_pair_check(pd);
+		} else {
+			_pair_remove(pd);
+		}
+		E = N;
+	}
+
+	for (int i = 0; i < pair_candidates.size(); i++) {
+
+		BVHElementID other = pair_candidates[i];
+		if (_get_element(other).last_pass == pass) {
+			_pair_add(p_id, other);
+		}
+	}
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_remove_pairs(BVHElementID p_id) {
+
+	Element &e = _get_element(p_id);
+	while (e.pair_list.front()) {
+		_pair_remove(e.pair_list.front()->get());
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+template <class T, bool use_pairs>
+BVHElementID DynamicBVH<T, use_pairs>::create(T *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+	BVHElementID id;
+
+	if (free_elements.size()) {
+
+		id = free_elements[free_elements.size() - 1];
+		free_elements.resize(free_elements.size() - 1);
+	} else {
+
+		if (element_max == element_page_count * ELEMENT_PAGE_SIZE) {
+			element_pages = (Element **)memrealloc(element_pages, sizeof(Element *) * (element_page_count + 1));
+			element_pages[element_page_count] = memnew_arr(Element, ELEMENT_PAGE_SIZE);
+			element_page_count++;
+		}
+		id = ++element_max;
+	}
+
+	Element &e = _get_element(id);
+	e.used = true;
+	e.userdata = p_userdata;
+	e.subindex = p_subindex;
+	e.aabb = p_aabb;
+	e.pairable = p_pairable;
+	e.pairable_type = p_pairable_type;
+	e.pairable_mask = p_pairable_mask;
+	e.last_pass = 0;
+	e.leaf = NODE_NULL;
+
+	if (!p_aabb.has_no_surface()) {
+		_create_leaf(id);
+		if (use_pairs)
+			_update_pairs(id);
+	}
+
+	return id;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::move(BVHElementID p_id, const AABB &p_aabb) {
+
+	ERR_FAIL_COND(!_is_valid_element(p_id));
+	Element &e = _get_element(p_id);
+
+	e.aabb = p_aabb;
+
+	if (p_aabb.has_no_surface()) {
+
+		if (e.leaf != NODE_NULL) {
+			if (use_pairs)
+				_remove_pairs(p_id);
+			_destroy_leaf(p_id);
+		}
+		return;
+	}
+
+	if (e.leaf == NODE_NULL) {
+
+		_create_leaf(p_id);
+		if (use_pairs)
+			_update_pairs(p_id);
+		return;
+	}
+
+	const AABB &fat = nodes[e.leaf].aabb;
+	// reinsert if it left its leaf, or if it shrunk so much the leaf is just wasting space
+	if (!fat.encloses(p_aabb) || _surface_area(fat) > 4.0 * _surface_area(_fatten(p_aabb))) {
+
+		int32_t leaf = e.leaf;
+		_remove_leaf(_get_tree(e), leaf);
+		nodes[leaf].aabb = _fatten(p_aabb);
+		_insert_leaf(_get_tree(e), leaf);
+		if (use_pairs)
+			_update_pairs(p_id);
+	} else if (use_pairs) {
+
+		_check_pairs(p_id);
+	}
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::set_pairable(BVHElementID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+	ERR_FAIL_COND(!_is_valid_element(p_id));
+	Element &e = _get_element(p_id);
+
+	if (p_pairable == e.pairable && e.pairable_type == p_pairable_type && e.pairable_mask == p_pairable_mask)
+		return; // no changes, return
+
+	if (e.leaf != NODE_NULL) {
+		_destroy_leaf(p_id);
+	}
+
+	e.pairable = p_pairable;
+	e.pairable_type = p_pairable_type;
+	e.pairable_mask = p_pairable_mask;
+
+	if (!e.aabb.has_no_surface()) {
+		_create_leaf(p_id);
+	}
+
+	if (use_pairs)
+		_update_pairs(p_id);
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::erase(BVHElementID p_id) {
+
+	ERR_FAIL_COND(!_is_valid_element(p_id));
+	Element &e = _get_element(p_id);
+
+	if (use_pairs)
+		_remove_pairs(p_id);
+
+	if (e.leaf != NODE_NULL) {
+		_destroy_leaf(p_id);
+	}
+
+	e.used = false;
+	e.userdata = NULL;
+	free_elements.push_back(p_id);
+}
+
+template <class T, bool use_pairs>
+bool DynamicBVH<T, use_pairs>::is_pairable(BVHElementID p_id) const {
+
+	ERR_FAIL_COND_V(!_is_valid_element(p_id), false);
+	return _get_element(p_id).pairable;
+}
+
+template <class T, bool use_pairs>
+T *DynamicBVH<T, use_pairs>::get(BVHElementID p_id) const {
+
+	ERR_FAIL_COND_V(!_is_valid_element(p_id), NULL);
+	return _get_element(p_id).userdata;
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::get_subindex(BVHElementID p_id) const {
+
+	ERR_FAIL_COND_V(!_is_valid_element(p_id), -1);
+	return _get_element(p_id).subindex;
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask) {
+
+	if (p_result_max <= 0)
+		return 0;
+
+	const Plane *planes = p_convex.ptr();
+	int plane_count = p_convex.size();
+
+	// nodes fully inside the convex don't need their children tested, the flag is carried down the stack
+	int32_t stack[MAX_STACK];
+	bool stack_inside[MAX_STACK];
+	int sp = 0;
+
+	for (int i = 0; i < TREE_MAX; i++) {
+		if (roots[i] != NODE_NULL) {
+			stack[sp] = roots[i];
+			stack_inside[sp] = false;
+			sp++;
+		}
+	}
+
+	int result_count = 0;
+
+	while (sp) {
+
+		sp--;
+		const Node &n = nodes[stack[sp]];
+		bool inside = stack_inside[sp];
+
+		if (use_pairs && !(n.type_mask & p_mask))
+			continue;
+
+		if (!inside) {
+			if (!n.aabb.intersects_convex_shape(planes, plane_count))
+				continue;
+			inside = n.aabb.inside_convex_shape(planes, plane_count);
+		}
+
+		if (n.is_leaf()) {
+
+			const Element &e = _get_element(n.element);
+
+			if (!inside && !e.aabb.intersects_convex_shape(planes, plane_count))
+				continue;
+
+			p_result_array[result_count++] = e.userdata;
+			if (result_count == p_result_max)
+				break;
+		} else {
+
+			ERR_CONTINUE(sp + 2 > MAX_STACK);
+			for (int i = 0; i < 2; i++) {
+				stack[sp] = n.children[i];
+				stack_inside[sp] = inside;
+				sp++;
+			}
+		}
+	}
+
+	return result_count;
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	if (p_result_max <= 0)
+		return 0;
+
+	int32_t stack[MAX_STACK];
+	int sp = 0;
+
+	for (int i = 0; i < TREE_MAX; i++) {
+		if (roots[i] != NODE_NULL)
+			stack[sp++] = roots[i];
+	}
+
+	int result_count = 0;
+
+	while (sp) {
+
+		const Node &n = nodes[stack[--sp]];
+
+		if ((use_pairs && !(n.type_mask & p_mask)) || !n.aabb.intersects_inclusive(p_aabb))
+			continue;
+
+		if (n.is_leaf()) {
+
+			const Element &e = _get_element(n.element);
+
+			if (!p_aabb.intersects_inclusive(e.aabb))
+				continue;
+
+			p_result_array[result_count] = e.userdata;
+			if (p_subindex_array)
+				p_subindex_array[result_count] = e.subindex;
+			result_count++;
+			if (result_count == p_result_max)
+				break;
+		} else {
+
+			ERR_CONTINUE(sp + 2 > MAX_STACK);
+			stack[sp++] = n.children[0];
+			stack[sp++] = n.children[1];
+		}
+	}
+
+	return result_count;
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	if (p_result_max <= 0)
+		return 0;
+
+	int32_t stack[MAX_STACK];
+	int sp = 0;
+
+	for (int i = 0; i < TREE_MAX; i++) {
+		if (roots[i] != NODE_NULL)
+			stack[sp++] = roots[i];
+	}
+
+	int result_count = 0;
+
+	while (sp) {
+
+		const Node &n = nodes[stack[--sp]];
+
+		if ((use_pairs && !(n.type_mask & p_mask)) || !n.aabb.intersects_segment(p_from, p_to))
+			continue;
+
+		if (n.is_leaf()) {
+
+			const Element &e = _get_element(n.element);
+
+			if (!e.aabb.intersects_segment(p_from, p_to))
+				continue;
+
+			p_result_array[result_count] = e.userdata;
+			if (p_subindex_array)
+				p_subindex_array[result_count] = e.subindex;
+			result_count++;
+			if (result_count == p_result_max)
+				break;
+		} else {
+
+			ERR_CONTINUE(sp + 2 > MAX_STACK);
+			stack[sp++] = n.children[0];
+			stack[sp++] = n.children[1];
+		}
+	}
+
+	return result_count;
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	if (p_result_max <= 0)
+		return 0;
+
+	int32_t stack[MAX_STACK];
+	int sp = 0;
+
+	for (int i = 0; i < TREE_MAX; i++) {
+		if (roots[i] != NODE_NULL)
+			stack[sp++] = roots[i];
+	}
+
+	int result_count = 0;
+
+	while (sp) {
+
+		const Node &n = nodes[stack[--sp]];
+
+		if ((use_pairs && !(n.type_mask & p_mask)) || !n.aabb.has_point(p_point))
+			continue;
+
+		if (n.is_leaf()) {
+
+			const Element &e = _get_element(n.element);
+
+			if (!e.aabb.has_point(p_point))
+				continue;
+
+			p_result_array[result_count] = e.userdata;
+			if (p_subindex_array)
+				p_subindex_array[result_count] = e.subindex;
+			result_count++;
+			if (result_count == p_result_max)
+				break;
+		} else {
+
+			ERR_CONTINUE(sp + 2 > MAX_STACK);
+			stack[sp++] = n.children[0];
+			stack[sp++] = n.children[1];
+		}
+	}
+
+	return result_count;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::set_pair_callback(PairCallback p_callback, void *p_userdata) {
+
+	pair_callback = p_callback;
+	pair_callback_userdata = p_userdata;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+
+	unpair_callback = p_callback;
+	unpair_callback_userdata = p_userdata;
+}
+
+template <class T, bool use_pairs>
+DynamicBVH<T, use_pairs>::DynamicBVH() {
+
+	nodes = NULL;
+	node_capacity = 0;
+	node_count = 0;
+	free_node = NODE_NULL;
+	for (int i = 0; i < TREE_MAX; i++) {
+		roots[i] = NODE_NULL;
+	}
+
+	element_pages = NULL;
+	element_page_count = 0;
+	element_max = 0;
+
+	pair_callback = NULL;
+	unpair_callback = NULL;
+	pair_callback_userdata = NULL;
+	unpair_callback_userdata = NULL;
+
+	pass = 1;
+	margin_ratio = 0.1;
+	pair_count = 0;
+}
+
+template <class T, bool use_pairs>
+DynamicBVH<T, use_pairs>::~DynamicBVH() {
+
+	// pairs are shared by both elements, free them once from the A side
+	for (uint32_t id = 1; id <= element_max; id++) {
+
+		Element &e = _get_element(id);
+		for (typename List<PairData *>::Element *E = e.pair_list.front(); E; E = E->next()) {
+			if (E->get()->A == id)
+				memdelete(E->get());
+		}
+	}
+
+	for (uint32_t i = 0; i < element_page_count; i++) {
+		memdelete_arr(element_pages[i]);
+	}
+
+	if (element_pages)
+		memfree(element_pages);
+	if (nodes)
+		memfree(nodes);
+}
+
+#endif // DYNAMIC_BVH_H
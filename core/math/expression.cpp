@@ -1933,231 +1933,538 @@ bool Expression::_compile_expression() {
 	return false;
 }
 
-bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str) {
+static bool _is_foldable_type(Variant::Type p_type) {
+
+	//shared containers and objects would leak one result into every execution
+	return p_type != Variant::ARRAY && p_type != Variant::DICTIONARY && p_type != Variant::OBJECT;
+}
+
+static bool _is_pure_func(Expression::BuiltinFunc p_func) {
+
+	switch (p_func) {
+		case Expression::MATH_RANDOMIZE:
+		case Expression::MATH_RAND:
+		case Expression::MATH_RANDF:
+		case Expression::MATH_RANDOM:
+		case Expression::MATH_SEED:
+		case Expression::MATH_RANDSEED:
+		case Expression::OBJ_WEAKREF:
+		case Expression::FUNC_FUNCREF:
+		case Expression::TYPE_EXISTS:
+		case Expression::TEXT_PRINT:
+		case Expression::TEXT_PRINTERR:
+		case Expression::TEXT_PRINTRAW:
+		case Expression::VAR_TO_BYTES:
+		case Expression::BYTES_TO_VAR:
+			return false;
+		default:
+			return true;
+	}
+}
+
+int Expression::_add_constant(const Variant &p_value) {
+
+	for (int i = 0; i < constants.size(); i++) {
+		if (constants[i].get_type() == p_value.get_type() && constants[i] == p_value) {
+			return (ADDR_CONSTANT << ADDR_MODE_SHIFT) | i;
+		}
+	}
+
+	constants.push_back(p_value);
+	return (ADDR_CONSTANT << ADDR_MODE_SHIFT) | (constants.size() - 1);
+}
+
+int Expression::_add_name(const StringName &p_name) {
+
+	int idx = names.find(p_name);
+	if (idx == -1) {
+		idx = names.size();
+		names.push_back(p_name);
+	}
+	return idx;
+}
+
+int Expression::_alloc_register() {
+
+	int reg = register_top++;
+	register_count = MAX(register_count, register_top);
+	return reg;
+}
+
+bool Expression::_fold_constant(int p_register, const Variant &p_value, int &r_addr) {
+
+	if (!_is_foldable_type(p_value.get_type())) {
+		return false;
+	}
+
+	//the destination register was the last one allocated, operands were constants and took none
+	register_top = p_register;
+	r_addr = _add_constant(p_value);
+	return true;
+}
+
+bool Expression::_compile_node_list(const Vector<ENode *> &p_nodes, Vector<int> &r_addrs) {
+
+	bool all_constant = true;
+	r_addrs.resize(p_nodes.size());
+	for (int i = 0; i < p_nodes.size(); i++) {
+		int addr = _compile_node(p_nodes[i]);
+		if ((addr >> ADDR_MODE_SHIFT) != ADDR_CONSTANT) {
+			all_constant = false;
+		}
+		r_addrs.write[i] = addr;
+	}
+	max_arguments = MAX(max_arguments, p_nodes.size());
+	return all_constant;
+}
+
+int Expression::_compile_node(ENode *p_node) {
 
 	switch (p_node->type) {
-		case Expression::ENode::TYPE_INPUT: {
+		case ENode::TYPE_INPUT: {
 
-			const Expression::InputNode *in = static_cast<const Expression::InputNode *>(p_node);
-			if (in->index < 0 || in->index >= p_inputs.size()) {
-				r_error_str = vformat(RTR("Invalid input %i (not passed) in expression"), in->index);
-				return true;
-			}
-			r_ret = p_inputs[in->index];
+			const InputNode *in = static_cast<const InputNode *>(p_node);
+			return (ADDR_INPUT << ADDR_MODE_SHIFT) | (in->index & ADDR_INDEX_MASK);
 		} break;
-		case Expression::ENode::TYPE_CONSTANT: {
+		case ENode::TYPE_CONSTANT: {
 
-			const Expression::ConstantNode *c = static_cast<const Expression::ConstantNode *>(p_node);
-			r_ret = c->value;
+			const ConstantNode *c = static_cast<const ConstantNode *>(p_node);
+			return _add_constant(c->value);
+		} break;
+		case ENode::TYPE_SELF: {
 
+			uses_self = true;
+			return ADDR_SELF << ADDR_MODE_SHIFT;
 		} break;
-		case Expression::ENode::TYPE_SELF: {
+		case ENode::TYPE_OPERATOR: {
 
-			if (!p_instance) {
-				r_error_str = RTR("self can't be used because instance is null (not passed)");
-				return true;
+			const OperatorNode *op = static_cast<const OperatorNode *>(p_node);
+
+			//the destination goes below the operand temporaries, so it never aliases them
+			int dst = _alloc_register();
+			int a = _compile_node(op->nodes[0]);
+			int b = op->nodes[1] ? _compile_node(op->nodes[1]) : _add_constant(Variant());
+
+			if ((a >> ADDR_MODE_SHIFT) == ADDR_CONSTANT && (b >> ADDR_MODE_SHIFT) == ADDR_CONSTANT) {
+				Variant ret;
+				bool valid = true;
+				Variant::evaluate(op->op, constants[a & ADDR_INDEX_MASK], constants[b & ADDR_INDEX_MASK], ret, valid);
+				int addr;
+				if (valid && _fold_constant(dst, ret, addr)) {
+					return addr;
+				}
 			}
-			r_ret = p_instance;
-		} break;
-		case Expression::ENode::TYPE_OPERATOR: {
 
-			const Expression::OperatorNode *op = static_cast<const Expression::OperatorNode *>(p_node);
+			code.push_back(OPCODE_OPERATOR);
+			code.push_back(op->op);
+			code.push_back(a);
+			code.push_back(b);
+			code.push_back(dst);
+			register_top = dst + 1;
+			return (ADDR_REGISTER << ADDR_MODE_SHIFT) | dst;
+		} break;
+		case ENode::TYPE_INDEX: {
 
-			Variant a;
-			bool ret = _execute(p_inputs, p_instance, op->nodes[0], a, r_error_str);
-			if (ret)
-				return true;
+			const IndexNode *index = static_cast<const IndexNode *>(p_node);
 
-			Variant b;
+			int dst = _alloc_register();
+			int base = _compile_node(index->base);
+			int idx = _compile_node(index->index);
 
-			if (op->nodes[1]) {
-				ret = _execute(p_inputs, p_instance, op->nodes[1], b, r_error_str);
-				if (ret)
-					return true;
+			if ((base >> ADDR_MODE_SHIFT) == ADDR_CONSTANT && (idx >> ADDR_MODE_SHIFT) == ADDR_CONSTANT) {
+				bool valid;
+				Variant ret = constants[base & ADDR_INDEX_MASK].get(constants[idx & ADDR_INDEX_MASK], &valid);
+				int addr;
+				if (valid && _fold_constant(dst, ret, addr)) {
+					return addr;
+				}
 			}
 
-			bool valid = true;
-			Variant::evaluate(op->op, a, b, r_ret, valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(op->op), Variant::get_type_name(a.get_type()), Variant::get_type_name(b.get_type()));
-				return true;
+			code.push_back(OPCODE_INDEX);
+			code.push_back(base);
+			code.push_back(idx);
+			code.push_back(dst);
+			register_top = dst + 1;
+			return (ADDR_REGISTER << ADDR_MODE_SHIFT) | dst;
+		} break;
+		case ENode::TYPE_NAMED_INDEX: {
+
+			const NamedIndexNode *index = static_cast<const NamedIndexNode *>(p_node);
+
+			int dst = _alloc_register();
+			int base = _compile_node(index->base);
+
+			if ((base >> ADDR_MODE_SHIFT) == ADDR_CONSTANT) {
+				bool valid;
+				Variant ret = constants[base & ADDR_INDEX_MASK].get_named(index->name, &valid);
+				int addr;
+				if (valid && _fold_constant(dst, ret, addr)) {
+					return addr;
+				}
 			}
 
+			code.push_back(OPCODE_NAMED_INDEX);
+			code.push_back(base);
+			code.push_back(_add_name(index->name));
+			code.push_back(dst);
+			register_top = dst + 1;
+			return (ADDR_REGISTER << ADDR_MODE_SHIFT) | dst;
 		} break;
-		case Expression::ENode::TYPE_INDEX: {
+		case ENode::TYPE_ARRAY: {
 
-			const Expression::IndexNode *index = static_cast<const Expression::IndexNode *>(p_node);
+			const ArrayNode *array = static_cast<const ArrayNode *>(p_node);
 
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, index->base, base, r_error_str);
-			if (ret)
-				return true;
+			int dst = _alloc_register();
+			Vector<int> values;
+			_compile_node_list(array->array, values);
 
-			Variant idx;
+			code.push_back(OPCODE_ARRAY);
+			code.push_back(dst);
+			code.push_back(values.size());
+			code.append_array(values);
+			register_top = dst + 1;
+			return (ADDR_REGISTER << ADDR_MODE_SHIFT) | dst;
+		} break;
+		case ENode::TYPE_DICTIONARY: {
 
-			ret = _execute(p_inputs, p_instance, index->index, idx, r_error_str);
-			if (ret)
-				return true;
+			const DictionaryNode *dictionary = static_cast<const DictionaryNode *>(p_node);
 
-			bool valid;
-			r_ret = base.get(idx, &valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid index of type %s for base type %s"), Variant::get_type_name(idx.get_type()), Variant::get_type_name(base.get_type()));
-				return true;
-			}
+			int dst = _alloc_register();
+			Vector<int> values;
+			_compile_node_list(dictionary->dict, values);
 
+			code.push_back(OPCODE_DICTIONARY);
+			code.push_back(dst);
+			code.push_back(values.size());
+			code.append_array(values);
+			register_top = dst + 1;
+			return (ADDR_REGISTER << ADDR_MODE_SHIFT) | dst;
 		} break;
-		case Expression::ENode::TYPE_NAMED_INDEX: {
+		case ENode::TYPE_CONSTRUCTOR: {
 
-			const Expression::NamedIndexNode *index = static_cast<const Expression::NamedIndexNode *>(p_node);
+			const ConstructorNode *constructor = static_cast<const ConstructorNode *>(p_node);
 
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, index->base, base, r_error_str);
-			if (ret)
-				return true;
+			int dst = _alloc_register();
+			Vector<int> args;
+			bool all_constant = _compile_node_list(constructor->arguments, args);
 
-			bool valid;
-			r_ret = base.get_named(index->name, &valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(index->name), Variant::get_type_name(base.get_type()));
-				return true;
+			if (all_constant) {
+				const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * MAX(args.size(), 1));
+				for (int i = 0; i < args.size(); i++) {
+					argp[i] = &constants[args[i] & ADDR_INDEX_MASK];
+				}
+				Variant::CallError ce;
+				Variant ret = Variant::construct(constructor->data_type, argp, args.size(), ce);
+				int addr;
+				if (ce.error == Variant::CallError::CALL_OK && _fold_constant(dst, ret, addr)) {
+					return addr;
+				}
 			}
 
+			code.push_back(OPCODE_CONSTRUCT);
+			code.push_back(dst);
+			code.push_back(constructor->data_type);
+			code.push_back(args.size());
+			code.append_array(args);
+			register_top = dst + 1;
+			return (ADDR_REGISTER << ADDR_MODE_SHIFT) | dst;
 		} break;
-		case Expression::ENode::TYPE_ARRAY: {
-			const Expression::ArrayNode *array = static_cast<const Expression::ArrayNode *>(p_node);
+		case ENode::TYPE_BUILTIN_FUNC: {
 
-			Array arr;
-			arr.resize(array->array.size());
-			for (int i = 0; i < array->array.size(); i++) {
+			const BuiltinFuncNode *bifunc = static_cast<const BuiltinFuncNode *>(p_node);
 
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, array->array[i], value, r_error_str);
+			int dst = _alloc_register();
+			Vector<int> args;
+			bool all_constant = _compile_node_list(bifunc->arguments, args);
 
-				if (ret)
-					return true;
-				arr[i] = value;
+			if (all_constant && _is_pure_func(bifunc->func)) {
+				const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * MAX(args.size(), 1));
+				for (int i = 0; i < args.size(); i++) {
+					argp[i] = &constants[args[i] & ADDR_INDEX_MASK];
+				}
+				Variant::CallError ce;
+				Variant ret;
+				String error_text;
+				exec_func(bifunc->func, argp, &ret, ce, error_text);
+				int addr;
+				if (ce.error == Variant::CallError::CALL_OK && _fold_constant(dst, ret, addr)) {
+					return addr;
+				}
 			}
 
-			r_ret = arr;
-
+			code.push_back(OPCODE_BUILTIN_FUNC);
+			code.push_back(dst);
+			code.push_back(bifunc->func);
+			code.push_back(args.size());
+			code.append_array(args);
+			register_top = dst + 1;
+			return (ADDR_REGISTER << ADDR_MODE_SHIFT) | dst;
+		} break;
+		case ENode::TYPE_CALL: {
+
+			const CallNode *call = static_cast<const CallNode *>(p_node);
+
+			//calls are never folded, methods may have side effects
+			int dst = _alloc_register();
+			int base = _compile_node(call->base);
+			Vector<int> args;
+			_compile_node_list(call->arguments, args);
+
+			code.push_back(OPCODE_CALL);
+			code.push_back(dst);
+			code.push_back(base);
+			code.push_back(_add_name(call->method));
+			code.push_back(args.size());
+			code.append_array(args);
+			register_top = dst + 1;
+			return (ADDR_REGISTER << ADDR_MODE_SHIFT) | dst;
 		} break;
-		case Expression::ENode::TYPE_DICTIONARY: {
-			const Expression::DictionaryNode *dictionary = static_cast<const Expression::DictionaryNode *>(p_node);
+	}
 
-			Dictionary d;
-			for (int i = 0; i < dictionary->dict.size(); i += 2) {
+	return _add_constant(Variant());
+}
 
-				Variant key;
-				bool ret = _execute(p_inputs, p_instance, dictionary->dict[i + 0], key, r_error_str);
+void Expression::_compile() {
 
-				if (ret)
-					return true;
+	code.clear();
+	constants.clear();
+	names.clear();
+	register_count = 0;
+	register_top = 0;
+	max_arguments = 0;
+	uses_self = false;
 
-				Variant value;
-				ret = _execute(p_inputs, p_instance, dictionary->dict[i + 1], value, r_error_str);
-				if (ret)
-					return true;
+	int result = _compile_node(root);
+	code.push_back(OPCODE_END);
+	code.push_back(result);
+}
 
-				d[key] = value;
-			}
+const Variant *Expression::_get_operand(int p_addr, const Array &p_inputs, const Variant &p_self, const Variant *p_registers, String &r_error_str) const {
 
-			r_ret = d;
+	int index = p_addr & ADDR_INDEX_MASK;
+	switch (p_addr >> ADDR_MODE_SHIFT) {
+		case ADDR_CONSTANT: {
+			return &constants[index];
 		} break;
-		case Expression::ENode::TYPE_CONSTRUCTOR: {
+		case ADDR_INPUT: {
+			if (index >= p_inputs.size()) {
+				r_error_str = vformat(RTR("Invalid input %i (not passed) in expression"), index);
+				return NULL;
+			}
+			return &p_inputs[index];
+		} break;
+		case ADDR_REGISTER: {
+			return &p_registers[index];
+		} break;
+		case ADDR_SELF: {
+			if (p_self.get_type() == Variant::NIL) {
+				r_error_str = RTR("self can't be used because instance is null (not passed)");
+				return NULL;
+			}
+			return &p_self;
+		} break;
+	}
 
-			const Expression::ConstructorNode *constructor = static_cast<const Expression::ConstructorNode *>(p_node);
+	return NULL;
+}
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(constructor->arguments.size());
-			argp.resize(constructor->arguments.size());
+bool Expression::_get_operands(const int *p_addrs, int p_count, const Array &p_inputs, const Variant &p_self, const Variant *p_registers, const Variant **r_args, String &r_error_str) const {
 
-			for (int i = 0; i < constructor->arguments.size(); i++) {
+	for (int i = 0; i < p_count; i++) {
+		r_args[i] = _get_operand(p_addrs[i], p_inputs, p_self, p_registers, r_error_str);
+		if (!r_args[i]) {
+			return false;
+		}
+	}
+	return true;
+}
 
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, constructor->arguments[i], value, r_error_str);
+bool Expression::_execute(const Array &p_inputs, Object *p_instance, Variant &r_ret, String &r_error_str) const {
 
-				if (ret)
-					return true;
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
-			}
+	Variant self;
+	if (uses_self && p_instance) {
+		self = p_instance;
+	}
 
-			Variant::CallError ce;
-			r_ret = Variant::construct(constructor->data_type, (const Variant **)argp.ptr(), argp.size(), ce);
+	//registers and argument lists live on the stack, so executing never allocates and is reentrant
+	Variant *registers = (Variant *)alloca(sizeof(Variant) * MAX(register_count, 1));
+	for (int i = 0; i < register_count; i++) {
+		memnew_placement(&registers[i], Variant);
+	}
+	const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * MAX(max_arguments, 1));
+
+	const int *c = code.ptr();
+	int ip = 0;
+	bool err = false;
+	bool done = false;
+
+#define GET_OPERAND(m_var, m_addr)                                                               \
+	const Variant *m_var = _get_operand(m_addr, p_inputs, self, registers, r_error_str); \
+	if (unlikely(!m_var)) {                                                                      \
+		err = true;                                                                              \
+		break;                                                                                   \
+	}
 
-			if (ce.error != Variant::CallError::CALL_OK) {
-				r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(constructor->data_type));
-				return true;
-			}
+	while (!err && !done) {
 
-		} break;
-		case Expression::ENode::TYPE_BUILTIN_FUNC: {
+		switch (c[ip]) {
+			case OPCODE_OPERATOR: {
 
-			const Expression::BuiltinFuncNode *bifunc = static_cast<const Expression::BuiltinFuncNode *>(p_node);
+				Variant::Operator op = Variant::Operator(c[ip + 1]);
+				GET_OPERAND(a, c[ip + 2]);
+				GET_OPERAND(b, c[ip + 3]);
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(bifunc->arguments.size());
-			argp.resize(bifunc->arguments.size());
+				bool valid = true;
+				Variant::evaluate(op, *a, *b, registers[c[ip + 4]], valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(op), Variant::get_type_name(a->get_type()), Variant::get_type_name(b->get_type()));
+					err = true;
+					break;
+				}
+				ip += 5;
+			} break;
+			case OPCODE_INDEX: {
 
-			for (int i = 0; i < bifunc->arguments.size(); i++) {
+				GET_OPERAND(base, c[ip + 1]);
+				GET_OPERAND(idx, c[ip + 2]);
 
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, bifunc->arguments[i], value, r_error_str);
-				if (ret)
-					return true;
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
-			}
+				bool valid;
+				registers[c[ip + 3]] = base->get(*idx, &valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid index of type %s for base type %s"), Variant::get_type_name(idx->get_type()), Variant::get_type_name(base->get_type()));
+					err = true;
+					break;
+				}
+				ip += 4;
+			} break;
+			case OPCODE_NAMED_INDEX: {
 
-			Variant::CallError ce;
-			exec_func(bifunc->func, (const Variant **)argp.ptr(), &r_ret, ce, r_error_str);
+				GET_OPERAND(base, c[ip + 1]);
+				const StringName &name = names[c[ip + 2]];
 
-			if (ce.error != Variant::CallError::CALL_OK) {
-				r_error_str = "Builtin Call Failed. " + r_error_str;
-				return true;
-			}
+				bool valid;
+				registers[c[ip + 3]] = base->get_named(name, &valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(name), Variant::get_type_name(base->get_type()));
+					err = true;
+					break;
+				}
+				ip += 4;
+			} break;
+			case OPCODE_ARRAY: {
 
-		} break;
-		case Expression::ENode::TYPE_CALL: {
+				int count = c[ip + 2];
+				if (!_get_operands(&c[ip + 3], count, p_inputs, self, registers, argp, r_error_str)) {
+					err = true;
+					break;
+				}
+
+				Array arr;
+				arr.resize(count);
+				for (int i = 0; i < count; i++) {
+					arr[i] = *argp[i];
+				}
+				registers[c[ip + 1]] = arr;
+				ip += 3 + count;
+			} break;
+			case OPCODE_DICTIONARY: {
+
+				int count = c[ip + 2];
+				if (!_get_operands(&c[ip + 3], count, p_inputs, self, registers, argp, r_error_str)) {
+					err = true;
+					break;
+				}
 
-			const Expression::CallNode *call = static_cast<const Expression::CallNode *>(p_node);
+				Dictionary d;
+				for (int i = 0; i < count; i += 2) {
+					d[*argp[i + 0]] = *argp[i + 1];
+				}
+				registers[c[ip + 1]] = d;
+				ip += 3 + count;
+			} break;
+			case OPCODE_CONSTRUCT: {
 
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, call->base, base, r_error_str);
+				Variant::Type type = Variant::Type(c[ip + 2]);
+				int argc = c[ip + 3];
+				if (!_get_operands(&c[ip + 4], argc, p_inputs, self, registers, argp, r_error_str)) {
+					err = true;
+					break;
+				}
 
-			if (ret)
-				return true;
+				Variant::CallError ce;
+				registers[c[ip + 1]] = Variant::construct(type, argp, argc, ce);
+				if (ce.error != Variant::CallError::CALL_OK) {
+					r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(type));
+					err = true;
+					break;
+				}
+				ip += 4 + argc;
+			} break;
+			case OPCODE_BUILTIN_FUNC: {
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(call->arguments.size());
-			argp.resize(call->arguments.size());
+				int argc = c[ip + 3];
+				if (!_get_operands(&c[ip + 4], argc, p_inputs, self, registers, argp, r_error_str)) {
+					err = true;
+					break;
+				}
 
-			for (int i = 0; i < call->arguments.size(); i++) {
+				Variant::CallError ce;
+				exec_func(BuiltinFunc(c[ip + 2]), argp, &registers[c[ip + 1]], ce, r_error_str);
+				if (ce.error != Variant::CallError::CALL_OK) {
+					r_error_str = "Builtin Call Failed. " + r_error_str;
+					err = true;
+					break;
+				}
+				ip += 4 + argc;
+			} break;
+			case OPCODE_CALL: {
 
-				Variant value;
-				ret = _execute(p_inputs, p_instance, call->arguments[i], value, r_error_str);
+				int dst = c[ip + 1];
+				int base_addr = c[ip + 2];
+				const StringName &method = names[c[ip + 3]];
+				int argc = c[ip + 4];
 
-				if (ret)
-					return true;
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
-			}
+				//methods may modify the base, so call on a temporary: the operand's own register, or a copy in the destination
+				Variant *base;
+				if ((base_addr >> ADDR_MODE_SHIFT) == ADDR_REGISTER) {
+					base = &registers[base_addr & ADDR_INDEX_MASK];
+				} else {
+					GET_OPERAND(src, base_addr);
+					registers[dst] = *src;
+					base = &registers[dst];
+				}
 
-			Variant::CallError ce;
-			r_ret = base.call(call->method, (const Variant **)argp.ptr(), argp.size(), ce);
+				if (!_get_operands(&c[ip + 5], argc, p_inputs, self, registers, argp, r_error_str)) {
+					err = true;
+					break;
+				}
 
-			if (ce.error != Variant::CallError::CALL_OK) {
-				r_error_str = vformat(RTR("On call to '%s':"), String(call->method));
-				return true;
-			}
+				Variant::CallError ce;
+				Variant ret = base->call(method, argp, argc, ce);
+				if (ce.error != Variant::CallError::CALL_OK) {
+					r_error_str = vformat(RTR("On call to '%s':"), String(method));
+					err = true;
+					break;
+				}
+				registers[dst] = ret;
+				ip += 5 + argc;
+			} break;
+			case OPCODE_END: {
 
-		} break;
+				GET_OPERAND(result, c[ip + 1]);
+				r_ret = *result;
+				done = true;
+			} break;
+		}
 	}
-	return false;
+
+#undef GET_OPERAND
+
+	for (int i = 0; i < register_count; i++) {
+		registers[i].~Variant();
+	}
+
+	return err;
 }
 
 Error Expression::parse(const String &p_expression, const Vector<String> &p_input_names) {
@@ -2185,6 +2492,12 @@ Error Expression::parse(const String &p_expression, const Vector<String> &p_inpu
 		return ERR_INVALID_PARAMETER;
 	}
 
+	//the tree is only needed to build the bytecode
+	_compile();
+	memdelete(nodes);
+	nodes = NULL;
+	root = NULL;
+
 	return OK;
 }
 
@@ -2195,7 +2508,7 @@ Variant Expression::execute(Array p_inputs, Object *p_base, bool p_show_error) {
 	execution_error = false;
 	Variant output;
 	String error_txt;
-	bool err = _execute(p_inputs, p_base, root, output, error_txt);
+	bool err = _execute(p_inputs, p_base, output, error_txt);
 	if (err) {
 		execution_error = true;
 		error_str = error_txt;
@@ -2227,7 +2540,11 @@ Expression::Expression() :
 		error_set(true),
 		root(NULL),
 		nodes(NULL),
-		execution_error(false) {
+		execution_error(false),
+		register_count(0),
+		register_top(0),
+		max_arguments(0),
+		uses_self(false) {
 }
 
 Expression::~Expression() {
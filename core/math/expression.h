@@ -346,7 +346,48 @@ private:
 	Vector<String> input_names;
 
 	bool execution_error;
-	bool _execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str);
+
+	//the parsed tree is compiled to a flat list of instructions over a register file, operands are addresses
+	enum Opcode {
+		OPCODE_OPERATOR, //op, a, b, dst
+		OPCODE_INDEX, //base, index, dst
+		OPCODE_NAMED_INDEX, //base, name, dst
+		OPCODE_ARRAY, //dst, count, values...
+		OPCODE_DICTIONARY, //dst, count, key/value pairs...
+		OPCODE_CONSTRUCT, //dst, type, argc, args...
+		OPCODE_BUILTIN_FUNC, //dst, func, argc, args...
+		OPCODE_CALL, //dst, base, method, argc, args...
+		OPCODE_END //result
+	};
+
+	enum {
+		ADDR_MODE_SHIFT = 24,
+		ADDR_INDEX_MASK = (1 << ADDR_MODE_SHIFT) - 1,
+		ADDR_CONSTANT = 0,
+		ADDR_INPUT = 1,
+		ADDR_REGISTER = 2,
+		ADDR_SELF = 3
+	};
+
+	Vector<int> code;
+	Vector<Variant> constants;
+	Vector<StringName> names;
+	int register_count;
+	int register_top;
+	int max_arguments;
+	bool uses_self;
+
+	int _add_constant(const Variant &p_value);
+	int _add_name(const StringName &p_name);
+	int _alloc_register();
+	bool _fold_constant(int p_register, const Variant &p_value, int &r_addr);
+	int _compile_node(ENode *p_node);
+	bool _compile_node_list(const Vector<ENode *> &p_nodes, Vector<int> &r_addrs);
+	void _compile();
+
+	_FORCE_INLINE_ const Variant *_get_operand(int p_addr, const Array &p_inputs, const Variant &p_self, const Variant *p_registers, String &r_error_str) const;
+	bool _get_operands(const int *p_addrs, int p_count, const Array &p_inputs, const Variant &p_self, const Variant *p_registers, const Variant **r_args, String &r_error_str) const;
+	bool _execute(const Array &p_inputs, Object *p_instance, Variant &r_ret, String &r_error_str) const;
 
 protected:
 	static void _bind_methods();
@@ -31,9 +31,55 @@
 #include "math_funcs.h"
 
 #include "core/error_macros.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
 
 RandomPCG Math::default_rand(RandomPCG::DEFAULT_SEED, RandomPCG::DEFAULT_INC);
 
+//the main thread uses default_rand, so seeded sequences stay the same; every other thread
+//gets its own stream, reseeded from the main thread's seed whenever that one changes
+static SafeNumeric<uint64_t> thread_rand_seed(RandomPCG::DEFAULT_SEED);
+static SafeNumeric<uint32_t> thread_rand_version(0);
+static SafeNumeric<uint64_t> thread_rand_streams(0);
+
+struct ThreadRand {
+	RandomPCG *rng;
+	uint64_t stream;
+	uint32_t version;
+};
+
+static thread_local ThreadRand thread_rand = { NULL, 0, 0 };
+static thread_local RandomPCG thread_rand_stream;
+
+RandomPCG &Math::_get_thread_rand() {
+
+	if (unlikely(!thread_rand.rng)) {
+		if (Thread::get_caller_id() == Thread::get_main_id()) {
+			thread_rand.rng = &default_rand;
+		} else {
+			thread_rand.rng = &thread_rand_stream;
+			thread_rand.stream = RandomPCG::DEFAULT_INC + thread_rand_streams.increment();
+			thread_rand.version = thread_rand_version.get() - 1;
+		}
+	}
+
+	if (thread_rand.rng != &default_rand) {
+		uint32_t version = thread_rand_version.get();
+		if (unlikely(thread_rand.version != version)) {
+			thread_rand.version = version;
+			thread_rand_stream.seed(thread_rand_seed.get(), thread_rand.stream);
+		}
+	}
+
+	return *thread_rand.rng;
+}
+
+void Math::_update_thread_rand_seed() {
+
+	thread_rand_seed.set(default_rand.get_seed());
+	thread_rand_version.increment();
+}
+
 #define PHI 0x9e3779b9
 
 uint32_t Math::rand_from_seed(uint64_t *seed) {
@@ -44,15 +90,23 @@ uint32_t Math::rand_from_seed(uint64_t *seed) {
 }
 
 void Math::seed(uint64_t x) {
-	default_rand.seed(x);
+	RandomPCG &rng = _get_thread_rand();
+	rng.seed(x);
+	if (&rng == &default_rand) {
+		_update_thread_rand_seed();
+	}
 }
 
 void Math::randomize() {
-	default_rand.randomize();
+	RandomPCG &rng = _get_thread_rand();
+	rng.randomize();
+	if (&rng == &default_rand) {
+		_update_thread_rand_seed();
+	}
 }
 
 uint32_t Math::rand() {
-	return default_rand.rand();
+	return _get_thread_rand().rand();
 }
 
 int Math::step_decimals(double p_step) {
@@ -175,9 +229,9 @@ uint32_t Math::larger_prime(uint32_t p_val) {
 }
 
 double Math::random(double from, double to) {
-	return default_rand.random(from, to);
+	return _get_thread_rand().random(from, to);
 }
 
 float Math::random(float from, float to) {
-	return default_rand.random(from, to);
+	return _get_thread_rand().random(from, to);
 }
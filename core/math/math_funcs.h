@@ -44,6 +44,9 @@ class Math {
 
 	static RandomPCG default_rand;
 
+	static RandomPCG &_get_thread_rand();
+	static void _update_thread_rand_seed();
+
 public:
 	Math() {} // useless to instance
 
@@ -32,10 +32,52 @@
 
 RandomNumberGenerator::RandomNumberGenerator() {}
 
+PoolRealArray RandomNumberGenerator::randf_array(int p_count) {
+	return randf_range_array(p_count, 0.0, 1.0);
+}
+
+PoolRealArray RandomNumberGenerator::randf_range_array(int p_count, real_t p_from, real_t p_to) {
+	PoolRealArray ret;
+	ERR_FAIL_COND_V(p_count < 0, ret);
+	ret.resize(p_count);
+	PoolRealArray::Write w = ret.write();
+	randbase.fill_random(w.ptr(), p_count, p_from, p_to);
+	return ret;
+}
+
+PoolRealArray RandomNumberGenerator::randfn_array(int p_count, real_t p_mean, real_t p_deviation) {
+	PoolRealArray ret;
+	ERR_FAIL_COND_V(p_count < 0, ret);
+	ret.resize(p_count);
+	PoolRealArray::Write w = ret.write();
+	randbase.fill_randfn(w.ptr(), p_count, p_mean, p_deviation);
+	return ret;
+}
+
+PoolIntArray RandomNumberGenerator::randi_range_array(int p_count, int p_from, int p_to) {
+	PoolIntArray ret;
+	ERR_FAIL_COND_V(p_count < 0, ret);
+	ret.resize(p_count);
+	PoolIntArray::Write w = ret.write();
+	uint32_t *values = (uint32_t *)w.ptr();
+	randbase.fill_rand(values, p_count);
+
+	//same mapping as randi_range()
+	int from = MIN(p_from, p_to);
+	unsigned int range = ABS(p_to - p_from) + 1;
+	for (int i = 0; i < p_count; i++) {
+		w[i] = values[i] % range + from;
+	}
+	return ret;
+}
+
 void RandomNumberGenerator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_seed", "seed"), &RandomNumberGenerator::set_seed);
 	ClassDB::bind_method(D_METHOD("get_seed"), &RandomNumberGenerator::get_seed);
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+	ClassDB::bind_method(D_METHOD("set_stream", "stream"), &RandomNumberGenerator::set_stream);
+	ClassDB::bind_method(D_METHOD("get_stream"), &RandomNumberGenerator::get_stream);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "stream"), "set_stream", "get_stream");
 
 	ClassDB::bind_method(D_METHOD("randi"), &RandomNumberGenerator::randi);
 	ClassDB::bind_method(D_METHOD("randf"), &RandomNumberGenerator::randf);
@@ -43,4 +85,10 @@ void RandomNumberGenerator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("randf_range", "from", "to"), &RandomNumberGenerator::randf_range);
 	ClassDB::bind_method(D_METHOD("randi_range", "from", "to"), &RandomNumberGenerator::randi_range);
 	ClassDB::bind_method(D_METHOD("randomize"), &RandomNumberGenerator::randomize);
+	ClassDB::bind_method(D_METHOD("advance", "delta"), &RandomNumberGenerator::advance);
+
+	ClassDB::bind_method(D_METHOD("randf_array", "count"), &RandomNumberGenerator::randf_array);
+	ClassDB::bind_method(D_METHOD("randf_range_array", "count", "from", "to"), &RandomNumberGenerator::randf_range_array);
+	ClassDB::bind_method(D_METHOD("randfn_array", "count", "mean", "deviation"), &RandomNumberGenerator::randfn_array, DEFVAL(0.0), DEFVAL(1.0));
+	ClassDB::bind_method(D_METHOD("randi_range_array", "count", "from", "to"), &RandomNumberGenerator::randi_range_array);
 }
@@ -47,6 +47,12 @@ public:
 
 	_FORCE_INLINE_ uint64_t get_seed() { return randbase.get_seed(); }
 
+	_FORCE_INLINE_ void set_stream(uint64_t p_stream) { randbase.seed(randbase.get_seed(), p_stream); }
+
+	_FORCE_INLINE_ uint64_t get_stream() { return randbase.get_stream(); }
+
+	_FORCE_INLINE_ void advance(uint64_t p_delta) { randbase.advance(p_delta); }
+
 	_FORCE_INLINE_ void randomize() { randbase.randomize(); }
 
 	_FORCE_INLINE_ uint32_t randi() { return randbase.rand(); }
@@ -65,6 +71,11 @@ public:
 			return ret % (to - from + 1) + from;
 	}
 
+	PoolRealArray randf_array(int p_count);
+	PoolRealArray randf_range_array(int p_count, real_t p_from, real_t p_to);
+	PoolRealArray randfn_array(int p_count, real_t p_mean = 0.0, real_t p_deviation = 1.0);
+	PoolIntArray randi_range_array(int p_count, int p_from, int p_to);
+
 	RandomNumberGenerator();
 };
 
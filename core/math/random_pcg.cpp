@@ -38,6 +38,25 @@ RandomPCG::RandomPCG(uint64_t p_seed, uint64_t p_inc) :
 	seed(p_seed);
 }
 
+void RandomPCG::advance(uint64_t p_delta) {
+	// Brown, "Random Number Generation with Arbitrary Stride": composes the LCG step with itself.
+	uint64_t cur_mult = 6364136223846793005ULL;
+	uint64_t cur_plus = pcg.inc | 1;
+	uint64_t acc_mult = 1;
+	uint64_t acc_plus = 0;
+	while (p_delta > 0) {
+		if (p_delta & 1) {
+			acc_mult *= cur_mult;
+			acc_plus = acc_plus * cur_mult + cur_plus;
+		}
+		cur_plus = (cur_mult + 1) * cur_plus;
+		cur_mult *= cur_mult;
+		p_delta >>= 1;
+	}
+	pcg.state = acc_mult * pcg.state + acc_plus;
+	current_seed = pcg.state;
+}
+
 void RandomPCG::randomize() {
 	seed(OS::get_singleton()->get_ticks_usec() * pcg.state + PCG_DEFAULT_INC_64);
 }
@@ -49,3 +68,45 @@ double RandomPCG::random(double p_from, double p_to) {
 float RandomPCG::random(float p_from, float p_to) {
 	return randf() * (p_to - p_from) + p_from;
 }
+
+void RandomPCG::fill_rand(uint32_t *p_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_dst[i] = rand();
+	}
+}
+
+void RandomPCG::fill_random(double *p_dst, uint32_t p_count, double p_from, double p_to) {
+	double range = p_to - p_from;
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_dst[i] = randd() * range + p_from;
+	}
+}
+
+void RandomPCG::fill_random(float *p_dst, uint32_t p_count, float p_from, float p_to) {
+	float range = p_to - p_from;
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_dst[i] = randf() * range + p_from;
+	}
+}
+
+void RandomPCG::fill_randfn(double *p_dst, uint32_t p_count, double p_mean, double p_deviation) {
+	for (uint32_t i = 0; i < p_count; i += 2) {
+		double radius = p_deviation * sqrt(-2.0 * log(randd()));
+		double angle = Math_TAU * randd();
+		p_dst[i] = p_mean + radius * cos(angle);
+		if (i + 1 < p_count) {
+			p_dst[i + 1] = p_mean + radius * sin(angle);
+		}
+	}
+}
+
+void RandomPCG::fill_randfn(float *p_dst, uint32_t p_count, float p_mean, float p_deviation) {
+	for (uint32_t i = 0; i < p_count; i += 2) {
+		float radius = p_deviation * sqrtf(-2.0f * logf(randf()));
+		float angle = (float)Math_TAU * randf();
+		p_dst[i] = p_mean + radius * cosf(angle);
+		if (i + 1 < p_count) {
+			p_dst[i + 1] = p_mean + radius * sinf(angle);
+		}
+	}
+}
@@ -64,6 +64,15 @@ class RandomPCG {
 	uint64_t current_seed; // seed with this to get the same state
 	uint64_t current_inc;
 
+	// Same step as pcg32_random_r(), but inlined in the callers.
+	static _FORCE_INLINE_ uint32_t _next(pcg32_random_t &r_pcg) {
+		uint64_t oldstate = r_pcg.state;
+		r_pcg.state = oldstate * 6364136223846793005ULL + (r_pcg.inc | 1);
+		uint32_t xorshifted = ((oldstate >> 18u) ^ oldstate) >> 27u;
+		uint32_t rot = oldstate >> 59u;
+		return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+	}
+
 public:
 	static const uint64_t DEFAULT_SEED = 12047754176567800795U;
 	static const uint64_t DEFAULT_INC = PCG_DEFAULT_INC_64;
@@ -77,10 +86,20 @@ public:
 	}
 	_FORCE_INLINE_ uint64_t get_seed() { return current_seed; }
 
+	// Generators seeded alike but with different streams give unrelated sequences, e.g. one per thread.
+	_FORCE_INLINE_ void seed(uint64_t p_seed, uint64_t p_stream) {
+		current_inc = p_stream;
+		seed(p_seed);
+	}
+	_FORCE_INLINE_ uint64_t get_stream() { return current_inc; }
+
+	// Skips the next p_delta calls to rand() in logarithmic time.
+	void advance(uint64_t p_delta);
+
 	void randomize();
 	_FORCE_INLINE_ uint32_t rand() {
 		current_seed = pcg.state;
-		return pcg32_random_r(&pcg);
+		return _next(pcg);
 	}
 
 	// Obtaining floating point numbers in [0, 1] range with "good enough" uniformity.
@@ -131,6 +150,14 @@ public:
 	double random(double p_from, double p_to);
 	float random(float p_from, float p_to);
 	real_t random(int p_from, int p_to) { return (real_t)random((real_t)p_from, (real_t)p_to); }
+
+	// Batch versions of the above, giving the same numbers as calling them p_count times.
+	void fill_rand(uint32_t *p_dst, uint32_t p_count);
+	void fill_random(double *p_dst, uint32_t p_count, double p_from, double p_to);
+	void fill_random(float *p_dst, uint32_t p_count, float p_from, float p_to);
+	// Uses both results of each Box-Muller transform, so the numbers differ from calling randfn().
+	void fill_randfn(double *p_dst, uint32_t p_count, double p_mean, double p_deviation);
+	void fill_randfn(float *p_dst, uint32_t p_count, float p_mean, float p_deviation);
 };
 
 #endif // RANDOM_PCG_H
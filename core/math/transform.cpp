@@ -34,6 +34,66 @@
 #include "core/os/copymem.h"
 #include "core/print_string.h"
 
+#if !defined(REAL_T_IS_DOUBLE) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define TRANSFORM_SSE2
+#include <emmintrin.h>
+#elif !defined(REAL_T_IS_DOUBLE) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define TRANSFORM_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(TRANSFORM_SSE2)
+
+typedef __m128 TransformLanes;
+
+static _FORCE_INLINE_ TransformLanes _lanes_set(float p_x, float p_y, float p_z, float p_w) {
+	return _mm_set_ps(p_w, p_z, p_y, p_x);
+}
+
+static _FORCE_INLINE_ TransformLanes _lanes_madd(const TransformLanes &p_acc, const TransformLanes &p_a, float p_b) {
+	return _mm_add_ps(p_acc, _mm_mul_ps(p_a, _mm_set1_ps(p_b)));
+}
+
+static _FORCE_INLINE_ void _lanes_store3(const TransformLanes &p_v, Vector3 &r_dst) {
+	//only three floats are written, the destination may be the last element of an array
+	_mm_storel_pi((__m64 *)&r_dst.x, p_v);
+	_mm_store_ss(&r_dst.z, _mm_movehl_ps(p_v, p_v));
+}
+
+#define _lanes_add(m_a, m_b) _mm_add_ps(m_a, m_b)
+#define _lanes_sub(m_a, m_b) _mm_sub_ps(m_a, m_b)
+#define _lanes_min(m_a, m_b) _mm_min_ps(m_a, m_b)
+#define _lanes_max(m_a, m_b) _mm_max_ps(m_a, m_b)
+#define _lanes_mul_scalar(m_a, m_b) _mm_mul_ps(m_a, _mm_set1_ps(m_b))
+#define _lanes_store4(m_v, m_dst) _mm_storeu_ps(m_dst, m_v)
+
+#elif defined(TRANSFORM_NEON)
+
+typedef float32x4_t TransformLanes;
+
+static _FORCE_INLINE_ TransformLanes _lanes_set(float p_x, float p_y, float p_z, float p_w) {
+	const float v[4] = { p_x, p_y, p_z, p_w };
+	return vld1q_f32(v);
+}
+
+static _FORCE_INLINE_ TransformLanes _lanes_madd(const TransformLanes &p_acc, const TransformLanes &p_a, float p_b) {
+	return vmlaq_n_f32(p_acc, p_a, p_b);
+}
+
+static _FORCE_INLINE_ void _lanes_store3(const TransformLanes &p_v, Vector3 &r_dst) {
+	vst1_f32(&r_dst.x, vget_low_f32(p_v));
+	r_dst.z = vgetq_lane_f32(p_v, 2);
+}
+
+#define _lanes_add(m_a, m_b) vaddq_f32(m_a, m_b)
+#define _lanes_sub(m_a, m_b) vsubq_f32(m_a, m_b)
+#define _lanes_min(m_a, m_b) vminq_f32(m_a, m_b)
+#define _lanes_max(m_a, m_b) vmaxq_f32(m_a, m_b)
+#define _lanes_mul_scalar(m_a, m_b) vmulq_n_f32(m_a, m_b)
+#define _lanes_store4(m_v, m_dst) vst1q_f32(m_dst, m_v)
+
+#endif
+
 void Transform::affine_invert() {
 
 	basis.invert();
@@ -209,6 +269,95 @@ Transform Transform::operator*(const Transform &p_transform) const {
 	return t;
 }
 
+void Transform::xform_array(const Vector3 *p_src, Vector3 *r_dst, int p_count) const {
+
+#if defined(TRANSFORM_SSE2) || defined(TRANSFORM_NEON)
+	//columns of the basis, the result is origin + c0 * x + c1 * y + c2 * z
+	const TransformLanes c0 = _lanes_set(basis[0][0], basis[1][0], basis[2][0], 0);
+	const TransformLanes c1 = _lanes_set(basis[0][1], basis[1][1], basis[2][1], 0);
+	const TransformLanes c2 = _lanes_set(basis[0][2], basis[1][2], basis[2][2], 0);
+	const TransformLanes o = _lanes_set(origin.x, origin.y, origin.z, 0);
+
+	for (int i = 0; i < p_count; i++) {
+		const Vector3 &v = p_src[i];
+		TransformLanes r = _lanes_madd(o, c0, v.x);
+		r = _lanes_madd(r, c1, v.y);
+		r = _lanes_madd(r, c2, v.z);
+		_lanes_store3(r, r_dst[i]);
+	}
+#else
+	for (int i = 0; i < p_count; i++) {
+		r_dst[i] = xform(p_src[i]);
+	}
+#endif
+}
+
+void Transform::xform_array(const AABB *p_src, AABB *r_dst, int p_count) const {
+
+#if defined(TRANSFORM_SSE2) || defined(TRANSFORM_NEON)
+	//same as xform(AABB), each basis column scaled by the box extents on that axis
+	const TransformLanes c[3] = {
+		_lanes_set(basis[0][0], basis[1][0], basis[2][0], 0),
+		_lanes_set(basis[0][1], basis[1][1], basis[2][1], 0),
+		_lanes_set(basis[0][2], basis[1][2], basis[2][2], 0)
+	};
+	const TransformLanes o = _lanes_set(origin.x, origin.y, origin.z, 0);
+
+	for (int i = 0; i < p_count; i++) {
+		const Vector3 min = p_src[i].position;
+		const Vector3 max = p_src[i].position + p_src[i].size;
+		TransformLanes tmin = o;
+		TransformLanes tmax = o;
+		for (int j = 0; j < 3; j++) {
+			TransformLanes e = _lanes_mul_scalar(c[j], min[j]);
+			TransformLanes f = _lanes_mul_scalar(c[j], max[j]);
+			tmin = _lanes_add(tmin, _lanes_min(e, f));
+			tmax = _lanes_add(tmax, _lanes_max(e, f));
+		}
+		_lanes_store3(tmin, r_dst[i].position);
+		_lanes_store3(_lanes_sub(tmax, tmin), r_dst[i].size);
+	}
+#else
+	for (int i = 0; i < p_count; i++) {
+		r_dst[i] = xform(p_src[i]);
+	}
+#endif
+}
+
+void Transform::multiply_array(const Transform *p_a, const Transform *p_b, Transform *r_dst, int p_count) {
+
+#if defined(TRANSFORM_SSE2) || defined(TRANSFORM_NEON)
+	for (int i = 0; i < p_count; i++) {
+		const Transform &a = p_a[i];
+		const Transform &b = p_b[i];
+
+		//rows of b with its origin in the last lane, so each result row carries its origin component too
+		const TransformLanes b0 = _lanes_set(b.basis[0][0], b.basis[0][1], b.basis[0][2], b.origin.x);
+		const TransformLanes b1 = _lanes_set(b.basis[1][0], b.basis[1][1], b.basis[1][2], b.origin.y);
+		const TransformLanes b2 = _lanes_set(b.basis[2][0], b.basis[2][1], b.basis[2][2], b.origin.z);
+
+		float rows[3][4];
+		for (int j = 0; j < 3; j++) {
+			TransformLanes r = _lanes_set(0, 0, 0, a.origin[j]);
+			r = _lanes_madd(r, b0, a.basis[j][0]);
+			r = _lanes_madd(r, b1, a.basis[j][1]);
+			r = _lanes_madd(r, b2, a.basis[j][2]);
+			_lanes_store4(r, rows[j]);
+		}
+
+		Transform &t = r_dst[i];
+		for (int j = 0; j < 3; j++) {
+			t.basis[j] = Vector3(rows[j][0], rows[j][1], rows[j][2]);
+			t.origin[j] = rows[j][3];
+		}
+	}
+#else
+	for (int i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i] * p_b[i];
+	}
+#endif
+}
+
 Transform::operator String() const {
 
 	return basis.operator String() + " - " + origin.operator String();
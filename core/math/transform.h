@@ -87,6 +87,11 @@ public:
 	_FORCE_INLINE_ PoolVector<Vector3> xform(const PoolVector<Vector3> &p_array) const;
 	_FORCE_INLINE_ PoolVector<Vector3> xform_inv(const PoolVector<Vector3> &p_array) const;
 
+	//batch versions (SSE2/NEON when available), r_dst may be the same array as p_src
+	void xform_array(const Vector3 *p_src, Vector3 *r_dst, int p_count) const;
+	void xform_array(const AABB *p_src, AABB *r_dst, int p_count) const;
+	static void multiply_array(const Transform *p_a, const Transform *p_b, Transform *r_dst, int p_count); //r_dst[i] = p_a[i] * p_b[i]
+
 	void operator*=(const Transform &p_transform);
 	Transform operator*(const Transform &p_transform) const;
 
@@ -218,9 +223,7 @@ PoolVector<Vector3> Transform::xform(const PoolVector<Vector3> &p_array) const {
 	PoolVector<Vector3>::Read r = p_array.read();
 	PoolVector<Vector3>::Write w = array.write();
 
-	for (int i = 0; i < p_array.size(); ++i) {
-		w[i] = xform(r[i]);
-	}
+	xform_array(r.ptr(), w.ptr(), p_array.size());
 	return array;
 }
 
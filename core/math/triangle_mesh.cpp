@@ -27,66 +27,267 @@
 /* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
-
 #include "triangle_mesh.h"
 
+#include "core/math/geometry.h"
+#include "core/oa_hash_map.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/sort_array.h"
 
-int TriangleMesh::_create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int p_depth, int &max_depth, int &max_alloc) {
+#if !defined(REAL_T_IS_DOUBLE) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define TRIANGLE_MESH_SSE2
+#include <emmintrin.h>
+#elif !defined(REAL_T_IS_DOUBLE) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define TRIANGLE_MESH_NEON
+#include <arm_neon.h>
+#endif
+
+#define TRIANGLE_MESH_LEAF_FACES 4
+#define TRIANGLE_MESH_STACK_SIZE 64 // enough for any balanced 4-wide tree
+#define TRIANGLE_MESH_RAY_GROUP 64 // rays of a batch query handed to a worker thread at once
+
+struct TriangleMeshVertexHasher {
+
+	static _FORCE_INLINE_ uint32_t hash(const Vector3 &p_vertex) {
 
-	if (p_depth > max_depth) {
-		max_depth = p_depth;
+		uint32_t h = hash_djb2_one_float(p_vertex.x);
+		h = hash_djb2_one_float(p_vertex.y, h);
+		return hash_djb2_one_float(p_vertex.z, h);
 	}
+};
 
-	if (p_size == 1) {
+//rays of a batch query, split in groups over the worker threads
+struct TriangleMeshRayGroups {
 
-		return p_bb[p_from] - p_bvh;
-	} else if (p_size == 0) {
+	const TriangleMesh *mesh;
+	const Vector3 *begins;
+	const Vector3 *dirs;
+	bool *hits;
+	Vector3 *points;
+	Vector3 *normals;
+	int count;
 
-		return -1;
+	void process(uint32_t p_group, void *p_userdata) {
+
+		int from = p_group * TRIANGLE_MESH_RAY_GROUP;
+		int to = MIN(count, from + TRIANGLE_MESH_RAY_GROUP);
+
+		for (int i = from; i < to; i++) {
+			hits[i] = mesh->intersect_ray(begins[i], dirs[i], points[i], normals[i]);
+		}
 	}
+};
 
-	AABB aabb;
-	aabb = p_bb[p_from]->aabb;
-	for (int i = 1; i < p_size; i++) {
+AABB TriangleMesh::_get_elements_aabb(const BVHElement *p_elements, int p_size) {
 
-		aabb.merge_with(p_bb[p_from + i]->aabb);
+	AABB aabb = p_elements[0].aabb;
+	for (int i = 1; i < p_size; i++) {
+		aabb.merge_with(p_elements[i].aabb);
 	}
 
-	int li = aabb.get_longest_axis_index();
+	return aabb;
+}
+
+AABB TriangleMesh::_get_child_aabb(const BVH &p_node, int p_child) {
+
+	Vector3 from(p_node.min_x[p_child], p_node.min_y[p_child], p_node.min_z[p_child]);
+	Vector3 to(p_node.max_x[p_child], p_node.max_y[p_child], p_node.max_z[p_child]);
+	return AABB(from, to - from);
+}
+
+void TriangleMesh::_split_elements(BVHElement *p_elements, int p_size) {
 
-	switch (li) {
+	// split along the axis where the centers spread the most, nth_element is enough to halve them
+	AABB centers(p_elements[0].center, Vector3());
+	for (int i = 1; i < p_size; i++) {
+		centers.expand_to(p_elements[i].center);
+	}
+
+	switch (centers.get_longest_axis_index()) {
 
 		case Vector3::AXIS_X: {
-			SortArray<BVH *, BVHCmpX> sort_x;
-			sort_x.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
-			//sort_x.sort(&p_bb[p_from],p_size);
+			SortArray<BVHElement, BVHCmpX> sort_x;
+			sort_x.nth_element(0, p_size, p_size / 2, p_elements);
 		} break;
 		case Vector3::AXIS_Y: {
-			SortArray<BVH *, BVHCmpY> sort_y;
-			sort_y.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
-			//sort_y.sort(&p_bb[p_from],p_size);
+			SortArray<BVHElement, BVHCmpY> sort_y;
+			sort_y.nth_element(0, p_size, p_size / 2, p_elements);
 		} break;
 		case Vector3::AXIS_Z: {
-			SortArray<BVH *, BVHCmpZ> sort_z;
-			sort_z.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
-			//sort_z.sort(&p_bb[p_from],p_size);
-
+			SortArray<BVHElement, BVHCmpZ> sort_z;
+			sort_z.nth_element(0, p_size, p_size / 2, p_elements);
 		} break;
 	}
+}
+
+int TriangleMesh::_create_bvh(BVHElement *p_elements, int p_size, int p_offset) {
+
+	// split in halves twice, which gives up to four children per node
+	int child_begin[4];
+	int child_size[4];
+	int child_count = 0;
 
-	int left = _create_bvh(p_bvh, p_bb, p_from, p_size / 2, p_depth + 1, max_depth, max_alloc);
-	int right = _create_bvh(p_bvh, p_bb, p_from + p_size / 2, p_size - p_size / 2, p_depth + 1, max_depth, max_alloc);
+	if (p_size <= TRIANGLE_MESH_LEAF_FACES) {
 
-	int index = max_alloc++;
-	BVH *_new = &p_bvh[index];
-	_new->aabb = aabb;
-	_new->center = aabb.position + aabb.size * 0.5;
-	_new->face_index = -1;
-	_new->left = left;
-	_new->right = right;
+		child_begin[0] = 0;
+		child_size[0] = p_size;
+		child_count = 1;
+	} else {
 
-	return index;
+		_split_elements(p_elements, p_size);
+
+		int half = p_size / 2;
+		int half_begin[2] = { 0, half };
+		int half_size[2] = { half, p_size - half };
+
+		for (int i = 0; i < 2; i++) {
+
+			if (half_size[i] > TRIANGLE_MESH_LEAF_FACES) {
+
+				_split_elements(&p_elements[half_begin[i]], half_size[i]);
+
+				int quarter = half_size[i] / 2;
+				child_begin[child_count] = half_begin[i];
+				child_size[child_count] = quarter;
+				child_count++;
+				child_begin[child_count] = half_begin[i] + quarter;
+				child_size[child_count] = half_size[i] - quarter;
+				child_count++;
+			} else {
+
+				child_begin[child_count] = half_begin[i];
+				child_size[child_count] = half_size[i];
+				child_count++;
+			}
+		}
+	}
+
+	BVH node;
+
+	for (int i = 0; i < 4; i++) {
+
+		if (i >= child_count) {
+			node.min_x[i] = node.min_y[i] = node.min_z[i] = 1e20;
+			node.max_x[i] = node.max_y[i] = node.max_z[i] = -1e20;
+			node.child[i] = -1;
+			node.face_count[i] = 0;
+			continue;
+		}
+
+		AABB aabb = _get_elements_aabb(&p_elements[child_begin[i]], child_size[i]);
+		node.min_x[i] = aabb.position.x;
+		node.min_y[i] = aabb.position.y;
+		node.min_z[i] = aabb.position.z;
+		node.max_x[i] = aabb.position.x + aabb.size.x;
+		node.max_y[i] = aabb.position.y + aabb.size.y;
+		node.max_z[i] = aabb.position.z + aabb.size.z;
+
+		if (child_size[i] <= TRIANGLE_MESH_LEAF_FACES) {
+			node.child[i] = p_offset + child_begin[i];
+			node.face_count[i] = child_size[i];
+		} else {
+			node.child[i] = -1; // filled below, once the subtree exists
+			node.face_count[i] = 0;
+		}
+	}
+
+	int idx = bvh.size();
+	bvh.push_back(node);
+
+	for (int i = 0; i < child_count; i++) {
+
+		if (child_size[i] > TRIANGLE_MESH_LEAF_FACES) {
+			int child = _create_bvh(&p_elements[child_begin[i]], child_size[i], p_offset + child_begin[i]);
+			bvh.write[idx].child[i] = child;
+		}
+	}
+
+	return idx;
+}
+
+//slab test of a ray against the four children of a node, returns a bit per child hit within [0, p_max_t]
+int TriangleMesh::_intersect_children(const BVH &p_node, const Vector3 &p_from, const Vector3 &p_inv_dir, real_t p_max_t, real_t *r_t_enter) const {
+
+#if defined(TRIANGLE_MESH_SSE2)
+
+	__m128 from_x = _mm_set1_ps(p_from.x);
+	__m128 from_y = _mm_set1_ps(p_from.y);
+	__m128 from_z = _mm_set1_ps(p_from.z);
+	__m128 inv_x = _mm_set1_ps(p_inv_dir.x);
+	__m128 inv_y = _mm_set1_ps(p_inv_dir.y);
+	__m128 inv_z = _mm_set1_ps(p_inv_dir.z);
+
+	__m128 tx0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node.min_x), from_x), inv_x);
+	__m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node.max_x), from_x), inv_x);
+	__m128 ty0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node.min_y), from_y), inv_y);
+	__m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node.max_y), from_y), inv_y);
+	__m128 tz0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node.min_z), from_z), inv_z);
+	__m128 tz1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node.max_z), from_z), inv_z);
+
+	__m128 t_enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx0, tx1), _mm_min_ps(ty0, ty1)), _mm_max_ps(_mm_min_ps(tz0, tz1), _mm_setzero_ps()));
+	__m128 t_exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx0, tx1), _mm_max_ps(ty0, ty1)), _mm_min_ps(_mm_max_ps(tz0, tz1), _mm_set1_ps(p_max_t)));
+
+	_mm_storeu_ps(r_t_enter, t_enter);
+	return _mm_movemask_ps(_mm_cmple_ps(t_enter, t_exit));
+
+#elif defined(TRIANGLE_MESH_NEON)
+
+	float32x4_t from_x = vdupq_n_f32(p_from.x);
+	float32x4_t from_y = vdupq_n_f32(p_from.y);
+	float32x4_t from_z = vdupq_n_f32(p_from.z);
+	float32x4_t inv_x = vdupq_n_f32(p_inv_dir.x);
+	float32x4_t inv_y = vdupq_n_f32(p_inv_dir.y);
+	float32x4_t inv_z = vdupq_n_f32(p_inv_dir.z);
+
+	float32x4_t tx0 = vmulq_f32(vsubq_f32(vld1q_f32(p_node.min_x), from_x), inv_x);
+	float32x4_t tx1 = vmulq_f32(vsubq_f32(vld1q_f32(p_node.max_x), from_x), inv_x);
+	float32x4_t ty0 = vmulq_f32(vsubq_f32(vld1q_f32(p_node.min_y), from_y), inv_y);
+	float32x4_t ty1 = vmulq_f32(vsubq_f32(vld1q_f32(p_node.max_y), from_y), inv_y);
+	float32x4_t tz0 = vmulq_f32(vsubq_f32(vld1q_f32(p_node.min_z), from_z), inv_z);
+	float32x4_t tz1 = vmulq_f32(vsubq_f32(vld1q_f32(p_node.max_z), from_z), inv_z);
+
+	float32x4_t t_enter = vmaxq_f32(vmaxq_f32(vminq_f32(tx0, tx1), vminq_f32(ty0, ty1)), vmaxq_f32(vminq_f32(tz0, tz1), vdupq_n_f32(0)));
+	float32x4_t t_exit = vminq_f32(vminq_f32(vmaxq_f32(tx0, tx1), vmaxq_f32(ty0, ty1)), vminq_f32(vmaxq_f32(tz0, tz1), vdupq_n_f32(p_max_t)));
+
+	vst1q_f32(r_t_enter, t_enter);
+	uint32x4_t hit = vcleq_f32(t_enter, t_exit);
+	return (vgetq_lane_u32(hit, 0) & 1) | (vgetq_lane_u32(hit, 1) & 2) | (vgetq_lane_u32(hit, 2) & 4) | (vgetq_lane_u32(hit, 3) & 8);
+
+#else
+
+	int mask = 0;
+
+	for (int i = 0; i < 4; i++) {
+
+		real_t tx0 = (p_node.min_x[i] - p_from.x) * p_inv_dir.x;
+		real_t tx1 = (p_node.max_x[i] - p_from.x) * p_inv_dir.x;
+		real_t ty0 = (p_node.min_y[i] - p_from.y) * p_inv_dir.y;
+		real_t ty1 = (p_node.max_y[i] - p_from.y) * p_inv_dir.y;
+		real_t tz0 = (p_node.min_z[i] - p_from.z) * p_inv_dir.z;
+		real_t tz1 = (p_node.max_z[i] - p_from.z) * p_inv_dir.z;
+
+		real_t t_enter = MAX(MAX(MIN(tx0, tx1), MIN(ty0, ty1)), MAX(MIN(tz0, tz1), (real_t)0.0));
+		real_t t_exit = MIN(MIN(MAX(tx0, tx1), MAX(ty0, ty1)), MIN(MAX(tz0, tz1), p_max_t));
+
+		r_t_enter[i] = t_enter;
+		if (t_enter <= t_exit) {
+			mask |= 1 << i;
+		}
+	}
+
+	return mask;
+
+#endif
+}
+
+static _FORCE_INLINE_ Vector3 _triangle_mesh_get_inv_dir(const Vector3 &p_dir) {
+
+	Vector3 inv_dir;
+	for (int i = 0; i < 3; i++) {
+		// avoid infinities, 0 * inf would turn the slab test into NaN
+		inv_dir[i] = p_dir[i] != 0 ? 1.0 / p_dir[i] : 1e30;
+	}
+	return inv_dir;
 }
 
 void TriangleMesh::get_indices(PoolVector<int> *r_triangles_indices) const {
@@ -113,23 +314,31 @@ void TriangleMesh::create(const PoolVector<Vector3> &p_faces) {
 
 	valid = false;
 
+	bvh.clear();
+	for (int i = 0; i < 3; i++) {
+		leaf_vertices[i].clear();
+	}
+	leaf_triangles.clear();
+
 	int fc = p_faces.size();
 	ERR_FAIL_COND(!fc || ((fc % 3) != 0));
 	fc /= 3;
 	triangles.resize(fc);
 
-	bvh.resize(fc * 3); //will never be larger than this (todo make better)
-	PoolVector<BVH>::Write bw = bvh.write();
+	Vector<BVHElement> elements;
+	elements.resize(fc);
+	BVHElement *ew = elements.ptrw();
 
 	{
 
 		//create faces and indices and base bvh
-		//except for the Set for repeated triangles, everything
+		//except for the map for repeated vertices, everything
 		//goes in-place.
 
 		PoolVector<Vector3>::Read r = p_faces.read();
 		PoolVector<Triangle>::Write w = triangles.write();
-		Map<Vector3, int> db;
+		OAHashMap<Vector3, int, TriangleMeshVertexHasher> db(next_power_of_2(fc * 2));
+		Vector<Vector3> unique_vertices;
 
 		for (int i = 0; i < fc; i++) {
 
@@ -140,141 +349,112 @@ void TriangleMesh::create(const PoolVector<Vector3> &p_faces) {
 
 				int vidx = -1;
 				Vector3 vs = v[j].snapped(Vector3(0.0001, 0.0001, 0.0001));
-				Map<Vector3, int>::Element *E = db.find(vs);
+				const int *E = db.lookup_ptr(vs);
 				if (E) {
-					vidx = E->get();
+					vidx = *E;
 				} else {
-					vidx = db.size();
-					db[vs] = vidx;
+					vidx = unique_vertices.size();
+					db.insert(vs, vidx);
+					unique_vertices.push_back(vs);
 				}
 
 				f.indices[j] = vidx;
 				if (j == 0)
-					bw[i].aabb.position = vs;
+					ew[i].aabb.position = vs;
 				else
-					bw[i].aabb.expand_to(vs);
+					ew[i].aabb.expand_to(vs);
 			}
 
 			f.normal = Face3(r[i * 3 + 0], r[i * 3 + 1], r[i * 3 + 2]).get_plane().get_normal();
 
-			bw[i].left = -1;
-			bw[i].right = -1;
-			bw[i].face_index = i;
-			bw[i].center = bw[i].aabb.position + bw[i].aabb.size * 0.5;
+			ew[i].face_index = i;
+			ew[i].center = ew[i].aabb.position + ew[i].aabb.size * 0.5;
 		}
 
-		vertices.resize(db.size());
+		vertices.resize(unique_vertices.size());
 		PoolVector<Vector3>::Write vw = vertices.write();
-		for (Map<Vector3, int>::Element *E = db.front(); E; E = E->next()) {
-			vw[E->get()] = E->key();
+		for (int i = 0; i < unique_vertices.size(); i++) {
+			vw[i] = unique_vertices[i];
 		}
 	}
 
-	PoolVector<BVH *> bwptrs;
-	bwptrs.resize(fc);
-	PoolVector<BVH *>::Write bwp = bwptrs.write();
-	for (int i = 0; i < fc; i++) {
+	// sorts the elements into leaf order
+	_create_bvh(ew, fc, 0);
 
-		bwp[i] = &bw[i];
+	for (int i = 0; i < 3; i++) {
+		leaf_vertices[i].resize(fc);
 	}
+	leaf_triangles.resize(fc);
+
+	Vector3 *vaw = leaf_vertices[0].ptrw();
+	Vector3 *vbw = leaf_vertices[1].ptrw();
+	Vector3 *vcw = leaf_vertices[2].ptrw();
+	int *trianglesw = leaf_triangles.ptrw();
 
-	max_depth = 0;
-	int max_alloc = fc;
-	_create_bvh(bw.ptr(), bwp.ptr(), 0, fc, 1, max_depth, max_alloc);
+	PoolVector<Triangle>::Read tr = triangles.read();
+	PoolVector<Vector3>::Read vr = vertices.read();
 
-	bw.release(); //clearup
-	bvh.resize(max_alloc); //resize back
+	for (int i = 0; i < fc; i++) {
+
+		int src = ew[i].face_index;
+		vaw[i] = vr[tr[src].indices[0]];
+		vbw[i] = vr[tr[src].indices[1]];
+		vcw[i] = vr[tr[src].indices[2]];
+		trianglesw[i] = src;
+	}
 
 	valid = true;
 }
 
 Vector3 TriangleMesh::get_area_normal(const AABB &p_aabb) const {
 
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
-
-	};
-
 	int n_count = 0;
 	Vector3 n;
 
-	int level = 0;
+	if (!valid)
+		return n;
 
 	PoolVector<Triangle>::Read trianglesr = triangles.read();
-	PoolVector<Vector3>::Read verticesr = vertices.read();
-	PoolVector<BVH>::Read bvhr = bvh.read();
-
 	const Triangle *triangleptr = trianglesr.ptr();
-	int pos = bvh.size() - 1;
-	const BVH *bvhptr = bvhr.ptr();
-
-	stack[0] = pos;
-	while (true) {
+	const BVH *nodes = bvh.ptr();
+	const int *leafptr = leaf_triangles.ptr();
+	const Vector3 *va = leaf_vertices[0].ptr();
+	const Vector3 *vb = leaf_vertices[1].ptr();
+	const Vector3 *vc = leaf_vertices[2].ptr();
 
-		uint32_t node = stack[level] & NODE_IDX_MASK;
-		const BVH &b = bvhptr[node];
-		bool done = false;
+	int stack[TRIANGLE_MESH_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
 
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
+	while (stack_size) {
 
-				bool valid = b.aabb.intersects(p_aabb);
-				if (!valid) {
+		const BVH &node = nodes[stack[--stack_size]];
 
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+		for (int i = 0; i < 4; i++) {
 
-				} else {
-
-					if (b.face_index >= 0) {
-
-						const Triangle &s = triangleptr[b.face_index];
-						n += s.normal;
-						n_count++;
-
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-					} else {
-
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
-					}
-				}
+			if (node.child[i] < 0 || !_get_child_aabb(node, i).intersects(p_aabb))
 				continue;
-			}
-			case VISIT_LEFT_BIT: {
 
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
+			if (node.face_count[i] == 0) {
+				stack[stack_size++] = node.child[i];
 				continue;
 			}
-			case VISIT_RIGHT_BIT: {
 
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
+			int from = node.child[i];
+			int to = from + node.face_count[i];
 
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
+			for (int j = from; j < to; j++) {
+
+				AABB aabb(va[j], Vector3());
+				aabb.expand_to(vb[j]);
+				aabb.expand_to(vc[j]);
+				if (!aabb.intersects(p_aabb))
+					continue;
+
+				n += triangleptr[leafptr[j]].normal;
+				n_count++;
 			}
 		}
-
-		if (done)
-			break;
 	}
 
 	if (n_count > 0)
@@ -283,445 +463,239 @@ Vector3 TriangleMesh::get_area_normal(const AABB &p_aabb) const {
 	return n;
 }
 
-bool TriangleMesh::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
-
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
-
-	};
-
-	Vector3 n = (p_end - p_begin).normalized();
-	real_t d = 1e10;
-	bool inters = false;
-
-	int level = 0;
+bool TriangleMesh::_intersect(const Vector3 &p_from, const Vector3 &p_dir, bool p_segment, Vector3 &r_point, Vector3 &r_normal) const {
 
-	PoolVector<Triangle>::Read trianglesr = triangles.read();
-	PoolVector<Vector3>::Read verticesr = vertices.read();
-	PoolVector<BVH>::Read bvhr = bvh.read();
+	if (!valid)
+		return false;
 
-	const Triangle *triangleptr = trianglesr.ptr();
-	const Vector3 *vertexptr = verticesr.ptr();
-	int pos = bvh.size() - 1;
-	const BVH *bvhptr = bvhr.ptr();
+	real_t dir_length_squared = p_dir.length_squared();
+	if (dir_length_squared == 0)
+		return false;
 
-	stack[0] = pos;
-	while (true) {
+	Vector3 inv_dir = _triangle_mesh_get_inv_dir(p_dir);
+	Vector3 to = p_from + p_dir;
 
-		uint32_t node = stack[level] & NODE_IDX_MASK;
-		const BVH &b = bvhptr[node];
-		bool done = false;
+	const BVH *nodes = bvh.ptr();
+	const Vector3 *va = leaf_vertices[0].ptr();
+	const Vector3 *vb = leaf_vertices[1].ptr();
+	const Vector3 *vc = leaf_vertices[2].ptr();
 
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
+	// hits are ordered by their distance along the ray, so farther nodes can be skipped
+	real_t max_t = p_segment ? 1.0 : 1e20;
+	int hit = -1;
 
-				bool valid = b.aabb.intersects_segment(p_begin, p_end);
-				//bool valid = b.aabb.intersects(ray_aabb);
+	int stack[TRIANGLE_MESH_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
 
-				if (!valid) {
+	while (stack_size) {
 
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+		const BVH &node = nodes[stack[--stack_size]];
 
-				} else {
+		real_t t_enter[4];
+		int mask = _intersect_children(node, p_from, inv_dir, max_t, t_enter);
 
-					if (b.face_index >= 0) {
+		// push the nearest child last, so it is visited first
+		int order[4];
+		int order_count = 0;
 
-						const Triangle &s = triangleptr[b.face_index];
-						Face3 f3(vertexptr[s.indices[0]], vertexptr[s.indices[1]], vertexptr[s.indices[2]]);
+		for (int i = 0; i < 4; i++) {
 
-						Vector3 res;
+			if (!(mask & (1 << i)) || node.child[i] < 0)
+				continue;
 
-						if (f3.intersects_segment(p_begin, p_end, &res)) {
+			if (node.face_count[i] == 0) {
+				int k = order_count++;
+				while (k > 0 && t_enter[order[k - 1]] < t_enter[i]) {
+					order[k] = order[k - 1];
+					k--;
+				}
+				order[k] = i;
+				continue;
+			}
 
-							real_t nd = n.dot(res);
-							if (nd < d) {
+			int from = node.child[i];
+			int end = from + node.face_count[i];
 
-								d = nd;
-								r_point = res;
-								r_normal = f3.get_plane().get_normal();
-								inters = true;
-							}
-						}
+			for (int j = from; j < end; j++) {
 
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+				Vector3 res;
+				bool inters = p_segment ? Geometry::segment_intersects_triangle(p_from, to, va[j], vb[j], vc[j], &res) : Geometry::ray_intersects_triangle(p_from, p_dir, va[j], vb[j], vc[j], &res);
 
-					} else {
+				if (inters) {
 
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
+					real_t t = (res - p_from).dot(p_dir) / dir_length_squared;
+					if (t < max_t) {
+						max_t = t;
+						r_point = res;
+						hit = j;
 					}
 				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
-
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
-
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
-
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
 			}
 		}
 
-		if (done)
-			break;
+		for (int i = 0; i < order_count; i++) {
+			stack[stack_size++] = node.child[order[i]];
+		}
 	}
 
-	if (inters) {
+	if (hit < 0)
+		return false;
 
-		if (n.dot(r_normal) > 0)
-			r_normal = -r_normal;
-	}
+	r_normal = Face3(va[hit], vb[hit], vc[hit]).get_plane().get_normal();
+	if (p_dir.dot(r_normal) > 0)
+		r_normal = -r_normal;
 
-	return inters;
+	return true;
 }
 
-bool TriangleMesh::intersect_ray(const Vector3 &p_begin, const Vector3 &p_dir, Vector3 &r_point, Vector3 &r_normal) const {
-
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
-
-	};
-
-	Vector3 n = p_dir;
-	real_t d = 1e20;
-	bool inters = false;
-
-	int level = 0;
-
-	PoolVector<Triangle>::Read trianglesr = triangles.read();
-	PoolVector<Vector3>::Read verticesr = vertices.read();
-	PoolVector<BVH>::Read bvhr = bvh.read();
-
-	const Triangle *triangleptr = trianglesr.ptr();
-	const Vector3 *vertexptr = verticesr.ptr();
-	int pos = bvh.size() - 1;
-	const BVH *bvhptr = bvhr.ptr();
-
-	stack[0] = pos;
-	while (true) {
-
-		uint32_t node = stack[level] & NODE_IDX_MASK;
-		const BVH &b = bvhptr[node];
-		bool done = false;
-
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
-
-				bool valid = b.aabb.intersects_ray(p_begin, p_dir);
-				if (!valid) {
-
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-				} else {
-
-					if (b.face_index >= 0) {
-
-						const Triangle &s = triangleptr[b.face_index];
-						Face3 f3(vertexptr[s.indices[0]], vertexptr[s.indices[1]], vertexptr[s.indices[2]]);
-
-						Vector3 res;
-
-						if (f3.intersects_ray(p_begin, p_dir, &res)) {
-
-							real_t nd = n.dot(res);
-							if (nd < d) {
+bool TriangleMesh::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
 
-								d = nd;
-								r_point = res;
-								r_normal = f3.get_plane().get_normal();
-								inters = true;
-							}
-						}
+	return _intersect(p_begin, p_end - p_begin, true, r_point, r_normal);
+}
 
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+bool TriangleMesh::intersect_ray(const Vector3 &p_begin, const Vector3 &p_dir, Vector3 &r_point, Vector3 &r_normal) const {
 
-					} else {
+	return _intersect(p_begin, p_dir, false, r_point, r_normal);
+}
 
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
-					}
-				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
+void TriangleMesh::intersect_rays(const Vector3 *p_begins, const Vector3 *p_dirs, int p_count, bool *r_hits, Vector3 *r_points, Vector3 *r_normals) const {
 
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
+	TriangleMeshRayGroups groups;
+	groups.mesh = this;
+	groups.begins = p_begins;
+	groups.dirs = p_dirs;
+	groups.hits = r_hits;
+	groups.points = r_points;
+	groups.normals = r_normals;
+	groups.count = p_count;
 
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
+	uint32_t group_count = (p_count + TRIANGLE_MESH_RAY_GROUP - 1) / TRIANGLE_MESH_RAY_GROUP;
 
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
-			}
+	if (group_count > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		WorkerThreadPool::get_singleton()->parallel_for(group_count, &groups, &TriangleMeshRayGroups::process, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < group_count; i++) {
+			groups.process(i, NULL);
 		}
-
-		if (done)
-			break;
-	}
-
-	if (inters) {
-
-		if (n.dot(r_normal) > 0)
-			r_normal = -r_normal;
 	}
-
-	return inters;
 }
 
 bool TriangleMesh::intersect_convex_shape(const Plane *p_planes, int p_plane_count) const {
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	//p_fully_inside = true;
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
 
-	};
-
-	int level = 0;
-
-	PoolVector<Triangle>::Read trianglesr = triangles.read();
-	PoolVector<Vector3>::Read verticesr = vertices.read();
-	PoolVector<BVH>::Read bvhr = bvh.read();
-
-	const Triangle *triangleptr = trianglesr.ptr();
-	const Vector3 *vertexptr = verticesr.ptr();
-	int pos = bvh.size() - 1;
-	const BVH *bvhptr = bvhr.ptr();
+	if (!valid)
+		return false;
 
-	stack[0] = pos;
-	while (true) {
+	const BVH *nodes = bvh.ptr();
+	const Vector3 *leaf[3] = { leaf_vertices[0].ptr(), leaf_vertices[1].ptr(), leaf_vertices[2].ptr() };
 
-		uint32_t node = stack[level] & NODE_IDX_MASK;
-		const BVH &b = bvhptr[node];
-		bool done = false;
+	int stack[TRIANGLE_MESH_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
 
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
+	while (stack_size) {
 
-				bool valid = b.aabb.intersects_convex_shape(p_planes, p_plane_count);
-				if (!valid) {
+		const BVH &node = nodes[stack[--stack_size]];
 
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+		for (int c = 0; c < 4; c++) {
 
-				} else {
+			if (node.child[c] < 0 || !_get_child_aabb(node, c).intersects_convex_shape(p_planes, p_plane_count))
+				continue;
 
-					if (b.face_index >= 0) {
-
-						const Triangle &s = triangleptr[b.face_index];
-
-						for (int j = 0; j < 3; ++j) {
-							const Vector3 &point = vertexptr[s.indices[j]];
-							const Vector3 &next_point = vertexptr[s.indices[(j + 1) % 3]];
-							Vector3 res;
-							bool over = true;
-							for (int i = 0; i < p_plane_count; i++) {
-								const Plane &p = p_planes[i];
-
-								if (p.intersects_segment(point, next_point, &res)) {
-									bool inisde = true;
-									for (int k = 0; k < p_plane_count; k++) {
-										if (k == i) continue;
-										const Plane &pp = p_planes[k];
-										if (pp.is_point_over(res)) {
-											inisde = false;
-											break;
-										}
-									}
-									if (inisde) return true;
-								}
+			if (node.face_count[c] == 0) {
+				stack[stack_size++] = node.child[c];
+				continue;
+			}
 
-								if (p.is_point_over(point)) {
-									over = false;
+			int from = node.child[c];
+			int end = from + node.face_count[c];
+
+			for (int f = from; f < end; f++) {
+
+				for (int j = 0; j < 3; ++j) {
+					const Vector3 &point = leaf[j][f];
+					const Vector3 &next_point = leaf[(j + 1) % 3][f];
+					Vector3 res;
+					bool over = true;
+					for (int i = 0; i < p_plane_count; i++) {
+						const Plane &p = p_planes[i];
+
+						if (p.intersects_segment(point, next_point, &res)) {
+							bool inisde = true;
+							for (int k = 0; k < p_plane_count; k++) {
+								if (k == i) continue;
+								const Plane &pp = p_planes[k];
+								if (pp.is_point_over(res)) {
+									inisde = false;
 									break;
 								}
 							}
-							if (over) return true;
+							if (inisde) return true;
 						}
 
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-					} else {
-
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
+						if (p.is_point_over(point)) {
+							over = false;
+							break;
+						}
 					}
+					if (over) return true;
 				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
-
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
-
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
-
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
 			}
 		}
-
-		if (done)
-			break;
 	}
 
 	return false;
 }
 
 bool TriangleMesh::inside_convex_shape(const Plane *p_planes, int p_plane_count, Vector3 p_scale) const {
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
-
-	};
 
-	int level = 0;
-
-	PoolVector<Triangle>::Read trianglesr = triangles.read();
-	PoolVector<Vector3>::Read verticesr = vertices.read();
-	PoolVector<BVH>::Read bvhr = bvh.read();
+	if (!valid)
+		return true;
 
 	Transform scale(Basis().scaled(p_scale));
 
-	const Triangle *triangleptr = trianglesr.ptr();
-	const Vector3 *vertexptr = verticesr.ptr();
-	int pos = bvh.size() - 1;
-	const BVH *bvhptr = bvhr.ptr();
+	const BVH *nodes = bvh.ptr();
+	const Vector3 *leaf[3] = { leaf_vertices[0].ptr(), leaf_vertices[1].ptr(), leaf_vertices[2].ptr() };
 
-	stack[0] = pos;
-	while (true) {
+	int stack[TRIANGLE_MESH_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
 
-		uint32_t node = stack[level] & NODE_IDX_MASK;
-		const BVH &b = bvhptr[node];
-		bool done = false;
+	while (stack_size) {
 
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
+		const BVH &node = nodes[stack[--stack_size]];
 
-				bool intersects = scale.xform(b.aabb).intersects_convex_shape(p_planes, p_plane_count);
-				if (!intersects) return false;
+		for (int c = 0; c < 4; c++) {
 
-				bool inside = scale.xform(b.aabb).inside_convex_shape(p_planes, p_plane_count);
-				if (inside) {
-
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-				} else {
-
-					if (b.face_index >= 0) {
-						const Triangle &s = triangleptr[b.face_index];
-						for (int j = 0; j < 3; ++j) {
-							Vector3 point = scale.xform(vertexptr[s.indices[j]]);
-							for (int i = 0; i < p_plane_count; i++) {
-								const Plane &p = p_planes[i];
-								if (p.is_point_over(point)) return false;
-							}
-						}
+			if (node.child[c] < 0)
+				continue;
 
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+			AABB aabb = scale.xform(_get_child_aabb(node, c));
 
-					} else {
+			if (!aabb.intersects_convex_shape(p_planes, p_plane_count))
+				return false;
 
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
-					}
-				}
+			if (aabb.inside_convex_shape(p_planes, p_plane_count))
 				continue;
-			}
-			case VISIT_LEFT_BIT: {
 
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
+			if (node.face_count[c] == 0) {
+				stack[stack_size++] = node.child[c];
 				continue;
 			}
-			case VISIT_RIGHT_BIT: {
 
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
+			int from = node.child[c];
+			int end = from + node.face_count[c];
 
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
+			for (int f = from; f < end; f++) {
+				for (int j = 0; j < 3; ++j) {
+					Vector3 point = scale.xform(leaf[j][f]);
+					for (int i = 0; i < p_plane_count; i++) {
+						const Plane &p = p_planes[i];
+						if (p.is_point_over(point)) return false;
+					}
+				}
 			}
 		}
-
-		if (done)
-			break;
 	}
 
 	return true;
@@ -758,5 +732,4 @@ PoolVector<Face3> TriangleMesh::get_faces() const {
 TriangleMesh::TriangleMesh() {
 
 	valid = false;
-	max_depth = 0;
 }
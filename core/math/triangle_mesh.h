@@ -47,49 +47,67 @@ class TriangleMesh : public Reference {
 	PoolVector<Triangle> triangles;
 	PoolVector<Vector3> vertices;
 
+	// 4-wide tree, child bounds are stored per axis so a node tests all its children at once
 	struct BVH {
 
+		real_t min_x[4];
+		real_t min_y[4];
+		real_t min_z[4];
+		real_t max_x[4];
+		real_t max_y[4];
+		real_t max_z[4];
+
+		int child[4]; // node index, or first leaf triangle if face_count > 0, -1 if unused
+		int face_count[4];
+	};
+
+	struct BVHElement {
+
 		AABB aabb;
 		Vector3 center; //used for sorting
-		int left;
-		int right;
-
 		int face_index;
 	};
 
 	struct BVHCmpX {
 
-		bool operator()(const BVH *p_left, const BVH *p_right) const {
+		bool operator()(const BVHElement &p_left, const BVHElement &p_right) const {
 
-			return p_left->center.x < p_right->center.x;
+			return p_left.center.x < p_right.center.x;
 		}
 	};
 
 	struct BVHCmpY {
 
-		bool operator()(const BVH *p_left, const BVH *p_right) const {
+		bool operator()(const BVHElement &p_left, const BVHElement &p_right) const {
 
-			return p_left->center.y < p_right->center.y;
+			return p_left.center.y < p_right.center.y;
 		}
 	};
 	struct BVHCmpZ {
 
-		bool operator()(const BVH *p_left, const BVH *p_right) const {
+		bool operator()(const BVHElement &p_left, const BVHElement &p_right) const {
 
-			return p_left->center.z < p_right->center.z;
+			return p_left.center.z < p_right.center.z;
 		}
 	};
 
-	int _create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int p_depth, int &max_depth, int &max_alloc);
+	static AABB _get_elements_aabb(const BVHElement *p_elements, int p_size);
+	static void _split_elements(BVHElement *p_elements, int p_size);
+	static _FORCE_INLINE_ AABB _get_child_aabb(const BVH &p_node, int p_child);
+	int _create_bvh(BVHElement *p_elements, int p_size, int p_offset);
+	_FORCE_INLINE_ int _intersect_children(const BVH &p_node, const Vector3 &p_from, const Vector3 &p_inv_dir, real_t p_max_t, real_t *r_t_enter) const;
+	bool _intersect(const Vector3 &p_from, const Vector3 &p_dir, bool p_segment, Vector3 &r_point, Vector3 &r_normal) const;
 
-	PoolVector<BVH> bvh;
-	int max_depth;
+	Vector<BVH> bvh;
+	Vector<Vector3> leaf_vertices[3]; // triangle vertices in leaf order, so leaves don't go through the index arrays
+	Vector<int> leaf_triangles; // source triangle of every leaf slot
 	bool valid;
 
 public:
 	bool is_valid() const;
 	bool intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const;
 	bool intersect_ray(const Vector3 &p_begin, const Vector3 &p_dir, Vector3 &r_point, Vector3 &r_normal) const;
+	void intersect_rays(const Vector3 *p_begins, const Vector3 *p_dirs, int p_count, bool *r_hits, Vector3 *r_points, Vector3 *r_normals) const;
 	bool intersect_convex_shape(const Plane *p_planes, int p_plane_count) const;
 	bool inside_convex_shape(const Plane *p_planes, int p_plane_count, Vector3 p_scale = Vector3(1, 1, 1)) const;
 	Vector3 get_area_normal(const AABB &p_aabb) const;
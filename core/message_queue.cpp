@@ -30,32 +30,85 @@
 
 #include "message_queue.h"
 
+#include "core/os/timeline_profiler.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
 
 MessageQueue *MessageQueue::singleton = NULL;
 
+thread_local MessageQueue::ThreadData MessageQueue::thread_data = { 0, NULL };
+SafeNumeric<uint64_t> MessageQueue::last_serial;
+
+MessageQueue::ThreadData::~ThreadData() {
+
+	//the queue belongs to the message queue that created it, which may be gone already
+	if (queue && singleton && singleton->serial == serial) {
+		queue->orphaned.set();
+	}
+}
+
 MessageQueue *MessageQueue::get_singleton() {
 
 	return singleton;
 }
 
-Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+MessageQueue::Segment *MessageQueue::_alloc_segment(uint32_t p_min_size) {
+
+	uint32_t size = MAX(segment_size, p_min_size);
+	Segment *segment = (Segment *)memalloc(_segment_header_size() + size);
+	segment->next.set(NULL);
+	segment->write_pos.set(0);
+	segment->read_pos = 0;
+	segment->size = size;
+	return segment;
+}
+
+MessageQueue::ThreadQueue *MessageQueue::_get_thread_queue() {
+
+	if (likely(thread_data.queue && thread_data.serial == serial)) {
+		return thread_data.queue;
+	}
+
+	ThreadQueue *queue = memnew(ThreadQueue);
+	queue->head = _alloc_segment(0);
+	queue->tail = queue->head;
+	queue->orphaned.clear();
+
+	do {
+		queue->next = queues.get();
+	} while (!queues.compare_exchange(queue->next, queue));
+
+	thread_data.serial = serial;
+	thread_data.queue = queue;
+	return queue;
+}
 
-	_THREAD_SAFE_METHOD_
+MessageQueue::Message *MessageQueue::_alloc_message(uint32_t p_size, Segment *&r_segment, uint32_t &r_end) {
 
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+	ThreadQueue *queue = _get_thread_queue();
 
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_class();
-		print_line("Failed method: " + type + ":" + p_method + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
+	Segment *segment = queue->tail;
+	uint32_t pos = segment->write_pos.get();
+
+	if (pos + p_size > segment->size) {
+		//full, chain a new segment, the consumer frees this one once drained
+		Segment *next = _alloc_segment(p_size);
+		segment->next.set(next);
+		queue->tail = next;
+		segment = next;
+		pos = 0;
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	r_segment = segment;
+	r_end = pos + p_size;
+	return memnew_placement(_segment_data(segment) + pos, Message);
+}
+
+Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+
+	Segment *segment;
+	uint32_t end;
+	Message *msg = _alloc_message(sizeof(Message) + sizeof(Variant) * p_argcount, segment, end);
 	msg->args = p_argcount;
 	msg->instance_id = p_id;
 	msg->target = p_method;
@@ -63,15 +116,14 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const V
 	if (p_show_error)
 		msg->type |= FLAG_SHOW_ERROR;
 
-	buffer_end += sizeof(Message);
-
+	Variant *args = (Variant *)(msg + 1);
 	for (int i = 0; i < p_argcount; i++) {
 
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
+		memnew_placement(&args[i], Variant(*p_args[i]));
 	}
 
+	_commit_message(msg, segment, end);
+
 	return OK;
 }
 
@@ -92,56 +144,35 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, VARIANT
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
 
-	_THREAD_SAFE_METHOD_
-
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
-
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_class();
-		print_line("Failed set: " + type + ":" + p_prop + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
-	}
-
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Segment *segment;
+	uint32_t end;
+	Message *msg = _alloc_message(sizeof(Message) + sizeof(Variant), segment, end);
 	msg->args = 1;
 	msg->instance_id = p_id;
 	msg->target = p_prop;
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
+	memnew_placement((Variant *)(msg + 1), Variant(p_value));
 
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
-	*v = p_value;
+	_commit_message(msg, segment, end);
 
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
 
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
-
-	if ((buffer_end + room_needed) >= buffer_size) {
-		print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
-	}
-
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Segment *segment;
+	uint32_t end;
+	Message *msg = _alloc_message(sizeof(Message), segment, end);
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->instance_id = p_id;
 	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
+	_commit_message(msg, segment, end);
 
 	return OK;
 }
@@ -160,62 +191,105 @@ Error MessageQueue::push_set(Object *p_object, const StringName &p_prop, const V
 	return push_set(p_object->get_instance_id(), p_prop, p_value);
 }
 
+MessageQueue::Message *MessageQueue::_peek(ThreadQueue *p_queue) {
+
+	Segment *segment = p_queue->head;
+
+	while (true) {
+		//load next before write_pos, once next is set write_pos is final
+		Segment *next = segment->next.get();
+		uint32_t end = segment->write_pos.get();
+
+		if (segment->read_pos < end) {
+			return (Message *)(_segment_data(segment) + segment->read_pos);
+		}
+
+		if (!next) {
+			return NULL;
+		}
+
+		p_queue->head = next;
+		memfree(segment);
+		segment = next;
+	}
+}
+
+void MessageQueue::_destroy_message(Message *p_message) {
+
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int i = 0; i < p_message->args; i++) {
+			args[i].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
 void MessageQueue::statistics() {
 
 	Map<StringName, int> set_count;
 	Map<int, int> notify_count;
 	Map<StringName, int> call_count;
 	int null_count = 0;
+	uint64_t total_bytes = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
+	for (ThreadQueue *queue = queues.get(); queue; queue = queue->next) {
 
-		Object *target = ObjectDB::get_instance(message->instance_id);
+		for (Segment *segment = queue->head; segment; segment = segment->next.get()) {
 
-		if (target != NULL) {
+			uint32_t read_pos = segment->read_pos;
+			uint32_t end = segment->write_pos.get();
+			total_bytes += end - read_pos;
 
-			switch (message->type & FLAG_MASK) {
+			while (read_pos < end) {
+				Message *message = (Message *)(_segment_data(segment) + read_pos);
 
-				case TYPE_CALL: {
+				Object *target = ObjectDB::get_instance(message->instance_id);
 
-					if (!call_count.has(message->target))
-						call_count[message->target] = 0;
+				if (target != NULL) {
 
-					call_count[message->target]++;
+					switch (message->type & FLAG_MASK) {
 
-				} break;
-				case TYPE_NOTIFICATION: {
+						case TYPE_CALL: {
 
-					if (!notify_count.has(message->notification))
-						notify_count[message->notification] = 0;
+							if (!call_count.has(message->target))
+								call_count[message->target] = 0;
 
-					notify_count[message->notification]++;
+							call_count[message->target]++;
 
-				} break;
-				case TYPE_SET: {
+						} break;
+						case TYPE_NOTIFICATION: {
 
-					if (!set_count.has(message->target))
-						set_count[message->target] = 0;
+							if (!notify_count.has(message->notification))
+								notify_count[message->notification] = 0;
 
-					set_count[message->target]++;
+							notify_count[message->notification]++;
 
-				} break;
-			}
+						} break;
+						case TYPE_SET: {
 
-		} else {
-			//object was deleted
-			print_line("Object was deleted while awaiting a callback");
+							if (!set_count.has(message->target))
+								set_count[message->target] = 0;
 
-			null_count++;
-		}
+							set_count[message->target]++;
+
+						} break;
+					}
+
+				} else {
+					//object was deleted
+					print_line("Object was deleted while awaiting a callback");
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+					null_count++;
+				}
+
+				read_pos += _message_size(message);
+			}
+		}
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	print_line("TOTAL BYTES: " + itos(total_bytes));
 	print_line("NULL count: " + itos(null_count));
 
 	for (Map<StringName, int>::Element *E = set_count.front(); E; E = E->next()) {
@@ -256,32 +330,39 @@ void MessageQueue::_call_function(Object *p_target, const StringName &p_func, co
 
 void MessageQueue::flush() {
 
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
-	}
-
-	uint32_t read_pos = 0;
-
-	//using reverse locking strategy
-	_THREAD_SAFE_LOCK_
-
 	ERR_FAIL_COND(flushing); //already flushing, you did something odd
 	flushing = true;
 
-	while (read_pos < buffer_end) {
+	TIMELINE_SCOPE("MessageQueue::flush");
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+	//messages other threads push while flushing wait for the next flush, so a busy producer
+	//can't keep this one from returning. the flushing thread's own ones still run now, as before
+	uint64_t order_limit = next_order.get();
+	uint32_t flushed = 0;
 
-		Message *message = (Message *)&buffer[read_pos];
+	while (true) {
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			advance += sizeof(Variant) * message->args;
+		ThreadQueue *own_queue = thread_data.serial == serial ? thread_data.queue : NULL;
 
-		//pre-advance so this function is reentrant
-		read_pos += advance;
+		//pick the oldest message among all threads
+		ThreadQueue *queue = NULL;
+		Message *message = NULL;
+		for (ThreadQueue *E = queues.get(); E; E = E->next) {
+			Message *m = _peek(E);
+			if (m && (m->order < order_limit || E == own_queue) && (!message || m->order < message->order)) {
+				queue = E;
+				message = m;
+			}
+		}
 
-		_THREAD_SAFE_UNLOCK_
+		if (!message) {
+			break;
+		}
+
+		//pre-advance so this function is reentrant
+		uint32_t size = _message_size(message);
+		queue->head->read_pos += size;
+		flushed += size;
 
 		Object *target = ObjectDB::get_instance(message->instance_id);
 
@@ -313,21 +394,27 @@ void MessageQueue::flush() {
 			}
 		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int i = 0; i < message->args; i++) {
-				args[i].~Variant();
-			}
-		}
+		_destroy_message(message);
+	}
 
-		message->~Message();
+	if (flushed > buffer_max_used) {
+		buffer_max_used = flushed;
+	}
 
-		_THREAD_SAFE_LOCK_
+	//release the queues of threads that exited, the list head is left alone as producers may be pushing in front of it
+	ThreadQueue *prev = queues.get();
+	while (prev && prev->next) {
+		ThreadQueue *queue = prev->next;
+		if (queue->orphaned.is_set() && !_peek(queue)) {
+			prev->next = queue->next;
+			memfree(queue->head);
+			memdelete(queue);
+		} else {
+			prev = queue;
+		}
 	}
 
-	buffer_end = 0; // reset buffer
 	flushing = false;
-	_THREAD_SAFE_UNLOCK_
 }
 
 bool MessageQueue::is_flushing() const {
@@ -341,34 +428,32 @@ MessageQueue::MessageQueue() {
 	singleton = this;
 	flushing = false;
 
-	buffer_end = 0;
+	serial = last_serial.increment();
+	queues.set(NULL);
+	next_order.set(0);
 	buffer_max_used = 0;
-	buffer_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
-	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "0,2048,1,or_greater"));
-	buffer_size *= 1024;
-	buffer = memnew_arr(uint8_t, buffer_size);
+	segment_size = GLOBAL_DEF_RST("memory/limits/message_queue/segment_size_kb", DEFAULT_SEGMENT_SIZE_KB);
+	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/segment_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/segment_size_kb", PROPERTY_HINT_RANGE, "4,2048,1,or_greater"));
+	segment_size = MAX(segment_size, 4u) * 1024;
 }
 
 MessageQueue::~MessageQueue() {
 
-	uint32_t read_pos = 0;
+	ThreadQueue *queue = queues.get();
 
-	while (read_pos < buffer_end) {
+	while (queue) {
 
-		Message *message = (Message *)&buffer[read_pos];
-		Variant *args = (Variant *)(message + 1);
-		int argc = message->args;
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			for (int i = 0; i < argc; i++)
-				args[i].~Variant();
+		Message *message;
+		while ((message = _peek(queue))) {
+			queue->head->read_pos += _message_size(message);
+			_destroy_message(message);
 		}
-		message->~Message();
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+		ThreadQueue *next = queue->next;
+		memfree(queue->head);
+		memdelete(queue);
+		queue = next;
 	}
 
 	singleton = NULL;
-	memdelete_arr(buffer);
 }
@@ -32,15 +32,22 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object.h"
-#include "core/os/thread_safe.h"
+#include "core/safe_refcount.h"
 
-class MessageQueue {
+/**
+ * Deferred calls, notifications and sets, drained by flush() on the main thread.
+ *
+ * Every thread that pushes gets its own chain of buffer segments, so producers
+ * never lock or contend with each other and the queue grows instead of running
+ * out of space. Messages carry a global sequence number and flush() replays
+ * them across all threads in push order.
+ */
 
-	_THREAD_SAFE_CLASS_
+class MessageQueue {
 
 	enum {
 
-		DEFAULT_QUEUE_SIZE_KB = 1024
+		DEFAULT_SEGMENT_SIZE_KB = 64
 	};
 
 	enum {
@@ -56,6 +63,7 @@ class MessageQueue {
 
 		ObjectID instance_id;
 		StringName target;
+		uint64_t order;
 		int16_t type;
 		union {
 			int16_t notification;
@@ -63,10 +71,52 @@ class MessageQueue {
 		};
 	};
 
-	uint8_t *buffer;
-	uint32_t buffer_end;
+	struct Segment {
+
+		SafePointer<Segment> next; //published by the producer once it moved on to this one
+		SafeNumeric<uint32_t> write_pos;
+		uint32_t read_pos; //only touched by the consumer
+		uint32_t size;
+	};
+
+	struct ThreadQueue {
+
+		Segment *head; //oldest segment, consumer side
+		Segment *tail; //segment being written, producer side
+		ThreadQueue *next;
+		SafeFlag orphaned; //producer thread exited
+	};
+
+	struct ThreadData {
+
+		uint64_t serial;
+		ThreadQueue *queue;
+
+		~ThreadData();
+	};
+
+	static thread_local ThreadData thread_data;
+	static SafeNumeric<uint64_t> last_serial;
+
+	uint64_t serial;
+	SafePointer<ThreadQueue> queues; //producers only ever push at the front
+	SafeNumeric<uint64_t> next_order;
+	uint32_t segment_size;
 	uint32_t buffer_max_used;
-	uint32_t buffer_size;
+
+	_FORCE_INLINE_ static uint32_t _segment_header_size() { return (sizeof(Segment) + 15) & ~15; }
+	_FORCE_INLINE_ static uint8_t *_segment_data(Segment *p_segment) { return ((uint8_t *)p_segment) + _segment_header_size(); }
+	_FORCE_INLINE_ static uint32_t _message_size(const Message *p_message) { return sizeof(Message) + ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION ? sizeof(Variant) * p_message->args : 0); }
+
+	Segment *_alloc_segment(uint32_t p_min_size);
+	ThreadQueue *_get_thread_queue();
+	Message *_alloc_message(uint32_t p_size, Segment *&r_segment, uint32_t &r_end);
+	_FORCE_INLINE_ void _commit_message(Message *p_message, Segment *p_segment, uint32_t p_end) {
+		p_message->order = next_order.increment() - 1;
+		p_segment->write_pos.set(p_end);
+	}
+	Message *_peek(ThreadQueue *p_queue);
+	void _destroy_message(Message *p_message);
 
 	void _call_function(Object *p_target, const StringName &p_func, const Variant *p_args, int p_argcount, bool p_show_error);
 
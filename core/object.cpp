@@ -403,6 +403,16 @@ void Object::_get_valid_parents_static(List<String> *p_parents) {
 
 void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid) {
 
+	_set_internal(p_name, p_value, r_valid, NULL);
+}
+
+void Object::set_cached(MethodCallCache &r_cache, const StringName &p_name, const Variant &p_value, bool *r_valid) {
+
+	_set_internal(p_name, p_value, r_valid, &r_cache);
+}
+
+void Object::_set_internal(const StringName &p_name, const Variant &p_value, bool *r_valid, MethodCallCache *r_cache) {
+
 #ifdef TOOLS_ENABLED
 
 	_edited = true;
@@ -419,7 +429,7 @@ void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid
 
 	//try built-in setgetter
 	{
-		if (ClassDB::set_property(this, p_name, p_value, r_valid)) {
+		if (r_cache ? ClassDB::set_property_cached(*r_cache, this, p_name, p_value, r_valid) : ClassDB::set_property(this, p_name, p_value, r_valid)) {
 			/*
 			if (r_valid)
 				*r_valid=true;
@@ -478,6 +488,16 @@ void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid
 
 Variant Object::get(const StringName &p_name, bool *r_valid) const {
 
+	return _get_internal(p_name, r_valid, NULL);
+}
+
+Variant Object::get_cached(MethodCallCache &r_cache, const StringName &p_name, bool *r_valid) const {
+
+	return _get_internal(p_name, r_valid, &r_cache);
+}
+
+Variant Object::_get_internal(const StringName &p_name, bool *r_valid, MethodCallCache *r_cache) const {
+
 	Variant ret;
 
 	if (script_instance) {
@@ -491,7 +511,7 @@ Variant Object::get(const StringName &p_name, bool *r_valid) const {
 
 	//try built-in setgetter
 	{
-		if (ClassDB::get_property(const_cast<Object *>(this), p_name, ret)) {
+		if (r_cache ? ClassDB::get_property_cached(*r_cache, const_cast<Object *>(this), p_name, ret) : ClassDB::get_property(const_cast<Object *>(this), p_name, ret)) {
 			if (r_valid)
 				*r_valid = true;
 			return ret;
@@ -926,6 +946,22 @@ Variant Object::call(const StringName &p_method, const Variant **p_args, int p_a
 	return ret;
 }
 
+Variant Object::call_cached(MethodCallCache &r_cache, const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+
+	if (script_instance || _has_custom_call()) {
+		return call(p_method, p_args, p_argcount, r_error);
+	}
+
+	MethodBind *method = ClassDB::get_method_cached(r_cache, get_class_name(), p_method);
+	if (!method) {
+		return call(p_method, p_args, p_argcount, r_error); //free() and errors
+	}
+
+	OBJ_DEBUG_LOCK
+	r_error.error = Variant::CallError::CALL_OK;
+	return method->call(this, p_args, p_argcount, r_error);
+}
+
 void Object::notification(int p_notification, bool p_reversed) {
 
 	_notificationv(p_notification, p_reversed);
@@ -1150,6 +1186,52 @@ Variant Object::_emit_signal(const Variant **p_args, int p_argcount, Variant::Ca
 	return Variant();
 }
 
+bool Object::_try_signal_ptrcall(Object *p_target, MethodBind *p_method, const Variant **p_args, int p_argcount) {
+
+#if defined(PTRCALL_ENABLED) && defined(DEBUG_METHODS_ENABLED)
+	//only for the simple signatures callbacks mostly have, anything else goes through MethodBind::call
+	if (p_method->has_return() || p_method->is_vararg() || p_method->get_argument_count() != p_argcount) {
+		return false;
+	}
+
+	union PtrArg {
+		bool b;
+		int64_t i;
+		double r;
+	};
+
+	PtrArg *values = (PtrArg *)alloca(sizeof(PtrArg) * MAX(p_argcount, 1));
+	const void **ptrargs = (const void **)alloca(sizeof(void *) * MAX(p_argcount, 1));
+
+	for (int i = 0; i < p_argcount; i++) {
+
+		Variant::Type type = p_method->get_argument_type(i);
+		if (type == Variant::NIL) {
+			ptrargs[i] = p_args[i]; //takes a Variant
+			continue;
+		}
+		if (p_args[i]->get_type() != type) {
+			return false;
+		}
+		switch (type) {
+			case Variant::BOOL: values[i].b = *p_args[i]; break;
+#ifndef BIG_ENDIAN_ENABLED
+			//enum arguments read the low 32 bits
+			case Variant::INT: values[i].i = *p_args[i]; break;
+#endif
+			case Variant::REAL: values[i].r = *p_args[i]; break;
+			default: return false;
+		}
+		ptrargs[i] = &values[i];
+	}
+
+	p_method->ptrcall(p_target, ptrargs, NULL);
+	return true;
+#else
+	return false;
+#endif
+}
+
 Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int p_argcount) {
 
 	if (_block_signals)
@@ -1177,13 +1259,26 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
 	OBJ_DEBUG_LOCK
 
-	Vector<const Variant *> bind_mem;
-
 	Error err = OK;
 
+	//one argument buffer for every slot with binds, alloca inside the loop would grow the stack per slot
+	int max_binds = 0;
 	for (int i = 0; i < ssize; i++) {
+		max_binds = MAX(max_binds, slot_map.getv(i).conn.binds.size());
+	}
 
-		const Connection &c = slot_map.getv(i).conn;
+	const Variant **bind_args = NULL;
+	if (max_binds > 0) {
+		bind_args = (const Variant **)alloca(sizeof(Variant *) * (p_argcount + max_binds));
+		for (int j = 0; j < p_argcount; j++) {
+			bind_args[j] = p_args[j];
+		}
+	}
+
+	for (int i = 0; i < ssize; i++) {
+
+		const Signal::Slot &slot = slot_map.getv(i);
+		const Connection &c = slot.conn;
 
 		Object *target = ObjectDB::get_instance(slot_map.getk(i)._id);
 		if (!target) {
@@ -1196,17 +1291,12 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
 		if (c.binds.size()) {
 			//handle binds
-			bind_mem.resize(p_argcount + c.binds.size());
+			argc = p_argcount + c.binds.size();
+			args = bind_args;
 
-			for (int j = 0; j < p_argcount; j++) {
-				bind_mem.write[j] = p_args[j];
-			}
 			for (int j = 0; j < c.binds.size(); j++) {
-				bind_mem.write[p_argcount + j] = &c.binds[j];
+				args[p_argcount + j] = &c.binds[j];
 			}
-
-			args = (const Variant **)bind_mem.ptr();
-			argc = bind_mem.size();
 		}
 
 		if (c.flags & CONNECT_DEFERRED) {
@@ -1214,7 +1304,17 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 		} else {
 			Variant::CallError ce;
 			_emitting = true;
-			target->call(c.method, args, argc, ce);
+			if (slot.method_bind && !target->script_instance && !target->_has_custom_call()) {
+				//neither a script nor a custom call() can override the method, skip the lookup by name
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock target_lock(target);
+#endif
+				if (!_try_signal_ptrcall(target, slot.method_bind, args, argc)) {
+					slot.method_bind->call(target, args, argc, ce);
+				}
+			} else {
+				target->call(c.method, args, argc, ce);
+			}
 			_emitting = false;
 
 			if (ce.error != Variant::CallError::CALL_OK) {
@@ -1476,6 +1576,7 @@ Error Object::connect(const StringName &p_signal, Object *p_to_object, const Str
 	conn.binds = p_binds;
 	slot.conn = conn;
 	slot.cE = p_to_object->connections.push_back(conn);
+	slot.method_bind = ClassDB::get_method(p_to_object->get_class_name(), p_to_method);
 	if (p_flags & CONNECT_REFERENCE_COUNTED) {
 		slot.reference_count = 1;
 	}
@@ -31,10 +31,12 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 
+#include "core/flat_hash_map.h"
 #include "core/hash_map.h"
 #include "core/list.h"
 #include "core/map.h"
 #include "core/os/rw_lock.h"
+#include "core/safe_refcount.h"
 #include "core/set.h"
 #include "core/variant.h"
 #include "core/vmap.h"
@@ -396,7 +398,14 @@ public:                                                        \
                                                                \
 private:
 
+// call site cache for Object::call_cached(), Object::get_cached()/set_cached() and the ClassDB *_cached() lookups, may be shared between threads
+struct MethodCallCache {
+
+	SafePointer<const void> entry;
+};
+
 class ScriptInstance;
+class MethodBind;
 typedef uint64_t ObjectID;
 
 class Object {
@@ -460,7 +469,11 @@ private:
 			int reference_count;
 			Connection conn;
 			List<Connection>::Element *cE;
-			Slot() { reference_count = 0; }
+			MethodBind *method_bind; //native method resolved on connect, used while the target has no script
+			Slot() {
+				reference_count = 0;
+				method_bind = NULL;
+			}
 		};
 
 		MethodInfo user;
@@ -468,7 +481,7 @@ private:
 		Signal() {}
 	};
 
-	HashMap<StringName, Signal> signal_map;
+	FlatHashMap<StringName, Signal> signal_map;
 	List<Connection> connections;
 #ifdef DEBUG_ENABLED
 	SafeRefCount _lock_index;
@@ -478,6 +491,7 @@ private:
 	Set<Object *> change_receptors;
 	ObjectID _instance_id;
 	bool _predelete();
+	static bool _try_signal_ptrcall(Object *p_target, MethodBind *p_method, const Variant **p_args, int p_argcount);
 	void _postinitialize();
 	bool _can_translate;
 	bool _emitting;
@@ -563,6 +577,9 @@ protected:
 
 	void _clear_internal_resource_paths(const Variant &p_var);
 
+	void _set_internal(const StringName &p_name, const Variant &p_value, bool *r_valid, MethodCallCache *r_cache);
+	Variant _get_internal(const StringName &p_name, bool *r_valid, MethodCallCache *r_cache) const;
+
 	friend class ClassDB;
 	virtual void _validate_property(PropertyInfo &property) const;
 
@@ -656,6 +673,8 @@ public:
 
 	void set(const StringName &p_name, const Variant &p_value, bool *r_valid = NULL);
 	Variant get(const StringName &p_name, bool *r_valid = NULL) const;
+	void set_cached(MethodCallCache &r_cache, const StringName &p_name, const Variant &p_value, bool *r_valid = NULL);
+	Variant get_cached(MethodCallCache &r_cache, const StringName &p_name, bool *r_valid = NULL) const;
 	void set_indexed(const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid = NULL);
 	Variant get_indexed(const Vector<StringName> &p_names, bool *r_valid = NULL) const;
 
@@ -665,6 +684,9 @@ public:
 	void get_method_list(List<MethodInfo> *p_list) const;
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	// same as call(), resolving the method bind through a cache kept by the call site
+	Variant call_cached(MethodCallCache &r_cache, const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	virtual bool _has_custom_call() const { return false; } //classes overriding call() must return true
 	virtual void call_multilevel(const StringName &p_method, const Variant **p_args, int p_argcount);
 	virtual void call_multilevel_reversed(const StringName &p_method, const Variant **p_args, int p_argcount);
 	Variant call(const StringName &p_name, VARIANT_ARG_LIST); // C++ helper
@@ -118,6 +118,14 @@ public:
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
 	virtual String get_as_utf8_string() const;
 
+	/**< zero-copy access for loaders that can consume a raw buffer.
+	 * returns the whole file contents (get_len() bytes) when the file is backed by memory
+	 * (a mapped pack or a memory file), NULL otherwise. valid until the file is closed.
+	 */
+	virtual const uint8_t *get_mapped_data() const { return NULL; }
+
+	virtual const uint8_t *map_read_only() { return NULL; } ///< map the whole file read only (READ mode only), valid until the file is closed; NULL when unsupported
+
 	/**< use this for files WRITTEN in _big_ endian machines (ie, amiga/mac)
 	 * It's not about the current CPU type but file formats.
 	 * this flags get reset to false (little endian) on each open
@@ -136,6 +136,7 @@ public:
 	virtual void accumulate_input_event(const Ref<InputEvent> &p_event) = 0;
 	virtual void flush_accumulated_events() = 0;
 	virtual void set_use_accumulated_input(bool p_enable) = 0;
+	virtual void set_use_accumulated_input_history(bool p_enable) = 0;
 
 	Input();
 };
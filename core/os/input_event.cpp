@@ -597,6 +597,33 @@ Vector2 InputEventMouseMotion::get_speed() const {
 	return speed;
 }
 
+static PoolVector2Array _xform_accumulated_positions(const PoolVector2Array &p_positions, const Transform2D &p_xform, const Vector2 &p_local_ofs) {
+
+	PoolVector2Array positions;
+	positions.resize(p_positions.size());
+	PoolVector2Array::Read r = p_positions.read();
+	PoolVector2Array::Write w = positions.write();
+	for (int i = 0; i < p_positions.size(); i++) {
+		w[i] = p_xform.xform(r[i] + p_local_ofs);
+	}
+	return positions;
+}
+
+void InputEventMouseMotion::set_accumulated_positions(const PoolVector2Array &p_positions) {
+
+	accumulated_positions = p_positions;
+}
+
+PoolVector2Array InputEventMouseMotion::get_accumulated_positions() const {
+
+	return accumulated_positions;
+}
+
+void InputEventMouseMotion::append_accumulated_position(const Vector2 &p_pos) {
+
+	accumulated_positions.push_back(p_pos);
+}
+
 Ref<InputEvent> InputEventMouseMotion::xformed_by(const Transform2D &p_xform, const Vector2 &p_local_ofs) const {
 
 	Vector2 g = get_global_position();
@@ -620,6 +647,10 @@ Ref<InputEvent> InputEventMouseMotion::xformed_by(const Transform2D &p_xform, co
 	mm->set_relative(r);
 	mm->set_speed(s);
 
+	if (accumulated_positions.size()) {
+		mm->accumulated_positions = _xform_accumulated_positions(accumulated_positions, p_xform, p_local_ofs);
+	}
+
 	return mm;
 }
 
@@ -701,6 +732,9 @@ void InputEventMouseMotion::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_speed", "speed"), &InputEventMouseMotion::set_speed);
 	ClassDB::bind_method(D_METHOD("get_speed"), &InputEventMouseMotion::get_speed);
 
+	ClassDB::bind_method(D_METHOD("set_accumulated_positions", "positions"), &InputEventMouseMotion::set_accumulated_positions);
+	ClassDB::bind_method(D_METHOD("get_accumulated_positions"), &InputEventMouseMotion::get_accumulated_positions);
+
 	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "tilt"), "set_tilt", "get_tilt");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "pressure"), "set_pressure", "get_pressure");
 	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "relative"), "set_relative", "get_relative");
@@ -979,6 +1013,21 @@ Vector2 InputEventScreenDrag::get_speed() const {
 	return speed;
 }
 
+void InputEventScreenDrag::set_accumulated_positions(const PoolVector2Array &p_positions) {
+
+	accumulated_positions = p_positions;
+}
+
+PoolVector2Array InputEventScreenDrag::get_accumulated_positions() const {
+
+	return accumulated_positions;
+}
+
+void InputEventScreenDrag::append_accumulated_position(const Vector2 &p_pos) {
+
+	accumulated_positions.push_back(p_pos);
+}
+
 Ref<InputEvent> InputEventScreenDrag::xformed_by(const Transform2D &p_xform, const Vector2 &p_local_ofs) const {
 
 	Ref<InputEventScreenDrag> sd;
@@ -992,9 +1041,30 @@ Ref<InputEvent> InputEventScreenDrag::xformed_by(const Transform2D &p_xform, con
 	sd->set_relative(p_xform.basis_xform(relative));
 	sd->set_speed(p_xform.basis_xform(speed));
 
+	if (accumulated_positions.size()) {
+		sd->accumulated_positions = _xform_accumulated_positions(accumulated_positions, p_xform, p_local_ofs);
+	}
+
 	return sd;
 }
 
+bool InputEventScreenDrag::accumulate(const Ref<InputEvent> &p_event) {
+
+	Ref<InputEventScreenDrag> drag = p_event;
+	if (drag.is_null())
+		return false;
+
+	if (index != drag->index) {
+		return false;
+	}
+
+	pos = drag->pos;
+	speed = drag->speed;
+	relative += drag->relative;
+
+	return true;
+}
+
 String InputEventScreenDrag::as_text() const {
 
 	return "InputEventScreenDrag : index=" + itos(index) + ", position=(" + String(get_position()) + "), relative=(" + String(get_relative()) + "), speed=(" + String(get_speed()) + ")";
@@ -1014,6 +1084,9 @@ void InputEventScreenDrag::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_speed", "speed"), &InputEventScreenDrag::set_speed);
 	ClassDB::bind_method(D_METHOD("get_speed"), &InputEventScreenDrag::get_speed);
 
+	ClassDB::bind_method(D_METHOD("set_accumulated_positions", "positions"), &InputEventScreenDrag::set_accumulated_positions);
+	ClassDB::bind_method(D_METHOD("get_accumulated_positions"), &InputEventScreenDrag::get_accumulated_positions);
+
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "index"), "set_index", "get_index");
 	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "position"), "set_position", "get_position");
 	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "relative"), "set_relative", "get_relative");
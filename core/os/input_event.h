@@ -356,6 +356,7 @@ class InputEventMouseMotion : public InputEventMouse {
 	float pressure;
 	Vector2 relative;
 	Vector2 speed;
+	PoolVector2Array accumulated_positions;
 
 protected:
 	static void _bind_methods();
@@ -373,6 +374,10 @@ public:
 	void set_speed(const Vector2 &p_speed);
 	Vector2 get_speed() const;
 
+	void set_accumulated_positions(const PoolVector2Array &p_positions);
+	PoolVector2Array get_accumulated_positions() const;
+	void append_accumulated_position(const Vector2 &p_pos);
+
 	virtual Ref<InputEvent> xformed_by(const Transform2D &p_xform, const Vector2 &p_local_ofs = Vector2()) const;
 	virtual String as_text() const;
 
@@ -467,6 +472,7 @@ class InputEventScreenDrag : public InputEvent {
 	Vector2 pos;
 	Vector2 relative;
 	Vector2 speed;
+	PoolVector2Array accumulated_positions;
 
 protected:
 	static void _bind_methods();
@@ -484,9 +490,15 @@ public:
 	void set_speed(const Vector2 &p_speed);
 	Vector2 get_speed() const;
 
+	void set_accumulated_positions(const PoolVector2Array &p_positions);
+	PoolVector2Array get_accumulated_positions() const;
+	void append_accumulated_position(const Vector2 &p_pos);
+
 	virtual Ref<InputEvent> xformed_by(const Transform2D &p_xform, const Vector2 &p_local_ofs = Vector2()) const;
 	virtual String as_text() const;
 
+	virtual bool accumulate(const Ref<InputEvent> &p_event);
+
 	InputEventScreenDrag();
 };
 
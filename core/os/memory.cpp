@@ -34,6 +34,10 @@
 #include "core/os/copymem.h"
 #include "core/safe_refcount.h"
 
+#ifdef POOLED_ALLOCATOR_ENABLED
+#include "core/os/pooled_allocator.h"
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -71,6 +75,77 @@ uint64_t Memory::max_usage = 0;
 
 uint64_t Memory::alloc_count = 0;
 
+#ifdef POOLED_ALLOCATOR_ENABLED
+
+// Counted per thread and only published once in a while, so threads don't fight over
+// the shared counters on every call. The totals lag behind by a few allocations.
+#define STATS_FLUSH_COUNT 64
+#define STATS_FLUSH_BYTES (64 * 1024)
+
+static thread_local int64_t stats_count = 0;
+static thread_local int64_t stats_bytes = 0;
+
+void Memory::_update_stats(int64_t p_count, int64_t p_bytes) {
+
+	stats_count += p_count;
+	stats_bytes += p_bytes;
+
+	if (stats_count > -STATS_FLUSH_COUNT && stats_count < STATS_FLUSH_COUNT && stats_bytes > -STATS_FLUSH_BYTES && stats_bytes < STATS_FLUSH_BYTES) {
+		return;
+	}
+
+	atomic_add(&alloc_count, (uint64_t)stats_count);
+#ifdef DEBUG_ENABLED
+	atomic_add(&mem_usage, (uint64_t)stats_bytes);
+	atomic_exchange_if_greater(&max_usage, mem_usage);
+#endif
+	stats_count = 0;
+	stats_bytes = 0;
+}
+
+void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+
+	// always padded, the allocator needs the header anyway
+	void *mem = PooledAllocator::alloc(p_bytes);
+
+	ERR_FAIL_COND_V(!mem, NULL);
+
+	_update_stats(1, p_bytes);
+	return mem;
+}
+
+void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
+
+	if (p_memory == NULL) {
+		return alloc_static(p_bytes, p_pad_align);
+	}
+
+	if (p_bytes == 0) {
+		free_static(p_memory, p_pad_align);
+		return NULL;
+	}
+
+	int64_t old_bytes = PooledAllocator::get_size(p_memory);
+
+	void *mem = PooledAllocator::realloc(p_memory, p_bytes);
+
+	ERR_FAIL_COND_V(!mem, NULL);
+
+	_update_stats(0, (int64_t)p_bytes - old_bytes);
+	return mem;
+}
+
+void Memory::free_static(void *p_ptr, bool p_pad_align) {
+
+	ERR_FAIL_COND(p_ptr == NULL);
+
+	_update_stats(-1, -(int64_t)PooledAllocator::get_size(p_ptr));
+
+	PooledAllocator::free(p_ptr);
+}
+
+#else
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 
 #ifdef DEBUG_ENABLED
@@ -182,6 +257,8 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	}
 }
 
+#endif
+
 uint64_t Memory::get_mem_available() {
 
 	return -1; // 0xFFFF...
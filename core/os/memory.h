@@ -50,6 +50,10 @@ class Memory {
 
 	static uint64_t alloc_count;
 
+#ifdef POOLED_ALLOCATOR_ENABLED
+	static void _update_stats(int64_t p_count, int64_t p_bytes);
+#endif
+
 public:
 	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
 	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false);
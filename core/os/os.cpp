@@ -130,6 +130,12 @@ void OS::print(const char *p_format, ...) {
 	va_end(argp);
 };
 
+void OS::flush_logs() {
+	if (_logger) {
+		_logger->flush();
+	}
+}
+
 void OS::printerr(const char *p_format, ...) {
 	va_list argp;
 	va_start(argp, p_format);
@@ -0,0 +1,324 @@
+/*************************************************************************/
+/*  pooled_allocator.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifdef POOLED_ALLOCATOR_ENABLED
+
+#include "pooled_allocator.h"
+
+#include "core/os/memory.h"
+#include "core/safe_refcount.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// sizes include the header
+static const uint32_t size_classes[] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256, 320, 384, 448, 512,
+	640, 768, 896, 1024, 1280, 1536, 1792, 2048
+};
+
+#define SIZE_CLASS_COUNT (sizeof(size_classes) / sizeof(size_classes[0]))
+#define SIZE_CLASS_LARGE 0xFFFFFFFF
+#define SLAB_SIZE (64 * 1024)
+
+struct BlockHeader {
+	uint64_t size;
+	uint32_t size_class;
+};
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+// shared between threads, slabs are never given back to the system
+struct CentralList {
+	SafeFlag lock;
+	FreeBlock *head;
+};
+
+static CentralList central_lists[SIZE_CLASS_COUNT];
+
+struct ThreadCache {
+	FreeBlock *head[SIZE_CLASS_COUNT];
+	uint32_t count[SIZE_CLASS_COUNT];
+
+	~ThreadCache();
+};
+
+static thread_local ThreadCache thread_cache;
+static thread_local bool thread_cache_destroyed = false;
+
+static _FORCE_INLINE_ uint32_t _get_size_class(size_t p_total) {
+
+	if (p_total <= 128) {
+		return p_total == 0 ? 0 : (uint32_t)((p_total - 1) >> 4);
+	}
+
+	for (uint32_t i = 8; i < SIZE_CLASS_COUNT; i++) {
+		if (p_total <= size_classes[i]) {
+			return i;
+		}
+	}
+
+	return SIZE_CLASS_LARGE;
+}
+
+static _FORCE_INLINE_ uint32_t _get_batch_count(uint32_t p_size_class) {
+
+	uint32_t count = 8192 / size_classes[p_size_class];
+	return count < 4 ? 4 : (count > 64 ? 64 : count);
+}
+
+static _FORCE_INLINE_ BlockHeader *_get_header(const void *p_memory) {
+
+	return (BlockHeader *)((uint8_t *)p_memory - PAD_ALIGN);
+}
+
+static _FORCE_INLINE_ void _lock(CentralList &p_list) {
+
+	while (p_list.lock.test_and_set()) {
+	}
+}
+
+static _FORCE_INLINE_ void _unlock(CentralList &p_list) {
+
+	p_list.lock.clear();
+}
+
+// takes up to p_count blocks off the shared list, carving a new slab if it's empty
+static FreeBlock *_central_pop(uint32_t p_size_class, uint32_t p_count, uint32_t &r_taken) {
+
+	CentralList &list = central_lists[p_size_class];
+	_lock(list);
+
+	if (!list.head) {
+
+		uint8_t *slab = (uint8_t *)malloc(SLAB_SIZE);
+		if (!slab) {
+			_unlock(list);
+			r_taken = 0;
+			return NULL;
+		}
+
+		uint32_t block_size = size_classes[p_size_class];
+		uint32_t block_count = SLAB_SIZE / block_size;
+
+		for (uint32_t i = 0; i < block_count; i++) {
+			FreeBlock *block = (FreeBlock *)(slab + (block_count - 1 - i) * block_size);
+			block->next = list.head;
+			list.head = block;
+		}
+	}
+
+	FreeBlock *first = list.head;
+	FreeBlock *last = first;
+	uint32_t taken = 1;
+	while (taken < p_count && last->next) {
+		last = last->next;
+		taken++;
+	}
+
+	list.head = last->next;
+	last->next = NULL;
+
+	_unlock(list);
+
+	r_taken = taken;
+	return first;
+}
+
+static void _central_push(uint32_t p_size_class, FreeBlock *p_first, FreeBlock *p_last) {
+
+	CentralList &list = central_lists[p_size_class];
+	_lock(list);
+	p_last->next = list.head;
+	list.head = p_first;
+	_unlock(list);
+}
+
+ThreadCache::~ThreadCache() {
+
+	for (uint32_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+
+		if (!head[i]) {
+			continue;
+		}
+
+		FreeBlock *last = head[i];
+		while (last->next) {
+			last = last->next;
+		}
+
+		_central_push(i, head[i], last);
+		head[i] = NULL;
+		count[i] = 0;
+	}
+
+	// anything freed from now on, by other thread locals, goes straight to the shared lists
+	thread_cache_destroyed = true;
+}
+
+static void *_alloc_block(uint32_t p_size_class) {
+
+	if (unlikely(thread_cache_destroyed)) {
+		uint32_t taken;
+		return _central_pop(p_size_class, 1, taken);
+	}
+
+	ThreadCache &cache = thread_cache;
+
+	if (!cache.head[p_size_class]) {
+
+		uint32_t taken;
+		cache.head[p_size_class] = _central_pop(p_size_class, _get_batch_count(p_size_class), taken);
+		cache.count[p_size_class] = taken;
+
+		if (!cache.head[p_size_class]) {
+			return NULL;
+		}
+	}
+
+	FreeBlock *block = cache.head[p_size_class];
+	cache.head[p_size_class] = block->next;
+	cache.count[p_size_class]--;
+	return block;
+}
+
+static void _free_block(uint32_t p_size_class, void *p_block) {
+
+	FreeBlock *block = (FreeBlock *)p_block;
+
+	if (unlikely(thread_cache_destroyed)) {
+		_central_push(p_size_class, block, block);
+		return;
+	}
+
+	ThreadCache &cache = thread_cache;
+
+	block->next = cache.head[p_size_class];
+	cache.head[p_size_class] = block;
+	cache.count[p_size_class]++;
+
+	uint32_t batch = _get_batch_count(p_size_class);
+	if (cache.count[p_size_class] > batch * 2) {
+
+		// give a batch back, so memory freed by a thread other than the allocating one doesn't pile up here
+		FreeBlock *first = cache.head[p_size_class];
+		FreeBlock *last = first;
+		for (uint32_t i = 1; i < batch; i++) {
+			last = last->next;
+		}
+
+		cache.head[p_size_class] = last->next;
+		cache.count[p_size_class] -= batch;
+		_central_push(p_size_class, first, last);
+	}
+}
+
+void *PooledAllocator::alloc(size_t p_bytes) {
+
+	size_t total = p_bytes + PAD_ALIGN;
+	uint32_t size_class = _get_size_class(total);
+
+	uint8_t *mem;
+	if (size_class == SIZE_CLASS_LARGE) {
+		mem = (uint8_t *)::malloc(total);
+	} else {
+		mem = (uint8_t *)_alloc_block(size_class);
+	}
+
+	if (!mem) {
+		return NULL;
+	}
+
+	BlockHeader *header = (BlockHeader *)mem;
+	header->size = p_bytes;
+	header->size_class = size_class;
+
+	return mem + PAD_ALIGN;
+}
+
+void *PooledAllocator::realloc(void *p_memory, size_t p_bytes) {
+
+	if (p_memory == NULL) {
+		return alloc(p_bytes);
+	}
+
+	BlockHeader *header = _get_header(p_memory);
+	size_t total = p_bytes + PAD_ALIGN;
+
+	if (header->size_class == SIZE_CLASS_LARGE) {
+
+		if (_get_size_class(total) == SIZE_CLASS_LARGE) {
+
+			uint8_t *mem = (uint8_t *)::realloc(header, total);
+			if (!mem) {
+				return NULL;
+			}
+
+			((BlockHeader *)mem)->size = p_bytes;
+			return mem + PAD_ALIGN;
+		}
+	} else if (total <= size_classes[header->size_class]) {
+
+		// still fits
+		header->size = p_bytes;
+		return p_memory;
+	}
+
+	void *new_memory = alloc(p_bytes);
+	if (!new_memory) {
+		return NULL;
+	}
+
+	memcpy(new_memory, p_memory, header->size < p_bytes ? header->size : p_bytes);
+	free(p_memory);
+
+	return new_memory;
+}
+
+void PooledAllocator::free(void *p_memory) {
+
+	BlockHeader *header = _get_header(p_memory);
+
+	if (header->size_class == SIZE_CLASS_LARGE) {
+		::free(header);
+	} else {
+		_free_block(header->size_class, header);
+	}
+}
+
+size_t PooledAllocator::get_size(const void *p_memory) {
+
+	return _get_header(p_memory)->size;
+}
+
+#endif
@@ -34,6 +34,7 @@ Thread *(*Thread::create_func)(ThreadCreateCallback, void *, const Settings &) =
 Thread::ID (*Thread::get_thread_id_func)() = NULL;
 void (*Thread::wait_to_finish_func)(Thread *) = NULL;
 Error (*Thread::set_name_func)(const String &) = NULL;
+uint64_t (*Thread::get_performance_core_mask_func)() = NULL;
 
 Thread::ID Thread::_main_thread_id = 0;
 
@@ -67,6 +68,14 @@ Error Thread::set_name(const String &p_name) {
 	return ERR_UNAVAILABLE;
 };
 
+uint64_t Thread::get_performance_core_mask() {
+
+	if (get_performance_core_mask_func)
+		return get_performance_core_mask_func();
+
+	return 0;
+}
+
 Thread::Thread() {
 }
 
@@ -42,13 +42,21 @@ public:
 
 		PRIORITY_LOW,
 		PRIORITY_NORMAL,
-		PRIORITY_HIGH
+		PRIORITY_HIGH,
+		PRIORITY_REALTIME ///< Real-time scheduling where the platform allows it, otherwise the highest regular priority
 	};
 
 	struct Settings {
 
 		Priority priority;
-		Settings() { priority = PRIORITY_NORMAL; }
+		uint64_t affinity_mask; ///< Bit N allows running on core N, 0 means any core
+		size_t stack_size; ///< 0 uses the platform thread default of the engine
+		String name; ///< Set on the new thread before the callback runs, so profilers see it from the start
+		Settings() {
+			priority = PRIORITY_NORMAL;
+			affinity_mask = 0;
+			stack_size = 0;
+		}
 	};
 
 	typedef uint64_t ID;
@@ -58,6 +66,7 @@ protected:
 	static ID (*get_thread_id_func)();
 	static void (*wait_to_finish_func)(Thread *);
 	static Error (*set_name_func)(const String &);
+	static uint64_t (*get_performance_core_mask_func)();
 
 	friend class Main;
 
@@ -69,6 +78,7 @@ public:
 	virtual ID get_id() const = 0;
 
 	static Error set_name(const String &p_name);
+	static uint64_t get_performance_core_mask(); ///< Affinity mask of the fastest cores on heterogeneous (big.LITTLE) CPUs, 0 if unknown or all cores are alike
 	_FORCE_INLINE_ static ID get_main_id() { return _main_thread_id; } ///< get the ID of the main thread
 	static ID get_caller_id(); ///< get the ID of the caller function ID
 	static void wait_to_finish(Thread *p_thread); ///< waits until thread is finished, and deallocates it.
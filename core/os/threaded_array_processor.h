@@ -35,6 +35,7 @@
 #include "core/os/os.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/safe_refcount.h"
 
 template <class C, class U>
@@ -67,6 +68,17 @@ void process_array_thread(void *ud) {
 template <class C, class M, class U>
 void thread_process_array(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
 
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool && pool->get_thread_count()) {
+		//run on the persistent workers instead of spawning threads on every call
+		pool->parallel_for(p_elements, p_instance, p_method, p_userdata);
+		return;
+	}
+
+	if (p_elements == 0) {
+		return;
+	}
+
 	ThreadArrayProcessData<C, U> data;
 	data.method = p_method;
 	data.instance = p_instance;
@@ -0,0 +1,180 @@
+/*************************************************************************/
+/*  timeline_profiler.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "timeline_profiler.h"
+
+#include "core/os/file_access.h"
+#include "core/os/thread.h"
+#include "core/string_builder.h"
+
+thread_local TimelineProfiler::ThreadData TimelineProfiler::thread_data = { NULL };
+SafePointer<TimelineProfiler::ThreadBuffer> TimelineProfiler::buffers;
+SafeFlag TimelineProfiler::enabled;
+SafeNumeric<uint64_t> TimelineProfiler::capture_begin;
+TimelineProfiler::ThreadBuffer *TimelineProfiler::gpu_buffer = NULL;
+
+TimelineProfiler::ThreadData::~ThreadData() {
+
+	//keep the events of the thread readable, until another thread claims the buffer
+	if (buffer) {
+		buffer->in_use.clear();
+	}
+}
+
+TimelineProfiler::ThreadBuffer *TimelineProfiler::_claim_buffer(const char *p_track_name) {
+
+	uint64_t thread_id = Thread::get_caller_id();
+
+	if (!p_track_name) {
+		for (ThreadBuffer *b = buffers.get(); b; b = b->next) {
+			if (!b->track_name && !b->in_use.test_and_set()) {
+				b->write_count.set(0);
+				b->thread_id = thread_id;
+				return b;
+			}
+		}
+	}
+
+	ThreadBuffer *buffer = (ThreadBuffer *)memalloc(sizeof(ThreadBuffer));
+	buffer->write_count.set(0);
+	buffer->in_use.set();
+	buffer->thread_id = thread_id;
+	buffer->track_name = p_track_name;
+
+	do {
+		buffer->next = buffers.get();
+	} while (!buffers.compare_exchange(buffer->next, buffer));
+
+	return buffer;
+}
+
+void TimelineProfiler::set_enabled(bool p_enabled) {
+
+	if (p_enabled && !is_enabled()) {
+		clear();
+	}
+	enabled.set_to(p_enabled);
+}
+
+void TimelineProfiler::add_gpu_event(const char *p_name, uint64_t p_begin, uint64_t p_end) {
+
+	if (unlikely(!gpu_buffer)) {
+		gpu_buffer = _claim_buffer("GPU");
+	}
+	_write(gpu_buffer, p_name, p_begin, p_end);
+}
+
+void TimelineProfiler::clear() {
+
+	//buffers are written without locks, so older events are filtered out instead of erased
+	capture_begin.set(OS::get_singleton()->get_ticks_usec());
+}
+
+String TimelineProfiler::get_chrome_trace() {
+
+	uint64_t since = capture_begin.get();
+
+	StringBuilder sb;
+	sb.append("{\"traceEvents\":[\n");
+	bool first = true;
+
+	Vector<Event> events;
+	events.resize(RING_SIZE);
+
+	int track = 0;
+	for (ThreadBuffer *b = buffers.get(); b; b = b->next) {
+
+		uint64_t tid = b->track_name ? (uint64_t)(0x7FFFFFFF - track) : b->thread_id;
+		track++;
+
+		uint64_t count = b->write_count.get();
+		uint64_t from = count > RING_SIZE ? count - RING_SIZE : 0;
+		for (uint64_t i = from; i < count; i++) {
+			events.write[i - from] = b->events[i & RING_MASK];
+		}
+
+		//the owner kept writing while copying, anything it may have overwritten is dropped
+		uint64_t count_after = b->write_count.get();
+		uint64_t valid_from = count_after > RING_SIZE ? count_after - RING_SIZE : 0;
+		if (count_after < count) {
+			continue; //buffer was claimed by another thread meanwhile
+		}
+
+		const char *track_name = b->track_name ? b->track_name : (b->thread_id == Thread::get_main_id() ? "Main" : NULL);
+		if (track_name) {
+			sb.append(first ? "" : ",\n");
+			sb.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + itos(tid) + ",\"args\":{\"name\":\"" + String(track_name).json_escape() + "\"}}");
+			first = false;
+		}
+
+		for (uint64_t i = MAX(from, valid_from); i < count; i++) {
+
+			const Event &e = events[i - from];
+			if (e.begin < since || !e.name) {
+				continue;
+			}
+
+			sb.append(first ? "" : ",\n");
+			sb.append("{\"name\":\"" + String(e.name).json_escape() + "\",\"ph\":\"X\",\"pid\":0,\"tid\":" + itos(tid) + ",\"ts\":" + itos(e.begin) + ",\"dur\":" + itos(e.end - e.begin) + "}");
+			first = false;
+		}
+	}
+
+	sb.append("\n]}\n");
+	return sb.as_string();
+}
+
+Error TimelineProfiler::save_chrome_trace(const String &p_path) {
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Can't open timeline file for writing: " + p_path + ".");
+
+	f->store_string(get_chrome_trace());
+	memdelete(f);
+
+	return OK;
+}
+
+void TimelineProfiler::finish() {
+
+	enabled.clear();
+
+	//only called on exit, once every other thread is gone
+	ThreadBuffer *b = buffers.exchange(NULL);
+	while (b) {
+		ThreadBuffer *next = b->next;
+		memfree(b);
+		b = next;
+	}
+
+	thread_data.buffer = NULL;
+	gpu_buffer = NULL;
+}
@@ -0,0 +1,140 @@
+/*************************************************************************/
+/*  timeline_profiler.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TIMELINE_PROFILER_H
+#define TIMELINE_PROFILER_H
+
+#include "core/os/os.h"
+#include "core/safe_refcount.h"
+#include "core/ustring.h"
+
+/**
+ * Records named, timed scopes on a per-thread timeline, to find out what
+ * happened during a frame spike.
+ *
+ * Each thread writes into its own fixed size ring buffer, so recording never
+ * locks and only costs a branch while capturing is disabled. Buffers are
+ * linked into a global list the first time a thread records, and reused once
+ * their thread exits. A capture can be saved at any time as Chrome trace JSON,
+ * to be viewed in chrome://tracing or Perfetto.
+ *
+ * Event names are stored as pointers, they must be string literals.
+ */
+
+class TimelineProfiler {
+public:
+	struct Event {
+
+		const char *name;
+		uint64_t begin; //usec
+		uint64_t end;
+	};
+
+private:
+	enum {
+		RING_SIZE = 8192,
+		RING_MASK = RING_SIZE - 1
+	};
+
+	struct ThreadBuffer {
+
+		Event events[RING_SIZE];
+		SafeNumeric<uint64_t> write_count;
+		SafeFlag in_use;
+		uint64_t thread_id;
+		const char *track_name; //set for tracks which are not threads, like the GPU
+		ThreadBuffer *next;
+	};
+
+	struct ThreadData {
+
+		ThreadBuffer *buffer;
+
+		~ThreadData();
+	};
+
+	static thread_local ThreadData thread_data;
+	static SafePointer<ThreadBuffer> buffers; //only ever pushed at the front
+	static SafeFlag enabled;
+	static SafeNumeric<uint64_t> capture_begin;
+	static ThreadBuffer *gpu_buffer;
+
+	static ThreadBuffer *_claim_buffer(const char *p_track_name);
+	_FORCE_INLINE_ static void _write(ThreadBuffer *p_buffer, const char *p_name, uint64_t p_begin, uint64_t p_end) {
+		uint64_t pos = p_buffer->write_count.get();
+		Event &e = p_buffer->events[pos & RING_MASK];
+		e.name = p_name;
+		e.begin = p_begin;
+		e.end = p_end;
+		p_buffer->write_count.set(pos + 1);
+	}
+
+public:
+	_FORCE_INLINE_ static bool is_enabled() { return enabled.is_set(); }
+	static void set_enabled(bool p_enabled);
+
+	_FORCE_INLINE_ static void add_event(const char *p_name, uint64_t p_begin, uint64_t p_end) {
+		if (unlikely(!thread_data.buffer)) {
+			thread_data.buffer = _claim_buffer(NULL);
+		}
+		_write(thread_data.buffer, p_name, p_begin, p_end);
+	}
+	//only to be called from the rendering thread
+	static void add_gpu_event(const char *p_name, uint64_t p_begin, uint64_t p_end);
+
+	static void clear();
+	static String get_chrome_trace();
+	static Error save_chrome_trace(const String &p_path);
+
+	static void finish();
+};
+
+class TimelineScope {
+
+	const char *name;
+	uint64_t begin;
+
+public:
+	_FORCE_INLINE_ TimelineScope(const char *p_name) {
+		name = p_name;
+		begin = TimelineProfiler::is_enabled() ? OS::get_singleton()->get_ticks_usec() : 0;
+	}
+	_FORCE_INLINE_ ~TimelineScope() {
+		if (begin) {
+			TimelineProfiler::add_event(name, begin, OS::get_singleton()->get_ticks_usec());
+		}
+	}
+};
+
+#define _TIMELINE_SCOPE_NAME(m_line) _timeline_scope_##m_line
+#define _TIMELINE_SCOPE_VAR(m_line) _TIMELINE_SCOPE_NAME(m_line)
+#define TIMELINE_SCOPE(m_name) TimelineScope _TIMELINE_SCOPE_VAR(__LINE__)(m_name)
+
+#endif // TIMELINE_PROFILER_H
@@ -0,0 +1,538 @@
+/*************************************************************************/
+/*  worker_thread_pool.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "worker_thread_pool.h"
+
+#include "core/method_bind_ext.gen.inc"
+#include "core/os/os.h"
+#include "core/os/timeline_profiler.h"
+#include "core/safe_refcount.h"
+
+WorkerThreadPool *WorkerThreadPool::singleton = NULL;
+
+static thread_local int current_worker = -1;
+
+void WorkerThreadPool::_thread_func(void *p_user) {
+
+	Worker *worker = (Worker *)p_user;
+	WorkerThreadPool *pool = worker->pool;
+	current_worker = worker->index;
+
+	while (true) {
+		pool->work_semaphore->wait();
+		if (pool->exit_threads) {
+			break;
+		}
+
+		Task *task;
+		while (pool->_pop_work(task)) {
+			pool->_run_work(task);
+		}
+	}
+}
+
+void WorkerThreadPool::_script_task_func(void *p_userdata, uint32_t p_index) {
+
+	ScriptTask *script = (ScriptTask *)p_userdata;
+	Object *obj = ObjectDB::get_instance(script->object);
+	ERR_FAIL_COND_MSG(!obj, "Object of a WorkerThreadPool task was freed before the task ran.");
+
+	//a null userdata is not passed, so methods can omit that argument
+	if (script->group) {
+		obj->call(script->method, p_index, script->userdata);
+	} else {
+		obj->call(script->method, script->userdata);
+	}
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(TaskFunc p_func, void *p_userdata, uint32_t p_elements, uint32_t p_grain, const TaskID *p_dependencies, int p_dependency_count, ScriptTask *p_script) {
+
+	Task *task = memnew(Task);
+	task->func = p_func;
+	task->userdata = p_userdata;
+	task->elements = p_elements;
+	task->grain = MAX(p_grain, 1u);
+	task->next_element = 0;
+	task->items_left = 0;
+	task->pending_dependencies = 0;
+	task->completed = false;
+	task->released = false;
+	task->waiters = 0;
+	task->done = NULL;
+	task->script = p_script;
+
+	mutex->lock();
+
+	task->id = ++last_task_id;
+	tasks[task->id] = task;
+
+	for (int i = 0; i < p_dependency_count; i++) {
+		Task **dependency = tasks.getptr(p_dependencies[i]);
+		if (!dependency) {
+			//already waited for and released, hence completed
+			continue;
+		}
+		if (!(*dependency)->completed) {
+			(*dependency)->dependents.push_back(task);
+			task->pending_dependencies++;
+		}
+	}
+
+	bool ready = task->pending_dependencies == 0;
+	TaskID id = task->id;
+
+	mutex->unlock();
+
+	if (ready) {
+		_schedule(task);
+	}
+
+	return id;
+}
+
+void WorkerThreadPool::_schedule(Task *p_task) {
+
+	if (worker_count == 0) {
+		p_task->items_left = 1;
+		_run_work(p_task);
+		return;
+	}
+
+	//one work item per thread that can help, each claims grain-sized chunks until the task runs dry
+	uint32_t chunks = (p_task->elements + p_task->grain - 1) / p_task->grain;
+	uint32_t items = CLAMP(chunks, 1u, uint32_t(worker_count + 1));
+	p_task->items_left = items;
+
+	if (current_worker >= 0) {
+		Worker &worker = workers[current_worker];
+		worker.mutex->lock();
+		for (uint32_t i = 0; i < items; i++) {
+			worker.queue.push_back(p_task);
+		}
+		worker.mutex->unlock();
+	} else {
+		mutex->lock();
+		for (uint32_t i = 0; i < items; i++) {
+			queue.push_back(p_task);
+		}
+		mutex->unlock();
+	}
+
+	for (uint32_t i = 0; i < items; i++) {
+		work_semaphore->post();
+	}
+}
+
+bool WorkerThreadPool::_pop_work(Task *&r_task) {
+
+	if (current_worker >= 0) {
+		//own queue first, newest work is the most likely to be cache hot
+		Worker &worker = workers[current_worker];
+		worker.mutex->lock();
+		int size = worker.queue.size();
+		if (size) {
+			r_task = worker.queue[size - 1];
+			worker.queue.resize(size - 1);
+		}
+		worker.mutex->unlock();
+		if (size) {
+			return true;
+		}
+	}
+
+	mutex->lock();
+	bool found = queue.size() > 0;
+	if (found) {
+		r_task = queue[0];
+		queue.remove(0);
+	}
+	mutex->unlock();
+	if (found) {
+		return true;
+	}
+
+	//steal the oldest work of the other workers
+	int start = current_worker >= 0 ? current_worker + 1 : 0;
+	for (int i = 0; i < worker_count; i++) {
+		Worker &victim = workers[(start + i) % worker_count];
+		if (victim.index == current_worker) {
+			continue;
+		}
+		victim.mutex->lock();
+		found = victim.queue.size() > 0;
+		if (found) {
+			r_task = victim.queue[0];
+			victim.queue.remove(0);
+		}
+		victim.mutex->unlock();
+		if (found) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool WorkerThreadPool::_take_from_queue(Vector<Task *> &p_queue, Task *p_task) {
+
+	for (int i = p_queue.size() - 1; i >= 0; i--) {
+		if (p_queue[i] == p_task) {
+			p_queue.remove(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool WorkerThreadPool::_take_task_work(Task *p_task) {
+
+	//only work items of p_task are taken, anything else queued is left to the workers
+	bool found = false;
+
+	if (current_worker >= 0) {
+		Worker &worker = workers[current_worker];
+		worker.mutex->lock();
+		found = _take_from_queue(worker.queue, p_task);
+		worker.mutex->unlock();
+		if (found) {
+			return true;
+		}
+	}
+
+	mutex->lock();
+	found = _take_from_queue(queue, p_task);
+	mutex->unlock();
+	if (found) {
+		return true;
+	}
+
+	for (int i = 0; i < worker_count; i++) {
+		Worker &victim = workers[i];
+		if (victim.index == current_worker) {
+			continue;
+		}
+		victim.mutex->lock();
+		found = _take_from_queue(victim.queue, p_task);
+		victim.mutex->unlock();
+		if (found) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void WorkerThreadPool::_run_work(Task *p_task) {
+
+	TIMELINE_SCOPE("WorkerThreadPool::run_work");
+
+	while (true) {
+		uint32_t from = atomic_add(&p_task->next_element, p_task->grain) - p_task->grain;
+		if (from >= p_task->elements) {
+			break;
+		}
+		uint32_t to = MIN(from + p_task->grain, p_task->elements);
+		for (uint32_t i = from; i < to; i++) {
+			p_task->func(p_task->userdata, i);
+		}
+	}
+
+	if (atomic_decrement(&p_task->items_left) == 0) {
+		_task_completed(p_task);
+	}
+}
+
+void WorkerThreadPool::_task_completed(Task *p_task) {
+
+	Vector<Task *> ready;
+
+	mutex->lock();
+
+	p_task->completed = true;
+	for (int i = 0; i < p_task->dependents.size(); i++) {
+		Task *dependent = p_task->dependents[i];
+		if (--dependent->pending_dependencies == 0) {
+			ready.push_back(dependent);
+		}
+	}
+	p_task->dependents.clear();
+
+	bool released = p_task->released;
+	if (released) {
+		tasks.erase(p_task->id);
+	}
+
+	//the task may be released as soon as the lock is dropped, do not touch it afterwards
+	for (int i = 0; i < p_task->waiters; i++) {
+		p_task->done->post();
+	}
+
+	mutex->unlock();
+
+	if (released) {
+		_free_task(p_task);
+	}
+
+	for (int i = 0; i < ready.size(); i++) {
+		_schedule(ready[i]);
+	}
+}
+
+void WorkerThreadPool::_free_task(Task *p_task) {
+
+	if (p_task->done) {
+		memdelete(p_task->done);
+	}
+	if (p_task->script) {
+		memdelete(p_task->script);
+	}
+	memdelete(p_task);
+}
+
+void WorkerThreadPool::release_task(TaskID p_task) {
+
+	mutex->lock();
+	Task **task_ptr = tasks.getptr(p_task);
+	Task *task = task_ptr ? *task_ptr : NULL;
+	if (!task) {
+		mutex->unlock();
+		ERR_FAIL_MSG("Invalid task ID, or task already waited for.");
+	}
+
+	if (!task->completed) {
+		task->released = true;
+		mutex->unlock();
+		return;
+	}
+
+	tasks.erase(p_task);
+	mutex->unlock();
+	_free_task(task);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(TaskFunc p_func, void *p_userdata, const Vector<TaskID> &p_dependencies) {
+
+	return _add_task(p_func, p_userdata, 1, 1, p_dependencies.ptr(), p_dependencies.size(), NULL);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_group_task(TaskFunc p_func, void *p_userdata, uint32_t p_elements, uint32_t p_grain, const Vector<TaskID> &p_dependencies) {
+
+	return _add_task(p_func, p_userdata, p_elements, p_grain, p_dependencies.ptr(), p_dependencies.size(), NULL);
+}
+
+bool WorkerThreadPool::is_task_completed(TaskID p_task) const {
+
+	mutex->lock();
+	Task *const *task = tasks.getptr(p_task);
+	bool completed = task && (*task)->completed;
+	mutex->unlock();
+
+	ERR_FAIL_COND_V_MSG(!task, false, "Invalid task ID, or task already waited for.");
+	return completed;
+}
+
+void WorkerThreadPool::wait_for_task_completion(TaskID p_task) {
+
+	mutex->lock();
+	Task **task_ptr = tasks.getptr(p_task);
+	Task *task = task_ptr ? *task_ptr : NULL;
+	mutex->unlock();
+
+	ERR_FAIL_COND_MSG(!task, "Invalid task ID, or task already waited for.");
+
+	while (true) {
+
+		mutex->lock();
+		bool completed = task->completed;
+		mutex->unlock();
+		if (completed) {
+			break;
+		}
+
+		//help with the waited task only, unrelated work could be slow or expect to run on a worker
+		if (_take_task_work(task)) {
+			_run_work(task);
+			continue;
+		}
+
+		//nothing left to run here, the remaining work is in flight on other threads
+		mutex->lock();
+		if (task->completed) {
+			mutex->unlock();
+			break;
+		}
+		if (!task->done) {
+			task->done = Semaphore::create();
+		}
+		task->waiters++;
+		mutex->unlock();
+
+		task->done->wait();
+
+		mutex->lock();
+		task->waiters--;
+		mutex->unlock();
+	}
+
+	mutex->lock();
+	tasks.erase(p_task);
+	mutex->unlock();
+
+	_free_task(task);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_script_task(Object *p_object, const StringName &p_method, const Variant &p_userdata, const Array &p_dependencies) {
+
+	ERR_FAIL_NULL_V(p_object, INVALID_TASK_ID);
+
+	ScriptTask *script = memnew(ScriptTask);
+	script->object = p_object->get_instance_id();
+	script->method = p_method;
+	script->userdata = p_userdata;
+	script->group = false;
+
+	Vector<TaskID> dependencies;
+	for (int i = 0; i < p_dependencies.size(); i++) {
+		dependencies.push_back(p_dependencies[i]);
+	}
+
+	return _add_task(&_script_task_func, script, 1, 1, dependencies.ptr(), dependencies.size(), script);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_script_group_task(Object *p_object, const StringName &p_method, int p_elements, const Variant &p_userdata, int p_grain, const Array &p_dependencies) {
+
+	ERR_FAIL_NULL_V(p_object, INVALID_TASK_ID);
+	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
+	ERR_FAIL_COND_V(p_grain < 1, INVALID_TASK_ID);
+
+	ScriptTask *script = memnew(ScriptTask);
+	script->object = p_object->get_instance_id();
+	script->method = p_method;
+	script->userdata = p_userdata;
+	script->group = true;
+
+	Vector<TaskID> dependencies;
+	for (int i = 0; i < p_dependencies.size(); i++) {
+		dependencies.push_back(p_dependencies[i]);
+	}
+
+	return _add_task(&_script_task_func, script, p_elements, p_grain, dependencies.ptr(), dependencies.size(), script);
+}
+
+void WorkerThreadPool::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("add_task", "object", "method", "userdata", "dependencies"), &WorkerThreadPool::_add_script_task, DEFVAL(Variant()), DEFVAL(Array()));
+	ClassDB::bind_method(D_METHOD("add_group_task", "object", "method", "elements", "userdata", "grain", "dependencies"), &WorkerThreadPool::_add_script_group_task, DEFVAL(Variant()), DEFVAL(1), DEFVAL(Array()));
+	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
+	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
+	ClassDB::bind_method(D_METHOD("get_thread_count"), &WorkerThreadPool::get_thread_count);
+
+	BIND_CONSTANT(INVALID_TASK_ID);
+}
+
+void WorkerThreadPool::init(int p_thread_count) {
+
+	ERR_FAIL_COND(workers);
+
+#ifndef NO_THREADS
+	if (p_thread_count < 0) {
+		p_thread_count = OS::get_singleton()->get_processor_count() - 1;
+	}
+
+	work_semaphore = Semaphore::create();
+	if (!work_semaphore) {
+		//platform without semaphores, run everything inline
+		p_thread_count = 0;
+	}
+#else
+	p_thread_count = 0;
+#endif
+
+	worker_count = MAX(p_thread_count, 0);
+	if (worker_count == 0) {
+		return;
+	}
+
+	//workers must exist before any thread can look at another's queue
+	workers = memnew_arr(Worker, worker_count);
+	for (int i = 0; i < worker_count; i++) {
+		workers[i].pool = this;
+		workers[i].index = i;
+		workers[i].mutex = Mutex::create();
+	}
+	for (int i = 0; i < worker_count; i++) {
+		Thread::Settings settings;
+		settings.name = "WorkerThread " + itos(i);
+		workers[i].thread = Thread::create(&_thread_func, &workers[i], settings);
+	}
+}
+
+void WorkerThreadPool::finish() {
+
+	if (workers) {
+		exit_threads = true;
+		for (int i = 0; i < worker_count; i++) {
+			work_semaphore->post();
+		}
+		for (int i = 0; i < worker_count; i++) {
+			Thread::wait_to_finish(workers[i].thread);
+			memdelete(workers[i].thread);
+			memdelete(workers[i].mutex);
+		}
+		memdelete_arr(workers);
+		workers = NULL;
+	}
+	worker_count = 0;
+
+	if (work_semaphore) {
+		memdelete(work_semaphore);
+		work_semaphore = NULL;
+	}
+
+	ERR_FAIL_COND_MSG(tasks.size(), itos(tasks.size()) + " WorkerThreadPool tasks were never waited for.");
+}
+
+WorkerThreadPool::WorkerThreadPool() {
+
+	singleton = this;
+	mutex = Mutex::create();
+	work_semaphore = NULL;
+	workers = NULL;
+	worker_count = 0;
+	last_task_id = 0;
+	exit_threads = false;
+}
+
+WorkerThreadPool::~WorkerThreadPool() {
+
+	finish();
+	memdelete(mutex);
+	singleton = NULL;
+}
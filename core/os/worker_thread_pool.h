@@ -0,0 +1,176 @@
+/*************************************************************************/
+/*  worker_thread_pool.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef WORKER_THREAD_POOL_H
+#define WORKER_THREAD_POOL_H
+
+#include "core/hash_map.h"
+#include "core/object.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/vector.h"
+
+/**
+ * Engine-wide pool of persistent worker threads.
+ *
+ * Work is submitted as tasks, optionally split into a group of elements that are
+ * processed in grain-sized chunks by as many workers as are free. Every worker
+ * owns a queue it pops from the back, idle workers steal from the front of the
+ * others' queues, and threads outside the pool push into a shared queue.
+ *
+ * A task may depend on other tasks; it is queued once all of those completed.
+ * Every added task must eventually be passed to wait_for_task_completion(),
+ * which releases it, or to release_task() when nobody will wait for it. The
+ * waiting thread helps with the elements of the waited task only, so a nested
+ * group task waited for from inside a task does not deadlock the pool. Other
+ * queued tasks are always left to the workers.
+ *
+ * With no worker threads (single core, NO_THREADS builds) tasks run inline
+ * when they become ready.
+ */
+
+class WorkerThreadPool : public Object {
+
+	GDCLASS(WorkerThreadPool, Object);
+
+public:
+	typedef int64_t TaskID;
+	typedef void (*TaskFunc)(void *p_userdata, uint32_t p_index);
+
+	enum {
+		INVALID_TASK_ID = -1
+	};
+
+private:
+	struct ScriptTask {
+		ObjectID object;
+		StringName method;
+		Variant userdata;
+		bool group;
+	};
+
+	struct Task {
+		TaskID id;
+		TaskFunc func;
+		void *userdata;
+		uint32_t elements;
+		uint32_t grain;
+		uint32_t next_element; //claimed atomically, grain at a time
+		uint32_t items_left; //queued work items not yet retired, the task completes when it reaches zero
+		uint32_t pending_dependencies;
+		Vector<Task *> dependents;
+		bool completed;
+		bool released; //nobody will wait, freed on completion
+		int waiters;
+		Semaphore *done;
+		ScriptTask *script;
+	};
+
+	struct Worker {
+		WorkerThreadPool *pool;
+		int index;
+		Thread *thread;
+		Mutex *mutex;
+		Vector<Task *> queue;
+	};
+
+	static WorkerThreadPool *singleton;
+
+	Mutex *mutex; //guards the task map, dependencies, completion and the shared queue
+	Semaphore *work_semaphore;
+	HashMap<TaskID, Task *> tasks;
+	Vector<Task *> queue;
+	Worker *workers;
+	int worker_count;
+	TaskID last_task_id;
+	volatile bool exit_threads;
+
+	static void _thread_func(void *p_user);
+	static void _script_task_func(void *p_userdata, uint32_t p_index);
+
+	TaskID _add_task(TaskFunc p_func, void *p_userdata, uint32_t p_elements, uint32_t p_grain, const TaskID *p_dependencies, int p_dependency_count, ScriptTask *p_script);
+	void _schedule(Task *p_task);
+	bool _pop_work(Task *&r_task);
+	static bool _take_from_queue(Vector<Task *> &p_queue, Task *p_task);
+	bool _take_task_work(Task *p_task);
+	void _run_work(Task *p_task);
+	void _task_completed(Task *p_task);
+	void _free_task(Task *p_task);
+
+	template <class C, class U>
+	struct ParallelForData {
+		C *instance;
+		void (C::*method)(uint32_t, U);
+		U userdata;
+
+		static void process(void *p_data, uint32_t p_index) {
+			ParallelForData *data = (ParallelForData *)p_data;
+			(data->instance->*data->method)(p_index, data->userdata);
+		}
+	};
+
+protected:
+	static void _bind_methods();
+
+	TaskID _add_script_task(Object *p_object, const StringName &p_method, const Variant &p_userdata, const Array &p_dependencies);
+	TaskID _add_script_group_task(Object *p_object, const StringName &p_method, int p_elements, const Variant &p_userdata, int p_grain, const Array &p_dependencies);
+
+public:
+	_FORCE_INLINE_ static WorkerThreadPool *get_singleton() { return singleton; }
+
+	TaskID add_native_task(TaskFunc p_func, void *p_userdata, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+	TaskID add_native_group_task(TaskFunc p_func, void *p_userdata, uint32_t p_elements, uint32_t p_grain = 1, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+
+	bool is_task_completed(TaskID p_task) const;
+	void wait_for_task_completion(TaskID p_task);
+	void release_task(TaskID p_task); //instead of waiting, the task is freed once it completes and its ID is invalid right away
+
+	//runs p_method for every element on the pool and the calling thread, returns once all are done
+	template <class C, class M, class U>
+	void parallel_for(uint32_t p_elements, C *p_instance, M p_method, U p_userdata, uint32_t p_grain = 1) {
+
+		ParallelForData<C, U> data;
+		data.instance = p_instance;
+		data.method = p_method;
+		data.userdata = p_userdata;
+		wait_for_task_completion(add_native_group_task(&ParallelForData<C, U>::process, &data, p_elements, p_grain));
+	}
+
+	int get_thread_count() const { return worker_count; }
+
+	void init(int p_thread_count = -1);
+	void finish();
+
+	WorkerThreadPool();
+	~WorkerThreadPool();
+};
+
+#endif // WORKER_THREAD_POOL_H
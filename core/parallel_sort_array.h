@@ -0,0 +1,150 @@
+/*************************************************************************/
+/*  parallel_sort_array.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef PARALLEL_SORT_ARRAY_H
+#define PARALLEL_SORT_ARRAY_H
+
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/os/threaded_array_processor.h"
+#include "core/sort_array.h"
+
+/**
+ * Sorts large arrays on all cores: the array is split in one chunk per thread, the chunks are
+ * introsorted in parallel, then merged pairwise (also in parallel) through a scratch buffer.
+ * Arrays smaller than two chunks of MIN_CHUNK_SIZE are sorted in place by SortArray.
+ * The comparator is called from several threads at once, so it must not modify shared state.
+ */
+template <class T, class Comparator = _DefaultComparator<T>, bool Validate = SORT_ARRAY_VALIDATE_ENABLED>
+class ParallelSortArray {
+
+	enum {
+
+		MIN_CHUNK_SIZE = 8192 // below this, the thread startup costs more than sorting
+	};
+
+	struct Job {
+
+		Comparator compare;
+		T *array;
+		T *src;
+		T *dst;
+		int len;
+		int chunks;
+		int run;
+
+		_FORCE_INLINE_ int chunk_begin(int p_chunk) const {
+			return int((int64_t)len * p_chunk / chunks);
+		}
+
+		void sort_chunk(uint32_t p_index, void *) {
+
+			SortArray<T, Comparator, Validate> sorter;
+			sorter.compare = compare;
+			int begin = chunk_begin(p_index);
+			sorter.sort_range(begin, chunk_begin(p_index + 1), array);
+		}
+
+		void merge_runs(uint32_t p_index, void *) {
+
+			int first = p_index * run * 2;
+			int left = chunk_begin(first);
+			int middle = chunk_begin(first + run);
+			int end = chunk_begin(first + run * 2);
+
+			int l = left;
+			int r = middle;
+			int to = left;
+			while (l < middle && r < end) {
+				// take from the left run on ties, so each merge is stable
+				if (compare(src[r], src[l])) {
+					dst[to++] = src[r++];
+				} else {
+					dst[to++] = src[l++];
+				}
+			}
+			while (l < middle) {
+				dst[to++] = src[l++];
+			}
+			while (r < end) {
+				dst[to++] = src[r++];
+			}
+		}
+	};
+
+public:
+	Comparator compare;
+
+	void sort(T *p_array, int p_len) const {
+
+		int threads = OS::get_singleton()->get_processor_count();
+		int chunks = 1;
+		while (chunks * 2 <= threads && p_len / (chunks * 2) >= MIN_CHUNK_SIZE) {
+			chunks *= 2;
+		}
+
+		if (chunks == 1) {
+			SortArray<T, Comparator, Validate> sorter;
+			sorter.compare = compare;
+			sorter.sort(p_array, p_len);
+			return;
+		}
+
+		Job job;
+		job.compare = compare;
+		job.array = p_array;
+		job.len = p_len;
+		job.chunks = chunks;
+		thread_process_array(chunks, &job, &Job::sort_chunk, (void *)NULL);
+
+		T *scratch = memnew_arr(T, p_len);
+		job.src = p_array;
+		job.dst = scratch;
+		for (job.run = 1; job.run < chunks; job.run *= 2) {
+			int merges = chunks / (job.run * 2);
+			if (merges == 1) {
+				job.merge_runs(0, NULL); // the last merge can't be split
+			} else {
+				thread_process_array(merges, &job, &Job::merge_runs, (void *)NULL);
+			}
+			SWAP(job.src, job.dst);
+		}
+
+		if (job.src != p_array) {
+			for (int i = 0; i < p_len; i++) {
+				p_array[i] = job.src[i];
+			}
+		}
+
+		memdelete_arr(scratch);
+	}
+};
+
+#endif // PARALLEL_SORT_ARRAY_H
@@ -112,6 +112,13 @@ bool PoolAllocator::find_hole(EntryArrayPos *p_pos, int p_for_size) {
 
 void PoolAllocator::compact(int p_up_to) {
 
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	_compact(p_up_to);
+	compaction_usec += OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+void PoolAllocator::_compact(int p_up_to) {
+
 	uint32_t prev_entry_end_pos = 0;
 
 	if (p_up_to < 0)
@@ -127,6 +134,7 @@ void PoolAllocator::compact(int p_up_to) {
 		/* if we can compact, do it */
 		if (hole_size > 0 && !entry.lock) {
 
+			compaction_bytes += aligned(entry.len);
 			COMPACT_CHUNK(entry, prev_entry_end_pos);
 		}
 
@@ -135,8 +143,94 @@ void PoolAllocator::compact(int p_up_to) {
 	}
 }
 
+bool PoolAllocator::compact_incremental(uint64_t p_time_budget_usec) {
+
+	mt_lock();
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint64_t now = begin;
+
+	/* allocations and frees since the last call only shift the cursor, moving an entry down to the end of the previous one is always safe */
+	if (compact_cursor > entry_count) {
+		compact_cursor = entry_count;
+	}
+
+	while (compact_cursor < entry_count) {
+
+		Entry &entry = entry_array[entry_indices[compact_cursor]];
+		uint32_t prev_entry_end_pos = compact_cursor == 0 ? 0 : entry_end(entry_array[entry_indices[compact_cursor - 1]]);
+
+		if (entry.pos > prev_entry_end_pos && !entry.lock) {
+
+			compaction_bytes += aligned(entry.len);
+			COMPACT_CHUNK(entry, prev_entry_end_pos);
+		}
+
+		compact_cursor++;
+
+		now = OS::get_singleton()->get_ticks_usec();
+		if (now - begin >= p_time_budget_usec) {
+			break;
+		}
+	}
+
+	compaction_usec += now - begin;
+
+	bool done = compact_cursor == entry_count;
+	if (done) {
+		compact_cursor = 0; // new holes may appear, start over next time
+	}
+
+	mt_unlock();
+
+	return done;
+}
+
+int PoolAllocator::get_free_block_count() const {
+
+	mt_lock();
+
+	int count = 0;
+	int prev_entry_end_pos = 0;
+	for (int i = 0; i < entry_count; i++) {
+
+		const Entry &entry = entry_array[entry_indices[i]];
+		if ((int)entry.pos > prev_entry_end_pos) {
+			count++;
+		}
+		prev_entry_end_pos = entry_end(entry);
+	}
+	if (pool_size > prev_entry_end_pos) {
+		count++;
+	}
+
+	mt_unlock();
+
+	return count;
+}
+
+int PoolAllocator::get_largest_free_block() const {
+
+	mt_lock();
+
+	int largest = 0;
+	int prev_entry_end_pos = 0;
+	for (int i = 0; i < entry_count; i++) {
+
+		const Entry &entry = entry_array[entry_indices[i]];
+		largest = MAX(largest, (int)entry.pos - prev_entry_end_pos);
+		prev_entry_end_pos = entry_end(entry);
+	}
+	largest = MAX(largest, pool_size - prev_entry_end_pos);
+
+	mt_unlock();
+
+	return largest;
+}
+
 void PoolAllocator::compact_up(int p_from) {
 
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
 	uint32_t next_entry_end_pos = pool_size; // - static_area_size;
 
 	for (int i = entry_count - 1; i >= p_from; i--) {
@@ -150,12 +244,15 @@ void PoolAllocator::compact_up(int p_from) {
 		/* if we can compact, do it */
 		if (hole_size > 0 && !entry.lock) {
 
+			compaction_bytes += aligned(entry.len);
 			COMPACT_CHUNK(entry, (next_entry_end_pos - aligned(entry.len)));
 		}
 
 		/* prepare for next one */
 		next_entry_end_pos = entry.pos;
 	}
+
+	compaction_usec += OS::get_singleton()->get_ticks_usec() - begin;
 }
 
 bool PoolAllocator::find_entry_index(EntryIndicesPos *p_map_pos, Entry *p_entry) {
@@ -578,6 +675,10 @@ void PoolAllocator::create_pool(void *p_mem, int p_size, int p_max_entries) {
 	free_mem_peak = p_size;
 
 	check_count = 0;
+
+	compact_cursor = 0;
+	compaction_usec = 0;
+	compaction_bytes = 0;
 }
 
 PoolAllocator::PoolAllocator(int p_size, bool p_needs_locking, int p_max_entries) {
@@ -95,6 +95,10 @@ private:
 
 	bool needs_locking;
 
+	int compact_cursor; // entry index where incremental compaction resumes
+	uint64_t compaction_usec; // total time spent moving memory around
+	uint64_t compaction_bytes;
+
 	inline int entry_end(const Entry &p_entry) const {
 		return p_entry.pos + aligned(p_entry.len);
 	}
@@ -107,6 +111,7 @@ private:
 		return p_size;
 	}
 
+	void _compact(int p_up_to = -1);
 	void compact(int p_up_to = -1);
 	void compact_up(int p_from = 0);
 	bool get_free_entry(EntryArrayPos *p_pos);
@@ -135,6 +140,12 @@ public:
 	int get_used_mem() const;
 	int get_free_peak(); ///< get free memory
 
+	bool compact_incremental(uint64_t p_time_budget_usec); ///< Move unlocked blocks down for at most the given time, returns true once no hole can be closed
+	int get_free_block_count() const; ///< number of holes between (and after) blocks
+	int get_largest_free_block() const; ///< size of the largest hole, the biggest allocation that can succeed without compacting
+	uint64_t get_compaction_time_usec() const { return compaction_usec; }
+	uint64_t get_compaction_bytes_moved() const { return compaction_bytes; }
+
 	Error lock(ID p_mem); //@todo move this out
 	void *get(ID p_mem);
 	const void *get(ID p_mem) const;
@@ -42,8 +42,8 @@ uint32_t MemoryPool::alloc_count = 0;
 uint32_t MemoryPool::allocs_used = 0;
 Mutex *MemoryPool::alloc_mutex = NULL;
 
-size_t MemoryPool::total_memory = 0;
-size_t MemoryPool::max_memory = 0;
+uint64_t MemoryPool::total_memory = 0;
+uint64_t MemoryPool::max_memory = 0;
 
 void MemoryPool::setup(uint32_t p_max_allocs) {
 
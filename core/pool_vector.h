@@ -53,6 +53,7 @@ struct MemoryPool {
 		void *mem;
 		PoolAllocator::ID pool_id;
 		size_t size;
+		size_t capacity; // bytes allocated for mem, grows geometrically so push_back does not realloc every time
 
 		Alloc *free_list;
 
@@ -61,6 +62,7 @@ struct MemoryPool {
 				mem(NULL),
 				pool_id(POOL_ALLOCATOR_INVALID_ID),
 				size(0),
+				capacity(0),
 				free_list(NULL) {
 		}
 	};
@@ -69,9 +71,22 @@ struct MemoryPool {
 	static Alloc *free_list;
 	static uint32_t alloc_count;
 	static uint32_t allocs_used;
-	static Mutex *alloc_mutex;
-	static size_t total_memory;
-	static size_t max_memory;
+	static Mutex *alloc_mutex; // only guards the alloc free list
+	static uint64_t total_memory;
+	static uint64_t max_memory;
+
+	_FORCE_INLINE_ static void _track_memory(size_t p_old_size, size_t p_new_size) {
+#ifdef DEBUG_ENABLED
+		// atomics, so resizing and copying never take alloc_mutex just for the statistics
+		uint64_t total;
+		if (p_new_size >= p_old_size) {
+			total = atomic_add(&total_memory, (uint64_t)(p_new_size - p_old_size));
+		} else {
+			total = atomic_sub(&total_memory, (uint64_t)(p_old_size - p_new_size));
+		}
+		atomic_exchange_if_greater(&max_memory, total);
+#endif
+	}
 
 	static void setup(uint32_t p_max_allocs = (1 << 16));
 	static void cleanup();
@@ -111,19 +126,15 @@ class PoolVector {
 
 		//copy the alloc data
 		alloc->size = old_alloc->size;
+		alloc->capacity = old_alloc->size;
 		alloc->refcount.init();
 		alloc->pool_id = POOL_ALLOCATOR_INVALID_ID;
 		alloc->lock = 0;
 
-#ifdef DEBUG_ENABLED
-		MemoryPool::total_memory += alloc->size;
-		if (MemoryPool::total_memory > MemoryPool::max_memory) {
-			MemoryPool::max_memory = MemoryPool::total_memory;
-		}
-#endif
-
 		MemoryPool::alloc_mutex->unlock();
 
+		MemoryPool::_track_memory(0, alloc->size);
+
 		if (MemoryPool::memory_pool) {
 
 		} else {
@@ -139,21 +150,21 @@ class PoolVector {
 			int cur_elements = alloc->size / sizeof(T);
 			T *dst = (T *)w.ptr();
 			const T *src = (const T *)r.ptr();
-			for (int i = 0; i < cur_elements; i++) {
-				memnew_placement(&dst[i], T(src[i]));
+			if (__has_trivial_copy(T)) {
+				copymem(dst, src, alloc->size);
+			} else {
+				for (int i = 0; i < cur_elements; i++) {
+					memnew_placement(&dst[i], T(src[i]));
+				}
 			}
 		}
 
 		if (old_alloc->refcount.unref()) {
 			//this should never happen but..
 
-#ifdef DEBUG_ENABLED
-			MemoryPool::alloc_mutex->lock();
-			MemoryPool::total_memory -= old_alloc->size;
-			MemoryPool::alloc_mutex->unlock();
-#endif
+			MemoryPool::_track_memory(old_alloc->size, 0);
 
-			{
+			if (!__has_trivial_destructor(T)) {
 				Write w;
 				w._ref(old_alloc);
 
@@ -173,6 +184,7 @@ class PoolVector {
 				memfree(old_alloc->mem);
 				old_alloc->mem = NULL;
 				old_alloc->size = 0;
+				old_alloc->capacity = 0;
 
 				MemoryPool::alloc_mutex->lock();
 				old_alloc->free_list = MemoryPool::free_list;
@@ -211,7 +223,7 @@ class PoolVector {
 
 		//must be disposed!
 
-		{
+		if (!__has_trivial_destructor(T)) {
 			int cur_elements = alloc->size / sizeof(T);
 
 			// Don't use write() here because it could otherwise provoke COW,
@@ -226,11 +238,7 @@ class PoolVector {
 			}
 		}
 
-#ifdef DEBUG_ENABLED
-		MemoryPool::alloc_mutex->lock();
-		MemoryPool::total_memory -= alloc->size;
-		MemoryPool::alloc_mutex->unlock();
-#endif
+		MemoryPool::_track_memory(alloc->size, 0);
 
 		if (MemoryPool::memory_pool) {
 			//resize memory pool
@@ -241,6 +249,7 @@ class PoolVector {
 			memfree(alloc->mem);
 			alloc->mem = NULL;
 			alloc->size = 0;
+			alloc->capacity = 0;
 
 			MemoryPool::alloc_mutex->lock();
 			alloc->free_list = MemoryPool::free_list;
@@ -293,7 +302,7 @@ public:
 		}
 
 	public:
-		virtual ~Access() {
+		~Access() {
 			_unref();
 		}
 
@@ -492,8 +501,9 @@ void PoolVector<T>::set(int p_index, const T &p_val) {
 
 	ERR_FAIL_INDEX(p_index, size());
 
-	Write w = write();
-	w[p_index] = p_val;
+	// a single element access can't overlap a resize, so there is no need to lock like Write does
+	_copy_on_write();
+	((T *)alloc->mem)[p_index] = p_val;
 }
 
 template <class T>
@@ -508,8 +518,7 @@ T PoolVector<T>::operator[](int p_index) const {
 
 	CRASH_BAD_INDEX(p_index, size());
 
-	Read r = read();
-	return r[p_index];
+	return ((const T *)alloc->mem)[p_index];
 }
 
 template <class T>
@@ -537,6 +546,7 @@ Error PoolVector<T>::resize(int p_size) {
 
 		//cleanup the alloc
 		alloc->size = 0;
+		alloc->capacity = 0;
 		alloc->refcount.init();
 		alloc->pool_id = POOL_ALLOCATOR_INVALID_ID;
 		MemoryPool::alloc_mutex->unlock();
@@ -558,15 +568,7 @@ Error PoolVector<T>::resize(int p_size) {
 
 	_copy_on_write(); // make it unique
 
-#ifdef DEBUG_ENABLED
-	MemoryPool::alloc_mutex->lock();
-	MemoryPool::total_memory -= alloc->size;
-	MemoryPool::total_memory += new_size;
-	if (MemoryPool::total_memory > MemoryPool::max_memory) {
-		MemoryPool::max_memory = MemoryPool::total_memory;
-	}
-	MemoryPool::alloc_mutex->unlock();
-#endif
+	MemoryPool::_track_memory(alloc->size, new_size);
 
 	int cur_elements = alloc->size / sizeof(T);
 
@@ -576,31 +578,36 @@ Error PoolVector<T>::resize(int p_size) {
 			//resize memory pool
 			//if none, create
 			//if some resize
-		} else {
+		} else if (new_size > alloc->capacity) {
 
-			if (alloc->size == 0) {
-				alloc->mem = memalloc(new_size);
+			// growing one element at a time (push_back, append) reallocates by half the capacity,
+			// while resizing to a known size allocates just that
+			size_t new_capacity = MAX(new_size, alloc->capacity + alloc->capacity / 2);
+			if (alloc->capacity == 0) {
+				alloc->mem = memalloc(new_capacity);
 			} else {
-				alloc->mem = memrealloc(alloc->mem, new_size);
+				alloc->mem = memrealloc(alloc->mem, new_capacity);
 			}
+			alloc->capacity = new_capacity;
 		}
 
 		alloc->size = new_size;
 
-		Write w = write();
+		if (!__has_trivial_constructor(T)) {
+			T *elems = (T *)alloc->mem;
+			for (int i = cur_elements; i < p_size; i++) {
 
-		for (int i = cur_elements; i < p_size; i++) {
-
-			memnew_placement(&w[i], T);
+				memnew_placement(&elems[i], T);
+			}
 		}
 
 	} else {
 
-		{
-			Write w = write();
+		if (!__has_trivial_destructor(T)) {
+			T *elems = (T *)alloc->mem;
 			for (int i = p_size; i < cur_elements; i++) {
 
-				w[i].~T();
+				elems[i].~T();
 			}
 		}
 
@@ -614,6 +621,7 @@ Error PoolVector<T>::resize(int p_size) {
 				memfree(alloc->mem);
 				alloc->mem = NULL;
 				alloc->size = 0;
+				alloc->capacity = 0;
 
 				MemoryPool::alloc_mutex->lock();
 				alloc->free_list = MemoryPool::free_list;
@@ -622,7 +630,10 @@ Error PoolVector<T>::resize(int p_size) {
 				MemoryPool::alloc_mutex->unlock();
 
 			} else {
-				alloc->mem = memrealloc(alloc->mem, new_size);
+				if (new_size < alloc->capacity / 2) {
+					alloc->mem = memrealloc(alloc->mem, new_size);
+					alloc->capacity = new_size;
+				}
 				alloc->size = new_size;
 			}
 		}
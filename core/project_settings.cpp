@@ -152,6 +152,8 @@ bool ProjectSettings::_set(const StringName &p_name, const Variant &p_value) {
 
 	_THREAD_SAFE_METHOD_
 
+	settings_version++;
+
 	if (p_value.get_type() == Variant::NIL)
 		props.erase(p_name);
 	else {
@@ -186,9 +188,10 @@ bool ProjectSettings::_set(const StringName &p_name, const Variant &p_value) {
 			}
 		}
 
-		if (props.has(p_name)) {
-			if (!props[p_name].overridden)
-				props[p_name].variant = p_value;
+		VariantContainer *v = props.getptr(p_name);
+		if (v) {
+			if (!v->overridden)
+				v->variant = p_value;
 
 		} else {
 			props[p_name] = VariantContainer(p_value, last_order++);
@@ -202,14 +205,18 @@ bool ProjectSettings::_get(const StringName &p_name, Variant &r_ret) const {
 	_THREAD_SAFE_METHOD_
 
 	StringName name = p_name;
-	if (!disable_feature_overrides && feature_overrides.has(name)) {
-		name = feature_overrides[name];
+	if (!disable_feature_overrides) {
+		const StringName *override_name = feature_overrides.getptr(name);
+		if (override_name) {
+			name = *override_name;
+		}
 	}
-	if (!props.has(name)) {
+	const VariantContainer *v = props.getptr(name);
+	if (!v) {
 		WARN_PRINT("Property not found: " + String(name));
 		return false;
 	}
-	r_ret = props[name].variant;
+	r_ret = v->variant;
 	return true;
 }
 
@@ -229,15 +236,15 @@ void ProjectSettings::_get_property_list(List<PropertyInfo> *p_list) const {
 
 	Set<_VCSort> vclist;
 
-	for (Map<StringName, VariantContainer>::Element *E = props.front(); E; E = E->next()) {
+	for (const StringName *E = props.next(NULL); E; E = props.next(E)) {
 
-		const VariantContainer *v = &E->get();
+		const VariantContainer *v = &props[*E];
 
 		if (v->hide_from_editor)
 			continue;
 
 		_VCSort vc;
-		vc.name = E->key();
+		vc.name = *E;
 		vc.order = v->order;
 		vc.type = v->variant.get_type();
 		if (vc.name.begins_with("input/") || vc.name.begins_with("import/") || vc.name.begins_with("export/") || vc.name.begins_with("/remap") || vc.name.begins_with("/locale") || vc.name.begins_with("/autoload"))
@@ -289,16 +296,17 @@ void ProjectSettings::_convert_to_last_version(int p_from_version) {
 
 	if (p_from_version <= 3) {
 		// Converts the actions from array to dictionary (array of events to dictionary with deadzone + events)
-		for (Map<StringName, ProjectSettings::VariantContainer>::Element *E = props.front(); E; E = E->next()) {
-			Variant value = E->get().variant;
-			if (String(E->key()).begins_with("input/") && value.get_type() == Variant::ARRAY) {
+		for (const StringName *E = props.next(NULL); E; E = props.next(E)) {
+			Variant value = props[*E].variant;
+			if (String(*E).begins_with("input/") && value.get_type() == Variant::ARRAY) {
 				Array array = value;
 				Dictionary action;
 				action["deadzone"] = Variant(0.5f);
 				action["events"] = array;
-				E->get().variant = action;
+				props[*E].variant = action;
 			}
 		}
+		settings_version++;
 	}
 }
 
@@ -645,6 +653,7 @@ void ProjectSettings::clear(const String &p_name) {
 
 	ERR_FAIL_COND_MSG(!props.has(p_name), "Request for nonexistent project setting: " + p_name + ".");
 	props.erase(p_name);
+	settings_version++;
 }
 
 Error ProjectSettings::save() {
@@ -803,18 +812,18 @@ Error ProjectSettings::save_custom(const String &p_path, const CustomMap &p_cust
 	Set<_VCSort> vclist;
 
 	if (p_merge_with_current) {
-		for (Map<StringName, VariantContainer>::Element *G = props.front(); G; G = G->next()) {
+		for (const StringName *G = props.next(NULL); G; G = props.next(G)) {
 
-			const VariantContainer *v = &G->get();
+			const VariantContainer *v = &props[*G];
 
 			if (v->hide_from_editor)
 				continue;
 
-			if (p_custom.has(G->key()))
+			if (p_custom.has(*G))
 				continue;
 
 			_VCSort vc;
-			vc.name = G->key(); //*k;
+			vc.name = *G; //*k;
 			vc.order = v->order;
 			vc.type = v->variant.get_type();
 			vc.flags = PROPERTY_USAGE_EDITOR | PROPERTY_USAGE_STORAGE;
@@ -828,11 +837,11 @@ Error ProjectSettings::save_custom(const String &p_path, const CustomMap &p_cust
 	for (const Map<String, Variant>::Element *E = p_custom.front(); E; E = E->next()) {
 
 		// Lookup global prop to store in the same order
-		Map<StringName, VariantContainer>::Element *global_prop = props.find(E->key());
+		const VariantContainer *global_prop = props.getptr(E->key());
 
 		_VCSort vc;
 		vc.name = E->key();
-		vc.order = global_prop ? global_prop->get().order : 0xFFFFFFF;
+		vc.order = global_prop ? global_prop->order : 0xFFFFFFF;
 		vc.type = E->get().get_type();
 		vc.flags = PROPERTY_USAGE_STORAGE;
 		vclist.insert(vc);
@@ -942,6 +951,7 @@ const Map<StringName, PropertyInfo> &ProjectSettings::get_custom_property_info()
 void ProjectSettings::set_disable_feature_overrides(bool p_disable) {
 
 	disable_feature_overrides = p_disable;
+	settings_version++;
 }
 
 bool ProjectSettings::is_using_datapack() const {
@@ -970,6 +980,25 @@ void ProjectSettings::set_setting(const String &p_setting, const Variant &p_valu
 }
 
 Variant ProjectSettings::get_setting(const String &p_setting) const {
+
+	//settings are looked up directly, skipping the class property checks Object::get() does first
+	{
+		_THREAD_SAFE_METHOD_
+
+		StringName name = p_setting;
+		if (!disable_feature_overrides) {
+			const StringName *override_name = feature_overrides.getptr(name);
+			if (override_name) {
+				name = *override_name;
+			}
+		}
+		const VariantContainer *v = props.getptr(name);
+		if (v) {
+			return v->variant;
+		}
+	}
+
+	//not a setting, Object::get() still resolves class properties and warns on a miss
 	return get(p_setting);
 }
 
@@ -1003,6 +1032,7 @@ ProjectSettings::ProjectSettings() {
 	last_order = NO_BUILTIN_ORDER_BASE;
 	last_builtin_order = 0;
 	disable_feature_overrides = false;
+	settings_version = 1;
 	registering_order = true;
 
 	Array events;
@@ -1196,6 +1226,7 @@ ProjectSettings::ProjectSettings() {
 	custom_prop_info["display/window/handheld/orientation"] = PropertyInfo(Variant::STRING, "display/window/handheld/orientation", PROPERTY_HINT_ENUM, "landscape,portrait,reverse_landscape,reverse_portrait,sensor_landscape,sensor_portrait,sensor");
 	custom_prop_info["rendering/threads/thread_model"] = PropertyInfo(Variant::INT, "rendering/threads/thread_model", PROPERTY_HINT_ENUM, "Single-Unsafe,Single-Safe,Multi-Threaded");
 	custom_prop_info["physics/2d/thread_model"] = PropertyInfo(Variant::INT, "physics/2d/thread_model", PROPERTY_HINT_ENUM, "Single-Unsafe,Single-Safe,Multi-Threaded");
+	custom_prop_info["physics/3d/thread_model"] = PropertyInfo(Variant::INT, "physics/3d/thread_model", PROPERTY_HINT_ENUM, "Single-Unsafe,Single-Safe,Multi-Threaded");
 	custom_prop_info["rendering/quality/intended_usage/framebuffer_allocation"] = PropertyInfo(Variant::INT, "rendering/quality/intended_usage/framebuffer_allocation", PROPERTY_HINT_ENUM, "2D,2D Without Sampling,3D,3D Without Effects");
 
 	GLOBAL_DEF("debug/settings/profiler/max_functions", 16384);
@@ -1209,6 +1240,9 @@ ProjectSettings::ProjectSettings() {
 	Compression::zstd_window_log_size = GLOBAL_DEF("compression/formats/zstd/window_log_size", 27);
 	custom_prop_info["compression/formats/zstd/window_log_size"] = PropertyInfo(Variant::INT, "compression/formats/zstd/window_log_size", PROPERTY_HINT_RANGE, "10,30,1");
 
+	GLOBAL_DEF("compression/formats/compressed_files/block_size", 65536);
+	custom_prop_info["compression/formats/compressed_files/block_size"] = PropertyInfo(Variant::INT, "compression/formats/compressed_files/block_size", PROPERTY_HINT_RANGE, "4096,16777216,1,or_greater");
+
 	Compression::zlib_level = GLOBAL_DEF("compression/formats/zlib/compression_level", Z_DEFAULT_COMPRESSION);
 	custom_prop_info["compression/formats/zlib/compression_level"] = PropertyInfo(Variant::INT, "compression/formats/zlib/compression_level", PROPERTY_HINT_RANGE, "-1,9,1");
 
@@ -31,6 +31,7 @@
 #ifndef GLOBAL_CONFIG_H
 #define GLOBAL_CONFIG_H
 
+#include "core/hash_map.h"
 #include "core/object.h"
 #include "core/os/thread_safe.h"
 #include "core/set.h"
@@ -77,7 +78,7 @@ protected:
 	bool registering_order;
 	int last_order;
 	int last_builtin_order;
-	Map<StringName, VariantContainer> props;
+	HashMap<StringName, VariantContainer> props;
 	String resource_path;
 	Map<StringName, PropertyInfo> custom_prop_info;
 	bool disable_feature_overrides;
@@ -85,7 +86,9 @@ protected:
 	List<String> input_presets;
 
 	Set<String> custom_features;
-	Map<StringName, StringName> feature_overrides;
+	HashMap<StringName, StringName> feature_overrides;
+
+	uint32_t settings_version; //bumped on every change, so Handle knows when to read its setting again
 
 	bool _set(const StringName &p_name, const Variant &p_value);
 	bool _get(const StringName &p_name, Variant &r_ret) const;
@@ -116,6 +119,32 @@ protected:
 public:
 	static const int CONFIG_VERSION = 4;
 
+	//typed access to a setting for hot paths, keeps the converted value until any setting changes
+	template <class T>
+	class Handle {
+
+		const char *name;
+		mutable T value;
+		mutable uint32_t version;
+
+	public:
+		_FORCE_INLINE_ const T &get() const {
+			const ProjectSettings *ps = ProjectSettings::get_singleton();
+			if (unlikely(version != ps->settings_version)) {
+				value = ps->get_setting(name);
+				version = ps->settings_version;
+			}
+			return value;
+		}
+
+		_FORCE_INLINE_ operator T() const { return get(); }
+
+		Handle(const char *p_name) :
+				name(p_name),
+				value(),
+				version(0) {}
+	};
+
 	void set_setting(const String &p_setting, const Variant &p_value);
 	Variant get_setting(const String &p_setting) const;
 
@@ -164,6 +193,6 @@ public:
 Variant _GLOBAL_DEF(const String &p_var, const Variant &p_default, bool p_restart_if_changed = false);
 #define GLOBAL_DEF(m_var, m_value) _GLOBAL_DEF(m_var, m_value)
 #define GLOBAL_DEF_RST(m_var, m_value) _GLOBAL_DEF(m_var, m_value, true)
-#define GLOBAL_GET(m_var) ProjectSettings::get_singleton()->get(m_var)
+#define GLOBAL_GET(m_var) ProjectSettings::get_singleton()->get_setting(m_var)
 
 #endif
@@ -0,0 +1,307 @@
+/*************************************************************************/
+/*  property_accessor.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "property_accessor.h"
+
+void PropertyAccessor::_set_subvalue(Variant &r_base, const StringName *p_names, int p_count, const Variant &p_value, bool *r_valid) {
+
+	if (p_count == 1) {
+		r_base.set_named(p_names[0], p_value, r_valid);
+		return;
+	}
+
+	Variant subvalue = r_base.get_named(p_names[0], r_valid);
+	if (!*r_valid)
+		return;
+
+	_set_subvalue(subvalue, p_names + 1, p_count - 1, p_value, r_valid);
+	if (!*r_valid)
+		return;
+
+	r_base.set_named(p_names[0], subvalue, r_valid);
+}
+
+Object *PropertyAccessor::_get_object(const Array &p_objects, int p_index) const {
+
+	const Variant &v = p_objects[p_index];
+	if (v.get_type() != Variant::OBJECT)
+		return NULL;
+
+	Object *obj = v;
+#ifdef DEBUG_ENABLED
+	if (obj && !v.is_ref() && !ObjectDB::instance_validate(obj))
+		return NULL; //freed
+#endif
+	return obj;
+}
+
+Variant PropertyAccessor::_get_value(Object *p_object, bool *r_valid) const {
+
+	Variant value = p_object->get_cached(cache, names[0], r_valid);
+	for (int i = 1; i < names.size() && *r_valid; i++) {
+		value = value.get_named(names[i], r_valid);
+	}
+	return value;
+}
+
+void PropertyAccessor::_set_value(Object *p_object, const Variant &p_value, bool *r_valid) const {
+
+	if (names.size() == 1) {
+		p_object->set_cached(cache, names[0], p_value, r_valid);
+		return;
+	}
+
+	Variant value = p_object->get_cached(cache, names[0], r_valid);
+	if (!*r_valid)
+		return;
+
+	_set_subvalue(value, &names[1], names.size() - 1, p_value, r_valid);
+	if (!*r_valid)
+		return;
+
+	p_object->set_cached(cache, names[0], value, r_valid);
+}
+
+void PropertyAccessor::set_property_path(const NodePath &p_path) {
+
+	property_path = p_path;
+	names = p_path.get_as_property_path().get_subnames();
+	cache.entry.set(NULL);
+}
+
+NodePath PropertyAccessor::get_property_path() const {
+
+	return property_path;
+}
+
+Array PropertyAccessor::get_values(const Array &p_objects) const {
+
+	Array ret;
+	ERR_FAIL_COND_V_MSG(names.empty(), ret, "No property path set.");
+
+	int count = p_objects.size();
+	ret.resize(count);
+
+	int failed = 0;
+	for (int i = 0; i < count; i++) {
+		Object *obj = _get_object(p_objects, i);
+		bool valid = false;
+		if (obj) {
+			ret[i] = _get_value(obj, &valid);
+		}
+		if (!valid) {
+			failed++;
+		}
+	}
+
+	if (failed) {
+		ERR_PRINT("Could not get property '" + String(property_path) + "' on " + itos(failed) + " of " + itos(count) + " objects.");
+	}
+
+	return ret;
+}
+
+template <class T>
+Variant PropertyAccessor::_get_values_packed(const Array &p_objects) const {
+
+	int count = p_objects.size();
+	PoolVector<T> ret;
+	ret.resize(count);
+
+	int failed = 0;
+	{
+		typename PoolVector<T>::Write w = ret.write();
+		for (int i = 0; i < count; i++) {
+			Object *obj = _get_object(p_objects, i);
+			bool valid = false;
+			if (obj) {
+				Variant value = _get_value(obj, &valid);
+				w[i] = value;
+			}
+			if (!valid) {
+				w[i] = T();
+				failed++;
+			}
+		}
+	}
+
+	if (failed) {
+		ERR_PRINT("Could not get property '" + String(property_path) + "' on " + itos(failed) + " of " + itos(count) + " objects.");
+	}
+
+	return ret;
+}
+
+Variant PropertyAccessor::get_values_packed(const Array &p_objects, Variant::Type p_array_type) const {
+
+	ERR_FAIL_COND_V_MSG(names.empty(), Variant(), "No property path set.");
+
+	switch (p_array_type) {
+		case Variant::POOL_BYTE_ARRAY: {
+			return _get_values_packed<uint8_t>(p_objects);
+		}
+		case Variant::POOL_INT_ARRAY: {
+			return _get_values_packed<int>(p_objects);
+		}
+		case Variant::POOL_REAL_ARRAY: {
+			return _get_values_packed<real_t>(p_objects);
+		}
+		case Variant::POOL_STRING_ARRAY: {
+			return _get_values_packed<String>(p_objects);
+		}
+		case Variant::POOL_VECTOR2_ARRAY: {
+			return _get_values_packed<Vector2>(p_objects);
+		}
+		case Variant::POOL_VECTOR3_ARRAY: {
+			return _get_values_packed<Vector3>(p_objects);
+		}
+		case Variant::POOL_COLOR_ARRAY: {
+			return _get_values_packed<Color>(p_objects);
+		}
+		default: {
+			ERR_FAIL_V_MSG(Variant(), "Type must be one of the pool array types.");
+		}
+	}
+}
+
+template <class T>
+void PropertyAccessor::_set_values_packed(const Array &p_objects, const PoolVector<T> &p_values) const {
+
+	int count = p_objects.size();
+	ERR_FAIL_COND_MSG(p_values.size() != count, "The number of values (" + itos(p_values.size()) + ") doesn't match the number of objects (" + itos(count) + ").");
+
+	int failed = 0;
+	typename PoolVector<T>::Read r = p_values.read();
+	for (int i = 0; i < count; i++) {
+		Object *obj = _get_object(p_objects, i);
+		bool valid = false;
+		if (obj) {
+			_set_value(obj, r[i], &valid);
+		}
+		if (!valid) {
+			failed++;
+		}
+	}
+
+	if (failed) {
+		ERR_PRINT("Could not set property '" + String(property_path) + "' on " + itos(failed) + " of " + itos(count) + " objects.");
+	}
+}
+
+void PropertyAccessor::set_values(const Array &p_objects, const Variant &p_values) {
+
+	ERR_FAIL_COND_MSG(names.empty(), "No property path set.");
+
+	switch (p_values.get_type()) {
+		case Variant::ARRAY: {
+			Array values = p_values;
+			int count = p_objects.size();
+			ERR_FAIL_COND_MSG(values.size() != count, "The number of values (" + itos(values.size()) + ") doesn't match the number of objects (" + itos(count) + ").");
+
+			int failed = 0;
+			for (int i = 0; i < count; i++) {
+				Object *obj = _get_object(p_objects, i);
+				bool valid = false;
+				if (obj) {
+					_set_value(obj, values[i], &valid);
+				}
+				if (!valid) {
+					failed++;
+				}
+			}
+
+			if (failed) {
+				ERR_PRINT("Could not set property '" + String(property_path) + "' on " + itos(failed) + " of " + itos(count) + " objects.");
+			}
+		} break;
+		case Variant::POOL_BYTE_ARRAY: {
+			_set_values_packed<uint8_t>(p_objects, p_values);
+		} break;
+		case Variant::POOL_INT_ARRAY: {
+			_set_values_packed<int>(p_objects, p_values);
+		} break;
+		case Variant::POOL_REAL_ARRAY: {
+			_set_values_packed<real_t>(p_objects, p_values);
+		} break;
+		case Variant::POOL_STRING_ARRAY: {
+			_set_values_packed<String>(p_objects, p_values);
+		} break;
+		case Variant::POOL_VECTOR2_ARRAY: {
+			_set_values_packed<Vector2>(p_objects, p_values);
+		} break;
+		case Variant::POOL_VECTOR3_ARRAY: {
+			_set_values_packed<Vector3>(p_objects, p_values);
+		} break;
+		case Variant::POOL_COLOR_ARRAY: {
+			_set_values_packed<Color>(p_objects, p_values);
+		} break;
+		default: {
+			ERR_FAIL_MSG("Values must be an Array or one of the pool array types.");
+		}
+	}
+}
+
+void PropertyAccessor::fill(const Array &p_objects, const Variant &p_value) {
+
+	ERR_FAIL_COND_MSG(names.empty(), "No property path set.");
+
+	int count = p_objects.size();
+	int failed = 0;
+	for (int i = 0; i < count; i++) {
+		Object *obj = _get_object(p_objects, i);
+		bool valid = false;
+		if (obj) {
+			_set_value(obj, p_value, &valid);
+		}
+		if (!valid) {
+			failed++;
+		}
+	}
+
+	if (failed) {
+		ERR_PRINT("Could not set property '" + String(property_path) + "' on " + itos(failed) + " of " + itos(count) + " objects.");
+	}
+}
+
+void PropertyAccessor::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("set_property_path", "path"), &PropertyAccessor::set_property_path);
+	ClassDB::bind_method(D_METHOD("get_property_path"), &PropertyAccessor::get_property_path);
+
+	ClassDB::bind_method(D_METHOD("get_values", "objects"), &PropertyAccessor::get_values);
+	ClassDB::bind_method(D_METHOD("get_values_packed", "objects", "array_type"), &PropertyAccessor::get_values_packed);
+	ClassDB::bind_method(D_METHOD("set_values", "objects", "values"), &PropertyAccessor::set_values);
+	ClassDB::bind_method(D_METHOD("fill", "objects", "value"), &PropertyAccessor::fill);
+
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "property_path"), "set_property_path", "get_property_path");
+}
+
+PropertyAccessor::PropertyAccessor() {
+}
@@ -0,0 +1,71 @@
+/*************************************************************************/
+/*  property_accessor.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef PROPERTY_ACCESSOR_H
+#define PROPERTY_ACCESSOR_H
+
+#include "core/reference.h"
+
+//reads and writes one property path over many objects, resolving the property only once per class
+class PropertyAccessor : public Reference {
+
+	GDCLASS(PropertyAccessor, Reference);
+
+	NodePath property_path;
+	Vector<StringName> names; //the property followed by its subnames
+	mutable MethodCallCache cache;
+
+	static void _set_subvalue(Variant &r_base, const StringName *p_names, int p_count, const Variant &p_value, bool *r_valid);
+
+	_FORCE_INLINE_ Object *_get_object(const Array &p_objects, int p_index) const;
+	_FORCE_INLINE_ Variant _get_value(Object *p_object, bool *r_valid) const;
+	_FORCE_INLINE_ void _set_value(Object *p_object, const Variant &p_value, bool *r_valid) const;
+
+	template <class T>
+	Variant _get_values_packed(const Array &p_objects) const;
+	template <class T>
+	void _set_values_packed(const Array &p_objects, const PoolVector<T> &p_values) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_property_path(const NodePath &p_path);
+	NodePath get_property_path() const;
+
+	Array get_values(const Array &p_objects) const;
+	Variant get_values_packed(const Array &p_objects, Variant::Type p_array_type) const;
+	void set_values(const Array &p_objects, const Variant &p_values);
+	void fill(const Array &p_objects, const Variant &p_value);
+
+	PropertyAccessor();
+};
+
+#endif // PROPERTY_ACCESSOR_H
@@ -55,15 +55,18 @@
 #include "core/io/translation_loader_po.h"
 #include "core/io/xml_parser.h"
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 #include "core/math/expression.h"
 #include "core/math/geometry.h"
 #include "core/math/random_number_generator.h"
 #include "core/math/triangle_mesh.h"
 #include "core/os/input.h"
 #include "core/os/main_loop.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/packed_data_container.h"
 #include "core/path_remap.h"
 #include "core/project_settings.h"
+#include "core/property_accessor.h"
 #include "core/translation.h"
 #include "core/undo_redo.h"
 
@@ -82,6 +85,7 @@ static _Engine *_engine = NULL;
 static _ClassDB *_classdb = NULL;
 static _Marshalls *_marshalls = NULL;
 static _JSON *_json = NULL;
+static WorkerThreadPool *worker_thread_pool = NULL;
 
 static IP *ip = NULL;
 
@@ -150,6 +154,7 @@ void register_core_types() {
 	ClassDB::register_class<InputEventMIDI>();
 
 	ClassDB::register_class<FuncRef>();
+	ClassDB::register_class<PropertyAccessor>();
 	ClassDB::register_virtual_class<StreamPeer>();
 	ClassDB::register_class<StreamPeerBuffer>();
 	ClassDB::register_class<StreamPeerTCP>();
@@ -201,6 +206,7 @@ void register_core_types() {
 	ClassDB::register_virtual_class<PackedDataContainerRef>();
 	ClassDB::register_class<AStar>();
 	ClassDB::register_class<AStar2D>();
+	ClassDB::register_class<AStarGrid2D>();
 	ClassDB::register_class<EncodedObjectAsID>();
 	ClassDB::register_class<RandomNumberGenerator>();
 
@@ -219,6 +225,8 @@ void register_core_types() {
 	_classdb = memnew(_ClassDB);
 	_marshalls = memnew(_Marshalls);
 	_json = memnew(_JSON);
+
+	worker_thread_pool = memnew(WorkerThreadPool);
 }
 
 void register_core_settings() {
@@ -230,6 +238,12 @@ void register_core_settings() {
 
 	GLOBAL_DEF("network/ssl/certificates", "");
 	ProjectSettings::get_singleton()->set_custom_property_info("network/ssl/certificates", PropertyInfo(Variant::STRING, "network/ssl/certificates", PROPERTY_HINT_FILE, "*.crt"));
+
+	GLOBAL_DEF("filesystem/binary_resources/lazy_load", false);
+
+	int worker_threads = GLOBAL_DEF_RST("threading/worker_pool/max_threads", -1);
+	ProjectSettings::get_singleton()->set_custom_property_info("threading/worker_pool/max_threads", PropertyInfo(Variant::INT, "threading/worker_pool/max_threads", PROPERTY_HINT_RANGE, "-1,256,1,or_greater"));
+	worker_thread_pool->init(worker_threads);
 }
 
 void register_core_singletons() {
@@ -248,6 +262,7 @@ void register_core_singletons() {
 	ClassDB::register_class<InputMap>();
 	ClassDB::register_class<_JSON>();
 	ClassDB::register_class<Expression>();
+	ClassDB::register_virtual_class<WorkerThreadPool>();
 
 	Engine::get_singleton()->add_singleton(Engine::Singleton("ProjectSettings", ProjectSettings::get_singleton()));
 	Engine::get_singleton()->add_singleton(Engine::Singleton("IP", IP::get_singleton()));
@@ -262,6 +277,7 @@ void register_core_singletons() {
 	Engine::get_singleton()->add_singleton(Engine::Singleton("Input", Input::get_singleton()));
 	Engine::get_singleton()->add_singleton(Engine::Singleton("InputMap", InputMap::get_singleton()));
 	Engine::get_singleton()->add_singleton(Engine::Singleton("JSON", _JSON::get_singleton()));
+	Engine::get_singleton()->add_singleton(Engine::Singleton("WorkerThreadPool", WorkerThreadPool::get_singleton()));
 }
 
 void unregister_core_types() {
@@ -276,6 +292,8 @@ void unregister_core_types() {
 
 	memdelete(_geometry);
 
+	memdelete(worker_thread_pool);
+
 	ResourceLoader::remove_resource_format_loader(resource_format_image);
 	resource_format_image.unref();
 
@@ -33,6 +33,7 @@
 #include "core/core_string_names.h"
 #include "core/io/resource_loader.h"
 #include "core/os/file_access.h"
+#include "core/os/os.h"
 #include "core/script_language.h"
 #include "scene/main/node.h" //only so casting works
 
@@ -151,6 +152,8 @@ void Resource::reload_from_file() {
 
 Ref<Resource> Resource::duplicate_for_local_scene(Node *p_for_scene, Map<Ref<Resource>, Ref<Resource> > &remap_cache) {
 
+	ensure_loaded();
+
 	List<PropertyInfo> plist;
 	get_property_list(&plist);
 
@@ -218,8 +221,16 @@ void Resource::configure_for_local_scene(Node *p_for_scene, Map<Ref<Resource>, R
 	}
 }
 
+void Resource::set_deferred_data(ResourceDeferredData *p_data) {
+
+	ERR_FAIL_COND(deferred_data);
+	deferred_data = p_data;
+}
+
 Ref<Resource> Resource::duplicate(bool p_subresources) const {
 
+	const_cast<Resource *>(this)->ensure_loaded();
+
 	List<PropertyInfo> plist;
 	get_property_list(&plist);
 
@@ -439,10 +450,15 @@ Resource::Resource() :
 	subindex = 0;
 	local_to_scene = false;
 	local_scene = NULL;
+	deferred_data = NULL;
 }
 
 Resource::~Resource() {
 
+	if (deferred_data) {
+		memdelete(deferred_data);
+	}
+
 	if (path_cache != "") {
 		ResourceCache::lock->write_lock();
 		ResourceCache::resources.erase(path_cache);
@@ -463,20 +479,138 @@ RWLock *ResourceCache::lock = NULL;
 RWLock *ResourceCache::path_cache_lock = NULL;
 #endif
 
+Mutex *ResourceCache::soft_cache_mutex = NULL;
+List<ResourceCache::SoftCacheEntry> ResourceCache::soft_cache;
+HashMap<ObjectID, List<ResourceCache::SoftCacheEntry>::Element *> ResourceCache::soft_cache_map;
+uint64_t ResourceCache::soft_cache_budget = 0;
+uint64_t ResourceCache::soft_cache_last_trim = 0;
+bool ResourceCache::soft_cache_dirty = false;
+
 void ResourceCache::setup() {
 
 	lock = RWLock::create();
 #ifdef TOOLS_ENABLED
 	path_cache_lock = RWLock::create();
 #endif
+	soft_cache_mutex = Mutex::create();
 }
 
 void ResourceCache::clear() {
+	clear_soft_cache();
+
 	if (resources.size())
 		ERR_PRINT("Resources Still in use at Exit!");
 
 	resources.clear();
 	memdelete(lock);
+	if (soft_cache_mutex) {
+		memdelete(soft_cache_mutex);
+		soft_cache_mutex = NULL;
+	}
+}
+
+void ResourceCache::set_soft_cache_budget(uint64_t p_bytes) {
+
+	soft_cache_budget = p_bytes;
+	if (p_bytes == 0) {
+		clear_soft_cache();
+	} else {
+		soft_cache_trim(true);
+	}
+}
+
+void ResourceCache::soft_cache_touch(const Ref<Resource> &p_resource) {
+
+	if (soft_cache_budget == 0 || p_resource.is_null()) {
+		return;
+	}
+
+	MutexLock lock(soft_cache_mutex);
+
+	List<SoftCacheEntry>::Element **E = soft_cache_map.getptr(p_resource->get_instance_id());
+	if (E) {
+		soft_cache.move_to_front(*E);
+		return;
+	}
+
+	SoftCacheEntry entry;
+	entry.resource = p_resource;
+	//resources not reporting their size still count, so their number stays bounded
+	entry.memory = MAX(p_resource->get_memory_usage(), (uint64_t)1024);
+	soft_cache_map[p_resource->get_instance_id()] = soft_cache.push_front(entry);
+	soft_cache_dirty = true;
+}
+
+void ResourceCache::soft_cache_trim(bool p_force) {
+
+	if (!soft_cache_mutex || soft_cache.empty()) {
+		return;
+	}
+
+	//resources get released without the cache knowing, so look at it once in a while even if nothing was loaded
+	uint64_t ticks = OS::get_singleton()->get_ticks_msec();
+	if (!p_force && !soft_cache_dirty && ticks - soft_cache_last_trim < 1000) {
+		return;
+	}
+
+	Vector<Ref<Resource> > evicted;
+
+	soft_cache_mutex->lock();
+
+	soft_cache_dirty = false;
+	soft_cache_last_trim = ticks;
+
+	//keep the most recently used of the released resources that fit the budget
+	uint64_t retained = 0;
+	List<SoftCacheEntry>::Element *E = soft_cache.front();
+	while (E) {
+		List<SoftCacheEntry>::Element *N = E->next();
+		if (E->get().resource->reference_get_count() == 1) {
+			if (retained + E->get().memory > soft_cache_budget) {
+				evicted.push_back(E->get().resource);
+				soft_cache_map.erase(E->get().resource->get_instance_id());
+				soft_cache.erase(E);
+			} else {
+				retained += E->get().memory;
+			}
+		}
+		E = N;
+	}
+
+	soft_cache_mutex->unlock();
+
+	//the last references go away here, outside the lock
+	evicted.clear();
+}
+
+uint64_t ResourceCache::get_soft_cache_retained_memory() {
+
+	MutexLock lock(soft_cache_mutex);
+
+	uint64_t retained = 0;
+	for (List<SoftCacheEntry>::Element *E = soft_cache.front(); E; E = E->next()) {
+		if (E->get().resource->reference_get_count() == 1) {
+			retained += E->get().memory;
+		}
+	}
+	return retained;
+}
+
+void ResourceCache::clear_soft_cache() {
+
+	List<SoftCacheEntry> entries;
+
+	if (soft_cache_mutex) {
+		soft_cache_mutex->lock();
+	}
+	entries = soft_cache;
+	soft_cache.clear();
+	soft_cache_map.clear();
+	if (soft_cache_mutex) {
+		soft_cache_mutex->unlock();
+	}
+
+	entries.clear();
 }
 
 void ResourceCache::reload_externals() {
@@ -33,6 +33,7 @@
 
 #include "core/class_db.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
 #include "core/ref_ptr.h"
 #include "core/reference.h"
 #include "core/safe_refcount.h"
@@ -45,6 +46,20 @@ public:
                                                                                                                     \
 private:
 
+class Resource;
+
+//set by loaders that postpone reading the contents of a resource until it's first needed
+class ResourceDeferredData {
+protected:
+	SafeFlag loaded;
+
+public:
+	_FORCE_INLINE_ bool is_loaded() const { return loaded.is_set(); }
+	virtual void load(Resource *p_resource) = 0; //must be safe to call from several threads, only the first call reads
+
+	virtual ~ResourceDeferredData() {}
+};
+
 class Resource : public Reference {
 
 	GDCLASS(Resource, Reference);
@@ -74,6 +89,8 @@ class Resource : public Reference {
 
 	SelfList<Resource> remapped_list;
 
+	ResourceDeferredData *deferred_data;
+
 protected:
 	void emit_changed();
 
@@ -132,6 +149,16 @@ public:
 	bool is_translation_remapped() const;
 
 	virtual RID get_rid() const; // some resources may offer conversion to RID
+	virtual uint64_t get_memory_usage() const { return 0; } // estimate of the bytes owned by the resource, including server side data
+
+	//lazy loading, only types whose users call ensure_loaded() before touching the data may opt in
+	virtual bool is_lazy_load_supported() const { return false; }
+	void set_deferred_data(ResourceDeferredData *p_data);
+	_FORCE_INLINE_ bool is_load_deferred() const { return deferred_data && !deferred_data->is_loaded(); }
+	_FORCE_INLINE_ void ensure_loaded() {
+		if (deferred_data && !deferred_data->is_loaded())
+			deferred_data->load(this);
+	}
 
 #ifdef TOOLS_ENABLED
 	//helps keep IDs same number when loading/saving scenes. -1 clears ID and it Returns -1 when no id stored
@@ -159,6 +186,20 @@ class ResourceCache {
 	friend void register_core_types();
 	static void setup();
 
+	//soft cache: keeps recently used resources alive once nothing else references
+	//them, as long as their memory fits the budget
+	struct SoftCacheEntry {
+		Ref<Resource> resource;
+		uint64_t memory;
+	};
+
+	static Mutex *soft_cache_mutex;
+	static List<SoftCacheEntry> soft_cache; //most recently used first
+	static HashMap<ObjectID, List<SoftCacheEntry>::Element *> soft_cache_map;
+	static uint64_t soft_cache_budget;
+	static uint64_t soft_cache_last_trim;
+	static bool soft_cache_dirty;
+
 public:
 	static void reload_externals();
 	static bool has(const String &p_path);
@@ -166,6 +207,13 @@ public:
 	static void dump(const char *p_file = NULL, bool p_short = false);
 	static void get_cached_resources(List<Ref<Resource> > *p_resources);
 	static int get_cached_resource_count();
+
+	static void set_soft_cache_budget(uint64_t p_bytes); //0 disables the soft cache
+	static uint64_t get_soft_cache_budget() { return soft_cache_budget; }
+	static void soft_cache_touch(const Ref<Resource> &p_resource);
+	static void soft_cache_trim(bool p_force = false);
+	static uint64_t get_soft_cache_retained_memory(); //memory of the resources kept alive only by the soft cache
+	static void clear_soft_cache();
 };
 
 #endif
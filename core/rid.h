@@ -103,6 +103,13 @@ protected:
 #endif
 	}
 
+	//an RID for data that already has one, its id is kept
+	_FORCE_INLINE_ static RID _get_rid(RID_Data *p_data) {
+		RID rid;
+		rid._data = p_data;
+		return rid;
+	}
+
 #ifndef DEBUG_ENABLED
 
 	_FORCE_INLINE_ bool _is_owner(const RID &p_rid) const {
@@ -201,4 +208,234 @@ public:
 	}
 };
 
+/**
+ * RID_Owner variant that stores the objects in its own chunks instead of allocating each one.
+ *
+ * Objects are constructed in place by make_rid() and destroyed by free(), so they must not be
+ * memnew'd or memdelete'd by the caller. Freed slots are reused.
+ *
+ * Validation finds the chunk an RID points into (a binary search over the few chunks) and
+ * checks the slot is in use, so unlike the Set of RID_Owner it costs no per-RID lookup and
+ * rejects RIDs of other owners without reading their memory. Live objects can be walked
+ * in storage order with get_slot().
+ *
+ * RIDs stay pointer sized (that's what GDNative exposes), so the slot is derived from the
+ * address and a RID whose slot was freed and reused can't be told apart from the new one.
+ */
+template <class T>
+class RID_ChunkedOwner : public RID_OwnerBase {
+
+	enum {
+		CHUNK_BYTES = 64 * 1024,
+	};
+
+	struct Chunk {
+		T *objects;
+		uint8_t *used;
+	};
+
+	struct ChunkRange {
+		const uint8_t *begin;
+		const uint8_t *end;
+		uint32_t chunk;
+	};
+
+	Chunk *chunks;
+	ChunkRange *ranges; //sorted by address, for validation
+	uint32_t chunk_count;
+	uint32_t elements_per_chunk;
+
+	uint32_t *free_slots;
+	uint32_t free_count;
+	uint32_t alloc_count;
+
+	_FORCE_INLINE_ bool _find_slot(const RID_Data *p_data, uint32_t &r_slot) const {
+
+		if (!p_data || !chunk_count) {
+			return false;
+		}
+
+		const uint8_t *address = (const uint8_t *)static_cast<const T *>(p_data);
+
+		//last range starting at or before the address
+		uint32_t low = 0;
+		uint32_t high = chunk_count;
+		while (high - low > 1) {
+			uint32_t middle = (low + high) / 2;
+			if (ranges[middle].begin <= address) {
+				low = middle;
+			} else {
+				high = middle;
+			}
+		}
+
+		const ChunkRange &range = ranges[low];
+		if (address < range.begin || address >= range.end) {
+			return false;
+		}
+
+		size_t offset = address - range.begin;
+		if (offset % sizeof(T) != 0) {
+			return false;
+		}
+
+		uint32_t index = offset / sizeof(T);
+		if (!chunks[range.chunk].used[index]) {
+			return false;
+		}
+
+		r_slot = range.chunk * elements_per_chunk + index;
+		return true;
+	}
+
+	void _grow() {
+
+		Chunk chunk;
+		chunk.objects = (T *)memalloc(sizeof(T) * elements_per_chunk);
+		chunk.used = (uint8_t *)memalloc(elements_per_chunk);
+		for (uint32_t i = 0; i < elements_per_chunk; i++) {
+			chunk.used[i] = 0;
+		}
+
+		chunks = (Chunk *)memrealloc(chunks, sizeof(Chunk) * (chunk_count + 1));
+		chunks[chunk_count] = chunk;
+
+		ChunkRange range;
+		range.begin = (const uint8_t *)chunk.objects;
+		range.end = range.begin + sizeof(T) * elements_per_chunk;
+		range.chunk = chunk_count;
+
+		ranges = (ChunkRange *)memrealloc(ranges, sizeof(ChunkRange) * (chunk_count + 1));
+		uint32_t pos = chunk_count;
+		while (pos > 0 && ranges[pos - 1].begin > range.begin) {
+			ranges[pos] = ranges[pos - 1];
+			pos--;
+		}
+		ranges[pos] = range;
+
+		//pushed backwards so the lowest slots are handed out first
+		free_slots = (uint32_t *)memrealloc(free_slots, sizeof(uint32_t) * (chunk_count + 1) * elements_per_chunk);
+		for (uint32_t i = 0; i < elements_per_chunk; i++) {
+			free_slots[free_count++] = chunk_count * elements_per_chunk + elements_per_chunk - i - 1;
+		}
+
+		chunk_count++;
+	}
+
+	_FORCE_INLINE_ T *_get_slot_object(uint32_t p_slot) const {
+
+		return &chunks[p_slot / elements_per_chunk].objects[p_slot % elements_per_chunk];
+	}
+
+public:
+	RID make_rid() {
+
+		if (free_count == 0) {
+			_grow();
+		}
+
+		uint32_t slot = free_slots[--free_count];
+		T *object = memnew_placement(_get_slot_object(slot), T);
+		chunks[slot / elements_per_chunk].used[slot % elements_per_chunk] = 1;
+		alloc_count++;
+
+		RID rid;
+		_set_data(rid, object);
+		return rid;
+	}
+
+	_FORCE_INLINE_ T *get(const RID &p_rid) {
+
+#ifdef DEBUG_ENABLED
+
+		ERR_FAIL_COND_V(!p_rid.is_valid(), NULL);
+		uint32_t slot;
+		ERR_FAIL_COND_V(!_find_slot(p_rid.get_data(), slot), NULL);
+#endif
+		return static_cast<T *>(p_rid.get_data());
+	}
+
+	_FORCE_INLINE_ T *getornull(const RID &p_rid) {
+
+#ifdef DEBUG_ENABLED
+
+		if (p_rid.get_data()) {
+			uint32_t slot;
+			ERR_FAIL_COND_V(!_find_slot(p_rid.get_data(), slot), NULL);
+		}
+#endif
+		return static_cast<T *>(p_rid.get_data());
+	}
+
+	_FORCE_INLINE_ T *getptr(const RID &p_rid) {
+
+		return static_cast<T *>(p_rid.get_data());
+	}
+
+	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
+
+		uint32_t slot;
+		return _find_slot(p_rid.get_data(), slot);
+	}
+
+	void free(RID p_rid) {
+
+		uint32_t slot;
+		ERR_FAIL_COND(!_find_slot(p_rid.get_data(), slot));
+
+		_get_slot_object(slot)->~T();
+		chunks[slot / elements_per_chunk].used[slot % elements_per_chunk] = 0;
+		free_slots[free_count++] = slot;
+		alloc_count--;
+	}
+
+	_FORCE_INLINE_ uint32_t get_rid_count() const { return alloc_count; }
+
+	//slots are laid out contiguously per chunk, get_slot() returns NULL for the unused ones
+	_FORCE_INLINE_ uint32_t get_slot_count() const { return chunk_count * elements_per_chunk; }
+	_FORCE_INLINE_ T *get_slot(uint32_t p_slot) const {
+
+		ERR_FAIL_UNSIGNED_INDEX_V(p_slot, get_slot_count(), NULL);
+		if (!chunks[p_slot / elements_per_chunk].used[p_slot % elements_per_chunk]) {
+			return NULL;
+		}
+		return _get_slot_object(p_slot);
+	}
+
+	void get_owned_list(List<RID> *p_owned) {
+
+		for (uint32_t i = 0; i < get_slot_count(); i++) {
+			T *object = get_slot(i);
+			if (object) {
+				p_owned->push_back(_get_rid(object));
+			}
+		}
+	}
+
+	RID_ChunkedOwner() {
+
+		chunks = NULL;
+		ranges = NULL;
+		chunk_count = 0;
+		elements_per_chunk = MAX((size_t)1, CHUNK_BYTES / sizeof(T));
+		free_slots = NULL;
+		free_count = 0;
+		alloc_count = 0;
+	}
+
+	~RID_ChunkedOwner() {
+
+		//like RID_Owner, objects still alive at this point are not destroyed, only their memory is released
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			memfree(chunks[i].objects);
+			memfree(chunks[i].used);
+		}
+		if (chunks) {
+			memfree(chunks);
+			memfree(ranges);
+			memfree(free_slots);
+		}
+	}
+};
+
 #endif
@@ -129,6 +129,13 @@ public:
 		return -1;
 	}
 
+	// Returns the next p_size elements in place if they can be read without wrapping around, NULL otherwise.
+	inline const T *get_read_ptr(int p_size) const {
+		if (p_size > data_left() || read_pos + p_size > size())
+			return NULL;
+		return data.ptr() + read_pos;
+	};
+
 	inline int advance_read(int p_n) {
 		p_n = MIN(p_n, data_left());
 		inc(read_pos, p_n);
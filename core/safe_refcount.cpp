@@ -166,4 +166,54 @@ uint64_t atomic_add(volatile uint64_t *pw, volatile uint64_t val) {
 uint64_t atomic_exchange_if_greater(volatile uint64_t *pw, volatile uint64_t val) {
 	return _atomic_exchange_if_greater_impl(pw, val);
 }
+
+// Interlocked functions are full barriers, which covers the acquire and release the others promise.
+
+uint32_t atomic_read(const volatile uint32_t *pw) {
+	return InterlockedCompareExchange((LONG volatile *)pw, 0, 0);
+}
+
+void atomic_write(volatile uint32_t *pw, volatile uint32_t val) {
+	InterlockedExchange((LONG volatile *)pw, val);
+}
+
+uint32_t atomic_swap(volatile uint32_t *pw, volatile uint32_t val) {
+	return InterlockedExchange((LONG volatile *)pw, val);
+}
+
+uint32_t atomic_compare_and_swap(volatile uint32_t *pw, volatile uint32_t expected, volatile uint32_t val) {
+	return InterlockedCompareExchange((LONG volatile *)pw, val, expected);
+}
+
+uint64_t atomic_read(const volatile uint64_t *pw) {
+	return InterlockedCompareExchange64((LONGLONG volatile *)pw, 0, 0);
+}
+
+void atomic_write(volatile uint64_t *pw, volatile uint64_t val) {
+	InterlockedExchange64((LONGLONG volatile *)pw, val);
+}
+
+uint64_t atomic_swap(volatile uint64_t *pw, volatile uint64_t val) {
+	return InterlockedExchange64((LONGLONG volatile *)pw, val);
+}
+
+uint64_t atomic_compare_and_swap(volatile uint64_t *pw, volatile uint64_t expected, volatile uint64_t val) {
+	return InterlockedCompareExchange64((LONGLONG volatile *)pw, val, expected);
+}
+
+void *atomic_read(void *const volatile *pw) {
+	return InterlockedCompareExchangePointer((PVOID volatile *)pw, NULL, NULL);
+}
+
+void atomic_write(void *volatile *pw, void *val) {
+	InterlockedExchangePointer((PVOID volatile *)pw, val);
+}
+
+void *atomic_swap(void *volatile *pw, void *val) {
+	return InterlockedExchangePointer((PVOID volatile *)pw, val);
+}
+
+void *atomic_compare_and_swap(void *volatile *pw, void *expected, void *val) {
+	return InterlockedCompareExchangePointer((PVOID volatile *)pw, val, expected);
+}
 #endif
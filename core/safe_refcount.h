@@ -93,6 +93,35 @@ static _ALWAYS_INLINE_ T atomic_exchange_if_greater(volatile T *pw, volatile V v
 	return *pw;
 }
 
+template <class T>
+static _ALWAYS_INLINE_ T atomic_read(const volatile T *pw) {
+
+	return *pw;
+}
+
+template <class T, class V>
+static _ALWAYS_INLINE_ void atomic_write(volatile T *pw, volatile V val) {
+
+	*pw = val;
+}
+
+template <class T, class V>
+static _ALWAYS_INLINE_ T atomic_swap(volatile T *pw, volatile V val) {
+
+	T tmp = *pw;
+	*pw = val;
+	return tmp;
+}
+
+template <class T, class V>
+static _ALWAYS_INLINE_ T atomic_compare_and_swap(volatile T *pw, volatile V expected, volatile V val) {
+
+	T tmp = *pw;
+	if (tmp == expected)
+		*pw = val;
+	return tmp;
+}
+
 #elif defined(__GNUC__)
 
 /* Implementation for GCC & Clang */
@@ -148,6 +177,33 @@ static _ALWAYS_INLINE_ T atomic_exchange_if_greater(volatile T *pw, volatile V v
 	}
 }
 
+// Reads acquire, writes release and swaps do both.
+
+template <class T>
+static _ALWAYS_INLINE_ T atomic_read(const volatile T *pw) {
+
+	return __atomic_load_n(pw, __ATOMIC_ACQUIRE);
+}
+
+template <class T, class V>
+static _ALWAYS_INLINE_ void atomic_write(volatile T *pw, volatile V val) {
+
+	__atomic_store_n(pw, (T)val, __ATOMIC_RELEASE);
+}
+
+template <class T, class V>
+static _ALWAYS_INLINE_ T atomic_swap(volatile T *pw, volatile V val) {
+
+	return __atomic_exchange_n(pw, (T)val, __ATOMIC_ACQ_REL);
+}
+
+// Returns the previous value, the swap happened if it equals expected.
+template <class T, class V>
+static _ALWAYS_INLINE_ T atomic_compare_and_swap(volatile T *pw, volatile V expected, volatile V val) {
+
+	return __sync_val_compare_and_swap(pw, (T)expected, (T)val);
+}
+
 #elif defined(_MSC_VER)
 // For MSVC use a separate compilation unit to prevent windows.h from polluting
 // the global namespace.
@@ -165,6 +221,21 @@ uint64_t atomic_sub(volatile uint64_t *pw, volatile uint64_t val);
 uint64_t atomic_add(volatile uint64_t *pw, volatile uint64_t val);
 uint64_t atomic_exchange_if_greater(volatile uint64_t *pw, volatile uint64_t val);
 
+uint32_t atomic_read(const volatile uint32_t *pw);
+void atomic_write(volatile uint32_t *pw, volatile uint32_t val);
+uint32_t atomic_swap(volatile uint32_t *pw, volatile uint32_t val);
+uint32_t atomic_compare_and_swap(volatile uint32_t *pw, volatile uint32_t expected, volatile uint32_t val);
+
+uint64_t atomic_read(const volatile uint64_t *pw);
+void atomic_write(volatile uint64_t *pw, volatile uint64_t val);
+uint64_t atomic_swap(volatile uint64_t *pw, volatile uint64_t val);
+uint64_t atomic_compare_and_swap(volatile uint64_t *pw, volatile uint64_t expected, volatile uint64_t val);
+
+void *atomic_read(void *const volatile *pw);
+void atomic_write(void *volatile *pw, void *val);
+void *atomic_swap(void *volatile *pw, void *val);
+void *atomic_compare_and_swap(void *volatile *pw, void *expected, void *val);
+
 #else
 //no threads supported?
 #error Must provide atomic functions for this platform or compiler!
@@ -208,4 +279,59 @@ public:
 	}
 };
 
+// Values shared between threads without a lock, so they can't be accessed non-atomically by mistake.
+// T must be uint32_t or uint64_t. Copying is not atomic, just like SafeRefCount.
+
+template <class T>
+class SafeNumeric {
+
+	T value;
+
+public:
+	_ALWAYS_INLINE_ T get() const { return atomic_read(&value); }
+	_ALWAYS_INLINE_ void set(T p_value) { atomic_write(&value, p_value); }
+	_ALWAYS_INLINE_ T exchange(T p_value) { return atomic_swap(&value, p_value); }
+	_ALWAYS_INLINE_ bool compare_exchange(T p_expected, T p_value) { return atomic_compare_and_swap(&value, p_expected, p_value) == p_expected; }
+
+	// These return the new value.
+	_ALWAYS_INLINE_ T increment() { return atomic_increment(&value); }
+	_ALWAYS_INLINE_ T decrement() { return atomic_decrement(&value); }
+	_ALWAYS_INLINE_ T add(T p_value) { return atomic_add(&value, p_value); }
+	_ALWAYS_INLINE_ T sub(T p_value) { return atomic_sub(&value, p_value); }
+	_ALWAYS_INLINE_ T exchange_if_greater(T p_value) { return atomic_exchange_if_greater(&value, p_value); }
+
+	explicit SafeNumeric(T p_value = 0) :
+			value(p_value) {}
+};
+
+class SafeFlag {
+
+	uint32_t flag;
+
+public:
+	_ALWAYS_INLINE_ bool is_set() const { return atomic_read(&flag) != 0; }
+	_ALWAYS_INLINE_ void set() { atomic_write(&flag, (uint32_t)1); }
+	_ALWAYS_INLINE_ void clear() { atomic_write(&flag, (uint32_t)0); }
+	_ALWAYS_INLINE_ void set_to(bool p_value) { atomic_write(&flag, (uint32_t)p_value); }
+	_ALWAYS_INLINE_ bool test_and_set() { return atomic_swap(&flag, (uint32_t)1) != 0; } // returns the previous state
+
+	explicit SafeFlag(bool p_value = false) :
+			flag(p_value) {}
+};
+
+template <class T>
+class SafePointer {
+
+	void *pointer;
+
+public:
+	_ALWAYS_INLINE_ T *get() const { return (T *)atomic_read(&pointer); }
+	_ALWAYS_INLINE_ void set(T *p_pointer) { atomic_write(&pointer, (void *)p_pointer); }
+	_ALWAYS_INLINE_ T *exchange(T *p_pointer) { return (T *)atomic_swap(&pointer, (void *)p_pointer); }
+	_ALWAYS_INLINE_ bool compare_exchange(T *p_expected, T *p_pointer) { return atomic_compare_and_swap(&pointer, (void *)p_expected, (void *)p_pointer) == (void *)p_expected; }
+
+	explicit SafePointer(T *p_pointer = NULL) :
+			pointer((void *)p_pointer) {}
+};
+
 #endif
@@ -32,6 +32,7 @@
 #define SORT_ARRAY_H
 
 #include "core/error_macros.h"
+#include "core/os/copymem.h"
 #include "core/typedefs.h"
 
 #define ERR_BAD_COMPARE(cond)                                         \
@@ -328,4 +329,83 @@ public:
 	}
 };
 
+template <class T, class KeyGetter>
+struct _RadixKeyComparator {
+
+	KeyGetter get_key;
+
+	_FORCE_INLINE_ bool operator()(const T &a, const T &b) const { return get_key(a) < get_key(b); }
+};
+
+/**
+ * Stable LSD radix sort for elements ordered by an unsigned 64 bits key, such as render list sort keys.
+ * KeyGetter must provide uint64_t operator()(const T &) const. Bytes that are the same in every key
+ * are skipped, so keys which only use some of their bits cost fewer passes.
+ */
+template <class T, class KeyGetter>
+class RadixSortArray {
+
+	enum {
+
+		RADIX_THRESHOLD = 256 // below this, comparison sorting is faster
+	};
+
+public:
+	KeyGetter get_key;
+
+	// p_scratch must have room for p_len elements, it is used as the destination of every other pass
+	void sort(T *p_array, int p_len, T *p_scratch) const {
+
+		if (p_len < RADIX_THRESHOLD) {
+			SortArray<T, _RadixKeyComparator<T, KeyGetter> > sorter;
+			sorter.compare.get_key = get_key;
+			sorter.sort(p_array, p_len);
+			return;
+		}
+
+		uint32_t histograms[8][256];
+		zeromem(histograms, sizeof(histograms));
+
+		for (int i = 0; i < p_len; i++) {
+			uint64_t key = get_key(p_array[i]);
+			for (int b = 0; b < 8; b++) {
+				histograms[b][(key >> (b * 8)) & 0xFF]++;
+			}
+		}
+
+		T *src = p_array;
+		T *dst = p_scratch;
+		uint64_t first_key = get_key(p_array[0]);
+
+		for (int b = 0; b < 8; b++) {
+
+			uint32_t *offsets = histograms[b];
+			int shift = b * 8;
+
+			if (offsets[(first_key >> shift) & 0xFF] == (uint32_t)p_len) {
+				continue; // all keys share this byte
+			}
+
+			uint32_t total = 0;
+			for (int i = 0; i < 256; i++) {
+				uint32_t count = offsets[i];
+				offsets[i] = total;
+				total += count;
+			}
+
+			for (int i = 0; i < p_len; i++) {
+				dst[offsets[(get_key(src[i]) >> shift) & 0xFF]++] = src[i];
+			}
+
+			SWAP(src, dst);
+		}
+
+		if (src != p_array) {
+			for (int i = 0; i < p_len; i++) {
+				p_array[i] = src[i];
+			}
+		}
+	}
+};
+
 #endif // SORT_ARRAY_H
@@ -39,7 +39,7 @@ StaticCString StaticCString::create(const char *p_ptr) {
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+StringName::_Shard StringName::_shards[STRING_TABLE_SHARDS];
 
 StringName _scs_create(const char *p_chr) {
 
@@ -47,49 +47,121 @@ StringName _scs_create(const char *p_chr) {
 }
 
 bool StringName::configured = false;
-Mutex *StringName::lock = NULL;
 
 void StringName::setup() {
 
-	lock = Mutex::create();
-
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-
-		_table[i] = NULL;
+	for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+
+		_Shard &shard = _shards[i];
+		shard.lock = Mutex::create();
+		shard.mask = (1 << STRING_TABLE_MIN_BITS) - 1;
+		shard.count = 0;
+		shard.table = memnew_arr(_Data *, shard.mask + 1);
+		for (uint32_t j = 0; j <= shard.mask; j++) {
+			shard.table[j] = NULL;
+		}
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
 
-	lock->lock();
-
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
+	for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+
+		_Shard &shard = _shards[i];
+		shard.lock->lock();
 
-		while (_table[i]) {
+		for (uint32_t j = 0; j <= shard.mask; j++) {
 
-			_Data *d = _table[i];
-			lost_strings++;
-			if (OS::get_singleton()->is_stdout_verbose()) {
-				if (d->cname) {
-					print_line("Orphan StringName: " + String(d->cname));
-				} else {
-					print_line("Orphan StringName: " + String(d->name));
+			while (shard.table[j]) {
+
+				_Data *d = shard.table[j];
+				lost_strings++;
+				if (OS::get_singleton()->is_stdout_verbose()) {
+					if (d->cname) {
+						print_line("Orphan StringName: " + String(d->cname));
+					} else {
+						print_line("Orphan StringName: " + String(d->name));
+					}
 				}
-			}
 
-			_table[i] = _table[i]->next;
-			memdelete(d);
+				shard.table[j] = shard.table[j]->next;
+				memdelete(d);
+			}
 		}
+
+		memdelete_arr(shard.table);
+		shard.table = NULL;
+		shard.count = 0;
+		shard.lock->unlock();
+
+		memdelete(shard.lock);
+		shard.lock = NULL;
 	}
 	if (lost_strings) {
 		print_verbose("StringName: " + itos(lost_strings) + " unclaimed string names at exit.");
 	}
-	lock->unlock();
 
-	memdelete(lock);
+	//names held by statics (e.g. SNAME) are released after this, they must not touch the table
+	configured = false;
+}
+
+template <class T>
+StringName::_Data *StringName::_find(_Shard &p_shard, uint32_t p_hash, const T &p_name) {
+
+	_Data *d = p_shard.table[p_hash & p_shard.mask];
+
+	while (d) {
+
+		// compare hash first
+		if (d->hash == p_hash && d->get_name() == p_name)
+			break;
+		d = d->next;
+	}
+
+	return d;
+}
+
+void StringName::_insert(_Shard &p_shard, _Data *p_data) {
+
+	if (p_shard.count > p_shard.mask) {
+
+		//more names than buckets, double the table
+		uint32_t new_mask = (p_shard.mask << 1) | 1;
+		_Data **new_table = memnew_arr(_Data *, new_mask + 1);
+		for (uint32_t i = 0; i <= new_mask; i++) {
+			new_table[i] = NULL;
+		}
+
+		for (uint32_t i = 0; i <= p_shard.mask; i++) {
+
+			_Data *d = p_shard.table[i];
+			while (d) {
+				_Data *next = d->next;
+				uint32_t idx = d->hash & new_mask;
+				d->prev = NULL;
+				d->next = new_table[idx];
+				if (new_table[idx])
+					new_table[idx]->prev = d;
+				new_table[idx] = d;
+				d = next;
+			}
+		}
+
+		memdelete_arr(p_shard.table);
+		p_shard.table = new_table;
+		p_shard.mask = new_mask;
+	}
+
+	uint32_t idx = p_data->hash & p_shard.mask;
+	p_data->next = p_shard.table[idx];
+	p_data->prev = NULL;
+	if (p_shard.table[idx])
+		p_shard.table[idx]->prev = p_data;
+	p_shard.table[idx] = p_data;
+	p_shard.count++;
 }
 
 void StringName::unref() {
@@ -98,22 +170,25 @@ void StringName::unref() {
 
 	if (_data && _data->refcount.unref()) {
 
-		lock->lock();
+		_Shard &shard = _get_shard(_data->hash);
+		shard.lock->lock();
 
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			if (_table[_data->idx] != _data) {
+			uint32_t idx = _data->hash & shard.mask;
+			if (shard.table[idx] != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			shard.table[idx] = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
+		shard.count--;
 		memdelete(_data);
-		lock->unlock();
+		shard.lock->unlock();
 	}
 
 	_data = NULL;
@@ -184,26 +259,17 @@ StringName::StringName(const char *p_name) {
 	if (!p_name || p_name[0] == 0)
 		return; //empty, ignore
 
-	lock->lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Shard &shard = _get_shard(hash);
+	shard.lock->lock();
 
-	_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
+	_data = _find(shard, hash, p_name);
 
 	if (_data) {
 		if (_data->refcount.ref()) {
 			// exists
-			lock->unlock();
+			shard.lock->unlock();
 			return;
 		}
 	}
@@ -212,15 +278,10 @@ StringName::StringName(const char *p_name) {
 	_data->name = p_name;
 	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_insert(shard, _data);
 
-	lock->unlock();
+	shard.lock->unlock();
 }
 
 StringName::StringName(const StaticCString &p_static_string) {
@@ -231,26 +292,26 @@ StringName::StringName(const StaticCString &p_static_string) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	lock->lock();
+	*this = StringName(p_static_string, String::hash(p_static_string.ptr));
+}
 
-	uint32_t hash = String::hash(p_static_string.ptr);
+StringName::StringName(const StaticCString &p_static_string, uint32_t p_hash) {
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_data = NULL;
 
-	_data = _table[idx];
+	ERR_FAIL_COND(!configured);
 
-	while (_data) {
+	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr)
-			break;
-		_data = _data->next;
-	}
+	_Shard &shard = _get_shard(p_hash);
+	shard.lock->lock();
+
+	_data = _find(shard, p_hash, p_static_string.ptr);
 
 	if (_data) {
 		if (_data->refcount.ref()) {
 			// exists
-			lock->unlock();
+			shard.lock->unlock();
 			return;
 		}
 	}
@@ -258,16 +319,11 @@ StringName::StringName(const StaticCString &p_static_string) {
 	_data = memnew(_Data);
 
 	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
+	_data->hash = p_hash;
 	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_insert(shard, _data);
 
-	lock->unlock();
+	shard.lock->unlock();
 }
 
 StringName::StringName(const String &p_name) {
@@ -279,25 +335,17 @@ StringName::StringName(const String &p_name) {
 	if (p_name == String())
 		return;
 
-	lock->lock();
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
+	_Shard &shard = _get_shard(hash);
+	shard.lock->lock();
 
-	while (_data) {
-
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
+	_data = _find(shard, hash, p_name);
 
 	if (_data) {
 		if (_data->refcount.ref()) {
 			// exists
-			lock->unlock();
+			shard.lock->unlock();
 			return;
 		}
 	}
@@ -306,15 +354,10 @@ StringName::StringName(const String &p_name) {
 	_data->name = p_name;
 	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_insert(shard, _data);
 
-	lock->unlock();
+	shard.lock->unlock();
 }
 
 StringName StringName::search(const char *p_name) {
@@ -325,29 +368,20 @@ StringName StringName::search(const char *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	lock->lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Shard &shard = _get_shard(hash);
+	shard.lock->lock();
 
-	_Data *_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
+	_Data *_data = _find(shard, hash, p_name);
 
 	if (_data && _data->refcount.ref()) {
-		lock->unlock();
+		shard.lock->unlock();
 
 		return StringName(_data);
 	}
 
-	lock->unlock();
+	shard.lock->unlock();
 	return StringName(); //does not exist
 }
 
@@ -359,56 +393,38 @@ StringName StringName::search(const CharType *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	lock->lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
+	_Shard &shard = _get_shard(hash);
+	shard.lock->lock();
 
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
+	_Data *_data = _find(shard, hash, p_name);
 
 	if (_data && _data->refcount.ref()) {
-		lock->unlock();
+		shard.lock->unlock();
 		return StringName(_data);
 	}
 
-	lock->unlock();
+	shard.lock->unlock();
 	return StringName(); //does not exist
 }
 StringName StringName::search(const String &p_name) {
 
 	ERR_FAIL_COND_V(p_name == "", StringName());
 
-	lock->lock();
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
+	_Shard &shard = _get_shard(hash);
+	shard.lock->lock();
 
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name())
-			break;
-		_data = _data->next;
-	}
+	_Data *_data = _find(shard, hash, p_name);
 
 	if (_data && _data->refcount.ref()) {
-		lock->unlock();
+		shard.lock->unlock();
 		return StringName(_data);
 	}
 
-	lock->unlock();
+	shard.lock->unlock();
 	return StringName(); //does not exist
 }
 
@@ -419,5 +435,7 @@ StringName::StringName() {
 
 StringName::~StringName() {
 
-	unref();
+	if (likely(configured)) {
+		unref();
+	}
 }
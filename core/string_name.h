@@ -45,9 +45,10 @@ class StringName {
 
 	enum {
 
-		STRING_TABLE_BITS = 12,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		// names are spread over shards, each with its own lock and table
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARDS = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_MIN_BITS = 6, // per shard, tables grow with the number of names
 	};
 
 	struct _Data {
@@ -56,19 +57,30 @@ class StringName {
 		String name;
 
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx;
 		uint32_t hash;
 		_Data *prev;
 		_Data *next;
 		_Data() {
 			cname = NULL;
 			next = prev = NULL;
-			idx = 0;
 			hash = 0;
 		}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	struct _Shard {
+		Mutex *lock;
+		_Data **table;
+		uint32_t mask;
+		uint32_t count;
+	};
+
+	static _Shard _shards[STRING_TABLE_SHARDS];
+
+	// fibonacci hashing, the top bits of short names' hashes are mostly zero and the low bits pick the bucket
+	_FORCE_INLINE_ static _Shard &_get_shard(uint32_t p_hash) { return _shards[(p_hash * 2654435769U) >> (32 - STRING_TABLE_SHARD_BITS)]; }
+	template <class T>
+	static _Data *_find(_Shard &p_shard, uint32_t p_hash, const T &p_name);
+	static void _insert(_Shard &p_shard, _Data *p_data);
 
 	_Data *_data;
 
@@ -82,7 +94,6 @@ class StringName {
 	friend void register_core_types();
 	friend void unregister_core_types();
 
-	static Mutex *lock;
 	static void setup();
 	static void cleanup();
 	static bool configured;
@@ -128,6 +139,11 @@ public:
 		return String();
 	}
 
+	// same as String::hash(const char *), usable at compile time
+	static constexpr uint32_t hash_static(const char *p_name, uint32_t p_hash = 5381) {
+		return *p_name ? hash_static(p_name + 1, ((p_hash << 5) + p_hash) + (uint32_t)*p_name) : p_hash;
+	}
+
 	static StringName search(const char *p_name);
 	static StringName search(const CharType *p_name);
 	static StringName search(const String &p_name);
@@ -160,10 +176,21 @@ public:
 	StringName(const StringName &p_name);
 	StringName(const String &p_name);
 	StringName(const StaticCString &p_static_string);
+	StringName(const StaticCString &p_static_string, uint32_t p_hash);
 	StringName();
 	~StringName();
 };
 
 StringName _scs_create(const char *p_chr);
 
+/**
+ * StringName for a string literal, interned on first use and reused afterwards.
+ * The hash is computed at compile time, so hot code neither hashes nor locks.
+ */
+#define SNAME(m_arg) ([]() -> const StringName & {                                          \
+	static constexpr uint32_t _sname_hash = StringName::hash_static(m_arg);                 \
+	static const StringName _sname = StringName(StaticCString::create(m_arg), _sname_hash); \
+	return _sname;                                                                          \
+})()
+
 #endif // STRING_NAME_H
@@ -32,6 +32,281 @@
 
 #include "core/os/os.h"
 
+//pool array deltas, stored as (start, length) spans and the values inside them
+
+template <class T>
+static bool _make_array_delta(const PoolVector<T> &p_old, const PoolVector<T> &p_new, PoolVector<int> &r_spans, PoolVector<T> &r_old_values, PoolVector<T> &r_new_values) {
+
+	int size = p_old.size();
+	if (p_new.size() != size) {
+		return false;
+	}
+
+	typename PoolVector<T>::Read old_r = p_old.read();
+	typename PoolVector<T>::Read new_r = p_new.read();
+
+	const int span_join_gap = 4; //unchanged runs shorter than this are cheaper to store than a new span
+	Vector<int> spans;
+	int changed = 0;
+	int i = 0;
+	while (i < size) {
+		if (old_r[i] == new_r[i]) {
+			i++;
+			continue;
+		}
+		int start = i;
+		int end = i + 1; //exclusive
+		for (int j = end; j < size && j < end + span_join_gap; j++) {
+			if (old_r[j] != new_r[j]) {
+				end = j + 1;
+			}
+		}
+		spans.push_back(start);
+		spans.push_back(end - start);
+		changed += end - start;
+		i = end;
+	}
+
+	//not worth it when most of the array changed
+	if (changed * 2 > size) {
+		return false;
+	}
+
+	r_spans.resize(spans.size());
+	r_old_values.resize(changed);
+	r_new_values.resize(changed);
+	typename PoolVector<int>::Write spans_w = r_spans.write();
+	typename PoolVector<T>::Write old_w = r_old_values.write();
+	typename PoolVector<T>::Write new_w = r_new_values.write();
+	int ofs = 0;
+	for (int j = 0; j < spans.size(); j += 2) {
+		spans_w[j] = spans[j];
+		spans_w[j + 1] = spans[j + 1];
+		for (int k = 0; k < spans[j + 1]; k++) {
+			old_w[ofs] = old_r[spans[j] + k];
+			new_w[ofs] = new_r[spans[j] + k];
+			ofs++;
+		}
+	}
+	return true;
+}
+
+template <class T>
+static bool _apply_array_delta(Variant &r_array, const PoolVector<int> &p_spans, const PoolVector<T> &p_values) {
+
+	PoolVector<T> array = r_array;
+	int size = array.size();
+	typename PoolVector<int>::Read spans_r = p_spans.read();
+	typename PoolVector<T>::Read values_r = p_values.read();
+	for (int i = 0; i < p_spans.size(); i += 2) {
+		if (spans_r[i] < 0 || spans_r[i] + spans_r[i + 1] > size) {
+			return false;
+		}
+	}
+
+	{
+		typename PoolVector<T>::Write w = array.write();
+		int ofs = 0;
+		for (int i = 0; i < p_spans.size(); i += 2) {
+			for (int j = 0; j < spans_r[i + 1]; j++) {
+				w[spans_r[i] + j] = values_r[ofs++];
+			}
+		}
+	}
+	r_array = array;
+	return true;
+}
+
+template <class T>
+static bool _make_typed_delta(const Variant &p_old, const Variant &p_new, PoolVector<int> &r_spans, Variant &r_old_values, Variant &r_new_values) {
+
+	PoolVector<T> old_values;
+	PoolVector<T> new_values;
+	if (!_make_array_delta<T>(p_old, p_new, r_spans, old_values, new_values)) {
+		return false;
+	}
+	r_old_values = old_values;
+	r_new_values = new_values;
+	return true;
+}
+
+static bool _make_variant_delta(const Variant &p_old, const Variant &p_new, Variant &r_spans, Variant &r_old_values, Variant &r_new_values) {
+
+	if (p_old.get_type() != p_new.get_type()) {
+		return false;
+	}
+
+	PoolVector<int> spans;
+	bool ok = false;
+	switch (p_old.get_type()) {
+		case Variant::POOL_BYTE_ARRAY: ok = _make_typed_delta<uint8_t>(p_old, p_new, spans, r_old_values, r_new_values); break;
+		case Variant::POOL_INT_ARRAY: ok = _make_typed_delta<int>(p_old, p_new, spans, r_old_values, r_new_values); break;
+		case Variant::POOL_REAL_ARRAY: ok = _make_typed_delta<real_t>(p_old, p_new, spans, r_old_values, r_new_values); break;
+		case Variant::POOL_STRING_ARRAY: ok = _make_typed_delta<String>(p_old, p_new, spans, r_old_values, r_new_values); break;
+		case Variant::POOL_VECTOR2_ARRAY: ok = _make_typed_delta<Vector2>(p_old, p_new, spans, r_old_values, r_new_values); break;
+		case Variant::POOL_VECTOR3_ARRAY: ok = _make_typed_delta<Vector3>(p_old, p_new, spans, r_old_values, r_new_values); break;
+		case Variant::POOL_COLOR_ARRAY: ok = _make_typed_delta<Color>(p_old, p_new, spans, r_old_values, r_new_values); break;
+		default: return false;
+	}
+
+	r_spans = spans;
+	return ok;
+}
+
+static bool _apply_variant_delta(Variant &r_array, const Variant &p_spans, const Variant &p_values) {
+
+	if (r_array.get_type() != p_values.get_type()) {
+		return false;
+	}
+
+	switch (p_values.get_type()) {
+		case Variant::POOL_BYTE_ARRAY: return _apply_array_delta<uint8_t>(r_array, p_spans, p_values);
+		case Variant::POOL_INT_ARRAY: return _apply_array_delta<int>(r_array, p_spans, p_values);
+		case Variant::POOL_REAL_ARRAY: return _apply_array_delta<real_t>(r_array, p_spans, p_values);
+		case Variant::POOL_STRING_ARRAY: return _apply_array_delta<String>(r_array, p_spans, p_values);
+		case Variant::POOL_VECTOR2_ARRAY: return _apply_array_delta<Vector2>(r_array, p_spans, p_values);
+		case Variant::POOL_VECTOR3_ARRAY: return _apply_array_delta<Vector3>(r_array, p_spans, p_values);
+		case Variant::POOL_COLOR_ARRAY: return _apply_array_delta<Color>(r_array, p_spans, p_values);
+		default: return false;
+	}
+}
+
+int64_t UndoRedo::_get_variant_memory(const Variant &p_variant, int p_depth) {
+
+	//an estimate, storage shared between values or owned by objects is not seen here
+	int64_t memory = sizeof(Variant);
+	switch (p_variant.get_type()) {
+		case Variant::STRING: {
+			memory += String(p_variant).length() * sizeof(CharType);
+		} break;
+		case Variant::POOL_BYTE_ARRAY: {
+			memory += PoolByteArray(p_variant).size();
+		} break;
+		case Variant::POOL_INT_ARRAY: {
+			memory += PoolIntArray(p_variant).size() * sizeof(int);
+		} break;
+		case Variant::POOL_REAL_ARRAY: {
+			memory += PoolRealArray(p_variant).size() * sizeof(real_t);
+		} break;
+		case Variant::POOL_STRING_ARRAY: {
+			PoolStringArray strings = p_variant;
+			PoolStringArray::Read r = strings.read();
+			for (int i = 0; i < strings.size(); i++) {
+				memory += sizeof(String) + r[i].length() * sizeof(CharType);
+			}
+		} break;
+		case Variant::POOL_VECTOR2_ARRAY: {
+			memory += PoolVector2Array(p_variant).size() * sizeof(Vector2);
+		} break;
+		case Variant::POOL_VECTOR3_ARRAY: {
+			memory += PoolVector3Array(p_variant).size() * sizeof(Vector3);
+		} break;
+		case Variant::POOL_COLOR_ARRAY: {
+			memory += PoolColorArray(p_variant).size() * sizeof(Color);
+		} break;
+		case Variant::ARRAY: {
+			if (p_depth < 8) {
+				Array array = p_variant;
+				for (int i = 0; i < array.size(); i++) {
+					memory += _get_variant_memory(array[i], p_depth + 1);
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			if (p_depth < 8) {
+				Dictionary dict = p_variant;
+				List<Variant> keys;
+				dict.get_key_list(&keys);
+				for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+					memory += _get_variant_memory(E->get(), p_depth + 1) + _get_variant_memory(dict[E->get()], p_depth + 1);
+				}
+			}
+		} break;
+		default: {
+		}
+	}
+	return memory;
+}
+
+int64_t UndoRedo::_get_operation_memory(const Operation &p_op) {
+
+	int64_t memory = sizeof(Operation);
+	for (int i = 0; i < VARIANT_ARG_MAX; i++) {
+		if (p_op.args[i].get_type() != Variant::NIL) {
+			memory += _get_variant_memory(p_op.args[i]) - sizeof(Variant);
+		}
+	}
+	return memory;
+}
+
+//finds a full property op for the same target, r_has_delta tells whether a delta for it was seen on the way
+List<UndoRedo::Operation>::Element *UndoRedo::_find_property_operation(List<Operation>::Element *E, const Operation &p_op, bool &r_has_delta) {
+
+	List<Operation>::Element *found = NULL;
+	r_has_delta = false;
+	for (; E; E = E->next()) {
+		const Operation &op = E->get();
+		if (op.object != p_op.object || op.name != p_op.name) {
+			continue;
+		}
+		if (op.type == Operation::TYPE_PROPERTY_DELTA) {
+			r_has_delta = true;
+		} else if (op.type == Operation::TYPE_PROPERTY && !found) {
+			found = E;
+		}
+	}
+	return found;
+}
+
+void UndoRedo::_add_do_operation(const Operation &p_op) {
+
+	Action &action = actions.write[current_action + 1];
+
+	if (merging && merge_mode == MERGE_ALL && p_op.type == Operation::TYPE_PROPERTY) {
+		//setting a property again in a merged step only needs the newest value
+		bool has_delta;
+		List<Operation>::Element *E = _find_property_operation(action.do_ops.front(), p_op, has_delta);
+		if (E && !has_delta) {
+			int64_t memory = _get_operation_memory(p_op) - _get_operation_memory(E->get());
+			action.memory += memory;
+			history_memory += memory;
+			E->get().args[0] = p_op.args[0];
+			return;
+		}
+	}
+
+	int64_t memory = _get_operation_memory(p_op);
+	action.memory += memory;
+	history_memory += memory;
+	action.do_ops.push_back(p_op);
+}
+
+void UndoRedo::_add_undo_operation(const Operation &p_op) {
+
+	Action &action = actions.write[current_action + 1];
+
+	if (merge_undo_first) {
+		if (p_op.type == Operation::TYPE_PROPERTY) {
+			//an earlier step restores this property after this one runs anyway
+			bool has_delta;
+			if (_find_property_operation(merge_undo_first, p_op, has_delta) && !has_delta) {
+				return;
+			}
+		}
+
+		int64_t memory = _get_operation_memory(p_op);
+		action.memory += memory;
+		history_memory += memory;
+		action.undo_ops.insert_before(merge_undo_first, p_op);
+		return;
+	}
+
+	int64_t memory = _get_operation_memory(p_op);
+	action.memory += memory;
+	history_memory += memory;
+	action.undo_ops.push_back(p_op);
+}
+
 void UndoRedo::_discard_redo() {
 
 	if (current_action == actions.size() - 1)
@@ -39,6 +314,8 @@ void UndoRedo::_discard_redo() {
 
 	for (int i = current_action + 1; i < actions.size(); i++) {
 
+		history_memory -= actions[i].memory;
+
 		for (List<Operation>::Element *E = actions.write[i].do_ops.front(); E; E = E->next()) {
 
 			if (E->get().type == Operation::TYPE_REFERENCE) {
@@ -82,9 +359,16 @@ void UndoRedo::create_action(const String &p_name, MergeMode p_mode) {
 							memdelete(obj);
 					}
 
+					int64_t memory = _get_operation_memory(E->get());
+					actions.write[current_action + 1].memory -= memory;
+					history_memory -= memory;
+
 					E = E->next();
 					actions.write[current_action + 1].do_ops.pop_front();
 				}
+				merge_undo_first = NULL;
+			} else {
+				merge_undo_first = actions.write[current_action + 1].undo_ops.front();
 			}
 
 			actions.write[actions.size() - 1].last_tick = ticks;
@@ -96,9 +380,11 @@ void UndoRedo::create_action(const String &p_name, MergeMode p_mode) {
 			Action new_action;
 			new_action.name = p_name;
 			new_action.last_tick = ticks;
+			new_action.memory = 0;
 			actions.push_back(new_action);
 
 			merge_mode = MERGE_DISABLE;
+			merge_undo_first = NULL;
 		}
 	}
 
@@ -122,7 +408,7 @@ void UndoRedo::add_do_method(Object *p_object, const String &p_method, VARIANT_A
 	for (int i = 0; i < VARIANT_ARG_MAX; i++) {
 		do_op.args[i] = *argptr[i];
 	}
-	actions.write[current_action + 1].do_ops.push_back(do_op);
+	_add_do_operation(do_op);
 }
 
 void UndoRedo::add_undo_method(Object *p_object, const String &p_method, VARIANT_ARG_DECLARE) {
@@ -147,7 +433,7 @@ void UndoRedo::add_undo_method(Object *p_object, const String &p_method, VARIANT
 	for (int i = 0; i < VARIANT_ARG_MAX; i++) {
 		undo_op.args[i] = *argptr[i];
 	}
-	actions.write[current_action + 1].undo_ops.push_back(undo_op);
+	_add_undo_operation(undo_op);
 }
 void UndoRedo::add_do_property(Object *p_object, const String &p_property, const Variant &p_value) {
 
@@ -162,7 +448,7 @@ void UndoRedo::add_do_property(Object *p_object, const String &p_property, const
 	do_op.type = Operation::TYPE_PROPERTY;
 	do_op.name = p_property;
 	do_op.args[0] = p_value;
-	actions.write[current_action + 1].do_ops.push_back(do_op);
+	_add_do_operation(do_op);
 }
 void UndoRedo::add_undo_property(Object *p_object, const String &p_property, const Variant &p_value) {
 
@@ -182,7 +468,7 @@ void UndoRedo::add_undo_property(Object *p_object, const String &p_property, con
 	undo_op.type = Operation::TYPE_PROPERTY;
 	undo_op.name = p_property;
 	undo_op.args[0] = p_value;
-	actions.write[current_action + 1].undo_ops.push_back(undo_op);
+	_add_undo_operation(undo_op);
 }
 void UndoRedo::add_do_reference(Object *p_object) {
 
@@ -195,7 +481,7 @@ void UndoRedo::add_do_reference(Object *p_object) {
 		do_op.resref = Ref<Resource>(Object::cast_to<Resource>(p_object));
 
 	do_op.type = Operation::TYPE_REFERENCE;
-	actions.write[current_action + 1].do_ops.push_back(do_op);
+	_add_do_operation(do_op);
 }
 void UndoRedo::add_undo_reference(Object *p_object) {
 
@@ -213,7 +499,39 @@ void UndoRedo::add_undo_reference(Object *p_object) {
 		undo_op.resref = Ref<Resource>(Object::cast_to<Resource>(p_object));
 
 	undo_op.type = Operation::TYPE_REFERENCE;
-	actions.write[current_action + 1].undo_ops.push_back(undo_op);
+	_add_undo_operation(undo_op);
+}
+
+void UndoRedo::add_property_delta(Object *p_object, const String &p_property, const Variant &p_old_value, const Variant &p_new_value) {
+
+	ERR_FAIL_COND(p_object == NULL);
+	ERR_FAIL_COND(action_level <= 0);
+	ERR_FAIL_COND((current_action + 1) >= actions.size());
+
+	Variant spans;
+	Variant old_values;
+	Variant new_values;
+	//MERGE_ENDS replays only the last do ops, which must then work from the state before the first step
+	if (merge_mode == MERGE_ENDS || !_make_variant_delta(p_old_value, p_new_value, spans, old_values, new_values)) {
+		add_do_property(p_object, p_property, p_new_value);
+		add_undo_property(p_object, p_property, p_old_value);
+		return;
+	}
+
+	Operation do_op;
+	do_op.object = p_object->get_instance_id();
+	if (Object::cast_to<Resource>(p_object))
+		do_op.resref = Ref<Resource>(Object::cast_to<Resource>(p_object));
+
+	do_op.type = Operation::TYPE_PROPERTY_DELTA;
+	do_op.name = p_property;
+	do_op.args[0] = spans;
+	do_op.args[1] = new_values;
+	_add_do_operation(do_op);
+
+	Operation undo_op = do_op;
+	undo_op.args[1] = old_values;
+	_add_undo_operation(undo_op);
 }
 
 void UndoRedo::_pop_history_tail() {
@@ -223,6 +541,8 @@ void UndoRedo::_pop_history_tail() {
 	if (!actions.size())
 		return;
 
+	history_memory -= actions[0].memory;
+
 	for (List<Operation>::Element *E = actions.write[0].undo_ops.front(); E; E = E->next()) {
 
 		if (E->get().type == Operation::TYPE_REFERENCE) {
@@ -253,6 +573,7 @@ void UndoRedo::commit_action() {
 	if (merging) {
 		version--;
 		merging = false;
+		merge_undo_first = NULL;
 	}
 
 	committing++;
@@ -261,6 +582,19 @@ void UndoRedo::commit_action() {
 	if (callback && actions.size() > 0) {
 		callback(callback_ud, actions[actions.size() - 1].name);
 	}
+
+	_trim_history();
+}
+
+void UndoRedo::_trim_history() {
+
+	if (max_history_memory <= 0)
+		return;
+
+	//the newest action is always kept, so it can still be undone
+	while (history_memory > max_history_memory && actions.size() > 1 && current_action > 0) {
+		_pop_history_tail();
+	}
 }
 
 void UndoRedo::_process_operation_list(List<Operation>::Element *E) {
@@ -318,6 +652,23 @@ void UndoRedo::_process_operation_list(List<Operation>::Element *E) {
 					property_callback(prop_callback_ud, obj, op.name, op.args[0]);
 				}
 			} break;
+			case Operation::TYPE_PROPERTY_DELTA: {
+
+				Variant value = obj->get(op.name);
+				if (!_apply_variant_delta(value, op.args[0], op.args[1])) {
+					ERR_PRINT("Can't apply the change to property '" + String(op.name) + "', its current value doesn't match the history.");
+					break;
+				}
+				obj->set(op.name, value);
+#ifdef TOOLS_ENABLED
+				Resource *res = Object::cast_to<Resource>(obj);
+				if (res)
+					res->set_edited(true);
+#endif
+				if (property_callback) {
+					property_callback(prop_callback_ud, obj, op.name, value);
+				}
+			} break;
 			case Operation::TYPE_REFERENCE: {
 				//do nothing
 			} break;
@@ -391,6 +742,24 @@ uint64_t UndoRedo::get_version() const {
 	return version;
 }
 
+void UndoRedo::set_max_history_memory(int64_t p_bytes) {
+
+	max_history_memory = p_bytes;
+	if (action_level == 0) {
+		_trim_history();
+	}
+}
+
+int64_t UndoRedo::get_max_history_memory() const {
+
+	return max_history_memory;
+}
+
+int64_t UndoRedo::get_history_memory() const {
+
+	return history_memory;
+}
+
 void UndoRedo::set_commit_notify_callback(CommitNotifyCallback p_callback, void *p_ud) {
 
 	callback = p_callback;
@@ -417,6 +786,9 @@ UndoRedo::UndoRedo() {
 	current_action = -1;
 	merge_mode = MERGE_DISABLE;
 	merging = false;
+	merge_undo_first = NULL;
+	history_memory = 0;
+	max_history_memory = 0;
 	callback = NULL;
 	callback_ud = NULL;
 
@@ -536,11 +908,15 @@ void UndoRedo::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_undo_property", "object", "property", "value"), &UndoRedo::add_undo_property);
 	ClassDB::bind_method(D_METHOD("add_do_reference", "object"), &UndoRedo::add_do_reference);
 	ClassDB::bind_method(D_METHOD("add_undo_reference", "object"), &UndoRedo::add_undo_reference);
+	ClassDB::bind_method(D_METHOD("add_property_delta", "object", "property", "old_value", "new_value"), &UndoRedo::add_property_delta);
 	ClassDB::bind_method(D_METHOD("clear_history", "increase_version"), &UndoRedo::clear_history, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("get_current_action_name"), &UndoRedo::get_current_action_name);
 	ClassDB::bind_method(D_METHOD("has_undo"), &UndoRedo::has_undo);
 	ClassDB::bind_method(D_METHOD("has_redo"), &UndoRedo::has_redo);
 	ClassDB::bind_method(D_METHOD("get_version"), &UndoRedo::get_version);
+	ClassDB::bind_method(D_METHOD("set_max_history_memory", "bytes"), &UndoRedo::set_max_history_memory);
+	ClassDB::bind_method(D_METHOD("get_max_history_memory"), &UndoRedo::get_max_history_memory);
+	ClassDB::bind_method(D_METHOD("get_history_memory"), &UndoRedo::get_history_memory);
 	ClassDB::bind_method(D_METHOD("redo"), &UndoRedo::redo);
 	ClassDB::bind_method(D_METHOD("undo"), &UndoRedo::undo);
 
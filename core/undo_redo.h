@@ -59,13 +59,14 @@ private:
 		enum Type {
 			TYPE_METHOD,
 			TYPE_PROPERTY,
+			TYPE_PROPERTY_DELTA, //args[0] holds (start, length) spans of a pool array property, args[1] their values
 			TYPE_REFERENCE
 		};
 
 		Type type;
 		Ref<Resource> resref;
 		ObjectID object;
-		String name;
+		StringName name;
 		Variant args[VARIANT_ARG_MAX];
 	};
 
@@ -74,6 +75,7 @@ private:
 		List<Operation> do_ops;
 		List<Operation> undo_ops;
 		uint64_t last_tick;
+		int64_t memory;
 	};
 
 	Vector<Action> actions;
@@ -81,8 +83,20 @@ private:
 	int action_level;
 	MergeMode merge_mode;
 	bool merging;
+	List<Operation>::Element *merge_undo_first; //undo ops of a merged step go before the ones of earlier steps
 	uint64_t version;
 
+	int64_t history_memory;
+	int64_t max_history_memory;
+
+	static int64_t _get_variant_memory(const Variant &p_variant, int p_depth = 0);
+	static int64_t _get_operation_memory(const Operation &p_op);
+	static List<Operation>::Element *_find_property_operation(List<Operation>::Element *E, const Operation &p_op, bool &r_has_delta);
+
+	void _add_do_operation(const Operation &p_op);
+	void _add_undo_operation(const Operation &p_op);
+	void _trim_history();
+
 	void _pop_history_tail();
 	void _process_operation_list(List<Operation>::Element *E);
 	void _discard_redo();
@@ -109,6 +123,7 @@ public:
 	void add_undo_property(Object *p_object, const String &p_property, const Variant &p_value);
 	void add_do_reference(Object *p_object);
 	void add_undo_reference(Object *p_object);
+	void add_property_delta(Object *p_object, const String &p_property, const Variant &p_old_value, const Variant &p_new_value);
 
 	bool is_committing_action() const;
 	void commit_action();
@@ -123,6 +138,10 @@ public:
 
 	uint64_t get_version() const;
 
+	void set_max_history_memory(int64_t p_bytes);
+	int64_t get_max_history_memory() const;
+	int64_t get_history_memory() const;
+
 	void set_commit_notify_callback(CommitNotifyCallback p_callback, void *p_ud);
 
 	void set_method_notify_callback(MethodNotifyCallback p_method_callback, void *p_ud);
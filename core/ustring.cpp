@@ -43,6 +43,7 @@
 #include "core/ucaps.h"
 #include "core/variant.h"
 
+#include <string.h>
 #include <wchar.h>
 #include <cstdint>
 
@@ -208,13 +209,10 @@ void String::copy_from(const CharType *p_cstr, const int p_clip_to) {
 // p_length <= p_char strlen
 void String::copy_from_unchecked(const CharType *p_char, const int p_length) {
 	resize(p_length + 1);
-	set(p_length, 0);
 
 	CharType *dst = ptrw();
-
-	for (int i = 0; i < p_length; i++) {
-		dst[i] = p_char[i];
-	}
+	memcpy(dst, p_char, p_length * sizeof(CharType));
+	dst[p_length] = 0;
 }
 
 void String::copy_from(const CharType &p_char) {
@@ -231,19 +229,13 @@ bool String::operator==(const String &p_str) const {
 	if (empty())
 		return true;
 
-	int l = length();
+	const CharType *src = ptr();
+	const CharType *dst = p_str.ptr();
 
-	const CharType *src = c_str();
-	const CharType *dst = p_str.c_str();
-
-	/* Compare char by char */
-	for (int i = 0; i < l; i++) {
+	if (src == dst)
+		return true; // same copy-on-write buffer
 
-		if (src[i] != dst[i])
-			return false;
-	}
-
-	return true;
+	return memcmp(src, dst, length() * sizeof(CharType)) == 0;
 }
 
 bool String::operator!=(const String &p_str) const {
@@ -1412,6 +1404,8 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 		}
 	}
 
+	bool ascii = true;
+
 	{
 		const char *ptrtmp = p_utf8;
 		const char *ptrtmp_limit = &p_utf8[p_len];
@@ -1421,6 +1415,7 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 			if (skip == 0) {
 
 				uint8_t c = *ptrtmp >= 0 ? *ptrtmp : uint8_t(256 + *ptrtmp);
+				ascii = ascii && c < 0x80;
 
 				/* Determine the number of characters in sequence */
 				if ((c & 0x80) == 0)
@@ -1472,6 +1467,14 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 	CharType *dst = ptrw();
 	dst[str_size] = 0;
 
+	if (ascii) {
+		// most text (identifiers, JSON, translation keys) needs no decoding at all
+		for (int i = 0; i < str_size; i++) {
+			dst[i] = (uint8_t)p_utf8[i];
+		}
+		return false;
+	}
+
 	while (cstr_size) {
 
 		int len = 0;
@@ -1578,6 +1581,15 @@ CharString String::utf8() const {
 	utf8s.resize(fl + 1);
 	uint8_t *cdst = (uint8_t *)utf8s.get_data();
 
+	if (fl == l) {
+		// only 7 bit characters
+		for (int i = 0; i < l; i++) {
+			cdst[i] = d[i];
+		}
+		cdst[l] = 0;
+		return utf8s;
+	}
+
 #define APPEND_CHAR(m_c) *(cdst++) = m_c
 
 	for (int i = 0; i < l; i++) {
@@ -2230,10 +2242,19 @@ uint32_t String::hash(const char *p_cstr, int p_len) {
 	return hashv;
 }
 
+// advances djb2 by four characters at once, the same as four "hash * 33 + c" steps but with a shorter dependency chain
+static _FORCE_INLINE_ uint32_t _hash_djb2_4(uint32_t p_hash, uint32_t p_c0, uint32_t p_c1, uint32_t p_c2, uint32_t p_c3) {
+
+	return p_hash * 1185921 + p_c0 * 35937 + p_c1 * 1089 + p_c2 * 33 + p_c3;
+}
+
 uint32_t String::hash(const CharType *p_cstr, int p_len) {
 
 	uint32_t hashv = 5381;
-	for (int i = 0; i < p_len; i++)
+	int i = 0;
+	for (; i + 4 <= p_len; i += 4)
+		hashv = _hash_djb2_4(hashv, p_cstr[i], p_cstr[i + 1], p_cstr[i + 2], p_cstr[i + 3]);
+	for (; i < p_len; i++)
 		hashv = ((hashv << 5) + hashv) + p_cstr[i]; /* hash * 33 + c */
 
 	return hashv;
@@ -2255,9 +2276,19 @@ uint32_t String::hash() const {
 	/* simple djb2 hashing */
 
 	const CharType *chr = c_str();
+	int len = length();
 	uint32_t hashv = 5381;
 	uint32_t c;
 
+	// the hash stops at the first zero, unroll while there is none
+	int i = 0;
+	for (; i + 4 <= len; i += 4) {
+		if (!chr[i] || !chr[i + 1] || !chr[i + 2] || !chr[i + 3])
+			break;
+		hashv = _hash_djb2_4(hashv, chr[i], chr[i + 1], chr[i + 2], chr[i + 3]);
+	}
+
+	chr += i;
 	while ((c = *chr++))
 		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
 
@@ -2410,28 +2441,22 @@ int String::find(const String &p_str, int p_from) const {
 
 	const CharType *src = c_str();
 	const CharType *str = p_str.c_str();
+	const CharType first = str[0];
+	const int last = len - src_len;
 
-	for (int i = p_from; i <= (len - src_len); i++) {
-
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
-
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			};
+	// let the C library (usually vectorized) find candidates for the first character, then compare the rest
+	int i = p_from;
+	while (i <= last) {
 
-			if (src[read_pos] != str[j]) {
-				found = false;
-				break;
-			}
-		}
+		const CharType *candidate = wmemchr(&src[i], first, last - i + 1);
+		if (!candidate)
+			return -1;
 
-		if (found)
+		i = candidate - src;
+		if (memcmp(&src[i + 1], &str[1], (src_len - 1) * sizeof(CharType)) == 0)
 			return i;
+
+		i++;
 	}
 
 	return -1;
@@ -2982,6 +2982,23 @@ bool Variant::hash_compare(const Variant &p_variant) const {
 		return false;
 
 	switch (type) {
+		//common dictionary keys, compared directly instead of going through evaluate()
+		case NIL: {
+			return true;
+		} break;
+
+		case BOOL: {
+			return _data._bool == p_variant._data._bool;
+		} break;
+
+		case INT: {
+			return _data._int == p_variant._data._int;
+		} break;
+
+		case STRING: {
+			return *reinterpret_cast<const String *>(_data._mem) == *reinterpret_cast<const String *>(p_variant._data._mem);
+		} break;
+
 		case REAL: {
 			return hash_compare_scalar(_data._real, p_variant._data._real);
 		} break;
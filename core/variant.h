@@ -56,6 +56,7 @@ class Control; // helper
 
 struct PropertyInfo;
 struct MethodInfo;
+struct MethodCallCache;
 
 typedef PoolVector<uint8_t> PoolByteArray;
 typedef PoolVector<int> PoolIntArray;
@@ -120,6 +121,7 @@ public:
 
 private:
 	friend struct _VariantCall;
+	friend struct _VariantValidated;
 	// Variant takes 20 bytes when real_t is float, and 36 if double
 	// it only allocates extra memory for aabb/matrix.
 
@@ -340,6 +342,20 @@ public:
 		return res;
 	}
 
+	//direct paths for operands whose types are known ahead of time (i.e. by a compiler), they skip all type dispatch.
+	//callers must make sure the operands are of the requested types, results are written in place when r_ret already has the result type.
+	typedef void (*ValidatedOperatorEvaluator)(const Variant *p_a, const Variant *p_b, Variant *r_ret);
+	typedef void (*ValidatedGetter)(const Variant *p_base, Variant *r_ret);
+	typedef void (*ValidatedSetter)(Variant *p_base, const Variant *p_value);
+	typedef bool (*ValidatedIndexedGetter)(const Variant *p_base, const Variant *p_index, Variant *r_ret); //false if out of bounds
+	typedef bool (*ValidatedIndexedSetter)(Variant *p_base, const Variant *p_index, const Variant *p_value); //false if out of bounds
+
+	static ValidatedOperatorEvaluator get_validated_operator_evaluator(Operator p_op, Type p_type_a, Type p_type_b); //NULL if evaluate() has to be used
+	static ValidatedGetter get_validated_member_getter(Type p_type, const StringName &p_member);
+	static ValidatedSetter get_validated_member_setter(Type p_type, const StringName &p_member, Type p_value_type);
+	static ValidatedIndexedGetter get_validated_indexed_getter(Type p_type, Type p_index_type);
+	static ValidatedIndexedSetter get_validated_indexed_setter(Type p_type, Type p_index_type, Type p_value_type);
+
 	void zero();
 	Variant duplicate(bool deep = false) const;
 	static void blend(const Variant &a, const Variant &b, float c, Variant &r_dst);
@@ -359,7 +375,7 @@ public:
 		Type expected;
 	};
 
-	void call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error);
+	void call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error, MethodCallCache *r_cache = NULL);
 	Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, CallError &r_error);
 	Variant call(const StringName &p_method, const Variant &p_arg1 = Variant(), const Variant &p_arg2 = Variant(), const Variant &p_arg3 = Variant(), const Variant &p_arg4 = Variant(), const Variant &p_arg5 = Variant());
 
@@ -375,8 +391,8 @@ public:
 	static Vector<StringName> get_method_argument_names(Variant::Type p_type, const StringName &p_method);
 	static bool is_method_const(Variant::Type p_type, const StringName &p_method);
 
-	void set_named(const StringName &p_index, const Variant &p_value, bool *r_valid = NULL);
-	Variant get_named(const StringName &p_index, bool *r_valid = NULL) const;
+	void set_named(const StringName &p_index, const Variant &p_value, bool *r_valid = NULL, MethodCallCache *r_cache = NULL);
+	Variant get_named(const StringName &p_index, bool *r_valid = NULL, MethodCallCache *r_cache = NULL) const;
 
 	void set(const Variant &p_index, const Variant &p_value, bool *r_valid = NULL);
 	Variant get(const Variant &p_index, bool *r_valid = NULL) const;
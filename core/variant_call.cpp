@@ -1089,7 +1089,7 @@ Variant Variant::call(const StringName &p_method, const Variant **p_args, int p_
 	return ret;
 }
 
-void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error) {
+void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error, MethodCallCache *r_cache) {
 	Variant ret;
 
 	if (type == Variant::OBJECT) {
@@ -1109,7 +1109,11 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 		}
 
 #endif
-		ret = _get_obj().obj->call(p_method, p_args, p_argcount, r_error);
+		if (r_cache) {
+			ret = _get_obj().obj->call_cached(*r_cache, p_method, p_args, p_argcount, r_error);
+		} else {
+			ret = _get_obj().obj->call(p_method, p_args, p_argcount, r_error);
+		}
 
 		//else if (type==Variant::METHOD) {
 
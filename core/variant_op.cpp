@@ -1223,7 +1223,7 @@ void Variant::evaluate(const Operator &p_op, const Variant &p_a,
 	}
 }
 
-void Variant::set_named(const StringName &p_index, const Variant &p_value, bool *r_valid) {
+void Variant::set_named(const StringName &p_index, const Variant &p_value, bool *r_valid, MethodCallCache *r_cache) {
 
 	bool valid = false;
 	switch (type) {
@@ -1520,7 +1520,11 @@ void Variant::set_named(const StringName &p_index, const Variant &p_value, bool
 			}
 
 #endif
-			_get_obj().obj->set(p_index, p_value, &valid);
+			if (r_cache) {
+				_get_obj().obj->set_cached(*r_cache, p_index, p_value, &valid);
+			} else {
+				_get_obj().obj->set(p_index, p_value, &valid);
+			}
 
 		} break;
 		default: {
@@ -1533,7 +1537,7 @@ void Variant::set_named(const StringName &p_index, const Variant &p_value, bool
 	}
 }
 
-Variant Variant::get_named(const StringName &p_index, bool *r_valid) const {
+Variant Variant::get_named(const StringName &p_index, bool *r_valid, MethodCallCache *r_cache) const {
 
 	if (r_valid) {
 		*r_valid = true;
@@ -1693,6 +1697,9 @@ Variant Variant::get_named(const StringName &p_index, bool *r_valid) const {
 
 #endif
 
+			if (r_cache) {
+				return _get_obj().obj->get_cached(*r_cache, p_index, r_valid);
+			}
 			return _get_obj().obj->get(p_index, r_valid);
 
 		} break;
@@ -3834,3 +3841,397 @@ String Variant::get_operator_name(Operator p_op) {
 	ERR_FAIL_INDEX_V(p_op, OP_MAX, "");
 	return _op_names[p_op];
 }
+
+/* validated operations, used when the types of the operands are known beforehand */
+
+struct _VariantValidated {
+
+	static _FORCE_INLINE_ bool get(const Variant *p_v, bool *) { return p_v->_data._bool; }
+	static _FORCE_INLINE_ int64_t get(const Variant *p_v, int64_t *) { return p_v->_data._int; }
+	static _FORCE_INLINE_ double get(const Variant *p_v, double *) { return p_v->_data._real; }
+	static _FORCE_INLINE_ const Vector2 &get(const Variant *p_v, Vector2 *) { return *reinterpret_cast<const Vector2 *>(p_v->_data._mem); }
+	static _FORCE_INLINE_ const Rect2 &get(const Variant *p_v, Rect2 *) { return *reinterpret_cast<const Rect2 *>(p_v->_data._mem); }
+	static _FORCE_INLINE_ const Vector3 &get(const Variant *p_v, Vector3 *) { return *reinterpret_cast<const Vector3 *>(p_v->_data._mem); }
+	static _FORCE_INLINE_ const Quat &get(const Variant *p_v, Quat *) { return *reinterpret_cast<const Quat *>(p_v->_data._mem); }
+	static _FORCE_INLINE_ const Color &get(const Variant *p_v, Color *) { return *reinterpret_cast<const Color *>(p_v->_data._mem); }
+	static _FORCE_INLINE_ const Array &get(const Variant *p_v, Array *) { return *reinterpret_cast<const Array *>(p_v->_data._mem); }
+	static _FORCE_INLINE_ const Dictionary &get(const Variant *p_v, Dictionary *) { return *reinterpret_cast<const Dictionary *>(p_v->_data._mem); }
+	static _FORCE_INLINE_ const String &get(const Variant *p_v, String *) { return *reinterpret_cast<const String *>(p_v->_data._mem); }
+	template <class T>
+	static _FORCE_INLINE_ const PoolVector<T> &get(const Variant *p_v, PoolVector<T> *) { return *reinterpret_cast<const PoolVector<T> *>(p_v->_data._mem); }
+
+	template <class T>
+	static _FORCE_INLINE_ T &get_mem(Variant *p_v) { return *reinterpret_cast<T *>(p_v->_data._mem); }
+
+	//write in place when the destination already holds the type, which is the common case for typed temporaries
+	static _FORCE_INLINE_ void set(Variant *r_v, bool p_value) {
+		if (r_v->type == Variant::BOOL) {
+			r_v->_data._bool = p_value;
+		} else {
+			*r_v = p_value;
+		}
+	}
+	static _FORCE_INLINE_ void set(Variant *r_v, int64_t p_value) {
+		if (r_v->type == Variant::INT) {
+			r_v->_data._int = p_value;
+		} else {
+			*r_v = p_value;
+		}
+	}
+	static _FORCE_INLINE_ void set(Variant *r_v, double p_value) {
+		if (r_v->type == Variant::REAL) {
+			r_v->_data._real = p_value;
+		} else {
+			*r_v = p_value;
+		}
+	}
+
+#define VALIDATED_SET_MEM(m_type, m_variant_type)                          \
+	static _FORCE_INLINE_ void set(Variant *r_v, const m_type &p_value) { \
+		if (r_v->type == Variant::m_variant_type) {                       \
+			get_mem<m_type>(r_v) = p_value;                               \
+		} else {                                                          \
+			*r_v = p_value;                                               \
+		}                                                                 \
+	}
+
+	VALIDATED_SET_MEM(Vector2, VECTOR2)
+	VALIDATED_SET_MEM(Vector3, VECTOR3)
+	VALIDATED_SET_MEM(Quat, QUAT)
+	VALIDATED_SET_MEM(Color, COLOR)
+	VALIDATED_SET_MEM(String, STRING)
+
+#undef VALIDATED_SET_MEM
+};
+
+#define VALIDATED_BINARY_OP(m_name, m_op)                                                                                            \
+	template <class R, class A, class B>                                                                                             \
+	static void _validated_##m_name(const Variant *p_a, const Variant *p_b, Variant *r_ret) {                                      \
+		_VariantValidated::set(r_ret, R(_VariantValidated::get(p_a, (A *)NULL) m_op _VariantValidated::get(p_b, (B *)NULL))); \
+	}
+
+#define VALIDATED_UNARY_OP(m_name, m_op)                                                         \
+	template <class R, class A>                                                                  \
+	static void _validated_##m_name(const Variant *p_a, const Variant *p_b, Variant *r_ret) {  \
+		_VariantValidated::set(r_ret, R(m_op _VariantValidated::get(p_a, (A *)NULL))); \
+	}
+
+VALIDATED_BINARY_OP(equal, ==)
+VALIDATED_BINARY_OP(not_equal, !=)
+VALIDATED_BINARY_OP(less, <)
+VALIDATED_BINARY_OP(less_equal, <=)
+VALIDATED_BINARY_OP(greater, >)
+VALIDATED_BINARY_OP(greater_equal, >=)
+VALIDATED_BINARY_OP(add, +)
+VALIDATED_BINARY_OP(subtract, -)
+VALIDATED_BINARY_OP(multiply, *)
+VALIDATED_BINARY_OP(divide, /)
+VALIDATED_BINARY_OP(module, %)
+VALIDATED_BINARY_OP(bit_and, &)
+VALIDATED_BINARY_OP(bit_or, |)
+VALIDATED_BINARY_OP(bit_xor, ^)
+VALIDATED_UNARY_OP(negate, -)
+VALIDATED_UNARY_OP(positive, ) //evaluate() returns the operand unchanged
+VALIDATED_UNARY_OP(bit_negate, ~)
+VALIDATED_UNARY_OP(not, !)
+
+#undef VALIDATED_BINARY_OP
+#undef VALIDATED_UNARY_OP
+
+Variant::ValidatedOperatorEvaluator Variant::get_validated_operator_evaluator(Operator p_op, Type p_type_a, Type p_type_b) {
+
+	//only operations that evaluate() performs without any checks on the values are listed, so results and errors match it exactly
+
+#define VALIDATED_OP(m_op, m_func, m_ret, m_type_a, m_a, m_type_b, m_b)          \
+	if (p_op == m_op && p_type_a == m_type_a && p_type_b == m_type_b) {          \
+		return &_validated_##m_func<m_ret, m_a, m_b>;                            \
+	}
+#define VALIDATED_UNARY(m_op, m_func, m_ret, m_type, m_a)                        \
+	if (p_op == m_op && p_type_a == m_type && p_type_b == m_type) {              \
+		return &_validated_##m_func<m_ret, m_a>;                                 \
+	}
+#define VALIDATED_NUM_OPS(m_type_a, m_a, m_type_b, m_b, m_ret)                                  \
+	VALIDATED_OP(OP_ADD, add, m_ret, m_type_a, m_a, m_type_b, m_b)                              \
+	VALIDATED_OP(OP_SUBTRACT, subtract, m_ret, m_type_a, m_a, m_type_b, m_b)                    \
+	VALIDATED_OP(OP_MULTIPLY, multiply, m_ret, m_type_a, m_a, m_type_b, m_b)                    \
+	VALIDATED_OP(OP_EQUAL, equal, bool, m_type_a, m_a, m_type_b, m_b)                           \
+	VALIDATED_OP(OP_NOT_EQUAL, not_equal, bool, m_type_a, m_a, m_type_b, m_b)                   \
+	VALIDATED_OP(OP_LESS, less, bool, m_type_a, m_a, m_type_b, m_b)                             \
+	VALIDATED_OP(OP_LESS_EQUAL, less_equal, bool, m_type_a, m_a, m_type_b, m_b)                 \
+	VALIDATED_OP(OP_GREATER, greater, bool, m_type_a, m_a, m_type_b, m_b)                       \
+	VALIDATED_OP(OP_GREATER_EQUAL, greater_equal, bool, m_type_a, m_a, m_type_b, m_b)
+#define VALIDATED_VECTOR_OPS(m_type, m_v)                                            \
+	VALIDATED_OP(OP_ADD, add, m_v, m_type, m_v, m_type, m_v)                         \
+	VALIDATED_OP(OP_SUBTRACT, subtract, m_v, m_type, m_v, m_type, m_v)               \
+	VALIDATED_OP(OP_MULTIPLY, multiply, m_v, m_type, m_v, m_type, m_v)               \
+	VALIDATED_OP(OP_MULTIPLY, multiply, m_v, m_type, m_v, INT, int64_t)              \
+	VALIDATED_OP(OP_MULTIPLY, multiply, m_v, m_type, m_v, REAL, double)              \
+	VALIDATED_OP(OP_DIVIDE, divide, m_v, m_type, m_v, m_type, m_v)                   \
+	VALIDATED_OP(OP_DIVIDE, divide, m_v, m_type, m_v, INT, int64_t)                  \
+	VALIDATED_OP(OP_DIVIDE, divide, m_v, m_type, m_v, REAL, double)                  \
+	VALIDATED_OP(OP_EQUAL, equal, bool, m_type, m_v, m_type, m_v)                    \
+	VALIDATED_OP(OP_NOT_EQUAL, not_equal, bool, m_type, m_v, m_type, m_v)
+
+	VALIDATED_NUM_OPS(INT, int64_t, INT, int64_t, int64_t)
+	VALIDATED_NUM_OPS(INT, int64_t, REAL, double, double)
+	VALIDATED_NUM_OPS(REAL, double, INT, int64_t, double)
+	VALIDATED_NUM_OPS(REAL, double, REAL, double, double)
+
+#ifndef DEBUG_ENABLED
+	//debug builds report division by zero, which needs the generic path
+	VALIDATED_OP(OP_DIVIDE, divide, int64_t, INT, int64_t, INT, int64_t)
+	VALIDATED_OP(OP_DIVIDE, divide, double, INT, int64_t, REAL, double)
+	VALIDATED_OP(OP_DIVIDE, divide, double, REAL, double, INT, int64_t)
+	VALIDATED_OP(OP_DIVIDE, divide, double, REAL, double, REAL, double)
+	VALIDATED_OP(OP_MODULE, module, int64_t, INT, int64_t, INT, int64_t)
+#endif
+
+	VALIDATED_OP(OP_BIT_AND, bit_and, int64_t, INT, int64_t, INT, int64_t)
+	VALIDATED_OP(OP_BIT_OR, bit_or, int64_t, INT, int64_t, INT, int64_t)
+	VALIDATED_OP(OP_BIT_XOR, bit_xor, int64_t, INT, int64_t, INT, int64_t)
+	VALIDATED_OP(OP_EQUAL, equal, bool, BOOL, bool, BOOL, bool)
+	VALIDATED_OP(OP_NOT_EQUAL, not_equal, bool, BOOL, bool, BOOL, bool)
+
+	VALIDATED_UNARY(OP_NEGATE, negate, int64_t, INT, int64_t)
+	VALIDATED_UNARY(OP_NEGATE, negate, double, REAL, double)
+	VALIDATED_UNARY(OP_POSITIVE, positive, int64_t, INT, int64_t)
+	VALIDATED_UNARY(OP_POSITIVE, positive, double, REAL, double)
+	VALIDATED_UNARY(OP_BIT_NEGATE, bit_negate, int64_t, INT, int64_t)
+	VALIDATED_UNARY(OP_NOT, not, bool, BOOL, bool)
+	VALIDATED_UNARY(OP_NOT, not, bool, INT, int64_t)
+	VALIDATED_UNARY(OP_NOT, not, bool, REAL, double)
+
+	VALIDATED_VECTOR_OPS(VECTOR2, Vector2)
+	VALIDATED_OP(OP_MULTIPLY, multiply, Vector2, INT, int64_t, VECTOR2, Vector2)
+	VALIDATED_OP(OP_MULTIPLY, multiply, Vector2, REAL, double, VECTOR2, Vector2)
+	VALIDATED_UNARY(OP_NEGATE, negate, Vector2, VECTOR2, Vector2)
+	VALIDATED_UNARY(OP_POSITIVE, positive, Vector2, VECTOR2, Vector2)
+
+	VALIDATED_VECTOR_OPS(VECTOR3, Vector3)
+	VALIDATED_OP(OP_MULTIPLY, multiply, Vector3, INT, int64_t, VECTOR3, Vector3)
+	VALIDATED_OP(OP_MULTIPLY, multiply, Vector3, REAL, double, VECTOR3, Vector3)
+	VALIDATED_UNARY(OP_NEGATE, negate, Vector3, VECTOR3, Vector3)
+	VALIDATED_UNARY(OP_POSITIVE, positive, Vector3, VECTOR3, Vector3)
+
+	VALIDATED_VECTOR_OPS(COLOR, Color)
+	VALIDATED_UNARY(OP_NEGATE, negate, Color, COLOR, Color)
+
+#undef VALIDATED_OP
+#undef VALIDATED_UNARY
+#undef VALIDATED_NUM_OPS
+#undef VALIDATED_VECTOR_OPS
+
+	return NULL;
+}
+
+#define VALIDATED_MEMBER(m_type, m_member, m_value)                                                                 \
+	static void _validated_get_##m_type##_##m_member(const Variant *p_base, Variant *r_ret) {                     \
+		_VariantValidated::set(r_ret, m_value(_VariantValidated::get(p_base, (m_type *)NULL).m_member));          \
+	}                                                                                                             \
+	template <class V>                                                                                            \
+	static void _validated_set_##m_type##_##m_member(Variant *p_base, const Variant *p_value) {                   \
+		_VariantValidated::get_mem<m_type>(p_base).m_member = _VariantValidated::get(p_value, (V *)NULL);         \
+	}
+
+VALIDATED_MEMBER(Vector2, x, double)
+VALIDATED_MEMBER(Vector2, y, double)
+VALIDATED_MEMBER(Rect2, position, Vector2)
+VALIDATED_MEMBER(Rect2, size, Vector2)
+VALIDATED_MEMBER(Vector3, x, double)
+VALIDATED_MEMBER(Vector3, y, double)
+VALIDATED_MEMBER(Vector3, z, double)
+VALIDATED_MEMBER(Quat, x, double)
+VALIDATED_MEMBER(Quat, y, double)
+VALIDATED_MEMBER(Quat, z, double)
+VALIDATED_MEMBER(Quat, w, double)
+VALIDATED_MEMBER(Color, r, double)
+VALIDATED_MEMBER(Color, g, double)
+VALIDATED_MEMBER(Color, b, double)
+VALIDATED_MEMBER(Color, a, double)
+
+#undef VALIDATED_MEMBER
+
+Variant::ValidatedGetter Variant::get_validated_member_getter(Type p_type, const StringName &p_member) {
+
+#define VALIDATED_GETTER(m_variant_type, m_type, m_member)                                     \
+	if (p_type == m_variant_type && p_member == CoreStringNames::get_singleton()->m_member) { \
+		return &_validated_get_##m_type##_##m_member;                                         \
+	}
+
+	VALIDATED_GETTER(VECTOR2, Vector2, x)
+	VALIDATED_GETTER(VECTOR2, Vector2, y)
+	VALIDATED_GETTER(RECT2, Rect2, position)
+	VALIDATED_GETTER(RECT2, Rect2, size)
+	VALIDATED_GETTER(VECTOR3, Vector3, x)
+	VALIDATED_GETTER(VECTOR3, Vector3, y)
+	VALIDATED_GETTER(VECTOR3, Vector3, z)
+	VALIDATED_GETTER(QUAT, Quat, x)
+	VALIDATED_GETTER(QUAT, Quat, y)
+	VALIDATED_GETTER(QUAT, Quat, z)
+	VALIDATED_GETTER(QUAT, Quat, w)
+	VALIDATED_GETTER(COLOR, Color, r)
+	VALIDATED_GETTER(COLOR, Color, g)
+	VALIDATED_GETTER(COLOR, Color, b)
+	VALIDATED_GETTER(COLOR, Color, a)
+
+#undef VALIDATED_GETTER
+
+	return NULL;
+}
+
+Variant::ValidatedSetter Variant::get_validated_member_setter(Type p_type, const StringName &p_member, Type p_value_type) {
+
+#define VALIDATED_SETTER(m_variant_type, m_type, m_member, m_value_type, m_value)                                                      \
+	if (p_type == m_variant_type && p_value_type == m_value_type && p_member == CoreStringNames::get_singleton()->m_member) { \
+		return &_validated_set_##m_type##_##m_member<m_value>;                                                                        \
+	}
+#define VALIDATED_REAL_SETTER(m_variant_type, m_type, m_member)           \
+	VALIDATED_SETTER(m_variant_type, m_type, m_member, INT, int64_t) \
+	VALIDATED_SETTER(m_variant_type, m_type, m_member, REAL, double)
+
+	VALIDATED_REAL_SETTER(VECTOR2, Vector2, x)
+	VALIDATED_REAL_SETTER(VECTOR2, Vector2, y)
+	VALIDATED_SETTER(RECT2, Rect2, position, VECTOR2, Vector2)
+	VALIDATED_SETTER(RECT2, Rect2, size, VECTOR2, Vector2)
+	VALIDATED_REAL_SETTER(VECTOR3, Vector3, x)
+	VALIDATED_REAL_SETTER(VECTOR3, Vector3, y)
+	VALIDATED_REAL_SETTER(VECTOR3, Vector3, z)
+	VALIDATED_REAL_SETTER(QUAT, Quat, x)
+	VALIDATED_REAL_SETTER(QUAT, Quat, y)
+	VALIDATED_REAL_SETTER(QUAT, Quat, z)
+	VALIDATED_REAL_SETTER(QUAT, Quat, w)
+	VALIDATED_REAL_SETTER(COLOR, Color, r)
+	VALIDATED_REAL_SETTER(COLOR, Color, g)
+	VALIDATED_REAL_SETTER(COLOR, Color, b)
+	VALIDATED_REAL_SETTER(COLOR, Color, a)
+
+#undef VALIDATED_SETTER
+#undef VALIDATED_REAL_SETTER
+
+	return NULL;
+}
+
+static bool _validated_index_array(const Variant *p_base, const Variant *p_index, Variant *r_ret) {
+
+	const Array &arr = _VariantValidated::get(p_base, (Array *)NULL);
+	int index = _VariantValidated::get(p_index, (int64_t *)NULL);
+	if (index < 0)
+		index += arr.size();
+	if (index < 0 || index >= arr.size())
+		return false;
+
+	Variant value = arr[index]; //the destination may be the array itself
+	*r_ret = value;
+	return true;
+}
+
+template <class T, class R>
+static bool _validated_index_pool(const Variant *p_base, const Variant *p_index, Variant *r_ret) {
+
+	const PoolVector<T> &arr = _VariantValidated::get(p_base, (PoolVector<T> *)NULL);
+	int index = _VariantValidated::get(p_index, (int64_t *)NULL);
+	if (index < 0)
+		index += arr.size();
+	if (index < 0 || index >= arr.size())
+		return false;
+
+	_VariantValidated::set(r_ret, R(arr.get(index)));
+	return true;
+}
+
+static bool _validated_index_dictionary(const Variant *p_base, const Variant *p_index, Variant *r_ret) {
+
+	const Dictionary &dic = _VariantValidated::get(p_base, (Dictionary *)NULL);
+	const Variant *value = dic.getptr(*p_index);
+	if (!value)
+		return false; //missing keys are reported by get()
+
+	Variant ret = *value; //the destination may be the dictionary itself
+	*r_ret = ret;
+	return true;
+}
+
+Variant::ValidatedIndexedGetter Variant::get_validated_indexed_getter(Type p_type, Type p_index_type) {
+
+	if (p_type == DICTIONARY)
+		return &_validated_index_dictionary;
+
+	if (p_index_type != INT)
+		return NULL;
+
+	switch (p_type) {
+		case ARRAY: return &_validated_index_array;
+		case POOL_BYTE_ARRAY: return &_validated_index_pool<uint8_t, int64_t>;
+		case POOL_INT_ARRAY: return &_validated_index_pool<int, int64_t>;
+		case POOL_REAL_ARRAY: return &_validated_index_pool<real_t, double>;
+		case POOL_STRING_ARRAY: return &_validated_index_pool<String, String>;
+		case POOL_VECTOR2_ARRAY: return &_validated_index_pool<Vector2, Vector2>;
+		case POOL_VECTOR3_ARRAY: return &_validated_index_pool<Vector3, Vector3>;
+		case POOL_COLOR_ARRAY: return &_validated_index_pool<Color, Color>;
+		default: return NULL;
+	}
+}
+
+static bool _validated_set_index_array(Variant *p_base, const Variant *p_index, const Variant *p_value) {
+
+	Array &arr = _VariantValidated::get_mem<Array>(p_base);
+	int index = _VariantValidated::get(p_index, (int64_t *)NULL);
+	if (index < 0)
+		index += arr.size();
+	if (index < 0 || index >= arr.size())
+		return false;
+
+	arr[index] = *p_value;
+	return true;
+}
+
+template <class T, class V>
+static bool _validated_set_index_pool(Variant *p_base, const Variant *p_index, const Variant *p_value) {
+
+	PoolVector<T> &arr = _VariantValidated::get_mem<PoolVector<T> >(p_base);
+	int index = _VariantValidated::get(p_index, (int64_t *)NULL);
+	if (index < 0)
+		index += arr.size();
+	if (index < 0 || index >= arr.size())
+		return false;
+
+	arr.set(index, T(_VariantValidated::get(p_value, (V *)NULL)));
+	return true;
+}
+
+static bool _validated_set_index_dictionary(Variant *p_base, const Variant *p_index, const Variant *p_value) {
+
+	_VariantValidated::get_mem<Dictionary>(p_base)[*p_index] = *p_value;
+	return true;
+}
+
+Variant::ValidatedIndexedSetter Variant::get_validated_indexed_setter(Type p_type, Type p_index_type, Type p_value_type) {
+
+	//same conversions as set(), values of any other type go through it and fail there
+	if (p_type == DICTIONARY)
+		return &_validated_set_index_dictionary;
+
+	if (p_index_type != INT)
+		return NULL;
+
+#define VALIDATED_POOL_SETTER(m_variant_type, m_type, m_value_type, m_value) \
+	if (p_type == m_variant_type && p_value_type == m_value_type) {          \
+		return &_validated_set_index_pool<m_type, m_value>;                  \
+	}
+	VALIDATED_POOL_SETTER(POOL_BYTE_ARRAY, uint8_t, INT, int64_t)
+	VALIDATED_POOL_SETTER(POOL_BYTE_ARRAY, uint8_t, REAL, double)
+	VALIDATED_POOL_SETTER(POOL_INT_ARRAY, int, INT, int64_t)
+	VALIDATED_POOL_SETTER(POOL_INT_ARRAY, int, REAL, double)
+	VALIDATED_POOL_SETTER(POOL_REAL_ARRAY, real_t, INT, int64_t)
+	VALIDATED_POOL_SETTER(POOL_REAL_ARRAY, real_t, REAL, double)
+	VALIDATED_POOL_SETTER(POOL_STRING_ARRAY, String, STRING, String)
+	VALIDATED_POOL_SETTER(POOL_VECTOR2_ARRAY, Vector2, VECTOR2, Vector2)
+	VALIDATED_POOL_SETTER(POOL_VECTOR3_ARRAY, Vector3, VECTOR3, Vector3)
+	VALIDATED_POOL_SETTER(POOL_COLOR_ARRAY, Color, COLOR, Color)
+#undef VALIDATED_POOL_SETTER
+
+	if (p_type == ARRAY)
+		return &_validated_set_index_array;
+
+	return NULL;
+}
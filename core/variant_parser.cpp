@@ -35,37 +35,96 @@
 #include "core/os/keyboard.h"
 #include "core/string_buffer.h"
 
-CharType VariantParser::StreamFile::get_char() {
+CharType VariantParser::Stream::_get_char_slow() {
 
-	return f->get_8();
+	if (eof) {
+		return 0;
+	}
+
+	readahead_pointer = 0;
+	readahead_filled = _read_buffer(readahead_buffer, readahead_enabled ? READAHEAD_SIZE : 1);
+	if (readahead_filled == 0) {
+		eof = true;
+		return 0;
+	}
+
+	if (!readahead_enabled) {
+		readahead_filled = 0; //keep reading from the source one character at a time
+		return readahead_buffer[0];
+	}
+
+	return readahead_buffer[readahead_pointer++];
 }
 
-bool VariantParser::StreamFile::is_utf8() const {
+uint32_t VariantParser::StreamFile::_read_buffer(CharType *p_buffer, uint32_t p_num_chars) {
 
-	return true;
+	//read bytes into the start of the buffer and widen them in place, from the end
+	uint8_t *bytes = (uint8_t *)p_buffer;
+	int read = f->get_buffer(bytes, p_num_chars);
+	if (read <= 0) {
+		return 0;
+	}
+
+	for (int i = read - 1; i >= 0; i--) {
+		p_buffer[i] = bytes[i];
+	}
+	return read;
 }
-bool VariantParser::StreamFile::is_eof() const {
 
-	return f->eof_reached();
+bool VariantParser::StreamFile::is_utf8() const {
+
+	return true;
 }
 
-CharType VariantParser::StreamString::get_char() {
+uint32_t VariantParser::StreamString::_read_buffer(CharType *p_buffer, uint32_t p_num_chars) {
 
-	if (pos >= s.length())
+	int available = s.length() - pos;
+	if (available <= 0) {
 		return 0;
-	else
-		return s[pos++];
+	}
+
+	int count = MIN((int)p_num_chars, available);
+	copymem(p_buffer, s.ptr() + pos, count * sizeof(CharType));
+	pos += count;
+	return count;
 }
 
 bool VariantParser::StreamString::is_utf8() const {
 	return false;
 }
-bool VariantParser::StreamString::is_eof() const {
-	return pos > s.length();
-}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+enum {
+	CHAR_CLASS_HEX = 1 << 0,
+	CHAR_CLASS_IDENTIFIER_START = 1 << 1,
+	CHAR_CLASS_IDENTIFIER = 1 << 2,
+};
+
+static struct VariantParserCharClasses {
+
+	uint8_t table[128];
+
+	VariantParserCharClasses() {
+		for (int i = 0; i < 128; i++) {
+			bool digit = i >= '0' && i <= '9';
+			bool alpha = (i >= 'A' && i <= 'Z') || (i >= 'a' && i <= 'z');
+			table[i] = 0;
+			if (digit || (i >= 'a' && i <= 'f') || (i >= 'A' && i <= 'F'))
+				table[i] |= CHAR_CLASS_HEX;
+			if (alpha || i == '_')
+				table[i] |= CHAR_CLASS_IDENTIFIER_START | CHAR_CLASS_IDENTIFIER;
+			if (digit)
+				table[i] |= CHAR_CLASS_IDENTIFIER;
+		}
+	}
+} _char_classes;
+
+static _FORCE_INLINE_ bool _is_char_class(CharType p_char, uint8_t p_class) {
+
+	return (uint32_t)p_char < 128 && (_char_classes.table[p_char] & p_class);
+}
+
 const char *VariantParser::tk_name[TK_MAX] = {
 	"'{'",
 	"'}'",
@@ -185,7 +244,7 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					if (p_stream->is_eof()) {
 						r_token.type = TK_EOF;
 						return OK;
-					} else if ((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F')) {
+					} else if (_is_char_class(ch, CHAR_CLASS_HEX)) {
 						color_str += ch;
 
 					} else {
@@ -200,7 +259,7 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 			};
 			case '"': {
 
-				String str;
+				StringBuffer<> str;
 				while (true) {
 
 					CharType ch = p_stream->get_char();
@@ -238,7 +297,7 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 										r_token.type = TK_ERROR;
 										return ERR_PARSE_ERROR;
 									}
-									if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))) {
+									if (!_is_char_class(c, CHAR_CLASS_HEX)) {
 
 										r_err_str = "Malformed hex constant in string";
 										r_token.type = TK_ERROR;
@@ -282,11 +341,12 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					}
 				}
 
+				String result = str.as_string();
 				if (p_stream->is_utf8()) {
-					str.parse_utf8(str.ascii(true).get_data());
+					result.parse_utf8(result.ascii(true).get_data());
 				}
 				r_token.type = TK_STRING;
-				r_token.value = str;
+				r_token.value = result;
 				return OK;
 
 			} break;
@@ -376,16 +436,16 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 						r_token.value = num.as_int();
 					return OK;
 
-				} else if ((cchar >= 'A' && cchar <= 'Z') || (cchar >= 'a' && cchar <= 'z') || cchar == '_') {
+				} else if (_is_char_class(cchar, CHAR_CLASS_IDENTIFIER_START)) {
 
 					StringBuffer<> id;
-					bool first = true;
+					id += cchar;
+					cchar = p_stream->get_char();
 
-					while ((cchar >= 'A' && cchar <= 'Z') || (cchar >= 'a' && cchar <= 'z') || cchar == '_' || (!first && cchar >= '0' && cchar <= '9')) {
+					while (_is_char_class(cchar, CHAR_CLASS_IDENTIFIER)) {
 
 						id += cchar;
 						cchar = p_stream->get_char();
-						first = false;
 					}
 
 					p_stream->saved = cchar;
@@ -1568,7 +1628,24 @@ static String rtosfix(double p_value) {
 		return rtoss(p_value);
 }
 
-Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_string_func, void *p_store_string_ud, EncodeResourceFunc p_encode_res_func, void *p_encode_res_ud) {
+static Error _write_to_str(void *ud, const String &p_string) {
+
+	String *str = (String *)ud;
+	(*str) += p_string;
+	return OK;
+}
+
+Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_string_func, void *p_store_string_ud, EncodeResourceFunc p_encode_res_func, void *p_encode_res_ud, PoolArrayCache *p_cache) {
+
+	if (p_cache && PoolArrayCache::is_cacheable(p_variant)) {
+
+		String text;
+		if (!p_cache->get(p_variant, text)) {
+			write(p_variant, _write_to_str, &text, p_encode_res_func, p_encode_res_ud);
+			p_cache->set(p_variant, text);
+		}
+		return p_store_string_func(p_store_string_ud, text);
+	}
 
 	switch (p_variant.get_type()) {
 
@@ -1752,7 +1829,7 @@ Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_str
 					}
 
 					p_store_string_func(p_store_string_ud, "\"" + E->get().name + "\":");
-					write(obj->get(E->get().name), p_store_string_func, p_store_string_ud, p_encode_res_func, p_encode_res_ud);
+					write(obj->get(E->get().name), p_store_string_func, p_store_string_ud, p_encode_res_func, p_encode_res_ud, p_cache);
 				}
 			}
 
@@ -1775,9 +1852,9 @@ Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_str
 				if (!_check_type(dict[E->get()]))
 					continue;
 				*/
-				write(E->get(), p_store_string_func, p_store_string_ud, p_encode_res_func, p_encode_res_ud);
+				write(E->get(), p_store_string_func, p_store_string_ud, p_encode_res_func, p_encode_res_ud, p_cache);
 				p_store_string_func(p_store_string_ud, ": ");
-				write(dict[E->get()], p_store_string_func, p_store_string_ud, p_encode_res_func, p_encode_res_ud);
+				write(dict[E->get()], p_store_string_func, p_store_string_ud, p_encode_res_func, p_encode_res_ud, p_cache);
 				if (E->next())
 					p_store_string_func(p_store_string_ud, ",\n");
 			}
@@ -1794,7 +1871,7 @@ Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_str
 
 				if (i > 0)
 					p_store_string_func(p_store_string_ud, ", ");
-				write(array[i], p_store_string_func, p_store_string_ud, p_encode_res_func, p_encode_res_ud);
+				write(array[i], p_store_string_func, p_store_string_ud, p_encode_res_func, p_encode_res_ud, p_cache);
 			}
 			p_store_string_func(p_store_string_ud, " ]");
 
@@ -1939,16 +2016,131 @@ Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_str
 	return OK;
 }
 
-static Error _write_to_str(void *ud, const String &p_string) {
+Error VariantWriter::write_to_string(const Variant &p_variant, String &r_string, EncodeResourceFunc p_encode_res_func, void *p_encode_res_ud, PoolArrayCache *p_cache) {
 
-	String *str = (String *)ud;
-	(*str) += p_string;
-	return OK;
+	r_string = String();
+
+	return write(p_variant, _write_to_str, &r_string, p_encode_res_func, p_encode_res_ud, p_cache);
 }
 
-Error VariantWriter::write_to_string(const Variant &p_variant, String &r_string, EncodeResourceFunc p_encode_res_func, void *p_encode_res_ud) {
+uint64_t VariantWriter::PoolArrayCache::_get_data_key(const Variant &p_array, int *r_size) {
 
-	r_string = String();
+	switch (p_array.get_type()) {
+		case Variant::POOL_BYTE_ARRAY: {
+			PoolVector<uint8_t> data = p_array;
+			if (r_size) {
+				*r_size = data.size();
+			}
+			return (uint64_t)data.read().ptr();
+		}
+		case Variant::POOL_INT_ARRAY: {
+			PoolVector<int> data = p_array;
+			if (r_size) {
+				*r_size = data.size();
+			}
+			return (uint64_t)data.read().ptr();
+		}
+		case Variant::POOL_REAL_ARRAY: {
+			PoolVector<real_t> data = p_array;
+			if (r_size) {
+				*r_size = data.size();
+			}
+			return (uint64_t)data.read().ptr();
+		}
+		case Variant::POOL_STRING_ARRAY: {
+			PoolVector<String> data = p_array;
+			if (r_size) {
+				*r_size = data.size();
+			}
+			return (uint64_t)data.read().ptr();
+		}
+		case Variant::POOL_VECTOR2_ARRAY: {
+			PoolVector<Vector2> data = p_array;
+			if (r_size) {
+				*r_size = data.size();
+			}
+			return (uint64_t)data.read().ptr();
+		}
+		case Variant::POOL_VECTOR3_ARRAY: {
+			PoolVector<Vector3> data = p_array;
+			if (r_size) {
+				*r_size = data.size();
+			}
+			return (uint64_t)data.read().ptr();
+		}
+		case Variant::POOL_COLOR_ARRAY: {
+			PoolVector<Color> data = p_array;
+			if (r_size) {
+				*r_size = data.size();
+			}
+			return (uint64_t)data.read().ptr();
+		}
+		default: {
+			return 0;
+		}
+	}
+}
+
+bool VariantWriter::PoolArrayCache::is_cacheable(const Variant &p_variant) {
+
+	int size = 0;
+	return _get_data_key(p_variant, &size) && size >= MIN_ARRAY_SIZE;
+}
+
+bool VariantWriter::PoolArrayCache::get(const Variant &p_array, String &r_text) {
+
+	uint64_t key = _get_data_key(p_array);
+	Entry *entry = key ? entries.getptr(key) : NULL;
+	//the cached reference reads the same data if, and only if, nothing wrote to the array since
+	if (!entry || entry->array.get_type() != p_array.get_type() || _get_data_key(entry->array) != key) {
+		return false;
+	}
+
+	entry->last_pass = pass;
+	r_text = entry->text;
+	return true;
+}
+
+void VariantWriter::PoolArrayCache::set(const Variant &p_array, const String &p_text) {
+
+	uint64_t key = _get_data_key(p_array);
+	if (!key) {
+		return;
+	}
+
+	Entry entry;
+	entry.array = p_array;
+	entry.text = p_text;
+	entry.last_pass = pass;
+	entries[key] = entry;
+}
+
+void VariantWriter::PoolArrayCache::begin_pass() {
+
+	pass++;
+}
+
+void VariantWriter::PoolArrayCache::end_pass() {
+
+	List<uint64_t> unused;
+	const uint64_t *key = NULL;
+	while ((key = entries.next(key))) {
+		if (pass - entries[*key].last_pass >= MAX_UNUSED_PASSES) {
+			unused.push_back(*key);
+		}
+	}
+
+	for (List<uint64_t>::Element *E = unused.front(); E; E = E->next()) {
+		entries.erase(E->get());
+	}
+}
+
+void VariantWriter::PoolArrayCache::clear() {
+
+	entries.clear();
+}
+
+VariantWriter::PoolArrayCache::PoolArrayCache() {
 
-	return write(p_variant, _write_to_str, &r_string, p_encode_res_func, p_encode_res_ud);
+	pass = 0;
 }
@@ -31,6 +31,7 @@
 #ifndef VARIANT_PARSER_H
 #define VARIANT_PARSER_H
 
+#include "core/hash_map.h"
 #include "core/os/file_access.h"
 #include "core/resource.h"
 #include "core/variant.h"
@@ -39,36 +40,67 @@ class VariantParser {
 public:
 	struct Stream {
 
-		virtual CharType get_char() = 0;
-		virtual bool is_utf8() const = 0;
-		virtual bool is_eof() const = 0;
+	private:
+		enum {
+			READAHEAD_SIZE = 2048
+		};
+
+		CharType readahead_buffer[READAHEAD_SIZE];
+		uint32_t readahead_pointer;
+		uint32_t readahead_filled;
+		bool eof;
+
+		CharType _get_char_slow();
 
+	protected:
+		virtual uint32_t _read_buffer(CharType *p_buffer, uint32_t p_num_chars) = 0;
+
+	public:
+		//disable to keep the position of the underlying source exact after each character
+		bool readahead_enabled;
 		CharType saved;
 
+		_FORCE_INLINE_ CharType get_char() {
+			if (likely(readahead_pointer < readahead_filled)) {
+				return readahead_buffer[readahead_pointer++];
+			}
+			return _get_char_slow();
+		}
+		virtual bool is_utf8() const = 0;
+		_FORCE_INLINE_ bool is_eof() const { return eof; }
+
 		Stream() :
+				readahead_pointer(0),
+				readahead_filled(0),
+				eof(false),
+				readahead_enabled(true),
 				saved(0) {}
 		virtual ~Stream() {}
 	};
 
 	struct StreamFile : public Stream {
 
+	protected:
+		virtual uint32_t _read_buffer(CharType *p_buffer, uint32_t p_num_chars);
+
+	public:
 		FileAccess *f;
 
-		virtual CharType get_char();
 		virtual bool is_utf8() const;
-		virtual bool is_eof() const;
 
 		StreamFile() { f = NULL; }
 	};
 
 	struct StreamString : public Stream {
 
+	protected:
+		virtual uint32_t _read_buffer(CharType *p_buffer, uint32_t p_num_chars);
+
+	public:
 		String s;
 		int pos;
 
-		virtual CharType get_char();
 		virtual bool is_utf8() const;
-		virtual bool is_eof() const;
 
 		StreamString() { pos = 0; }
 	};
@@ -147,8 +179,41 @@ public:
 	typedef Error (*StoreStringFunc)(void *ud, const String &p_string);
 	typedef String (*EncodeResourceFunc)(void *ud, const RES &p_resource);
 
-	static Error write(const Variant &p_variant, StoreStringFunc p_store_string_func, void *p_store_string_ud, EncodeResourceFunc p_encode_res_func, void *p_encode_res_ud);
-	static Error write_to_string(const Variant &p_variant, String &r_string, EncodeResourceFunc p_encode_res_func = NULL, void *p_encode_res_ud = NULL);
+	//keeps the text of large pool arrays between writes; entries hold a reference to their array,
+	//so writing to it afterwards copies the data and an unchanged data pointer means unchanged contents
+	class PoolArrayCache {
+
+		struct Entry {
+			Variant array;
+			String text;
+			uint64_t last_pass;
+		};
+
+		HashMap<uint64_t, Entry> entries;
+		uint64_t pass;
+
+		static uint64_t _get_data_key(const Variant &p_array, int *r_size = NULL);
+
+	public:
+		enum {
+			MIN_ARRAY_SIZE = 1024,
+			MAX_UNUSED_PASSES = 64
+		};
+
+		static bool is_cacheable(const Variant &p_variant);
+
+		bool get(const Variant &p_array, String &r_text);
+		void set(const Variant &p_array, const String &p_text);
+
+		void begin_pass();
+		void end_pass(); //drops the entries that were not used for MAX_UNUSED_PASSES passes
+		void clear();
+
+		PoolArrayCache();
+	};
+
+	static Error write(const Variant &p_variant, StoreStringFunc p_store_string_func, void *p_store_string_ud, EncodeResourceFunc p_encode_res_func, void *p_encode_res_ud, PoolArrayCache *p_cache = NULL);
+	static Error write_to_string(const Variant &p_variant, String &r_string, EncodeResourceFunc p_encode_res_func = NULL, void *p_encode_res_ud = NULL, PoolArrayCache *p_cache = NULL);
 };
 
 #endif // VARIANT_PARSER_H
@@ -155,7 +155,10 @@ Error AudioDriverALSA::init() {
 	Error err = init_device();
 	if (err == OK) {
 		mutex = Mutex::create();
-		thread = Thread::create(AudioDriverALSA::thread_func, this);
+		Thread::Settings settings;
+		settings.priority = Thread::PRIORITY_REALTIME;
+		settings.name = "AudioDriverALSA";
+		thread = Thread::create(AudioDriverALSA::thread_func, this, settings);
 	}
 
 	return err;
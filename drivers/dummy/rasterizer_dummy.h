@@ -44,7 +44,10 @@ public:
 	RID shadow_atlas_create() { return RID(); }
 	void shadow_atlas_set_size(RID p_atlas, int p_size) {}
 	void shadow_atlas_set_quadrant_subdivision(RID p_atlas, int p_quadrant, int p_subdivision) {}
-	bool shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version) { return false; }
+	bool shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version, uint64_t &r_drawn_version) {
+		r_drawn_version = 0;
+		return false;
+	}
 
 	int get_directional_light_shadow_size(RID p_light_intance) { return 0; }
 	void set_directional_shadow_count(int p_count) {}
@@ -71,6 +74,8 @@ public:
 
 	void environment_set_ssr(RID p_env, bool p_enable, int p_max_steps, float p_fade_int, float p_fade_out, float p_depth_tolerance, bool p_roughness) {}
 	void environment_set_ssao(RID p_env, bool p_enable, float p_radius, float p_intensity, float p_radius2, float p_intensity2, float p_bias, float p_light_affect, float p_ao_channel_affect, const Color &p_color, VS::EnvironmentSSAOQuality p_quality, VS::EnvironmentSSAOBlur p_blur, float p_bilateral_sharpness) {}
+	void environment_set_ssr_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal) {}
+	void environment_set_ssao_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal) {}
 
 	void environment_set_tonemap(RID p_env, VS::EnvironmentToneMapper p_tone_mapper, float p_exposure, float p_white, bool p_auto_exposure, float p_min_luminance, float p_max_luminance, float p_auto_exp_speed, float p_auto_exp_scale) {}
 
@@ -110,6 +115,7 @@ public:
 	void render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count) {}
 
 	void set_scene_pass(uint64_t p_pass) {}
+	void set_stereo_pass(StereoPass p_pass) {}
 	void set_debug_draw_mode(VS::ViewportDebugDraw p_debug_draw) {}
 
 	bool free(RID p_rid) { return true; }
@@ -240,6 +246,9 @@ public:
 	void texture_set_detect_srgb_callback(RID p_texture, VisualServer::TextureDetectCallback p_callback, void *p_userdata) {}
 	void texture_set_detect_normal_callback(RID p_texture, VisualServer::TextureDetectCallback p_callback, void *p_userdata) {}
 
+	void texture_set_stream_callback(RID p_texture, VisualServer::TextureStreamCallback p_callback, void *p_userdata) {}
+	void texture_set_stream_data(RID p_texture, const Ref<Image> &p_image, int p_first_mipmap) {}
+
 	void textures_keep_original(bool p_enable) {}
 
 	void texture_set_proxy(RID p_proxy, RID p_base) {}
@@ -396,6 +405,8 @@ public:
 		return m->surfaces[p_surface].bone_aabbs;
 	}
 
+	void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_edge_lengths, const Vector<PoolVector<uint8_t> > &p_index_arrays) {}
+
 	void mesh_remove_surface(RID p_mesh, int p_index) {
 		DummyMesh *m = mesh_owner.getornull(p_mesh);
 		ERR_FAIL_COND(!m);
@@ -436,6 +447,7 @@ public:
 	Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const { return Color(); }
 
 	void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array) {}
+	void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) {}
 
 	void multimesh_set_visible_instances(RID p_multimesh, int p_visible) {}
 	int multimesh_get_visible_instances(RID p_multimesh) const { return 0; }
@@ -466,6 +478,7 @@ public:
 	void skeleton_set_world_transform(RID p_skeleton, bool p_enable, const Transform &p_world_transform) {}
 	int skeleton_get_bone_count(RID p_skeleton) const { return 0; }
 	void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) {}
+	void skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms) {}
 	Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const { return Transform(); }
 	void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {}
 	Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const { return Transform2D(); }
@@ -672,6 +685,8 @@ public:
 	void particles_set_process_material(RID p_particles, RID p_material) {}
 	void particles_set_fixed_fps(RID p_particles, int p_fps) {}
 	void particles_set_fractional_delta(RID p_particles, bool p_enable) {}
+	void particles_set_collision_heightfield(RID p_particles, RID p_texture, const AABB &p_aabb) {}
+	void particles_set_collision_bounce(RID p_particles, float p_bounce) {}
 	void particles_restart(RID p_particles) {}
 
 	void particles_set_draw_order(RID p_particles, VS::ParticlesDrawOrder p_order) {}
@@ -737,6 +752,8 @@ public:
 
 	void set_debug_generate_wireframes(bool p_generate) {}
 
+	void warm_up_shaders() {}
+
 	void render_info_begin_capture() {}
 	void render_info_end_capture() {}
 	int get_captured_render_info(VS::RenderInfo p_info) { return 0; }
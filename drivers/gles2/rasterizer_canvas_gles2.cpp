@@ -541,6 +541,549 @@ static const GLenum gl_primitive[] = {
 	GL_TRIANGLE_FAN
 };
 
+bool RasterizerCanvasGLES2::_get_batch_command_textures(const Item::Command *p_command, RID &r_texture, RID &r_normal_map) const {
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+			r_texture = rect->texture;
+			r_normal_map = rect->normal_map;
+		} break;
+		case Item::Command::TYPE_NINEPATCH: {
+
+			const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+			r_texture = np->texture;
+			r_normal_map = np->normal_map;
+		} break;
+		case Item::Command::TYPE_PRIMITIVE: {
+
+			const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(p_command);
+			r_texture = primitive->texture;
+			r_normal_map = primitive->normal_map;
+		} break;
+		case Item::Command::TYPE_POLYGON: {
+
+			const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(p_command);
+			r_texture = polygon->texture;
+			r_normal_map = polygon->normal_map;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool RasterizerCanvasGLES2::_get_batch_command_size(const Item::Command *p_command, const RasterizerStorageGLES2::Texture *p_texture, int &r_vertex_count, int &r_index_count) const {
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+
+			if (rect->flags & CANVAS_RECT_CLIP_UV) {
+				return false; // needs the per rect clamp done in the fragment shader
+			}
+
+			if (p_texture) {
+				if (rect->flags & CANVAS_RECT_TILE) {
+					if (!(p_texture->flags & VS::TEXTURE_FLAG_REPEAT)) {
+						return false; // needs the wrap mode toggled around the draw
+					}
+					if (!storage->config.support_npot_repeat_mipmap && (next_power_of_2(p_texture->alloc_width) != (unsigned int)p_texture->alloc_width || next_power_of_2(p_texture->alloc_height) != (unsigned int)p_texture->alloc_height)) {
+						return false; // needs USE_FORCE_REPEAT
+					}
+				}
+				if (rect->flags & (CANVAS_RECT_FLIP_H | CANVAS_RECT_FLIP_V) && rect->normal_map.is_valid()) {
+					return false; // flipped normals are handled by the texture rect shader
+				}
+			}
+
+			r_vertex_count = 4;
+			r_index_count = 6;
+		} break;
+		case Item::Command::TYPE_NINEPATCH: {
+
+			if (!p_texture || p_texture->width == 0 || p_texture->height == 0) {
+				return false; // let the regular path warn about it
+			}
+
+			const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+
+			r_vertex_count = 16;
+			r_index_count = np->draw_center ? 9 * 6 : 8 * 6;
+		} break;
+		case Item::Command::TYPE_PRIMITIVE: {
+
+			const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(p_command);
+			int point_count = primitive->points.size();
+
+			if (point_count < 3 || point_count > 4) {
+				return false; // points and lines can't go in a triangle batch
+			}
+			if (primitive->colors.size() > 1 && primitive->colors.size() != point_count) {
+				return false;
+			}
+			if (primitive->uvs.size() && primitive->uvs.size() != point_count) {
+				return false;
+			}
+
+			r_vertex_count = point_count;
+			r_index_count = point_count == 4 ? 6 : 3;
+		} break;
+		case Item::Command::TYPE_POLYGON: {
+
+			const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(p_command);
+			int point_count = polygon->points.size();
+
+			if (polygon->antialiased || polygon->count <= 0 || polygon->count > polygon->indices.size()) {
+				return false;
+			}
+			if (polygon->colors.size() > 1 && polygon->colors.size() != point_count) {
+				return false;
+			}
+			if (polygon->uvs.size() && polygon->uvs.size() != point_count) {
+				return false;
+			}
+
+			r_vertex_count = point_count;
+			r_index_count = polygon->count;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool RasterizerCanvasGLES2::_get_batch_item_size(const Item *p_item, const RID &p_texture, const RID &p_normal_map, const RasterizerStorageGLES2::Texture *p_texture_ptr, int &r_vertex_count, int &r_index_count) const {
+
+	int command_count = p_item->commands.size();
+	Item::Command *const *commands = p_item->commands.ptr();
+
+	if (command_count == 0) {
+		return false;
+	}
+
+	r_vertex_count = 0;
+	r_index_count = 0;
+
+	for (int i = 0; i < command_count; i++) {
+
+		RID command_texture;
+		RID command_normal_map;
+		if (!_get_batch_command_textures(commands[i], command_texture, command_normal_map) || command_texture != p_texture || command_normal_map != p_normal_map) {
+			return false;
+		}
+
+		int command_vertices;
+		int command_indices;
+		if (!_get_batch_command_size(commands[i], p_texture_ptr, command_vertices, command_indices)) {
+			return false;
+		}
+
+		r_vertex_count += command_vertices;
+		r_index_count += command_indices;
+	}
+
+	return true;
+}
+
+void RasterizerCanvasGLES2::_fill_batch_command(const Item::Command *p_command, const RasterizerStorageGLES2::Texture *p_texture, const Transform2D *p_xform, int &r_vertex_ofs, int &r_index_ofs) {
+
+	Vector2 *vertices = &data.batch_vertices[r_vertex_ofs];
+	Vector2 *uvs = &data.batch_uvs[r_vertex_ofs];
+	Color *colors = &data.batch_colors[r_vertex_ofs];
+	int *indices = &data.batch_indices[r_index_ofs];
+
+	int vertex_count = 0;
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+
+			Rect2 dst_rect = Rect2(rect->rect.position, rect->rect.size);
+			Rect2 src_rect = Rect2(0, 0, 1, 1);
+			bool transpose = false;
+
+			if (dst_rect.size.width < 0) {
+				dst_rect.position.x += dst_rect.size.width;
+				dst_rect.size.width *= -1;
+			}
+			if (dst_rect.size.height < 0) {
+				dst_rect.position.y += dst_rect.size.height;
+				dst_rect.size.height *= -1;
+			}
+
+			if (p_texture) {
+
+				Size2 texpixel_size(1.0 / p_texture->width, 1.0 / p_texture->height);
+				if (rect->flags & CANVAS_RECT_REGION) {
+					src_rect = Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size);
+				}
+				if (rect->flags & CANVAS_RECT_FLIP_H) {
+					src_rect.size.x *= -1;
+				}
+				if (rect->flags & CANVAS_RECT_FLIP_V) {
+					src_rect.size.y *= -1;
+				}
+				transpose = rect->flags & CANVAS_RECT_TRANSPOSE;
+			}
+
+			// Same mapping the texture rect shader does on the unit quad.
+			static const Vector2 quad[4] = { Vector2(0, 0), Vector2(0, 1), Vector2(1, 1), Vector2(1, 0) };
+
+			for (int i = 0; i < 4; i++) {
+
+				Vector2 v = quad[i];
+				Vector2 pos_v(src_rect.size.x < 0 ? 1.0 - v.x : v.x, src_rect.size.y < 0 ? 1.0 - v.y : v.y);
+				vertices[i] = dst_rect.position + dst_rect.size * pos_v;
+				uvs[i] = src_rect.position + src_rect.size.abs() * (transpose ? Vector2(v.y, v.x) : v);
+				colors[i] = rect->modulate;
+			}
+
+			indices[0] = r_vertex_ofs + 0;
+			indices[1] = r_vertex_ofs + 1;
+			indices[2] = r_vertex_ofs + 2;
+			indices[3] = r_vertex_ofs + 0;
+			indices[4] = r_vertex_ofs + 2;
+			indices[5] = r_vertex_ofs + 3;
+
+			vertex_count = 4;
+			r_index_ofs += 6;
+		} break;
+		case Item::Command::TYPE_NINEPATCH: {
+
+			const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+
+			Size2 texpixel_size(1.0 / p_texture->width, 1.0 / p_texture->height);
+
+			Rect2 source = np->source;
+			if (source.size.x == 0 && source.size.y == 0) {
+				source.size.x = p_texture->width;
+				source.size.y = p_texture->height;
+			}
+
+			// Same scaling as the regular nine-patch path.
+			float screen_scale = 1.0;
+			if (source.size.x != 0 && source.size.y != 0) {
+				screen_scale = MIN(np->rect.size.x / source.size.x, np->rect.size.y / source.size.y);
+				screen_scale = MIN(1.0, screen_scale);
+			}
+
+			float x[4] = {
+				np->rect.position.x,
+				np->rect.position.x + np->margin[MARGIN_LEFT] * screen_scale,
+				np->rect.position.x + np->rect.size.x - np->margin[MARGIN_RIGHT] * screen_scale,
+				np->rect.position.x + np->rect.size.x
+			};
+			float y[4] = {
+				np->rect.position.y,
+				np->rect.position.y + np->margin[MARGIN_TOP] * screen_scale,
+				np->rect.position.y + np->rect.size.y - np->margin[MARGIN_BOTTOM] * screen_scale,
+				np->rect.position.y + np->rect.size.y
+			};
+			float u[4] = {
+				source.position.x * texpixel_size.x,
+				(source.position.x + np->margin[MARGIN_LEFT]) * texpixel_size.x,
+				(source.position.x + source.size.x - np->margin[MARGIN_RIGHT]) * texpixel_size.x,
+				(source.position.x + source.size.x) * texpixel_size.x
+			};
+			float v[4] = {
+				source.position.y * texpixel_size.y,
+				(source.position.y + np->margin[MARGIN_TOP]) * texpixel_size.y,
+				(source.position.y + source.size.y - np->margin[MARGIN_BOTTOM]) * texpixel_size.y,
+				(source.position.y + source.size.y) * texpixel_size.y
+			};
+
+			for (int j = 0; j < 4; j++) {
+				for (int i = 0; i < 4; i++) {
+					vertices[j * 4 + i] = Vector2(x[i], y[j]);
+					uvs[j * 4 + i] = Vector2(u[i], v[j]);
+					colors[j * 4 + i] = np->color;
+				}
+			}
+
+			int index_count = 0;
+
+			for (int j = 0; j < 3; j++) {
+				for (int i = 0; i < 3; i++) {
+
+					if (i == 1 && j == 1 && !np->draw_center) {
+						continue;
+					}
+
+					int a = j * 4 + i;
+
+					indices[index_count++] = r_vertex_ofs + a;
+					indices[index_count++] = r_vertex_ofs + a + 1;
+					indices[index_count++] = r_vertex_ofs + a + 5;
+					indices[index_count++] = r_vertex_ofs + a + 5;
+					indices[index_count++] = r_vertex_ofs + a + 4;
+					indices[index_count++] = r_vertex_ofs + a;
+				}
+			}
+
+			vertex_count = 16;
+			r_index_ofs += index_count;
+		} break;
+		case Item::Command::TYPE_PRIMITIVE: {
+
+			const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(p_command);
+			int point_count = primitive->points.size();
+			const Vector2 *points = primitive->points.ptr();
+
+			for (int i = 0; i < point_count; i++) {
+				vertices[i] = points[i];
+				uvs[i] = primitive->uvs.size() ? primitive->uvs[i] : Vector2();
+				if (primitive->colors.size() > 1) {
+					colors[i] = primitive->colors[i];
+				} else {
+					colors[i] = primitive->colors.size() ? primitive->colors[0] : Color(1, 1, 1, 1);
+				}
+			}
+
+			indices[0] = r_vertex_ofs + 0;
+			indices[1] = r_vertex_ofs + 1;
+			indices[2] = r_vertex_ofs + 2;
+			if (point_count == 4) {
+				indices[3] = r_vertex_ofs + 0;
+				indices[4] = r_vertex_ofs + 2;
+				indices[5] = r_vertex_ofs + 3;
+			}
+
+			vertex_count = point_count;
+			r_index_ofs += point_count == 4 ? 6 : 3;
+		} break;
+		case Item::Command::TYPE_POLYGON: {
+
+			const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(p_command);
+			int point_count = polygon->points.size();
+			const Vector2 *points = polygon->points.ptr();
+			const int *polygon_indices = polygon->indices.ptr();
+
+			for (int i = 0; i < point_count; i++) {
+				vertices[i] = points[i];
+				uvs[i] = polygon->uvs.size() ? polygon->uvs[i] : Vector2();
+				if (polygon->colors.size() > 1) {
+					colors[i] = polygon->colors[i];
+				} else {
+					colors[i] = polygon->colors.size() ? polygon->colors[0] : Color(1, 1, 1, 1);
+				}
+			}
+
+			for (int i = 0; i < polygon->count; i++) {
+				indices[i] = r_vertex_ofs + polygon_indices[i];
+			}
+
+			vertex_count = point_count;
+			r_index_ofs += polygon->count;
+		} break;
+		default: {
+		}
+	}
+
+	if (p_xform) {
+		// Joined items are drawn with an identity modelview, so move them to canvas space here.
+		for (int i = 0; i < vertex_count; i++) {
+			vertices[i] = p_xform->xform(vertices[i]);
+		}
+	}
+
+	r_vertex_ofs += vertex_count;
+}
+
+int RasterizerCanvasGLES2::_canvas_item_batch_commands(Item::Command *const *p_commands, int p_count, RasterizerStorageGLES2::Material *p_material) {
+
+	if (!state.use_batching || !state.batching_allowed || state.using_skeleton || p_count < 2) {
+		return 0;
+	}
+
+	RID texture;
+	RID normal_map;
+
+	if (!_get_batch_command_textures(p_commands[0], texture, normal_map)) {
+		return 0;
+	}
+
+	RasterizerStorageGLES2::Texture *texture_ptr = storage->texture_owner.getornull(texture);
+	if (texture_ptr) {
+		texture_ptr = texture_ptr->get_ptr();
+	}
+
+	int batch_size = 0;
+	int vertex_count = 0;
+	int index_count = 0;
+
+	while (batch_size < p_count) {
+
+		RID command_texture;
+		RID command_normal_map;
+		if (!_get_batch_command_textures(p_commands[batch_size], command_texture, command_normal_map) || command_texture != texture || command_normal_map != normal_map) {
+			break;
+		}
+
+		int command_vertices;
+		int command_indices;
+		if (!_get_batch_command_size(p_commands[batch_size], texture_ptr, command_vertices, command_indices)) {
+			break;
+		}
+
+		if (vertex_count + command_vertices > data.batch_max_vertices || index_count + command_indices > data.batch_max_indices) {
+			break;
+		}
+
+		vertex_count += command_vertices;
+		index_count += command_indices;
+		batch_size++;
+	}
+
+	if (batch_size < 2) {
+		return 0; // nothing to gain, let the regular path draw it
+	}
+
+	state.canvas_shader.set_conditional(CanvasShaderGLES2::USE_TEXTURE_RECT, false);
+	if (state.canvas_shader.bind()) {
+		_set_uniforms();
+		state.canvas_shader.use_material((void *)p_material);
+	}
+
+	RasterizerStorageGLES2::Texture *bound_texture = _bind_canvas_texture(texture, normal_map);
+
+	if (bound_texture) {
+		Size2 texpixel_size(1.0 / bound_texture->width, 1.0 / bound_texture->height);
+		state.canvas_shader.set_uniform(CanvasShaderGLES2::COLOR_TEXPIXEL_SIZE, texpixel_size);
+	}
+
+	int vertex_ofs = 0;
+	int index_ofs = 0;
+
+	for (int i = 0; i < batch_size; i++) {
+		_fill_batch_command(p_commands[i], bound_texture, NULL, vertex_ofs, index_ofs);
+	}
+
+	_draw_polygon(data.batch_indices, index_ofs, vertex_ofs, data.batch_vertices, data.batch_uvs, data.batch_colors, false);
+
+	return batch_size;
+}
+
+int RasterizerCanvasGLES2::_canvas_item_join_items(Item *p_item, const RID &p_material, RasterizerStorageGLES2::Material *p_material_ptr) {
+
+	if (!state.use_batching || !state.use_item_joining || !state.batching_allowed || !state.joining_allowed || state.using_skeleton || !p_item->next) {
+		return 0;
+	}
+
+	if (p_item->commands.size() == 0) {
+		return 0;
+	}
+
+	RID texture;
+	RID normal_map;
+
+	if (!_get_batch_command_textures(p_item->commands[0], texture, normal_map)) {
+		return 0;
+	}
+
+	RasterizerStorageGLES2::Texture *texture_ptr = storage->texture_owner.getornull(texture);
+	if (texture_ptr) {
+		texture_ptr = texture_ptr->get_ptr();
+	}
+
+	int vertex_count;
+	int index_count;
+
+	if (!_get_batch_item_size(p_item, texture, normal_map, texture_ptr, vertex_count, index_count)) {
+		return 0;
+	}
+
+	if (vertex_count > data.batch_max_vertices || index_count > data.batch_max_indices) {
+		return 0;
+	}
+
+	// Everything the caller sets up per item has to match, so the items can share one draw.
+	int item_count = 1;
+	Item *item = p_item->next;
+
+	while (item) {
+
+		if (item->final_clip_owner != p_item->final_clip_owner || item->copy_back_buffer || item->skeleton.is_valid()) {
+			break;
+		}
+
+		Item *material_owner = item->material_owner ? item->material_owner : item;
+		if (material_owner->material != p_material) {
+			break;
+		}
+
+		if (item->final_modulate != p_item->final_modulate || item->light_masked != p_item->light_masked) {
+			break;
+		}
+
+		int item_vertices;
+		int item_indices;
+		if (!_get_batch_item_size(item, texture, normal_map, texture_ptr, item_vertices, item_indices)) {
+			break;
+		}
+
+		if (vertex_count + item_vertices > data.batch_max_vertices || index_count + item_indices > data.batch_max_indices) {
+			break;
+		}
+
+		vertex_count += item_vertices;
+		index_count += item_indices;
+		item_count++;
+		item = item->next;
+	}
+
+	if (item_count < 2) {
+		return 0; // the per item batching handles this one
+	}
+
+	state.uniforms.modelview_matrix = Transform2D();
+	state.uniforms.extra_matrix = Transform2D();
+
+	state.canvas_shader.set_conditional(CanvasShaderGLES2::USE_TEXTURE_RECT, false);
+	state.canvas_shader.bind();
+	_set_uniforms();
+	state.canvas_shader.use_material((void *)p_material_ptr);
+
+	RasterizerStorageGLES2::Texture *bound_texture = _bind_canvas_texture(texture, normal_map);
+
+	if (bound_texture) {
+		Size2 texpixel_size(1.0 / bound_texture->width, 1.0 / bound_texture->height);
+		state.canvas_shader.set_uniform(CanvasShaderGLES2::COLOR_TEXPIXEL_SIZE, texpixel_size);
+	}
+
+	int vertex_ofs = 0;
+	int index_ofs = 0;
+	int command_count = 0;
+
+	item = p_item;
+	for (int i = 0; i < item_count; i++) {
+
+		int item_commands = item->commands.size();
+		Item::Command *const *commands = item->commands.ptr();
+
+		for (int j = 0; j < item_commands; j++) {
+			_fill_batch_command(commands[j], bound_texture, &item->final_transform, vertex_ofs, index_ofs);
+		}
+
+		command_count += item_commands;
+		item = item->next;
+	}
+
+	_draw_polygon(data.batch_indices, index_ofs, vertex_ofs, data.batch_vertices, data.batch_uvs, data.batch_colors, false);
+
+	storage->info.render.canvas_command_count += command_count;
+	storage->info.render.canvas_batch_count++;
+
+	return item_count;
+}
+
 void RasterizerCanvasGLES2::_canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip, RasterizerStorageGLES2::Material *p_material) {
 
 	int command_count = p_item->commands.size();
@@ -548,6 +1091,18 @@ void RasterizerCanvasGLES2::_canvas_item_render_commands(Item *p_item, Item *cur
 
 	for (int i = 0; i < command_count; i++) {
 
+		int batched = _canvas_item_batch_commands(&commands[i], command_count - i, p_material);
+
+		if (batched) {
+			storage->info.render.canvas_command_count += batched;
+			storage->info.render.canvas_batch_count++;
+			i += batched - 1;
+			continue;
+		}
+
+		storage->info.render.canvas_command_count++;
+		storage->info.render.canvas_batch_count++;
+
 		Item::Command *command = commands[i];
 
 		switch (command->type) {
@@ -1606,6 +2161,9 @@ void RasterizerCanvasGLES2::canvas_render_items(Item *p_item_list, int p_z, cons
 
 			shader_cache = shader_ptr;
 
+			state.batching_allowed = !shader_ptr || !shader_ptr->canvas_item.uses_vertex;
+			state.joining_allowed = !shader_ptr || !shader_ptr->canvas_item.uses_world_matrix;
+
 			canvas_last_material = material;
 
 			rebind_shader = false;
@@ -1673,12 +2231,28 @@ void RasterizerCanvasGLES2::canvas_render_items(Item *p_item_list, int p_z, cons
 
 		_set_uniforms();
 
-		if (unshaded || (state.uniforms.final_modulate.a > 0.001 && (!shader_cache || shader_cache->canvas_item.light_mode != RasterizerStorageGLES2::Shader::CanvasItem::LIGHT_MODE_LIGHT_ONLY) && !ci->light_masked))
+		bool light_pass = (blend_mode == RasterizerStorageGLES2::Shader::CanvasItem::BLEND_MODE_MIX || blend_mode == RasterizerStorageGLES2::Shader::CanvasItem::BLEND_MODE_PMALPHA) && p_light && !unshaded;
+
+		if (unshaded || (state.uniforms.final_modulate.a > 0.001 && (!shader_cache || shader_cache->canvas_item.light_mode != RasterizerStorageGLES2::Shader::CanvasItem::LIGHT_MODE_LIGHT_ONLY) && !ci->light_masked)) {
+
+			// Items that would need a light pass each are drawn one by one.
+			int joined = light_pass ? 0 : _canvas_item_join_items(ci, material, material_ptr);
+
+			if (joined) {
+				for (int i = 1; i < joined; i++) {
+					p_item_list = p_item_list->next;
+				}
+				rebind_shader = true;
+				p_item_list = p_item_list->next;
+				continue;
+			}
+
 			_canvas_item_render_commands(p_item_list, NULL, reclip, material_ptr);
+		}
 
 		rebind_shader = true; // hacked in for now.
 
-		if ((blend_mode == RasterizerStorageGLES2::Shader::CanvasItem::BLEND_MODE_MIX || blend_mode == RasterizerStorageGLES2::Shader::CanvasItem::BLEND_MODE_PMALPHA) && p_light && !unshaded) {
+		if (light_pass) {
 
 			Light *light = p_light;
 			bool light_used = false;
@@ -2132,6 +2706,17 @@ void RasterizerCanvasGLES2::initialize() {
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
 		data.polygon_index_buffer_size = index_size;
+
+		// batched vertices carry position, color and uv
+		data.batch_max_vertices = poly_size / (sizeof(Vector2) * 2 + sizeof(Color));
+		data.batch_max_indices = index_size / sizeof(int);
+		if (!storage->config.support_32_bits_indices) {
+			data.batch_max_vertices = MIN(data.batch_max_vertices, 65536);
+		}
+		data.batch_vertices = (Vector2 *)memalloc(sizeof(Vector2) * data.batch_max_vertices);
+		data.batch_uvs = (Vector2 *)memalloc(sizeof(Vector2) * data.batch_max_vertices);
+		data.batch_colors = (Color *)memalloc(sizeof(Color) * data.batch_max_vertices);
+		data.batch_indices = (int *)memalloc(sizeof(int) * MAX(data.batch_max_indices, 1));
 	}
 
 	// ninepatch buffers
@@ -2213,9 +2798,19 @@ void RasterizerCanvasGLES2::initialize() {
 	state.using_light = NULL;
 	state.using_transparent_rt = false;
 	state.using_skeleton = false;
+
+	state.use_batching = GLOBAL_DEF("rendering/quality/2d/use_batching", true);
+	state.use_item_joining = GLOBAL_DEF("rendering/quality/2d/use_batching_across_items", true);
+	state.batching_allowed = true;
+	state.joining_allowed = true;
 }
 
 void RasterizerCanvasGLES2::finalize() {
+
+	memfree(data.batch_vertices);
+	memfree(data.batch_uvs);
+	memfree(data.batch_colors);
+	memfree(data.batch_indices);
 }
 
 RasterizerCanvasGLES2::RasterizerCanvasGLES2() {
@@ -70,6 +70,14 @@ public:
 		GLuint ninepatch_vertices;
 		GLuint ninepatch_elements;
 
+		// CPU side staging for batched commands, sized to fit the polygon buffers.
+		Vector2 *batch_vertices;
+		Vector2 *batch_uvs;
+		Color *batch_colors;
+		int *batch_indices;
+		int batch_max_vertices;
+		int batch_max_indices;
+
 	} data;
 
 	struct State {
@@ -83,6 +91,11 @@ public:
 		bool using_ninepatch;
 		bool using_skeleton;
 
+		bool use_batching;
+		bool use_item_joining;
+		bool batching_allowed; // false while a custom shader that reads VERTEX is bound
+		bool joining_allowed; // false while a custom shader that reads WORLD_MATRIX or EXTRA_MATRIX is bound
+
 		Transform2D skeleton_transform;
 		Transform2D skeleton_transform_inverse;
 		Size2i skeleton_texture_size;
@@ -120,6 +133,13 @@ public:
 	_FORCE_INLINE_ void _draw_generic(GLuint p_primitive, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor);
 	_FORCE_INLINE_ void _draw_generic_indices(GLuint p_primitive, const int *p_indices, int p_index_count, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor);
 
+	_FORCE_INLINE_ bool _get_batch_command_textures(const Item::Command *p_command, RID &r_texture, RID &r_normal_map) const;
+	_FORCE_INLINE_ bool _get_batch_command_size(const Item::Command *p_command, const RasterizerStorageGLES2::Texture *p_texture, int &r_vertex_count, int &r_index_count) const;
+	_FORCE_INLINE_ bool _get_batch_item_size(const Item *p_item, const RID &p_texture, const RID &p_normal_map, const RasterizerStorageGLES2::Texture *p_texture_ptr, int &r_vertex_count, int &r_index_count) const;
+	_FORCE_INLINE_ void _fill_batch_command(const Item::Command *p_command, const RasterizerStorageGLES2::Texture *p_texture, const Transform2D *p_xform, int &r_vertex_ofs, int &r_index_ofs);
+	_FORCE_INLINE_ int _canvas_item_batch_commands(Item::Command *const *p_commands, int p_count, RasterizerStorageGLES2::Material *p_material);
+	_FORCE_INLINE_ int _canvas_item_join_items(Item *p_item, const RID &p_material, RasterizerStorageGLES2::Material *p_material_ptr);
+
 	_FORCE_INLINE_ void _canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip, RasterizerStorageGLES2::Material *p_material);
 	void _copy_screen(const Rect2 &p_rect);
 	_FORCE_INLINE_ void _copy_texscreen(const Rect2 &p_rect);
@@ -288,7 +288,7 @@ bool RasterizerSceneGLES2::_shadow_atlas_find_shadow(ShadowAtlas *shadow_atlas,
 	return false;
 }
 
-bool RasterizerSceneGLES2::shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version) {
+bool RasterizerSceneGLES2::shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version, uint64_t &r_drawn_version) {
 
 	ShadowAtlas *shadow_atlas = shadow_atlas_owner.getornull(p_atlas);
 	ERR_FAIL_COND_V(!shadow_atlas, false);
@@ -296,6 +296,8 @@ bool RasterizerSceneGLES2::shadow_atlas_update_light(RID p_atlas, RID p_light_in
 	LightInstance *li = light_instance_owner.getornull(p_light_intance);
 	ERR_FAIL_COND_V(!li, false);
 
+	r_drawn_version = 0; //nothing usable drawn yet, unless the current slot is kept
+
 	if (shadow_atlas->size == 0 || shadow_atlas->smallest_subdiv == 0) {
 		return false;
 	}
@@ -348,6 +350,7 @@ bool RasterizerSceneGLES2::shadow_atlas_update_light(RID p_atlas, RID p_light_in
 		bool should_redraw = shadow_atlas->quadrants[q].shadows[s].version != p_light_version;
 
 		if (!should_realloc) {
+			r_drawn_version = shadow_atlas->quadrants[q].shadows[s].version;
 			shadow_atlas->quadrants[q].shadows.write[s].version = p_light_version;
 			return should_redraw;
 		}
@@ -391,6 +394,7 @@ bool RasterizerSceneGLES2::shadow_atlas_update_light(RID p_atlas, RID p_light_in
 
 		// no better place found, so we keep the current place
 
+		r_drawn_version = shadow_atlas->quadrants[q].shadows[s].version;
 		shadow_atlas->quadrants[q].shadows.write[s].version = p_light_version;
 
 		return should_redraw;
@@ -806,6 +810,16 @@ void RasterizerSceneGLES2::environment_set_ssao(RID p_env, bool p_enable, float
 	ERR_FAIL_COND(!env);
 }
 
+void RasterizerSceneGLES2::environment_set_ssr_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal) {
+	Environment *env = environment_owner.getornull(p_env);
+	ERR_FAIL_COND(!env);
+}
+
+void RasterizerSceneGLES2::environment_set_ssao_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal) {
+	Environment *env = environment_owner.getornull(p_env);
+	ERR_FAIL_COND(!env);
+}
+
 void RasterizerSceneGLES2::environment_set_tonemap(RID p_env, VS::EnvironmentToneMapper p_tone_mapper, float p_exposure, float p_white, bool p_auto_exposure, float p_min_luminance, float p_max_luminance, float p_auto_exp_speed, float p_auto_exp_scale) {
 	Environment *env = environment_owner.getornull(p_env);
 	ERR_FAIL_COND(!env);
@@ -1204,6 +1218,31 @@ void RasterizerSceneGLES2::_copy_texture_to_buffer(GLuint p_texture, GLuint p_bu
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+RasterizerStorageGLES2::Surface *RasterizerSceneGLES2::_get_surface_lod(RasterizerStorageGLES2::Surface *p_surface, const InstanceBase *p_instance, float p_scale) const {
+
+	float pixels_per_unit = state.lod_pixels_per_unit * p_scale;
+
+	if (!state.lod_orthogonal) {
+		//distance to a sphere around the instance origin that contains the surface
+		const AABB &aabb = p_surface->aabb;
+		float radius = ((aabb.position + aabb.size * 0.5).length() + aabb.size.length() * 0.5) * p_scale;
+		float distance = p_instance->depth - radius;
+		if (distance <= 0.0) {
+			return p_surface;
+		}
+		pixels_per_unit /= distance;
+	}
+
+	//coarsest level whose error stays under the threshold on screen
+	for (int i = p_surface->lods.size() - 1; i >= 0; i--) {
+		if (p_surface->lods[i].edge_length * pixels_per_unit < state.lod_threshold) {
+			return p_surface->lods[i].surface;
+		}
+	}
+
+	return p_surface;
+}
+
 void RasterizerSceneGLES2::_fill_render_list(InstanceBase **p_cull_result, int p_cull_count, bool p_depth_pass, bool p_shadow_pass) {
 
 	render_pass++;
@@ -1225,12 +1264,21 @@ void RasterizerSceneGLES2::_fill_render_list(InstanceBase **p_cull_result, int p
 				ERR_CONTINUE(!mesh);
 
 				int num_surfaces = mesh->surfaces.size();
+				float lod_scale = -1.0;
 
 				for (int j = 0; j < num_surfaces; j++) {
 					int material_index = instance->materials[j].is_valid() ? j : -1;
 
 					RasterizerStorageGLES2::Surface *surface = mesh->surfaces[j];
 
+					if (surface->lods.size() && state.lod_pixels_per_unit > 0.0) {
+						if (lod_scale < 0.0) {
+							Vector3 scale = instance->transform.basis.get_scale();
+							lod_scale = MAX(scale.x, MAX(scale.y, scale.z));
+						}
+						surface = _get_surface_lod(surface, instance, lod_scale);
+					}
+
 					_add_geometry(surface, instance, NULL, material_index, p_depth_pass, p_shadow_pass);
 				}
 
@@ -3161,6 +3209,13 @@ void RasterizerSceneGLES2::_post_process(Environment *env, const CameraMatrix &p
 
 void RasterizerSceneGLES2::render_scene(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RID p_environment, RID p_shadow_atlas, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {
 
+	StereoPass stereo = stereo_pass;
+	stereo_pass = STEREO_PASS_NONE;
+
+	//the second eye sees the same cull result, its list only changes in camera transform and projection
+	bool reuse_lists = stereo == STEREO_PASS_SECOND && stereo_lists.valid && stereo_lists.render_pass == render_pass && stereo_lists.cull_result == p_cull_result && stereo_lists.cull_count == p_cull_count;
+	stereo_lists.valid = false;
+
 	Transform cam_transform = p_cam_transform;
 
 	storage->info.render.object_count += p_cull_count;
@@ -3217,12 +3272,21 @@ void RasterizerSceneGLES2::render_scene(const Transform &p_cam_transform, const
 		}
 	}
 
-	state.used_screen_texture = false;
+	if (!reuse_lists) {
+		state.used_screen_texture = false;
+	}
 	state.viewport_size.x = viewport_width;
 	state.viewport_size.y = viewport_height;
 	state.screen_pixel_size.x = 1.0 / viewport_width;
 	state.screen_pixel_size.y = 1.0 / viewport_height;
 
+	if (state.lod_threshold > 0.0) {
+		state.lod_pixels_per_unit = 0.5 * viewport_height * p_cam_projection.matrix[1][1];
+		state.lod_orthogonal = p_cam_ortogonal;
+	} else {
+		state.lod_pixels_per_unit = 0.0;
+	}
+
 	//push back the directional lights
 
 	if (p_light_cull_count) {
@@ -3262,7 +3326,7 @@ void RasterizerSceneGLES2::render_scene(const Transform &p_cam_transform, const
 		for (int i = 0; i < p_reflection_probe_cull_count; i++) {
 			ReflectionProbeInstance *rpi = reflection_probe_instance_owner.getornull(p_reflection_probe_cull_result[i]);
 			ERR_CONTINUE(!rpi);
-			rpi->last_pass = render_pass + 1; //will be incremented later
+			rpi->last_pass = reuse_lists ? render_pass : render_pass + 1; //will be incremented later, unless the list is reused
 			rpi->index = i;
 			reflection_probe_instances[i] = rpi;
 		}
@@ -3280,8 +3344,18 @@ void RasterizerSceneGLES2::render_scene(const Transform &p_cam_transform, const
 
 	// render list stuff
 
-	render_list.clear();
-	_fill_render_list(p_cull_result, p_cull_count, false, false);
+	if (reuse_lists) {
+		//additive light passes are marked while drawing, start over from the base passes
+		for (int i = 0; i < render_list.element_count; i++) {
+			render_list.elements[i]->use_accum = false;
+		}
+		for (int i = render_list.max_elements - render_list.alpha_element_count; i < render_list.max_elements; i++) {
+			render_list.elements[i]->use_accum = false;
+		}
+	} else {
+		render_list.clear();
+		_fill_render_list(p_cull_result, p_cull_count, false, false);
+	}
 
 	// other stuff
 
@@ -3430,7 +3504,9 @@ void RasterizerSceneGLES2::render_scene(const Transform &p_cam_transform, const
 	}
 
 	// render opaque things first
-	render_list.sort_by_key(false);
+	if (!reuse_lists) {
+		render_list.sort_by_key(false);
+	}
 	_render_render_list(render_list.elements, render_list.element_count, cam_transform, p_cam_projection, p_shadow_atlas, env, env_radiance_tex, 0.0, 0.0, reverse_cull, false, false);
 
 	// then draw the sky after
@@ -3483,10 +3559,19 @@ void RasterizerSceneGLES2::render_scene(const Transform &p_cam_transform, const
 	glBlendEquation(GL_FUNC_ADD);
 	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
-	render_list.sort_by_reverse_depth_and_priority(true);
+	if (!reuse_lists) {
+		render_list.sort_by_reverse_depth_and_priority(true);
+	}
 
 	_render_render_list(&render_list.elements[render_list.max_elements - render_list.alpha_element_count], render_list.alpha_element_count, cam_transform, p_cam_projection, p_shadow_atlas, env, env_radiance_tex, 0.0, 0.0, reverse_cull, true, false);
 
+	if (stereo == STEREO_PASS_FIRST && !p_reflection_probe.is_valid()) {
+		stereo_lists.valid = true;
+		stereo_lists.render_pass = render_pass;
+		stereo_lists.cull_result = p_cull_result;
+		stereo_lists.cull_count = p_cull_count;
+	}
+
 	if (p_reflection_probe.is_valid()) {
 		// Rendering to a probe so no need for post_processing
 		return;
@@ -3538,6 +3623,7 @@ void RasterizerSceneGLES2::render_scene(const Transform &p_cam_transform, const
 void RasterizerSceneGLES2::render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count) {
 
 	state.render_no_shadows = false;
+	state.lod_pixels_per_unit = 0.0; //shadows use full detail, coarser casters would self shadow
 
 	LightInstance *light_instance = light_instance_owner.getornull(p_light);
 	ERR_FAIL_COND(!light_instance);
@@ -3820,6 +3906,10 @@ void RasterizerSceneGLES2::set_scene_pass(uint64_t p_pass) {
 	scene_pass = p_pass;
 }
 
+void RasterizerSceneGLES2::set_stereo_pass(StereoPass p_pass) {
+	stereo_pass = p_pass;
+}
+
 bool RasterizerSceneGLES2::free(RID p_rid) {
 
 	if (light_instance_owner.owns(p_rid)) {
@@ -3886,6 +3976,8 @@ void RasterizerSceneGLES2::initialize() {
 	render_list.init();
 
 	render_pass = 1;
+	stereo_pass = STEREO_PASS_NONE;
+	stereo_lists.valid = false;
 
 	shadow_atlas_realloc_tolerance_msec = 500;
 
@@ -3931,6 +4023,13 @@ void RasterizerSceneGLES2::initialize() {
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
+	{
+		state.lod_threshold = GLOBAL_DEF("rendering/quality/lod/threshold_pixels", 1.0);
+		ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/lod/threshold_pixels", PropertyInfo(Variant::REAL, "rendering/quality/lod/threshold_pixels", PROPERTY_HINT_RANGE, "0,16,0.1"));
+		state.lod_pixels_per_unit = 0.0;
+		state.lod_orthogonal = false;
+	}
+
 	{
 		uint32_t immediate_buffer_size = GLOBAL_DEF("rendering/limits/buffers/immediate_buffer_size_kb", 2048);
 		ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/buffers/immediate_buffer_size_kb", PropertyInfo(Variant::INT, "rendering/limits/buffers/immediate_buffer_size_kb", PROPERTY_HINT_RANGE, "0,8192,1,or_greater"));
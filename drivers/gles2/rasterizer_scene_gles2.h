@@ -34,6 +34,8 @@
 /* Must come before shaders or the Windows build fails... */
 #include "rasterizer_storage_gles2.h"
 
+#include "core/parallel_sort_array.h"
+
 #include "shaders/cube_to_dp.glsl.gen.h"
 #include "shaders/effect_blur.glsl.gen.h"
 #include "shaders/scene.glsl.gen.h"
@@ -109,6 +111,10 @@ public:
 		Color default_ambient;
 		Color default_bg;
 
+		float lod_threshold; //pixels of error allowed on screen
+		float lod_pixels_per_unit; //at distance one for perspective cameras, zero draws full detail
+		bool lod_orthogonal;
+
 		// ResolveShaderGLES3 resolve_shader;
 		// ScreenSpaceReflectionShaderGLES3 ssr_shader;
 		// EffectBlurShaderGLES3 effect_blur_shader;
@@ -279,7 +285,7 @@ public:
 	void shadow_atlas_set_size(RID p_atlas, int p_size);
 	void shadow_atlas_set_quadrant_subdivision(RID p_atlas, int p_quadrant, int p_subdivision);
 	bool _shadow_atlas_find_shadow(ShadowAtlas *shadow_atlas, int *p_in_quadrants, int p_quadrant_count, int p_current_subdiv, uint64_t p_tick, int &r_quadrant, int &r_shadow);
-	bool shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version);
+	bool shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version, uint64_t &r_drawn_version);
 
 	struct DirectionalShadow {
 		GLuint fbo;
@@ -480,6 +486,8 @@ public:
 
 	virtual void environment_set_ssr(RID p_env, bool p_enable, int p_max_steps, float p_fade_in, float p_fade_out, float p_depth_tolerance, bool p_roughness);
 	virtual void environment_set_ssao(RID p_env, bool p_enable, float p_radius, float p_intensity, float p_radius2, float p_intensity2, float p_bias, float p_light_affect, float p_ao_channel_affect, const Color &p_color, VS::EnvironmentSSAOQuality p_quality, VS::EnvironmentSSAOBlur p_blur, float p_bilateral_sharpness);
+	virtual void environment_set_ssr_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal);
+	virtual void environment_set_ssao_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal);
 
 	virtual void environment_set_tonemap(RID p_env, VS::EnvironmentToneMapper p_tone_mapper, float p_exposure, float p_white, bool p_auto_exposure, float p_min_luminance, float p_max_luminance, float p_auto_exp_speed, float p_auto_exp_scale);
 
@@ -634,7 +642,7 @@ public:
 		};
 
 		void sort_by_key(bool p_alpha) {
-			SortArray<Element *, SortByKey> sorter;
+			ParallelSortArray<Element *, SortByKey> sorter;
 
 			if (p_alpha) {
 				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
@@ -652,7 +660,7 @@ public:
 
 		void sort_by_depth(bool p_alpha) { //used for shadows
 
-			SortArray<Element *, SortByDepth> sorter;
+			ParallelSortArray<Element *, SortByDepth> sorter;
 			if (p_alpha) {
 				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
 			} else {
@@ -673,7 +681,7 @@ public:
 
 		void sort_by_reverse_depth_and_priority(bool p_alpha) { //used for alpha
 
-			SortArray<Element *, SortByReverseDepthAndPriority> sorter;
+			ParallelSortArray<Element *, SortByReverseDepthAndPriority> sorter;
 			if (p_alpha) {
 				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
 			} else {
@@ -726,10 +734,22 @@ public:
 
 	RenderList render_list;
 
+	//render list of the first eye of a stereo render, drawn again for the second one
+	struct StereoLists {
+		bool valid;
+		uint64_t render_pass;
+		InstanceBase **cull_result;
+		int cull_count;
+	};
+
+	StereoPass stereo_pass;
+	StereoLists stereo_lists;
+
 	void _add_geometry(RasterizerStorageGLES2::Geometry *p_geometry, InstanceBase *p_instance, RasterizerStorageGLES2::GeometryOwner *p_owner, int p_material, bool p_depth_pass, bool p_shadow_pass);
 	void _add_geometry_with_material(RasterizerStorageGLES2::Geometry *p_geometry, InstanceBase *p_instance, RasterizerStorageGLES2::GeometryOwner *p_owner, RasterizerStorageGLES2::Material *p_material, bool p_depth_pass, bool p_shadow_pass);
 
 	void _copy_texture_to_buffer(GLuint p_texture, GLuint p_buffer);
+	_FORCE_INLINE_ RasterizerStorageGLES2::Surface *_get_surface_lod(RasterizerStorageGLES2::Surface *p_surface, const InstanceBase *p_instance, float p_scale) const;
 	void _fill_render_list(InstanceBase **p_cull_result, int p_cull_count, bool p_depth_pass, bool p_shadow_pass);
 	void _render_render_list(RenderList::Element **p_elements, int p_element_count,
 			const Transform &p_view_transform,
@@ -760,6 +780,7 @@ public:
 	virtual bool free(RID p_rid);
 
 	virtual void set_scene_pass(uint64_t p_pass);
+	virtual void set_stereo_pass(StereoPass p_pass);
 	virtual void set_debug_draw_mode(VS::ViewportDebugDraw p_debug_draw);
 
 	void iteration();
@@ -1132,6 +1132,22 @@ void RasterizerStorageGLES2::texture_set_detect_normal_callback(RID p_texture, V
 	texture->detect_normal_ud = p_userdata;
 }
 
+void RasterizerStorageGLES2::texture_set_stream_callback(RID p_texture, VisualServer::TextureStreamCallback p_callback, void *p_userdata) {
+	Texture *texture = texture_owner.get(p_texture);
+	ERR_FAIL_COND(!texture);
+
+	//partial mipmap chains can't be sampled without GL_TEXTURE_BASE_LEVEL, so the whole chain is asked for right away
+	if (p_callback) {
+		p_callback(p_userdata, 0);
+	}
+}
+
+void RasterizerStorageGLES2::texture_set_stream_data(RID p_texture, const Ref<Image> &p_image, int p_first_mipmap) {
+
+	//until the full chain arrives, the smaller mipmaps are used as the whole texture
+	texture_set_data(p_texture, p_image);
+}
+
 RID RasterizerStorageGLES2::texture_create_radiance_cubemap(RID p_source, int p_resolution) const {
 
 	return RID();
@@ -1395,6 +1411,8 @@ void RasterizerStorageGLES2::_update_shader(Shader *p_shader) const {
 			p_shader->canvas_item.uses_screen_texture = false;
 			p_shader->canvas_item.uses_screen_uv = false;
 			p_shader->canvas_item.uses_time = false;
+			p_shader->canvas_item.uses_vertex = false;
+			p_shader->canvas_item.uses_world_matrix = false;
 
 			shaders.actions_canvas.render_mode_values["blend_add"] = Pair<int *, int>(&p_shader->canvas_item.blend_mode, Shader::CanvasItem::BLEND_MODE_ADD);
 			shaders.actions_canvas.render_mode_values["blend_mix"] = Pair<int *, int>(&p_shader->canvas_item.blend_mode, Shader::CanvasItem::BLEND_MODE_MIX);
@@ -1409,6 +1427,9 @@ void RasterizerStorageGLES2::_update_shader(Shader *p_shader) const {
 			shaders.actions_canvas.usage_flag_pointers["SCREEN_PIXEL_SIZE"] = &p_shader->canvas_item.uses_screen_uv;
 			shaders.actions_canvas.usage_flag_pointers["SCREEN_TEXTURE"] = &p_shader->canvas_item.uses_screen_texture;
 			shaders.actions_canvas.usage_flag_pointers["TIME"] = &p_shader->canvas_item.uses_time;
+			shaders.actions_canvas.usage_flag_pointers["VERTEX"] = &p_shader->canvas_item.uses_vertex;
+			shaders.actions_canvas.usage_flag_pointers["WORLD_MATRIX"] = &p_shader->canvas_item.uses_world_matrix;
+			shaders.actions_canvas.usage_flag_pointers["EXTRA_MATRIX"] = &p_shader->canvas_item.uses_world_matrix;
 
 			actions = &shaders.actions_canvas;
 			actions->uniforms = &p_shader->uniforms;
@@ -2554,6 +2575,10 @@ void RasterizerStorageGLES2::mesh_surface_set_material(RID p_mesh, int p_surface
 
 	mesh->surfaces[p_surface]->material = p_material;
 
+	for (int i = 0; i < mesh->surfaces[p_surface]->lods.size(); i++) {
+		mesh->surfaces[p_surface]->lods[i].surface->material = p_material;
+	}
+
 	if (mesh->surfaces[p_surface]->material.is_valid()) {
 		_material_add_geometry(mesh->surfaces[p_surface]->material, mesh->surfaces[p_surface]);
 	}
@@ -2651,6 +2676,92 @@ Vector<AABB> RasterizerStorageGLES2::mesh_surface_get_skeleton_aabb(RID p_mesh,
 	return mesh->surfaces[p_surface]->skeleton_bone_aabb;
 }
 
+void RasterizerStorageGLES2::_mesh_surface_clear_lods(Surface *p_surface) {
+
+	for (int i = 0; i < p_surface->lods.size(); i++) {
+
+		Surface *lod = p_surface->lods[i].surface;
+
+		//the vertex buffer belongs to the base surface
+		glDeleteBuffers(1, &lod->index_id);
+
+		info.vertex_mem -= lod->total_data_size;
+
+		memdelete(lod);
+	}
+
+	p_surface->lods.clear();
+}
+
+void RasterizerStorageGLES2::mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_edge_lengths, const Vector<PoolVector<uint8_t> > &p_index_arrays) {
+
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_INDEX(p_surface, mesh->surfaces.size());
+	ERR_FAIL_COND(p_edge_lengths.size() != p_index_arrays.size());
+
+	Surface *surface = mesh->surfaces[p_surface];
+
+	_mesh_surface_clear_lods(surface);
+
+	if (p_index_arrays.size() == 0) {
+		mesh->instance_change_notify(false, true);
+		return;
+	}
+
+	ERR_FAIL_COND_MSG(!surface->index_id || surface->primitive != VS::PRIMITIVE_TRIANGLES, "LODs need an indexed triangle surface.");
+	ERR_FAIL_COND_MSG(surface->blend_shapes.size(), "LODs are not supported on surfaces with blend shapes.");
+
+	int index_size = surface->array_len >= (1 << 16) ? 4 : 2;
+
+	for (int i = 0; i < p_index_arrays.size(); i++) {
+
+		const PoolVector<uint8_t> &index_array = p_index_arrays[i];
+		ERR_CONTINUE(index_array.size() == 0 || index_array.size() % (index_size * 3) != 0);
+
+		Surface *lod = memnew(Surface);
+
+		for (int j = 0; j < VS::ARRAY_MAX; j++) {
+			lod->attribs[j] = surface->attribs[j];
+		}
+		lod->mesh = mesh;
+		lod->format = surface->format;
+		lod->material = surface->material;
+		lod->vertex_id = surface->vertex_id;
+		lod->aabb = surface->aabb;
+		lod->array_len = surface->array_len;
+		lod->index_array_len = index_array.size() / index_size;
+		lod->max_bone = surface->max_bone;
+		lod->array_byte_size = surface->array_byte_size;
+		lod->index_array_byte_size = index_array.size();
+		lod->primitive = surface->primitive;
+		lod->skeleton_bone_aabb = surface->skeleton_bone_aabb;
+		lod->skeleton_bone_used = surface->skeleton_bone_used;
+		lod->active = true;
+		lod->data = surface->data;
+		lod->index_data = index_array;
+		lod->total_data_size = index_array.size();
+
+		{
+			PoolVector<uint8_t>::Read ir = index_array.read();
+
+			glGenBuffers(1, &lod->index_id);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod->index_id);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_array.size(), ir.ptr(), GL_STATIC_DRAW);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //unbind
+		}
+
+		info.vertex_mem += lod->total_data_size;
+
+		Surface::LOD l;
+		l.edge_length = p_edge_lengths[i];
+		l.surface = lod;
+		surface->lods.push_back(l);
+	}
+
+	mesh->instance_change_notify(false, true);
+}
+
 void RasterizerStorageGLES2::mesh_remove_surface(RID p_mesh, int p_surface) {
 
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
@@ -2663,6 +2774,8 @@ void RasterizerStorageGLES2::mesh_remove_surface(RID p_mesh, int p_surface) {
 		_material_remove_geometry(surface->material, mesh->surfaces[p_surface]);
 	}
 
+	_mesh_surface_clear_lods(surface);
+
 	glDeleteBuffers(1, &surface->vertex_id);
 	if (surface->index_id) {
 		glDeleteBuffers(1, &surface->index_id);
@@ -2942,12 +3055,12 @@ void RasterizerStorageGLES2::multimesh_allocate(RID p_multimesh, int p_instances
 		}
 	}
 
-	multimesh->dirty_aabb = true;
-	multimesh->dirty_data = true;
+	int region_count = (multimesh->size + MULTIMESH_DIRTY_REGION_SIZE - 1) / MULTIMESH_DIRTY_REGION_SIZE;
+	multimesh->dirty_regions.resize(region_count);
+	multimesh->region_aabbs.resize(region_count);
+	multimesh->dirty_region_aabbs = true;
 
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_all_dirty(multimesh, true);
 }
 
 int RasterizerStorageGLES2::multimesh_get_instance_count(RID p_multimesh) const {
@@ -2978,6 +3091,7 @@ void RasterizerStorageGLES2::multimesh_set_mesh(RID p_multimesh, RID p_mesh) {
 	}
 
 	multimesh->dirty_aabb = true;
+	multimesh->dirty_region_aabbs = true;
 
 	if (!multimesh->update_list.in_list()) {
 		multimesh_update_list.add(&multimesh->update_list);
@@ -3007,12 +3121,7 @@ void RasterizerStorageGLES2::multimesh_instance_set_transform(RID p_multimesh, i
 	dataptr[10] = p_transform.basis.elements[2][2];
 	dataptr[11] = p_transform.origin.z;
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, true);
 }
 
 void RasterizerStorageGLES2::multimesh_instance_set_transform_2d(RID p_multimesh, int p_index, const Transform2D &p_transform) {
@@ -3033,12 +3142,7 @@ void RasterizerStorageGLES2::multimesh_instance_set_transform_2d(RID p_multimesh
 	dataptr[6] = 0;
 	dataptr[7] = p_transform.elements[2][1];
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, true);
 }
 
 void RasterizerStorageGLES2::multimesh_instance_set_color(RID p_multimesh, int p_index, const Color &p_color) {
@@ -3066,12 +3170,7 @@ void RasterizerStorageGLES2::multimesh_instance_set_color(RID p_multimesh, int p
 		dataptr[3] = p_color.a;
 	}
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, false);
 }
 
 void RasterizerStorageGLES2::multimesh_instance_set_custom_data(RID p_multimesh, int p_index, const Color &p_custom_data) {
@@ -3099,12 +3198,7 @@ void RasterizerStorageGLES2::multimesh_instance_set_custom_data(RID p_multimesh,
 		dataptr[3] = p_custom_data.a;
 	}
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, false);
 }
 
 RID RasterizerStorageGLES2::multimesh_get_mesh(RID p_multimesh) const {
@@ -3239,14 +3333,26 @@ void RasterizerStorageGLES2::multimesh_set_as_bulk_array(RID p_multimesh, const
 
 	PoolVector<float>::Read r = p_array.read();
 	ERR_FAIL_COND(!r.ptr());
-	copymem(multimesh->data.ptrw(), r.ptr(), dsize * sizeof(float));
+	_multimesh_write_instances(multimesh, 0, multimesh->size, r.ptr());
+}
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
+void RasterizerStorageGLES2::multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) {
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+	ERR_FAIL_COND(!multimesh->data.ptr());
 
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
+	int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
+	ERR_FAIL_COND_MSG(p_array.size() % stride != 0, "Array size must be a multiple of the floats used by one instance.");
+
+	int count = p_array.size() / stride;
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + count > multimesh->size);
+
+	if (count == 0) {
+		return;
 	}
+
+	PoolVector<float>::Read r = p_array.read();
+	_multimesh_write_instances(multimesh, p_from_instance, count, r.ptr());
 }
 
 void RasterizerStorageGLES2::multimesh_set_visible_instances(RID p_multimesh, int p_visible) {
@@ -3272,6 +3378,129 @@ AABB RasterizerStorageGLES2::multimesh_get_aabb(RID p_multimesh) const {
 	return multimesh->aabb;
 }
 
+void RasterizerStorageGLES2::_multimesh_mark_dirty(MultiMesh *p_multimesh, int p_index, bool p_aabb) {
+	int region = p_index / MULTIMESH_DIRTY_REGION_SIZE;
+
+	if (!p_multimesh->dirty_regions[region]) {
+		p_multimesh->dirty_regions.write[region] = true;
+		p_multimesh->dirty_region_count++;
+	}
+
+	p_multimesh->dirty_data = true;
+	if (p_aabb) {
+		p_multimesh->dirty_aabb = true;
+	}
+
+	if (!p_multimesh->update_list.in_list()) {
+		multimesh_update_list.add(&p_multimesh->update_list);
+	}
+}
+
+void RasterizerStorageGLES2::_multimesh_mark_all_dirty(MultiMesh *p_multimesh, bool p_aabb) {
+	int region_count = p_multimesh->dirty_regions.size();
+	bool *dirty = p_multimesh->dirty_regions.ptrw();
+
+	for (int i = 0; i < region_count; i++) {
+		dirty[i] = true;
+	}
+	p_multimesh->dirty_region_count = region_count;
+
+	p_multimesh->dirty_data = true;
+	if (p_aabb) {
+		p_multimesh->dirty_aabb = true;
+	}
+
+	if (!p_multimesh->update_list.in_list()) {
+		multimesh_update_list.add(&p_multimesh->update_list);
+	}
+}
+
+void RasterizerStorageGLES2::_multimesh_write_instances(MultiMesh *p_multimesh, int p_from, int p_count, const float *p_data) {
+	//compared region by region, so rewriting mostly unchanged data only dirties what really changed
+	int stride = p_multimesh->color_floats + p_multimesh->xform_floats + p_multimesh->custom_data_floats;
+	float *data = p_multimesh->data.ptrw();
+	int end = p_from + p_count;
+
+	for (int from = p_from; from < end;) {
+
+		int to = MIN((from / MULTIMESH_DIRTY_REGION_SIZE + 1) * MULTIMESH_DIRTY_REGION_SIZE, end);
+		const float *src = &p_data[(from - p_from) * stride];
+		float *dst = &data[from * stride];
+		size_t bytes = (to - from) * stride * sizeof(float);
+
+		if (memcmp(dst, src, bytes) != 0) {
+			copymem(dst, src, bytes);
+			_multimesh_mark_dirty(p_multimesh, from, true);
+		}
+
+		from = to;
+	}
+}
+
+AABB RasterizerStorageGLES2::_multimesh_get_region_aabb(const MultiMesh *p_multimesh, int p_region, const AABB &p_mesh_aabb) const {
+	int stride = p_multimesh->color_floats + p_multimesh->xform_floats + p_multimesh->custom_data_floats;
+	int from = p_region * MULTIMESH_DIRTY_REGION_SIZE * stride;
+	int to = MIN((p_region + 1) * MULTIMESH_DIRTY_REGION_SIZE, p_multimesh->size) * stride;
+	const float *data = p_multimesh->data.ptr();
+
+	AABB aabb;
+
+	if (p_multimesh->transform_format == VS::MULTIMESH_TRANSFORM_2D) {
+
+		for (int i = from; i < to; i += stride) {
+
+			const float *dataptr = &data[i];
+
+			Transform xform;
+			xform.basis[0][0] = dataptr[0];
+			xform.basis[0][1] = dataptr[1];
+			xform.origin[0] = dataptr[3];
+			xform.basis[1][0] = dataptr[4];
+			xform.basis[1][1] = dataptr[5];
+			xform.origin[1] = dataptr[7];
+
+			AABB laabb = xform.xform(p_mesh_aabb);
+
+			if (i == from) {
+				aabb = laabb;
+			} else {
+				aabb.merge_with(laabb);
+			}
+		}
+
+	} else {
+
+		for (int i = from; i < to; i += stride) {
+
+			const float *dataptr = &data[i];
+
+			Transform xform;
+			xform.basis.elements[0][0] = dataptr[0];
+			xform.basis.elements[0][1] = dataptr[1];
+			xform.basis.elements[0][2] = dataptr[2];
+			xform.origin.x = dataptr[3];
+			xform.basis.elements[1][0] = dataptr[4];
+			xform.basis.elements[1][1] = dataptr[5];
+			xform.basis.elements[1][2] = dataptr[6];
+			xform.origin.y = dataptr[7];
+			xform.basis.elements[2][0] = dataptr[8];
+			xform.basis.elements[2][1] = dataptr[9];
+			xform.basis.elements[2][2] = dataptr[10];
+			xform.origin.z = dataptr[11];
+
+			AABB laabb = xform.xform(p_mesh_aabb);
+
+			if (i == from) {
+				aabb = laabb;
+			} else {
+				aabb.merge_with(laabb);
+			}
+		}
+	}
+
+	return aabb;
+}
+
 void RasterizerStorageGLES2::update_dirty_multimeshes() {
 
 	while (multimesh_update_list.first()) {
@@ -3288,66 +3517,33 @@ void RasterizerStorageGLES2::update_dirty_multimeshes() {
 
 			mesh_aabb.size += Vector3(0.001, 0.001, 0.001); //in case mesh is empty in one of the sides
 
-			int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
-			int count = multimesh->data.size();
-			float *data = multimesh->data.ptrw();
+			//only regions with changed instances are recomputed, unless the mesh changed
+			int region_count = multimesh->region_aabbs.size();
+			const bool *dirty = multimesh->dirty_regions.ptr();
+			AABB *region_aabbs = multimesh->region_aabbs.ptrw();
 
 			AABB aabb;
 
-			if (multimesh->transform_format == VS::MULTIMESH_TRANSFORM_2D) {
-
-				for (int i = 0; i < count; i += stride) {
-
-					float *dataptr = &data[i];
-
-					Transform xform;
-					xform.basis[0][0] = dataptr[0];
-					xform.basis[0][1] = dataptr[1];
-					xform.origin[0] = dataptr[3];
-					xform.basis[1][0] = dataptr[4];
-					xform.basis[1][1] = dataptr[5];
-					xform.origin[1] = dataptr[7];
-
-					AABB laabb = xform.xform(mesh_aabb);
+			for (int i = 0; i < region_count; i++) {
 
-					if (i == 0) {
-						aabb = laabb;
-					} else {
-						aabb.merge_with(laabb);
-					}
+				if (multimesh->dirty_region_aabbs || dirty[i]) {
+					region_aabbs[i] = _multimesh_get_region_aabb(multimesh, i, mesh_aabb);
 				}
 
-			} else {
-
-				for (int i = 0; i < count; i += stride) {
-
-					float *dataptr = &data[i];
-
-					Transform xform;
-					xform.basis.elements[0][0] = dataptr[0];
-					xform.basis.elements[0][1] = dataptr[1];
-					xform.basis.elements[0][2] = dataptr[2];
-					xform.origin.x = dataptr[3];
-					xform.basis.elements[1][0] = dataptr[4];
-					xform.basis.elements[1][1] = dataptr[5];
-					xform.basis.elements[1][2] = dataptr[6];
-					xform.origin.y = dataptr[7];
-					xform.basis.elements[2][0] = dataptr[8];
-					xform.basis.elements[2][1] = dataptr[9];
-					xform.basis.elements[2][2] = dataptr[10];
-					xform.origin.z = dataptr[11];
-
-					AABB laabb = xform.xform(mesh_aabb);
-
-					if (i == 0) {
-						aabb = laabb;
-					} else {
-						aabb.merge_with(laabb);
-					}
+				if (i == 0) {
+					aabb = region_aabbs[i];
+				} else {
+					aabb.merge_with(region_aabbs[i]);
 				}
 			}
 
 			multimesh->aabb = aabb;
+			multimesh->dirty_region_aabbs = false;
+		}
+
+		if (multimesh->dirty_region_count) {
+			zeromem(multimesh->dirty_regions.ptrw(), multimesh->dirty_regions.size() * sizeof(bool));
+			multimesh->dirty_region_count = 0;
 		}
 
 		multimesh->dirty_aabb = false;
@@ -3577,6 +3773,42 @@ void RasterizerStorageGLES2::skeleton_bone_set_transform(RID p_skeleton, int p_b
 	}
 }
 
+void RasterizerStorageGLES2::skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms) {
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+	ERR_FAIL_COND(!skeleton);
+
+	ERR_FAIL_COND(p_transforms.size() > skeleton->size);
+	ERR_FAIL_COND(skeleton->use_2d);
+
+	float *bone_data = skeleton->bone_data.ptrw();
+	const Transform *transforms = p_transforms.ptr();
+
+	for (int i = 0; i < p_transforms.size(); i++) {
+
+		const Transform &xform = transforms[i];
+		float *data = &bone_data[i * 4 * 3];
+
+		data[0] = xform.basis[0].x;
+		data[1] = xform.basis[0].y;
+		data[2] = xform.basis[0].z;
+		data[3] = xform.origin.x;
+
+		data[4] = xform.basis[1].x;
+		data[5] = xform.basis[1].y;
+		data[6] = xform.basis[1].z;
+		data[7] = xform.origin.y;
+
+		data[8] = xform.basis[2].x;
+		data[9] = xform.basis[2].y;
+		data[10] = xform.basis[2].z;
+		data[11] = xform.origin.z;
+	}
+
+	if (!skeleton->update_list.in_list()) {
+		skeleton_update_list.add(&skeleton->update_list);
+	}
+}
+
 Transform RasterizerStorageGLES2::skeleton_bone_get_transform(RID p_skeleton, int p_bone) const {
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
 	ERR_FAIL_COND_V(!skeleton, Transform());
@@ -4409,6 +4641,12 @@ void RasterizerStorageGLES2::particles_set_fixed_fps(RID p_particles, int p_fps)
 void RasterizerStorageGLES2::particles_set_fractional_delta(RID p_particles, bool p_enable) {
 }
 
+void RasterizerStorageGLES2::particles_set_collision_heightfield(RID p_particles, RID p_texture, const AABB &p_aabb) {
+}
+
+void RasterizerStorageGLES2::particles_set_collision_bounce(RID p_particles, float p_bounce) {
+}
+
 void RasterizerStorageGLES2::particles_set_process_material(RID p_particles, RID p_material) {
 }
 
@@ -5580,6 +5818,7 @@ bool RasterizerStorageGLES2::free(RID p_rid) {
 			MultiMesh *multimesh = mesh->multimeshes.first()->self();
 			multimesh->mesh = RID();
 			multimesh->dirty_aabb = true;
+			multimesh->dirty_region_aabbs = true;
 
 			mesh->multimeshes.remove(mesh->multimeshes.first());
 
@@ -5696,6 +5935,9 @@ bool RasterizerStorageGLES2::has_os_feature(const String &p_feature) const {
 void RasterizerStorageGLES2::set_debug_generate_wireframes(bool p_generate) {
 }
 
+void RasterizerStorageGLES2::warm_up_shaders() {
+}
+
 void RasterizerStorageGLES2::render_info_begin_capture() {
 
 	info.snap = info.render;
@@ -5709,6 +5951,8 @@ void RasterizerStorageGLES2::render_info_end_capture() {
 	info.snap.surface_switch_count = info.render.surface_switch_count - info.snap.surface_switch_count;
 	info.snap.shader_rebind_count = info.render.shader_rebind_count - info.snap.shader_rebind_count;
 	info.snap.vertices_count = info.render.vertices_count - info.snap.vertices_count;
+	info.snap.canvas_command_count = info.render.canvas_command_count - info.snap.canvas_command_count;
+	info.snap.canvas_batch_count = info.render.canvas_batch_count - info.snap.canvas_batch_count;
 }
 
 int RasterizerStorageGLES2::get_captured_render_info(VS::RenderInfo p_info) {
@@ -5732,6 +5976,12 @@ int RasterizerStorageGLES2::get_captured_render_info(VS::RenderInfo p_info) {
 		case VS::INFO_DRAW_CALLS_IN_FRAME: {
 			return info.snap.draw_call_count;
 		} break;
+		case VS::INFO_2D_COMMANDS_IN_FRAME: {
+			return info.snap.canvas_command_count;
+		} break;
+		case VS::INFO_2D_BATCHES_IN_FRAME: {
+			return info.snap.canvas_batch_count;
+		} break;
 		default: {
 			return get_render_info(p_info);
 		}
@@ -5760,6 +6010,10 @@ int RasterizerStorageGLES2::get_render_info(VS::RenderInfo p_info) {
 			return info.texture_mem;
 		case VS::INFO_VERTEX_MEM_USED:
 			return info.vertex_mem;
+		case VS::INFO_2D_COMMANDS_IN_FRAME:
+			return info.render_final.canvas_command_count;
+		case VS::INFO_2D_BATCHES_IN_FRAME:
+			return info.render_final.canvas_batch_count;
 		default:
 			return 0; //no idea either
 	}
@@ -149,6 +149,8 @@ public:
 			uint32_t surface_switch_count;
 			uint32_t shader_rebind_count;
 			uint32_t vertices_count;
+			uint32_t canvas_command_count;
+			uint32_t canvas_batch_count;
 
 			void reset() {
 				object_count = 0;
@@ -157,6 +159,8 @@ public:
 				surface_switch_count = 0;
 				shader_rebind_count = 0;
 				vertices_count = 0;
+				canvas_command_count = 0;
+				canvas_batch_count = 0;
 			}
 		} render, render_final, snap;
 
@@ -374,6 +378,9 @@ public:
 	virtual void texture_set_detect_srgb_callback(RID p_texture, VisualServer::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_normal_callback(RID p_texture, VisualServer::TextureDetectCallback p_callback, void *p_userdata);
 
+	virtual void texture_set_stream_callback(RID p_texture, VisualServer::TextureStreamCallback p_callback, void *p_userdata);
+	virtual void texture_set_stream_data(RID p_texture, const Ref<Image> &p_image, int p_first_mipmap);
+
 	virtual void texture_set_force_redraw_if_visible(RID p_texture, bool p_enable);
 
 	/* SKY API */
@@ -446,6 +453,8 @@ public:
 			bool uses_screen_texture;
 			bool uses_screen_uv;
 			bool uses_time;
+			bool uses_vertex;
+			bool uses_world_matrix;
 
 		} canvas_item;
 
@@ -627,6 +636,13 @@ public:
 
 		Vector<BlendShape> blend_shapes;
 
+		struct LOD {
+			float edge_length; //object space error of this level
+			Surface *surface; //shares the vertex buffer, owns its index buffer
+		};
+
+		Vector<LOD> lods; //finest to coarsest
+
 		AABB aabb;
 
 		int array_len;
@@ -723,6 +739,9 @@ public:
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const;
 
+	void _mesh_surface_clear_lods(Surface *p_surface);
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_edge_lengths, const Vector<PoolVector<uint8_t> > &p_index_arrays);
+
 	virtual void mesh_remove_surface(RID p_mesh, int p_surface);
 	virtual int mesh_get_surface_count(RID p_mesh) const;
 
@@ -734,6 +753,10 @@ public:
 
 	/* MULTIMESH API */
 
+	enum {
+		MULTIMESH_DIRTY_REGION_SIZE = 512 //instances, changes are tracked and uploaded per region
+	};
+
 	struct MultiMesh : public GeometryOwner {
 
 		RID mesh;
@@ -759,6 +782,11 @@ public:
 		bool dirty_aabb;
 		bool dirty_data;
 
+		Vector<bool> dirty_regions;
+		int dirty_region_count;
+		Vector<AABB> region_aabbs;
+		bool dirty_region_aabbs; //all region aabbs must be recomputed, eg. the mesh changed
+
 		MultiMesh() :
 				size(0),
 				transform_format(VS::MULTIMESH_TRANSFORM_2D),
@@ -771,7 +799,9 @@ public:
 				color_floats(0),
 				custom_data_floats(0),
 				dirty_aabb(true),
-				dirty_data(true) {
+				dirty_data(true),
+				dirty_region_count(0),
+				dirty_region_aabbs(true) {
 		}
 	};
 
@@ -798,6 +828,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const;
 
 	virtual void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array);
+	virtual void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array);
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible);
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const;
@@ -806,6 +837,11 @@ public:
 
 	void update_dirty_multimeshes();
 
+	void _multimesh_mark_dirty(MultiMesh *p_multimesh, int p_index, bool p_aabb);
+	void _multimesh_mark_all_dirty(MultiMesh *p_multimesh, bool p_aabb);
+	void _multimesh_write_instances(MultiMesh *p_multimesh, int p_from, int p_count, const float *p_data);
+	AABB _multimesh_get_region_aabb(const MultiMesh *p_multimesh, int p_region, const AABB &p_mesh_aabb) const;
+
 	/* IMMEDIATE API */
 
 	struct Immediate : public Geometry {
@@ -891,6 +927,7 @@ public:
 	virtual void skeleton_allocate(RID p_skeleton, int p_bones, bool p_2d_skeleton = false);
 	virtual int skeleton_get_bone_count(RID p_skeleton) const;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform);
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms);
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const;
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform);
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const;
@@ -1104,6 +1141,8 @@ public:
 	virtual void particles_set_process_material(RID p_particles, RID p_material);
 	virtual void particles_set_fixed_fps(RID p_particles, int p_fps);
 	virtual void particles_set_fractional_delta(RID p_particles, bool p_enable);
+	virtual void particles_set_collision_heightfield(RID p_particles, RID p_texture, const AABB &p_aabb);
+	virtual void particles_set_collision_bounce(RID p_particles, float p_bounce);
 	virtual void particles_restart(RID p_particles);
 
 	virtual void particles_set_draw_order(RID p_particles, VS::ParticlesDrawOrder p_order);
@@ -1302,6 +1341,8 @@ public:
 
 	virtual void set_debug_generate_wireframes(bool p_generate);
 
+	virtual void warm_up_shaders();
+
 	virtual void render_info_begin_capture();
 	virtual void render_info_end_capture();
 	virtual int get_captured_render_info(VS::RenderInfo p_info);
@@ -187,7 +187,7 @@ void RasterizerCanvasGLES3::canvas_begin() {
 	//state.canvas_shader.set_uniform(CanvasShaderGLES3::MODELVIEW_MATRIX,Transform());
 	//state.canvas_shader.set_uniform(CanvasShaderGLES3::EXTRA_MATRIX,Transform());
 
-	glBindBufferBase(GL_UNIFORM_BUFFER, 0, state.canvas_item_ubo);
+	glBindBufferRange(GL_UNIFORM_BUFFER, 0, state.canvas_item_ubo->id, state.canvas_item_ubo_offset, sizeof(CanvasItemUBO));
 	glBindVertexArray(data.canvas_quad_array);
 	state.using_texture_rect = true;
 	state.using_ninepatch = false;
@@ -288,6 +288,13 @@ RasterizerStorageGLES3::Texture *RasterizerCanvasGLES3::_bind_canvas_texture(con
 	return tex_return;
 }
 
+void RasterizerCanvasGLES3::_upload_canvas_item_ubo() {
+
+	state.canvas_item_ubo_offset = storage->stream_buffer_upload(state.canvas_item_ubo, &state.canvas_item_ubo_data, sizeof(CanvasItemUBO), storage->config.uniform_buffer_offset_alignment);
+	glBindBufferRange(GL_UNIFORM_BUFFER, 0, state.canvas_item_ubo->id, state.canvas_item_ubo_offset, sizeof(CanvasItemUBO));
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
 void RasterizerCanvasGLES3::_set_texture_rect_mode(bool p_enable, bool p_ninepatch) {
 
 	if (state.using_texture_rect == p_enable && state.using_ninepatch == p_ninepatch)
@@ -323,25 +330,28 @@ void RasterizerCanvasGLES3::_set_texture_rect_mode(bool p_enable, bool p_ninepat
 
 void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_count, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor, const int *p_bones, const float *p_weights) {
 
-	glBindVertexArray(data.polygon_buffer_pointer_array);
-	glBindBuffer(GL_ARRAY_BUFFER, data.polygon_buffer);
+	uint32_t buffer_size = sizeof(Vector2) * p_vertex_count;
+	if (!p_singlecolor && p_colors)
+		buffer_size += sizeof(Color) * p_vertex_count;
+	if (p_uvs)
+		buffer_size += sizeof(Vector2) * p_vertex_count;
+	if (p_bones && p_weights)
+		buffer_size += (sizeof(int) * 4 + sizeof(float) * 4) * p_vertex_count;
 
-#ifndef GLES_OVER_GL
-	// Orphan the buffer to avoid CPU/GPU sync points caused by glBufferSubData
-	glBufferData(GL_ARRAY_BUFFER, data.polygon_buffer_size, NULL, GL_DYNAMIC_DRAW);
-#endif
+	uint32_t stream_ofs = 0;
+	uint8_t *buffer = storage->stream_buffer_map(data.polygon_stream, buffer_size, 4, stream_ofs);
+	ERR_FAIL_COND(!buffer);
+
+	glBindVertexArray(data.polygon_buffer_pointer_array);
 
 	uint32_t buffer_ofs = 0;
 
 	//vertex
-	glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_vertices);
+	copymem(buffer + buffer_ofs, p_vertices, sizeof(Vector2) * p_vertex_count);
 	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 	buffer_ofs += sizeof(Vector2) * p_vertex_count;
 	//color
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
 
 	if (p_singlecolor) {
 		glDisableVertexAttribArray(VS::ARRAY_COLOR);
@@ -352,42 +362,34 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
 		glVertexAttrib4f(VS::ARRAY_COLOR, 1, 1, 1, 1);
 	} else {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Color) * p_vertex_count, p_colors);
+		copymem(buffer + buffer_ofs, p_colors, sizeof(Color) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_COLOR);
-		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 		buffer_ofs += sizeof(Color) * p_vertex_count;
 	}
 
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
-
 	if (p_uvs) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_uvs);
+		copymem(buffer + buffer_ofs, p_uvs, sizeof(Vector2) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 		buffer_ofs += sizeof(Vector2) * p_vertex_count;
 
 	} else {
 		glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
 	}
 
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
-
 	if (p_bones && p_weights) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(int) * 4 * p_vertex_count, p_bones);
+		copymem(buffer + buffer_ofs, p_bones, sizeof(int) * 4 * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_BONES);
 		//glVertexAttribPointer(VS::ARRAY_BONES, 4, GL_UNSIGNED_INT, false, sizeof(int) * 4, ((uint8_t *)0) + buffer_ofs);
-		glVertexAttribIPointer(VS::ARRAY_BONES, 4, GL_UNSIGNED_INT, sizeof(int) * 4, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		glVertexAttribIPointer(VS::ARRAY_BONES, 4, GL_UNSIGNED_INT, sizeof(int) * 4, CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 		buffer_ofs += sizeof(int) * 4 * p_vertex_count;
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(float) * 4 * p_vertex_count, p_weights);
+		copymem(buffer + buffer_ofs, p_weights, sizeof(float) * 4 * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_WEIGHTS);
-		glVertexAttribPointer(VS::ARRAY_WEIGHTS, 4, GL_FLOAT, false, sizeof(float) * 4, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		glVertexAttribPointer(VS::ARRAY_WEIGHTS, 4, GL_FLOAT, false, sizeof(float) * 4, CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 		buffer_ofs += sizeof(float) * 4 * p_vertex_count;
 
 	} else if (state.using_skeleton) {
@@ -395,20 +397,13 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
 		glVertexAttrib4f(VS::ARRAY_WEIGHTS, 0, 0, 0, 0);
 	}
 
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
+	storage->stream_buffer_unmap(data.polygon_stream);
 
-	//bind the indices buffer.
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.polygon_index_buffer);
-#ifndef GLES_OVER_GL
-	// Orphan the buffer to avoid CPU/GPU sync points caused by glBufferSubData
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.polygon_index_buffer_size, NULL, GL_DYNAMIC_DRAW);
-#endif
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(int) * p_index_count, p_indices);
+	//upload the indices, this also binds the index buffer to the vertex array.
+	uint32_t index_ofs = storage->stream_buffer_upload(data.polygon_index_stream, p_indices, sizeof(int) * p_index_count);
 
 	//draw the triangles.
-	glDrawElements(GL_TRIANGLES, p_index_count, GL_UNSIGNED_INT, 0);
+	glDrawElements(GL_TRIANGLES, p_index_count, GL_UNSIGNED_INT, CAST_INT_TO_UCHAR_PTR(index_ofs));
 
 	storage->frame.canvas_draw_commands++;
 
@@ -424,20 +419,24 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
 
 void RasterizerCanvasGLES3::_draw_generic(GLuint p_primitive, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor) {
 
-	glBindVertexArray(data.polygon_buffer_pointer_array);
-	glBindBuffer(GL_ARRAY_BUFFER, data.polygon_buffer);
+	uint32_t buffer_size = sizeof(Vector2) * p_vertex_count;
+	if (!p_singlecolor && p_colors)
+		buffer_size += sizeof(Color) * p_vertex_count;
+	if (p_uvs)
+		buffer_size += sizeof(Vector2) * p_vertex_count;
 
-#ifndef GLES_OVER_GL
-	// Orphan the buffer to avoid CPU/GPU sync points caused by glBufferSubData
-	glBufferData(GL_ARRAY_BUFFER, data.polygon_buffer_size, NULL, GL_DYNAMIC_DRAW);
-#endif
+	uint32_t stream_ofs = 0;
+	uint8_t *buffer = storage->stream_buffer_map(data.polygon_stream, buffer_size, 4, stream_ofs);
+	ERR_FAIL_COND(!buffer);
+
+	glBindVertexArray(data.polygon_buffer_pointer_array);
 
 	uint32_t buffer_ofs = 0;
 
 	//vertex
-	glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_vertices);
+	copymem(buffer + buffer_ofs, p_vertices, sizeof(Vector2) * p_vertex_count);
 	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 	buffer_ofs += sizeof(Vector2) * p_vertex_count;
 	//color
 
@@ -450,23 +449,25 @@ void RasterizerCanvasGLES3::_draw_generic(GLuint p_primitive, int p_vertex_count
 		glVertexAttrib4f(VS::ARRAY_COLOR, 1, 1, 1, 1);
 	} else {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Color) * p_vertex_count, p_colors);
+		copymem(buffer + buffer_ofs, p_colors, sizeof(Color) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_COLOR);
-		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 		buffer_ofs += sizeof(Color) * p_vertex_count;
 	}
 
 	if (p_uvs) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_uvs);
+		copymem(buffer + buffer_ofs, p_uvs, sizeof(Vector2) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 		buffer_ofs += sizeof(Vector2) * p_vertex_count;
 
 	} else {
 		glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
 	}
 
+	storage->stream_buffer_unmap(data.polygon_stream);
+
 	glDrawArrays(p_primitive, 0, p_vertex_count);
 
 	storage->frame.canvas_draw_commands++;
@@ -477,25 +478,26 @@ void RasterizerCanvasGLES3::_draw_generic(GLuint p_primitive, int p_vertex_count
 
 void RasterizerCanvasGLES3::_draw_generic_indices(GLuint p_primitive, const int *p_indices, int p_index_count, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor) {
 
-	glBindVertexArray(data.polygon_buffer_pointer_array);
-	glBindBuffer(GL_ARRAY_BUFFER, data.polygon_buffer);
+	uint32_t buffer_size = sizeof(Vector2) * p_vertex_count;
+	if (!p_singlecolor && p_colors)
+		buffer_size += sizeof(Color) * p_vertex_count;
+	if (p_uvs)
+		buffer_size += sizeof(Vector2) * p_vertex_count;
 
-#ifndef GLES_OVER_GL
-	// Orphan the buffer to avoid CPU/GPU sync points caused by glBufferSubData
-	glBufferData(GL_ARRAY_BUFFER, data.polygon_buffer_size, NULL, GL_DYNAMIC_DRAW);
-#endif
+	uint32_t stream_ofs = 0;
+	uint8_t *buffer = storage->stream_buffer_map(data.polygon_stream, buffer_size, 4, stream_ofs);
+	ERR_FAIL_COND(!buffer);
+
+	glBindVertexArray(data.polygon_buffer_pointer_array);
 
 	uint32_t buffer_ofs = 0;
 
 	//vertex
-	glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_vertices);
+	copymem(buffer + buffer_ofs, p_vertices, sizeof(Vector2) * p_vertex_count);
 	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 	buffer_ofs += sizeof(Vector2) * p_vertex_count;
 	//color
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
 
 	if (p_singlecolor) {
 		glDisableVertexAttribArray(VS::ARRAY_COLOR);
@@ -506,41 +508,30 @@ void RasterizerCanvasGLES3::_draw_generic_indices(GLuint p_primitive, const int
 		glVertexAttrib4f(VS::ARRAY_COLOR, 1, 1, 1, 1);
 	} else {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Color) * p_vertex_count, p_colors);
+		copymem(buffer + buffer_ofs, p_colors, sizeof(Color) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_COLOR);
-		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 		buffer_ofs += sizeof(Color) * p_vertex_count;
 	}
 
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
-
 	if (p_uvs) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_uvs);
+		copymem(buffer + buffer_ofs, p_uvs, sizeof(Vector2) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(stream_ofs + buffer_ofs));
 		buffer_ofs += sizeof(Vector2) * p_vertex_count;
 
 	} else {
 		glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
 	}
 
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
+	storage->stream_buffer_unmap(data.polygon_stream);
 
-	//bind the indices buffer.
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.polygon_index_buffer);
-#ifndef GLES_OVER_GL
-	// Orphan the buffer to avoid CPU/GPU sync points caused by glBufferSubData
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.polygon_index_buffer_size, NULL, GL_DYNAMIC_DRAW);
-#endif
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(int) * p_index_count, p_indices);
+	//upload the indices, this also binds the index buffer to the vertex array.
+	uint32_t index_ofs = storage->stream_buffer_upload(data.polygon_index_stream, p_indices, sizeof(int) * p_index_count);
 
 	//draw the triangles.
-	glDrawElements(p_primitive, p_index_count, GL_UNSIGNED_INT, 0);
+	glDrawElements(p_primitive, p_index_count, GL_UNSIGNED_INT, CAST_INT_TO_UCHAR_PTR(index_ofs));
 
 	storage->frame.canvas_draw_commands++;
 
@@ -554,19 +545,16 @@ void RasterizerCanvasGLES3::_draw_gui_primitive(int p_points, const Vector2 *p_v
 
 	//#define GLES_USE_PRIMITIVE_BUFFER
 
-	int version = 0;
 	int color_ofs = 0;
 	int uv_ofs = 0;
 	int stride = 2;
 
 	if (p_colors) { //color
-		version |= 1;
 		color_ofs = stride;
 		stride += 4;
 	}
 
 	if (p_uvs) { //uv
-		version |= 2;
 		uv_ofs = stride;
 		stride += 2;
 	}
@@ -596,14 +584,27 @@ void RasterizerCanvasGLES3::_draw_gui_primitive(int p_points, const Vector2 *p_v
 		}
 	}
 
-	glBindBuffer(GL_ARRAY_BUFFER, data.polygon_buffer);
-#ifndef GLES_OVER_GL
-	// Orphan the buffer to avoid CPU/GPU sync points caused by glBufferSubData
-	glBufferData(GL_ARRAY_BUFFER, data.polygon_buffer_size, NULL, GL_DYNAMIC_DRAW);
-#endif
-	//TODO the below call may need to be replaced with: glBufferSubData(GL_ARRAY_BUFFER, 0, p_points * stride * 4 * sizeof(float), &b[0]);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, p_points * stride * 4, &b[0]);
-	glBindVertexArray(data.polygon_buffer_quad_arrays[version]);
+	uint32_t buffer_ofs = storage->stream_buffer_upload(data.polygon_stream, &b[0], p_points * stride * sizeof(float));
+
+	glBindVertexArray(data.polygon_buffer_pointer_array);
+
+	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, GL_FALSE, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+
+	if (p_colors) {
+		glEnableVertexAttribArray(VS::ARRAY_COLOR);
+		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, GL_FALSE, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(buffer_ofs + color_ofs * sizeof(float)));
+	} else {
+		glDisableVertexAttribArray(VS::ARRAY_COLOR);
+	}
+
+	if (p_uvs) {
+		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, GL_FALSE, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(buffer_ofs + uv_ofs * sizeof(float)));
+	} else {
+		glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
+	}
+
 	glDrawArrays(prim[p_points], 0, p_points);
 	glBindVertexArray(0);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -621,6 +622,399 @@ static const GLenum gl_primitive[] = {
 	GL_TRIANGLE_FAN
 };
 
+bool RasterizerCanvasGLES3::_get_batch_command_textures(const Item::Command *p_command, RID &r_texture, RID &r_normal_map) const {
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+			r_texture = rect->texture;
+			r_normal_map = rect->normal_map;
+		} break;
+		case Item::Command::TYPE_NINEPATCH: {
+
+			const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+			r_texture = np->texture;
+			r_normal_map = np->normal_map;
+		} break;
+		case Item::Command::TYPE_PRIMITIVE: {
+
+			const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(p_command);
+			r_texture = primitive->texture;
+			r_normal_map = primitive->normal_map;
+		} break;
+		case Item::Command::TYPE_POLYGON: {
+
+			const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(p_command);
+			r_texture = polygon->texture;
+			r_normal_map = polygon->normal_map;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool RasterizerCanvasGLES3::_get_batch_command_size(const Item::Command *p_command, const RasterizerStorageGLES3::Texture *p_texture, int &r_vertex_count, int &r_index_count) const {
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+
+			if (rect->flags & CANVAS_RECT_CLIP_UV) {
+				return false; // needs the per rect clamp done in the fragment shader
+			}
+
+			if (p_texture) {
+				if (rect->flags & CANVAS_RECT_TILE && !(p_texture->flags & VS::TEXTURE_FLAG_REPEAT)) {
+					return false; // needs the wrap mode toggled around the draw
+				}
+				if (rect->flags & (CANVAS_RECT_FLIP_H | CANVAS_RECT_FLIP_V) && rect->normal_map.is_valid()) {
+					return false; // flipped normals are handled by the texture rect shader
+				}
+			}
+
+			r_vertex_count = 4;
+			r_index_count = 6;
+		} break;
+		case Item::Command::TYPE_NINEPATCH: {
+
+			const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+
+			if (!p_texture || np->axis_x != VS::NINE_PATCH_STRETCH || np->axis_y != VS::NINE_PATCH_STRETCH) {
+				return false;
+			}
+
+			if (np->rect.size.width <= 0 || np->rect.size.height <= 0) {
+				return false;
+			}
+
+			Size2 tex_size = np->source != Rect2() ? np->source.size : Size2(p_texture->width, p_texture->height);
+			float s_ratio = MAX(1.0, MAX(tex_size.width / np->rect.size.width, tex_size.height / np->rect.size.height));
+
+			if ((np->margin[MARGIN_LEFT] + np->margin[MARGIN_RIGHT]) / s_ratio > np->rect.size.width || (np->margin[MARGIN_TOP] + np->margin[MARGIN_BOTTOM]) / s_ratio > np->rect.size.height) {
+				return false; // overlapping margins are resolved per pixel in the shader
+			}
+
+			// 4x4 grid, the center is emitted separately when it has to be transparent
+			r_vertex_count = np->draw_center ? 16 : 20;
+			r_index_count = 9 * 6;
+		} break;
+		case Item::Command::TYPE_PRIMITIVE: {
+
+			const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(p_command);
+			int point_count = primitive->points.size();
+
+			if (point_count < 3 || point_count > 4) {
+				return false; // points and lines can't go in a triangle batch
+			}
+			if (primitive->colors.size() > 1 && primitive->colors.size() != point_count) {
+				return false;
+			}
+			if (primitive->uvs.size() && primitive->uvs.size() != point_count) {
+				return false;
+			}
+
+			r_vertex_count = point_count;
+			r_index_count = point_count == 4 ? 6 : 3;
+		} break;
+		case Item::Command::TYPE_POLYGON: {
+
+			const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(p_command);
+			int point_count = polygon->points.size();
+
+			if (polygon->antialiased || polygon->count <= 0 || polygon->count > polygon->indices.size()) {
+				return false;
+			}
+			if (polygon->colors.size() > 1 && polygon->colors.size() != point_count) {
+				return false;
+			}
+			if (polygon->uvs.size() && polygon->uvs.size() != point_count) {
+				return false;
+			}
+
+			r_vertex_count = point_count;
+			r_index_count = polygon->count;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RasterizerCanvasGLES3::_fill_batch_command(const Item::Command *p_command, const RasterizerStorageGLES3::Texture *p_texture, int &r_vertex_ofs, int &r_index_ofs) {
+
+	Vector2 *vertices = &data.batch_vertices[r_vertex_ofs];
+	Vector2 *uvs = &data.batch_uvs[r_vertex_ofs];
+	Color *colors = &data.batch_colors[r_vertex_ofs];
+	int *indices = &data.batch_indices[r_index_ofs];
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+
+			Rect2 dst_rect = Rect2(rect->rect.position, rect->rect.size);
+			Rect2 src_rect = Rect2(0, 0, 1, 1);
+			bool transpose = false;
+
+			if (dst_rect.size.width < 0) {
+				dst_rect.position.x += dst_rect.size.width;
+				dst_rect.size.width *= -1;
+			}
+			if (dst_rect.size.height < 0) {
+				dst_rect.position.y += dst_rect.size.height;
+				dst_rect.size.height *= -1;
+			}
+
+			if (p_texture) {
+
+				Size2 texpixel_size(1.0 / p_texture->width, 1.0 / p_texture->height);
+				if (rect->flags & CANVAS_RECT_REGION) {
+					src_rect = Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size);
+				}
+				if (rect->flags & CANVAS_RECT_FLIP_H) {
+					src_rect.size.x *= -1;
+				}
+				if (rect->flags & CANVAS_RECT_FLIP_V) {
+					src_rect.size.y *= -1;
+				}
+				transpose = rect->flags & CANVAS_RECT_TRANSPOSE;
+			}
+
+			// Same mapping the texture rect shader does on the unit quad.
+			static const Vector2 quad[4] = { Vector2(0, 0), Vector2(0, 1), Vector2(1, 1), Vector2(1, 0) };
+
+			for (int i = 0; i < 4; i++) {
+
+				Vector2 v = quad[i];
+				Vector2 pos_v(src_rect.size.x < 0 ? 1.0 - v.x : v.x, src_rect.size.y < 0 ? 1.0 - v.y : v.y);
+				vertices[i] = dst_rect.position + dst_rect.size * pos_v;
+				uvs[i] = src_rect.position + src_rect.size.abs() * (transpose ? Vector2(v.y, v.x) : v);
+				colors[i] = rect->modulate;
+			}
+
+			indices[0] = r_vertex_ofs + 0;
+			indices[1] = r_vertex_ofs + 1;
+			indices[2] = r_vertex_ofs + 2;
+			indices[3] = r_vertex_ofs + 0;
+			indices[4] = r_vertex_ofs + 2;
+			indices[5] = r_vertex_ofs + 3;
+
+			r_vertex_ofs += 4;
+			r_index_ofs += 6;
+		} break;
+		case Item::Command::TYPE_NINEPATCH: {
+
+			const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+
+			Rect2 source = np->source != Rect2() ? np->source : Rect2(0, 0, p_texture->width, p_texture->height);
+			float s_ratio = MAX(1.0, MAX(source.size.width / np->rect.size.width, source.size.height / np->rect.size.height));
+			Size2 texpixel_size(1.0 / p_texture->width, 1.0 / p_texture->height);
+
+			float x[4] = {
+				np->rect.position.x,
+				np->rect.position.x + np->margin[MARGIN_LEFT] / s_ratio,
+				np->rect.position.x + np->rect.size.width - np->margin[MARGIN_RIGHT] / s_ratio,
+				np->rect.position.x + np->rect.size.width
+			};
+			float y[4] = {
+				np->rect.position.y,
+				np->rect.position.y + np->margin[MARGIN_TOP] / s_ratio,
+				np->rect.position.y + np->rect.size.height - np->margin[MARGIN_BOTTOM] / s_ratio,
+				np->rect.position.y + np->rect.size.height
+			};
+			float u[4] = {
+				source.position.x * texpixel_size.x,
+				(source.position.x + np->margin[MARGIN_LEFT]) * texpixel_size.x,
+				(source.position.x + source.size.width - np->margin[MARGIN_RIGHT]) * texpixel_size.x,
+				(source.position.x + source.size.width) * texpixel_size.x
+			};
+			float v[4] = {
+				source.position.y * texpixel_size.y,
+				(source.position.y + np->margin[MARGIN_TOP]) * texpixel_size.y,
+				(source.position.y + source.size.height - np->margin[MARGIN_BOTTOM]) * texpixel_size.y,
+				(source.position.y + source.size.height) * texpixel_size.y
+			};
+
+			for (int j = 0; j < 4; j++) {
+				for (int i = 0; i < 4; i++) {
+					vertices[j * 4 + i] = Vector2(x[i], y[j]);
+					uvs[j * 4 + i] = Vector2(u[i], v[j]);
+					colors[j * 4 + i] = np->color;
+				}
+			}
+
+			int vertex_count = 16;
+			int index_count = 0;
+
+			for (int j = 0; j < 3; j++) {
+				for (int i = 0; i < 3; i++) {
+
+					int a = j * 4 + i;
+					int b = a + 1;
+					int c = a + 5;
+					int d = a + 4;
+
+					if (i == 1 && j == 1 && !np->draw_center) {
+						// The shader still draws the center, just fully transparent.
+						const int corners[4] = { a, b, c, d };
+						for (int k = 0; k < 4; k++) {
+							vertices[16 + k] = vertices[corners[k]];
+							uvs[16 + k] = uvs[corners[k]];
+							colors[16 + k] = Color(np->color.r, np->color.g, np->color.b, 0.0);
+						}
+						a = 16;
+						b = 17;
+						c = 18;
+						d = 19;
+						vertex_count = 20;
+					}
+
+					indices[index_count++] = r_vertex_ofs + a;
+					indices[index_count++] = r_vertex_ofs + b;
+					indices[index_count++] = r_vertex_ofs + c;
+					indices[index_count++] = r_vertex_ofs + a;
+					indices[index_count++] = r_vertex_ofs + c;
+					indices[index_count++] = r_vertex_ofs + d;
+				}
+			}
+
+			r_vertex_ofs += vertex_count;
+			r_index_ofs += index_count;
+		} break;
+		case Item::Command::TYPE_PRIMITIVE: {
+
+			const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(p_command);
+			int point_count = primitive->points.size();
+			const Vector2 *points = primitive->points.ptr();
+
+			for (int i = 0; i < point_count; i++) {
+				vertices[i] = points[i];
+				uvs[i] = primitive->uvs.size() ? primitive->uvs[i] : Vector2();
+				if (primitive->colors.size() > 1) {
+					colors[i] = primitive->colors[i];
+				} else {
+					colors[i] = primitive->colors.size() ? primitive->colors[0] : Color(1, 1, 1, 1);
+				}
+			}
+
+			indices[0] = r_vertex_ofs + 0;
+			indices[1] = r_vertex_ofs + 1;
+			indices[2] = r_vertex_ofs + 2;
+			if (point_count == 4) {
+				indices[3] = r_vertex_ofs + 0;
+				indices[4] = r_vertex_ofs + 2;
+				indices[5] = r_vertex_ofs + 3;
+			}
+
+			r_vertex_ofs += point_count;
+			r_index_ofs += point_count == 4 ? 6 : 3;
+		} break;
+		case Item::Command::TYPE_POLYGON: {
+
+			const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(p_command);
+			int point_count = polygon->points.size();
+			const Vector2 *points = polygon->points.ptr();
+			const int *polygon_indices = polygon->indices.ptr();
+
+			for (int i = 0; i < point_count; i++) {
+				vertices[i] = points[i];
+				uvs[i] = polygon->uvs.size() ? polygon->uvs[i] : Vector2();
+				if (polygon->colors.size() > 1) {
+					colors[i] = polygon->colors[i];
+				} else {
+					colors[i] = polygon->colors.size() ? polygon->colors[0] : Color(1, 1, 1, 1);
+				}
+			}
+
+			for (int i = 0; i < polygon->count; i++) {
+				indices[i] = r_vertex_ofs + polygon_indices[i];
+			}
+
+			r_vertex_ofs += point_count;
+			r_index_ofs += polygon->count;
+		} break;
+		default: {
+		}
+	}
+}
+
+int RasterizerCanvasGLES3::_canvas_item_batch_commands(Item::Command *const *p_commands, int p_count) {
+
+	if (!state.use_batching || !state.batching_allowed || state.using_skeleton || p_count < 2) {
+		return 0;
+	}
+
+	RID texture;
+	RID normal_map;
+
+	if (!_get_batch_command_textures(p_commands[0], texture, normal_map)) {
+		return 0;
+	}
+
+	RasterizerStorageGLES3::Texture *texture_ptr = storage->texture_owner.getornull(texture);
+	if (texture_ptr) {
+		texture_ptr = texture_ptr->get_ptr();
+	}
+
+	int batch_size = 0;
+	int vertex_count = 0;
+	int index_count = 0;
+
+	while (batch_size < p_count) {
+
+		RID command_texture;
+		RID command_normal_map;
+		if (!_get_batch_command_textures(p_commands[batch_size], command_texture, command_normal_map) || command_texture != texture || command_normal_map != normal_map) {
+			break;
+		}
+
+		int command_vertices;
+		int command_indices;
+		if (!_get_batch_command_size(p_commands[batch_size], texture_ptr, command_vertices, command_indices)) {
+			break;
+		}
+
+		if (vertex_count + command_vertices > data.batch_max_vertices || index_count + command_indices > data.batch_max_indices) {
+			break;
+		}
+
+		vertex_count += command_vertices;
+		index_count += command_indices;
+		batch_size++;
+	}
+
+	if (batch_size < 2) {
+		return 0; // nothing to gain, let the regular path draw it
+	}
+
+	_set_texture_rect_mode(false);
+
+	RasterizerStorageGLES3::Texture *bound_texture = _bind_canvas_texture(texture, normal_map);
+
+	if (bound_texture) {
+		Size2 texpixel_size(1.0 / bound_texture->width, 1.0 / bound_texture->height);
+		state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
+	}
+
+	int vertex_ofs = 0;
+	int index_ofs = 0;
+
+	for (int i = 0; i < batch_size; i++) {
+		_fill_batch_command(p_commands[i], bound_texture, vertex_ofs, index_ofs);
+	}
+
+	_draw_polygon(data.batch_indices, index_ofs, vertex_ofs, data.batch_vertices, data.batch_uvs, data.batch_colors, false, NULL, NULL);
+
+	return batch_size;
+}
+
 void RasterizerCanvasGLES3::_canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip) {
 
 	int cc = p_item->commands.size();
@@ -628,6 +1022,18 @@ void RasterizerCanvasGLES3::_canvas_item_render_commands(Item *p_item, Item *cur
 
 	for (int i = 0; i < cc; i++) {
 
+		int batched = _canvas_item_batch_commands(&commands[i], cc - i);
+
+		if (batched) {
+			storage->info.render.canvas_command_count += batched;
+			storage->info.render.canvas_batch_count++;
+			i += batched - 1;
+			continue;
+		}
+
+		storage->info.render.canvas_command_count++;
+		storage->info.render.canvas_batch_count++;
+
 		Item::Command *c = commands[i];
 
 		switch (c->type) {
@@ -1339,13 +1745,12 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 
 	bool rebind_shader = true;
 
-	glBindBuffer(GL_UNIFORM_BUFFER, state.canvas_item_ubo);
-	glBufferData(GL_UNIFORM_BUFFER, sizeof(CanvasItemUBO), &state.canvas_item_ubo_data, GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	_upload_canvas_item_ubo();
 
 	state.current_tex = RID();
 	state.current_tex_ptr = NULL;
 	state.current_normal = RID();
+	state.batching_allowed = true;
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_2D, storage->resources.white_tex);
 
@@ -1523,6 +1928,7 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 			}
 
 			shader_cache = shader_ptr;
+			state.batching_allowed = !shader_ptr || !shader_ptr->canvas_item.uses_vertex;
 
 			canvas_last_material = material;
 			rebind_shader = false;
@@ -1998,9 +2404,7 @@ void RasterizerCanvasGLES3::reset_canvas() {
 	store_transform(canvas_transform, state.canvas_item_ubo_data.projection_matrix);
 	state.canvas_item_ubo_data.time = storage->frame.time[0];
 
-	glBindBuffer(GL_UNIFORM_BUFFER, state.canvas_item_ubo);
-	glBufferData(GL_UNIFORM_BUFFER, sizeof(CanvasItemUBO), &state.canvas_item_ubo_data, GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	_upload_canvas_item_ubo();
 
 	state.canvas_texscreen_used = false;
 }
@@ -2037,7 +2441,7 @@ void RasterizerCanvasGLES3::draw_lens_distortion_rect(const Rect2 &p_rect, float
 	state.lens_shader.set_uniform(LensDistortedShaderGLES3::UPSCALE, p_oversample);
 	state.lens_shader.set_uniform(LensDistortedShaderGLES3::ASPECT_RATIO, aspect_ratio);
 
-	glBindBufferBase(GL_UNIFORM_BUFFER, 0, state.canvas_item_ubo);
+	glBindBufferRange(GL_UNIFORM_BUFFER, 0, state.canvas_item_ubo->id, state.canvas_item_ubo_offset, sizeof(CanvasItemUBO));
 	glBindVertexArray(data.canvas_quad_array);
 
 	// and draw
@@ -2175,67 +2579,30 @@ void RasterizerCanvasGLES3::initialize() {
 		ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/buffers/canvas_polygon_buffer_size_kb", PropertyInfo(Variant::INT, "rendering/limits/buffers/canvas_polygon_buffer_size_kb", PROPERTY_HINT_RANGE, "0,256,1,or_greater"));
 		poly_size *= 1024; //kb
 		poly_size = MAX(poly_size, (2 + 2 + 4) * 4 * sizeof(float));
-		glGenBuffers(1, &data.polygon_buffer);
-		glBindBuffer(GL_ARRAY_BUFFER, data.polygon_buffer);
-		glBufferData(GL_ARRAY_BUFFER, poly_size, NULL, GL_DYNAMIC_DRAW); //allocate max size
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		data.polygon_stream = storage->stream_buffer_create(GL_ARRAY_BUFFER, poly_size);
 		data.polygon_buffer_size = poly_size;
 
-		//quad arrays
-		for (int i = 0; i < 4; i++) {
-			glGenVertexArrays(1, &data.polygon_buffer_quad_arrays[i]);
-			glBindVertexArray(data.polygon_buffer_quad_arrays[i]);
-			glBindBuffer(GL_ARRAY_BUFFER, data.polygon_buffer);
-
-			int uv_ofs = 0;
-			int color_ofs = 0;
-			int stride = 2 * 4;
-
-			if (i & 1) { //color
-				color_ofs = stride;
-				stride += 4 * 4;
-			}
-
-			if (i & 2) { //uv
-				uv_ofs = stride;
-				stride += 2 * 4;
-			}
-
-			glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-			glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, GL_FALSE, stride, NULL);
-
-			if (i & 1) {
-				glEnableVertexAttribArray(VS::ARRAY_COLOR);
-				glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, GL_FALSE, stride, CAST_INT_TO_UCHAR_PTR(color_ofs));
-			}
-
-			if (i & 2) {
-				glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-				glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, GL_FALSE, stride, CAST_INT_TO_UCHAR_PTR(uv_ofs));
-			}
-
-			glBindVertexArray(0);
-		}
-
 		glGenVertexArrays(1, &data.polygon_buffer_pointer_array);
 
 		uint32_t index_size = GLOBAL_DEF_RST("rendering/limits/buffers/canvas_polygon_index_buffer_size_kb", 128);
 		ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/buffers/canvas_polygon_index_buffer_size_kb", PropertyInfo(Variant::INT, "rendering/limits/buffers/canvas_polygon_index_buffer_size_kb", PROPERTY_HINT_RANGE, "0,256,1,or_greater"));
 		index_size *= 1024; //kb
-		glGenBuffers(1, &data.polygon_index_buffer);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.polygon_index_buffer);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_size, NULL, GL_DYNAMIC_DRAW); //allocate max size
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
+		data.polygon_index_stream = storage->stream_buffer_create(GL_ELEMENT_ARRAY_BUFFER, index_size);
 		data.polygon_index_buffer_size = index_size;
+
+		// batched vertices carry position, color and uv
+		data.batch_max_vertices = poly_size / (sizeof(Vector2) * 2 + sizeof(Color));
+		data.batch_max_indices = index_size / sizeof(int);
+		data.batch_vertices = (Vector2 *)memalloc(sizeof(Vector2) * data.batch_max_vertices);
+		data.batch_uvs = (Vector2 *)memalloc(sizeof(Vector2) * data.batch_max_vertices);
+		data.batch_colors = (Color *)memalloc(sizeof(Color) * data.batch_max_vertices);
+		data.batch_indices = (int *)memalloc(sizeof(int) * MAX(data.batch_max_indices, 1));
 	}
 
 	store_transform(Transform(), state.canvas_item_ubo_data.projection_matrix);
 
-	glGenBuffers(1, &state.canvas_item_ubo);
-	glBindBuffer(GL_UNIFORM_BUFFER, state.canvas_item_ubo);
-	glBufferData(GL_UNIFORM_BUFFER, sizeof(CanvasItemUBO), &state.canvas_item_ubo_data, GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	state.canvas_item_ubo = storage->stream_buffer_create(GL_UNIFORM_BUFFER, 64 * 1024);
+	_upload_canvas_item_ubo();
 
 	state.canvas_shader.init();
 	state.canvas_shader.set_base_material_tex_index(2);
@@ -2246,6 +2613,9 @@ void RasterizerCanvasGLES3::initialize() {
 	state.canvas_shadow_shader.set_conditional(CanvasShadowShaderGLES3::USE_RGBA_SHADOWS, storage->config.use_rgba_2d_shadows);
 
 	state.canvas_shader.set_conditional(CanvasShaderGLES3::USE_PIXEL_SNAP, GLOBAL_DEF("rendering/quality/2d/use_pixel_snap", false));
+
+	state.use_batching = GLOBAL_DEF("rendering/quality/2d/use_batching", true);
+	state.batching_allowed = true;
 }
 
 void RasterizerCanvasGLES3::finalize() {
@@ -2257,6 +2627,15 @@ void RasterizerCanvasGLES3::finalize() {
 	glDeleteVertexArrays(1, &data.canvas_quad_array);
 
 	glDeleteVertexArrays(1, &data.polygon_buffer_pointer_array);
+
+	storage->stream_buffer_free(data.polygon_stream);
+	storage->stream_buffer_free(data.polygon_index_stream);
+	storage->stream_buffer_free(state.canvas_item_ubo);
+
+	memfree(data.batch_vertices);
+	memfree(data.batch_uvs);
+	memfree(data.batch_colors);
+	memfree(data.batch_indices);
 }
 
 RasterizerCanvasGLES3::RasterizerCanvasGLES3() {
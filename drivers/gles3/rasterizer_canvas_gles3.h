@@ -55,10 +55,9 @@ public:
 		GLuint canvas_quad_vertices;
 		GLuint canvas_quad_array;
 
-		GLuint polygon_buffer;
-		GLuint polygon_buffer_quad_arrays[4];
+		RasterizerStorageGLES3::StreamBuffer *polygon_stream;
+		RasterizerStorageGLES3::StreamBuffer *polygon_index_stream;
 		GLuint polygon_buffer_pointer_array;
-		GLuint polygon_index_buffer;
 
 		GLuint particle_quad_vertices;
 		GLuint particle_quad_array;
@@ -66,11 +65,20 @@ public:
 		uint32_t polygon_buffer_size;
 		uint32_t polygon_index_buffer_size;
 
+		// CPU side staging for batched commands, sized to fit the polygon buffers.
+		Vector2 *batch_vertices;
+		Vector2 *batch_uvs;
+		Color *batch_colors;
+		int *batch_indices;
+		int batch_max_vertices;
+		int batch_max_indices;
+
 	} data;
 
 	struct State {
 		CanvasItemUBO canvas_item_ubo_data;
-		GLuint canvas_item_ubo;
+		RasterizerStorageGLES3::StreamBuffer *canvas_item_ubo;
+		uint32_t canvas_item_ubo_offset;
 		bool canvas_texscreen_used;
 		CanvasShaderGLES3 canvas_shader;
 		CanvasShadowShaderGLES3 canvas_shadow_shader;
@@ -79,6 +87,9 @@ public:
 		bool using_texture_rect;
 		bool using_ninepatch;
 
+		bool use_batching;
+		bool batching_allowed; // false while a custom shader that reads VERTEX is bound
+
 		RID current_tex;
 		RID current_normal;
 		RasterizerStorageGLES3::Texture *current_tex_ptr;
@@ -126,6 +137,7 @@ public:
 	virtual void canvas_begin();
 	virtual void canvas_end();
 
+	_FORCE_INLINE_ void _upload_canvas_item_ubo();
 	_FORCE_INLINE_ void _set_texture_rect_mode(bool p_enable, bool p_ninepatch = false);
 	_FORCE_INLINE_ RasterizerStorageGLES3::Texture *_bind_canvas_texture(const RID &p_texture, const RID &p_normal_map, bool p_force = false);
 
@@ -134,6 +146,11 @@ public:
 	_FORCE_INLINE_ void _draw_generic(GLuint p_primitive, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor);
 	_FORCE_INLINE_ void _draw_generic_indices(GLuint p_primitive, const int *p_indices, int p_index_count, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor);
 
+	_FORCE_INLINE_ bool _get_batch_command_textures(const Item::Command *p_command, RID &r_texture, RID &r_normal_map) const;
+	_FORCE_INLINE_ bool _get_batch_command_size(const Item::Command *p_command, const RasterizerStorageGLES3::Texture *p_texture, int &r_vertex_count, int &r_index_count) const;
+	_FORCE_INLINE_ void _fill_batch_command(const Item::Command *p_command, const RasterizerStorageGLES3::Texture *p_texture, int &r_vertex_ofs, int &r_index_ofs);
+	_FORCE_INLINE_ int _canvas_item_batch_commands(Item::Command *const *p_commands, int p_count);
+
 	_FORCE_INLINE_ void _canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip);
 	_FORCE_INLINE_ void _copy_texscreen(const Rect2 &p_rect);
 
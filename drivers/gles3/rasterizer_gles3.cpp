@@ -31,6 +31,7 @@
 #include "rasterizer_gles3.h"
 
 #include "core/os/os.h"
+#include "core/os/timeline_profiler.h"
 #include "core/project_settings.h"
 
 RasterizerStorage *RasterizerGLES3::get_storage() {
@@ -187,10 +188,57 @@ void RasterizerGLES3::initialize() {
 	*/
 
 	print_line("OpenGL ES 3.0 Renderer: " + VisualServer::get_singleton()->get_video_adapter_name());
+	shader_cache = memnew(ShaderCacheGLES3);
 	storage->initialize();
 	canvas->initialize();
 	scene->initialize();
+
+#ifdef GLES_OVER_GL
+	glGenQueries(GPU_TIMER_FRAMES * 2, &gpu_timer_queries[0][0]);
+#endif
+}
+
+#ifdef GLES_OVER_GL
+void RasterizerGLES3::_gpu_timer_begin_frame() {
+
+	gpu_timer_started = false;
+
+	int idx = gpu_timer_frame % GPU_TIMER_FRAMES;
+	if (gpu_timer_pending[idx]) {
+		//results that are still not there after a few frames are dropped, rather than waited for
+		GLint available = 0;
+		glGetQueryObjectiv(gpu_timer_queries[idx][1], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available) {
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(gpu_timer_queries[idx][0], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(gpu_timer_queries[idx][1], GL_QUERY_RESULT, &end);
+			//gpu clocks are not comparable with cpu ones, the frame is placed where its commands were submitted
+			uint64_t cpu_begin = gpu_timer_cpu_begin[idx];
+			TimelineProfiler::add_gpu_event("GPU frame", cpu_begin, cpu_begin + (end - begin) / 1000);
+		}
+		gpu_timer_pending[idx] = false;
+	}
+
+	if (!TimelineProfiler::is_enabled())
+		return;
+
+	glQueryCounter(gpu_timer_queries[idx][0], GL_TIMESTAMP);
+	gpu_timer_cpu_begin[idx] = OS::get_singleton()->get_ticks_usec();
+	gpu_timer_started = true;
+}
+
+void RasterizerGLES3::_gpu_timer_end_frame() {
+
+	if (!gpu_timer_started)
+		return;
+
+	int idx = gpu_timer_frame % GPU_TIMER_FRAMES;
+	glQueryCounter(gpu_timer_queries[idx][1], GL_TIMESTAMP);
+	gpu_timer_pending[idx] = true;
+	gpu_timer_frame++;
+	gpu_timer_started = false;
 }
+#endif
 
 void RasterizerGLES3::begin_frame(double frame_step) {
 
@@ -218,6 +266,10 @@ void RasterizerGLES3::begin_frame(double frame_step) {
 	storage->info.render.reset();
 
 	scene->iteration();
+
+#ifdef GLES_OVER_GL
+	_gpu_timer_begin_frame();
+#endif
 }
 
 void RasterizerGLES3::set_current_render_target(RID p_render_target) {
@@ -372,6 +424,10 @@ void RasterizerGLES3::output_lens_distorted_to_screen(RID p_render_target, const
 
 void RasterizerGLES3::end_frame(bool p_swap_buffers) {
 
+#ifdef GLES_OVER_GL
+	_gpu_timer_end_frame();
+#endif
+
 	if (OS::get_singleton()->is_layered_allowed()) {
 		if (OS::get_singleton()->get_window_per_pixel_transparency_enabled()) {
 #if (defined WINDOWS_ENABLED) && !(defined UWP_ENABLED)
@@ -401,8 +457,13 @@ void RasterizerGLES3::end_frame(bool p_swap_buffers) {
 
 void RasterizerGLES3::finalize() {
 
+#ifdef GLES_OVER_GL
+	glDeleteQueries(GPU_TIMER_FRAMES * 2, &gpu_timer_queries[0][0]);
+#endif
+
 	storage->finalize();
 	canvas->finalize();
+	scene->finalize();
 }
 
 Rasterizer *RasterizerGLES3::_create_current() {
@@ -432,8 +493,20 @@ RasterizerGLES3::RasterizerGLES3() {
 	storage->canvas = canvas;
 	scene->storage = storage;
 	storage->scene = scene;
+	shader_cache = NULL;
 
 	time_total = 0;
+
+#ifdef GLES_OVER_GL
+	for (int i = 0; i < GPU_TIMER_FRAMES; i++) {
+		gpu_timer_queries[i][0] = 0;
+		gpu_timer_queries[i][1] = 0;
+		gpu_timer_cpu_begin[i] = 0;
+		gpu_timer_pending[i] = false;
+	}
+	gpu_timer_frame = 0;
+	gpu_timer_started = false;
+#endif
 }
 
 RasterizerGLES3::~RasterizerGLES3() {
@@ -441,4 +514,8 @@ RasterizerGLES3::~RasterizerGLES3() {
 	memdelete(storage);
 	memdelete(canvas);
 	memdelete(scene);
+
+	if (shader_cache) {
+		memdelete(shader_cache);
+	}
 }
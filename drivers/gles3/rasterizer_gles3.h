@@ -34,6 +34,7 @@
 #include "rasterizer_canvas_gles3.h"
 #include "rasterizer_scene_gles3.h"
 #include "rasterizer_storage_gles3.h"
+#include "shader_cache_gles3.h"
 #include "servers/visual/rasterizer.h"
 
 class RasterizerGLES3 : public Rasterizer {
@@ -43,9 +44,26 @@ class RasterizerGLES3 : public Rasterizer {
 	RasterizerStorageGLES3 *storage;
 	RasterizerCanvasGLES3 *canvas;
 	RasterizerSceneGLES3 *scene;
+	ShaderCacheGLES3 *shader_cache;
 
 	double time_total;
 
+#ifdef GLES_OVER_GL
+	//gpu frame times for the timeline profiler, read back a few frames later to avoid stalling
+	enum {
+		GPU_TIMER_FRAMES = 4
+	};
+
+	GLuint gpu_timer_queries[GPU_TIMER_FRAMES][2];
+	uint64_t gpu_timer_cpu_begin[GPU_TIMER_FRAMES];
+	bool gpu_timer_pending[GPU_TIMER_FRAMES];
+	int gpu_timer_frame;
+	bool gpu_timer_started;
+
+	void _gpu_timer_begin_frame();
+	void _gpu_timer_end_frame();
+#endif
+
 public:
 	virtual RasterizerStorage *get_storage();
 	virtual RasterizerCanvas *get_canvas();
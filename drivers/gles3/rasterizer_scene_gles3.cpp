@@ -281,7 +281,7 @@ bool RasterizerSceneGLES3::_shadow_atlas_find_shadow(ShadowAtlas *shadow_atlas,
 	return false;
 }
 
-bool RasterizerSceneGLES3::shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version) {
+bool RasterizerSceneGLES3::shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version, uint64_t &r_drawn_version) {
 
 	ShadowAtlas *shadow_atlas = shadow_atlas_owner.getornull(p_atlas);
 	ERR_FAIL_COND_V(!shadow_atlas, false);
@@ -289,6 +289,8 @@ bool RasterizerSceneGLES3::shadow_atlas_update_light(RID p_atlas, RID p_light_in
 	LightInstance *li = light_instance_owner.getornull(p_light_intance);
 	ERR_FAIL_COND_V(!li, false);
 
+	r_drawn_version = 0; //nothing usable drawn yet, unless the current slot is kept
+
 	if (shadow_atlas->size == 0 || shadow_atlas->smallest_subdiv == 0) {
 		return false;
 	}
@@ -337,6 +339,7 @@ bool RasterizerSceneGLES3::shadow_atlas_update_light(RID p_atlas, RID p_light_in
 		bool should_redraw = shadow_atlas->quadrants[q].shadows[s].version != p_light_version;
 
 		if (!should_realloc) {
+			r_drawn_version = shadow_atlas->quadrants[q].shadows[s].version;
 			shadow_atlas->quadrants[q].shadows.write[s].version = p_light_version;
 			//already existing, see if it should redraw or it's just OK
 			return should_redraw;
@@ -377,6 +380,7 @@ bool RasterizerSceneGLES3::shadow_atlas_update_light(RID p_atlas, RID p_light_in
 
 		//already existing, see if it should redraw or it's just OK
 
+		r_drawn_version = shadow_atlas->quadrants[q].shadows[s].version;
 		shadow_atlas->quadrants[q].shadows.write[s].version = p_light_version;
 
 		return should_redraw;
@@ -586,6 +590,7 @@ RID RasterizerSceneGLES3::reflection_probe_instance_create(RID p_probe) {
 	rpi->reflection_atlas_index = -1;
 	rpi->render_step = -1;
 	rpi->last_pass = 0;
+	rpi->clustered = false;
 
 	return rpi->self;
 }
@@ -912,6 +917,24 @@ void RasterizerSceneGLES3::environment_set_ssao(RID p_env, bool p_enable, float
 	env->ssao_bilateral_sharpness = p_bilateral_sharpness;
 }
 
+void RasterizerSceneGLES3::environment_set_ssr_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal) {
+
+	Environment *env = environment_owner.getornull(p_env);
+	ERR_FAIL_COND(!env);
+
+	env->ssr_resolution = p_resolution;
+	env->ssr_temporal = p_temporal;
+}
+
+void RasterizerSceneGLES3::environment_set_ssao_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal) {
+
+	Environment *env = environment_owner.getornull(p_env);
+	ERR_FAIL_COND(!env);
+
+	env->ssao_resolution = p_resolution;
+	env->ssao_temporal = p_temporal;
+}
+
 void RasterizerSceneGLES3::environment_set_tonemap(RID p_env, VS::EnvironmentToneMapper p_tone_mapper, float p_exposure, float p_white, bool p_auto_exposure, float p_min_luminance, float p_max_luminance, float p_auto_exp_speed, float p_auto_exp_scale) {
 
 	Environment *env = environment_owner.getornull(p_env);
@@ -1000,6 +1023,7 @@ RID RasterizerSceneGLES3::light_instance_create(RID p_light) {
 	LightInstance *light_instance = memnew(LightInstance);
 
 	light_instance->last_pass = 0;
+	light_instance->clustered = false;
 	light_instance->last_scene_pass = 0;
 	light_instance->last_scene_shadow_pass = 0;
 
@@ -1311,6 +1335,31 @@ struct RasterizerGLES3ParticleSort {
 	}
 };
 
+void RasterizerSceneGLES3::_sort_particles_by_depth(InstanceBase **p_cull_result, int p_cull_count, const Transform &p_cam_transform) {
+
+	//sort before any pass draws them, histories are only read back when the GPU can't do it
+
+	for (int i = 0; i < p_cull_count; i++) {
+
+		InstanceBase *inst = p_cull_result[i];
+		if (inst->base_type != VS::INSTANCE_PARTICLES)
+			continue;
+
+		RasterizerStorageGLES3::Particles *particles = storage->particles_owner.getornull(inst->base);
+		if (!particles || particles->draw_order != VS::PARTICLES_DRAW_ORDER_VIEW_DEPTH || !particles->particle_sort_buffer || particles->inactive)
+			continue;
+
+		Vector3 sort_direction;
+		if (particles->use_local_coords) {
+			sort_direction = inst->transform.affine_inverse().basis.xform(p_cam_transform.basis.get_axis(2)).normalized();
+		} else {
+			sort_direction = p_cam_transform.basis.get_axis(2).normalized();
+		}
+
+		storage->particles_sort_by_depth(particles, sort_direction);
+	}
+}
+
 void RasterizerSceneGLES3::_setup_geometry(RenderList::Element *e, const Transform &p_view_transform) {
 
 	switch (e->instance->base_type) {
@@ -1421,7 +1470,20 @@ void RasterizerSceneGLES3::_setup_geometry(RenderList::Element *e, const Transfo
 			RasterizerStorageGLES3::Particles *particles = static_cast<RasterizerStorageGLES3::Particles *>(e->owner);
 			RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(e->geometry);
 
-			if (particles->draw_order == VS::PARTICLES_DRAW_ORDER_VIEW_DEPTH && particles->particle_valid_histories[1]) {
+			if (particles->draw_order == VS::PARTICLES_DRAW_ORDER_VIEW_DEPTH && particles->particle_sort_valid) {
+
+				//already sorted on the GPU for this view
+#ifdef DEBUG_ENABLED
+				if (state.debug_draw == VS::VIEWPORT_DEBUG_DRAW_WIREFRAME && s->instancing_array_wireframe_id) {
+					glBindVertexArray(s->instancing_array_wireframe_id); // use the wireframe instancing array ID
+				} else
+#endif
+				{
+					glBindVertexArray(s->instancing_array_id); // use the instancing array ID
+				}
+				glBindBuffer(GL_ARRAY_BUFFER, particles->particle_sort_buffer);
+
+			} else if (particles->draw_order == VS::PARTICLES_DRAW_ORDER_VIEW_DEPTH && particles->particle_valid_histories[1]) {
 
 				glBindBuffer(GL_ARRAY_BUFFER, particles->particle_buffer_histories[1]); //modify the buffer, this was used 2 frames ago so it should be good enough for flushing
 				RasterizerGLES3Particle *particle_array;
@@ -1518,7 +1580,7 @@ static const GLenum gl_primitive[] = {
 	GL_TRIANGLE_FAN
 };
 
-void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
+void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e, int p_instance_count) {
 
 	switch (e->instance->base_type) {
 
@@ -1526,6 +1588,32 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 
 			RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(e->geometry);
 
+			if (p_instance_count > 1) {
+				// several mesh instances batched together, see _setup_auto_instancing()
+#ifdef DEBUG_ENABLED
+
+				if (state.debug_draw == VS::VIEWPORT_DEBUG_DRAW_WIREFRAME && s->array_wireframe_id) {
+
+					glDrawElementsInstanced(GL_LINES, s->index_wireframe_len, GL_UNSIGNED_INT, 0, p_instance_count);
+					storage->info.render.vertices_count += s->index_array_len * p_instance_count;
+				} else
+#endif
+						if (s->index_array_len > 0) {
+
+					glDrawElementsInstanced(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0, p_instance_count);
+
+					storage->info.render.vertices_count += s->index_array_len * p_instance_count;
+
+				} else {
+
+					glDrawArraysInstanced(gl_primitive[s->primitive], 0, s->array_len, p_instance_count);
+
+					storage->info.render.vertices_count += s->array_len * p_instance_count;
+				}
+
+				break;
+			}
+
 #ifdef DEBUG_ENABLED
 
 			if (state.debug_draw == VS::VIEWPORT_DEBUG_DRAW_WIREFRAME && s->array_wireframe_id) {
@@ -1589,7 +1677,6 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				return;
 			}
 
-			glBindBuffer(GL_ARRAY_BUFFER, state.immediate_buffer);
 			glBindVertexArray(state.immediate_array);
 
 			for (const List<RasterizerStorageGLES3::Immediate::Chunk>::Element *E = im->chunks.front(); E; E = E->next()) {
@@ -1600,6 +1687,25 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				}
 
 				int vertices = c.vertices.size();
+
+				uint32_t buf_size = sizeof(Vector3) * vertices;
+				if (!c.normals.empty())
+					buf_size += sizeof(Vector3) * vertices;
+				if (!c.tangents.empty())
+					buf_size += sizeof(Plane) * vertices;
+				if (!c.colors.empty())
+					buf_size += sizeof(Color) * vertices;
+				if (!c.uvs.empty())
+					buf_size += sizeof(Vector2) * vertices;
+				if (!c.uvs2.empty())
+					buf_size += sizeof(Vector2) * vertices;
+
+				uint32_t stream_ofs = 0;
+				uint8_t *buffer = storage->stream_buffer_map(state.immediate_buffer, buf_size, 4, stream_ofs);
+				if (!buffer) {
+					continue;
+				}
+
 				uint32_t buf_ofs = 0;
 
 				storage->info.render.vertices_count += vertices;
@@ -1637,8 +1743,8 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				if (!c.normals.empty()) {
 
 					glEnableVertexAttribArray(VS::ARRAY_NORMAL);
-					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector3) * vertices, c.normals.ptr());
-					glVertexAttribPointer(VS::ARRAY_NORMAL, 3, GL_FLOAT, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					copymem(buffer + buf_ofs, c.normals.ptr(), sizeof(Vector3) * vertices);
+					glVertexAttribPointer(VS::ARRAY_NORMAL, 3, GL_FLOAT, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(stream_ofs + buf_ofs));
 					buf_ofs += sizeof(Vector3) * vertices;
 
 				} else {
@@ -1649,8 +1755,8 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				if (!c.tangents.empty()) {
 
 					glEnableVertexAttribArray(VS::ARRAY_TANGENT);
-					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Plane) * vertices, c.tangents.ptr());
-					glVertexAttribPointer(VS::ARRAY_TANGENT, 4, GL_FLOAT, false, sizeof(Plane), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					copymem(buffer + buf_ofs, c.tangents.ptr(), sizeof(Plane) * vertices);
+					glVertexAttribPointer(VS::ARRAY_TANGENT, 4, GL_FLOAT, false, sizeof(Plane), CAST_INT_TO_UCHAR_PTR(stream_ofs + buf_ofs));
 					buf_ofs += sizeof(Plane) * vertices;
 
 				} else {
@@ -1661,8 +1767,8 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				if (!c.colors.empty()) {
 
 					glEnableVertexAttribArray(VS::ARRAY_COLOR);
-					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Color) * vertices, c.colors.ptr());
-					glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					copymem(buffer + buf_ofs, c.colors.ptr(), sizeof(Color) * vertices);
+					glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(stream_ofs + buf_ofs));
 					buf_ofs += sizeof(Color) * vertices;
 
 				} else {
@@ -1674,8 +1780,8 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				if (!c.uvs.empty()) {
 
 					glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector2) * vertices, c.uvs.ptr());
-					glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					copymem(buffer + buf_ofs, c.uvs.ptr(), sizeof(Vector2) * vertices);
+					glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(stream_ofs + buf_ofs));
 					buf_ofs += sizeof(Vector2) * vertices;
 
 				} else {
@@ -1686,8 +1792,8 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				if (!c.uvs2.empty()) {
 
 					glEnableVertexAttribArray(VS::ARRAY_TEX_UV2);
-					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector2) * vertices, c.uvs2.ptr());
-					glVertexAttribPointer(VS::ARRAY_TEX_UV2, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					copymem(buffer + buf_ofs, c.uvs2.ptr(), sizeof(Vector2) * vertices);
+					glVertexAttribPointer(VS::ARRAY_TEX_UV2, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(stream_ofs + buf_ofs));
 					buf_ofs += sizeof(Vector2) * vertices;
 
 				} else {
@@ -1696,8 +1802,11 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				}
 
 				glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-				glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector3) * vertices, c.vertices.ptr());
-				glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+				copymem(buffer + buf_ofs, c.vertices.ptr(), sizeof(Vector3) * vertices);
+				glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(stream_ofs + buf_ofs));
+
+				storage->stream_buffer_unmap(state.immediate_buffer);
+
 				glDrawArrays(gl_primitive[c.primitive], 0, c.vertices.size());
 			}
 
@@ -1842,6 +1951,9 @@ void RasterizerSceneGLES3::_setup_light(RenderList::Element *e, const Transform
 
 	int maxobj = MIN(16, state.max_forward_lights_per_object);
 
+	//clustered lights are looked up per pixel, vertex lighting still needs all of them here
+	bool clustered_lights = cluster.active && !(e->sort_key & SORT_KEY_VERTEX_LIT_FLAG);
+
 	int lc = e->instance->light_instances.size();
 	if (lc) {
 
@@ -1852,6 +1964,9 @@ void RasterizerSceneGLES3::_setup_light(RenderList::Element *e, const Transform
 			if (!li || li->last_pass != render_pass) //not visible
 				continue;
 
+			if (clustered_lights && li->clustered)
+				continue;
+
 			if (li && li->light_ptr->type == VS::LIGHT_OMNI) {
 				if (omni_count < maxobj && e->instance->layer_mask & li->light_ptr->cull_mask) {
 					omni_indices[omni_count++] = li->light_index;
@@ -1888,6 +2003,9 @@ void RasterizerSceneGLES3::_setup_light(RenderList::Element *e, const Transform
 			if (rpi->last_pass != render_pass) //not visible
 				continue;
 
+			if (cluster.active && rpi->clustered)
+				continue;
+
 			if (reflection_count < maxobj) {
 				reflection_indices[reflection_count++] = rpi->reflection_index;
 			}
@@ -1972,13 +2090,132 @@ void RasterizerSceneGLES3::_set_cull(bool p_front, bool p_disabled, bool p_rever
 	}
 }
 
+bool RasterizerSceneGLES3::_can_auto_instance(RenderList::Element *e) const {
+
+	if (e->instance->base_type != VS::INSTANCE_MESH || e->instance->skeleton.is_valid()) {
+		return false;
+	}
+
+	RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(e->geometry);
+
+	if (s->blend_shapes.size() && e->instance->blend_values.size()) {
+		return false; //blend shapes go through transform feedback
+	}
+
+	const RasterizerStorageGLES3::Shader *shader = e->material->shader;
+
+	// these would read the batch transform (or instance index) instead of the one of each mesh
+	return !shader->spatial.writes_modelview_or_projection && !shader->spatial.uses_world_matrix && !shader->spatial.uses_instance_id;
+}
+
+static _FORCE_INLINE_ bool _rid_vectors_equal(const Vector<RID> &p_a, const Vector<RID> &p_b) {
+
+	int size = p_a.size();
+	if (size != p_b.size()) {
+		return false;
+	}
+
+	const RID *a = p_a.ptr();
+	const RID *b = p_b.ptr();
+	for (int i = 0; i < size; i++) {
+		if (a[i] != b[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool RasterizerSceneGLES3::_can_share_instanced_draw(RenderList::Element *a, RenderList::Element *b, bool p_lit) const {
+
+	if (a->geometry != b->geometry || a->material != b->material || a->owner != b->owner || a->sort_key != b->sort_key) {
+		return false;
+	}
+
+	if (a->instance->layer_mask != b->instance->layer_mask || !_can_auto_instance(b)) {
+		return false;
+	}
+
+	if (!p_lit) {
+		return true;
+	}
+
+	// everything _setup_light() sends must be the same for the whole batch
+	const InstanceBase *ia = a->instance;
+	const InstanceBase *ib = b->instance;
+
+	if (ia->gi_probe_instances.size() || ib->gi_probe_instances.size() || ia->lightmap.is_valid() || ib->lightmap.is_valid() || !ia->lightmap_capture_data.empty() || !ib->lightmap_capture_data.empty()) {
+		return false;
+	}
+
+	return _rid_vectors_equal(ia->light_instances, ib->light_instances) && _rid_vectors_equal(ia->reflection_probe_instances, ib->reflection_probe_instances);
+}
+
+void RasterizerSceneGLES3::_setup_auto_instancing(RenderList::Element **p_elements, int p_instance_count) {
+
+	RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(p_elements[0]->geometry);
+
+#ifdef DEBUG_ENABLED
+	if (state.debug_draw == VS::VIEWPORT_DEBUG_DRAW_WIREFRAME && s->instancing_array_wireframe_id) {
+
+		glBindVertexArray(s->instancing_array_wireframe_id); // use the wireframe instancing array ID
+	} else
+#endif
+	{
+		glBindVertexArray(s->instancing_array_id); // use the instancing array ID
+	}
+
+	// same layout as a MultiMesh using MULTIMESH_TRANSFORM_3D
+	float *data = state.auto_instance_transforms;
+
+	for (int i = 0; i < p_instance_count; i++) {
+
+		const Transform &xform = p_elements[i]->instance->transform;
+
+		data[0] = xform.basis.elements[0][0];
+		data[1] = xform.basis.elements[0][1];
+		data[2] = xform.basis.elements[0][2];
+		data[3] = xform.origin.x;
+		data[4] = xform.basis.elements[1][0];
+		data[5] = xform.basis.elements[1][1];
+		data[6] = xform.basis.elements[1][2];
+		data[7] = xform.origin.y;
+		data[8] = xform.basis.elements[2][0];
+		data[9] = xform.basis.elements[2][1];
+		data[10] = xform.basis.elements[2][2];
+		data[11] = xform.origin.z;
+
+		data += 12;
+	}
+
+	uint32_t buffer_ofs = storage->stream_buffer_upload(state.auto_instance_buffer, state.auto_instance_transforms, sizeof(float) * 12 * p_instance_count);
+
+	int stride = sizeof(float) * 12;
+
+	glEnableVertexAttribArray(8);
+	glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, stride, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+	glVertexAttribDivisor(8, 1);
+	glEnableVertexAttribArray(9);
+	glVertexAttribPointer(9, 4, GL_FLOAT, GL_FALSE, stride, CAST_INT_TO_UCHAR_PTR(buffer_ofs + 4 * 4));
+	glVertexAttribDivisor(9, 1);
+	glEnableVertexAttribArray(10);
+	glVertexAttribPointer(10, 4, GL_FLOAT, GL_FALSE, stride, CAST_INT_TO_UCHAR_PTR(buffer_ofs + 8 * 4));
+	glVertexAttribDivisor(10, 1);
+
+	//match what a regular mesh gets
+	glDisableVertexAttribArray(11);
+	glVertexAttrib4f(11, 1, 1, 1, 1);
+	glDisableVertexAttribArray(12);
+	glVertexAttrib4f(12, 0, 0, 0, 0);
+}
+
 void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_element_count, const Transform &p_view_transform, const CameraMatrix &p_projection, RasterizerStorageGLES3::Sky *p_sky, bool p_reverse_cull, bool p_alpha_pass, bool p_shadow, bool p_directional_add, bool p_directional_shadows) {
 
-	glBindBufferBase(GL_UNIFORM_BUFFER, 0, state.scene_ubo); //bind globals ubo
+	glBindBufferRange(GL_UNIFORM_BUFFER, 0, state.scene_ubo->id, state.scene_ubo_offset, sizeof(State::SceneDataUBO)); //bind globals ubo
 
 	bool use_radiance_map = false;
 	if (!p_shadow && !p_directional_add) {
-		glBindBufferBase(GL_UNIFORM_BUFFER, 2, state.env_radiance_ubo); //bind environment radiance info
+		glBindBufferRange(GL_UNIFORM_BUFFER, 2, state.env_radiance_ubo->id, state.env_radiance_ubo_offset, sizeof(State::EnvironmentRadianceUBO)); //bind environment radiance info
 
 		if (p_sky != NULL) {
 			glActiveTexture(GL_TEXTURE0 + storage->config.max_texture_image_units - 2);
@@ -2030,6 +2267,7 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 
 	bool first = true;
 	bool prev_use_instancing = false;
+	bool prev_auto_instanced = false;
 
 	storage->info.render.draw_call_count += p_element_count;
 	bool prev_opaque_prepass = false;
@@ -2063,6 +2301,7 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 
 					state.scene_shader.set_conditional(SceneShaderGLES3::SHADELESS, true);
 					state.scene_shader.set_conditional(SceneShaderGLES3::USE_FORWARD_LIGHTING, false);
+					state.scene_shader.set_conditional(SceneShaderGLES3::USE_CLUSTERED_LIGHTING, false);
 					state.scene_shader.set_conditional(SceneShaderGLES3::USE_VERTEX_LIGHTING, false);
 					state.scene_shader.set_conditional(SceneShaderGLES3::USE_LIGHT_DIRECTIONAL, false);
 					state.scene_shader.set_conditional(SceneShaderGLES3::LIGHT_DIRECTIONAL_SHADOW, false);
@@ -2088,6 +2327,7 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 					state.scene_shader.set_conditional(SceneShaderGLES3::SHADELESS, false);
 
 					state.scene_shader.set_conditional(SceneShaderGLES3::USE_FORWARD_LIGHTING, !p_directional_add);
+					state.scene_shader.set_conditional(SceneShaderGLES3::USE_CLUSTERED_LIGHTING, !p_directional_add && cluster.active);
 					state.scene_shader.set_conditional(SceneShaderGLES3::USE_VERTEX_LIGHTING, (e->sort_key & SORT_KEY_VERTEX_LIT_FLAG));
 
 					state.scene_shader.set_conditional(SceneShaderGLES3::USE_LIGHT_DIRECTIONAL, false);
@@ -2173,6 +2413,19 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 			}
 		}
 
+		bool lit = !(e->sort_key & SORT_KEY_UNSHADED_FLAG) && !p_directional_add && !p_shadow;
+
+		// identical consecutive meshes are drawn with a single instanced call
+		int instance_count = 1;
+
+		if (state.use_auto_instancing && _can_auto_instance(e)) {
+			while (i + instance_count < p_element_count && instance_count < MAX_AUTO_INSTANCES && _can_share_instanced_draw(e, p_elements[i + instance_count], lit)) {
+				instance_count++;
+			}
+		}
+
+		bool auto_instanced = instance_count > 1;
+
 		bool use_opaque_prepass = e->sort_key & RenderList::SORT_KEY_OPAQUE_PRE_PASS;
 
 		if (use_opaque_prepass != prev_opaque_prepass) {
@@ -2180,7 +2433,7 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 			rebind = true;
 		}
 
-		bool use_instancing = e->instance->base_type == VS::INSTANCE_MULTIMESH || e->instance->base_type == VS::INSTANCE_PARTICLES;
+		bool use_instancing = auto_instanced || e->instance->base_type == VS::INSTANCE_MULTIMESH || e->instance->base_type == VS::INSTANCE_PARTICLES;
 
 		if (use_instancing != prev_use_instancing) {
 			state.scene_shader.set_conditional(SceneShaderGLES3::USE_INSTANCING, use_instancing);
@@ -2207,14 +2460,23 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 
 			if (rebind) {
 				storage->info.render.shader_rebind_count++;
+
+				if (lit && cluster.active) {
+					state.scene_shader.set_uniform(SceneShaderGLES3::CLUSTER_XY_PARAMS, cluster.xy_params[0], cluster.xy_params[1], cluster.xy_params[2], cluster.xy_params[3]);
+					state.scene_shader.set_uniform(SceneShaderGLES3::CLUSTER_Z_PARAMS, cluster.z_params[0], cluster.z_params[1], cluster.z_params[2], cluster.z_params[3]);
+				}
 			}
 		}
 
-		if (!(e->sort_key & SORT_KEY_UNSHADED_FLAG) && !p_directional_add && !p_shadow) {
+		if (lit) {
 			_setup_light(e, p_view_transform);
 		}
 
-		if (e->owner != prev_owner || prev_base_type != e->instance->base_type || prev_geometry != e->geometry) {
+		if (auto_instanced) {
+
+			_setup_auto_instancing(&p_elements[i], instance_count);
+			storage->info.render.surface_switch_count++;
+		} else if (prev_auto_instanced || e->owner != prev_owner || prev_base_type != e->instance->base_type || prev_geometry != e->geometry) {
 
 			_setup_geometry(e, p_view_transform);
 			storage->info.render.surface_switch_count++;
@@ -2222,9 +2484,14 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 
 		_set_cull(e->sort_key & RenderList::SORT_KEY_MIRROR_FLAG, e->sort_key & RenderList::SORT_KEY_CULL_DISABLED_FLAG, p_reverse_cull);
 
-		state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, e->instance->transform);
+		state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, auto_instanced ? Transform() : e->instance->transform);
+
+		_render_geometry(e, instance_count);
 
-		_render_geometry(e);
+		if (auto_instanced) {
+			storage->info.render.draw_call_count -= instance_count - 1;
+			i += instance_count - 1;
+		}
 
 		prev_material = material;
 		prev_base_type = e->instance->base_type;
@@ -2233,6 +2500,7 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 		prev_shading = shading;
 		prev_skeleton = skeleton;
 		prev_use_instancing = use_instancing;
+		prev_auto_instanced = auto_instanced;
 		prev_opaque_prepass = use_opaque_prepass;
 		first = false;
 	}
@@ -2243,6 +2511,7 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_SKELETON, false);
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_RADIANCE_MAP, false);
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_FORWARD_LIGHTING, false);
+	state.scene_shader.set_conditional(SceneShaderGLES3::USE_CLUSTERED_LIGHTING, false);
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_LIGHT_DIRECTIONAL, false);
 	state.scene_shader.set_conditional(SceneShaderGLES3::LIGHT_DIRECTIONAL_SHADOW, false);
 	state.scene_shader.set_conditional(SceneShaderGLES3::LIGHT_USE_PSSM4, false);
@@ -2651,16 +2920,14 @@ void RasterizerSceneGLES3::_setup_environment(Environment *env, const CameraMatr
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LESS);
 	}
 
-	glBindBuffer(GL_UNIFORM_BUFFER, state.scene_ubo);
-	glBufferData(GL_UNIFORM_BUFFER, sizeof(State::SceneDataUBO), &state.ubo_data, GL_DYNAMIC_DRAW);
+	state.scene_ubo_offset = storage->stream_buffer_upload(state.scene_ubo, &state.ubo_data, sizeof(State::SceneDataUBO), storage->config.uniform_buffer_offset_alignment);
 	glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
 	//fill up environment
 
 	store_transform(sky_orientation * p_cam_transform, state.env_radiance_data.transform);
 
-	glBindBuffer(GL_UNIFORM_BUFFER, state.env_radiance_ubo);
-	glBufferData(GL_UNIFORM_BUFFER, sizeof(State::EnvironmentRadianceUBO), &state.env_radiance_data, GL_DYNAMIC_DRAW);
+	state.env_radiance_ubo_offset = storage->stream_buffer_upload(state.env_radiance_ubo, &state.env_radiance_data, sizeof(State::EnvironmentRadianceUBO), storage->config.uniform_buffer_offset_alignment);
 	glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
@@ -3079,6 +3346,173 @@ void RasterizerSceneGLES3::_setup_reflections(RID *p_reflection_probe_cull_resul
 	glBindBufferBase(GL_UNIFORM_BUFFER, 6, state.reflection_array_ubo);
 }
 
+void RasterizerSceneGLES3::_cluster_add_item(const AABB &p_view_aabb, ClusterItemType p_type, uint16_t p_index, const CameraMatrix &p_camera_projection) {
+
+	//view space looks towards -Z
+	float depth_min = -(p_view_aabb.position.z + p_view_aabb.size.z);
+	float depth_max = -p_view_aabb.position.z;
+
+	if (depth_max < cluster.z_near || depth_min > cluster.z_far) {
+		return; //outside of the depth range
+	}
+
+	int from_x = 0;
+	int from_y = 0;
+	int to_x = CLUSTER_COUNT_X - 1;
+	int to_y = CLUSTER_COUNT_Y - 1;
+
+	if (depth_min > cluster.z_near) {
+		//fully in front of the near plane, so the projected corners bound it on screen
+		Vector2 screen_min(1e20, 1e20);
+		Vector2 screen_max(-1e20, -1e20);
+
+		for (int i = 0; i < 8; i++) {
+			Vector3 ndc = p_camera_projection.xform(p_view_aabb.get_endpoint(i));
+			screen_min.x = MIN(screen_min.x, ndc.x);
+			screen_min.y = MIN(screen_min.y, ndc.y);
+			screen_max.x = MAX(screen_max.x, ndc.x);
+			screen_max.y = MAX(screen_max.y, ndc.y);
+		}
+
+		if (screen_max.x < -1.0 || screen_max.y < -1.0 || screen_min.x > 1.0 || screen_min.y > 1.0) {
+			return;
+		}
+
+		from_x = CLAMP(int(Math::floor((screen_min.x * 0.5 + 0.5) * CLUSTER_COUNT_X)), 0, CLUSTER_COUNT_X - 1);
+		from_y = CLAMP(int(Math::floor((screen_min.y * 0.5 + 0.5) * CLUSTER_COUNT_Y)), 0, CLUSTER_COUNT_Y - 1);
+		to_x = CLAMP(int(Math::floor((screen_max.x * 0.5 + 0.5) * CLUSTER_COUNT_X)), 0, CLUSTER_COUNT_X - 1);
+		to_y = CLAMP(int(Math::floor((screen_max.y * 0.5 + 0.5) * CLUSTER_COUNT_Y)), 0, CLUSTER_COUNT_Y - 1);
+	}
+
+	depth_min = MAX(depth_min, cluster.z_near);
+	depth_max = MIN(depth_max, cluster.z_far);
+
+	if (cluster.z_log) {
+		depth_min = Math::log(depth_min);
+		depth_max = Math::log(depth_max);
+	}
+
+	int from_z = CLAMP(int(Math::floor(depth_min * cluster.z_params[0] + cluster.z_params[1])), 0, CLUSTER_COUNT_Z - 1);
+	int to_z = CLAMP(int(Math::floor(depth_max * cluster.z_params[0] + cluster.z_params[1])), 0, CLUSTER_COUNT_Z - 1);
+
+	for (int z = from_z; z <= to_z; z++) {
+		for (int y = from_y; y <= to_y; y++) {
+			for (int x = from_x; x <= to_x; x++) {
+
+				int list = ((z * CLUSTER_COUNT_Y + y) * CLUSTER_COUNT_X + x) * CLUSTER_ITEM_MAX + p_type;
+				uint8_t &count = cluster.item_counts[list];
+
+				if (count < CLUSTER_MAX_ITEMS) {
+					cluster.items[list * CLUSTER_MAX_ITEMS + count] = p_index;
+					count++;
+				}
+			}
+		}
+	}
+}
+
+void RasterizerSceneGLES3::_setup_clusters(RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, const Transform &p_camera_inverse_transform, const CameraMatrix &p_camera_projection, bool p_camera_ortogonal, const Size2i &p_viewport_size) {
+
+	cluster.active = cluster.enabled && p_viewport_size.width > 0 && p_viewport_size.height > 0;
+
+	if (!cluster.active) {
+		return;
+	}
+
+	zeromem(cluster.item_counts, CLUSTER_COUNT * CLUSTER_ITEM_MAX);
+
+	cluster.z_near = MAX(0.001, p_camera_projection.get_z_near());
+	cluster.z_far = MAX(cluster.z_near + 0.001, p_camera_projection.get_z_far());
+	cluster.z_log = !p_camera_ortogonal;
+
+	//slices are distributed logarithmically for perspective, so they keep a similar aspect ratio
+	if (cluster.z_log) {
+		cluster.z_params[0] = CLUSTER_COUNT_Z / Math::log(cluster.z_far / cluster.z_near);
+		cluster.z_params[1] = -Math::log(cluster.z_near) * cluster.z_params[0];
+	} else {
+		cluster.z_params[0] = CLUSTER_COUNT_Z / (cluster.z_far - cluster.z_near);
+		cluster.z_params[1] = -cluster.z_near * cluster.z_params[0];
+	}
+	cluster.z_params[2] = CLUSTER_COUNT_Z;
+	cluster.z_params[3] = cluster.z_log ? 1.0 : 0.0;
+
+	cluster.xy_params[0] = float(CLUSTER_COUNT_X) / p_viewport_size.width;
+	cluster.xy_params[1] = float(CLUSTER_COUNT_Y) / p_viewport_size.height;
+	cluster.xy_params[2] = CLUSTER_COUNT_X;
+	cluster.xy_params[3] = CLUSTER_COUNT_Y;
+
+	for (int i = 0; i < p_light_cull_count; i++) {
+
+		LightInstance *li = light_instance_owner.getptr(p_light_cull_result[i]);
+		li->clustered = false;
+
+		if (li->last_pass != render_pass || li->light_ptr->type == VS::LIGHT_DIRECTIONAL) {
+			continue;
+		}
+
+		//lights affecting only some layers must be filtered per object
+		if ((li->light_ptr->cull_mask & 0xFFFFF) != 0xFFFFF) {
+			continue;
+		}
+
+		//spot lights use the bounding sphere of their range, which is conservative but cheap
+		float radius = li->light_ptr->param[VS::LIGHT_PARAM_RANGE];
+		Vector3 pos = p_camera_inverse_transform.xform(li->transform.origin);
+		AABB aabb(pos - Vector3(radius, radius, radius), Vector3(radius, radius, radius) * 2.0);
+
+		_cluster_add_item(aabb, li->light_ptr->type == VS::LIGHT_OMNI ? CLUSTER_ITEM_OMNI : CLUSTER_ITEM_SPOT, li->light_index, p_camera_projection);
+		li->clustered = true;
+	}
+
+	for (int i = 0; i < p_reflection_probe_cull_count; i++) {
+
+		ReflectionProbeInstance *rpi = reflection_probe_instance_owner.getornull(p_reflection_probe_cull_result[i]);
+		if (!rpi) {
+			continue;
+		}
+		rpi->clustered = false;
+
+		if (rpi->last_pass != render_pass || (rpi->probe_ptr->cull_mask & 0xFFFFF) != 0xFFFFF) {
+			continue;
+		}
+
+		Vector3 extents = rpi->probe_ptr->extents;
+		AABB aabb = (p_camera_inverse_transform * rpi->transform).xform(AABB(-extents, extents * 2.0));
+
+		_cluster_add_item(aabb, CLUSTER_ITEM_REFLECTION, rpi->reflection_index, p_camera_projection);
+		rpi->clustered = true;
+	}
+
+	//pack the headers first, then every non empty item list after them
+	uint32_t item_pos = CLUSTER_COUNT * 4;
+
+	for (int i = 0; i < CLUSTER_COUNT; i++) {
+
+		uint32_t *header = &cluster.texture_data[i * 4];
+		header[0] = item_pos;
+
+		for (int j = 0; j < CLUSTER_ITEM_MAX; j++) {
+
+			int list = i * CLUSTER_ITEM_MAX + j;
+			int count = cluster.item_counts[list];
+			const uint16_t *items = &cluster.items[list * CLUSTER_MAX_ITEMS];
+
+			for (int k = 0; k < count; k++) {
+				cluster.texture_data[item_pos++] = items[k];
+			}
+
+			header[j + 1] = count;
+		}
+	}
+
+	int used_texels = (item_pos + 3) / 4;
+	int used_rows = MIN((used_texels + CLUSTER_TEXTURE_WIDTH - 1) / CLUSTER_TEXTURE_WIDTH, cluster.texture_height);
+
+	glActiveTexture(GL_TEXTURE0 + storage->config.max_texture_image_units - 11);
+	glBindTexture(GL_TEXTURE_2D, cluster.texture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, CLUSTER_TEXTURE_WIDTH, used_rows, GL_RGBA_INTEGER, GL_UNSIGNED_INT, cluster.texture_data);
+}
+
 void RasterizerSceneGLES3::_copy_screen(bool p_invalidate_color, bool p_invalidate_depth) {
 
 #ifndef GLES_OVER_GL
@@ -3125,6 +3559,85 @@ void RasterizerSceneGLES3::_copy_texture_to_front_buffer(GLuint p_texture) {
 	storage->shaders.copy.set_conditional(CopyShaderGLES3::DISABLE_ALPHA, false);
 }
 
+void RasterizerSceneGLES3::_update_texture_stream_requirements(const CameraMatrix &p_cam_projection, bool p_cam_ortogonal) {
+
+	//estimate how many pixels each drawn surface covers on screen, streamed textures in its material
+	//need the mipmap where a texel is about a pixel
+	float viewport_height = storage->frame.current_rt ? storage->frame.current_rt->height : 1;
+	float pixels_per_unit = 0.5 * viewport_height * p_cam_projection.matrix[1][1];
+	float z_near = p_cam_projection.get_z_near();
+
+	for (int i = 0; i < render_list.max_elements; i++) {
+
+		if (i == render_list.element_count) {
+			//skip to the alpha elements, which are stored at the end
+			i = render_list.max_elements - render_list.alpha_element_count;
+			if (i >= render_list.max_elements) {
+				break;
+			}
+		}
+
+		RenderList::Element *e = render_list.elements[i];
+		if (!e->material->textures.size()) {
+			continue;
+		}
+
+		float pixels = 0;
+		if (e->geometry->type == RasterizerStorageGLES3::Geometry::GEOMETRY_SURFACE) {
+			const RasterizerStorageGLES3::Surface *s = static_cast<const RasterizerStorageGLES3::Surface *>(e->geometry);
+			Vector3 scale = e->instance->transform.basis.get_scale().abs();
+			float size = s->aabb.get_longest_axis_size() * MAX(scale.x, MAX(scale.y, scale.z));
+			float distance = p_cam_ortogonal ? 1.0 : MAX(e->instance->depth, z_near);
+			pixels = size * pixels_per_unit / distance;
+		}
+
+		const RID *textures = e->material->textures.ptr();
+		for (int j = 0; j < e->material->textures.size(); j++) {
+
+			RasterizerStorageGLES3::Texture *t = storage->texture_owner.getornull(textures[j]);
+			if (!t || !t->stream_callback) {
+				continue;
+			}
+
+			//geometry of unknown size keeps the whole chain
+			int mipmap = 0;
+			if (pixels > 0) {
+				int texture_size = MAX(t->alloc_width, t->alloc_height);
+				while ((texture_size >> (mipmap + 1)) >= pixels && (texture_size >> (mipmap + 1)) > 0) {
+					mipmap++;
+				}
+			}
+
+			storage->texture_stream_require_mipmap(t, mipmap);
+		}
+	}
+}
+
+RasterizerStorageGLES3::Surface *RasterizerSceneGLES3::_get_surface_lod(RasterizerStorageGLES3::Surface *p_surface, const InstanceBase *p_instance, float p_scale) const {
+
+	float pixels_per_unit = state.lod_pixels_per_unit * p_scale;
+
+	if (!state.lod_orthogonal) {
+		//distance to a sphere around the instance origin that contains the surface
+		const AABB &aabb = p_surface->aabb;
+		float radius = ((aabb.position + aabb.size * 0.5).length() + aabb.size.length() * 0.5) * p_scale;
+		float distance = p_instance->depth - radius;
+		if (distance <= 0.0) {
+			return p_surface;
+		}
+		pixels_per_unit /= distance;
+	}
+
+	//coarsest level whose error stays under the threshold on screen
+	for (int i = p_surface->lods.size() - 1; i >= 0; i--) {
+		if (p_surface->lods[i].edge_length * pixels_per_unit < state.lod_threshold) {
+			return p_surface->lods[i].surface;
+		}
+	}
+
+	return p_surface;
+}
+
 void RasterizerSceneGLES3::_fill_render_list(InstanceBase **p_cull_result, int p_cull_count, bool p_depth_pass, bool p_shadow_pass) {
 
 	current_geometry_index = 0;
@@ -3146,11 +3659,21 @@ void RasterizerSceneGLES3::_fill_render_list(InstanceBase **p_cull_result, int p
 				ERR_CONTINUE(!mesh);
 
 				int ssize = mesh->surfaces.size();
+				float lod_scale = -1.0;
 
 				for (int j = 0; j < ssize; j++) {
 
 					int mat_idx = inst->materials[j].is_valid() ? j : -1;
 					RasterizerStorageGLES3::Surface *s = mesh->surfaces[j];
+
+					if (s->lods.size() && state.lod_pixels_per_unit > 0.0) {
+						if (lod_scale < 0.0) {
+							Vector3 scale = inst->transform.basis.get_scale();
+							lod_scale = MAX(scale.x, MAX(scale.y, scale.z));
+						}
+						s = _get_surface_lod(s, inst, lod_scale);
+					}
+
 					_add_geometry(s, inst, NULL, mat_idx, p_depth_pass, p_shadow_pass);
 				}
 
@@ -3272,7 +3795,38 @@ void RasterizerSceneGLES3::_bind_depth_texture() {
 	}
 }
 
-void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_cam_projection) {
+GLuint RasterizerSceneGLES3::_temporal_accumulate(RasterizerStorageGLES3::RenderTarget::Effects::Scaled &r_scaled, GLuint p_source, const CameraMatrix &p_view_projection) {
+
+	//history is only usable if it was rendered on the previous frame, anything older is likely from another view
+	bool history_valid = r_scaled.history_frame != 0 && storage->frame.count - r_scaled.history_frame <= 1;
+
+	int prev = r_scaled.current_history;
+	int dst = 1 - prev;
+
+	state.temporal_shader.bind();
+	state.temporal_shader.set_uniform(TemporalReprojectionShaderGLES3::REPROJECTION, r_scaled.history_view_projection * p_view_projection.inverse());
+	state.temporal_shader.set_uniform(TemporalReprojectionShaderGLES3::BLEND, history_valid ? 0.1f : 1.0f);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, p_source);
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, r_scaled.history[prev]);
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, r_scaled.history_fbo[dst]);
+	glViewport(0, 0, r_scaled.width, r_scaled.height);
+
+	_copy_screen(true);
+
+	r_scaled.current_history = dst;
+	r_scaled.history_frame = storage->frame.count;
+	r_scaled.history_view_projection = p_view_projection;
+
+	return r_scaled.history[dst];
+}
+
+void RasterizerSceneGLES3::_render_mrts(Environment *env, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection) {
 
 	glDepthMask(GL_FALSE);
 	glDisable(GL_DEPTH_TEST);
@@ -3281,6 +3835,8 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 
 	_prepare_depth_texture();
 
+	CameraMatrix view_projection = p_cam_projection * CameraMatrix(p_cam_transform.affine_inverse());
+
 	if (env->ssao_enabled || env->ssr_enabled) {
 
 		//copy normal and roughness to effect buffer
@@ -3332,10 +3888,31 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		ss[0] = storage->frame.current_rt->width;
 		ss[1] = storage->frame.current_rt->height;
 
-		glViewport(0, 0, ss[0], ss[1]);
+		int ao_shift = int(env->ssao_resolution);
+		bool ao_scaled = ao_shift > 0 || env->ssao_temporal;
+		RasterizerStorageGLES3::RenderTarget::Effects::Scaled &ao_target = storage->frame.current_rt->effects.ssao_scaled;
 
-		glEnable(GL_DEPTH_TEST);
-		glDepthFunc(GL_GREATER);
+		if (ao_scaled) {
+			bool hf = storage->config.framebuffer_half_float_supported;
+			if (!storage->_render_target_update_scaled(ao_target, ss[0] >> ao_shift, ss[1] >> ao_shift, hf ? GL_R16F : GL_R8, GL_RED, hf ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE)) {
+				ao_shift = 0;
+				ao_scaled = false;
+			}
+		}
+
+		//projection info is always computed for the full resolution, the shader maps its pixels back to it
+		GLint ao_ss[2] = { ss[0], ss[1] };
+		if (ao_shift > 0) {
+			ao_ss[0] = ao_target.width;
+			ao_ss[1] = ao_target.height;
+		}
+
+		glViewport(0, 0, ao_ss[0], ao_ss[1]);
+
+		if (ao_shift == 0) {
+			glEnable(GL_DEPTH_TEST);
+			glDepthFunc(GL_GREATER);
+		}
 		// do SSAO!
 		state.ssao_shader.set_conditional(SsaoShaderGLES3::ENABLE_RADIUS2, env->ssao_radius2 > 0.001);
 		state.ssao_shader.set_conditional(SsaoShaderGLES3::USE_ORTHOGONAL_PROJECTION, p_cam_projection.is_orthogonal());
@@ -3345,6 +3922,7 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		state.ssao_shader.set_uniform(SsaoShaderGLES3::CAMERA_Z_FAR, p_cam_projection.get_z_far());
 		state.ssao_shader.set_uniform(SsaoShaderGLES3::CAMERA_Z_NEAR, p_cam_projection.get_z_near());
 		glUniform2iv(state.ssao_shader.get_uniform(SsaoShaderGLES3::SCREEN_SIZE), 1, ss);
+		state.ssao_shader.set_uniform(SsaoShaderGLES3::RESOLUTION_SHIFT, ao_shift);
 		float radius = env->ssao_radius;
 		state.ssao_shader.set_uniform(SsaoShaderGLES3::RADIUS, radius);
 		float intensity = env->ssao_intensity;
@@ -3378,7 +3956,17 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->buffers.effect);
 
-		glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.ssao.blur_fbo[0]); //copy to front first
+		//at reduced resolution there is no matching depth attachment, so the sky is not skipped and every texel is written
+		GLuint ao_fbo[2] = { storage->frame.current_rt->effects.ssao.blur_fbo[0], storage->frame.current_rt->effects.ssao.blur_fbo[1] };
+		GLuint ao_tex[2] = { storage->frame.current_rt->effects.ssao.blur_red[0], storage->frame.current_rt->effects.ssao.blur_red[1] };
+		if (ao_shift > 0) {
+			ao_fbo[0] = ao_target.fbo[0];
+			ao_fbo[1] = ao_target.fbo[1];
+			ao_tex[0] = ao_target.color[0];
+			ao_tex[1] = ao_target.color[1];
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, ao_fbo[0]); //copy to front first
 		Color white(1, 1, 1, 1);
 		glClearBufferfv(GL_COLOR, 0, white.components); // specular
 
@@ -3395,18 +3983,19 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 				state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::CAMERA_Z_NEAR, p_cam_projection.get_z_near());
 				state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::EDGE_SHARPNESS, env->ssao_bilateral_sharpness);
 				state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::FILTER_SCALE, int(env->ssao_filter));
+				state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::RESOLUTION_SHIFT, ao_shift);
 
 				GLint axis[2] = { i, 1 - i };
 				glUniform2iv(state.ssao_blur_shader.get_uniform(SsaoBlurShaderGLES3::AXIS), 1, axis);
-				glUniform2iv(state.ssao_blur_shader.get_uniform(SsaoBlurShaderGLES3::SCREEN_SIZE), 1, ss);
+				glUniform2iv(state.ssao_blur_shader.get_uniform(SsaoBlurShaderGLES3::SCREEN_SIZE), 1, ao_ss);
 
 				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->effects.ssao.blur_red[i]);
+				glBindTexture(GL_TEXTURE_2D, ao_tex[i]);
 				glActiveTexture(GL_TEXTURE1);
 				glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
 				glActiveTexture(GL_TEXTURE2);
 				glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->buffers.effect);
-				glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.ssao.blur_fbo[1 - i]);
+				glBindFramebuffer(GL_FRAMEBUFFER, ao_fbo[1 - i]);
 				if (i == 0) {
 					glClearBufferfv(GL_COLOR, 0, white.components); // specular
 				}
@@ -3417,6 +4006,47 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		glDisable(GL_DEPTH_TEST);
 		glDepthFunc(GL_LEQUAL);
 
+		GLuint ao_result = ao_tex[0];
+
+		if (ao_scaled) {
+
+			if (env->ssao_temporal) {
+				ao_result = _temporal_accumulate(ao_target, ao_result, view_projection);
+			}
+
+			if (ao_shift > 0) {
+				//bring it back to full resolution, following depth edges
+				glViewport(0, 0, ss[0], ss[1]);
+				glEnable(GL_DEPTH_TEST);
+				glDepthFunc(GL_GREATER);
+
+				state.ssao_blur_shader.set_conditional(SsaoBlurShaderGLES3::USE_UPSCALE, true);
+				state.ssao_blur_shader.bind();
+				state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::CAMERA_Z_FAR, p_cam_projection.get_z_far());
+				state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::CAMERA_Z_NEAR, p_cam_projection.get_z_near());
+				state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::EDGE_SHARPNESS, env->ssao_bilateral_sharpness);
+				state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::RESOLUTION_SHIFT, ao_shift);
+				glUniform2iv(state.ssao_blur_shader.get_uniform(SsaoBlurShaderGLES3::SCREEN_SIZE), 1, ao_ss);
+
+				glActiveTexture(GL_TEXTURE0);
+				glBindTexture(GL_TEXTURE_2D, ao_result);
+				glActiveTexture(GL_TEXTURE1);
+				glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
+
+				glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.ssao.blur_fbo[0]);
+				glClearBufferfv(GL_COLOR, 0, white.components);
+				_copy_screen(true);
+				state.ssao_blur_shader.set_conditional(SsaoBlurShaderGLES3::USE_UPSCALE, false);
+
+				glDisable(GL_DEPTH_TEST);
+				glDepthFunc(GL_LEQUAL);
+
+				ao_result = storage->frame.current_rt->effects.ssao.blur_red[0];
+			}
+
+			glViewport(0, 0, ss[0], ss[1]);
+		}
+
 		// just copy diffuse while applying SSAO
 
 		state.effect_blur_shader.set_conditional(EffectBlurShaderGLES3::SSAO_MERGE, true);
@@ -3425,7 +4055,7 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->color); //previous level, since mipmaps[0] starts one level bigger
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->effects.ssao.blur_red[0]); //previous level, since mipmaps[0] starts one level bigger
+		glBindTexture(GL_TEXTURE_2D, ao_result);
 		glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.mip_maps[0].sizes[0].fbo); // copy to base level
 		_copy_screen(true);
 		state.effect_blur_shader.set_conditional(EffectBlurShaderGLES3::SSAO_MERGE, false);
@@ -3495,6 +4125,9 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 	}
 
+	GLuint ssr_result = 0;
+	bool ssr_upscale = false;
+
 	if (env->ssr_enabled) {
 
 		//blur diffuse into effect mipmaps using separatable convolution
@@ -3508,9 +4141,24 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 
 		state.ssr_shader.bind();
 
+		//rays are always marched in half resolution pixel units, only the density of the output changes
 		int ssr_w = storage->frame.current_rt->effects.mip_maps[1].sizes[0].width;
 		int ssr_h = storage->frame.current_rt->effects.mip_maps[1].sizes[0].height;
 
+		int ssr_shift = int(env->ssr_resolution);
+		bool ssr_scaled = ssr_shift != VS::ENV_EFFECT_RESOLUTION_HALF || env->ssr_temporal;
+		RasterizerStorageGLES3::RenderTarget::Effects::Scaled &ssr_target = storage->frame.current_rt->effects.ssr_scaled;
+
+		if (ssr_scaled) {
+			bool hf = storage->config.framebuffer_half_float_supported;
+			int w = storage->frame.current_rt->width >> ssr_shift;
+			int h = storage->frame.current_rt->height >> ssr_shift;
+			if (!storage->_render_target_update_scaled(ssr_target, w, h, hf ? GL_RGBA16F : GL_RGBA8, GL_RGBA, hf ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE)) {
+				ssr_shift = VS::ENV_EFFECT_RESOLUTION_HALF;
+				ssr_scaled = false;
+			}
+		}
+
 		state.ssr_shader.set_uniform(ScreenSpaceReflectionShaderGLES3::PIXEL_SIZE, Vector2(1.0 / (ssr_w * 0.5), 1.0 / (ssr_h * 0.5)));
 		state.ssr_shader.set_uniform(ScreenSpaceReflectionShaderGLES3::CAMERA_Z_NEAR, p_cam_projection.get_z_near());
 		state.ssr_shader.set_uniform(ScreenSpaceReflectionShaderGLES3::CAMERA_Z_FAR, p_cam_projection.get_z_far());
@@ -3532,10 +4180,25 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
 
-		glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.mip_maps[1].sizes[0].fbo);
-		glViewport(0, 0, ssr_w, ssr_h);
+		if (ssr_scaled) {
+			glBindFramebuffer(GL_FRAMEBUFFER, ssr_target.fbo[0]);
+			glViewport(0, 0, ssr_target.width, ssr_target.height);
+		} else {
+			glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.mip_maps[1].sizes[0].fbo);
+			glViewport(0, 0, ssr_w, ssr_h);
+		}
 
 		_copy_screen(true);
+
+		ssr_result = storage->frame.current_rt->effects.mip_maps[1].color;
+		if (ssr_scaled) {
+			ssr_result = ssr_target.color[0];
+			if (env->ssr_temporal) {
+				ssr_result = _temporal_accumulate(ssr_target, ssr_result, view_projection);
+			}
+		}
+		ssr_upscale = ssr_shift > 0;
+
 		glViewport(0, 0, storage->frame.current_rt->width, storage->frame.current_rt->height);
 	}
 
@@ -3551,6 +4214,7 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 
 	//copy reflection over diffuse, resolving SSR if needed
 	state.resolve_shader.set_conditional(ResolveShaderGLES3::USE_SSR, env->ssr_enabled);
+	state.resolve_shader.set_conditional(ResolveShaderGLES3::USE_SSR_UPSCALE, ssr_upscale);
 	state.resolve_shader.bind();
 	state.resolve_shader.set_uniform(ResolveShaderGLES3::PIXEL_SIZE, Vector2(1.0 / storage->frame.current_rt->width, 1.0 / storage->frame.current_rt->height));
 
@@ -3558,7 +4222,13 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 	glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->color);
 	if (env->ssr_enabled) {
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->effects.mip_maps[1].color);
+		glBindTexture(GL_TEXTURE_2D, ssr_result);
+	}
+	if (ssr_upscale) {
+		state.resolve_shader.set_uniform(ResolveShaderGLES3::CAMERA_Z_NEAR, p_cam_projection.get_z_near());
+		state.resolve_shader.set_uniform(ResolveShaderGLES3::CAMERA_Z_FAR, p_cam_projection.get_z_far());
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
 	}
 
 	glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.mip_maps[0].sizes[0].fbo);
@@ -4087,6 +4757,13 @@ void RasterizerSceneGLES3::_post_process(Environment *env, const CameraMatrix &p
 
 void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RID p_environment, RID p_shadow_atlas, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {
 
+	StereoPass stereo = stereo_pass;
+	stereo_pass = STEREO_PASS_NONE;
+
+	//the second eye sees the same cull result, its lists only change in camera transform and projection
+	bool reuse_lists = stereo == STEREO_PASS_SECOND && stereo_lists.valid && stereo_lists.render_pass == render_pass && stereo_lists.cull_result == p_cull_result && stereo_lists.cull_count == p_cull_count;
+	stereo_lists.valid = false;
+
 	//first of all, make a new render pass
 	render_pass++;
 
@@ -4094,6 +4771,15 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 
 	storage->info.render.object_count += p_cull_count;
 
+	//the depth prepass and the main pass pick the same mesh lods
+	if (state.lod_threshold > 0.0) {
+		float viewport_height = storage->frame.current_rt ? storage->frame.current_rt->height : 1;
+		state.lod_pixels_per_unit = 0.5 * viewport_height * p_cam_projection.matrix[1][1];
+		state.lod_orthogonal = p_cam_ortogonal;
+	} else {
+		state.lod_pixels_per_unit = 0.0;
+	}
+
 	Environment *env = environment_owner.getornull(p_environment);
 	ShadowAtlas *shadow_atlas = shadow_atlas_owner.getornull(p_shadow_atlas);
 	ReflectionAtlas *reflection_atlas = reflection_atlas_owner.getornull(p_reflection_atlas);
@@ -4143,6 +4829,8 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 
 	_setup_environment(env, p_cam_projection, p_cam_transform, p_reflection_probe.is_valid());
 
+	_sort_particles_by_depth(p_cull_result, p_cull_count, p_cam_transform);
+
 	bool fb_cleared = false;
 
 	glDepthFunc(GL_LEQUAL);
@@ -4171,6 +4859,8 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 	use_depth_prepass = use_depth_prepass && storage->frame.current_rt && !storage->frame.current_rt->flags[RasterizerStorage::RENDER_TARGET_NO_3D_EFFECTS];
 	use_depth_prepass = use_depth_prepass && state.debug_draw != VS::VIEWPORT_DEBUG_DRAW_OVERDRAW;
 
+	reuse_lists = reuse_lists && use_depth_prepass == stereo_lists.used_depth_prepass;
+
 	if (use_depth_prepass) {
 		//pre z pass
 
@@ -4187,11 +4877,34 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 		glClearDepth(1.0f);
 		glClear(GL_DEPTH_BUFFER_BIT);
 
-		render_list.clear();
-		_fill_render_list(p_cull_result, p_cull_count, true, false);
-		render_list.sort_by_key(false);
+		RenderList::Element **depth_elements;
+		int depth_element_count;
+
+		if (reuse_lists) {
+			depth_elements = stereo_lists.depth_element_ptrs.ptrw();
+			depth_element_count = stereo_lists.depth_element_ptrs.size();
+		} else {
+			render_list.clear();
+			_fill_render_list(p_cull_result, p_cull_count, true, false);
+			render_list.sort_by_key(false);
+			depth_elements = render_list.elements;
+			depth_element_count = render_list.element_count;
+
+			if (stereo == STEREO_PASS_FIRST) {
+				//the main pass reuses render_list, so keep a copy of the sorted depth pass
+				stereo_lists.depth_elements.resize(depth_element_count);
+				stereo_lists.depth_element_ptrs.resize(depth_element_count);
+				RenderList::Element *kept = stereo_lists.depth_elements.ptrw();
+				RenderList::Element **kept_ptrs = stereo_lists.depth_element_ptrs.ptrw();
+				for (int i = 0; i < depth_element_count; i++) {
+					kept[i] = *depth_elements[i];
+					kept_ptrs[i] = &kept[i];
+				}
+			}
+		}
+
 		state.scene_shader.set_conditional(SceneShaderGLES3::RENDER_DEPTH, true);
-		_render_list(render_list.elements, render_list.element_count, p_cam_transform, p_cam_projection, NULL, false, false, true, false, false);
+		_render_list(depth_elements, depth_element_count, p_cam_transform, p_cam_projection, NULL, false, false, true, false, false);
 		state.scene_shader.set_conditional(SceneShaderGLES3::RENDER_DEPTH, false);
 
 		glColorMask(1, 1, 1, 1);
@@ -4214,9 +4927,14 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 
 	bool use_mrt = false;
 
-	render_list.clear();
-	_fill_render_list(p_cull_result, p_cull_count, false, false);
-	//
+	if (!reuse_lists) {
+		render_list.clear();
+		_fill_render_list(p_cull_result, p_cull_count, false, false);
+	}
+
+	if (storage->texture_stream_list.first()) {
+		_update_texture_stream_requirements(p_cam_projection, p_cam_ortogonal);
+	}
 
 	glEnable(GL_BLEND);
 	glDepthMask(GL_TRUE);
@@ -4226,6 +4944,7 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 	//rendering to a probe cubemap side
 	ReflectionProbeInstance *probe = reflection_probe_instance_owner.getornull(p_reflection_probe);
 	GLuint current_fbo;
+	Size2i viewport_size;
 
 	if (probe) {
 
@@ -4248,7 +4967,8 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 		use_mrt = false;
 		state.scene_shader.set_conditional(SceneShaderGLES3::USE_MULTIPLE_RENDER_TARGETS, false);
 
-		glViewport(0, 0, reflection_cubemaps[cubemap_index].size, reflection_cubemaps[cubemap_index].size);
+		viewport_size = Size2i(reflection_cubemaps[cubemap_index].size, reflection_cubemaps[cubemap_index].size);
+		glViewport(0, 0, viewport_size.width, viewport_size.height);
 		glBindFramebuffer(GL_FRAMEBUFFER, current_fbo);
 
 	} else {
@@ -4260,7 +4980,8 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 		use_mrt = use_mrt && state.debug_draw != VS::VIEWPORT_DEBUG_DRAW_OVERDRAW;
 		use_mrt = use_mrt && (env->bg_mode != VS::ENV_BG_KEEP && env->bg_mode != VS::ENV_BG_CANVAS);
 
-		glViewport(0, 0, storage->frame.current_rt->width, storage->frame.current_rt->height);
+		viewport_size = Size2i(storage->frame.current_rt->width, storage->frame.current_rt->height);
+		glViewport(0, 0, viewport_size.width, viewport_size.height);
 
 		if (use_mrt) {
 
@@ -4306,6 +5027,8 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 		}
 	}
 
+	_setup_clusters(p_light_cull_result, p_light_cull_count, p_reflection_probe_cull_result, p_reflection_probe_cull_count, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_ortogonal, viewport_size);
+
 	if (!fb_cleared) {
 		glClearDepth(1.0f);
 		glClear(GL_DEPTH_BUFFER_BIT);
@@ -4476,7 +5199,9 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 		glDisable(GL_BLEND);
 	}
 
-	render_list.sort_by_key(false);
+	if (!reuse_lists) {
+		render_list.sort_by_key(false);
+	}
 
 	if (state.directional_light_count == 0) {
 		directional_light = NULL;
@@ -4517,7 +5242,7 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 
 	if (use_mrt) {
 
-		_render_mrts(env, p_cam_projection);
+		_render_mrts(env, p_cam_transform, p_cam_projection);
 	} else {
 		// Here we have to do the blits/resolves that otherwise are done in the MRT rendering, in particular
 		// - prepare screen texture for any geometry that uses a shader with screen texture
@@ -4562,7 +5287,9 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 	glEnable(GL_DEPTH_TEST);
 	glDisable(GL_SCISSOR_TEST);
 
-	render_list.sort_by_reverse_depth_and_priority(true);
+	if (!reuse_lists) {
+		render_list.sort_by_reverse_depth_and_priority(true);
+	}
 
 	if (state.directional_light_count == 0) {
 		directional_light = NULL;
@@ -4575,6 +5302,14 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 		}
 	}
 
+	if (stereo == STEREO_PASS_FIRST && !probe) {
+		stereo_lists.valid = true;
+		stereo_lists.render_pass = render_pass;
+		stereo_lists.cull_result = p_cull_result;
+		stereo_lists.cull_count = p_cull_count;
+		stereo_lists.used_depth_prepass = use_depth_prepass;
+	}
+
 	if (probe) {
 		//rendering a probe, do no more!
 		return;
@@ -4643,6 +5378,7 @@ void RasterizerSceneGLES3::render_shadow(RID p_light, RID p_shadow_atlas, int p_
 	render_pass++;
 
 	directional_light = NULL;
+	state.lod_pixels_per_unit = 0.0; //shadows use full detail, coarser casters would self shadow
 
 	LightInstance *light_instance = light_instance_owner.getornull(p_light);
 	ERR_FAIL_COND(!light_instance);
@@ -4910,6 +5646,10 @@ void RasterizerSceneGLES3::set_scene_pass(uint64_t p_pass) {
 	scene_pass = p_pass;
 }
 
+void RasterizerSceneGLES3::set_stereo_pass(StereoPass p_pass) {
+	stereo_pass = p_pass;
+}
+
 bool RasterizerSceneGLES3::free(RID p_rid) {
 
 	if (light_instance_owner.owns(p_rid)) {
@@ -4980,6 +5720,8 @@ void RasterizerSceneGLES3::set_debug_draw_mode(VS::ViewportDebugDraw p_debug_dra
 void RasterizerSceneGLES3::initialize() {
 
 	render_pass = 0;
+	stereo_pass = STEREO_PASS_NONE;
+	stereo_lists.valid = false;
 
 	state.scene_shader.init();
 
@@ -5018,15 +5760,11 @@ void RasterizerSceneGLES3::initialize() {
 		storage->material_set_shader(default_overdraw_material, default_overdraw_shader);
 	}
 
-	glGenBuffers(1, &state.scene_ubo);
-	glBindBuffer(GL_UNIFORM_BUFFER, state.scene_ubo);
-	glBufferData(GL_UNIFORM_BUFFER, sizeof(State::SceneDataUBO), &state.scene_ubo, GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	state.scene_ubo = storage->stream_buffer_create(GL_UNIFORM_BUFFER, 64 * 1024);
+	state.scene_ubo_offset = 0;
 
-	glGenBuffers(1, &state.env_radiance_ubo);
-	glBindBuffer(GL_UNIFORM_BUFFER, state.env_radiance_ubo);
-	glBufferData(GL_UNIFORM_BUFFER, sizeof(State::EnvironmentRadianceUBO), &state.env_radiance_ubo, GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	state.env_radiance_ubo = storage->stream_buffer_create(GL_UNIFORM_BUFFER, 64 * 1024);
+	state.env_radiance_ubo_offset = 0;
 
 	render_list.max_elements = GLOBAL_DEF_RST("rendering/limits/rendering/max_renderable_elements", (int)RenderList::DEFAULT_MAX_ELEMENTS);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/rendering/max_renderable_elements", PropertyInfo(Variant::INT, "rendering/limits/rendering/max_renderable_elements", PROPERTY_HINT_RANGE, "1024,1000000,1"));
@@ -5234,14 +5972,49 @@ void RasterizerSceneGLES3::initialize() {
 		uint32_t immediate_buffer_size = GLOBAL_DEF("rendering/limits/buffers/immediate_buffer_size_kb", 2048);
 		ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/buffers/immediate_buffer_size_kb", PropertyInfo(Variant::INT, "rendering/limits/buffers/immediate_buffer_size_kb", PROPERTY_HINT_RANGE, "0,8192,1,or_greater"));
 
-		glGenBuffers(1, &state.immediate_buffer);
-		glBindBuffer(GL_ARRAY_BUFFER, state.immediate_buffer);
-		glBufferData(GL_ARRAY_BUFFER, immediate_buffer_size * 1024, NULL, GL_DYNAMIC_DRAW);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		state.immediate_buffer = storage->stream_buffer_create(GL_ARRAY_BUFFER, immediate_buffer_size * 1024);
 
 		glGenVertexArrays(1, &state.immediate_array);
 	}
 
+	{
+		state.use_auto_instancing = GLOBAL_DEF("rendering/quality/instancing/use_auto_instancing", true);
+
+		state.lod_threshold = GLOBAL_DEF("rendering/quality/lod/threshold_pixels", 1.0);
+		ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/lod/threshold_pixels", PropertyInfo(Variant::REAL, "rendering/quality/lod/threshold_pixels", PROPERTY_HINT_RANGE, "0,16,0.1"));
+		state.lod_pixels_per_unit = 0.0;
+		state.lod_orthogonal = false;
+
+		state.auto_instance_buffer = storage->stream_buffer_create(GL_ARRAY_BUFFER, sizeof(float) * 12 * MAX_AUTO_INSTANCES);
+		state.auto_instance_transforms = (float *)memalloc(sizeof(float) * 12 * MAX_AUTO_INSTANCES);
+	}
+
+	{
+		cluster.enabled = GLOBAL_DEF("rendering/quality/shading/use_clustered_lighting", false);
+
+		if (cluster.enabled) {
+			//enough room for every header plus full item lists in all clusters
+			int max_texels = CLUSTER_COUNT + CLUSTER_COUNT * CLUSTER_ITEM_MAX * CLUSTER_MAX_ITEMS / 4;
+			cluster.texture_height = (max_texels + CLUSTER_TEXTURE_WIDTH - 1) / CLUSTER_TEXTURE_WIDTH;
+
+			cluster.texture_data = (uint32_t *)memalloc(sizeof(uint32_t) * 4 * CLUSTER_TEXTURE_WIDTH * cluster.texture_height);
+			cluster.items = (uint16_t *)memalloc(sizeof(uint16_t) * CLUSTER_COUNT * CLUSTER_ITEM_MAX * CLUSTER_MAX_ITEMS);
+			cluster.item_counts = (uint8_t *)memalloc(CLUSTER_COUNT * CLUSTER_ITEM_MAX);
+
+			glGenTextures(1, &cluster.texture);
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, cluster.texture);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32UI, CLUSTER_TEXTURE_WIDTH, cluster.texture_height, 0, GL_RGBA_INTEGER, GL_UNSIGNED_INT, NULL);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glBindTexture(GL_TEXTURE_2D, 0);
+
+			state.scene_shader.add_custom_define("#define CLUSTER_TEXTURE_WIDTH " + itos(CLUSTER_TEXTURE_WIDTH) + "\n");
+		}
+	}
+
 #ifdef GLES_OVER_GL
 	//"desktop" opengl needs this.
 	glEnable(GL_PROGRAM_POINT_SIZE);
@@ -5255,6 +6028,7 @@ void RasterizerSceneGLES3::initialize() {
 	state.ssao_minify_shader.init();
 	state.ssao_shader.init();
 	state.ssao_blur_shader.init();
+	state.temporal_shader.init();
 	state.exposure_shader.init();
 	state.tonemap_shader.init();
 
@@ -5320,6 +6094,18 @@ void RasterizerSceneGLES3::iteration() {
 }
 
 void RasterizerSceneGLES3::finalize() {
+
+	storage->stream_buffer_free(state.scene_ubo);
+	storage->stream_buffer_free(state.env_radiance_ubo);
+	storage->stream_buffer_free(state.immediate_buffer);
+	storage->stream_buffer_free(state.auto_instance_buffer);
+
+	if (cluster.texture) {
+		glDeleteTextures(1, &cluster.texture);
+		memfree(cluster.texture_data);
+		memfree(cluster.items);
+		memfree(cluster.item_counts);
+	}
 }
 
 RasterizerSceneGLES3::RasterizerSceneGLES3() {
@@ -5343,4 +6129,5 @@ RasterizerSceneGLES3::~RasterizerSceneGLES3() {
 	memfree(state.spot_array_tmp);
 	memfree(state.omni_array_tmp);
 	memfree(state.reflection_array_tmp);
+	memfree(state.auto_instance_transforms);
 }
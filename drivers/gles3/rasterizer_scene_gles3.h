@@ -34,6 +34,8 @@
 /* Must come before shaders or the Windows build fails... */
 #include "rasterizer_storage_gles3.h"
 
+#include "core/parallel_sort_array.h"
+
 #include "drivers/gles3/shaders/cube_to_dp.glsl.gen.h"
 #include "drivers/gles3/shaders/effect_blur.glsl.gen.h"
 #include "drivers/gles3/shaders/exposure.glsl.gen.h"
@@ -44,6 +46,7 @@
 #include "drivers/gles3/shaders/ssao_blur.glsl.gen.h"
 #include "drivers/gles3/shaders/ssao_minify.glsl.gen.h"
 #include "drivers/gles3/shaders/subsurf_scattering.glsl.gen.h"
+#include "drivers/gles3/shaders/temporal_reprojection.glsl.gen.h"
 #include "drivers/gles3/shaders/tonemap.glsl.gen.h"
 
 class RasterizerSceneGLES3 : public RasterizerScene {
@@ -110,6 +113,7 @@ public:
 		SsaoMinifyShaderGLES3 ssao_minify_shader;
 		SsaoShaderGLES3 ssao_shader;
 		SsaoBlurShaderGLES3 ssao_blur_shader;
+		TemporalReprojectionShaderGLES3 temporal_shader;
 		ExposureShaderGLES3 exposure_shader;
 		TonemapShaderGLES3 tonemap_shader;
 
@@ -159,7 +163,8 @@ public:
 
 		} ubo_data;
 
-		GLuint scene_ubo;
+		RasterizerStorageGLES3::StreamBuffer *scene_ubo;
+		uint32_t scene_ubo_offset;
 
 		struct EnvironmentRadianceUBO {
 
@@ -169,7 +174,8 @@ public:
 
 		} env_radiance_data;
 
-		GLuint env_radiance_ubo;
+		RasterizerStorageGLES3::StreamBuffer *env_radiance_ubo;
+		uint32_t env_radiance_ubo_offset;
 
 		GLuint sky_verts;
 		GLuint sky_array;
@@ -180,9 +186,17 @@ public:
 		GLuint omni_array_ubo;
 		GLuint reflection_array_ubo;
 
-		GLuint immediate_buffer;
+		RasterizerStorageGLES3::StreamBuffer *immediate_buffer;
 		GLuint immediate_array;
 
+		bool use_auto_instancing;
+		RasterizerStorageGLES3::StreamBuffer *auto_instance_buffer;
+		float *auto_instance_transforms;
+
+		float lod_threshold; //pixels of error allowed on screen
+		float lod_pixels_per_unit; //at distance one for perspective cameras, zero draws full detail
+		bool lod_orthogonal;
+
 		uint32_t ubo_light_size;
 		uint8_t *spot_array_tmp;
 		uint8_t *omni_array_tmp;
@@ -273,7 +287,7 @@ public:
 	void shadow_atlas_set_size(RID p_atlas, int p_size);
 	void shadow_atlas_set_quadrant_subdivision(RID p_atlas, int p_quadrant, int p_subdivision);
 	bool _shadow_atlas_find_shadow(ShadowAtlas *shadow_atlas, int *p_in_quadrants, int p_quadrant_count, int p_current_subdiv, uint64_t p_tick, int &r_quadrant, int &r_shadow);
-	bool shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version);
+	bool shadow_atlas_update_light(RID p_atlas, RID p_light_intance, float p_coverage, uint64_t p_light_version, uint64_t &r_drawn_version);
 
 	struct DirectionalShadow {
 		GLuint fbo;
@@ -337,6 +351,7 @@ public:
 
 		uint64_t last_pass;
 		int reflection_index;
+		bool clustered;
 
 		Transform transform;
 	};
@@ -390,6 +405,8 @@ public:
 		float ssr_fade_out;
 		float ssr_depth_tolerance;
 		bool ssr_roughness;
+		VS::EnvironmentEffectResolution ssr_resolution;
+		bool ssr_temporal;
 
 		bool ssao_enabled;
 		float ssao_intensity;
@@ -403,6 +420,8 @@ public:
 		VS::EnvironmentSSAOQuality ssao_quality;
 		float ssao_bilateral_sharpness;
 		VS::EnvironmentSSAOBlur ssao_filter;
+		VS::EnvironmentEffectResolution ssao_resolution;
+		bool ssao_temporal;
 
 		bool glow_enabled;
 		int glow_levels;
@@ -473,6 +492,8 @@ public:
 				ssr_fade_out(2.0),
 				ssr_depth_tolerance(0.2),
 				ssr_roughness(true),
+				ssr_resolution(VS::ENV_EFFECT_RESOLUTION_HALF),
+				ssr_temporal(false),
 				ssao_enabled(false),
 				ssao_intensity(1.0),
 				ssao_radius(1.0),
@@ -484,6 +505,8 @@ public:
 				ssao_quality(VS::ENV_SSAO_QUALITY_LOW),
 				ssao_bilateral_sharpness(4),
 				ssao_filter(VS::ENV_SSAO_BLUR_3x3),
+				ssao_resolution(VS::ENV_EFFECT_RESOLUTION_FULL),
+				ssao_temporal(false),
 				glow_enabled(false),
 				glow_levels((1 << 2) | (1 << 4)),
 				glow_intensity(0.8),
@@ -554,6 +577,8 @@ public:
 
 	virtual void environment_set_ssr(RID p_env, bool p_enable, int p_max_steps, float p_fade_in, float p_fade_out, float p_depth_tolerance, bool p_roughness);
 	virtual void environment_set_ssao(RID p_env, bool p_enable, float p_radius, float p_intensity, float p_radius2, float p_intensity2, float p_bias, float p_light_affect, float p_ao_channel_affect, const Color &p_color, VS::EnvironmentSSAOQuality p_quality, VS::EnvironmentSSAOBlur p_blur, float p_bilateral_sharpness);
+	virtual void environment_set_ssr_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal);
+	virtual void environment_set_ssao_resolution(RID p_env, VS::EnvironmentEffectResolution p_resolution, bool p_temporal);
 
 	virtual void environment_set_tonemap(RID p_env, VS::EnvironmentToneMapper p_tone_mapper, float p_exposure, float p_white, bool p_auto_exposure, float p_min_luminance, float p_max_luminance, float p_auto_exp_speed, float p_auto_exp_scale);
 
@@ -618,6 +643,7 @@ public:
 		uint64_t last_pass;
 		uint16_t light_index;
 		uint16_t light_directional_index;
+		bool clustered;
 
 		uint32_t current_shadow_atlas_key;
 
@@ -637,6 +663,56 @@ public:
 	virtual void light_instance_set_shadow_transform(RID p_light_instance, const CameraMatrix &p_projection, const Transform &p_transform, float p_far, float p_split, int p_pass, float p_bias_scale = 1.0);
 	virtual void light_instance_mark_visible(RID p_light_instance);
 
+	/* CLUSTERED LIGHTING */
+
+	enum {
+		CLUSTER_COUNT_X = 16,
+		CLUSTER_COUNT_Y = 8,
+		CLUSTER_COUNT_Z = 24,
+		CLUSTER_COUNT = CLUSTER_COUNT_X * CLUSTER_COUNT_Y * CLUSTER_COUNT_Z,
+		CLUSTER_MAX_ITEMS = 32, //per cluster and item type
+		CLUSTER_TEXTURE_WIDTH = 1024
+	};
+
+	enum ClusterItemType {
+		CLUSTER_ITEM_OMNI,
+		CLUSTER_ITEM_SPOT,
+		CLUSTER_ITEM_REFLECTION,
+		CLUSTER_ITEM_MAX
+	};
+
+	struct Cluster {
+
+		bool enabled;
+		bool active; //built for the scene being rendered
+
+		GLuint texture;
+		int texture_height;
+		uint32_t *texture_data; //RGBA32UI texels: cluster headers followed by the item indices
+
+		uint16_t *items;
+		uint8_t *item_counts;
+
+		float xy_params[4];
+		float z_params[4];
+		float z_near;
+		float z_far;
+		bool z_log;
+
+		Cluster() :
+				enabled(false),
+				active(false),
+				texture(0),
+				texture_height(0),
+				texture_data(NULL),
+				items(NULL),
+				item_counts(NULL) {
+		}
+	} cluster;
+
+	void _cluster_add_item(const AABB &p_view_aabb, ClusterItemType p_type, uint16_t p_index, const CameraMatrix &p_camera_projection);
+	void _setup_clusters(RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, const Transform &p_camera_inverse_transform, const CameraMatrix &p_camera_projection, bool p_camera_ortogonal, const Size2i &p_viewport_size);
+
 	/* REFLECTION INSTANCE */
 
 	struct GIProbeInstance : public RID_Data {
@@ -715,6 +791,7 @@ public:
 
 		Element *base_elements;
 		Element **elements;
+		Element **sort_scratch;
 
 		int element_count;
 		int alpha_element_count;
@@ -725,22 +802,20 @@ public:
 			alpha_element_count = 0;
 		}
 
-		//should eventually be replaced by radix
+		struct SortKeyGetter {
 
-		struct SortByKey {
-
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->sort_key < B->sort_key;
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				return A->sort_key;
 			}
 		};
 
 		void sort_by_key(bool p_alpha) {
 
-			SortArray<Element *, SortByKey> sorter;
+			RadixSortArray<Element *, SortKeyGetter> sorter;
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count, sort_scratch);
 			} else {
-				sorter.sort(elements, element_count);
+				sorter.sort(elements, element_count, sort_scratch);
 			}
 		}
 
@@ -753,7 +828,7 @@ public:
 
 		void sort_by_depth(bool p_alpha) { //used for shadows
 
-			SortArray<Element *, SortByDepth> sorter;
+			ParallelSortArray<Element *, SortByDepth> sorter;
 			if (p_alpha) {
 				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
 			} else {
@@ -776,7 +851,7 @@ public:
 
 		void sort_by_reverse_depth_and_priority(bool p_alpha) { //used for alpha
 
-			SortArray<Element *, SortByReverseDepthAndPriority> sorter;
+			ParallelSortArray<Element *, SortByReverseDepthAndPriority> sorter;
 			if (p_alpha) {
 				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
 			} else {
@@ -807,6 +882,7 @@ public:
 			element_count = 0;
 			alpha_element_count = 0;
 			elements = memnew_arr(Element *, max_elements);
+			sort_scratch = memnew_arr(Element *, max_elements);
 			base_elements = memnew_arr(Element, max_elements);
 			for (int i = 0; i < max_elements; i++)
 				elements[i] = &base_elements[i]; // assign elements
@@ -821,6 +897,7 @@ public:
 
 		~RenderList() {
 			memdelete_arr(elements);
+			memdelete_arr(sort_scratch);
 			memdelete_arr(base_elements);
 		}
 	};
@@ -830,11 +907,33 @@ public:
 
 	RenderList render_list;
 
+	//render lists of the first eye of a stereo render, drawn again for the second one
+	struct StereoLists {
+		bool valid;
+		uint64_t render_pass;
+		InstanceBase **cull_result;
+		int cull_count;
+		bool used_depth_prepass;
+		Vector<RenderList::Element> depth_elements;
+		Vector<RenderList::Element *> depth_element_ptrs;
+	};
+
+	StereoPass stereo_pass;
+	StereoLists stereo_lists;
+
 	_FORCE_INLINE_ void _set_cull(bool p_front, bool p_disabled, bool p_reverse_cull);
 
 	_FORCE_INLINE_ bool _setup_material(RasterizerStorageGLES3::Material *p_material, bool p_depth_pass, bool p_alpha_pass);
 	_FORCE_INLINE_ void _setup_geometry(RenderList::Element *e, const Transform &p_view_transform);
-	_FORCE_INLINE_ void _render_geometry(RenderList::Element *e);
+	_FORCE_INLINE_ void _render_geometry(RenderList::Element *e, int p_instance_count = 1);
+
+	enum {
+		MAX_AUTO_INSTANCES = 512
+	};
+
+	_FORCE_INLINE_ bool _can_auto_instance(RenderList::Element *e) const;
+	_FORCE_INLINE_ bool _can_share_instanced_draw(RenderList::Element *a, RenderList::Element *b, bool p_lit) const;
+	_FORCE_INLINE_ void _setup_auto_instancing(RenderList::Element **p_elements, int p_instance_count);
 	_FORCE_INLINE_ void _setup_light(RenderList::Element *e, const Transform &p_view_transform);
 
 	void _render_list(RenderList::Element **p_elements, int p_element_count, const Transform &p_view_transform, const CameraMatrix &p_projection, RasterizerStorageGLES3::Sky *p_sky, bool p_reverse_cull, bool p_alpha_pass, bool p_shadow, bool p_directional_add, bool p_directional_shadows);
@@ -846,6 +945,7 @@ public:
 	void _draw_sky(RasterizerStorageGLES3::Sky *p_sky, const CameraMatrix &p_projection, const Transform &p_transform, bool p_vflip, float p_custom_fov, float p_energy, const Basis &p_sky_orientation);
 
 	void _setup_environment(Environment *env, const CameraMatrix &p_cam_projection, const Transform &p_cam_transform, bool p_no_fog = false);
+	void _sort_particles_by_depth(InstanceBase **p_cull_result, int p_cull_count, const Transform &p_cam_transform);
 	void _setup_directional_light(int p_index, const Transform &p_camera_inverse_transform, bool p_use_shadows);
 	void _setup_lights(RID *p_light_cull_result, int p_light_cull_count, const Transform &p_camera_inverse_transform, const CameraMatrix &p_camera_projection, RID p_shadow_atlas);
 	void _setup_reflections(RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, const Transform &p_camera_inverse_transform, const CameraMatrix &p_camera_projection, RID p_reflection_atlas, Environment *p_env);
@@ -853,10 +953,13 @@ public:
 	void _copy_screen(bool p_invalidate_color = false, bool p_invalidate_depth = false);
 	void _copy_texture_to_front_buffer(GLuint p_texture); //used for debug
 
+	_FORCE_INLINE_ RasterizerStorageGLES3::Surface *_get_surface_lod(RasterizerStorageGLES3::Surface *p_surface, const InstanceBase *p_instance, float p_scale) const;
 	void _fill_render_list(InstanceBase **p_cull_result, int p_cull_count, bool p_depth_pass, bool p_shadow_pass);
+	void _update_texture_stream_requirements(const CameraMatrix &p_cam_projection, bool p_cam_ortogonal);
 
 	void _blur_effect_buffer();
-	void _render_mrts(Environment *env, const CameraMatrix &p_cam_projection);
+	GLuint _temporal_accumulate(RasterizerStorageGLES3::RenderTarget::Effects::Scaled &r_scaled, GLuint p_source, const CameraMatrix &p_view_projection);
+	void _render_mrts(Environment *env, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection);
 	void _post_process(Environment *env, const CameraMatrix &p_cam_projection);
 
 	void _prepare_depth_texture();
@@ -867,6 +970,7 @@ public:
 	virtual bool free(RID p_rid);
 
 	virtual void set_scene_pass(uint64_t p_pass);
+	virtual void set_stereo_pass(StereoPass p_pass);
 	virtual void set_debug_draw_mode(VS::ViewportDebugDraw p_debug_draw);
 
 	void iteration();
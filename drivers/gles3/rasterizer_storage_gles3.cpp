@@ -30,12 +30,17 @@
 
 #include "rasterizer_storage_gles3.h"
 #include "core/engine.h"
+#include "core/os/file_access.h"
 #include "core/project_settings.h"
 #include "rasterizer_canvas_gles3.h"
 #include "rasterizer_scene_gles3.h"
+#include "shader_cache_gles3.h"
 
 /* TEXTURE API */
 
+//streamed textures not drawn for this many frames go back to their smallest resident mipmap
+#define TEXTURE_STREAM_KEEP_FRAMES 120
+
 #define _EXT_COMPRESSED_RGB_PVRTC_4BPPV1_IMG 0x8C00
 #define _EXT_COMPRESSED_RGB_PVRTC_2BPPV1_IMG 0x8C01
 #define _EXT_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG 0x8C02
@@ -753,6 +758,12 @@ void RasterizerStorageGLES3::texture_set_data(RID p_texture, const Ref<Image> &p
 	Texture *texture = texture_owner.get(p_texture);
 
 	ERR_FAIL_COND(!texture);
+	_texture_set_data(texture, p_image, p_layer, 0);
+}
+
+//p_image holds the mipmaps starting at p_first_mipmap, which is only non zero for streamed textures
+void RasterizerStorageGLES3::_texture_set_data(Texture *texture, const Ref<Image> &p_image, int p_layer, int p_first_mipmap) {
+
 	ERR_FAIL_COND(!texture->active);
 	ERR_FAIL_COND(texture->render_target);
 	ERR_FAIL_COND(texture->format != p_image->get_format());
@@ -764,14 +775,14 @@ void RasterizerStorageGLES3::texture_set_data(RID p_texture, const Ref<Image> &p
 	bool compressed;
 	bool srgb;
 
-	if (config.keep_original_textures && !(texture->flags & VS::TEXTURE_FLAG_USED_FOR_STREAMING)) {
+	if (config.keep_original_textures && !(texture->flags & VS::TEXTURE_FLAG_USED_FOR_STREAMING) && !texture->stream_callback) {
 		texture->images.write[p_layer] = p_image;
 	}
 
 	Image::Format real_format;
 	Ref<Image> img = _get_gl_image_and_format(p_image, p_image->get_format(), texture->flags, real_format, format, internal_format, type, compressed, srgb, texture->is_npot_repeat_mipmap);
 
-	if (config.shrink_textures_x2 && (p_image->has_mipmaps() || !p_image->is_compressed()) && !(texture->flags & VS::TEXTURE_FLAG_USED_FOR_STREAMING)) {
+	if (config.shrink_textures_x2 && (p_image->has_mipmaps() || !p_image->is_compressed()) && !(texture->flags & VS::TEXTURE_FLAG_USED_FOR_STREAMING) && !texture->stream_callback) {
 
 		texture->alloc_height = MAX(1, texture->alloc_height / 2);
 		texture->alloc_width = MAX(1, texture->alloc_width / 2);
@@ -916,14 +927,14 @@ void RasterizerStorageGLES3::texture_set_data(RID p_texture, const Ref<Image> &p
 				int bw = w;
 				int bh = h;
 
-				glCompressedTexImage2D(blit_target, i, internal_format, bw, bh, 0, size, &read[ofs]);
+				glCompressedTexImage2D(blit_target, p_first_mipmap + i, internal_format, bw, bh, 0, size, &read[ofs]);
 
 			} else {
 				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 				if (texture->flags & VS::TEXTURE_FLAG_USED_FOR_STREAMING) {
 					glTexSubImage2D(blit_target, i, 0, 0, w, h, format, type, &read[ofs]);
 				} else {
-					glTexImage2D(blit_target, i, internal_format, w, h, 0, format, type, &read[ofs]);
+					glTexImage2D(blit_target, p_first_mipmap + i, internal_format, w, h, 0, format, type, &read[ofs]);
 				}
 			}
 		} else {
@@ -957,18 +968,17 @@ void RasterizerStorageGLES3::texture_set_data(RID p_texture, const Ref<Image> &p
 
 	texture->stored_cube_sides |= (1 << p_layer);
 
-	if ((texture->type == VS::TEXTURE_TYPE_2D || texture->type == VS::TEXTURE_TYPE_CUBEMAP) && (texture->flags & VS::TEXTURE_FLAG_MIPMAPS) && mipmaps == 1 && !texture->ignore_mipmaps && (texture->type != VS::TEXTURE_TYPE_CUBEMAP || texture->stored_cube_sides == (1 << 6) - 1)) {
+	if ((texture->type == VS::TEXTURE_TYPE_2D || texture->type == VS::TEXTURE_TYPE_CUBEMAP) && (texture->flags & VS::TEXTURE_FLAG_MIPMAPS) && mipmaps == 1 && p_first_mipmap == 0 && !texture->ignore_mipmaps && (texture->type != VS::TEXTURE_TYPE_CUBEMAP || texture->stored_cube_sides == (1 << 6) - 1)) {
 		//generate mipmaps if they were requested and the image does not contain them
 		glGenerateMipmap(texture->target);
-	} else if (mipmaps > 1) {
-		glTexParameteri(texture->target, GL_TEXTURE_BASE_LEVEL, 0);
-		glTexParameteri(texture->target, GL_TEXTURE_MAX_LEVEL, mipmaps - 1);
 	} else {
-		glTexParameteri(texture->target, GL_TEXTURE_BASE_LEVEL, 0);
-		glTexParameteri(texture->target, GL_TEXTURE_MAX_LEVEL, 0);
+		//levels below the base one are not resident in streamed textures
+		glTexParameteri(texture->target, GL_TEXTURE_BASE_LEVEL, p_first_mipmap);
+		glTexParameteri(texture->target, GL_TEXTURE_MAX_LEVEL, p_first_mipmap + mipmaps - 1);
 	}
 
-	texture->mipmaps = mipmaps;
+	texture->mipmaps = p_first_mipmap + mipmaps;
+	texture->stream_first_mipmap = p_first_mipmap;
 
 	//texture_set_flags(p_texture,texture->flags);
 }
@@ -1571,6 +1581,107 @@ void RasterizerStorageGLES3::texture_set_detect_normal_callback(RID p_texture, V
 	texture->detect_normal_ud = p_userdata;
 }
 
+void RasterizerStorageGLES3::texture_set_stream_callback(RID p_texture, VisualServer::TextureStreamCallback p_callback, void *p_userdata) {
+
+	Texture *texture = texture_owner.get(p_texture);
+	ERR_FAIL_COND(!texture);
+
+	texture->stream_callback = p_callback;
+	texture->stream_ud = p_userdata;
+	texture->stream_requested_mipmap = -1;
+
+	if (p_callback && !texture->stream_list.in_list()) {
+		texture_stream_list.add(&texture->stream_list);
+	} else if (!p_callback && texture->stream_list.in_list()) {
+		texture_stream_list.remove(&texture->stream_list);
+	}
+}
+
+void RasterizerStorageGLES3::texture_set_stream_data(RID p_texture, const Ref<Image> &p_image, int p_first_mipmap) {
+
+	Texture *texture = texture_owner.get(p_texture);
+	ERR_FAIL_COND(!texture);
+	ERR_FAIL_COND(p_image.is_null());
+	ERR_FAIL_COND(texture->type != VS::TEXTURE_TYPE_2D);
+	ERR_FAIL_COND(texture->render_target);
+	ERR_FAIL_COND(!(texture->flags & VS::TEXTURE_FLAG_MIPMAPS));
+
+	int chain_mipmaps = Image::get_image_required_mipmaps(texture->alloc_width, texture->alloc_height, texture->format) + 1;
+	ERR_FAIL_INDEX(p_first_mipmap, chain_mipmaps);
+	ERR_FAIL_COND(p_image->get_width() != MAX(texture->alloc_width >> p_first_mipmap, 1) || p_image->get_height() != MAX(texture->alloc_height >> p_first_mipmap, 1));
+	ERR_FAIL_COND_MSG(p_first_mipmap + p_image->get_mipmap_count() + 1 != chain_mipmaps, "Streamed texture data must contain all mipmaps from the first one down to the smallest.");
+
+	if (p_first_mipmap > texture->stream_first_mipmap || texture->mipmaps < chain_mipmaps) {
+		//GL can't free single levels, so dropping mipmaps (or the first upload) starts from a new texture
+		glDeleteTextures(1, &texture->tex_id);
+		glGenTextures(1, &texture->tex_id);
+	}
+
+	_texture_set_data(texture, p_image, 0, p_first_mipmap);
+
+	if (texture->stream_requested_mipmap == p_first_mipmap) {
+		texture->stream_requested_mipmap = -1;
+	}
+}
+
+int RasterizerStorageGLES3::_texture_stream_target_mipmap(const Texture *p_texture, int p_bias) const {
+
+	//smallest mipmap kept resident, StreamTexture loads the same one initially
+	int floor = 0;
+	while (MAX(p_texture->alloc_width >> floor, p_texture->alloc_height >> floor) > config.texture_streaming_min_size) {
+		floor++;
+	}
+
+	if (p_texture->stream_used_frame == 0 || frame.count - p_texture->stream_used_frame > TEXTURE_STREAM_KEEP_FRAMES) {
+		return floor;
+	}
+
+	return MIN(p_texture->stream_required_mipmap + p_bias, floor);
+}
+
+void RasterizerStorageGLES3::update_texture_streaming() {
+
+	if (!texture_stream_list.first()) {
+		return;
+	}
+
+	//a texture used recently wants the mipmap the scene asked for, the others drop back to the smallest resident size.
+	//when the wanted set doesn't fit the budget, a bias is added to every texture until it does.
+	int bias = 0;
+	int max_bias = 0;
+
+	while (true) {
+
+		uint64_t total = 0;
+
+		for (SelfList<Texture> *E = texture_stream_list.first(); E; E = E->next()) {
+
+			Texture *t = E->self();
+			int target = _texture_stream_target_mipmap(t, bias);
+
+			total += Image::get_image_data_size(MAX(t->alloc_width >> target, 1), MAX(t->alloc_height >> target, 1), t->format, true);
+			max_bias = MAX(max_bias, _texture_stream_target_mipmap(t, 0) - t->stream_required_mipmap);
+		}
+
+		if (total <= config.texture_streaming_budget || bias >= max_bias) {
+			break;
+		}
+
+		bias++;
+	}
+
+	for (SelfList<Texture> *E = texture_stream_list.first(); E; E = E->next()) {
+
+		Texture *t = E->self();
+		int target = _texture_stream_target_mipmap(t, bias);
+
+		if (target != t->stream_first_mipmap && target != t->stream_requested_mipmap) {
+			t->stream_requested_mipmap = target;
+			t->stream_callback(t->stream_ud, target);
+		}
+	}
+}
+
 RID RasterizerStorageGLES3::texture_create_radiance_cubemap(RID p_source, int p_resolution) const {
 
 	Texture *texture = texture_owner.get(p_source);
@@ -2256,6 +2367,14 @@ void RasterizerStorageGLES3::_update_shader(Shader *p_shader) const {
 	ShaderCompilerGLES3::GeneratedCode gen_code;
 	ShaderCompilerGLES3::IdentifierActions *actions = NULL;
 
+	// Materials with generated code often share it, and it may have been compiled in a previous run.
+	String compiled_key = _get_compiled_shader_key(p_shader);
+
+	if (_load_compiled_shader(p_shader, compiled_key, gen_code)) {
+		_apply_shader_code(p_shader, gen_code);
+		return;
+	}
+
 	switch (p_shader->mode) {
 		case VS::SHADER_CANVAS_ITEM: {
 
@@ -2264,6 +2383,7 @@ void RasterizerStorageGLES3::_update_shader(Shader *p_shader) const {
 			p_shader->canvas_item.uses_screen_texture = false;
 			p_shader->canvas_item.uses_screen_uv = false;
 			p_shader->canvas_item.uses_time = false;
+			p_shader->canvas_item.uses_vertex = false;
 
 			shaders.actions_canvas.render_mode_values["blend_add"] = Pair<int *, int>(&p_shader->canvas_item.blend_mode, Shader::CanvasItem::BLEND_MODE_ADD);
 			shaders.actions_canvas.render_mode_values["blend_mix"] = Pair<int *, int>(&p_shader->canvas_item.blend_mode, Shader::CanvasItem::BLEND_MODE_MIX);
@@ -2279,6 +2399,7 @@ void RasterizerStorageGLES3::_update_shader(Shader *p_shader) const {
 			shaders.actions_canvas.usage_flag_pointers["SCREEN_PIXEL_SIZE"] = &p_shader->canvas_item.uses_screen_uv;
 			shaders.actions_canvas.usage_flag_pointers["SCREEN_TEXTURE"] = &p_shader->canvas_item.uses_screen_texture;
 			shaders.actions_canvas.usage_flag_pointers["TIME"] = &p_shader->canvas_item.uses_time;
+			shaders.actions_canvas.usage_flag_pointers["VERTEX"] = &p_shader->canvas_item.uses_vertex;
 
 			actions = &shaders.actions_canvas;
 			actions->uniforms = &p_shader->uniforms;
@@ -2303,6 +2424,8 @@ void RasterizerStorageGLES3::_update_shader(Shader *p_shader) const {
 			p_shader->spatial.uses_vertex = false;
 			p_shader->spatial.writes_modelview_or_projection = false;
 			p_shader->spatial.uses_world_coordinates = false;
+			p_shader->spatial.uses_world_matrix = false;
+			p_shader->spatial.uses_instance_id = false;
 
 			shaders.actions_scene.render_mode_values["blend_add"] = Pair<int *, int>(&p_shader->spatial.blend_mode, Shader::Spatial::BLEND_MODE_ADD);
 			shaders.actions_scene.render_mode_values["blend_mix"] = Pair<int *, int>(&p_shader->spatial.blend_mode, Shader::Spatial::BLEND_MODE_MIX);
@@ -2333,6 +2456,8 @@ void RasterizerStorageGLES3::_update_shader(Shader *p_shader) const {
 			shaders.actions_scene.usage_flag_pointers["SCREEN_TEXTURE"] = &p_shader->spatial.uses_screen_texture;
 			shaders.actions_scene.usage_flag_pointers["DEPTH_TEXTURE"] = &p_shader->spatial.uses_depth_texture;
 			shaders.actions_scene.usage_flag_pointers["TIME"] = &p_shader->spatial.uses_time;
+			shaders.actions_scene.usage_flag_pointers["WORLD_MATRIX"] = &p_shader->spatial.uses_world_matrix;
+			shaders.actions_scene.usage_flag_pointers["INSTANCE_ID"] = &p_shader->spatial.uses_instance_id;
 
 			shaders.actions_scene.write_flag_pointers["MODELVIEW_MATRIX"] = &p_shader->spatial.writes_modelview_or_projection;
 			shaders.actions_scene.write_flag_pointers["PROJECTION_MATRIX"] = &p_shader->spatial.writes_modelview_or_projection;
@@ -2356,16 +2481,23 @@ void RasterizerStorageGLES3::_update_shader(Shader *p_shader) const {
 		return;
 	}
 
-	p_shader->shader->set_custom_shader_code(p_shader->custom_code_id, gen_code.vertex, gen_code.vertex_global, gen_code.fragment, gen_code.light, gen_code.fragment_global, gen_code.uniforms, gen_code.texture_uniforms, gen_code.defines);
+	_store_compiled_shader(p_shader, compiled_key, gen_code);
+
+	_apply_shader_code(p_shader, gen_code);
+}
+
+void RasterizerStorageGLES3::_apply_shader_code(Shader *p_shader, const ShaderCompilerGLES3::GeneratedCode &p_gen_code) const {
+
+	p_shader->shader->set_custom_shader_code(p_shader->custom_code_id, p_gen_code.vertex, p_gen_code.vertex_global, p_gen_code.fragment, p_gen_code.light, p_gen_code.fragment_global, p_gen_code.uniforms, p_gen_code.texture_uniforms, p_gen_code.defines);
 
-	p_shader->ubo_size = gen_code.uniform_total_size;
-	p_shader->ubo_offsets = gen_code.uniform_offsets;
-	p_shader->texture_count = gen_code.texture_uniforms.size();
-	p_shader->texture_hints = gen_code.texture_hints;
-	p_shader->texture_types = gen_code.texture_types;
+	p_shader->ubo_size = p_gen_code.uniform_total_size;
+	p_shader->ubo_offsets = p_gen_code.uniform_offsets;
+	p_shader->texture_count = p_gen_code.texture_uniforms.size();
+	p_shader->texture_hints = p_gen_code.texture_hints;
+	p_shader->texture_types = p_gen_code.texture_types;
 
-	p_shader->uses_vertex_time = gen_code.uses_vertex_time;
-	p_shader->uses_fragment_time = gen_code.uses_fragment_time;
+	p_shader->uses_vertex_time = p_gen_code.uses_vertex_time;
+	p_shader->uses_fragment_time = p_gen_code.uses_fragment_time;
 
 	//all materials using this shader will have to be invalidated, unfortunately
 
@@ -2378,6 +2510,220 @@ void RasterizerStorageGLES3::_update_shader(Shader *p_shader) const {
 	p_shader->version++;
 }
 
+#define COMPILED_SHADER_MAGIC 0x43535347 // "GSSC"
+#define COMPILED_SHADER_FORMAT_VERSION 1
+#define COMPILED_SHADER_MAX_ENTRIES 1024
+
+String RasterizerStorageGLES3::_get_compiled_shader_key(const Shader *p_shader) const {
+
+	return itos(p_shader->mode) + ":" + p_shader->code.sha256_text();
+}
+
+bool RasterizerStorageGLES3::_load_compiled_shader(Shader *p_shader, const String &p_key, ShaderCompilerGLES3::GeneratedCode &r_gen_code) const {
+
+	const CompiledShader *compiled = compiled_shaders.getptr(p_key);
+
+	if (!compiled) {
+
+		ShaderCacheGLES3 *cache = ShaderCacheGLES3::get_singleton();
+		FileAccess *f = cache ? cache->open_code(p_key, false) : NULL;
+		if (!f) {
+			return false;
+		}
+
+		CompiledShader loaded;
+		bool valid = _read_compiled_shader(f, p_shader->mode, loaded);
+		memdelete(f);
+
+		if (!valid) {
+			cache->discard_code(p_key);
+			return false;
+		}
+
+		if (compiled_shaders.size() >= COMPILED_SHADER_MAX_ENTRIES) {
+			compiled_shaders.clear();
+		}
+		compiled_shaders[p_key] = loaded;
+		compiled = compiled_shaders.getptr(p_key);
+	}
+
+	r_gen_code = compiled->gen_code;
+	p_shader->uniforms = compiled->uniforms;
+
+	switch (p_shader->mode) {
+		case VS::SHADER_CANVAS_ITEM: {
+			p_shader->canvas_item = compiled->canvas_item;
+		} break;
+		case VS::SHADER_SPATIAL: {
+			p_shader->spatial = compiled->spatial;
+		} break;
+		default: {
+		}
+	}
+
+	return true;
+}
+
+void RasterizerStorageGLES3::_store_compiled_shader(const Shader *p_shader, const String &p_key, const ShaderCompilerGLES3::GeneratedCode &p_gen_code) const {
+
+	if (compiled_shaders.size() >= COMPILED_SHADER_MAX_ENTRIES) {
+		compiled_shaders.clear(); // editing shaders produces a stream of one-off variants, don't keep them all
+	}
+
+	CompiledShader &compiled = compiled_shaders[p_key];
+	compiled.gen_code = p_gen_code;
+	compiled.uniforms = p_shader->uniforms;
+	compiled.canvas_item = p_shader->canvas_item;
+	compiled.spatial = p_shader->spatial;
+
+	ShaderCacheGLES3 *cache = ShaderCacheGLES3::get_singleton();
+	FileAccess *f = cache ? cache->open_code(p_key, true) : NULL;
+	if (f) {
+		_write_compiled_shader(f, p_shader->mode, compiled);
+		memdelete(f);
+	}
+}
+
+void RasterizerStorageGLES3::_write_compiled_shader(FileAccess *p_file, VS::ShaderMode p_mode, const CompiledShader &p_compiled) const {
+
+	const ShaderCompilerGLES3::GeneratedCode &gen_code = p_compiled.gen_code;
+
+	p_file->store_32(COMPILED_SHADER_MAGIC);
+	p_file->store_32(COMPILED_SHADER_FORMAT_VERSION);
+	p_file->store_32(p_mode);
+
+	p_file->store_32(gen_code.defines.size());
+	for (int i = 0; i < gen_code.defines.size(); i++) {
+		p_file->store_pascal_string(String(gen_code.defines[i].get_data()));
+	}
+
+	p_file->store_32(gen_code.texture_uniforms.size());
+	for (int i = 0; i < gen_code.texture_uniforms.size(); i++) {
+		p_file->store_pascal_string(gen_code.texture_uniforms[i]);
+		p_file->store_32(gen_code.texture_types[i]);
+		p_file->store_32(gen_code.texture_hints[i]);
+	}
+
+	p_file->store_32(gen_code.uniform_offsets.size());
+	for (int i = 0; i < gen_code.uniform_offsets.size(); i++) {
+		p_file->store_32(gen_code.uniform_offsets[i]);
+	}
+	p_file->store_32(gen_code.uniform_total_size);
+
+	p_file->store_pascal_string(gen_code.uniforms);
+	p_file->store_pascal_string(gen_code.vertex_global);
+	p_file->store_pascal_string(gen_code.vertex);
+	p_file->store_pascal_string(gen_code.fragment_global);
+	p_file->store_pascal_string(gen_code.fragment);
+	p_file->store_pascal_string(gen_code.light);
+	p_file->store_8(gen_code.uses_fragment_time);
+	p_file->store_8(gen_code.uses_vertex_time);
+
+	p_file->store_32(p_compiled.uniforms.size());
+	for (const Map<StringName, ShaderLanguage::ShaderNode::Uniform>::Element *E = p_compiled.uniforms.front(); E; E = E->next()) {
+
+		const ShaderLanguage::ShaderNode::Uniform &u = E->get();
+		p_file->store_pascal_string(E->key());
+		p_file->store_32(u.order);
+		p_file->store_32(u.texture_order);
+		p_file->store_32(u.type);
+		p_file->store_32(u.precision);
+		p_file->store_32(u.hint);
+		for (int i = 0; i < 3; i++) {
+			p_file->store_float(u.hint_range[i]);
+		}
+		p_file->store_32(u.default_value.size());
+		for (int i = 0; i < u.default_value.size(); i++) {
+			p_file->store_32(u.default_value[i].uint);
+		}
+	}
+
+	// Plain flag structs, the format version covers layout changes.
+	p_file->store_32(sizeof(Shader::CanvasItem));
+	p_file->store_buffer((const uint8_t *)&p_compiled.canvas_item, sizeof(Shader::CanvasItem));
+	p_file->store_32(sizeof(Shader::Spatial));
+	p_file->store_buffer((const uint8_t *)&p_compiled.spatial, sizeof(Shader::Spatial));
+
+	p_file->store_32(COMPILED_SHADER_MAGIC);
+}
+
+bool RasterizerStorageGLES3::_read_compiled_shader(FileAccess *p_file, VS::ShaderMode p_mode, CompiledShader &r_compiled) const {
+
+	// Counts are bounded by the file size so a damaged file can't request huge allocations.
+	uint32_t max_count = p_file->get_len();
+
+	if (p_file->get_32() != COMPILED_SHADER_MAGIC || p_file->get_32() != COMPILED_SHADER_FORMAT_VERSION || p_file->get_32() != (uint32_t)p_mode) {
+		return false;
+	}
+
+	ShaderCompilerGLES3::GeneratedCode &gen_code = r_compiled.gen_code;
+
+	uint32_t count = p_file->get_32();
+	ERR_FAIL_COND_V(count > max_count, false);
+	for (uint32_t i = 0; i < count; i++) {
+		gen_code.defines.push_back(p_file->get_pascal_string().utf8());
+	}
+
+	count = p_file->get_32();
+	ERR_FAIL_COND_V(count > max_count, false);
+	for (uint32_t i = 0; i < count; i++) {
+		gen_code.texture_uniforms.push_back(p_file->get_pascal_string());
+		gen_code.texture_types.push_back(ShaderLanguage::DataType(p_file->get_32()));
+		gen_code.texture_hints.push_back(ShaderLanguage::ShaderNode::Uniform::Hint(p_file->get_32()));
+	}
+
+	count = p_file->get_32();
+	ERR_FAIL_COND_V(count > max_count, false);
+	gen_code.uniform_offsets.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		gen_code.uniform_offsets.write[i] = p_file->get_32();
+	}
+	gen_code.uniform_total_size = p_file->get_32();
+
+	gen_code.uniforms = p_file->get_pascal_string();
+	gen_code.vertex_global = p_file->get_pascal_string();
+	gen_code.vertex = p_file->get_pascal_string();
+	gen_code.fragment_global = p_file->get_pascal_string();
+	gen_code.fragment = p_file->get_pascal_string();
+	gen_code.light = p_file->get_pascal_string();
+	gen_code.uses_fragment_time = p_file->get_8();
+	gen_code.uses_vertex_time = p_file->get_8();
+
+	count = p_file->get_32();
+	ERR_FAIL_COND_V(count > max_count, false);
+	for (uint32_t i = 0; i < count; i++) {
+
+		StringName name = p_file->get_pascal_string();
+		ShaderLanguage::ShaderNode::Uniform &u = r_compiled.uniforms[name];
+		u.order = p_file->get_32();
+		u.texture_order = p_file->get_32();
+		u.type = ShaderLanguage::DataType(p_file->get_32());
+		u.precision = ShaderLanguage::DataPrecision(p_file->get_32());
+		u.hint = ShaderLanguage::ShaderNode::Uniform::Hint(p_file->get_32());
+		for (int j = 0; j < 3; j++) {
+			u.hint_range[j] = p_file->get_float();
+		}
+
+		uint32_t value_count = p_file->get_32();
+		ERR_FAIL_COND_V(value_count > max_count, false);
+		u.default_value.resize(value_count);
+		for (uint32_t j = 0; j < value_count; j++) {
+			u.default_value.write[j].uint = p_file->get_32();
+		}
+	}
+
+	if (p_file->get_32() != sizeof(Shader::CanvasItem)) {
+		return false;
+	}
+	p_file->get_buffer((uint8_t *)&r_compiled.canvas_item, sizeof(Shader::CanvasItem));
+	if (p_file->get_32() != sizeof(Shader::Spatial)) {
+		return false;
+	}
+	p_file->get_buffer((uint8_t *)&r_compiled.spatial, sizeof(Shader::Spatial));
+
+	return p_file->get_32() == COMPILED_SHADER_MAGIC;
+}
+
 void RasterizerStorageGLES3::update_dirty_shaders() {
 
 	while (_shader_dirty_list.first()) {
@@ -3901,6 +4247,10 @@ void RasterizerStorageGLES3::mesh_surface_set_material(RID p_mesh, int p_surface
 
 	mesh->surfaces[p_surface]->material = p_material;
 
+	for (int i = 0; i < mesh->surfaces[p_surface]->lods.size(); i++) {
+		mesh->surfaces[p_surface]->lods[i].surface->material = p_material;
+	}
+
 	if (mesh->surfaces[p_surface]->material.is_valid()) {
 		_material_add_geometry(mesh->surfaces[p_surface]->material, mesh->surfaces[p_surface]);
 	}
@@ -4069,6 +4419,122 @@ Vector<AABB> RasterizerStorageGLES3::mesh_surface_get_skeleton_aabb(RID p_mesh,
 	return mesh->surfaces[p_surface]->skeleton_bone_aabb;
 }
 
+void RasterizerStorageGLES3::_mesh_surface_clear_lods(Surface *p_surface) {
+
+	for (int i = 0; i < p_surface->lods.size(); i++) {
+
+		Surface *lod = p_surface->lods[i].surface;
+
+		//the vertex buffer belongs to the base surface
+		glDeleteBuffers(1, &lod->index_id);
+		glDeleteVertexArrays(1, &lod->array_id);
+		glDeleteVertexArrays(1, &lod->instancing_array_id);
+
+		info.vertex_mem -= lod->total_data_size;
+
+		memdelete(lod);
+	}
+
+	p_surface->lods.clear();
+}
+
+void RasterizerStorageGLES3::mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_edge_lengths, const Vector<PoolVector<uint8_t> > &p_index_arrays) {
+
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_INDEX(p_surface, mesh->surfaces.size());
+	ERR_FAIL_COND(p_edge_lengths.size() != p_index_arrays.size());
+
+	Surface *surface = mesh->surfaces[p_surface];
+
+	_mesh_surface_clear_lods(surface);
+
+	if (p_index_arrays.size() == 0) {
+		mesh->instance_change_notify(false, true);
+		return;
+	}
+
+	ERR_FAIL_COND_MSG(!surface->index_id || surface->primitive != VS::PRIMITIVE_TRIANGLES, "LODs need an indexed triangle surface.");
+	ERR_FAIL_COND_MSG(surface->blend_shapes.size(), "LODs are not supported on surfaces with blend shapes.");
+
+	int index_size = surface->array_len >= (1 << 16) ? 4 : 2;
+
+	for (int i = 0; i < p_index_arrays.size(); i++) {
+
+		const PoolVector<uint8_t> &index_array = p_index_arrays[i];
+		ERR_CONTINUE(index_array.size() == 0 || index_array.size() % (index_size * 3) != 0);
+
+		Surface *lod = memnew(Surface);
+
+		for (int j = 0; j < VS::ARRAY_MAX; j++) {
+			lod->attribs[j] = surface->attribs[j];
+		}
+		lod->mesh = mesh;
+		lod->format = surface->format;
+		lod->material = surface->material;
+		lod->vertex_id = surface->vertex_id;
+		lod->aabb = surface->aabb;
+		lod->array_len = surface->array_len;
+		lod->index_array_len = index_array.size() / index_size;
+		lod->max_bone = surface->max_bone;
+		lod->array_byte_size = surface->array_byte_size;
+		lod->index_array_byte_size = index_array.size();
+		lod->primitive = surface->primitive;
+		lod->skeleton_bone_aabb = surface->skeleton_bone_aabb;
+		lod->skeleton_bone_used = surface->skeleton_bone_used;
+		lod->active = true;
+		lod->total_data_size = index_array.size();
+
+		{
+			PoolVector<uint8_t>::Read ir = index_array.read();
+
+			glGenBuffers(1, &lod->index_id);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod->index_id);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_array.size(), ir.ptr(), GL_STATIC_DRAW);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //unbind
+		}
+
+		//same layout as the base surface, only the index buffer differs
+
+		for (int ai = 0; ai < 2; ai++) {
+
+			GLuint *array_id = ai == 0 ? &lod->array_id : &lod->instancing_array_id;
+			glGenVertexArrays(1, array_id);
+			glBindVertexArray(*array_id);
+			glBindBuffer(GL_ARRAY_BUFFER, lod->vertex_id);
+
+			for (int j = 0; j < VS::ARRAY_MAX - 1; j++) {
+
+				const Surface::Attrib &attrib = lod->attribs[j];
+				if (!attrib.enabled)
+					continue;
+
+				if (attrib.integer) {
+					glVertexAttribIPointer(attrib.index, attrib.size, attrib.type, attrib.stride, CAST_INT_TO_UCHAR_PTR(attrib.offset));
+				} else {
+					glVertexAttribPointer(attrib.index, attrib.size, attrib.type, attrib.normalized, attrib.stride, CAST_INT_TO_UCHAR_PTR(attrib.offset));
+				}
+				glEnableVertexAttribArray(attrib.index);
+			}
+
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod->index_id);
+
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		}
+
+		info.vertex_mem += lod->total_data_size;
+
+		Surface::LOD l;
+		l.edge_length = p_edge_lengths[i];
+		l.surface = lod;
+		surface->lods.push_back(l);
+	}
+
+	mesh->instance_change_notify(false, true);
+}
+
 void RasterizerStorageGLES3::mesh_remove_surface(RID p_mesh, int p_surface) {
 
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
@@ -4081,6 +4547,8 @@ void RasterizerStorageGLES3::mesh_remove_surface(RID p_mesh, int p_surface) {
 		_material_remove_geometry(surface->material, mesh->surfaces[p_surface]);
 	}
 
+	_mesh_surface_clear_lods(surface);
+
 	glDeleteBuffers(1, &surface->vertex_id);
 	if (surface->index_id) {
 		glDeleteBuffers(1, &surface->index_id);
@@ -4611,12 +5079,12 @@ void RasterizerStorageGLES3::multimesh_allocate(RID p_multimesh, int p_instances
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
+	int region_count = (multimesh->size + MULTIMESH_DIRTY_REGION_SIZE - 1) / MULTIMESH_DIRTY_REGION_SIZE;
+	multimesh->dirty_regions.resize(region_count);
+	multimesh->region_aabbs.resize(region_count);
+	multimesh->dirty_region_aabbs = true;
 
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_all_dirty(multimesh, true);
 }
 
 int RasterizerStorageGLES3::multimesh_get_instance_count(RID p_multimesh) const {
@@ -4649,6 +5117,7 @@ void RasterizerStorageGLES3::multimesh_set_mesh(RID p_multimesh, RID p_mesh) {
 	}
 
 	multimesh->dirty_aabb = true;
+	multimesh->dirty_region_aabbs = true;
 
 	if (!multimesh->update_list.in_list()) {
 		multimesh_update_list.add(&multimesh->update_list);
@@ -4678,12 +5147,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_transform(RID p_multimesh, i
 	dataptr[10] = p_transform.basis.elements[2][2];
 	dataptr[11] = p_transform.origin.z;
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, true);
 }
 
 void RasterizerStorageGLES3::multimesh_instance_set_transform_2d(RID p_multimesh, int p_index, const Transform2D &p_transform) {
@@ -4705,12 +5169,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_transform_2d(RID p_multimesh
 	dataptr[6] = 0;
 	dataptr[7] = p_transform.elements[2][1];
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, true);
 }
 void RasterizerStorageGLES3::multimesh_instance_set_color(RID p_multimesh, int p_index, const Color &p_color) {
 
@@ -4738,12 +5197,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_color(RID p_multimesh, int p
 		dataptr[3] = p_color.a;
 	}
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, false);
 }
 
 void RasterizerStorageGLES3::multimesh_instance_set_custom_data(RID p_multimesh, int p_index, const Color &p_custom_data) {
@@ -4772,12 +5226,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_custom_data(RID p_multimesh,
 		dataptr[3] = p_custom_data.a;
 	}
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, false);
 }
 RID RasterizerStorageGLES3::multimesh_get_mesh(RID p_multimesh) const {
 
@@ -4914,14 +5363,28 @@ void RasterizerStorageGLES3::multimesh_set_as_bulk_array(RID p_multimesh, const
 	ERR_FAIL_COND(dsize != p_array.size());
 
 	PoolVector<float>::Read r = p_array.read();
-	copymem(multimesh->data.ptrw(), r.ptr(), dsize * sizeof(float));
+	ERR_FAIL_COND(!r.ptr());
+	_multimesh_write_instances(multimesh, 0, multimesh->size, r.ptr());
+}
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
+void RasterizerStorageGLES3::multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) {
 
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+	ERR_FAIL_COND(!multimesh->data.ptr());
+
+	int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
+	ERR_FAIL_COND_MSG(p_array.size() % stride != 0, "Array size must be a multiple of the floats used by one instance.");
+
+	int count = p_array.size() / stride;
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + count > multimesh->size);
+
+	if (count == 0) {
+		return;
 	}
+
+	PoolVector<float>::Read r = p_array.read();
+	_multimesh_write_instances(multimesh, p_from_instance, count, r.ptr());
 }
 
 void RasterizerStorageGLES3::multimesh_set_visible_instances(RID p_multimesh, int p_visible) {
@@ -4949,83 +5412,210 @@ AABB RasterizerStorageGLES3::multimesh_get_aabb(RID p_multimesh) const {
 	return multimesh->aabb;
 }
 
-void RasterizerStorageGLES3::update_dirty_multimeshes() {
+void RasterizerStorageGLES3::_multimesh_mark_dirty(MultiMesh *p_multimesh, int p_index, bool p_aabb) {
 
-	while (multimesh_update_list.first()) {
+	int region = p_index / MULTIMESH_DIRTY_REGION_SIZE;
 
-		MultiMesh *multimesh = multimesh_update_list.first()->self();
+	if (!p_multimesh->dirty_regions[region]) {
+		p_multimesh->dirty_regions.write[region] = true;
+		p_multimesh->dirty_region_count++;
+	}
 
-		if (multimesh->size && multimesh->dirty_data) {
+	p_multimesh->dirty_data = true;
+	if (p_aabb) {
+		p_multimesh->dirty_aabb = true;
+	}
 
-			glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer);
-			glBufferSubData(GL_ARRAY_BUFFER, 0, multimesh->data.size() * sizeof(float), multimesh->data.ptr());
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
-		}
+	if (!p_multimesh->update_list.in_list()) {
+		multimesh_update_list.add(&p_multimesh->update_list);
+	}
+}
 
-		if (multimesh->size && multimesh->dirty_aabb) {
+void RasterizerStorageGLES3::_multimesh_mark_all_dirty(MultiMesh *p_multimesh, bool p_aabb) {
 
-			AABB mesh_aabb;
+	int region_count = p_multimesh->dirty_regions.size();
+	bool *dirty = p_multimesh->dirty_regions.ptrw();
 
-			if (multimesh->mesh.is_valid()) {
-				mesh_aabb = mesh_get_aabb(multimesh->mesh, RID());
-			} else {
-				mesh_aabb.size += Vector3(0.001, 0.001, 0.001);
-			}
+	for (int i = 0; i < region_count; i++) {
+		dirty[i] = true;
+	}
+	p_multimesh->dirty_region_count = region_count;
 
-			int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
-			int count = multimesh->data.size();
-			float *data = multimesh->data.ptrw();
+	p_multimesh->dirty_data = true;
+	if (p_aabb) {
+		p_multimesh->dirty_aabb = true;
+	}
 
-			AABB aabb;
+	if (!p_multimesh->update_list.in_list()) {
+		multimesh_update_list.add(&p_multimesh->update_list);
+	}
+}
 
-			if (multimesh->transform_format == VS::MULTIMESH_TRANSFORM_2D) {
+void RasterizerStorageGLES3::_multimesh_write_instances(MultiMesh *p_multimesh, int p_from, int p_count, const float *p_data) {
+
+	//compared region by region, so rewriting mostly unchanged data only dirties what really changed
+	int stride = p_multimesh->color_floats + p_multimesh->xform_floats + p_multimesh->custom_data_floats;
+	float *data = p_multimesh->data.ptrw();
+	int end = p_from + p_count;
+
+	for (int from = p_from; from < end;) {
+
+		int to = MIN((from / MULTIMESH_DIRTY_REGION_SIZE + 1) * MULTIMESH_DIRTY_REGION_SIZE, end);
+		const float *src = &p_data[(from - p_from) * stride];
+		float *dst = &data[from * stride];
+		size_t bytes = (to - from) * stride * sizeof(float);
+
+		if (memcmp(dst, src, bytes) != 0) {
+			copymem(dst, src, bytes);
+			_multimesh_mark_dirty(p_multimesh, from, true);
+		}
+
+		from = to;
+	}
+}
+
+AABB RasterizerStorageGLES3::_multimesh_get_region_aabb(const MultiMesh *p_multimesh, int p_region, const AABB &p_mesh_aabb) const {
+
+	int stride = p_multimesh->color_floats + p_multimesh->xform_floats + p_multimesh->custom_data_floats;
+	int from = p_region * MULTIMESH_DIRTY_REGION_SIZE * stride;
+	int to = MIN((p_region + 1) * MULTIMESH_DIRTY_REGION_SIZE, p_multimesh->size) * stride;
+	const float *data = p_multimesh->data.ptr();
 
-				for (int i = 0; i < count; i += stride) {
-
-					float *dataptr = &data[i];
-					Transform xform;
-					xform.basis[0][0] = dataptr[0];
-					xform.basis[0][1] = dataptr[1];
-					xform.origin[0] = dataptr[3];
-					xform.basis[1][0] = dataptr[4];
-					xform.basis[1][1] = dataptr[5];
-					xform.origin[1] = dataptr[7];
-
-					AABB laabb = xform.xform(mesh_aabb);
-					if (i == 0)
-						aabb = laabb;
-					else
-						aabb.merge_with(laabb);
+	AABB aabb;
+
+	if (p_multimesh->transform_format == VS::MULTIMESH_TRANSFORM_2D) {
+
+		for (int i = from; i < to; i += stride) {
+
+			const float *dataptr = &data[i];
+
+			Transform xform;
+			xform.basis[0][0] = dataptr[0];
+			xform.basis[0][1] = dataptr[1];
+			xform.origin[0] = dataptr[3];
+			xform.basis[1][0] = dataptr[4];
+			xform.basis[1][1] = dataptr[5];
+			xform.origin[1] = dataptr[7];
+
+			AABB laabb = xform.xform(p_mesh_aabb);
+
+			if (i == from) {
+				aabb = laabb;
+			} else {
+				aabb.merge_with(laabb);
+			}
+		}
+
+	} else {
+
+		for (int i = from; i < to; i += stride) {
+
+			const float *dataptr = &data[i];
+
+			Transform xform;
+			xform.basis.elements[0][0] = dataptr[0];
+			xform.basis.elements[0][1] = dataptr[1];
+			xform.basis.elements[0][2] = dataptr[2];
+			xform.origin.x = dataptr[3];
+			xform.basis.elements[1][0] = dataptr[4];
+			xform.basis.elements[1][1] = dataptr[5];
+			xform.basis.elements[1][2] = dataptr[6];
+			xform.origin.y = dataptr[7];
+			xform.basis.elements[2][0] = dataptr[8];
+			xform.basis.elements[2][1] = dataptr[9];
+			xform.basis.elements[2][2] = dataptr[10];
+			xform.origin.z = dataptr[11];
+
+			AABB laabb = xform.xform(p_mesh_aabb);
+
+			if (i == from) {
+				aabb = laabb;
+			} else {
+				aabb.merge_with(laabb);
+			}
+		}
+	}
+
+	return aabb;
+}
+
+void RasterizerStorageGLES3::update_dirty_multimeshes() {
+
+	while (multimesh_update_list.first()) {
+
+		MultiMesh *multimesh = multimesh_update_list.first()->self();
+
+		if (multimesh->size && multimesh->dirty_data) {
+
+			int region_count = multimesh->dirty_regions.size();
+
+			glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer);
+
+			if (multimesh->dirty_region_count * 2 > region_count) {
+				//most of it changed, one upload is cheaper
+				glBufferSubData(GL_ARRAY_BUFFER, 0, multimesh->data.size() * sizeof(float), multimesh->data.ptr());
+			} else {
+
+				int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
+				const bool *dirty = multimesh->dirty_regions.ptr();
+				const float *data = multimesh->data.ptr();
+
+				for (int i = 0; i < region_count; i++) {
+
+					if (!dirty[i])
+						continue;
+
+					//consecutive dirty regions go in a single upload
+					int from = i * MULTIMESH_DIRTY_REGION_SIZE * stride;
+					while (i + 1 < region_count && dirty[i + 1]) {
+						i++;
+					}
+					int to = MIN((i + 1) * MULTIMESH_DIRTY_REGION_SIZE, multimesh->size) * stride;
+
+					glBufferSubData(GL_ARRAY_BUFFER, from * sizeof(float), (to - from) * sizeof(float), &data[from]);
 				}
+			}
+
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		if (multimesh->size && multimesh->dirty_aabb) {
+
+			AABB mesh_aabb;
+
+			if (multimesh->mesh.is_valid()) {
+				mesh_aabb = mesh_get_aabb(multimesh->mesh, RID());
 			} else {
+				mesh_aabb.size += Vector3(0.001, 0.001, 0.001);
+			}
+
+			//only regions with changed instances are recomputed, unless the mesh changed
+			int region_count = multimesh->region_aabbs.size();
+			const bool *dirty = multimesh->dirty_regions.ptr();
+			AABB *region_aabbs = multimesh->region_aabbs.ptrw();
+
+			AABB aabb;
+
+			for (int i = 0; i < region_count; i++) {
 
-				for (int i = 0; i < count; i += stride) {
-
-					float *dataptr = &data[i];
-					Transform xform;
-
-					xform.basis.elements[0][0] = dataptr[0];
-					xform.basis.elements[0][1] = dataptr[1];
-					xform.basis.elements[0][2] = dataptr[2];
-					xform.origin.x = dataptr[3];
-					xform.basis.elements[1][0] = dataptr[4];
-					xform.basis.elements[1][1] = dataptr[5];
-					xform.basis.elements[1][2] = dataptr[6];
-					xform.origin.y = dataptr[7];
-					xform.basis.elements[2][0] = dataptr[8];
-					xform.basis.elements[2][1] = dataptr[9];
-					xform.basis.elements[2][2] = dataptr[10];
-					xform.origin.z = dataptr[11];
-
-					AABB laabb = xform.xform(mesh_aabb);
-					if (i == 0)
-						aabb = laabb;
-					else
-						aabb.merge_with(laabb);
+				if (multimesh->dirty_region_aabbs || dirty[i]) {
+					region_aabbs[i] = _multimesh_get_region_aabb(multimesh, i, mesh_aabb);
+				}
+
+				if (i == 0) {
+					aabb = region_aabbs[i];
+				} else {
+					aabb.merge_with(region_aabbs[i]);
 				}
 			}
 
 			multimesh->aabb = aabb;
+			multimesh->dirty_region_aabbs = false;
+		}
+
+		if (multimesh->dirty_region_count) {
+			zeromem(multimesh->dirty_regions.ptrw(), multimesh->dirty_regions.size() * sizeof(bool));
+			multimesh->dirty_region_count = 0;
 		}
 		multimesh->dirty_aabb = false;
 		multimesh->dirty_data = false;
@@ -5263,6 +5853,43 @@ void RasterizerStorageGLES3::skeleton_bone_set_transform(RID p_skeleton, int p_b
 	}
 }
 
+void RasterizerStorageGLES3::skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms) {
+
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+
+	ERR_FAIL_COND(!skeleton);
+	ERR_FAIL_COND(p_transforms.size() > skeleton->size);
+	ERR_FAIL_COND(skeleton->use_2d);
+
+	float *texture = skeleton->skel_texture.ptrw();
+	const Transform *transforms = p_transforms.ptr();
+
+	for (int i = 0; i < p_transforms.size(); i++) {
+
+		const Transform &xform = transforms[i];
+		int base_ofs = ((i / 256) * 256) * 3 * 4 + (i % 256) * 4;
+
+		texture[base_ofs + 0] = xform.basis[0].x;
+		texture[base_ofs + 1] = xform.basis[0].y;
+		texture[base_ofs + 2] = xform.basis[0].z;
+		texture[base_ofs + 3] = xform.origin.x;
+		base_ofs += 256 * 4;
+		texture[base_ofs + 0] = xform.basis[1].x;
+		texture[base_ofs + 1] = xform.basis[1].y;
+		texture[base_ofs + 2] = xform.basis[1].z;
+		texture[base_ofs + 3] = xform.origin.y;
+		base_ofs += 256 * 4;
+		texture[base_ofs + 0] = xform.basis[2].x;
+		texture[base_ofs + 1] = xform.basis[2].y;
+		texture[base_ofs + 2] = xform.basis[2].z;
+		texture[base_ofs + 3] = xform.origin.z;
+	}
+
+	if (!skeleton->update_list.in_list()) {
+		skeleton_update_list.add(&skeleton->update_list);
+	}
+}
+
 Transform RasterizerStorageGLES3::skeleton_bone_get_transform(RID p_skeleton, int p_bone) const {
 
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
@@ -6309,12 +6936,22 @@ void RasterizerStorageGLES3::particles_set_amount(RID p_particles, int p_amount)
 
 	glBindVertexArray(0);
 
+	if (particles->particle_sort_buffer) {
+
+		glBindBuffer(GL_ARRAY_BUFFER, particles->particle_sort_buffer);
+		glBufferData(GL_ARRAY_BUFFER, floats * sizeof(float), NULL, GL_DYNAMIC_COPY);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		particles->particle_sort_valid = false;
+	}
+
 	particles->prev_ticks = 0;
 	particles->phase = 0;
 	particles->prev_phase = 0;
 	particles->clear = true;
 
 	memdelete_arr(data);
+
+	_particles_update_histories(particles); //the amount decides whether sorting can happen on the GPU
 }
 
 void RasterizerStorageGLES3::particles_set_lifetime(RID p_particles, float p_lifetime) {
@@ -6352,7 +6989,24 @@ void RasterizerStorageGLES3::particles_set_randomness_ratio(RID p_particles, flo
 
 void RasterizerStorageGLES3::_particles_update_histories(Particles *particles) {
 
-	bool needs_histories = particles->draw_order == VS::PARTICLES_DRAW_ORDER_VIEW_DEPTH;
+	//view depth order is sorted on the GPU when possible, reading back the histories to sort them on the CPU is the fallback
+	bool needs_sort = particles->draw_order == VS::PARTICLES_DRAW_ORDER_VIEW_DEPTH;
+	bool sort_on_gpu = needs_sort && _particles_can_sort_on_gpu(particles->amount);
+	bool needs_histories = needs_sort && !sort_on_gpu;
+
+	if (sort_on_gpu != (particles->particle_sort_buffer != 0)) {
+
+		if (sort_on_gpu) {
+			glGenBuffers(1, &particles->particle_sort_buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, particles->particle_sort_buffer);
+			glBufferData(GL_ARRAY_BUFFER, particles->amount * 24 * sizeof(float), NULL, GL_DYNAMIC_COPY);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		} else {
+			glDeleteBuffers(1, &particles->particle_sort_buffer);
+			particles->particle_sort_buffer = 0;
+		}
+		particles->particle_sort_valid = false;
+	}
 
 	if (needs_histories == particles->histories_enabled)
 		return;
@@ -6389,6 +7043,164 @@ void RasterizerStorageGLES3::_particles_update_histories(Particles *particles) {
 	particles->clear = true;
 }
 
+bool RasterizerStorageGLES3::_particles_can_sort_on_gpu(int p_amount) const {
+
+	if (!config.framebuffer_float_supported || p_amount <= 0)
+		return false;
+
+	int key_rows = MAX(next_power_of_2(p_amount) / 1024, 1);
+	int data_rows = (p_amount + 255) / 256;
+
+	return key_rows <= config.max_texture_size && data_rows <= config.max_texture_size && 256 * 6 <= config.max_texture_size;
+}
+
+bool RasterizerStorageGLES3::particles_sort_by_depth(Particles *p_particles, const Vector3 &p_sort_direction) {
+
+	if (!p_particles->particle_sort_buffer)
+		return false;
+
+	int amount = p_particles->amount;
+	int keys = next_power_of_2(amount);
+	int key_width = MIN(keys, 1024);
+	int key_rows = keys / key_width;
+	int data_rows = (amount + 255) / 256;
+
+	//the sort targets are shared by all particle systems and grow to fit the largest one
+
+	if (particle_sort.data_rows < data_rows) {
+
+		if (!particle_sort.data_texture) {
+			glGenTextures(1, &particle_sort.data_texture);
+		}
+
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, particle_sort.data_texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 256 * 6, data_rows, 0, GL_RGBA, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		particle_sort.data_rows = data_rows;
+	}
+
+	if (particle_sort.key_rows < key_rows) {
+
+		for (int i = 0; i < 2; i++) {
+
+			if (!particle_sort.key_textures[i]) {
+				glGenTextures(1, &particle_sort.key_textures[i]);
+				glGenFramebuffers(1, &particle_sort.key_fbos[i]);
+			}
+
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, particle_sort.key_textures[i]);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32F, 1024, key_rows, 0, GL_RG, GL_FLOAT, NULL);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+			glBindFramebuffer(GL_FRAMEBUFFER, particle_sort.key_fbos[i]);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, particle_sort.key_textures[i], 0);
+		}
+
+		particle_sort.key_rows = key_rows;
+	}
+
+	if (!particle_sort.empty_array) {
+		glGenVertexArrays(1, &particle_sort.empty_array);
+	}
+
+	//copy the simulated particles into the data texture, this stays on the GPU
+
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, particle_sort.data_texture);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, p_particles->particle_buffers[0]);
+
+	int full_rows = amount / 256;
+	if (full_rows) {
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256 * 6, full_rows, GL_RGBA, GL_FLOAT, NULL);
+	}
+	if (amount % 256) {
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, full_rows, (amount % 256) * 6, 1, GL_RGBA, GL_FLOAT, CAST_INT_TO_UCHAR_PTR(full_rows * 256 * 24 * sizeof(float)));
+	}
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	bool cull_enabled = glIsEnabled(GL_CULL_FACE);
+	glDisable(GL_CULL_FACE);
+	glDisable(GL_BLEND);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_SCISSOR_TEST);
+
+	glViewport(0, 0, key_width, key_rows);
+	glBindVertexArray(resources.quadie_array);
+
+	//write the (depth, index) keys, padded to a power of two
+
+	shaders.particles_sort.set_conditional(ParticlesSortShaderGLES3::USE_KEYS, true);
+	shaders.particles_sort.bind();
+	shaders.particles_sort.set_uniform(ParticlesSortShaderGLES3::SORT_WIDTH, key_width);
+	shaders.particles_sort.set_uniform(ParticlesSortShaderGLES3::TOTAL_PARTICLES, amount);
+	shaders.particles_sort.set_uniform(ParticlesSortShaderGLES3::SORT_DIRECTION, p_sort_direction);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, particle_sort.key_fbos[0]);
+	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+
+	//bitonic sort, one pass per compare and exchange step
+
+	shaders.particles_sort.set_conditional(ParticlesSortShaderGLES3::USE_KEYS, false);
+	shaders.particles_sort.bind();
+	shaders.particles_sort.set_uniform(ParticlesSortShaderGLES3::SORT_WIDTH, key_width);
+
+	glActiveTexture(GL_TEXTURE0);
+	int source = 0;
+
+	for (int stage = 2; stage <= keys; stage <<= 1) {
+		for (int step = stage >> 1; step > 0; step >>= 1) {
+
+			glBindTexture(GL_TEXTURE_2D, particle_sort.key_textures[source]);
+			glBindFramebuffer(GL_FRAMEBUFFER, particle_sort.key_fbos[source ^ 1]);
+			shaders.particles_sort.set_uniform(ParticlesSortShaderGLES3::SORT_STAGE, stage);
+			shaders.particles_sort.set_uniform(ParticlesSortShaderGLES3::SORT_STEP, step);
+			glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+			source ^= 1;
+		}
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, RasterizerStorageGLES3::system_fbo);
+
+	//gather the particles in sorted order into the buffer that is drawn instead of the simulated one
+
+	shaders.particles_sort.set_conditional(ParticlesSortShaderGLES3::USE_GATHER, true);
+	shaders.particles_sort.bind();
+	shaders.particles_sort.set_uniform(ParticlesSortShaderGLES3::SORT_WIDTH, key_width);
+
+	glBindTexture(GL_TEXTURE_2D, particle_sort.key_textures[source]);
+
+	glEnable(GL_RASTERIZER_DISCARD);
+	glBindVertexArray(particle_sort.empty_array);
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, p_particles->particle_sort_buffer);
+
+	glBeginTransformFeedback(GL_POINTS);
+	glDrawArrays(GL_POINTS, 0, amount);
+	glEndTransformFeedback();
+
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+	glBindVertexArray(0);
+	glDisable(GL_RASTERIZER_DISCARD);
+
+	shaders.particles_sort.set_conditional(ParticlesSortShaderGLES3::USE_GATHER, false);
+
+	if (cull_enabled) {
+		glEnable(GL_CULL_FACE);
+	}
+
+	p_particles->particle_sort_valid = true;
+	return true;
+}
+
 void RasterizerStorageGLES3::particles_set_custom_aabb(RID p_particles, const AABB &p_aabb) {
 
 	Particles *particles = particles_owner.getornull(p_particles);
@@ -6429,6 +7241,23 @@ void RasterizerStorageGLES3::particles_set_fractional_delta(RID p_particles, boo
 	particles->fractional_delta = p_enable;
 }
 
+void RasterizerStorageGLES3::particles_set_collision_heightfield(RID p_particles, RID p_texture, const AABB &p_aabb) {
+
+	Particles *particles = particles_owner.getornull(p_particles);
+	ERR_FAIL_COND(!particles);
+
+	particles->collision_heightfield = p_texture;
+	particles->collision_aabb = p_aabb;
+}
+
+void RasterizerStorageGLES3::particles_set_collision_bounce(RID p_particles, float p_bounce) {
+
+	Particles *particles = particles_owner.getornull(p_particles);
+	ERR_FAIL_COND(!particles);
+
+	particles->collision_bounce = p_bounce;
+}
+
 void RasterizerStorageGLES3::particles_set_process_material(RID p_particles, RID p_material) {
 
 	Particles *particles = particles_owner.getornull(p_particles);
@@ -6742,10 +7571,27 @@ void RasterizerStorageGLES3::update_particles() {
 			}
 		}
 
+		Texture *height_field = texture_owner.getornull(particles->collision_heightfield);
+		if (height_field) {
+			height_field = height_field->get_ptr(); //resolve for proxies
+			if (height_field->target != GL_TEXTURE_2D)
+				height_field = NULL;
+		}
+
 		shaders.particles.set_conditional(ParticlesShaderGLES3::USE_FRACTIONAL_DELTA, particles->fractional_delta);
+		shaders.particles.set_conditional(ParticlesShaderGLES3::USE_COLLISION_HEIGHTFIELD, height_field != NULL);
 
 		shaders.particles.bind();
 
+		if (height_field) {
+			glActiveTexture(GL_TEXTURE0 + config.max_texture_image_units - 1);
+			glBindTexture(GL_TEXTURE_2D, height_field->tex_id);
+
+			shaders.particles.set_uniform(ParticlesShaderGLES3::HEIGHT_FIELD_POSITION, particles->collision_aabb.position);
+			shaders.particles.set_uniform(ParticlesShaderGLES3::HEIGHT_FIELD_SIZE, particles->collision_aabb.size);
+			shaders.particles.set_uniform(ParticlesShaderGLES3::COLLISION_BOUNCE, particles->collision_bounce);
+		}
+
 		shaders.particles.set_uniform(ParticlesShaderGLES3::TOTAL_PARTICLES, particles->amount);
 		shaders.particles.set_uniform(ParticlesShaderGLES3::TIME, frame.time[0]);
 		shaders.particles.set_uniform(ParticlesShaderGLES3::EXPLOSIVENESS, particles->explosiveness);
@@ -6820,6 +7666,8 @@ void RasterizerStorageGLES3::update_particles() {
 			particles->particle_valid_histories[0] = true;
 		}
 
+		particles->particle_sort_valid = false; //sorted again by the next view that draws it
+
 		particles->instance_change_notify(true, false); //make sure shadows are updated
 	}
 
@@ -6988,6 +7836,9 @@ void RasterizerStorageGLES3::_render_target_clear(RenderTarget *rt) {
 		rt->effects.ssao.blur_fbo[1] = 0;
 	}
 
+	_render_target_clear_scaled(rt->effects.ssao_scaled);
+	_render_target_clear_scaled(rt->effects.ssr_scaled);
+
 	if (rt->exposure.fbo) {
 		glDeleteFramebuffers(1, &rt->exposure.fbo);
 		glDeleteTextures(1, &rt->exposure.color);
@@ -7415,6 +8266,70 @@ void RasterizerStorageGLES3::_render_target_allocate(RenderTarget *rt) {
 	}
 }
 
+void RasterizerStorageGLES3::_render_target_clear_scaled(RenderTarget::Effects::Scaled &r_scaled) {
+
+	if (!r_scaled.fbo[0])
+		return;
+
+	glDeleteFramebuffers(2, r_scaled.fbo);
+	glDeleteTextures(2, r_scaled.color);
+	glDeleteFramebuffers(2, r_scaled.history_fbo);
+	glDeleteTextures(2, r_scaled.history);
+
+	r_scaled.fbo[0] = 0;
+	r_scaled.width = 0;
+	r_scaled.height = 0;
+	r_scaled.history_frame = 0;
+}
+
+bool RasterizerStorageGLES3::_render_target_update_scaled(RenderTarget::Effects::Scaled &r_scaled, int p_width, int p_height, GLenum p_internal_format, GLenum p_format, GLenum p_type) {
+
+	p_width = MAX(p_width, 1);
+	p_height = MAX(p_height, 1);
+
+	if (r_scaled.fbo[0] && r_scaled.width == p_width && r_scaled.height == p_height)
+		return true;
+
+	_render_target_clear_scaled(r_scaled);
+
+	glGenFramebuffers(2, r_scaled.fbo);
+	glGenTextures(2, r_scaled.color);
+	glGenFramebuffers(2, r_scaled.history_fbo);
+	glGenTextures(2, r_scaled.history);
+
+	for (int i = 0; i < 4; i++) {
+
+		GLuint fbo = i < 2 ? r_scaled.fbo[i] : r_scaled.history_fbo[i - 2];
+		GLuint color = i < 2 ? r_scaled.color[i] : r_scaled.history[i - 2];
+
+		glBindTexture(GL_TEXTURE_2D, color);
+		glTexImage2D(GL_TEXTURE_2D, 0, p_internal_format, p_width, p_height, 0, p_format, p_type, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); //history is resampled when reprojected
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		if (status != GL_FRAMEBUFFER_COMPLETE) {
+			glBindFramebuffer(GL_FRAMEBUFFER, RasterizerStorageGLES3::system_fbo);
+			_render_target_clear_scaled(r_scaled);
+			ERR_FAIL_COND_V(status != GL_FRAMEBUFFER_COMPLETE, false);
+		}
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, RasterizerStorageGLES3::system_fbo);
+
+	r_scaled.width = p_width;
+	r_scaled.height = p_height;
+	r_scaled.current_history = 0;
+	r_scaled.history_frame = 0;
+
+	return true;
+}
+
 RID RasterizerStorageGLES3::render_target_create() {
 
 	RenderTarget *rt = memnew(RenderTarget);
@@ -7775,6 +8690,157 @@ void RasterizerStorageGLES3::canvas_light_occluder_set_polylines(RID p_occluder,
 	}
 }
 
+/* STREAM BUFFER API */
+
+RasterizerStorageGLES3::StreamBuffer *RasterizerStorageGLES3::stream_buffer_create(GLenum p_target, uint32_t p_segment_size) {
+
+	StreamBuffer *sb = memnew(StreamBuffer);
+
+	// segments start at offsets usable for uniform buffer ranges
+	uint32_t alignment = MAX(256, config.uniform_buffer_offset_alignment);
+
+	sb->target = p_target;
+	sb->segment_size = ((MAX(p_segment_size, 1) + alignment - 1) / alignment) * alignment;
+	sb->offset = 0;
+	sb->segment = 0;
+	for (int i = 0; i < STREAM_BUFFER_SEGMENTS; i++) {
+		sb->fences[i] = 0;
+	}
+	sb->persistent_ptr = NULL;
+	sb->staging = NULL;
+	sb->map_offset = 0;
+	sb->map_size = 0;
+
+	uint32_t size = sb->segment_size * STREAM_BUFFER_SEGMENTS;
+
+	glGenBuffers(1, &sb->id);
+	glBindBuffer(p_target, sb->id);
+
+#ifdef GLAD_ENABLED
+	if (config.use_persistent_stream_buffers) {
+
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(p_target, size, NULL, flags);
+		sb->persistent_ptr = (uint8_t *)glMapBufferRange(p_target, 0, size, flags);
+
+		if (!sb->persistent_ptr) {
+			//storage is immutable, start over with a regular buffer
+			glDeleteBuffers(1, &sb->id);
+			glGenBuffers(1, &sb->id);
+			glBindBuffer(p_target, sb->id);
+		}
+	}
+#endif
+
+	if (!sb->persistent_ptr) {
+		glBufferData(p_target, size, NULL, GL_STREAM_DRAW);
+#ifdef __EMSCRIPTEN__
+		sb->staging = (uint8_t *)memalloc(sb->segment_size);
+#endif
+	}
+
+	glBindBuffer(p_target, 0);
+
+	return sb;
+}
+
+void RasterizerStorageGLES3::stream_buffer_free(StreamBuffer *p_buffer) {
+
+	ERR_FAIL_COND(!p_buffer);
+
+	for (int i = 0; i < STREAM_BUFFER_SEGMENTS; i++) {
+		if (p_buffer->fences[i]) {
+			glDeleteSync(p_buffer->fences[i]);
+		}
+	}
+
+	glDeleteBuffers(1, &p_buffer->id);
+
+	if (p_buffer->staging) {
+		memfree(p_buffer->staging);
+	}
+
+	memdelete(p_buffer);
+}
+
+uint8_t *RasterizerStorageGLES3::stream_buffer_map(StreamBuffer *p_buffer, uint32_t p_size, uint32_t p_alignment, uint32_t &r_offset) {
+
+	ERR_FAIL_COND_V(!p_buffer, NULL);
+	ERR_FAIL_COND_V_MSG(p_size > p_buffer->segment_size, NULL, "Stream buffer upload of " + itos(p_size) + " bytes does not fit in a segment of " + itos(p_buffer->segment_size) + " bytes.");
+
+	//empty uploads still get a valid pointer
+	p_size = MAX(p_size, 1);
+
+	uint32_t offset = p_buffer->offset;
+	if (p_alignment > 1) {
+		offset = ((offset + p_alignment - 1) / p_alignment) * p_alignment;
+	}
+
+	if (offset + p_size > (p_buffer->segment + 1) * p_buffer->segment_size) {
+
+		//everything drawn from the current segment has been submitted by now, fence it and move on
+		p_buffer->fences[p_buffer->segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		p_buffer->segment = (p_buffer->segment + 1) % STREAM_BUFFER_SEGMENTS;
+
+		GLsync fence = p_buffer->fences[p_buffer->segment];
+		if (fence) {
+			//only blocks if the GPU is a whole ring behind
+			while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {
+			}
+			glDeleteSync(fence);
+			p_buffer->fences[p_buffer->segment] = 0;
+		}
+
+		offset = p_buffer->segment * p_buffer->segment_size;
+	}
+
+	p_buffer->offset = offset + p_size;
+	r_offset = offset;
+
+	glBindBuffer(p_buffer->target, p_buffer->id);
+
+	if (p_buffer->persistent_ptr) {
+		return p_buffer->persistent_ptr + offset;
+	}
+
+	p_buffer->map_offset = offset;
+	p_buffer->map_size = p_size;
+
+#ifdef __EMSCRIPTEN__
+	return p_buffer->staging;
+#else
+	//the fences already guarantee this range is not in use
+	return (uint8_t *)glMapBufferRange(p_buffer->target, offset, p_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+#endif
+}
+
+void RasterizerStorageGLES3::stream_buffer_unmap(StreamBuffer *p_buffer) {
+
+	ERR_FAIL_COND(!p_buffer);
+
+	if (p_buffer->persistent_ptr) {
+		return; //coherent mapping, writes are visible without flushing
+	}
+
+#ifdef __EMSCRIPTEN__
+	glBufferSubData(p_buffer->target, p_buffer->map_offset, p_buffer->map_size, p_buffer->staging);
+#else
+	glUnmapBuffer(p_buffer->target);
+#endif
+}
+
+uint32_t RasterizerStorageGLES3::stream_buffer_upload(StreamBuffer *p_buffer, const void *p_data, uint32_t p_size, uint32_t p_alignment) {
+
+	uint32_t offset = 0;
+	uint8_t *ptr = stream_buffer_map(p_buffer, p_size, p_alignment, offset);
+	ERR_FAIL_COND_V(!ptr, 0);
+
+	copymem(ptr, p_data, p_size);
+	stream_buffer_unmap(p_buffer);
+
+	return offset;
+}
+
 VS::InstanceType RasterizerStorageGLES3::get_base_type(RID p_rid) const {
 
 	if (mesh_owner.owns(p_rid)) {
@@ -7928,6 +8994,7 @@ bool RasterizerStorageGLES3::free(RID p_rid) {
 			MultiMesh *multimesh = mesh->multimeshes.first()->self();
 			multimesh->mesh = RID();
 			multimesh->dirty_aabb = true;
+			multimesh->dirty_region_aabbs = true;
 			mesh->multimeshes.remove(mesh->multimeshes.first());
 
 			if (!multimesh->update_list.in_list()) {
@@ -8066,6 +9133,13 @@ void RasterizerStorageGLES3::set_debug_generate_wireframes(bool p_generate) {
 	config.generate_wireframes = p_generate;
 }
 
+void RasterizerStorageGLES3::warm_up_shaders() {
+
+	// make sure the custom code of every loaded material is known
+	update_dirty_shaders();
+	ShaderGLES3::warm_up_all();
+}
+
 void RasterizerStorageGLES3::render_info_begin_capture() {
 
 	info.snap = info.render;
@@ -8079,6 +9153,8 @@ void RasterizerStorageGLES3::render_info_end_capture() {
 	info.snap.surface_switch_count = info.render.surface_switch_count - info.snap.surface_switch_count;
 	info.snap.shader_rebind_count = info.render.shader_rebind_count - info.snap.shader_rebind_count;
 	info.snap.vertices_count = info.render.vertices_count - info.snap.vertices_count;
+	info.snap.canvas_command_count = info.render.canvas_command_count - info.snap.canvas_command_count;
+	info.snap.canvas_batch_count = info.render.canvas_batch_count - info.snap.canvas_batch_count;
 }
 
 int RasterizerStorageGLES3::get_captured_render_info(VS::RenderInfo p_info) {
@@ -8104,6 +9180,12 @@ int RasterizerStorageGLES3::get_captured_render_info(VS::RenderInfo p_info) {
 		case VS::INFO_DRAW_CALLS_IN_FRAME: {
 			return info.snap.draw_call_count;
 		} break;
+		case VS::INFO_2D_COMMANDS_IN_FRAME: {
+			return info.snap.canvas_command_count;
+		} break;
+		case VS::INFO_2D_BATCHES_IN_FRAME: {
+			return info.snap.canvas_batch_count;
+		} break;
 		default: {
 			return get_render_info(p_info);
 		}
@@ -8133,6 +9215,10 @@ int RasterizerStorageGLES3::get_render_info(VS::RenderInfo p_info) {
 			return info.texture_mem;
 		case VS::INFO_VERTEX_MEM_USED:
 			return info.vertex_mem;
+		case VS::INFO_2D_COMMANDS_IN_FRAME:
+			return info.render_final.canvas_command_count;
+		case VS::INFO_2D_BATCHES_IN_FRAME:
+			return info.render_final.canvas_batch_count;
 		default:
 			return 0; //no idea either
 	}
@@ -8167,6 +9253,13 @@ void RasterizerStorageGLES3::initialize() {
 		}
 	}
 
+	bool async_shader_compilation = GLOBAL_DEF("rendering/quality/shader_compilation/async", false);
+	if (async_shader_compilation && !config.extensions.has("GL_KHR_parallel_shader_compile") && !config.extensions.has("GL_ARB_parallel_shader_compile")) {
+		print_verbose("Asynchronous shader compilation requested, but GL_KHR_parallel_shader_compile is not supported by the driver.");
+		async_shader_compilation = false;
+	}
+	ShaderGLES3::set_async_compilation(async_shader_compilation);
+
 	config.shrink_textures_x2 = false;
 	config.use_fast_texture_filter = int(ProjectSettings::get_singleton()->get("rendering/quality/filters/use_nearest_mipmap_filter"));
 	config.use_anisotropic_filter = config.extensions.has("rendering/quality/filters/anisotropic_filter_level");
@@ -8195,6 +9288,13 @@ void RasterizerStorageGLES3::initialize() {
 	config.pvrtc_supported = config.extensions.has("GL_IMG_texture_compression_pvrtc");
 	config.srgb_decode_supported = config.extensions.has("GL_EXT_texture_sRGB_decode");
 
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &config.uniform_buffer_offset_alignment);
+#ifdef GLAD_ENABLED
+	config.use_persistent_stream_buffers = GLAD_GL_ARB_buffer_storage;
+#else
+	config.use_persistent_stream_buffers = false;
+#endif
+
 	config.anisotropic_level = 1.0;
 	config.use_anisotropic_filter = config.extensions.has("GL_EXT_texture_filter_anisotropic");
 	if (config.use_anisotropic_filter) {
@@ -8350,6 +9450,7 @@ void RasterizerStorageGLES3::initialize() {
 	bool ggx_hq = GLOBAL_GET("rendering/quality/reflections/high_quality_ggx");
 	shaders.cubemap_filter.set_conditional(CubemapFilterShaderGLES3::LOW_QUALITY, !ggx_hq);
 	shaders.particles.init();
+	shaders.particles_sort.init();
 
 #ifdef GLES_OVER_GL
 	glEnable(_EXT_TEXTURE_CUBE_MAP_SEAMLESS);
@@ -8364,6 +9465,9 @@ void RasterizerStorageGLES3::initialize() {
 
 	config.force_vertex_shading = GLOBAL_GET("rendering/quality/shading/force_vertex_shading");
 
+	config.texture_streaming_budget = uint64_t(int(GLOBAL_GET("rendering/texture_streaming/memory_budget_mb"))) * 1024 * 1024;
+	config.texture_streaming_min_size = GLOBAL_GET("rendering/texture_streaming/min_resident_size");
+
 	String renderer = (const char *)glGetString(GL_RENDERER);
 
 	config.use_depth_prepass = bool(GLOBAL_GET("rendering/quality/depth_prepass/enable"));
@@ -8388,6 +9492,17 @@ void RasterizerStorageGLES3::finalize() {
 	glDeleteTextures(1, &resources.white_tex);
 	glDeleteTextures(1, &resources.black_tex);
 	glDeleteTextures(1, &resources.normal_tex);
+
+	if (particle_sort.data_texture) {
+		glDeleteTextures(1, &particle_sort.data_texture);
+	}
+	if (particle_sort.key_textures[0]) {
+		glDeleteTextures(2, particle_sort.key_textures);
+		glDeleteFramebuffers(2, particle_sort.key_fbos);
+	}
+	if (particle_sort.empty_array) {
+		glDeleteVertexArrays(1, &particle_sort.empty_array);
+	}
 }
 
 void RasterizerStorageGLES3::update_dirty_resources() {
@@ -8397,6 +9512,7 @@ void RasterizerStorageGLES3::update_dirty_resources() {
 	update_dirty_shaders();
 	update_dirty_materials();
 	update_particles();
+	update_texture_streaming();
 }
 
 RasterizerStorageGLES3::RasterizerStorageGLES3() {
@@ -31,6 +31,7 @@
 #ifndef RASTERIZERSTORAGEGLES3_H
 #define RASTERIZERSTORAGEGLES3_H
 
+#include "core/hash_map.h"
 #include "core/self_list.h"
 #include "servers/visual/rasterizer.h"
 #include "servers/visual/shader_language.h"
@@ -42,12 +43,14 @@
 #include "shaders/copy.glsl.gen.h"
 #include "shaders/cubemap_filter.glsl.gen.h"
 #include "shaders/particles.glsl.gen.h"
+#include "shaders/particles_sort.glsl.gen.h"
 
 // WebGL 2.0 has no MapBufferRange/UnmapBuffer, but offers a non-ES style BufferSubData API instead.
 #ifdef __EMSCRIPTEN__
 void glGetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, GLvoid *data);
 #endif
 
+class FileAccess;
 class RasterizerCanvasGLES3;
 class RasterizerSceneGLES3;
 
@@ -105,6 +108,12 @@ public:
 
 		bool use_depth_prepass;
 		bool force_vertex_shading;
+
+		int uniform_buffer_offset_alignment;
+		bool use_persistent_stream_buffers;
+
+		uint64_t texture_streaming_budget;
+		int texture_streaming_min_size;
 	} config;
 
 	mutable struct Shaders {
@@ -119,6 +128,8 @@ public:
 
 		ParticlesShaderGLES3 particles;
 
+		ParticlesSortShaderGLES3 particles_sort;
+
 		ShaderCompilerGLES3::IdentifierActions actions_canvas;
 		ShaderCompilerGLES3::IdentifierActions actions_scene;
 		ShaderCompilerGLES3::IdentifierActions actions_particles;
@@ -154,6 +165,8 @@ public:
 			uint32_t surface_switch_count;
 			uint32_t shader_rebind_count;
 			uint32_t vertices_count;
+			uint32_t canvas_command_count;
+			uint32_t canvas_batch_count;
 
 			void reset() {
 				object_count = 0;
@@ -162,6 +175,8 @@ public:
 				surface_switch_count = 0;
 				shader_rebind_count = 0;
 				vertices_count = 0;
+				canvas_command_count = 0;
+				canvas_batch_count = 0;
 			}
 		} render, render_final, snap;
 
@@ -289,6 +304,15 @@ public:
 		VisualServer::TextureDetectCallback detect_normal;
 		void *detect_normal_ud;
 
+		//streamed textures keep mipmaps from stream_first_mipmap resident, the storage asks for more or less of them
+		VisualServer::TextureStreamCallback stream_callback;
+		void *stream_ud;
+		int stream_first_mipmap;
+		int stream_requested_mipmap;
+		int stream_required_mipmap;
+		uint64_t stream_used_frame;
+		SelfList<Texture> stream_list;
+
 		Texture() :
 				proxy(NULL),
 				flags(0),
@@ -314,7 +338,14 @@ public:
 				detect_srgb(NULL),
 				detect_srgb_ud(NULL),
 				detect_normal(NULL),
-				detect_normal_ud(NULL) {
+				detect_normal_ud(NULL),
+				stream_callback(NULL),
+				stream_ud(NULL),
+				stream_first_mipmap(0),
+				stream_requested_mipmap(-1),
+				stream_required_mipmap(0),
+				stream_used_frame(0),
+				stream_list(this) {
 		}
 
 		_ALWAYS_INLINE_ Texture *get_ptr() {
@@ -344,6 +375,22 @@ public:
 
 	mutable RID_Owner<Texture> texture_owner;
 
+	SelfList<Texture>::List texture_stream_list;
+
+	void _texture_set_data(Texture *p_texture, const Ref<Image> &p_image, int p_layer, int p_first_mipmap);
+	int _texture_stream_target_mipmap(const Texture *p_texture, int p_bias) const;
+	void update_texture_streaming();
+
+	_FORCE_INLINE_ void texture_stream_require_mipmap(Texture *p_texture, int p_mipmap) {
+		//called while filling render lists, the lowest mipmap asked for in a frame wins
+		if (p_texture->stream_used_frame != frame.count) {
+			p_texture->stream_used_frame = frame.count;
+			p_texture->stream_required_mipmap = p_mipmap;
+		} else if (p_mipmap < p_texture->stream_required_mipmap) {
+			p_texture->stream_required_mipmap = p_mipmap;
+		}
+	}
+
 	Ref<Image> _get_gl_image_and_format(const Ref<Image> &p_image, Image::Format p_format, uint32_t p_flags, Image::Format &r_real_format, GLenum &r_gl_format, GLenum &r_gl_internal_format, GLenum &r_gl_type, bool &r_compressed, bool &r_srgb, bool p_force_decompress) const;
 
 	virtual RID texture_create();
@@ -377,6 +424,9 @@ public:
 	virtual void texture_set_detect_srgb_callback(RID p_texture, VisualServer::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_normal_callback(RID p_texture, VisualServer::TextureDetectCallback p_callback, void *p_userdata);
 
+	virtual void texture_set_stream_callback(RID p_texture, VisualServer::TextureStreamCallback p_callback, void *p_userdata);
+	virtual void texture_set_stream_data(RID p_texture, const Ref<Image> &p_image, int p_first_mipmap);
+
 	virtual void texture_set_proxy(RID p_texture, RID p_proxy);
 	virtual Size2 texture_size_with_proxy(RID p_texture) const;
 
@@ -454,6 +504,7 @@ public:
 			bool uses_screen_texture;
 			bool uses_screen_uv;
 			bool uses_time;
+			bool uses_vertex;
 
 		} canvas_item;
 
@@ -498,6 +549,8 @@ public:
 			bool writes_modelview_or_projection;
 			bool uses_vertex_lighting;
 			bool uses_world_coordinates;
+			bool uses_world_matrix;
+			bool uses_instance_id;
 
 		} spatial;
 
@@ -522,6 +575,22 @@ public:
 	mutable SelfList<Shader>::List _shader_dirty_list;
 	void _shader_make_dirty(Shader *p_shader);
 
+	// Compiler output shared by all shaders with the same mode and code.
+	struct CompiledShader {
+		ShaderCompilerGLES3::GeneratedCode gen_code;
+		Map<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+		Shader::CanvasItem canvas_item;
+		Shader::Spatial spatial;
+	};
+
+	mutable HashMap<String, CompiledShader> compiled_shaders;
+
+	String _get_compiled_shader_key(const Shader *p_shader) const;
+	bool _load_compiled_shader(Shader *p_shader, const String &p_key, ShaderCompilerGLES3::GeneratedCode &r_gen_code) const;
+	void _store_compiled_shader(const Shader *p_shader, const String &p_key, const ShaderCompilerGLES3::GeneratedCode &p_gen_code) const;
+	bool _read_compiled_shader(FileAccess *p_file, VS::ShaderMode p_mode, CompiledShader &r_compiled) const;
+	void _write_compiled_shader(FileAccess *p_file, VS::ShaderMode p_mode, const CompiledShader &p_compiled) const;
+
 	mutable RID_Owner<Shader> shader_owner;
 
 	virtual RID shader_create();
@@ -534,6 +603,7 @@ public:
 	virtual RID shader_get_default_texture_param(RID p_shader, const StringName &p_name) const;
 
 	void _update_shader(Shader *p_shader) const;
+	void _apply_shader_code(Shader *p_shader, const ShaderCompilerGLES3::GeneratedCode &p_gen_code) const;
 
 	void update_dirty_shaders();
 
@@ -652,6 +722,13 @@ public:
 
 		Vector<BlendShape> blend_shapes;
 
+		struct LOD {
+			float edge_length; //object space error of this level
+			Surface *surface; //shares the vertex buffer, owns its index buffer and vertex arrays
+		};
+
+		Vector<LOD> lods; //finest to coarsest
+
 		AABB aabb;
 
 		int array_len;
@@ -754,6 +831,9 @@ public:
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const;
 
+	void _mesh_surface_clear_lods(Surface *p_surface);
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_edge_lengths, const Vector<PoolVector<uint8_t> > &p_index_arrays);
+
 	virtual void mesh_remove_surface(RID p_mesh, int p_surface);
 	virtual int mesh_get_surface_count(RID p_mesh) const;
 
@@ -767,6 +847,10 @@ public:
 
 	/* MULTIMESH API */
 
+	enum {
+		MULTIMESH_DIRTY_REGION_SIZE = 512 //instances, changes are tracked and uploaded per region
+	};
+
 	struct MultiMesh : public GeometryOwner {
 		RID mesh;
 		int size;
@@ -787,6 +871,11 @@ public:
 		bool dirty_aabb;
 		bool dirty_data;
 
+		Vector<bool> dirty_regions;
+		int dirty_region_count;
+		Vector<AABB> region_aabbs;
+		bool dirty_region_aabbs; //all region aabbs must be recomputed, eg. the mesh changed
+
 		MultiMesh() :
 				size(0),
 				transform_format(VS::MULTIMESH_TRANSFORM_2D),
@@ -800,7 +889,9 @@ public:
 				color_floats(0),
 				custom_data_floats(0),
 				dirty_aabb(true),
-				dirty_data(true) {
+				dirty_data(true),
+				dirty_region_count(0),
+				dirty_region_aabbs(true) {
 		}
 	};
 
@@ -810,6 +901,11 @@ public:
 
 	void update_dirty_multimeshes();
 
+	void _multimesh_mark_dirty(MultiMesh *p_multimesh, int p_index, bool p_aabb);
+	void _multimesh_mark_all_dirty(MultiMesh *p_multimesh, bool p_aabb);
+	void _multimesh_write_instances(MultiMesh *p_multimesh, int p_from, int p_count, const float *p_data);
+	AABB _multimesh_get_region_aabb(const MultiMesh *p_multimesh, int p_region, const AABB &p_mesh_aabb) const;
+
 	virtual RID multimesh_create();
 
 	virtual void multimesh_allocate(RID p_multimesh, int p_instances, VS::MultimeshTransformFormat p_transform_format, VS::MultimeshColorFormat p_color_format, VS::MultimeshCustomDataFormat p_data_format = VS::MULTIMESH_CUSTOM_DATA_NONE);
@@ -829,6 +925,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const;
 
 	virtual void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array);
+	virtual void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array);
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible);
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const;
@@ -914,6 +1011,7 @@ public:
 	virtual void skeleton_allocate(RID p_skeleton, int p_bones, bool p_2d_skeleton = false);
 	virtual int skeleton_get_bone_count(RID p_skeleton) const;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform);
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms);
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const;
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform);
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const;
@@ -1164,6 +1262,13 @@ public:
 		bool particle_valid_histories[2];
 		bool histories_enabled;
 
+		GLuint particle_sort_buffer; //view depth order sorted on the GPU, 0 when sorting falls back to the histories
+		bool particle_sort_valid;
+
+		RID collision_heightfield;
+		AABB collision_aabb;
+		float collision_bounce;
+
 		SelfList<Particles> particle_element;
 
 		float phase;
@@ -1198,6 +1303,10 @@ public:
 				use_local_coords(true),
 				draw_order(VS::PARTICLES_DRAW_ORDER_INDEX),
 				histories_enabled(false),
+				particle_sort_buffer(0),
+				particle_sort_valid(false),
+				collision_aabb(AABB(Vector3(-4, -4, -4), Vector3(8, 8, 8))),
+				collision_bounce(0.0),
 				particle_element(this),
 				prev_ticks(0),
 				random_seed(0),
@@ -1221,9 +1330,33 @@ public:
 				glDeleteBuffers(2, particle_buffer_histories);
 				glDeleteVertexArrays(2, particle_vao_histories);
 			}
+			if (particle_sort_buffer) {
+				glDeleteBuffers(1, &particle_sort_buffer);
+			}
 		}
 	};
 
+	struct ParticleSort {
+
+		GLuint data_texture; //particles copied from their buffer, 256 per row and 6 texels each
+		int data_rows;
+
+		GLuint key_textures[2]; //(depth, index) pairs ping-ponged through the sort steps, 1024 per row
+		GLuint key_fbos[2];
+		int key_rows;
+
+		GLuint empty_array;
+
+		ParticleSort() {
+			data_texture = 0;
+			data_rows = 0;
+			key_textures[0] = key_textures[1] = 0;
+			key_fbos[0] = key_fbos[1] = 0;
+			key_rows = 0;
+			empty_array = 0;
+		}
+	} particle_sort;
+
 	SelfList<Particles>::List particle_update_list;
 
 	void update_particles();
@@ -1246,6 +1379,8 @@ public:
 	virtual void particles_set_process_material(RID p_particles, RID p_material);
 	virtual void particles_set_fixed_fps(RID p_particles, int p_fps);
 	virtual void particles_set_fractional_delta(RID p_particles, bool p_enable);
+	virtual void particles_set_collision_heightfield(RID p_particles, RID p_texture, const AABB &p_aabb);
+	virtual void particles_set_collision_bounce(RID p_particles, float p_bounce);
 	virtual void particles_restart(RID p_particles);
 
 	virtual void particles_set_draw_order(RID p_particles, VS::ParticlesDrawOrder p_order);
@@ -1258,6 +1393,8 @@ public:
 	virtual AABB particles_get_aabb(RID p_particles) const;
 
 	virtual void _particles_update_histories(Particles *particles);
+	bool _particles_can_sort_on_gpu(int p_amount) const;
+	bool particles_sort_by_depth(Particles *p_particles, const Vector3 &p_sort_direction);
 
 	virtual void particles_set_emission_transform(RID p_particles, const Transform &p_transform);
 	void _particles_process(Particles *p_particles, float p_delta);
@@ -1337,6 +1474,30 @@ public:
 				}
 			} ssao;
 
+			//an effect rendered below screen resolution and/or accumulated over frames, allocated the first time it's needed
+			struct Scaled {
+				GLuint fbo[2]; //ping-pong at the reduced size
+				GLuint color[2];
+				GLuint history_fbo[2]; //result of the last two frames, alternating
+				GLuint history[2];
+				int width;
+				int height;
+				int current_history;
+				uint64_t history_frame;
+				CameraMatrix history_view_projection; //camera the latest history was rendered from
+
+				Scaled() :
+						width(0),
+						height(0),
+						current_history(0),
+						history_frame(0) {
+					fbo[0] = 0;
+				}
+			};
+
+			Scaled ssao_scaled;
+			Scaled ssr_scaled;
+
 			Effects() {}
 
 		} effects;
@@ -1393,6 +1554,8 @@ public:
 
 	void _render_target_clear(RenderTarget *rt);
 	void _render_target_allocate(RenderTarget *rt);
+	void _render_target_clear_scaled(RenderTarget::Effects::Scaled &r_scaled);
+	bool _render_target_update_scaled(RenderTarget::Effects::Scaled &r_scaled, int p_width, int p_height, GLenum p_internal_format, GLenum p_format, GLenum p_type);
 
 	virtual RID render_target_create();
 	virtual void render_target_set_position(RID p_render_target, int p_x, int p_y);
@@ -1436,6 +1599,36 @@ public:
 	virtual RID canvas_light_occluder_create();
 	virtual void canvas_light_occluder_set_polylines(RID p_occluder, const PoolVector<Vector2> &p_lines);
 
+	/* STREAM BUFFER API */
+
+	enum {
+		STREAM_BUFFER_SEGMENTS = 3
+	};
+
+	// Ring buffer for data that is written once and drawn right away (UBOs, immediate geometry, canvas polygons).
+	// It is split in segments, and a segment is only written again once the GPU has signaled the fence placed when it was left,
+	// so uploads never have to wait on the driver. Memory handed out stays valid until the next map of the same buffer.
+	struct StreamBuffer {
+
+		GLuint id;
+		GLenum target;
+		uint32_t segment_size;
+		uint32_t offset;
+		int segment;
+		GLsync fences[STREAM_BUFFER_SEGMENTS];
+
+		uint8_t *persistent_ptr; // whole buffer, mapped for its lifetime
+		uint8_t *staging; // used when buffers can't be mapped at all
+		uint32_t map_offset;
+		uint32_t map_size;
+	};
+
+	StreamBuffer *stream_buffer_create(GLenum p_target, uint32_t p_segment_size);
+	void stream_buffer_free(StreamBuffer *p_buffer);
+	uint8_t *stream_buffer_map(StreamBuffer *p_buffer, uint32_t p_size, uint32_t p_alignment, uint32_t &r_offset);
+	void stream_buffer_unmap(StreamBuffer *p_buffer);
+	uint32_t stream_buffer_upload(StreamBuffer *p_buffer, const void *p_data, uint32_t p_size, uint32_t p_alignment = 4);
+
 	virtual VS::InstanceType get_base_type(RID p_rid) const;
 
 	virtual bool free(RID p_rid);
@@ -1462,6 +1655,8 @@ public:
 
 	virtual void set_debug_generate_wireframes(bool p_generate);
 
+	virtual void warm_up_shaders();
+
 	virtual void render_info_begin_capture();
 	virtual void render_info_end_capture();
 	virtual int get_captured_render_info(VS::RenderInfo p_info);
@@ -0,0 +1,393 @@
+/*************************************************************************/
+/*  shader_cache_gles3.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "shader_cache_gles3.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/print_string.h"
+#include "core/project_settings.h"
+#include "core/version.h"
+
+#define SHADER_CACHE_MAGIC 0x43505347 // "GSPC"
+#define SHADER_CACHE_HEADER_SIZE 12
+
+ShaderCacheGLES3 *ShaderCacheGLES3::singleton = NULL;
+
+String ShaderCacheGLES3::hash_program(const String &p_shader_name, const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const {
+
+	static const uint8_t separator = 0;
+
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+
+	CharString driver = driver_id.utf8();
+	ctx.update((const uint8_t *)driver.get_data(), driver.length());
+	ctx.update(&separator, 1);
+
+	CharString name = p_shader_name.utf8();
+	ctx.update((const uint8_t *)name.get_data(), name.length());
+	ctx.update(&separator, 1);
+
+	for (int i = 0; i < p_vertex_strings.size(); i++) {
+		ctx.update((const uint8_t *)p_vertex_strings[i], strlen(p_vertex_strings[i]));
+		ctx.update(&separator, 1);
+	}
+
+	ctx.update(&separator, 1);
+
+	for (int i = 0; i < p_fragment_strings.size(); i++) {
+		ctx.update((const uint8_t *)p_fragment_strings[i], strlen(p_fragment_strings[i]));
+		ctx.update(&separator, 1);
+	}
+
+	unsigned char hash[32];
+	ctx.finish(hash);
+
+	return String::hex_encode_buffer(hash, 32);
+}
+
+bool ShaderCacheGLES3::load_program(const String &p_hash, GLuint p_program) {
+
+	if (!enabled || !programs.has(p_hash)) {
+		return false;
+	}
+
+	String path = cache_dir.plus_file(p_hash + ".bin");
+	FileAccess *f = FileAccess::open(path, FileAccess::READ);
+	if (!f) {
+		programs.erase(p_hash);
+		return false;
+	}
+
+	uint32_t magic = f->get_32();
+	GLenum format = f->get_32();
+	uint32_t length = f->get_32();
+
+	if (magic != SHADER_CACHE_MAGIC || length == 0 || length != f->get_len() - SHADER_CACHE_HEADER_SIZE) {
+		memdelete(f);
+		programs.erase(p_hash);
+		return false;
+	}
+
+	Vector<uint8_t> binary;
+	binary.resize(length);
+	f->get_buffer(binary.ptrw(), length);
+	memdelete(f);
+
+	glProgramBinary(p_program, format, binary.ptr(), length);
+
+	GLint status;
+	glGetProgramiv(p_program, GL_LINK_STATUS, &status);
+
+	if (status == GL_FALSE) {
+		// Driver rejected it, usually because it was updated without changing its version string.
+		print_verbose("ShaderCacheGLES3: Discarding stale program binary " + p_hash + ".");
+		DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+		da->remove(path);
+		memdelete(da);
+		programs.erase(p_hash);
+		return false;
+	}
+
+	return true;
+}
+
+void ShaderCacheGLES3::store_program(const String &p_hash, GLuint p_program) {
+
+	if (!enabled) {
+		return;
+	}
+
+	GLint length = 0;
+	glGetProgramiv(p_program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) {
+		return;
+	}
+
+	Vector<uint8_t> binary;
+	binary.resize(length);
+
+	GLsizei written = 0;
+	GLenum format = 0;
+	glGetProgramBinary(p_program, length, &written, &format, binary.ptrw());
+	if (written <= 0) {
+		return;
+	}
+
+	FileAccess *f = FileAccess::open(cache_dir.plus_file(p_hash + ".bin"), FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Can't write shader cache file in '" + cache_dir + "'.");
+
+	f->store_32(SHADER_CACHE_MAGIC);
+	f->store_32(format);
+	f->store_32(written);
+	f->store_buffer(binary.ptr(), written);
+	memdelete(f);
+
+	programs.insert(p_hash);
+}
+
+void ShaderCacheGLES3::record_version(const String &p_shader_name, const String &p_code_hash, uint32_t p_version) {
+
+	if (!enabled) {
+		return;
+	}
+
+	String code_hash = p_code_hash == String() ? "-" : p_code_hash;
+	Set<uint32_t> &recorded = versions[p_shader_name + ":" + code_hash];
+	if (recorded.has(p_version)) {
+		return;
+	}
+	recorded.insert(p_version);
+
+	String path = cache_dir.plus_file("versions.txt");
+	FileAccess *f = FileAccess::open(path, FileAccess::READ_WRITE);
+	if (!f) {
+		f = FileAccess::open(path, FileAccess::WRITE);
+	}
+	ERR_FAIL_COND(!f);
+
+	f->seek_end();
+	f->store_line(p_shader_name + " " + code_hash + " " + itos(p_version));
+	memdelete(f);
+}
+
+void ShaderCacheGLES3::get_versions(const String &p_shader_name, const String &p_code_hash, Vector<uint32_t> &r_versions) const {
+
+	String code_hash = p_code_hash == String() ? "-" : p_code_hash;
+	const Map<String, Set<uint32_t> >::Element *E = versions.find(p_shader_name + ":" + code_hash);
+	if (!E) {
+		return;
+	}
+
+	for (const Set<uint32_t>::Element *F = E->get().front(); F; F = F->next()) {
+		r_versions.push_back(F->get());
+	}
+}
+
+String ShaderCacheGLES3::_get_code_file(const String &p_key) const {
+
+	// The compiler output changes between engine builds, so the build is part of the name.
+	return (String(VERSION_FULL_BUILD) + "\n" + p_key).sha256_text();
+}
+
+FileAccess *ShaderCacheGLES3::open_code(const String &p_key, bool p_write) {
+
+	if (!code_enabled) {
+		return NULL;
+	}
+
+	String file = _get_code_file(p_key);
+
+	if (!p_write) {
+		if (!codes.has(file)) {
+			return NULL;
+		}
+		FileAccess *f = FileAccess::open(cache_dir.plus_file(file + ".code"), FileAccess::READ);
+		if (!f) {
+			codes.erase(file);
+		}
+		return f;
+	}
+
+	FileAccess *f = FileAccess::open(cache_dir.plus_file(file + ".code"), FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(!f, NULL, "Can't write shader cache file in '" + cache_dir + "'.");
+	codes.insert(file);
+	return f;
+}
+
+void ShaderCacheGLES3::discard_code(const String &p_key) {
+
+	if (!code_enabled) {
+		return;
+	}
+
+	String file = _get_code_file(p_key);
+	if (!codes.has(file)) {
+		return;
+	}
+
+	print_verbose("ShaderCacheGLES3: Discarding invalid compiled shader " + file + ".");
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->remove(cache_dir.plus_file(file + ".code"));
+	memdelete(da);
+	codes.erase(file);
+}
+
+void ShaderCacheGLES3::_load_versions() {
+
+	FileAccess *f = FileAccess::open(cache_dir.plus_file("versions.txt"), FileAccess::READ);
+	if (!f) {
+		return;
+	}
+
+	while (!f->eof_reached()) {
+
+		Vector<String> fields = f->get_line().split(" ", false);
+		if (fields.size() != 3) {
+			continue;
+		}
+
+		versions[fields[0] + ":" + fields[1]].insert(fields[2].to_int64());
+	}
+
+	memdelete(f);
+}
+
+void ShaderCacheGLES3::_clear_programs() {
+
+	DirAccess *da = DirAccess::open(cache_dir);
+	if (!da) {
+		return;
+	}
+
+	Vector<String> to_remove;
+
+	da->list_dir_begin();
+	String file = da->get_next();
+	while (file != String()) {
+		if (!da->current_is_dir() && file.get_extension() == "bin") {
+			to_remove.push_back(file);
+		}
+		file = da->get_next();
+	}
+	da->list_dir_end();
+
+	for (int i = 0; i < to_remove.size(); i++) {
+		da->remove(to_remove[i]);
+	}
+
+	memdelete(da);
+	programs.clear();
+}
+
+void ShaderCacheGLES3::_scan_cache_dir() {
+
+	DirAccess *da = DirAccess::open(cache_dir);
+	if (!da) {
+		return;
+	}
+
+	da->list_dir_begin();
+	String file = da->get_next();
+	while (file != String()) {
+		if (!da->current_is_dir()) {
+			if (file.get_extension() == "bin") {
+				programs.insert(file.get_basename());
+			} else if (file.get_extension() == "code") {
+				codes.insert(file.get_basename());
+			}
+		}
+		file = da->get_next();
+	}
+	da->list_dir_end();
+	memdelete(da);
+}
+
+ShaderCacheGLES3::ShaderCacheGLES3() {
+
+	singleton = this;
+
+	enabled = false;
+	code_enabled = false;
+
+	if (!GLOBAL_DEF("rendering/quality/shader_cache/enabled", true)) {
+		return;
+	}
+
+	cache_dir = "user://shader_cache/gles3";
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	Error err = da->make_dir_recursive(cache_dir);
+	memdelete(da);
+
+	if (err != OK) {
+		ERR_PRINT("Can't create shader cache directory '" + cache_dir + "', shader cache disabled.");
+		return;
+	}
+
+	code_enabled = true;
+	enabled = true;
+
+#ifdef GLAD_ENABLED
+	if (!GLAD_GL_ARB_get_program_binary) {
+		print_verbose("ShaderCacheGLES3: GL_ARB_get_program_binary not supported, program binary cache disabled.");
+		enabled = false;
+	}
+#endif
+
+	if (enabled) {
+		GLint format_count = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+		if (format_count <= 0) {
+			print_verbose("ShaderCacheGLES3: Driver exposes no program binary formats, program binary cache disabled.");
+			enabled = false;
+		}
+	}
+
+	if (enabled) {
+
+		driver_id = String((const char *)glGetString(GL_VENDOR)) + "\n" + String((const char *)glGetString(GL_RENDERER)) + "\n" + String((const char *)glGetString(GL_VERSION));
+
+		// Binaries from another driver are useless, drop them all at once.
+		String driver_path = cache_dir.plus_file("driver.txt");
+		FileAccess *f = FileAccess::open(driver_path, FileAccess::READ);
+		String cached_driver_id;
+		if (f) {
+			cached_driver_id = f->get_as_utf8_string();
+			memdelete(f);
+		}
+
+		if (cached_driver_id != driver_id) {
+			_clear_programs();
+			f = FileAccess::open(driver_path, FileAccess::WRITE);
+			if (f) {
+				f->store_string(driver_id);
+				memdelete(f);
+			}
+		}
+
+		_load_versions();
+	}
+
+	_scan_cache_dir();
+
+	if (!enabled) {
+		programs.clear();
+	}
+
+	print_verbose("ShaderCacheGLES3: " + itos(programs.size()) + " cached programs and " + itos(codes.size()) + " compiled shaders found in '" + cache_dir + "'.");
+}
+
+ShaderCacheGLES3::~ShaderCacheGLES3() {
+
+	singleton = NULL;
+}
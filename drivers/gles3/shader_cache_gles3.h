@@ -0,0 +1,93 @@
+/*************************************************************************/
+/*  shader_cache_gles3.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SHADER_CACHE_GLES3_H
+#define SHADER_CACHE_GLES3_H
+
+#include "core/map.h"
+#include "core/set.h"
+#include "core/ustring.h"
+#include "core/vector.h"
+
+#include "platform_config.h"
+#ifndef GLES3_INCLUDE_H
+#include <GLES3/gl3.h>
+#else
+#include GLES3_INCLUDE_H
+#endif
+
+class FileAccess;
+
+// Keeps linked program binaries under user:// so shader variants compiled in
+// a previous run can be loaded instead of compiled again. It also remembers
+// which variants were used, so they can be precompiled on demand, and stores
+// the shader compiler output of material shaders, which does not depend on
+// the driver.
+class ShaderCacheGLES3 {
+
+	static ShaderCacheGLES3 *singleton;
+
+	bool enabled;
+	bool code_enabled;
+	String cache_dir;
+	String driver_id;
+
+	Set<String> programs;
+	Set<String> codes;
+	Map<String, Set<uint32_t> > versions;
+
+	void _load_versions();
+	void _clear_programs();
+	void _scan_cache_dir();
+	String _get_code_file(const String &p_key) const;
+
+public:
+	static ShaderCacheGLES3 *get_singleton() { return singleton; }
+
+	_FORCE_INLINE_ bool is_enabled() const { return enabled; }
+	_FORCE_INLINE_ bool is_code_enabled() const { return code_enabled; }
+
+	String hash_program(const String &p_shader_name, const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const;
+
+	bool load_program(const String &p_hash, GLuint p_program);
+	void store_program(const String &p_hash, GLuint p_program);
+
+	void record_version(const String &p_shader_name, const String &p_code_hash, uint32_t p_version);
+	void get_versions(const String &p_shader_name, const String &p_code_hash, Vector<uint32_t> &r_versions) const;
+
+	// The caller owns the returned file; NULL when there is nothing cached or the cache is disabled.
+	FileAccess *open_code(const String &p_key, bool p_write);
+	void discard_code(const String &p_key);
+
+	ShaderCacheGLES3();
+	~ShaderCacheGLES3();
+};
+
+#endif // SHADER_CACHE_GLES3_H
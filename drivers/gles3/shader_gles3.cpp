@@ -31,6 +31,7 @@
 #include "shader_gles3.h"
 
 #include "core/print_string.h"
+#include "shader_cache_gles3.h"
 
 //#define DEBUG_OPENGL
 
@@ -50,6 +51,10 @@
 #endif
 
 ShaderGLES3 *ShaderGLES3::active = NULL;
+ShaderGLES3 *ShaderGLES3::first_shader = NULL;
+bool ShaderGLES3::async_compilation = false;
+
+#define _EXT_COMPLETION_STATUS 0x91B1
 
 //#define DEBUG_SHADER
 
@@ -112,7 +117,9 @@ GLint ShaderGLES3::get_uniform_location(int p_index) const {
 
 bool ShaderGLES3::bind() {
 
-	if (active != this || !version || new_conditional_version.key != conditional_version.key) {
+	Version *prev_version = active == this ? version : NULL;
+
+	if (active != this || !version || new_conditional_version.key != conditional_version.key || using_fallback) {
 		conditional_version = new_conditional_version;
 		version = get_current_version();
 	} else {
@@ -122,6 +129,22 @@ bool ShaderGLES3::bind() {
 
 	ERR_FAIL_COND_V(!version, false);
 
+	using_fallback = version->compiling;
+
+	if (using_fallback) {
+		// Not linked yet, draw with the built-in code for the same conditionals meanwhile.
+		VersionKey key = conditional_version;
+		conditional_version.code_version = 0;
+		version = get_current_version();
+		conditional_version = key;
+
+		ERR_FAIL_COND_V(!version, false);
+
+		if (version == prev_version && version->ok) {
+			return false; // fallback already bound
+		}
+	}
+
 	if (!version->ok) { //broken, unable to bind (do not throw error, you saw it before already when it failed compilation).
 		glUseProgram(0);
 		return false;
@@ -173,8 +196,12 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		if (conditional_version.code_version != 0) {
 			CustomCode *cc = custom_code_map.getptr(conditional_version.code_version);
 			ERR_FAIL_COND_V(!cc, _v);
-			if (cc->version == _v->code_version)
+			if (cc->version == _v->code_version) {
+				if (_v->compiling) {
+					return _poll_version(*_v, cc);
+				}
 				return _v;
+			}
 		} else {
 			return _v;
 		}
@@ -190,7 +217,7 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		v.uniform_location = memnew_arr(GLint, uniform_count);
 
 	} else {
-		if (v.ok) {
+		if (v.ok || v.compiling) {
 			//bye bye shaders
 			glDeleteShader(v.vert_id);
 			glDeleteShader(v.frag_id);
@@ -200,6 +227,7 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	}
 
 	v.ok = false;
+	v.compiling = false;
 	/* SETUP CONDITIONALS */
 
 	Vector<const char *> strings;
@@ -229,6 +257,8 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	CharString code_string;
 	CharString code_string2;
 	CharString code_globals;
+	CharString code_globals2;
+	CharString light_string;
 	CharString material_string;
 
 	CustomCode *cc = NULL;
@@ -241,12 +271,6 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		v.code_version = cc->version;
 	}
 
-	/* CREATE PROGRAM */
-
-	v.id = glCreateProgram();
-
-	ERR_FAIL_COND_V(v.id == 0, NULL);
-
 	/* VERTEX SHADER */
 
 	if (cc) {
@@ -255,9 +279,10 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 			strings.push_back(cc->custom_defines[i].get_data());
 			DEBUG_PRINT("CD #" + itos(i) + ": " + String(cc->custom_defines[i]));
 		}
+		material_string = cc->uniforms.ascii();
 	}
 
-	int strings_base_size = strings.size();
+	Vector<const char *> fragment_strings = strings;
 
 	//vertex precision is high
 	strings.push_back("precision highp float;\n");
@@ -271,7 +296,6 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	strings.push_back(vertex_code0.get_data());
 
 	if (cc) {
-		material_string = cc->uniforms.ascii();
 		strings.push_back(material_string.get_data());
 	}
 
@@ -299,144 +323,93 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	}
 #endif
 
-	v.vert_id = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(v.vert_id, strings.size(), &strings[0], NULL);
-	glCompileShader(v.vert_id);
-
-	GLint status;
-
-	glGetShaderiv(v.vert_id, GL_COMPILE_STATUS, &status);
-	if (status == GL_FALSE) {
-		// error compiling
-		GLsizei iloglen;
-		glGetShaderiv(v.vert_id, GL_INFO_LOG_LENGTH, &iloglen);
-
-		if (iloglen < 0) {
-
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-
-			ERR_PRINT("Vertex shader compilation failed with empty log");
-		} else {
-
-			if (iloglen == 0) {
-
-				iloglen = 4096; //buggy driver (Adreno 220+....)
-			}
-
-			char *ilogmem = (char *)memalloc(iloglen + 1);
-			ilogmem[iloglen] = 0;
-			glGetShaderInfoLog(v.vert_id, iloglen, &iloglen, ilogmem);
-
-			String err_string = get_shader_name() + ": Vertex Program Compilation Failed:\n";
-
-			err_string += ilogmem;
-			_display_error_with_code(err_string, strings);
-			memfree(ilogmem);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-		}
-
-		ERR_FAIL_V(NULL);
-	}
-
-	//_display_error_with_code("pepo", strings);
-
 	/* FRAGMENT SHADER */
 
-	strings.resize(strings_base_size);
 	//fragment precision is medium
-	strings.push_back("precision highp float;\n");
-	strings.push_back("precision highp int;\n");
+	fragment_strings.push_back("precision highp float;\n");
+	fragment_strings.push_back("precision highp int;\n");
 #ifndef GLES_OVER_GL
-	strings.push_back("precision highp sampler2D;\n");
-	strings.push_back("precision highp samplerCube;\n");
-	strings.push_back("precision highp sampler2DArray;\n");
+	fragment_strings.push_back("precision highp sampler2D;\n");
+	fragment_strings.push_back("precision highp samplerCube;\n");
+	fragment_strings.push_back("precision highp sampler2DArray;\n");
 #endif
 
-	strings.push_back(fragment_code0.get_data());
+	fragment_strings.push_back(fragment_code0.get_data());
 	if (cc) {
-		material_string = cc->uniforms.ascii();
-		strings.push_back(material_string.get_data());
+		fragment_strings.push_back(material_string.get_data());
 	}
 
-	strings.push_back(fragment_code1.get_data());
+	fragment_strings.push_back(fragment_code1.get_data());
 
 	if (cc) {
-		code_globals = cc->fragment_globals.ascii();
-		strings.push_back(code_globals.get_data());
+		code_globals2 = cc->fragment_globals.ascii();
+		fragment_strings.push_back(code_globals2.get_data());
 	}
 
-	strings.push_back(fragment_code2.get_data());
+	fragment_strings.push_back(fragment_code2.get_data());
 
 	if (cc) {
-		code_string = cc->light.ascii();
-		strings.push_back(code_string.get_data());
+		light_string = cc->light.ascii();
+		fragment_strings.push_back(light_string.get_data());
 	}
 
-	strings.push_back(fragment_code3.get_data());
+	fragment_strings.push_back(fragment_code3.get_data());
 
 	if (cc) {
 		code_string2 = cc->fragment.ascii();
-		strings.push_back(code_string2.get_data());
+		fragment_strings.push_back(code_string2.get_data());
 	}
 
-	strings.push_back(fragment_code4.get_data());
+	fragment_strings.push_back(fragment_code4.get_data());
 
 #ifdef DEBUG_SHADER
-	DEBUG_PRINT("\nFragment Globals:\n\n" + String(code_globals.get_data()));
+	DEBUG_PRINT("\nFragment Globals:\n\n" + String(code_globals2.get_data()));
 	DEBUG_PRINT("\nFragment Code:\n\n" + String(code_string2.get_data()));
-	for (int i = 0; i < strings.size(); i++) {
+	for (int i = 0; i < fragment_strings.size(); i++) {
 
-		//print_line("frag strings "+itos(i)+":"+String(strings[i]));
+		//print_line("frag strings "+itos(i)+":"+String(fragment_strings[i]));
 	}
 #endif
 
-	v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(v.frag_id, strings.size(), &strings[0], NULL);
-	glCompileShader(v.frag_id);
+	/* CREATE PROGRAM */
 
-	glGetShaderiv(v.frag_id, GL_COMPILE_STATUS, &status);
-	if (status == GL_FALSE) {
-		// error compiling
-		GLsizei iloglen;
-		glGetShaderiv(v.frag_id, GL_INFO_LOG_LENGTH, &iloglen);
+	v.id = glCreateProgram();
 
-		if (iloglen < 0) {
+	ERR_FAIL_COND_V(v.id == 0, NULL);
 
-			glDeleteShader(v.frag_id);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-			ERR_PRINT("Fragment shader compilation failed with empty log");
-		} else {
+	ShaderCacheGLES3 *shader_cache = ShaderCacheGLES3::get_singleton();
+	String program_hash;
 
-			if (iloglen == 0) {
+	if (shader_cache && shader_cache->is_enabled()) {
 
-				iloglen = 4096; //buggy driver (Adreno 220+....)
-			}
+		program_hash = shader_cache->hash_program(get_shader_name(), strings, fragment_strings);
 
-			char *ilogmem = (char *)memalloc(iloglen + 1);
-			ilogmem[iloglen] = 0;
-			glGetShaderInfoLog(v.frag_id, iloglen, &iloglen, ilogmem);
+		if (shader_cache->load_program(program_hash, v.id)) {
 
-			String err_string = get_shader_name() + ": Fragment Program Compilation Failed:\n";
+			v.vert_id = 0;
+			v.frag_id = 0;
 
-			err_string += ilogmem;
-			_display_error_with_code(err_string, strings);
-			ERR_PRINT(err_string.ascii().get_data());
-			memfree(ilogmem);
-			glDeleteShader(v.frag_id);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
+			_setup_version(v, cc);
+			shader_cache->record_version(get_shader_name(), cc ? cc->code_hash : String(), conditional_version.version);
+			return &v;
 		}
 
-		ERR_FAIL_V(NULL);
+		// a failed binary load may leave the program unusable for linking, start from scratch
+		glDeleteProgram(v.id);
+		v.id = glCreateProgram();
+		ERR_FAIL_COND_V(v.id == 0, NULL);
+
+		glProgramParameteri(v.id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	}
 
+	v.vert_id = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(v.vert_id, strings.size(), &strings[0], NULL);
+	glCompileShader(v.vert_id);
+
+	v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(v.frag_id, fragment_strings.size(), &fragment_strings[0], NULL);
+	glCompileShader(v.frag_id);
+
 	glAttachShader(v.id, v.frag_id);
 	glAttachShader(v.id, v.vert_id);
 
@@ -465,6 +438,110 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 
 	glLinkProgram(v.id);
 
+	v.program_hash = program_hash;
+
+	// Only material code has a fallback to draw with, and transform feedback
+	// shaders can't be replaced without corrupting what they simulate.
+	if (async_compilation && cc && !feedback_count) {
+
+		// Don't query any status yet, that would block until the driver is done.
+		v.compiling = true;
+		cc->versions.insert(conditional_version.version);
+		return &v;
+	}
+
+	if (!_check_version_status(v, &strings, &fragment_strings)) {
+		ERR_FAIL_V(NULL);
+	}
+
+	_finish_version(v, cc);
+
+	return &v;
+}
+
+bool ShaderGLES3::_check_version_status(Version &v, const Vector<const char *> *p_vertex_strings, const Vector<const char *> *p_fragment_strings) {
+
+	GLint status;
+
+	glGetShaderiv(v.vert_id, GL_COMPILE_STATUS, &status);
+	if (status == GL_FALSE) {
+		// error compiling
+		GLsizei iloglen;
+		glGetShaderiv(v.vert_id, GL_INFO_LOG_LENGTH, &iloglen);
+
+		if (iloglen < 0) {
+
+			ERR_PRINT("Vertex shader compilation failed with empty log");
+		} else {
+
+			if (iloglen == 0) {
+
+				iloglen = 4096; //buggy driver (Adreno 220+....)
+			}
+
+			char *ilogmem = (char *)memalloc(iloglen + 1);
+			ilogmem[iloglen] = 0;
+			glGetShaderInfoLog(v.vert_id, iloglen, &iloglen, ilogmem);
+
+			String err_string = get_shader_name() + ": Vertex Program Compilation Failed:\n";
+
+			err_string += ilogmem;
+			if (p_vertex_strings) {
+				_display_error_with_code(err_string, *p_vertex_strings);
+			} else {
+				ERR_PRINT(err_string.ascii().get_data());
+			}
+			memfree(ilogmem);
+		}
+
+		glDeleteShader(v.frag_id);
+		glDeleteShader(v.vert_id);
+		glDeleteProgram(v.id);
+		v.id = 0;
+
+		return false;
+	}
+
+	//_display_error_with_code("pepo", strings);
+
+	glGetShaderiv(v.frag_id, GL_COMPILE_STATUS, &status);
+	if (status == GL_FALSE) {
+		// error compiling
+		GLsizei iloglen;
+		glGetShaderiv(v.frag_id, GL_INFO_LOG_LENGTH, &iloglen);
+
+		if (iloglen < 0) {
+
+			ERR_PRINT("Fragment shader compilation failed with empty log");
+		} else {
+
+			if (iloglen == 0) {
+
+				iloglen = 4096; //buggy driver (Adreno 220+....)
+			}
+
+			char *ilogmem = (char *)memalloc(iloglen + 1);
+			ilogmem[iloglen] = 0;
+			glGetShaderInfoLog(v.frag_id, iloglen, &iloglen, ilogmem);
+
+			String err_string = get_shader_name() + ": Fragment Program Compilation Failed:\n";
+
+			err_string += ilogmem;
+			if (p_fragment_strings) {
+				_display_error_with_code(err_string, *p_fragment_strings);
+			}
+			ERR_PRINT(err_string.ascii().get_data());
+			memfree(ilogmem);
+		}
+
+		glDeleteShader(v.frag_id);
+		glDeleteShader(v.vert_id);
+		glDeleteProgram(v.id);
+		v.id = 0;
+
+		return false;
+	}
+
 	glGetProgramiv(v.id, GL_LINK_STATUS, &status);
 
 	if (status == GL_FALSE) {
@@ -478,7 +555,7 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 			glDeleteShader(v.vert_id);
 			glDeleteProgram(v.id);
 			v.id = 0;
-			ERR_FAIL_COND_V(iloglen < 0, NULL);
+			ERR_FAIL_COND_V(iloglen < 0, false);
 		}
 
 		if (iloglen == 0) {
@@ -493,7 +570,9 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		String err_string = get_shader_name() + ": Program LINK FAILED:\n";
 
 		err_string += ilogmem;
-		_display_error_with_code(err_string, strings);
+		if (p_fragment_strings) {
+			_display_error_with_code(err_string, *p_fragment_strings);
+		}
 		ERR_PRINT(err_string.ascii().get_data());
 		Memory::free_static(ilogmem);
 		glDeleteShader(v.frag_id);
@@ -501,9 +580,46 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		glDeleteProgram(v.id);
 		v.id = 0;
 
+		return false;
+	}
+
+	return true;
+}
+
+void ShaderGLES3::_finish_version(Version &v, CustomCode *cc) {
+
+	if (v.program_hash != String()) {
+		ShaderCacheGLES3 *shader_cache = ShaderCacheGLES3::get_singleton();
+		shader_cache->store_program(v.program_hash, v.id);
+		shader_cache->record_version(get_shader_name(), cc ? cc->code_hash : String(), conditional_version.version);
+		v.program_hash = String();
+	}
+
+	_setup_version(v, cc);
+}
+
+ShaderGLES3::Version *ShaderGLES3::_poll_version(Version &v, CustomCode *cc) {
+
+	GLint done = GL_FALSE;
+	glGetProgramiv(v.id, _EXT_COMPLETION_STATUS, &done);
+	if (done == GL_FALSE) {
+		return &v; // still compiling, bind() draws with the fallback
+	}
+
+	v.compiling = false;
+
+	if (!_check_version_status(v, NULL, NULL)) {
+		v.program_hash = String();
 		ERR_FAIL_V(NULL);
 	}
 
+	_finish_version(v, cc);
+
+	return &v;
+}
+
+void ShaderGLES3::_setup_version(Version &v, CustomCode *cc) {
+
 	/* UNIFORMS */
 
 	glUseProgram(v.id);
@@ -553,8 +669,59 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	if (cc) {
 		cc->versions.insert(conditional_version.version);
 	}
+}
+
+void ShaderGLES3::_warm_up() {
+
+	ShaderCacheGLES3 *shader_cache = ShaderCacheGLES3::get_singleton();
+	if (!shader_cache || !shader_cache->is_enabled()) {
+		return;
+	}
 
-	return &v;
+	VersionKey prev_conditional_version = conditional_version;
+	Version *prev_version = version;
+
+	Vector<uint32_t> versions;
+	shader_cache->get_versions(get_shader_name(), String(), versions);
+
+	conditional_version.code_version = 0;
+	for (int i = 0; i < versions.size(); i++) {
+		conditional_version.version = versions[i];
+		get_current_version();
+	}
+
+	const uint32_t *K = NULL;
+	while ((K = custom_code_map.next(K))) {
+
+		const CustomCode &cc = custom_code_map[*K];
+		if (cc.code_hash == String()) {
+			continue; // code not set yet
+		}
+
+		versions.clear();
+		shader_cache->get_versions(get_shader_name(), cc.code_hash, versions);
+
+		conditional_version.code_version = *K;
+		for (int i = 0; i < versions.size(); i++) {
+			conditional_version.version = versions[i];
+			get_current_version();
+		}
+	}
+
+	conditional_version = prev_conditional_version;
+	version = prev_version;
+}
+
+void ShaderGLES3::warm_up_all() {
+
+	for (ShaderGLES3 *shader = first_shader; shader; shader = shader->next_shader) {
+		shader->_warm_up();
+	}
+
+	// get_current_version() leaves no program bound, force the next bind() to restore it
+	if (active) {
+		active->unbind();
+	}
 }
 
 GLint ShaderGLES3::get_uniform_location(const String &p_name) const {
@@ -725,6 +892,12 @@ void ShaderGLES3::set_custom_shader_code(uint32_t p_code_id, const String &p_ver
 	cc->uniforms = p_uniforms;
 	cc->custom_defines = p_custom_defines;
 	cc->version++;
+
+	String code_hash_src = p_vertex + "\n" + p_vertex_globals + "\n" + p_fragment + "\n" + p_fragment_globals + "\n" + p_light + "\n" + p_uniforms;
+	for (int i = 0; i < p_custom_defines.size(); i++) {
+		code_hash_src += "\n" + String(p_custom_defines[i].get_data());
+	}
+	cc->code_hash = code_hash_src.sha256_text();
 }
 
 void ShaderGLES3::set_custom_shader(uint32_t p_code_id) {
@@ -759,6 +932,11 @@ void ShaderGLES3::free_custom_shader(uint32_t p_code_id) {
 	custom_code_map.erase(p_code_id);
 }
 
+void ShaderGLES3::set_async_compilation(bool p_enable) {
+
+	async_compilation = p_enable;
+}
+
 void ShaderGLES3::set_base_material_tex_index(int p_idx) {
 
 	base_material_tex_index = p_idx;
@@ -769,9 +947,23 @@ ShaderGLES3::ShaderGLES3() {
 	last_custom_code = 1;
 	uniforms_dirty = true;
 	base_material_tex_index = 0;
+
+	using_fallback = false;
+
+	next_shader = first_shader;
+	first_shader = this;
 }
 
 ShaderGLES3::~ShaderGLES3() {
 
 	finish();
+
+	ShaderGLES3 **shader = &first_shader;
+	while (*shader) {
+		if (*shader == this) {
+			*shader = next_shader;
+			break;
+		}
+		shader = &(*shader)->next_shader;
+	}
 }
@@ -114,6 +114,7 @@ private:
 		Vector<StringName> texture_uniforms;
 		Vector<CharString> custom_defines;
 		Set<uint32_t> versions;
+		String code_hash; // stable across runs, used to find the versions to warm up
 	};
 
 	struct Version {
@@ -125,16 +126,20 @@ private:
 		Vector<GLint> texture_uniform_locations;
 		uint32_t code_version;
 		bool ok;
+		bool compiling; // linked asynchronously, status not queried yet
+		String program_hash;
 		Version() :
 				id(0),
 				vert_id(0),
 				frag_id(0),
 				uniform_location(NULL),
 				code_version(0),
-				ok(false) {}
+				ok(false),
+				compiling(false) {}
 	};
 
 	Version *version;
+	bool using_fallback;
 
 	union VersionKey {
 
@@ -187,8 +192,17 @@ private:
 	int base_material_tex_index;
 
 	Version *get_current_version();
+	bool _check_version_status(Version &v, const Vector<const char *> *p_vertex_strings, const Vector<const char *> *p_fragment_strings);
+	void _finish_version(Version &v, CustomCode *cc);
+	Version *_poll_version(Version &v, CustomCode *cc);
+	void _setup_version(Version &v, CustomCode *cc);
+	void _warm_up();
 
 	static ShaderGLES3 *active;
+	static bool async_compilation;
+
+	static ShaderGLES3 *first_shader;
+	ShaderGLES3 *next_shader;
 
 	int max_image_units;
 
@@ -362,6 +376,12 @@ public:
 	virtual void init() = 0;
 	void finish();
 
+	// Compiles every version the shader cache saw being used in previous runs.
+	static void warm_up_all();
+
+	// Requires GL_KHR_parallel_shader_compile (or the ARB variant) to poll without blocking.
+	static void set_async_compilation(bool p_enable);
+
 	void set_base_material_tex_index(int p_idx);
 
 	void add_custom_define(const String &p_define) {
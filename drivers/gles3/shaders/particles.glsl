@@ -38,6 +38,16 @@ uniform float lifetime;
 uniform mat4 emission_transform;
 uniform uint random_seed;
 
+#ifdef USE_COLLISION_HEIGHTFIELD
+
+// red channel is the height, from the bottom (0) to the top (1) of the box, laid over its x and z extents
+uniform highp sampler2D height_field; //texunit:-1
+uniform highp vec3 height_field_position;
+uniform highp vec3 height_field_size;
+uniform float collision_bounce;
+
+#endif
+
 out highp vec4 out_color; //tfb:
 out highp vec4 out_velocity_active; //tfb:
 out highp vec4 out_custom; //tfb:
@@ -218,6 +228,33 @@ VERTEX_SHADER_CODE
 			xform[3].xyz += out_velocity_active.xyz * local_delta;
 		}
 #endif
+
+#ifdef USE_COLLISION_HEIGHTFIELD
+
+		{
+			highp vec3 uvw = (xform[3].xyz - height_field_position) / height_field_size;
+
+			if (all(greaterThanEqual(uvw, vec3(0.0))) && all(lessThanEqual(uvw.xz, vec2(1.0)))) {
+
+				float height = texture(height_field, uvw.xz).r;
+
+				if (uvw.y < height) {
+
+					vec2 texel = 1.0 / vec2(textureSize(height_field, 0));
+					float slope_x = (texture(height_field, uvw.xz + vec2(texel.x, 0.0)).r - texture(height_field, uvw.xz - vec2(texel.x, 0.0)).r) * height_field_size.y / (2.0 * texel.x * height_field_size.x);
+					float slope_z = (texture(height_field, uvw.xz + vec2(0.0, texel.y)).r - texture(height_field, uvw.xz - vec2(0.0, texel.y)).r) * height_field_size.y / (2.0 * texel.y * height_field_size.z);
+					vec3 normal = normalize(vec3(-slope_x, 1.0, -slope_z));
+
+					xform[3].y = height_field_position.y + height * height_field_size.y;
+
+					float speed_into = dot(out_velocity_active.xyz, normal);
+					if (speed_into < 0.0) {
+						out_velocity_active.xyz -= (1.0 + collision_bounce) * speed_into * normal;
+					}
+				}
+			}
+		}
+#endif
 	} else {
 		xform = mat4(0.0);
 	}
@@ -0,0 +1,107 @@
+/* clang-format off */
+[vertex]
+
+layout(location = 0) in highp vec4 vertex_attrib;
+/* clang-format on */
+
+#ifdef USE_GATHER
+
+// particles are stored 256 per row, 6 texels each
+#define PARTICLES_PER_ROW 256
+
+uniform highp sampler2D sort_keys; //texunit:0
+uniform highp sampler2D particle_data; //texunit:1
+uniform int sort_width;
+
+out highp vec4 out_color; //tfb:USE_GATHER
+out highp vec4 out_velocity_active; //tfb:USE_GATHER
+out highp vec4 out_custom; //tfb:USE_GATHER
+out highp vec4 out_xform_1; //tfb:USE_GATHER
+out highp vec4 out_xform_2; //tfb:USE_GATHER
+out highp vec4 out_xform_3; //tfb:USE_GATHER
+
+#endif
+
+void main() {
+
+#ifdef USE_GATHER
+
+	int index = gl_VertexID;
+	int source = int(texelFetch(sort_keys, ivec2(index % sort_width, index / sort_width), 0).g);
+	ivec2 base = ivec2((source % PARTICLES_PER_ROW) * 6, source / PARTICLES_PER_ROW);
+
+	out_color = texelFetch(particle_data, base, 0);
+	out_velocity_active = texelFetch(particle_data, base + ivec2(1, 0), 0);
+	out_custom = texelFetch(particle_data, base + ivec2(2, 0), 0);
+	out_xform_1 = texelFetch(particle_data, base + ivec2(3, 0), 0);
+	out_xform_2 = texelFetch(particle_data, base + ivec2(4, 0), 0);
+	out_xform_3 = texelFetch(particle_data, base + ivec2(5, 0), 0);
+
+	gl_Position = vec4(0.0);
+#else
+	gl_Position = vertex_attrib;
+#endif
+}
+
+/* clang-format off */
+[fragment]
+
+// keys are (depth, particle index) pairs, one per texel, sort_width texels per row
+uniform int sort_width;
+/* clang-format on */
+
+#ifdef USE_KEYS
+
+#define PARTICLES_PER_ROW 256
+
+uniform highp sampler2D particle_data; //texunit:1
+uniform int total_particles;
+uniform highp vec3 sort_direction;
+
+#else
+
+uniform highp sampler2D source_keys; //texunit:0
+uniform int sort_stage;
+uniform int sort_step;
+
+#endif
+
+#ifndef USE_GATHER
+layout(location = 0) out highp vec4 frag_color;
+#endif
+
+void main() {
+
+#ifndef USE_GATHER
+
+	ivec2 coord = ivec2(gl_FragCoord.xy);
+	int index = coord.y * sort_width + coord.x;
+
+#ifdef USE_KEYS
+
+	if (index < total_particles) {
+		ivec2 base = ivec2((index % PARTICLES_PER_ROW) * 6, index / PARTICLES_PER_ROW);
+		highp vec3 origin = vec3(texelFetch(particle_data, base + ivec2(3, 0), 0).w, texelFetch(particle_data, base + ivec2(4, 0), 0).w, texelFetch(particle_data, base + ivec2(5, 0), 0).w);
+		frag_color = vec4(dot(sort_direction, origin), float(index), 0.0, 1.0);
+	} else {
+		// padding up to the power of two sorts after every particle
+		frag_color = vec4(1e38, float(index), 0.0, 1.0);
+	}
+
+#else
+
+	// one compare and exchange step of a bitonic sort network
+	int partner = index ^ sort_step;
+	highp vec2 own = texelFetch(source_keys, coord, 0).rg;
+	highp vec2 other = texelFetch(source_keys, ivec2(partner % sort_width, partner / sort_width), 0).rg;
+
+	bool ascending = (index & sort_stage) == 0;
+	bool keep_lower = (index < partner) == ascending;
+	bool other_lower = other.x < own.x || (other.x == own.x && other.y < own.y);
+
+	frag_color = vec4(keep_lower == other_lower ? other : own, 0.0, 1.0);
+
+#endif
+
+#endif //USE_GATHER
+}
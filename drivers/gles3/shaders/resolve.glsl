@@ -25,6 +25,18 @@ in vec2 uv_interp;
 uniform sampler2D source_specular; // texunit:0
 uniform sampler2D source_ssr; // texunit:1
 
+#ifdef USE_SSR_UPSCALE
+uniform highp sampler2D source_depth; // texunit:2
+uniform float camera_z_near;
+uniform float camera_z_far;
+
+float linearize_depth(highp float p_depth) {
+
+	p_depth = p_depth * 2.0 - 1.0;
+	return 2.0 * camera_z_near * camera_z_far / (camera_z_far + camera_z_near - p_depth * (camera_z_far - camera_z_near));
+}
+#endif
+
 uniform vec2 pixel_size;
 
 in vec2 uv2_interp;
@@ -36,7 +48,39 @@ void main() {
 	vec4 specular = texture(source_specular, uv_interp);
 
 #ifdef USE_SSR
+
+#ifdef USE_SSR_UPSCALE
+
+	// reflections were traced at a reduced resolution, weight the four nearest texels by how close their depth is to this pixel
+	ivec2 ssr_size = textureSize(source_ssr, 0);
+	ivec2 depth_size = textureSize(source_depth, 0);
+	vec2 ssr_pos = uv_interp * vec2(ssr_size) - vec2(0.5);
+	ivec2 base = ivec2(floor(ssr_pos));
+	vec2 f = ssr_pos - vec2(base);
+
+	float depth = linearize_depth(textureLod(source_depth, uv_interp, 0.0).r);
+
+	vec4 ssr = vec4(0.0);
+	float total_weight = 0.0;
+
+	for (int i = 0; i < 4; i++) {
+
+		ivec2 ofs = ivec2(i & 1, i >> 1);
+		ivec2 tap = clamp(base + ofs, ivec2(0), ssr_size - ivec2(1));
+		vec2 tap_uv = (vec2(tap) + vec2(0.5)) / vec2(ssr_size);
+		float tap_depth = linearize_depth(texelFetch(source_depth, min(ivec2(tap_uv * vec2(depth_size)), depth_size - ivec2(1)), 0).r);
+
+		vec2 bilinear = mix(vec2(1.0) - f, f, vec2(ofs));
+		float weight = bilinear.x * bilinear.y / (0.001 + abs(tap_depth - depth) / depth);
+
+		ssr += texelFetch(source_ssr, tap, 0) * weight;
+		total_weight += weight;
+	}
+
+	ssr /= max(total_weight, 0.0001);
+#else
 	vec4 ssr = textureLod(source_ssr, uv_interp, 0.0);
+#endif
 	specular.rgb = mix(specular.rgb, ssr.rgb * specular.a, ssr.a);
 #endif
 
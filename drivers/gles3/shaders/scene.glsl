@@ -825,6 +825,36 @@ uniform int spot_light_count;
 uniform int reflection_indices[MAX_FORWARD_LIGHTS];
 uniform int reflection_count;
 
+#ifdef USE_CLUSTERED_LIGHTING
+
+uniform highp usampler2D cluster_texture; // texunit:-11
+uniform highp vec4 cluster_xy_params;
+uniform highp vec4 cluster_z_params;
+
+// x: offset of the first item, yzw: omni, spot and reflection counts
+uvec4 cluster_get_header(highp vec3 p_vertex) {
+
+	highp float depth = max(-p_vertex.z, 0.0001);
+	if (cluster_z_params.w > 0.0) {
+		depth = log(depth);
+	}
+
+	ivec2 cell = clamp(ivec2(gl_FragCoord.xy * cluster_xy_params.xy), ivec2(0), ivec2(cluster_xy_params.zw) - ivec2(1));
+	int slice = clamp(int(depth * cluster_z_params.x + cluster_z_params.y), 0, int(cluster_z_params.z) - 1);
+	int index = (slice * int(cluster_xy_params.w) + cell.y) * int(cluster_xy_params.z) + cell.x;
+
+	return texelFetch(cluster_texture, ivec2(index % CLUSTER_TEXTURE_WIDTH, index / CLUSTER_TEXTURE_WIDTH), 0);
+}
+
+int cluster_get_item(uint p_pos) {
+
+	int texel = int(p_pos >> 2u);
+	uvec4 items = texelFetch(cluster_texture, ivec2(texel % CLUSTER_TEXTURE_WIDTH, texel / CLUSTER_TEXTURE_WIDTH), 0);
+	return int(items[int(p_pos & 3u)]);
+}
+
+#endif
+
 #endif
 
 #if defined(SCREEN_TEXTURE_USED)
@@ -1869,6 +1899,14 @@ FRAGMENT_SHADER_CODE
 		reflection_process(reflection_indices[i], vertex, normal, binormal, tangent, roughness, anisotropy, ambient_light, env_reflection_light, reflection_accum, ambient_accum);
 	}
 
+#ifdef USE_CLUSTERED_LIGHTING
+	uvec4 cluster_header = cluster_get_header(vertex);
+	uint cluster_reflection_ofs = cluster_header.x + cluster_header.y + cluster_header.z;
+	for (uint i = 0u; i < cluster_header.w; i++) {
+		reflection_process(cluster_get_item(cluster_reflection_ofs + i), vertex, normal, binormal, tangent, roughness, anisotropy, ambient_light, env_reflection_light, reflection_accum, ambient_accum);
+	}
+#endif
+
 	if (reflection_accum.a > 0.0) {
 		specular_light += reflection_accum.rgb / reflection_accum.a;
 	} else {
@@ -2063,6 +2101,16 @@ FRAGMENT_SHADER_CODE
 		light_process_spot(spot_light_indices[i], vertex, eye_vec, normal, binormal, tangent, albedo, transmission, roughness, metallic, specular, rim, rim_tint, clearcoat, clearcoat_gloss, anisotropy, specular_blob_intensity, diffuse_light, specular_light, alpha);
 	}
 
+#ifdef USE_CLUSTERED_LIGHTING
+	for (uint i = 0u; i < cluster_header.y; i++) {
+		light_process_omni(cluster_get_item(cluster_header.x + i), vertex, eye_vec, normal, binormal, tangent, albedo, transmission, roughness, metallic, specular, rim, rim_tint, clearcoat, clearcoat_gloss, anisotropy, specular_blob_intensity, diffuse_light, specular_light, alpha);
+	}
+
+	for (uint i = 0u; i < cluster_header.z; i++) {
+		light_process_spot(cluster_get_item(cluster_header.x + cluster_header.y + i), vertex, eye_vec, normal, binormal, tangent, albedo, transmission, roughness, metallic, specular, rim, rim_tint, clearcoat, clearcoat_gloss, anisotropy, specular_blob_intensity, diffuse_light, specular_light, alpha);
+	}
+#endif
+
 #endif //USE_VERTEX_LIGHTING
 
 #endif
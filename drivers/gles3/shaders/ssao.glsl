@@ -60,6 +60,8 @@ uniform highp usampler2D source_depth_mipmaps; //texunit:1
 uniform sampler2D source_normal; //texunit:2
 
 uniform ivec2 screen_size;
+// the AO target is this many times smaller (as a power of two) than the screen, positions are still read at full resolution
+uniform int resolution_shift;
 uniform float camera_z_far;
 uniform float camera_z_near;
 
@@ -201,7 +203,8 @@ float sampleAO(in ivec2 ssC, in vec3 C, in vec3 n_C, in float ssDiskRadius, in f
 
 void main() {
 	// Pixel being shaded
-	ivec2 ssC = ivec2(gl_FragCoord.xy);
+	ivec2 target_C = ivec2(gl_FragCoord.xy);
+	ivec2 ssC = (target_C << resolution_shift) + ivec2((1 << resolution_shift) >> 1);
 
 	// World space point being shaded
 	vec3 C = getPosition(ssC);
@@ -267,10 +270,10 @@ void main() {
 	// Bilateral box-filter over a quad for free, respecting depth edges
 	// (the difference that this makes is subtle)
 	if (abs(dFdx(C.z)) < 0.02) {
-		A -= dFdx(A) * (float(ssC.x & 1) - 0.5);
+		A -= dFdx(A) * (float(target_C.x & 1) - 0.5);
 	}
 	if (abs(dFdy(C.z)) < 0.02) {
-		A -= dFdy(A) * (float(ssC.y & 1) - 0.5);
+		A -= dFdy(A) * (float(target_C.y & 1) - 0.5);
 	}
 
 	visibility = A;
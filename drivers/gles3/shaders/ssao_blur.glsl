@@ -57,11 +57,60 @@ uniform float camera_z_near;
 
 uniform ivec2 screen_size;
 
+// the AO being filtered is this many times smaller (as a power of two) than the depth buffer
+uniform int resolution_shift;
+
+float linearize_depth(float p_depth) {
+
+	p_depth = p_depth * 2.0 - 1.0;
+	return 2.0 * camera_z_near * camera_z_far / (camera_z_far + camera_z_near - p_depth * (camera_z_far - camera_z_near));
+}
+
+#ifdef USE_UPSCALE
+
+// depth aware upsampling of the reduced resolution AO into the full resolution buffer, screen_size is the reduced size
+
+void main() {
+
+	ivec2 ssC = ivec2(gl_FragCoord.xy);
+	float depth = linearize_depth(texelFetch(source_depth, ssC, 0).r);
+
+	vec2 pos = (vec2(ssC) + vec2(0.5)) / float(1 << resolution_shift) - vec2(0.5);
+	ivec2 base = ivec2(floor(pos));
+	vec2 f = pos - vec2(base);
+
+	ivec2 clamp_limit = screen_size - ivec2(1);
+	ivec2 depth_limit = (screen_size << resolution_shift) - ivec2(1);
+
+	float sum = 0.0;
+	float total_weight = 0.0;
+
+	for (int i = 0; i < 4; i++) {
+
+		ivec2 ofs = ivec2(i & 1, i >> 1);
+		ivec2 low_pos = clamp(base + ofs, ivec2(0), clamp_limit);
+
+		// AO texels were computed for the center pixel of their block
+		ivec2 depth_pos = min((low_pos << resolution_shift) + ivec2((1 << resolution_shift) >> 1), depth_limit);
+		float low_depth = linearize_depth(texelFetch(source_depth, depth_pos, 0).r);
+
+		vec2 bilinear = mix(vec2(1.0) - f, f, vec2(ofs));
+		float weight = bilinear.x * bilinear.y * max(0.0001, 1.0 - edge_sharpness * abs(low_depth - depth));
+
+		sum += texelFetch(source_ssao, low_pos, 0).r * weight;
+		total_weight += weight;
+	}
+
+	visibility = sum / max(total_weight, 0.0001);
+}
+
+#else
+
 void main() {
 
 	ivec2 ssC = ivec2(gl_FragCoord.xy);
 
-	float depth = texelFetch(source_depth, ssC, 0).r;
+	float depth = texelFetch(source_depth, ssC << resolution_shift, 0).r;
 	//vec3 normal = texelFetch(source_normal, ssC, 0).rgb * 2.0 - 1.0;
 
 	depth = depth * 2.0 - 1.0;
@@ -95,7 +144,7 @@ void main() {
 			ivec2 ppos = ssC + axis * (r * filter_scale);
 			float value = texelFetch(source_ssao, clamp(ppos, ivec2(0), clamp_limit), 0).r;
 			ivec2 rpos = clamp(ppos, ivec2(0), clamp_limit);
-			float temp_depth = texelFetch(source_depth, rpos, 0).r;
+			float temp_depth = texelFetch(source_depth, rpos << resolution_shift, 0).r;
 			//vec3 temp_normal = texelFetch(source_normal, rpos, 0).rgb * 2.0 - 1.0;
 
 			temp_depth = temp_depth * 2.0 - 1.0;
@@ -117,3 +166,5 @@ void main() {
 	const float epsilon = 0.0001;
 	visibility = sum / (totalWeight + epsilon);
 }
+
+#endif
@@ -0,0 +1,67 @@
+/* clang-format off */
+[vertex]
+
+layout(location = 0) in highp vec4 vertex_attrib;
+/* clang-format on */
+layout(location = 4) in vec2 uv_in;
+
+out vec2 uv_interp;
+
+void main() {
+
+	uv_interp = uv_in;
+	gl_Position = vertex_attrib;
+}
+
+/* clang-format off */
+[fragment]
+
+#if !defined(GLES_OVER_GL)
+precision mediump float;
+#endif
+/* clang-format on */
+
+in vec2 uv_interp;
+
+uniform highp sampler2D source_current; //texunit:0
+uniform highp sampler2D source_history; //texunit:1
+uniform highp sampler2D source_depth; //texunit:2
+
+// from this frame's clip space to the clip space the history was rendered in
+uniform highp mat4 reprojection;
+// weight of the current frame, 1.0 discards the history
+uniform float blend;
+
+layout(location = 0) out vec4 frag_color;
+
+void main() {
+
+	ivec2 coord = ivec2(gl_FragCoord.xy);
+	ivec2 limit = textureSize(source_current, 0) - ivec2(1);
+
+	vec4 current = texelFetch(source_current, coord, 0);
+
+	// the history is clamped to the neighborhood of this frame, which rejects what got disoccluded or changed
+	vec4 neighbor_min = current;
+	vec4 neighbor_max = current;
+
+	for (int i = 0; i < 4; i++) {
+		ivec2 ofs = i < 2 ? ivec2(i * 2 - 1, 0) : ivec2(0, i * 2 - 5);
+		vec4 neighbor = texelFetch(source_current, clamp(coord + ofs, ivec2(0), limit), 0);
+		neighbor_min = min(neighbor_min, neighbor);
+		neighbor_max = max(neighbor_max, neighbor);
+	}
+
+	highp float depth = textureLod(source_depth, uv_interp, 0.0).r;
+	highp vec4 prev_pos = reprojection * vec4(vec3(uv_interp, depth) * 2.0 - 1.0, 1.0);
+	highp vec2 prev_uv = prev_pos.xy / prev_pos.w * 0.5 + 0.5;
+
+	if (blend >= 1.0 || any(lessThan(prev_uv, vec2(0.0))) || any(greaterThan(prev_uv, vec2(1.0)))) {
+		frag_color = current;
+		return;
+	}
+
+	vec4 history = clamp(textureLod(source_history, prev_uv, 0.0), neighbor_min, neighbor_max);
+
+	frag_color = mix(history, current, blend);
+}
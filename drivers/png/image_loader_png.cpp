@@ -39,6 +39,15 @@
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, FileAccess *f, bool p_force_linear, float p_scale) {
 
 	const size_t buffer_size = f->get_len();
+
+	const uint8_t *mapped = f->get_mapped_data();
+	if (mapped) {
+		//decode straight from memory, no copy
+		Error err = PNGDriverCommon::png_to_image(mapped, buffer_size, p_image);
+		f->close();
+		return err;
+	}
+
 	PoolVector<uint8_t> file_buffer;
 	Error err = file_buffer.resize(buffer_size);
 	if (err) {
@@ -292,7 +292,10 @@ Error AudioDriverPulseAudio::init() {
 	Error err = init_device();
 	if (err == OK) {
 		mutex = Mutex::create();
-		thread = Thread::create(AudioDriverPulseAudio::thread_func, this);
+		Thread::Settings settings;
+		settings.priority = Thread::PRIORITY_REALTIME;
+		settings.name = "AudioDriverPulseAudio";
+		thread = Thread::create(AudioDriverPulseAudio::thread_func, this, settings);
 	}
 
 	return OK;
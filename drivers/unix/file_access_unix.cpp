@@ -41,6 +41,7 @@
 #include <errno.h>
 
 #if defined(UNIX_ENABLED)
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -72,8 +73,20 @@ void FileAccessUnix::check_errors() const {
 	}
 }
 
+void FileAccessUnix::_unmap() {
+
+#if defined(UNIX_ENABLED)
+	if (mapped) {
+		munmap(mapped, mapped_len);
+		mapped = NULL;
+		mapped_len = 0;
+	}
+#endif
+}
+
 Error FileAccessUnix::_open(const String &p_path, int p_mode_flags) {
 
+	_unmap();
 	if (f)
 		fclose(f);
 	f = NULL;
@@ -154,6 +167,7 @@ void FileAccessUnix::close() {
 	if (!f)
 		return;
 
+	_unmap();
 	fclose(f);
 	f = NULL;
 
@@ -255,6 +269,38 @@ int FileAccessUnix::get_buffer(uint8_t *p_dst, int p_length) const {
 	return read;
 };
 
+const uint8_t *FileAccessUnix::map_read_only() {
+
+	ERR_FAIL_COND_V_MSG(!f, NULL, "File must be opened before use.");
+
+#if defined(UNIX_ENABLED)
+	if (mapped) {
+		return (const uint8_t *)mapped;
+	}
+
+	//only files that can't change under the mapping
+	if (flags != READ) {
+		return NULL;
+	}
+
+	size_t len = get_len();
+	if (len == 0) {
+		return NULL;
+	}
+
+	void *ptr = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (ptr == MAP_FAILED) {
+		return NULL;
+	}
+
+	mapped = ptr;
+	mapped_len = len;
+	return (const uint8_t *)mapped;
+#else
+	return NULL;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 
 	return last_error;
@@ -357,6 +403,8 @@ CloseNotificationFunc FileAccessUnix::close_notification_func = NULL;
 FileAccessUnix::FileAccessUnix() :
 		f(NULL),
 		flags(0),
+		mapped(NULL),
+		mapped_len(0),
 		last_error(OK) {
 }
 
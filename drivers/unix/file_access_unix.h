@@ -44,6 +44,9 @@ class FileAccessUnix : public FileAccess {
 
 	FILE *f;
 	int flags;
+	void *mapped;
+	size_t mapped_len;
+	void _unmap();
 	void check_errors() const;
 	mutable Error last_error;
 	String save_path;
@@ -72,6 +75,8 @@ public:
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
 
+	virtual const uint8_t *map_read_only();
+
 	virtual Error get_error() const; ///< get last error
 
 	virtual void flush();
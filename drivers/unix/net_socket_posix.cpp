@@ -72,6 +72,12 @@
 #define SOCK_CLOSE ::close
 #define SOCK_CONNECT(p_sock, p_addr, p_addr_len) ::connect(p_sock, p_addr, p_addr_len)
 
+// Linux can transfer several datagrams per system call
+#if defined(__linux__) && defined(MSG_WAITFORONE)
+#define SOCK_MMSG_ENABLED
+#define SOCK_MMSG_MAX 32
+#endif
+
 /* Windows */
 #elif defined(WINDOWS_ENABLED)
 #include <winsock2.h>
@@ -161,6 +167,7 @@ void NetSocketPosix::make_default() {
 	}
 #endif
 	_create = _create_func;
+	NetSocketPollerPosix::make_default();
 }
 
 void NetSocketPosix::cleanup() {
@@ -616,6 +623,87 @@ Error NetSocketPosix::sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP
 	return OK;
 }
 
+Error NetSocketPosix::recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received) {
+#ifdef SOCK_MMSG_ENABLED
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	int count = MIN(p_count, SOCK_MMSG_MAX);
+	struct mmsghdr msgs[SOCK_MMSG_MAX];
+	struct iovec iov[SOCK_MMSG_MAX];
+	struct sockaddr_storage from[SOCK_MMSG_MAX];
+	memset(msgs, 0, sizeof(struct mmsghdr) * count);
+
+	for (int i = 0; i < count; i++) {
+		iov[i].iov_base = p_datagrams[i].buffer;
+		iov[i].iov_len = p_datagrams[i].len;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &from[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+	}
+
+	// Only wait for the first datagram if the socket is blocking.
+	int ret = ::recvmmsg(_sock, msgs, count, MSG_WAITFORONE, NULL);
+
+	if (ret < 0) {
+		r_received = 0;
+		NetError err = _get_socket_error();
+		if (err == ERR_NET_WOULD_BLOCK)
+			return ERR_BUSY;
+
+		return FAILED;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		p_datagrams[i].len = msgs[i].msg_len;
+		_set_ip_port(&from[i], p_datagrams[i].ip, p_datagrams[i].port);
+	}
+	r_received = ret;
+
+	return OK;
+#else
+	return NetSocket::recvfrom_batch(p_datagrams, p_count, r_received);
+#endif
+}
+
+Error NetSocketPosix::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent) {
+#ifdef SOCK_MMSG_ENABLED
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	int count = MIN(p_count, SOCK_MMSG_MAX);
+	struct mmsghdr msgs[SOCK_MMSG_MAX];
+	struct iovec iov[SOCK_MMSG_MAX];
+	struct sockaddr_storage addr[SOCK_MMSG_MAX];
+	memset(msgs, 0, sizeof(struct mmsghdr) * count);
+
+	for (int i = 0; i < count; i++) {
+		iov[i].iov_base = p_datagrams[i].buffer;
+		iov[i].iov_len = p_datagrams[i].len;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &addr[i];
+		msgs[i].msg_hdr.msg_namelen = _set_addr_storage(&addr[i], p_datagrams[i].ip, p_datagrams[i].port, _ip_type);
+	}
+
+	int ret = ::sendmmsg(_sock, msgs, count, 0);
+
+	if (ret < 0) {
+		r_sent = 0;
+		NetError err = _get_socket_error();
+		if (err == ERR_NET_WOULD_BLOCK)
+			return ERR_BUSY;
+
+		return FAILED;
+	}
+
+	r_sent = ret;
+
+	return OK;
+#else
+	return NetSocket::sendto_batch(p_datagrams, p_count, r_sent);
+#endif
+}
+
 Error NetSocketPosix::set_broadcasting_enabled(bool p_enabled) {
 	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
 	// IPv6 has no broadcast support.
@@ -738,4 +826,296 @@ Error NetSocketPosix::join_multicast_group(const IP_Address &p_multi_address, St
 Error NetSocketPosix::leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) {
 	return _change_multicast_group(p_multi_address, p_if_name, false);
 }
+
+NetSocketPoller *NetSocketPollerPosix::_create_func() {
+	return memnew(NetSocketPollerPosix);
+}
+
+void NetSocketPollerPosix::make_default() {
+	_create = _create_func;
+}
+
+Error NetSocketPollerPosix::_register(const Entry &p_entry, bool p_modify) {
+
+	bool in = p_entry.type != NetSocket::POLL_TYPE_OUT;
+	bool out = p_entry.type != NetSocket::POLL_TYPE_IN;
+
+#if defined(NET_SOCKET_POLLER_EPOLL)
+	ERR_FAIL_COND_V(_epoll == -1, ERR_UNAVAILABLE);
+
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = (in ? EPOLLIN : 0) | (out ? EPOLLOUT : 0);
+#ifdef EPOLLRDHUP
+	ev.events |= EPOLLRDHUP;
+#endif
+	ev.data.u64 = p_entry.id;
+
+	if (epoll_ctl(_epoll, p_modify ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, p_entry.sock, &ev) != 0) {
+		print_verbose("Unable to register socket with epoll, errno: " + itos(errno));
+		return FAILED;
+	}
+#elif defined(NET_SOCKET_POLLER_KQUEUE)
+	ERR_FAIL_COND_V(_kqueue == -1, ERR_UNAVAILABLE);
+
+	// Both filters always exist, so modifying never has to delete one that may not be there.
+	struct kevent changes[2];
+	EV_SET(&changes[0], p_entry.sock, EVFILT_READ, EV_ADD | (in ? EV_ENABLE : EV_DISABLE), 0, 0, NULL);
+	EV_SET(&changes[1], p_entry.sock, EVFILT_WRITE, EV_ADD | (out ? EV_ENABLE : EV_DISABLE), 0, 0, NULL);
+
+	if (kevent(_kqueue, changes, 2, NULL, 0, NULL) == -1) {
+		print_verbose("Unable to register socket with kqueue, errno: " + itos(errno));
+		return FAILED;
+	}
+#else
+	// The poll set is rebuilt from the entries by the callers.
+	(void)in;
+	(void)out;
+	(void)p_modify;
+#endif
+
+	return OK;
+}
+
+void NetSocketPollerPosix::_unregister(const Entry &p_entry) {
+
+	// Failures are expected when the socket was closed first, the kernel dropped it already.
+#if defined(NET_SOCKET_POLLER_EPOLL)
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	epoll_ctl(_epoll, EPOLL_CTL_DEL, p_entry.sock, &ev);
+#elif defined(NET_SOCKET_POLLER_KQUEUE)
+	struct kevent changes[2];
+	EV_SET(&changes[0], p_entry.sock, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+	EV_SET(&changes[1], p_entry.sock, EVFILT_WRITE, EV_DELETE, 0, 0, NULL);
+	kevent(_kqueue, changes, 2, NULL, 0, NULL);
+#else
+	(void)p_entry;
+#endif
+}
+
+Error NetSocketPollerPosix::add_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, uint64_t p_id) {
+
+	ERR_FAIL_COND_V(p_socket.is_null() || !p_socket->is_open(), ERR_INVALID_PARAMETER);
+
+	uint64_t key = (uint64_t)(uintptr_t)p_socket.ptr();
+	ERR_FAIL_COND_V(_positions.has(key), ERR_ALREADY_IN_USE);
+
+	Entry entry;
+	entry.socket = p_socket.ptr();
+	entry.sock = static_cast<const NetSocketPosix *>(p_socket.ptr())->_sock;
+	entry.id = p_id;
+	entry.type = p_type;
+
+	Error err = _register(entry, false);
+	if (err != OK) {
+		return err;
+	}
+
+	int pos = _entries.size();
+	_positions.set(key, pos);
+#if defined(NET_SOCKET_POLLER_KQUEUE)
+	_fd_positions.set((uint64_t)entry.sock, pos);
+#elif !defined(NET_SOCKET_POLLER_EPOLL)
+	_pollfds.resize(pos + 1);
+	_pollfds.write[pos].fd = entry.sock;
+	_pollfds.write[pos].events = (p_type != NetSocket::POLL_TYPE_OUT ? POLLIN : 0) | (p_type != NetSocket::POLL_TYPE_IN ? POLLOUT : 0);
+	_pollfds.write[pos].revents = 0;
+#endif
+	_entries.push_back(entry);
+
+	return OK;
+}
+
+Error NetSocketPollerPosix::modify_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, uint64_t p_id) {
+
+	ERR_FAIL_COND_V(p_socket.is_null(), ERR_INVALID_PARAMETER);
+
+	const int *pos = _positions.getptr((uint64_t)(uintptr_t)p_socket.ptr());
+	ERR_FAIL_COND_V(!pos, ERR_DOES_NOT_EXIST);
+
+	Entry &entry = _entries.write[*pos];
+	entry.id = p_id;
+	entry.type = p_type;
+
+#if !defined(NET_SOCKET_POLLER_EPOLL) && !defined(NET_SOCKET_POLLER_KQUEUE)
+	_pollfds.write[*pos].events = (p_type != NetSocket::POLL_TYPE_OUT ? POLLIN : 0) | (p_type != NetSocket::POLL_TYPE_IN ? POLLOUT : 0);
+#endif
+
+	return _register(entry, true);
+}
+
+void NetSocketPollerPosix::remove_socket(const Ref<NetSocket> &p_socket) {
+
+	ERR_FAIL_COND(p_socket.is_null());
+
+	uint64_t key = (uint64_t)(uintptr_t)p_socket.ptr();
+	const int *found = _positions.getptr(key);
+	ERR_FAIL_COND(!found);
+	int pos = *found;
+
+	_unregister(_entries[pos]);
+
+	_positions.erase(key);
+#if defined(NET_SOCKET_POLLER_KQUEUE)
+	_fd_positions.erase((uint64_t)_entries[pos].sock);
+#endif
+
+	// Move the last entry into the hole.
+	int last = _entries.size() - 1;
+	if (pos != last) {
+		_entries.write[pos] = _entries[last];
+		_positions.set((uint64_t)(uintptr_t)_entries[pos].socket, pos);
+#if defined(NET_SOCKET_POLLER_KQUEUE)
+		_fd_positions.set((uint64_t)_entries[pos].sock, pos);
+#elif !defined(NET_SOCKET_POLLER_EPOLL)
+		_pollfds.write[pos] = _pollfds[last];
+#endif
+	}
+
+	_entries.resize(last);
+#if !defined(NET_SOCKET_POLLER_EPOLL) && !defined(NET_SOCKET_POLLER_KQUEUE)
+	_pollfds.resize(last);
+#endif
+}
+
+int NetSocketPollerPosix::get_socket_count() const {
+	return _entries.size();
+}
+
+Error NetSocketPollerPosix::wait(int p_timeout, Vector<Event> &r_events) {
+
+	r_events.clear();
+
+	if (_entries.empty()) {
+		return ERR_BUSY;
+	}
+
+#if defined(NET_SOCKET_POLLER_EPOLL)
+	int max_events = MIN(_entries.size(), 1024);
+	if (_events.size() < max_events) {
+		_events.resize(max_events);
+	}
+
+	int ret = epoll_wait(_epoll, _events.ptrw(), max_events, p_timeout);
+	if (ret < 0) {
+		if (errno == EINTR) {
+			return ERR_BUSY;
+		}
+		print_verbose("Error when waiting on epoll, errno: " + itos(errno));
+		return FAILED;
+	}
+
+	r_events.resize(ret);
+	for (int i = 0; i < ret; i++) {
+
+		const struct epoll_event &ev = _events[i];
+		Event &e = r_events.write[i];
+		e.id = ev.data.u64;
+		e.readable = ev.events & EPOLLIN;
+		e.writable = ev.events & EPOLLOUT;
+		e.hangup = ev.events & (EPOLLHUP | EPOLLERR);
+#ifdef EPOLLRDHUP
+		e.hangup = e.hangup || (ev.events & EPOLLRDHUP);
+#endif
+	}
+#elif defined(NET_SOCKET_POLLER_KQUEUE)
+	int max_events = MIN(_entries.size() * 2, 1024);
+	if (_events.size() < max_events) {
+		_events.resize(max_events);
+	}
+
+	struct timespec ts;
+	ts.tv_sec = p_timeout / 1000;
+	ts.tv_nsec = (p_timeout % 1000) * 1000000;
+
+	int ret = kevent(_kqueue, NULL, 0, _events.ptrw(), max_events, p_timeout < 0 ? NULL : &ts);
+	if (ret < 0) {
+		if (errno == EINTR) {
+			return ERR_BUSY;
+		}
+		print_verbose("Error when waiting on kqueue, errno: " + itos(errno));
+		return FAILED;
+	}
+
+	for (int i = 0; i < ret; i++) {
+
+		const struct kevent &ev = _events[i];
+		const int *pos = _fd_positions.getptr((uint64_t)ev.ident);
+		if (!pos) {
+			continue;
+		}
+
+		Event e;
+		e.id = _entries[*pos].id;
+		e.readable = ev.filter == EVFILT_READ;
+		e.writable = ev.filter == EVFILT_WRITE;
+		e.hangup = ev.flags & (EV_EOF | EV_ERROR);
+		r_events.push_back(e);
+	}
+#else
+#if defined(WINDOWS_ENABLED)
+	int ret = WSAPoll(_pollfds.ptrw(), _pollfds.size(), p_timeout);
+	if (ret == SOCKET_ERROR) {
+		print_verbose("Error when polling sockets.");
+		return FAILED;
+	}
+#else
+	int ret = ::poll(_pollfds.ptrw(), _pollfds.size(), p_timeout);
+	if (ret < 0) {
+		if (errno == EINTR) {
+			return ERR_BUSY;
+		}
+		print_verbose("Error when polling sockets, errno: " + itos(errno));
+		return FAILED;
+	}
+#endif
+
+	for (int i = 0; i < _pollfds.size() && r_events.size() < ret; i++) {
+
+		short revents = _pollfds[i].revents;
+		if (!revents) {
+			continue;
+		}
+		_pollfds.write[i].revents = 0;
+
+		Event e;
+		e.id = _entries[i].id;
+		e.readable = revents & POLLIN;
+		e.writable = revents & POLLOUT;
+		e.hangup = revents & (POLLHUP | POLLERR | POLLNVAL);
+		r_events.push_back(e);
+	}
+#endif
+
+	return r_events.empty() ? ERR_BUSY : OK;
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() {
+
+#if defined(NET_SOCKET_POLLER_EPOLL)
+	_epoll = epoll_create1(EPOLL_CLOEXEC);
+	if (_epoll == -1) {
+		ERR_PRINT("Unable to create epoll instance, errno: " + itos(errno));
+	}
+#elif defined(NET_SOCKET_POLLER_KQUEUE)
+	_kqueue = kqueue();
+	if (_kqueue == -1) {
+		ERR_PRINT("Unable to create kqueue, errno: " + itos(errno));
+	}
+#endif
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+
+#if defined(NET_SOCKET_POLLER_EPOLL)
+	if (_epoll != -1) {
+		::close(_epoll);
+	}
+#elif defined(NET_SOCKET_POLLER_KQUEUE)
+	if (_kqueue != -1) {
+		::close(_kqueue);
+	}
+#endif
+}
 #endif
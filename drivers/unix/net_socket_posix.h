@@ -31,6 +31,7 @@
 #ifndef NET_SOCKET_UNIX_H
 #define NET_SOCKET_UNIX_H
 
+#include "core/hash_map.h"
 #include "core/io/net_socket.h"
 
 #if defined(WINDOWS_ENABLED)
@@ -44,8 +45,21 @@
 
 #endif
 
+// Kernel event queues when the platform has one, a single poll() over every socket otherwise
+#if defined(__linux__)
+#define NET_SOCKET_POLLER_EPOLL
+#include <sys/epoll.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#define NET_SOCKET_POLLER_KQUEUE
+#include <sys/event.h>
+#elif !defined(WINDOWS_ENABLED)
+#include <poll.h>
+#endif
+
 class NetSocketPosix : public NetSocket {
 
+	friend class NetSocketPollerPosix;
+
 private:
 	SOCKET_TYPE _sock;
 	IP::Type _ip_type;
@@ -85,6 +99,8 @@ public:
 	virtual Error send(const uint8_t *p_buffer, int p_len, int &r_sent);
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port);
 	virtual Ref<NetSocket> accept(IP_Address &r_ip, uint16_t &r_port);
+	virtual Error recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received);
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent);
 
 	virtual bool is_open() const;
 	virtual int get_available_bytes() const;
@@ -102,4 +118,49 @@ public:
 	~NetSocketPosix();
 };
 
+class NetSocketPollerPosix : public NetSocketPoller {
+
+private:
+	struct Entry {
+		const NetSocket *socket;
+		SOCKET_TYPE sock;
+		uint64_t id;
+		NetSocket::PollType type;
+	};
+
+	Vector<Entry> _entries;
+	HashMap<uint64_t, int> _positions; // By NetSocket, sockets may be closed already when removed.
+
+#if defined(NET_SOCKET_POLLER_EPOLL)
+	int _epoll;
+	Vector<struct epoll_event> _events;
+#elif defined(NET_SOCKET_POLLER_KQUEUE)
+	int _kqueue;
+	Vector<struct kevent> _events;
+	HashMap<uint64_t, int> _fd_positions;
+#elif defined(WINDOWS_ENABLED)
+	Vector<WSAPOLLFD> _pollfds;
+#else
+	Vector<struct pollfd> _pollfds;
+#endif
+
+	Error _register(const Entry &p_entry, bool p_modify);
+	void _unregister(const Entry &p_entry);
+
+protected:
+	static NetSocketPoller *_create_func();
+
+public:
+	static void make_default();
+
+	virtual Error add_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, uint64_t p_id);
+	virtual Error modify_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, uint64_t p_id);
+	virtual void remove_socket(const Ref<NetSocket> &p_socket);
+	virtual int get_socket_count() const;
+	virtual Error wait(int p_timeout, Vector<Event> &r_events);
+
+	NetSocketPollerPosix();
+	~NetSocketPollerPosix();
+};
+
 #endif
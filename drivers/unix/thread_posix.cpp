@@ -40,6 +40,15 @@
 #include "core/os/memory.h"
 #include "core/safe_refcount.h"
 
+#include <sched.h>
+#include <stdio.h>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 static void _thread_id_key_destr_callback(void *p_value) {
 	memdelete(static_cast<Thread::ID *>(p_value));
 }
@@ -69,6 +78,8 @@ void *ThreadPosix::thread_callback(void *userdata) {
 	t->id = atomic_increment(&next_thread_id);
 	pthread_setspecific(thread_id_key, (void *)memnew(ID(t->id)));
 
+	apply_settings(t->settings);
+
 	ScriptServer::thread_enter(); //scripts may need to attach a stack
 
 	t->callback(t->user);
@@ -78,14 +89,78 @@ void *ThreadPosix::thread_callback(void *userdata) {
 	return NULL;
 }
 
-Thread *ThreadPosix::create_func_posix(ThreadCreateCallback p_callback, void *p_user, const Settings &) {
+void ThreadPosix::apply_settings(const Settings &p_settings) {
+
+	//all of this is best effort, raising priorities usually needs privileges the process may not have
+	if (p_settings.name != String()) {
+		set_name_func_posix(p_settings.name);
+	}
+
+#ifdef __linux__
+	if (p_settings.affinity_mask) {
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		for (int i = 0; i < 64 && i < CPU_SETSIZE; i++) {
+			if (p_settings.affinity_mask & (uint64_t(1) << i)) {
+				CPU_SET(i, &cpu_set);
+			}
+		}
+		sched_setaffinity(0, sizeof(cpu_set), &cpu_set); //0 is the calling thread
+	}
+#endif
+
+	if (p_settings.priority == PRIORITY_NORMAL) {
+		return;
+	}
+
+	if (p_settings.priority == PRIORITY_REALTIME) {
+		sched_param param;
+		int min_priority = sched_get_priority_min(SCHED_RR);
+		int max_priority = sched_get_priority_max(SCHED_RR);
+		param.sched_priority = min_priority + (max_priority - min_priority) / 2;
+		if (pthread_setschedparam(pthread_self(), SCHED_RR, &param) == 0) {
+			return;
+		}
+		//not allowed, use the highest regular priority instead
+	}
+
+#ifdef __linux__
+	//linux ignores the priority of SCHED_OTHER threads, but niceness is per thread
+	int niceness = 0;
+	switch (p_settings.priority) {
+		case PRIORITY_LOW: {
+			niceness = 10;
+		} break;
+		case PRIORITY_HIGH: {
+			niceness = -10;
+		} break;
+		case PRIORITY_REALTIME: {
+			niceness = -16;
+		} break;
+		default: {
+		}
+	}
+	setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), niceness);
+#else
+	int policy;
+	sched_param param;
+	if (pthread_getschedparam(pthread_self(), &policy, &param) != 0) {
+		return;
+	}
+	param.sched_priority = p_settings.priority == PRIORITY_LOW ? sched_get_priority_min(policy) : sched_get_priority_max(policy);
+	pthread_setschedparam(pthread_self(), policy, &param);
+#endif
+}
+
+Thread *ThreadPosix::create_func_posix(ThreadCreateCallback p_callback, void *p_user, const Settings &p_settings) {
 
 	ThreadPosix *tr = memnew(ThreadPosix);
 	tr->callback = p_callback;
 	tr->user = p_user;
+	tr->settings = p_settings;
 	pthread_attr_init(&tr->pthread_attr);
 	pthread_attr_setdetachstate(&tr->pthread_attr, PTHREAD_CREATE_JOINABLE);
-	pthread_attr_setstacksize(&tr->pthread_attr, 256 * 1024);
+	pthread_attr_setstacksize(&tr->pthread_attr, p_settings.stack_size ? p_settings.stack_size : 256 * 1024);
 
 	pthread_create(&tr->pthread, &tr->pthread_attr, thread_callback, tr);
 
@@ -131,7 +206,14 @@ Error ThreadPosix::set_name_func_posix(const String &p_name) {
 	pthread_set_name_np(running_thread, p_name.utf8().get_data());
 	int err = 0; // Open/FreeBSD ignore errors in this function
 #else
-	int err = pthread_setname_np(running_thread, p_name.utf8().get_data());
+	CharString name = p_name.utf8();
+#ifdef __linux__
+	if (name.length() > 15) {
+		name.resize(16); //linux rejects names longer than 15 bytes
+		name[15] = 0;
+	}
+#endif
+	int err = pthread_setname_np(running_thread, name.get_data());
 #endif // PTHREAD_BSD_SET_NAME
 
 #endif // PTHREAD_RENAME_SELF
@@ -141,12 +223,60 @@ Error ThreadPosix::set_name_func_posix(const String &p_name) {
 #endif // PTHREAD_NO_RENAME
 };
 
+static uint64_t _compute_performance_core_mask() {
+
+#ifdef __linux__
+	//cores of the fast cluster are the ones reporting the highest maximum frequency
+	long core_freq[64];
+	long max_freq = 0;
+	long min_freq = 0;
+	int core_count = 0;
+	for (; core_count < 64; core_count++) {
+		char path[128];
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", core_count);
+		FILE *f = fopen(path, "r");
+		if (!f) {
+			break;
+		}
+		long freq = 0;
+		if (fscanf(f, "%ld", &freq) != 1) {
+			freq = 0;
+		}
+		fclose(f);
+		core_freq[core_count] = freq;
+		max_freq = MAX(max_freq, freq);
+		min_freq = core_count == 0 ? freq : MIN(min_freq, freq);
+	}
+
+	if (core_count == 0 || max_freq == min_freq) {
+		return 0; //unknown, or all cores are alike
+	}
+
+	uint64_t mask = 0;
+	for (int i = 0; i < core_count; i++) {
+		if (core_freq[i] == max_freq) {
+			mask |= uint64_t(1) << i;
+		}
+	}
+	return mask;
+#else
+	return 0;
+#endif
+}
+
+uint64_t ThreadPosix::get_performance_core_mask_func_posix() {
+
+	static uint64_t mask = _compute_performance_core_mask();
+	return mask;
+}
+
 void ThreadPosix::make_default() {
 
 	create_func = create_func_posix;
 	get_thread_id_func = get_thread_id_func_posix;
 	wait_to_finish_func = wait_to_finish_func_posix;
 	set_name_func = set_name_func_posix;
+	get_performance_core_mask_func = get_performance_core_mask_func_posix;
 }
 
 ThreadPosix::ThreadPosix() {
@@ -47,6 +47,7 @@ class ThreadPosix : public Thread {
 	ThreadCreateCallback callback;
 	void *user;
 	ID id;
+	Settings settings;
 
 	static Thread *create_thread_posix();
 
@@ -57,6 +58,9 @@ class ThreadPosix : public Thread {
 	static void wait_to_finish_func_posix(Thread *p_thread);
 
 	static Error set_name_func_posix(const String &p_name);
+	static uint64_t get_performance_core_mask_func_posix();
+
+	static void apply_settings(const Settings &p_settings);
 
 	ThreadPosix();
 
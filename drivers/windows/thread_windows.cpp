@@ -48,6 +48,8 @@ DWORD ThreadWindows::thread_callback(LPVOID userdata) {
 
 	ThreadWindows *t = reinterpret_cast<ThreadWindows *>(userdata);
 
+	apply_settings(t->settings);
+
 	ScriptServer::thread_enter(); //scripts may need to attach a stack
 
 	t->id = (ID)GetCurrentThreadId(); // must implement
@@ -59,14 +61,41 @@ DWORD ThreadWindows::thread_callback(LPVOID userdata) {
 	return 0;
 }
 
-Thread *ThreadWindows::create_func_windows(ThreadCreateCallback p_callback, void *p_user, const Settings &) {
+void ThreadWindows::apply_settings(const Settings &p_settings) {
+
+	if (p_settings.name != String()) {
+		set_name_func_windows(p_settings.name);
+	}
+
+	if (p_settings.affinity_mask) {
+		SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)p_settings.affinity_mask);
+	}
+
+	switch (p_settings.priority) {
+		case PRIORITY_LOW: {
+			SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+		} break;
+		case PRIORITY_HIGH: {
+			SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
+		} break;
+		case PRIORITY_REALTIME: {
+			SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+		} break;
+		default: {
+		}
+	}
+}
+
+Thread *ThreadWindows::create_func_windows(ThreadCreateCallback p_callback, void *p_user, const Settings &p_settings) {
 
 	ThreadWindows *tr = memnew(ThreadWindows);
 	tr->callback = p_callback;
 	tr->user = p_user;
+	tr->settings = p_settings;
 	tr->handle = CreateEvent(NULL, TRUE, FALSE, NULL);
 
-	QueueUserWorkItem(thread_callback, tr, WT_EXECUTELONGFUNCTION);
+	//a dedicated thread rather than a pool work item, so priority and affinity changes don't leak into other work
+	tr->thread_handle = CreateThread(NULL, p_settings.stack_size, thread_callback, tr, 0, NULL);
 
 	return tr;
 }
@@ -80,18 +109,37 @@ void ThreadWindows::wait_to_finish_func_windows(Thread *p_thread) {
 	ERR_FAIL_COND(!tp);
 	WaitForSingleObject(tp->handle, INFINITE);
 	CloseHandle(tp->handle);
+	if (tp->thread_handle) {
+		WaitForSingleObject(tp->thread_handle, INFINITE);
+		CloseHandle(tp->thread_handle);
+		tp->thread_handle = NULL;
+	}
 	//`memdelete(tp);
 }
 
+Error ThreadWindows::set_name_func_windows(const String &p_name) {
+
+	//SetThreadDescription is only available since Windows 10 1607
+	typedef HRESULT(WINAPI * SetThreadDescriptionPtr)(HANDLE, PCWSTR);
+	static SetThreadDescriptionPtr set_thread_description = (SetThreadDescriptionPtr)GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription");
+	if (!set_thread_description) {
+		return ERR_UNAVAILABLE;
+	}
+
+	return SUCCEEDED(set_thread_description(GetCurrentThread(), (LPCWSTR)p_name.c_str())) ? OK : ERR_INVALID_PARAMETER;
+}
+
 void ThreadWindows::make_default() {
 
 	create_func = create_func_windows;
 	get_thread_id_func = get_thread_id_func_windows;
 	wait_to_finish_func = wait_to_finish_func_windows;
+	set_name_func = set_name_func_windows;
 }
 
 ThreadWindows::ThreadWindows() :
-		handle(NULL) {
+		handle(NULL),
+		thread_handle(NULL) {
 }
 
 ThreadWindows::~ThreadWindows() {
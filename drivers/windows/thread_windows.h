@@ -44,6 +44,8 @@ class ThreadWindows : public Thread {
 	void *user;
 	ID id;
 	HANDLE handle;
+	HANDLE thread_handle;
+	Settings settings;
 
 	static Thread *create_thread_windows();
 
@@ -52,6 +54,9 @@ class ThreadWindows : public Thread {
 	static Thread *create_func_windows(ThreadCreateCallback p_callback, void *, const Settings &);
 	static ID get_thread_id_func_windows();
 	static void wait_to_finish_func_windows(Thread *p_thread);
+	static Error set_name_func_windows(const String &p_name);
+
+	static void apply_settings(const Settings &p_settings);
 
 	ThreadWindows();
 
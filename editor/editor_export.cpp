@@ -31,13 +31,16 @@
 #include "editor_export.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/compressed_translation.h"
 #include "core/io/config_file.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/io/zip_io.h"
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
 #include "core/version.h"
@@ -45,6 +48,7 @@
 #include "editor/plugins/script_editor_plugin.h"
 #include "editor_node.h"
 #include "editor_settings.h"
+#include "scene/resources/material.h"
 #include "scene/resources/resource_format_text.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -59,6 +63,8 @@ static int _get_pad(int p_alignment, int p_n) {
 }
 
 #define PCK_PADDING 16
+#define PACK_BATCH_FILES 256
+#define PACK_BATCH_BYTES (64 * 1024 * 1024)
 
 bool EditorExportPreset::_set(const StringName &p_name, const Variant &p_value) {
 
@@ -315,31 +321,189 @@ void EditorExportPlatform::gen_debug_flags(Vector<String> &r_flags, int p_flags)
 	}
 }
 
-Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total) {
+void EditorExportPlatform::PackData::process_file(uint32_t p_index, void *p_userdata) {
 
-	PackData *pd = (PackData *)p_userdata;
+	PendingFile &pf = pending.write[p_index];
+
+	pf.md5.resize(16);
+	CryptoCore::md5(pf.data.ptr(), pf.data.size(), pf.md5.ptrw());
+
+	const Map<String, Vector<uint8_t> >::Element *base = patch_base.find(pf.path);
+	if (base && base->get().size() == 16 && memcmp(base->get().ptr(), pf.md5.ptr(), 16) == 0) {
+		pf.skip = true; //already in the packs being patched
+		return;
+	}
+
+	if (!compress || pf.data.size() == 0) {
+		return;
+	}
+
+	String cache_path;
+	if (cache_dir != String()) {
+		cache_path = cache_dir.plus_file(String::md5(pf.md5.ptr()));
+		if (FileAccess::exists(cache_path)) {
+			//an empty entry means compressing was not worth it
+			pf.compressed = FileAccess::get_file_as_array(cache_path);
+			return;
+		}
+	}
+
+	pf.compressed = FileAccessCompressed::compress_buffer(PACK_COMPRESSED_MAGIC, pf.data.ptr(), pf.data.size());
+	//not worth decompressing for less than 1/16 saved, already compressed formats end up here
+	if (pf.compressed.size() >= pf.data.size() - pf.data.size() / 16) {
+		pf.compressed.clear();
+	}
+
+	if (cache_path != String()) {
+		//identical files may be processed at the same time, so write to a unique name first
+		String tmp_path = cache_path + "." + itos(p_index) + ".tmp";
+		FileAccess *f = FileAccess::open(tmp_path, FileAccess::WRITE);
+		if (f) {
+			f->store_buffer(pf.compressed.ptr(), pf.compressed.size());
+			memdelete(f);
+			DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+			if (da->rename(tmp_path, cache_path) != OK) {
+				da->remove(tmp_path);
+			}
+			memdelete(da);
+		}
+	}
+}
+
+void EditorExportPlatform::_flush_pack_files(PackData *p_pd) {
+
+	int count = p_pd->pending.size();
+
+	if (count > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		WorkerThreadPool::get_singleton()->parallel_for(count, p_pd, &PackData::process_file, (void *)NULL);
+	} else {
+		for (int i = 0; i < count; i++) {
+			p_pd->process_file(i, NULL);
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+
+		const PendingFile &pf = p_pd->pending[i];
+
+		if (p_pd->cache_dir != String() && pf.md5.size() == 16) {
+			p_pd->cache_used.insert(String::md5(pf.md5.ptr()));
+		}
+
+		if (pf.skip) {
+			continue;
+		}
+
+		SavedData sd;
+		sd.path_utf8 = pf.path.utf8();
+		sd.ofs = p_pd->f->get_position();
+		sd.size = pf.data.size();
+		sd.flags = 0;
+		sd.md5 = pf.md5;
+
+		if (pf.compressed.size()) {
+			sd.size = pf.compressed.size();
+			sd.flags |= PACK_FILE_COMPRESSED;
+			p_pd->f->store_buffer(pf.compressed.ptr(), pf.compressed.size());
+		} else {
+			p_pd->f->store_buffer(pf.data.ptr(), pf.data.size());
+		}
+
+		int pad = _get_pad(PCK_PADDING, sd.size);
+		for (int j = 0; j < pad; j++) {
+			p_pd->f->store_8(0);
+		}
+
+		p_pd->file_ofs.push_back(sd);
+	}
+
+	p_pd->pending.clear();
+	p_pd->pending_size = 0;
+}
+
+Error EditorExportPlatform::_load_pack_md5s(const String &p_path, Map<String, Vector<uint8_t> > &r_md5s) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(!f, ERR_FILE_CANT_OPEN, "Cannot open pack to patch: '" + p_path + "'.");
+
+	uint32_t magic = f->get_32();
+	if (magic != PACK_HEADER_MAGIC) {
+		//embedded in an executable, the directory size is stored right before the trailing magic
+		f->seek_end();
+		f->seek(f->get_position() - 4);
+		magic = f->get_32();
+		if (magic == PACK_HEADER_MAGIC) {
+			f->seek(f->get_position() - 12);
+			uint64_t ds = f->get_64();
+			f->seek(f->get_position() - ds - 8);
+			magic = f->get_32();
+		}
+	}
+
+	if (magic != PACK_HEADER_MAGIC) {
+		memdelete(f);
+		ERR_FAIL_V_MSG(ERR_FILE_UNRECOGNIZED, "Not a pack file: '" + p_path + "'.");
+	}
 
-	SavedData sd;
-	sd.path_utf8 = p_path.utf8();
-	sd.ofs = pd->f->get_position();
-	sd.size = p_data.size();
+	uint32_t version = f->get_32();
+	if (version < 1 || version > PACK_FORMAT_VERSION) {
+		memdelete(f);
+		ERR_FAIL_V_MSG(ERR_FILE_UNRECOGNIZED, "Pack version unsupported: " + itos(version) + ".");
+	}
 
-	pd->f->store_buffer(p_data.ptr(), p_data.size());
-	int pad = _get_pad(PCK_PADDING, sd.size);
-	for (int i = 0; i < pad; i++) {
-		pd->f->store_8(0);
+	for (int i = 0; i < 3; i++) {
+		f->get_32(); //engine version
 	}
+	for (int i = 0; i < 16; i++) {
+		f->get_32(); //index offset, capacity and reserved
+	}
+
+	uint32_t file_count = f->get_32();
+
+	for (uint32_t i = 0; i < file_count; i++) {
 
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(p_data.ptr(), p_data.size(), hash);
-		sd.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			sd.md5.write[i] = hash[i];
+		uint32_t sl = f->get_32();
+		CharString cs;
+		cs.resize(sl + 1);
+		f->get_buffer((uint8_t *)cs.ptr(), sl);
+		cs[sl] = 0;
+
+		String path;
+		path.parse_utf8(cs.ptr());
+
+		f->get_64(); //offset
+		f->get_64(); //size
+		Vector<uint8_t> md5;
+		md5.resize(16);
+		f->get_buffer(md5.ptrw(), 16);
+		if (version >= 3) {
+			f->get_32(); //flags
 		}
+
+		r_md5s[path] = md5;
 	}
 
-	pd->file_ofs.push_back(sd);
+	bool truncated = f->eof_reached();
+	memdelete(f);
+	ERR_FAIL_COND_V_MSG(truncated, ERR_FILE_CORRUPT, "Pack to patch is truncated: '" + p_path + "'.");
+
+	return OK;
+}
+
+Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total) {
+
+	PackData *pd = (PackData *)p_userdata;
+
+	PendingFile pf;
+	pf.path = p_path;
+	pf.data = p_data;
+	pf.skip = false;
+	pd->pending.push_back(pf);
+	pd->pending_size += p_data.size();
+
+	if (pd->pending.size() >= PACK_BATCH_FILES || pd->pending_size >= PACK_BATCH_BYTES) {
+		_flush_pack_files(pd);
+	}
 
 	if (pd->ep->step(TTR("Storing File:") + " " + p_path, 2 + p_file * 100 / p_total, false)) {
 		return ERR_SKIP;
@@ -609,6 +773,9 @@ void EditorExportPlugin::_export_file(const String &p_path, const String &p_type
 void EditorExportPlugin::_export_begin(const Set<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
 }
 
+void EditorExportPlugin::_export_files_end(const Set<String> &p_paths, const Set<String> &p_features) {
+}
+
 void EditorExportPlugin::skip() {
 
 	skipped = true;
@@ -844,6 +1011,23 @@ Error EditorExportPlatform::export_project_files(const Ref<EditorExportPreset> &
 		idx++;
 	}
 
+	//let plugins add files that depend on the whole set of exported files
+	for (int i = 0; i < export_plugins.size(); i++) {
+
+		export_plugins.write[i]->_export_files_end(paths, features);
+
+		if (p_so_func) {
+			for (int j = 0; j < export_plugins[i]->shared_objects.size(); j++) {
+				p_so_func(p_udata, export_plugins[i]->shared_objects[j]);
+			}
+		}
+		for (int j = 0; j < export_plugins[i]->extra_files.size(); j++) {
+			p_func(p_udata, export_plugins[i]->extra_files[j].path, export_plugins[i]->extra_files[j].data, idx, total);
+		}
+
+		export_plugins.write[i]->_clear();
+	}
+
 	//save config!
 
 	Vector<String> custom_list;
@@ -914,7 +1098,7 @@ Error EditorExportPlatform::_add_shared_object(void *p_userdata, const SharedObj
 	return OK;
 }
 
-Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, const String &p_path, Vector<SharedObject> *p_so_files, bool p_embed, int64_t *r_embedded_start, int64_t *r_embedded_size) {
+Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, const String &p_path, Vector<SharedObject> *p_so_files, bool p_embed, int64_t *r_embedded_start, int64_t *r_embedded_size, bool p_patch) {
 
 	EditorProgress ep("savepack", TTR("Packing"), 102, true);
 
@@ -926,9 +1110,45 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compress = GLOBAL_GET("editor/compress_pck_files_on_export");
+	pd.pending_size = 0;
+
+	if (pd.compress && EditorSettings::get_singleton()->get("filesystem/export/use_pck_compression_cache")) {
+		pd.cache_dir = EditorSettings::get_singleton()->get_cache_dir().plus_file("pck_cache").plus_file(p_preset->get_name().md5_text());
+		DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		if (da->make_dir_recursive(pd.cache_dir) != OK) {
+			WARN_PRINT("Cannot create the export cache directory '" + pd.cache_dir + "', packing without it.");
+			pd.cache_dir = String();
+		}
+		memdelete(da);
+	}
+
+	if (p_patch) {
+		//only files that differ from the enabled patch list (the base pack and any later patches) are stored
+		Vector<String> patches = p_preset->get_patches();
+		for (int i = 0; i < patches.size(); i++) {
+			if (!patches[i].ends_with("*")) {
+				continue;
+			}
+			String patch = patches[i].substr(0, patches[i].length() - 1);
+			if (patch.is_rel_path()) {
+				patch = ProjectSettings::get_singleton()->get_resource_path().plus_file(patch).simplify_path();
+			}
+			Error err = _load_pack_md5s(patch, pd.patch_base);
+			if (err != OK) {
+				memdelete(ftmp);
+				DirAccess::remove_file_or_error(tmppath);
+				return err;
+			}
+		}
+	}
 
 	Error err = export_project_files(p_preset, _save_pack_file, &pd, _add_shared_object);
 
+	if (err == OK) {
+		_flush_pack_files(&pd);
+	}
+
 	memdelete(ftmp); //close tmp file
 
 	if (err != OK) {
@@ -936,6 +1156,23 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 		return err;
 	}
 
+	if (pd.cache_dir != String()) {
+		//drop entries for contents that are no longer exported
+		DirAccess *da = DirAccess::open(pd.cache_dir);
+		if (da) {
+			da->list_dir_begin();
+			String f = da->get_next();
+			while (f != String()) {
+				if (!da->current_is_dir() && !pd.cache_used.has(f)) {
+					da->remove(f);
+				}
+				f = da->get_next();
+			}
+			da->list_dir_end();
+			memdelete(da);
+		}
+	}
+
 	pd.file_ofs.sort(); //do sort, so we can do binary search later
 
 	FileAccess *f;
@@ -971,20 +1208,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 
 	int64_t pck_start_pos = f->get_position();
 
-	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
-	f->store_32(VERSION_MAJOR);
-	f->store_32(VERSION_MINOR);
-	f->store_32(VERSION_PATCH);
-
-	for (int i = 0; i < 16; i++) {
-		//reserved
-		f->store_32(0);
-	}
-
-	f->store_32(pd.file_ofs.size()); //amount of files
-
-	int64_t header_size = f->get_position();
+	int64_t header_size = pck_start_pos + PACK_HEADER_SIZE;
 
 	//precalculate header size
 
@@ -995,10 +1219,35 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 		header_size += 8; // offset to file _with_ header size included
 		header_size += 8; // size of file
 		header_size += 16; // md5
+		header_size += 4; // flags
 	}
 
+	//the hash index follows the directory
+	uint32_t index_capacity = PackedData::get_index_capacity(pd.file_ofs.size());
+	int64_t index_ofs = header_size - pck_start_pos;
+	header_size += int64_t(index_capacity) * PACK_INDEX_SLOT_SIZE;
+
 	int header_padding = _get_pad(PCK_PADDING, header_size);
 
+	f->store_32(PACK_HEADER_MAGIC);
+	f->store_32(PACK_FORMAT_VERSION);
+	f->store_32(VERSION_MAJOR);
+	f->store_32(VERSION_MINOR);
+	f->store_32(VERSION_PATCH);
+
+	f->store_64(index_ofs);
+	f->store_32(index_capacity);
+	for (int i = 3; i < 16; i++) {
+		//reserved
+		f->store_32(0);
+	}
+
+	f->store_32(pd.file_ofs.size()); //amount of files
+
+	Vector<uint8_t> index;
+	index.resize(index_capacity * PACK_INDEX_SLOT_SIZE);
+	zeromem(index.ptrw(), index.size());
+
 	for (int i = 0; i < pd.file_ofs.size(); i++) {
 
 		int string_len = pd.file_ofs[i].path_utf8.length();
@@ -1010,11 +1259,19 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 			f->store_8(0);
 		}
 
-		f->store_64(pd.file_ofs[i].ofs + header_padding + header_size);
+		uint64_t file_ofs = pd.file_ofs[i].ofs + header_padding + header_size;
+		f->store_64(file_ofs);
 		f->store_64(pd.file_ofs[i].size); // pay attention here, this is where file is
 		f->store_buffer(pd.file_ofs[i].md5.ptr(), 16); //also save md5 for file
+		f->store_32(pd.file_ofs[i].flags);
+
+		String path;
+		path.parse_utf8(pd.file_ofs[i].path_utf8.get_data());
+		PackedData::store_index_slot(index.ptrw(), index_capacity, path, file_ofs, pd.file_ofs[i].size, pd.file_ofs[i].md5.ptr(), pd.file_ofs[i].flags);
 	}
 
+	f->store_buffer(index.ptr(), index.size());
+
 	for (int i = 0; i < header_padding; i++) {
 		f->store_8(0);
 	}
@@ -1087,7 +1344,7 @@ Error EditorExportPlatform::save_zip(const Ref<EditorExportPreset> &p_preset, co
 
 Error EditorExportPlatform::export_pack(const Ref<EditorExportPreset> &p_preset, bool p_debug, const String &p_path, int p_flags) {
 	ExportNotifier notifier(*this, p_preset, p_debug, p_path, p_flags);
-	return save_pack(p_preset, p_path);
+	return save_pack(p_preset, p_path, NULL, false, NULL, NULL, true);
 }
 
 Error EditorExportPlatform::export_zip(const Ref<EditorExportPreset> &p_preset, bool p_debug, const String &p_path, int p_flags) {
@@ -1428,6 +1685,8 @@ EditorExport::EditorExport() {
 	save_timer->connect("timeout", this, "_save");
 	block_save = false;
 
+	GLOBAL_DEF("editor/compress_pck_files_on_export", false);
+
 	singleton = this;
 }
 
@@ -1731,3 +1990,139 @@ EditorExportTextSceneToBinaryPlugin::EditorExportTextSceneToBinaryPlugin() {
 
 	GLOBAL_DEF("editor/convert_text_resources_to_binary_on_export", false);
 }
+
+///////////////////////
+
+void EditorExportSpatialMaterialVariantsPlugin::_find_variants(const Variant &p_value, Set<const Object *> &r_visited, Map<uint64_t, String> &r_variants) {
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+
+			const Object *obj = p_value;
+			if (!obj || r_visited.has(obj)) {
+				return;
+			}
+			r_visited.insert(obj);
+
+			const SpatialMaterial *material = Object::cast_to<SpatialMaterial>(obj);
+			if (material) {
+				uint64_t key = material->get_shader_variant();
+				if (!r_variants.has(key)) {
+					r_variants[key] = material->get_shader_variant_code();
+				}
+			}
+
+			List<PropertyInfo> properties;
+			obj->get_property_list(&properties);
+			for (List<PropertyInfo>::Element *E = properties.front(); E; E = E->next()) {
+
+				const PropertyInfo &pi = E->get();
+				if (!(pi.usage & PROPERTY_USAGE_STORAGE)) {
+					continue;
+				}
+				if (pi.type != Variant::OBJECT && pi.type != Variant::ARRAY && pi.type != Variant::DICTIONARY && pi.type != Variant::NIL) {
+					continue;
+				}
+				_find_variants(obj->get(pi.name), r_visited, r_variants);
+			}
+		} break;
+		case Variant::ARRAY: {
+
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				_find_variants(array[i], r_visited, r_variants);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+
+			Dictionary dict = p_value;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				_find_variants(E->get(), r_visited, r_variants);
+				_find_variants(dict[E->get()], r_visited, r_variants);
+			}
+		} break;
+		default: {
+		}
+	}
+}
+
+void EditorExportSpatialMaterialVariantsPlugin::_export_files_end(const Set<String> &p_paths, const Set<String> &p_features) {
+
+	bool enabled = GLOBAL_GET("editor/export_spatial_material_variants");
+	if (!enabled)
+		return;
+
+	Map<uint64_t, String> variants;
+
+	for (const Set<String>::Element *E = p_paths.front(); E; E = E->next()) {
+
+		String type = ResourceLoader::get_resource_type(E->get());
+		if (type != "PackedScene" && !ClassDB::is_parent_class(type, "Material") && !ClassDB::is_parent_class(type, "Mesh")) {
+			continue;
+		}
+
+		RES res = ResourceLoader::load(E->get());
+		if (res.is_null()) {
+			continue;
+		}
+
+		Set<const Object *> visited;
+		_find_variants(res, visited, variants);
+	}
+
+	if (variants.empty())
+		return;
+
+	add_file(SpatialMaterial::get_shader_variants_path(), SpatialMaterial::encode_shader_variants(variants), false);
+}
+
+EditorExportSpatialMaterialVariantsPlugin::EditorExportSpatialMaterialVariantsPlugin() {
+
+	GLOBAL_DEF("editor/export_spatial_material_variants", true);
+}
+
+///////////////////////
+
+void EditorExportTranslationPlugin::_export_file(const String &p_path, const String &p_type, const Set<String> &p_features) {
+
+	// Only plain translations (e.g. loaded from PO files), compressed ones are exported as they are.
+	if (p_type != "Translation") {
+		return;
+	}
+
+	bool convert = GLOBAL_GET("editor/compress_translations_on_export");
+	if (!convert)
+		return;
+
+	Ref<Translation> translation = ResourceLoader::load(p_path, "Translation");
+	ERR_FAIL_COND(translation.is_null());
+
+	List<StringName> messages;
+	translation->get_message_list(&messages);
+	if (messages.empty()) {
+		return; // Nothing to hash, keep the original file.
+	}
+
+	Ref<PHashTranslation> compressed;
+	compressed.instance();
+	compressed->generate(translation);
+
+	String tmp_path = EditorSettings::get_singleton()->get_cache_dir().plus_file("tmptranslation.res");
+	Error err = ResourceSaver::save(tmp_path, compressed);
+	if (err != OK) {
+		DirAccess::remove_file_or_error(tmp_path);
+		ERR_FAIL();
+	}
+	Vector<uint8_t> data = FileAccess::get_file_as_array(tmp_path);
+	DirAccess::remove_file_or_error(tmp_path);
+	ERR_FAIL_COND(data.size() == 0);
+
+	add_file(p_path + ".converted.res", data, true);
+}
+
+EditorExportTranslationPlugin::EditorExportTranslationPlugin() {
+
+	GLOBAL_DEF("editor/compress_translations_on_export", true);
+}
@@ -164,6 +164,7 @@ private:
 
 		uint64_t ofs;
 		uint64_t size;
+		uint32_t flags;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
 
@@ -172,12 +173,33 @@ private:
 		}
 	};
 
+	struct PendingFile {
+
+		String path;
+		Vector<uint8_t> data;
+		Vector<uint8_t> md5;
+		Vector<uint8_t> compressed; //empty when stored uncompressed
+		bool skip;
+	};
+
 	struct PackData {
 
 		FileAccess *f;
 		Vector<SavedData> file_ofs;
 		EditorProgress *ep;
 		Vector<SharedObject> *so_files;
+		bool compress;
+
+		//files are hashed and compressed in parallel in batches, then written in export order
+		Vector<PendingFile> pending;
+		uint64_t pending_size;
+
+		String cache_dir; //compressed files keyed by the md5 of their contents, reused between exports
+		Set<String> cache_used;
+
+		Map<String, Vector<uint8_t> > patch_base; //md5 of every file already shipped in the packs being patched
+
+		void process_file(uint32_t p_index, void *p_userdata);
 	};
 
 	struct ZipData {
@@ -196,6 +218,8 @@ private:
 
 	void gen_debug_flags(Vector<String> &r_flags, int p_flags);
 	static Error _save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total);
+	static void _flush_pack_files(PackData *p_pd);
+	static Error _load_pack_md5s(const String &p_path, Map<String, Vector<uint8_t> > &r_md5s);
 	static Error _save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total);
 
 	void _edit_files_with_filter(DirAccess *da, const Vector<String> &p_filters, Set<String> &r_list, bool exclude);
@@ -240,7 +264,7 @@ public:
 
 	Error export_project_files(const Ref<EditorExportPreset> &p_preset, EditorExportSaveFunction p_func, void *p_udata, EditorExportSaveSharedObject p_so_func = NULL);
 
-	Error save_pack(const Ref<EditorExportPreset> &p_preset, const String &p_path, Vector<SharedObject> *p_so_files = NULL, bool p_embed = false, int64_t *r_embedded_start = NULL, int64_t *r_embedded_size = NULL);
+	Error save_pack(const Ref<EditorExportPreset> &p_preset, const String &p_path, Vector<SharedObject> *p_so_files = NULL, bool p_embed = false, int64_t *r_embedded_start = NULL, int64_t *r_embedded_size = NULL, bool p_patch = false);
 	Error save_zip(const Ref<EditorExportPreset> &p_preset, const String &p_path);
 
 	virtual bool poll_export() { return false; }
@@ -331,6 +355,7 @@ protected:
 
 	virtual void _export_file(const String &p_path, const String &p_type, const Set<String> &p_features);
 	virtual void _export_begin(const Set<String> &p_features, bool p_debug, const String &p_path, int p_flags);
+	virtual void _export_files_end(const Set<String> &p_paths, const Set<String> &p_features);
 
 	static void _bind_methods();
 
@@ -460,4 +485,24 @@ public:
 	EditorExportTextSceneToBinaryPlugin();
 };
 
+class EditorExportSpatialMaterialVariantsPlugin : public EditorExportPlugin {
+
+	GDCLASS(EditorExportSpatialMaterialVariantsPlugin, EditorExportPlugin);
+
+	void _find_variants(const Variant &p_value, Set<const Object *> &r_visited, Map<uint64_t, String> &r_variants);
+
+public:
+	virtual void _export_files_end(const Set<String> &p_paths, const Set<String> &p_features);
+	EditorExportSpatialMaterialVariantsPlugin();
+};
+
+class EditorExportTranslationPlugin : public EditorExportPlugin {
+
+	GDCLASS(EditorExportTranslationPlugin, EditorExportPlugin);
+
+public:
+	virtual void _export_file(const String &p_path, const String &p_type, const Set<String> &p_features);
+	EditorExportTranslationPlugin();
+};
+
 #endif // EDITOR_IMPORT_EXPORT_H
@@ -0,0 +1,415 @@
+/*************************************************************************/
+/*  editor_file_index.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "editor_file_index.h"
+
+#include "core/os/file_access.h"
+#include "core/project_settings.h"
+#include "editor/editor_file_system.h"
+#include "editor/editor_settings.h"
+
+#define INDEX_FILE_NAME "find_in_files_index"
+#define INDEX_VERSION 1
+
+EditorFileIndex *EditorFileIndex::singleton = NULL;
+
+uint32_t EditorFileIndex::_get_trigram(CharType p_a, CharType p_b, CharType p_c) {
+	// Exact for the first 1024 code points, anything above may collide, which only causes false positives.
+	return ((uint32_t(p_a) & 0x3FF) << 20) | ((uint32_t(p_b) & 0x3FF) << 10) | (uint32_t(p_c) & 0x3FF);
+}
+
+void EditorFileIndex::_get_bit_positions(uint32_t p_trigram, uint32_t p_mask, uint32_t &r_a, uint32_t &r_b) {
+	uint32_t h = hash_one_uint64(p_trigram);
+	r_a = h & p_mask;
+	r_b = ((h >> 16) | (h << 16)) & p_mask;
+}
+
+void EditorFileIndex::_build_filter(const String &p_text, Vector<uint32_t> &r_bits) {
+
+	int len = p_text.length();
+	if (len < 3) {
+		// Nothing long enough to search for can match.
+		r_bits.resize(1);
+		r_bits.write[0] = 0;
+		return;
+	}
+
+	const CharType *c = p_text.c_str();
+	Vector<uint32_t> trigrams;
+	trigrams.resize(len - 2);
+	uint32_t *t = trigrams.ptrw();
+	for (int i = 0; i < len - 2; i++) {
+		t[i] = _get_trigram(c[i], c[i + 1], c[i + 2]);
+	}
+	trigrams.sort();
+
+	int count = 0;
+	for (int i = 0; i < trigrams.size(); i++) {
+		if (i == 0 || t[i] != t[i - 1]) {
+			t[count++] = t[i];
+		}
+	}
+
+	// About 8 bits per trigram with two probes keeps false positives around 5% per trigram.
+	uint32_t words = next_power_of_2(MAX(count / 4, 2));
+	uint32_t mask = words * 32 - 1;
+	r_bits.resize(words);
+	uint32_t *b = r_bits.ptrw();
+	for (uint32_t i = 0; i < words; i++) {
+		b[i] = 0;
+	}
+
+	for (int i = 0; i < count; i++) {
+		uint32_t pa, pb;
+		_get_bit_positions(t[i], mask, pa, pb);
+		b[pa >> 5] |= 1 << (pa & 31);
+		b[pb >> 5] |= 1 << (pb & 31);
+	}
+}
+
+bool EditorFileIndex::_filter_has(const Vector<uint32_t> &p_bits, const Vector<uint32_t> &p_trigrams) {
+
+	if (p_bits.empty()) {
+		return true;
+	}
+
+	const uint32_t *b = p_bits.ptr();
+	uint32_t mask = p_bits.size() * 32 - 1;
+	for (int i = 0; i < p_trigrams.size(); i++) {
+		uint32_t pa, pb;
+		_get_bit_positions(p_trigrams[i], mask, pa, pb);
+		if (!(b[pa >> 5] & (1 << (pa & 31))) || !(b[pb >> 5] & (1 << (pb & 31)))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool EditorFileIndex::find_candidates(const String &p_pattern, const String &p_folder, const Set<String> &p_extensions, Vector<String> &r_files) const {
+
+	String pattern = p_pattern.to_lower();
+	Vector<uint32_t> trigrams;
+	for (int i = 0; i + 2 < pattern.length(); i++) {
+		trigrams.push_back(_get_trigram(pattern[i], pattern[i + 1], pattern[i + 2]));
+	}
+
+	String base = "res://" + p_folder;
+	if (!base.ends_with("/")) {
+		base += "/";
+	}
+
+	MutexLock lock(mutex);
+
+	if (!synced) {
+		return false;
+	}
+
+	for (Set<String>::Element *E = p_extensions.front(); E; E = E->next()) {
+		if (!extensions.has(E->get())) {
+			return false;
+		}
+	}
+
+	const String *k = NULL;
+	while ((k = files.next(k))) {
+		if (!p_extensions.has(k->get_extension()) || !k->begins_with(base)) {
+			continue;
+		}
+		// Stale entries can't rule a file out either.
+		if (pending.has(*k) || *k == indexing || _filter_has(files.get(*k).bits, trigrams)) {
+			r_files.push_back(*k);
+		}
+	}
+
+	// Files that were never indexed yet can't be ruled out.
+	for (const Map<String, uint64_t>::Element *E = pending.front(); E; E = E->next()) {
+		if (!files.has(E->key()) && p_extensions.has(E->key().get_extension()) && E->key().begins_with(base)) {
+			r_files.push_back(E->key());
+		}
+	}
+	if (indexing != String() && !files.has(indexing) && !pending.has(indexing) && p_extensions.has(indexing.get_extension()) && indexing.begins_with(base)) {
+		r_files.push_back(indexing);
+	}
+
+	r_files.sort();
+	return true;
+}
+
+void EditorFileIndex::_scan_dir(EditorFileSystemDirectory *p_dir, Set<String> &r_found) {
+
+	String base = p_dir->get_path();
+
+	for (int i = 0; i < p_dir->get_file_count(); i++) {
+		String file = p_dir->get_file(i);
+		if (!extensions.has(file.get_extension())) {
+			continue;
+		}
+
+		String path = base.plus_file(file);
+		r_found.insert(path);
+
+		uint64_t modified_time = p_dir->get_file_modified_time(i);
+		const FileEntry *entry = files.getptr(path);
+		if (entry && entry->modified_time == modified_time) {
+			continue;
+		}
+
+		Map<String, uint64_t>::Element *E = pending.find(path);
+		if (E) {
+			E->get() = modified_time;
+		} else {
+			pending.insert(path, modified_time);
+			sem->post();
+		}
+	}
+
+	for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+		_scan_dir(p_dir->get_subdir(i), r_found);
+	}
+}
+
+void EditorFileIndex::_filesystem_changed() {
+
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	if (!efs || !thread) {
+		return;
+	}
+
+	Set<String> exts;
+	Array ext_list = ProjectSettings::get_singleton()->get("editor/search_in_file_extensions");
+	for (int i = 0; i < ext_list.size(); i++) {
+		exts.insert(ext_list[i]);
+	}
+
+	MutexLock lock(mutex);
+
+	if (!loaded) {
+		// The thread calls this again once the saved index is loaded.
+		return;
+	}
+
+	extensions = exts;
+
+	Set<String> found;
+	_scan_dir(efs->get_filesystem(), found);
+
+	List<String> removed;
+	const String *k = NULL;
+	while ((k = files.next(k))) {
+		if (!found.has(*k)) {
+			removed.push_back(*k);
+		}
+	}
+	for (List<String>::Element *E = removed.front(); E; E = E->next()) {
+		files.erase(E->get());
+		dirty = true;
+	}
+
+	removed.clear();
+	for (Map<String, uint64_t>::Element *E = pending.front(); E; E = E->next()) {
+		if (!found.has(E->key())) {
+			removed.push_back(E->key());
+		}
+	}
+	for (List<String>::Element *E = removed.front(); E; E = E->next()) {
+		pending.erase(E->get());
+	}
+
+	if (indexing != String() && !found.has(indexing)) {
+		indexing_removed = true;
+	}
+
+	synced = true;
+}
+
+void EditorFileIndex::_load(HashMap<String, FileEntry> &r_files) const {
+
+	FileAccessRef f = FileAccess::open(index_path, FileAccess::READ);
+	if (!f) {
+		return;
+	}
+
+	if (f->get_32() != INDEX_VERSION) {
+		return;
+	}
+
+	uint32_t count = f->get_32();
+	for (uint32_t i = 0; i < count && !f->eof_reached(); i++) {
+		String path = f->get_pascal_string();
+		FileEntry entry;
+		entry.modified_time = f->get_64();
+		uint32_t words = f->get_32();
+		ERR_FAIL_COND_MSG(words > (1 << 24), "Corrupt Find in Files index at '" + index_path + "'.");
+		entry.bits.resize(words);
+		if (words) {
+			f->get_buffer((uint8_t *)entry.bits.ptrw(), words * sizeof(uint32_t));
+		}
+		if (f->eof_reached()) {
+			break;
+		}
+		r_files[path] = entry;
+	}
+}
+
+void EditorFileIndex::_save() {
+
+	FileAccessRef f = FileAccess::open(index_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Cannot create file '" + index_path + "'. Check user write permissions.");
+
+	f->store_32(INDEX_VERSION);
+	f->store_32(files.size());
+
+	const String *k = NULL;
+	while ((k = files.next(k))) {
+		const FileEntry &entry = files.get(*k);
+		f->store_pascal_string(*k);
+		f->store_64(entry.modified_time);
+		f->store_32(entry.bits.size());
+		if (entry.bits.size()) {
+			f->store_buffer((const uint8_t *)entry.bits.ptr(), entry.bits.size() * sizeof(uint32_t));
+		}
+	}
+
+	dirty = false;
+}
+
+void EditorFileIndex::_thread_func(void *p_ud) {
+
+	EditorFileIndex *efi = (EditorFileIndex *)p_ud;
+	efi->_thread();
+}
+
+void EditorFileIndex::_thread() {
+
+	HashMap<String, FileEntry> saved_files;
+	_load(saved_files);
+
+	mutex->lock();
+	files = saved_files;
+	loaded = true;
+	mutex->unlock();
+
+	call_deferred("_filesystem_changed");
+
+	while (!exit) {
+
+		sem->wait();
+
+		mutex->lock();
+		if (exit || pending.empty()) {
+			mutex->unlock();
+			continue;
+		}
+
+		Map<String, uint64_t>::Element *E = pending.front();
+		String path = E->key();
+		uint64_t modified_time = E->get();
+		pending.erase(E);
+		indexing = path;
+		indexing_removed = false;
+		mutex->unlock();
+
+		FileEntry entry;
+		entry.modified_time = modified_time;
+
+		Error err;
+		Vector<uint8_t> data = FileAccess::get_file_as_array(path, &err);
+		if (err == OK) {
+			String text;
+			// Searches match line by line with carriage returns stripped, the index must see the same text.
+			if (data.empty() || !text.parse_utf8((const char *)data.ptr(), data.size())) {
+				_build_filter(text.replace("\r", "").to_lower(), entry.bits);
+			}
+		}
+
+		mutex->lock();
+		if (!indexing_removed) {
+			files[path] = entry;
+			dirty = true;
+		}
+		indexing = String();
+		mutex->unlock();
+	}
+}
+
+void EditorFileIndex::start() {
+
+	ERR_FAIL_COND_MSG(thread, "Thread already started.");
+
+	index_path = EditorSettings::get_singleton()->get_project_settings_dir().plus_file(INDEX_FILE_NAME);
+	EditorFileSystem::get_singleton()->connect("filesystem_changed", this, "_filesystem_changed");
+
+	exit = false;
+	thread = Thread::create(_thread_func, this);
+}
+
+void EditorFileIndex::stop() {
+
+	if (!thread) {
+		return;
+	}
+
+	exit = true;
+	sem->post();
+	Thread::wait_to_finish(thread);
+	memdelete(thread);
+	thread = NULL;
+
+	if (dirty) {
+		_save();
+	}
+}
+
+void EditorFileIndex::_bind_methods() {
+
+	ClassDB::bind_method("_filesystem_changed", &EditorFileIndex::_filesystem_changed);
+}
+
+EditorFileIndex::EditorFileIndex() {
+
+	singleton = this;
+	mutex = Mutex::create();
+	sem = Semaphore::create();
+	thread = NULL;
+	exit = false;
+	loaded = false;
+	synced = false;
+	dirty = false;
+	indexing_removed = false;
+}
+
+EditorFileIndex::~EditorFileIndex() {
+
+	stop();
+	memdelete(mutex);
+	memdelete(sem);
+	singleton = NULL;
+}
@@ -0,0 +1,105 @@
+/*************************************************************************/
+/*  editor_file_index.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef EDITOR_FILE_INDEX_H
+#define EDITOR_FILE_INDEX_H
+
+#include "core/hash_map.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "scene/main/node.h"
+
+class EditorFileSystemDirectory;
+
+// Keeps a trigram filter for every searchable text file in the project, so
+// Find in Files only has to open the files that can possibly match.
+class EditorFileIndex : public Node {
+
+	GDCLASS(EditorFileIndex, Node);
+
+	static EditorFileIndex *singleton;
+
+	struct FileEntry {
+		uint64_t modified_time;
+		// Bloom filter over the lowercase trigrams of the file. Empty when the
+		// file could not be indexed, in which case it always matches.
+		Vector<uint32_t> bits;
+	};
+
+	HashMap<String, FileEntry> files;
+	Map<String, uint64_t> pending; // Path to modified time, waiting to be indexed.
+	String indexing; // Path the thread is working on right now.
+	bool indexing_removed;
+	Set<String> extensions;
+
+	Mutex *mutex;
+	Semaphore *sem;
+	Thread *thread;
+	volatile bool exit;
+	bool loaded;
+	bool synced;
+	bool dirty;
+
+	String index_path;
+
+	void _load(HashMap<String, FileEntry> &r_files) const;
+	void _save();
+
+	void _scan_dir(EditorFileSystemDirectory *p_dir, Set<String> &r_found);
+	void _filesystem_changed();
+
+	static uint32_t _get_trigram(CharType p_a, CharType p_b, CharType p_c);
+	static void _get_bit_positions(uint32_t p_trigram, uint32_t p_mask, uint32_t &r_a, uint32_t &r_b);
+	static void _build_filter(const String &p_text, Vector<uint32_t> &r_bits);
+	static bool _filter_has(const Vector<uint32_t> &p_bits, const Vector<uint32_t> &p_trigrams);
+
+	static void _thread_func(void *p_ud);
+	void _thread();
+
+protected:
+	static void _bind_methods();
+
+public:
+	static EditorFileIndex *get_singleton() { return singleton; }
+
+	// Fills r_files with every file under p_folder (relative to res://) with one of
+	// p_extensions that may contain p_pattern, ignoring case and word boundaries.
+	// Returns false if the index can't answer yet, the caller should scan by itself.
+	bool find_candidates(const String &p_pattern, const String &p_folder, const Set<String> &p_extensions, Vector<String> &r_files) const;
+
+	void start();
+	void stop();
+
+	EditorFileIndex();
+	~EditorFileIndex();
+};
+
+#endif // EDITOR_FILE_INDEX_H
@@ -35,6 +35,7 @@
 #include "core/io/resource_saver.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/project_settings.h"
 #include "core/variant_parser.h"
 #include "editor_node.h"
@@ -43,7 +44,7 @@
 
 EditorFileSystem *EditorFileSystem::singleton = NULL;
 //the name is the version, to keep compatibility with different versions of Godot
-#define CACHE_FILE_NAME "filesystem_cache6"
+#define CACHE_FILE_NAME "filesystem_cache7"
 
 void EditorFileSystemDirectory::sort_files() {
 
@@ -145,6 +146,12 @@ StringName EditorFileSystemDirectory::get_file_type(int p_idx) const {
 	return files[p_idx]->type;
 }
 
+uint64_t EditorFileSystemDirectory::get_file_modified_time(int p_idx) const {
+
+	ERR_FAIL_INDEX_V(p_idx, files.size(), 0);
+	return files[p_idx]->modified_time;
+}
+
 String EditorFileSystemDirectory::get_name() {
 
 	return name;
@@ -232,6 +239,16 @@ void EditorFileSystem::_scan_filesystem() {
 			if (l == String())
 				continue;
 
+			if (l.begins_with("import_dir::")) {
+				if (first_scan) {
+					Vector<String> split = l.split("::");
+					ERR_CONTINUE(split.size() != 3);
+					import_dir_modified_time = split[1].to_int64();
+					import_dir_settings_hash = split[2];
+				}
+				continue;
+			}
+
 			if (l.begins_with("::")) {
 				Vector<String> split = l.split("::");
 				ERR_CONTINUE(split.size() != 3);
@@ -302,6 +319,8 @@ void EditorFileSystem::_scan_filesystem() {
 	new_filesystem = memnew(EditorFileSystemDirectory);
 	new_filesystem->parent = NULL;
 
+	imported_files_verified = _begin_imported_files_scan();
+
 	DirAccess *d = DirAccess::create(DirAccess::ACCESS_RESOURCES);
 	d->change_dir("res://");
 	_scan_new_dir(new_filesystem, d, sp);
@@ -328,6 +347,7 @@ void EditorFileSystem::_save_filesystem_cache() {
 	ERR_FAIL_COND_MSG(!f, "Cannot create file '" + fscache + "'. Check user write permissions.");
 
 	f->store_line(filesystem_settings_version_for_import);
+	f->store_line("import_dir::" + itos(import_dir_modified_time) + "::" + import_dir_settings_hash);
 	_save_filesystem_cache(filesystem, f);
 	f->close();
 	memdelete(f);
@@ -485,6 +505,27 @@ bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_impo
 	return false; //nothing changed
 }
 
+void EditorFileSystem::_test_for_reimport_thread(uint32_t p_index, ReimportTestData *p_data) {
+
+	p_data->results[p_index] = _test_for_reimport(p_data->paths[p_index], false);
+}
+
+bool EditorFileSystem::_are_imported_files_unchanged() const {
+
+	if (using_fat32_or_exfat || import_dir_modified_time == 0) {
+		return false; //directory times can't be trusted, or there is no snapshot yet
+	}
+
+	return FileAccess::get_modified_time("res://.import") == import_dir_modified_time && import_dir_settings_hash == ResourceFormatImporter::get_singleton()->get_import_settings_hash();
+}
+
+bool EditorFileSystem::_begin_imported_files_scan() {
+
+	//taken before checking, so anything removed while the scan runs is caught by the next one
+	scan_import_dir_modified_time = FileAccess::get_modified_time("res://.import");
+	return _are_imported_files_unchanged();
+}
+
 bool EditorFileSystem::_update_scan_actions() {
 
 	sources_changed.clear();
@@ -494,6 +535,24 @@ bool EditorFileSystem::_update_scan_actions() {
 	Vector<String> reimports;
 	Vector<String> reloads;
 
+	//hashing changed files is the slow part, so test them all on the worker threads before applying the actions
+	Vector<String> test_paths;
+	for (List<ItemAction>::Element *E = scan_actions.front(); E; E = E->next()) {
+		if (E->get().action == ItemAction::ACTION_FILE_TEST_REIMPORT) {
+			test_paths.push_back(E->get().dir->get_path().plus_file(E->get().file));
+		}
+	}
+
+	Vector<bool> test_results;
+	test_results.resize(test_paths.size());
+	if (test_paths.size()) {
+		ReimportTestData data;
+		data.paths = test_paths.ptr();
+		data.results = test_results.ptrw();
+		WorkerThreadPool::get_singleton()->parallel_for(test_paths.size(), this, &EditorFileSystem::_test_for_reimport_thread, &data);
+	}
+	int test_index = 0;
+
 	for (List<ItemAction>::Element *E = scan_actions.front(); E; E = E->next()) {
 
 		ItemAction &ia = E->get();
@@ -557,10 +616,11 @@ bool EditorFileSystem::_update_scan_actions() {
 			} break;
 			case ItemAction::ACTION_FILE_TEST_REIMPORT: {
 
+				bool must_reimport = test_results[test_index++];
 				int idx = ia.dir->find_file_index(ia.file);
 				ERR_CONTINUE(idx == -1);
 				String full_path = ia.dir->get_file_path(idx);
-				if (_test_for_reimport(full_path, false)) {
+				if (must_reimport) {
 					//must reimport
 					reimports.push_back(full_path);
 				} else {
@@ -584,8 +644,15 @@ bool EditorFileSystem::_update_scan_actions() {
 		}
 	}
 
+	//everything the scan found missing is reimported below, so the directory as it was when the scan started is known good
+	bool snapshot_changed = import_dir_modified_time != scan_import_dir_modified_time || import_dir_settings_hash != ResourceFormatImporter::get_singleton()->get_import_settings_hash();
+	import_dir_modified_time = scan_import_dir_modified_time;
+	import_dir_settings_hash = ResourceFormatImporter::get_singleton()->get_import_settings_hash();
+
 	if (reimports.size()) {
-		reimport_files(reimports);
+		reimport_files(reimports); //saves the cache
+	} else if (snapshot_changed && !first_scan) {
+		_save_filesystem_cache();
 	}
 
 	if (first_scan) {
@@ -763,7 +830,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 				import_mt = FileAccess::get_modified_time(path + ".import");
 			}
 
-			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
+			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && (imported_files_verified || !_test_for_reimport(path, true))) {
 
 				fi->type = fc->type;
 				fi->deps = fc->deps;
@@ -981,7 +1048,7 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 				uint64_t import_mt = FileAccess::get_modified_time(path + ".import");
 				if (import_mt != p_dir->files[i]->import_modified_time) {
 					reimport = true;
-				} else if (_test_for_reimport(path, true)) {
+				} else if (!imported_files_verified && _test_for_reimport(path, true)) {
 					reimport = true;
 				}
 			}
@@ -1068,6 +1135,7 @@ void EditorFileSystem::scan_changes() {
 	scanning_changes_done = false;
 
 	abort_scan = false;
+	imported_files_verified = _begin_imported_files_scan();
 
 	if (!use_threads) {
 		if (filesystem) {
@@ -1699,12 +1767,22 @@ Error EditorFileSystem::_reimport_group(const String &p_group_file, const Vector
 	return err;
 }
 
-void EditorFileSystem::_reimport_file(const String &p_file) {
+bool EditorFileSystem::_prepare_import_file(const String &p_file) {
 
 	EditorFileSystemDirectory *fs = NULL;
 	int cpos = -1;
 	bool found = _find_file(p_file, &fs, cpos);
-	ERR_FAIL_COND_MSG(!found, "Can't find file '" + p_file + "'.");
+	ERR_FAIL_COND_V_MSG(!found, false, "Can't find file '" + p_file + "'.");
+
+	if (!FileAccess::exists(p_file + ".import")) {
+		late_added_files.insert(p_file); //imported files do not call update_file(), but just in case..
+	}
+
+	return true;
+}
+
+//does not touch the filesystem tree, so it can run from the import threads for importers that allow it
+Ref<ResourceImporter> EditorFileSystem::_import_file(const String &p_file) {
 
 	//try to obtain existing params
 
@@ -1728,9 +1806,6 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 				importer_name = cf->get_value("remap", "importer");
 			}
 		}
-
-	} else {
-		late_added_files.insert(p_file); //imported files do not call update_file(), but just in case..
 	}
 
 	Ref<ResourceImporter> importer;
@@ -1746,7 +1821,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		load_default = true;
 		if (importer.is_null()) {
 			ERR_PRINT("BUG: File queued for import, but can't be imported!");
-			ERR_FAIL();
+			ERR_FAIL_V(Ref<ResourceImporter>());
 		}
 	}
 
@@ -1786,7 +1861,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	//as import is complete, save the .import file
 
 	FileAccess *f = FileAccess::open(p_file + ".import", FileAccess::WRITE);
-	ERR_FAIL_COND_MSG(!f, "Cannot open file from path '" + p_file + ".import'.");
+	ERR_FAIL_COND_V_MSG(!f, Ref<ResourceImporter>(), "Cannot open file from path '" + p_file + ".import'.");
 
 	//write manually, as order matters ([remap] has to go first for performance).
 	f->store_line("[remap]");
@@ -1871,7 +1946,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 
 	// Store the md5's of the various files. These are stored separately so that the .import files can be version controlled.
 	FileAccess *md5s = FileAccess::open(base_path + ".md5", FileAccess::WRITE);
-	ERR_FAIL_COND_MSG(!md5s, "Cannot open MD5 file '" + base_path + ".md5'.");
+	ERR_FAIL_COND_V_MSG(!md5s, Ref<ResourceImporter>(), "Cannot open MD5 file '" + base_path + ".md5'.");
 
 	md5s->store_line("source_md5=\"" + FileAccess::get_md5(p_file) + "\"");
 	if (dest_paths.size()) {
@@ -1880,11 +1955,21 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	md5s->close();
 	memdelete(md5s);
 
+	return importer;
+}
+
+void EditorFileSystem::_update_imported_file(const String &p_file, const Ref<ResourceImporter> &p_importer) {
+
+	EditorFileSystemDirectory *fs = NULL;
+	int cpos = -1;
+	bool found = _find_file(p_file, &fs, cpos);
+	ERR_FAIL_COND_MSG(!found, "Can't find file '" + p_file + "'.");
+
 	//update modified times, to avoid reimport
 	fs->files[cpos]->modified_time = FileAccess::get_modified_time(p_file);
 	fs->files[cpos]->import_modified_time = FileAccess::get_modified_time(p_file + ".import");
 	fs->files[cpos]->deps = _get_dependencies(p_file);
-	fs->files[cpos]->type = importer->get_resource_type();
+	fs->files[cpos]->type = p_importer->get_resource_type();
 	fs->files[cpos]->import_valid = ResourceLoader::is_import_valid(p_file);
 
 	//if file is currently up, maybe the source it was loaded from changed, so import math must be updated for it
@@ -1904,6 +1989,58 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	EditorResourcePreview::get_singleton()->check_for_invalidation(p_file);
 }
 
+void EditorFileSystem::_reimport_file(const String &p_file) {
+
+	if (!_prepare_import_file(p_file)) {
+		return;
+	}
+
+	Ref<ResourceImporter> importer = _import_file(p_file);
+	if (importer.is_valid()) {
+		_update_imported_file(p_file, importer);
+	}
+}
+
+void EditorFileSystem::_import_thread_func(void *p_userdata, uint32_t p_index) {
+
+	ImportThreadData *data = (ImportThreadData *)p_userdata;
+	ImportFile &ifile = data->files[p_index];
+	if (ifile.threaded) {
+		ifile.importer = singleton->_import_file(ifile.path);
+	}
+	atomic_increment(&data->imported);
+}
+
+void EditorFileSystem::_reimport_threaded(ImportFile *p_files, int p_count, int p_progress_from, EditorProgress &p_progress) {
+
+	for (int i = 0; i < p_count; i++) {
+		//files that can't be found are skipped by the import threads, as in the serial path
+		p_files[i].threaded = _prepare_import_file(p_files[i].path);
+	}
+
+	ImportThreadData data;
+	data.files = p_files;
+	data.imported = 0;
+
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_group_task(&EditorFileSystem::_import_thread_func, &data, p_count);
+
+	//keep the progress dialog alive while the pool works
+	while (!WorkerThreadPool::get_singleton()->is_task_completed(task)) {
+		int imported = MIN(int(data.imported), p_count - 1);
+		p_progress.step(p_files[imported].path.get_file(), p_progress_from + imported);
+		OS::get_singleton()->delay_usec(10000);
+	}
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+
+	//updating the filesystem tree and the resource cache has to happen on the main thread
+	for (int i = 0; i < p_count; i++) {
+		if (p_files[i].threaded && p_files[i].importer.is_valid()) {
+			_update_imported_file(p_files[i].path, p_files[i].importer);
+		}
+		p_files[i].importer.unref();
+	}
+}
+
 void EditorFileSystem::_find_group_files(EditorFileSystemDirectory *efd, Map<String, Vector<String> > &group_files, Set<String> &groups_to_reimport) {
 
 	int fc = efd->files.size();
@@ -1937,6 +2074,7 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 	}
 
 	importing = true;
+	bool imported_files_unchanged = _are_imported_files_unchanged();
 	EditorProgress pr("reimport", TTR("(Re)Importing Assets"), p_files.size());
 
 	Vector<ImportFile> files;
@@ -1959,6 +2097,7 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 			ImportFile ifile;
 			ifile.path = p_files[i];
 			ifile.order = ResourceFormatImporter::get_singleton()->get_import_order(p_files[i]);
+			ifile.threaded = use_threads && ResourceFormatImporter::get_singleton()->can_import_threaded(p_files[i]);
 			files.push_back(ifile);
 		}
 
@@ -1973,9 +2112,21 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	files.sort();
 
-	for (int i = 0; i < files.size(); i++) {
-		pr.step(files[i].path.get_file(), i);
-		_reimport_file(files[i].path);
+	int i = 0;
+	while (i < files.size()) {
+
+		if (files[i].threaded) {
+			//import every consecutive file of the same order that allows it in parallel
+			int from = i;
+			while (i < files.size() && files[i].threaded && files[i].order == files[from].order) {
+				i++;
+			}
+			_reimport_threaded(files.ptrw() + from, i - from, from, pr);
+		} else {
+			pr.step(files[i].path.get_file(), i);
+			_reimport_file(files[i].path);
+			i++;
+		}
 	}
 
 	//reimport groups
@@ -1992,6 +2143,11 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 		}
 	}
 
+	if (imported_files_unchanged) {
+		//only this import touched res://.import, keep skipping the per file checks on the next scan
+		import_dir_modified_time = FileAccess::get_modified_time("res://.import");
+	}
+
 	_save_filesystem_cache();
 	importing = false;
 	if (!is_scanning()) {
@@ -2139,6 +2295,9 @@ EditorFileSystem::EditorFileSystem() {
 	update_script_classes_queued = false;
 	first_scan = true;
 	revalidate_import_files = false;
+	import_dir_modified_time = 0;
+	scan_import_dir_modified_time = 0;
+	imported_files_verified = false;
 }
 
 EditorFileSystem::~EditorFileSystem() {
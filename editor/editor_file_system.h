@@ -31,6 +31,7 @@
 #ifndef EDITOR_FILE_SYSTEM_H
 #define EDITOR_FILE_SYSTEM_H
 
+#include "core/io/resource_importer.h"
 #include "core/os/dir_access.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
@@ -38,6 +39,7 @@
 #include "scene/main/node.h"
 class FileAccess;
 
+struct EditorProgress;
 struct EditorProgressBG;
 class EditorFileSystemDirectory : public Object {
 
@@ -88,6 +90,7 @@ public:
 	String get_file(int p_idx) const;
 	String get_file_path(int p_idx) const;
 	StringName get_file_type(int p_idx) const;
+	uint64_t get_file_modified_time(int p_idx) const;
 	Vector<String> get_file_deps(int p_idx) const;
 	bool get_file_import_is_valid(int p_idx) const;
 	String get_file_script_class_name(int p_idx) const; //used for scripts
@@ -149,6 +152,16 @@ class EditorFileSystem : public Node {
 	String filesystem_settings_version_for_import;
 	bool revalidate_import_files;
 
+	//res://.import only changes modification time when files are added or removed from it, so as long as it matches the
+	//time at which every imported file was last known to exist (and import settings didn't change), scans can skip checking them one by one
+	uint64_t import_dir_modified_time;
+	String import_dir_settings_hash;
+	uint64_t scan_import_dir_modified_time;
+	bool imported_files_verified;
+
+	bool _begin_imported_files_scan();
+	bool _are_imported_files_unchanged() const;
+
 	void _scan_filesystem();
 
 	Set<String> late_added_files; //keep track of files that were added, these will be re-scanned
@@ -212,11 +225,21 @@ class EditorFileSystem : public Node {
 
 	void _update_extensions();
 
+	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
+
+	struct ReimportTestData {
+		const String *paths;
+		bool *results;
+	};
+
+	void _test_for_reimport_thread(uint32_t p_index, ReimportTestData *p_data);
+
 	void _reimport_file(const String &p_file);
+	bool _prepare_import_file(const String &p_file);
+	Ref<ResourceImporter> _import_file(const String &p_file);
+	void _update_imported_file(const String &p_file, const Ref<ResourceImporter> &p_importer);
 	Error _reimport_group(const String &p_group_file, const Vector<String> &p_files);
 
-	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
-
 	bool reimport_on_missing_imported_files;
 
 	Vector<String> _get_dependencies(const String &p_path);
@@ -224,11 +247,22 @@ class EditorFileSystem : public Node {
 	struct ImportFile {
 		String path;
 		int order;
+		bool threaded;
+		Ref<ResourceImporter> importer;
 		bool operator<(const ImportFile &p_if) const {
-			return order < p_if.order;
+			//within the same order, keep the files that can be imported in parallel together
+			return order == p_if.order ? (threaded && !p_if.threaded) : order < p_if.order;
 		}
 	};
 
+	struct ImportThreadData {
+		ImportFile *files;
+		volatile uint32_t imported;
+	};
+
+	static void _import_thread_func(void *p_userdata, uint32_t p_index);
+	void _reimport_threaded(ImportFile *p_files, int p_count, int p_progress_from, EditorProgress &p_progress);
+
 	void _scan_script_classes(EditorFileSystemDirectory *p_dir);
 	volatile bool update_script_classes_queued;
 	void _queue_update_script_classes();
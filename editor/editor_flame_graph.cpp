@@ -0,0 +1,262 @@
+/*************************************************************************/
+/*  editor_flame_graph.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "editor_flame_graph.h"
+
+#include "core/os/file_access.h"
+#include "editor_scale.h"
+
+void EditorFlameGraph::add_samples(const String &p_stack, uint64_t p_count) {
+
+	if (stacks.has(p_stack)) {
+		stacks[p_stack] += p_count;
+	} else {
+		stacks[p_stack] = p_count;
+	}
+
+	Vector<String> names = p_stack.split(";", false);
+
+	int frame = 0;
+	frames.write[0].samples += p_count;
+
+	for (int i = 0; i < names.size(); i++) {
+
+		int child;
+		const Map<String, int>::Element *E = frames[frame].children.find(names[i]);
+		if (E) {
+			child = E->get();
+		} else {
+			Frame f;
+			f.name = names[i];
+			f.samples = 0;
+			f.parent = frame;
+			child = frames.size();
+			frames.push_back(f);
+			frames.write[frame].children[names[i]] = child;
+		}
+
+		frames.write[child].samples += p_count;
+		frame = child;
+	}
+
+	update();
+}
+
+void EditorFlameGraph::clear() {
+
+	frames.resize(1);
+	frames.write[0].samples = 0;
+	frames.write[0].children.clear();
+	stacks.clear();
+	drawn_frames.clear();
+	focused = 0;
+	hovered = -1;
+	update();
+}
+
+Error EditorFlameGraph::save_folded_stacks(const String &p_path) const {
+
+	Error err;
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Cannot save profiler samples to file '" + p_path + "'.");
+
+	for (const Map<String, uint64_t>::Element *E = stacks.front(); E; E = E->next()) {
+		f->store_line(E->key() + " " + itos(E->get()));
+	}
+
+	return OK;
+}
+
+Color EditorFlameGraph::_get_frame_color(const Frame &p_frame) const {
+
+	//warm colors, stable per function
+	float rot = (p_frame.name.hash() % 1000) / 1000.0;
+	Color c;
+	c.set_hsv(0.01 + rot * 0.12, 0.65, 0.9);
+	return c;
+}
+
+void EditorFlameGraph::_draw_frame(int p_frame, int p_depth, float p_x, float p_width, float p_row_height) {
+
+	if (p_width < 1) {
+		return;
+	}
+
+	Rect2 rect(p_x, p_depth * p_row_height, p_width, p_row_height - 1);
+	if (rect.position.y > get_size().height) {
+		return;
+	}
+
+	const Frame &frame = frames[p_frame];
+
+	Color color = _get_frame_color(frame);
+	if (p_frame == hovered) {
+		color = color.lightened(0.3);
+	}
+	draw_rect(Rect2(rect.position, Size2(MAX(rect.size.width - 1, 1), rect.size.height)), color);
+
+	Ref<Font> font = get_font("font", "Label");
+	const float margin = 3 * EDSCALE;
+	if (p_width > margin * 4) {
+		String name = p_frame == 0 ? String(TTR("All")) : frame.name;
+		draw_string(font, rect.position + Vector2(margin, font->get_ascent() + (p_row_height - font->get_height()) / 2), name, Color(0, 0, 0), p_width - margin * 2);
+	}
+
+	DrawnFrame df;
+	df.rect = rect;
+	df.frame = p_frame;
+	drawn_frames.push_back(df);
+
+	float x = p_x;
+	for (const Map<String, int>::Element *E = frame.children.front(); E; E = E->next()) {
+		float w = p_width * frames[E->get()].samples / frame.samples;
+		_draw_frame(E->get(), p_depth + 1, x, w, p_row_height);
+		x += w;
+	}
+}
+
+int EditorFlameGraph::_get_frame_at(const Point2 &p_pos) const {
+
+	for (int i = 0; i < drawn_frames.size(); i++) {
+		if (drawn_frames[i].rect.has_point(p_pos)) {
+			return drawn_frames[i].frame;
+		}
+	}
+
+	return -1;
+}
+
+void EditorFlameGraph::_gui_input(const Ref<InputEvent> &p_event) {
+
+	Ref<InputEventMouseMotion> mm = p_event;
+	if (mm.is_valid()) {
+		int frame = _get_frame_at(mm->get_position());
+		if (frame != hovered) {
+			hovered = frame;
+			update();
+		}
+	}
+
+	Ref<InputEventMouseButton> mb = p_event;
+	if (mb.is_valid() && mb->is_pressed()) {
+		if (mb->get_button_index() == BUTTON_LEFT) {
+			//zoom into the clicked frame, clicking the ancestors above it zooms back out
+			int frame = _get_frame_at(mb->get_position());
+			if (frame != -1 && frame != focused) {
+				focused = frame;
+				update();
+			}
+		} else if (mb->get_button_index() == BUTTON_RIGHT && focused != 0) {
+			focused = 0;
+			update();
+		}
+	}
+}
+
+void EditorFlameGraph::_notification(int p_what) {
+
+	if (p_what == NOTIFICATION_MOUSE_EXIT) {
+		if (hovered != -1) {
+			hovered = -1;
+			update();
+		}
+	}
+
+	if (p_what == NOTIFICATION_DRAW) {
+
+		drawn_frames.clear();
+
+		draw_rect(Rect2(Point2(), get_size()), get_color("dark_color_2", "Editor"));
+
+		Ref<Font> font = get_font("font", "Label");
+
+		if (frames[0].samples == 0) {
+			String text = TTR("No samples yet.");
+			Size2 text_size = font->get_string_size(text);
+			draw_string(font, (get_size() - text_size) / 2 + Vector2(0, font->get_ascent()), text, get_color("font_color", "Label"));
+			return;
+		}
+
+		float row_height = font->get_height() + 4 * EDSCALE;
+		float width = get_size().width;
+
+		//the focused frame fills the width, its callers are shown above it
+		Vector<int> ancestors;
+		for (int f = frames[focused].parent; f != -1; f = frames[f].parent) {
+			ancestors.push_back(f);
+		}
+
+		for (int i = 0; i < ancestors.size(); i++) {
+			int frame = ancestors[ancestors.size() - i - 1];
+			Rect2 rect(0, i * row_height, width, row_height - 1);
+			draw_rect(rect, _get_frame_color(frames[frame]).darkened(0.4));
+			String name = frame == 0 ? String(TTR("All")) : frames[frame].name;
+			draw_string(font, rect.position + Vector2(3 * EDSCALE, font->get_ascent() + 2 * EDSCALE), name, Color(0, 0, 0), width);
+			DrawnFrame df;
+			df.rect = rect;
+			df.frame = frame;
+			drawn_frames.push_back(df);
+		}
+
+		_draw_frame(focused, ancestors.size(), 0, width, row_height);
+	}
+}
+
+String EditorFlameGraph::get_tooltip(const Point2 &p_pos) const {
+
+	int frame = _get_frame_at(p_pos);
+	if (frame == -1 || frames[0].samples == 0) {
+		return Control::get_tooltip(p_pos);
+	}
+
+	const Frame &f = frames[frame];
+	String name = frame == 0 ? String(TTR("All")) : f.name;
+	String percent = String::num(double(f.samples) * 100.0 / double(frames[0].samples), 1);
+	return name + "\n" + vformat(TTR("Samples: %d (%s%%)"), f.samples, percent);
+}
+
+void EditorFlameGraph::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("_gui_input"), &EditorFlameGraph::_gui_input);
+}
+
+EditorFlameGraph::EditorFlameGraph() {
+
+	Frame root;
+	root.samples = 0;
+	root.parent = -1;
+	frames.push_back(root);
+
+	focused = 0;
+	hovered = -1;
+
+	set_mouse_filter(MOUSE_FILTER_STOP);
+	set_clip_contents(true);
+}
@@ -0,0 +1,86 @@
+/*************************************************************************/
+/*  editor_flame_graph.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef EDITOR_FLAME_GRAPH_H
+#define EDITOR_FLAME_GRAPH_H
+
+#include "scene/gui/control.h"
+
+// Draws sampled call stacks as a flame graph, outermost calls at the top.
+// Stacks are given folded, with the frames separated by ';'.
+class EditorFlameGraph : public Control {
+
+	GDCLASS(EditorFlameGraph, Control);
+
+	struct Frame {
+
+		String name;
+		uint64_t samples;
+		int parent;
+		Map<String, int> children;
+	};
+
+	struct DrawnFrame {
+
+		Rect2 rect;
+		int frame;
+	};
+
+	Vector<Frame> frames; //frames[0] is the root, holding every sample
+	Map<String, uint64_t> stacks; //kept as received, for saving
+	Vector<DrawnFrame> drawn_frames;
+
+	int focused;
+	int hovered;
+
+	Color _get_frame_color(const Frame &p_frame) const;
+	void _draw_frame(int p_frame, int p_depth, float p_x, float p_width, float p_row_height);
+	int _get_frame_at(const Point2 &p_pos) const;
+
+	void _gui_input(const Ref<InputEvent> &p_event);
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void add_samples(const String &p_stack, uint64_t p_count);
+	uint64_t get_total_samples() const { return frames[0].samples; }
+	void clear();
+
+	//folded stacks, one "frame;frame;frame count" per line, as read by common flame graph tools
+	Error save_folded_stacks(const String &p_path) const;
+
+	virtual String get_tooltip(const Point2 &p_pos) const;
+
+	EditorFlameGraph();
+};
+
+#endif // EDITOR_FLAME_GRAPH_H
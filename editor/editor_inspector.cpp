@@ -1402,6 +1402,224 @@ bool EditorInspector::_is_property_disabled_by_feature_profile(const StringName
 	return false;
 }
 
+int EditorInspector::_create_property_editors(VBoxContainer *p_vbox, int p_position, const PropertyInfo &p, const String &p_label, const StringName &p_selected, int p_focusable) {
+
+	int added = 0;
+
+	bool checkable = false;
+	bool checked = false;
+	if (p.usage & PROPERTY_USAGE_CHECKABLE) {
+		checkable = true;
+		checked = p.usage & PROPERTY_USAGE_CHECKED;
+	}
+
+	String doc_hint;
+
+	if (use_doc_hints) {
+
+		StringName classname = object->get_class_name();
+		if (object_class != String()) {
+			classname = object_class;
+		}
+		StringName propname = property_prefix + p.name;
+		String descr;
+		bool found = false;
+
+		Map<StringName, Map<StringName, String> >::Element *E = descr_cache.find(classname);
+		if (E) {
+			Map<StringName, String>::Element *F = E->get().find(propname);
+			if (F) {
+				found = true;
+				descr = F->get();
+			}
+		}
+
+		if (!found) {
+			DocData *dd = EditorHelp::get_doc_data();
+			Map<String, DocData::ClassDoc>::Element *F = dd->class_list.find(classname);
+			while (F && descr == String()) {
+				for (int i = 0; i < F->get().properties.size(); i++) {
+					if (F->get().properties[i].name == propname.operator String()) {
+						descr = F->get().properties[i].description.strip_edges();
+						break;
+					}
+				}
+				if (!F->get().inherits.empty()) {
+					F = dd->class_list.find(F->get().inherits);
+				} else {
+					break;
+				}
+			}
+			descr_cache[classname][propname] = descr;
+		}
+
+		doc_hint = descr;
+	}
+
+	for (List<Ref<EditorInspectorPlugin> >::Element *E = valid_plugins.front(); E; E = E->next()) {
+		Ref<EditorInspectorPlugin> ped = E->get();
+		bool exclusive = ped->parse_property(object, p.type, p.name, p.hint, p.hint_string, p.usage);
+
+		List<EditorInspectorPlugin::AddedEditor> editors = ped->added_editors; //make a copy, since plugins may be used again in a sub-inspector
+		ped->added_editors.clear();
+
+		for (List<EditorInspectorPlugin::AddedEditor>::Element *F = editors.front(); F; F = F->next()) {
+
+			EditorProperty *ep = Object::cast_to<EditorProperty>(F->get().property_editor);
+
+			if (ep) {
+				//set all this before the control gets the ENTER_TREE notification
+				ep->object = object;
+
+				if (F->get().properties.size()) {
+
+					if (F->get().properties.size() == 1) {
+						//since it's one, associate:
+						ep->property = F->get().properties[0];
+						ep->property_usage = p.usage;
+						//and set label?
+					}
+
+					if (F->get().label != String()) {
+						ep->set_label(F->get().label);
+					} else {
+						//use existin one
+						ep->set_label(p_label);
+					}
+					for (int i = 0; i < F->get().properties.size(); i++) {
+						String prop = F->get().properties[i];
+
+						if (!editor_property_map.has(prop)) {
+							editor_property_map[prop] = List<EditorProperty *>();
+						}
+						editor_property_map[prop].push_back(ep);
+						property_values[prop] = object->get(prop);
+					}
+				}
+				ep->set_draw_red(draw_red);
+				ep->set_use_folding(use_folding);
+				ep->set_checkable(checkable);
+				ep->set_checked(checked);
+				ep->set_keying(keying);
+
+				ep->set_read_only(read_only);
+			}
+
+			p_vbox->add_child(F->get().property_editor);
+			if (p_position >= 0) {
+				p_vbox->move_child(F->get().property_editor, p_position + added);
+			}
+			added++;
+
+			if (ep) {
+
+				ep->connect("property_changed", this, "_property_changed");
+				if (p.usage & PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED) {
+					ep->connect("property_changed", this, "_property_changed_update_all", varray(), CONNECT_DEFERRED);
+				}
+				ep->connect("property_keyed", this, "_property_keyed");
+				ep->connect("property_keyed_with_value", this, "_property_keyed_with_value");
+				ep->connect("property_checked", this, "_property_checked");
+				ep->connect("selected", this, "_property_selected");
+				ep->connect("multiple_properties_changed", this, "_multiple_properties_changed");
+				ep->connect("resource_selected", this, "_resource_selected", varray(), CONNECT_DEFERRED);
+				ep->connect("object_id_selected", this, "_object_id_selected", varray(), CONNECT_DEFERRED);
+				if (doc_hint != String()) {
+					ep->set_tooltip(property_prefix + p.name + "::" + doc_hint);
+				} else {
+					ep->set_tooltip(property_prefix + p.name);
+				}
+				ep->update_property();
+				ep->update_reload_status();
+
+				if (p_selected && ep->property == p_selected) {
+					ep->select(p_focusable);
+				}
+			}
+		}
+
+		if (exclusive) {
+			break;
+		}
+	}
+
+	return added;
+}
+
+void EditorInspector::_section_visibility_changed(Object *p_vbox) {
+
+	VBoxContainer *vbox = Object::cast_to<VBoxContainer>(p_vbox);
+	if (!vbox || !vbox->is_visible()) {
+		return;
+	}
+
+	Map<VBoxContainer *, List<DeferredProperty> >::Element *E = deferred_properties.find(vbox);
+	if (!E) {
+		return;
+	}
+
+	List<DeferredProperty> props = E->get();
+	deferred_properties.erase(E);
+
+	//positions were taken with no editors in the box, shift them by what was inserted before
+	Map<VBoxContainer *, int> inserted;
+	for (List<DeferredProperty>::Element *F = props.front(); F; F = F->next()) {
+		const DeferredProperty &dp = F->get();
+		int offset = inserted.has(dp.vbox) ? inserted[dp.vbox] : 0;
+		inserted[dp.vbox] = offset + _create_property_editors(dp.vbox, dp.position + offset, dp.info, dp.label, StringName(), -1);
+	}
+}
+
+uint32_t EditorInspector::_hash_property_list(const List<PropertyInfo> &p_list) {
+
+	uint32_t h = hash_djb2_one_32(p_list.size());
+	for (const List<PropertyInfo>::Element *E = p_list.front(); E; E = E->next()) {
+		const PropertyInfo &pi = E->get();
+		h = hash_djb2_one_32(pi.name.hash(), h);
+		h = hash_djb2_one_32(pi.type, h);
+		h = hash_djb2_one_32(pi.hint, h);
+		h = hash_djb2_one_32(pi.hint_string.hash(), h);
+		h = hash_djb2_one_32(pi.usage, h);
+		h = hash_djb2_one_32(String(pi.class_name).hash(), h);
+	}
+	return h == 0 ? 1 : h; //zero means no tree was built
+}
+
+bool EditorInspector::_update_changed_properties() {
+
+	if (!object || property_list_hash == 0) {
+		return false;
+	}
+
+	List<PropertyInfo> plist;
+	object->get_property_list(&plist, true);
+	if (_hash_property_list(plist) != property_list_hash) {
+		return false;
+	}
+
+	//same properties as when the tree was built, only refresh the editors whose value changed
+	for (Map<StringName, List<EditorProperty *> >::Element *F = editor_property_map.front(); F; F = F->next()) {
+
+		Variant value = object->get(F->key());
+		Variant::Type type = value.get_type();
+		//containers and objects can change without the Variant changing, always refresh those
+		bool by_reference = type == Variant::OBJECT || type == Variant::ARRAY || type == Variant::DICTIONARY;
+
+		Variant *cached = property_values.getptr(F->key());
+		if (cached && !by_reference && cached->get_type() == type && *cached == value) {
+			continue;
+		}
+		property_values[F->key()] = value;
+
+		for (List<EditorProperty *>::Element *E = F->get().front(); E; E = E->next()) {
+			E->get()->update_property();
+			E->get()->update_reload_status();
+		}
+	}
+
+	return true;
+}
+
 void EditorInspector::update_tree() {
 
 	//to update properly if all is refreshed
@@ -1434,15 +1652,13 @@ void EditorInspector::update_tree() {
 	if (!object)
 		return;
 
-	List<Ref<EditorInspectorPlugin> > valid_plugins;
-
 	for (int i = inspector_plugin_count - 1; i >= 0; i--) { //start by last, so lastly added can override newly added
 		if (!inspector_plugins[i]->can_handle(object))
 			continue;
 		valid_plugins.push_back(inspector_plugins[i]);
 	}
 
-	bool draw_red = false;
+	draw_red = false;
 
 	{
 		Node *nod = Object::cast_to<Node>(object);
@@ -1462,6 +1678,7 @@ void EditorInspector::update_tree() {
 	List<PropertyInfo>
 			plist;
 	object->get_property_list(&plist, true);
+	property_list_hash = _hash_property_list(plist);
 
 	HashMap<String, VBoxContainer *> item_path;
 	Map<VBoxContainer *, EditorInspectorSection *> section_map;
@@ -1606,6 +1823,7 @@ void EditorInspector::update_tree() {
 		}
 
 		VBoxContainer *current_vbox = main_vbox;
+		VBoxContainer *folded_vbox = NULL; //innermost folded section
 
 		{
 
@@ -1633,6 +1851,9 @@ void EditorInspector::update_tree() {
 					section_map[vb] = section;
 				}
 				current_vbox = item_path[acc_path];
+				if (use_folding && !object->editor_is_section_unfolded(acc_path)) {
+					folded_vbox = current_vbox;
+				}
 				level = (MIN(level + 1, 4));
 			}
 
@@ -1645,141 +1866,25 @@ void EditorInspector::update_tree() {
 			}
 		}
 
-		bool checkable = false;
-		bool checked = false;
-		if (p.usage & PROPERTY_USAGE_CHECKABLE) {
-			checkable = true;
-			checked = p.usage & PROPERTY_USAGE_CHECKED;
-		}
-
 		if (p.usage & PROPERTY_USAGE_RESTART_IF_CHANGED) {
 			restart_request_props.insert(p.name);
 		}
 
-		String doc_hint;
-
-		if (use_doc_hints) {
-
-			StringName classname = object->get_class_name();
-			if (object_class != String()) {
-				classname = object_class;
-			}
-			StringName propname = property_prefix + p.name;
-			String descr;
-			bool found = false;
-
-			Map<StringName, Map<StringName, String> >::Element *E = descr_cache.find(classname);
-			if (E) {
-				Map<StringName, String>::Element *F = E->get().find(propname);
-				if (F) {
-					found = true;
-					descr = F->get();
-				}
-			}
-
-			if (!found) {
-				DocData *dd = EditorHelp::get_doc_data();
-				Map<String, DocData::ClassDoc>::Element *F = dd->class_list.find(classname);
-				while (F && descr == String()) {
-					for (int i = 0; i < F->get().properties.size(); i++) {
-						if (F->get().properties[i].name == propname.operator String()) {
-							descr = F->get().properties[i].description.strip_edges();
-							break;
-						}
-					}
-					if (!F->get().inherits.empty()) {
-						F = dd->class_list.find(F->get().inherits);
-					} else {
-						break;
-					}
-				}
-				descr_cache[classname][propname] = descr;
+		if (folded_vbox) {
+			// Creating editors is what makes large objects slow, so wait until the section is unfolded.
+			if (!deferred_properties.has(folded_vbox)) {
+				folded_vbox->connect("visibility_changed", this, "_section_visibility_changed", varray(folded_vbox));
 			}
-
-			doc_hint = descr;
+			DeferredProperty dp;
+			dp.info = p;
+			dp.label = name;
+			dp.vbox = current_vbox;
+			dp.position = current_vbox->get_child_count();
+			deferred_properties[folded_vbox].push_back(dp);
+			continue;
 		}
 
-		for (List<Ref<EditorInspectorPlugin> >::Element *E = valid_plugins.front(); E; E = E->next()) {
-			Ref<EditorInspectorPlugin> ped = E->get();
-			bool exclusive = ped->parse_property(object, p.type, p.name, p.hint, p.hint_string, p.usage);
-
-			List<EditorInspectorPlugin::AddedEditor> editors = ped->added_editors; //make a copy, since plugins may be used again in a sub-inspector
-			ped->added_editors.clear();
-
-			for (List<EditorInspectorPlugin::AddedEditor>::Element *F = editors.front(); F; F = F->next()) {
-
-				EditorProperty *ep = Object::cast_to<EditorProperty>(F->get().property_editor);
-
-				if (ep) {
-					//set all this before the control gets the ENTER_TREE notification
-					ep->object = object;
-
-					if (F->get().properties.size()) {
-
-						if (F->get().properties.size() == 1) {
-							//since it's one, associate:
-							ep->property = F->get().properties[0];
-							ep->property_usage = p.usage;
-							//and set label?
-						}
-
-						if (F->get().label != String()) {
-							ep->set_label(F->get().label);
-						} else {
-							//use existin one
-							ep->set_label(name);
-						}
-						for (int i = 0; i < F->get().properties.size(); i++) {
-							String prop = F->get().properties[i];
-
-							if (!editor_property_map.has(prop)) {
-								editor_property_map[prop] = List<EditorProperty *>();
-							}
-							editor_property_map[prop].push_back(ep);
-						}
-					}
-					ep->set_draw_red(draw_red);
-					ep->set_use_folding(use_folding);
-					ep->set_checkable(checkable);
-					ep->set_checked(checked);
-					ep->set_keying(keying);
-
-					ep->set_read_only(read_only);
-				}
-
-				current_vbox->add_child(F->get().property_editor);
-
-				if (ep) {
-
-					ep->connect("property_changed", this, "_property_changed");
-					if (p.usage & PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED) {
-						ep->connect("property_changed", this, "_property_changed_update_all", varray(), CONNECT_DEFERRED);
-					}
-					ep->connect("property_keyed", this, "_property_keyed");
-					ep->connect("property_keyed_with_value", this, "_property_keyed_with_value");
-					ep->connect("property_checked", this, "_property_checked");
-					ep->connect("selected", this, "_property_selected");
-					ep->connect("multiple_properties_changed", this, "_multiple_properties_changed");
-					ep->connect("resource_selected", this, "_resource_selected", varray(), CONNECT_DEFERRED);
-					ep->connect("object_id_selected", this, "_object_id_selected", varray(), CONNECT_DEFERRED);
-					if (doc_hint != String()) {
-						ep->set_tooltip(property_prefix + p.name + "::" + doc_hint);
-					} else {
-						ep->set_tooltip(property_prefix + p.name);
-					}
-					ep->update_property();
-					ep->update_reload_status();
-
-					if (current_selected && ep->property == current_selected) {
-						ep->select(current_focusable);
-					}
-				}
-			}
-
-			if (exclusive) {
-				break;
-			}
-		}
+		_create_property_editors(current_vbox, -1, p, name, current_selected, current_focusable);
 	}
 
 	for (List<Ref<EditorInspectorPlugin> >::Element *E = valid_plugins.front(); E; E = E->next()) {
@@ -1808,6 +1913,10 @@ void EditorInspector::_clear() {
 	property_selected = StringName();
 	property_focusable = -1;
 	editor_property_map.clear();
+	property_values.clear();
+	deferred_properties.clear();
+	valid_plugins.clear();
+	property_list_hash = 0;
 	sections.clear();
 	pending.clear();
 	restart_request_props.clear();
@@ -2210,7 +2319,9 @@ void EditorInspector::_notification(int p_what) {
 
 		if (update_tree_pending) {
 
-			update_tree();
+			if (!_update_changed_properties()) {
+				update_tree();
+			}
 			update_tree_pending = false;
 			pending.clear();
 
@@ -2295,6 +2406,7 @@ void EditorInspector::_bind_methods() {
 	ClassDB::bind_method("_resource_selected", &EditorInspector::_resource_selected);
 	ClassDB::bind_method("_object_id_selected", &EditorInspector::_object_id_selected);
 	ClassDB::bind_method("_vscroll_changed", &EditorInspector::_vscroll_changed);
+	ClassDB::bind_method("_section_visibility_changed", &EditorInspector::_section_visibility_changed);
 	ClassDB::bind_method("_feature_profile_changed", &EditorInspector::_feature_profile_changed);
 
 	ClassDB::bind_method("refresh", &EditorInspector::refresh);
@@ -2328,6 +2440,8 @@ EditorInspector::EditorInspector() {
 	use_folding = false;
 	update_all_pending = false;
 	update_tree_pending = false;
+	draw_red = false;
+	property_list_hash = 0;
 	refresh_countdown = 0;
 	read_only = false;
 	search_box = NULL;
@@ -297,6 +297,19 @@ class EditorInspector : public ScrollContainer {
 
 	Map<ObjectID, int> scroll_cache;
 
+	struct DeferredProperty {
+		PropertyInfo info;
+		String label;
+		VBoxContainer *vbox;
+		int position;
+	};
+
+	List<Ref<EditorInspectorPlugin> > valid_plugins;
+	bool draw_red;
+	Map<VBoxContainer *, List<DeferredProperty> > deferred_properties; //keyed by the folded section box that must be shown first
+	HashMap<StringName, Variant> property_values; //as last shown, to refresh only what changed
+	uint32_t property_list_hash;
+
 	String property_prefix; //used for sectioned inspector
 	String object_class;
 
@@ -328,6 +341,11 @@ class EditorInspector : public ScrollContainer {
 
 	bool _is_property_disabled_by_feature_profile(const StringName &p_property);
 
+	int _create_property_editors(VBoxContainer *p_vbox, int p_position, const PropertyInfo &p, const String &p_label, const StringName &p_selected, int p_focusable);
+	void _section_visibility_changed(Object *p_vbox);
+	static uint32_t _hash_property_list(const List<PropertyInfo> &p_list);
+	bool _update_changed_properties();
+
 protected:
 	static void _bind_methods();
 	void _notification(int p_what);
@@ -70,6 +70,7 @@
 #include "editor/editor_audio_buses.h"
 #include "editor/editor_export.h"
 #include "editor/editor_feature_profile.h"
+#include "editor/editor_file_index.h"
 #include "editor/editor_file_system.h"
 #include "editor/editor_help.h"
 #include "editor/editor_inspector.h"
@@ -424,6 +425,7 @@ void EditorNode::_notification(int p_what) {
 		} break;
 
 		case EditorSettings::NOTIFICATION_EDITOR_SETTINGS_CHANGED: {
+			editor_data.get_undo_redo().set_max_history_memory(int64_t(EDITOR_GET("interface/editor/undo_history_max_memory_mb")) * 1024 * 1024);
 			scene_tabs->set_tab_close_display_policy((bool(EDITOR_GET("interface/scene_tabs/always_show_close_button")) ? Tabs::CLOSE_BUTTON_SHOW_ALWAYS : Tabs::CLOSE_BUTTON_SHOW_ACTIVE_ONLY));
 			theme = create_editor_theme(theme_base->get_theme());
 
@@ -676,6 +678,7 @@ void EditorNode::_sources_changed(bool p_exist) {
 		// Start preview thread now that it's safe.
 		if (!singleton->cmdline_export_mode) {
 			EditorResourcePreview::get_singleton()->start();
+			file_index->start();
 		}
 
 		_load_docks();
@@ -2760,6 +2763,7 @@ int EditorNode::_next_unsaved_scene(bool p_valid_filename, int p_start) {
 void EditorNode::_exit_editor() {
 	exiting = true;
 	resource_preview->stop(); //stop early to avoid crashes
+	file_index->stop();
 	_save_docks();
 
 	// Dim the editor window while it's quitting to make it clearer that it's busy
@@ -3608,9 +3612,18 @@ void EditorNode::notify_child_process_exited() {
 }
 
 void EditorNode::add_io_error(const String &p_error) {
+	if (Thread::get_caller_id() != Thread::get_main_id()) {
+		//reported from an import thread, the dialog can only be touched from the main thread
+		singleton->call_deferred("_add_io_error", p_error);
+		return;
+	}
 	_load_error_notify(singleton, p_error);
 }
 
+void EditorNode::_add_io_error(const String &p_error) {
+	_load_error_notify(this, p_error);
+}
+
 void EditorNode::_load_error_notify(void *p_ud, const String &p_text) {
 
 	EditorNode *en = (EditorNode *)p_ud;
@@ -5409,6 +5422,7 @@ void EditorNode::_feature_profile_changed() {
 void EditorNode::_bind_methods() {
 
 	ClassDB::bind_method("_menu_option", &EditorNode::_menu_option);
+	ClassDB::bind_method("_add_io_error", &EditorNode::_add_io_error);
 	ClassDB::bind_method("_tool_menu_option", &EditorNode::_tool_menu_option);
 	ClassDB::bind_method("_menu_confirm_current", &EditorNode::_menu_confirm_current);
 	ClassDB::bind_method("_dialog_action", &EditorNode::_dialog_action);
@@ -5794,6 +5808,8 @@ EditorNode::EditorNode() {
 	EDITOR_DEF("interface/editor/quit_confirmation", true);
 	EDITOR_DEF("interface/editor/show_update_spinner", false);
 	EDITOR_DEF("interface/editor/update_continuously", false);
+	EDITOR_DEF("interface/editor/undo_history_max_memory_mb", 512);
+	editor_data.get_undo_redo().set_max_history_memory(int64_t(EDITOR_GET("interface/editor/undo_history_max_memory_mb")) * 1024 * 1024);
 	EDITOR_DEF_RST("interface/scene_tabs/restore_scenes_on_load", false);
 	EDITOR_DEF_RST("interface/scene_tabs/show_thumbnail_on_hover", true);
 	EDITOR_DEF_RST("interface/inspector/capitalize_properties", true);
@@ -5823,6 +5839,8 @@ EditorNode::EditorNode() {
 
 	resource_preview = memnew(EditorResourcePreview);
 	add_child(resource_preview);
+	file_index = memnew(EditorFileIndex);
+	add_child(file_index);
 	progress_dialog = memnew(ProgressDialog);
 	gui_base->add_child(progress_dialog);
 
@@ -6730,6 +6748,16 @@ EditorNode::EditorNode() {
 
 	EditorExport::get_singleton()->add_export_plugin(export_text_to_binary_plugin);
 
+	Ref<EditorExportSpatialMaterialVariantsPlugin> export_spatial_material_variants_plugin;
+	export_spatial_material_variants_plugin.instance();
+
+	EditorExport::get_singleton()->add_export_plugin(export_spatial_material_variants_plugin);
+
+	Ref<EditorExportTranslationPlugin> export_translation_plugin;
+	export_translation_plugin.instance();
+
+	EditorExport::get_singleton()->add_export_plugin(export_translation_plugin);
+
 	_edit_current();
 	current = NULL;
 	saving_resource = Ref<Resource>();
@@ -53,6 +53,7 @@ class DependencyErrorDialog;
 class EditorAbout;
 class EditorExport;
 class EditorFeatureProfileManager;
+class EditorFileIndex;
 class EditorFileServer;
 class EditorInspector;
 class EditorLayoutsDialog;
@@ -408,6 +409,7 @@ private:
 	EditorSelection *editor_selection;
 	ProjectExportDialog *project_export;
 	EditorResourcePreview *resource_preview;
+	EditorFileIndex *file_index;
 	EditorFolding editor_folding;
 
 	EditorFileServer *file_server;
@@ -514,6 +516,7 @@ private:
 	void _unhandled_input(const Ref<InputEvent> &p_event);
 
 	static void _load_error_notify(void *p_ud, const String &p_text);
+	void _add_io_error(const String &p_error);
 
 	bool has_main_screen() const { return true; }
 
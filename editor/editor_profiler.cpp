@@ -99,6 +99,8 @@ void EditorProfiler::clear() {
 	updating_frame = false;
 	hover_metric = -1;
 	seeking = false;
+
+	flame_graph->clear();
 }
 
 static String _get_percent_txt(float p_value, float p_total) {
@@ -427,9 +429,41 @@ void EditorProfiler::_activate_pressed() {
 		activate->set_icon(get_icon("Play", "EditorIcons"));
 		activate->set_text(TTR("Start"));
 	}
+	profile_mode->set_disabled(activate->is_pressed());
 	emit_signal("enable_profiling", activate->is_pressed());
 }
 
+void EditorProfiler::_profile_mode_changed(int p_mode) {
+
+	bool sampled = p_mode == PROFILE_MODE_SAMPLED;
+	h_split->set_visible(!sampled);
+	flame_graph->set_visible(sampled);
+	export_samples->set_visible(sampled);
+	display_mode->set_disabled(sampled);
+	display_time->set_disabled(sampled);
+	cursor_metric_edit->set_editable(!sampled);
+}
+
+void EditorProfiler::_export_samples_pressed() {
+
+	samples_file_dialog->popup_centered_ratio();
+}
+
+void EditorProfiler::_samples_file_selected(const String &p_path) {
+
+	flame_graph->save_folded_stacks(p_path);
+}
+
+bool EditorProfiler::is_sampling() const {
+
+	return profile_mode->get_selected() == PROFILE_MODE_SAMPLED;
+}
+
+void EditorProfiler::add_samples(const String &p_stack, uint64_t p_count) {
+
+	flame_graph->add_samples(p_stack, p_count);
+}
+
 void EditorProfiler::_clear_pressed() {
 
 	clear();
@@ -441,6 +475,7 @@ void EditorProfiler::_notification(int p_what) {
 	if (p_what == NOTIFICATION_ENTER_TREE) {
 		activate->set_icon(get_icon("Play", "EditorIcons"));
 		clear_button->set_icon(get_icon("Clear", "EditorIcons"));
+		export_samples->set_icon(get_icon("Save", "EditorIcons"));
 	}
 }
 
@@ -608,6 +643,9 @@ void EditorProfiler::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_graph_tex_mouse_exit"), &EditorProfiler::_graph_tex_mouse_exit);
 	ClassDB::bind_method(D_METHOD("_cursor_metric_changed"), &EditorProfiler::_cursor_metric_changed);
 	ClassDB::bind_method(D_METHOD("_combo_changed"), &EditorProfiler::_combo_changed);
+	ClassDB::bind_method(D_METHOD("_profile_mode_changed"), &EditorProfiler::_profile_mode_changed);
+	ClassDB::bind_method(D_METHOD("_export_samples_pressed"), &EditorProfiler::_export_samples_pressed);
+	ClassDB::bind_method(D_METHOD("_samples_file_selected"), &EditorProfiler::_samples_file_selected);
 
 	ClassDB::bind_method(D_METHOD("_item_edited"), &EditorProfiler::_item_edited);
 	ADD_SIGNAL(MethodInfo("enable_profiling", PropertyInfo(Variant::BOOL, "enable")));
@@ -695,6 +733,21 @@ EditorProfiler::EditorProfiler() {
 	clear_button->connect("pressed", this, "_clear_pressed");
 	hb->add_child(clear_button);
 
+	hb->add_child(memnew(Label(TTR("Mode:"))));
+
+	profile_mode = memnew(OptionButton);
+	profile_mode->add_item(TTR("Instrumented"));
+	profile_mode->add_item(TTR("Sampled"));
+	profile_mode->set_tooltip(TTR("Sampling records the script call stacks at a fixed interval, with much less overhead than measuring every call."));
+	profile_mode->connect("item_selected", this, "_profile_mode_changed");
+	hb->add_child(profile_mode);
+
+	export_samples = memnew(Button);
+	export_samples->set_text(TTR("Export Samples"));
+	export_samples->set_tooltip(TTR("Save the sampled call stacks in the folded format used by flame graph tools."));
+	export_samples->connect("pressed", this, "_export_samples_pressed");
+	hb->add_child(export_samples);
+
 	hb->add_child(memnew(Label(TTR("Measure:"))));
 
 	display_mode = memnew(OptionButton);
@@ -758,12 +811,24 @@ EditorProfiler::EditorProfiler() {
 	h_split->add_child(graph);
 	graph->set_h_size_flags(SIZE_EXPAND_FILL);
 
+	flame_graph = memnew(EditorFlameGraph);
+	flame_graph->set_v_size_flags(SIZE_EXPAND_FILL);
+	add_child(flame_graph);
+
+	samples_file_dialog = memnew(EditorFileDialog);
+	samples_file_dialog->set_mode(EditorFileDialog::MODE_SAVE_FILE);
+	samples_file_dialog->set_access(EditorFileDialog::ACCESS_FILESYSTEM);
+	samples_file_dialog->add_filter("*.txt ; " + TTR("Folded Stacks"));
+	samples_file_dialog->connect("file_selected", this, "_samples_file_selected");
+	add_child(samples_file_dialog);
+
 	int metric_size = CLAMP(int(EDITOR_DEF("debugger/profiler_frame_history_size", 600)), 60, 1024);
 	frame_metrics.resize(metric_size);
 	last_metric = -1;
 	hover_metric = -1;
 
 	EDITOR_DEF("debugger/profiler_frame_max_functions", 64);
+	EDITOR_DEF("debugger/profiler_sampling_interval_usec", 1000);
 
 	frame_delay = memnew(Timer);
 	frame_delay->set_wait_time(0.1);
@@ -782,4 +847,6 @@ EditorProfiler::EditorProfiler() {
 
 	seeking = false;
 	graph_height = 1;
+
+	_profile_mode_changed(PROFILE_MODE_INSTRUMENTED);
 }
@@ -31,6 +31,8 @@
 #ifndef EDITORPROFILER_H
 #define EDITORPROFILER_H
 
+#include "editor/editor_file_dialog.h"
+#include "editor/editor_flame_graph.h"
 #include "scene/gui/box_container.h"
 #include "scene/gui/button.h"
 #include "scene/gui/label.h"
@@ -98,6 +100,11 @@ public:
 		DISPLAY_SELF_TIME,
 	};
 
+	enum ProfileMode {
+		PROFILE_MODE_INSTRUMENTED,
+		PROFILE_MODE_SAMPLED,
+	};
+
 private:
 	Button *activate;
 	Button *clear_button;
@@ -107,6 +114,11 @@ private:
 	Tree *variables;
 	HSplitContainer *h_split;
 
+	OptionButton *profile_mode;
+	Button *export_samples;
+	EditorFlameGraph *flame_graph;
+	EditorFileDialog *samples_file_dialog;
+
 	Set<StringName> plot_sigs;
 
 	OptionButton *display_mode;
@@ -156,6 +168,10 @@ private:
 
 	void _combo_changed(int);
 
+	void _profile_mode_changed(int p_mode);
+	void _export_samples_pressed();
+	void _samples_file_selected(const String &p_path);
+
 protected:
 	void _notification(int p_what);
 	static void _bind_methods();
@@ -164,6 +180,8 @@ public:
 	void add_frame_metric(const Metric &p_metric, bool p_final = false);
 	void set_enabled(bool p_enable);
 	bool is_profiling();
+	bool is_sampling() const;
+	void add_samples(const String &p_stack, uint64_t p_count);
 	bool is_seeking() { return seeking; }
 	void disable_seeking();
 
@@ -309,12 +309,7 @@ void EditorPropertyArray::update_property() {
 			page_hb->add_child(page);
 			page->set_h_size_flags(SIZE_EXPAND_FILL);
 			page->connect("value_changed", this, "_page_changed");
-		} else {
-			//bye bye children of the box
-			while (vbox->get_child_count() > 2) {
-				vbox->get_child(2)->queue_delete(); // button still needed after pressed is called
-				vbox->remove_child(vbox->get_child(2));
-			}
+			row_types.clear();
 		}
 
 		int len = array.call("size");
@@ -338,10 +333,11 @@ void EditorPropertyArray::update_property() {
 
 		object->set_array(array);
 
+		// Rows only depend on the page and on the type of each element, when those are
+		// unchanged the existing editors are refreshed instead of being built again.
+		Vector<int> types;
+		types.resize(amount);
 		for (int i = 0; i < amount; i++) {
-			String prop_name = "indices/" + itos(i + offset);
-
-			EditorProperty *prop = NULL;
 			Variant value = array.get(i + offset);
 			Variant::Type value_type = value.get_type();
 
@@ -350,6 +346,45 @@ void EditorPropertyArray::update_property() {
 			}
 
 			if (value_type == Variant::OBJECT && Object::cast_to<EncodedObjectAsID>(value)) {
+				types.write[i] = Variant::VARIANT_MAX;
+			} else {
+				types.write[i] = value_type;
+			}
+		}
+
+		bool reuse_rows = offset == row_offset && types.size() == row_types.size() && vbox->get_child_count() == amount + 2;
+		for (int i = 0; reuse_rows && i < amount; i++) {
+			reuse_rows = types[i] == row_types[i];
+		}
+
+		if (reuse_rows) {
+			for (int i = 0; i < amount; i++) {
+				EditorProperty *prop = Object::cast_to<EditorProperty>(vbox->get_child(i + 2)->get_child(0));
+				if (prop) {
+					prop->update_property();
+				}
+			}
+
+			updating = false;
+			return;
+		}
+
+		//bye bye children of the box
+		while (vbox->get_child_count() > 2) {
+			vbox->get_child(2)->queue_delete(); // button still needed after pressed is called
+			vbox->remove_child(vbox->get_child(2));
+		}
+
+		row_offset = offset;
+		row_types = types;
+
+		for (int i = 0; i < amount; i++) {
+			String prop_name = "indices/" + itos(i + offset);
+
+			EditorProperty *prop = NULL;
+			Variant::Type value_type = types[i] == Variant::VARIANT_MAX ? Variant::OBJECT : Variant::Type(types[i]);
+
+			if (types[i] == Variant::VARIANT_MAX) {
 				EditorPropertyObjectID *editor = memnew(EditorPropertyObjectID);
 				editor->setup("Object");
 				prop = editor;
@@ -506,6 +541,7 @@ EditorPropertyArray::EditorPropertyArray() {
 	object.instance();
 	page_idx = 0;
 	page_len = 10;
+	row_offset = -1;
 	edit = memnew(Button);
 	edit->set_flat(true);
 	edit->set_h_size_flags(SIZE_EXPAND_FILL);
@@ -96,6 +96,8 @@ class EditorPropertyArray : public EditorProperty {
 	Variant::Type subtype;
 	PropertyHint subtype_hint;
 	String subtype_hint_string;
+	int row_offset;
+	Vector<int> row_types; //per visible element, VARIANT_MAX for object IDs
 
 	void _page_changed(double p_page);
 	void _length_changed(double p_page);
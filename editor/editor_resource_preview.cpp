@@ -87,6 +87,15 @@ bool EditorResourcePreviewGenerator::can_generate_small_preview() const {
 	return false;
 }
 
+bool EditorResourcePreviewGenerator::is_thread_safe() const {
+
+	if (get_script_instance() && get_script_instance()->has_method("is_thread_safe")) {
+		return get_script_instance()->call("is_thread_safe");
+	}
+
+	return false;
+}
+
 void EditorResourcePreviewGenerator::_bind_methods() {
 
 	ClassDB::add_virtual_method(get_class_static(), MethodInfo(Variant::BOOL, "handles", PropertyInfo(Variant::STRING, "type")));
@@ -94,6 +103,7 @@ void EditorResourcePreviewGenerator::_bind_methods() {
 	ClassDB::add_virtual_method(get_class_static(), MethodInfo(CLASS_INFO(Texture), "generate_from_path", PropertyInfo(Variant::STRING, "path", PROPERTY_HINT_FILE), PropertyInfo(Variant::VECTOR2, "size")));
 	ClassDB::add_virtual_method(get_class_static(), MethodInfo(Variant::BOOL, "generate_small_preview_automatically"));
 	ClassDB::add_virtual_method(get_class_static(), MethodInfo(Variant::BOOL, "can_generate_small_preview"));
+	ClassDB::add_virtual_method(get_class_static(), MethodInfo(Variant::BOOL, "is_thread_safe"));
 }
 
 EditorResourcePreviewGenerator::EditorResourcePreviewGenerator() {
@@ -136,7 +146,33 @@ void EditorResourcePreview::_preview_ready(const String &p_str, const Ref<Textur
 	MessageQueue::get_singleton()->push_call(id, p_func, path, p_texture, p_small_texture, p_ud);
 }
 
-void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const QueueItem &p_item, const String &cache_base) {
+Ref<EditorResourcePreviewGenerator> EditorResourcePreview::_get_generator(const String &p_type) const {
+
+	for (int i = 0; i < preview_generators.size(); i++) {
+		if (preview_generators[i]->handles(p_type))
+			return preview_generators[i];
+	}
+
+	return Ref<EditorResourcePreviewGenerator>();
+}
+
+String EditorResourcePreview::_get_cache_base(const String &p_path) const {
+
+	String temp_path = EditorSettings::get_singleton()->get_cache_dir();
+	String cache_base = ProjectSettings::get_singleton()->globalize_path(p_path).md5_text();
+	return temp_path.plus_file("resthumb-" + cache_base);
+}
+
+void EditorResourcePreview::_get_thumbnail_sizes(int &r_size, int &r_small_size) const {
+
+	r_size = EditorSettings::get_singleton()->get("filesystem/file_dialog/thumbnail_size");
+	r_size *= EDSCALE;
+
+	r_small_size = EditorNode::get_singleton()->get_theme_base()->get_icon("Object", "EditorIcons")->get_width(); // Kind of a workaround to retrieve the default icon size
+	r_small_size *= EDSCALE;
+}
+
+void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const QueueItem &p_item, const String &cache_base, int p_thumbnail_size, int p_small_thumbnail_size) {
 	String type;
 
 	if (p_item.resource.is_valid())
@@ -150,78 +186,207 @@ void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<
 		return; //could not guess type
 	}
 
-	int thumbnail_size = EditorSettings::get_singleton()->get("filesystem/file_dialog/thumbnail_size");
-	thumbnail_size *= EDSCALE;
-
 	r_texture = Ref<ImageTexture>();
 	r_small_texture = Ref<ImageTexture>();
 
-	for (int i = 0; i < preview_generators.size(); i++) {
-		if (!preview_generators[i]->handles(type))
-			continue;
+	Ref<EditorResourcePreviewGenerator> generator = _get_generator(type);
+	if (generator.is_null()) {
+		return;
+	}
 
-		Ref<Texture> generated;
+	Ref<Texture> generated;
+	if (p_item.resource.is_valid()) {
+		generated = generator->generate(p_item.resource, Vector2(p_thumbnail_size, p_thumbnail_size));
+	} else {
+		generated = generator->generate_from_path(p_item.path, Vector2(p_thumbnail_size, p_thumbnail_size));
+	}
+	r_texture = generated;
+
+	if (generator->can_generate_small_preview()) {
+		Ref<Texture> generated_small;
 		if (p_item.resource.is_valid()) {
-			generated = preview_generators[i]->generate(p_item.resource, Vector2(thumbnail_size, thumbnail_size));
+			generated_small = generator->generate(p_item.resource, Vector2(p_small_thumbnail_size, p_small_thumbnail_size));
 		} else {
-			generated = preview_generators[i]->generate_from_path(p_item.path, Vector2(thumbnail_size, thumbnail_size));
-		}
-		r_texture = generated;
-
-		int small_thumbnail_size = EditorNode::get_singleton()->get_theme_base()->get_icon("Object", "EditorIcons")->get_width(); // Kind of a workaround to retrieve the default icon size
-		small_thumbnail_size *= EDSCALE;
-
-		if (preview_generators[i]->can_generate_small_preview()) {
-			Ref<Texture> generated_small;
-			if (p_item.resource.is_valid()) {
-				generated_small = preview_generators[i]->generate(p_item.resource, Vector2(small_thumbnail_size, small_thumbnail_size));
-			} else {
-				generated_small = preview_generators[i]->generate_from_path(p_item.path, Vector2(small_thumbnail_size, small_thumbnail_size));
-			}
-			r_small_texture = generated_small;
-		}
-
-		if (!r_small_texture.is_valid() && r_texture.is_valid() && preview_generators[i]->generate_small_preview_automatically()) {
-			Ref<Image> small_image = r_texture->get_data();
-			small_image = small_image->duplicate();
-			small_image->resize(small_thumbnail_size, small_thumbnail_size, Image::INTERPOLATE_CUBIC);
-			r_small_texture.instance();
-			r_small_texture->create_from_image(small_image);
+			generated_small = generator->generate_from_path(p_item.path, Vector2(p_small_thumbnail_size, p_small_thumbnail_size));
 		}
+		r_small_texture = generated_small;
+	}
 
-		break;
+	if (!r_small_texture.is_valid() && r_texture.is_valid() && generator->generate_small_preview_automatically()) {
+		Ref<Image> small_image = r_texture->get_data();
+		small_image = small_image->duplicate();
+		small_image->resize(p_small_thumbnail_size, p_small_thumbnail_size, Image::INTERPOLATE_CUBIC);
+		r_small_texture.instance();
+		r_small_texture->create_from_image(small_image);
 	}
 
 	if (!p_item.resource.is_valid()) {
 		// cache the preview in case it's a resource on disk
-		if (r_texture.is_valid()) {
-			//wow it generated a preview... save cache
-			bool has_small_texture = r_small_texture.is_valid();
+		//a generator that ran and produced nothing is cached too, so the resource is not loaded again until it changes
+		bool has_texture = r_texture.is_valid();
+		bool has_small_texture = r_small_texture.is_valid();
+		if (has_texture) {
 			ResourceSaver::save(cache_base + ".png", r_texture);
 			if (has_small_texture) {
 				ResourceSaver::save(cache_base + "_small.png", r_small_texture);
 			}
-			FileAccess *f = FileAccess::open(cache_base + ".txt", FileAccess::WRITE);
-			ERR_FAIL_COND_MSG(!f, "Cannot create file '" + cache_base + ".txt'. Check user write permissions.");
-			f->store_line(itos(thumbnail_size));
+		}
+		FileAccess *f = FileAccess::open(cache_base + ".txt", FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(!f, "Cannot create file '" + cache_base + ".txt'. Check user write permissions.");
+		f->store_line(itos(p_thumbnail_size));
+		f->store_line(itos(has_small_texture));
+		f->store_line(itos(FileAccess::get_modified_time(p_item.path)));
+		f->store_line(FileAccess::get_md5(p_item.path));
+		f->store_line(itos(has_texture));
+		f->close();
+		memdelete(f);
+	}
+}
+
+bool EditorResourcePreview::_load_cached_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const String &p_path, const String &p_cache_base, int p_thumbnail_size) {
+
+	String file = p_cache_base + ".txt";
+	FileAccess *f = FileAccess::open(file, FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	uint64_t modtime = FileAccess::get_modified_time(p_path);
+	int tsize = f->get_line().to_int64();
+	bool has_small_texture = f->get_line().to_int();
+	uint64_t last_modtime = f->get_line().to_int64();
+	String last_md5 = f->get_line();
+	String has_texture_line = f->get_line();
+	bool has_texture = has_texture_line == "" || has_texture_line.to_int(); //caches written before this line existed always had a texture
+	memdelete(f);
+
+	if (tsize != p_thumbnail_size) {
+		return false;
+	}
+
+	if (last_modtime != modtime) {
+
+		String md5 = FileAccess::get_md5(p_path);
+		if (last_md5 != md5) {
+			return false;
+		}
+
+		//update modified time
+		f = FileAccess::open(file, FileAccess::WRITE);
+		if (!f) {
+			// Not returning as this would leave the thread hanging and would require
+			// some proper cleanup/disabling of resource preview generation.
+			ERR_PRINT("Cannot create file '" + file + "'. Check user write permissions.");
+		} else {
+			f->store_line(itos(p_thumbnail_size));
 			f->store_line(itos(has_small_texture));
-			f->store_line(itos(FileAccess::get_modified_time(p_item.path)));
-			f->store_line(FileAccess::get_md5(p_item.path));
-			f->close();
+			f->store_line(itos(modtime));
+			f->store_line(md5);
+			f->store_line(itos(has_texture));
 			memdelete(f);
 		}
 	}
+
+	if (!has_texture) {
+		r_texture = Ref<ImageTexture>();
+		r_small_texture = Ref<ImageTexture>();
+		return true;
+	}
+
+	Ref<Image> img;
+	img.instance();
+	if (img->load(p_cache_base + ".png") != OK) {
+		return false;
+	}
+
+	r_texture.instance();
+	r_texture->create_from_image(img, Texture::FLAG_FILTER);
+
+	if (has_small_texture) {
+		Ref<Image> small_img;
+		small_img.instance();
+		if (small_img->load(p_cache_base + "_small.png") != OK) {
+			r_texture = Ref<ImageTexture>();
+			return false;
+		}
+		r_small_texture.instance();
+		r_small_texture->create_from_image(small_img, Texture::FLAG_FILTER);
+	}
+
+	return true;
+}
+
+void EditorResourcePreview::_process_path_task(PathTask *p_task) {
+
+	const QueueItem &item = p_task->item;
+	String cache_base = _get_cache_base(item.path);
+
+	Ref<ImageTexture> texture;
+	Ref<ImageTexture> small_texture;
+
+	if (!_load_cached_preview(texture, small_texture, item.path, cache_base, p_task->thumbnail_size)) {
+
+		if (p_task->on_worker) {
+			Ref<EditorResourcePreviewGenerator> generator = _get_generator(ResourceLoader::get_resource_type(item.path));
+			if (generator.is_valid() && !generator->is_thread_safe()) {
+				//needs the renderer (or is a script), hand it back to the preview thread
+				preview_mutex->lock();
+				render_queue.push_back(item);
+				preview_mutex->unlock();
+				preview_sem->post();
+				memdelete(p_task);
+				return;
+			}
+		}
+
+		_generate_preview(texture, small_texture, item, cache_base, p_task->thumbnail_size, p_task->small_thumbnail_size);
+	}
+
+	_preview_ready(item.path, texture, small_texture, item.id, item.function, item.userdata);
+	memdelete(p_task);
+}
+
+void EditorResourcePreview::_path_task_func(void *p_userdata, uint32_t p_index) {
+
+	PathTask *task = (PathTask *)p_userdata;
+	task->preview->_process_path_task(task);
 }
 
 void EditorResourcePreview::_thread() {
 
 	exited = false;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	bool use_pool = pool && pool->get_thread_count() > 0;
+	//bounded, so requests queued later (and renderer previews handed back) are not stuck behind thousands of tasks
+	int max_tasks = use_pool ? pool->get_thread_count() * 2 : 0;
+
 	while (!exit) {
 
 		preview_sem->wait();
 		preview_mutex->lock();
 
-		if (queue.size()) {
+		while (tasks.size() && pool->is_task_completed(tasks.front()->get())) {
+			pool->wait_for_task_completion(tasks.front()->get());
+			tasks.pop_front();
+		}
+
+		if (render_queue.size()) {
+
+			//renderer based previews are generated back to back here, everything else runs on the worker pool
+			QueueItem item = render_queue.front()->get();
+			render_queue.pop_front();
+			preview_mutex->unlock();
+
+			int thumbnail_size, small_thumbnail_size;
+			_get_thumbnail_sizes(thumbnail_size, small_thumbnail_size);
+
+			Ref<ImageTexture> texture;
+			Ref<ImageTexture> small_texture;
+			_generate_preview(texture, small_texture, item, _get_cache_base(item.path), thumbnail_size, small_thumbnail_size);
+			_preview_ready(item.path, texture, small_texture, item.id, item.function, item.userdata);
+
+		} else if (queue.size()) {
 
 			QueueItem item = queue.front()->get();
 			queue.pop_front();
@@ -240,107 +405,37 @@ void EditorResourcePreview::_thread() {
 
 				preview_mutex->unlock();
 
-				Ref<ImageTexture> texture;
-				Ref<ImageTexture> small_texture;
-
-				int thumbnail_size = EditorSettings::get_singleton()->get("filesystem/file_dialog/thumbnail_size");
-				thumbnail_size *= EDSCALE;
+				int thumbnail_size, small_thumbnail_size;
+				_get_thumbnail_sizes(thumbnail_size, small_thumbnail_size);
 
 				if (item.resource.is_valid()) {
 
-					_generate_preview(texture, small_texture, item, String());
+					Ref<ImageTexture> texture;
+					Ref<ImageTexture> small_texture;
+
+					_generate_preview(texture, small_texture, item, String(), thumbnail_size, small_thumbnail_size);
 
 					//adding hash to the end of path (should be ID:<objid>:<hash>) because of 5 argument limit to call_deferred
 					_preview_ready(item.path + ":" + itos(item.resource->hash_edited_version()), texture, small_texture, item.id, item.function, item.userdata);
 
 				} else {
 
-					String temp_path = EditorSettings::get_singleton()->get_cache_dir();
-					String cache_base = ProjectSettings::get_singleton()->globalize_path(item.path).md5_text();
-					cache_base = temp_path.plus_file("resthumb-" + cache_base);
-
-					//does not have it, try to load a cached thumbnail
-
-					String file = cache_base + ".txt";
-					FileAccess *f = FileAccess::open(file, FileAccess::READ);
-					if (!f) {
-
-						// No cache found, generate
-						_generate_preview(texture, small_texture, item, cache_base);
-					} else {
-
-						uint64_t modtime = FileAccess::get_modified_time(item.path);
-						int tsize = f->get_line().to_int64();
-						bool has_small_texture = f->get_line().to_int();
-						uint64_t last_modtime = f->get_line().to_int64();
-
-						bool cache_valid = true;
-
-						if (tsize != thumbnail_size) {
-
-							cache_valid = false;
-							memdelete(f);
-						} else if (last_modtime != modtime) {
-
-							String last_md5 = f->get_line();
-							String md5 = FileAccess::get_md5(item.path);
-							memdelete(f);
-
-							if (last_md5 != md5) {
-
-								cache_valid = false;
-
-							} else {
-								//update modified time
-
-								f = FileAccess::open(file, FileAccess::WRITE);
-								if (!f) {
-									// Not returning as this would leave the thread hanging and would require
-									// some proper cleanup/disabling of resource preview generation.
-									ERR_PRINT("Cannot create file '" + file + "'. Check user write permissions.");
-								} else {
-									f->store_line(itos(thumbnail_size));
-									f->store_line(itos(has_small_texture));
-									f->store_line(itos(modtime));
-									f->store_line(md5);
-									memdelete(f);
-								}
-							}
-						} else {
-							memdelete(f);
-						}
-
-						if (cache_valid) {
-
-							Ref<Image> img;
-							img.instance();
-							Ref<Image> small_img;
-							small_img.instance();
-
-							if (img->load(cache_base + ".png") != OK) {
-								cache_valid = false;
-							} else {
-
-								texture.instance();
-								texture->create_from_image(img, Texture::FLAG_FILTER);
-
-								if (has_small_texture) {
-									if (small_img->load(cache_base + "_small.png") != OK) {
-										cache_valid = false;
-									} else {
-										small_texture.instance();
-										small_texture->create_from_image(small_img, Texture::FLAG_FILTER);
-									}
-								}
-							}
-						}
-
-						if (!cache_valid) {
-
-							_generate_preview(texture, small_texture, item, cache_base);
+					PathTask *task = memnew(PathTask);
+					task->preview = this;
+					task->item = item;
+					task->thumbnail_size = thumbnail_size;
+					task->small_thumbnail_size = small_thumbnail_size;
+					task->on_worker = use_pool;
+
+					if (use_pool) {
+						while (tasks.size() >= max_tasks) {
+							pool->wait_for_task_completion(tasks.front()->get());
+							tasks.pop_front();
 						}
+						tasks.push_back(pool->add_native_task(&EditorResourcePreview::_path_task_func, task));
+					} else {
+						_process_path_task(task);
 					}
-					_preview_ready(item.path, texture, small_texture, item.id, item.function, item.userdata);
 				}
 			}
 
@@ -348,6 +443,12 @@ void EditorResourcePreview::_thread() {
 			preview_mutex->unlock();
 		}
 	}
+
+	while (tasks.size()) {
+		pool->wait_for_task_completion(tasks.front()->get());
+		tasks.pop_front();
+	}
+
 	exited = true;
 }
 
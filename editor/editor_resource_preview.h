@@ -33,6 +33,7 @@
 
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/os/worker_thread_pool.h"
 #include "scene/main/node.h"
 #include "scene/resources/texture.h"
 
@@ -51,6 +52,8 @@ public:
 	virtual bool generate_small_preview_automatically() const;
 	virtual bool can_generate_small_preview() const;
 
+	virtual bool is_thread_safe() const;
+
 	EditorResourcePreviewGenerator();
 };
 
@@ -69,6 +72,17 @@ class EditorResourcePreview : public Node {
 	};
 
 	List<QueueItem> queue;
+	List<QueueItem> render_queue; //disk cache already checked, waiting for a generator that must run on the preview thread
+
+	struct PathTask {
+		EditorResourcePreview *preview;
+		QueueItem item;
+		int thumbnail_size;
+		int small_thumbnail_size;
+		bool on_worker;
+	};
+
+	List<WorkerThreadPool::TaskID> tasks;
 
 	Mutex *preview_mutex;
 	Semaphore *preview_sem;
@@ -89,7 +103,14 @@ class EditorResourcePreview : public Node {
 	Map<String, Item> cache;
 
 	void _preview_ready(const String &p_str, const Ref<Texture> &p_texture, const Ref<Texture> &p_small_texture, ObjectID id, const StringName &p_func, const Variant &p_ud);
-	void _generate_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const QueueItem &p_item, const String &cache_base);
+	void _generate_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const QueueItem &p_item, const String &cache_base, int p_thumbnail_size, int p_small_thumbnail_size);
+	bool _load_cached_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const String &p_path, const String &p_cache_base, int p_thumbnail_size);
+	Ref<EditorResourcePreviewGenerator> _get_generator(const String &p_type) const;
+	String _get_cache_base(const String &p_path) const;
+	void _get_thumbnail_sizes(int &r_size, int &r_small_size) const;
+
+	void _process_path_task(PathTask *p_task);
+	static void _path_task_func(void *p_userdata, uint32_t p_index);
 
 	static void _thread_func(void *ud);
 	void _thread();
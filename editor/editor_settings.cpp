@@ -343,6 +343,8 @@ void EditorSettings::_load_defaults(Ref<ConfigFile> p_extra_config) {
 	_initial_set("interface/editor/hide_console_window", false);
 	_initial_set("interface/editor/save_each_scene_on_quit", true); // Regression
 	_initial_set("interface/editor/quit_confirmation", true);
+	_initial_set("interface/editor/undo_history_max_memory_mb", 512);
+	hints["interface/editor/undo_history_max_memory_mb"] = PropertyInfo(Variant::INT, "interface/editor/undo_history_max_memory_mb", PROPERTY_HINT_RANGE, "0,16384,1,or_greater"); // 0 means no limit.
 
 	// Theme
 	_initial_set("interface/theme/preset", "Default");
@@ -402,6 +404,9 @@ void EditorSettings::_load_defaults(Ref<ConfigFile> p_extra_config) {
 #endif
 	_initial_set("filesystem/import/pvrtc_fast_conversion", false);
 
+	// Export
+	_initial_set("filesystem/export/use_pck_compression_cache", true);
+
 	/* Docks */
 
 	// SceneTree
@@ -32,6 +32,7 @@
 
 #include "core/os/dir_access.h"
 #include "core/os/os.h"
+#include "editor_file_index.h"
 #include "editor_node.h"
 #include "editor_scale.h"
 #include "scene/gui/box_container.h"
@@ -132,13 +133,25 @@ void FindInFiles::start() {
 
 	// Init search
 	_current_dir = "";
-	PoolStringArray init_folder;
-	init_folder.append(_root_dir);
 	_folders_stack.clear();
-	_folders_stack.push_back(init_folder);
-
+	_files_to_scan.clear();
 	_initial_files_count = 0;
 
+	Vector<String> candidates;
+	EditorFileIndex *index = EditorFileIndex::get_singleton();
+	if (index && index->find_candidates(_pattern, _root_dir, _extension_filter, candidates)) {
+		// The index already ruled out the files that can't match, no need to walk folders.
+		// Files are scanned from the back, so keep them in reverse to report results in order.
+		for (int i = candidates.size() - 1; i >= 0; i--) {
+			_files_to_scan.push_back(candidates[i]);
+		}
+		_initial_files_count = _files_to_scan.size();
+	} else {
+		PoolStringArray init_folder;
+		init_folder.append(_root_dir);
+		_folders_stack.push_back(init_folder);
+	}
+
 	_searching = true;
 	set_process(true);
 }
@@ -35,6 +35,7 @@
 #include "core/math/math_defs.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 #include "modules/regex/regex.h"
 #include "scene/3d/bone_attachment.h"
 #include "scene/3d/camera.h"
@@ -52,6 +53,36 @@ void EditorSceneImporterGLTF::get_extensions(List<String> *r_extensions) const {
 	r_extensions->push_back("glb");
 }
 
+EditorSceneImporterGLTF::GLTFState::~GLTFState() {
+
+	for (int i = 0; i < nodes.size(); i++) {
+		memdelete(nodes[i]);
+	}
+	for (int i = 0; i < mapped_files.size(); i++) {
+		memdelete(mapped_files[i]);
+	}
+}
+
+bool EditorSceneImporterGLTF::_map_buffer(GLTFState &state, const String &p_path, uint64_t p_offset, uint64_t p_size, GLTFBuffer &r_buffer) {
+
+	//large buffers are used in place instead of being read into memory, when the platform allows it
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	const uint8_t *data = f->map_read_only();
+	if (!data || p_offset + p_size > f->get_len()) {
+		memdelete(f);
+		return false;
+	}
+
+	state.mapped_files.push_back(f);
+	r_buffer.mapped = data + p_offset;
+	r_buffer.mapped_size = p_size;
+	return true;
+}
+
 Error EditorSceneImporterGLTF::_parse_json(const String &p_path, GLTFState &state) {
 
 	Error err;
@@ -126,8 +157,12 @@ Error EditorSceneImporterGLTF::_parse_glb(const String &p_path, GLTFState &state
 
 	ERR_FAIL_COND_V(chunk_type != 0x004E4942, ERR_PARSE_ERROR); //BIN
 
-	state.glb_data.resize(chunk_length);
-	len = f->get_buffer(state.glb_data.ptrw(), chunk_length);
+	if (_map_buffer(state, p_path, f->get_position(), chunk_length, state.glb_data)) {
+		return OK;
+	}
+
+	state.glb_data.data.resize(chunk_length);
+	len = f->get_buffer(state.glb_data.data.ptrw(), chunk_length);
 	ERR_FAIL_COND_V(len != chunk_length, ERR_FILE_CORRUPT);
 
 	return OK;
@@ -380,21 +415,26 @@ Error EditorSceneImporterGLTF::_parse_buffers(GLTFState &state, const String &p_
 			const Dictionary &buffer = buffers[i];
 			if (buffer.has("uri")) {
 
-				Vector<uint8_t> buffer_data;
+				GLTFBuffer buffer_data;
 				String uri = buffer["uri"];
 
 				if (uri.findn("data:application/octet-stream;base64") == 0) {
 					//embedded data
-					buffer_data = _parse_base64_uri(uri);
+					buffer_data.data = _parse_base64_uri(uri);
 				} else {
 
 					uri = p_base_path.plus_file(uri).replace("\\", "/"); //fix for windows
-					buffer_data = FileAccess::get_file_as_array(uri);
-					ERR_FAIL_COND_V(buffer.size() == 0, ERR_PARSE_ERROR);
+					FileAccessRef f = FileAccess::open(uri, FileAccess::READ);
+					ERR_FAIL_COND_V_MSG(!f, ERR_FILE_CANT_OPEN, "Can't open glTF buffer: '" + uri + "'.");
+					if (!_map_buffer(state, uri, 0, f->get_len(), buffer_data)) {
+						buffer_data.data.resize(f->get_len());
+						f->get_buffer(buffer_data.data.ptrw(), buffer_data.data.size());
+					}
+					ERR_FAIL_COND_V(buffer_data.size() == 0, ERR_PARSE_ERROR);
 				}
 
 				ERR_FAIL_COND_V(!buffer.has("byteLength"), ERR_PARSE_ERROR);
-				int byteLength = buffer["byteLength"];
+				uint64_t byteLength = (int64_t)buffer["byteLength"];
 				ERR_FAIL_COND_V(byteLength < buffer_data.size(), ERR_PARSE_ERROR);
 				state.buffers.push_back(buffer_data);
 			}
@@ -563,7 +603,8 @@ String EditorSceneImporterGLTF::_get_type_name(const GLTFType p_component) {
 	return names[p_component];
 }
 
-Error EditorSceneImporterGLTF::_decode_buffer_view(GLTFState &state, double *dst, const GLTFBufferViewIndex p_buffer_view, const int skip_every, const int skip_bytes, const int element_size, const int count, const GLTFType type, const int component_count, const int component_type, const int component_size, const bool normalized, const int byte_offset, const bool for_vertex) {
+template <class T>
+Error EditorSceneImporterGLTF::_decode_buffer_view(const GLTFState &state, T *dst, const GLTFBufferViewIndex p_buffer_view, const int skip_every, const int skip_bytes, const int element_size, const int count, const GLTFType type, const int component_count, const int component_type, const int component_size, const bool normalized, const int byte_offset, const bool for_vertex) {
 
 	const GLTFBufferView &bv = state.buffer_views[p_buffer_view];
 
@@ -575,7 +616,7 @@ Error EditorSceneImporterGLTF::_decode_buffer_view(GLTFState &state, double *dst
 	ERR_FAIL_INDEX_V(bv.buffer, state.buffers.size(), ERR_PARSE_ERROR);
 
 	const uint32_t offset = bv.byte_offset + byte_offset;
-	Vector<uint8_t> buffer = state.buffers[bv.buffer]; //copy on write, so no performance hit
+	const GLTFBuffer &buffer = state.buffers[bv.buffer];
 	const uint8_t *bufptr = buffer.ptr();
 
 	//use to debug
@@ -585,9 +626,9 @@ Error EditorSceneImporterGLTF::_decode_buffer_view(GLTFState &state, double *dst
 	const int buffer_end = (stride * (count - 1)) + element_size;
 	ERR_FAIL_COND_V(buffer_end > bv.byte_length, ERR_PARSE_ERROR);
 
-	ERR_FAIL_COND_V((int)(offset + buffer_end) > buffer.size(), ERR_PARSE_ERROR);
+	ERR_FAIL_COND_V((uint64_t)(offset + buffer_end) > buffer.size(), ERR_PARSE_ERROR);
 
-	//fill everything as doubles
+	//decode straight into the destination type, the component type is the same for the whole view
 
 	for (int i = 0; i < count; i++) {
 
@@ -599,51 +640,32 @@ Error EditorSceneImporterGLTF::_decode_buffer_view(GLTFState &state, double *dst
 				src += skip_bytes;
 			}
 
-			double d = 0;
-
 			switch (component_type) {
 				case COMPONENT_TYPE_BYTE: {
 					int8_t b = int8_t(*src);
-					if (normalized) {
-						d = (double(b) / 128.0);
-					} else {
-						d = double(b);
-					}
+					*dst = normalized ? T(b / 128.0f) : T(b);
 				} break;
 				case COMPONENT_TYPE_UNSIGNED_BYTE: {
 					uint8_t b = *src;
-					if (normalized) {
-						d = (double(b) / 255.0);
-					} else {
-						d = double(b);
-					}
+					*dst = normalized ? T(b / 255.0f) : T(b);
 				} break;
 				case COMPONENT_TYPE_SHORT: {
 					int16_t s = *(int16_t *)src;
-					if (normalized) {
-						d = (double(s) / 32768.0);
-					} else {
-						d = double(s);
-					}
+					*dst = normalized ? T(s / 32768.0f) : T(s);
 				} break;
 				case COMPONENT_TYPE_UNSIGNED_SHORT: {
 					uint16_t s = *(uint16_t *)src;
-					if (normalized) {
-						d = (double(s) / 65535.0);
-					} else {
-						d = double(s);
-					}
-
+					*dst = normalized ? T(s / 65535.0f) : T(s);
 				} break;
 				case COMPONENT_TYPE_INT: {
-					d = *(int *)src;
+					*dst = T(*(int *)src);
 				} break;
 				case COMPONENT_TYPE_FLOAT: {
-					d = *(float *)src;
+					*dst = T(*(float *)src);
 				} break;
 			}
 
-			*dst++ = d;
+			dst++;
 			src += component_size;
 		}
 	}
@@ -667,12 +689,25 @@ int EditorSceneImporterGLTF::_get_component_type_size(const int component_type)
 	return 0;
 }
 
-Vector<double> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+int EditorSceneImporterGLTF::_get_accessor_component_count(const GLTFState &state, const GLTFAccessorIndex p_accessor) {
+
+	ERR_FAIL_INDEX_V(p_accessor, state.accessors.size(), 0);
+
+	const int component_count_for_type[7] = {
+		1, 2, 3, 4, 4, 9, 16
+	};
+
+	const GLTFAccessor &a = state.accessors[p_accessor];
+	return component_count_for_type[a.type] * a.count;
+}
+
+template <class T>
+Error EditorSceneImporterGLTF::_decode_accessor(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex, T *dst) {
 
 	//spec, for reference:
 	//https://github.com/KhronosGroup/glTF/tree/master/specification/2.0#data-alignment
 
-	ERR_FAIL_INDEX_V(p_accessor, state.accessors.size(), Vector<double>());
+	ERR_FAIL_INDEX_V(p_accessor, state.accessors.size(), ERR_INVALID_PARAMETER);
 
 	const GLTFAccessor &a = state.accessors[p_accessor];
 
@@ -682,7 +717,7 @@ Vector<double> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, const
 
 	const int component_count = component_count_for_type[a.type];
 	const int component_size = _get_component_type_size(a.component_type);
-	ERR_FAIL_COND_V(component_size == 0, Vector<double>());
+	ERR_FAIL_COND_V(component_size == 0, ERR_PARSE_ERROR);
 	int element_size = component_count * component_size;
 
 	int skip_every = 0;
@@ -716,43 +751,40 @@ Vector<double> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, const
 		}
 	}
 
-	Vector<double> dst_buffer;
-	dst_buffer.resize(component_count * a.count);
-	double *dst = dst_buffer.ptrw();
-
 	if (a.buffer_view >= 0) {
 
-		ERR_FAIL_INDEX_V(a.buffer_view, state.buffer_views.size(), Vector<double>());
+		ERR_FAIL_INDEX_V(a.buffer_view, state.buffer_views.size(), ERR_PARSE_ERROR);
 
 		const Error err = _decode_buffer_view(state, dst, a.buffer_view, skip_every, skip_bytes, element_size, a.count, a.type, component_count, a.component_type, component_size, a.normalized, a.byte_offset, p_for_vertex);
 		if (err != OK)
-			return Vector<double>();
+			return err;
 
 	} else {
 		//fill with zeros, as bufferview is not defined.
 		for (int i = 0; i < (a.count * component_count); i++) {
-			dst_buffer.write[i] = 0;
+			dst[i] = T(0);
 		}
 	}
 
 	if (a.sparse_count > 0) {
 		// I could not find any file using this, so this code is so far untested
-		Vector<double> indices;
+		Vector<int> indices;
 		indices.resize(a.sparse_count);
 		const int indices_component_size = _get_component_type_size(a.sparse_indices_component_type);
 
 		Error err = _decode_buffer_view(state, indices.ptrw(), a.sparse_indices_buffer_view, 0, 0, indices_component_size, a.sparse_count, TYPE_SCALAR, 1, a.sparse_indices_component_type, indices_component_size, false, a.sparse_indices_byte_offset, false);
 		if (err != OK)
-			return Vector<double>();
+			return err;
 
-		Vector<double> data;
+		Vector<T> data;
 		data.resize(component_count * a.sparse_count);
 		err = _decode_buffer_view(state, data.ptrw(), a.sparse_values_buffer_view, skip_every, skip_bytes, element_size, a.sparse_count, a.type, component_count, a.component_type, component_size, a.normalized, a.sparse_values_byte_offset, p_for_vertex);
 		if (err != OK)
-			return Vector<double>();
+			return err;
 
 		for (int i = 0; i < indices.size(); i++) {
-			const int write_offset = int(indices[i]) * component_count;
+			ERR_FAIL_INDEX_V(indices[i], a.count, ERR_PARSE_ERROR);
+			const int write_offset = indices[i] * component_count;
 
 			for (int j = 0; j < component_count; j++) {
 				dst[write_offset + j] = data[i * component_count + j];
@@ -760,97 +792,95 @@ Vector<double> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, const
 		}
 	}
 
-	return dst_buffer;
+	return OK;
 }
 
-PoolVector<int> EditorSceneImporterGLTF::_decode_accessor_as_ints(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+PoolVector<int> EditorSceneImporterGLTF::_decode_accessor_as_ints(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	PoolVector<int> ret;
 
-	if (attribs.size() == 0)
+	const int ret_size = _get_accessor_component_count(state, p_accessor);
+	if (ret_size == 0)
 		return ret;
 
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size();
 	ret.resize(ret_size);
+	Error err;
 	{
 		PoolVector<int>::Write w = ret.write();
-		for (int i = 0; i < ret_size; i++) {
-			w[i] = int(attribs_ptr[i]);
-		}
+		err = _decode_accessor(state, p_accessor, p_for_vertex, w.ptr());
 	}
+	if (err != OK)
+		return PoolVector<int>();
 	return ret;
 }
 
-PoolVector<float> EditorSceneImporterGLTF::_decode_accessor_as_floats(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+PoolVector<float> EditorSceneImporterGLTF::_decode_accessor_as_floats(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	PoolVector<float> ret;
 
-	if (attribs.size() == 0)
+	const int ret_size = _get_accessor_component_count(state, p_accessor);
+	if (ret_size == 0)
 		return ret;
 
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size();
 	ret.resize(ret_size);
+	Error err;
 	{
 		PoolVector<float>::Write w = ret.write();
-		for (int i = 0; i < ret_size; i++) {
-			w[i] = float(attribs_ptr[i]);
-		}
+		err = _decode_accessor(state, p_accessor, p_for_vertex, w.ptr());
 	}
+	if (err != OK)
+		return PoolVector<float>();
 	return ret;
 }
 
-PoolVector<Vector2> EditorSceneImporterGLTF::_decode_accessor_as_vec2(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+PoolVector<Vector2> EditorSceneImporterGLTF::_decode_accessor_as_vec2(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	PoolVector<Vector2> ret;
 
-	if (attribs.size() == 0)
+	const int size = _get_accessor_component_count(state, p_accessor);
+	if (size == 0)
 		return ret;
 
-	ERR_FAIL_COND_V(attribs.size() % 2 != 0, ret);
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size() / 2;
-	ret.resize(ret_size);
+	ERR_FAIL_COND_V(size % 2 != 0, ret);
+	ret.resize(size / 2);
+	Error err;
 	{
+		//Vector2 is laid out as two consecutive real_t
 		PoolVector<Vector2>::Write w = ret.write();
-		for (int i = 0; i < ret_size; i++) {
-			w[i] = Vector2(attribs_ptr[i * 2 + 0], attribs_ptr[i * 2 + 1]);
-		}
+		err = _decode_accessor(state, p_accessor, p_for_vertex, (real_t *)w.ptr());
 	}
+	if (err != OK)
+		return PoolVector<Vector2>();
 	return ret;
 }
 
-PoolVector<Vector3> EditorSceneImporterGLTF::_decode_accessor_as_vec3(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+PoolVector<Vector3> EditorSceneImporterGLTF::_decode_accessor_as_vec3(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	PoolVector<Vector3> ret;
 
-	if (attribs.size() == 0)
+	const int size = _get_accessor_component_count(state, p_accessor);
+	if (size == 0)
 		return ret;
 
-	ERR_FAIL_COND_V(attribs.size() % 3 != 0, ret);
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size() / 3;
-	ret.resize(ret_size);
+	ERR_FAIL_COND_V(size % 3 != 0, ret);
+	ret.resize(size / 3);
+	Error err;
 	{
+		//Vector3 is laid out as three consecutive real_t
 		PoolVector<Vector3>::Write w = ret.write();
-		for (int i = 0; i < ret_size; i++) {
-			w[i] = Vector3(attribs_ptr[i * 3 + 0], attribs_ptr[i * 3 + 1], attribs_ptr[i * 3 + 2]);
-		}
+		err = _decode_accessor(state, p_accessor, p_for_vertex, (real_t *)w.ptr());
 	}
+	if (err != OK)
+		return PoolVector<Vector3>();
 	return ret;
 }
 
-PoolVector<Color> EditorSceneImporterGLTF::_decode_accessor_as_color(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+PoolVector<Color> EditorSceneImporterGLTF::_decode_accessor_as_color(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	PoolVector<Color> ret;
 
-	if (attribs.size() == 0)
+	const int size = _get_accessor_component_count(state, p_accessor);
+	if (size == 0)
 		return ret;
 
 	const int type = state.accessors[p_accessor].type;
@@ -860,48 +890,70 @@ PoolVector<Color> EditorSceneImporterGLTF::_decode_accessor_as_color(GLTFState &
 		vec_len = 4;
 	}
 
-	ERR_FAIL_COND_V(attribs.size() % vec_len != 0, ret);
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size() / vec_len;
+	ERR_FAIL_COND_V(size % vec_len != 0, ret);
+	const int ret_size = size / vec_len;
 	ret.resize(ret_size);
-	{
-		PoolVector<Color>::Write w = ret.write();
+
+	PoolVector<Color>::Write w = ret.write();
+	if (vec_len == 4) {
+		//Color is laid out as four consecutive floats
+		if (_decode_accessor(state, p_accessor, p_for_vertex, (float *)w.ptr()) != OK) {
+			w.release();
+			return PoolVector<Color>();
+		}
+	} else {
+		Vector<float> attribs;
+		attribs.resize(size);
+		if (_decode_accessor(state, p_accessor, p_for_vertex, attribs.ptrw()) != OK) {
+			w.release();
+			return PoolVector<Color>();
+		}
+		const float *attribs_ptr = attribs.ptr();
 		for (int i = 0; i < ret_size; i++) {
-			w[i] = Color(attribs_ptr[i * vec_len + 0], attribs_ptr[i * vec_len + 1], attribs_ptr[i * vec_len + 2], vec_len == 4 ? attribs_ptr[i * 4 + 3] : 1.0);
+			w[i] = Color(attribs_ptr[i * 3 + 0], attribs_ptr[i * 3 + 1], attribs_ptr[i * 3 + 2], 1.0);
 		}
 	}
+	w.release();
 	return ret;
 }
 
-Vector<Quat> EditorSceneImporterGLTF::_decode_accessor_as_quat(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+Vector<Quat> EditorSceneImporterGLTF::_decode_accessor_as_quat(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	Vector<Quat> ret;
 
-	if (attribs.size() == 0)
+	const int size = _get_accessor_component_count(state, p_accessor);
+	if (size == 0)
 		return ret;
 
-	ERR_FAIL_COND_V(attribs.size() % 4 != 0, ret);
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size() / 4;
+	ERR_FAIL_COND_V(size % 4 != 0, ret);
+	const int ret_size = size / 4;
 	ret.resize(ret_size);
-	{
-		for (int i = 0; i < ret_size; i++) {
-			ret.write[i] = Quat(attribs_ptr[i * 4 + 0], attribs_ptr[i * 4 + 1], attribs_ptr[i * 4 + 2], attribs_ptr[i * 4 + 3]).normalized();
-		}
+	//Quat is laid out as four consecutive real_t
+	Quat *w = ret.ptrw();
+	if (_decode_accessor(state, p_accessor, p_for_vertex, (real_t *)w) != OK)
+		return Vector<Quat>();
+
+	for (int i = 0; i < ret_size; i++) {
+		w[i] = w[i].normalized();
 	}
 	return ret;
 }
-Vector<Transform2D> EditorSceneImporterGLTF::_decode_accessor_as_xform2d(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
+Vector<Transform2D> EditorSceneImporterGLTF::_decode_accessor_as_xform2d(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+
 	Vector<Transform2D> ret;
 
-	if (attribs.size() == 0)
+	const int size = _get_accessor_component_count(state, p_accessor);
+	if (size == 0)
+		return ret;
+
+	ERR_FAIL_COND_V(size % 4 != 0, ret);
+	Vector<real_t> attribs;
+	attribs.resize(size);
+	if (_decode_accessor(state, p_accessor, p_for_vertex, attribs.ptrw()) != OK)
 		return ret;
 
-	ERR_FAIL_COND_V(attribs.size() % 4 != 0, ret);
-	ret.resize(attribs.size() / 4);
+	ret.resize(size / 4);
 	for (int i = 0; i < ret.size(); i++) {
 		ret.write[i][0] = Vector2(attribs[i * 4 + 0], attribs[i * 4 + 1]);
 		ret.write[i][1] = Vector2(attribs[i * 4 + 2], attribs[i * 4 + 3]);
@@ -909,16 +961,21 @@ Vector<Transform2D> EditorSceneImporterGLTF::_decode_accessor_as_xform2d(GLTFSta
 	return ret;
 }
 
-Vector<Basis> EditorSceneImporterGLTF::_decode_accessor_as_basis(GLTFState &state, const GLTFAccessorIndex p_accessor, bool p_for_vertex) {
+Vector<Basis> EditorSceneImporterGLTF::_decode_accessor_as_basis(const GLTFState &state, const GLTFAccessorIndex p_accessor, bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	Vector<Basis> ret;
 
-	if (attribs.size() == 0)
+	const int size = _get_accessor_component_count(state, p_accessor);
+	if (size == 0)
 		return ret;
 
-	ERR_FAIL_COND_V(attribs.size() % 9 != 0, ret);
-	ret.resize(attribs.size() / 9);
+	ERR_FAIL_COND_V(size % 9 != 0, ret);
+	Vector<real_t> attribs;
+	attribs.resize(size);
+	if (_decode_accessor(state, p_accessor, p_for_vertex, attribs.ptrw()) != OK)
+		return ret;
+
+	ret.resize(size / 9);
 	for (int i = 0; i < ret.size(); i++) {
 		ret.write[i].set_axis(0, Vector3(attribs[i * 9 + 0], attribs[i * 9 + 1], attribs[i * 9 + 2]));
 		ret.write[i].set_axis(1, Vector3(attribs[i * 9 + 3], attribs[i * 9 + 4], attribs[i * 9 + 5]));
@@ -927,16 +984,21 @@ Vector<Basis> EditorSceneImporterGLTF::_decode_accessor_as_basis(GLTFState &stat
 	return ret;
 }
 
-Vector<Transform> EditorSceneImporterGLTF::_decode_accessor_as_xform(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+Vector<Transform> EditorSceneImporterGLTF::_decode_accessor_as_xform(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	Vector<Transform> ret;
 
-	if (attribs.size() == 0)
+	const int size = _get_accessor_component_count(state, p_accessor);
+	if (size == 0)
+		return ret;
+
+	ERR_FAIL_COND_V(size % 16 != 0, ret);
+	Vector<real_t> attribs;
+	attribs.resize(size);
+	if (_decode_accessor(state, p_accessor, p_for_vertex, attribs.ptrw()) != OK)
 		return ret;
 
-	ERR_FAIL_COND_V(attribs.size() % 16 != 0, ret);
-	ret.resize(attribs.size() / 16);
+	ret.resize(size / 16);
 	for (int i = 0; i < ret.size(); i++) {
 		ret.write[i].basis.set_axis(0, Vector3(attribs[i * 16 + 0], attribs[i * 16 + 1], attribs[i * 16 + 2]));
 		ret.write[i].basis.set_axis(1, Vector3(attribs[i * 16 + 4], attribs[i * 16 + 5], attribs[i * 16 + 6]));
@@ -946,283 +1008,339 @@ Vector<Transform> EditorSceneImporterGLTF::_decode_accessor_as_xform(GLTFState &
 	return ret;
 }
 
-Error EditorSceneImporterGLTF::_parse_meshes(GLTFState &state) {
-
-	if (!state.json.has("meshes"))
-		return OK;
-
-	Array meshes = state.json["meshes"];
-	for (GLTFMeshIndex i = 0; i < meshes.size(); i++) {
+Error EditorSceneImporterGLTF::_decode_mesh(const GLTFState &state, const Dictionary &d, GLTFMeshData &r_data) {
 
-		print_verbose("glTF: Parsing mesh: " + itos(i));
-		Dictionary d = meshes[i];
+	ERR_FAIL_COND_V(!d.has("primitives"), ERR_PARSE_ERROR);
 
-		GLTFMesh mesh;
-		mesh.mesh.instance();
-
-		ERR_FAIL_COND_V(!d.has("primitives"), ERR_PARSE_ERROR);
+	Array primitives = d["primitives"];
+	const Dictionary &extras = d.has("extras") ? (Dictionary)d["extras"] : Dictionary();
 
-		Array primitives = d["primitives"];
-		const Dictionary &extras = d.has("extras") ? (Dictionary)d["extras"] : Dictionary();
+	for (int j = 0; j < primitives.size(); j++) {
 
-		for (int j = 0; j < primitives.size(); j++) {
+		Dictionary p = primitives[j];
 
-			Dictionary p = primitives[j];
+		Array array;
+		array.resize(Mesh::ARRAY_MAX);
 
-			Array array;
-			array.resize(Mesh::ARRAY_MAX);
+		ERR_FAIL_COND_V(!p.has("attributes"), ERR_PARSE_ERROR);
 
-			ERR_FAIL_COND_V(!p.has("attributes"), ERR_PARSE_ERROR);
+		Dictionary a = p["attributes"];
 
-			Dictionary a = p["attributes"];
+		Mesh::PrimitiveType primitive = Mesh::PRIMITIVE_TRIANGLES;
+		if (p.has("mode")) {
+			const int mode = p["mode"];
+			ERR_FAIL_INDEX_V(mode, 7, ERR_FILE_CORRUPT);
+			static const Mesh::PrimitiveType primitives2[7] = {
+				Mesh::PRIMITIVE_POINTS,
+				Mesh::PRIMITIVE_LINES,
+				Mesh::PRIMITIVE_LINE_LOOP,
+				Mesh::PRIMITIVE_LINE_STRIP,
+				Mesh::PRIMITIVE_TRIANGLES,
+				Mesh::PRIMITIVE_TRIANGLE_STRIP,
+				Mesh::PRIMITIVE_TRIANGLE_FAN,
+			};
 
-			Mesh::PrimitiveType primitive = Mesh::PRIMITIVE_TRIANGLES;
-			if (p.has("mode")) {
-				const int mode = p["mode"];
-				ERR_FAIL_INDEX_V(mode, 7, ERR_FILE_CORRUPT);
-				static const Mesh::PrimitiveType primitives2[7] = {
-					Mesh::PRIMITIVE_POINTS,
-					Mesh::PRIMITIVE_LINES,
-					Mesh::PRIMITIVE_LINE_LOOP,
-					Mesh::PRIMITIVE_LINE_STRIP,
-					Mesh::PRIMITIVE_TRIANGLES,
-					Mesh::PRIMITIVE_TRIANGLE_STRIP,
-					Mesh::PRIMITIVE_TRIANGLE_FAN,
-				};
+			primitive = primitives2[mode];
+		}
 
-				primitive = primitives2[mode];
-			}
+		ERR_FAIL_COND_V(!a.has("POSITION"), ERR_PARSE_ERROR);
+		if (a.has("POSITION")) {
+			array[Mesh::ARRAY_VERTEX] = _decode_accessor_as_vec3(state, a["POSITION"], true);
+		}
+		if (a.has("NORMAL")) {
+			array[Mesh::ARRAY_NORMAL] = _decode_accessor_as_vec3(state, a["NORMAL"], true);
+		}
+		if (a.has("TANGENT")) {
+			array[Mesh::ARRAY_TANGENT] = _decode_accessor_as_floats(state, a["TANGENT"], true);
+		}
+		if (a.has("TEXCOORD_0")) {
+			array[Mesh::ARRAY_TEX_UV] = _decode_accessor_as_vec2(state, a["TEXCOORD_0"], true);
+		}
+		if (a.has("TEXCOORD_1")) {
+			array[Mesh::ARRAY_TEX_UV2] = _decode_accessor_as_vec2(state, a["TEXCOORD_1"], true);
+		}
+		if (a.has("COLOR_0")) {
+			array[Mesh::ARRAY_COLOR] = _decode_accessor_as_color(state, a["COLOR_0"], true);
+		}
+		if (a.has("JOINTS_0")) {
+			array[Mesh::ARRAY_BONES] = _decode_accessor_as_ints(state, a["JOINTS_0"], true);
+		}
+		if (a.has("WEIGHTS_0")) {
+			PoolVector<float> weights = _decode_accessor_as_floats(state, a["WEIGHTS_0"], true);
+			{ //gltf does not seem to normalize the weights for some reason..
+				int wc = weights.size();
+				PoolVector<float>::Write w = weights.write();
 
-			ERR_FAIL_COND_V(!a.has("POSITION"), ERR_PARSE_ERROR);
-			if (a.has("POSITION")) {
-				array[Mesh::ARRAY_VERTEX] = _decode_accessor_as_vec3(state, a["POSITION"], true);
-			}
-			if (a.has("NORMAL")) {
-				array[Mesh::ARRAY_NORMAL] = _decode_accessor_as_vec3(state, a["NORMAL"], true);
-			}
-			if (a.has("TANGENT")) {
-				array[Mesh::ARRAY_TANGENT] = _decode_accessor_as_floats(state, a["TANGENT"], true);
-			}
-			if (a.has("TEXCOORD_0")) {
-				array[Mesh::ARRAY_TEX_UV] = _decode_accessor_as_vec2(state, a["TEXCOORD_0"], true);
-			}
-			if (a.has("TEXCOORD_1")) {
-				array[Mesh::ARRAY_TEX_UV2] = _decode_accessor_as_vec2(state, a["TEXCOORD_1"], true);
-			}
-			if (a.has("COLOR_0")) {
-				array[Mesh::ARRAY_COLOR] = _decode_accessor_as_color(state, a["COLOR_0"], true);
-			}
-			if (a.has("JOINTS_0")) {
-				array[Mesh::ARRAY_BONES] = _decode_accessor_as_ints(state, a["JOINTS_0"], true);
-			}
-			if (a.has("WEIGHTS_0")) {
-				PoolVector<float> weights = _decode_accessor_as_floats(state, a["WEIGHTS_0"], true);
-				{ //gltf does not seem to normalize the weights for some reason..
-					int wc = weights.size();
-					PoolVector<float>::Write w = weights.write();
-
-					for (int k = 0; k < wc; k += 4) {
-						float total = 0.0;
-						total += w[k + 0];
-						total += w[k + 1];
-						total += w[k + 2];
-						total += w[k + 3];
-						if (total > 0.0) {
-							w[k + 0] /= total;
-							w[k + 1] /= total;
-							w[k + 2] /= total;
-							w[k + 3] /= total;
-						}
+				for (int k = 0; k < wc; k += 4) {
+					float total = 0.0;
+					total += w[k + 0];
+					total += w[k + 1];
+					total += w[k + 2];
+					total += w[k + 3];
+					if (total > 0.0) {
+						w[k + 0] /= total;
+						w[k + 1] /= total;
+						w[k + 2] /= total;
+						w[k + 3] /= total;
 					}
 				}
-				array[Mesh::ARRAY_WEIGHTS] = weights;
 			}
+			array[Mesh::ARRAY_WEIGHTS] = weights;
+		}
 
-			if (p.has("indices")) {
-				PoolVector<int> indices = _decode_accessor_as_ints(state, p["indices"], false);
+		if (p.has("indices")) {
+			PoolVector<int> indices = _decode_accessor_as_ints(state, p["indices"], false);
 
-				if (primitive == Mesh::PRIMITIVE_TRIANGLES) {
-					//swap around indices, convert ccw to cw for front face
+			if (primitive == Mesh::PRIMITIVE_TRIANGLES) {
+				//swap around indices, convert ccw to cw for front face
 
-					const int is = indices.size();
-					const PoolVector<int>::Write w = indices.write();
-					for (int k = 0; k < is; k += 3) {
-						SWAP(w[k + 1], w[k + 2]);
-					}
+				const int is = indices.size();
+				const PoolVector<int>::Write w = indices.write();
+				for (int k = 0; k < is; k += 3) {
+					SWAP(w[k + 1], w[k + 2]);
 				}
-				array[Mesh::ARRAY_INDEX] = indices;
-
-			} else if (primitive == Mesh::PRIMITIVE_TRIANGLES) {
-				//generate indices because they need to be swapped for CW/CCW
-				const PoolVector<Vector3> &vertices = array[Mesh::ARRAY_VERTEX];
-				ERR_FAIL_COND_V(vertices.size() == 0, ERR_PARSE_ERROR);
-				PoolVector<int> indices;
-				const int vs = vertices.size();
-				indices.resize(vs);
-				{
-					const PoolVector<int>::Write w = indices.write();
-					for (int k = 0; k < vs; k += 3) {
-						w[k] = k;
-						w[k + 1] = k + 2;
-						w[k + 2] = k + 1;
-					}
+			}
+			array[Mesh::ARRAY_INDEX] = indices;
+
+		} else if (primitive == Mesh::PRIMITIVE_TRIANGLES) {
+			//generate indices because they need to be swapped for CW/CCW
+			const PoolVector<Vector3> &vertices = array[Mesh::ARRAY_VERTEX];
+			ERR_FAIL_COND_V(vertices.size() == 0, ERR_PARSE_ERROR);
+			PoolVector<int> indices;
+			const int vs = vertices.size();
+			indices.resize(vs);
+			{
+				const PoolVector<int>::Write w = indices.write();
+				for (int k = 0; k < vs; k += 3) {
+					w[k] = k;
+					w[k + 1] = k + 2;
+					w[k + 2] = k + 1;
 				}
-				array[Mesh::ARRAY_INDEX] = indices;
 			}
+			array[Mesh::ARRAY_INDEX] = indices;
+		}
 
-			bool generated_tangents = false;
-			Variant erased_indices;
-
-			if (primitive == Mesh::PRIMITIVE_TRIANGLES && !a.has("TANGENT") && a.has("TEXCOORD_0") && a.has("NORMAL")) {
-				//must generate mikktspace tangents.. ergh..
-				Ref<SurfaceTool> st;
-				st.instance();
-				st->create_from_triangle_arrays(array);
-				if (!p.has("targets")) {
-					//morph targets should not be reindexed, as array size might differ
-					//removing indices is the best bet here
-					st->deindex();
-					erased_indices = a[Mesh::ARRAY_INDEX];
-					a[Mesh::ARRAY_INDEX] = Variant();
-				}
-				st->generate_tangents();
-				array = st->commit_to_arrays();
-				generated_tangents = true;
+		bool generated_tangents = false;
+		Variant erased_indices;
+
+		if (primitive == Mesh::PRIMITIVE_TRIANGLES && !a.has("TANGENT") && a.has("TEXCOORD_0") && a.has("NORMAL")) {
+			//must generate mikktspace tangents.. ergh..
+			Ref<SurfaceTool> st;
+			st.instance();
+			st->create_from_triangle_arrays(array);
+			if (!p.has("targets")) {
+				//morph targets should not be reindexed, as array size might differ
+				//removing indices is the best bet here
+				st->deindex();
+				erased_indices = a[Mesh::ARRAY_INDEX];
+				a[Mesh::ARRAY_INDEX] = Variant();
 			}
+			st->generate_tangents();
+			array = st->commit_to_arrays();
+			generated_tangents = true;
+		}
 
-			Array morphs;
-			//blend shapes
-			if (p.has("targets")) {
-				print_verbose("glTF: Mesh has targets");
-				const Array &targets = p["targets"];
-
-				//ideally BLEND_SHAPE_MODE_RELATIVE since gltf2 stores in displacement
-				//but it could require a larger refactor?
-				mesh.mesh->set_blend_shape_mode(Mesh::BLEND_SHAPE_MODE_NORMALIZED);
-
-				if (j == 0) {
-					const Array &target_names = extras.has("targetNames") ? (Array)extras["targetNames"] : Array();
-					for (int k = 0; k < targets.size(); k++) {
-						const String name = k < target_names.size() ? (String)target_names[k] : String("morph_") + itos(k);
-						mesh.mesh->add_blend_shape(name);
-					}
-				}
+		Array morphs;
+		//blend shapes
+		if (p.has("targets")) {
+			print_verbose("glTF: Mesh has targets");
+			const Array &targets = p["targets"];
+
+			r_data.has_targets = true;
 
+			if (j == 0) {
+				const Array &target_names = extras.has("targetNames") ? (Array)extras["targetNames"] : Array();
 				for (int k = 0; k < targets.size(); k++) {
+					const String name = k < target_names.size() ? (String)target_names[k] : String("morph_") + itos(k);
+					r_data.blend_shape_names.push_back(name);
+				}
+			}
 
-					const Dictionary &t = targets[k];
+			for (int k = 0; k < targets.size(); k++) {
 
-					Array array_copy;
-					array_copy.resize(Mesh::ARRAY_MAX);
+				const Dictionary &t = targets[k];
 
-					for (int l = 0; l < Mesh::ARRAY_MAX; l++) {
-						array_copy[l] = array[l];
-					}
+				Array array_copy;
+				array_copy.resize(Mesh::ARRAY_MAX);
+
+				for (int l = 0; l < Mesh::ARRAY_MAX; l++) {
+					array_copy[l] = array[l];
+				}
 
-					array_copy[Mesh::ARRAY_INDEX] = Variant();
-
-					if (t.has("POSITION")) {
-						PoolVector<Vector3> varr = _decode_accessor_as_vec3(state, t["POSITION"], true);
-						const PoolVector<Vector3> src_varr = array[Mesh::ARRAY_VERTEX];
-						const int size = src_varr.size();
-						ERR_FAIL_COND_V(size == 0, ERR_PARSE_ERROR);
-						{
-
-							const int max_idx = varr.size();
-							varr.resize(size);
-
-							const PoolVector<Vector3>::Write w_varr = varr.write();
-							const PoolVector<Vector3>::Read r_varr = varr.read();
-							const PoolVector<Vector3>::Read r_src_varr = src_varr.read();
-							for (int l = 0; l < size; l++) {
-								if (l < max_idx) {
-									w_varr[l] = r_varr[l] + r_src_varr[l];
-								} else {
-									w_varr[l] = r_src_varr[l];
-								}
+				array_copy[Mesh::ARRAY_INDEX] = Variant();
+
+				if (t.has("POSITION")) {
+					PoolVector<Vector3> varr = _decode_accessor_as_vec3(state, t["POSITION"], true);
+					const PoolVector<Vector3> src_varr = array[Mesh::ARRAY_VERTEX];
+					const int size = src_varr.size();
+					ERR_FAIL_COND_V(size == 0, ERR_PARSE_ERROR);
+					{
+
+						const int max_idx = varr.size();
+						varr.resize(size);
+
+						const PoolVector<Vector3>::Write w_varr = varr.write();
+						const PoolVector<Vector3>::Read r_varr = varr.read();
+						const PoolVector<Vector3>::Read r_src_varr = src_varr.read();
+						for (int l = 0; l < size; l++) {
+							if (l < max_idx) {
+								w_varr[l] = r_varr[l] + r_src_varr[l];
+							} else {
+								w_varr[l] = r_src_varr[l];
 							}
 						}
-						array_copy[Mesh::ARRAY_VERTEX] = varr;
 					}
-					if (t.has("NORMAL")) {
-						PoolVector<Vector3> narr = _decode_accessor_as_vec3(state, t["NORMAL"], true);
-						const PoolVector<Vector3> src_narr = array[Mesh::ARRAY_NORMAL];
-						int size = src_narr.size();
-						ERR_FAIL_COND_V(size == 0, ERR_PARSE_ERROR);
-						{
-							int max_idx = narr.size();
-							narr.resize(size);
-
-							const PoolVector<Vector3>::Write w_narr = narr.write();
-							const PoolVector<Vector3>::Read r_narr = narr.read();
-							const PoolVector<Vector3>::Read r_src_narr = src_narr.read();
-							for (int l = 0; l < size; l++) {
-								if (l < max_idx) {
-									w_narr[l] = r_narr[l] + r_src_narr[l];
-								} else {
-									w_narr[l] = r_src_narr[l];
-								}
+					array_copy[Mesh::ARRAY_VERTEX] = varr;
+				}
+				if (t.has("NORMAL")) {
+					PoolVector<Vector3> narr = _decode_accessor_as_vec3(state, t["NORMAL"], true);
+					const PoolVector<Vector3> src_narr = array[Mesh::ARRAY_NORMAL];
+					int size = src_narr.size();
+					ERR_FAIL_COND_V(size == 0, ERR_PARSE_ERROR);
+					{
+						int max_idx = narr.size();
+						narr.resize(size);
+
+						const PoolVector<Vector3>::Write w_narr = narr.write();
+						const PoolVector<Vector3>::Read r_narr = narr.read();
+						const PoolVector<Vector3>::Read r_src_narr = src_narr.read();
+						for (int l = 0; l < size; l++) {
+							if (l < max_idx) {
+								w_narr[l] = r_narr[l] + r_src_narr[l];
+							} else {
+								w_narr[l] = r_src_narr[l];
 							}
 						}
-						array_copy[Mesh::ARRAY_NORMAL] = narr;
 					}
-					if (t.has("TANGENT")) {
-						const PoolVector<Vector3> tangents_v3 = _decode_accessor_as_vec3(state, t["TANGENT"], true);
-						const PoolVector<float> src_tangents = array[Mesh::ARRAY_TANGENT];
-						ERR_FAIL_COND_V(src_tangents.size() == 0, ERR_PARSE_ERROR);
+					array_copy[Mesh::ARRAY_NORMAL] = narr;
+				}
+				if (t.has("TANGENT")) {
+					const PoolVector<Vector3> tangents_v3 = _decode_accessor_as_vec3(state, t["TANGENT"], true);
+					const PoolVector<float> src_tangents = array[Mesh::ARRAY_TANGENT];
+					ERR_FAIL_COND_V(src_tangents.size() == 0, ERR_PARSE_ERROR);
 
-						PoolVector<float> tangents_v4;
+					PoolVector<float> tangents_v4;
 
-						{
+					{
 
-							int max_idx = tangents_v3.size();
+						int max_idx = tangents_v3.size();
 
-							int size4 = src_tangents.size();
-							tangents_v4.resize(size4);
-							const PoolVector<float>::Write w4 = tangents_v4.write();
+						int size4 = src_tangents.size();
+						tangents_v4.resize(size4);
+						const PoolVector<float>::Write w4 = tangents_v4.write();
 
-							const PoolVector<Vector3>::Read r3 = tangents_v3.read();
-							const PoolVector<float>::Read r4 = src_tangents.read();
+						const PoolVector<Vector3>::Read r3 = tangents_v3.read();
+						const PoolVector<float>::Read r4 = src_tangents.read();
 
-							for (int l = 0; l < size4 / 4; l++) {
+						for (int l = 0; l < size4 / 4; l++) {
 
-								if (l < max_idx) {
-									w4[l * 4 + 0] = r3[l].x + r4[l * 4 + 0];
-									w4[l * 4 + 1] = r3[l].y + r4[l * 4 + 1];
-									w4[l * 4 + 2] = r3[l].z + r4[l * 4 + 2];
-								} else {
-									w4[l * 4 + 0] = r4[l * 4 + 0];
-									w4[l * 4 + 1] = r4[l * 4 + 1];
-									w4[l * 4 + 2] = r4[l * 4 + 2];
-								}
-								w4[l * 4 + 3] = r4[l * 4 + 3]; //copy flip value
+							if (l < max_idx) {
+								w4[l * 4 + 0] = r3[l].x + r4[l * 4 + 0];
+								w4[l * 4 + 1] = r3[l].y + r4[l * 4 + 1];
+								w4[l * 4 + 2] = r3[l].z + r4[l * 4 + 2];
+							} else {
+								w4[l * 4 + 0] = r4[l * 4 + 0];
+								w4[l * 4 + 1] = r4[l * 4 + 1];
+								w4[l * 4 + 2] = r4[l * 4 + 2];
 							}
+							w4[l * 4 + 3] = r4[l * 4 + 3]; //copy flip value
 						}
-
-						array_copy[Mesh::ARRAY_TANGENT] = tangents_v4;
 					}
 
-					if (generated_tangents) {
-						Ref<SurfaceTool> st;
-						st.instance();
-						array_copy[Mesh::ARRAY_INDEX] = erased_indices; //needed for tangent generation, erased by deindex
-						st->create_from_triangle_arrays(array_copy);
-						st->deindex();
-						st->generate_tangents();
-						array_copy = st->commit_to_arrays();
-					}
+					array_copy[Mesh::ARRAY_TANGENT] = tangents_v4;
+				}
 
-					morphs.push_back(array_copy);
+				if (generated_tangents) {
+					Ref<SurfaceTool> st;
+					st.instance();
+					array_copy[Mesh::ARRAY_INDEX] = erased_indices; //needed for tangent generation, erased by deindex
+					st->create_from_triangle_arrays(array_copy);
+					st->deindex();
+					st->generate_tangents();
+					array_copy = st->commit_to_arrays();
 				}
+
+				morphs.push_back(array_copy);
 			}
+		}
+
+		GLTFSurfaceData surface;
+		surface.primitive = primitive;
+		surface.arrays = array;
+		surface.morphs = morphs;
+		surface.material = -1;
+
+		if (p.has("material")) {
+			const int material = p["material"];
+			ERR_FAIL_INDEX_V(material, state.materials.size(), ERR_FILE_CORRUPT);
+			surface.material = material;
+		}
+
+		r_data.surfaces.push_back(surface);
+	}
+
+	return OK;
+}
+
+void EditorSceneImporterGLTF::_decode_mesh_task(uint32_t p_index, GLTFMeshDecodeJob *p_job) {
+
+	print_verbose("glTF: Parsing mesh: " + itos(p_index));
+	const Dictionary &d = p_job->meshes[p_index];
+	GLTFMeshData &data = p_job->results[p_index];
+	data.err = _decode_mesh(*p_job->state, d, data);
+}
+
+Error EditorSceneImporterGLTF::_parse_meshes(GLTFState &state) {
+
+	if (!state.json.has("meshes"))
+		return OK;
+
+	//accessors are decoded and tangents generated for all meshes in parallel, the meshes are then built in order
+	GLTFMeshDecodeJob job;
+	job.state = &state;
+	job.meshes = state.json["meshes"];
+	job.data.resize(job.meshes.size());
+	job.results = job.data.ptrw();
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (job.meshes.size() > 1 && pool && pool->get_thread_count() > 0) {
+		pool->parallel_for(job.meshes.size(), this, &EditorSceneImporterGLTF::_decode_mesh_task, &job);
+	} else {
+		for (int i = 0; i < job.meshes.size(); i++) {
+			_decode_mesh_task(i, &job);
+		}
+	}
+
+	for (GLTFMeshIndex i = 0; i < job.meshes.size(); i++) {
+
+		const GLTFMeshData &data = job.data[i];
+		if (data.err != OK) {
+			return data.err;
+		}
+
+		Dictionary d = job.meshes[i];
+
+		GLTFMesh mesh;
+		mesh.mesh.instance();
+
+		if (data.has_targets) {
+			//ideally BLEND_SHAPE_MODE_RELATIVE since gltf2 stores in displacement
+			//but it could require a larger refactor?
+			mesh.mesh->set_blend_shape_mode(Mesh::BLEND_SHAPE_MODE_NORMALIZED);
+		}
+		for (int j = 0; j < data.blend_shape_names.size(); j++) {
+			mesh.mesh->add_blend_shape(data.blend_shape_names[j]);
+		}
+
+		for (int j = 0; j < data.surfaces.size(); j++) {
+
+			const GLTFSurfaceData &surface = data.surfaces[j];
 
 			//just add it
-			mesh.mesh->add_surface_from_arrays(primitive, array, morphs);
+			mesh.mesh->add_surface_from_arrays(surface.primitive, surface.arrays, surface.morphs);
 
-			if (p.has("material")) {
-				const int material = p["material"];
-				ERR_FAIL_INDEX_V(material, state.materials.size(), ERR_FILE_CORRUPT);
-				const Ref<Material> &mat = state.materials[material];
+			if (surface.material >= 0) {
+				const Ref<Material> &mat = state.materials[surface.material];
 
 				mesh.mesh->surface_set_material(mesh.mesh->get_surface_count() - 1, mat);
 			}
@@ -1292,9 +1410,9 @@ Error EditorSceneImporterGLTF::_parse_images(GLTFState &state, const String &p_b
 			const GLTFBufferIndex bi = bv.buffer;
 			ERR_FAIL_INDEX_V(bi, state.buffers.size(), ERR_PARAMETER_RANGE_ERROR);
 
-			ERR_FAIL_COND_V(bv.byte_offset + bv.byte_length > state.buffers[bi].size(), ERR_FILE_CORRUPT);
+			ERR_FAIL_COND_V((uint64_t)bv.byte_offset + bv.byte_length > state.buffers[bi].size(), ERR_FILE_CORRUPT);
 
-			data_ptr = &state.buffers[bi][bv.byte_offset];
+			data_ptr = state.buffers[bi].ptr() + bv.byte_offset;
 			data_size = bv.byte_length;
 		}
 
@@ -2313,136 +2431,165 @@ Error EditorSceneImporterGLTF::_parse_cameras(GLTFState &state) {
 	return OK;
 }
 
-Error EditorSceneImporterGLTF::_parse_animations(GLTFState &state) {
-
-	if (!state.json.has("animations"))
-		return OK;
+Error EditorSceneImporterGLTF::_decode_animation(const GLTFState &state, const Dictionary &d, GLTFAnimation &animation) {
 
-	const Array &animations = state.json["animations"];
+	if (!d.has("channels") || !d.has("samplers"))
+		return ERR_SKIP;
 
-	for (GLTFAnimationIndex i = 0; i < animations.size(); i++) {
+	Array channels = d["channels"];
+	Array samplers = d["samplers"];
 
-		const Dictionary &d = animations[i];
+	if (d.has("name")) {
+		String name = d["name"];
+		if (name.begins_with("loop") || name.ends_with("loop") || name.begins_with("cycle") || name.ends_with("cycle")) {
+			animation.loop = true;
+		}
+		animation.name = _sanitize_scene_name(name);
+	}
 
-		GLTFAnimation animation;
+	for (int j = 0; j < channels.size(); j++) {
 
-		if (!d.has("channels") || !d.has("samplers"))
+		const Dictionary &c = channels[j];
+		if (!c.has("target"))
 			continue;
 
-		Array channels = d["channels"];
-		Array samplers = d["samplers"];
-
-		if (d.has("name")) {
-			String name = d["name"];
-			if (name.begins_with("loop") || name.ends_with("loop") || name.begins_with("cycle") || name.ends_with("cycle")) {
-				animation.loop = true;
-			}
-			animation.name = _sanitize_scene_name(name);
+		const Dictionary &t = c["target"];
+		if (!t.has("node") || !t.has("path")) {
+			continue;
 		}
 
-		for (int j = 0; j < channels.size(); j++) {
-
-			const Dictionary &c = channels[j];
-			if (!c.has("target"))
-				continue;
+		ERR_FAIL_COND_V(!c.has("sampler"), ERR_PARSE_ERROR);
+		const int sampler = c["sampler"];
+		ERR_FAIL_INDEX_V(sampler, samplers.size(), ERR_PARSE_ERROR);
+
+		GLTFNodeIndex node = t["node"];
+		String path = t["path"];
+
+		ERR_FAIL_INDEX_V(node, state.nodes.size(), ERR_PARSE_ERROR);
+
+		GLTFAnimation::Track *track = nullptr;
+
+		if (!animation.tracks.has(node)) {
+			animation.tracks[node] = GLTFAnimation::Track();
+		}
+
+		track = &animation.tracks[node];
+
+		const Dictionary &s = samplers[sampler];
+
+		ERR_FAIL_COND_V(!s.has("input"), ERR_PARSE_ERROR);
+		ERR_FAIL_COND_V(!s.has("output"), ERR_PARSE_ERROR);
+
+		const int input = s["input"];
+		const int output = s["output"];
+
+		GLTFAnimation::Interpolation interp = GLTFAnimation::INTERP_LINEAR;
+		int output_count = 1;
+		if (s.has("interpolation")) {
+			const String &in = s["interpolation"];
+			if (in == "STEP") {
+				interp = GLTFAnimation::INTERP_STEP;
+			} else if (in == "LINEAR") {
+				interp = GLTFAnimation::INTERP_LINEAR;
+			} else if (in == "CATMULLROMSPLINE") {
+				interp = GLTFAnimation::INTERP_CATMULLROMSPLINE;
+				output_count = 3;
+			} else if (in == "CUBICSPLINE") {
+				interp = GLTFAnimation::INTERP_CUBIC_SPLINE;
+				output_count = 3;
+			}
+		}
+
+		const PoolVector<float> times = _decode_accessor_as_floats(state, input, false);
+		if (path == "translation") {
+			const PoolVector<Vector3> translations = _decode_accessor_as_vec3(state, output, false);
+			track->translation_track.interpolation = interp;
+			track->translation_track.times = Variant(times); //convert via variant
+			track->translation_track.values = Variant(translations); //convert via variant
+		} else if (path == "rotation") {
+			const Vector<Quat> rotations = _decode_accessor_as_quat(state, output, false);
+			track->rotation_track.interpolation = interp;
+			track->rotation_track.times = Variant(times); //convert via variant
+			track->rotation_track.values = rotations; //convert via variant
+		} else if (path == "scale") {
+			const PoolVector<Vector3> scales = _decode_accessor_as_vec3(state, output, false);
+			track->scale_track.interpolation = interp;
+			track->scale_track.times = Variant(times); //convert via variant
+			track->scale_track.values = Variant(scales); //convert via variant
+		} else if (path == "weights") {
+			const PoolVector<float> weights = _decode_accessor_as_floats(state, output, false);
+
+			ERR_FAIL_INDEX_V(state.nodes[node]->mesh, state.meshes.size(), ERR_PARSE_ERROR);
+			const GLTFMesh *mesh = &state.meshes[state.nodes[node]->mesh];
+			ERR_FAIL_COND_V(mesh->blend_weights.size() == 0, ERR_PARSE_ERROR);
+			const int wc = mesh->blend_weights.size();
+
+			track->weight_tracks.resize(wc);
+
+			const int expected_value_count = times.size() * output_count * wc;
+			ERR_FAIL_COND_V_MSG(weights.size() != expected_value_count, ERR_PARSE_ERROR, "Invalid weight data, expected " + itos(expected_value_count) + " weight values, got " + itos(weights.size()) + " instead.");
+
+			const int wlen = weights.size() / wc;
+			PoolVector<float>::Read r = weights.read();
+			for (int k = 0; k < wc; k++) { //separate tracks, having them together is not such a good idea
+				GLTFAnimation::Channel<float> cf;
+				cf.interpolation = interp;
+				cf.times = Variant(times);
+				Vector<float> wdata;
+				wdata.resize(wlen);
+				for (int l = 0; l < wlen; l++) {
+					wdata.write[l] = r[l * wc + k];
+				}
 
-			const Dictionary &t = c["target"];
-			if (!t.has("node") || !t.has("path")) {
-				continue;
+				cf.values = wdata;
+				track->weight_tracks.write[k] = cf;
 			}
+		} else {
+			WARN_PRINT("Invalid path '" + path + "'.");
+		}
+	}
 
-			ERR_FAIL_COND_V(!c.has("sampler"), ERR_PARSE_ERROR);
-			const int sampler = c["sampler"];
-			ERR_FAIL_INDEX_V(sampler, samplers.size(), ERR_PARSE_ERROR);
+	return OK;
+}
 
-			GLTFNodeIndex node = t["node"];
-			String path = t["path"];
+void EditorSceneImporterGLTF::_decode_animation_task(uint32_t p_index, GLTFAnimationDecodeJob *p_job) {
 
-			ERR_FAIL_INDEX_V(node, state.nodes.size(), ERR_PARSE_ERROR);
+	const Dictionary &d = p_job->animations[p_index];
+	p_job->errors[p_index] = _decode_animation(*p_job->state, d, p_job->results[p_index]);
+}
 
-			GLTFAnimation::Track *track = nullptr;
+Error EditorSceneImporterGLTF::_parse_animations(GLTFState &state) {
 
-			if (!animation.tracks.has(node)) {
-				animation.tracks[node] = GLTFAnimation::Track();
-			}
+	if (!state.json.has("animations"))
+		return OK;
 
-			track = &animation.tracks[node];
-
-			const Dictionary &s = samplers[sampler];
-
-			ERR_FAIL_COND_V(!s.has("input"), ERR_PARSE_ERROR);
-			ERR_FAIL_COND_V(!s.has("output"), ERR_PARSE_ERROR);
-
-			const int input = s["input"];
-			const int output = s["output"];
-
-			GLTFAnimation::Interpolation interp = GLTFAnimation::INTERP_LINEAR;
-			int output_count = 1;
-			if (s.has("interpolation")) {
-				const String &in = s["interpolation"];
-				if (in == "STEP") {
-					interp = GLTFAnimation::INTERP_STEP;
-				} else if (in == "LINEAR") {
-					interp = GLTFAnimation::INTERP_LINEAR;
-				} else if (in == "CATMULLROMSPLINE") {
-					interp = GLTFAnimation::INTERP_CATMULLROMSPLINE;
-					output_count = 3;
-				} else if (in == "CUBICSPLINE") {
-					interp = GLTFAnimation::INTERP_CUBIC_SPLINE;
-					output_count = 3;
-				}
-			}
+	GLTFAnimationDecodeJob job;
+	job.state = &state;
+	job.animations = state.json["animations"];
+	job.data.resize(job.animations.size());
+	job.results = job.data.ptrw();
+	job.error_list.resize(job.animations.size());
+	job.errors = job.error_list.ptrw();
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (job.animations.size() > 1 && pool && pool->get_thread_count() > 0) {
+		pool->parallel_for(job.animations.size(), this, &EditorSceneImporterGLTF::_decode_animation_task, &job);
+	} else {
+		for (int i = 0; i < job.animations.size(); i++) {
+			_decode_animation_task(i, &job);
+		}
+	}
 
-			const PoolVector<float> times = _decode_accessor_as_floats(state, input, false);
-			if (path == "translation") {
-				const PoolVector<Vector3> translations = _decode_accessor_as_vec3(state, output, false);
-				track->translation_track.interpolation = interp;
-				track->translation_track.times = Variant(times); //convert via variant
-				track->translation_track.values = Variant(translations); //convert via variant
-			} else if (path == "rotation") {
-				const Vector<Quat> rotations = _decode_accessor_as_quat(state, output, false);
-				track->rotation_track.interpolation = interp;
-				track->rotation_track.times = Variant(times); //convert via variant
-				track->rotation_track.values = rotations; //convert via variant
-			} else if (path == "scale") {
-				const PoolVector<Vector3> scales = _decode_accessor_as_vec3(state, output, false);
-				track->scale_track.interpolation = interp;
-				track->scale_track.times = Variant(times); //convert via variant
-				track->scale_track.values = Variant(scales); //convert via variant
-			} else if (path == "weights") {
-				const PoolVector<float> weights = _decode_accessor_as_floats(state, output, false);
-
-				ERR_FAIL_INDEX_V(state.nodes[node]->mesh, state.meshes.size(), ERR_PARSE_ERROR);
-				const GLTFMesh *mesh = &state.meshes[state.nodes[node]->mesh];
-				ERR_FAIL_COND_V(mesh->blend_weights.size() == 0, ERR_PARSE_ERROR);
-				const int wc = mesh->blend_weights.size();
-
-				track->weight_tracks.resize(wc);
-
-				const int expected_value_count = times.size() * output_count * wc;
-				ERR_FAIL_COND_V_MSG(weights.size() != expected_value_count, ERR_PARSE_ERROR, "Invalid weight data, expected " + itos(expected_value_count) + " weight values, got " + itos(weights.size()) + " instead.");
-
-				const int wlen = weights.size() / wc;
-				PoolVector<float>::Read r = weights.read();
-				for (int k = 0; k < wc; k++) { //separate tracks, having them together is not such a good idea
-					GLTFAnimation::Channel<float> cf;
-					cf.interpolation = interp;
-					cf.times = Variant(times);
-					Vector<float> wdata;
-					wdata.resize(wlen);
-					for (int l = 0; l < wlen; l++) {
-						wdata.write[l] = r[l * wc + k];
-					}
+	for (GLTFAnimationIndex i = 0; i < job.animations.size(); i++) {
 
-					cf.values = wdata;
-					track->weight_tracks.write[k] = cf;
-				}
-			} else {
-				WARN_PRINT("Invalid path '" + path + "'.");
-			}
+		if (job.error_list[i] == ERR_SKIP) {
+			continue;
+		}
+		if (job.error_list[i] != OK) {
+			return job.error_list[i];
 		}
 
-		state.animations.push_back(animation);
+		state.animations.push_back(job.data[i]);
 	}
 
 	print_verbose("glTF: Total animations '" + itos(state.animations.size()) + "'.");
@@ -37,6 +37,7 @@
 
 class AnimationPlayer;
 class BoneAttachment;
+class FileAccess;
 class MeshInstance;
 
 class EditorSceneImporterGLTF : public EditorSceneImporter {
@@ -128,6 +129,21 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 				fake_joint_parent(-1) {}
 	};
 
+	struct GLTFBuffer {
+
+		Vector<uint8_t> data; //embedded data, or a copy when the file can't be mapped
+		const uint8_t *mapped; //points into one of GLTFState::mapped_files otherwise
+		uint64_t mapped_size;
+
+		_FORCE_INLINE_ const uint8_t *ptr() const { return mapped ? mapped : data.ptr(); }
+		_FORCE_INLINE_ uint64_t size() const { return mapped ? mapped_size : data.size(); }
+
+		GLTFBuffer() :
+				mapped(NULL),
+				mapped_size(0) {
+		}
+	};
+
 	struct GLTFBufferView {
 
 		GLTFBufferIndex buffer;
@@ -246,6 +262,26 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 		Vector<float> blend_weights;
 	};
 
+	struct GLTFSurfaceData {
+		Mesh::PrimitiveType primitive;
+		Array arrays;
+		Array morphs;
+		int material;
+	};
+
+	//decoded off the main thread, turned into a GLTFMesh afterwards
+	struct GLTFMeshData {
+		Vector<GLTFSurfaceData> surfaces;
+		Vector<String> blend_shape_names;
+		bool has_targets;
+		Error err;
+
+		GLTFMeshData() :
+				has_targets(false),
+				err(OK) {
+		}
+	};
+
 	struct GLTFCamera {
 
 		bool perspective;
@@ -296,10 +332,11 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 		Dictionary json;
 		int major_version;
 		int minor_version;
-		Vector<uint8_t> glb_data;
+		GLTFBuffer glb_data;
+		Vector<FileAccess *> mapped_files;
 
 		Vector<GLTFNode *> nodes;
-		Vector<Vector<uint8_t> > buffers;
+		Vector<GLTFBuffer> buffers;
 		Vector<GLTFBufferView> buffer_views;
 		Vector<GLTFAccessor> accessors;
 
@@ -322,11 +359,7 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 
 		Map<GLTFNodeIndex, Node *> scene_nodes;
 
-		~GLTFState() {
-			for (int i = 0; i < nodes.size(); i++) {
-				memdelete(nodes[i]);
-			}
-		}
+		~GLTFState();
 	};
 
 	String _sanitize_scene_name(const String &name);
@@ -345,23 +378,36 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 
 	void _compute_node_heights(GLTFState &state);
 
+	bool _map_buffer(GLTFState &state, const String &p_path, uint64_t p_offset, uint64_t p_size, GLTFBuffer &r_buffer);
 	Error _parse_buffers(GLTFState &state, const String &p_base_path);
 	Error _parse_buffer_views(GLTFState &state);
 	GLTFType _get_type_from_str(const String &p_string);
 	Error _parse_accessors(GLTFState &state);
-	Error _decode_buffer_view(GLTFState &state, double *dst, const GLTFBufferViewIndex p_buffer_view, const int skip_every, const int skip_bytes, const int element_size, const int count, const GLTFType type, const int component_count, const int component_type, const int component_size, const bool normalized, const int byte_offset, const bool for_vertex);
-
-	Vector<double> _decode_accessor(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
-	PoolVector<float> _decode_accessor_as_floats(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
-	PoolVector<int> _decode_accessor_as_ints(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
-	PoolVector<Vector2> _decode_accessor_as_vec2(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
-	PoolVector<Vector3> _decode_accessor_as_vec3(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
-	PoolVector<Color> _decode_accessor_as_color(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
-	Vector<Quat> _decode_accessor_as_quat(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
-	Vector<Transform2D> _decode_accessor_as_xform2d(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
-	Vector<Basis> _decode_accessor_as_basis(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
-	Vector<Transform> _decode_accessor_as_xform(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+	template <class T>
+	Error _decode_buffer_view(const GLTFState &state, T *dst, const GLTFBufferViewIndex p_buffer_view, const int skip_every, const int skip_bytes, const int element_size, const int count, const GLTFType type, const int component_count, const int component_type, const int component_size, const bool normalized, const int byte_offset, const bool for_vertex);
 
+	int _get_accessor_component_count(const GLTFState &state, const GLTFAccessorIndex p_accessor);
+	template <class T>
+	Error _decode_accessor(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex, T *dst);
+	PoolVector<float> _decode_accessor_as_floats(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+	PoolVector<int> _decode_accessor_as_ints(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+	PoolVector<Vector2> _decode_accessor_as_vec2(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+	PoolVector<Vector3> _decode_accessor_as_vec3(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+	PoolVector<Color> _decode_accessor_as_color(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+	Vector<Quat> _decode_accessor_as_quat(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+	Vector<Transform2D> _decode_accessor_as_xform2d(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+	Vector<Basis> _decode_accessor_as_basis(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+	Vector<Transform> _decode_accessor_as_xform(const GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex);
+
+	struct GLTFMeshDecodeJob {
+		const GLTFState *state;
+		Array meshes;
+		Vector<GLTFMeshData> data;
+		GLTFMeshData *results; //data.ptrw(), taken once so the tasks never touch the vector itself
+	};
+
+	Error _decode_mesh(const GLTFState &state, const Dictionary &d, GLTFMeshData &r_data);
+	void _decode_mesh_task(uint32_t p_index, GLTFMeshDecodeJob *p_job);
 	Error _parse_meshes(GLTFState &state);
 	Error _parse_images(GLTFState &state, const String &p_base_path);
 	Error _parse_textures(GLTFState &state);
@@ -390,6 +436,17 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 
 	Error _parse_cameras(GLTFState &state);
 
+	struct GLTFAnimationDecodeJob {
+		const GLTFState *state;
+		Array animations;
+		Vector<GLTFAnimation> data;
+		Vector<Error> error_list;
+		GLTFAnimation *results;
+		Error *errors; //ERR_SKIP for animations without channels
+	};
+
+	Error _decode_animation(const GLTFState &state, const Dictionary &d, GLTFAnimation &animation);
+	void _decode_animation_task(uint32_t p_index, GLTFAnimationDecodeJob *p_job);
 	Error _parse_animations(GLTFState &state);
 
 	BoneAttachment *_generate_bone_attachment(GLTFState &state, Skeleton *skeleton, const GLTFNodeIndex node_index);
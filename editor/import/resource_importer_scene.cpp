@@ -276,12 +276,16 @@ static String _fixstr(const String &p_what, const String &p_str) {
 	return what;
 }
 
-static void _gen_shape_list(const Ref<Mesh> &mesh, List<Ref<Shape> > &r_shape_list, bool p_convex) {
+static void _gen_shape_list(const Ref<Mesh> &mesh, List<Ref<Shape> > &r_shape_list, bool p_convex, const Map<Ref<Mesh>, List<Ref<Shape> > > &p_convex_map) {
 
 	if (!p_convex) {
 
 		Ref<Shape> shape = mesh->create_trimesh_shape();
 		r_shape_list.push_back(shape);
+	} else if (p_convex_map.has(mesh)) {
+
+		// Decomposed ahead of time, see _find_convex_collision_meshes().
+		r_shape_list = p_convex_map[mesh];
 	} else {
 
 		Vector<Ref<Shape> > cd = mesh->convex_decompose();
@@ -293,12 +297,36 @@ static void _gen_shape_list(const Ref<Mesh> &mesh, List<Ref<Shape> > &r_shape_li
 	}
 }
 
-Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>, List<Ref<Shape> > > &collision_map, LightBakeMode p_light_bake_mode) {
+void ResourceImporterScene::_find_convex_collision_meshes(Node *p_node, Node *p_root, Vector<Ref<Mesh> > &r_meshes) {
+
+	String name = p_node->get_name();
+
+	if (p_node != p_root && _teststr(name, "noimp")) {
+		return;
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_find_convex_collision_meshes(p_node->get_child(i), p_root, r_meshes);
+	}
+
+	// Same suffixes _fix_node() generates convex shapes for, it only looks the results up.
+	MeshInstance *mi = Object::cast_to<MeshInstance>(p_node);
+	if (mi && mi->get_mesh().is_valid()) {
+
+		Ref<Mesh> mesh = mi->get_mesh();
+		bool convex = _teststr(name, "convcolonly") || _teststr(name, "convcol") || _teststr(name, "rigid") || _teststr(mesh->get_name(), "convcol");
+		if (convex && r_meshes.find(mesh) == -1) {
+			r_meshes.push_back(mesh);
+		}
+	}
+}
+
+Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>, List<Ref<Shape> > > &collision_map, const Map<Ref<Mesh>, List<Ref<Shape> > > &p_convex_map, LightBakeMode p_light_bake_mode) {
 
 	// children first
 	for (int i = 0; i < p_node->get_child_count(); i++) {
 
-		Node *r = _fix_node(p_node->get_child(i), p_root, collision_map, p_light_bake_mode);
+		Node *r = _fix_node(p_node->get_child(i), p_root, collision_map, p_convex_map, p_light_bake_mode);
 		if (!r) {
 			i--; //was erased
 		}
@@ -387,10 +415,10 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>
 				if (collision_map.has(mesh)) {
 					shapes = collision_map[mesh];
 				} else if (_teststr(name, "colonly")) {
-					_gen_shape_list(mesh, shapes, false);
+					_gen_shape_list(mesh, shapes, false, p_convex_map);
 					collision_map[mesh] = shapes;
 				} else if (_teststr(name, "convcolonly")) {
-					_gen_shape_list(mesh, shapes, true);
+					_gen_shape_list(mesh, shapes, true, p_convex_map);
 					collision_map[mesh] = shapes;
 				}
 
@@ -472,7 +500,7 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>
 			if (collision_map.has(mesh)) {
 				shapes = collision_map[mesh];
 			} else {
-				_gen_shape_list(mesh, shapes, true);
+				_gen_shape_list(mesh, shapes, true, p_convex_map);
 			}
 
 			RigidBody *rigid_body = memnew(RigidBody);
@@ -510,10 +538,10 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>
 			if (collision_map.has(mesh)) {
 				shapes = collision_map[mesh];
 			} else if (_teststr(name, "col")) {
-				_gen_shape_list(mesh, shapes, false);
+				_gen_shape_list(mesh, shapes, false, p_convex_map);
 				collision_map[mesh] = shapes;
 			} else if (_teststr(name, "convcol")) {
-				_gen_shape_list(mesh, shapes, true);
+				_gen_shape_list(mesh, shapes, true, p_convex_map);
 				collision_map[mesh] = shapes;
 			}
 
@@ -622,11 +650,11 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>
 			if (collision_map.has(mesh)) {
 				shapes = collision_map[mesh];
 			} else if (_teststr(mesh->get_name(), "col")) {
-				_gen_shape_list(mesh, shapes, false);
+				_gen_shape_list(mesh, shapes, false, p_convex_map);
 				collision_map[mesh] = shapes;
 				mesh->set_name(_fixstr(mesh->get_name(), "col"));
 			} else if (_teststr(mesh->get_name(), "convcol")) {
-				_gen_shape_list(mesh, shapes, true);
+				_gen_shape_list(mesh, shapes, true, p_convex_map);
 				collision_map[mesh] = shapes;
 				mesh->set_name(_fixstr(mesh->get_name(), "convcol"));
 			}
@@ -913,6 +941,24 @@ void ResourceImporterScene::_optimize_animations(Node *scene, float p_max_lin_er
 	}
 }
 
+void ResourceImporterScene::_compress_animations(Node *scene) {
+
+	if (!scene->has_node(String("AnimationPlayer")))
+		return;
+	Node *n = scene->get_node(String("AnimationPlayer"));
+	ERR_FAIL_COND(!n);
+	AnimationPlayer *anim = Object::cast_to<AnimationPlayer>(n);
+	ERR_FAIL_COND(!anim);
+
+	List<StringName> anim_names;
+	anim->get_animation_list(&anim_names);
+	for (List<StringName>::Element *E = anim_names.front(); E; E = E->next()) {
+
+		Ref<Animation> a = anim->get_animation(E->get());
+		a->compress();
+	}
+}
+
 static String _make_extname(const String &p_str) {
 
 	String ext_name = p_str.replace(".", "_");
@@ -1168,6 +1214,8 @@ void ResourceImporterScene::get_import_options(List<ImportOption> *r_options, in
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "materials/keep_on_reimport"), materials_out));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/compress"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/ensure_tangents"), true));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/optimize"), true));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/generate_lods"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/storage", PROPERTY_HINT_ENUM, "Built-In,Files (.mesh),Files (.tres)"), meshes_out ? 1 : 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/light_baking", PROPERTY_HINT_ENUM, "Disabled,Enable,Gen Lightmaps", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "meshes/lightmap_texel_size", PROPERTY_HINT_RANGE, "0.001,100,0.001"), 0.1));
@@ -1182,6 +1230,7 @@ void ResourceImporterScene::get_import_options(List<ImportOption> *r_options, in
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/optimizer/max_angular_error"), 0.01));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/optimizer/max_angle"), 22));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/optimizer/remove_unused_tracks"), true));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/compression/enabled"), false));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "animation/clips/amount", PROPERTY_HINT_RANGE, "0,256,1", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0));
 	for (int i = 0; i < 256; i++) {
 		r_options->push_back(ImportOption(PropertyInfo(Variant::STRING, "animation/clip_" + itos(i + 1) + "/name"), ""));
@@ -1366,7 +1415,23 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 
 	Map<Ref<Mesh>, List<Ref<Shape> > > collision_map;
 
-	scene = _fix_node(scene, scene, collision_map, LightBakeMode(light_bake_mode));
+	// Convex decomposition is the slow part of generating collisions, run it for all meshes at once.
+	Map<Ref<Mesh>, List<Ref<Shape> > > convex_map;
+	Vector<Ref<Mesh> > convex_meshes;
+	_find_convex_collision_meshes(scene, scene, convex_meshes);
+	if (convex_meshes.size()) {
+
+		Vector<Vector<Ref<Shape> > > decomposed = Mesh::convex_decompose_multiple(convex_meshes);
+		for (int i = 0; i < decomposed.size(); i++) {
+
+			List<Ref<Shape> > &shapes = convex_map[convex_meshes[i]];
+			for (int j = 0; j < decomposed[i].size(); j++) {
+				shapes.push_back(decomposed[i][j]);
+			}
+		}
+	}
+
+	scene = _fix_node(scene, scene, collision_map, convex_map, LightBakeMode(light_bake_mode));
 
 	if (use_optimizer) {
 		_optimize_animations(scene, anim_optimizer_linerr, anim_optimizer_angerr, anim_optimizer_maxang);
@@ -1397,6 +1462,10 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		_filter_tracks(scene, animation_filter);
 	}
 
+	if (bool(p_options["animation/compression/enabled"])) {
+		_compress_animations(scene);
+	}
+
 	bool external_animations = int(p_options["animation/storage"]) == 1 || int(p_options["animation/storage"]) == 2;
 	bool external_animations_as_text = int(p_options["animation/storage"]) == 2;
 	bool keep_custom_tracks = p_options["animation/keep_custom_tracks"];
@@ -1420,7 +1489,10 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		}
 	}
 
-	if (light_bake_mode == 2 /* || generate LOD */) {
+	bool optimize_meshes = p_options["meshes/optimize"];
+	bool generate_lods = p_options["meshes/generate_lods"];
+
+	if (light_bake_mode == 2 || optimize_meshes || generate_lods) {
 
 		Map<Ref<ArrayMesh>, Transform> meshes;
 		_find_meshes(scene, meshes);
@@ -1430,7 +1502,34 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 			float texel_size = p_options["meshes/lightmap_texel_size"];
 			texel_size = MAX(0.001, texel_size);
 
-			EditorProgress progress2("gen_lightmaps", TTR("Generating Lightmaps"), meshes.size());
+			EditorProgress progress2("gen_lightmaps", TTR("Generating Lightmaps"), 1);
+			progress2.step(TTR("Generating for Meshes: ") + itos(meshes.size()), 0);
+
+			// Meshes are unwrapped in parallel, surfaces are still rebuilt one by one.
+			Vector<Ref<ArrayMesh> > unwrap_meshes;
+			Vector<Transform> unwrap_transforms;
+			for (Map<Ref<ArrayMesh>, Transform>::Element *E = meshes.front(); E; E = E->next()) {
+				unwrap_meshes.push_back(E->key());
+				unwrap_transforms.push_back(E->get());
+			}
+
+			Vector<Error> errors = ArrayMesh::lightmap_unwrap_multiple(unwrap_meshes, unwrap_transforms, texel_size);
+			for (int i = 0; i < errors.size(); i++) {
+
+				if (errors[i] != OK) {
+					String name = unwrap_meshes[i]->get_name();
+					if (name == "") { //should not happen but..
+						name = "Mesh " + itos(i);
+					}
+					EditorNode::add_io_error("Mesh '" + name + "' failed lightmap generation. Please fix geometry.");
+				}
+			}
+		}
+
+		if (optimize_meshes) {
+
+			//after unwrapping, which rebuilds the surfaces, and before LODs, which index the reordered vertices
+			EditorProgress progress_optimize("optimize_meshes", TTR("Optimizing Meshes"), meshes.size());
 			int step = 0;
 			for (Map<Ref<ArrayMesh>, Transform>::Element *E = meshes.front(); E; E = E->next()) {
 
@@ -1440,12 +1539,29 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 					name = "Mesh " + itos(step);
 				}
 
-				progress2.step(TTR("Generating for Mesh: ") + name + " (" + itos(step) + "/" + itos(meshes.size()) + ")", step);
+				progress_optimize.step(TTR("Optimizing Mesh: ") + name + " (" + itos(step) + "/" + itos(meshes.size()) + ")", step);
 
-				Error err2 = mesh->lightmap_unwrap(E->get(), texel_size);
-				if (err2 != OK) {
-					EditorNode::add_io_error("Mesh '" + name + "' failed lightmap generation. Please fix geometry.");
+				mesh->optimize_surfaces();
+				step++;
+			}
+		}
+
+		if (generate_lods) {
+
+			//after unwrapping, which rebuilds the surfaces
+			EditorProgress progress3("gen_lods", TTR("Generating LODs"), meshes.size());
+			int step = 0;
+			for (Map<Ref<ArrayMesh>, Transform>::Element *E = meshes.front(); E; E = E->next()) {
+
+				Ref<ArrayMesh> mesh = E->key();
+				String name = mesh->get_name();
+				if (name == "") { //should not happen but..
+					name = "Mesh " + itos(step);
 				}
+
+				progress3.step(TTR("Generating for Mesh: ") + name + " (" + itos(step) + "/" + itos(meshes.size()) + ")", step);
+
+				mesh->generate_lods();
 				step++;
 			}
 		}
@@ -127,8 +127,8 @@ void AbstractPolygon2DEditor::_set_polygon(int p_idx, const Variant &p_polygon)
 void AbstractPolygon2DEditor::_action_set_polygon(int p_idx, const Variant &p_previous, const Variant &p_polygon) {
 
 	Node2D *node = _get_node();
-	undo_redo->add_do_method(node, "set_polygon", p_polygon);
-	undo_redo->add_undo_method(node, "set_polygon", p_previous);
+	// Moving a few vertices only stores those in the history.
+	undo_redo->add_property_delta(node, "polygon", p_previous, p_polygon);
 }
 
 Vector2 AbstractPolygon2DEditor::_get_offset(int p_idx) const {
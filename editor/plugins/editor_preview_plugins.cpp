@@ -141,6 +141,10 @@ Ref<Texture> EditorTexturePreviewPlugin::generate(const RES &p_from, const Size2
 	return ptex;
 }
 
+bool EditorTexturePreviewPlugin::is_thread_safe() const {
+	return true;
+}
+
 EditorTexturePreviewPlugin::EditorTexturePreviewPlugin() {
 }
 
@@ -186,6 +190,10 @@ Ref<Texture> EditorImagePreviewPlugin::generate(const RES &p_from, const Size2 &
 	return ptex;
 }
 
+bool EditorImagePreviewPlugin::is_thread_safe() const {
+	return true;
+}
+
 EditorImagePreviewPlugin::EditorImagePreviewPlugin() {
 }
 
@@ -257,6 +265,10 @@ bool EditorBitmapPreviewPlugin::generate_small_preview_automatically() const {
 	return true;
 }
 
+bool EditorBitmapPreviewPlugin::is_thread_safe() const {
+	return true;
+}
+
 EditorBitmapPreviewPlugin::EditorBitmapPreviewPlugin() {
 }
 
@@ -691,6 +703,10 @@ Ref<Texture> EditorAudioStreamPreviewPlugin::generate(const RES &p_from, const S
 	return ptex;
 }
 
+bool EditorAudioStreamPreviewPlugin::is_thread_safe() const {
+	return true;
+}
+
 EditorAudioStreamPreviewPlugin::EditorAudioStreamPreviewPlugin() {
 }
 
@@ -42,6 +42,7 @@ public:
 	virtual bool handles(const String &p_type) const;
 	virtual bool generate_small_preview_automatically() const;
 	virtual Ref<Texture> generate(const RES &p_from, const Size2 &p_size) const;
+	virtual bool is_thread_safe() const;
 
 	EditorTexturePreviewPlugin();
 };
@@ -53,6 +54,7 @@ public:
 	virtual bool handles(const String &p_type) const;
 	virtual bool generate_small_preview_automatically() const;
 	virtual Ref<Texture> generate(const RES &p_from, const Size2 &p_size) const;
+	virtual bool is_thread_safe() const;
 
 	EditorImagePreviewPlugin();
 };
@@ -64,6 +66,7 @@ public:
 	virtual bool handles(const String &p_type) const;
 	virtual bool generate_small_preview_automatically() const;
 	virtual Ref<Texture> generate(const RES &p_from, const Size2 &p_size) const;
+	virtual bool is_thread_safe() const;
 
 	EditorBitmapPreviewPlugin();
 };
@@ -120,6 +123,7 @@ class EditorAudioStreamPreviewPlugin : public EditorResourcePreviewGenerator {
 public:
 	virtual bool handles(const String &p_type) const;
 	virtual Ref<Texture> generate(const RES &p_from, const Size2 &p_size) const;
+	virtual bool is_thread_safe() const;
 
 	EditorAudioStreamPreviewPlugin();
 };
@@ -158,9 +158,9 @@ void TileMapEditor::_menu_option(int p_option) {
 		case OPTION_FIX_INVALID: {
 
 			undo_redo->create_action(TTR("Fix Invalid Tiles"));
-			undo_redo->add_undo_method(node, "set", "tile_data", node->get("tile_data"));
+			Variant old_tile_data = node->get("tile_data");
 			node->fix_invalid_tiles();
-			undo_redo->add_do_method(node, "set", "tile_data", node->get("tile_data"));
+			undo_redo->add_property_delta(node, "tile_data", old_tile_data, node->get("tile_data"));
 			undo_redo->commit_action();
 
 		} break;
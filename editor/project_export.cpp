@@ -878,6 +878,17 @@ void ProjectExportDialog::_tree_changed() {
 
 void ProjectExportDialog::_export_pck_zip() {
 
+	export_pck_zip->clear_filters();
+	export_pck_zip->add_filter("*.zip ; " + TTR("ZIP File"));
+	export_pck_zip->add_filter("*.pck ; " + TTR("Godot Game Pack"));
+	export_pck_zip->popup_centered_ratio();
+}
+
+void ProjectExportDialog::_export_patch() {
+
+	// Patches are only generated as PCK files, see EditorExportPlatform::export_pack().
+	export_pck_zip->clear_filters();
+	export_pck_zip->add_filter("*.pck ; " + TTR("Godot Game Pack"));
 	export_pck_zip->popup_centered_ratio();
 }
 
@@ -1041,6 +1052,7 @@ void ProjectExportDialog::_bind_methods() {
 	ClassDB::bind_method("_patch_deleted", &ProjectExportDialog::_patch_deleted);
 	ClassDB::bind_method("_patch_edited", &ProjectExportDialog::_patch_edited);
 	ClassDB::bind_method("_export_pck_zip", &ProjectExportDialog::_export_pck_zip);
+	ClassDB::bind_method("_export_patch", &ProjectExportDialog::_export_patch);
 	ClassDB::bind_method("_export_pck_zip_selected", &ProjectExportDialog::_export_pck_zip_selected);
 	ClassDB::bind_method("_open_export_template_manager", &ProjectExportDialog::_open_export_template_manager);
 	ClassDB::bind_method("_validate_export_path", &ProjectExportDialog::_validate_export_path);
@@ -1181,11 +1193,7 @@ ProjectExportDialog::ProjectExportDialog() {
 	sections->add_child(patch_vb);
 	patch_vb->set_name(TTR("Patches"));
 
-	// FIXME: Patching support doesn't seem properly implemented yet, so we hide it.
-	// The rest of the code is still kept for now, in the hope that it will be made
-	// functional and reactivated.
-	patch_vb->hide();
-
+	// Enabled packs are the base of PCK exports, which then only store what changed since them.
 	patches = memnew(Tree);
 	patch_vb->add_child(patches);
 	patches->set_v_size_flags(SIZE_EXPAND_FILL);
@@ -1200,6 +1208,7 @@ ProjectExportDialog::ProjectExportDialog() {
 	patches_hb->add_spacer();
 	patch_export = memnew(Button);
 	patch_export->set_text(TTR("Make Patch"));
+	patch_export->connect("pressed", this, "_export_patch");
 	patches_hb->add_child(patch_export);
 	patches_hb->add_spacer();
 
@@ -147,6 +147,7 @@ private:
 	void _open_export_template_manager();
 
 	void _export_pck_zip();
+	void _export_patch();
 	void _export_pck_zip_selected(const String &p_path);
 
 	void _validate_export_path(const String &p_path);
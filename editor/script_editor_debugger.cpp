@@ -342,12 +342,15 @@ void ScriptEditorDebugger::_file_selected(const String &p_file) {
 				return;
 			}
 			Vector<String> line;
-			line.resize(Performance::MONITOR_MAX);
+			line.resize(Performance::MONITOR_MAX + perf_custom_names.size());
 
 			// signatures
 			for (int i = 0; i < Performance::MONITOR_MAX; i++) {
 				line.write[i] = Performance::get_singleton()->get_monitor_name(Performance::Monitor(i));
 			}
+			for (int i = 0; i < perf_custom_names.size(); i++) {
+				line.write[Performance::MONITOR_MAX + i] = perf_custom_names[i];
+			}
 			file->store_csv_line(line);
 
 			// values
@@ -355,7 +358,7 @@ void ScriptEditorDebugger::_file_selected(const String &p_file) {
 			while (E) {
 
 				Vector<float> &perf_data = E->get();
-				for (int i = 0; i < perf_data.size(); i++) {
+				for (int i = 0; i < perf_data.size() && i < line.size(); i++) {
 
 					line.write[i] = String::num_real(perf_data[i]);
 				}
@@ -802,6 +805,14 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 
 	} else if (p_msg == "performance") {
 		Array arr = p_data[0];
+		if (p_data.size() >= 3) {
+			// Custom monitors registered by the game follow the built-in ones.
+			_update_custom_monitors(p_data[1]);
+			Array custom_values = p_data[2];
+			for (int i = 0; i < custom_values.size(); i++) {
+				arr.push_back(custom_values[i]);
+			}
+		}
 		Vector<float> p;
 		p.resize(arr.size());
 		for (int i = 0; i < arr.size(); i++) {
@@ -1076,6 +1087,11 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 			profiler->add_frame_metric(metric, false);
 		else
 			profiler->add_frame_metric(metric, true);
+	} else if (p_msg == "profile_samples") {
+
+		for (int i = 0; i + 1 < p_data.size(); i += 2) {
+			profiler->add_samples(p_data[i], (uint64_t)p_data[i + 1]);
+		}
 	} else if (p_msg == "network_profile") {
 		int frame_size = 6;
 		for (int i = 0; i < p_data.size(); i += frame_size) {
@@ -1116,6 +1132,66 @@ void ScriptEditorDebugger::_performance_select() {
 	perf_draw->update();
 }
 
+void ScriptEditorDebugger::_update_custom_monitors(const Array &p_names) {
+
+	bool changed = p_names.size() != perf_custom_names.size();
+	Vector<String> names;
+	for (int i = 0; i < p_names.size(); i++) {
+		names.push_back(p_names[i]);
+		changed = changed || names[i] != perf_custom_names[i];
+	}
+	if (!changed) {
+		return;
+	}
+	perf_custom_names = names;
+
+	for (int i = Performance::MONITOR_MAX; i < perf_items.size(); i++) {
+		memdelete(perf_items[i]);
+	}
+	perf_items.resize(Performance::MONITOR_MAX);
+	perf_max.resize(Performance::MONITOR_MAX);
+
+	for (int i = 0; i < perf_custom_bases.size(); i++) {
+		for (Map<String, TreeItem *>::Element *E = perf_bases.front(); E; E = E->next()) {
+			if (E->get() == perf_custom_bases[i]) {
+				perf_bases.erase(E);
+				break;
+			}
+		}
+		memdelete(perf_custom_bases[i]);
+	}
+	perf_custom_bases.clear();
+
+	for (int i = 0; i < names.size(); i++) {
+
+		String base = names[i].get_slice("/", 0);
+		String name = names[i].get_slice("/", 1);
+		if (!perf_bases.has(base)) {
+			TreeItem *b = perf_monitors->create_item(perf_monitors->get_root());
+			b->set_text(0, base.capitalize());
+			b->set_editable(0, false);
+			b->set_selectable(0, false);
+			b->set_expand_right(0, true);
+			perf_bases[base] = b;
+			perf_custom_bases.push_back(b);
+		}
+
+		TreeItem *it = perf_monitors->create_item(perf_bases[base]);
+		it->set_metadata(1, Performance::MONITOR_TYPE_QUANTITY);
+		it->set_cell_mode(0, TreeItem::CELL_MODE_CHECK);
+		it->set_editable(0, true);
+		it->set_selectable(0, false);
+		it->set_selectable(1, false);
+		it->set_text(0, name.capitalize());
+		perf_items.push_back(it);
+		perf_max.push_back(0);
+	}
+
+	// Older samples are indexed by the previous set of monitors.
+	perf_history.clear();
+	perf_draw->update();
+}
+
 void ScriptEditorDebugger::_performance_draw() {
 
 	Vector<int> which;
@@ -1475,6 +1551,7 @@ void ScriptEditorDebugger::start() {
 
 		perf_max.write[i] = 0;
 	}
+	_update_custom_monitors(Array());
 
 	int remote_port = (int)EditorSettings::get_singleton()->get("network/debug/remote_port");
 	if (server->listen(remote_port) != OK) {
@@ -1547,6 +1624,22 @@ void ScriptEditorDebugger::_profiler_activate(bool p_enable) {
 	if (!connection.is_valid())
 		return;
 
+	if (profiler->is_sampling()) {
+
+		Array msg;
+		if (p_enable) {
+			msg.push_back("start_sampling");
+			int interval = EditorSettings::get_singleton()->get("debugger/profiler_sampling_interval_usec");
+			msg.push_back(CLAMP(interval, 100, 100000));
+			print_verbose("Starting sampling.");
+		} else {
+			msg.push_back("stop_sampling");
+			print_verbose("Ending sampling.");
+		}
+		ppeer->put_var(msg);
+		return;
+	}
+
 	if (p_enable) {
 		profiler_signature.clear();
 		Array msg;
@@ -2484,7 +2577,7 @@ ScriptEditorDebugger::ScriptEditorDebugger(EditorNode *p_editor) {
 		tabs->add_child(hsp);
 		perf_max.resize(Performance::MONITOR_MAX);
 
-		Map<String, TreeItem *> bases;
+		Map<String, TreeItem *> &bases = perf_bases;
 		TreeItem *root = perf_monitors->create_item();
 		perf_monitors->set_hide_root(true);
 		for (int i = 0; i < Performance::MONITOR_MAX; i++) {
@@ -142,6 +142,9 @@ private:
 	List<Vector<float> > perf_history;
 	Vector<float> perf_max;
 	Vector<TreeItem *> perf_items;
+	Map<String, TreeItem *> perf_bases;
+	Vector<TreeItem *> perf_custom_bases;
+	Vector<String> perf_custom_names;
 
 	Map<int, String> profiler_signature;
 
@@ -181,6 +184,7 @@ private:
 
 	void _performance_draw();
 	void _performance_select();
+	void _update_custom_monitors(const Array &p_names);
 	void _stack_dump_frame_selected();
 	void _output_clear();
 
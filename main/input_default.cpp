@@ -666,12 +666,60 @@ void InputDefault::accumulate_input_event(const Ref<InputEvent> &p_event) {
 		parse_input_event(p_event);
 		return;
 	}
-	if (!accumulated_events.empty() && accumulated_events.back()->get()->accumulate(p_event)) {
+
+	List<Ref<InputEvent> >::Element *E = accumulated_events.back();
+	if (E && _accumulate_into(E->get(), p_event)) {
 		return; //event was accumulated, exit
 	}
 
+	if (Object::cast_to<InputEventScreenDrag>(*p_event)) {
+		//drags of other fingers are often interleaved, merging past them doesn't change what any single finger does
+		while (E && Object::cast_to<InputEventScreenDrag>(*E->get())) {
+			E = E->prev();
+			if (E && _accumulate_into(E->get(), p_event)) {
+				return;
+			}
+		}
+	}
+
 	accumulated_events.push_back(p_event);
 }
+
+bool InputDefault::_accumulate_into(Ref<InputEvent> &p_into, const Ref<InputEvent> &p_event) {
+
+	if (!use_accumulated_input_history) {
+		return p_into->accumulate(p_event);
+	}
+
+	//keep every position merged in, so drawing can follow the exact path
+	InputEventMouseMotion *mm = Object::cast_to<InputEventMouseMotion>(p_into.ptr());
+	if (mm) {
+		Vector2 from = mm->get_position();
+		if (!mm->accumulate(p_event)) {
+			return false;
+		}
+		if (mm->get_accumulated_positions().size() == 0) {
+			mm->append_accumulated_position(from);
+		}
+		mm->append_accumulated_position(mm->get_position());
+		return true;
+	}
+
+	InputEventScreenDrag *sd = Object::cast_to<InputEventScreenDrag>(p_into.ptr());
+	if (sd) {
+		Vector2 from = sd->get_position();
+		if (!sd->accumulate(p_event)) {
+			return false;
+		}
+		if (sd->get_accumulated_positions().size() == 0) {
+			sd->append_accumulated_position(from);
+		}
+		sd->append_accumulated_position(sd->get_position());
+		return true;
+	}
+
+	return p_into->accumulate(p_event);
+}
 void InputDefault::flush_accumulated_events() {
 
 	while (accumulated_events.front()) {
@@ -685,6 +733,11 @@ void InputDefault::set_use_accumulated_input(bool p_enable) {
 	use_accumulated_input = p_enable;
 }
 
+void InputDefault::set_use_accumulated_input_history(bool p_enable) {
+
+	use_accumulated_input_history = p_enable;
+}
+
 void InputDefault::release_pressed_events() {
 
 	flush_accumulated_events(); // this is needed to release actions strengths
@@ -702,6 +755,7 @@ void InputDefault::release_pressed_events() {
 InputDefault::InputDefault() {
 
 	use_accumulated_input = true;
+	use_accumulated_input_history = false;
 	mouse_button_mask = 0;
 	emulate_touch_from_mouse = false;
 	emulate_mouse_from_touch = false;
@@ -185,6 +185,9 @@ private:
 
 	List<Ref<InputEvent> > accumulated_events;
 	bool use_accumulated_input;
+	bool use_accumulated_input_history;
+
+	bool _accumulate_into(Ref<InputEvent> &p_into, const Ref<InputEvent> &p_event);
 
 public:
 	virtual bool is_key_pressed(int p_scancode) const;
@@ -272,6 +275,7 @@ public:
 	virtual void accumulate_input_event(const Ref<InputEvent> &p_event);
 	virtual void flush_accumulated_events();
 	virtual void set_use_accumulated_input(bool p_enable);
+	virtual void set_use_accumulated_input_history(bool p_enable);
 
 	virtual void release_pressed_events();
 	InputDefault();
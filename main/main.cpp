@@ -31,6 +31,7 @@
 #include "main.h"
 
 #include "core/crypto/crypto.h"
+#include "core/frame_arena.h"
 #include "core/input_map.h"
 #include "core/io/file_access_network.h"
 #include "core/io/file_access_pack.h"
@@ -41,6 +42,7 @@
 #include "core/message_queue.h"
 #include "core/os/dir_access.h"
 #include "core/os/os.h"
+#include "core/os/timeline_profiler.h"
 #include "core/project_settings.h"
 #include "core/register_core_types.h"
 #include "core/script_debugger_local.h"
@@ -145,7 +147,9 @@ static bool debug_navigation = false;
 static int frame_delay = 0;
 static bool disable_render_loop = false;
 static int fixed_fps = -1;
+static int pool_compaction_usec = 0;
 static bool print_fps = false;
+static String timeline_path;
 
 /* Helper methods */
 
@@ -280,6 +284,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --disable-crash-handler          Disable crash handler when supported by the platform code.\n");
 	OS::get_singleton()->print("  --fixed-fps <fps>                Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	OS::get_singleton()->print("  --print-fps                      Print the frames per second to the stdout.\n");
+	OS::get_singleton()->print("  --timeline <file>                Record a timeline of engine scopes and save it on exit as Chrome trace JSON.\n");
 	OS::get_singleton()->print("\n");
 
 	OS::get_singleton()->print("Standalone tools:\n");
@@ -305,6 +310,7 @@ void Main::print_help(const char *p_binary) {
 		comma = ", ";
 	}
 	OS::get_singleton()->print(").\n");
+	OS::get_singleton()->print("  --benchmark                      Run the benchmark suite. Takes --benchmark-filter <pattern>, --benchmark-iterations <n>, --benchmark-warmup <n> and --benchmark-json <path>.\n");
 #endif
 }
 
@@ -804,6 +810,15 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			}
 		} else if (I->get() == "--print-fps") {
 			print_fps = true;
+		} else if (I->get() == "--timeline") { // record a timeline until exit
+			if (I->next()) {
+				timeline_path = I->next()->get();
+				TimelineProfiler::set_enabled(true);
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing timeline file argument, aborting.\n");
+				goto error;
+			}
 		} else if (I->get() == "--disable-crash-handler") {
 			OS::get_singleton()->disable_crash_handler();
 		} else if (I->get() == "--skip-breakpoints") {
@@ -864,6 +879,13 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	GLOBAL_DEF("memory/limits/multithreaded_server/rid_pool_prealloc", 60);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/multithreaded_server/rid_pool_prealloc", PropertyInfo(Variant::INT, "memory/limits/multithreaded_server/rid_pool_prealloc", PROPERTY_HINT_RANGE, "0,500,1")); // No negative and limit to 500 due to crashes
+	pool_compaction_usec = GLOBAL_DEF("memory/limits/pool_allocator/idle_compaction_usec", 500);
+	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/pool_allocator/idle_compaction_usec", PropertyInfo(Variant::INT, "memory/limits/pool_allocator/idle_compaction_usec", PROPERTY_HINT_RANGE, "0,10000,1,or_greater"));
+	GLOBAL_DEF("memory/limits/resource_cache/soft_budget_mb", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/resource_cache/soft_budget_mb", PropertyInfo(Variant::INT, "memory/limits/resource_cache/soft_budget_mb", PROPERTY_HINT_RANGE, "0,16384,1,or_greater"));
+	if (!editor) {
+		ResourceCache::set_soft_cache_budget(uint64_t(MAX(int(GLOBAL_GET("memory/limits/resource_cache/soft_budget_mb")), 0)) * 1024 * 1024);
+	}
 	GLOBAL_DEF("network/limits/debugger_stdout/max_chars_per_second", 2048);
 	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger_stdout/max_chars_per_second", PropertyInfo(Variant::INT, "network/limits/debugger_stdout/max_chars_per_second", PROPERTY_HINT_RANGE, "0, 4096, 1, or_greater"));
 	GLOBAL_DEF("network/limits/debugger_stdout/max_messages_per_frame", 10);
@@ -921,10 +943,15 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	GLOBAL_DEF("logging/file_logging/log_path", "user://logs/log.txt");
 	GLOBAL_DEF("logging/file_logging/max_log_files", 10);
 	ProjectSettings::get_singleton()->set_custom_property_info("logging/file_logging/max_log_files", PropertyInfo(Variant::INT, "logging/file_logging/max_log_files", PROPERTY_HINT_RANGE, "0,20,1,or_greater")); //no negative numbers
+	GLOBAL_DEF("logging/file_logging/async", false);
 	if (FileAccess::get_create_func(FileAccess::ACCESS_USERDATA) && GLOBAL_GET("logging/file_logging/enable_file_logging")) {
 		String base_path = GLOBAL_GET("logging/file_logging/log_path");
 		int max_files = GLOBAL_GET("logging/file_logging/max_log_files");
-		OS::get_singleton()->add_logger(memnew(RotatedFileLogger(base_path, max_files)));
+		Logger *file_logger = memnew(RotatedFileLogger(base_path, max_files));
+		if (GLOBAL_GET("logging/file_logging/async")) {
+			file_logger = memnew(AsyncLogger(file_logger));
+		}
+		OS::get_singleton()->add_logger(file_logger);
 	}
 
 #ifdef TOOLS_ENABLED
@@ -1123,6 +1150,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/fps/force_fps", PropertyInfo(Variant::INT, "debug/settings/fps/force_fps", PROPERTY_HINT_RANGE, "0,120,1,or_greater"));
 
 	GLOBAL_DEF("debug/settings/stdout/print_fps", false);
+	GLOBAL_DEF("debug/settings/metrics/export_port", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/metrics/export_port", PropertyInfo(Variant::INT, "debug/settings/metrics/export_port", PROPERTY_HINT_RANGE, "0,65535,1"));
+	GLOBAL_DEF("debug/settings/metrics/export_bind_address", "127.0.0.1");
 
 	if (!OS::get_singleton()->_verbose_stdout) //overridden
 		OS::get_singleton()->_verbose_stdout = GLOBAL_DEF("debug/settings/stdout/verbose_stdout", false);
@@ -1422,6 +1452,8 @@ bool Main::start() {
 		//parameters that do not have an argument to the right
 		if (args[i] == "--check-only") {
 			check_only = true;
+		} else if (args[i] == "--benchmark") {
+			test = "benchmark";
 #ifdef TOOLS_ENABLED
 		} else if (args[i] == "--no-docbase") {
 			doc_base = false;
@@ -1997,6 +2029,9 @@ bool Main::iteration() {
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
 
 		uint64_t physics_begin = OS::get_singleton()->get_ticks_usec();
+		TIMELINE_SCOPE("Main::physics_step");
+
+		VisualServer::get_singleton()->tick();
 
 		PhysicsServer::get_singleton()->sync();
 		PhysicsServer::get_singleton()->flush_queries();
@@ -2027,15 +2062,22 @@ bool Main::iteration() {
 
 	uint64_t idle_begin = OS::get_singleton()->get_ticks_usec();
 
-	if (OS::get_singleton()->get_main_loop()->idle(step * time_scale)) {
-		exit = true;
+	{
+		TIMELINE_SCOPE("Main::idle");
+		if (OS::get_singleton()->get_main_loop()->idle(step * time_scale)) {
+			exit = true;
+		}
+		message_queue->flush();
 	}
-	message_queue->flush();
 
 	VisualServer::get_singleton()->sync(); //sync if still drawing from previous frames.
 
+	VisualServer::get_singleton()->pre_draw(advance.interpolation_fraction); //blend interpolated transforms for this frame
+
 	if (OS::get_singleton()->can_draw() && !disable_render_loop) {
 
+		TIMELINE_SCOPE("Main::draw");
+
 		if ((!force_redraw_requested) && OS::get_singleton()->is_in_low_processor_usage_mode()) {
 			if (VisualServer::get_singleton()->has_changed()) {
 				VisualServer::get_singleton()->draw(true, scaled_step); // flush visual commands
@@ -2058,6 +2100,14 @@ bool Main::iteration() {
 
 	AudioServer::get_singleton()->update();
 
+	performance->poll_metrics_export();
+
+	if (MemoryPool::memory_pool && pool_compaction_usec > 0) {
+		MemoryPool::memory_pool->compact_incremental(pool_compaction_usec);
+	}
+
+	ResourceCache::soft_cache_trim();
+
 	if (script_debugger) {
 		if (script_debugger->is_profiling()) {
 			script_debugger->profiling_set_frame_times(USEC_TO_SEC(frame_time), USEC_TO_SEC(idle_process_ticks), USEC_TO_SEC(physics_process_ticks), frame_slice);
@@ -2088,6 +2138,11 @@ bool Main::iteration() {
 		frames = 0;
 	}
 
+	// nested iterations (e.g. progress dialogs) run inside callers that may still hold frame data
+	if (iterating == 1) {
+		FrameArena::reset();
+	}
+
 	iterating--;
 
 	if (fixed_fps != -1)
@@ -2146,8 +2201,13 @@ void Main::cleanup() {
 		script_debugger->idle_poll();
 	}
 
+	if (timeline_path != "") {
+		TimelineProfiler::save_chrome_trace(timeline_path);
+	}
+
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
+	ResourceCache::clear_soft_cache();
 
 	message_queue->flush();
 	memdelete(message_queue);
@@ -2230,5 +2290,7 @@ void Main::cleanup() {
 	unregister_core_driver_types();
 	unregister_core_types();
 
+	TimelineProfiler::finish();
+
 	OS::get_singleton()->finalize_core();
 }
@@ -31,7 +31,10 @@
 #include "performance.h"
 
 #include "core/message_queue.h"
+#include "core/engine.h"
+#include "core/project_settings.h"
 #include "core/os/os.h"
+#include "core/os/timeline_profiler.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio_server.h"
@@ -44,6 +47,16 @@ Performance *Performance::singleton = NULL;
 void Performance::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_monitor", "monitor"), &Performance::get_monitor);
+	ClassDB::bind_method(D_METHOD("add_custom_monitor", "id", "object", "method", "args"), &Performance::add_custom_monitor, DEFVAL(Array()));
+	ClassDB::bind_method(D_METHOD("remove_custom_monitor", "id"), &Performance::remove_custom_monitor);
+	ClassDB::bind_method(D_METHOD("has_custom_monitor", "id"), &Performance::has_custom_monitor);
+	ClassDB::bind_method(D_METHOD("get_custom_monitor", "id"), &Performance::get_custom_monitor);
+	ClassDB::bind_method(D_METHOD("get_custom_monitor_names"), &Performance::get_custom_monitor_names);
+	ClassDB::bind_method(D_METHOD("get_monitor_modification_time"), &Performance::get_monitor_modification_time);
+	ClassDB::bind_method(D_METHOD("set_timeline_enabled", "enabled"), &Performance::set_timeline_enabled);
+	ClassDB::bind_method(D_METHOD("is_timeline_enabled"), &Performance::is_timeline_enabled);
+	ClassDB::bind_method(D_METHOD("clear_timeline"), &Performance::clear_timeline);
+	ClassDB::bind_method(D_METHOD("save_timeline", "path"), &Performance::save_timeline);
 
 	BIND_ENUM_CONSTANT(TIME_FPS);
 	BIND_ENUM_CONSTANT(TIME_PROCESS);
@@ -74,6 +87,11 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(MEMORY_POOL_FREE_BLOCKS);
+	BIND_ENUM_CONSTANT(MEMORY_POOL_LARGEST_FREE_BLOCK);
+	BIND_ENUM_CONSTANT(MEMORY_POOL_COMPACTION_TIME);
+	BIND_ENUM_CONSTANT(RENDER_SERVER_COMMANDS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_SERVER_COMMAND_BYTES_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -120,6 +138,11 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/output_latency",
+		"memory/pool_free_blocks",
+		"memory/pool_largest_free_block",
+		"memory/pool_compaction_time",
+		"raster/server_commands",
+		"raster/server_command_bytes",
 
 	};
 
@@ -158,6 +181,11 @@ float Performance::get_monitor(Monitor p_monitor) const {
 		case PHYSICS_3D_COLLISION_PAIRS: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_COLLISION_PAIRS);
 		case PHYSICS_3D_ISLAND_COUNT: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY: return AudioServer::get_singleton()->get_output_latency();
+		case MEMORY_POOL_FREE_BLOCKS: return MemoryPool::memory_pool ? MemoryPool::memory_pool->get_free_block_count() : 0;
+		case MEMORY_POOL_LARGEST_FREE_BLOCK: return MemoryPool::memory_pool ? MemoryPool::memory_pool->get_largest_free_block() : 0;
+		case MEMORY_POOL_COMPACTION_TIME: return MemoryPool::memory_pool ? USEC_TO_SEC(MemoryPool::memory_pool->get_compaction_time_usec()) : 0;
+		case RENDER_SERVER_COMMANDS_IN_FRAME: return VS::get_singleton()->get_render_info(VS::INFO_SERVER_COMMANDS_IN_FRAME);
+		case RENDER_SERVER_COMMAND_BYTES_IN_FRAME: return VS::get_singleton()->get_render_info(VS::INFO_SERVER_COMMAND_BYTES_IN_FRAME);
 
 		default: {
 		}
@@ -200,6 +228,11 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
@@ -216,9 +249,242 @@ void Performance::set_physics_process_time(float p_pt) {
 	_physics_process_time = p_pt;
 }
 
+void Performance::set_timeline_enabled(bool p_enabled) {
+
+	TimelineProfiler::set_enabled(p_enabled);
+}
+
+bool Performance::is_timeline_enabled() const {
+
+	return TimelineProfiler::is_enabled();
+}
+
+void Performance::clear_timeline() {
+
+	TimelineProfiler::clear();
+}
+
+Error Performance::save_timeline(const String &p_path) const {
+
+	return TimelineProfiler::save_chrome_trace(p_path);
+}
+
+void Performance::add_custom_monitor(const String &p_id, Object *p_object, const StringName &p_method, const Array &p_args) {
+
+	ERR_FAIL_NULL(p_object);
+	ERR_FAIL_COND_MSG(p_id.get_slice_count("/") != 2, "Custom monitor ID must have the form 'category/name': " + p_id + ".");
+
+	MutexLock lock(custom_monitors_mutex);
+	ERR_FAIL_COND_MSG(custom_monitors.has(p_id), "Custom monitor with ID '" + p_id + "' already exists.");
+
+	CustomMonitor monitor;
+	monitor.object = p_object->get_instance_id();
+	monitor.method = p_method;
+	monitor.args = p_args;
+	monitor.counter = NULL;
+	custom_monitors[p_id] = monitor;
+	custom_monitors_modified = OS::get_singleton()->get_ticks_usec();
+}
+
+Performance::Counter *Performance::add_custom_counter(const String &p_id) {
+
+	ERR_FAIL_COND_V_MSG(p_id.get_slice_count("/") != 2, NULL, "Custom monitor ID must have the form 'category/name': " + p_id + ".");
+
+	MutexLock lock(custom_monitors_mutex);
+	ERR_FAIL_COND_V_MSG(custom_monitors.has(p_id), NULL, "Custom monitor with ID '" + p_id + "' already exists.");
+
+	CustomMonitor monitor;
+	monitor.object = 0;
+	monitor.counter = memnew(Counter);
+	custom_monitors[p_id] = monitor;
+	custom_monitors_modified = OS::get_singleton()->get_ticks_usec();
+
+	return monitor.counter;
+}
+
+void Performance::remove_custom_monitor(const String &p_id) {
+
+	MutexLock lock(custom_monitors_mutex);
+
+	Map<String, CustomMonitor>::Element *E = custom_monitors.find(p_id);
+	ERR_FAIL_COND_MSG(!E, "Custom monitor with ID '" + p_id + "' doesn't exist.");
+
+	if (E->get().counter) {
+		memdelete(E->get().counter);
+	}
+	custom_monitors.erase(E);
+	custom_monitors_modified = OS::get_singleton()->get_ticks_usec();
+}
+
+bool Performance::has_custom_monitor(const String &p_id) {
+
+	MutexLock lock(custom_monitors_mutex);
+	return custom_monitors.has(p_id);
+}
+
+float Performance::get_custom_monitor(const String &p_id) {
+
+	CustomMonitor monitor;
+	{
+		MutexLock lock(custom_monitors_mutex);
+		Map<String, CustomMonitor>::Element *E = custom_monitors.find(p_id);
+		ERR_FAIL_COND_V_MSG(!E, 0, "Custom monitor with ID '" + p_id + "' doesn't exist.");
+		if (E->get().counter) {
+			return E->get().counter->get();
+		}
+		monitor = E->get();
+	}
+
+	// Called without the lock held, so the callback may add or remove monitors.
+	Object *obj = ObjectDB::get_instance(monitor.object);
+	if (!obj) {
+		return 0;
+	}
+
+	Variant ret = obj->callv(monitor.method, monitor.args);
+	ERR_FAIL_COND_V_MSG(ret.get_type() != Variant::INT && ret.get_type() != Variant::REAL && ret.get_type() != Variant::BOOL, 0, "Custom monitor '" + p_id + "' must return a number.");
+	return ret;
+}
+
+Array Performance::get_custom_monitor_names() {
+
+	MutexLock lock(custom_monitors_mutex);
+
+	Array names;
+	for (Map<String, CustomMonitor>::Element *E = custom_monitors.front(); E; E = E->next()) {
+		names.push_back(E->key());
+	}
+	return names;
+}
+
+uint64_t Performance::get_monitor_modification_time() const {
+
+	return custom_monitors_modified;
+}
+
+static String _metric_name(const String &p_id) {
+
+	String name = "godot_" + p_id;
+	CharType *w = name.ptrw();
+	for (int i = 0; i < name.length(); i++) {
+		CharType c = w[i];
+		if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_')) {
+			w[i] = '_';
+		}
+	}
+	return name;
+}
+
+String Performance::_get_metrics_text() {
+
+	String text;
+
+	for (int i = 0; i < MONITOR_MAX; i++) {
+		String name = _metric_name(get_monitor_name(Monitor(i)));
+		text += "# TYPE " + name + " gauge\n";
+		text += name + " " + rtos(get_monitor(Monitor(i))) + "\n";
+	}
+
+	Array names = get_custom_monitor_names();
+	for (int i = 0; i < names.size(); i++) {
+		String name = _metric_name(names[i]);
+		text += "# TYPE " + name + " gauge\n";
+		text += name + " " + rtos(get_custom_monitor(names[i])) + "\n";
+	}
+
+	return text;
+}
+
+void Performance::poll_metrics_export() {
+
+	if (!metrics_export_started) {
+		metrics_export_started = true;
+
+		int port = GLOBAL_GET("debug/settings/metrics/export_port");
+		if (port <= 0 || Engine::get_singleton()->is_editor_hint()) {
+			return;
+		}
+
+		metrics_server.instance();
+		String bind_address = GLOBAL_GET("debug/settings/metrics/export_bind_address");
+		Error err = metrics_server->listen(port, IP_Address(bind_address));
+		if (err != OK) {
+			metrics_server.unref();
+			ERR_FAIL_MSG("Can't listen for metrics requests on port " + itos(port) + ".");
+		}
+		print_verbose("Performance: Serving metrics on port " + itos(port) + ".");
+	}
+
+	if (metrics_server.is_null()) {
+		return;
+	}
+
+	uint64_t time = OS::get_singleton()->get_ticks_msec();
+
+	while (metrics_server->is_connection_available() && metrics_clients.size() < 16) {
+		MetricsClient client;
+		client.peer = metrics_server->take_connection();
+		client.time = time;
+		metrics_clients.push_back(client);
+	}
+
+	List<MetricsClient>::Element *E = metrics_clients.front();
+	while (E) {
+		List<MetricsClient>::Element *N = E->next();
+		MetricsClient &client = E->get();
+
+		bool done = client.peer->get_status() != StreamPeerTCP::STATUS_CONNECTED || time - client.time > 5000 || client.request.length() > 4096;
+
+		int available = done ? 0 : client.peer->get_available_bytes();
+		if (available > 0) {
+			Vector<uint8_t> data;
+			data.resize(available);
+			int received = 0;
+			client.peer->get_partial_data(data.ptrw(), available, received);
+			String chunk;
+			chunk.parse_utf8((const char *)data.ptr(), received);
+			client.request += chunk;
+		}
+
+		if (!done && client.request.find("\r\n\r\n") != -1) {
+			// Any path is answered, scrapers usually ask for /metrics.
+			CharString body = _get_metrics_text().utf8();
+			CharString header = ("HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " + itos(body.length()) + "\r\nConnection: close\r\n\r\n").utf8();
+			client.peer->put_data((const uint8_t *)header.get_data(), header.length());
+			client.peer->put_data((const uint8_t *)body.get_data(), body.length());
+			done = true;
+		}
+
+		if (done) {
+			client.peer->disconnect_from_host();
+			metrics_clients.erase(E);
+		}
+		E = N;
+	}
+}
+
 Performance::Performance() {
 
 	_process_time = 0;
 	_physics_process_time = 0;
+	custom_monitors_modified = 0;
+	custom_monitors_mutex = Mutex::create();
+	metrics_export_started = false;
 	singleton = this;
 }
+
+Performance::~Performance() {
+
+	for (Map<String, CustomMonitor>::Element *E = custom_monitors.front(); E; E = E->next()) {
+		if (E->get().counter) {
+			memdelete(E->get().counter);
+		}
+	}
+
+	metrics_clients.clear();
+	if (metrics_server.is_valid()) {
+		metrics_server->stop();
+	}
+
+	memdelete(custom_monitors_mutex);
+}
@@ -31,7 +31,11 @@
 #ifndef PERFORMANCE_H
 #define PERFORMANCE_H
 
+#include "core/io/stream_peer_tcp.h"
+#include "core/io/tcp_server.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
+#include "core/safe_refcount.h"
 
 #define PERF_WARN_OFFLINE_FUNCTION
 #define PERF_WARN_PROCESS_SYNC
@@ -48,6 +52,43 @@ class Performance : public Object {
 	float _process_time;
 	float _physics_process_time;
 
+public:
+	// Counter for custom monitors fed from C++, safe to update from any thread.
+	struct Counter {
+
+		SafeNumeric<uint64_t> value; //two's complement, so negative amounts work too
+
+		_FORCE_INLINE_ void add(int64_t p_amount) { value.add((uint64_t)p_amount); }
+		_FORCE_INLINE_ void set(int64_t p_value) { value.set((uint64_t)p_value); }
+		_FORCE_INLINE_ int64_t get() const { return (int64_t)value.get(); }
+	};
+
+private:
+	struct CustomMonitor {
+
+		ObjectID object;
+		StringName method;
+		Array args;
+		Counter *counter;
+	};
+
+	Map<String, CustomMonitor> custom_monitors;
+	uint64_t custom_monitors_modified;
+	Mutex *custom_monitors_mutex;
+
+	struct MetricsClient {
+
+		Ref<StreamPeerTCP> peer;
+		uint64_t time;
+		String request;
+	};
+
+	bool metrics_export_started;
+	Ref<TCP_Server> metrics_server;
+	List<MetricsClient> metrics_clients;
+
+	String _get_metrics_text();
+
 public:
 	enum Monitor {
 
@@ -81,6 +122,11 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		MEMORY_POOL_FREE_BLOCKS,
+		MEMORY_POOL_LARGEST_FREE_BLOCK,
+		MEMORY_POOL_COMPACTION_TIME,
+		RENDER_SERVER_COMMANDS_IN_FRAME,
+		RENDER_SERVER_COMMAND_BYTES_IN_FRAME,
 		MONITOR_MAX
 	};
 
@@ -98,9 +144,25 @@ public:
 	void set_process_time(float p_pt);
 	void set_physics_process_time(float p_pt);
 
+	void set_timeline_enabled(bool p_enabled);
+	bool is_timeline_enabled() const;
+	void clear_timeline();
+	Error save_timeline(const String &p_path) const;
+
+	void add_custom_monitor(const String &p_id, Object *p_object, const StringName &p_method, const Array &p_args = Array());
+	Counter *add_custom_counter(const String &p_id); // Owned by Performance, valid until the monitor is removed.
+	void remove_custom_monitor(const String &p_id);
+	bool has_custom_monitor(const String &p_id);
+	float get_custom_monitor(const String &p_id);
+	Array get_custom_monitor_names();
+	uint64_t get_monitor_modification_time() const;
+
+	void poll_metrics_export();
+
 	static Performance *get_singleton() { return singleton; }
 
 	Performance();
+	~Performance();
 };
 
 VARIANT_ENUM_CAST(Performance::Monitor);
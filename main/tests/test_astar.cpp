@@ -31,6 +31,7 @@
 #include "test_astar.h"
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 #include "core/math/math_funcs.h"
 #include "core/os/os.h"
 
@@ -344,6 +345,143 @@ bool test_solutions() {
 	return true;
 }
 
+// Reference distances on the grid, relaxing every cell until nothing changes
+static void grid_distances(const AStarGrid2D &g, int w, int h, int from, bool weights, float *d) {
+	for (int i = 0; i < w * h; i++)
+		d[i] = INFINITY;
+	d[from] = 0;
+
+	AStarGrid2D::DiagonalMode mode = g.get_diagonal_mode();
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (int u = 0; u < w * h; u++) {
+			if (Math::is_inf(d[u])) continue;
+			int x = u % w, y = u / w;
+			for (int dy = -1; dy <= 1; dy++)
+				for (int dx = -1; dx <= 1; dx++) {
+					int nx = x + dx, ny = y + dy;
+					if ((!dx && !dy) || !g.is_in_bounds(nx, ny) || g.is_point_solid(Vector2(nx, ny))) continue;
+					if (dx && dy) {
+						if (mode == AStarGrid2D::DIAGONAL_MODE_NEVER) continue;
+						if (mode == AStarGrid2D::DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES && (g.is_point_solid(Vector2(nx, y)) || g.is_point_solid(Vector2(x, ny)))) continue;
+					}
+					float cost = d[u] + Math::sqrt((float)(dx * dx + dy * dy)) * (weights ? g.get_point_weight_scale(Vector2(nx, ny)) : 1);
+					if (cost < d[ny * w + nx] - CMP_EPSILON) {
+						d[ny * w + nx] = cost;
+						changed = true;
+					}
+				}
+		}
+	}
+}
+
+// Returns the cost of the path, or -1 if it isn't made of valid moves
+static float grid_path_cost(const AStarGrid2D &g, const PoolVector<Vector2> &p_path, bool weights) {
+	float cost = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		Vector2 from = p_path[i - 1], to = p_path[i];
+		int dx = to.x - from.x, dy = to.y - from.y;
+		if (ABS(dx) > 1 || ABS(dy) > 1 || (!dx && !dy) || g.is_point_solid(to)) return -1;
+		if (dx && dy) {
+			if (g.get_diagonal_mode() == AStarGrid2D::DIAGONAL_MODE_NEVER) return -1;
+			if (g.get_diagonal_mode() == AStarGrid2D::DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES && (g.is_point_solid(Vector2(to.x, from.y)) || g.is_point_solid(Vector2(from.x, to.y)))) return -1;
+		}
+		cost += Math::sqrt((float)(dx * dx + dy * dy)) * (weights ? g.get_point_weight_scale(to) : 1);
+	}
+	return cost;
+}
+
+bool test_grid_solutions() {
+	// Random grids against the reference distances, with plain, jumping and hierarchical searches
+
+	Math::seed(0);
+
+	for (int test = 0; test < 600; test++) {
+		Ref<AStarGrid2D> g;
+		g.instance();
+		int w = 4 + Math::rand() % 30;
+		int h = 4 + Math::rand() % 30;
+		g->set_size(Vector2(w, h));
+		g->set_diagonal_mode((AStarGrid2D::DiagonalMode)(test % 3));
+
+		int density = Math::rand() % 40;
+		for (int i = 0; i < w * h; i++)
+			if ((int)(Math::rand() % 100) < density) g->set_point_solid(Vector2(i % w, i / w));
+
+		int kind = (test / 3) % 3;
+		if (kind == 1) g->set_jumping_enabled(true);
+		if (kind == 2) g->set_cluster_size(2 + Math::rand() % 10);
+		bool weights = kind != 1 && test % 5 == 0;
+		if (weights)
+			for (int i = 0; i < w * h; i++)
+				if (Math::rand() % 4 == 0) g->set_point_weight_scale(Vector2(i % w, i / w), 1 + Math::rand() % 5);
+
+		int from = Math::rand() % (w * h), to = Math::rand() % (w * h);
+		g->set_point_solid(Vector2(from % w, from / w), false);
+		g->set_point_solid(Vector2(to % w, to / w), false);
+
+		Vector<float> d;
+		d.resize(w * h);
+		grid_distances(**g, w, h, from, weights, d.ptrw());
+
+		PoolVector<Vector2> path = g->get_id_path(Vector2(from % w, from / w), Vector2(to % w, to / w));
+		if (Math::is_inf(d[to])) {
+			if (path.size() > 0) {
+				printf("Grid test #%d: found a nonexistent path\n", test + 1);
+				return false;
+			}
+			continue;
+		}
+		if (path.size() == 0 || path[0] != Vector2(from % w, from / w) || path[path.size() - 1] != Vector2(to % w, to / w)) {
+			printf("Grid test #%d: did not find a path\n", test + 1);
+			return false;
+		}
+
+		float cost = grid_path_cost(**g, path, weights);
+		if (cost < 0) {
+			printf("Grid test #%d: path has an invalid move\n", test + 1);
+			return false;
+		}
+		// Hierarchical paths are only near-optimal
+		if ((kind == 2 && cost < d[to] - 0.001) || (kind != 2 && !Math::is_equal_approx(cost, d[to], (float)0.001))) {
+			printf("Grid test #%d: reference gives %.6f, AStarGrid2D gives %.6f\n", test + 1, d[to], cost);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool test_grid_benchmark() {
+	const int N = 1024;
+	const char *names[] = { "plain", "jumping", "clusters" };
+
+	for (int kind = 0; kind < 3; kind++) {
+		Ref<AStarGrid2D> g;
+		g.instance();
+		g->set_size(Vector2(N, N));
+		Math::seed(5);
+		for (int i = 0; i < N * N / 5; i++) {
+			int c = Math::rand() % (N * N);
+			g->set_point_solid(Vector2(c % N, c / N));
+		}
+		g->set_point_solid(Vector2(0, 0), false);
+		g->set_point_solid(Vector2(N - 1, N - 1), false);
+		g->set_jumping_enabled(kind > 0);
+		g->set_cluster_size(kind == 2 ? 32 : 0);
+
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		PoolVector<Vector2> path = g->get_id_path(Vector2(0, 0), Vector2(N - 1, N - 1));
+		uint64_t first = OS::get_singleton()->get_ticks_usec();
+		g->get_id_path(Vector2(0, 0), Vector2(N - 1, N - 1));
+		uint64_t second = OS::get_singleton()->get_ticks_usec();
+
+		printf("%dx%d %s: %d cells, first query %.1f ms, second query %.1f ms\n", N, N, names[kind], path.size(), (first - start) / 1000.0, (second - first) / 1000.0);
+		if (path.size() == 0) return false;
+	}
+	return true;
+}
+
 typedef bool (*TestFunc)(void);
 
 TestFunc test_funcs[] = {
@@ -351,6 +489,8 @@ TestFunc test_funcs[] = {
 	test_abcx,
 	test_add_remove,
 	test_solutions,
+	test_grid_solutions,
+	test_grid_benchmark,
 	NULL
 };
 
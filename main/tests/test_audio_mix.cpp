@@ -0,0 +1,225 @@
+/*************************************************************************/
+/*  test_audio_mix.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_audio_mix.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/vector.h"
+#include "servers/audio/audio_mix.h"
+
+namespace TestAudioMix {
+
+enum {
+	FRAC_BITS = 16,
+	BENCH_FRAMES = 1024,
+	BENCH_ROUNDS = 20000,
+};
+
+static bool _check(bool p_ok, const char *p_what) {
+
+	OS::get_singleton()->print("%s: %s\n", p_what, p_ok ? "ok" : "FAILED");
+	return p_ok;
+}
+
+static bool _match(const Vector<AudioFrame> &p_a, const Vector<AudioFrame> &p_b, float p_tolerance) {
+
+	for (int i = 0; i < p_a.size(); i++) {
+		if (Math::abs(p_a[i].l - p_b[i].l) > p_tolerance || Math::abs(p_a[i].r - p_b[i].r) > p_tolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static Vector<AudioFrame> _noise(int p_frames) {
+
+	Vector<AudioFrame> frames;
+	frames.resize(p_frames);
+	for (int i = 0; i < p_frames; i++) {
+		frames.write[i] = AudioFrame(Math::random(-1.0f, 1.0f), Math::random(-1.0f, 1.0f));
+	}
+	return frames;
+}
+
+// Scalar versions of the kernels, as the mixing loops were written before.
+
+static void _add_ramp_scalar(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, AudioFrame p_vol, const AudioFrame &p_vol_inc) {
+
+	for (int i = 0; i < p_frames; i++) {
+		p_dst[i] += p_src[i] * p_vol;
+		p_vol += p_vol_inc;
+	}
+}
+
+static void _resample_cubic_scalar(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, uint64_t &r_offset, uint64_t p_increment) {
+
+	for (int i = 0; i < p_frames; i++) {
+
+		uint32_t idx = uint32_t(r_offset >> FRAC_BITS);
+		float mu = (r_offset & ((1 << FRAC_BITS) - 1)) / float(1 << FRAC_BITS);
+		AudioFrame y0 = p_src[idx + 0];
+		AudioFrame y1 = p_src[idx + 1];
+		AudioFrame y2 = p_src[idx + 2];
+		AudioFrame y3 = p_src[idx + 3];
+
+		float mu2 = mu * mu;
+		AudioFrame a0 = y3 - y2 - y0 + y1;
+		AudioFrame a1 = y0 - y1 - a0;
+		AudioFrame a2 = y2 - y0;
+		AudioFrame a3 = y1;
+
+		p_dst[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3);
+		r_offset += p_increment;
+	}
+}
+
+MainLoop *test() {
+
+	OS::get_singleton()->print("\n\n\nHello from test\n");
+
+	Math::seed(7);
+
+	// every kernel against the scalar loops, with lengths covering the vector tails
+	{
+		bool add_ok = true;
+		bool ramp_ok = true;
+		bool scale_ok = true;
+		bool peak_ok = true;
+		bool resample_ok = true;
+
+		for (int n = 0; n < 37; n++) {
+
+			Vector<AudioFrame> src = _noise(n);
+			Vector<AudioFrame> dst = _noise(n);
+
+			Vector<AudioFrame> expected = dst;
+			Vector<AudioFrame> result = dst;
+			for (int i = 0; i < n; i++) {
+				expected.write[i] += src[i];
+			}
+			AudioMix::add(result.ptrw(), src.ptr(), n);
+			add_ok = add_ok && _match(expected, result, 1e-6);
+
+			expected = dst;
+			result = dst;
+			_add_ramp_scalar(expected.ptrw(), src.ptr(), n, AudioFrame(0.25, 1.0), AudioFrame(0.01, -0.02));
+			AudioMix::add_ramp(result.ptrw(), src.ptr(), n, AudioFrame(0.25, 1.0), AudioFrame(0.01, -0.02));
+			ramp_ok = ramp_ok && _match(expected, result, 1e-5);
+
+			expected = dst;
+			result = dst;
+			float vol = 0.5;
+			for (int i = 0; i < n; i++) {
+				expected.write[i] *= vol;
+				vol += 0.015;
+			}
+			AudioMix::scale_ramp(result.ptrw(), n, 0.5, 0.015);
+			scale_ok = scale_ok && _match(expected, result, 1e-5);
+
+			AudioFrame peak = AudioFrame(0, 0);
+			expected = dst;
+			result = dst;
+			for (int i = 0; i < n; i++) {
+				expected.write[i] *= 0.75;
+				peak.l = MAX(peak.l, Math::abs(expected[i].l));
+				peak.r = MAX(peak.r, Math::abs(expected[i].r));
+			}
+			AudioFrame result_peak = AudioMix::scale_peak(result.ptrw(), n, 0.75);
+			peak_ok = peak_ok && _match(expected, result, 0) && result_peak.l == peak.l && result_peak.r == peak.r;
+
+			//a rate that does not divide the fixed point length, plus an unaligned start
+			Vector<AudioFrame> input = _noise(n * 2 + 4);
+			uint64_t increment = uint64_t(1.37 * (1 << FRAC_BITS));
+			uint64_t expected_offset = 12345;
+			uint64_t result_offset = 12345;
+			expected.resize(n);
+			result.resize(n);
+			_resample_cubic_scalar(expected.ptrw(), input.ptr(), n, expected_offset, increment);
+			AudioMix::resample_cubic(result.ptrw(), input.ptr(), n, result_offset, increment, FRAC_BITS);
+			resample_ok = resample_ok && _match(expected, result, 1e-5) && expected_offset == result_offset;
+		}
+
+		_check(add_ok, "add");
+		_check(ramp_ok, "add_ramp");
+		_check(scale_ok, "scale_ramp");
+		_check(peak_ok, "scale_peak");
+		_check(resample_ok, "resample_cubic");
+	}
+
+	// timings, one buffer of the default mix size over and over
+	{
+		Vector<AudioFrame> src = _noise(BENCH_FRAMES * 2 + 4);
+		Vector<AudioFrame> dst = _noise(BENCH_FRAMES);
+		AudioFrame *d = dst.ptrw();
+		const AudioFrame *s = src.ptr();
+		uint64_t increment = uint64_t(1.09 * (1 << FRAC_BITS)); // 48000 / 44100
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < BENCH_ROUNDS; r++) {
+			_add_ramp_scalar(d, s, BENCH_FRAMES, AudioFrame(0.5, 0.5), AudioFrame(0.000001, -0.000001));
+		}
+		uint64_t ramp_scalar = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < BENCH_ROUNDS; r++) {
+			AudioMix::add_ramp(d, s, BENCH_FRAMES, AudioFrame(0.5, 0.5), AudioFrame(0.000001, -0.000001));
+		}
+		uint64_t ramp_kernel = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < BENCH_ROUNDS; r++) {
+			AudioMix::scale_peak(d, BENCH_FRAMES, 0.999);
+		}
+		uint64_t peak_kernel = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < BENCH_ROUNDS; r++) {
+			uint64_t offset = 0;
+			_resample_cubic_scalar(d, s, BENCH_FRAMES, offset, increment);
+		}
+		uint64_t resample_scalar = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < BENCH_ROUNDS; r++) {
+			uint64_t offset = 0;
+			AudioMix::resample_cubic(d, s, BENCH_FRAMES, offset, increment, FRAC_BITS);
+		}
+		uint64_t resample_kernel = OS::get_singleton()->get_ticks_usec() - begin;
+
+		OS::get_singleton()->print("%d buffers of %d frames, scalar / kernel (usec):\n", int(BENCH_ROUNDS), int(BENCH_FRAMES));
+		OS::get_singleton()->print("\tadd_ramp       %d / %d\n", int(ramp_scalar), int(ramp_kernel));
+		OS::get_singleton()->print("\tscale_peak     - / %d\n", int(peak_kernel));
+		OS::get_singleton()->print("\tresample_cubic %d / %d\n", int(resample_scalar), int(resample_kernel));
+	}
+
+	return NULL;
+}
+} // namespace TestAudioMix
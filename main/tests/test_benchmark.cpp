@@ -0,0 +1,747 @@
+/*************************************************************************/
+/*  test_benchmark.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_benchmark.h"
+
+#include "core/engine.h"
+#include "core/hash_map.h"
+#include "core/io/json.h"
+#include "core/math/camera_matrix.h"
+#include "core/math/random_pcg.h"
+#include "core/oa_hash_map.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/script_language.h"
+#include "scene/2d/node_2d.h"
+#include "scene/resources/packed_scene.h"
+#include "servers/physics_2d_server.h"
+#include "servers/physics_server.h"
+#include "servers/visual_server.h"
+
+namespace TestBenchmark {
+
+// A benchmark repeats the same workload once per iteration.
+// Setup, teardown and the reset before each iteration are not measured.
+class Benchmark {
+public:
+	virtual const char *get_name() const = 0;
+	// Work items done by one iteration, used to report the time per item.
+	virtual int get_operations() const { return 1; }
+
+	// Returning false skips the benchmark, e.g. when a server or module is missing.
+	virtual bool setup() { return true; }
+	virtual void reset() {}
+	virtual void run() = 0;
+	virtual void teardown() {}
+
+	virtual ~Benchmark() {}
+};
+
+struct Result {
+	String name;
+	int iterations;
+	int operations;
+	// In microseconds per iteration.
+	double min;
+	double max;
+	double mean;
+	double median;
+	double stddev;
+};
+
+/* CONTAINERS */
+
+static const int CONTAINER_KEYS = 100000;
+
+typedef HashMap<int, int> IntHashMap;
+typedef OAHashMap<int, int> IntOAHashMap;
+
+static Vector<int> _make_keys(int p_count, uint64_t p_seed) {
+
+	RandomPCG rng(p_seed);
+	Vector<int> keys;
+	keys.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		keys.write[i] = rng.rand() & 0x7FFFFFFF;
+	}
+	return keys;
+}
+
+static _FORCE_INLINE_ const int *_map_find(const IntHashMap &p_map, int p_key) {
+	return p_map.getptr(p_key);
+}
+
+static _FORCE_INLINE_ const int *_map_find(const IntOAHashMap &p_map, int p_key) {
+	return p_map.lookup_ptr(p_key);
+}
+
+template <class M>
+class MapInsert : public Benchmark {
+
+	const char *name;
+	Vector<int> keys;
+
+public:
+	virtual const char *get_name() const { return name; }
+	virtual int get_operations() const { return keys.size(); }
+
+	virtual bool setup() {
+		keys = _make_keys(CONTAINER_KEYS, 1);
+		return true;
+	}
+
+	virtual void run() {
+		M map;
+		for (int i = 0; i < keys.size(); i++) {
+			map.set(keys[i], i);
+		}
+	}
+
+	MapInsert(const char *p_name) :
+			name(p_name) {}
+};
+
+template <class M>
+class MapLookup : public Benchmark {
+
+	const char *name;
+	M map;
+	Vector<int> keys;
+	int found;
+
+public:
+	virtual const char *get_name() const { return name; }
+	virtual int get_operations() const { return keys.size(); }
+
+	virtual bool setup() {
+		keys = _make_keys(CONTAINER_KEYS, 2);
+		// Only every other key is present, so half of the lookups miss.
+		for (int i = 0; i < keys.size(); i += 2) {
+			map.set(keys[i], i);
+		}
+		return true;
+	}
+
+	virtual void run() {
+		int count = 0;
+		for (int i = 0; i < keys.size(); i++) {
+			if (_map_find(map, keys[i])) {
+				count++;
+			}
+		}
+		found = count;
+	}
+
+	MapLookup(const char *p_name) :
+			name(p_name),
+			found(0) {}
+};
+
+/* VARIANT */
+
+class VariantEvaluate : public Benchmark {
+
+	enum {
+		EVALUATIONS = 100000
+	};
+
+	const char *name;
+	Variant::Operator op;
+	Variant a;
+	Variant b;
+	Variant ret;
+
+public:
+	virtual const char *get_name() const { return name; }
+	virtual int get_operations() const { return EVALUATIONS; }
+
+	virtual void run() {
+		bool valid;
+		for (int i = 0; i < EVALUATIONS; i++) {
+			Variant::evaluate(op, a, b, ret, valid);
+		}
+	}
+
+	VariantEvaluate(const char *p_name, Variant::Operator p_op, const Variant &p_a, const Variant &p_b) :
+			name(p_name),
+			op(p_op),
+			a(p_a),
+			b(p_b) {}
+};
+
+/* SCRIPTS */
+
+class ScriptRun : public Benchmark {
+
+	const char *name;
+	String language;
+	String code;
+	int operations;
+	Ref<Script> script;
+	Object *object;
+	Variant ret;
+
+public:
+	virtual const char *get_name() const { return name; }
+	virtual int get_operations() const { return operations; }
+
+	virtual bool setup() {
+
+		ScriptLanguage *lang = NULL;
+		for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+			if (ScriptServer::get_language(i)->get_name() == language) {
+				lang = ScriptServer::get_language(i);
+			}
+		}
+		if (!lang) {
+			return false;
+		}
+
+		script = Ref<Script>(lang->create_script());
+		script->set_source_code(code);
+		ERR_FAIL_COND_V_MSG(script->reload() != OK, false, "Benchmark script failed to compile.");
+
+		object = memnew(Object);
+		object->set_script(script.get_ref_ptr());
+		return true;
+	}
+
+	virtual void run() {
+		ret = object->call("run");
+	}
+
+	virtual void teardown() {
+		if (object) {
+			memdelete(object);
+			object = NULL;
+		}
+		script.unref();
+	}
+
+	ScriptRun(const char *p_name, const String &p_language, const String &p_code, int p_operations) :
+			name(p_name),
+			language(p_language),
+			code(p_code),
+			operations(p_operations),
+			object(NULL) {}
+};
+
+static const char *gdscript_loop_code =
+		"extends Object\n"
+		"\n"
+		"func run():\n"
+		"\tvar total = 0\n"
+		"\tfor i in range(100000):\n"
+		"\t\ttotal += i * 2\n"
+		"\treturn total\n";
+
+static const char *gdscript_call_code =
+		"extends Object\n"
+		"\n"
+		"func add(a, b):\n"
+		"\treturn a + b\n"
+		"\n"
+		"func run():\n"
+		"\tvar total = 0\n"
+		"\tfor i in range(20000):\n"
+		"\t\ttotal = add(total, i)\n"
+		"\treturn total\n";
+
+/* PHYSICS */
+
+class PhysicsStacking : public Benchmark {
+
+	enum {
+		STACKS = 8,
+		STACK_HEIGHT = 10,
+		STEPS = 60
+	};
+
+	RID space;
+	RID ground_shape;
+	RID box_shape;
+	RID ground;
+	Vector<RID> boxes;
+	Vector<Transform> start;
+
+public:
+	virtual const char *get_name() const { return "physics/3d_stacking"; }
+	virtual int get_operations() const { return STEPS; }
+
+	virtual bool setup() {
+
+		PhysicsServer *ps = PhysicsServer::get_singleton();
+		ERR_FAIL_COND_V(!ps, false);
+		ps->set_active(true);
+
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		ground_shape = ps->shape_create(PhysicsServer::SHAPE_PLANE);
+		ps->shape_set_data(ground_shape, Plane(Vector3(0, 1, 0), 0));
+		ground = ps->body_create(PhysicsServer::BODY_MODE_STATIC);
+		ps->body_add_shape(ground, ground_shape);
+		ps->body_set_space(ground, space);
+
+		box_shape = ps->shape_create(PhysicsServer::SHAPE_BOX);
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+		for (int i = 0; i < STACKS; i++) {
+			for (int j = 0; j < STACK_HEIGHT; j++) {
+				RID box = ps->body_create(PhysicsServer::BODY_MODE_RIGID);
+				ps->body_add_shape(box, box_shape);
+				ps->body_set_space(box, space);
+				boxes.push_back(box);
+				start.push_back(Transform(Basis(), Vector3(i * 3.0, 0.5 + j * 1.01, 0)));
+			}
+		}
+
+		return true;
+	}
+
+	virtual void reset() {
+
+		PhysicsServer *ps = PhysicsServer::get_singleton();
+		for (int i = 0; i < boxes.size(); i++) {
+			ps->body_set_state(boxes[i], PhysicsServer::BODY_STATE_TRANSFORM, start[i]);
+			ps->body_set_state(boxes[i], PhysicsServer::BODY_STATE_LINEAR_VELOCITY, Vector3());
+			ps->body_set_state(boxes[i], PhysicsServer::BODY_STATE_ANGULAR_VELOCITY, Vector3());
+			ps->body_set_state(boxes[i], PhysicsServer::BODY_STATE_SLEEPING, false);
+		}
+	}
+
+	virtual void run() {
+
+		PhysicsServer *ps = PhysicsServer::get_singleton();
+		for (int i = 0; i < STEPS; i++) {
+			ps->sync();
+			ps->flush_queries();
+			ps->step(1.0 / 60.0);
+		}
+	}
+
+	virtual void teardown() {
+
+		PhysicsServer *ps = PhysicsServer::get_singleton();
+		for (int i = 0; i < boxes.size(); i++) {
+			ps->free(boxes[i]);
+		}
+		boxes.clear();
+		ps->free(ground);
+		ps->free(box_shape);
+		ps->free(ground_shape);
+		ps->free(space);
+	}
+};
+
+/* CULLING */
+
+class Cull3D : public Benchmark {
+
+	enum {
+		INSTANCES = 20000,
+		QUERIES = 1000
+	};
+
+	bool frustum;
+	RID scenario;
+	RID mesh;
+	Vector<RID> instances;
+	Vector<AABB> boxes;
+	Vector<Vector<Plane> > frustums;
+	int culled;
+
+public:
+	virtual const char *get_name() const { return frustum ? "cull/3d_frustum" : "cull/3d_aabb"; }
+	virtual int get_operations() const { return QUERIES; }
+
+	virtual bool setup() {
+
+		VisualServer *vs = VisualServer::get_singleton();
+		ERR_FAIL_COND_V(!vs, false);
+
+		RandomPCG rng(3);
+		scenario = vs->scenario_create();
+		mesh = vs->mesh_create();
+
+		for (int i = 0; i < INSTANCES; i++) {
+			RID instance = vs->instance_create2(mesh, scenario);
+			Vector3 size = Vector3(1, 1, 1) * (1 + rng.randf() * 4);
+			vs->instance_set_custom_aabb(instance, AABB(-size * 0.5, size));
+			vs->instance_set_transform(instance, Transform(Basis(), Vector3(rng.randf(), rng.randf(), rng.randf()) * 1000));
+			vs->instance_attach_object_instance_id(instance, i + 1);
+			instances.push_back(instance);
+		}
+
+		CameraMatrix projection;
+		projection.set_perspective(60, 1, 0.05, 200);
+
+		for (int i = 0; i < QUERIES; i++) {
+			Vector3 pos = Vector3(rng.randf(), rng.randf(), rng.randf()) * 1000;
+			if (frustum) {
+				Transform camera;
+				camera.origin = pos;
+				camera.basis.rotate(Vector3(0, 1, 0), rng.randf() * Math_TAU);
+				frustums.push_back(projection.get_projection_planes(camera));
+			} else {
+				boxes.push_back(AABB(pos, Vector3(50, 50, 50)));
+			}
+		}
+
+		return true;
+	}
+
+	virtual void run() {
+
+		VisualServer *vs = VisualServer::get_singleton();
+		int count = 0;
+		for (int i = 0; i < QUERIES; i++) {
+			if (frustum) {
+				count += vs->instances_cull_convex(frustums[i], scenario).size();
+			} else {
+				count += vs->instances_cull_aabb(boxes[i], scenario).size();
+			}
+		}
+		culled = count;
+	}
+
+	virtual void teardown() {
+
+		VisualServer *vs = VisualServer::get_singleton();
+		for (int i = 0; i < instances.size(); i++) {
+			vs->free(instances[i]);
+		}
+		instances.clear();
+		vs->free(mesh);
+		vs->free(scenario);
+	}
+
+	Cull3D(bool p_frustum) :
+			frustum(p_frustum),
+			culled(0) {}
+};
+
+// There is no query API for 2D rendering culling, so this measures the 2D
+// broadphase instead, which answers the same kind of rectangle queries.
+class Cull2D : public Benchmark {
+
+	enum {
+		BODIES = 10000,
+		QUERIES = 1000,
+		MAX_RESULTS = 64
+	};
+
+	RID space;
+	RID body_shape;
+	RID query_shape;
+	Vector<RID> bodies;
+	Vector<Transform2D> queries;
+	int culled;
+
+public:
+	virtual const char *get_name() const { return "cull/2d_broadphase"; }
+	virtual int get_operations() const { return QUERIES; }
+
+	virtual bool setup() {
+
+		Physics2DServer *ps = Physics2DServer::get_singleton();
+		ERR_FAIL_COND_V(!ps, false);
+		ps->set_active(true);
+
+		RandomPCG rng(4);
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		body_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(body_shape, Vector2(8, 8));
+		query_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(query_shape, Vector2(64, 64));
+
+		for (int i = 0; i < BODIES; i++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, Physics2DServer::BODY_MODE_STATIC);
+			ps->body_add_shape(body, body_shape);
+			ps->body_set_state(body, Physics2DServer::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(rng.randf(), rng.randf()) * 4096));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+
+		for (int i = 0; i < QUERIES; i++) {
+			queries.push_back(Transform2D(0, Vector2(rng.randf(), rng.randf()) * 4096));
+		}
+
+		// Let the server apply the pending shape updates.
+		ps->sync();
+		ps->flush_queries();
+		ps->end_sync();
+		ps->step(1.0 / 60.0);
+
+		return ps->space_get_direct_state(space) != NULL;
+	}
+
+	virtual void run() {
+
+		Physics2DDirectSpaceState *state = Physics2DServer::get_singleton()->space_get_direct_state(space);
+		Physics2DDirectSpaceState::ShapeResult results[MAX_RESULTS];
+		int count = 0;
+		for (int i = 0; i < QUERIES; i++) {
+			count += state->intersect_shape(query_shape, queries[i], Vector2(), 0, results, MAX_RESULTS);
+		}
+		culled = count;
+	}
+
+	virtual void teardown() {
+
+		Physics2DServer *ps = Physics2DServer::get_singleton();
+		for (int i = 0; i < bodies.size(); i++) {
+			ps->free(bodies[i]);
+		}
+		bodies.clear();
+		ps->free(query_shape);
+		ps->free(body_shape);
+		ps->free(space);
+	}
+
+	Cull2D() :
+			culled(0) {}
+};
+
+/* SCENES */
+
+class SceneInstance : public Benchmark {
+
+	enum {
+		BRANCHES = 10,
+		LEAVES = 10,
+		INSTANCES = 50
+	};
+
+	Ref<PackedScene> scene;
+
+public:
+	virtual const char *get_name() const { return "scene/instance"; }
+	virtual int get_operations() const { return INSTANCES; }
+
+	virtual bool setup() {
+
+		Node2D *root = memnew(Node2D);
+		root->set_name("Root");
+
+		for (int i = 0; i < BRANCHES; i++) {
+			Node2D *branch = memnew(Node2D);
+			branch->set_name("Branch" + itos(i));
+			branch->set_position(Vector2(i * 10, 0));
+			root->add_child(branch);
+			branch->set_owner(root);
+
+			for (int j = 0; j < LEAVES; j++) {
+				Node2D *leaf = memnew(Node2D);
+				leaf->set_name("Leaf" + itos(j));
+				leaf->set_position(Vector2(0, j * 10));
+				leaf->set_rotation(j * 0.1);
+				branch->add_child(leaf);
+				leaf->set_owner(root);
+			}
+		}
+
+		scene.instance();
+		Error err = scene->pack(root);
+		memdelete(root);
+
+		return err == OK;
+	}
+
+	virtual void run() {
+
+		for (int i = 0; i < INSTANCES; i++) {
+			Node *node = scene->instance();
+			memdelete(node);
+		}
+	}
+
+	virtual void teardown() {
+		scene.unref();
+	}
+};
+
+/* HARNESS */
+
+static bool _run_benchmark(Benchmark *p_bench, int p_warmup, int p_iterations, Result &r_result) {
+
+	if (!p_bench->setup()) {
+		OS::get_singleton()->print("%-28s skipped\n", p_bench->get_name());
+		p_bench->teardown();
+		return false;
+	}
+
+	for (int i = 0; i < p_warmup; i++) {
+		p_bench->reset();
+		p_bench->run();
+	}
+
+	Vector<double> times;
+	times.resize(p_iterations);
+
+	for (int i = 0; i < p_iterations; i++) {
+		p_bench->reset();
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		p_bench->run();
+		times.write[i] = OS::get_singleton()->get_ticks_usec() - from;
+	}
+
+	p_bench->teardown();
+
+	times.sort();
+
+	double sum = 0;
+	for (int i = 0; i < times.size(); i++) {
+		sum += times[i];
+	}
+	double mean = sum / times.size();
+
+	double variance = 0;
+	for (int i = 0; i < times.size(); i++) {
+		variance += (times[i] - mean) * (times[i] - mean);
+	}
+
+	int mid = times.size() / 2;
+
+	r_result.name = p_bench->get_name();
+	r_result.iterations = p_iterations;
+	r_result.operations = p_bench->get_operations();
+	r_result.min = times[0];
+	r_result.max = times[times.size() - 1];
+	r_result.mean = mean;
+	r_result.median = (times.size() % 2) ? times[mid] : (times[mid - 1] + times[mid]) * 0.5;
+	r_result.stddev = Math::sqrt(variance / times.size());
+
+	OS::get_singleton()->print("%-28s median %10.3f ms  min %10.3f ms  mean %10.3f ms  stddev %8.3f ms  %12.1f ns/op\n",
+			p_bench->get_name(),
+			r_result.median / 1000.0,
+			r_result.min / 1000.0,
+			r_result.mean / 1000.0,
+			r_result.stddev / 1000.0,
+			r_result.median * 1000.0 / MAX(r_result.operations, 1));
+
+	return true;
+}
+
+static Error _save_json(const String &p_path, const Vector<Result> &p_results) {
+
+	Array benchmarks;
+	for (int i = 0; i < p_results.size(); i++) {
+		const Result &r = p_results[i];
+		Dictionary d;
+		d["name"] = r.name;
+		d["iterations"] = r.iterations;
+		d["operations"] = r.operations;
+		d["min_usec"] = r.min;
+		d["max_usec"] = r.max;
+		d["mean_usec"] = r.mean;
+		d["median_usec"] = r.median;
+		d["stddev_usec"] = r.stddev;
+		benchmarks.push_back(d);
+	}
+
+	Dictionary root;
+	root["engine"] = Engine::get_singleton()->get_version_info()["string"];
+	root["os"] = OS::get_singleton()->get_name();
+	root["processor_count"] = OS::get_singleton()->get_processor_count();
+	root["benchmarks"] = benchmarks;
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Can't open benchmark output file: " + p_path);
+	f->store_string(JSON::print(root, "\t"));
+	memdelete(f);
+
+	return OK;
+}
+
+MainLoop *test(const List<String> &p_args) {
+
+	String filter = "*";
+	String json_path;
+	int iterations = 10;
+	int warmup = 2;
+
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+		if (!E->next()) {
+			break;
+		}
+		if (E->get() == "--benchmark-filter") {
+			filter = E->next()->get();
+		} else if (E->get() == "--benchmark-json") {
+			json_path = E->next()->get();
+		} else if (E->get() == "--benchmark-iterations") {
+			iterations = MAX(E->next()->get().to_int(), 1);
+		} else if (E->get() == "--benchmark-warmup") {
+			warmup = MAX(E->next()->get().to_int(), 0);
+		}
+	}
+
+	Vector<Benchmark *> benchmarks;
+	benchmarks.push_back(memnew(MapInsert<IntHashMap>("containers/hash_map_insert")));
+	benchmarks.push_back(memnew(MapLookup<IntHashMap>("containers/hash_map_lookup")));
+	benchmarks.push_back(memnew(MapInsert<IntOAHashMap>("containers/oa_hash_map_insert")));
+	benchmarks.push_back(memnew(MapLookup<IntOAHashMap>("containers/oa_hash_map_lookup")));
+	benchmarks.push_back(memnew(VariantEvaluate("variant/evaluate_int_add", Variant::OP_ADD, 3, 4)));
+	benchmarks.push_back(memnew(VariantEvaluate("variant/evaluate_vector3_mul", Variant::OP_MULTIPLY, Vector3(1, 2, 3), 2.5)));
+	benchmarks.push_back(memnew(VariantEvaluate("variant/evaluate_string_add", Variant::OP_ADD, "hello ", "world")));
+	benchmarks.push_back(memnew(ScriptRun("gdscript/loop", "GDScript", gdscript_loop_code, 100000)));
+	benchmarks.push_back(memnew(ScriptRun("gdscript/call", "GDScript", gdscript_call_code, 20000)));
+	benchmarks.push_back(memnew(PhysicsStacking));
+	benchmarks.push_back(memnew(Cull3D(false)));
+	benchmarks.push_back(memnew(Cull3D(true)));
+	benchmarks.push_back(memnew(Cull2D));
+	benchmarks.push_back(memnew(SceneInstance));
+
+	OS::get_singleton()->print("Running benchmarks matching '%s', %d warmup and %d measured iterations.\n", filter.utf8().get_data(), warmup, iterations);
+
+	Vector<Result> results;
+	for (int i = 0; i < benchmarks.size(); i++) {
+		if (String(benchmarks[i]->get_name()).match(filter)) {
+			Result result;
+			if (_run_benchmark(benchmarks[i], warmup, iterations, result)) {
+				results.push_back(result);
+			}
+		}
+		memdelete(benchmarks[i]);
+	}
+
+	if (json_path != "") {
+		if (_save_json(json_path, results) == OK) {
+			OS::get_singleton()->print("Saved results to %s\n", json_path.utf8().get_data());
+		}
+	}
+
+	return NULL;
+}
+} // namespace TestBenchmark
@@ -0,0 +1,153 @@
+/*************************************************************************/
+/*  test_btree.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_btree.h"
+
+#include "core/btree.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/set.h"
+
+namespace TestBTree {
+
+static bool _check(bool p_ok, const char *p_what) {
+
+	OS::get_singleton()->print("%s: %s\n", p_what, p_ok ? "ok" : "FAILED");
+	return p_ok;
+}
+
+MainLoop *test() {
+
+	OS::get_singleton()->print("\n\n\nHello from test\n");
+
+	// ordered iteration over several levels of inner nodes
+	{
+		BTreeMap<int, String> map;
+
+		for (int i = 0; i < 20000; i++) {
+			int k = (i * 7919) % 20000;
+			map[k] = itos(k);
+		}
+		map.insert(42, "overwritten");
+
+		bool ok = map.size() == 20000;
+		int expected = 0;
+		for (BTreeMap<int, String>::Element *E = map.front(); E; E = E->next()) {
+			ok = ok && E->key() == expected && (expected == 42 || E->value() == itos(expected));
+			expected++;
+		}
+		_check(ok && expected == 20000 && map[42] == "overwritten", "ordered insert and iteration");
+
+		expected = 19999;
+		for (BTreeMap<int, String>::Element *E = map.back(); E; E = E->prev()) {
+			ok = ok && E->key() == expected--;
+		}
+		_check(ok && expected == -1, "reverse iteration");
+	}
+
+	// erase with merges, then lookups around the holes
+	{
+		BTreeSet<int> set;
+
+		for (int i = 0; i < 10000; i++) {
+			set.insert(i * 2);
+		}
+		for (int i = 0; i < 10000; i++) {
+			if (i % 10) {
+				set.erase(i * 2);
+			}
+		}
+
+		bool ok = set.size() == 1000;
+		for (int i = 0; i < 20000; i++) {
+			ok = ok && set.has(i) == (i % 20 == 0);
+		}
+		_check(ok, "erase");
+
+		const BTreeSet<int>::Element *lb = set.lower_bound(21);
+		_check(lb && lb->get() == 40 && !set.lower_bound(19981), "lower_bound");
+
+		BTreeMap<int, int> map;
+		map[10] = 1;
+		map[20] = 2;
+		_check(map.find_closest(15)->key() == 10 && map.find_closest(20)->key() == 20 && !map.find_closest(5), "find_closest");
+
+		for (int i = 0; i < 20000; i++) {
+			set.erase(i);
+		}
+		_check(set.empty() && !set.front(), "erase all");
+	}
+
+	// benchmark against Set, with the RID-like keys physics exclusion uses
+	{
+		const int N = 512;
+		const int ROUNDS = 2000;
+
+		Vector<uint64_t> keys;
+		Math::seed(0);
+		for (int i = 0; i < N; i++) {
+			keys.push_back(((uint64_t)Math::rand() << 32) | Math::rand());
+		}
+
+		BTreeSet<uint64_t> btree;
+		Set<uint64_t> rb;
+		int found = 0;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < N; i++) {
+			btree.insert(keys[i]);
+		}
+		for (int r = 0; r < ROUNDS; r++) {
+			for (int i = 0; i < N; i++) {
+				found += btree.has(keys[i] ^ (r & 1)) ? 1 : 0;
+			}
+		}
+		uint64_t btree_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < N; i++) {
+			rb.insert(keys[i]);
+		}
+		for (int r = 0; r < ROUNDS; r++) {
+			for (int i = 0; i < N; i++) {
+				found += rb.has(keys[i] ^ (r & 1)) ? 1 : 0;
+			}
+		}
+		uint64_t rb_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+		OS::get_singleton()->print("%d keys, %d lookups each (found %d)\n", N, N * ROUNDS, found);
+		OS::get_singleton()->print("BTreeSet: %.3f ms\n", btree_time / 1000.0);
+		OS::get_singleton()->print("Set: %.3f ms\n", rb_time / 1000.0);
+	}
+
+	return NULL;
+}
+
+} // namespace TestBTree
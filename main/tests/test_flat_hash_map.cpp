@@ -0,0 +1,211 @@
+/*************************************************************************/
+/*  test_flat_hash_map.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_flat_hash_map.h"
+
+#include "core/flat_hash_map.h"
+#include "core/hash_map.h"
+#include "core/map.h"
+#include "core/math/math_funcs.h"
+#include "core/oa_hash_map.h"
+#include "core/os/os.h"
+#include "core/string_name.h"
+
+namespace TestFlatHashMap {
+
+static bool _check(bool p_ok, const char *p_what) {
+
+	OS::get_singleton()->print("%s: %s\n", p_what, p_ok ? "ok" : "FAILED");
+	return p_ok;
+}
+
+template <class M>
+static uint64_t _bench_insert(M &p_map, const Vector<StringName> &p_keys) {
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_keys.size(); i++) {
+		p_map[p_keys[i]] = i;
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+template <class M>
+static uint64_t _bench_lookup(M &p_map, const Vector<StringName> &p_keys, int p_rounds, int &r_found) {
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < p_rounds; r++) {
+		for (int i = 0; i < p_keys.size(); i++) {
+			if (p_map.getptr(p_keys[i])) {
+				r_found++;
+			}
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+MainLoop *test() {
+
+	OS::get_singleton()->print("\n\n\nHello from test\n");
+
+	// basic set/get/overwrite
+	{
+		FlatHashMap<int, int> map;
+
+		map.set(42, 1337);
+		map.set(1337, 21);
+		map.set(42, 11880);
+
+		_check(map.size() == 2, "element count");
+		_check(map.has(42) && map[42] == 11880, "overwrite");
+		_check(!map.getptr(7), "missing key");
+	}
+
+	// rehashing and deletion, with tombstones
+	{
+		FlatHashMap<int, int> map;
+
+		for (int i = 0; i < 5000; i++) {
+			map.set(i, i * 2);
+		}
+		for (int i = 0; i < 5000; i += 2) {
+			map.erase(i);
+		}
+		for (int i = 5000; i < 7500; i++) {
+			map.set(i, i * 2);
+		}
+
+		bool ok = map.size() == 5000;
+		for (int i = 0; i < 7500; i++) {
+			const int *v = map.getptr(i);
+			bool expected = i >= 5000 || (i & 1);
+			ok = ok && (expected ? (v && *v == i * 2) : !v);
+		}
+		_check(ok, "rehash and erase");
+
+		for (int i = 0; i < 7500; i++) {
+			map.erase(i);
+		}
+		_check(map.empty() && map.get_capacity() == 0, "erase all releases the table");
+	}
+
+	// iteration, erasing the key being iterated like Object does
+	{
+		FlatHashMap<String, int> map;
+
+		map.set("Hello", 1);
+		map.set("World", 2);
+		map.set("Godot rocks", 42);
+
+		int sum = 0;
+		const String *k = NULL;
+		while ((k = map.next(k))) {
+			sum += map[*k];
+		}
+		_check(sum == 45, "iteration");
+
+		while ((k = map.next(NULL))) {
+			map.erase(*k);
+		}
+		_check(map.empty(), "erase while iterating");
+	}
+
+	// copies are independent
+	{
+		FlatHashMap<String, String> a;
+		a["one"] = "1";
+		a["two"] = "2";
+		FlatHashMap<String, String> b = a;
+		b["one"] = "uno";
+		_check(a["one"] == "1" && b["one"] == "uno" && b.size() == 2, "copy");
+	}
+
+	// benchmark against the other maps, with the StringName keys ClassDB and Object use
+	{
+		const int N = 20000;
+		const int ROUNDS = 20;
+
+		Vector<StringName> keys;
+		Vector<StringName> missing;
+		Math::seed(0);
+		for (int i = 0; i < N; i++) {
+			keys.push_back(StringName("key_" + itos(Math::rand())));
+			missing.push_back(StringName("missing_" + itos(i)));
+		}
+
+		int found = 0;
+
+		FlatHashMap<StringName, int> flat;
+		HashMap<StringName, int> hash;
+		OAHashMap<StringName, int> oa;
+		Map<StringName, int> tree;
+
+		uint64_t flat_insert = _bench_insert(flat, keys);
+		uint64_t hash_insert = _bench_insert(hash, keys);
+		uint64_t tree_insert = _bench_insert(tree, keys);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < N; i++) {
+			oa.set(keys[i], i);
+		}
+		uint64_t oa_insert = OS::get_singleton()->get_ticks_usec() - begin;
+
+		uint64_t flat_lookup = _bench_lookup(flat, keys, ROUNDS, found) + _bench_lookup(flat, missing, ROUNDS, found);
+		uint64_t hash_lookup = _bench_lookup(hash, keys, ROUNDS, found) + _bench_lookup(hash, missing, ROUNDS, found);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < ROUNDS; r++) {
+			for (int i = 0; i < N; i++) {
+				found += oa.lookup_ptr(keys[i]) ? 1 : 0;
+				found += oa.lookup_ptr(missing[i]) ? 1 : 0;
+			}
+		}
+		uint64_t oa_lookup = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < ROUNDS; r++) {
+			for (int i = 0; i < N; i++) {
+				found += tree.has(keys[i]) ? 1 : 0;
+				found += tree.has(missing[i]) ? 1 : 0;
+			}
+		}
+		uint64_t tree_lookup = OS::get_singleton()->get_ticks_usec() - begin;
+
+		_check(found == N * ROUNDS * 4, "benchmark lookups");
+
+		OS::get_singleton()->print("%d keys, insert / %d hit+miss lookups (usec):\n", N, N * ROUNDS * 2);
+		OS::get_singleton()->print("\tFlatHashMap %d / %d\n", int(flat_insert), int(flat_lookup));
+		OS::get_singleton()->print("\tHashMap     %d / %d\n", int(hash_insert), int(hash_lookup));
+		OS::get_singleton()->print("\tOAHashMap   %d / %d\n", int(oa_insert), int(oa_lookup));
+		OS::get_singleton()->print("\tMap         %d / %d\n", int(tree_insert), int(tree_lookup));
+	}
+
+	return NULL;
+}
+} // namespace TestFlatHashMap
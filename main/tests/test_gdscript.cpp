@@ -578,6 +578,52 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += DADDR(3);
 					incr += 5;
 
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+
+					//prefix of the regular opcode that follows, which is listed on its own
+					txt += " validated op types: ";
+					txt += Variant::get_type_name(Variant::Type(code[ip + 1] & 0xFF));
+					txt += ",";
+					txt += Variant::get_type_name(Variant::Type(code[ip + 1] >> 8));
+					incr += 3;
+
+				} break;
+				case GDScriptFunction::OPCODE_GET_VALIDATED: {
+
+					txt += " validated get types: ";
+					txt += Variant::get_type_name(Variant::Type(code[ip + 1] & 0xFF));
+					txt += ",";
+					txt += Variant::get_type_name(Variant::Type(code[ip + 1] >> 8));
+					incr += 3;
+
+				} break;
+				case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+
+					txt += " validated get_named type: ";
+					txt += Variant::get_type_name(Variant::Type(code[ip + 1]));
+					incr += 3;
+
+				} break;
+				case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+
+					txt += " validated set_named types: ";
+					txt += Variant::get_type_name(Variant::Type(code[ip + 1] & 0xFF));
+					txt += ",";
+					txt += Variant::get_type_name(Variant::Type(code[ip + 1] >> 8));
+					incr += 3;
+
+				} break;
+				case GDScriptFunction::OPCODE_SET_VALIDATED: {
+
+					txt += " validated set types: ";
+					txt += Variant::get_type_name(Variant::Type(code[ip + 1] & 0xFF));
+					txt += ",";
+					txt += Variant::get_type_name(Variant::Type((code[ip + 1] >> 8) & 0xFF));
+					txt += ",";
+					txt += Variant::get_type_name(Variant::Type(code[ip + 1] >> 16));
+					incr += 3;
+
 				} break;
 				case GDScriptFunction::OPCODE_SET: {
 
@@ -837,8 +883,9 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 				} break;
 				case GDScriptFunction::OPCODE_YIELD: {
 
-					txt += " yield ";
-					incr = 1;
+					txt += " yield live: ";
+					txt += itos(code[ip + 1]);
+					incr = 2;
 
 				} break;
 				case GDScriptFunction::OPCODE_YIELD_SIGNAL: {
@@ -847,7 +894,9 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += DADDR(1);
 					txt += ",";
 					txt += DADDR(2);
-					incr = 3;
+					txt += " live: ";
+					txt += itos(code[ip + 3]);
+					incr = 4;
 				} break;
 				case GDScriptFunction::OPCODE_YIELD_RESUME: {
 
@@ -941,8 +990,92 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 	}
 }
 
+static String _benchmark_make_class(int p_index) {
+
+	String code = "extends Node\n\n";
+	code += "signal changed_" + itos(p_index) + "(value)\n";
+	code += "enum State { IDLE, RUNNING, DONE }\n";
+	code += "const LIMIT = " + itos(p_index * 7 + 3) + "\n";
+	code += "export var speed := 1.5\n";
+	code += "var items = []\n";
+	code += "var lookup = {}\n\n";
+
+	for (int i = 0; i < 20; i++) {
+		String n = itos(i);
+		code += "func compute_" + n + "(a: int, b: float = 2.0) -> float:\n";
+		code += "\tvar total = 0.0\n";
+		code += "\tfor i in range(a):\n";
+		code += "\t\tif i % 3 == 0 and b > 1.0:\n";
+		code += "\t\t\ttotal += sin(i * b) + Vector2(i, b).length()\n";
+		code += "\t\telif i > LIMIT:\n";
+		code += "\t\t\tbreak\n";
+		code += "\t\telse:\n";
+		code += "\t\t\ttotal -= lookup.get(\"key_" + n + "\", 0.0)\n";
+		code += "\tmatch a:\n";
+		code += "\t\t0, 1:\n";
+		code += "\t\t\titems.append(total)\n";
+		code += "\t\t_:\n";
+		code += "\t\t\temit_signal(\"changed_" + itos(p_index) + "\", total)\n";
+		code += "\treturn total * speed\n\n";
+	}
+
+	return code;
+}
+
+static void _benchmark() {
+
+	const int classes = 200;
+	const int iterations = 5;
+
+	Vector<String> corpus;
+	int bytes = 0;
+	for (int i = 0; i < classes; i++) {
+		corpus.push_back(_benchmark_make_class(i));
+		bytes += corpus[i].length();
+	}
+
+	print_line("Corpus: " + itos(classes) + " scripts, " + itos(bytes / 1024) + " KiB of code.");
+
+	uint64_t tokenize_usec = 0;
+	uint64_t parse_usec = 0;
+	int tokens = 0;
+
+	for (int it = 0; it < iterations; it++) {
+
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < corpus.size(); i++) {
+			GDScriptTokenizerText tk;
+			tk.set_code(corpus[i]);
+			while (tk.get_token() != GDScriptTokenizer::TK_EOF && tk.get_token() != GDScriptTokenizer::TK_ERROR) {
+				tokens++;
+				tk.advance();
+			}
+		}
+		tokenize_usec += OS::get_singleton()->get_ticks_usec() - from;
+
+		from = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < corpus.size(); i++) {
+			GDScriptParser parser;
+			Error err = parser.parse(corpus[i]);
+			if (err) {
+				print_line("Parse Error:\n" + itos(parser.get_error_line()) + ":" + itos(parser.get_error_column()) + ":" + parser.get_error());
+				return;
+			}
+		}
+		parse_usec += OS::get_singleton()->get_ticks_usec() - from;
+	}
+
+	print_line("Tokenizer: " + rtos(tokenize_usec / 1000.0 / iterations) + " ms per pass, " + itos(tokens / iterations) + " tokens.");
+	print_line("Parser: " + rtos(parse_usec / 1000.0 / iterations) + " ms per pass (includes tokenizing).");
+}
+
 MainLoop *test(TestType p_type) {
 
+	if (p_type == TEST_BENCHMARK) {
+		_benchmark();
+		return NULL;
+	}
+
 	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
 
 	if (cmdlargs.empty()) {
@@ -34,6 +34,10 @@
 #ifdef DEBUG_ENABLED
 
 #include "test_astar.h"
+#include "test_audio_mix.h"
+#include "test_benchmark.h"
+#include "test_btree.h"
+#include "test_flat_hash_map.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
 #include "test_math.h"
@@ -54,14 +58,19 @@ const char **tests_get_names() {
 		"physics_2d",
 		"render",
 		"oa_hash_map",
+		"flat_hash_map",
+		"btree",
 		"gui",
 		"shaderlang",
 		"gd_tokenizer",
 		"gd_parser",
 		"gd_compiler",
 		"gd_bytecode",
+		"gd_benchmark",
 		"ordered_hash_map",
 		"astar",
+		"audio_mix",
+		"benchmark",
 		NULL
 	};
 
@@ -100,6 +109,16 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestOAHashMap::test();
 	}
 
+	if (p_test == "flat_hash_map") {
+
+		return TestFlatHashMap::test();
+	}
+
+	if (p_test == "btree") {
+
+		return TestBTree::test();
+	}
+
 #ifndef _3D_DISABLED
 	if (p_test == "gui") {
 
@@ -132,6 +151,11 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestGDScript::test(TestGDScript::TEST_BYTECODE);
 	}
 
+	if (p_test == "gd_benchmark") {
+
+		return TestGDScript::test(TestGDScript::TEST_BENCHMARK);
+	}
+
 	if (p_test == "ordered_hash_map") {
 
 		return TestOrderedHashMap::test();
@@ -142,6 +166,16 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "audio_mix") {
+
+		return TestAudioMix::test();
+	}
+
+	if (p_test == "benchmark") {
+
+		return TestBenchmark::test(p_args);
+	}
+
 	print_line("Unknown test: " + p_test);
 	return NULL;
 }
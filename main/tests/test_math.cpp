@@ -402,8 +402,101 @@ uint32_t ihash3(uint32_t a) {
 	return a;
 }
 
+static void test_transform_batch() {
+
+	const int count = 100000;
+	const int passes = 20;
+
+	Transform xf(Basis(Vector3(0.3, 0.8, -0.5).normalized(), 0.7).scaled(Vector3(1.5, 0.5, 2.0)), Vector3(1, -2, 3));
+
+	Vector<Vector3> points;
+	Vector<AABB> boxes;
+	Vector<Transform> transforms;
+	points.resize(count);
+	boxes.resize(count);
+	transforms.resize(count);
+	for (int i = 0; i < count; i++) {
+		points.write[i] = Vector3(Math::randf(), Math::randf(), Math::randf()) * 100.0 - Vector3(50, 50, 50);
+		boxes.write[i] = AABB(points[i], Vector3(Math::randf(), Math::randf(), Math::randf()) * 10.0);
+		transforms.write[i] = Transform(Basis(Vector3(Math::randf(), Math::randf(), 1.0).normalized(), Math::randf() * Math_PI), points[i]);
+	}
+
+	Vector<Vector3> points_out;
+	Vector<AABB> boxes_out;
+	Vector<Transform> transforms_out;
+	points_out.resize(count);
+	boxes_out.resize(count);
+	transforms_out.resize(count);
+
+	// Results must match the scalar versions.
+	int mismatches = 0;
+	xf.xform_array(points.ptr(), points_out.ptrw(), count);
+	xf.xform_array(boxes.ptr(), boxes_out.ptrw(), count);
+	Transform::multiply_array(transforms.ptr(), transforms.ptr(), transforms_out.ptrw(), count);
+	for (int i = 0; i < count; i++) {
+		AABB box = xf.xform(boxes[i]);
+		Transform t = transforms[i] * transforms[i];
+		// Summation order differs from the scalar paths, so allow for rounding.
+		real_t error = (points_out[i] - xf.xform(points[i])).length();
+		error = MAX(error, (boxes_out[i].position - box.position).length());
+		error = MAX(error, (boxes_out[i].size - box.size).length());
+		error = MAX(error, (transforms_out[i].origin - t.origin).length());
+		for (int j = 0; j < 3; j++) {
+			error = MAX(error, (transforms_out[i].basis[j] - t.basis[j]).length());
+		}
+		if (error > 0.001) {
+			mismatches++;
+		}
+	}
+	print_line("Transform batch mismatches: " + itos(mismatches));
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int p = 0; p < passes; p++) {
+		for (int i = 0; i < count; i++) {
+			points_out.write[i] = xf.xform(points[i]);
+		}
+	}
+	uint64_t scalar_time = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int p = 0; p < passes; p++) {
+		xf.xform_array(points.ptr(), points_out.ptrw(), count);
+	}
+	print_line("Vector3 xform: scalar " + itos(scalar_time) + " usec, batch " + itos(OS::get_singleton()->get_ticks_usec() - from) + " usec");
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int p = 0; p < passes; p++) {
+		for (int i = 0; i < count; i++) {
+			boxes_out.write[i] = xf.xform(boxes[i]);
+		}
+	}
+	scalar_time = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int p = 0; p < passes; p++) {
+		xf.xform_array(boxes.ptr(), boxes_out.ptrw(), count);
+	}
+	print_line("AABB xform: scalar " + itos(scalar_time) + " usec, batch " + itos(OS::get_singleton()->get_ticks_usec() - from) + " usec");
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int p = 0; p < passes; p++) {
+		for (int i = 0; i < count; i++) {
+			transforms_out.write[i] = transforms[i] * transforms[i];
+		}
+	}
+	scalar_time = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int p = 0; p < passes; p++) {
+		Transform::multiply_array(transforms.ptr(), transforms.ptr(), transforms_out.ptrw(), count);
+	}
+	print_line("Transform multiply: scalar " + itos(scalar_time) + " usec, batch " + itos(OS::get_singleton()->get_ticks_usec() - from) + " usec");
+}
+
 MainLoop *test() {
 
+	test_transform_batch();
+
 	{
 		float r = 1;
 		float g = 0.5;
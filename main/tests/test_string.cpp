@@ -1121,6 +1121,39 @@ bool test_35() {
 	return state;
 }
 
+bool test_36() {
+
+	OS::get_singleton()->print("\n\nTest 36: ASCII and UTF-8 fast paths\n");
+	bool state = true;
+
+	String ascii;
+	ascii.parse_utf8("Hello, World");
+	COUNT_TEST(ascii == "Hello, World");
+	COUNT_TEST(ascii.utf8() == CharString("Hello, World"));
+
+	String mixed = String::utf8("Hello \xc3\xa9t\xc3\xa9");
+	COUNT_TEST(mixed.length() == 9);
+	COUNT_TEST(String::utf8(mixed.utf8().get_data()) == mixed);
+
+	// the unrolled hash must match the character by character one, StringName literals depend on it
+	String long_text = "The quick brown fox jumps over the lazy dog";
+	COUNT_TEST(long_text.hash() == String::hash(long_text.utf8().get_data()));
+	COUNT_TEST(long_text.hash() == String::hash(long_text.c_str(), long_text.length()));
+
+	COUNT_TEST(long_text.find("fox") == 16);
+	COUNT_TEST(long_text.find(String("dog")) == 40);
+	COUNT_TEST(long_text.find(String("dogs")) == -1);
+	COUNT_TEST(long_text.find(String("o"), 13) == 17);
+	COUNT_TEST(long_text.find(String("The"), 1) == -1);
+
+	String copy = long_text;
+	COUNT_TEST(copy == long_text);
+	copy[4] = 'Q';
+	COUNT_TEST(copy != long_text);
+
+	return state;
+}
+
 typedef bool (*TestFunc)(void);
 
 TestFunc test_funcs[] = {
@@ -1160,6 +1193,7 @@ TestFunc test_funcs[] = {
 	test_33,
 	test_34,
 	test_35,
+	test_36,
 	0
 
 };
@@ -60,9 +60,6 @@ private:
 	float eye_height, z_near, z_far;
 
 	Ref<CameraFeed> feed;
-	int image_width[2];
-	int image_height[2];
-	PoolVector<uint8_t> img_data[2];
 
 	struct anchor_map {
 		ARVRPositionalTracker *tracker;
@@ -468,76 +468,16 @@ void ARKitInterface::process() {
 					} else if (dataCbCr == NULL) {
 						print_line("Couldn't access CbCr pixel buffer data");
 					} else {
-						Ref<Image> img[2];
 						size_t extraLeft, extraRight, extraTop, extraBottom;
 
 						CVPixelBufferGetExtendedPixels(pixelBuffer, &extraLeft, &extraRight, &extraTop, &extraBottom);
 
-						{
-							// do Y
-							int new_width = CVPixelBufferGetWidthOfPlane(pixelBuffer, 0);
-							int new_height = CVPixelBufferGetHeightOfPlane(pixelBuffer, 0);
-							int bytes_per_row = CVPixelBufferGetBytesPerRowOfPlane(pixelBuffer, 0);
-
-							if ((image_width[0] != new_width) || (image_height[0] != new_height)) {
-								printf("- Camera padding l:%lu r:%lu t:%lu b:%lu\n", extraLeft, extraRight, extraTop, extraBottom);
-								printf("- Camera Y plane size: %i, %i - %i\n", new_width, new_height, bytes_per_row);
-
-								image_width[0] = new_width;
-								image_height[0] = new_height;
-								img_data[0].resize(new_width * new_height);
-							}
-
-							PoolVector<uint8_t>::Write w = img_data[0].write();
-							if (new_width == bytes_per_row) {
-								memcpy(w.ptr(), dataY, new_width * new_height);
-							} else {
-								int offset_a = 0;
-								int offset_b = extraLeft + (extraTop * bytes_per_row);
-								for (int r = 0; r < new_height; r++) {
-									memcpy(w.ptr() + offset_a, dataY + offset_b, new_width);
-									offset_a += new_width;
-									offset_b += bytes_per_row;
-								}
-							}
-
-							img[0].instance();
-							img[0]->create(new_width, new_height, 0, Image::FORMAT_R8, img_data[0]);
-						}
-
-						{
-							// do CbCr
-							int new_width = CVPixelBufferGetWidthOfPlane(pixelBuffer, 1);
-							int new_height = CVPixelBufferGetHeightOfPlane(pixelBuffer, 1);
-							int bytes_per_row = CVPixelBufferGetBytesPerRowOfPlane(pixelBuffer, 0);
-
-							if ((image_width[1] != new_width) || (image_height[1] != new_height)) {
-								printf("- Camera CbCr plane size: %i, %i - %i\n", new_width, new_height, bytes_per_row);
-
-								image_width[1] = new_width;
-								image_height[1] = new_height;
-								img_data[1].resize(2 * new_width * new_height);
-							}
-
-							PoolVector<uint8_t>::Write w = img_data[1].write();
-							if ((2 * new_width) == bytes_per_row) {
-								memcpy(w.ptr(), dataCbCr, 2 * new_width * new_height);
-							} else {
-								int offset_a = 0;
-								int offset_b = extraLeft + (extraTop * bytes_per_row);
-								for (int r = 0; r < new_height; r++) {
-									memcpy(w.ptr() + offset_a, dataCbCr + offset_b, 2 * new_width);
-									offset_a += 2 * new_width;
-									offset_b += bytes_per_row;
-								}
-							}
-
-							img[1].instance();
-							img[1]->create(new_width, new_height, 0, Image::FORMAT_RG8, img_data[1]);
-						}
+						// skip the padding, the feed copies the visible rows straight into buffers it reuses between frames
+						size_t y_bytes_per_row = CVPixelBufferGetBytesPerRowOfPlane(pixelBuffer, 0);
+						size_t cbcr_bytes_per_row = CVPixelBufferGetBytesPerRowOfPlane(pixelBuffer, 1);
 
-						// set our texture...
-						feed->set_YCbCr_imgs(img[0], img[1]);
+						feed->set_YCbCr_planes(dataY + extraLeft + (extraTop * y_bytes_per_row), CVPixelBufferGetWidthOfPlane(pixelBuffer, 0), CVPixelBufferGetHeightOfPlane(pixelBuffer, 0), y_bytes_per_row,
+								dataCbCr + extraLeft + (extraTop * cbcr_bytes_per_row), CVPixelBufferGetWidthOfPlane(pixelBuffer, 1), CVPixelBufferGetHeightOfPlane(pixelBuffer, 1), cbcr_bytes_per_row);
 
 						// now build our transform to display this as a background image that matches our camera
 						CGAffineTransform affine_transform = [current_frame displayTransformForOrientation:orientation viewportSize:CGSizeMake(screen_size.width, screen_size.height)];
@@ -736,10 +676,6 @@ ARKitInterface::ARKitInterface() {
 	num_anchors = 0;
 	ambient_intensity = 1.0;
 	ambient_color_temperature = 1.0;
-	image_width[0] = 0;
-	image_width[1] = 0;
-	image_height[0] = 0;
-	image_height[1] = 0;
 }
 
 ARKitInterface::~ARKitInterface() {
@@ -55,7 +55,9 @@ AreaBullet::AreaBullet() :
 		spOv_linearDump(0.1),
 		spOv_angularDump(1),
 		spOv_priority(0),
-		isScratched(false) {
+		isScratched(false),
+		monitor_batching(false),
+		dispatching(false) {
 
 	btGhost = bulletnew(btGhostObject);
 	reload_shapes();
@@ -79,6 +81,8 @@ void AreaBullet::dispatch_callbacks() {
 		return;
 	isScratched = false;
 
+	dispatching = true;
+
 	// Reverse order because I've to remove EXIT objects
 	for (int i = overlappingObjects.size() - 1; 0 <= i; --i) {
 		OverlappingObjectData &otherObj = overlappingObjects.write[i];
@@ -99,6 +103,9 @@ void AreaBullet::dispatch_callbacks() {
 				break;
 		}
 	}
+
+	dispatching = false;
+	flush_events();
 }
 
 void AreaBullet::call_event(CollisionObjectBullet *p_otherObject, PhysicsServer::AreaBodyStatus p_status) {
@@ -111,6 +118,19 @@ void AreaBullet::call_event(CollisionObjectBullet *p_otherObject, PhysicsServer:
 		return;
 	}
 
+	if (monitor_batching) {
+		Array &batch = batched_events[static_cast<int>(p_otherObject->getType())];
+		batch.push_back(p_status);
+		batch.push_back(p_otherObject->get_self()); // Other body
+		batch.push_back(p_otherObject->get_instance_id()); // instance ID
+		batch.push_back(0); // other_body_shape ID
+		batch.push_back(0); // self_shape ID
+		if (!dispatching) {
+			flush_events();
+		}
+		return;
+	}
+
 	call_event_res[0] = p_status;
 	call_event_res[1] = p_otherObject->get_self(); // Other body
 	call_event_res[2] = p_otherObject->get_instance_id(); // instance ID
@@ -121,6 +141,30 @@ void AreaBullet::call_event(CollisionObjectBullet *p_otherObject, PhysicsServer:
 	areaGodoObject->call(event.event_callback_method, (const Variant **)call_event_res_ptr, 5, outResp);
 }
 
+void AreaBullet::flush_events() {
+
+	for (int i = 0; i < 2; ++i) {
+		if (batched_events[i].empty()) {
+			continue;
+		}
+
+		// Swap the batch out first, the receiver may cause new events while handling this one.
+		Array batch = batched_events[i];
+		batched_events[i] = Array();
+
+		Object *areaGodoObject = ObjectDB::get_instance(eventsCallbacks[i].event_callback_id);
+		if (!areaGodoObject) {
+			eventsCallbacks[i].event_callback_id = 0;
+			continue;
+		}
+
+		Variant arg = batch;
+		const Variant *argp = &arg;
+		Variant::CallError outResp;
+		areaGodoObject->call(eventsCallbacks[i].event_callback_method, &argp, 1, outResp);
+	}
+}
+
 void AreaBullet::scratch() {
 	if (isScratched)
 		return;
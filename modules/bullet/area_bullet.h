@@ -103,6 +103,13 @@ private:
 
 	InOutEventCallback eventsCallbacks[2];
 
+	// When batching, events are packed five values per event and sent in one call per callback.
+	bool monitor_batching;
+	bool dispatching;
+	Array batched_events[2];
+
+	void flush_events();
+
 public:
 	AreaBullet();
 	~AreaBullet();
@@ -115,6 +122,9 @@ public:
 
 	bool is_monitoring() const;
 
+	_FORCE_INLINE_ void set_monitor_batching(bool p_enable) { monitor_batching = p_enable; }
+	_FORCE_INLINE_ bool is_monitor_batching() const { return monitor_batching; }
+
 	_FORCE_INLINE_ void set_spOv_mode(PhysicsServer::AreaSpaceOverrideMode p_mode) { spOv_mode = p_mode; }
 	_FORCE_INLINE_ PhysicsServer::AreaSpaceOverrideMode get_spOv_mode() { return spOv_mode; }
 
@@ -34,6 +34,8 @@
 #include "cone_twist_joint_bullet.h"
 #include "core/class_db.h"
 #include "core/error_macros.h"
+#include "core/os/os.h"
+#include "core/project_settings.h"
 #include "core/ustring.h"
 #include "generic_6dof_joint_bullet.h"
 #include "hinge_joint_bullet.h"
@@ -81,7 +83,11 @@ void BulletPhysicsServer::_bind_methods() {
 BulletPhysicsServer::BulletPhysicsServer() :
 		PhysicsServer(),
 		active(true),
-		active_spaces_count(0) {}
+		active_spaces_count(0) {
+#if BT_THREADSAFE
+	task_scheduler = NULL;
+#endif
+}
 
 BulletPhysicsServer::~BulletPhysicsServer() {}
 
@@ -438,6 +444,13 @@ void BulletPhysicsServer::area_set_area_monitor_callback(RID p_area, Object *p_r
 	area->set_event_callback(CollisionObjectBullet::TYPE_AREA, p_receiver ? p_receiver->get_instance_id() : 0, p_method);
 }
 
+void BulletPhysicsServer::area_set_monitor_batching(RID p_area, bool p_enable) {
+	AreaBullet *area = area_owner.get(p_area);
+	ERR_FAIL_COND(!area);
+
+	area->set_monitor_batching(p_enable);
+}
+
 void BulletPhysicsServer::area_set_ray_pickable(RID p_area, bool p_enable) {
 	AreaBullet *area = area_owner.get(p_area);
 	ERR_FAIL_COND(!area);
@@ -1554,6 +1567,21 @@ void BulletPhysicsServer::free(RID p_rid) {
 
 void BulletPhysicsServer::init() {
 	BulletPhysicsDirectBodyState::initSingleton();
+
+	bool multithreaded = GLOBAL_DEF("physics/3d/bullet/multithreaded", false);
+	GLOBAL_DEF("physics/3d/bullet/thread_count", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/bullet/thread_count", PropertyInfo(Variant::INT, "physics/3d/bullet/thread_count", PROPERTY_HINT_RANGE, "0,64,1"));
+
+	if (multithreaded) {
+#if BT_THREADSAFE
+		int thread_count = ProjectSettings::get_singleton()->get("physics/3d/bullet/thread_count");
+		// Must be set before any space is created, the worlds pick their dispatcher and solver from it
+		task_scheduler = memnew(GodotTaskScheduler(thread_count > 0 ? thread_count : OS::get_singleton()->get_processor_count()));
+		btSetTaskScheduler(task_scheduler);
+#else
+		WARN_PRINT("physics/3d/bullet/multithreaded is enabled, but this build of Bullet isn't thread safe. Build with bullet_multithreaded=yes to use it.");
+#endif
+	}
 }
 
 void BulletPhysicsServer::step(float p_deltaTime) {
@@ -1576,6 +1604,14 @@ void BulletPhysicsServer::flush_queries() {
 
 void BulletPhysicsServer::finish() {
 	BulletPhysicsDirectBodyState::destroySingleton();
+
+#if BT_THREADSAFE
+	if (task_scheduler) {
+		btSetTaskScheduler(btGetSequentialTaskScheduler());
+		memdelete(task_scheduler);
+		task_scheduler = NULL;
+	}
+#endif
 }
 
 int BulletPhysicsServer::get_process_info(ProcessInfo p_info) {
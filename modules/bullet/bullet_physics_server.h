@@ -33,6 +33,7 @@
 
 #include "area_bullet.h"
 #include "core/rid.h"
+#include "godot_task_scheduler.h"
 #include "joint_bullet.h"
 #include "rigid_body_bullet.h"
 #include "servers/physics_server.h"
@@ -51,6 +52,9 @@ class BulletPhysicsServer : public PhysicsServer {
 
 	bool active;
 	char active_spaces_count;
+#if BT_THREADSAFE
+	GodotTaskScheduler *task_scheduler;
+#endif
 	Vector<SpaceBullet *> active_spaces;
 
 	mutable RID_Owner<SpaceBullet> space_owner;
@@ -161,6 +165,7 @@ public:
 	virtual void area_set_monitorable(RID p_area, bool p_monitorable);
 	virtual void area_set_monitor_callback(RID p_area, Object *p_receiver, const StringName &p_method);
 	virtual void area_set_area_monitor_callback(RID p_area, Object *p_receiver, const StringName &p_method);
+	virtual void area_set_monitor_batching(RID p_area, bool p_enable);
 	virtual void area_set_ray_pickable(RID p_area, bool p_enable);
 	virtual bool area_is_ray_pickable(RID p_area) const;
 
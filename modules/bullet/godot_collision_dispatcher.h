@@ -35,6 +35,10 @@
 
 #include <btBulletDynamicsCommon.h>
 
+#if BT_THREADSAFE
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#endif
+
 /**
 	@author AndreaCatania
 */
@@ -49,4 +53,17 @@ public:
 	virtual bool needsCollision(const btCollisionObject *body0, const btCollisionObject *body1);
 	virtual bool needsResponse(const btCollisionObject *body0, const btCollisionObject *body1);
 };
+
+#if BT_THREADSAFE
+/// Same as GodotCollisionDispatcher, but dispatches the narrowphase pairs on the task scheduler
+class GodotCollisionDispatcherMt : public btCollisionDispatcherMt {
+private:
+	static const int CASTED_TYPE_AREA;
+
+public:
+	GodotCollisionDispatcherMt(btCollisionConfiguration *collisionConfiguration);
+	virtual bool needsCollision(const btCollisionObject *body0, const btCollisionObject *body1);
+	virtual bool needsResponse(const btCollisionObject *body0, const btCollisionObject *body1);
+};
+#endif
 #endif
@@ -0,0 +1,172 @@
+/*************************************************************************/
+/*  godot_soft_body_solver.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "godot_soft_body_solver.h"
+
+#include <BulletCollision/BroadphaseCollision/btBroadphaseInterface.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+
+void GodotSoftBodySolver::PredictMotionLoop::forLoop(int p_begin, int p_end) const {
+	for (int i = p_begin; i < p_end; ++i) {
+		bodies[i]->predictMotion(time_step);
+	}
+}
+
+void GodotSoftBodySolver::SolveConstraintsLoop::forLoop(int p_begin, int p_end) const {
+	for (int i = p_begin; i < p_end; ++i) {
+		bodies[i]->solveConstraints();
+	}
+}
+
+void GodotSoftBodySolver::IntegrateMotionLoop::forLoop(int p_begin, int p_end) const {
+	for (int i = p_begin; i < p_end; ++i) {
+		bodies[i]->integrateMotion();
+	}
+}
+
+bool GodotSoftBodySolver::_is_parallel() const {
+	return m_softBodySet.size() > 1 && btGetTaskScheduler() && btGetTaskScheduler()->getNumThreads() > 1;
+}
+
+void GodotSoftBodySolver::_collect_active_bodies() {
+	active_bodies.resize(0);
+	for (int i = 0; i < m_softBodySet.size(); ++i) {
+		if (m_softBodySet[i]->isActive()) {
+			active_bodies.push_back(m_softBodySet[i]);
+		}
+	}
+}
+
+bool GodotSoftBodySolver::_is_independent(const btSoftBody *p_body) {
+
+	// Soft contacts move the nodes of the other soft body
+	if (p_body->m_scontacts.size()) {
+		return false;
+	}
+
+	// Anchors and rigid contacts apply impulses to the other object, which is only harmless if it can't move
+	for (int i = 0; i < p_body->m_anchors.size(); ++i) {
+		if (!p_body->m_anchors[i].m_body->isStaticOrKinematicObject()) {
+			return false;
+		}
+	}
+
+	for (int i = 0; i < p_body->m_rcontacts.size(); ++i) {
+		const btCollisionObject *other = p_body->m_rcontacts[i].m_cti.m_colObj;
+		if (other && !other->isStaticOrKinematicObject()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void GodotSoftBodySolver::predictMotion(btScalar p_time_step) {
+
+	if (!_is_parallel()) {
+		btDefaultSoftBodySolver::predictMotion(p_time_step);
+		return;
+	}
+
+	_collect_active_bodies();
+	if (!active_bodies.size()) {
+		return;
+	}
+
+	// predictMotion() moves the body in the broadphase, which isn't thread safe.
+	// Detach the handles meanwhile and move the bodies afterwards.
+	broadphase_handles.resize(active_bodies.size());
+	for (int i = 0; i < active_bodies.size(); ++i) {
+		broadphase_handles[i] = active_bodies[i]->getBroadphaseHandle();
+		active_bodies[i]->setBroadphaseHandle(NULL);
+	}
+
+	PredictMotionLoop loop;
+	loop.bodies = &active_bodies[0];
+	loop.time_step = p_time_step;
+	btParallelFor(0, active_bodies.size(), 1, loop);
+
+	for (int i = 0; i < active_bodies.size(); ++i) {
+		btSoftBody *body = active_bodies[i];
+		body->setBroadphaseHandle(broadphase_handles[i]);
+		if (broadphase_handles[i]) {
+			body->m_worldInfo->m_broadphase->setAabb(broadphase_handles[i], body->m_bounds[0], body->m_bounds[1], body->m_worldInfo->m_dispatcher);
+		}
+	}
+}
+
+void GodotSoftBodySolver::solveConstraints(btScalar p_solver_dt) {
+
+	if (!_is_parallel()) {
+		btDefaultSoftBodySolver::solveConstraints(p_solver_dt);
+		return;
+	}
+
+	_collect_active_bodies();
+
+	// Keep the independent bodies in active_bodies, the others are solved after them
+	serial_bodies.resize(0);
+	int independent_count = 0;
+	for (int i = 0; i < active_bodies.size(); ++i) {
+		if (_is_independent(active_bodies[i])) {
+			active_bodies[independent_count++] = active_bodies[i];
+		} else {
+			serial_bodies.push_back(active_bodies[i]);
+		}
+	}
+
+	if (independent_count > 1) {
+		SolveConstraintsLoop loop;
+		loop.bodies = &active_bodies[0];
+		btParallelFor(0, independent_count, 1, loop);
+	} else if (independent_count == 1) {
+		active_bodies[0]->solveConstraints();
+	}
+
+	for (int i = 0; i < serial_bodies.size(); ++i) {
+		serial_bodies[i]->solveConstraints();
+	}
+}
+
+void GodotSoftBodySolver::updateSoftBodies() {
+
+	if (!_is_parallel()) {
+		btDefaultSoftBodySolver::updateSoftBodies();
+		return;
+	}
+
+	_collect_active_bodies();
+
+	if (active_bodies.size()) {
+		IntegrateMotionLoop loop;
+		loop.bodies = &active_bodies[0];
+		btParallelFor(0, active_bodies.size(), 1, loop);
+	}
+}
@@ -0,0 +1,72 @@
+/*************************************************************************/
+/*  godot_soft_body_solver.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GODOT_SOFT_BODY_SOLVER_H
+#define GODOT_SOFT_BODY_SOLVER_H
+
+#include <BulletSoftBody/btDefaultSoftBodySolver.h>
+#include <BulletSoftBody/btSoftBody.h>
+#include <LinearMath/btThreads.h>
+
+/// Same as btDefaultSoftBodySolver, but steps the soft bodies in parallel on the task scheduler.
+/// Bodies whose constraints push dynamic objects or other soft bodies are still solved one at a time.
+class GodotSoftBodySolver : public btDefaultSoftBodySolver {
+
+	struct PredictMotionLoop : public btIParallelForBody {
+		btSoftBody *const *bodies;
+		btScalar time_step;
+		virtual void forLoop(int p_begin, int p_end) const;
+	};
+
+	struct SolveConstraintsLoop : public btIParallelForBody {
+		btSoftBody *const *bodies;
+		virtual void forLoop(int p_begin, int p_end) const;
+	};
+
+	struct IntegrateMotionLoop : public btIParallelForBody {
+		btSoftBody *const *bodies;
+		virtual void forLoop(int p_begin, int p_end) const;
+	};
+
+	btAlignedObjectArray<btSoftBody *> active_bodies;
+	btAlignedObjectArray<btSoftBody *> serial_bodies;
+	btAlignedObjectArray<btBroadphaseProxy *> broadphase_handles;
+
+	bool _is_parallel() const;
+	void _collect_active_bodies();
+	static bool _is_independent(const btSoftBody *p_body);
+
+public:
+	virtual void predictMotion(btScalar p_time_step);
+	virtual void solveConstraints(btScalar p_solver_dt);
+	virtual void updateSoftBodies();
+};
+
+#endif
@@ -0,0 +1,187 @@
+/*************************************************************************/
+/*  godot_task_scheduler.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "godot_task_scheduler.h"
+
+#if BT_THREADSAFE
+
+#include "core/safe_refcount.h"
+
+void GodotTaskScheduler::_worker_thread(void *p_userdata) {
+
+	GodotTaskScheduler *scheduler = static_cast<GodotTaskScheduler *>(p_userdata);
+
+	while (true) {
+
+		scheduler->work_semaphore->wait();
+		if (scheduler->exit)
+			break;
+
+		scheduler->_process_job();
+		scheduler->done_semaphore->post();
+	}
+}
+
+void GodotTaskScheduler::_process_job() {
+
+	while (true) {
+
+		uint32_t chunk = atomic_increment(&job.next_chunk) - 1;
+		if (chunk >= job.chunk_count)
+			break;
+
+		int begin = job.begin + chunk * job.grain_size;
+		int end = MIN(begin + job.grain_size, job.end);
+
+		if (job.for_body) {
+			job.for_body->forLoop(begin, end);
+		} else {
+			btScalar sum = job.sum_body->sumLoop(begin, end);
+			MutexLock lock(sum_mutex);
+			job.sum += sum;
+		}
+	}
+}
+
+void GodotTaskScheduler::_run_job() {
+
+	job.grain_size = MAX(job.grain_size, 1);
+	job.chunk_count = (job.end - job.begin + job.grain_size - 1) / job.grain_size;
+	job.next_chunk = 0;
+	job_running = true;
+
+	// no need to wake anybody for a single chunk
+	int helpers = MIN(num_threads - 1, (int)job.chunk_count - 1);
+
+	for (int i = 0; i < helpers; i++) {
+		work_semaphore->post();
+	}
+
+	_process_job();
+
+	for (int i = 0; i < helpers; i++) {
+		done_semaphore->wait();
+	}
+
+	job_running = false;
+}
+
+int GodotTaskScheduler::getMaxNumThreads() const {
+
+	return workers.size() + 1;
+}
+
+int GodotTaskScheduler::getNumThreads() const {
+
+	return num_threads;
+}
+
+void GodotTaskScheduler::setNumThreads(int p_num_threads) {
+
+	num_threads = CLAMP(p_num_threads, 1, getMaxNumThreads());
+}
+
+void GodotTaskScheduler::parallelFor(int p_begin, int p_end, int p_grain_size, const btIParallelForBody &p_body) {
+
+	if (p_begin >= p_end)
+		return;
+
+	if (job_running) {
+		// nested loops run on the thread that asked for them
+		p_body.forLoop(p_begin, p_end);
+		return;
+	}
+
+	job.for_body = &p_body;
+	job.sum_body = NULL;
+	job.begin = p_begin;
+	job.end = p_end;
+	job.grain_size = p_grain_size;
+
+	_run_job();
+}
+
+btScalar GodotTaskScheduler::parallelSum(int p_begin, int p_end, int p_grain_size, const btIParallelSumBody &p_body) {
+
+	if (p_begin >= p_end)
+		return btScalar(0);
+
+	if (job_running) {
+		return p_body.sumLoop(p_begin, p_end);
+	}
+
+	job.for_body = NULL;
+	job.sum_body = &p_body;
+	job.begin = p_begin;
+	job.end = p_end;
+	job.grain_size = p_grain_size;
+	job.sum = btScalar(0);
+
+	_run_job();
+
+	return job.sum;
+}
+
+GodotTaskScheduler::GodotTaskScheduler(int p_num_threads) :
+		btITaskScheduler("Godot") {
+
+	// the calling thread takes part in every job, Bullet can't index more than BT_MAX_THREAD_COUNT threads
+	num_threads = CLAMP(p_num_threads, 1, (int)BT_MAX_THREAD_COUNT);
+	exit = false;
+	job_running = false;
+
+	work_semaphore = Semaphore::create();
+	done_semaphore = Semaphore::create();
+	sum_mutex = Mutex::create();
+
+	workers.resize(num_threads - 1);
+	for (int i = 0; i < workers.size(); i++) {
+		workers.write[i] = Thread::create(_worker_thread, this);
+	}
+}
+
+GodotTaskScheduler::~GodotTaskScheduler() {
+
+	exit = true;
+	for (int i = 0; i < workers.size(); i++) {
+		work_semaphore->post();
+	}
+
+	for (int i = 0; i < workers.size(); i++) {
+		Thread::wait_to_finish(workers[i]);
+		memdelete(workers[i]);
+	}
+
+	memdelete(work_semaphore);
+	memdelete(done_semaphore);
+	memdelete(sum_mutex);
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*************************************************************************/
+/*  godot_task_scheduler.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GODOT_TASK_SCHEDULER_H
+#define GODOT_TASK_SCHEDULER_H
+
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/vector.h"
+
+#include <LinearMath/btThreads.h>
+
+#if BT_THREADSAFE
+
+/// Runs the parallel loops of the multithreaded Bullet classes on Godot threads.
+/// Workers are created once and sleep on a semaphore between jobs.
+class GodotTaskScheduler : public btITaskScheduler {
+
+	struct Job {
+		const btIParallelForBody *for_body;
+		const btIParallelSumBody *sum_body;
+		int begin;
+		int end;
+		int grain_size;
+		uint32_t chunk_count;
+		volatile uint32_t next_chunk;
+		btScalar sum;
+	};
+
+	Vector<Thread *> workers;
+	Semaphore *work_semaphore;
+	Semaphore *done_semaphore;
+	Mutex *sum_mutex;
+	bool exit;
+	volatile bool job_running;
+	int num_threads;
+
+	Job job;
+
+	static void _worker_thread(void *p_userdata);
+	void _process_job();
+	void _run_job();
+
+public:
+	virtual int getMaxNumThreads() const;
+	virtual int getNumThreads() const;
+	virtual void setNumThreads(int p_num_threads);
+	virtual void parallelFor(int p_begin, int p_end, int p_grain_size, const btIParallelForBody &p_body);
+	virtual btScalar parallelSum(int p_begin, int p_end, int p_grain_size, const btIParallelSumBody &p_body);
+
+	GodotTaskScheduler(int p_num_threads);
+	~GodotTaskScheduler();
+};
+
+#endif
+
+#endif
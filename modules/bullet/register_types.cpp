@@ -33,6 +33,7 @@
 #include "bullet_physics_server.h"
 #include "core/class_db.h"
 #include "core/project_settings.h"
+#include "servers/physics/physics_server_wrap_mt.h"
 
 /**
 	@author AndreaCatania
@@ -40,7 +41,7 @@
 
 #ifndef _3D_DISABLED
 PhysicsServer *_createBulletPhysicsCallback() {
-	return memnew(BulletPhysicsServer);
+	return PhysicsServerWrapMT::init_server<BulletPhysicsServer>();
 }
 #endif
 
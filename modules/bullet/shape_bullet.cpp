@@ -450,6 +450,42 @@ HeightMapShapeBullet::HeightMapShapeBullet() :
 void HeightMapShapeBullet::set_data(const Variant &p_data) {
 	ERR_FAIL_COND(p_data.get_type() != Variant::DICTIONARY);
 	Dictionary d = p_data;
+
+	if (d.has("region")) {
+		// Bullet can't patch its heightfield, but at least the rest of the heights don't have to be sent again
+		Rect2 l_region = d["region"];
+		PoolVector<real_t> l_region_heights = d["heights"];
+		int l_region_x = l_region.position.x;
+		int l_region_z = l_region.position.y;
+		int l_region_width = l_region.size.x;
+		int l_region_depth = l_region.size.y;
+
+		ERR_FAIL_COND(l_region_width <= 0 || l_region_depth <= 0);
+		ERR_FAIL_COND(l_region_x < 0 || l_region_z < 0);
+		ERR_FAIL_COND(l_region_x + l_region_width > width || l_region_z + l_region_depth > depth);
+		ERR_FAIL_COND(l_region_heights.size() != l_region_width * l_region_depth);
+
+		PoolVector<real_t> l_heights = heights;
+		real_t l_min_height = min_height;
+		real_t l_max_height = max_height;
+		{
+			PoolVector<real_t>::Write w = l_heights.write();
+			PoolVector<real_t>::Read r = l_region_heights.read();
+
+			for (int z = 0; z < l_region_depth; ++z) {
+				for (int x = 0; x < l_region_width; ++x) {
+					real_t h = r[z * l_region_width + x];
+					w[(l_region_z + z) * width + l_region_x + x] = h;
+					l_min_height = MIN(l_min_height, h);
+					l_max_height = MAX(l_max_height, h);
+				}
+			}
+		}
+
+		setup(l_heights, width, depth, l_min_height, l_max_height);
+		return;
+	}
+
 	ERR_FAIL_COND(!d.has("width"));
 	ERR_FAIL_COND(!d.has("depth"));
 	ERR_FAIL_COND(!d.has("heights"));
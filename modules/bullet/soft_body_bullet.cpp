@@ -84,23 +84,19 @@ void SoftBodyBullet::update_visual_server(SoftBodyVisualServerHandler *p_visual_
 	const btSoftBody::tNodeArray &nodes(bt_soft_body->m_nodes);
 	const int nodes_count = nodes.size();
 
-	const Vector<int> *vs_indices;
-	const void *vertex_position;
-	const void *vertex_normal;
+	/// Convert the nodes once, then let the handler write the whole surface in one pass
+	node_positions.resize(nodes_count);
+	node_normals.resize(nodes_count);
+	Vector3 *positions = node_positions.ptrw();
+	Vector3 *normals = node_normals.ptrw();
 
 	for (int vertex_index = 0; vertex_index < nodes_count; ++vertex_index) {
-		vertex_position = reinterpret_cast<const void *>(&nodes[vertex_index].m_x);
-		vertex_normal = reinterpret_cast<const void *>(&nodes[vertex_index].m_n);
-
-		vs_indices = &indices_table[vertex_index];
-
-		const int vs_indices_size(vs_indices->size());
-		for (int x = 0; x < vs_indices_size; ++x) {
-			p_visual_server_handler->set_vertex((*vs_indices)[x], vertex_position);
-			p_visual_server_handler->set_normal((*vs_indices)[x], vertex_normal);
-		}
+		B_TO_G(nodes[vertex_index].m_x, positions[vertex_index]);
+		B_TO_G(nodes[vertex_index].m_n, normals[vertex_index]);
 	}
 
+	p_visual_server_handler->set_vertices(positions, normals, vs_indices_to_physics_table.ptr(), vs_indices_to_physics_table.size());
+
 	/// Generate AABB
 	btVector3 aabb_min;
 	btVector3 aabb_max;
@@ -327,11 +323,11 @@ void SoftBodyBullet::set_trimesh_body_shape(PoolVector<int> p_indices, PoolVecto
 	/// Merge all overlapping vertices and create a map of physical vertices to visual server
 
 	{
-		/// This is the map of visual server indices to physics indices (So it's the inverse of idices_map), Thanks to it I don't need make a heavy search in the indices_map
-		Vector<int> vs_indices_to_physics_table;
+		/// vs_indices_to_physics_table is the map of visual server indices to physics indices (So it's the inverse of idices_map), Thanks to it I don't need make a heavy search in the indices_map
 
 		{ // Map vertices
 			indices_table.resize(0);
+			vs_indices_to_physics_table.resize(0);
 
 			int index = 0;
 			Map<Vector3, int> unique_vertices;
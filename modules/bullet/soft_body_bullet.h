@@ -60,6 +60,9 @@ class SoftBodyBullet : public CollisionObjectBullet {
 private:
 	btSoftBody *bt_soft_body;
 	Vector<Vector<int> > indices_table;
+	Vector<int> vs_indices_to_physics_table; // The soft body node of each visual server vertex
+	Vector<Vector3> node_positions; // Scratch buffers of update_visual_server
+	Vector<Vector3> node_normals;
 	btSoftBody::Material *mat0; // This is just a copy of pointer managed by btSoftBody
 	bool isScratched;
 
@@ -42,9 +42,6 @@
 
 @interface MyCaptureSession : AVCaptureSession <AVCaptureVideoDataOutputSampleBufferDelegate> {
 	Ref<CameraFeed> feed;
-	size_t width[2];
-	size_t height[2];
-	PoolVector<uint8_t> img_data[2];
 
 	AVCaptureDeviceInput *input;
 	AVCaptureVideoDataOutput *output;
@@ -58,10 +55,6 @@
 	if (self = [super init]) {
 		NSError *error;
 		feed = p_feed;
-		width[0] = 0;
-		height[0] = 0;
-		width[1] = 0;
-		height[1] = 0;
 
 		// prepare our device
 		[p_device lockForConfiguration:&error];
@@ -159,53 +152,11 @@
 		print_line("Couldn't access CbCr pixel buffer data");
 	} else {
 		UIInterfaceOrientation orientation = [[UIApplication sharedApplication] statusBarOrientation];
-		Ref<Image> img[2];
 
-		{
-			// do Y
-			int new_width = CVPixelBufferGetWidthOfPlane(pixelBuffer, 0);
-			int new_height = CVPixelBufferGetHeightOfPlane(pixelBuffer, 0);
-			int _bytes_per_row = CVPixelBufferGetBytesPerRowOfPlane(pixelBuffer, 0);
-
-			if ((width[0] != new_width) || (height[0] != new_height)) {
-				// printf("Camera Y plane %i, %i - %i\n", new_width, new_height, bytes_per_row);
-
-				width[0] = new_width;
-				height[0] = new_height;
-				img_data[0].resize(new_width * new_height);
-			}
-
-			PoolVector<uint8_t>::Write w = img_data[0].write();
-			memcpy(w.ptr(), dataY, new_width * new_height);
-
-			img[0].instance();
-			img[0]->create(new_width, new_height, 0, Image::FORMAT_R8, img_data[0]);
-		}
-
-		{
-			// do CbCr
-			int new_width = CVPixelBufferGetWidthOfPlane(pixelBuffer, 1);
-			int new_height = CVPixelBufferGetHeightOfPlane(pixelBuffer, 1);
-			int bytes_per_row = CVPixelBufferGetBytesPerRowOfPlane(pixelBuffer, 1);
-
-			if ((width[1] != new_width) || (height[1] != new_height)) {
-				// printf("Camera CbCr plane %i, %i - %i\n", new_width, new_height, bytes_per_row);
-
-				width[1] = new_width;
-				height[1] = new_height;
-				img_data[1].resize(2 * new_width * new_height);
-			}
-
-			PoolVector<uint8_t>::Write w = img_data[1].write();
-			memcpy(w.ptr(), dataCbCr, 2 * new_width * new_height);
-
-			///TODO GLES2 doesn't support FORMAT_RG8, need to do some form of conversion
-			img[1].instance();
-			img[1]->create(new_width, new_height, 0, Image::FORMAT_RG8, img_data[1]);
-		}
-
-		// set our texture...
-		feed->set_YCbCr_imgs(img[0], img[1]);
+		// the feed copies the planes straight into buffers it reuses between frames (and skips them if it isn't active)
+		///TODO GLES2 doesn't support FORMAT_RG8, need to do some form of conversion
+		feed->set_YCbCr_planes(dataY, CVPixelBufferGetWidthOfPlane(pixelBuffer, 0), CVPixelBufferGetHeightOfPlane(pixelBuffer, 0), CVPixelBufferGetBytesPerRowOfPlane(pixelBuffer, 0),
+				dataCbCr, CVPixelBufferGetWidthOfPlane(pixelBuffer, 1), CVPixelBufferGetHeightOfPlane(pixelBuffer, 1), CVPixelBufferGetBytesPerRowOfPlane(pixelBuffer, 1));
 
 		// update our matrix to match the orientation, note, before changing anything
 		// here, be aware that the project orientation settings must match your xcode
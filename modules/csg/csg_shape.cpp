@@ -50,7 +50,7 @@ void CSGShape::set_use_collision(bool p_enable) {
 		PhysicsServer::get_singleton()->body_attach_object_instance_id(root_collision_instance, get_instance_id());
 		set_collision_layer(collision_layer);
 		set_collision_mask(collision_mask);
-		_make_dirty(); //force update
+		_make_dirty(false); //force update
 	} else {
 		PhysicsServer::get_singleton()->free(root_collision_instance);
 		root_collision_instance = RID();
@@ -131,7 +131,11 @@ float CSGShape::get_snap() const {
 	return snap;
 }
 
-void CSGShape::_make_dirty() {
+void CSGShape::_make_dirty(bool p_shape_changed) {
+
+	if (p_shape_changed) {
+		self_dirty = true;
+	}
 
 	if (!is_inside_tree())
 		return;
@@ -143,76 +147,210 @@ void CSGShape::_make_dirty() {
 	dirty = true;
 
 	if (parent) {
-		parent->_make_dirty();
+		parent->_make_dirty(false);
 	} else {
 		//only parent will do
 		call_deferred("_update_shape");
 	}
 }
 
-CSGBrush *CSGShape::_get_brush() {
+void CSGShape::_free_steps(Vector<CombineStep> &r_steps) {
 
-	if (dirty) {
-		if (brush) {
-			memdelete(brush);
+	for (int i = 0; i < r_steps.size(); i++) {
+		if (r_steps[i].result) {
+			memdelete(r_steps[i].result);
 		}
-		brush = NULL;
+	}
+	r_steps.clear();
+}
 
-		CSGBrush *n = _build_brush();
+CSGShape::BuildNode *CSGShape::_create_build_node(CSGShape *p_shape) {
 
-		for (int i = 0; i < get_child_count(); i++) {
+	if (p_shape->building) {
+		//caches are still held by an unfinished build, start over
+		p_shape->self_dirty = true;
+		p_shape->dirty = true;
+	}
 
-			CSGShape *child = Object::cast_to<CSGShape>(get_child(i));
+	if (p_shape->self_dirty) {
+		_free_steps(p_shape->steps);
+		if (p_shape->self_brush) {
+			memdelete(p_shape->self_brush);
+		}
+		p_shape->self_brush = p_shape->_build_brush();
+		p_shape->brush = p_shape->self_brush;
+		p_shape->self_dirty = false;
+		p_shape->dirty = true;
+	}
+
+	BuildNode *n = memnew(BuildNode);
+	n->id = p_shape->get_instance_id();
+	n->generation = ++p_shape->build_generation;
+	n->dirty = p_shape->dirty;
+	n->snap = p_shape->snap;
+	n->self_brush = p_shape->self_brush;
+	n->steps = p_shape->steps;
+	n->brush = p_shape->brush;
+	n->version = p_shape->brush_version;
+	n->aabb = p_shape->node_aabb;
+
+	p_shape->self_brush = NULL;
+	p_shape->steps.clear();
+	p_shape->brush = NULL;
+	p_shape->building = true;
+	p_shape->dirty = false;
+
+	if (n->dirty) {
+		for (int i = 0; i < p_shape->get_child_count(); i++) {
+
+			CSGShape *child = Object::cast_to<CSGShape>(p_shape->get_child(i));
 			if (!child)
 				continue;
 			if (!child->is_visible_in_tree())
 				continue;
 
-			CSGBrush *n2 = child->_get_brush();
-			if (!n2)
-				continue;
+			BuildNode::Child c;
+			c.node = _create_build_node(child);
+			c.xform = child->get_transform();
+			c.operation = child->get_operation();
+			n->children.push_back(c);
+		}
+	}
+
+	return n;
+}
+
+void CSGShape::_combine_build_node(BuildNode *p_node) {
+
+	if (!p_node->dirty)
+		return;
+
+	for (int i = 0; i < p_node->children.size(); i++) {
+		_combine_build_node(p_node->children[i].node);
+	}
+
+	//steps are valid as long as nothing changed before them
+	int valid = 0;
+	while (valid < p_node->steps.size() && valid < p_node->children.size()) {
+
+		const CombineStep &step = p_node->steps[valid];
+		const BuildNode::Child &c = p_node->children[valid];
+		if (step.child != c.node->id || step.child_version != c.node->version || step.operation != c.operation || step.snap != p_node->snap || !(step.xform == c.xform))
+			break;
+		valid++;
+	}
+
+	for (int i = valid; i < p_node->steps.size(); i++) {
+		if (p_node->steps[i].result) {
+			memdelete(p_node->steps[i].result);
+		}
+	}
+	p_node->steps.resize(valid);
+
+	CSGBrush *n = p_node->self_brush;
+	for (int i = 0; i < valid; i++) {
+		if (p_node->steps[i].result) {
+			n = p_node->steps[i].result;
+		}
+	}
+
+	for (int i = valid; i < p_node->children.size(); i++) {
+
+		const BuildNode::Child &c = p_node->children[i];
+
+		CombineStep step;
+		step.child = c.node->id;
+		step.child_version = c.node->version;
+		step.xform = c.xform;
+		step.operation = c.operation;
+		step.snap = p_node->snap;
+		step.result = NULL;
+
+		CSGBrush *n2 = c.node->brush;
+		if (n2) {
 			if (!n) {
-				n = memnew(CSGBrush);
+				step.result = memnew(CSGBrush);
 
-				n->copy_from(*n2, child->get_transform());
+				step.result->copy_from(*n2, c.xform);
 
 			} else {
 
 				CSGBrush *nn = memnew(CSGBrush);
 				CSGBrush *nn2 = memnew(CSGBrush);
-				nn2->copy_from(*n2, child->get_transform());
+				nn2->copy_from(*n2, c.xform);
 
 				CSGBrushOperation bop;
 
-				switch (child->get_operation()) {
-					case CSGShape::OPERATION_UNION: bop.merge_brushes(CSGBrushOperation::OPERATION_UNION, *n, *nn2, *nn, snap); break;
-					case CSGShape::OPERATION_INTERSECTION: bop.merge_brushes(CSGBrushOperation::OPERATION_INTERSECTION, *n, *nn2, *nn, snap); break;
-					case CSGShape::OPERATION_SUBTRACTION: bop.merge_brushes(CSGBrushOperation::OPERATION_SUBSTRACTION, *n, *nn2, *nn, snap); break;
+				switch (c.operation) {
+					case CSGShape::OPERATION_UNION: bop.merge_brushes(CSGBrushOperation::OPERATION_UNION, *n, *nn2, *nn, p_node->snap); break;
+					case CSGShape::OPERATION_INTERSECTION: bop.merge_brushes(CSGBrushOperation::OPERATION_INTERSECTION, *n, *nn2, *nn, p_node->snap); break;
+					case CSGShape::OPERATION_SUBTRACTION: bop.merge_brushes(CSGBrushOperation::OPERATION_SUBSTRACTION, *n, *nn2, *nn, p_node->snap); break;
 				}
-				memdelete(n);
 				memdelete(nn2);
-				n = nn;
+				step.result = nn;
 			}
+			n = step.result;
 		}
 
-		if (n) {
-			AABB aabb;
-			for (int i = 0; i < n->faces.size(); i++) {
-				for (int j = 0; j < 3; j++) {
-					if (i == 0 && j == 0)
-						aabb.position = n->faces[i].vertices[j];
-					else
-						aabb.expand_to(n->faces[i].vertices[j]);
-				}
+		p_node->steps.push_back(step);
+	}
+
+	if (n) {
+		AABB aabb;
+		for (int i = 0; i < n->faces.size(); i++) {
+			for (int j = 0; j < 3; j++) {
+				if (i == 0 && j == 0)
+					aabb.position = n->faces[i].vertices[j];
+				else
+					aabb.expand_to(n->faces[i].vertices[j]);
 			}
-			node_aabb = aabb;
-		} else {
-			node_aabb = AABB();
 		}
+		p_node->aabb = aabb;
+	} else {
+		p_node->aabb = AABB();
+	}
 
-		brush = n;
+	p_node->brush = n;
+	p_node->version++;
+}
+
+void CSGShape::_restore_build_node(BuildNode *p_node) {
 
-		dirty = false;
+	for (int i = 0; i < p_node->children.size(); i++) {
+		_restore_build_node(p_node->children[i].node);
+	}
+
+	CSGShape *shape = Object::cast_to<CSGShape>(ObjectDB::get_instance(p_node->id));
+	if (shape && shape->building && shape->build_generation == p_node->generation) {
+		shape->self_brush = p_node->self_brush;
+		shape->steps = p_node->steps;
+		shape->brush = p_node->brush;
+		shape->brush_version = p_node->version;
+		shape->node_aabb = p_node->aabb;
+		shape->building = false;
+	} else {
+		//shape is gone or was checked out again meanwhile
+		_free_steps(p_node->steps);
+		if (p_node->self_brush) {
+			memdelete(p_node->self_brush);
+		}
+	}
+
+	memdelete(p_node);
+}
+
+CSGBrush *CSGShape::_get_brush() {
+
+	CSGShape *root = this;
+	while (root->parent) {
+		root = root->parent;
+	}
+	root->_finish_pending_build(true);
+
+	if (dirty || self_dirty || building) {
+		BuildNode *n = _create_build_node(this);
+		_combine_build_node(n);
+		_restore_build_node(n);
 	}
 
 	return brush;
@@ -273,16 +411,13 @@ void CSGShape::mikktSetTSpaceDefault(const SMikkTSpaceContext *pContext, const f
 	surface.tansw[i++] = d < 0 ? -1 : 1;
 }
 
-void CSGShape::_update_shape() {
+void CSGShape::_build_surfaces(ShapeBuild *p_build) {
 
-	if (parent)
+	const CSGBrush *n = p_build->root->brush;
+	if (!n)
 		return;
 
-	set_base(RID());
-	root_mesh.unref(); //byebye root mesh
-
-	CSGBrush *n = _get_brush();
-	ERR_FAIL_COND_MSG(!n, "Cannot get CSGBrush.");
+	bool calculate_tangents = p_build->calculate_tangents;
 
 	OAHashMap<Vector3, Vector3> vec_map;
 
@@ -343,11 +478,10 @@ void CSGShape::_update_shape() {
 	}
 
 	//fill arrays
-	PoolVector<Vector3> physics_faces;
-	bool fill_physics_faces = false;
-	if (root_collision_shape.is_valid()) {
+	PoolVector<Vector3> &physics_faces = p_build->physics_faces;
+	bool fill_physics_faces = p_build->fill_physics_faces;
+	if (fill_physics_faces) {
 		physics_faces.resize(n->faces.size() * 3);
-		fill_physics_faces = true;
 	}
 
 	{
@@ -413,7 +547,6 @@ void CSGShape::_update_shape() {
 		}
 	}
 
-	root_mesh.instance();
 	//create surfaces
 
 	for (int i = 0; i < surfaces.size(); i++) {
@@ -455,17 +588,92 @@ void CSGShape::_update_shape() {
 			array[Mesh::ARRAY_TANGENT] = surfaces[i].tans;
 		}
 
-		int idx = root_mesh->get_surface_count();
-		root_mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, array);
-		root_mesh->surface_set_material(idx, surfaces[i].material);
+		p_build->surfaces.push_back(Pair<Ref<Material>, Array>(surfaces[i].material, array));
 	}
+}
+
+void CSGShape::_shape_build_task(void *p_userdata, uint32_t p_index) {
+
+	ShapeBuild *build = (ShapeBuild *)p_userdata;
+	_combine_build_node(build->root);
+	_build_surfaces(build);
+}
+
+void CSGShape::_apply_build(ShapeBuild *p_build) {
+
+	bool has_brush = p_build->root->brush != NULL;
+	_restore_build_node(p_build->root);
+
+	set_base(RID());
+	root_mesh.unref(); //byebye root mesh
+
+	ERR_FAIL_COND_MSG(!has_brush, "Cannot get CSGBrush.");
+
+	root_mesh.instance();
 
-	if (root_collision_shape.is_valid()) {
-		root_collision_shape->set_faces(physics_faces);
+	for (int i = 0; i < p_build->surfaces.size(); i++) {
+		root_mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, p_build->surfaces[i].second);
+		root_mesh->surface_set_material(i, p_build->surfaces[i].first);
+	}
+
+	if (root_collision_shape.is_valid() && p_build->fill_physics_faces) {
+		root_collision_shape->set_faces(p_build->physics_faces);
 	}
 
 	set_base(root_mesh->get_rid());
 }
+
+void CSGShape::_finish_pending_build(bool p_wait) {
+
+	if (!pending_build)
+		return;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (!p_wait && !pool->is_task_completed(pending_build->task))
+		return;
+
+	pool->wait_for_task_completion(pending_build->task);
+
+	ShapeBuild *build = pending_build;
+	pending_build = NULL;
+	set_process_internal(false);
+
+	_apply_build(build);
+	memdelete(build);
+
+	if (dirty) {
+		//changed while building
+		call_deferred("_update_shape");
+	}
+}
+
+void CSGShape::_update_shape() {
+
+	if (parent)
+		return;
+
+	if (pending_build)
+		return; //picked up once the pending build is applied
+
+	ShapeBuild *build = memnew(ShapeBuild);
+	build->root = _create_build_node(this);
+	build->calculate_tangents = calculate_tangents;
+	build->fill_physics_faces = root_collision_shape.is_valid();
+	build->task = WorkerThreadPool::INVALID_TASK_ID;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (use_threaded_update && is_inside_tree() && pool && pool->get_thread_count() > 0) {
+		//the current mesh stays until the new one is ready
+		build->task = pool->add_native_task(&CSGShape::_shape_build_task, build);
+		pending_build = build;
+		set_process_internal(true);
+		return;
+	}
+
+	_shape_build_task(build, 0);
+	_apply_build(build);
+	memdelete(build);
+}
 AABB CSGShape::get_aabb() const {
 	return node_aabb;
 }
@@ -521,27 +729,34 @@ void CSGShape::_notification(int p_what) {
 			set_collision_mask(collision_mask);
 		}
 
-		_make_dirty();
+		_make_dirty(false);
 	}
 
 	if (p_what == NOTIFICATION_LOCAL_TRANSFORM_CHANGED) {
 
 		if (parent) {
-			parent->_make_dirty();
+			parent->_make_dirty(false);
 		}
 	}
 
 	if (p_what == NOTIFICATION_VISIBILITY_CHANGED) {
 
 		if (parent) {
-			parent->_make_dirty();
+			parent->_make_dirty(false);
 		}
 	}
 
+	if (p_what == NOTIFICATION_INTERNAL_PROCESS) {
+
+		_finish_pending_build(false);
+	}
+
 	if (p_what == NOTIFICATION_EXIT_TREE) {
 
+		_finish_pending_build(true);
+
 		if (parent)
-			parent->_make_dirty();
+			parent->_make_dirty(false);
 		parent = NULL;
 
 		if (use_collision && is_root_shape() && root_collision_instance.is_valid()) {
@@ -549,14 +764,16 @@ void CSGShape::_notification(int p_what) {
 			root_collision_instance = RID();
 			root_collision_shape.unref();
 		}
-		_make_dirty();
+		_make_dirty(false);
 	}
 }
 
 void CSGShape::set_operation(Operation p_operation) {
 
 	operation = p_operation;
-	_make_dirty();
+	if (parent) {
+		parent->_make_dirty(false);
+	}
 	update_gizmo();
 }
 
@@ -566,13 +783,24 @@ CSGShape::Operation CSGShape::get_operation() const {
 
 void CSGShape::set_calculate_tangents(bool p_calculate_tangents) {
 	calculate_tangents = p_calculate_tangents;
-	_make_dirty();
+	_make_dirty(false);
 }
 
 bool CSGShape::is_calculating_tangents() const {
 	return calculate_tangents;
 }
 
+void CSGShape::set_use_threaded_update(bool p_enable) {
+	use_threaded_update = p_enable;
+	if (!use_threaded_update) {
+		_finish_pending_build(true);
+	}
+}
+
+bool CSGShape::is_using_threaded_update() const {
+	return use_threaded_update;
+}
+
 void CSGShape::_validate_property(PropertyInfo &property) const {
 	bool is_collision_prefixed = property.name.begins_with("collision_");
 	if ((is_collision_prefixed || property.name.begins_with("use_collision")) && is_inside_tree() && !is_root_shape()) {
@@ -624,11 +852,15 @@ void CSGShape::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_calculate_tangents", "enabled"), &CSGShape::set_calculate_tangents);
 	ClassDB::bind_method(D_METHOD("is_calculating_tangents"), &CSGShape::is_calculating_tangents);
 
+	ClassDB::bind_method(D_METHOD("set_use_threaded_update", "enable"), &CSGShape::set_use_threaded_update);
+	ClassDB::bind_method(D_METHOD("is_using_threaded_update"), &CSGShape::is_using_threaded_update);
+
 	ClassDB::bind_method(D_METHOD("get_meshes"), &CSGShape::get_meshes);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "operation", PROPERTY_HINT_ENUM, "Union,Intersection,Subtraction"), "set_operation", "get_operation");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "snap", PROPERTY_HINT_RANGE, "0.0001,1,0.001"), "set_snap", "get_snap");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "calculate_tangents"), "set_calculate_tangents", "is_calculating_tangents");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threaded_update"), "set_use_threaded_update", "is_using_threaded_update");
 
 	ADD_GROUP("Collision", "collision_");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_collision"), "set_use_collision", "is_using_collision");
@@ -643,8 +875,15 @@ void CSGShape::_bind_methods() {
 CSGShape::CSGShape() {
 	operation = OPERATION_UNION;
 	parent = NULL;
+	self_brush = NULL;
 	brush = NULL;
+	brush_version = 0;
+	build_generation = 0;
+	building = false;
 	dirty = false;
+	self_dirty = true;
+	use_threaded_update = false;
+	pending_build = NULL;
 	snap = 0.001;
 	use_collision = false;
 	collision_layer = 1;
@@ -654,10 +893,19 @@ CSGShape::CSGShape() {
 }
 
 CSGShape::~CSGShape() {
-	if (brush) {
-		memdelete(brush);
-		brush = NULL;
+	if (pending_build) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pending_build->task);
+		_restore_build_node(pending_build->root);
+		memdelete(pending_build);
+		pending_build = NULL;
 	}
+
+	_free_steps(steps);
+	if (self_brush) {
+		memdelete(self_brush);
+	}
+	self_brush = NULL;
+	brush = NULL;
 }
 //////////////////////////////////
 
@@ -33,6 +33,7 @@
 
 #define CSGJS_HEADER_ONLY
 
+#include "core/os/worker_thread_pool.h"
 #include "csg.h"
 #include "scene/3d/visual_instance.h"
 #include "scene/resources/concave_polygon_shape.h"
@@ -53,13 +54,66 @@ private:
 	Operation operation;
 	CSGShape *parent;
 
-	CSGBrush *brush;
+	/**
+	 * Every shape caches its own brush and the result of each child it combined with it, so
+	 * a change only recomputes the steps from the changed child on, and only on the path to
+	 * the root. To build, the caches are moved into a tree of BuildNodes, which only holds
+	 * data and can be combined away from the main thread, then moved back.
+	 */
+	struct CombineStep {
+		ObjectID child;
+		uint64_t child_version;
+		Transform xform;
+		Operation operation;
+		float snap;
+		CSGBrush *result; //NULL if the child added nothing
+	};
+
+	struct BuildNode {
+
+		struct Child {
+			BuildNode *node;
+			Transform xform;
+			Operation operation;
+		};
+
+		ObjectID id;
+		uint64_t generation;
+		bool dirty;
+		float snap;
+		CSGBrush *self_brush;
+		Vector<CombineStep> steps;
+		CSGBrush *brush;
+		uint64_t version;
+		AABB aabb;
+		Vector<Child> children;
+	};
+
+	struct ShapeBuild {
+		BuildNode *root;
+		bool calculate_tangents;
+		bool fill_physics_faces;
+		Vector<Pair<Ref<Material>, Array> > surfaces;
+		PoolVector<Vector3> physics_faces;
+		WorkerThreadPool::TaskID task;
+	};
+
+	CSGBrush *self_brush;
+	Vector<CombineStep> steps;
+	CSGBrush *brush; //points to self_brush or to the last step result
+	uint64_t brush_version;
+	uint64_t build_generation;
+	bool building; //caches are held by a BuildNode
 
 	AABB node_aabb;
 
 	bool dirty;
+	bool self_dirty;
 	float snap;
 
+	bool use_threaded_update;
+	ShapeBuild *pending_build;
+
 	bool use_collision;
 	uint32_t collision_layer;
 	uint32_t collision_mask;
@@ -102,12 +156,22 @@ private:
 	static void mikktSetTSpaceDefault(const SMikkTSpaceContext *pContext, const float fvTangent[], const float fvBiTangent[], const float fMagS, const float fMagT,
 			const tbool bIsOrientationPreserving, const int iFace, const int iVert);
 
+	static void _free_steps(Vector<CombineStep> &r_steps);
+	static BuildNode *_create_build_node(CSGShape *p_shape);
+	static void _combine_build_node(BuildNode *p_node);
+	static void _restore_build_node(BuildNode *p_node);
+	static void _build_surfaces(ShapeBuild *p_build);
+	static void _shape_build_task(void *p_userdata, uint32_t p_index);
+
+	void _apply_build(ShapeBuild *p_build);
+	void _finish_pending_build(bool p_wait);
+
 	void _update_shape();
 
 protected:
 	void _notification(int p_what);
 	virtual CSGBrush *_build_brush() = 0;
-	void _make_dirty();
+	void _make_dirty(bool p_shape_changed = true);
 
 	static void _bind_methods();
 
@@ -148,6 +212,9 @@ public:
 	void set_calculate_tangents(bool p_calculate_tangents);
 	bool is_calculating_tangents() const;
 
+	void set_use_threaded_update(bool p_enable);
+	bool is_using_threaded_update() const;
+
 	bool is_root_shape() const;
 	CSGShape();
 	~CSGShape();
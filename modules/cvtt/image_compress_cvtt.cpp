@@ -31,7 +31,7 @@
 #include "image_compress_cvtt.h"
 
 #include "core/os/os.h"
-#include "core/os/thread.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/print_string.h"
 
 #include <ConvectionKernels.h>
@@ -55,8 +55,8 @@ struct CVTTCompressionRowTask {
 struct CVTTCompressionJobQueue {
 	CVTTCompressionJobParams job_params;
 	const CVTTCompressionRowTask *job_tasks;
-	uint32_t num_tasks;
-	uint32_t current_task;
+
+	void digest_task(uint32_t p_index, void *);
 };
 
 static void _digest_row_task(const CVTTCompressionJobParams &p_job_params, const CVTTCompressionRowTask &p_row_task) {
@@ -128,12 +128,8 @@ static void _digest_row_task(const CVTTCompressionJobParams &p_job_params, const
 	}
 }
 
-static void _digest_job_queue(void *p_job_queue) {
-	CVTTCompressionJobQueue *job_queue = static_cast<CVTTCompressionJobQueue *>(p_job_queue);
-
-	for (uint32_t next_task = atomic_increment(&job_queue->current_task); next_task <= job_queue->num_tasks; next_task = atomic_increment(&job_queue->current_task)) {
-		_digest_row_task(job_queue->job_params, job_queue->job_tasks[next_task - 1]);
-	}
+void CVTTCompressionJobQueue::digest_task(uint32_t p_index, void *) {
+	_digest_row_task(job_params, job_tasks[p_index]);
 }
 
 void image_compress_cvtt(Image *p_image, float p_lossy_quality, Image::CompressSource p_source) {
@@ -213,13 +209,10 @@ void image_compress_cvtt(Image *p_image, float p_lossy_quality, Image::CompressS
 	job_queue.job_params.options = options;
 	job_queue.job_params.bytes_per_pixel = is_hdr ? 6 : 4;
 
-#ifdef NO_THREADS
-	int num_job_threads = 0;
-#else
-	int num_job_threads = OS::get_singleton()->can_use_threads() ? (OS::get_singleton()->get_processor_count() - 1) : 0;
-#endif
+	//rows of blocks of all mipmap levels are compressed together on the worker pool
+	bool use_threads = WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0;
 
-	PoolVector<CVTTCompressionRowTask> tasks;
+	Vector<CVTTCompressionRowTask> tasks;
 
 	for (int i = 0; i <= mm_count; i++) {
 
@@ -239,7 +232,7 @@ void image_compress_cvtt(Image *p_image, float p_lossy_quality, Image::CompressS
 			row_task.in_mm_bytes = in_bytes;
 			row_task.out_mm_bytes = out_bytes;
 
-			if (num_job_threads > 0) {
+			if (use_threads) {
 				tasks.push_back(row_task);
 			} else {
 				_digest_row_task(job_queue.job_params, row_task);
@@ -253,27 +246,9 @@ void image_compress_cvtt(Image *p_image, float p_lossy_quality, Image::CompressS
 		h = MAX(h / 2, 1);
 	}
 
-	if (num_job_threads > 0) {
-		PoolVector<Thread *> threads;
-		threads.resize(num_job_threads);
-
-		PoolVector<Thread *>::Write threads_wb = threads.write();
-
-		PoolVector<CVTTCompressionRowTask>::Read tasks_rb = tasks.read();
-
-		job_queue.job_tasks = &tasks_rb[0];
-		job_queue.current_task = 0;
-		job_queue.num_tasks = static_cast<uint32_t>(tasks.size());
-
-		for (int i = 0; i < num_job_threads; i++) {
-			threads_wb[i] = Thread::create(_digest_job_queue, &job_queue);
-		}
-		_digest_job_queue(&job_queue);
-
-		for (int i = 0; i < num_job_threads; i++) {
-			Thread::wait_to_finish(threads_wb[i]);
-			memdelete(threads_wb[i]);
-		}
+	if (tasks.size()) {
+		job_queue.job_tasks = tasks.ptr();
+		WorkerThreadPool::get_singleton()->parallel_for(tasks.size(), &job_queue, &CVTTCompressionJobQueue::digest_task, (void *)NULL);
 	}
 
 	p_image->create(p_image->get_width(), p_image->get_height(), p_image->has_mipmaps(), target_format, data);
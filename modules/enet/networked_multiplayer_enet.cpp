@@ -112,6 +112,11 @@ Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int
 	refuse_connections = false;
 	unique_id = 1;
 	connection_status = CONNECTION_CONNECTED;
+
+	if (threaded) {
+		_start_thread();
+	}
+
 	return OK;
 }
 Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_port, int p_in_bandwidth, int p_out_bandwidth, int p_client_port) {
@@ -198,6 +203,10 @@ Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_por
 	server = false;
 	refuse_connections = false;
 
+	if (threaded) {
+		_start_thread();
+	}
+
 	return OK;
 }
 
@@ -207,6 +216,36 @@ void NetworkedMultiplayerENet::poll() {
 
 	_pop_current_packet();
 
+	if (!thread) {
+		_service();
+		return;
+	}
+
+	// Take everything the network thread gathered since the last poll.
+	List<Notification> notifications;
+
+	mutex->lock();
+	for (List<Packet>::Element *E = thread_packets.front(); E; E = E->next()) {
+		incoming_packets.push_back(E->get());
+	}
+	thread_packets.clear();
+	for (List<Notification>::Element *E = thread_notifications.front(); E; E = E->next()) {
+		notifications.push_back(E->get());
+	}
+	thread_notifications.clear();
+	mutex->unlock();
+
+	for (List<Notification>::Element *E = notifications.front(); E; E = E->next()) {
+
+		if (!active) // Might have been disconnected while emitting a notification
+			return;
+
+		_dispatch_notification(E->get());
+	}
+}
+
+void NetworkedMultiplayerENet::_service() {
+
 	ENetEvent event;
 	/* Keep servicing until there are no available events left in queue. */
 	while (true) {
@@ -250,9 +289,7 @@ void NetworkedMultiplayerENet::poll() {
 
 				peer_map[*new_id] = event.peer;
 
-				connection_status = CONNECTION_CONNECTED; // If connecting, this means it connected to something!
-
-				emit_signal("peer_connected", *new_id);
+				_notify(NOTIFY_PEER_CONNECTED, *new_id);
 
 				if (server) {
 					// Do not notify other peers when server_relay is disabled.
@@ -277,7 +314,7 @@ void NetworkedMultiplayerENet::poll() {
 					}
 				} else {
 
-					emit_signal("connection_succeeded");
+					_notify(NOTIFY_CONNECTION_SUCCEEDED);
 				}
 
 			} break;
@@ -289,7 +326,7 @@ void NetworkedMultiplayerENet::poll() {
 
 				if (!id) {
 					if (!server) {
-						emit_signal("connection_failed");
+						_notify(NOTIFY_CONNECTION_FAILED);
 					}
 					// Never fully connected.
 					break;
@@ -298,8 +335,7 @@ void NetworkedMultiplayerENet::poll() {
 				if (!server) {
 
 					// Client just disconnected from server.
-					emit_signal("server_disconnected");
-					close_connection();
+					_notify(NOTIFY_SERVER_DISCONNECTED);
 					return;
 				} else if (server_relay) {
 
@@ -316,7 +352,7 @@ void NetworkedMultiplayerENet::poll() {
 					}
 				}
 
-				emit_signal("peer_disconnected", *id);
+				_notify(NOTIFY_PEER_DISCONNECTED, *id);
 				peer_map.erase(*id);
 				memdelete(id);
 			} break;
@@ -336,13 +372,13 @@ void NetworkedMultiplayerENet::poll() {
 						case SYSMSG_ADD_PEER: {
 
 							peer_map[id] = NULL;
-							emit_signal("peer_connected", id);
+							_notify(NOTIFY_PEER_CONNECTED, id);
 
 						} break;
 						case SYSMSG_REMOVE_PEER: {
 
 							peer_map.erase(id);
-							emit_signal("peer_disconnected", id);
+							_notify(NOTIFY_PEER_DISCONNECTED, id);
 						} break;
 					}
 
@@ -370,14 +406,14 @@ void NetworkedMultiplayerENet::poll() {
 
 						if (target == 1) {
 							// To myself and only myself
-							incoming_packets.push_back(packet);
+							_queue_packet(packet);
 						} else if (!server_relay) {
 							// No other destination is allowed when server is not relaying
 							continue;
 						} else if (target == 0) {
 							// Re-send to everyone but sender :|
 
-							incoming_packets.push_back(packet);
+							_queue_packet(packet);
 							// And make copies for sending
 							for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
 
@@ -405,7 +441,7 @@ void NetworkedMultiplayerENet::poll() {
 
 							if (-target != 1) {
 								// Server is not excluded
-								incoming_packets.push_back(packet);
+								_queue_packet(packet);
 							} else {
 								// Server is excluded, erase packet
 								enet_packet_destroy(packet.packet);
@@ -418,7 +454,7 @@ void NetworkedMultiplayerENet::poll() {
 						}
 					} else {
 
-						incoming_packets.push_back(packet);
+						_queue_packet(packet);
 					}
 
 					// Destroy packet later
@@ -434,6 +470,114 @@ void NetworkedMultiplayerENet::poll() {
 	}
 }
 
+void NetworkedMultiplayerENet::_queue_packet(const Packet &p_packet) {
+
+	if (thread) {
+		thread_packets.push_back(p_packet);
+	} else {
+		incoming_packets.push_back(p_packet);
+	}
+}
+
+void NetworkedMultiplayerENet::_notify(NotificationType p_type, int p_id) {
+
+	Notification notification;
+	notification.type = p_type;
+	notification.id = p_id;
+
+	if (thread) {
+		// Signals must be emitted from the main thread, defer to poll().
+		thread_notifications.push_back(notification);
+	} else {
+		_dispatch_notification(notification);
+	}
+}
+
+void NetworkedMultiplayerENet::_dispatch_notification(const Notification &p_notification) {
+
+	switch (p_notification.type) {
+		case NOTIFY_PEER_CONNECTED: {
+
+			connection_status = CONNECTION_CONNECTED; // If connecting, this means it connected to something!
+			emit_signal("peer_connected", p_notification.id);
+		} break;
+		case NOTIFY_PEER_DISCONNECTED: {
+
+			emit_signal("peer_disconnected", p_notification.id);
+		} break;
+		case NOTIFY_CONNECTION_SUCCEEDED: {
+
+			emit_signal("connection_succeeded");
+		} break;
+		case NOTIFY_CONNECTION_FAILED: {
+
+			emit_signal("connection_failed");
+		} break;
+		case NOTIFY_SERVER_DISCONNECTED: {
+
+			emit_signal("server_disconnected");
+			if (active) // Might have been disconnected while emitting the signal
+				close_connection();
+		} break;
+	}
+}
+
+void NetworkedMultiplayerENet::_thread_func(void *p_ud) {
+
+	NetworkedMultiplayerENet *enet = (NetworkedMultiplayerENet *)p_ud;
+
+	while (!enet->thread_exit) {
+
+		uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+
+		enet->mutex->lock();
+		enet->_service();
+		enet->mutex->unlock();
+
+		uint64_t interval = 1000000 / enet->thread_poll_rate;
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - ticks;
+		if (elapsed < interval) {
+			OS::get_singleton()->delay_usec(interval - elapsed);
+		}
+	}
+}
+
+void NetworkedMultiplayerENet::_start_thread() {
+
+	mutex = Mutex::create();
+	thread_exit = false;
+
+	// Hold the lock so the thread does not service the host before it knows it is threaded.
+	mutex->lock();
+	thread = Thread::create(_thread_func, this);
+	mutex->unlock();
+
+	if (!thread) {
+		// No thread support, fall back to servicing in poll().
+		memdelete(mutex);
+		mutex = NULL;
+	}
+}
+
+void NetworkedMultiplayerENet::_stop_thread() {
+
+	if (!thread)
+		return;
+
+	thread_exit = true;
+	Thread::wait_to_finish(thread);
+	memdelete(thread);
+	thread = NULL;
+	memdelete(mutex);
+	mutex = NULL;
+
+	for (List<Packet>::Element *E = thread_packets.front(); E; E = E->next()) {
+		enet_packet_destroy(E->get().packet);
+	}
+	thread_packets.clear();
+	thread_notifications.clear();
+}
+
 bool NetworkedMultiplayerENet::is_server() const {
 	ERR_FAIL_COND_V(!active, false);
 
@@ -444,6 +588,7 @@ void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
 
 	ERR_FAIL_COND(!active);
 
+	_stop_thread();
 	_pop_current_packet();
 
 	bool peers_disconnected = false;
@@ -476,6 +621,8 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 
 	ERR_FAIL_COND(!active);
 	ERR_FAIL_COND(!is_server());
+
+	MutexLock lock(mutex);
 	ERR_FAIL_COND(!peer_map.has(p_peer));
 
 	if (now) {
@@ -557,6 +704,8 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 	if (transfer_channel > SYSCH_CONFIG)
 		channel = transfer_channel;
 
+	MutexLock lock(mutex);
+
 	Map<int, ENetPeer *>::Element *E = NULL;
 
 	if (target_peer != 0) {
@@ -600,7 +749,10 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 		enet_peer_send(peer_map[1], channel, packet); // Send to server for broadcast
 	}
 
-	enet_host_flush(host);
+	if (!thread) {
+		// The network thread sends queued packets on its next service.
+		enet_host_flush(host);
+	}
 
 	return OK;
 }
@@ -781,6 +933,8 @@ void NetworkedMultiplayerENet::enet_compressor_destroy(void *context) {
 
 IP_Address NetworkedMultiplayerENet::get_peer_address(int p_peer_id) const {
 
+	MutexLock lock(mutex);
+
 	ERR_FAIL_COND_V(!peer_map.has(p_peer_id), IP_Address());
 	ERR_FAIL_COND_V(!is_server() && p_peer_id != 1, IP_Address());
 	ERR_FAIL_COND_V(peer_map[p_peer_id] == NULL, IP_Address());
@@ -797,6 +951,8 @@ IP_Address NetworkedMultiplayerENet::get_peer_address(int p_peer_id) const {
 
 int NetworkedMultiplayerENet::get_peer_port(int p_peer_id) const {
 
+	MutexLock lock(mutex);
+
 	ERR_FAIL_COND_V(!peer_map.has(p_peer_id), 0);
 	ERR_FAIL_COND_V(!is_server() && p_peer_id != 1, 0);
 	ERR_FAIL_COND_V(peer_map[p_peer_id] == NULL, 0);
@@ -847,6 +1003,26 @@ bool NetworkedMultiplayerENet::is_server_relay_enabled() const {
 	return server_relay;
 }
 
+void NetworkedMultiplayerENet::set_threaded_enabled(bool p_enabled) {
+	ERR_FAIL_COND(active);
+
+	threaded = p_enabled;
+}
+
+bool NetworkedMultiplayerENet::is_threaded_enabled() const {
+	return threaded;
+}
+
+void NetworkedMultiplayerENet::set_thread_poll_rate(int p_rate) {
+	ERR_FAIL_COND(p_rate < 1);
+
+	thread_poll_rate = p_rate;
+}
+
+int NetworkedMultiplayerENet::get_thread_poll_rate() const {
+	return thread_poll_rate;
+}
+
 void NetworkedMultiplayerENet::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("create_server", "port", "max_clients", "in_bandwidth", "out_bandwidth"), &NetworkedMultiplayerENet::create_server, DEFVAL(32), DEFVAL(0), DEFVAL(0));
@@ -869,12 +1045,18 @@ void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_always_ordered"), &NetworkedMultiplayerENet::is_always_ordered);
 	ClassDB::bind_method(D_METHOD("set_server_relay_enabled", "enabled"), &NetworkedMultiplayerENet::set_server_relay_enabled);
 	ClassDB::bind_method(D_METHOD("is_server_relay_enabled"), &NetworkedMultiplayerENet::is_server_relay_enabled);
+	ClassDB::bind_method(D_METHOD("set_threaded_enabled", "enabled"), &NetworkedMultiplayerENet::set_threaded_enabled);
+	ClassDB::bind_method(D_METHOD("is_threaded_enabled"), &NetworkedMultiplayerENet::is_threaded_enabled);
+	ClassDB::bind_method(D_METHOD("set_thread_poll_rate", "rate"), &NetworkedMultiplayerENet::set_thread_poll_rate);
+	ClassDB::bind_method(D_METHOD("get_thread_poll_rate"), &NetworkedMultiplayerENet::get_thread_poll_rate);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "None,Range Coder,FastLZ,ZLib,ZStd"), "set_compression_mode", "get_compression_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "transfer_channel"), "set_transfer_channel", "get_transfer_channel");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "channel_count"), "set_channel_count", "get_channel_count");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "always_ordered"), "set_always_ordered", "is_always_ordered");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded"), "set_threaded_enabled", "is_threaded_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "thread_poll_rate", PROPERTY_HINT_RANGE, "1,10000,1"), "set_thread_poll_rate", "get_thread_poll_rate");
 
 	BIND_ENUM_CONSTANT(COMPRESS_NONE);
 	BIND_ENUM_CONSTANT(COMPRESS_RANGE_CODER);
@@ -889,6 +1071,11 @@ NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
 	server = false;
 	refuse_connections = false;
 	server_relay = true;
+	threaded = false;
+	thread_poll_rate = 1000;
+	thread = NULL;
+	mutex = NULL;
+	thread_exit = false;
 	unique_id = 0;
 	target_peer = 0;
 	current_packet.packet = NULL;
@@ -33,6 +33,8 @@
 
 #include "core/io/compression.h"
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
 
 #include <enet/enet.h>
 
@@ -55,6 +57,14 @@ private:
 		SYSMSG_REMOVE_PEER
 	};
 
+	enum NotificationType {
+		NOTIFY_PEER_CONNECTED,
+		NOTIFY_PEER_DISCONNECTED,
+		NOTIFY_CONNECTION_SUCCEEDED,
+		NOTIFY_CONNECTION_FAILED,
+		NOTIFY_SERVER_DISCONNECTED
+	};
+
 	enum {
 		SYSCH_CONFIG,
 		SYSCH_RELIABLE,
@@ -97,8 +107,31 @@ private:
 
 	Packet current_packet;
 
+	struct Notification {
+
+		NotificationType type;
+		int id;
+	};
+
+	//network thread, services the host and queues packets and notifications for poll()
+	bool threaded;
+	int thread_poll_rate;
+	Thread *thread;
+	Mutex *mutex;
+	volatile bool thread_exit;
+	List<Packet> thread_packets;
+	List<Notification> thread_notifications;
+
+	static void _thread_func(void *p_ud);
+	void _start_thread();
+	void _stop_thread();
+
 	uint32_t _gen_unique_id() const;
 	void _pop_current_packet();
+	void _service();
+	void _queue_packet(const Packet &p_packet);
+	void _notify(NotificationType p_type, int p_id = 0);
+	void _dispatch_notification(const Notification &p_notification);
 
 	Vector<uint8_t> src_compressor_mem;
 	Vector<uint8_t> dst_compressor_mem;
@@ -161,6 +194,10 @@ public:
 	bool is_always_ordered() const;
 	void set_server_relay_enabled(bool p_enabled);
 	bool is_server_relay_enabled() const;
+	void set_threaded_enabled(bool p_enabled);
+	bool is_threaded_enabled() const;
+	void set_thread_poll_rate(int p_rate);
+	int get_thread_poll_rate() const;
 
 	NetworkedMultiplayerENet();
 	~NetworkedMultiplayerENet();
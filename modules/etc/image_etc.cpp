@@ -34,6 +34,7 @@
 #include "core/image.h"
 #include "core/os/copymem.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/print_string.h"
 
 static Image::Format _get_etc2_mode(Image::DetectChannels format) {
@@ -88,6 +89,47 @@ static Etc::Image::Format _image_format_to_etc2comp_format(Image::Format format)
 	}
 }
 
+struct EtcMipmapTask {
+	const uint8_t *src;
+	uint8_t *dst;
+	int width;
+	int height;
+	unsigned int dst_size;
+	unsigned int jobs;
+};
+
+struct EtcMipmapJob {
+	const EtcMipmapTask *tasks;
+	Etc::Image::Format format;
+	Etc::ErrorMetric error_metric;
+	float effort;
+
+	void encode_task(uint32_t p_index, void *) {
+
+		const EtcMipmapTask &task = tasks[p_index];
+
+		// convert source image to internal etc2comp format (which is equivalent to Image::FORMAT_RGBAF)
+		// NOTE: We can alternatively add a case to Image::convert to handle Image::FORMAT_RGBAF conversion.
+		Etc::ColorFloatRGBA *src_rgba_f = new Etc::ColorFloatRGBA[task.width * task.height];
+		for (int j = 0; j < task.width * task.height; j++) {
+			int si = j * 4; // RGBA8
+			src_rgba_f[j] = Etc::ColorFloatRGBA::ConvertFromRGBA8(task.src[si], task.src[si + 1], task.src[si + 2], task.src[si + 3]);
+		}
+
+		unsigned char *etc_data = NULL;
+		unsigned int etc_data_len = 0;
+		unsigned int extended_width = 0, extended_height = 0;
+		int encoding_time = 0;
+		Etc::Encode((float *)src_rgba_f, task.width, task.height, format, error_metric, effort, task.jobs, task.jobs, &etc_data, &etc_data_len, &extended_width, &extended_height, &encoding_time);
+
+		CRASH_COND(etc_data_len > task.dst_size);
+		memcpy(task.dst, etc_data, etc_data_len);
+
+		delete[] etc_data;
+		delete[] src_rgba_f;
+	}
+};
+
 static void _compress_etc(Image *p_img, float p_lossy_quality, bool force_etc1_format, Image::CompressSource p_source) {
 	Image::Format img_format = p_img->get_format();
 	Image::DetectChannels detected_channels = p_img->get_detected_channels();
@@ -191,8 +233,7 @@ static void _compress_etc(Image *p_img, float p_lossy_quality, bool force_etc1_f
 	PoolVector<uint8_t>::Write w = dst_data.write();
 
 	// prepare parameters to be passed to etc2comp
-	int num_cpus = OS::get_singleton()->get_processor_count();
-	int encoding_time = 0;
+	unsigned int num_cpus = OS::get_singleton()->get_processor_count();
 	float effort = 0.0; //default, reasonable time
 
 	if (p_lossy_quality > 0.75)
@@ -202,37 +243,48 @@ static void _compress_etc(Image *p_img, float p_lossy_quality, bool force_etc1_f
 	else if (p_lossy_quality > 0.95)
 		effort = 0.8;
 
-	Etc::ErrorMetric error_metric = Etc::ErrorMetric::RGBX; // NOTE: we can experiment with other error metrics
-	Etc::Image::Format etc2comp_etc_format = _image_format_to_etc2comp_format(etc_format);
+	EtcMipmapJob job;
+	job.error_metric = Etc::ErrorMetric::RGBX; // NOTE: we can experiment with other error metrics
+	job.format = _image_format_to_etc2comp_format(etc_format);
+	job.effort = effort;
 
-	int wofs = 0;
+	// mipmap levels are encoded at the same time, each one with a share of the cores matching its share of the pixels
+	Vector<EtcMipmapTask> tasks;
+	tasks.resize(mmc);
 
-	print_verbose("ETC: Begin encoding, format: " + Image::get_format_name(etc_format));
-	uint64_t t = OS::get_singleton()->get_ticks_msec();
+	unsigned int total_pixels = 0;
 	for (int i = 0; i < mmc; i++) {
-		// convert source image to internal etc2comp format (which is equivalent to Image::FORMAT_RGBAF)
-		// NOTE: We can alternatively add a case to Image::convert to handle Image::FORMAT_RGBAF conversion.
 		int mipmap_ofs = 0, mipmap_size = 0, mipmap_w = 0, mipmap_h = 0;
 		img->get_mipmap_offset_size_and_dimensions(i, mipmap_ofs, mipmap_size, mipmap_w, mipmap_h);
-		const uint8_t *src = &r[mipmap_ofs];
+		total_pixels += mipmap_w * mipmap_h;
 
-		Etc::ColorFloatRGBA *src_rgba_f = new Etc::ColorFloatRGBA[mipmap_w * mipmap_h];
-		for (int j = 0; j < mipmap_w * mipmap_h; j++) {
-			int si = j * 4; // RGBA8
-			src_rgba_f[j] = Etc::ColorFloatRGBA::ConvertFromRGBA8(src[si], src[si + 1], src[si + 2], src[si + 3]);
-		}
+		EtcMipmapTask &task = tasks.write[i];
+		task.src = &r[mipmap_ofs];
+		task.width = mipmap_w;
+		task.height = mipmap_h;
+	}
 
-		unsigned char *etc_data = NULL;
-		unsigned int etc_data_len = 0;
-		unsigned int extended_width = 0, extended_height = 0;
-		Etc::Encode((float *)src_rgba_f, mipmap_w, mipmap_h, etc2comp_etc_format, error_metric, effort, num_cpus, num_cpus, &etc_data, &etc_data_len, &extended_width, &extended_height, &encoding_time);
+	for (int i = 0; i < mmc; i++) {
+		int dst_ofs = Image::get_image_mipmap_offset(imgw, imgh, etc_format, i);
+		int dst_end = (i + 1 < mmc) ? Image::get_image_mipmap_offset(imgw, imgh, etc_format, i + 1) : target_size;
 
-		CRASH_COND(wofs + etc_data_len > target_size);
-		memcpy(&w[wofs], etc_data, etc_data_len);
-		wofs += etc_data_len;
+		EtcMipmapTask &task = tasks.write[i];
+		task.dst = &w[dst_ofs];
+		task.dst_size = dst_end - dst_ofs;
+		task.jobs = MAX(1u, (unsigned int)((uint64_t)num_cpus * task.width * task.height / total_pixels));
+	}
 
-		delete[] etc_data;
-		delete[] src_rgba_f;
+	job.tasks = tasks.ptr();
+
+	print_verbose("ETC: Begin encoding, format: " + Image::get_format_name(etc_format));
+	uint64_t t = OS::get_singleton()->get_ticks_msec();
+
+	if (mmc > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		WorkerThreadPool::get_singleton()->parallel_for(mmc, &job, &EtcMipmapJob::encode_task, (void *)NULL);
+	} else {
+		for (int i = 0; i < mmc; i++) {
+			job.encode_task(i, NULL);
+		}
 	}
 
 	print_verbose("ETC: Time encoding: " + rtos(OS::get_singleton()->get_ticks_msec() - t));
@@ -69,6 +69,16 @@ void GDAPI godot_method_bind_ptrcall(godot_method_bind *p_method_bind, godot_obj
 	mb->ptrcall(o, p_args, p_ret);
 }
 
+void GDAPI godot_method_bind_ptrcall_batch(godot_method_bind *p_method_bind, godot_object **p_instances, int p_num_instances, const void **p_args, void **r_returns) {
+
+	MethodBind *mb = (MethodBind *)p_method_bind;
+	ERR_FAIL_NULL(mb);
+	ERR_FAIL_COND_MSG(!r_returns && mb->has_return(), "Method returns a value but no return pointers were given.");
+	for (int i = 0; i < p_num_instances; i++) {
+		mb->ptrcall((Object *)p_instances[i], p_args, r_returns ? r_returns[i] : NULL);
+	}
+}
+
 godot_variant GDAPI godot_method_bind_call(godot_method_bind *p_method_bind, godot_object *p_instance, const godot_variant **p_args, const int p_arg_count, godot_variant_call_error *p_call_error) {
 	MethodBind *mb = (MethodBind *)p_method_bind;
 	Object *o = (Object *)p_instance;
@@ -222,6 +222,8 @@ typedef struct {
 godot_method_bind GDAPI *godot_method_bind_get_method(const char *p_classname, const char *p_methodname);
 void GDAPI godot_method_bind_ptrcall(godot_method_bind *p_method_bind, godot_object *p_instance, const void **p_args, void *p_ret);
 godot_variant GDAPI godot_method_bind_call(godot_method_bind *p_method_bind, godot_object *p_instance, const godot_variant **p_args, const int p_arg_count, godot_variant_call_error *p_call_error);
+// calls the method on every instance with the same arguments, r_returns holds one return pointer per instance and may only be NULL for methods without a return value
+void GDAPI godot_method_bind_ptrcall_batch(godot_method_bind *p_method_bind, godot_object **p_instances, int p_num_instances, const void **p_args, void **r_returns);
 ////// Script API
 
 typedef struct godot_gdnative_api_version {
@@ -243,6 +243,43 @@ void GDAPI *godot_nativescript_get_instance_binding_data(int p_idx, godot_object
 
 void GDAPI godot_nativescript_profiling_add_data(const char *p_signature, uint64_t p_time);
 
+/*
+ *
+ *
+ * NativeScript 1.2
+ *
+ *
+ */
+
+// ptrcall methods, arguments and return value are passed as pointers to their native types
+// following the same convention as godot_method_bind_ptrcall
+
+typedef struct {
+	// instance pointer, method data, user data, args, return value
+	GDCALLINGCONV void (*method)(godot_object *, void *, void *, const void **, void *);
+	void *method_data;
+	GDCALLINGCONV void (*free_func)(void *);
+} godot_instance_ptrcall_method;
+
+// adds a ptrcall entry point to a method registered with godot_nativescript_register_method,
+// Variant based callers such as scripts keep using the regular one
+void GDAPI godot_nativescript_register_method_ptrcall(void *p_gdnative_handle, const char *p_name, const char *p_function_name, godot_instance_ptrcall_method p_method);
+
+// cached method handles, resolved once through the class hierarchy of the object and valid
+// for every instance of the same class for as long as the library defining the method is loaded
+
+typedef void godot_nativescript_method_handle;
+
+const godot_nativescript_method_handle GDAPI *godot_nativescript_get_method_handle(const godot_object *p_object, const char *p_method);
+
+godot_variant GDAPI godot_nativescript_method_handle_call(const godot_nativescript_method_handle *p_handle, godot_object *p_object, const godot_variant **p_args, int p_num_args);
+void GDAPI godot_nativescript_method_handle_ptrcall(const godot_nativescript_method_handle *p_handle, godot_object *p_object, const void **p_args, void *r_ret);
+
+// batched calls of the same method with the same arguments on many objects, r_returns may be NULL
+// when the results are not needed, otherwise it holds one entry per object
+void GDAPI godot_nativescript_method_handle_call_batch(const godot_nativescript_method_handle *p_handle, godot_object **p_objects, int p_num_objects, const godot_variant **p_args, int p_num_args, godot_variant *r_returns);
+void GDAPI godot_nativescript_method_handle_ptrcall_batch(const godot_nativescript_method_handle *p_handle, godot_object **p_objects, int p_num_objects, const void **p_args, void **r_returns);
+
 #ifdef __cplusplus
 }
 #endif
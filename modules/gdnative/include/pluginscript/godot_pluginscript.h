@@ -162,6 +162,52 @@ typedef struct {
 
 void GDAPI godot_pluginscript_register_language(const godot_pluginscript_language_desc *language_desc);
 
+/*
+ *
+ *
+ * PluginScript 1.1
+ *
+ *
+ */
+
+typedef void godot_pluginscript_method_data;
+
+// Method tables let the engine resolve each method of a script once when the script is loaded,
+// calls then pass the resolved method instead of its name.
+typedef struct {
+	// Returns the language's handle for a method of the script, NULL if the script doesn't define it.
+	godot_pluginscript_method_data *(*get_method)(godot_pluginscript_script_data *p_data, const godot_string_name *p_method);
+	// Releases a handle returned by get_method, called when the script is reloaded or freed.
+	// Note: You can set this function pointer to NULL if not needed.
+	void (*free_method)(godot_pluginscript_script_data *p_data, godot_pluginscript_method_data *p_method);
+
+	godot_variant (*call_method)(godot_pluginscript_instance_data *p_data,
+			godot_pluginscript_method_data *p_method, const godot_variant **p_args,
+			int p_argcount, godot_variant_call_error *r_error);
+
+	// Arguments and return value are passed as pointers to their native types following the same
+	// convention as godot_method_bind_ptrcall, untyped ones (NIL in the manifest) as godot_variant.
+	// The engine uses it when every declared type is bool, int, float, String, Vector2, Vector3,
+	// Color or untyped and the call provides exactly the declared arguments.
+	// Note: You can set this function pointer to NULL if not needed.
+	void (*ptrcall_method)(godot_pluginscript_instance_data *p_data,
+			godot_pluginscript_method_data *p_method, const void **p_args, void *r_ret);
+} godot_pluginscript_method_table_desc;
+
+// Attaches a method table to a language registered with godot_pluginscript_register_language,
+// scripts loaded before this is called resolve their methods on their next reload.
+void GDAPI godot_pluginscript_register_method_table(const char *p_language_name, const godot_pluginscript_method_table_desc *p_method_table_desc);
+
+// Cached method handles, resolved once per script and valid for every instance of it
+// for as long as the script isn't reloaded or freed.
+
+typedef void godot_pluginscript_method_handle;
+
+const godot_pluginscript_method_handle GDAPI *godot_pluginscript_get_method_handle(const godot_object *p_object, const char *p_method);
+
+godot_variant GDAPI godot_pluginscript_method_handle_call(const godot_pluginscript_method_handle *p_handle, godot_object *p_object, const godot_variant **p_args, int p_num_args);
+void GDAPI godot_pluginscript_method_handle_ptrcall(const godot_pluginscript_method_handle *p_handle, godot_object *p_object, const void **p_args, void *r_ret);
+
 #ifdef __cplusplus
 }
 #endif
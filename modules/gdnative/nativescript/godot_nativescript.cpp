@@ -110,6 +110,7 @@ void GDAPI godot_nativescript_register_method(void *p_gdnative_handle, const cha
 	method.method = p_method;
 	method.rpc_mode = p_attr.rpc_type;
 	method.info = MethodInfo(p_function_name);
+	method.owner = &E->get();
 
 	E->get().methods.insert(p_function_name, method);
 }
@@ -321,6 +322,142 @@ void GDAPI godot_nativescript_profiling_add_data(const char *p_signature, uint64
 	NativeScriptLanguage::get_singleton()->profiling_add_data(StringName(p_signature), p_time);
 }
 
+/*
+ *
+ *
+ * NativeScript 1.2
+ *
+ *
+ */
+
+void GDAPI godot_nativescript_register_method_ptrcall(void *p_gdnative_handle, const char *p_name, const char *p_function_name, godot_instance_ptrcall_method p_method) {
+
+	String *s = (String *)p_gdnative_handle;
+
+	Map<StringName, NativeScriptDesc>::Element *E = NSL->library_classes[*s].find(p_name);
+	ERR_FAIL_COND_MSG(!E, "Attempted to register method on non-existent class.");
+
+	Map<StringName, NativeScriptDesc::Method>::Element *M = E->get().methods.find(p_function_name);
+	ERR_FAIL_COND_MSG(!M, "Attempted to register a ptrcall entry for a method that was not registered.");
+
+	if (M->get().ptrcall_method.free_func) {
+		M->get().ptrcall_method.free_func(M->get().ptrcall_method.method_data);
+	}
+	M->get().ptrcall_method = p_method;
+}
+
+static NativeScriptInstance *_get_native_script_instance(Object *p_object) {
+
+	if (!p_object || !p_object->get_script_instance() || p_object->get_script_instance()->get_language() != NativeScriptLanguage::get_singleton()) {
+		return NULL;
+	}
+	return (NativeScriptInstance *)p_object->get_script_instance();
+}
+
+const godot_nativescript_method_handle GDAPI *godot_nativescript_get_method_handle(const godot_object *p_object, const char *p_method) {
+
+	NativeScriptInstance *instance = _get_native_script_instance((Object *)p_object);
+	ERR_FAIL_COND_V_MSG(!instance, NULL, "Object has no NativeScript instance.");
+
+	NativeScript *script = Object::cast_to<NativeScript>(instance->get_script().ptr());
+	ERR_FAIL_COND_V(!script, NULL);
+
+	StringName method = p_method;
+	NativeScriptDesc *script_data = script->get_script_desc();
+	while (script_data) {
+		Map<StringName, NativeScriptDesc::Method>::Element *E = script_data->methods.find(method);
+		if (E) {
+			return (const godot_nativescript_method_handle *)&E->get();
+		}
+		script_data = script_data->base_data;
+	}
+
+	return NULL;
+}
+
+#ifdef DEBUG_ENABLED
+static bool _method_handle_matches(const NativeScriptDesc::Method *p_method, NativeScriptInstance *p_instance) {
+
+	NativeScript *script = Object::cast_to<NativeScript>(p_instance->get_script().ptr());
+	NativeScriptDesc *script_data = script ? script->get_script_desc() : NULL;
+	while (script_data) {
+		if (script_data == p_method->owner) {
+			return true;
+		}
+		script_data = script_data->base_data;
+	}
+	return false;
+}
+
+#define VALIDATE_METHOD_HANDLE(m_method, m_instance, m_retval)                                                               \
+	ERR_FAIL_COND_V_MSG(!m_instance, m_retval, "Object has no NativeScript instance.");                                       \
+	ERR_FAIL_COND_V_MSG(!_method_handle_matches(m_method, m_instance), m_retval, "Method handle does not belong to the class of this object.");
+#else
+#define VALIDATE_METHOD_HANDLE(m_method, m_instance, m_retval) \
+	ERR_FAIL_COND_V_MSG(!m_instance, m_retval, "Object has no NativeScript instance.");
+#endif
+
+godot_variant GDAPI godot_nativescript_method_handle_call(const godot_nativescript_method_handle *p_handle, godot_object *p_object, const godot_variant **p_args, int p_num_args) {
+
+	godot_variant ret;
+	godot_variant_new_nil(&ret);
+
+	const NativeScriptDesc::Method *method = (const NativeScriptDesc::Method *)p_handle;
+	ERR_FAIL_NULL_V(method, ret);
+
+	NativeScriptInstance *instance = _get_native_script_instance((Object *)p_object);
+	VALIDATE_METHOD_HANDLE(method, instance, ret);
+
+	godot_variant_destroy(&ret);
+	return method->method.method(p_object, method->method.method_data, instance->userdata, p_num_args, (godot_variant **)p_args);
+}
+
+void GDAPI godot_nativescript_method_handle_ptrcall(const godot_nativescript_method_handle *p_handle, godot_object *p_object, const void **p_args, void *r_ret) {
+
+	const NativeScriptDesc::Method *method = (const NativeScriptDesc::Method *)p_handle;
+	ERR_FAIL_NULL(method);
+	ERR_FAIL_COND_MSG(!method->ptrcall_method.method, "Method has no ptrcall entry point, register one with godot_nativescript_register_method_ptrcall.");
+
+	NativeScriptInstance *instance = _get_native_script_instance((Object *)p_object);
+	VALIDATE_METHOD_HANDLE(method, instance, );
+
+	method->ptrcall_method.method(p_object, method->ptrcall_method.method_data, instance->userdata, p_args, r_ret);
+}
+
+void GDAPI godot_nativescript_method_handle_call_batch(const godot_nativescript_method_handle *p_handle, godot_object **p_objects, int p_num_objects, const godot_variant **p_args, int p_num_args, godot_variant *r_returns) {
+
+	const NativeScriptDesc::Method *method = (const NativeScriptDesc::Method *)p_handle;
+	ERR_FAIL_NULL(method);
+
+	for (int i = 0; i < p_num_objects; i++) {
+		NativeScriptInstance *instance = _get_native_script_instance((Object *)p_objects[i]);
+		VALIDATE_METHOD_HANDLE(method, instance, );
+
+		godot_variant result = method->method.method(p_objects[i], method->method.method_data, instance->userdata, p_num_args, (godot_variant **)p_args);
+		if (r_returns) {
+			r_returns[i] = result;
+		} else {
+			godot_variant_destroy(&result);
+		}
+	}
+}
+
+void GDAPI godot_nativescript_method_handle_ptrcall_batch(const godot_nativescript_method_handle *p_handle, godot_object **p_objects, int p_num_objects, const void **p_args, void **r_returns) {
+
+	const NativeScriptDesc::Method *method = (const NativeScriptDesc::Method *)p_handle;
+	ERR_FAIL_NULL(method);
+	ERR_FAIL_COND_MSG(!method->ptrcall_method.method, "Method has no ptrcall entry point, register one with godot_nativescript_register_method_ptrcall.");
+
+	for (int i = 0; i < p_num_objects; i++) {
+		NativeScriptInstance *instance = _get_native_script_instance((Object *)p_objects[i]);
+		VALIDATE_METHOD_HANDLE(method, instance, );
+
+		method->ptrcall_method.method(p_objects[i], method->ptrcall_method.method_data, instance->userdata, p_args, r_returns ? r_returns[i] : NULL);
+	}
+}
+
+#undef VALIDATE_METHOD_HANDLE
+
 #ifdef __cplusplus
 }
 #endif
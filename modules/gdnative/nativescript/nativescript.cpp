@@ -979,6 +979,9 @@ void NativeScriptLanguage::_unload_stuff(bool p_reload) {
 			for (Map<StringName, NativeScriptDesc::Method>::Element *M = C->get().methods.front(); M; M = M->next()) {
 				if (M->get().method.free_func)
 					M->get().method.free_func(M->get().method.method_data);
+
+				if (M->get().ptrcall_method.free_func)
+					M->get().ptrcall_method.free_func(M->get().ptrcall_method.method_data);
 			}
 
 			// free constructor/destructor
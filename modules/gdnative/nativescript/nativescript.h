@@ -52,9 +52,18 @@ struct NativeScriptDesc {
 
 	struct Method {
 		godot_instance_method method;
+		godot_instance_ptrcall_method ptrcall_method;
+		NativeScriptDesc *owner;
 		MethodInfo info;
 		int rpc_mode;
 		String documentation;
+
+		Method() {
+			zeromem(&method, sizeof(godot_instance_method));
+			zeromem(&ptrcall_method, sizeof(godot_instance_ptrcall_method));
+			owner = NULL;
+			rpc_mode = 0;
+		}
 	};
 	struct Property {
 		godot_property_set_func setter;
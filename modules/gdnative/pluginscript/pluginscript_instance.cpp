@@ -82,7 +82,11 @@ bool PluginScriptInstance::has_method(const StringName &p_method) const {
 }
 
 Variant PluginScriptInstance::call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
-	// TODO: optimize when calling a Godot method from Godot to avoid param conversion ?
+	const PluginScript::Method *method = _script->get_resolved_method(p_method);
+	if (method) {
+		return call_method(method, p_args, p_argcount, r_error);
+	}
+
 	godot_variant ret = _desc->call_method(
 			_data, (godot_string_name *)&p_method, (const godot_variant **)p_args,
 			p_argcount, (godot_variant_call_error *)&r_error);
@@ -91,6 +95,136 @@ Variant PluginScriptInstance::call(const StringName &p_method, const Variant **p
 	return var_ret;
 }
 
+// Native storage of one ptrcall argument
+struct PluginScriptPtrArg {
+	bool b;
+	int64_t i;
+	double r;
+	String s;
+	Vector2 v2;
+	Vector3 v3;
+	Color c;
+};
+
+#define PLUGINSCRIPT_MAX_PTRCALL_ARGS 8
+
+static bool _encode_ptrcall_arg(Variant::Type p_type, const Variant *p_value, PluginScriptPtrArg &r_arg, const void *&r_ptr) {
+	Variant::Type type = p_value->get_type();
+	if (type != p_type && p_type != Variant::NIL && !(p_type == Variant::REAL && type == Variant::INT)) {
+		return false; // Let the language convert or report it.
+	}
+
+	switch (p_type) {
+		case Variant::NIL: {
+			r_ptr = p_value;
+		} break;
+		case Variant::BOOL: {
+			r_arg.b = *p_value;
+			r_ptr = &r_arg.b;
+		} break;
+		case Variant::INT: {
+			r_arg.i = *p_value;
+			r_ptr = &r_arg.i;
+		} break;
+		case Variant::REAL: {
+			r_arg.r = *p_value;
+			r_ptr = &r_arg.r;
+		} break;
+		case Variant::STRING: {
+			r_arg.s = *p_value;
+			r_ptr = &r_arg.s;
+		} break;
+		case Variant::VECTOR2: {
+			r_arg.v2 = *p_value;
+			r_ptr = &r_arg.v2;
+		} break;
+		case Variant::VECTOR3: {
+			r_arg.v3 = *p_value;
+			r_ptr = &r_arg.v3;
+		} break;
+		case Variant::COLOR: {
+			r_arg.c = *p_value;
+			r_ptr = &r_arg.c;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+Variant PluginScriptInstance::call_method(const PluginScript::Method *p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+	const godot_pluginscript_method_table_desc *table = _script->_language->get_method_table();
+
+	// Typed methods skip the godot_variant marshalling when the arguments already match
+	if (p_method->typed && table->ptrcall_method && p_argcount == p_method->argument_types.size() && p_argcount <= PLUGINSCRIPT_MAX_PTRCALL_ARGS) {
+		PluginScriptPtrArg args[PLUGINSCRIPT_MAX_PTRCALL_ARGS];
+		const void *ptr_args[PLUGINSCRIPT_MAX_PTRCALL_ARGS];
+
+		bool encoded = true;
+		for (int i = 0; i < p_argcount && encoded; i++) {
+			encoded = _encode_ptrcall_arg(p_method->argument_types[i], p_args[i], args[i], ptr_args[i]);
+		}
+
+		if (encoded) {
+			r_error.error = Variant::CallError::CALL_OK;
+
+			PluginScriptPtrArg ret;
+			switch (p_method->return_type) {
+				case Variant::BOOL: {
+					table->ptrcall_method(_data, p_method->data, ptr_args, &ret.b);
+					return ret.b;
+				}
+				case Variant::INT: {
+					table->ptrcall_method(_data, p_method->data, ptr_args, &ret.i);
+					return ret.i;
+				}
+				case Variant::REAL: {
+					table->ptrcall_method(_data, p_method->data, ptr_args, &ret.r);
+					return ret.r;
+				}
+				case Variant::STRING: {
+					table->ptrcall_method(_data, p_method->data, ptr_args, &ret.s);
+					return ret.s;
+				}
+				case Variant::VECTOR2: {
+					table->ptrcall_method(_data, p_method->data, ptr_args, &ret.v2);
+					return ret.v2;
+				}
+				case Variant::VECTOR3: {
+					table->ptrcall_method(_data, p_method->data, ptr_args, &ret.v3);
+					return ret.v3;
+				}
+				case Variant::COLOR: {
+					table->ptrcall_method(_data, p_method->data, ptr_args, &ret.c);
+					return ret.c;
+				}
+				default: {
+					Variant var_ret;
+					table->ptrcall_method(_data, p_method->data, ptr_args, &var_ret);
+					return var_ret;
+				}
+			}
+		}
+	}
+
+	godot_variant ret = table->call_method(
+			_data, p_method->data, (const godot_variant **)p_args,
+			p_argcount, (godot_variant_call_error *)&r_error);
+	Variant var_ret = *(Variant *)&ret;
+	godot_variant_destroy(&ret);
+	return var_ret;
+}
+
+void PluginScriptInstance::ptrcall_method(const PluginScript::Method *p_method, const void **p_args, void *r_ret) {
+	const godot_pluginscript_method_table_desc *table = _script->_language->get_method_table();
+	ERR_FAIL_COND_MSG(!table->ptrcall_method, "Method has no ptrcall entry point, register one with godot_pluginscript_register_method_table.");
+
+	table->ptrcall_method(_data, p_method->data, p_args, r_ret);
+}
+
+#undef PLUGINSCRIPT_MAX_PTRCALL_ARGS
+
 void PluginScriptInstance::notification(int p_notification) {
 	_desc->notification(_data, p_notification);
 }
@@ -35,10 +35,9 @@
 #include "core/script_language.h"
 
 // PluginScript imports
+#include "pluginscript_script.h"
 #include <pluginscript/godot_pluginscript.h>
 
-class PluginScript;
-
 class PluginScriptInstance : public ScriptInstance {
 	friend class PluginScript;
 
@@ -62,6 +61,10 @@ public:
 
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 
+	// Calls of methods resolved through the language's method table
+	Variant call_method(const PluginScript::Method *p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	void ptrcall_method(const PluginScript::Method *p_method, const void **p_args, void *r_ret);
+
 	// Rely on default implementations provided by ScriptInstance for the moment.
 	// Note that multilevel call could be removed in 3.0 release, so stay tuned
 	// (see https://godotengine.org/qa/9244/can-override-the-_ready-and-_process-functions-child-classes)
@@ -415,8 +415,14 @@ void PluginScriptLanguage::unlock() {
 #endif
 }
 
+void PluginScriptLanguage::set_method_table(const godot_pluginscript_method_table_desc *p_desc) {
+	_method_table = *p_desc;
+	_has_method_table = true;
+}
+
 PluginScriptLanguage::PluginScriptLanguage(const godot_pluginscript_language_desc *desc) :
-		_desc(*desc) {
+		_desc(*desc),
+		_has_method_table(false) {
 	_resource_loader = Ref<ResourceFormatLoaderPluginScript>(memnew(ResourceFormatLoaderPluginScript(this)));
 	_resource_saver = Ref<ResourceFormatSaverPluginScript>(memnew(ResourceFormatSaverPluginScript(this)));
 
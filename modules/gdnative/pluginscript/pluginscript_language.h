@@ -52,6 +52,8 @@ class PluginScriptLanguage : public ScriptLanguage {
 	Ref<ResourceFormatSaverPluginScript> _resource_saver;
 	const godot_pluginscript_language_desc _desc;
 	godot_pluginscript_language_data *_data;
+	godot_pluginscript_method_table_desc _method_table;
+	bool _has_method_table;
 
 	Mutex *_lock;
 	SelfList<PluginScript>::List _script_list;
@@ -62,6 +64,9 @@ public:
 	_FORCE_INLINE_ Ref<ResourceFormatLoaderPluginScript> get_resource_loader() { return _resource_loader; }
 	_FORCE_INLINE_ Ref<ResourceFormatSaverPluginScript> get_resource_saver() { return _resource_saver; }
 
+	void set_method_table(const godot_pluginscript_method_table_desc *p_desc);
+	_FORCE_INLINE_ const godot_pluginscript_method_table_desc *get_method_table() const { return _has_method_table ? &_method_table : NULL; }
+
 	/* LANGUAGE FUNCTIONS */
 	virtual void init();
 	virtual String get_type() const;
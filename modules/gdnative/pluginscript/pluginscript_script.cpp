@@ -242,6 +242,7 @@ Error PluginScript::reload(bool p_keep_state) {
 		basedir = basedir.get_base_dir();
 
 	if (_data) {
+		_free_methods();
 		_desc->finish(_data);
 	}
 
@@ -338,11 +339,66 @@ Error PluginScript::reload(bool p_keep_state) {
     }*/
 #endif
 
+	_resolve_methods();
+
 	FREE_SCRIPT_MANIFEST(manifest);
 	return OK;
 #undef FREE_SCRIPT_MANIFEST
 }
 
+static bool _is_ptrcall_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::NIL:
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::REAL:
+		case Variant::STRING:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+		case Variant::COLOR:
+			return true;
+		default:
+			return false;
+	}
+}
+
+void PluginScript::_resolve_methods() {
+	const godot_pluginscript_method_table_desc *table = _language->get_method_table();
+	if (!table) {
+		return;
+	}
+
+	for (Map<StringName, MethodInfo>::Element *E = _methods_info.front(); E; E = E->next()) {
+		godot_pluginscript_method_data *data = table->get_method(_data, (const godot_string_name *)&E->key());
+		if (!data) {
+			continue;
+		}
+
+		const MethodInfo &mi = E->get();
+		Method method;
+		method.data = data;
+		method.owner = this;
+		method.return_type = mi.return_val.type;
+		method.typed = _is_ptrcall_type(method.return_type);
+		for (const List<PropertyInfo>::Element *A = mi.arguments.front(); A; A = A->next()) {
+			method.argument_types.push_back(A->get().type);
+			method.typed = method.typed && _is_ptrcall_type(A->get().type);
+		}
+		_methods[E->key()] = method;
+	}
+}
+
+void PluginScript::_free_methods() {
+	const godot_pluginscript_method_table_desc *table = _language->get_method_table();
+	if (table && table->free_method) {
+		const StringName *key = NULL;
+		while ((key = _methods.next(key))) {
+			table->free_method(_data, _methods[*key].data);
+		}
+	}
+	_methods.clear();
+}
+
 void PluginScript::get_script_method_list(List<MethodInfo> *r_methods) const {
 	ASSERT_SCRIPT_VALID();
 	for (Map<StringName, MethodInfo>::Element *e = _methods_info.front(); e != NULL; e = e->next()) {
@@ -497,6 +553,7 @@ void PluginScript::init(PluginScriptLanguage *language) {
 
 PluginScript::~PluginScript() {
 	if (_desc && _data) {
+		_free_methods();
 		_desc->finish(_data);
 	}
 
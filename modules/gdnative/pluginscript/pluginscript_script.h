@@ -32,6 +32,7 @@
 #define PLUGINSCRIPT_SCRIPT_H
 
 // Godot imports
+#include "core/hash_map.h"
 #include "core/script_language.h"
 // PluginScript imports
 #include "pluginscript_language.h"
@@ -44,6 +45,16 @@ class PluginScript : public Script {
 	friend class PluginScriptInstance;
 	friend class PluginScriptLanguage;
 
+public:
+	// A method resolved through the language's method table
+	struct Method {
+		godot_pluginscript_method_data *data;
+		const PluginScript *owner;
+		Vector<Variant::Type> argument_types;
+		Variant::Type return_type;
+		bool typed; // every declared type has a native ptrcall representation
+	};
+
 private:
 	godot_pluginscript_script_data *_data;
 	const godot_pluginscript_script_desc *_desc;
@@ -62,6 +73,7 @@ private:
 	Map<StringName, MethodInfo> _methods_info;
 	Map<StringName, MultiplayerAPI::RPCMode> _variables_rset_mode;
 	Map<StringName, MultiplayerAPI::RPCMode> _methods_rpc_mode;
+	HashMap<StringName, Method> _methods;
 
 	Set<Object *> _instances;
 	//exported members
@@ -75,6 +87,9 @@ protected:
 	PluginScriptInstance *_create_instance(const Variant **p_args, int p_argcount, Object *p_owner, Variant::CallError &r_error);
 	Variant _new(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 
+	void _resolve_methods();
+	void _free_methods();
+
 #ifdef TOOLS_ENABLED
 	Set<PlaceHolderScriptInstance *> placeholders;
 	//void _update_placeholder(PlaceHolderScriptInstance *p_placeholder);
@@ -98,6 +113,7 @@ public:
 
 	virtual bool has_method(const StringName &p_method) const;
 	virtual MethodInfo get_method_info(const StringName &p_method) const;
+	_FORCE_INLINE_ const Method *get_resolved_method(const StringName &p_method) const { return _methods.getptr(p_method); }
 
 	bool has_property(const StringName &p_method) const;
 	PropertyInfo get_property_info(const StringName &p_property) const;
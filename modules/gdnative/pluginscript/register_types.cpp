@@ -37,6 +37,7 @@
 #include "core/project_settings.h"
 #include "scene/main/scene_tree.h"
 
+#include "pluginscript_instance.h"
 #include "pluginscript_language.h"
 #include "pluginscript_script.h"
 #include <pluginscript/godot_pluginscript.h>
@@ -106,6 +107,93 @@ void GDAPI godot_pluginscript_register_language(const godot_pluginscript_languag
 	pluginscript_languages.push_back(language);
 }
 
+void GDAPI godot_pluginscript_register_method_table(const char *p_language_name, const godot_pluginscript_method_table_desc *p_method_table_desc) {
+	ERR_FAIL_NULL(p_method_table_desc);
+	ERR_FAIL_COND(!p_method_table_desc->get_method);
+	ERR_FAIL_COND(!p_method_table_desc->call_method);
+	// p_method_table_desc->free_method is not mandatory
+	// p_method_table_desc->ptrcall_method is not mandatory
+
+	String language_name = p_language_name;
+	for (List<PluginScriptLanguage *>::Element *e = pluginscript_languages.front(); e; e = e->next()) {
+		if (e->get()->get_name() == language_name) {
+			e->get()->set_method_table(p_method_table_desc);
+			return;
+		}
+	}
+	ERR_FAIL_MSG("No PluginScript language registered with name '" + language_name + "'.");
+}
+
+static PluginScriptInstance *_get_plugin_script_instance(Object *p_object) {
+	if (!p_object) {
+		return NULL;
+	}
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (!script_instance || script_instance->is_placeholder()) {
+		return NULL;
+	}
+	if (!Object::cast_to<PluginScript>(script_instance->get_script().ptr())) {
+		return NULL;
+	}
+	return static_cast<PluginScriptInstance *>(script_instance);
+}
+
+const godot_pluginscript_method_handle GDAPI *godot_pluginscript_get_method_handle(const godot_object *p_object, const char *p_method) {
+	PluginScriptInstance *instance = _get_plugin_script_instance((Object *)p_object);
+	ERR_FAIL_COND_V_MSG(!instance, NULL, "Object has no PluginScript instance.");
+
+	Ref<PluginScript> script = instance->get_script();
+	return (const godot_pluginscript_method_handle *)script->get_resolved_method(StringName(p_method));
+}
+
+#ifdef DEBUG_ENABLED
+static bool _method_handle_matches(const PluginScript::Method *p_method, PluginScriptInstance *p_instance) {
+	Ref<Script> script = p_instance->get_script();
+	while (script.is_valid()) {
+		if (script.ptr() == p_method->owner) {
+			return true;
+		}
+		script = script->get_base_script();
+	}
+	return false;
+}
+
+#define VALIDATE_METHOD_HANDLE(m_method, m_instance, m_retval)                                                               \
+	ERR_FAIL_COND_V_MSG(!m_instance, m_retval, "Object has no PluginScript instance.");                                       \
+	ERR_FAIL_COND_V_MSG(!_method_handle_matches(m_method, m_instance), m_retval, "Method handle does not belong to the script of this object.");
+#else
+#define VALIDATE_METHOD_HANDLE(m_method, m_instance, m_retval) \
+	ERR_FAIL_COND_V_MSG(!m_instance, m_retval, "Object has no PluginScript instance.");
+#endif
+
+godot_variant GDAPI godot_pluginscript_method_handle_call(const godot_pluginscript_method_handle *p_handle, godot_object *p_object, const godot_variant **p_args, int p_num_args) {
+	godot_variant ret;
+	godot_variant_new_nil(&ret);
+
+	const PluginScript::Method *method = (const PluginScript::Method *)p_handle;
+	ERR_FAIL_NULL_V(method, ret);
+
+	PluginScriptInstance *instance = _get_plugin_script_instance((Object *)p_object);
+	VALIDATE_METHOD_HANDLE(method, instance, ret);
+
+	Variant::CallError error;
+	Variant result = instance->call_method(method, (const Variant **)p_args, p_num_args, error);
+	godot_variant_new_copy(&ret, (const godot_variant *)&result);
+	return ret;
+}
+
+void GDAPI godot_pluginscript_method_handle_ptrcall(const godot_pluginscript_method_handle *p_handle, godot_object *p_object, const void **p_args, void *r_ret) {
+	const PluginScript::Method *method = (const PluginScript::Method *)p_handle;
+	ERR_FAIL_NULL(method);
+
+	PluginScriptInstance *instance = _get_plugin_script_instance((Object *)p_object);
+	VALIDATE_METHOD_HANDLE(method, instance, );
+
+	instance->ptrcall_method(method, p_args, r_ret);
+}
+
+#undef VALIDATE_METHOD_HANDLE
+
 void register_pluginscript_types() {
 	ClassDB::register_class<PluginScript>();
 }
@@ -37,7 +37,9 @@
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "gdscript_bytecode.h"
 #include "gdscript_compiler.h"
+#include "gdscript_yield_scheduler.h"
 
 ///////////////////////////
 
@@ -566,6 +568,21 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 
 	valid = false;
+
+#ifdef TOOLS_ENABLED
+	//compiled scripts are cached by source hash, inner scripts and built-in ones are never cached
+	bool use_cache = !p_keep_state && GDScriptBytecode::is_cache_enabled() && get_path().begins_with("res://") && get_path().find("::") == -1;
+	uint64_t source_hash = use_cache ? source.hash64() : 0;
+	if (use_cache && GDScriptBytecode::load_from_cache(this, source_hash) == OK) {
+		valid = true;
+		for (Map<StringName, Ref<GDScript> >::Element *E = subclasses.front(); E; E = E->next()) {
+
+			_set_subclass_path(E->get(), path);
+		}
+		return OK;
+	}
+#endif
+
 	GDScriptParser parser;
 	Error err = parser.parse(source, basedir, false, path);
 	if (err) {
@@ -610,6 +627,12 @@ Error GDScript::reload(bool p_keep_state) {
 		_set_subclass_path(E->get(), path);
 	}
 
+#ifdef TOOLS_ENABLED
+	if (use_cache) {
+		GDScriptBytecode::save_to_cache(this, source_hash, parser.get_dependencies());
+	}
+#endif
+
 	return OK;
 }
 
@@ -771,6 +794,21 @@ Error GDScript::load_byte_code(const String &p_path) {
 		basedir = basedir.get_base_dir();
 
 	valid = false;
+
+	//exports with compiled scripts ship the compiled form next to the tokens
+	String compiled_path = p_path.get_basename() + ".gdbc";
+	if (!p_path.ends_with("gde") && FileAccess::exists(compiled_path)) {
+		Vector<uint8_t> compiled = FileAccess::get_file_as_array(compiled_path);
+		if (GDScriptBytecode::load(this, compiled, GDScriptBytecode::hash_buffer(bytecode.ptr(), bytecode.size())) == OK) {
+			valid = true;
+			for (Map<StringName, Ref<GDScript> >::Element *E = subclasses.front(); E; E = E->next()) {
+
+				_set_subclass_path(E->get(), path);
+			}
+			return OK;
+		}
+	}
+
 	GDScriptParser parser;
 	Error err = parser.parse_bytecode(bytecode, basedir, get_path());
 	if (err) {
@@ -1415,6 +1453,9 @@ void GDScriptLanguage::remove_named_global_constant(const StringName &p_name) {
 
 void GDScriptLanguage::init() {
 
+	//build the reserved word table before any thread gets to tokenize
+	GDScriptTokenizer::initialize_reserved_words();
+
 	//populate global constants
 	int gcc = GlobalConstants::get_global_constant_count();
 	for (int i = 0; i < gcc; i++) {
@@ -1468,6 +1509,13 @@ Error GDScriptLanguage::execute_file(const String &p_path) {
 	return OK;
 }
 void GDScriptLanguage::finish() {
+
+	profiling_sampling_stop();
+
+	//release functions still waiting on timers or frames
+	if (GDScriptYieldScheduler::get_singleton()) {
+		GDScriptYieldScheduler::get_singleton()->clear();
+	}
 }
 
 void GDScriptLanguage::profiling_start() {
@@ -2180,6 +2228,14 @@ GDScriptLanguage::GDScriptLanguage() {
 		_call_stack = NULL;
 	}
 
+	_sample_stack_pos = 0;
+	_sample_max_stack = dmcs;
+	_sample_stack = memnew_arr(SampleLevel, _sample_max_stack);
+	sampling = false;
+	sample_requested = false;
+	sampling_interval_usec = 1000;
+	sampling_thread = NULL;
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/treat_warnings_as_errors", false);
@@ -2191,10 +2247,113 @@ GDScriptLanguage::GDScriptLanguage() {
 		GLOBAL_DEF("debug/gdscript/warnings/" + warning, default_enabled);
 	}
 #endif // DEBUG_ENABLED
+	GLOBAL_DEF("filesystem/scripts/use_bytecode_cache", false);
+}
+
+void GDScriptLanguage::_sampling_thread_func(void *p_userdata) {
+
+	GDScriptLanguage *self = (GDScriptLanguage *)p_userdata;
+
+	while (self->sampling) {
+		OS::get_singleton()->delay_usec(self->sampling_interval_usec);
+		//the main thread takes the sample itself at the next line or call, so its stack is never read concurrently
+		self->sample_requested = true;
+	}
+}
+
+void GDScriptLanguage::_take_sample() {
+
+	sample_requested = false;
+
+	String stack;
+	for (int i = 0; i < _sample_stack_pos; i++) {
+		const SampleLevel &sl = _sample_stack[i];
+		if (i > 0) {
+			stack += ";";
+		}
+		stack += String(sl.function->get_name()) + " (" + String(sl.function->get_source()) + ":" + itos(*sl.line) + ")";
+	}
+
+	if (lock) {
+		lock->lock();
+	}
+
+	Map<String, uint32_t>::Element *E = samples.find(stack);
+	if (E) {
+		E->get()++;
+	} else {
+		samples[stack] = 1;
+	}
+
+	if (lock) {
+		lock->unlock();
+	}
+}
+
+void GDScriptLanguage::profiling_sampling_start(int p_interval_usec) {
+
+	profiling_sampling_stop();
+
+	if (lock) {
+		lock->lock();
+	}
+
+	samples.clear();
+
+	if (lock) {
+		lock->unlock();
+	}
+
+	sampling_interval_usec = MAX(p_interval_usec, 100);
+	sampling = true;
+	sampling_thread = Thread::create(_sampling_thread_func, this);
+	if (!sampling_thread) {
+		sampling = false;
+		ERR_FAIL_MSG("Could not start the GDScript sampling thread.");
+	}
+}
+
+void GDScriptLanguage::profiling_sampling_stop() {
+
+	if (!sampling) {
+		return;
+	}
+
+	sampling = false;
+	Thread::wait_to_finish(sampling_thread);
+	memdelete(sampling_thread);
+	sampling_thread = NULL;
+	sample_requested = false;
+}
+
+void GDScriptLanguage::profiling_get_samples(Map<String, uint32_t> &r_samples) {
+
+	if (lock) {
+		lock->lock();
+	}
+
+	for (Map<String, uint32_t>::Element *E = samples.front(); E; E = E->next()) {
+		Map<String, uint32_t>::Element *F = r_samples.find(E->key());
+		if (F) {
+			F->get() += E->get();
+		} else {
+			r_samples[E->key()] = E->get();
+		}
+	}
+	samples.clear();
+
+	if (lock) {
+		lock->unlock();
+	}
 }
 
 GDScriptLanguage::~GDScriptLanguage() {
 
+	profiling_sampling_stop();
+
+	if (_sample_stack) {
+		memdelete_arr(_sample_stack);
+	}
 	if (lock) {
 		memdelete(lock);
 		lock = NULL;
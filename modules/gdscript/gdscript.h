@@ -72,6 +72,7 @@ class GDScript : public Script {
 	friend class GDScriptCompiler;
 	friend class GDScriptFunctions;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecode;
 
 	Variant _static_ref; //used for static call
 	Ref<GDScriptNativeClass> native;
@@ -140,6 +141,7 @@ protected:
 	void _get_property_list(List<PropertyInfo> *p_properties) const;
 
 	Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	virtual bool _has_custom_call() const { return true; }
 	//void call_multilevel(const StringName& p_method,const Variant** p_args,int p_argcount);
 
 	static void _bind_methods();
@@ -357,6 +359,25 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool profiling;
 	uint64_t script_frame_time;
 
+	struct SampleLevel {
+
+		GDScriptFunction *function;
+		int *line;
+	};
+
+	//sampling works without the debugger, the main thread records its own stack when a sample is requested
+	SampleLevel *_sample_stack;
+	int _sample_stack_pos;
+	int _sample_max_stack;
+	volatile bool sampling;
+	volatile bool sample_requested;
+	int sampling_interval_usec;
+	Thread *sampling_thread;
+	Map<String, uint32_t> samples;
+
+	static void _sampling_thread_func(void *p_userdata);
+	void _take_sample();
+
 	Map<String, ObjectID> orphan_subclasses;
 
 public:
@@ -406,6 +427,36 @@ public:
 		_debug_call_stack_pos--;
 	}
 
+	_FORCE_INLINE_ bool is_sampling() const { return sampling; }
+
+	_FORCE_INLINE_ bool sample_enter_function(GDScriptFunction *p_function, int *p_line) {
+
+		if (Thread::get_main_id() != Thread::get_caller_id())
+			return false; //only the main thread is sampled
+
+		if (_sample_stack_pos >= _sample_max_stack)
+			return false;
+
+		_sample_stack[_sample_stack_pos].function = p_function;
+		_sample_stack[_sample_stack_pos].line = p_line;
+		_sample_stack_pos++;
+
+		if (sample_requested)
+			_take_sample();
+		return true;
+	}
+
+	_FORCE_INLINE_ void sample_exit_function() {
+
+		_sample_stack_pos--;
+	}
+
+	_FORCE_INLINE_ void sample_line() {
+
+		if (unlikely(sample_requested) && _sample_stack_pos && Thread::get_main_id() == Thread::get_caller_id())
+			_take_sample();
+	}
+
 	virtual Vector<StackInfo> debug_get_current_stack_info() {
 		if (Thread::get_main_id() != Thread::get_caller_id())
 			return Vector<StackInfo>();
@@ -501,6 +552,10 @@ public:
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max);
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max);
 
+	virtual void profiling_sampling_start(int p_interval_usec);
+	virtual void profiling_sampling_stop();
+	virtual void profiling_get_samples(Map<String, uint32_t> &r_samples);
+
 	/* LOADER FUNCTIONS */
 
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
@@ -0,0 +1,1506 @@
+/*************************************************************************/
+/*  gdscript_bytecode.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_bytecode.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/thread.h"
+#include "core/project_settings.h"
+#include "core/version.h"
+#include "core/version_hash.gen.h"
+#include "gdscript_function.h"
+
+#define BYTECODE_MAGIC "GDBC"
+
+enum {
+	FLAG_DEBUG_INFO = 1
+};
+
+enum {
+	CONSTANT_VALUE,
+	CONSTANT_NATIVE_CLASS,
+	CONSTANT_SCRIPT,
+	CONSTANT_RESOURCE,
+	CONSTANT_GLOBAL //autoloads and singletons folded as constants, looked up by name
+};
+
+enum {
+	SCRIPT_REF_NONE,
+	SCRIPT_REF_SELF,
+	SCRIPT_REF_PATH
+};
+
+static String _get_engine_version() {
+
+	return String(VERSION_FULL_BUILD) + "." + String(VERSION_HASH);
+}
+
+struct GDScriptBytecode::SaveState {
+
+	Vector<uint8_t> data;
+	const GDScript *root;
+	Vector<StringName> global_names; //global array index to name
+	Set<String> dependencies;
+	bool strip_debug_info;
+
+	void put_8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+	void put_32(uint32_t p_value) {
+		int ofs = data.size();
+		data.resize(ofs + 4);
+		encode_uint32(p_value, &data.write[ofs]);
+	}
+	void put_64(uint64_t p_value) {
+		int ofs = data.size();
+		data.resize(ofs + 8);
+		encode_uint64(p_value, &data.write[ofs]);
+	}
+	void put_string(const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		put_32(utf8.length());
+		int ofs = data.size();
+		data.resize(ofs + utf8.length());
+		copymem(&data.write[ofs], utf8.get_data(), utf8.length());
+	}
+	bool put_variant(const Variant &p_value) {
+		int len;
+		if (encode_variant(p_value, NULL, len) != OK) {
+			return false;
+		}
+		put_32(len);
+		int ofs = data.size();
+		data.resize(ofs + len);
+		return encode_variant(p_value, &data.write[ofs], len) == OK;
+	}
+};
+
+struct GDScriptBytecode::LoadState {
+
+	const uint8_t *data;
+	int size;
+	int pos;
+	bool error;
+	GDScript *root;
+
+	uint8_t get_8() {
+		if (pos + 1 > size) {
+			error = true;
+			return 0;
+		}
+		return data[pos++];
+	}
+	uint32_t get_32() {
+		if (pos + 4 > size) {
+			error = true;
+			return 0;
+		}
+		uint32_t value = decode_uint32(&data[pos]);
+		pos += 4;
+		return value;
+	}
+	uint64_t get_64() {
+		if (pos + 8 > size) {
+			error = true;
+			return 0;
+		}
+		uint64_t value = decode_uint64(&data[pos]);
+		pos += 8;
+		return value;
+	}
+	String get_string() {
+		uint32_t len = get_32();
+		if (error || len > uint32_t(size - pos)) {
+			error = true;
+			return String();
+		}
+		String str;
+		str.parse_utf8((const char *)&data[pos], len);
+		pos += len;
+		return str;
+	}
+	Variant get_variant() {
+		uint32_t len = get_32();
+		if (error || len > uint32_t(size - pos)) {
+			error = true;
+			return Variant();
+		}
+		Variant value;
+		if (decode_variant(value, &data[pos], len) != OK) {
+			error = true;
+		}
+		pos += len;
+		return value;
+	}
+	//counts are bounded by the remaining data, so corrupt files can't trigger huge allocations
+	int get_count() {
+		uint32_t count = get_32();
+		if (count > uint32_t(size - pos)) {
+			error = true;
+			return 0;
+		}
+		return count;
+	}
+};
+
+uint64_t GDScriptBytecode::hash_buffer(const uint8_t *p_buffer, int p_size) {
+
+	//FNV-1a
+	uint64_t hash = 14695981039346656037ULL;
+	for (int i = 0; i < p_size; i++) {
+		hash ^= p_buffer[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+// size of the opcode at p_ip and the positions of its operands that are addresses
+bool GDScriptBytecode::_get_opcode_layout(const int *p_code, int p_code_size, int p_ip, int &r_size, Vector<int> &r_addresses) {
+
+#define ADDRESS(m_ofs) r_addresses.push_back(p_ip + (m_ofs))
+
+	r_addresses.clear();
+
+	switch (p_code[p_ip]) {
+		case GDScriptFunction::OPCODE_OPERATOR: {
+			r_size = 5;
+			ADDRESS(2);
+			ADDRESS(3);
+			ADDRESS(4);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_VALIDATED: {
+			r_size = 3; //prefix, the generic opcode follows
+		} break;
+		case GDScriptFunction::OPCODE_EXTENDS_TEST:
+		case GDScriptFunction::OPCODE_SET:
+		case GDScriptFunction::OPCODE_GET:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+			r_size = 4;
+			ADDRESS(1);
+			ADDRESS(2);
+			ADDRESS(3);
+		} break;
+		case GDScriptFunction::OPCODE_IS_BUILTIN:
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED: {
+			r_size = 4;
+			ADDRESS(1);
+			ADDRESS(3);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+			r_size = 4;
+			ADDRESS(2);
+			ADDRESS(3);
+		} break;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER: {
+			r_size = 3;
+			ADDRESS(2);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_ASSERT: {
+			r_size = 3;
+			ADDRESS(1);
+			ADDRESS(2);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_YIELD_RESUME:
+		case GDScriptFunction::OPCODE_RETURN: {
+			r_size = 2;
+			ADDRESS(1);
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CALL_BUILT_IN:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+			if (p_ip + 2 >= p_code_size) {
+				return false;
+			}
+			int argc = p_code[p_ip + 2];
+			if (argc < 0 || argc >= p_code_size) {
+				return false;
+			}
+			r_size = 4 + argc;
+			for (int i = 0; i <= argc; i++) {
+				ADDRESS(3 + i); //arguments and destination
+			}
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+			if (p_ip + 1 >= p_code_size) {
+				return false;
+			}
+			int argc = p_code[p_ip + 1];
+			if (p_code[p_ip] == GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY) {
+				argc *= 2;
+			}
+			if (argc < 0 || argc >= p_code_size) {
+				return false;
+			}
+			r_size = 3 + argc;
+			for (int i = 0; i <= argc; i++) {
+				ADDRESS(2 + i);
+			}
+		} break;
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN: {
+			if (p_ip + 1 >= p_code_size) {
+				return false;
+			}
+			int argc = p_code[p_ip + 1];
+			if (argc < 0 || argc >= p_code_size) {
+				return false;
+			}
+			r_size = 5 + argc;
+			ADDRESS(2); //base, the method name at +3 is an index in the global names
+			for (int i = 0; i <= argc; i++) {
+				ADDRESS(4 + i);
+			}
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+		case GDScriptFunction::OPCODE_END:
+		case GDScriptFunction::OPCODE_CALL_SELF: {
+			r_size = 1;
+		} break;
+		case GDScriptFunction::OPCODE_YIELD: {
+			r_size = 2; //the live stack size at +1 is not an address
+		} break;
+		case GDScriptFunction::OPCODE_YIELD_SIGNAL: {
+			r_size = 4;
+			ADDRESS(1);
+			ADDRESS(2);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP:
+		case GDScriptFunction::OPCODE_LINE: {
+			r_size = 2;
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			r_size = 3;
+			ADDRESS(1);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE: {
+			r_size = 5;
+			ADDRESS(1);
+			ADDRESS(2);
+			ADDRESS(4);
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+#undef ADDRESS
+
+	return p_ip + r_size <= p_code_size;
+}
+
+// removes OPCODE_LINE, only the debugger and error messages use it
+bool GDScriptBytecode::_strip_line_opcodes(Vector<int> &r_code, Vector<int> &r_default_arguments) {
+
+	const int *code = r_code.ptr();
+	int code_size = r_code.size();
+
+	//new position of each opcode, jumps may target any of them or the end
+	Vector<int> remap;
+	remap.resize(code_size + 1);
+	for (int i = 0; i < remap.size(); i++) {
+		remap.write[i] = -1;
+	}
+	Vector<int> stripped;
+	Vector<int> addresses;
+	for (int ip = 0; ip < code_size;) {
+		int size;
+		if (!_get_opcode_layout(code, code_size, ip, size, addresses)) {
+			return false;
+		}
+		remap.write[ip] = stripped.size();
+		if (code[ip] != GDScriptFunction::OPCODE_LINE) {
+			for (int i = 0; i < size; i++) {
+				stripped.push_back(code[ip + i]);
+			}
+		}
+		ip += size;
+	}
+	remap.write[code_size] = stripped.size();
+
+	int *stripped_ptr = stripped.ptrw();
+	for (int ip = 0; ip < stripped.size();) {
+		int size;
+		_get_opcode_layout(stripped_ptr, stripped.size(), ip, size, addresses);
+
+		int target = -1;
+		switch (stripped_ptr[ip]) {
+			case GDScriptFunction::OPCODE_JUMP: {
+				target = ip + 1;
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				target = ip + 2;
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+			case GDScriptFunction::OPCODE_ITERATE: {
+				target = ip + 3;
+			} break;
+			default: {
+			}
+		}
+		if (target != -1) {
+			int old_target = stripped_ptr[target];
+			if (old_target < 0 || old_target > code_size || remap[old_target] == -1) {
+				return false;
+			}
+			stripped_ptr[target] = remap[old_target];
+		}
+
+		ip += size;
+	}
+
+	for (int i = 0; i < r_default_arguments.size(); i++) {
+		int old_target = r_default_arguments[i];
+		if (old_target < 0 || old_target > code_size || remap[old_target] == -1) {
+			return false;
+		}
+		r_default_arguments.write[i] = remap[old_target];
+	}
+
+	r_code = stripped;
+	return true;
+}
+
+static bool _has_objects(const Variant &p_value) {
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			return true;
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				if (_has_objects(array[i])) {
+					return true;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				if (_has_objects(E->get()) || _has_objects(dict[E->get()])) {
+					return true;
+				}
+			}
+		} break;
+		default: {
+		}
+	}
+
+	return false;
+}
+
+static bool _is_file_resource_path(const String &p_path) {
+
+	return p_path.begins_with("res://") && p_path.find("::") == -1;
+}
+
+/////////////////////
+
+bool GDScriptBytecode::_save_script_ref(SaveState &p_state, const Ref<Script> &p_script) {
+
+	if (p_script.is_null()) {
+		p_state.put_8(SCRIPT_REF_NONE);
+		return true;
+	}
+
+	Vector<StringName> inner_names;
+	const Script *root = p_script.ptr();
+
+	const GDScript *gds = Object::cast_to<GDScript>(p_script.ptr());
+	if (gds) {
+		while (gds->_owner) {
+			inner_names.insert(0, gds->name);
+			gds = gds->_owner;
+		}
+		root = gds;
+	}
+
+	if (root == p_state.root) {
+		p_state.put_8(SCRIPT_REF_SELF);
+	} else {
+		String path = root->get_path();
+		if (!_is_file_resource_path(path)) {
+			return false; //built-in scripts can't be referenced by path
+		}
+		p_state.put_8(SCRIPT_REF_PATH);
+		p_state.put_string(path);
+		p_state.dependencies.insert(path);
+	}
+
+	p_state.put_32(inner_names.size());
+	for (int i = 0; i < inner_names.size(); i++) {
+		p_state.put_string(inner_names[i]);
+	}
+
+	return true;
+}
+
+bool GDScriptBytecode::_save_constant(SaveState &p_state, const Variant &p_value) {
+
+	if (p_value.get_type() != Variant::OBJECT) {
+		if (_has_objects(p_value)) {
+			return false;
+		}
+		p_state.put_8(CONSTANT_VALUE);
+		return p_state.put_variant(p_value);
+	}
+
+	Object *obj = p_value;
+	if (!obj) {
+		p_state.put_8(CONSTANT_VALUE);
+		return p_state.put_variant(Variant());
+	}
+
+	GDScriptNativeClass *native = Object::cast_to<GDScriptNativeClass>(obj);
+	if (native) {
+		p_state.put_8(CONSTANT_NATIVE_CLASS);
+		p_state.put_string(native->get_name());
+		return true;
+	}
+
+	Script *script = Object::cast_to<Script>(obj);
+	if (script) {
+		p_state.put_8(CONSTANT_SCRIPT);
+		return _save_script_ref(p_state, Ref<Script>(script));
+	}
+
+	Resource *res = Object::cast_to<Resource>(obj);
+	if (res) {
+		if (!_is_file_resource_path(res->get_path())) {
+			return false;
+		}
+		p_state.put_8(CONSTANT_RESOURCE);
+		p_state.put_string(res->get_path());
+		return true;
+	}
+
+	//singletons and autoloads folded by the parser
+	const Map<StringName, Variant> &named_globals = GDScriptLanguage::get_singleton()->get_named_globals_map();
+	for (const Map<StringName, Variant>::Element *E = named_globals.front(); E; E = E->next()) {
+		if (E->get().get_type() == Variant::OBJECT && (Object *)E->get() == obj) {
+			p_state.put_8(CONSTANT_GLOBAL);
+			p_state.put_string(E->key());
+			return true;
+		}
+	}
+	const Variant *globals = GDScriptLanguage::get_singleton()->get_global_array();
+	for (int i = 0; i < p_state.global_names.size(); i++) {
+		if (globals[i].get_type() == Variant::OBJECT && (Object *)globals[i] == obj) {
+			p_state.put_8(CONSTANT_GLOBAL);
+			p_state.put_string(p_state.global_names[i]);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool GDScriptBytecode::_save_data_type(SaveState &p_state, const GDScriptDataType &p_type) {
+
+	p_state.put_8(p_type.has_type);
+	p_state.put_8(p_type.kind);
+	p_state.put_32(p_type.builtin_type);
+	p_state.put_string(p_type.native_type);
+	return _save_script_ref(p_state, p_type.script_type);
+}
+
+bool GDScriptBytecode::_save_function(SaveState &p_state, const GDScriptFunction *p_function) {
+
+	p_state.put_string(p_function->name);
+	p_state.put_32(p_function->_argument_count);
+	p_state.put_32(p_function->_stack_size);
+	p_state.put_32(p_function->_call_size);
+	p_state.put_32(p_function->_initial_line);
+	p_state.put_8(p_function->_static);
+	p_state.put_32(p_function->rpc_mode);
+
+	p_state.put_32(p_function->constants.size());
+	for (int i = 0; i < p_function->constants.size(); i++) {
+		if (!_save_constant(p_state, p_function->constants[i])) {
+			return false;
+		}
+	}
+
+	p_state.put_32(p_function->global_names.size());
+	for (int i = 0; i < p_function->global_names.size(); i++) {
+		p_state.put_string(p_function->global_names[i]);
+	}
+
+	//global addresses are indices in the language's global array, which differs between
+	//the editor and export templates. replace them with indices in a list of names.
+	Vector<int> code = p_function->code;
+	Vector<StringName> globals;
+	int *code_ptr = code.ptrw();
+	Vector<int> addresses;
+	for (int ip = 0; ip < code.size();) {
+
+		int size;
+		if (!_get_opcode_layout(code_ptr, code.size(), ip, size, addresses)) {
+			return false;
+		}
+
+		for (int i = 0; i < addresses.size(); i++) {
+			int address = code_ptr[addresses[i]];
+			int type = (address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+			int index = address & GDScriptFunction::ADDR_MASK;
+			StringName global;
+			if (type == GDScriptFunction::ADDR_TYPE_GLOBAL) {
+				ERR_FAIL_INDEX_V(index, p_state.global_names.size(), false);
+				global = p_state.global_names[index];
+#ifdef TOOLS_ENABLED
+			} else if (type == GDScriptFunction::ADDR_TYPE_NAMED_GLOBAL) {
+				ERR_FAIL_INDEX_V(index, p_function->named_globals.size(), false);
+				global = p_function->named_globals[index];
+#endif
+			} else {
+				continue;
+			}
+
+			int pos = globals.find(global);
+			if (pos == -1) {
+				pos = globals.size();
+				globals.push_back(global);
+			}
+			code_ptr[addresses[i]] = pos | (GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS);
+		}
+
+		ip += size;
+	}
+
+	Vector<int> default_arguments = p_function->default_arguments;
+	if (p_state.strip_debug_info && !_strip_line_opcodes(code, default_arguments)) {
+		return false;
+	}
+
+	p_state.put_32(globals.size());
+	for (int i = 0; i < globals.size(); i++) {
+		p_state.put_string(globals[i]);
+	}
+
+	p_state.put_32(code.size());
+	for (int i = 0; i < code.size(); i++) {
+		p_state.put_32(code[i]);
+	}
+
+	p_state.put_32(default_arguments.size());
+	for (int i = 0; i < default_arguments.size(); i++) {
+		p_state.put_32(default_arguments[i]);
+	}
+
+	p_state.put_32(p_function->argument_types.size());
+	for (int i = 0; i < p_function->argument_types.size(); i++) {
+		if (!_save_data_type(p_state, p_function->argument_types[i])) {
+			return false;
+		}
+	}
+	if (!_save_data_type(p_state, p_function->return_type)) {
+		return false;
+	}
+
+#ifdef TOOLS_ENABLED
+	p_state.put_32(p_function->arg_names.size());
+	for (int i = 0; i < p_function->arg_names.size(); i++) {
+		p_state.put_string(p_function->arg_names[i]);
+	}
+#else
+	p_state.put_32(0);
+#endif
+
+	if (p_state.strip_debug_info) {
+		p_state.put_32(0);
+		return true;
+	}
+
+	p_state.put_32(p_function->stack_debug.size());
+	for (const List<GDScriptFunction::StackDebug>::Element *E = p_function->stack_debug.front(); E; E = E->next()) {
+		p_state.put_32(E->get().line);
+		p_state.put_32(E->get().pos);
+		p_state.put_8(E->get().added);
+		p_state.put_string(E->get().identifier);
+	}
+
+	return true;
+}
+
+void GDScriptBytecode::_save_class_tree(SaveState &p_state, const GDScript *p_script) {
+
+	p_state.put_32(p_script->subclasses.size());
+	for (const Map<StringName, Ref<GDScript> >::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		p_state.put_string(E->key());
+		_save_class_tree(p_state, E->get().ptr());
+	}
+}
+
+bool GDScriptBytecode::_save_class(SaveState &p_state, const GDScript *p_script) {
+
+	p_state.put_8(p_script->tool);
+	p_state.put_string(p_script->name);
+	p_state.put_string(p_script->native.is_valid() ? String(p_script->native->get_name()) : String());
+	if (!_save_script_ref(p_state, p_script->base)) {
+		return false;
+	}
+
+	p_state.put_32(p_script->members.size());
+	for (const Set<StringName>::Element *E = p_script->members.front(); E; E = E->next()) {
+		p_state.put_string(E->get());
+	}
+
+	p_state.put_32(p_script->member_indices.size());
+	for (const Map<StringName, GDScript::MemberInfo>::Element *E = p_script->member_indices.front(); E; E = E->next()) {
+		p_state.put_string(E->key());
+		p_state.put_32(E->get().index);
+		p_state.put_string(E->get().setter);
+		p_state.put_string(E->get().getter);
+		p_state.put_32(E->get().rpc_mode);
+		if (!_save_data_type(p_state, E->get().data_type)) {
+			return false;
+		}
+	}
+
+	p_state.put_32(p_script->member_info.size());
+	for (const Map<StringName, PropertyInfo>::Element *E = p_script->member_info.front(); E; E = E->next()) {
+		p_state.put_string(E->key());
+		p_state.put_32(E->get().type);
+		p_state.put_string(E->get().name);
+		p_state.put_string(E->get().class_name);
+		p_state.put_32(E->get().hint);
+		p_state.put_string(E->get().hint_string);
+		p_state.put_32(E->get().usage);
+	}
+
+	p_state.put_32(p_script->constants.size());
+	for (const Map<StringName, Variant>::Element *E = p_script->constants.front(); E; E = E->next()) {
+		p_state.put_string(E->key());
+		if (!_save_constant(p_state, E->get())) {
+			return false;
+		}
+	}
+
+	p_state.put_32(p_script->_signals.size());
+	for (const Map<StringName, Vector<StringName> >::Element *E = p_script->_signals.front(); E; E = E->next()) {
+		p_state.put_string(E->key());
+		p_state.put_32(E->get().size());
+		for (int i = 0; i < E->get().size(); i++) {
+			p_state.put_string(E->get()[i]);
+		}
+	}
+
+	p_state.put_32(p_script->member_functions.size());
+	for (const Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
+		p_state.put_string(E->key());
+		if (!_save_function(p_state, E->get())) {
+			return false;
+		}
+	}
+
+#ifdef TOOLS_ENABLED
+	p_state.put_32(p_script->member_lines.size());
+	for (const Map<StringName, int>::Element *E = p_script->member_lines.front(); E; E = E->next()) {
+		p_state.put_string(E->key());
+		p_state.put_32(E->get());
+	}
+
+	p_state.put_32(p_script->member_default_values.size());
+	for (const Map<StringName, Variant>::Element *E = p_script->member_default_values.front(); E; E = E->next()) {
+		p_state.put_string(E->key());
+		if (!_save_constant(p_state, E->get())) {
+			return false;
+		}
+	}
+#else
+	p_state.put_32(0);
+	p_state.put_32(0);
+#endif
+
+	//same order as the tree
+	for (const Map<StringName, Ref<GDScript> >::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		if (!_save_class(p_state, E->get().ptr())) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+Error GDScriptBytecode::save(const GDScript *p_script, uint64_t p_source_hash, const List<String> &p_dependencies, Vector<uint8_t> &r_buffer, bool p_strip_debug_info) {
+
+	ERR_FAIL_COND_V(!p_script->valid, ERR_INVALID_PARAMETER);
+
+	SaveState state;
+	state.root = p_script;
+	state.strip_debug_info = p_strip_debug_info;
+
+	const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	state.global_names.resize(GDScriptLanguage::get_singleton()->get_global_array_size());
+	for (const Map<StringName, int>::Element *E = global_map.front(); E; E = E->next()) {
+		ERR_CONTINUE(E->get() < 0 || E->get() >= state.global_names.size());
+		state.global_names.write[E->get()] = E->key();
+	}
+
+	SaveState body;
+	body.root = p_script;
+	body.global_names = state.global_names;
+	body.strip_debug_info = p_strip_debug_info;
+	_save_class_tree(body, p_script);
+	if (!_save_class(body, p_script)) {
+		return ERR_UNAVAILABLE; //uses constants that can't be serialized
+	}
+
+	state.data.push_back(BYTECODE_MAGIC[0]);
+	state.data.push_back(BYTECODE_MAGIC[1]);
+	state.data.push_back(BYTECODE_MAGIC[2]);
+	state.data.push_back(BYTECODE_MAGIC[3]);
+	state.put_32(FORMAT_VERSION);
+	state.put_string(_get_engine_version());
+	state.put_64(p_source_hash);
+	//stack debug info is only generated while a debugger is attached
+	state.put_32(ScriptDebugger::get_singleton() && !p_strip_debug_info ? FLAG_DEBUG_INFO : 0);
+
+	if (p_dependencies.size() || body.dependencies.size()) {
+		Set<String> dependencies = body.dependencies;
+		for (const List<String>::Element *E = p_dependencies.front(); E; E = E->next()) {
+			dependencies.insert(E->get());
+		}
+		dependencies.erase(p_script->get_path());
+
+		state.put_32(dependencies.size());
+		for (Set<String>::Element *E = dependencies.front(); E; E = E->next()) {
+			state.put_string(E->get());
+			state.put_64(FileAccess::get_modified_time(E->get()));
+		}
+	} else {
+		state.put_32(0);
+	}
+
+	r_buffer = state.data;
+	r_buffer.append_array(body.data);
+	return OK;
+}
+
+/////////////////////
+
+bool GDScriptBytecode::_load_script_ref(LoadState &p_state, Ref<Script> &r_script) {
+
+	int ref_type = p_state.get_8();
+	if (ref_type == SCRIPT_REF_NONE) {
+		r_script = Ref<Script>();
+		return !p_state.error;
+	}
+
+	Ref<Script> script;
+	if (ref_type == SCRIPT_REF_SELF) {
+		script = Ref<Script>(p_state.root);
+	} else if (ref_type == SCRIPT_REF_PATH) {
+		String path = p_state.get_string();
+		if (p_state.error) {
+			return false;
+		}
+		script = ResourceLoader::load(path);
+	} else {
+		return false;
+	}
+
+	int inner_count = p_state.get_count();
+	for (int i = 0; i < inner_count; i++) {
+		StringName inner = p_state.get_string();
+		Ref<GDScript> gds = script;
+		if (gds.is_null() || !gds->subclasses.has(inner)) {
+			return false;
+		}
+		script = gds->subclasses[inner];
+	}
+
+	if (p_state.error || script.is_null()) {
+		return false;
+	}
+
+	r_script = script;
+	return true;
+}
+
+bool GDScriptBytecode::_load_constant(LoadState &p_state, Variant &r_value) {
+
+	int constant_type = p_state.get_8();
+	switch (constant_type) {
+		case CONSTANT_VALUE: {
+			r_value = p_state.get_variant();
+		} break;
+		case CONSTANT_NATIVE_CLASS: {
+			StringName name = p_state.get_string();
+			const Map<StringName, int>::Element *E = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+			if (!E) {
+				return false;
+			}
+			r_value = GDScriptLanguage::get_singleton()->get_global_array()[E->get()];
+			if (!Object::cast_to<GDScriptNativeClass>(r_value)) {
+				return false;
+			}
+		} break;
+		case CONSTANT_SCRIPT: {
+			Ref<Script> script;
+			if (!_load_script_ref(p_state, script)) {
+				return false;
+			}
+			r_value = script;
+		} break;
+		case CONSTANT_RESOURCE: {
+			String path = p_state.get_string();
+			if (p_state.error) {
+				return false;
+			}
+			RES res = ResourceLoader::load(path);
+			if (res.is_null()) {
+				return false;
+			}
+			r_value = res;
+		} break;
+		case CONSTANT_GLOBAL: {
+			StringName name = p_state.get_string();
+			const Map<StringName, Variant>::Element *N = GDScriptLanguage::get_singleton()->get_named_globals_map().find(name);
+			if (N) {
+				r_value = N->get();
+			} else {
+				const Map<StringName, int>::Element *E = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+				if (!E) {
+					return false;
+				}
+				r_value = GDScriptLanguage::get_singleton()->get_global_array()[E->get()];
+			}
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	return !p_state.error;
+}
+
+bool GDScriptBytecode::_load_data_type(LoadState &p_state, GDScriptDataType &r_type) {
+
+	r_type.has_type = p_state.get_8();
+	int kind = p_state.get_8();
+	int builtin_type = p_state.get_32();
+	r_type.native_type = p_state.get_string();
+	if (p_state.error || kind > GDScriptDataType::GDSCRIPT || builtin_type < 0 || builtin_type >= Variant::VARIANT_MAX) {
+		return false;
+	}
+	r_type.kind = decltype(r_type.kind)(kind);
+	r_type.builtin_type = Variant::Type(builtin_type);
+	return _load_script_ref(p_state, r_type.script_type);
+}
+
+bool GDScriptBytecode::_load_function(LoadState &p_state, GDScript *p_script, GDScriptFunction *p_function) {
+
+	p_function->name = p_state.get_string();
+	p_function->_argument_count = p_state.get_32();
+	p_function->_stack_size = p_state.get_32();
+	p_function->_call_size = p_state.get_32();
+	p_function->_initial_line = p_state.get_32();
+	p_function->_static = p_state.get_8();
+	p_function->rpc_mode = MultiplayerAPI::RPCMode(p_state.get_32());
+
+	int constant_count = p_state.get_count();
+	p_function->constants.resize(constant_count);
+	for (int i = 0; i < constant_count; i++) {
+		if (!_load_constant(p_state, p_function->constants.write[i])) {
+			return false;
+		}
+	}
+
+	int name_count = p_state.get_count();
+	p_function->global_names.resize(name_count);
+	for (int i = 0; i < name_count; i++) {
+		p_function->global_names.write[i] = p_state.get_string();
+	}
+
+	int global_count = p_state.get_count();
+	Vector<StringName> globals;
+	globals.resize(global_count);
+	for (int i = 0; i < global_count; i++) {
+		globals.write[i] = p_state.get_string();
+	}
+
+	int code_size = p_state.get_count();
+	p_function->code.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		p_function->code.write[i] = p_state.get_32();
+	}
+
+	int default_count = p_state.get_count();
+	p_function->default_arguments.resize(default_count);
+	for (int i = 0; i < default_count; i++) {
+		p_function->default_arguments.write[i] = p_state.get_32();
+	}
+
+	int argument_type_count = p_state.get_count();
+	p_function->argument_types.resize(argument_type_count);
+	for (int i = 0; i < argument_type_count; i++) {
+		if (!_load_data_type(p_state, p_function->argument_types.write[i])) {
+			return false;
+		}
+	}
+	if (!_load_data_type(p_state, p_function->return_type)) {
+		return false;
+	}
+
+	int arg_name_count = p_state.get_count();
+#ifdef TOOLS_ENABLED
+	p_function->arg_names.resize(arg_name_count);
+	for (int i = 0; i < arg_name_count; i++) {
+		p_function->arg_names.write[i] = p_state.get_string();
+	}
+#else
+	for (int i = 0; i < arg_name_count; i++) {
+		p_state.get_string();
+	}
+#endif
+
+	int stack_debug_count = p_state.get_count();
+	for (int i = 0; i < stack_debug_count; i++) {
+		GDScriptFunction::StackDebug sd;
+		sd.line = p_state.get_32();
+		sd.pos = p_state.get_32();
+		sd.added = p_state.get_8();
+		sd.identifier = p_state.get_string();
+		p_function->stack_debug.push_back(sd);
+	}
+
+	if (p_state.error) {
+		return false;
+	}
+
+	//resolve globals by name and rebuild the specialized helper tables, the compiler
+	//stored them as function pointers which are only meaningful in the running binary
+
+	const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	int *code_ptr = p_function->code.ptrw();
+	Vector<int> addresses;
+	for (int ip = 0; ip < code_size;) {
+
+		int size;
+		if (!_get_opcode_layout(code_ptr, code_size, ip, size, addresses)) {
+			return false;
+		}
+
+		for (int i = 0; i < addresses.size(); i++) {
+			int address = code_ptr[addresses[i]];
+			if (((address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) != GDScriptFunction::ADDR_TYPE_GLOBAL) {
+				continue;
+			}
+			int index = address & GDScriptFunction::ADDR_MASK;
+			if (index >= global_count) {
+				return false;
+			}
+
+			const Map<StringName, int>::Element *E = global_map.find(globals[index]);
+			if (E) {
+				code_ptr[addresses[i]] = E->get() | (GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS);
+				continue;
+			}
+#ifdef TOOLS_ENABLED
+			if (GDScriptLanguage::get_singleton()->get_named_globals_map().has(globals[index])) {
+				int named_index = p_function->named_globals.find(globals[index]);
+				if (named_index == -1) {
+					named_index = p_function->named_globals.size();
+					p_function->named_globals.push_back(globals[index]);
+				}
+				code_ptr[addresses[i]] = named_index | (GDScriptFunction::ADDR_TYPE_NAMED_GLOBAL << GDScriptFunction::ADDR_BITS);
+				continue;
+			}
+#endif
+			return false; //the global no longer exists
+		}
+
+		switch (code_ptr[ip]) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				int op = code_ptr[ip + 4];
+				if (op < 0 || op >= Variant::OP_MAX) {
+					return false;
+				}
+				Variant::ValidatedOperatorEvaluator func = Variant::get_validated_operator_evaluator(Variant::Operator(op), Variant::Type(code_ptr[ip + 1] & 0xFF), Variant::Type(code_ptr[ip + 1] >> 8));
+				if (!func) {
+					return false;
+				}
+				int pos = p_function->operator_funcs.find(func);
+				if (pos == -1) {
+					pos = p_function->operator_funcs.size();
+					p_function->operator_funcs.push_back(func);
+				}
+				code_ptr[ip + 2] = pos;
+			} break;
+			case GDScriptFunction::OPCODE_GET_VALIDATED: {
+				Variant::ValidatedIndexedGetter func = Variant::get_validated_indexed_getter(Variant::Type(code_ptr[ip + 1] & 0xFF), Variant::Type(code_ptr[ip + 1] >> 8));
+				if (!func) {
+					return false;
+				}
+				int pos = p_function->indexed_getter_funcs.find(func);
+				if (pos == -1) {
+					pos = p_function->indexed_getter_funcs.size();
+					p_function->indexed_getter_funcs.push_back(func);
+				}
+				code_ptr[ip + 2] = pos;
+			} break;
+			case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+				int name_index = ip + 5 < code_size ? code_ptr[ip + 5] : -1;
+				if (name_index < 0 || name_index >= name_count) {
+					return false;
+				}
+				Variant::ValidatedGetter func = Variant::get_validated_member_getter(Variant::Type(code_ptr[ip + 1]), p_function->global_names[name_index]);
+				if (!func) {
+					return false;
+				}
+				int pos = p_function->getter_funcs.find(func);
+				if (pos == -1) {
+					pos = p_function->getter_funcs.size();
+					p_function->getter_funcs.push_back(func);
+				}
+				code_ptr[ip + 2] = pos;
+			} break;
+			case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+				int name_index = ip + 5 < code_size ? code_ptr[ip + 5] : -1;
+				if (name_index < 0 || name_index >= name_count) {
+					return false;
+				}
+				Variant::ValidatedSetter func = Variant::get_validated_member_setter(Variant::Type(code_ptr[ip + 1] & 0xFF), p_function->global_names[name_index], Variant::Type(code_ptr[ip + 1] >> 8));
+				if (!func) {
+					return false;
+				}
+				int pos = p_function->setter_funcs.find(func);
+				if (pos == -1) {
+					pos = p_function->setter_funcs.size();
+					p_function->setter_funcs.push_back(func);
+				}
+				code_ptr[ip + 2] = pos;
+			} break;
+			case GDScriptFunction::OPCODE_SET_VALIDATED: {
+				int types = code_ptr[ip + 1];
+				Variant::ValidatedIndexedSetter func = Variant::get_validated_indexed_setter(Variant::Type(types & 0xFF), Variant::Type((types >> 8) & 0xFF), Variant::Type(types >> 16));
+				if (!func) {
+					return false;
+				}
+				int pos = p_function->indexed_setter_funcs.find(func);
+				if (pos == -1) {
+					pos = p_function->indexed_setter_funcs.size();
+					p_function->indexed_setter_funcs.push_back(func);
+				}
+				code_ptr[ip + 2] = pos;
+			} break;
+			default: {
+			}
+		}
+
+		ip += size;
+	}
+
+	//same setup as GDScriptCompiler::_parse_function
+
+	p_function->_constant_count = p_function->constants.size();
+	p_function->_constants_ptr = constant_count ? p_function->constants.ptrw() : NULL;
+
+	p_function->_global_names_count = name_count;
+	if (name_count) {
+		p_function->_global_names_ptr = p_function->global_names.ptr();
+		p_function->_method_caches = memnew_arr(MethodCallCache, name_count);
+		p_function->_property_caches = memnew_arr(MethodCallCache, name_count);
+	} else {
+		p_function->_global_names_ptr = NULL;
+		p_function->_method_caches = NULL;
+		p_function->_property_caches = NULL;
+	}
+
+	p_function->_operator_funcs_ptr = p_function->operator_funcs.ptr();
+	p_function->_operator_funcs_count = p_function->operator_funcs.size();
+	p_function->_getter_funcs_ptr = p_function->getter_funcs.ptr();
+	p_function->_getter_funcs_count = p_function->getter_funcs.size();
+	p_function->_setter_funcs_ptr = p_function->setter_funcs.ptr();
+	p_function->_setter_funcs_count = p_function->setter_funcs.size();
+	p_function->_indexed_getter_funcs_ptr = p_function->indexed_getter_funcs.ptr();
+	p_function->_indexed_getter_funcs_count = p_function->indexed_getter_funcs.size();
+	p_function->_indexed_setter_funcs_ptr = p_function->indexed_setter_funcs.ptr();
+	p_function->_indexed_setter_funcs_count = p_function->indexed_setter_funcs.size();
+
+#ifdef TOOLS_ENABLED
+	p_function->_named_globals_ptr = p_function->named_globals.ptr();
+	p_function->_named_globals_count = p_function->named_globals.size();
+#endif
+
+	p_function->_code_ptr = code_size ? p_function->code.ptr() : NULL;
+	p_function->_code_size = code_size;
+
+	if (default_count) {
+		p_function->_default_arg_count = default_count - 1;
+		p_function->_default_arg_ptr = p_function->default_arguments.ptr();
+	} else {
+		p_function->_default_arg_count = 0;
+		p_function->_default_arg_ptr = NULL;
+	}
+
+	p_function->_script = p_script;
+	p_function->source = p_state.root->get_path();
+
+#ifdef DEBUG_ENABLED
+	if (ScriptDebugger::get_singleton()) {
+		String signature = p_state.root->get_path() + "::" + itos(p_function->_initial_line);
+		if (p_script->name != String()) {
+			signature += "::" + p_script->name + "." + String(p_function->name);
+		} else {
+			signature += "::" + String(p_function->name);
+		}
+		p_function->profile.signature = signature;
+	}
+
+	p_function->func_cname = (String(p_function->source) + " - " + String(p_function->name)).utf8();
+	p_function->_func_cname = p_function->func_cname.get_data();
+#endif
+
+	return true;
+}
+
+bool GDScriptBytecode::_load_class_tree(LoadState &p_state, GDScript *p_script) {
+
+	p_script->subclasses.clear();
+
+	int subclass_count = p_state.get_count();
+	for (int i = 0; i < subclass_count; i++) {
+		StringName name = p_state.get_string();
+		if (p_state.error) {
+			return false;
+		}
+
+		String fully_qualified_name = p_script->fully_qualified_name + "::" + name;
+		Ref<GDScript> subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+		if (subclass.is_null()) {
+			subclass.instance();
+		}
+		subclass->_owner = p_script;
+		subclass->fully_qualified_name = fully_qualified_name;
+		p_script->subclasses.insert(name, subclass);
+
+		if (!_load_class_tree(p_state, subclass.ptr())) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool GDScriptBytecode::_load_class(LoadState &p_state, GDScript *p_script) {
+
+	for (Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+	p_script->member_functions.clear();
+	p_script->members.clear();
+	p_script->constants.clear();
+	p_script->member_indices.clear();
+	p_script->member_info.clear();
+	p_script->_signals.clear();
+	p_script->initializer = NULL;
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = NULL;
+#ifdef TOOLS_ENABLED
+	p_script->member_lines.clear();
+	p_script->member_default_values.clear();
+#endif
+
+	p_script->tool = p_state.get_8();
+	p_script->name = p_state.get_string();
+
+	StringName native_name = p_state.get_string();
+	if (native_name != StringName()) {
+		const Map<StringName, int>::Element *E = GDScriptLanguage::get_singleton()->get_global_map().find(native_name);
+		if (!E) {
+			return false;
+		}
+		p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[E->get()];
+		if (p_script->native.is_null()) {
+			return false;
+		}
+	}
+
+	Ref<Script> base;
+	if (!_load_script_ref(p_state, base)) {
+		return false;
+	}
+	if (base.is_valid()) {
+		p_script->base = base;
+		if (p_script->base.is_null()) {
+			return false;
+		}
+		p_script->_base = p_script->base.ptr();
+	}
+
+	int member_count = p_state.get_count();
+	for (int i = 0; i < member_count; i++) {
+		p_script->members.insert(p_state.get_string());
+	}
+
+	int member_index_count = p_state.get_count();
+	for (int i = 0; i < member_index_count; i++) {
+		StringName name = p_state.get_string();
+		GDScript::MemberInfo minfo;
+		minfo.index = p_state.get_32();
+		minfo.setter = p_state.get_string();
+		minfo.getter = p_state.get_string();
+		minfo.rpc_mode = MultiplayerAPI::RPCMode(p_state.get_32());
+		if (!_load_data_type(p_state, minfo.data_type)) {
+			return false;
+		}
+		p_script->member_indices[name] = minfo;
+	}
+
+	int member_info_count = p_state.get_count();
+	for (int i = 0; i < member_info_count; i++) {
+		StringName name = p_state.get_string();
+		PropertyInfo pinfo;
+		pinfo.type = Variant::Type(p_state.get_32());
+		pinfo.name = p_state.get_string();
+		pinfo.class_name = p_state.get_string();
+		pinfo.hint = PropertyHint(p_state.get_32());
+		pinfo.hint_string = p_state.get_string();
+		pinfo.usage = p_state.get_32();
+		p_script->member_info[name] = pinfo;
+	}
+
+	int constant_count = p_state.get_count();
+	for (int i = 0; i < constant_count; i++) {
+		StringName name = p_state.get_string();
+		Variant value;
+		if (!_load_constant(p_state, value)) {
+			return false;
+		}
+		p_script->constants[name] = value;
+	}
+
+	int signal_count = p_state.get_count();
+	for (int i = 0; i < signal_count; i++) {
+		StringName name = p_state.get_string();
+		int argument_count = p_state.get_count();
+		Vector<StringName> arguments;
+		arguments.resize(argument_count);
+		for (int j = 0; j < argument_count; j++) {
+			arguments.write[j] = p_state.get_string();
+		}
+		p_script->_signals[name] = arguments;
+	}
+
+	int function_count = p_state.get_count();
+	for (int i = 0; i < function_count; i++) {
+		StringName name = p_state.get_string();
+		if (p_state.error) {
+			return false;
+		}
+		GDScriptFunction *function = memnew(GDScriptFunction);
+		p_script->member_functions[name] = function; //freed by the script if loading fails
+		if (!_load_function(p_state, p_script, function)) {
+			return false;
+		}
+	}
+
+	int line_count = p_state.get_count();
+	for (int i = 0; i < line_count; i++) {
+		StringName name = p_state.get_string();
+		int line = p_state.get_32();
+#ifdef TOOLS_ENABLED
+		p_script->member_lines[name] = line;
+#endif
+	}
+
+	int default_value_count = p_state.get_count();
+	for (int i = 0; i < default_value_count; i++) {
+		StringName name = p_state.get_string();
+		Variant value;
+		if (!_load_constant(p_state, value)) {
+			return false;
+		}
+#ifdef TOOLS_ENABLED
+		p_script->member_default_values[name] = value;
+#endif
+	}
+
+	if (p_state.error || !p_script->member_functions.has("_init")) {
+		return false;
+	}
+	p_script->initializer = p_script->member_functions["_init"];
+
+	for (Map<StringName, Ref<GDScript> >::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		if (!_load_class(p_state, E->get().ptr())) {
+			return false;
+		}
+	}
+
+	p_script->valid = true;
+	return true;
+}
+
+Error GDScriptBytecode::load(GDScript *p_script, const Vector<uint8_t> &p_buffer, uint64_t p_source_hash) {
+
+	LoadState state;
+	state.data = p_buffer.ptr();
+	state.size = p_buffer.size();
+	state.pos = 0;
+	state.error = false;
+	state.root = p_script;
+
+	if (state.size < 4 || state.data[0] != BYTECODE_MAGIC[0] || state.data[1] != BYTECODE_MAGIC[1] || state.data[2] != BYTECODE_MAGIC[2] || state.data[3] != BYTECODE_MAGIC[3]) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	state.pos = 4;
+
+	if (state.get_32() != FORMAT_VERSION || state.get_string() != _get_engine_version() || state.get_64() != p_source_hash) {
+		return ERR_UNAVAILABLE;
+	}
+
+	uint32_t flags = state.get_32();
+	if (ScriptDebugger::get_singleton() && !(flags & FLAG_DEBUG_INFO)) {
+		return ERR_UNAVAILABLE; //compile again to get debug info for the debugger
+	}
+
+	int dependency_count = state.get_count();
+	for (int i = 0; i < dependency_count; i++) {
+		String path = state.get_string();
+		uint64_t modified_time = state.get_64();
+		if (state.error || FileAccess::get_modified_time(path) != modified_time) {
+			return ERR_UNAVAILABLE;
+		}
+	}
+
+	if (state.error) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	p_script->fully_qualified_name = p_script->path;
+	p_script->_owner = NULL;
+
+	if (!_load_class_tree(state, p_script) || !_load_class(state, p_script)) {
+		//leave the script empty, it's compiled from source next
+		p_script->valid = false;
+		return ERR_UNAVAILABLE;
+	}
+
+	if (state.pos != state.size) {
+		p_script->valid = false;
+		return ERR_FILE_CORRUPT;
+	}
+
+	return OK;
+}
+
+/////////////////////
+
+static String _get_cache_path(const String &p_path) {
+
+	return "res://.import/" + p_path.get_file() + "-" + p_path.md5_text() + ".gdbc";
+}
+
+bool GDScriptBytecode::is_cache_enabled() {
+
+	return GLOBAL_GET("filesystem/scripts/use_bytecode_cache");
+}
+
+Error GDScriptBytecode::load_from_cache(GDScript *p_script, uint64_t p_source_hash) {
+
+	String cache_path = _get_cache_path(p_script->get_path());
+	if (!FileAccess::exists(cache_path)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	FileAccess *f = FileAccess::open(cache_path, FileAccess::READ);
+	if (!f) {
+		return ERR_CANT_OPEN;
+	}
+
+	Vector<uint8_t> buffer;
+	buffer.resize(f->get_len());
+	int read = f->get_buffer(buffer.ptrw(), buffer.size());
+	memdelete(f);
+	if (read != buffer.size()) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	return load(p_script, buffer, p_source_hash);
+}
+
+void GDScriptBytecode::save_to_cache(const GDScript *p_script, uint64_t p_source_hash, const List<String> &p_dependencies) {
+
+	Vector<uint8_t> buffer;
+	if (save(p_script, p_source_hash, p_dependencies, buffer) != OK) {
+		return; //not cacheable, compiled from source every time
+	}
+
+	String cache_path = _get_cache_path(p_script->get_path());
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+	if (!da->dir_exists("res://.import")) {
+		da->make_dir_recursive("res://.import");
+	}
+
+	//write aside and move it in place, so concurrent loads never see a partial file
+	String temp_path = cache_path + ".tmp" + itos(Thread::get_caller_id());
+	FileAccess *f = FileAccess::open(temp_path, FileAccess::WRITE);
+	if (!f) {
+		memdelete(da);
+		return;
+	}
+	f->store_buffer(buffer.ptr(), buffer.size());
+	bool failed = f->get_error() != OK;
+	memdelete(f);
+
+	if (!failed && da->file_exists(cache_path)) {
+		da->remove(cache_path);
+	}
+	if (failed || da->rename(temp_path, cache_path) != OK) {
+		da->remove(temp_path);
+	}
+	memdelete(da);
+}
@@ -0,0 +1,81 @@
+/*************************************************************************/
+/*  gdscript_bytecode.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_H
+#define GDSCRIPT_BYTECODE_H
+
+#include "gdscript.h"
+
+// serialized form of a compiled script (classes, constants, functions and their opcode
+// streams), so it can be loaded without parsing and compiling the source again.
+// references to engine globals are stored by name and resolved again on load, so caches
+// written by the editor are valid in export templates too.
+class GDScriptBytecode {
+
+	struct SaveState;
+	struct LoadState;
+
+	static bool _get_opcode_layout(const int *p_code, int p_code_size, int p_ip, int &r_size, Vector<int> &r_addresses);
+	static bool _strip_line_opcodes(Vector<int> &r_code, Vector<int> &r_default_arguments);
+
+	static bool _save_script_ref(SaveState &p_state, const Ref<Script> &p_script);
+	static bool _save_constant(SaveState &p_state, const Variant &p_value);
+	static bool _save_data_type(SaveState &p_state, const GDScriptDataType &p_type);
+	static bool _save_function(SaveState &p_state, const GDScriptFunction *p_function);
+	static void _save_class_tree(SaveState &p_state, const GDScript *p_script);
+	static bool _save_class(SaveState &p_state, const GDScript *p_script);
+
+	static bool _load_script_ref(LoadState &p_state, Ref<Script> &r_script);
+	static bool _load_constant(LoadState &p_state, Variant &r_value);
+	static bool _load_data_type(LoadState &p_state, GDScriptDataType &r_type);
+	static bool _load_function(LoadState &p_state, GDScript *p_script, GDScriptFunction *p_function);
+	static bool _load_class_tree(LoadState &p_state, GDScript *p_script);
+	static bool _load_class(LoadState &p_state, GDScript *p_script);
+
+public:
+	enum {
+		FORMAT_VERSION = 3
+	};
+
+	static uint64_t hash_buffer(const uint8_t *p_buffer, int p_size);
+
+	// p_dependencies are checked by modification time on load, leave empty for exports.
+	// p_strip_debug_info drops line opcodes and local variable info, for release exports.
+	static Error save(const GDScript *p_script, uint64_t p_source_hash, const List<String> &p_dependencies, Vector<uint8_t> &r_buffer, bool p_strip_debug_info = false);
+	// fails with ERR_UNAVAILABLE when stale, the caller compiles from source then
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_buffer, uint64_t p_source_hash);
+
+	// cache of compiled scripts in the project's .import folder, used by tools builds
+	static bool is_cache_enabled();
+	static Error load_from_cache(GDScript *p_script, uint64_t p_source_hash);
+	static void save_to_cache(const GDScript *p_script, uint64_t p_source_hash, const List<String> &p_dependencies);
+};
+
+#endif // GDSCRIPT_BYTECODE_H
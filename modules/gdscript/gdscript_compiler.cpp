@@ -31,6 +31,7 @@
 #include "gdscript_compiler.h"
 
 #include "gdscript.h"
+#include "gdscript_functions.h"
 
 bool GDScriptCompiler::_is_class_member_property(CodeGen &codegen, const StringName &p_name) {
 
@@ -74,6 +75,230 @@ void GDScriptCompiler::_set_error(const String &p_error, const GDScriptParser::N
 	}
 }
 
+Variant::Type GDScriptCompiler::_get_builtin_type_hint(const GDScriptParser::Node *p_node) const {
+
+	GDScriptParser::DataType datatype = p_node->get_datatype();
+	if (!datatype.has_type || datatype.kind != GDScriptParser::DataType::BUILTIN || datatype.builtin_type == Variant::NIL) {
+		return Variant::VARIANT_MAX;
+	}
+	return datatype.builtin_type;
+}
+
+bool GDScriptCompiler::_get_constant_value(CodeGen &codegen, const GDScriptParser::Node *p_node, Variant &r_value) {
+
+	//evaluates expressions the parser couldn't reduce because they use class constants.
+	//only side-effect free operations are folded, and anything that fails to evaluate is
+	//left for the runtime, so it errors out the same way it always did.
+
+	switch (p_node->type) {
+		case GDScriptParser::Node::TYPE_CONSTANT: {
+			r_value = static_cast<const GDScriptParser::ConstantNode *>(p_node)->value;
+			return true;
+		} break;
+		case GDScriptParser::Node::TYPE_IDENTIFIER: {
+			StringName identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_node)->name;
+
+			//same lookup order as _parse_expression
+			if (codegen.stack_identifiers.has(identifier) || _is_class_member_property(codegen, identifier)) {
+				return false;
+			}
+			if ((!codegen.function_node || !codegen.function_node->_static) && codegen.script->member_indices.has(identifier)) {
+				return false;
+			}
+
+			for (GDScript *owner = codegen.script; owner; owner = owner->_owner) {
+				for (GDScript *scr = owner; scr; scr = scr->_base) {
+					const Map<StringName, Variant>::Element *E = scr->constants.find(identifier);
+					if (E) {
+						r_value = E->get();
+						return true;
+					}
+				}
+			}
+			return false;
+		} break;
+		case GDScriptParser::Node::TYPE_OPERATOR: {
+			//handled below
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	const GDScriptParser::OperatorNode *on = static_cast<const GDScriptParser::OperatorNode *>(p_node);
+
+	Variant::Operator vop;
+	switch (on->op) {
+		case GDScriptParser::OperatorNode::OP_NEG: vop = Variant::OP_NEGATE; break;
+		case GDScriptParser::OperatorNode::OP_POS: vop = Variant::OP_POSITIVE; break;
+		case GDScriptParser::OperatorNode::OP_NOT: vop = Variant::OP_NOT; break;
+		case GDScriptParser::OperatorNode::OP_BIT_INVERT: vop = Variant::OP_BIT_NEGATE; break;
+		case GDScriptParser::OperatorNode::OP_IN: vop = Variant::OP_IN; break;
+		case GDScriptParser::OperatorNode::OP_EQUAL: vop = Variant::OP_EQUAL; break;
+		case GDScriptParser::OperatorNode::OP_NOT_EQUAL: vop = Variant::OP_NOT_EQUAL; break;
+		case GDScriptParser::OperatorNode::OP_LESS: vop = Variant::OP_LESS; break;
+		case GDScriptParser::OperatorNode::OP_LESS_EQUAL: vop = Variant::OP_LESS_EQUAL; break;
+		case GDScriptParser::OperatorNode::OP_GREATER: vop = Variant::OP_GREATER; break;
+		case GDScriptParser::OperatorNode::OP_GREATER_EQUAL: vop = Variant::OP_GREATER_EQUAL; break;
+		case GDScriptParser::OperatorNode::OP_ADD: vop = Variant::OP_ADD; break;
+		case GDScriptParser::OperatorNode::OP_SUB: vop = Variant::OP_SUBTRACT; break;
+		case GDScriptParser::OperatorNode::OP_MUL: vop = Variant::OP_MULTIPLY; break;
+		case GDScriptParser::OperatorNode::OP_DIV: vop = Variant::OP_DIVIDE; break;
+		case GDScriptParser::OperatorNode::OP_MOD: vop = Variant::OP_MODULE; break;
+		case GDScriptParser::OperatorNode::OP_SHIFT_LEFT: vop = Variant::OP_SHIFT_LEFT; break;
+		case GDScriptParser::OperatorNode::OP_SHIFT_RIGHT: vop = Variant::OP_SHIFT_RIGHT; break;
+		case GDScriptParser::OperatorNode::OP_BIT_AND: vop = Variant::OP_BIT_AND; break;
+		case GDScriptParser::OperatorNode::OP_BIT_OR: vop = Variant::OP_BIT_OR; break;
+		case GDScriptParser::OperatorNode::OP_BIT_XOR: vop = Variant::OP_BIT_XOR; break;
+		case GDScriptParser::OperatorNode::OP_AND:
+		case GDScriptParser::OperatorNode::OP_OR: {
+			//short-circuit, the right side doesn't need to be constant when the left one decides
+			Variant a;
+			if (!_get_constant_value(codegen, on->arguments[0], a) || a.get_type() == Variant::OBJECT) {
+				return false;
+			}
+			bool is_and = on->op == GDScriptParser::OperatorNode::OP_AND;
+			if (a.booleanize() != is_and) {
+				r_value = !is_and;
+				return true;
+			}
+			Variant b;
+			if (!_get_constant_value(codegen, on->arguments[1], b) || b.get_type() == Variant::OBJECT) {
+				return false;
+			}
+			r_value = b.booleanize();
+			return true;
+		} break;
+		case GDScriptParser::OperatorNode::OP_TERNARY_IF: {
+			Variant condition;
+			if (!_get_constant_value(codegen, on->arguments[0], condition) || condition.get_type() == Variant::OBJECT) {
+				return false;
+			}
+			return _get_constant_value(codegen, on->arguments[condition.booleanize() ? 1 : 2], r_value);
+		} break;
+		case GDScriptParser::OperatorNode::OP_INDEX:
+		case GDScriptParser::OperatorNode::OP_INDEX_NAMED: {
+			Variant base;
+			if (!_get_constant_value(codegen, on->arguments[0], base)) {
+				return false;
+			}
+
+			bool valid = false;
+			if (on->op == GDScriptParser::OperatorNode::OP_INDEX_NAMED) {
+				if (on->arguments[1]->type != GDScriptParser::Node::TYPE_IDENTIFIER) {
+					return false;
+				}
+				StringName name = static_cast<const GDScriptParser::IdentifierNode *>(on->arguments[1])->name;
+				if (base.get_type() == Variant::OBJECT) {
+					//constants of preloaded scripts, anything else on objects may have side effects
+					for (GDScript *scr = Object::cast_to<GDScript>(base); scr; scr = scr->_base) {
+						const Map<StringName, Variant>::Element *E = scr->constants.find(name);
+						if (E) {
+							r_value = E->get();
+							valid = true;
+							break;
+						}
+					}
+				} else {
+					r_value = base.get_named(name, &valid);
+				}
+			} else {
+				Variant index;
+				if (base.get_type() == Variant::OBJECT || !_get_constant_value(codegen, on->arguments[1], index)) {
+					return false;
+				}
+				r_value = base.get(index, &valid);
+			}
+			if (!valid) {
+				return false;
+			}
+			vop = Variant::OP_MAX;
+		} break;
+		case GDScriptParser::OperatorNode::OP_CALL: {
+			//built-in type constructors and deterministic built-in functions
+			const GDScriptParser::Node *callee = on->arguments[0];
+			bool is_constructor = callee->type == GDScriptParser::Node::TYPE_TYPE;
+			if (!is_constructor && (callee->type != GDScriptParser::Node::TYPE_BUILT_IN_FUNCTION || !GDScriptFunctions::is_deterministic(static_cast<const GDScriptParser::BuiltInFunctionNode *>(callee)->function))) {
+				return false;
+			}
+
+			Vector<Variant> args;
+			args.resize(on->arguments.size() - 1);
+			Vector<const Variant *> argptrs;
+			argptrs.resize(args.size());
+			for (int i = 0; i < args.size(); i++) {
+				if (!_get_constant_value(codegen, on->arguments[i + 1], args.write[i]) || args[i].get_type() == Variant::OBJECT) {
+					return false;
+				}
+				argptrs.write[i] = &args[i];
+			}
+
+			Variant::CallError ce;
+			if (is_constructor) {
+				r_value = Variant::construct(static_cast<const GDScriptParser::TypeNode *>(callee)->vtype, (const Variant **)argptrs.ptr(), args.size(), ce);
+			} else {
+				GDScriptFunctions::call(static_cast<const GDScriptParser::BuiltInFunctionNode *>(callee)->function, (const Variant **)argptrs.ptr(), args.size(), r_value, ce);
+			}
+			if (ce.error != Variant::CallError::CALL_OK) {
+				return false;
+			}
+			vop = Variant::OP_MAX;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	if (vop != Variant::OP_MAX) {
+		Variant a, b;
+		if (!_get_constant_value(codegen, on->arguments[0], a) || (on->arguments.size() > 1 && !_get_constant_value(codegen, on->arguments[1], b))) {
+			return false;
+		}
+		if (a.get_type() == Variant::OBJECT || b.get_type() == Variant::OBJECT) {
+			return false; //may call into scripts
+		}
+
+		bool valid = false;
+		Variant::evaluate(vop, a, b, r_value, valid);
+		if (!valid) {
+			return false;
+		}
+	}
+
+	//folded arrays and dictionaries would be shared between calls instead of created each time
+	switch (r_value.get_type()) {
+		case Variant::OBJECT:
+		case Variant::ARRAY:
+		case Variant::DICTIONARY: {
+			return false;
+		} break;
+		default: {
+		}
+	}
+
+	return true;
+}
+
+void GDScriptCompiler::_emit_validated_operator(CodeGen &codegen, Variant::Operator op, const GDScriptParser::Node *p_a, const GDScriptParser::Node *p_b) {
+
+	//when both operand types are known, prefix the generic operator with a specialized one.
+	//types are still checked at runtime, so a wrong hint just falls back to the generic path.
+	Variant::Type type_a = _get_builtin_type_hint(p_a);
+	Variant::Type type_b = _get_builtin_type_hint(p_b);
+	if (type_a == Variant::VARIANT_MAX || type_b == Variant::VARIANT_MAX) {
+		return;
+	}
+
+	Variant::ValidatedOperatorEvaluator func = Variant::get_validated_operator_evaluator(op, type_a, type_b);
+	if (!func) {
+		return;
+	}
+
+	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+	codegen.opcodes.push_back(type_a | (type_b << 8));
+	codegen.opcodes.push_back(codegen.get_operator_func_pos(func));
+}
+
 bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 
 	ERR_FAIL_COND_V(on->arguments.size() != 1, false);
@@ -82,6 +307,7 @@ bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptPa
 	if (src_address_a < 0)
 		return false;
 
+	_emit_validated_operator(codegen, op, on->arguments[0], on->arguments[0]);
 	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
@@ -104,6 +330,7 @@ bool GDScriptCompiler::_create_binary_operator(CodeGen &codegen, const GDScriptP
 	if (src_address_b < 0)
 		return false;
 
+	_emit_validated_operator(codegen, op, on->arguments[0], on->arguments[1]);
 	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
@@ -216,6 +443,13 @@ int GDScriptCompiler::_parse_assign_right_expression(CodeGen &codegen, const GDS
 
 int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::Node *p_expression, int p_stack_level, bool p_root, bool p_initializer, int p_index_addr) {
 
+	if (p_expression->type == GDScriptParser::Node::TYPE_OPERATOR) {
+		Variant value;
+		if (_get_constant_value(codegen, p_expression, value)) {
+			return codegen.get_constant_pos(value) | (GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT << GDScriptFunction::ADDR_BITS);
+		}
+	}
+
 	switch (p_expression->type) {
 		//should parse variable declaration and adjust stack accordingly...
 		case GDScriptParser::Node::TYPE_IDENTIFIER: {
@@ -685,6 +919,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 					codegen.opcodes.push_back(arguments.size() == 0 ? GDScriptFunction::OPCODE_YIELD : GDScriptFunction::OPCODE_YIELD_SIGNAL); // basic type constructor
 					for (int i = 0; i < arguments.size(); i++)
 						codegen.opcodes.push_back(arguments[i]); //arguments
+					codegen.opcodes.push_back(p_stack_level); //stack slots live across the yield, the rest are temporaries
 					codegen.opcodes.push_back(GDScriptFunction::OPCODE_YIELD_RESUME);
 					//next will be where to place the result :)
 
@@ -704,6 +939,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						return from;
 
 					int index;
+					StringName index_name;
 					if (p_index_addr != 0) {
 						index = p_index_addr;
 					} else if (named) {
@@ -726,14 +962,15 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							}
 						}
 
-						index = codegen.get_name_map_pos(static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name);
+						index_name = static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name;
+						index = codegen.get_name_map_pos(index_name);
 
 					} else {
 
 						if (on->arguments[1]->type == GDScriptParser::Node::TYPE_CONSTANT && static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value.get_type() == Variant::STRING) {
 							//also, somehow, named (speed up anyway)
-							StringName name = static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value;
-							index = codegen.get_name_map_pos(name);
+							index_name = static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value;
+							index = codegen.get_name_map_pos(index_name);
 							named = true;
 
 						} else {
@@ -749,6 +986,27 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						}
 					}
 
+					//prefix with a specialized getter when the base (and index) types are known
+					Variant::Type from_type = _get_builtin_type_hint(on->arguments[0]);
+					if (from_type != Variant::VARIANT_MAX) {
+						if (named && index_name != StringName()) {
+							Variant::ValidatedGetter getter = Variant::get_validated_member_getter(from_type, index_name);
+							if (getter) {
+								codegen.opcodes.push_back(GDScriptFunction::OPCODE_GET_NAMED_VALIDATED);
+								codegen.opcodes.push_back(from_type);
+								codegen.opcodes.push_back(codegen.get_getter_func_pos(getter));
+							}
+						} else if (!named && p_index_addr == 0) {
+							Variant::Type index_type = _get_builtin_type_hint(on->arguments[1]);
+							Variant::ValidatedIndexedGetter getter = index_type != Variant::VARIANT_MAX ? Variant::get_validated_indexed_getter(from_type, index_type) : NULL;
+							if (getter) {
+								codegen.opcodes.push_back(GDScriptFunction::OPCODE_GET_VALIDATED);
+								codegen.opcodes.push_back(from_type | (index_type << 8));
+								codegen.opcodes.push_back(codegen.get_indexed_getter_func_pos(getter));
+							}
+						}
+					}
+
 					codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
 					codegen.opcodes.push_back(from); // argument 1
 					codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
@@ -825,6 +1083,12 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 
 					// x IF a ELSE y operator with early out on failure
 
+					Variant condition;
+					if (_get_constant_value(codegen, on->arguments[0], condition)) {
+						//only the branch taken is compiled
+						return _parse_expression(codegen, on->arguments[condition.booleanize() ? 1 : 2], p_stack_level);
+					}
+
 					int res = _parse_expression(codegen, on->arguments[0], p_stack_level);
 					if (res < 0)
 						return res;
@@ -1097,6 +1361,42 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						if (set_value < 0) //error
 							return set_value;
 
+						if (named) {
+							//prefix with a specialized setter when the base and value types are known
+							Variant::Type base_type = _get_builtin_type_hint(op->arguments[0]);
+							Variant::Type value_type = _get_builtin_type_hint(on->arguments[1]);
+							if (on->op != GDScriptParser::OperatorNode::OP_ASSIGN) {
+								//compound assignment, the value is the result of the operator on the member
+								value_type = _get_builtin_type_hint(op);
+							}
+							Variant::ValidatedSetter setter = NULL;
+							if (base_type != Variant::VARIANT_MAX && value_type != Variant::VARIANT_MAX) {
+								setter = Variant::get_validated_member_setter(base_type, static_cast<const GDScriptParser::IdentifierNode *>(op->arguments[1])->name, value_type);
+							}
+							if (setter) {
+								codegen.opcodes.push_back(GDScriptFunction::OPCODE_SET_NAMED_VALIDATED);
+								codegen.opcodes.push_back(base_type | (value_type << 8));
+								codegen.opcodes.push_back(codegen.get_setter_func_pos(setter));
+							}
+						} else {
+							//same for indexed stores, i.e. arr[i] = x on arrays, pool arrays and dictionaries
+							Variant::Type base_type = _get_builtin_type_hint(op->arguments[0]);
+							Variant::Type index_type = _get_builtin_type_hint(op->arguments[1]);
+							Variant::Type value_type = _get_builtin_type_hint(on->arguments[1]);
+							if (on->op != GDScriptParser::OperatorNode::OP_ASSIGN) {
+								value_type = _get_builtin_type_hint(op);
+							}
+							Variant::ValidatedIndexedSetter setter = NULL;
+							if (base_type != Variant::VARIANT_MAX && index_type != Variant::VARIANT_MAX && value_type != Variant::VARIANT_MAX) {
+								setter = Variant::get_validated_indexed_setter(base_type, index_type, value_type);
+							}
+							if (setter) {
+								codegen.opcodes.push_back(GDScriptFunction::OPCODE_SET_VALIDATED);
+								codegen.opcodes.push_back(base_type | (index_type << 8) | (value_type << 16));
+								codegen.opcodes.push_back(codegen.get_indexed_setter_func_pos(setter));
+							}
+						}
+
 						codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_SET_NAMED : GDScriptFunction::OPCODE_SET);
 						codegen.opcodes.push_back(prev_pos);
 						codegen.opcodes.push_back(set_index);
@@ -1361,6 +1661,18 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 
 					case GDScriptParser::ControlFlowNode::CF_IF: {
 
+						Variant condition;
+						if (_get_constant_value(codegen, cf->arguments[0], condition)) {
+							//the branch not taken is never compiled
+							const GDScriptParser::BlockNode *taken = condition.booleanize() ? cf->body : cf->body_else;
+							if (taken) {
+								Error err = _parse_block(codegen, taken, p_stack_level, p_break_addr, p_continue_addr);
+								if (err)
+									return err;
+							}
+							break;
+						}
+
 						int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
 						if (ret2 < 0)
 							return ERR_PARSE_ERROR;
@@ -1446,6 +1758,12 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 					} break;
 					case GDScriptParser::ControlFlowNode::CF_WHILE: {
 
+						Variant condition;
+						bool constant_condition = _get_constant_value(codegen, cf->arguments[0], condition);
+						if (constant_condition && !condition.booleanize()) {
+							break; //never runs
+						}
+
 						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP);
 						codegen.opcodes.push_back(codegen.opcodes.size() + 3);
 						int break_addr = codegen.opcodes.size();
@@ -1453,12 +1771,14 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 						codegen.opcodes.push_back(0);
 						int continue_addr = codegen.opcodes.size();
 
-						int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
-						if (ret2 < 0)
-							return ERR_PARSE_ERROR;
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-						codegen.opcodes.push_back(ret2);
-						codegen.opcodes.push_back(break_addr);
+						if (!constant_condition) {
+							int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
+							if (ret2 < 0)
+								return ERR_PARSE_ERROR;
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+							codegen.opcodes.push_back(ret2);
+							codegen.opcodes.push_back(break_addr);
+						}
 						Error err = _parse_block(codegen, cf->body, p_stack_level, break_addr, continue_addr);
 						if (err)
 							return err;
@@ -1563,6 +1883,13 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 					return ERR_PARSE_ERROR;
 			} break;
 		}
+
+		if (s->type == GDScriptParser::Node::TYPE_CONTROL_FLOW) {
+			GDScriptParser::ControlFlowNode::CFType cf_type = static_cast<const GDScriptParser::ControlFlowNode *>(s)->cf_type;
+			if (cf_type == GDScriptParser::ControlFlowNode::CF_RETURN || cf_type == GDScriptParser::ControlFlowNode::CF_BREAK || cf_type == GDScriptParser::ControlFlowNode::CF_CONTINUE) {
+				break; //the rest of the block is unreachable
+			}
+		}
 	}
 	codegen.pop_stack_identifiers();
 	return OK;
@@ -1720,12 +2047,33 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 			gdfunc->global_names.write[E->get()] = E->key();
 		}
 		gdfunc->_global_names_count = gdfunc->global_names.size();
+		gdfunc->_method_caches = memnew_arr(MethodCallCache, gdfunc->_global_names_count);
+		gdfunc->_property_caches = memnew_arr(MethodCallCache, gdfunc->_global_names_count);
 
 	} else {
 		gdfunc->_global_names_ptr = NULL;
 		gdfunc->_global_names_count = 0;
+		gdfunc->_method_caches = NULL;
+		gdfunc->_property_caches = NULL;
 	}
 
+	//specialized operator/getter/setter tables
+	gdfunc->operator_funcs = codegen.operator_funcs;
+	gdfunc->_operator_funcs_ptr = gdfunc->operator_funcs.ptr();
+	gdfunc->_operator_funcs_count = gdfunc->operator_funcs.size();
+	gdfunc->getter_funcs = codegen.getter_funcs;
+	gdfunc->_getter_funcs_ptr = gdfunc->getter_funcs.ptr();
+	gdfunc->_getter_funcs_count = gdfunc->getter_funcs.size();
+	gdfunc->setter_funcs = codegen.setter_funcs;
+	gdfunc->_setter_funcs_ptr = gdfunc->setter_funcs.ptr();
+	gdfunc->_setter_funcs_count = gdfunc->setter_funcs.size();
+	gdfunc->indexed_getter_funcs = codegen.indexed_getter_funcs;
+	gdfunc->_indexed_getter_funcs_ptr = gdfunc->indexed_getter_funcs.ptr();
+	gdfunc->_indexed_getter_funcs_count = gdfunc->indexed_getter_funcs.size();
+	gdfunc->indexed_setter_funcs = codegen.indexed_setter_funcs;
+	gdfunc->_indexed_setter_funcs_ptr = gdfunc->indexed_setter_funcs.ptr();
+	gdfunc->_indexed_setter_funcs_count = gdfunc->indexed_setter_funcs.size();
+
 #ifdef TOOLS_ENABLED
 	// Named globals
 	if (codegen.named_globals.size()) {
@@ -121,6 +121,28 @@ class GDScriptCompiler {
 			return pos;
 		}
 
+		Vector<Variant::ValidatedOperatorEvaluator> operator_funcs;
+		Vector<Variant::ValidatedGetter> getter_funcs;
+		Vector<Variant::ValidatedSetter> setter_funcs;
+		Vector<Variant::ValidatedIndexedGetter> indexed_getter_funcs;
+		Vector<Variant::ValidatedIndexedSetter> indexed_setter_funcs;
+
+		template <class T>
+		static int _get_func_pos(Vector<T> &p_funcs, T p_func) {
+			int pos = p_funcs.find(p_func);
+			if (pos < 0) {
+				pos = p_funcs.size();
+				p_funcs.push_back(p_func);
+			}
+			return pos;
+		}
+
+		int get_operator_func_pos(Variant::ValidatedOperatorEvaluator p_func) { return _get_func_pos(operator_funcs, p_func); }
+		int get_getter_func_pos(Variant::ValidatedGetter p_func) { return _get_func_pos(getter_funcs, p_func); }
+		int get_setter_func_pos(Variant::ValidatedSetter p_func) { return _get_func_pos(setter_funcs, p_func); }
+		int get_indexed_getter_func_pos(Variant::ValidatedIndexedGetter p_func) { return _get_func_pos(indexed_getter_funcs, p_func); }
+		int get_indexed_setter_func_pos(Variant::ValidatedIndexedSetter p_func) { return _get_func_pos(indexed_setter_funcs, p_func); }
+
 		Vector<int> opcodes;
 		void alloc_stack(int p_level) {
 			if (p_level >= stack_max) stack_max = p_level + 1;
@@ -143,6 +165,9 @@ class GDScriptCompiler {
 	bool _create_binary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level, bool p_initializer = false, int p_index_addr = 0);
 
 	GDScriptDataType _gdtype_from_datatype(const GDScriptParser::DataType &p_datatype) const;
+	Variant::Type _get_builtin_type_hint(const GDScriptParser::Node *p_node) const;
+	bool _get_constant_value(CodeGen &codegen, const GDScriptParser::Node *p_node, Variant &r_value);
+	void _emit_validated_operator(CodeGen &codegen, Variant::Operator op, const GDScriptParser::Node *p_a, const GDScriptParser::Node *p_b);
 
 	int _parse_assign_right_expression(CodeGen &codegen, const GDScriptParser::OperatorNode *p_expression, int p_stack_level, int p_index_addr = 0);
 	int _parse_expression(CodeGen &codegen, const GDScriptParser::Node *p_expression, int p_stack_level, bool p_root = false, bool p_initializer = false, int p_index_addr = 0);
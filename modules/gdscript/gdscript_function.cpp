@@ -33,6 +33,7 @@
 #include "core/os/os.h"
 #include "gdscript.h"
 #include "gdscript_functions.h"
+#include "gdscript_yield_scheduler.h"
 
 Variant *GDScriptFunction::_get_variant(int p_address, GDScriptInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const {
 
@@ -193,6 +194,11 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 #define OPCODES_TABLE                         \
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR,                    \
+		&&OPCODE_OPERATOR_VALIDATED,          \
+		&&OPCODE_GET_VALIDATED,               \
+		&&OPCODE_GET_NAMED_VALIDATED,         \
+		&&OPCODE_SET_NAMED_VALIDATED,         \
+		&&OPCODE_SET_VALIDATED,               \
 		&&OPCODE_EXTENDS_TEST,                \
 		&&OPCODE_IS_BUILTIN,                  \
 		&&OPCODE_SET,                         \
@@ -287,11 +293,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (yielded)
-		stack = (Variant *)p_state->stack.ptr();
-		call_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		call_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script.ptr();
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -387,6 +393,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	String err_text;
 
+	bool sampled = GDScriptLanguage::get_singleton()->is_sampling() && GDScriptLanguage::get_singleton()->sample_enter_function(this, &line);
+
 #ifdef DEBUG_ENABLED
 
 	if (ScriptDebugger::get_singleton())
@@ -479,6 +487,28 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED) {
+
+				//prefix of a regular OPCODE_OPERATOR, skipped into when the operand types don't match the hints
+				CHECK_SPACE(8);
+
+				int types = _code_ptr[ip + 1];
+				int func = _code_ptr[ip + 2];
+				GD_ERR_BREAK(func < 0 || func >= _operator_funcs_count);
+
+				GET_VARIANT_PTR(a, 5);
+				GET_VARIANT_PTR(b, 6);
+
+				if (likely(a->get_type() == (types & 0xFF) && b->get_type() == (types >> 8))) {
+					GET_VARIANT_PTR(dst, 7);
+					_operator_funcs_ptr[func](a, b, dst);
+					ip += 8;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_EXTENDS_TEST) {
 
 				CHECK_SPACE(4);
@@ -637,7 +667,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				const StringName *index = &_global_names_ptr[indexname];
 
 				bool valid;
-				dst->set_named(*index, *value, &valid);
+				dst->set_named(*index, *value, &valid, &_property_caches[indexname]);
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -665,10 +695,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, &valid);
+				Variant ret = src->get_named(*index, &valid, &_property_caches[indexname]);
 
 #else
-				*dst = src->get_named(*index, &valid);
+				*dst = src->get_named(*index, &valid, &_property_caches[indexname]);
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -685,6 +715,93 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_VALIDATED) {
+
+				//prefix of a regular OPCODE_GET, falls through to it on type mismatch or out of bounds index
+				CHECK_SPACE(7);
+
+				int types = _code_ptr[ip + 1];
+				int func = _code_ptr[ip + 2];
+				GD_ERR_BREAK(func < 0 || func >= _indexed_getter_funcs_count);
+
+				GET_VARIANT_PTR(src, 4);
+				GET_VARIANT_PTR(index, 5);
+
+				if (likely(src->get_type() == (types & 0xFF) && index->get_type() == (types >> 8))) {
+					GET_VARIANT_PTR(dst, 6);
+					if (likely(_indexed_getter_funcs_ptr[func](src, index, dst))) {
+						ip += 7;
+						DISPATCH_OPCODE;
+					}
+				}
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_NAMED_VALIDATED) {
+
+				//prefix of a regular OPCODE_GET_NAMED
+				CHECK_SPACE(7);
+
+				int func = _code_ptr[ip + 2];
+				GD_ERR_BREAK(func < 0 || func >= _getter_funcs_count);
+
+				GET_VARIANT_PTR(src, 4);
+
+				if (likely(src->get_type() == _code_ptr[ip + 1])) {
+					GET_VARIANT_PTR(dst, 6);
+					_getter_funcs_ptr[func](src, dst);
+					ip += 7;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_SET_NAMED_VALIDATED) {
+
+				//prefix of a regular OPCODE_SET_NAMED
+				CHECK_SPACE(7);
+
+				int types = _code_ptr[ip + 1];
+				int func = _code_ptr[ip + 2];
+				GD_ERR_BREAK(func < 0 || func >= _setter_funcs_count);
+
+				GET_VARIANT_PTR(dst, 4);
+				GET_VARIANT_PTR(value, 6);
+
+				if (likely(dst->get_type() == (types & 0xFF) && value->get_type() == (types >> 8))) {
+					_setter_funcs_ptr[func](dst, value);
+					ip += 7;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_SET_VALIDATED) {
+
+				//prefix of a regular OPCODE_SET, falls through to it on type mismatch or out of bounds index
+				CHECK_SPACE(7);
+
+				int types = _code_ptr[ip + 1];
+				int func = _code_ptr[ip + 2];
+				GD_ERR_BREAK(func < 0 || func >= _indexed_setter_funcs_count);
+
+				GET_VARIANT_PTR(dst, 4);
+				GET_VARIANT_PTR(index, 5);
+				GET_VARIANT_PTR(value, 6);
+
+				if (likely(dst->get_type() == (types & 0xFF) && index->get_type() == ((types >> 8) & 0xFF) && value->get_type() == (types >> 16))) {
+					if (likely(_indexed_setter_funcs_ptr[func](dst, index, value))) {
+						ip += 7;
+						DISPATCH_OPCODE;
+					}
+				}
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_MEMBER) {
 
 				CHECK_SPACE(3);
@@ -695,9 +812,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				bool valid;
 #ifndef DEBUG_ENABLED
-				ClassDB::set_property(p_instance->owner, *index, *src, &valid);
+				ClassDB::set_property_cached(_property_caches[indexname], p_instance->owner, *index, *src, &valid);
 #else
-				bool ok = ClassDB::set_property(p_instance->owner, *index, *src, &valid);
+				bool ok = ClassDB::set_property_cached(_property_caches[indexname], p_instance->owner, *index, *src, &valid);
 				if (!ok) {
 					err_text = "Internal error setting property: " + String(*index);
 					OPCODE_BREAK;
@@ -719,9 +836,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(dst, 2);
 
 #ifndef DEBUG_ENABLED
-				ClassDB::get_property(p_instance->owner, *index, *dst);
+				ClassDB::get_property_cached(_property_caches[indexname], p_instance->owner, *index, *dst);
 #else
-				bool ok = ClassDB::get_property(p_instance->owner, *index, *dst);
+				bool ok = ClassDB::get_property_cached(_property_caches[indexname], p_instance->owner, *index, *dst);
 				if (!ok) {
 					err_text = "Internal error getting property: " + String(*index);
 					OPCODE_BREAK;
@@ -1082,10 +1199,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (call_ret) {
 
 					GET_VARIANT_PTR(ret, argc);
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
+					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err, &_method_caches[nameg]);
 				} else {
 
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, NULL, err);
+					base->call_ptr(*methodname, (const Variant **)argptrs, argc, NULL, err, &_method_caches[nameg]);
 				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
@@ -1252,21 +1369,30 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_YIELD)
 			OPCODE(OPCODE_YIELD_SIGNAL) {
 
-				int ipofs = 1;
+				int ipofs = 2;
+				int live;
 				if (_code_ptr[ip] == OPCODE_YIELD_SIGNAL) {
-					CHECK_SPACE(4);
+					CHECK_SPACE(5);
 					ipofs += 2;
+					live = _code_ptr[ip + 3];
 				} else {
-					CHECK_SPACE(2);
+					CHECK_SPACE(3);
+					live = _code_ptr[ip + 1];
 				}
 
+				GD_ERR_BREAK(live < 0 || live > _stack_size);
+
 				Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 				gdfs->function = this;
 
-				gdfs->state.stack.resize(alloca_size);
-				//copy variant stack
-				for (int i = 0; i < _stack_size; i++) {
-					memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+				gdfs->state.stack = GDScriptYieldScheduler::alloc_stack(alloca_size);
+				//copy variant stack, only the slots below the yield's stack level are live
+				Variant *state_stack = (Variant *)gdfs->state.stack;
+				for (int i = 0; i < live; i++) {
+					memnew_placement(&state_stack[i], Variant(stack[i]));
+				}
+				for (int i = live; i < _stack_size; i++) {
+					memnew_placement(&state_stack[i], Variant);
 				}
 				gdfs->state.stack_size = _stack_size;
 				gdfs->state.self = self;
@@ -1318,14 +1444,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						OPCODE_BREAK;
 					}
 
-					Error err = obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
-					if (err != OK) {
-						err_text = "Error connecting to signal: " + signal + " during yield().";
-						OPCODE_BREAK;
-					}
+#endif
+
+					//scene tree timers and frames are resumed by the scheduler, everything else connects
+					if (!GDScriptYieldScheduler::schedule(obj, signal, gdfs)) {
+#ifdef DEBUG_ENABLED
+						Error err = obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
+						if (err != OK) {
+							err_text = "Error connecting to signal: " + signal + " during yield().";
+							OPCODE_BREAK;
+						}
 #else
-					obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
+						obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
 #endif
+					}
 				}
 
 #ifdef DEBUG_ENABLED
@@ -1519,6 +1651,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+				GDScriptLanguage::get_singleton()->sample_line();
+
 				if (ScriptDebugger::get_singleton()) {
 					// line
 					bool do_break = false;
@@ -1590,6 +1724,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 
 	OPCODES_OUT
+
+	if (sampled)
+		GDScriptLanguage::get_singleton()->sample_exit_function();
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
@@ -1747,6 +1885,18 @@ GDScriptFunction::GDScriptFunction() :
 
 	_stack_size = 0;
 	_call_size = 0;
+	_method_caches = NULL;
+	_property_caches = NULL;
+	_operator_funcs_ptr = NULL;
+	_operator_funcs_count = 0;
+	_getter_funcs_ptr = NULL;
+	_getter_funcs_count = 0;
+	_setter_funcs_ptr = NULL;
+	_setter_funcs_count = 0;
+	_indexed_getter_funcs_ptr = NULL;
+	_indexed_getter_funcs_count = 0;
+	_indexed_setter_funcs_ptr = NULL;
+	_indexed_setter_funcs_count = 0;
 	rpc_mode = MultiplayerAPI::RPC_MODE_DISABLED;
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -1775,6 +1925,14 @@ GDScriptFunction::GDScriptFunction() :
 }
 
 GDScriptFunction::~GDScriptFunction() {
+
+	if (_method_caches) {
+		memdelete_arr(_method_caches);
+	}
+	if (_property_caches) {
+		memdelete_arr(_property_caches);
+	}
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->lock) {
 		GDScriptLanguage::get_singleton()->lock->lock();
@@ -1878,13 +2036,17 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 			GDScriptLanguage::get_singleton()->exit_function();
 		if (state.stack_size) {
 			//free stack
-			Variant *stack = (Variant *)state.stack.ptr();
+			Variant *stack = (Variant *)state.stack;
 			for (int i = 0; i < state.stack_size; i++)
 				stack[i].~Variant();
 		}
 #endif
 	}
 
+	//the variants were destructed by the call, or just above
+	GDScriptYieldScheduler::free_stack(state.stack, state.alloca_size);
+	state.stack = NULL;
+
 	return ret;
 }
 
@@ -1900,6 +2062,9 @@ void GDScriptFunctionState::_bind_methods() {
 GDScriptFunctionState::GDScriptFunctionState() {
 
 	function = NULL;
+	state.stack = NULL;
+	state.stack_size = 0;
+	state.alloca_size = 0;
 }
 
 GDScriptFunctionState::~GDScriptFunctionState() {
@@ -1911,4 +2076,6 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 			v->~Variant();
 		}
 	}
+
+	GDScriptYieldScheduler::free_stack(state.stack, state.alloca_size);
 }
@@ -156,6 +156,11 @@ class GDScriptFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
+		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_GET_VALIDATED,
+		OPCODE_GET_NAMED_VALIDATED,
+		OPCODE_SET_NAMED_VALIDATED,
+		OPCODE_SET_VALIDATED,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_IS_BUILTIN,
 		OPCODE_SET,
@@ -223,6 +228,7 @@ public:
 
 private:
 	friend class GDScriptCompiler;
+	friend class GDScriptBytecode;
 
 	StringName source;
 
@@ -231,6 +237,18 @@ private:
 	int _constant_count;
 	const StringName *_global_names_ptr;
 	int _global_names_count;
+	MethodCallCache *_method_caches; //one per global name, used by OPCODE_CALL
+	MethodCallCache *_property_caches; //one per global name, used by the named and member get/set opcodes
+	const Variant::ValidatedOperatorEvaluator *_operator_funcs_ptr;
+	int _operator_funcs_count;
+	const Variant::ValidatedGetter *_getter_funcs_ptr;
+	int _getter_funcs_count;
+	const Variant::ValidatedSetter *_setter_funcs_ptr;
+	int _setter_funcs_count;
+	const Variant::ValidatedIndexedGetter *_indexed_getter_funcs_ptr;
+	int _indexed_getter_funcs_count;
+	const Variant::ValidatedIndexedSetter *_indexed_setter_funcs_ptr;
+	int _indexed_setter_funcs_count;
 #ifdef TOOLS_ENABLED
 	const StringName *_named_globals_ptr;
 	int _named_globals_count;
@@ -251,6 +269,12 @@ private:
 	StringName name;
 	Vector<Variant> constants;
 	Vector<StringName> global_names;
+	//type-specialized helpers used by the *_VALIDATED opcodes, resolved at compile time
+	Vector<Variant::ValidatedOperatorEvaluator> operator_funcs;
+	Vector<Variant::ValidatedGetter> getter_funcs;
+	Vector<Variant::ValidatedSetter> setter_funcs;
+	Vector<Variant::ValidatedIndexedGetter> indexed_getter_funcs;
+	Vector<Variant::ValidatedIndexedSetter> indexed_setter_funcs;
 #ifdef TOOLS_ENABLED
 	Vector<StringName> named_globals;
 #endif
@@ -295,7 +319,7 @@ public:
 
 		ObjectID instance_id;
 		GDScriptInstance *instance;
-		Vector<uint8_t> stack;
+		uint8_t *stack; //alloca_size bytes, pooled by GDScriptYieldScheduler
 		int stack_size;
 		Variant self;
 		uint32_t alloca_size;
@@ -40,10 +40,52 @@
 #include "core/script_language.h"
 #include "gdscript.h"
 
+void *GDScriptParser::_arena_alloc(size_t p_size) {
+
+	const size_t header = (sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~size_t(ARENA_ALIGN - 1);
+	p_size = (p_size + ARENA_ALIGN - 1) & ~size_t(ARENA_ALIGN - 1);
+
+	if (p_size > ARENA_BLOCK_SIZE / 4) {
+		//large node, give it its own block behind the current one so the remaining space is not wasted
+		ArenaBlock *block = (ArenaBlock *)memalloc(header + p_size);
+		block->size = p_size;
+		block->used = p_size;
+		if (arena) {
+			block->prev = arena->prev;
+			arena->prev = block;
+		} else {
+			block->prev = NULL;
+			arena = block;
+		}
+		return (uint8_t *)block + header;
+	}
+
+	if (!arena || arena->used + p_size > arena->size) {
+		ArenaBlock *block = (ArenaBlock *)memalloc(header + ARENA_BLOCK_SIZE);
+		block->size = ARENA_BLOCK_SIZE;
+		block->used = 0;
+		block->prev = arena;
+		arena = block;
+	}
+
+	void *ptr = (uint8_t *)arena + header + arena->used;
+	arena->used += p_size;
+	return ptr;
+}
+
+void GDScriptParser::_arena_clear() {
+
+	while (arena) {
+		ArenaBlock *prev = arena->prev;
+		memfree(arena);
+		arena = prev;
+	}
+}
+
 template <class T>
 T *GDScriptParser::alloc_node() {
 
-	T *t = memnew(T);
+	T *t = memnew_placement(_arena_alloc(sizeof(T)), T);
 
 	t->next = list;
 	list = t;
@@ -5600,6 +5642,28 @@ bool GDScriptParser::_parse_type(DataType &r_type, bool p_can_be_void) {
 		tokenizer->advance();
 	}
 
+	if (r_type.kind == DataType::BUILTIN && r_type.builtin_type == Variant::ARRAY && tokenizer->get_token() == GDScriptTokenizer::TK_BRACKET_OPEN && tokenizer->get_token(1) == GDScriptTokenizer::TK_BUILT_IN_TYPE) {
+		//typed arrays, stored unboxed in the pool array of their element type
+		switch (tokenizer->get_token_type(1)) {
+			case Variant::INT: r_type.builtin_type = Variant::POOL_INT_ARRAY; break;
+			case Variant::REAL: r_type.builtin_type = Variant::POOL_REAL_ARRAY; break;
+			case Variant::STRING: r_type.builtin_type = Variant::POOL_STRING_ARRAY; break;
+			case Variant::VECTOR2: r_type.builtin_type = Variant::POOL_VECTOR2_ARRAY; break;
+			case Variant::VECTOR3: r_type.builtin_type = Variant::POOL_VECTOR3_ARRAY; break;
+			case Variant::COLOR: r_type.builtin_type = Variant::POOL_COLOR_ARRAY; break;
+			default: {
+				_set_error("Typed arrays only support int, float, String, Vector2, Vector3 and Color elements.");
+				return false;
+			}
+		}
+		tokenizer->advance(2);
+		if (tokenizer->get_token() != GDScriptTokenizer::TK_BRACKET_CLOSE) {
+			_set_error("Expected \"]\" after the array element type.");
+			return false;
+		}
+		tokenizer->advance();
+	}
+
 	if (can_index) {
 		while (!finished) {
 			switch (tokenizer->get_token()) {
@@ -8611,9 +8675,10 @@ void GDScriptParser::clear() {
 
 		Node *l = list;
 		list = list->next;
-		memdelete(l);
+		l->~Node();
 	}
 
+	_arena_clear();
 	head = NULL;
 	list = NULL;
 
@@ -8703,6 +8768,7 @@ GDScriptParser::GDScriptParser() {
 
 	head = NULL;
 	list = NULL;
+	arena = NULL;
 	tokenizer = NULL;
 	pending_newline = -1;
 	clear();
@@ -529,6 +529,23 @@ private:
 
 	Node *head;
 	Node *list;
+
+	//nodes are bump allocated from chunks and released all at once in clear()
+	enum {
+		ARENA_BLOCK_SIZE = 65536,
+		ARENA_ALIGN = 16,
+	};
+
+	struct ArenaBlock {
+		ArenaBlock *prev;
+		size_t size;
+		size_t used;
+	};
+
+	ArenaBlock *arena;
+	void *_arena_alloc(size_t p_size);
+	void _arena_clear();
+
 	template <class T>
 	T *alloc_node();
 
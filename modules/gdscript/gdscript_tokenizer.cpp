@@ -235,6 +235,105 @@ static const _kws _keyword_list[] = {
 	{ GDScriptTokenizer::TK_ERROR, NULL }
 };
 
+//all reserved words (constants, types, built-in functions and keywords) live in a small
+//open addressing table keyed by the same hash the tokenizer computes while scanning
+struct _ReservedWord {
+
+	enum Kind {
+		KIND_CONSTANT,
+		KIND_TYPE,
+		KIND_BUILT_IN_FUNC,
+		KIND_KEYWORD,
+	};
+
+	const char *text;
+	int length;
+	uint32_t hash;
+	Kind kind;
+	int value;
+};
+
+enum {
+	RESERVED_WORD_TABLE_SIZE = 512 // power of two, well above the amount of reserved words
+};
+
+static _ReservedWord _reserved_words[RESERVED_WORD_TABLE_SIZE];
+static bool _reserved_words_initialized = false;
+
+static bool _reserved_word_matches(const _ReservedWord &p_word, const CharType *p_str, int p_len, uint32_t p_hash) {
+
+	if (p_word.hash != p_hash || p_word.length != p_len) {
+		return false;
+	}
+	for (int i = 0; i < p_len; i++) {
+		if (CharType(p_word.text[i]) != p_str[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static const _ReservedWord *_find_reserved_word(const CharType *p_str, int p_len, uint32_t p_hash) {
+
+	uint32_t pos = p_hash & (RESERVED_WORD_TABLE_SIZE - 1);
+	while (_reserved_words[pos].text) {
+		if (_reserved_word_matches(_reserved_words[pos], p_str, p_len, p_hash)) {
+			return &_reserved_words[pos];
+		}
+		pos = (pos + 1) & (RESERVED_WORD_TABLE_SIZE - 1);
+	}
+	return NULL;
+}
+
+static void _add_reserved_word(const char *p_text, _ReservedWord::Kind p_kind, int p_value) {
+
+	int len = strlen(p_text);
+	uint32_t hash = 5381;
+	for (int i = 0; i < len; i++) {
+		hash = ((hash << 5) + hash) ^ uint32_t(p_text[i]);
+	}
+
+	uint32_t pos = hash & (RESERVED_WORD_TABLE_SIZE - 1);
+	while (_reserved_words[pos].text) {
+		if (_reserved_words[pos].hash == hash && _reserved_words[pos].length == len && strcmp(_reserved_words[pos].text, p_text) == 0) {
+			return; //first registration wins, same precedence as the old lookup order
+		}
+		pos = (pos + 1) & (RESERVED_WORD_TABLE_SIZE - 1);
+	}
+
+	_ReservedWord &word = _reserved_words[pos];
+	word.text = p_text;
+	word.length = len;
+	word.hash = hash;
+	word.kind = p_kind;
+	word.value = p_value;
+}
+
+void GDScriptTokenizer::initialize_reserved_words() {
+
+	if (_reserved_words_initialized) {
+		return;
+	}
+
+	_add_reserved_word("null", _ReservedWord::KIND_CONSTANT, 0);
+	_add_reserved_word("true", _ReservedWord::KIND_CONSTANT, 1);
+	_add_reserved_word("false", _ReservedWord::KIND_CONSTANT, 2);
+
+	for (int i = 0; _type_list[i].text; i++) {
+		_add_reserved_word(_type_list[i].text, _ReservedWord::KIND_TYPE, _type_list[i].type);
+	}
+
+	for (int i = 0; i < GDScriptFunctions::FUNC_MAX; i++) {
+		_add_reserved_word(GDScriptFunctions::get_func_name(GDScriptFunctions::Function(i)), _ReservedWord::KIND_BUILT_IN_FUNC, i);
+	}
+
+	for (int i = 0; _keyword_list[i].text; i++) {
+		_add_reserved_word(_keyword_list[i].text, _ReservedWord::KIND_KEYWORD, _keyword_list[i].token);
+	}
+
+	_reserved_words_initialized = true;
+}
+
 const char *GDScriptTokenizer::get_token_name(Token p_token) {
 
 	ERR_FAIL_INDEX_V(p_token, TK_MAX, "<error>");
@@ -972,85 +1071,40 @@ void GDScriptTokenizerText::_advance() {
 				}
 
 				if (_is_text_char(GETCHAR(0))) {
-					// parse identifier
-					String str;
-					str += CharType(GETCHAR(0));
-
-					int i = 1;
+					// parse identifier, hashing it on the way so reserved words are found without building a string
+					const CharType *str = &_code[code_pos];
+					uint32_t hash = 5381;
+					int i = 0;
 					while (_is_text_char(GETCHAR(i))) {
-						str += CharType(GETCHAR(i));
+						hash = ((hash << 5) + hash) ^ uint32_t(GETCHAR(i));
 						i++;
 					}
 
-					bool identifier = false;
-
-					if (str == "null") {
-						_make_constant(Variant());
-
-					} else if (str == "true") {
-						_make_constant(true);
+					const _ReservedWord *word = _find_reserved_word(str, i, hash);
 
-					} else if (str == "false") {
-						_make_constant(false);
+					if (!word) {
+						_make_identifier(String(str, i));
 					} else {
-
-						bool found = false;
-
-						{
-
-							int idx = 0;
-
-							while (_type_list[idx].text) {
-
-								if (str == _type_list[idx].text) {
-									_make_type(_type_list[idx].type);
-									found = true;
-									break;
-								}
-								idx++;
-							}
-						}
-
-						if (!found) {
-
-							//built in func?
-
-							for (int j = 0; j < GDScriptFunctions::FUNC_MAX; j++) {
-
-								if (str == GDScriptFunctions::get_func_name(GDScriptFunctions::Function(j))) {
-
-									_make_built_in_func(GDScriptFunctions::Function(j));
-									found = true;
-									break;
-								}
-							}
-						}
-
-						if (!found) {
-							//keyword
-
-							int idx = 0;
-							found = false;
-
-							while (_keyword_list[idx].text) {
-
-								if (str == _keyword_list[idx].text) {
-									_make_token(_keyword_list[idx].token);
-									found = true;
-									break;
+						switch (word->kind) {
+							case _ReservedWord::KIND_CONSTANT: {
+								if (word->value == 0) {
+									_make_constant(Variant());
+								} else {
+									_make_constant(word->value == 1);
 								}
-								idx++;
-							}
+							} break;
+							case _ReservedWord::KIND_TYPE: {
+								_make_type(Variant::Type(word->value));
+							} break;
+							case _ReservedWord::KIND_BUILT_IN_FUNC: {
+								_make_built_in_func(GDScriptFunctions::Function(word->value));
+							} break;
+							case _ReservedWord::KIND_KEYWORD: {
+								_make_token(Token(word->value));
+							} break;
 						}
-
-						if (!found)
-							identifier = true;
 					}
-
-					if (identifier) {
-						_make_identifier(str);
-					}
-					INCPOS(str.length());
+					INCPOS(i);
 					return;
 				}
 
@@ -1067,6 +1121,8 @@ void GDScriptTokenizerText::_advance() {
 
 void GDScriptTokenizerText::set_code(const String &p_code) {
 
+	initialize_reserved_words();
+
 	code = p_code;
 	len = p_code.length();
 	if (len) {
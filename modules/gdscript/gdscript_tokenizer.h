@@ -156,6 +156,7 @@ protected:
 
 public:
 	static const char *get_token_name(Token p_token);
+	static void initialize_reserved_words();
 
 	bool is_token_literal(int p_offset = 0, bool variable_safe = false) const;
 	StringName get_token_literal(int p_offset = 0) const;
@@ -0,0 +1,265 @@
+/*************************************************************************/
+/*  gdscript_yield_scheduler.cpp                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_yield_scheduler.h"
+
+GDScriptYieldScheduler *GDScriptYieldScheduler::singleton = NULL;
+
+uint8_t *GDScriptYieldScheduler::alloc_stack(uint32_t p_size) {
+
+	uint32_t size = next_power_of_2(MAX(p_size, (uint32_t)sizeof(FreeStack)));
+	int bucket = get_shift_from_power_of_2(size);
+
+	if (bucket >= STACK_POOL_BUCKETS) {
+		return (uint8_t *)memalloc(p_size);
+	}
+
+	if (singleton) {
+		MutexLock lock(singleton->mutex);
+		FreeStack *fs = singleton->free_stacks[bucket];
+		if (fs) {
+			singleton->free_stacks[bucket] = fs->next;
+			singleton->free_stack_count[bucket]--;
+			return (uint8_t *)fs;
+		}
+	}
+
+	//always allocate the full bucket size, so the block can be pooled when freed
+	return (uint8_t *)memalloc(size);
+}
+
+void GDScriptYieldScheduler::free_stack(uint8_t *p_stack, uint32_t p_size) {
+
+	if (!p_stack) {
+		return;
+	}
+
+	uint32_t size = next_power_of_2(MAX(p_size, (uint32_t)sizeof(FreeStack)));
+	int bucket = get_shift_from_power_of_2(size);
+
+	if (singleton && bucket < STACK_POOL_BUCKETS) {
+		MutexLock lock(singleton->mutex);
+		if (singleton->free_stack_count[bucket] < STACK_POOL_MAX_FREE) {
+			FreeStack *fs = (FreeStack *)p_stack;
+			fs->next = singleton->free_stacks[bucket];
+			singleton->free_stacks[bucket] = fs;
+			singleton->free_stack_count[bucket]++;
+			return;
+		}
+	}
+
+	memfree(p_stack);
+}
+
+bool GDScriptYieldScheduler::_connect_tree(SceneTree *p_tree) {
+
+	if (connected_tree_id == p_tree->get_instance_id()) {
+		return true;
+	}
+
+	//one persistent connection per signal, instead of a oneshot connection per yield
+	if (p_tree->connect(idle_frame_name, this, "_idle_frame") != OK) {
+		return false;
+	}
+	if (p_tree->connect(physics_frame_name, this, "_physics_frame") != OK) {
+		p_tree->disconnect(idle_frame_name, this, "_idle_frame");
+		return false;
+	}
+
+	connected_tree_id = p_tree->get_instance_id();
+	return true;
+}
+
+bool GDScriptYieldScheduler::schedule(Object *p_object, const StringName &p_signal, const Ref<GDScriptFunctionState> &p_state) {
+
+	if (!singleton) {
+		return false;
+	}
+
+	if (p_signal == singleton->timeout_name) {
+
+		Ref<SceneTreeTimer> timer = Object::cast_to<SceneTreeTimer>(p_object);
+		//timers that already fired are left to the regular connection, which never resumes either
+		if (timer.is_null() || timer->get_time_left() < 0) {
+			return false;
+		}
+
+		TimerWait wait;
+		wait.timer = timer;
+		wait.state = p_state;
+
+		MutexLock lock(singleton->mutex);
+		singleton->timer_waits.push_back(wait);
+		return true;
+	}
+
+	SceneTree *tree = SceneTree::get_singleton();
+	if (!tree || p_object != tree) {
+		return false;
+	}
+
+	if (p_signal == singleton->idle_frame_name) {
+
+		MutexLock lock(singleton->mutex);
+		if (!singleton->_connect_tree(tree)) {
+			return false;
+		}
+		singleton->idle_frame_waits.push_back(p_state);
+		return true;
+	}
+
+	if (p_signal == singleton->physics_frame_name) {
+
+		MutexLock lock(singleton->mutex);
+		if (!singleton->_connect_tree(tree)) {
+			return false;
+		}
+		singleton->physics_frame_waits.push_back(p_state);
+		return true;
+	}
+
+	return false;
+}
+
+void GDScriptYieldScheduler::_resume_all(Vector<Ref<GDScriptFunctionState> > &p_waits) {
+
+	Vector<Ref<GDScriptFunctionState> > waits;
+	{
+		//functions that yield again while resuming wait for the next emission
+		MutexLock lock(mutex);
+		if (p_waits.empty()) {
+			return;
+		}
+		waits = p_waits;
+		p_waits.clear();
+	}
+
+	for (int i = 0; i < waits.size(); i++) {
+		waits.write[i]->resume();
+	}
+}
+
+void GDScriptYieldScheduler::_idle_frame() {
+
+	_resume_all(idle_frame_waits);
+}
+
+void GDScriptYieldScheduler::_physics_frame() {
+
+	_resume_all(physics_frame_waits);
+}
+
+void GDScriptYieldScheduler::_resume_timers() {
+
+	Vector<Ref<GDScriptFunctionState> > fired;
+	{
+		MutexLock lock(mutex);
+		if (timer_waits.empty()) {
+			return;
+		}
+
+		int to = 0;
+		for (int i = 0; i < timer_waits.size(); i++) {
+			const TimerWait &wait = timer_waits[i];
+			if (wait.timer->get_time_left() < 0) {
+				fired.push_back(wait.state);
+			} else {
+				if (to != i) {
+					timer_waits.write[to] = wait;
+				}
+				to++;
+			}
+		}
+		timer_waits.resize(to);
+	}
+
+	for (int i = 0; i < fired.size(); i++) {
+		fired.write[i]->resume();
+	}
+}
+
+void GDScriptYieldScheduler::_idle_callback() {
+
+	//runs after the scene tree processed its timers
+	if (singleton) {
+		singleton->_resume_timers();
+	}
+}
+
+void GDScriptYieldScheduler::clear() {
+
+	MutexLock lock(mutex);
+
+	timer_waits.clear();
+	idle_frame_waits.clear();
+	physics_frame_waits.clear();
+}
+
+void GDScriptYieldScheduler::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("_idle_frame"), &GDScriptYieldScheduler::_idle_frame);
+	ClassDB::bind_method(D_METHOD("_physics_frame"), &GDScriptYieldScheduler::_physics_frame);
+}
+
+GDScriptYieldScheduler::GDScriptYieldScheduler() {
+
+	singleton = this;
+	mutex = Mutex::create();
+	connected_tree_id = 0;
+
+	for (int i = 0; i < STACK_POOL_BUCKETS; i++) {
+		free_stacks[i] = NULL;
+		free_stack_count[i] = 0;
+	}
+
+	timeout_name = "timeout";
+	idle_frame_name = "idle_frame";
+	physics_frame_name = "physics_frame";
+
+	SceneTree::add_idle_callback(&GDScriptYieldScheduler::_idle_callback);
+}
+
+GDScriptYieldScheduler::~GDScriptYieldScheduler() {
+
+	clear();
+
+	singleton = NULL;
+
+	for (int i = 0; i < STACK_POOL_BUCKETS; i++) {
+		FreeStack *fs = free_stacks[i];
+		while (fs) {
+			FreeStack *next = fs->next;
+			memfree(fs);
+			fs = next;
+		}
+	}
+
+	memdelete(mutex);
+}
@@ -0,0 +1,100 @@
+/*************************************************************************/
+/*  gdscript_yield_scheduler.h                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_YIELD_SCHEDULER_H
+#define GDSCRIPT_YIELD_SCHEDULER_H
+
+#include "core/os/mutex.h"
+#include "gdscript_function.h"
+#include "scene/main/scene_tree.h"
+
+// Resumes functions that yield on scene tree timers or frame signals without
+// connecting a signal per yield, and pools the stack buffers of yielded functions.
+class GDScriptYieldScheduler : public Object {
+
+	GDCLASS(GDScriptYieldScheduler, Object);
+
+	enum {
+		STACK_POOL_BUCKETS = 17, //power of two sizes, up to 64KiB
+		STACK_POOL_MAX_FREE = 64 //per bucket, the rest go back to the allocator
+	};
+
+	struct FreeStack {
+		FreeStack *next;
+	};
+
+	struct TimerWait {
+		Ref<SceneTreeTimer> timer;
+		Ref<GDScriptFunctionState> state;
+	};
+
+	static GDScriptYieldScheduler *singleton;
+
+	Mutex *mutex;
+	FreeStack *free_stacks[STACK_POOL_BUCKETS];
+	int free_stack_count[STACK_POOL_BUCKETS];
+
+	Vector<TimerWait> timer_waits;
+	Vector<Ref<GDScriptFunctionState> > idle_frame_waits;
+	Vector<Ref<GDScriptFunctionState> > physics_frame_waits;
+	ObjectID connected_tree_id;
+
+	StringName timeout_name;
+	StringName idle_frame_name;
+	StringName physics_frame_name;
+
+	bool _connect_tree(SceneTree *p_tree);
+	void _resume_all(Vector<Ref<GDScriptFunctionState> > &p_waits);
+	void _idle_frame();
+	void _physics_frame();
+	void _resume_timers();
+
+	static void _idle_callback();
+
+protected:
+	static void _bind_methods();
+
+public:
+	static GDScriptYieldScheduler *get_singleton() { return singleton; }
+
+	//stacks are raw memory, the caller constructs and destructs the variants in them
+	static uint8_t *alloc_stack(uint32_t p_size);
+	static void free_stack(uint8_t *p_stack, uint32_t p_size);
+
+	//returns false if the signal is not handled here and must be connected as usual
+	static bool schedule(Object *p_object, const StringName &p_signal, const Ref<GDScriptFunctionState> &p_state);
+
+	void clear();
+
+	GDScriptYieldScheduler();
+	~GDScriptYieldScheduler();
+};
+
+#endif // GDSCRIPT_YIELD_SCHEDULER_H
@@ -249,9 +249,7 @@ void ExtendGDScriptParser::parse_class_symbol(const GDScriptParser::ClassNode *p
 			if (res.is_valid() && !res->get_path().empty()) {
 				value_text = "preload(\"" + res->get_path() + "\")";
 				if (symbol.documentation.empty()) {
-					if (Map<String, ExtendGDScriptParser *>::Element *S = GDScriptLanguageProtocol::get_singleton()->get_workspace()->scripts.find(res->get_path())) {
-						symbol.documentation = S->get()->class_symbol.documentation;
-					}
+					symbol.documentation = GDScriptLanguageProtocol::get_singleton()->get_workspace()->get_script_documentation(res->get_path());
 				}
 			} else {
 				value_text = JSON::print(node->value);
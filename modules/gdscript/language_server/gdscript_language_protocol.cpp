@@ -97,6 +97,7 @@ void GDScriptLanguageProtocol::_bind_methods() {
 Dictionary GDScriptLanguageProtocol::initialize(const Dictionary &p_params) {
 
 	lsp::InitializeResult ret;
+	ret.capabilities.textDocumentSync.change = lsp::TextDocumentSyncKind::Incremental;
 
 	String root_uri = p_params["rootUri"];
 	String root = p_params["rootPath"];
@@ -154,6 +155,9 @@ void GDScriptLanguageProtocol::initialized(const Variant &p_params) {
 
 void GDScriptLanguageProtocol::poll() {
 	server->poll();
+	if (_initialized) {
+		workspace->process_parse_results();
+	}
 }
 
 Error GDScriptLanguageProtocol::start(int p_port, const IP_Address &p_bind_ip) {
@@ -39,6 +39,7 @@
 void GDScriptTextDocument::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("didOpen"), &GDScriptTextDocument::didOpen);
 	ClassDB::bind_method(D_METHOD("didChange"), &GDScriptTextDocument::didChange);
+	ClassDB::bind_method(D_METHOD("didClose"), &GDScriptTextDocument::didClose);
 	ClassDB::bind_method(D_METHOD("nativeSymbol"), &GDScriptTextDocument::nativeSymbol);
 	ClassDB::bind_method(D_METHOD("documentSymbol"), &GDScriptTextDocument::documentSymbol);
 	ClassDB::bind_method(D_METHOD("completion"), &GDScriptTextDocument::completion);
@@ -56,19 +57,59 @@ void GDScriptTextDocument::_bind_methods() {
 
 void GDScriptTextDocument::didOpen(const Variant &p_param) {
 	lsp::TextDocumentItem doc = load_document_item(p_param);
+	open_documents[doc.uri] = doc.text;
 	sync_script_content(doc.uri, doc.text);
 }
 
+static int _get_text_offset(const String &p_text, const lsp::Position &p_position) {
+
+	int len = p_text.length();
+	int ofs = 0;
+	for (int line = 0; line < p_position.line && ofs < len; ofs++) {
+		if (p_text[ofs] == '\n') {
+			line++;
+		}
+	}
+
+	int line_end = ofs;
+	while (line_end < len && p_text[line_end] != '\n') {
+		line_end++;
+	}
+
+	return MIN(ofs + p_position.character, line_end);
+}
+
 void GDScriptTextDocument::didChange(const Variant &p_param) {
 	lsp::TextDocumentItem doc = load_document_item(p_param);
 	Dictionary dict = p_param;
 	Array contentChanges = dict["contentChanges"];
+
+	Map<String, String>::Element *E = open_documents.find(doc.uri);
+	if (!E) {
+		// changes for a document we never saw opened apply to its content on disk
+		String path = GDScriptLanguageProtocol::get_singleton()->get_workspace()->get_file_path(doc.uri);
+		E = open_documents.insert(doc.uri, FileAccess::get_file_as_string(path));
+	}
+	String &text = E->get();
+
 	for (int i = 0; i < contentChanges.size(); ++i) {
+		Dictionary change = contentChanges[i];
 		lsp::TextDocumentContentChangeEvent evt;
-		evt.load(contentChanges[i]);
-		doc.text = evt.text;
+		evt.load(change);
+		if (change.has("range")) {
+			int from = _get_text_offset(text, evt.range.start);
+			int to = MAX(from, _get_text_offset(text, evt.range.end));
+			text = text.substr(0, from) + evt.text + text.substr(to, text.length() - to);
+		} else {
+			text = evt.text;
+		}
 	}
-	sync_script_content(doc.uri, doc.text);
+	sync_script_content(doc.uri, text);
+}
+
+void GDScriptTextDocument::didClose(const Variant &p_param) {
+	lsp::TextDocumentItem doc = load_document_item(p_param);
+	open_documents.erase(doc.uri);
 }
 
 lsp::TextDocumentItem GDScriptTextDocument::load_document_item(const Variant &p_param) {
@@ -412,7 +453,7 @@ GDScriptTextDocument::~GDScriptTextDocument() {
 
 void GDScriptTextDocument::sync_script_content(const String &p_path, const String &p_content) {
 	String path = GDScriptLanguageProtocol::get_singleton()->get_workspace()->get_file_path(p_path);
-	GDScriptLanguageProtocol::get_singleton()->get_workspace()->parse_script(path, p_content);
+	GDScriptLanguageProtocol::get_singleton()->get_workspace()->queue_parse_script(path, p_content);
 }
 
 void GDScriptTextDocument::show_native_symbol_in_editor(const String &p_symbol_id) {
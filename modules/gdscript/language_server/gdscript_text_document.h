@@ -44,12 +44,16 @@ protected:
 
 	void didOpen(const Variant &p_param);
 	void didChange(const Variant &p_param);
+	void didClose(const Variant &p_param);
 
 	void sync_script_content(const String &p_path, const String &p_content);
 	void show_native_symbol_in_editor(const String &p_symbol_id);
 
 	Array native_member_completions;
 
+	// content of the documents open in the client, kept in sync with incremental changes
+	Map<String, String> open_documents;
+
 private:
 	Array find_symbols(const lsp::TextDocumentPositionParams &p_location, List<const lsp::DocumentSymbol *> &r_list);
 	lsp::TextDocumentItem load_document_item(const Variant &p_param);
@@ -47,10 +47,11 @@ void GDScriptWorkspace::_bind_methods() {
 }
 
 void GDScriptWorkspace::remove_cache_parser(const String &p_path) {
+	MutexLock lock(parse_mutex);
 	Map<String, ExtendGDScriptParser *>::Element *parser = parse_results.find(p_path);
 	Map<String, ExtendGDScriptParser *>::Element *script = scripts.find(p_path);
 	if (parser && script) {
-		if (script->get() && script->get() == script->get()) {
+		if (script->get() && parser->get() == script->get()) {
 			memdelete(script->get());
 		} else {
 			memdelete(script->get());
@@ -109,16 +110,7 @@ void GDScriptWorkspace::reload_all_workspace_scripts() {
 		Error err;
 		String content = FileAccess::get_file_as_string(path, &err);
 		ERR_CONTINUE(err != OK);
-		err = parse_script(path, content);
-
-		if (err != OK) {
-			Map<String, ExtendGDScriptParser *>::Element *S = parse_results.find(path);
-			String err_msg = "Failed parse script " + path;
-			if (S) {
-				err_msg += "\n" + S->get()->get_error();
-			}
-			ERR_CONTINUE_MSG(err != OK, err_msg);
-		}
+		queue_parse_script(path, content);
 	}
 }
 
@@ -141,6 +133,7 @@ void GDScriptWorkspace::list_script_files(const String &p_root_dir, List<String>
 }
 
 ExtendGDScriptParser *GDScriptWorkspace::get_parse_successed_script(const String &p_path) {
+	_flush_pending_parse(p_path);
 	const Map<String, ExtendGDScriptParser *>::Element *S = scripts.find(p_path);
 	if (!S) {
 		parse_local_script(p_path);
@@ -153,6 +146,7 @@ ExtendGDScriptParser *GDScriptWorkspace::get_parse_successed_script(const String
 }
 
 ExtendGDScriptParser *GDScriptWorkspace::get_parse_result(const String &p_path) {
+	_flush_pending_parse(p_path);
 	const Map<String, ExtendGDScriptParser *>::Element *S = parse_results.find(p_path);
 	if (!S) {
 		parse_local_script(p_path);
@@ -168,9 +162,8 @@ Array GDScriptWorkspace::symbol(const Dictionary &p_params) {
 	String query = p_params["query"];
 	Array arr;
 	if (!query.empty()) {
-		for (Map<String, ExtendGDScriptParser *>::Element *E = scripts.front(); E; E = E->next()) {
-			Vector<lsp::DocumentedSymbolInformation> script_symbols;
-			E->get()->get_symbols().symbol_tree_as_list(E->key(), script_symbols);
+		for (Map<String, Vector<lsp::DocumentedSymbolInformation> >::Element *E = script_symbol_lists.front(); E; E = E->next()) {
+			const Vector<lsp::DocumentedSymbolInformation> &script_symbols = E->get();
 			for (int i = 0; i < script_symbols.size(); ++i) {
 				if (query.is_subsequence_ofi(script_symbols[i].name)) {
 					arr.push_back(script_symbols[i].to_json());
@@ -184,6 +177,11 @@ Array GDScriptWorkspace::symbol(const Dictionary &p_params) {
 Error GDScriptWorkspace::initialize() {
 	if (initialized) return OK;
 
+	if (!parse_thread) {
+		parse_thread_exit = false;
+		parse_thread = Thread::create(_parse_thread_func, this);
+	}
+
 	DocData *doc = EditorHelp::get_doc_data();
 	for (Map<String, DocData::ClassDoc>::Element *E = doc->class_list.front(); E; E = E->next()) {
 
@@ -312,27 +310,228 @@ Error GDScriptWorkspace::initialize() {
 
 Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_content) {
 
+	{
+		MutexLock lock(parse_mutex);
+		// a synchronous parse supersedes whatever is still waiting for the worker
+		Map<String, ParseRequest>::Element *E = pending_parses.find(p_path);
+		if (E) {
+			if (E->get().queued) {
+				parse_queue.erase(p_path);
+			}
+			pending_parses.erase(E);
+		}
+	}
+
 	ExtendGDScriptParser *parser = memnew(ExtendGDScriptParser);
 	Error err = parser->parse(p_content, p_path);
+	_apply_parse_result(p_path, parser, err);
+
+	return err;
+}
+
+void GDScriptWorkspace::_apply_parse_result(const String &p_path, ExtendGDScriptParser *p_parser, Error p_error) {
+
 	Map<String, ExtendGDScriptParser *>::Element *last_parser = parse_results.find(p_path);
 	Map<String, ExtendGDScriptParser *>::Element *last_script = scripts.find(p_path);
 
-	if (err == OK) {
+	if (p_error == OK) {
 
-		remove_cache_parser(p_path);
-		parse_results[p_path] = parser;
-		scripts[p_path] = parser;
+		{
+			MutexLock lock(parse_mutex);
+			remove_cache_parser(p_path);
+			parse_results[p_path] = p_parser;
+			scripts[p_path] = p_parser;
+		}
+		_update_symbol_index(p_path);
 
 	} else {
-		if (last_parser && last_script && last_parser->get() != last_script->get()) {
+		if (last_parser && (!last_script || last_parser->get() != last_script->get())) {
 			memdelete(last_parser->get());
 		}
-		parse_results[p_path] = parser;
+		parse_results[p_path] = p_parser;
 	}
 
 	publish_diagnostics(p_path);
+}
 
-	return err;
+void GDScriptWorkspace::queue_parse_script(const String &p_path, const String &p_content) {
+
+	if (!parse_thread) {
+		parse_script(p_path, p_content);
+		return;
+	}
+
+	MutexLock lock(parse_mutex);
+	ParseRequest &request = pending_parses[p_path];
+	request.content = p_content;
+	request.version = ++parse_version;
+	if (!request.queued) {
+		// edits arriving while the script waits in the queue only replace its content
+		request.queued = true;
+		parse_queue.push_back(p_path);
+		parse_semaphore->post();
+	}
+}
+
+void GDScriptWorkspace::process_parse_results() {
+
+	List<ParseResult> finished;
+	{
+		MutexLock lock(parse_mutex);
+		if (parse_finished.empty()) {
+			return;
+		}
+		finished = parse_finished;
+		parse_finished.clear();
+	}
+
+	for (List<ParseResult>::Element *E = finished.front(); E; E = E->next()) {
+		const ParseResult &result = E->get();
+
+		bool latest = false;
+		{
+			MutexLock lock(parse_mutex);
+			Map<String, ParseRequest>::Element *P = pending_parses.find(result.path);
+			if (P && P->get().version == result.version) {
+				pending_parses.erase(P);
+				latest = true;
+			}
+		}
+
+		if (latest) {
+			_apply_parse_result(result.path, result.parser, result.error);
+		} else {
+			// superseded by a newer edit or a synchronous parse
+			memdelete(result.parser);
+		}
+	}
+}
+
+void GDScriptWorkspace::_parse_thread_func(void *p_ud) {
+	static_cast<GDScriptWorkspace *>(p_ud)->_parse_thread();
+}
+
+void GDScriptWorkspace::_parse_thread() {
+
+	while (true) {
+
+		parse_semaphore->wait();
+		if (parse_thread_exit) {
+			break;
+		}
+
+		ParseResult result;
+		String content;
+		{
+			MutexLock lock(parse_mutex);
+			if (parse_queue.empty()) {
+				continue;
+			}
+			result.path = parse_queue.front()->get();
+			parse_queue.pop_front();
+
+			Map<String, ParseRequest>::Element *E = pending_parses.find(result.path);
+			if (!E) {
+				continue;
+			}
+			E->get().queued = false;
+			content = E->get().content;
+			result.version = E->get().version;
+		}
+
+		result.parser = memnew(ExtendGDScriptParser);
+		result.error = result.parser->parse(content, result.path);
+
+		MutexLock lock(parse_mutex);
+		parse_finished.push_back(result);
+	}
+}
+
+bool GDScriptWorkspace::_get_pending_content(const String &p_path, String &r_content) {
+
+	MutexLock lock(parse_mutex);
+	const Map<String, ParseRequest>::Element *E = pending_parses.find(p_path);
+	if (!E) {
+		return false;
+	}
+	r_content = E->get().content;
+	return true;
+}
+
+void GDScriptWorkspace::_flush_pending_parse(const String &p_path) {
+
+	String content;
+	if (_get_pending_content(p_path, content)) {
+		parse_script(p_path, content);
+	}
+}
+
+void GDScriptWorkspace::_update_symbol_index(const String &p_path) {
+
+	Map<String, Vector<String> >::Element *N = script_member_names.find(p_path);
+	if (N) {
+		const Vector<String> &names = N->get();
+		for (int i = 0; i < names.size(); i++) {
+			if (Set<String> *paths = member_scripts.getptr(names[i])) {
+				paths->erase(p_path);
+				if (paths->empty()) {
+					member_scripts.erase(names[i]);
+				}
+			}
+		}
+		script_member_names.erase(N);
+	}
+	script_symbol_lists.erase(p_path);
+
+	const Map<String, ExtendGDScriptParser *>::Element *S = scripts.find(p_path);
+	if (!S) {
+		return;
+	}
+	const ExtendGDScriptParser *script = S->get();
+
+	Vector<String> names;
+	const String *name = script->get_members().next(NULL);
+	while (name) {
+		names.push_back(*name);
+		name = script->get_members().next(name);
+	}
+
+	const HashMap<String, ClassMembers> &inner_classes = script->get_inner_classes();
+	const String *_class = inner_classes.next(NULL);
+	while (_class) {
+		const ClassMembers *inner_class = inner_classes.getptr(*_class);
+		const String *member_name = inner_class->next(NULL);
+		while (member_name) {
+			names.push_back(*member_name);
+			member_name = inner_class->next(member_name);
+		}
+		_class = inner_classes.next(_class);
+	}
+
+	for (int i = 0; i < names.size(); i++) {
+		if (Set<String> *paths = member_scripts.getptr(names[i])) {
+			paths->insert(p_path);
+		} else {
+			Set<String> new_paths;
+			new_paths.insert(p_path);
+			member_scripts.set(names[i], new_paths);
+		}
+	}
+	script_member_names[p_path] = names;
+
+	Vector<lsp::DocumentedSymbolInformation> symbols;
+	script->get_symbols().symbol_tree_as_list(p_path, symbols);
+	script_symbol_lists[p_path] = symbols;
+}
+
+String GDScriptWorkspace::get_script_documentation(const String &p_path) {
+
+	// also called from the parse thread
+	MutexLock lock(parse_mutex);
+	if (const Map<String, ExtendGDScriptParser *>::Element *S = scripts.find(p_path)) {
+		return S->get()->get_symbols().documentation;
+	}
+	return String();
 }
 
 Error GDScriptWorkspace::parse_local_script(const String &p_path) {
@@ -379,7 +578,25 @@ void GDScriptWorkspace::completion(const lsp::CompletionParams &p_params, List<S
 	String call_hint;
 	bool forced = false;
 
-	if (const ExtendGDScriptParser *parser = get_parse_result(path)) {
+	String content;
+	if (_get_pending_content(path, content)) {
+		// complete against the latest text right away instead of waiting for the pending parse
+		Vector<String> lines = content.split("\n");
+		String code;
+		for (int i = 0; i < lines.size(); i++) {
+			if (i == p_params.position.line) {
+				code += lines[i].substr(0, p_params.position.character);
+				code += String::chr(0xFFFF); //not unicode, represents the cursor
+				code += lines[i].substr(p_params.position.character, lines[i].length());
+			} else {
+				code += lines[i];
+			}
+			if (i != lines.size() - 1) {
+				code += "\n";
+			}
+		}
+		GDScriptLanguage::get_singleton()->complete_code(code, path, NULL, r_options, forced, call_hint);
+	} else if (const ExtendGDScriptParser *parser = get_parse_result(path)) {
 		String code = parser->get_text_for_completion(p_params.position);
 		GDScriptLanguage::get_singleton()->complete_code(code, path, NULL, r_options, forced, call_hint);
 	}
@@ -464,23 +681,29 @@ void GDScriptWorkspace::resolve_related_symbols(const lsp::TextDocumentPositionP
 			class_ptr = native_members.next(class_ptr);
 		}
 
-		for (Map<String, ExtendGDScriptParser *>::Element *E = scripts.front(); E; E = E->next()) {
-			const ExtendGDScriptParser *script = E->get();
-			const ClassMembers &members = script->get_members();
-			if (const lsp::DocumentSymbol *const *symbol = members.getptr(symbol_identifier)) {
-				r_list.push_back(*symbol);
-			}
-
-			const HashMap<String, ClassMembers> &inner_classes = script->get_inner_classes();
-			const String *_class = inner_classes.next(NULL);
-			while (_class) {
-
-				const ClassMembers *inner_class = inner_classes.getptr(*_class);
-				if (const lsp::DocumentSymbol *const *symbol = inner_class->getptr(symbol_identifier)) {
+		if (const Set<String> *paths = member_scripts.getptr(symbol_identifier)) {
+			for (const Set<String>::Element *E = paths->front(); E; E = E->next()) {
+				const Map<String, ExtendGDScriptParser *>::Element *S = scripts.find(E->get());
+				if (!S) {
+					continue;
+				}
+				const ExtendGDScriptParser *script = S->get();
+				const ClassMembers &members = script->get_members();
+				if (const lsp::DocumentSymbol *const *symbol = members.getptr(symbol_identifier)) {
 					r_list.push_back(*symbol);
 				}
 
-				_class = inner_classes.next(_class);
+				const HashMap<String, ClassMembers> &inner_classes = script->get_inner_classes();
+				const String *_class = inner_classes.next(NULL);
+				while (_class) {
+
+					const ClassMembers *inner_class = inner_classes.getptr(*_class);
+					if (const lsp::DocumentSymbol *const *symbol = inner_class->getptr(symbol_identifier)) {
+						r_list.push_back(*symbol);
+					}
+
+					_class = inner_classes.next(_class);
+				}
 			}
 		}
 	}
@@ -566,9 +789,29 @@ Error GDScriptWorkspace::resolve_signature(const lsp::TextDocumentPositionParams
 
 GDScriptWorkspace::GDScriptWorkspace() {
 	ProjectSettings::get_singleton()->get_resource_path();
+
+	parse_mutex = Mutex::create();
+	parse_semaphore = Semaphore::create();
+	parse_thread = NULL;
+	parse_thread_exit = false;
+	parse_version = 0;
 }
 
 GDScriptWorkspace::~GDScriptWorkspace() {
+
+	if (parse_thread) {
+		parse_thread_exit = true;
+		parse_semaphore->post();
+		Thread::wait_to_finish(parse_thread);
+		memdelete(parse_thread);
+		parse_thread = NULL;
+	}
+
+	for (List<ParseResult>::Element *E = parse_finished.front(); E; E = E->next()) {
+		memdelete(E->get().parser);
+	}
+	parse_finished.clear();
+
 	Set<String> cached_parsers;
 
 	for (Map<String, ExtendGDScriptParser *>::Element *E = parse_results.front(); E; E = E->next()) {
@@ -582,4 +825,7 @@ GDScriptWorkspace::~GDScriptWorkspace() {
 	for (Set<String>::Element *E = cached_parsers.front(); E; E = E->next()) {
 		remove_cache_parser(E->get());
 	}
+
+	memdelete(parse_semaphore);
+	memdelete(parse_mutex);
 }
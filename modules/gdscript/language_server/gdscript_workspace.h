@@ -32,6 +32,9 @@
 #define GDSCRIPT_WORKSPACE_H
 
 #include "../gdscript_parser.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/variant.h"
 #include "gdscript_extend_parser.h"
 #include "lsp.hpp"
@@ -55,6 +58,47 @@ protected:
 
 	void list_script_files(const String &p_root_dir, List<String> &r_files);
 
+	// scripts are parsed on a worker thread, results are applied from process_parse_results()
+	struct ParseRequest {
+		String content;
+		uint64_t version;
+		bool queued;
+
+		ParseRequest() {
+			version = 0;
+			queued = false;
+		}
+	};
+
+	struct ParseResult {
+		String path;
+		uint64_t version;
+		ExtendGDScriptParser *parser;
+		Error error;
+	};
+
+	Mutex *parse_mutex;
+	Semaphore *parse_semaphore;
+	Thread *parse_thread;
+	volatile bool parse_thread_exit;
+	uint64_t parse_version;
+	Map<String, ParseRequest> pending_parses;
+	List<String> parse_queue;
+	List<ParseResult> parse_finished;
+
+	static void _parse_thread_func(void *p_ud);
+	void _parse_thread();
+	void _apply_parse_result(const String &p_path, ExtendGDScriptParser *p_parser, Error p_error);
+	void _flush_pending_parse(const String &p_path);
+	bool _get_pending_content(const String &p_path, String &r_content);
+
+	// workspace wide symbol index, only updated for the scripts that changed
+	HashMap<String, Set<String> > member_scripts;
+	Map<String, Vector<String> > script_member_names;
+	Map<String, Vector<lsp::DocumentedSymbolInformation> > script_symbol_lists;
+
+	void _update_symbol_index(const String &p_path);
+
 public:
 	String root;
 	String root_uri;
@@ -71,6 +115,10 @@ public:
 
 	Error parse_script(const String &p_path, const String &p_content);
 	Error parse_local_script(const String &p_path);
+	void queue_parse_script(const String &p_path, const String &p_content);
+	void process_parse_results();
+
+	String get_script_documentation(const String &p_path);
 
 	String get_file_path(const String &p_uri) const;
 	String get_file_uri(const String &p_path) const;
@@ -35,9 +35,12 @@
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
 #include "gdscript.h"
+#include "gdscript_bytecode.h"
 #include "gdscript_tokenizer.h"
+#include "gdscript_yield_scheduler.h"
 
 GDScriptLanguage *script_language_gd = NULL;
+GDScriptYieldScheduler *yield_scheduler_gd = NULL;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 
@@ -57,7 +60,14 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	bool debug;
+
 public:
+	virtual void _export_begin(const Set<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+
+		debug = p_debug;
+	}
+
 	virtual void _export_file(const String &p_path, const String &p_type, const Set<String> &p_features) {
 
 		int script_mode = EditorExportPreset::MODE_SCRIPT_COMPILED;
@@ -129,9 +139,22 @@ public:
 			} else {
 
 				add_file(p_path.get_basename() + ".gdc", file, true);
+
+				//also ship the compiled form, so the game doesn't have to compile it again on load.
+				//release templates never run the debugger, so line info is left out there
+				Ref<GDScript> script = ResourceLoader::load(p_path);
+				Vector<uint8_t> compiled;
+				if (script.is_valid() && script->is_valid() && GDScriptBytecode::save(script.ptr(), GDScriptBytecode::hash_buffer(file.ptr(), file.size()), List<String>(), compiled, !debug) == OK) {
+					add_file(p_path.get_basename() + ".gdbc", compiled, false);
+				}
 			}
 		}
 	}
+
+	EditorExportGDScript() {
+
+		debug = true;
+	}
 };
 
 static void _editor_init() {
@@ -158,6 +181,8 @@ void register_gdscript_types() {
 	script_language_gd = memnew(GDScriptLanguage);
 	ScriptServer::register_language(script_language_gd);
 
+	yield_scheduler_gd = memnew(GDScriptYieldScheduler);
+
 	resource_loader_gd.instance();
 	ResourceLoader::add_resource_format_loader(resource_loader_gd);
 
@@ -177,6 +202,9 @@ void unregister_gdscript_types() {
 	if (script_language_gd)
 		memdelete(script_language_gd);
 
+	if (yield_scheduler_gd)
+		memdelete(yield_scheduler_gd);
+
 	ResourceLoader::remove_resource_format_loader(resource_loader_gd);
 	resource_loader_gd.unref();
 
@@ -102,15 +102,20 @@ bool GridMap::_get(const StringName &p_name, Variant &r_ret) const {
 
 		Dictionary d;
 
+		//sorted, so saving the same cells always gives the same data
+		List<IndexKey> keys;
+		cell_map.get_key_list(&keys);
+		keys.sort();
+
 		PoolVector<int> cells;
 		cells.resize(cell_map.size() * 3);
 		{
 			PoolVector<int>::Write w = cells.write();
 			int i = 0;
-			for (Map<IndexKey, Cell>::Element *E = cell_map.front(); E; E = E->next(), i++) {
+			for (List<IndexKey>::Element *E = keys.front(); E; E = E->next(), i++) {
 
-				encode_uint64(E->key().key, (uint8_t *)&w[i * 3]);
-				encode_uint32(E->get().cell, (uint8_t *)&w[i * 3 + 2]);
+				encode_uint64(E->get().key, (uint8_t *)&w[i * 3]);
+				encode_uint32(cell_map[E->get()].cell, (uint8_t *)&w[i * 3 + 2]);
 			}
 		}
 
@@ -400,174 +405,557 @@ void GridMap::_octant_transform(const OctantKey &p_key) {
 	for (int i = 0; i < g.multimesh_instances.size(); i++) {
 		VS::get_singleton()->instance_set_transform(g.multimesh_instances[i].instance, get_global_transform());
 	}
+
+	if (g.merged_instance.is_valid()) {
+		VS::get_singleton()->instance_set_transform(g.merged_instance, get_global_transform());
+	}
 }
 
-bool GridMap::_octant_update(const OctantKey &p_key) {
-	ERR_FAIL_COND_V(!octant_map.has(p_key), false);
-	Octant &g = *octant_map[p_key];
-	if (!g.dirty)
-		return false;
+GridMap::BuildItem GridMap::_make_build_item(int p_item, bool p_debug_collision) const {
 
-	//erase body shapes
-	PhysicsServer::get_singleton()->body_clear_shapes(g.static_body);
+	BuildItem bi;
+	if (!mesh_library.is_valid() || !mesh_library->has_item(p_item))
+		return bi;
 
-	//erase body shapes debug
-	if (g.collision_debug.is_valid()) {
+	bi.valid = true;
 
-		VS::get_singleton()->mesh_clear(g.collision_debug);
+	Vector<MeshLibrary::ShapeData> shapes = mesh_library->get_item_shapes(p_item);
+	for (int i = 0; i < shapes.size(); i++) {
+		if (!shapes[i].shape.is_valid())
+			continue;
+		bi.shapes.push_back(Pair<RID, Transform>(shapes[i].shape->get_rid(), shapes[i].local_transform));
+		if (p_debug_collision) {
+			PoolVector<Vector3> lines;
+			shapes.write[i].shape->add_vertices_to_array(lines, shapes[i].local_transform);
+			PoolVector<Vector3>::Read r = lines.read();
+			for (int j = 0; j < lines.size(); j++) {
+				bi.debug_lines.push_back(r[j]);
+			}
+		}
 	}
 
-	//erase navigation
-	if (navigation) {
-		for (Map<IndexKey, Octant::NavMesh>::Element *E = g.navmesh_ids.front(); E; E = E->next()) {
-			navigation->navmesh_remove(E->get().id);
+	if (mesh_library->get_item_navmesh(p_item).is_valid()) {
+		bi.has_navmesh = true;
+		bi.navmesh_transform = mesh_library->get_item_navmesh_transform(p_item);
+	}
+
+	Ref<Mesh> mesh = mesh_library->get_item_mesh(p_item);
+	if (mesh.is_null())
+		return bi;
+
+	bi.has_mesh = true;
+
+	if (!use_mesh_merging || mesh->get_blend_shape_count() > 0)
+		return bi;
+
+	//only plain triangle surfaces can be baked into the octant mesh, anything else stays a multimesh
+	bool mergeable = mesh->get_surface_count() > 0;
+	for (int i = 0; i < mesh->get_surface_count() && mergeable; i++) {
+		uint32_t format = mesh->surface_get_format(i);
+		if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES || (format & (Mesh::ARRAY_FORMAT_BONES | Mesh::ARRAY_FORMAT_WEIGHTS))) {
+			mergeable = false;
 		}
-		g.navmesh_ids.clear();
 	}
 
-	//erase multimeshes
+	if (!mergeable)
+		return bi;
 
-	for (int i = 0; i < g.multimesh_instances.size(); i++) {
+	for (int i = 0; i < mesh->get_surface_count(); i++) {
 
-		VS::get_singleton()->free(g.multimesh_instances[i].instance);
-		VS::get_singleton()->free(g.multimesh_instances[i].multimesh);
+		Array arrays = mesh->surface_get_arrays(i);
+		MergeSurface ms;
+		ms.material = mesh->surface_get_material(i);
+		ms.format = mesh->surface_get_format(i) & (Mesh::ARRAY_FORMAT_VERTEX | Mesh::ARRAY_FORMAT_NORMAL | Mesh::ARRAY_FORMAT_TANGENT | Mesh::ARRAY_FORMAT_COLOR | Mesh::ARRAY_FORMAT_TEX_UV | Mesh::ARRAY_FORMAT_TEX_UV2 | Mesh::ARRAY_FORMAT_INDEX);
+
+		PoolVector<Vector3> vertices = arrays[Mesh::ARRAY_VERTEX];
+		int vc = vertices.size();
+		{
+			PoolVector<Vector3>::Read r = vertices.read();
+			ms.vertices.resize(vc);
+			for (int j = 0; j < vc; j++) {
+				ms.vertices.write[j] = r[j];
+			}
+		}
+		if (ms.format & Mesh::ARRAY_FORMAT_NORMAL) {
+			PoolVector<Vector3> normals = arrays[Mesh::ARRAY_NORMAL];
+			PoolVector<Vector3>::Read r = normals.read();
+			ms.normals.resize(normals.size());
+			for (int j = 0; j < normals.size(); j++) {
+				ms.normals.write[j] = r[j];
+			}
+		}
+		if (ms.format & Mesh::ARRAY_FORMAT_TANGENT) {
+			PoolVector<float> tangents = arrays[Mesh::ARRAY_TANGENT];
+			PoolVector<float>::Read r = tangents.read();
+			ms.tangents.resize(tangents.size());
+			for (int j = 0; j < tangents.size(); j++) {
+				ms.tangents.write[j] = r[j];
+			}
+		}
+		if (ms.format & Mesh::ARRAY_FORMAT_COLOR) {
+			PoolVector<Color> colors = arrays[Mesh::ARRAY_COLOR];
+			PoolVector<Color>::Read r = colors.read();
+			ms.colors.resize(colors.size());
+			for (int j = 0; j < colors.size(); j++) {
+				ms.colors.write[j] = r[j];
+			}
+		}
+		if (ms.format & Mesh::ARRAY_FORMAT_TEX_UV) {
+			PoolVector<Vector2> uvs = arrays[Mesh::ARRAY_TEX_UV];
+			PoolVector<Vector2>::Read r = uvs.read();
+			ms.uvs.resize(uvs.size());
+			for (int j = 0; j < uvs.size(); j++) {
+				ms.uvs.write[j] = r[j];
+			}
+		}
+		if (ms.format & Mesh::ARRAY_FORMAT_TEX_UV2) {
+			PoolVector<Vector2> uv2s = arrays[Mesh::ARRAY_TEX_UV2];
+			PoolVector<Vector2>::Read r = uv2s.read();
+			ms.uv2s.resize(uv2s.size());
+			for (int j = 0; j < uv2s.size(); j++) {
+				ms.uv2s.write[j] = r[j];
+			}
+		}
+		if (ms.format & Mesh::ARRAY_FORMAT_INDEX) {
+			PoolVector<int> indices = arrays[Mesh::ARRAY_INDEX];
+			PoolVector<int>::Read r = indices.read();
+			ms.indices.resize(indices.size());
+			for (int j = 0; j < indices.size(); j++) {
+				ms.indices.write[j] = r[j];
+			}
+		} else {
+			//merged surfaces are always indexed
+			ms.indices.resize(vc);
+			for (int j = 0; j < vc; j++) {
+				ms.indices.write[j] = j;
+			}
+			ms.format |= Mesh::ARRAY_FORMAT_INDEX;
+		}
+
+		bi.surfaces.push_back(ms);
 	}
-	g.multimesh_instances.clear();
 
-	if (g.cells.size() == 0) {
-		//octant no longer needed
-		_octant_clean_up(p_key);
-		return true;
+	bi.mergeable = true;
+	return bi;
+}
+
+GridMap::OctantBuildBatch *GridMap::_create_build_batch() {
+
+	OctantBuildBatch *batch = NULL;
+
+	const OctantKey *k = NULL;
+	while ((k = octant_map.next(k))) {
+
+		Octant *g = octant_map[*k];
+		if (!g->dirty)
+			continue;
+
+		if (!batch) {
+			batch = memnew(OctantBuildBatch);
+			batch->cell_size = cell_size;
+			batch->offset = _get_offset();
+			batch->cell_scale = cell_scale;
+			batch->use_meshes = baked_meshes.size() == 0;
+		}
+
+		OctantBuild ob;
+		ob.key = *k;
+		ob.debug_collision = g->collision_debug.is_valid();
+
+		for (Set<IndexKey>::Element *E = g->cells.front(); E; E = E->next()) {
+
+			const Cell *c = cell_map.getptr(E->get());
+			ERR_CONTINUE(!c);
+			ob.cells.push_back(Pair<IndexKey, Cell>(E->get(), *c));
+
+			//mesh library data is read here, the worker threads only see the copies
+			if (!batch->items.has(c->item)) {
+				batch->items[c->item] = _make_build_item(c->item, ob.debug_collision);
+			}
+		}
+
+		batch->octants.push_back(ob);
+		g->dirty = false;
 	}
 
-	PoolVector<Vector3> col_debug;
+	if (batch) {
+		batch->octants_ptr = batch->octants.ptrw();
+	}
 
-	/*
-	 * foreach item in this octant,
-	 * set item's multimesh's instance count to number of cells which have this item
-	 * and set said multimesh bounding box to one containing all cells which have this item
-	 */
+	return batch;
+}
+
+void GridMap::_build_octant(void *p_userdata, uint32_t p_index) {
+
+	OctantBuildBatch *batch = (OctantBuildBatch *)p_userdata;
+	OctantBuild &ob = batch->octants_ptr[p_index];
 
 	Map<int, List<Pair<Transform, IndexKey> > > multimesh_items;
+	Vector<MergeSurface> merged;
 
-	for (Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
+	for (int i = 0; i < ob.cells.size(); i++) {
 
-		ERR_CONTINUE(!cell_map.has(E->get()));
-		const Cell &c = cell_map[E->get()];
+		const IndexKey &key = ob.cells[i].first;
+		const Cell &c = ob.cells[i].second;
 
-		if (!mesh_library.is_valid() || !mesh_library->has_item(c.item))
+		const Map<int, BuildItem>::Element *IE = batch->items.find(c.item);
+		if (!IE || !IE->get().valid)
 			continue;
+		const BuildItem &bi = IE->get();
 
-		Vector3 cellpos = Vector3(E->get().x, E->get().y, E->get().z);
-		Vector3 ofs = _get_offset();
+		Vector3 cellpos = Vector3(key.x, key.y, key.z);
 
 		Transform xform;
 
 		xform.basis.set_orthogonal_index(c.rot);
-		xform.set_origin(cellpos * cell_size + ofs);
-		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
-		if (baked_meshes.size() == 0) {
-			if (mesh_library->get_item_mesh(c.item).is_valid()) {
-				if (!multimesh_items.has(c.item)) {
-					multimesh_items[c.item] = List<Pair<Transform, IndexKey> >();
+		xform.set_origin(cellpos * batch->cell_size + batch->offset);
+		xform.basis.scale(Vector3(batch->cell_scale, batch->cell_scale, batch->cell_scale));
+
+		if (batch->use_meshes && bi.has_mesh) {
+			if (bi.mergeable) {
+				Basis normal_basis = xform.basis.inverse().transposed();
+
+				for (int j = 0; j < bi.surfaces.size(); j++) {
+					const MergeSurface &src = bi.surfaces[j];
+
+					int idx = -1;
+					for (int l = 0; l < merged.size(); l++) {
+						if (merged[l].material == src.material && merged[l].format == src.format) {
+							idx = l;
+							break;
+						}
+					}
+					if (idx == -1) {
+						MergeSurface ms;
+						ms.material = src.material;
+						ms.format = src.format;
+						merged.push_back(ms);
+						idx = merged.size() - 1;
+					}
+
+					MergeSurface &dst = merged.write[idx];
+					int base = dst.vertices.size();
+
+					for (int l = 0; l < src.vertices.size(); l++) {
+						dst.vertices.push_back(xform.xform(src.vertices[l]));
+					}
+					for (int l = 0; l < src.normals.size(); l++) {
+						dst.normals.push_back(normal_basis.xform(src.normals[l]).normalized());
+					}
+					for (int l = 0; l + 3 < src.tangents.size(); l += 4) {
+						Vector3 t = xform.basis.xform(Vector3(src.tangents[l], src.tangents[l + 1], src.tangents[l + 2])).normalized();
+						dst.tangents.push_back(t.x);
+						dst.tangents.push_back(t.y);
+						dst.tangents.push_back(t.z);
+						dst.tangents.push_back(src.tangents[l + 3]);
+					}
+					for (int l = 0; l < src.colors.size(); l++) {
+						dst.colors.push_back(src.colors[l]);
+					}
+					for (int l = 0; l < src.uvs.size(); l++) {
+						dst.uvs.push_back(src.uvs[l]);
+					}
+					for (int l = 0; l < src.uv2s.size(); l++) {
+						dst.uv2s.push_back(src.uv2s[l]);
+					}
+					for (int l = 0; l < src.indices.size(); l++) {
+						dst.indices.push_back(base + src.indices[l]);
+					}
 				}
-
-				Pair<Transform, IndexKey> p;
-				p.first = xform;
-				p.second = E->get();
-				multimesh_items[c.item].push_back(p);
+			} else {
+				multimesh_items[c.item].push_back(Pair<Transform, IndexKey>(xform, key));
 			}
 		}
 
-		Vector<MeshLibrary::ShapeData> shapes = mesh_library->get_item_shapes(c.item);
 		// add the item's shape at given xform to octant's static_body
-		for (int i = 0; i < shapes.size(); i++) {
-			// add the item's shape
-			if (!shapes[i].shape.is_valid())
-				continue;
-			PhysicsServer::get_singleton()->body_add_shape(g.static_body, shapes[i].shape->get_rid(), xform * shapes[i].local_transform);
-			if (g.collision_debug.is_valid()) {
-				shapes.write[i].shape->add_vertices_to_array(col_debug, xform * shapes[i].local_transform);
+		for (int j = 0; j < bi.shapes.size(); j++) {
+			ob.shapes.push_back(Pair<RID, Transform>(bi.shapes[j].first, xform * bi.shapes[j].second));
+		}
+
+		if (ob.debug_collision && bi.debug_lines.size()) {
+			int from = ob.col_debug.size();
+			ob.col_debug.resize(from + bi.debug_lines.size());
+			PoolVector<Vector3>::Write w = ob.col_debug.write();
+			for (int j = 0; j < bi.debug_lines.size(); j++) {
+				w[from + j] = xform.xform(bi.debug_lines[j]);
 			}
 		}
 
 		// add the item's navmesh at given xform to GridMap's Navigation ancestor
-		Ref<NavigationMesh> navmesh = mesh_library->get_item_navmesh(c.item);
-		if (navmesh.is_valid()) {
-			Octant::NavMesh nm;
-			nm.xform = xform * mesh_library->get_item_navmesh_transform(c.item);
+		if (bi.has_navmesh) {
+			OctantBuild::NavMeshData nd;
+			nd.key = key;
+			nd.item = c.item;
+			nd.xform = xform;
+			nd.navmesh_xform = xform * bi.navmesh_transform;
+			ob.navmeshes.push_back(nd);
+		}
+	}
+
+	for (Map<int, List<Pair<Transform, IndexKey> > >::Element *E = multimesh_items.front(); E; E = E->next()) {
+
+		OctantBuild::MultimeshData md;
+		md.item = E->key();
+		md.transforms.resize(E->get().size() * 12);
+
+		PoolVector<float>::Write w = md.transforms.write();
+		int idx = 0;
+		for (List<Pair<Transform, IndexKey> >::Element *F = E->get().front(); F; F = F->next()) {
+
+			const Transform &t = F->get().first;
+			float *dataptr = &w[idx * 12];
+			dataptr[0] = t.basis.elements[0][0];
+			dataptr[1] = t.basis.elements[0][1];
+			dataptr[2] = t.basis.elements[0][2];
+			dataptr[3] = t.origin.x;
+			dataptr[4] = t.basis.elements[1][0];
+			dataptr[5] = t.basis.elements[1][1];
+			dataptr[6] = t.basis.elements[1][2];
+			dataptr[7] = t.origin.y;
+			dataptr[8] = t.basis.elements[2][0];
+			dataptr[9] = t.basis.elements[2][1];
+			dataptr[10] = t.basis.elements[2][2];
+			dataptr[11] = t.origin.z;
+#ifdef TOOLS_ENABLED
+
+			Octant::MultimeshInstance::Item it;
+			it.index = idx;
+			it.transform = t;
+			it.key = F->get().second;
+			md.items.push_back(it);
+#endif
+			idx++;
+		}
+
+		ob.multimeshes.push_back(md);
+	}
+
+	for (int i = 0; i < merged.size(); i++) {
+
+		const MergeSurface &ms = merged[i];
+
+		Array arr;
+		arr.resize(VS::ARRAY_MAX);
+
+		PoolVector<Vector3> vertices;
+		vertices.resize(ms.vertices.size());
+		{
+			PoolVector<Vector3>::Write w = vertices.write();
+			for (int j = 0; j < ms.vertices.size(); j++) {
+				w[j] = ms.vertices[j];
+			}
+		}
+		arr[VS::ARRAY_VERTEX] = vertices;
+
+		if (ms.normals.size() == ms.vertices.size() && ms.normals.size()) {
+			PoolVector<Vector3> normals;
+			normals.resize(ms.normals.size());
+			PoolVector<Vector3>::Write w = normals.write();
+			for (int j = 0; j < ms.normals.size(); j++) {
+				w[j] = ms.normals[j];
+			}
+			w.release();
+			arr[VS::ARRAY_NORMAL] = normals;
+		}
+		if (ms.tangents.size() == ms.vertices.size() * 4 && ms.tangents.size()) {
+			PoolVector<float> tangents;
+			tangents.resize(ms.tangents.size());
+			PoolVector<float>::Write w = tangents.write();
+			for (int j = 0; j < ms.tangents.size(); j++) {
+				w[j] = ms.tangents[j];
+			}
+			w.release();
+			arr[VS::ARRAY_TANGENT] = tangents;
+		}
+		if (ms.colors.size() == ms.vertices.size() && ms.colors.size()) {
+			PoolVector<Color> colors;
+			colors.resize(ms.colors.size());
+			PoolVector<Color>::Write w = colors.write();
+			for (int j = 0; j < ms.colors.size(); j++) {
+				w[j] = ms.colors[j];
+			}
+			w.release();
+			arr[VS::ARRAY_COLOR] = colors;
+		}
+		if (ms.uvs.size() == ms.vertices.size() && ms.uvs.size()) {
+			PoolVector<Vector2> uvs;
+			uvs.resize(ms.uvs.size());
+			PoolVector<Vector2>::Write w = uvs.write();
+			for (int j = 0; j < ms.uvs.size(); j++) {
+				w[j] = ms.uvs[j];
+			}
+			w.release();
+			arr[VS::ARRAY_TEX_UV] = uvs;
+		}
+		if (ms.uv2s.size() == ms.vertices.size() && ms.uv2s.size()) {
+			PoolVector<Vector2> uv2s;
+			uv2s.resize(ms.uv2s.size());
+			PoolVector<Vector2>::Write w = uv2s.write();
+			for (int j = 0; j < ms.uv2s.size(); j++) {
+				w[j] = ms.uv2s[j];
+			}
+			w.release();
+			arr[VS::ARRAY_TEX_UV2] = uv2s;
+		}
+
+		PoolVector<int> indices;
+		indices.resize(ms.indices.size());
+		{
+			PoolVector<int>::Write w = indices.write();
+			for (int j = 0; j < ms.indices.size(); j++) {
+				w[j] = ms.indices[j];
+			}
+		}
+		arr[VS::ARRAY_INDEX] = indices;
+
+		ob.merged_surfaces.push_back(Pair<Ref<Material>, Array>(ms.material, arr));
+	}
+}
+
+void GridMap::_apply_build_batch(OctantBuildBatch *p_batch) {
+
+	for (int i = 0; i < p_batch->octants.size(); i++) {
+
+		OctantBuild &ob = p_batch->octants.write[i];
+
+		Octant **gptr = octant_map.getptr(ob.key);
+		if (!gptr)
+			continue; //removed while building
+
+		Octant &g = **gptr;
 
-			if (navigation) {
-				nm.id = navigation->navmesh_add(navmesh, xform, this);
+		_octant_clear_data(g);
+
+		if (g.cells.size() == 0) {
+			//octant no longer needed
+			_octant_clean_up(ob.key);
+			memdelete(&g);
+			octant_map.erase(ob.key);
+			continue;
+		}
+
+		for (int j = 0; j < ob.shapes.size(); j++) {
+			PhysicsServer::get_singleton()->body_add_shape(g.static_body, ob.shapes[j].first, ob.shapes[j].second);
+		}
+
+		for (int j = 0; j < ob.navmeshes.size(); j++) {
+			const OctantBuild::NavMeshData &nd = ob.navmeshes[j];
+			Octant::NavMesh nm;
+			nm.xform = nd.navmesh_xform;
+			if (navigation && mesh_library.is_valid()) {
+				nm.id = navigation->navmesh_add(mesh_library->get_item_navmesh(nd.item), nd.xform, this);
 			} else {
 				nm.id = -1;
 			}
-			g.navmesh_ids[E->get()] = nm;
+			g.navmesh_ids[nd.key] = nm;
 		}
-	}
 
-	//update multimeshes, only if not baked
-	if (baked_meshes.size() == 0) {
+		if (mesh_library.is_valid()) {
 
-		for (Map<int, List<Pair<Transform, IndexKey> > >::Element *E = multimesh_items.front(); E; E = E->next()) {
-			Octant::MultimeshInstance mmi;
+			for (int j = 0; j < ob.multimeshes.size(); j++) {
+				const OctantBuild::MultimeshData &md = ob.multimeshes[j];
 
-			RID mm = VS::get_singleton()->multimesh_create();
-			VS::get_singleton()->multimesh_allocate(mm, E->get().size(), VS::MULTIMESH_TRANSFORM_3D, VS::MULTIMESH_COLOR_NONE);
-			VS::get_singleton()->multimesh_set_mesh(mm, mesh_library->get_item_mesh(E->key())->get_rid());
+				Ref<Mesh> mesh = mesh_library->get_item_mesh(md.item);
+				if (mesh.is_null())
+					continue;
 
-			int idx = 0;
-			for (List<Pair<Transform, IndexKey> >::Element *F = E->get().front(); F; F = F->next()) {
-				VS::get_singleton()->multimesh_instance_set_transform(mm, idx, F->get().first);
-#ifdef TOOLS_ENABLED
+				Octant::MultimeshInstance mmi;
 
-				Octant::MultimeshInstance::Item it;
-				it.index = idx;
-				it.transform = F->get().first;
-				it.key = F->get().second;
-				mmi.items.push_back(it);
-#endif
+				RID mm = VS::get_singleton()->multimesh_create();
+				VS::get_singleton()->multimesh_allocate(mm, md.transforms.size() / 12, VS::MULTIMESH_TRANSFORM_3D, VS::MULTIMESH_COLOR_NONE);
+				VS::get_singleton()->multimesh_set_mesh(mm, mesh->get_rid());
+				VS::get_singleton()->multimesh_set_as_bulk_array(mm, md.transforms);
 
-				idx++;
+				RID instance = VS::get_singleton()->instance_create();
+				VS::get_singleton()->instance_set_base(instance, mm);
+
+				if (is_inside_tree()) {
+					VS::get_singleton()->instance_set_scenario(instance, get_world()->get_scenario());
+					VS::get_singleton()->instance_set_transform(instance, get_global_transform());
+				}
+
+				mmi.multimesh = mm;
+				mmi.instance = instance;
+				mmi.items = md.items;
+
+				g.multimesh_instances.push_back(mmi);
 			}
+		}
 
-			RID instance = VS::get_singleton()->instance_create();
-			VS::get_singleton()->instance_set_base(instance, mm);
+		if (ob.merged_surfaces.size()) {
 
-			if (is_inside_tree()) {
-				VS::get_singleton()->instance_set_scenario(instance, get_world()->get_scenario());
-				VS::get_singleton()->instance_set_transform(instance, get_global_transform());
+			g.merged_mesh = VS::get_singleton()->mesh_create();
+			for (int j = 0; j < ob.merged_surfaces.size(); j++) {
+				VS::get_singleton()->mesh_add_surface_from_arrays(g.merged_mesh, VS::PRIMITIVE_TRIANGLES, ob.merged_surfaces[j].second);
+				if (ob.merged_surfaces[j].first.is_valid()) {
+					VS::get_singleton()->mesh_surface_set_material(g.merged_mesh, j, ob.merged_surfaces[j].first->get_rid());
+				}
 			}
 
-			mmi.multimesh = mm;
-			mmi.instance = instance;
+			g.merged_instance = VS::get_singleton()->instance_create();
+			VS::get_singleton()->instance_set_base(g.merged_instance, g.merged_mesh);
 
-			g.multimesh_instances.push_back(mmi);
+			if (is_inside_tree()) {
+				VS::get_singleton()->instance_set_scenario(g.merged_instance, get_world()->get_scenario());
+				VS::get_singleton()->instance_set_transform(g.merged_instance, get_global_transform());
+			}
 		}
-	}
 
-	if (col_debug.size()) {
+		if (ob.col_debug.size() && g.collision_debug.is_valid()) {
 
-		Array arr;
-		arr.resize(VS::ARRAY_MAX);
-		arr[VS::ARRAY_VERTEX] = col_debug;
+			Array arr;
+			arr.resize(VS::ARRAY_MAX);
+			arr[VS::ARRAY_VERTEX] = ob.col_debug;
 
-		VS::get_singleton()->mesh_add_surface_from_arrays(g.collision_debug, VS::PRIMITIVE_LINES, arr);
-		SceneTree *st = SceneTree::get_singleton();
-		if (st) {
-			VS::get_singleton()->mesh_surface_set_material(g.collision_debug, 0, st->get_debug_collision_material()->get_rid());
+			VS::get_singleton()->mesh_add_surface_from_arrays(g.collision_debug, VS::PRIMITIVE_LINES, arr);
+			SceneTree *st = SceneTree::get_singleton();
+			if (st) {
+				VS::get_singleton()->mesh_surface_set_material(g.collision_debug, 0, st->get_debug_collision_material()->get_rid());
+			}
 		}
 	}
 
-	g.dirty = false;
+	_update_visibility();
+}
+
+void GridMap::_finish_pending_build(bool p_wait) {
+
+	if (!pending_build)
+		return;
 
-	return false;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (!p_wait && !pool->is_task_completed(pending_build->task))
+		return;
+
+	pool->wait_for_task_completion(pending_build->task);
+
+	OctantBuildBatch *batch = pending_build;
+	pending_build = NULL;
+	set_process_internal(false);
+
+	_apply_build_batch(batch);
+	memdelete(batch);
+
+	//octants changed while the batch was building
+	_queue_octants_dirty();
+}
+
+void GridMap::_discard_pending_build() {
+
+	if (!pending_build)
+		return;
+
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(pending_build->task);
+	memdelete(pending_build);
+	pending_build = NULL;
+	set_process_internal(false);
 }
 
 void GridMap::_reset_physic_bodies_collision_filters() {
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-		PhysicsServer::get_singleton()->body_set_collision_layer(E->get()->static_body, collision_layer);
-		PhysicsServer::get_singleton()->body_set_collision_mask(E->get()->static_body, collision_mask);
+	const OctantKey *k = NULL;
+	while ((k = octant_map.next(k))) {
+		PhysicsServer::get_singleton()->body_set_collision_layer(octant_map[*k]->static_body, collision_layer);
+		PhysicsServer::get_singleton()->body_set_collision_mask(octant_map[*k]->static_body, collision_mask);
 	}
 }
 
@@ -588,6 +976,11 @@ void GridMap::_octant_enter_world(const OctantKey &p_key) {
 		VS::get_singleton()->instance_set_transform(g.multimesh_instances[i].instance, get_global_transform());
 	}
 
+	if (g.merged_instance.is_valid()) {
+		VS::get_singleton()->instance_set_scenario(g.merged_instance, get_world()->get_scenario());
+		VS::get_singleton()->instance_set_transform(g.merged_instance, get_global_transform());
+	}
+
 	if (navigation && mesh_library.is_valid()) {
 		for (Map<IndexKey, Octant::NavMesh>::Element *F = g.navmesh_ids.front(); F; F = F->next()) {
 
@@ -617,6 +1010,10 @@ void GridMap::_octant_exit_world(const OctantKey &p_key) {
 		VS::get_singleton()->instance_set_scenario(g.multimesh_instances[i].instance, RID());
 	}
 
+	if (g.merged_instance.is_valid()) {
+		VS::get_singleton()->instance_set_scenario(g.merged_instance, RID());
+	}
+
 	if (navigation) {
 		for (Map<IndexKey, Octant::NavMesh>::Element *F = g.navmesh_ids.front(); F; F = F->next()) {
 
@@ -628,25 +1025,26 @@ void GridMap::_octant_exit_world(const OctantKey &p_key) {
 	}
 }
 
-void GridMap::_octant_clean_up(const OctantKey &p_key) {
+void GridMap::_octant_clear_data(Octant &g) {
 
-	ERR_FAIL_COND(!octant_map.has(p_key));
-	Octant &g = *octant_map[p_key];
+	//erase body shapes
+	PhysicsServer::get_singleton()->body_clear_shapes(g.static_body);
 
-	if (g.collision_debug.is_valid())
-		VS::get_singleton()->free(g.collision_debug);
-	if (g.collision_debug_instance.is_valid())
-		VS::get_singleton()->free(g.collision_debug_instance);
+	//erase body shapes debug
+	if (g.collision_debug.is_valid()) {
 
-	PhysicsServer::get_singleton()->free(g.static_body);
+		VS::get_singleton()->mesh_clear(g.collision_debug);
+	}
 
 	//erase navigation
 	if (navigation) {
 		for (Map<IndexKey, Octant::NavMesh>::Element *E = g.navmesh_ids.front(); E; E = E->next()) {
-			navigation->navmesh_remove(E->get().id);
+			if (E->get().id >= 0) {
+				navigation->navmesh_remove(E->get().id);
+			}
 		}
-		g.navmesh_ids.clear();
 	}
+	g.navmesh_ids.clear();
 
 	//erase multimeshes
 
@@ -656,6 +1054,28 @@ void GridMap::_octant_clean_up(const OctantKey &p_key) {
 		VS::get_singleton()->free(g.multimesh_instances[i].multimesh);
 	}
 	g.multimesh_instances.clear();
+
+	if (g.merged_instance.is_valid()) {
+		VS::get_singleton()->free(g.merged_instance);
+		VS::get_singleton()->free(g.merged_mesh);
+		g.merged_instance = RID();
+		g.merged_mesh = RID();
+	}
+}
+
+void GridMap::_octant_clean_up(const OctantKey &p_key) {
+
+	ERR_FAIL_COND(!octant_map.has(p_key));
+	Octant &g = *octant_map[p_key];
+
+	_octant_clear_data(g);
+
+	if (g.collision_debug.is_valid())
+		VS::get_singleton()->free(g.collision_debug);
+	if (g.collision_debug_instance.is_valid())
+		VS::get_singleton()->free(g.collision_debug_instance);
+
+	PhysicsServer::get_singleton()->free(g.static_body);
 }
 
 void GridMap::_notification(int p_what) {
@@ -676,8 +1096,9 @@ void GridMap::_notification(int p_what) {
 
 			last_transform = get_global_transform();
 
-			for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-				_octant_enter_world(E->key());
+			const OctantKey *k = NULL;
+			while ((k = octant_map.next(k))) {
+				_octant_enter_world(*k);
 			}
 
 			for (int i = 0; i < baked_meshes.size(); i++) {
@@ -692,8 +1113,9 @@ void GridMap::_notification(int p_what) {
 			if (new_xform == last_transform)
 				break;
 			//update run
-			for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-				_octant_transform(E->key());
+			const OctantKey *k = NULL;
+			while ((k = octant_map.next(k))) {
+				_octant_transform(*k);
 			}
 
 			last_transform = new_xform;
@@ -705,8 +1127,12 @@ void GridMap::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 
-			for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-				_octant_exit_world(E->key());
+			//results of a build in flight still need the world
+			_finish_pending_build(true);
+
+			const OctantKey *k = NULL;
+			while ((k = octant_map.next(k))) {
+				_octant_exit_world(*k);
 			}
 
 			navigation = NULL;
@@ -722,6 +1148,9 @@ void GridMap::_notification(int p_what) {
 		case NOTIFICATION_VISIBILITY_CHANGED: {
 			_update_visibility();
 		} break;
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			_finish_pending_build(false);
+		} break;
 	}
 }
 
@@ -731,12 +1160,16 @@ void GridMap::_update_visibility() {
 
 	_change_notify("visible");
 
-	for (Map<OctantKey, Octant *>::Element *e = octant_map.front(); e; e = e->next()) {
-		Octant *octant = e->value();
+	const OctantKey *k = NULL;
+	while ((k = octant_map.next(k))) {
+		Octant *octant = octant_map[*k];
 		for (int i = 0; i < octant->multimesh_instances.size(); i++) {
 			const Octant::MultimeshInstance &mi = octant->multimesh_instances[i];
 			VS::get_singleton()->instance_set_visible(mi.instance, is_visible());
 		}
+		if (octant->merged_instance.is_valid()) {
+			VS::get_singleton()->instance_set_visible(octant->merged_instance, is_visible());
+		}
 	}
 }
 
@@ -752,23 +1185,28 @@ void GridMap::_queue_octants_dirty() {
 void GridMap::_recreate_octant_data() {
 
 	recreating_octants = true;
-	Map<IndexKey, Cell> cell_copy = cell_map;
+	HashMap<IndexKey, Cell, IndexKey> cell_copy = cell_map;
 	_clear_internal();
-	for (Map<IndexKey, Cell>::Element *E = cell_copy.front(); E; E = E->next()) {
+	const IndexKey *k = NULL;
+	while ((k = cell_copy.next(k))) {
 
-		set_cell_item(E->key().x, E->key().y, E->key().z, E->get().item, E->get().rot);
+		const Cell &c = cell_copy[*k];
+		set_cell_item(k->x, k->y, k->z, c.item, c.rot);
 	}
 	recreating_octants = false;
 }
 
 void GridMap::_clear_internal() {
 
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
+	_discard_pending_build();
+
+	const OctantKey *k = NULL;
+	while ((k = octant_map.next(k))) {
 		if (is_inside_world())
-			_octant_exit_world(E->key());
+			_octant_exit_world(*k);
 
-		_octant_clean_up(E->key());
-		memdelete(E->get());
+		_octant_clean_up(*k);
+		memdelete(octant_map[*k]);
 	}
 
 	octant_map.clear();
@@ -791,21 +1229,39 @@ void GridMap::_update_octants_callback() {
 	if (!awaiting_update)
 		return;
 
-	List<OctantKey> to_delete;
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
+	awaiting_update = false;
 
-		if (_octant_update(E->key())) {
-			to_delete.push_back(E->key());
-		}
+	if (pending_build) {
+		return; //octants dirtied meanwhile are picked up once the pending build is applied
 	}
 
-	while (to_delete.front()) {
-		octant_map.erase(to_delete.front()->get());
-		to_delete.pop_back();
+	OctantBuildBatch *batch = _create_build_batch();
+	if (!batch) {
+		_update_visibility();
+		return;
 	}
 
-	_update_visibility();
-	awaiting_update = false;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	bool use_pool = pool && pool->get_thread_count() > 0;
+
+	if (use_pool && use_threaded_update && is_inside_tree()) {
+		//results are swapped in from the internal process once ready
+		batch->task = pool->add_native_group_task(&GridMap::_build_octant, batch, batch->octants.size());
+		pending_build = batch;
+		set_process_internal(true);
+		return;
+	}
+
+	if (use_pool && batch->octants.size() > 1) {
+		pool->wait_for_task_completion(pool->add_native_group_task(&GridMap::_build_octant, batch, batch->octants.size()));
+	} else {
+		for (int i = 0; i < batch->octants.size(); i++) {
+			_build_octant(batch, i);
+		}
+	}
+
+	_apply_build_batch(batch);
+	memdelete(batch);
 }
 
 void GridMap::_bind_methods() {
@@ -834,6 +1290,12 @@ void GridMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_octant_size", "size"), &GridMap::set_octant_size);
 	ClassDB::bind_method(D_METHOD("get_octant_size"), &GridMap::get_octant_size);
 
+	ClassDB::bind_method(D_METHOD("set_use_threaded_update", "enable"), &GridMap::set_use_threaded_update);
+	ClassDB::bind_method(D_METHOD("is_using_threaded_update"), &GridMap::is_using_threaded_update);
+
+	ClassDB::bind_method(D_METHOD("set_use_mesh_merging", "enable"), &GridMap::set_use_mesh_merging);
+	ClassDB::bind_method(D_METHOD("is_using_mesh_merging"), &GridMap::is_using_mesh_merging);
+
 	ClassDB::bind_method(D_METHOD("set_cell_item", "x", "y", "z", "item", "orientation"), &GridMap::set_cell_item, DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("get_cell_item", "x", "y", "z"), &GridMap::get_cell_item);
 	ClassDB::bind_method(D_METHOD("get_cell_item_orientation", "x", "y", "z"), &GridMap::get_cell_item_orientation);
@@ -872,6 +1334,9 @@ void GridMap::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cell_center_y"), "set_center_y", "get_center_y");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cell_center_z"), "set_center_z", "get_center_z");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "cell_scale"), "set_cell_scale", "get_cell_scale");
+	ADD_GROUP("Octant", "octant_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "octant_use_threaded_update"), "set_use_threaded_update", "is_using_threaded_update");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "octant_use_mesh_merging"), "set_use_mesh_merging", "is_using_mesh_merging");
 	ADD_GROUP("Collision", "collision_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_layer", PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_collision_layer", "get_collision_layer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_mask", PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_collision_mask", "get_collision_mask");
@@ -894,9 +1359,10 @@ void GridMap::set_clip(bool p_enabled, bool p_clip_above, int p_floor, Vector3::
 	clip_above = p_clip_above;
 
 	//make it all update
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
+	const OctantKey *k = NULL;
+	while ((k = octant_map.next(k))) {
 
-		Octant *g = E->get();
+		Octant *g = octant_map[*k];
 		g->dirty = true;
 	}
 	awaiting_update = true;
@@ -914,13 +1380,41 @@ float GridMap::get_cell_scale() const {
 	return cell_scale;
 }
 
+void GridMap::set_use_threaded_update(bool p_enable) {
+
+	use_threaded_update = p_enable;
+	if (!use_threaded_update) {
+		_finish_pending_build(true);
+	}
+}
+
+bool GridMap::is_using_threaded_update() const {
+
+	return use_threaded_update;
+}
+
+void GridMap::set_use_mesh_merging(bool p_enable) {
+
+	if (use_mesh_merging == p_enable)
+		return;
+
+	use_mesh_merging = p_enable;
+	_recreate_octant_data();
+}
+
+bool GridMap::is_using_mesh_merging() const {
+
+	return use_mesh_merging;
+}
+
 Array GridMap::get_used_cells() const {
 
 	Array a;
 	a.resize(cell_map.size());
 	int i = 0;
-	for (Map<IndexKey, Cell>::Element *E = cell_map.front(); E; E = E->next()) {
-		Vector3 p(E->key().x, E->key().y, E->key().z);
+	const IndexKey *k = NULL;
+	while ((k = cell_map.next(k))) {
+		Vector3 p(k->x, k->y, k->z);
 		a[i++] = p;
 	}
 
@@ -935,22 +1429,24 @@ Array GridMap::get_meshes() {
 	Vector3 ofs = _get_offset();
 	Array meshes;
 
-	for (Map<IndexKey, Cell>::Element *E = cell_map.front(); E; E = E->next()) {
+	const IndexKey *k = NULL;
+	while ((k = cell_map.next(k))) {
 
-		int id = E->get().item;
+		const Cell &c = cell_map[*k];
+		int id = c.item;
 		if (!mesh_library->has_item(id))
 			continue;
 		Ref<Mesh> mesh = mesh_library->get_item_mesh(id);
 		if (mesh.is_null())
 			continue;
 
-		IndexKey ik = E->key();
+		IndexKey ik = *k;
 
 		Vector3 cellpos = Vector3(ik.x, ik.y, ik.z);
 
 		Transform xform;
 
-		xform.basis.set_orthogonal_index(E->get().rot);
+		xform.basis.set_orthogonal_index(c.rot);
 
 		xform.set_origin(cellpos * cell_size + ofs);
 		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
@@ -987,11 +1483,13 @@ void GridMap::make_baked_meshes(bool p_gen_lightmap_uv, float p_lightmap_uv_texe
 	//generate
 	Map<OctantKey, Map<Ref<Material>, Ref<SurfaceTool> > > surface_map;
 
-	for (Map<IndexKey, Cell>::Element *E = cell_map.front(); E; E = E->next()) {
+	const IndexKey *k = NULL;
+	while ((k = cell_map.next(k))) {
 
-		IndexKey key = E->key();
+		IndexKey key = *k;
+		const Cell &c = cell_map[key];
 
-		int item = E->get().item;
+		int item = c.item;
 		if (!mesh_library->has_item(item))
 			continue;
 
@@ -1004,7 +1502,7 @@ void GridMap::make_baked_meshes(bool p_gen_lightmap_uv, float p_lightmap_uv_texe
 
 		Transform xform;
 
-		xform.basis.set_orthogonal_index(E->get().rot);
+		xform.basis.set_orthogonal_index(c.rot);
 		xform.set_origin(cellpos * cell_size + ofs);
 		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
 
@@ -1107,6 +1605,10 @@ GridMap::GridMap() {
 	navigation = NULL;
 	set_notify_transform(true);
 	recreating_octants = false;
+
+	use_threaded_update = false;
+	use_mesh_merging = false;
+	pending_build = NULL;
 }
 
 GridMap::~GridMap() {
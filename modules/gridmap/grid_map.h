@@ -31,6 +31,8 @@
 #ifndef GRID_MAP_H
 #define GRID_MAP_H
 
+#include "core/hash_map.h"
+#include "core/os/worker_thread_pool.h"
 #include "scene/3d/navigation.h"
 #include "scene/3d/spatial.h"
 #include "scene/resources/mesh_library.h"
@@ -62,6 +64,16 @@ class GridMap : public Spatial {
 			return key < p_key.key;
 		}
 
+		_FORCE_INLINE_ bool operator==(const IndexKey &p_key) const {
+
+			return key == p_key.key;
+		}
+
+		static _FORCE_INLINE_ uint32_t hash(const IndexKey &p_key) {
+
+			return hash_one_uint64(p_key.key);
+		}
+
 		IndexKey() { key = 0; }
 	};
 
@@ -108,6 +120,8 @@ class GridMap : public Spatial {
 		};
 
 		Vector<MultimeshInstance> multimesh_instances;
+		RID merged_mesh; //all mergeable items of the octant in one mesh, see set_use_mesh_merging()
+		RID merged_instance;
 		Set<IndexKey> cells;
 		RID collision_debug;
 		RID collision_debug_instance;
@@ -133,6 +147,16 @@ class GridMap : public Spatial {
 			return key < p_key.key;
 		}
 
+		_FORCE_INLINE_ bool operator==(const OctantKey &p_key) const {
+
+			return key == p_key.key;
+		}
+
+		static _FORCE_INLINE_ uint32_t hash(const OctantKey &p_key) {
+
+			return hash_one_uint64(p_key.key);
+		}
+
 		//OctantKey(const IndexKey& p_k, int p_item) { indexkey=p_k.key; item=p_item; }
 		OctantKey() { key = 0; }
 	};
@@ -159,11 +183,105 @@ class GridMap : public Spatial {
 
 	Ref<MeshLibrary> mesh_library;
 
-	Map<OctantKey, Octant *> octant_map;
-	Map<IndexKey, Cell> cell_map;
+	HashMap<OctantKey, Octant *, OctantKey> octant_map;
+	HashMap<IndexKey, Cell, IndexKey> cell_map;
 
 	void _recreate_octant_data();
 
+	/**
+	 * Dirty octants are rebuilt in batches: the cells and the mesh library data they use are
+	 * copied on the main thread, everything derived from them is computed on the worker pool,
+	 * and the results are handed to the servers on the main thread again.
+	 */
+	struct MergeSurface {
+		Ref<Material> material;
+		uint32_t format;
+		Vector<Vector3> vertices;
+		Vector<Vector3> normals;
+		Vector<float> tangents;
+		Vector<Color> colors;
+		Vector<Vector2> uvs;
+		Vector<Vector2> uv2s;
+		Vector<int> indices;
+
+		MergeSurface() { format = 0; }
+	};
+
+	struct BuildItem {
+		bool valid;
+		bool has_mesh;
+		bool mergeable;
+		Vector<Pair<RID, Transform> > shapes;
+		Vector<Vector3> debug_lines; //item space
+		bool has_navmesh;
+		Transform navmesh_transform;
+		Vector<MergeSurface> surfaces; //item space, only when mergeable
+
+		BuildItem() {
+			valid = false;
+			has_mesh = false;
+			mergeable = false;
+			has_navmesh = false;
+		}
+	};
+
+	struct OctantBuild {
+
+		struct MultimeshData {
+			int item;
+			PoolVector<float> transforms;
+			Vector<Octant::MultimeshInstance::Item> items; //tools only
+		};
+
+		struct NavMeshData {
+			IndexKey key;
+			int item;
+			Transform xform;
+			Transform navmesh_xform;
+		};
+
+		OctantKey key;
+		Vector<Pair<IndexKey, Cell> > cells;
+		bool debug_collision;
+
+		Vector<MultimeshData> multimeshes;
+		Vector<Pair<Ref<Material>, Array> > merged_surfaces;
+		Vector<Pair<RID, Transform> > shapes;
+		PoolVector<Vector3> col_debug;
+		Vector<NavMeshData> navmeshes;
+
+		OctantBuild() { debug_collision = false; }
+	};
+
+	struct OctantBuildBatch {
+		Map<int, BuildItem> items;
+		Vector<OctantBuild> octants;
+		OctantBuild *octants_ptr;
+		Vector3 cell_size;
+		Vector3 offset;
+		float cell_scale;
+		bool use_meshes;
+		WorkerThreadPool::TaskID task;
+
+		OctantBuildBatch() {
+			octants_ptr = NULL;
+			cell_scale = 1.0;
+			use_meshes = true;
+			task = WorkerThreadPool::INVALID_TASK_ID;
+		}
+	};
+
+	bool use_threaded_update;
+	bool use_mesh_merging;
+	OctantBuildBatch *pending_build;
+
+	BuildItem _make_build_item(int p_item, bool p_debug_collision) const;
+	OctantBuildBatch *_create_build_batch();
+	static void _build_octant(void *p_userdata, uint32_t p_index);
+	void _apply_build_batch(OctantBuildBatch *p_batch);
+	void _finish_pending_build(bool p_wait);
+	void _discard_pending_build();
+
 	struct BakeLight {
 
 		VS::LightType type;
@@ -180,7 +298,7 @@ class GridMap : public Spatial {
 	void _reset_physic_bodies_collision_filters();
 	void _octant_enter_world(const OctantKey &p_key);
 	void _octant_exit_world(const OctantKey &p_key);
-	bool _octant_update(const OctantKey &p_key);
+	void _octant_clear_data(Octant &g);
 	void _octant_clean_up(const OctantKey &p_key);
 	void _octant_transform(const OctantKey &p_key);
 	bool awaiting_update;
@@ -255,6 +373,12 @@ public:
 	void set_cell_scale(float p_scale);
 	float get_cell_scale() const;
 
+	void set_use_threaded_update(bool p_enable);
+	bool is_using_threaded_update() const;
+
+	void set_use_mesh_merging(bool p_enable);
+	bool is_using_mesh_merging() const;
+
 	Array get_used_cells() const;
 
 	Array get_meshes();
@@ -36,7 +36,84 @@
 #include <jpgd.h>
 #include <string.h>
 
-Error jpeg_load_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p_buffer_len) {
+//box filters the scanlines while decoding, so the full size image is never allocated
+static Error jpeg_load_shrunk_image(Image *p_image, jpgd::jpeg_decoder &p_decoder, int p_width, int p_height, int p_comps, int p_shrink) {
+
+	while (p_shrink > 0 && ((p_width >> p_shrink) == 0 || (p_height >> p_shrink) == 0)) {
+		p_shrink--;
+	}
+
+	const int dst_width = p_width >> p_shrink;
+	const int dst_height = p_height >> p_shrink;
+
+	//the rightmost and bottom source pixels that do not fill a whole block go to the last one
+	Vector<uint32_t> column_count;
+	column_count.resize(dst_width);
+	for (int x = 0; x < dst_width; x++) {
+		column_count.write[x] = 0;
+	}
+	for (int x = 0; x < p_width; x++) {
+		column_count.write[MIN(x >> p_shrink, dst_width - 1)]++;
+	}
+
+	Vector<uint32_t> accum;
+	accum.resize(dst_width * p_comps);
+
+	PoolVector<uint8_t> data;
+	data.resize(dst_width * dst_height * p_comps);
+	PoolVector<uint8_t>::Write dw = data.write();
+
+	int rows = 0;
+	for (int y = 0; y < p_height; y++) {
+		const jpgd::uint8 *pScan_line;
+		jpgd::uint scan_line_len;
+		if (p_decoder.decode((const void **)&pScan_line, &scan_line_len) != jpgd::JPGD_SUCCESS) {
+			return ERR_FILE_CORRUPT;
+		}
+
+		if (rows == 0) {
+			for (int i = 0; i < accum.size(); i++) {
+				accum.write[i] = 0;
+			}
+		}
+
+		uint32_t *acc = accum.ptrw();
+		for (int x = 0; x < p_width; x++) {
+			uint32_t *dst = &acc[MIN(x >> p_shrink, dst_width - 1) * p_comps];
+			if (p_comps == 1) {
+				dst[0] += pScan_line[x];
+			} else {
+				// Same as the full size path, pScan_line holds 32-bit RGBA pixels.
+				dst[0] += pScan_line[x * 4 + 0];
+				dst[1] += pScan_line[x * 4 + 1];
+				dst[2] += pScan_line[x * 4 + 2];
+			}
+		}
+		rows++;
+
+		const int dst_y = MIN(y >> p_shrink, dst_height - 1);
+		const bool last_row = y == p_height - 1 || MIN((y + 1) >> p_shrink, dst_height - 1) != dst_y;
+		if (!last_row) {
+			continue;
+		}
+
+		uint8_t *dst_row = dw.ptr() + dst_y * dst_width * p_comps;
+		for (int x = 0; x < dst_width; x++) {
+			const uint32_t count = column_count[x] * rows;
+			for (int c = 0; c < p_comps; c++) {
+				dst_row[x * p_comps + c] = (acc[x * p_comps + c] + count / 2) / count;
+			}
+		}
+		rows = 0;
+	}
+
+	dw.release();
+	p_image->create(dst_width, dst_height, 0, p_comps == 1 ? Image::FORMAT_L8 : Image::FORMAT_RGB8, data);
+
+	return OK;
+}
+
+Error jpeg_load_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p_buffer_len, int p_shrink = 0) {
 
 	jpgd::jpeg_decoder_mem_stream mem_stream(p_buffer, p_buffer_len);
 
@@ -55,6 +132,10 @@ Error jpeg_load_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p
 	if (decoder.begin_decoding() != jpgd::JPGD_SUCCESS)
 		return ERR_FILE_CORRUPT;
 
+	if (p_shrink > 0) {
+		return jpeg_load_shrunk_image(p_image, decoder, image_width, image_height, comps, p_shrink);
+	}
+
 	const int dst_bpl = image_width * comps;
 
 	PoolVector<uint8_t> data;
@@ -107,6 +188,15 @@ Error ImageLoaderJPG::load_image(Ref<Image> p_image, FileAccess *f, bool p_force
 	PoolVector<uint8_t> src_image;
 	int src_image_len = f->get_len();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
+
+	const uint8_t *mapped = f->get_mapped_data();
+	if (mapped) {
+		//decode straight from memory, no copy
+		Error err = jpeg_load_image_from_buffer(p_image.ptr(), mapped, src_image_len);
+		f->close();
+		return err;
+	}
+
 	src_image.resize(src_image_len);
 
 	PoolVector<uint8_t>::Write w = src_image.write();
@@ -135,7 +225,17 @@ static Ref<Image> _jpegd_mem_loader_func(const uint8_t *p_png, int p_size) {
 	return img;
 }
 
+static Ref<Image> _jpegd_mem_shrink_loader_func(const uint8_t *p_data, int p_size, int p_shrink) {
+
+	Ref<Image> img;
+	img.instance();
+	Error err = jpeg_load_image_from_buffer(img.ptr(), p_data, p_size, p_shrink);
+	ERR_FAIL_COND_V(err, Ref<Image>());
+	return img;
+}
+
 ImageLoaderJPG::ImageLoaderJPG() {
 
 	Image::_jpg_mem_loader_func = _jpegd_mem_loader_func;
+	Image::_jpg_mem_shrink_loader_func = _jpegd_mem_shrink_loader_func;
 }
@@ -33,6 +33,11 @@
 #include "core/io/stream_peer_tcp.h"
 #include "core/os/file_access.h"
 
+#define SESSION_CACHE_MAX 64
+
+Mutex *StreamPeerMbedTLS::session_mutex = NULL;
+HashMap<String, mbedtls_ssl_session *> StreamPeerMbedTLS::sessions;
+
 void _print_error(int ret) {
 	printf("mbedtls error: returned -0x%x\n\n", -ret);
 	fflush(stdout);
@@ -76,6 +81,41 @@ int StreamPeerMbedTLS::bio_recv(void *ctx, unsigned char *buf, size_t len) {
 	return got;
 }
 
+void StreamPeerMbedTLS::_clear_sessions() {
+
+	const String *k = NULL;
+	while ((k = sessions.next(k))) {
+		mbedtls_ssl_session_free(sessions[*k]);
+		memfree(sessions[*k]);
+	}
+	sessions.clear();
+}
+
+void StreamPeerMbedTLS::_store_session() {
+
+	MutexLock lock(session_mutex);
+
+	mbedtls_ssl_session **cached = sessions.getptr(session_key);
+	mbedtls_ssl_session *session = NULL;
+	if (cached) {
+		session = *cached;
+		mbedtls_ssl_session_free(session);
+	} else {
+		if (sessions.size() >= SESSION_CACHE_MAX) {
+			_clear_sessions();
+		}
+		session = (mbedtls_ssl_session *)memalloc(sizeof(mbedtls_ssl_session));
+		sessions[session_key] = session;
+	}
+	mbedtls_ssl_session_init(session);
+
+	if (mbedtls_ssl_get_session(ssl_ctx->get_context(), session) != 0) {
+		mbedtls_ssl_session_free(session);
+		memfree(session);
+		sessions.erase(session_key);
+	}
+}
+
 void StreamPeerMbedTLS::_cleanup() {
 
 	ssl_ctx->clear();
@@ -102,6 +142,10 @@ Error StreamPeerMbedTLS::_do_handshake() {
 		}
 	}
 
+	if (session_key != String()) {
+		_store_session();
+	}
+
 	status = STATUS_CONNECTED;
 	return OK;
 }
@@ -119,6 +163,19 @@ Error StreamPeerMbedTLS::connect_to_stream(Ref<StreamPeer> p_base, bool p_valida
 	mbedtls_ssl_set_hostname(ssl_ctx->get_context(), p_for_hostname.utf8().get_data());
 	mbedtls_ssl_set_bio(ssl_ctx->get_context(), this, bio_send, bio_recv, NULL);
 
+	// Sessions verified against custom certificates are never shared.
+	hostname = p_for_hostname;
+	session_key = String();
+	if (hostname != String() && p_ca_certs.is_null()) {
+		session_key = (p_validate_certs ? "v:" : "n:") + hostname;
+
+		MutexLock lock(session_mutex);
+		mbedtls_ssl_session **cached = sessions.getptr(session_key);
+		if (cached) {
+			mbedtls_ssl_set_session(ssl_ctx->get_context(), *cached);
+		}
+	}
+
 	status = STATUS_HANDSHAKING;
 
 	if (_do_handshake() != OK) {
@@ -137,6 +194,7 @@ Error StreamPeerMbedTLS::accept_stream(Ref<StreamPeer> p_base, Ref<CryptoKey> p_
 	ERR_FAIL_COND_V(err != OK, err);
 
 	base = p_base;
+	session_key = String();
 
 	mbedtls_ssl_set_bio(ssl_ctx->get_context(), this, bio_send, bio_recv, NULL);
 
@@ -320,10 +378,15 @@ void StreamPeerMbedTLS::initialize_ssl() {
 
 	_create = _create_func;
 	available = true;
+	session_mutex = Mutex::create();
 }
 
 void StreamPeerMbedTLS::finalize_ssl() {
 
 	available = false;
 	_create = NULL;
+
+	_clear_sessions();
+	memdelete(session_mutex);
+	session_mutex = NULL;
 }
@@ -31,7 +31,9 @@
 #ifndef STREAM_PEER_OPEN_SSL_H
 #define STREAM_PEER_OPEN_SSL_H
 
+#include "core/hash_map.h"
 #include "core/io/stream_peer_ssl.h"
+#include "core/os/mutex.h"
 #include "ssl_context_mbedtls.h"
 
 class StreamPeerMbedTLS : public StreamPeerSSL {
@@ -41,6 +43,14 @@ private:
 
 	Ref<StreamPeer> base;
 
+	// Client sessions are cached per host so reconnecting can skip the full handshake.
+	String session_key;
+	static Mutex *session_mutex;
+	static HashMap<String, mbedtls_ssl_session *> sessions;
+
+	static void _clear_sessions();
+	void _store_session();
+
 	static StreamPeerSSL *_create_func();
 
 	static int bio_recv(void *ctx, unsigned char *buf, size_t len);
@@ -31,6 +31,11 @@
 #include "open_simplex_noise.h"
 
 #include "core/core_string_names.h"
+#include "core/os/worker_thread_pool.h"
+
+// Below this amount of samples, waking up worker threads costs more than it saves.
+#define PARALLEL_MIN_SAMPLES 4096
+#define POINTS_PER_CHUNK 1024
 
 OpenSimplexNoise::OpenSimplexNoise() {
 
@@ -96,23 +101,70 @@ void OpenSimplexNoise::set_lacunarity(float p_lacunarity) {
 	emit_changed();
 }
 
+template <class T>
+void OpenSimplexNoise::_run_jobs(uint32_t p_count, uint32_t p_samples, void (OpenSimplexNoise::*p_method)(uint32_t, T *), T *p_job) {
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_count > 1 && p_samples >= PARALLEL_MIN_SAMPLES && pool && pool->get_thread_count() > 0) {
+		pool->parallel_for(p_count, this, p_method, p_job);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, p_job);
+		}
+	}
+}
+
+void OpenSimplexNoise::_image_row(uint32_t p_row, ImageJob *p_job) {
+
+	int i = p_row;
+	int width = p_job->width;
+	uint8_t *wd8 = p_job->out + i * width * 4;
+
+	for (int j = 0; j < width; j++) {
+		float v;
+		if (p_job->seamless) {
+			int size = width;
+
+			float ii = (float)i / (float)size;
+			float jj = (float)j / (float)size;
+
+			ii *= 2.0 * Math_PI;
+			jj *= 2.0 * Math_PI;
+
+			float radius = size / (2.0 * Math_PI);
+
+			float x = radius * Math::sin(jj);
+			float y = radius * Math::cos(jj);
+			float z = radius * Math::sin(ii);
+			float w = radius * Math::cos(ii);
+			v = get_noise_4d(x, y, z, w);
+		} else {
+			v = get_noise_2d(i, j);
+		}
+
+		v = v * 0.5 + 0.5; // Normalize [0..1]
+		uint8_t value = uint8_t(CLAMP(v * 255.0, 0, 255));
+		wd8[j * 4 + 0] = value;
+		wd8[j * 4 + 1] = value;
+		wd8[j * 4 + 2] = value;
+		wd8[j * 4 + 3] = 255;
+	}
+}
+
 Ref<Image> OpenSimplexNoise::get_image(int p_width, int p_height) {
 
 	PoolVector<uint8_t> data;
 	data.resize(p_width * p_height * 4);
 
-	PoolVector<uint8_t>::Write wd8 = data.write();
-
-	for (int i = 0; i < p_height; i++) {
-		for (int j = 0; j < p_width; j++) {
-			float v = get_noise_2d(i, j);
-			v = v * 0.5 + 0.5; // Normalize [0..1]
-			uint8_t value = uint8_t(CLAMP(v * 255.0, 0, 255));
-			wd8[(i * p_width + j) * 4 + 0] = value;
-			wd8[(i * p_width + j) * 4 + 1] = value;
-			wd8[(i * p_width + j) * 4 + 2] = value;
-			wd8[(i * p_width + j) * 4 + 3] = 255;
-		}
+	{
+		PoolVector<uint8_t>::Write wd8 = data.write();
+
+		ImageJob job;
+		job.width = p_width;
+		job.height = p_height;
+		job.seamless = false;
+		job.out = wd8.ptr();
+		_run_jobs(p_height, p_width * p_height, &OpenSimplexNoise::_image_row, &job);
 	}
 
 	Ref<Image> image = memnew(Image(p_width, p_height, false, Image::FORMAT_RGBA8, data));
@@ -124,36 +176,166 @@ Ref<Image> OpenSimplexNoise::get_seamless_image(int p_size) {
 	PoolVector<uint8_t> data;
 	data.resize(p_size * p_size * 4);
 
-	PoolVector<uint8_t>::Write wd8 = data.write();
+	{
+		PoolVector<uint8_t>::Write wd8 = data.write();
 
-	for (int i = 0; i < p_size; i++) {
-		for (int j = 0; j < p_size; j++) {
+		ImageJob job;
+		job.width = p_size;
+		job.height = p_size;
+		job.seamless = true;
+		job.out = wd8.ptr();
+		_run_jobs(p_size, p_size * p_size, &OpenSimplexNoise::_image_row, &job);
+	}
 
-			float ii = (float)i / (float)p_size;
-			float jj = (float)j / (float)p_size;
+	Ref<Image> image = memnew(Image(p_size, p_size, false, Image::FORMAT_RGBA8, data));
+	return image;
+}
 
-			ii *= 2.0 * Math_PI;
-			jj *= 2.0 * Math_PI;
+void OpenSimplexNoise::_grid_row(uint32_t p_row, GridJob *p_job) {
 
-			float radius = p_size / (2.0 * Math_PI);
+	// For 3D grids, rows go through y first and then z.
+	int y = p_row % p_job->height;
+	int z = p_row / p_job->height;
+	real_t *out = p_job->out + p_row * p_job->width;
 
-			float x = radius * Math::sin(jj);
-			float y = radius * Math::cos(jj);
-			float z = radius * Math::sin(ii);
-			float w = radius * Math::cos(ii);
-			float v = get_noise_4d(x, y, z, w);
-
-			v = v * 0.5 + 0.5; // Normalize [0..1]
-			uint8_t value = uint8_t(CLAMP(v * 255.0, 0, 255));
-			wd8[(i * p_size + j) * 4 + 0] = value;
-			wd8[(i * p_size + j) * 4 + 1] = value;
-			wd8[(i * p_size + j) * 4 + 2] = value;
-			wd8[(i * p_size + j) * 4 + 3] = 255;
+	float py = p_job->from.y + y * p_job->step.y;
+	if (p_job->dimensions == 2) {
+		for (int x = 0; x < p_job->width; x++) {
+			out[x] = get_noise_2d(p_job->from.x + x * p_job->step.x, py);
+		}
+	} else {
+		float pz = p_job->from.z + z * p_job->step.z;
+		for (int x = 0; x < p_job->width; x++) {
+			out[x] = get_noise_3d(p_job->from.x + x * p_job->step.x, py, pz);
 		}
 	}
+}
 
-	Ref<Image> image = memnew(Image(p_size, p_size, false, Image::FORMAT_RGBA8, data));
-	return image;
+PoolRealArray OpenSimplexNoise::get_noise_grid_2d(const Vector2 &p_from, int p_width, int p_height, const Vector2 &p_step) {
+
+	PoolRealArray result;
+	ERR_FAIL_COND_V(p_width < 0 || p_height < 0, result);
+	result.resize(p_width * p_height);
+	if (result.size() == 0) {
+		return result;
+	}
+
+	PoolRealArray::Write w = result.write();
+
+	GridJob job;
+	job.dimensions = 2;
+	job.from = Vector3(p_from.x, p_from.y, 0);
+	job.step = Vector3(p_step.x, p_step.y, 0);
+	job.width = p_width;
+	job.height = p_height;
+	job.out = w.ptr();
+	_run_jobs(p_height, p_width * p_height, &OpenSimplexNoise::_grid_row, &job);
+
+	return result;
+}
+
+PoolRealArray OpenSimplexNoise::get_noise_grid_3d(const Vector3 &p_from, int p_width, int p_height, int p_depth, const Vector3 &p_step) {
+
+	PoolRealArray result;
+	ERR_FAIL_COND_V(p_width < 0 || p_height < 0 || p_depth < 0, result);
+	result.resize(p_width * p_height * p_depth);
+	if (result.size() == 0) {
+		return result;
+	}
+
+	PoolRealArray::Write w = result.write();
+
+	GridJob job;
+	job.dimensions = 3;
+	job.from = p_from;
+	job.step = p_step;
+	job.width = p_width;
+	job.height = p_height;
+	job.out = w.ptr();
+	_run_jobs(p_height * p_depth, p_width * p_height * p_depth, &OpenSimplexNoise::_grid_row, &job);
+
+	return result;
+}
+
+void OpenSimplexNoise::_points_chunk(uint32_t p_chunk, PointsJob *p_job) {
+
+	int from = p_chunk * POINTS_PER_CHUNK;
+	int to = MIN(from + POINTS_PER_CHUNK, p_job->count);
+
+	switch (p_job->dimensions) {
+		case 2: {
+			for (int i = from; i < to; i++) {
+				p_job->out[i] = get_noise_2d(p_job->points_2d[i].x, p_job->points_2d[i].y);
+			}
+		} break;
+		case 3: {
+			for (int i = from; i < to; i++) {
+				p_job->out[i] = get_noise_3d(p_job->points_3d[i].x, p_job->points_3d[i].y, p_job->points_3d[i].z);
+			}
+		} break;
+		default: {
+			for (int i = from; i < to; i++) {
+				const real_t *p = &p_job->points_4d[i * 4];
+				p_job->out[i] = get_noise_4d(p[0], p[1], p[2], p[3]);
+			}
+		}
+	}
+}
+
+PoolRealArray OpenSimplexNoise::_get_noise_points(PointsJob &p_job) {
+
+	PoolRealArray result;
+	result.resize(p_job.count);
+	if (p_job.count == 0) {
+		return result;
+	}
+
+	PoolRealArray::Write w = result.write();
+	p_job.out = w.ptr();
+	_run_jobs((p_job.count + POINTS_PER_CHUNK - 1) / POINTS_PER_CHUNK, p_job.count, &OpenSimplexNoise::_points_chunk, &p_job);
+
+	return result;
+}
+
+PoolRealArray OpenSimplexNoise::get_noise_points_2d(const PoolVector2Array &p_points) {
+
+	PoolVector2Array::Read r = p_points.read();
+
+	PointsJob job;
+	job.dimensions = 2;
+	job.count = p_points.size();
+	job.points_2d = r.ptr();
+	job.points_3d = NULL;
+	job.points_4d = NULL;
+	return _get_noise_points(job);
+}
+
+PoolRealArray OpenSimplexNoise::get_noise_points_3d(const PoolVector3Array &p_points) {
+
+	PoolVector3Array::Read r = p_points.read();
+
+	PointsJob job;
+	job.dimensions = 3;
+	job.count = p_points.size();
+	job.points_2d = NULL;
+	job.points_3d = r.ptr();
+	job.points_4d = NULL;
+	return _get_noise_points(job);
+}
+
+PoolRealArray OpenSimplexNoise::get_noise_points_4d(const PoolRealArray &p_points) {
+
+	ERR_FAIL_COND_V_MSG(p_points.size() % 4 != 0, PoolRealArray(), "4D points must be given as groups of 4 values (x, y, z, w).");
+
+	PoolRealArray::Read r = p_points.read();
+
+	PointsJob job;
+	job.dimensions = 4;
+	job.count = p_points.size() / 4;
+	job.points_2d = NULL;
+	job.points_3d = NULL;
+	job.points_4d = r.ptr();
+	return _get_noise_points(job);
 }
 
 void OpenSimplexNoise::_bind_methods() {
@@ -184,6 +366,13 @@ void OpenSimplexNoise::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_noise_2dv", "pos"), &OpenSimplexNoise::get_noise_2dv);
 	ClassDB::bind_method(D_METHOD("get_noise_3dv", "pos"), &OpenSimplexNoise::get_noise_3dv);
 
+	ClassDB::bind_method(D_METHOD("get_noise_grid_2d", "from", "width", "height", "step"), &OpenSimplexNoise::get_noise_grid_2d, DEFVAL(Vector2(1, 1)));
+	ClassDB::bind_method(D_METHOD("get_noise_grid_3d", "from", "width", "height", "depth", "step"), &OpenSimplexNoise::get_noise_grid_3d, DEFVAL(Vector3(1, 1, 1)));
+
+	ClassDB::bind_method(D_METHOD("get_noise_points_2d", "points"), &OpenSimplexNoise::get_noise_points_2d);
+	ClassDB::bind_method(D_METHOD("get_noise_points_3d", "points"), &OpenSimplexNoise::get_noise_points_3d);
+	ClassDB::bind_method(D_METHOD("get_noise_points_4d", "points"), &OpenSimplexNoise::get_noise_points_4d);
+
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "octaves", PROPERTY_HINT_RANGE, vformat("1,%d,1", MAX_OCTAVES)), "set_octaves", "get_octaves");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "period", PROPERTY_HINT_RANGE, "0.1,256.0,0.1"), "set_period", "get_period");
@@ -54,6 +54,41 @@ class OpenSimplexNoise : public Resource {
 	float period; // Distance above which we start to see similarities. The higher, the longer "hills" will be on a terrain.
 	float lacunarity; // Controls period change across octaves. 2 is usually a good value to address all detail levels.
 
+	// Batch evaluation splits the work in rows (or chunks of points) that run on the WorkerThreadPool.
+	struct GridJob {
+		int dimensions;
+		Vector3 from;
+		Vector3 step;
+		int width;
+		int height;
+		real_t *out;
+	};
+
+	struct PointsJob {
+		int dimensions;
+		int count;
+		const Vector2 *points_2d;
+		const Vector3 *points_3d;
+		const real_t *points_4d;
+		real_t *out;
+	};
+
+	struct ImageJob {
+		int width;
+		int height;
+		bool seamless;
+		uint8_t *out;
+	};
+
+	template <class T>
+	void _run_jobs(uint32_t p_count, uint32_t p_samples, void (OpenSimplexNoise::*p_method)(uint32_t, T *), T *p_job);
+
+	void _grid_row(uint32_t p_row, GridJob *p_job);
+	void _points_chunk(uint32_t p_chunk, PointsJob *p_job);
+	void _image_row(uint32_t p_row, ImageJob *p_job);
+
+	PoolRealArray _get_noise_points(PointsJob &p_job);
+
 public:
 	OpenSimplexNoise();
 	~OpenSimplexNoise();
@@ -83,6 +118,13 @@ public:
 	float get_noise_3d(float x, float y, float z);
 	float get_noise_4d(float x, float y, float z, float w);
 
+	PoolRealArray get_noise_grid_2d(const Vector2 &p_from, int p_width, int p_height, const Vector2 &p_step = Vector2(1, 1));
+	PoolRealArray get_noise_grid_3d(const Vector3 &p_from, int p_width, int p_height, int p_depth, const Vector3 &p_step = Vector3(1, 1, 1));
+
+	PoolRealArray get_noise_points_2d(const PoolVector2Array &p_points);
+	PoolRealArray get_noise_points_3d(const PoolVector3Array &p_points);
+	PoolRealArray get_noise_points_4d(const PoolRealArray &p_points);
+
 	_FORCE_INLINE_ float _get_octave_noise_2d(int octave, float x, float y) { return open_simplex_noise2(&(contexts[octave]), x, y); }
 	_FORCE_INLINE_ float _get_octave_noise_3d(int octave, float x, float y, float z) { return open_simplex_noise3(&(contexts[octave]), x, y, z); }
 	_FORCE_INLINE_ float _get_octave_noise_4d(int octave, float x, float y, float z, float w) { return open_simplex_noise4(&(contexts[octave]), x, y, z, w); }
@@ -31,7 +31,7 @@
 #include "navigation_mesh_generator.h"
 #include "core/math/quick_hull.h"
 #include "core/os/thread.h"
-#include "editor/editor_settings.h"
+#include "core/os/worker_thread_pool.h"
 #include "scene/3d/collision_shape.h"
 #include "scene/3d/mesh_instance.h"
 #include "scene/3d/physics_body.h"
@@ -55,6 +55,14 @@
 
 EditorNavigationMeshGenerator *EditorNavigationMeshGenerator::singleton = NULL;
 
+static void _progress_step(EditorProgress *p_ep, const String &p_state, int p_step) {
+#ifdef TOOLS_ENABLED
+	if (p_ep) {
+		p_ep->step(p_state, p_step);
+	}
+#endif
+}
+
 void EditorNavigationMeshGenerator::_add_vertex(const Vector3 &p_vec3, Vector<float> &p_verticies) {
 	p_verticies.push_back(p_vec3.x);
 	p_verticies.push_back(p_vec3.y);
@@ -270,15 +278,32 @@ void EditorNavigationMeshGenerator::_parse_geometry(Transform p_accumulated_tran
 	}
 }
 
-void EditorNavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
+void EditorNavigationMeshGenerator::_parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &r_vertices, Vector<int> &r_indices) {
 
-	PoolVector<Vector3> nav_vertices;
+	List<Node *> parse_nodes;
+
+	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
+		parse_nodes.push_back(p_node);
+	} else {
+		p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
+	}
 
+	Transform navmesh_xform = Object::cast_to<Spatial>(p_node)->get_transform().affine_inverse();
+	for (const List<Node *>::Element *E = parse_nodes.front(); E; E = E->next()) {
+		int geometry_type = p_nav_mesh->get_parsed_geometry_type();
+		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
+		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
+		_parse_geometry(navmesh_xform, E->get(), r_vertices, r_indices, geometry_type, collision_mask, recurse_children);
+	}
+}
+
+void EditorNavigationMeshGenerator::_append_detail_mesh(const rcPolyMeshDetail *p_detail_mesh, Vector<Vector3> &r_vertices, Vector<Vector<int> > &r_polygons) {
+
+	int base = r_vertices.size();
 	for (int i = 0; i < p_detail_mesh->nverts; i++) {
 		const float *v = &p_detail_mesh->verts[i * 3];
-		nav_vertices.append(Vector3(v[0], v[1], v[2]));
+		r_vertices.push_back(Vector3(v[0], v[1], v[2]));
 	}
-	p_nav_mesh->set_vertices(nav_vertices);
 
 	for (int i = 0; i < p_detail_mesh->nmeshes; i++) {
 		const unsigned int *m = &p_detail_mesh->meshes[i * 4];
@@ -290,19 +315,40 @@ void EditorNavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_me
 			Vector<int> nav_indices;
 			nav_indices.resize(3);
 			// Polygon order in recast is opposite than godot's
-			nav_indices.write[0] = ((int)(bverts + tris[j * 4 + 0]));
-			nav_indices.write[1] = ((int)(bverts + tris[j * 4 + 2]));
-			nav_indices.write[2] = ((int)(bverts + tris[j * 4 + 1]));
-			p_nav_mesh->add_polygon(nav_indices);
+			nav_indices.write[0] = base + ((int)(bverts + tris[j * 4 + 0]));
+			nav_indices.write[1] = base + ((int)(bverts + tris[j * 4 + 2]));
+			nav_indices.write[2] = base + ((int)(bverts + tris[j * 4 + 1]));
+			r_polygons.push_back(nav_indices);
 		}
 	}
 }
 
+void EditorNavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
+
+	Vector<Vector3> vertices;
+	Vector<Vector<int> > polygons;
+	_append_detail_mesh(p_detail_mesh, vertices, polygons);
+
+	PoolVector<Vector3> nav_vertices;
+	nav_vertices.resize(vertices.size());
+	{
+		PoolVector<Vector3>::Write w = nav_vertices.write();
+		for (int i = 0; i < vertices.size(); i++) {
+			w[i] = vertices[i];
+		}
+	}
+	p_nav_mesh->set_vertices(nav_vertices);
+
+	for (int i = 0; i < polygons.size(); i++) {
+		p_nav_mesh->add_polygon(polygons[i]);
+	}
+}
+
 void EditorNavigationMeshGenerator::_build_recast_navigation_mesh(Ref<NavigationMesh> p_nav_mesh, EditorProgress *ep,
 		rcHeightfield *hf, rcCompactHeightfield *chf, rcContourSet *cset, rcPolyMesh *poly_mesh, rcPolyMeshDetail *detail_mesh,
 		Vector<float> &vertices, Vector<int> &indices) {
 	rcContext ctx;
-	ep->step(TTR("Setting up Configuration..."), 1);
+	_progress_step(ep, TTR("Setting up Configuration..."), 1);
 
 	const float *verts = vertices.ptr();
 	const int nverts = vertices.size() / 3;
@@ -313,21 +359,7 @@ void EditorNavigationMeshGenerator::_build_recast_navigation_mesh(Ref<Navigation
 	rcCalcBounds(verts, nverts, bmin, bmax);
 
 	rcConfig cfg;
-	memset(&cfg, 0, sizeof(cfg));
-
-	cfg.cs = p_nav_mesh->get_cell_size();
-	cfg.ch = p_nav_mesh->get_cell_height();
-	cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
-	cfg.detailSampleDist = p_nav_mesh->get_detail_sample_distance() < 0.9f ? 0 : p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance();
-	cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+	_setup_config(p_nav_mesh, cfg);
 
 	cfg.bmin[0] = bmin[0];
 	cfg.bmin[1] = bmin[1];
@@ -336,16 +368,16 @@ void EditorNavigationMeshGenerator::_build_recast_navigation_mesh(Ref<Navigation
 	cfg.bmax[1] = bmax[1];
 	cfg.bmax[2] = bmax[2];
 
-	ep->step(TTR("Calculating grid size..."), 2);
+	_progress_step(ep, TTR("Calculating grid size..."), 2);
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
-	ep->step(TTR("Creating heightfield..."), 3);
+	_progress_step(ep, TTR("Creating heightfield..."), 3);
 	hf = rcAllocHeightfield();
 
 	ERR_FAIL_COND(!hf);
 	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
 
-	ep->step(TTR("Marking walkable triangles..."), 4);
+	_progress_step(ep, TTR("Marking walkable triangles..."), 4);
 	{
 		Vector<unsigned char> tri_areas;
 		tri_areas.resize(ntris);
@@ -365,7 +397,7 @@ void EditorNavigationMeshGenerator::_build_recast_navigation_mesh(Ref<Navigation
 	if (p_nav_mesh->get_filter_walkable_low_height_spans())
 		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
 
-	ep->step(TTR("Constructing compact heightfield..."), 5);
+	_progress_step(ep, TTR("Constructing compact heightfield..."), 5);
 
 	chf = rcAllocCompactHeightfield();
 
@@ -375,10 +407,10 @@ void EditorNavigationMeshGenerator::_build_recast_navigation_mesh(Ref<Navigation
 	rcFreeHeightField(hf);
 	hf = 0;
 
-	ep->step(TTR("Eroding walkable area..."), 6);
+	_progress_step(ep, TTR("Eroding walkable area..."), 6);
 	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
 
-	ep->step(TTR("Partitioning..."), 7);
+	_progress_step(ep, TTR("Partitioning..."), 7);
 	if (p_nav_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
 		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
 		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
@@ -388,14 +420,14 @@ void EditorNavigationMeshGenerator::_build_recast_navigation_mesh(Ref<Navigation
 		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, 0, cfg.minRegionArea));
 	}
 
-	ep->step(TTR("Creating contours..."), 8);
+	_progress_step(ep, TTR("Creating contours..."), 8);
 
 	cset = rcAllocContourSet();
 
 	ERR_FAIL_COND(!cset);
 	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
 
-	ep->step(TTR("Creating polymesh..."), 9);
+	_progress_step(ep, TTR("Creating polymesh..."), 9);
 
 	poly_mesh = rcAllocPolyMesh();
 	ERR_FAIL_COND(!poly_mesh);
@@ -410,7 +442,7 @@ void EditorNavigationMeshGenerator::_build_recast_navigation_mesh(Ref<Navigation
 	rcFreeContourSet(cset);
 	cset = 0;
 
-	ep->step(TTR("Converting to native navigation mesh..."), 10);
+	_progress_step(ep, TTR("Converting to native navigation mesh..."), 10);
 
 	_convert_detail_mesh_to_native_navigation_mesh(detail_mesh, p_nav_mesh);
 
@@ -420,6 +452,203 @@ void EditorNavigationMeshGenerator::_build_recast_navigation_mesh(Ref<Navigation
 	detail_mesh = 0;
 }
 
+void EditorNavigationMeshGenerator::_setup_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg) {
+
+	memset(&r_cfg, 0, sizeof(r_cfg));
+
+	r_cfg.cs = p_nav_mesh->get_cell_size();
+	r_cfg.ch = p_nav_mesh->get_cell_height();
+	r_cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
+	r_cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / r_cfg.ch);
+	r_cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / r_cfg.ch);
+	r_cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / r_cfg.cs);
+	r_cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
+	r_cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
+	r_cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
+	r_cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
+	r_cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
+	r_cfg.detailSampleDist = p_nav_mesh->get_detail_sample_distance() < 0.9f ? 0 : p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance();
+	r_cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+
+	if (p_nav_mesh->get_tile_size() > 0) {
+		//the border lets each tile see the geometry of its neighbours, so erosion and regions match at the seams
+		r_cfg.tileSize = p_nav_mesh->get_tile_size();
+		r_cfg.borderSize = r_cfg.walkableRadius + 3;
+		r_cfg.width = r_cfg.tileSize + r_cfg.borderSize * 2;
+		r_cfg.height = r_cfg.tileSize + r_cfg.borderSize * 2;
+	}
+}
+
+static bool _build_tile_mesh(rcContext *p_ctx, const rcConfig &p_cfg, int p_partition_type, bool p_filter_low_hanging_obstacles, bool p_filter_ledge_spans, bool p_filter_walkable_low_height_spans,
+		const float *p_verts, int p_nverts, const int *p_tris, const unsigned char *p_tri_areas, int p_ntris,
+		rcHeightfield *hf, rcCompactHeightfield *chf, rcContourSet *cset, rcPolyMesh *poly_mesh, rcPolyMeshDetail *detail_mesh) {
+
+	ERR_FAIL_COND_V(!rcCreateHeightfield(p_ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
+	ERR_FAIL_COND_V(!rcRasterizeTriangles(p_ctx, p_verts, p_nverts, p_tris, p_tri_areas, p_ntris, *hf, p_cfg.walkableClimb), false);
+
+	if (p_filter_low_hanging_obstacles)
+		rcFilterLowHangingWalkableObstacles(p_ctx, p_cfg.walkableClimb, *hf);
+	if (p_filter_ledge_spans)
+		rcFilterLedgeSpans(p_ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
+	if (p_filter_walkable_low_height_spans)
+		rcFilterWalkableLowHeightSpans(p_ctx, p_cfg.walkableHeight, *hf);
+
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(p_ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), false);
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(p_ctx, p_cfg.walkableRadius, *chf), false);
+
+	if (p_partition_type == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+		ERR_FAIL_COND_V(!rcBuildDistanceField(p_ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(p_ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
+	} else if (p_partition_type == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(p_ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
+	} else {
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(p_ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
+	}
+
+	ERR_FAIL_COND_V(!rcBuildContours(p_ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), false);
+	if (cset->nconts == 0) {
+		return false; //nothing walkable in this tile
+	}
+
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(p_ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(p_ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), false);
+
+	return true;
+}
+
+void EditorNavigationMeshGenerator::_build_tile(uint32_t p_index, TiledBake *p_bake) {
+
+	BakeTile &tile = p_bake->tiles[p_index];
+	if (tile.triangles.empty()) {
+		return;
+	}
+
+	rcConfig cfg = p_bake->cfg;
+	float border = cfg.borderSize * cfg.cs;
+	cfg.bmin[0] = tile.x * p_bake->tile_world_size - border;
+	cfg.bmin[1] = p_bake->min_y;
+	cfg.bmin[2] = tile.z * p_bake->tile_world_size - border;
+	cfg.bmax[0] = (tile.x + 1) * p_bake->tile_world_size + border;
+	cfg.bmax[1] = p_bake->max_y;
+	cfg.bmax[2] = (tile.z + 1) * p_bake->tile_world_size + border;
+
+	//gather the overlapping triangles so rasterization does not walk the whole geometry for every tile
+	int ntris = tile.triangles.size();
+	Vector<int> tris;
+	tris.resize(ntris * 3);
+	Vector<unsigned char> tri_areas;
+	tri_areas.resize(ntris);
+	{
+		int *tw = tris.ptrw();
+		unsigned char *aw = tri_areas.ptrw();
+		const int *tr = tile.triangles.ptr();
+		for (int i = 0; i < ntris; i++) {
+			int t = tr[i];
+			tw[i * 3 + 0] = p_bake->tris[t * 3 + 0];
+			tw[i * 3 + 1] = p_bake->tris[t * 3 + 1];
+			tw[i * 3 + 2] = p_bake->tris[t * 3 + 2];
+			aw[i] = p_bake->tri_areas[t];
+		}
+	}
+
+	rcContext ctx(false);
+	rcHeightfield *hf = rcAllocHeightfield();
+	rcCompactHeightfield *chf = rcAllocCompactHeightfield();
+	rcContourSet *cset = rcAllocContourSet();
+	rcPolyMesh *poly_mesh = rcAllocPolyMesh();
+	rcPolyMeshDetail *detail_mesh = rcAllocPolyMeshDetail();
+
+	if (hf && chf && cset && poly_mesh && detail_mesh) {
+		if (_build_tile_mesh(&ctx, cfg, p_bake->partition_type, p_bake->filter_low_hanging_obstacles, p_bake->filter_ledge_spans, p_bake->filter_walkable_low_height_spans,
+					p_bake->verts, p_bake->nverts, tris.ptr(), tri_areas.ptr(), ntris, hf, chf, cset, poly_mesh, detail_mesh)) {
+			_append_detail_mesh(detail_mesh, tile.vertices, tile.polygons);
+		}
+	}
+
+	rcFreeHeightField(hf);
+	rcFreeCompactHeightfield(chf);
+	rcFreeContourSet(cset);
+	rcFreePolyMesh(poly_mesh);
+	rcFreePolyMeshDetail(detail_mesh);
+}
+
+void EditorNavigationMeshGenerator::_bake_tiles(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices, int p_from_x, int p_from_z, int p_to_x, int p_to_z, Vector<BakeTile> &r_tiles) {
+
+	TiledBake bake;
+	_setup_config(p_nav_mesh, bake.cfg);
+	bake.tile_world_size = bake.cfg.tileSize * bake.cfg.cs;
+	bake.partition_type = p_nav_mesh->get_sample_partition_type();
+	bake.filter_low_hanging_obstacles = p_nav_mesh->get_filter_low_hanging_obstacles();
+	bake.filter_ledge_spans = p_nav_mesh->get_filter_ledge_spans();
+	bake.filter_walkable_low_height_spans = p_nav_mesh->get_filter_walkable_low_height_spans();
+
+	bake.verts = p_vertices.ptr();
+	bake.nverts = p_vertices.size() / 3;
+	bake.tris = p_indices.ptr();
+	int ntris = p_indices.size() / 3;
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(bake.verts, bake.nverts, bmin, bmax);
+	//snap the floor of the heightfield to the cell height, spans of tiles rebaked later then quantize the same way
+	bake.min_y = Math::floor(bmin[1] / bake.cfg.ch) * bake.cfg.ch;
+	bake.max_y = bmax[1];
+
+	int width = p_to_x - p_from_x + 1;
+	int depth = p_to_z - p_from_z + 1;
+	ERR_FAIL_COND(width <= 0 || depth <= 0);
+
+	r_tiles.resize(width * depth);
+	bake.tiles = r_tiles.ptrw();
+	for (int z = 0; z < depth; z++) {
+		for (int x = 0; x < width; x++) {
+			BakeTile &tile = bake.tiles[z * width + x];
+			tile.x = p_from_x + x;
+			tile.z = p_from_z + z;
+		}
+	}
+
+	Vector<unsigned char> tri_areas;
+	tri_areas.resize(ntris);
+	ERR_FAIL_COND(tri_areas.size() == 0);
+	memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
+	{
+		rcContext ctx;
+		rcMarkWalkableTriangles(&ctx, bake.cfg.walkableSlopeAngle, bake.verts, bake.nverts, bake.tris, ntris, tri_areas.ptrw());
+	}
+	bake.tri_areas = tri_areas.ptr();
+
+	float border = bake.cfg.borderSize * bake.cfg.cs;
+	for (int i = 0; i < ntris; i++) {
+		const float *a = &bake.verts[bake.tris[i * 3 + 0] * 3];
+		const float *b = &bake.verts[bake.tris[i * 3 + 1] * 3];
+		const float *c = &bake.verts[bake.tris[i * 3 + 2] * 3];
+
+		float min_x = MIN(a[0], MIN(b[0], c[0])) - border;
+		float max_x = MAX(a[0], MAX(b[0], c[0])) + border;
+		float min_z = MIN(a[2], MIN(b[2], c[2])) - border;
+		float max_z = MAX(a[2], MAX(b[2], c[2])) + border;
+
+		int tile_from_x = MAX(p_from_x, (int)Math::floor(min_x / bake.tile_world_size));
+		int tile_to_x = MIN(p_to_x, (int)Math::floor(max_x / bake.tile_world_size));
+		int tile_from_z = MAX(p_from_z, (int)Math::floor(min_z / bake.tile_world_size));
+		int tile_to_z = MIN(p_to_z, (int)Math::floor(max_z / bake.tile_world_size));
+
+		for (int z = tile_from_z; z <= tile_to_z; z++) {
+			for (int x = tile_from_x; x <= tile_to_x; x++) {
+				bake.tiles[(z - p_from_z) * width + (x - p_from_x)].triangles.push_back(i);
+			}
+		}
+	}
+
+	if (WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		WorkerThreadPool::get_singleton()->parallel_for(r_tiles.size(), this, &EditorNavigationMeshGenerator::_build_tile, &bake);
+	} else {
+		for (int i = 0; i < r_tiles.size(); i++) {
+			_build_tile(i, &bake);
+		}
+	}
+}
+
 EditorNavigationMeshGenerator *EditorNavigationMeshGenerator::get_singleton() {
 	return singleton;
 }
@@ -435,54 +664,208 @@ void EditorNavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p
 
 	ERR_FAIL_COND(!p_nav_mesh.is_valid());
 
-	EditorProgress ep("bake", TTR("Navigation Mesh Generator Setup:"), 11);
-	ep.step(TTR("Parsing Geometry..."), 0);
+	EditorProgress *ep = NULL;
+#ifdef TOOLS_ENABLED
+	if (EditorNode::get_singleton()) {
+		ep = memnew(EditorProgress("bake", TTR("Navigation Mesh Generator Setup:"), 11));
+	}
+#endif
+	_progress_step(ep, TTR("Parsing Geometry..."), 0);
 
 	Vector<float> vertices;
 	Vector<int> indices;
 
-	List<Node *> parse_nodes;
+	_parse_source_geometry(p_nav_mesh, p_node, vertices, indices);
 
-	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
-		parse_nodes.push_back(p_node);
-	} else {
-		p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
+	if (vertices.size() > 0 && indices.size() > 0) {
+
+		if (p_nav_mesh->get_tile_size() > 0) {
+
+			_progress_step(ep, TTR("Building tiles..."), 1);
+
+			float bmin[3], bmax[3];
+			rcCalcBounds(vertices.ptr(), vertices.size() / 3, bmin, bmax);
+
+			//tiles are laid on a grid anchored at the origin, so rebaking part of the mesh later finds the same tiles
+			float tile_world_size = p_nav_mesh->get_tile_size() * p_nav_mesh->get_cell_size();
+			Vector<BakeTile> tiles;
+			_bake_tiles(p_nav_mesh, vertices, indices,
+					(int)Math::floor(bmin[0] / tile_world_size), (int)Math::floor(bmin[2] / tile_world_size),
+					(int)Math::floor(bmax[0] / tile_world_size), (int)Math::floor(bmax[2] / tile_world_size), tiles);
+
+			_progress_step(ep, TTR("Converting to native navigation mesh..."), 10);
+
+			int vertex_count = 0;
+			for (int i = 0; i < tiles.size(); i++) {
+				vertex_count += tiles[i].vertices.size();
+			}
+
+			PoolVector<Vector3> nav_vertices;
+			nav_vertices.resize(vertex_count);
+			{
+				PoolVector<Vector3>::Write w = nav_vertices.write();
+				int idx = 0;
+				for (int i = 0; i < tiles.size(); i++) {
+					for (int j = 0; j < tiles[i].vertices.size(); j++) {
+						w[idx++] = tiles[i].vertices[j];
+					}
+				}
+			}
+			p_nav_mesh->set_vertices(nav_vertices);
+
+			int base = 0;
+			for (int i = 0; i < tiles.size(); i++) {
+				const BakeTile &tile = tiles[i];
+				for (int j = 0; j < tile.polygons.size(); j++) {
+					Vector<int> polygon = tile.polygons[j];
+					for (int k = 0; k < polygon.size(); k++) {
+						polygon.write[k] += base;
+					}
+					p_nav_mesh->add_polygon(polygon);
+				}
+				base += tile.vertices.size();
+			}
+
+		} else {
+
+			rcHeightfield *hf = NULL;
+			rcCompactHeightfield *chf = NULL;
+			rcContourSet *cset = NULL;
+			rcPolyMesh *poly_mesh = NULL;
+			rcPolyMeshDetail *detail_mesh = NULL;
+
+			_build_recast_navigation_mesh(p_nav_mesh, ep, hf, chf, cset, poly_mesh, detail_mesh, vertices, indices);
+
+			rcFreeHeightField(hf);
+			hf = 0;
+
+			rcFreeCompactHeightfield(chf);
+			chf = 0;
+
+			rcFreeContourSet(cset);
+			cset = 0;
+
+			rcFreePolyMesh(poly_mesh);
+			poly_mesh = 0;
+
+			rcFreePolyMeshDetail(detail_mesh);
+			detail_mesh = 0;
+		}
 	}
+	_progress_step(ep, TTR("Done!"), 11);
 
-	Transform navmesh_xform = Object::cast_to<Spatial>(p_node)->get_transform().affine_inverse();
-	for (const List<Node *>::Element *E = parse_nodes.front(); E; E = E->next()) {
-		int geometry_type = p_nav_mesh->get_parsed_geometry_type();
-		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
-		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
-		_parse_geometry(navmesh_xform, E->get(), vertices, indices, geometry_type, collision_mask, recurse_children);
+#ifdef TOOLS_ENABLED
+	if (ep) {
+		memdelete(ep);
 	}
+#endif
+}
+
+void EditorNavigationMeshGenerator::rebake_tiles(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB &p_changed_aabb) {
 
+	ERR_FAIL_COND(!p_nav_mesh.is_valid());
+	ERR_FAIL_COND_MSG(p_nav_mesh->get_tile_size() <= 0, "Only navigation meshes with a tile size can rebake tiles.");
+
+	Vector<float> vertices;
+	Vector<int> indices;
+
+	_parse_source_geometry(p_nav_mesh, p_node, vertices, indices);
+
+	rcConfig cfg;
+	_setup_config(p_nav_mesh, cfg);
+	float tile_world_size = cfg.tileSize * cfg.cs;
+
+	//a change also alters erosion and regions of the neighbouring tiles that see it through their border
+	float border = cfg.borderSize * cfg.cs;
+	Vector3 from = p_changed_aabb.position;
+	Vector3 to = p_changed_aabb.position + p_changed_aabb.size;
+	int from_x = (int)Math::floor((from.x - border) / tile_world_size);
+	int from_z = (int)Math::floor((from.z - border) / tile_world_size);
+	int to_x = (int)Math::floor((to.x + border) / tile_world_size);
+	int to_z = (int)Math::floor((to.z + border) / tile_world_size);
+
+	Vector<BakeTile> tiles;
 	if (vertices.size() > 0 && indices.size() > 0) {
+		_bake_tiles(p_nav_mesh, vertices, indices, from_x, from_z, to_x, to_z, tiles);
+	}
+
+	//drop the polygons of the rebuilt tiles, tile polygons never cross the tile edges so their center tells the tile they belong to
+	PoolVector<Vector3> old_vertices = p_nav_mesh->get_vertices();
+	PoolVector<Vector3>::Read r = old_vertices.read();
 
-		rcHeightfield *hf = NULL;
-		rcCompactHeightfield *chf = NULL;
-		rcContourSet *cset = NULL;
-		rcPolyMesh *poly_mesh = NULL;
-		rcPolyMeshDetail *detail_mesh = NULL;
+	Vector<int> remap;
+	remap.resize(old_vertices.size());
+	for (int i = 0; i < remap.size(); i++) {
+		remap.write[i] = -1;
+	}
 
-		_build_recast_navigation_mesh(p_nav_mesh, &ep, hf, chf, cset, poly_mesh, detail_mesh, vertices, indices);
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int> > nav_polygons;
 
-		rcFreeHeightField(hf);
-		hf = 0;
+	for (int i = 0; i < p_nav_mesh->get_polygon_count(); i++) {
+		Vector<int> polygon = p_nav_mesh->get_polygon(i);
+		if (polygon.empty()) {
+			continue;
+		}
 
-		rcFreeCompactHeightfield(chf);
-		chf = 0;
+		Vector3 center;
+		bool valid = true;
+		for (int j = 0; j < polygon.size(); j++) {
+			if (polygon[j] < 0 || polygon[j] >= old_vertices.size()) {
+				valid = false;
+				break;
+			}
+			center += r[polygon[j]];
+		}
+		ERR_CONTINUE(!valid);
+		center /= polygon.size();
 
-		rcFreeContourSet(cset);
-		cset = 0;
+		int x = (int)Math::floor(center.x / tile_world_size);
+		int z = (int)Math::floor(center.z / tile_world_size);
+		if (x >= from_x && x <= to_x && z >= from_z && z <= to_z) {
+			continue;
+		}
 
-		rcFreePolyMesh(poly_mesh);
-		poly_mesh = 0;
+		for (int j = 0; j < polygon.size(); j++) {
+			int &idx = remap.write[polygon[j]];
+			if (idx == -1) {
+				idx = nav_vertices.size();
+				nav_vertices.push_back(r[polygon[j]]);
+			}
+			polygon.write[j] = idx;
+		}
+		nav_polygons.push_back(polygon);
+	}
+
+	for (int i = 0; i < tiles.size(); i++) {
+		const BakeTile &tile = tiles[i];
+		int base = nav_vertices.size();
+		for (int j = 0; j < tile.vertices.size(); j++) {
+			nav_vertices.push_back(tile.vertices[j]);
+		}
+		for (int j = 0; j < tile.polygons.size(); j++) {
+			Vector<int> polygon = tile.polygons[j];
+			for (int k = 0; k < polygon.size(); k++) {
+				polygon.write[k] += base;
+			}
+			nav_polygons.push_back(polygon);
+		}
+	}
+
+	PoolVector<Vector3> result;
+	result.resize(nav_vertices.size());
+	{
+		PoolVector<Vector3>::Write w = result.write();
+		for (int i = 0; i < nav_vertices.size(); i++) {
+			w[i] = nav_vertices[i];
+		}
+	}
 
-		rcFreePolyMeshDetail(detail_mesh);
-		detail_mesh = 0;
+	p_nav_mesh->clear_polygons();
+	p_nav_mesh->set_vertices(result);
+	for (int i = 0; i < nav_polygons.size(); i++) {
+		p_nav_mesh->add_polygon(nav_polygons[i]);
 	}
-	ep.step(TTR("Done!"), 11);
 }
 
 void EditorNavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
@@ -494,5 +877,6 @@ void EditorNavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 
 void EditorNavigationMeshGenerator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bake", "nav_mesh", "root_node"), &EditorNavigationMeshGenerator::bake);
+	ClassDB::bind_method(D_METHOD("rebake_tiles", "nav_mesh", "root_node", "changed_aabb"), &EditorNavigationMeshGenerator::rebake_tiles);
 	ClassDB::bind_method(D_METHOD("clear", "nav_mesh"), &EditorNavigationMeshGenerator::clear);
 }
@@ -31,9 +31,14 @@
 #ifndef NAVIGATION_MESH_GENERATOR_H
 #define NAVIGATION_MESH_GENERATOR_H
 
-#include "editor/editor_node.h"
 #include "scene/3d/navigation_mesh.h"
 
+#ifdef TOOLS_ENABLED
+#include "editor/editor_node.h"
+#else
+struct EditorProgress;
+#endif
+
 #include <Recast.h>
 
 class EditorNavigationMeshGenerator : public Object {
@@ -41,6 +46,34 @@ class EditorNavigationMeshGenerator : public Object {
 
 	static EditorNavigationMeshGenerator *singleton;
 
+	struct BakeTile {
+		int x;
+		int z;
+		Vector<int> triangles; //indices of the source triangles overlapping the tile and its border
+		Vector<Vector3> vertices;
+		Vector<Vector<int> > polygons;
+	};
+
+	struct TiledBake {
+		rcConfig cfg; //shared settings, bounds and size are set per tile
+		float tile_world_size; //tile_size * cell_size
+		float min_y;
+		float max_y;
+		int partition_type;
+		bool filter_low_hanging_obstacles;
+		bool filter_ledge_spans;
+		bool filter_walkable_low_height_spans;
+
+		const float *verts;
+		int nverts;
+		const int *tris;
+		const unsigned char *tri_areas;
+		BakeTile *tiles;
+	};
+
+	void _build_tile(uint32_t p_index, TiledBake *p_bake);
+	void _bake_tiles(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices, int p_from_x, int p_from_z, int p_to_x, int p_to_z, Vector<BakeTile> &r_tiles);
+
 protected:
 	static void _bind_methods();
 
@@ -48,6 +81,10 @@ protected:
 	static void _add_mesh(const Ref<Mesh> &p_mesh, const Transform &p_xform, Vector<float> &p_verticies, Vector<int> &p_indices);
 	static void _add_faces(const PoolVector3Array &p_faces, const Transform &p_xform, Vector<float> &p_verticies, Vector<int> &p_indices);
 	static void _parse_geometry(Transform p_accumulated_transform, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices, int p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
+	static void _parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &r_vertices, Vector<int> &r_indices);
+
+	static void _setup_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg);
+	static void _append_detail_mesh(const rcPolyMeshDetail *p_detail_mesh, Vector<Vector3> &r_vertices, Vector<Vector<int> > &r_polygons);
 
 	static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh);
 	static void _build_recast_navigation_mesh(Ref<NavigationMesh> p_nav_mesh, EditorProgress *ep,
@@ -61,6 +98,7 @@ public:
 	~EditorNavigationMeshGenerator();
 
 	void bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node);
+	void rebake_tiles(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB &p_changed_aabb);
 	void clear(Ref<NavigationMesh> p_nav_mesh);
 };
 
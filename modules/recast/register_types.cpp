@@ -30,32 +30,35 @@
 
 #include "register_types.h"
 
-#include "navigation_mesh_editor_plugin.h"
+#include "core/engine.h"
+#include "navigation_mesh_generator.h"
 
 #ifdef TOOLS_ENABLED
-EditorNavigationMeshGenerator *_nav_mesh_generator = NULL;
+#include "navigation_mesh_editor_plugin.h"
 #endif
 
-void register_recast_types() {
-#ifdef TOOLS_ENABLED
-	ClassDB::APIType prev_api = ClassDB::get_current_api();
-	ClassDB::set_current_api(ClassDB::API_EDITOR);
+EditorNavigationMeshGenerator *_nav_mesh_generator = NULL;
 
-	EditorPlugins::add_by_type<NavigationMeshEditorPlugin>();
+void register_recast_types() {
+	//the generator is also available in exported projects, so navigation can be rebaked at runtime
 	_nav_mesh_generator = memnew(EditorNavigationMeshGenerator);
 
 	ClassDB::register_class<EditorNavigationMeshGenerator>();
 
 	Engine::get_singleton()->add_singleton(Engine::Singleton("NavigationMeshGenerator", EditorNavigationMeshGenerator::get_singleton()));
 
+#ifdef TOOLS_ENABLED
+	ClassDB::APIType prev_api = ClassDB::get_current_api();
+	ClassDB::set_current_api(ClassDB::API_EDITOR);
+
+	EditorPlugins::add_by_type<NavigationMeshEditorPlugin>();
+
 	ClassDB::set_current_api(prev_api);
 #endif
 }
 
 void unregister_recast_types() {
-#ifdef TOOLS_ENABLED
 	if (_nav_mesh_generator) {
 		memdelete(_nav_mesh_generator);
 	}
-#endif
 }
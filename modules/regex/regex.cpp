@@ -178,6 +178,11 @@ void RegEx::clear() {
 
 	if (sizeof(CharType) == 2) {
 
+		if (match_data) {
+			pcre2_match_data_free_16((pcre2_match_data_16 *)match_data);
+			match_data = NULL;
+		}
+
 		if (code) {
 			pcre2_code_free_16((pcre2_code_16 *)code);
 			code = NULL;
@@ -185,6 +190,11 @@ void RegEx::clear() {
 
 	} else {
 
+		if (match_data) {
+			pcre2_match_data_free_32((pcre2_match_data_32 *)match_data);
+			match_data = NULL;
+		}
+
 		if (code) {
 			pcre2_code_free_32((pcre2_code_32 *)code);
 			code = NULL;
@@ -219,6 +229,10 @@ Error RegEx::compile(const String &p_pattern) {
 			return FAILED;
 		}
 
+		// fails harmlessly when pcre2 was built without jit support, matching then falls back to the interpreter
+		pcre2_jit_compile_16((pcre2_code_16 *)code, PCRE2_JIT_COMPLETE);
+		match_data = pcre2_match_data_create_from_pattern_16((pcre2_code_16 *)code, gctx);
+
 	} else {
 
 		pcre2_general_context_32 *gctx = (pcre2_general_context_32 *)general_ctx;
@@ -236,81 +250,88 @@ Error RegEx::compile(const String &p_pattern) {
 			ERR_PRINT(message.utf8());
 			return FAILED;
 		}
+
+		pcre2_jit_compile_32((pcre2_code_32 *)code, PCRE2_JIT_COMPLETE);
+		match_data = pcre2_match_data_create_from_pattern_32((pcre2_code_32 *)code, gctx);
 	}
 	return OK;
 }
 
-Ref<RegExMatch> RegEx::search(const String &p_subject, int p_offset, int p_end) const {
+void *RegEx::_acquire_match_data() const {
 
-	ERR_FAIL_COND_V(!is_valid(), NULL);
+	// the cached match data is handed out to one caller at a time, concurrent searches get their own
+	if (!match_data_busy.test_and_set())
+		return match_data;
 
-	Ref<RegExMatch> result = memnew(RegExMatch);
+	if (sizeof(CharType) == 2) {
 
-	int length = p_subject.length();
-	if (p_end >= 0 && p_end < length)
-		length = p_end;
+		return pcre2_match_data_create_from_pattern_16((pcre2_code_16 *)code, (pcre2_general_context_16 *)general_ctx);
 
-	if (sizeof(CharType) == 2) {
+	} else {
 
-		pcre2_code_16 *c = (pcre2_code_16 *)code;
-		pcre2_general_context_16 *gctx = (pcre2_general_context_16 *)general_ctx;
-		pcre2_match_context_16 *mctx = pcre2_match_context_create_16(gctx);
-		PCRE2_SPTR16 s = (PCRE2_SPTR16)p_subject.c_str();
+		return pcre2_match_data_create_from_pattern_32((pcre2_code_32 *)code, (pcre2_general_context_32 *)general_ctx);
+	}
+}
 
-		pcre2_match_data_16 *match = pcre2_match_data_create_from_pattern_16(c, gctx);
+void RegEx::_release_match_data(void *p_match_data) const {
 
-		int res = pcre2_match_16(c, s, length, p_offset, 0, match, mctx);
+	if (p_match_data == match_data) {
+		match_data_busy.clear();
+		return;
+	}
 
-		if (res < 0) {
-			pcre2_match_data_free_16(match);
-			return NULL;
-		}
+	if (sizeof(CharType) == 2) {
 
-		uint32_t size = pcre2_get_ovector_count_16(match);
-		PCRE2_SIZE *ovector = pcre2_get_ovector_pointer_16(match);
+		pcre2_match_data_free_16((pcre2_match_data_16 *)p_match_data);
 
-		result->data.resize(size);
+	} else {
+
+		pcre2_match_data_free_32((pcre2_match_data_32 *)p_match_data);
+	}
+}
 
-		for (uint32_t i = 0; i < size; i++) {
+int RegEx::_match(const String &p_subject, int p_offset, int p_end, void *p_match_data) const {
 
-			result->data.write[i].start = ovector[i * 2];
-			result->data.write[i].end = ovector[i * 2 + 1];
-		}
+	int length = p_subject.length();
+	if (p_end >= 0 && p_end < length)
+		length = p_end;
 
-		pcre2_match_data_free_16(match);
-		pcre2_match_context_free_16(mctx);
+	if (sizeof(CharType) == 2) {
+
+		PCRE2_SPTR16 s = (PCRE2_SPTR16)p_subject.c_str();
+		return pcre2_match_16((pcre2_code_16 *)code, s, length, p_offset, 0, (pcre2_match_data_16 *)p_match_data, (pcre2_match_context_16 *)match_ctx);
 
 	} else {
 
-		pcre2_code_32 *c = (pcre2_code_32 *)code;
-		pcre2_general_context_32 *gctx = (pcre2_general_context_32 *)general_ctx;
-		pcre2_match_context_32 *mctx = pcre2_match_context_create_32(gctx);
 		PCRE2_SPTR32 s = (PCRE2_SPTR32)p_subject.c_str();
+		return pcre2_match_32((pcre2_code_32 *)code, s, length, p_offset, 0, (pcre2_match_data_32 *)p_match_data, (pcre2_match_context_32 *)match_ctx);
+	}
+}
 
-		pcre2_match_data_32 *match = pcre2_match_data_create_from_pattern_32(c, gctx);
+Ref<RegExMatch> RegEx::_make_match(const String &p_subject, void *p_match_data) const {
 
-		int res = pcre2_match_32(c, s, length, p_offset, 0, match, mctx);
+	Ref<RegExMatch> result = memnew(RegExMatch);
 
-		if (res < 0) {
-			pcre2_match_data_free_32(match);
-			pcre2_match_context_free_32(mctx);
+	uint32_t size;
+	PCRE2_SIZE *ovector;
 
-			return NULL;
-		}
+	if (sizeof(CharType) == 2) {
 
-		uint32_t size = pcre2_get_ovector_count_32(match);
-		PCRE2_SIZE *ovector = pcre2_get_ovector_pointer_32(match);
+		size = pcre2_get_ovector_count_16((pcre2_match_data_16 *)p_match_data);
+		ovector = pcre2_get_ovector_pointer_16((pcre2_match_data_16 *)p_match_data);
 
-		result->data.resize(size);
+	} else {
 
-		for (uint32_t i = 0; i < size; i++) {
+		size = pcre2_get_ovector_count_32((pcre2_match_data_32 *)p_match_data);
+		ovector = pcre2_get_ovector_pointer_32((pcre2_match_data_32 *)p_match_data);
+	}
 
-			result->data.write[i].start = ovector[i * 2];
-			result->data.write[i].end = ovector[i * 2 + 1];
-		}
+	result->data.resize(size);
 
-		pcre2_match_data_free_32(match);
-		pcre2_match_context_free_32(mctx);
+	for (uint32_t i = 0; i < size; i++) {
+
+		result->data.write[i].start = ovector[i * 2];
+		result->data.write[i].end = ovector[i * 2 + 1];
 	}
 
 	result->subject = p_subject;
@@ -338,18 +359,66 @@ Ref<RegExMatch> RegEx::search(const String &p_subject, int p_offset, int p_end)
 	return result;
 }
 
+Ref<RegExMatch> RegEx::search(const String &p_subject, int p_offset, int p_end) const {
+
+	ERR_FAIL_COND_V(!is_valid(), NULL);
+
+	void *md = _acquire_match_data();
+
+	Ref<RegExMatch> result;
+	if (_match(p_subject, p_offset, p_end, md) >= 0)
+		result = _make_match(p_subject, md);
+
+	_release_match_data(md);
+
+	return result;
+}
+
 Array RegEx::search_all(const String &p_subject, int p_offset, int p_end) const {
 
-	int last_end = -1;
 	Array result;
-	Ref<RegExMatch> match = search(p_subject, p_offset, p_end);
-	while (match.is_valid()) {
-		if (last_end == match->get_end(0))
+
+	ERR_FAIL_COND_V(!is_valid(), result);
+
+	void *md = _acquire_match_data();
+
+	int last_end = -1;
+	int offset = p_offset;
+	while (_match(p_subject, offset, p_end, md) >= 0) {
+		Ref<RegExMatch> match = _make_match(p_subject, md);
+		int end = match->get_end(0);
+		if (last_end == end)
 			break;
 		result.push_back(match);
-		last_end = match->get_end(0);
-		match = search(p_subject, match->get_end(0), p_end);
+		last_end = end;
+		offset = end;
 	}
+
+	_release_match_data(md);
+
+	return result;
+}
+
+Array RegEx::search_array(const PoolStringArray &p_subjects) const {
+
+	Array result;
+
+	ERR_FAIL_COND_V(!is_valid(), result);
+
+	int size = p_subjects.size();
+	result.resize(size);
+
+	void *md = _acquire_match_data();
+
+	PoolStringArray::Read r = p_subjects.read();
+	for (int i = 0; i < size; i++) {
+
+		if (_match(r[i], 0, -1, md) >= 0)
+			result[i] = _make_match(r[i], md);
+	}
+
+	_release_match_data(md);
+
 	return result;
 }
 
@@ -375,16 +444,17 @@ String RegEx::sub(const String &p_subject, const String &p_replacement, bool p_a
 	if (p_end >= 0 && (uint32_t)p_end < length)
 		length = p_end;
 
+	void *md = _acquire_match_data();
+
 	if (sizeof(CharType) == 2) {
 
 		pcre2_code_16 *c = (pcre2_code_16 *)code;
-		pcre2_general_context_16 *gctx = (pcre2_general_context_16 *)general_ctx;
-		pcre2_match_context_16 *mctx = pcre2_match_context_create_16(gctx);
+		pcre2_match_context_16 *mctx = (pcre2_match_context_16 *)match_ctx;
 		PCRE2_SPTR16 s = (PCRE2_SPTR16)p_subject.c_str();
 		PCRE2_SPTR16 r = (PCRE2_SPTR16)p_replacement.c_str();
 		PCRE2_UCHAR16 *o = (PCRE2_UCHAR16 *)output.ptrw();
 
-		pcre2_match_data_16 *match = pcre2_match_data_create_from_pattern_16(c, gctx);
+		pcre2_match_data_16 *match = (pcre2_match_data_16 *)md;
 
 		int res = pcre2_substitute_16(c, s, length, p_offset, flags, match, mctx, r, p_replacement.length(), o, &olength);
 
@@ -394,8 +464,7 @@ String RegEx::sub(const String &p_subject, const String &p_replacement, bool p_a
 			res = pcre2_substitute_16(c, s, length, p_offset, flags, match, mctx, r, p_replacement.length(), o, &olength);
 		}
 
-		pcre2_match_data_free_16(match);
-		pcre2_match_context_free_16(mctx);
+		_release_match_data(md);
 
 		if (res < 0)
 			return String();
@@ -403,13 +472,12 @@ String RegEx::sub(const String &p_subject, const String &p_replacement, bool p_a
 	} else {
 
 		pcre2_code_32 *c = (pcre2_code_32 *)code;
-		pcre2_general_context_32 *gctx = (pcre2_general_context_32 *)general_ctx;
-		pcre2_match_context_32 *mctx = pcre2_match_context_create_32(gctx);
+		pcre2_match_context_32 *mctx = (pcre2_match_context_32 *)match_ctx;
 		PCRE2_SPTR32 s = (PCRE2_SPTR32)p_subject.c_str();
 		PCRE2_SPTR32 r = (PCRE2_SPTR32)p_replacement.c_str();
 		PCRE2_UCHAR32 *o = (PCRE2_UCHAR32 *)output.ptrw();
 
-		pcre2_match_data_32 *match = pcre2_match_data_create_from_pattern_32(c, gctx);
+		pcre2_match_data_32 *match = (pcre2_match_data_32 *)md;
 
 		int res = pcre2_substitute_32(c, s, length, p_offset, flags, match, mctx, r, p_replacement.length(), o, &olength);
 
@@ -419,8 +487,7 @@ String RegEx::sub(const String &p_subject, const String &p_replacement, bool p_a
 			res = pcre2_substitute_32(c, s, length, p_offset, flags, match, mctx, r, p_replacement.length(), o, &olength);
 		}
 
-		pcre2_match_data_free_32(match);
-		pcre2_match_context_free_32(mctx);
+		_release_match_data(md);
 
 		if (res < 0)
 			return String();
@@ -480,12 +547,16 @@ RegEx::RegEx() {
 	if (sizeof(CharType) == 2) {
 
 		general_ctx = pcre2_general_context_create_16(&_regex_malloc, &_regex_free, NULL);
+		match_ctx = pcre2_match_context_create_16((pcre2_general_context_16 *)general_ctx);
 
 	} else {
 
 		general_ctx = pcre2_general_context_create_32(&_regex_malloc, &_regex_free, NULL);
+		match_ctx = pcre2_match_context_create_32((pcre2_general_context_32 *)general_ctx);
 	}
 	code = NULL;
+	match_data = NULL;
+	match_data_busy.clear();
 }
 
 RegEx::RegEx(const String &p_pattern) {
@@ -493,12 +564,16 @@ RegEx::RegEx(const String &p_pattern) {
 	if (sizeof(CharType) == 2) {
 
 		general_ctx = pcre2_general_context_create_16(&_regex_malloc, &_regex_free, NULL);
+		match_ctx = pcre2_match_context_create_16((pcre2_general_context_16 *)general_ctx);
 
 	} else {
 
 		general_ctx = pcre2_general_context_create_32(&_regex_malloc, &_regex_free, NULL);
+		match_ctx = pcre2_match_context_create_32((pcre2_general_context_32 *)general_ctx);
 	}
 	code = NULL;
+	match_data = NULL;
+	match_data_busy.clear();
 	compile(p_pattern);
 }
 
@@ -506,14 +581,20 @@ RegEx::~RegEx() {
 
 	if (sizeof(CharType) == 2) {
 
+		if (match_data)
+			pcre2_match_data_free_16((pcre2_match_data_16 *)match_data);
 		if (code)
 			pcre2_code_free_16((pcre2_code_16 *)code);
+		pcre2_match_context_free_16((pcre2_match_context_16 *)match_ctx);
 		pcre2_general_context_free_16((pcre2_general_context_16 *)general_ctx);
 
 	} else {
 
+		if (match_data)
+			pcre2_match_data_free_32((pcre2_match_data_32 *)match_data);
 		if (code)
 			pcre2_code_free_32((pcre2_code_32 *)code);
+		pcre2_match_context_free_32((pcre2_match_context_32 *)match_ctx);
 		pcre2_general_context_free_32((pcre2_general_context_32 *)general_ctx);
 	}
 }
@@ -524,6 +605,7 @@ void RegEx::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("compile", "pattern"), &RegEx::compile);
 	ClassDB::bind_method(D_METHOD("search", "subject", "offset", "end"), &RegEx::search, DEFVAL(0), DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("search_all", "subject", "offset", "end"), &RegEx::search_all, DEFVAL(0), DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("search_array", "subjects"), &RegEx::search_array);
 	ClassDB::bind_method(D_METHOD("sub", "subject", "replacement", "all", "offset", "end"), &RegEx::sub, DEFVAL(false), DEFVAL(0), DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("is_valid"), &RegEx::is_valid);
 	ClassDB::bind_method(D_METHOD("get_pattern"), &RegEx::get_pattern);
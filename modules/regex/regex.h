@@ -35,6 +35,7 @@
 #include "core/dictionary.h"
 #include "core/map.h"
 #include "core/reference.h"
+#include "core/safe_refcount.h"
 #include "core/ustring.h"
 #include "core/vector.h"
 
@@ -74,11 +75,19 @@ class RegEx : public Reference {
 	GDCLASS(RegEx, Reference);
 
 	void *general_ctx;
+	void *match_ctx;
 	void *code;
+	void *match_data;
+	mutable SafeFlag match_data_busy;
 	String pattern;
 
 	void _pattern_info(uint32_t what, void *where) const;
 
+	void *_acquire_match_data() const;
+	void _release_match_data(void *p_match_data) const;
+	int _match(const String &p_subject, int p_offset, int p_end, void *p_match_data) const;
+	Ref<RegExMatch> _make_match(const String &p_subject, void *p_match_data) const;
+
 protected:
 	static void _bind_methods();
 
@@ -89,6 +98,7 @@ public:
 
 	Ref<RegExMatch> search(const String &p_subject, int p_offset = 0, int p_end = -1) const;
 	Array search_all(const String &p_subject, int p_offset = 0, int p_end = -1) const;
+	Array search_array(const PoolStringArray &p_subjects) const;
 	String sub(const String &p_subject, const String &p_replacement, bool p_all = false, int p_offset = 0, int p_end = -1) const;
 
 	bool is_valid() const;
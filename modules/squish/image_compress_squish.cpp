@@ -30,8 +30,36 @@
 
 #include "image_compress_squish.h"
 
+#include "core/os/worker_thread_pool.h"
+
 #include <squish.h>
 
+#define SQUISH_BLOCK_ROWS_PER_TASK 4
+
+struct SquishCompressTask {
+	const uint8_t *src;
+	uint8_t *dst;
+	int width;
+	int height;
+	int y_start;
+};
+
+struct SquishCompressJob {
+	const SquishCompressTask *tasks;
+	int flags;
+
+	void compress_task(uint32_t p_index, void *) {
+
+		//a band of block rows is compressed as an image of its own
+		const SquishCompressTask &task = tasks[p_index];
+		int bytes_per_block = (flags & (squish::kDxt3 | squish::kDxt5 | squish::kBc5)) ? 16 : 8;
+		int rows = MIN(task.height - task.y_start, SQUISH_BLOCK_ROWS_PER_TASK * 4);
+		uint8_t *dst = task.dst + (task.y_start / 4) * ((task.width + 3) / 4) * bytes_per_block;
+
+		squish::CompressImage(task.src + task.y_start * task.width * 4, task.width, rows, task.width * 4, dst, flags);
+	}
+};
+
 void image_decompress_squish(Image *p_image) {
 	int w = p_image->get_width();
 	int h = p_image->get_height();
@@ -184,18 +212,43 @@ void image_compress_squish(Image *p_image, float p_lossy_quality, Image::Compres
 
 		int dst_ofs = 0;
 
+		//bands of block rows of all mipmap levels are compressed together on the worker pool
+		Vector<SquishCompressTask> tasks;
+
 		for (int i = 0; i <= mm_count; i++) {
 
 			int bw = w % 4 != 0 ? w + (4 - w % 4) : w;
 			int bh = h % 4 != 0 ? h + (4 - h % 4) : h;
 
 			int src_ofs = p_image->get_mipmap_offset(i);
-			squish::CompressImage(&rb[src_ofs], w, h, &wb[dst_ofs], squish_comp);
+
+			for (int y_start = 0; y_start < h; y_start += SQUISH_BLOCK_ROWS_PER_TASK * 4) {
+				SquishCompressTask task;
+				task.src = &rb[src_ofs];
+				task.dst = &wb[dst_ofs];
+				task.width = w;
+				task.height = h;
+				task.y_start = y_start;
+				tasks.push_back(task);
+			}
+
 			dst_ofs += (MAX(4, bw) * MAX(4, bh)) >> shift;
 			w = MAX(w / 2, 1);
 			h = MAX(h / 2, 1);
 		}
 
+		SquishCompressJob job;
+		job.tasks = tasks.ptr();
+		job.flags = squish_comp;
+
+		if (tasks.size() > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+			WorkerThreadPool::get_singleton()->parallel_for(tasks.size(), &job, &SquishCompressJob::compress_task, (void *)NULL);
+		} else {
+			for (int i = 0; i < tasks.size(); i++) {
+				job.compress_task(i, NULL);
+			}
+		}
+
 		rb.release();
 		wb.release();
 
@@ -30,12 +30,18 @@
 
 #include "audio_stream_ogg_vorbis.h"
 
+#include "core/io/marshalls.h"
 #include "core/os/file_access.h"
 
 void AudioStreamPlaybackOGGVorbis::_mix_internal(AudioFrame *p_buffer, int p_frames) {
 
 	ERR_FAIL_COND(!active);
 
+	if (seek_pending) {
+		stb_vorbis_seek(ogg_stream, frames_mixed);
+		seek_pending = false;
+	}
+
 	int todo = p_frames;
 
 	int start_buffer = 0;
@@ -116,6 +122,31 @@ void AudioStreamPlaybackOGGVorbis::seek(float p_time) {
 	frames_mixed = uint32_t(vorbis_stream->sample_rate * p_time);
 
 	stb_vorbis_seek(ogg_stream, frames_mixed);
+	seek_pending = false;
+}
+
+void AudioStreamPlaybackOGGVorbis::skip(float p_time) {
+
+	if (!active)
+		return;
+
+	//seeking decodes from the nearest page, so only do it once mixing resumes
+	uint64_t length = uint64_t(vorbis_stream->length * vorbis_stream->sample_rate);
+	uint64_t pos = frames_mixed + uint64_t(p_time * vorbis_stream->sample_rate);
+
+	if (pos >= length) {
+		uint64_t loop_begin = uint64_t(vorbis_stream->loop_offset * vorbis_stream->sample_rate);
+		if (!vorbis_stream->loop || loop_begin >= length) {
+			active = false;
+			return;
+		}
+		uint64_t loop_len = length - loop_begin;
+		loops += 1 + (pos - length) / loop_len;
+		pos = loop_begin + (pos - length) % loop_len;
+	}
+
+	frames_mixed = pos;
+	seek_pending = true;
 }
 
 AudioStreamPlaybackOGGVorbis::~AudioStreamPlaybackOGGVorbis() {
@@ -125,8 +156,434 @@ AudioStreamPlaybackOGGVorbis::~AudioStreamPlaybackOGGVorbis() {
 	}
 }
 
+bool AudioStreamPlaybackOGGVorbisStream::_feed() {
+
+	if (read_pos > 0) {
+		//keep what the decoder did not consume yet at the front
+		int left = read_len - read_pos;
+		if (left > 0) {
+			movemem(read_buffer.ptrw(), read_buffer.ptr() + read_pos, left);
+		}
+		read_len = left;
+		read_pos = 0;
+	}
+
+	if (read_len == read_buffer.size()) {
+		//a single packet bigger than the buffer, grow it
+		if (read_buffer.size() >= MAX_READ_BUFFER_SIZE) {
+			return false;
+		}
+		read_buffer.resize(read_buffer.size() * 2);
+	}
+
+	if (file->eof_reached()) {
+		return false;
+	}
+
+	int read = file->get_buffer(read_buffer.ptrw() + read_len, read_buffer.size() - read_len);
+	if (read <= 0) {
+		return false;
+	}
+	read_len += read;
+	return true;
+}
+
+bool AudioStreamPlaybackOGGVorbisStream::_restart_decoder() {
+
+	if (ogg_stream) {
+		stb_vorbis_close(ogg_stream);
+		ogg_stream = NULL;
+	}
+
+	file->seek(vorbis_stream->stream_offset);
+	read_pos = 0;
+	read_len = 0;
+	frame_ofs = 0;
+	frame_len = 0;
+
+	while (_feed()) {
+		int used = 0;
+		int error = 0;
+		ogg_stream = stb_vorbis_open_pushdata(read_buffer.ptr(), read_len, &used, &error, &ogg_alloc);
+		if (ogg_stream) {
+			read_pos = used;
+			audio_begin = vorbis_stream->stream_offset + used;
+			return true;
+		}
+		if (error != VORBIS_need_more_data) {
+			break;
+		}
+	}
+
+	ERR_FAIL_V_MSG(false, "Cannot open OGG Vorbis stream '" + vorbis_stream->stream_file + "'.");
+}
+
+void AudioStreamPlaybackOGGVorbisStream::_resync_decoder(uint64_t p_pos) {
+
+	file->seek(p_pos);
+	read_pos = 0;
+	read_len = 0;
+	frame_ofs = 0;
+	frame_len = 0;
+	stb_vorbis_flush_pushdata(ogg_stream);
+}
+
+int AudioStreamPlaybackOGGVorbisStream::_decode_frame() {
+
+	while (true) {
+		int samples = 0;
+		int used = stb_vorbis_decode_frame_pushdata(ogg_stream, read_buffer.ptr() + read_pos, read_len - read_pos, NULL, &frame_output, &samples);
+		read_pos += used;
+
+		if (samples > 0) {
+			frame_ofs = 0;
+			frame_len = samples;
+			return samples;
+		}
+
+		if (used == 0 && !_feed()) {
+			frame_ofs = 0;
+			frame_len = 0;
+			return -1; //end of file
+		}
+	}
+}
+
+int64_t AudioStreamPlaybackOGGVorbisStream::_find_frame_start() {
+
+	//after a resync the position becomes known once a full page went through the decoder
+	while (true) {
+		int samples = _decode_frame();
+		if (samples < 0) {
+			return -1;
+		}
+		int next = stb_vorbis_get_sample_offset(ogg_stream);
+		if (next >= 0) {
+			return MAX(int64_t(0), int64_t(next) - samples);
+		}
+	}
+}
+
+void AudioStreamPlaybackOGGVorbisStream::_seek_decoder(uint32_t p_frame) {
+
+	frame_skip = 0;
+
+	if (!ogg_stream || p_frame < uint32_t(vorbis_stream->sample_rate)) {
+		//close to the beginning, decoding from the start is cheaper than searching
+		if (_restart_decoder()) {
+			frame_skip = p_frame;
+		}
+		return;
+	}
+
+	//bisect the file until a page shortly before the requested frame is found
+	uint64_t begin = audio_begin;
+	uint64_t end = file->get_len();
+	uint32_t window = uint32_t(vorbis_stream->sample_rate);
+
+	for (int i = 0; i < SEEK_BISECT_STEPS && end - begin > READ_CHUNK_SIZE; i++) {
+
+		uint64_t pos = begin + (end - begin) / 2;
+		_resync_decoder(pos);
+		int64_t start = _find_frame_start();
+
+		if (start < 0 || start > p_frame) {
+			end = pos;
+			continue;
+		}
+
+		if (p_frame - start <= window) {
+			frame_skip = p_frame - start;
+			return;
+		}
+
+		begin = pos;
+	}
+
+	//small enough range, decode forward from its lower bound
+	int64_t start = -1;
+	if (begin > audio_begin) {
+		_resync_decoder(begin);
+		start = _find_frame_start();
+	}
+	if (start < 0 || start > p_frame) {
+		if (!_restart_decoder()) {
+			return;
+		}
+		start = 0;
+	}
+	frame_skip = p_frame - start;
+}
+
+void AudioStreamPlaybackOGGVorbisStream::_fill_ring_buffer() {
+
+	AudioFrame pcm[FILL_CHUNK_SIZE];
+
+	while (!thread_exit && !decode_eof && seek_done == seek_request) {
+
+		if (frame_ofs == frame_len) {
+			if (!ogg_stream || _decode_frame() < 0) {
+				if (ogg_stream && vorbis_stream->loop && decoded_since_loop) {
+					decoded_since_loop = false;
+					_seek_decoder(uint32_t(vorbis_stream->loop_offset * vorbis_stream->sample_rate));
+				} else {
+					decode_eof = true;
+				}
+				continue;
+			}
+			decoded_since_loop = true;
+		}
+
+		if (frame_skip) {
+			uint32_t skipped = MIN(frame_skip, uint32_t(frame_len - frame_ofs));
+			frame_ofs += skipped;
+			frame_skip -= skipped;
+			continue;
+		}
+
+		int todo = MIN(MIN(frame_len - frame_ofs, (int)FILL_CHUNK_SIZE), ring_buffer.space_left());
+		if (todo <= 0) {
+			return; //ring buffer is full
+		}
+
+		const float *l = frame_output[0] + frame_ofs;
+		const float *r = vorbis_stream->channels > 1 ? frame_output[1] + frame_ofs : l;
+		for (int i = 0; i < todo; i++) {
+			pcm[i] = AudioFrame(l[i], r[i]);
+		}
+
+		ring_buffer.write(pcm, todo);
+		frame_ofs += todo;
+	}
+}
+
+void AudioStreamPlaybackOGGVorbisStream::_decode_step() {
+
+	uint32_t request = seek_request;
+	if (request != seek_done) {
+		//the mix thread stops reading until the request is acknowledged, so the buffer can be reset
+		decoded_since_loop = false;
+		_seek_decoder(seek_frame);
+		ring_buffer.clear();
+		decode_eof = false;
+		seek_done = request;
+	}
+
+	if (seek_done == 0) {
+		return; //never started
+	}
+
+	_fill_ring_buffer();
+}
+
+void AudioStreamPlaybackOGGVorbisStream::_decoder_thread(void *p_ud) {
+
+	AudioStreamPlaybackOGGVorbisStream *ovs = (AudioStreamPlaybackOGGVorbisStream *)p_ud;
+
+	while (!ovs->thread_exit) {
+		ovs->_decode_step();
+		ovs->thread_sem->wait();
+	}
+}
+
+void AudioStreamPlaybackOGGVorbisStream::_request_seek(uint32_t p_frame) {
+
+	frames_mixed = p_frame;
+	if (seek_request && !mixed_since_seek && seek_frame == p_frame) {
+		return; //already buffered from there, e.g. when starting from the beginning
+	}
+
+	mixed_since_seek = false;
+	seek_frame = p_frame;
+	atomic_increment(&seek_request);
+	if (thread) {
+		thread_sem->post();
+	}
+}
+
+void AudioStreamPlaybackOGGVorbisStream::_mix_internal(AudioFrame *p_buffer, int p_frames) {
+
+	ERR_FAIL_COND(!active);
+
+	if (!thread) {
+		_decode_step(); //no threads, decode in place
+	}
+
+	int mixed = 0;
+	if (seek_done == seek_request) {
+		mixed = ring_buffer.read(p_buffer, p_frames);
+	}
+
+	for (int i = mixed; i < p_frames; i++) {
+		p_buffer[i] = AudioFrame(0, 0);
+	}
+
+	if (mixed < p_frames && decode_eof && ring_buffer.data_left() == 0) {
+		active = false;
+	}
+
+	if (mixed > 0) {
+		mixed_since_seek = true;
+	}
+
+	frames_mixed += mixed;
+	if (vorbis_stream->loop) {
+		//follow the decoder around the loop point
+		uint32_t length = uint32_t(vorbis_stream->length * vorbis_stream->sample_rate);
+		uint32_t loop_begin = uint32_t(vorbis_stream->loop_offset * vorbis_stream->sample_rate);
+		if (frames_mixed >= length && loop_begin < length) {
+			frames_mixed = loop_begin + (frames_mixed - length) % (length - loop_begin);
+			loops++;
+		}
+	}
+
+	if (thread && ring_buffer.space_left() > ring_buffer.size() / 2) {
+		thread_sem->post();
+	}
+}
+
+float AudioStreamPlaybackOGGVorbisStream::get_stream_sampling_rate() {
+
+	return vorbis_stream->sample_rate;
+}
+
+void AudioStreamPlaybackOGGVorbisStream::start(float p_from_pos) {
+
+	active = true;
+	seek(p_from_pos);
+	loops = 0;
+	_begin_resample();
+}
+
+void AudioStreamPlaybackOGGVorbisStream::stop() {
+
+	active = false;
+}
+
+bool AudioStreamPlaybackOGGVorbisStream::is_playing() const {
+
+	return active;
+}
+
+int AudioStreamPlaybackOGGVorbisStream::get_loop_count() const {
+
+	return loops;
+}
+
+float AudioStreamPlaybackOGGVorbisStream::get_playback_position() const {
+
+	return float(frames_mixed) / vorbis_stream->sample_rate;
+}
+
+void AudioStreamPlaybackOGGVorbisStream::seek(float p_time) {
+
+	if (!active)
+		return;
+
+	if (p_time >= vorbis_stream->get_length()) {
+		p_time = 0;
+	}
+
+	_request_seek(uint32_t(vorbis_stream->sample_rate * p_time));
+}
+
+void AudioStreamPlaybackOGGVorbisStream::skip(float p_time) {
+
+	if (!active)
+		return;
+
+	uint64_t length = uint64_t(vorbis_stream->length * vorbis_stream->sample_rate);
+	uint64_t pos = frames_mixed + uint64_t(p_time * vorbis_stream->sample_rate);
+
+	if (pos >= length) {
+		uint64_t loop_begin = uint64_t(vorbis_stream->loop_offset * vorbis_stream->sample_rate);
+		if (!vorbis_stream->loop || loop_begin >= length) {
+			active = false;
+			return;
+		}
+		uint64_t loop_len = length - loop_begin;
+		loops += 1 + (pos - length) / loop_len;
+		pos = loop_begin + (pos - length) % loop_len;
+	}
+
+	_request_seek(pos);
+}
+
+AudioStreamPlaybackOGGVorbisStream::AudioStreamPlaybackOGGVorbisStream() {
+
+	file = NULL;
+	audio_begin = 0;
+	ogg_stream = NULL;
+	ogg_alloc.alloc_buffer = NULL;
+	ogg_alloc.alloc_buffer_length_in_bytes = 0;
+	read_buffer.resize(READ_CHUNK_SIZE);
+	read_pos = 0;
+	read_len = 0;
+	frame_output = NULL;
+	frame_ofs = 0;
+	frame_len = 0;
+	frame_skip = 0;
+	decoded_since_loop = false;
+
+	ring_buffer.resize(RING_BUFFER_POWER);
+	thread = NULL;
+	thread_sem = NULL;
+	thread_exit = false;
+	seek_request = 0;
+	seek_done = 0;
+	seek_frame = 0;
+	decode_eof = false;
+
+	frames_mixed = 0;
+	mixed_since_seek = false;
+	active = false;
+	loops = 0;
+}
+
+AudioStreamPlaybackOGGVorbisStream::~AudioStreamPlaybackOGGVorbisStream() {
+
+	if (thread) {
+		thread_exit = true;
+		thread_sem->post();
+		Thread::wait_to_finish(thread);
+		memdelete(thread);
+	}
+	if (thread_sem) {
+		memdelete(thread_sem);
+	}
+	if (ogg_stream) {
+		stb_vorbis_close(ogg_stream);
+	}
+	if (ogg_alloc.alloc_buffer) {
+		AudioServer::get_singleton()->audio_data_free(ogg_alloc.alloc_buffer);
+	}
+	if (file) {
+		file->close();
+		memdelete(file);
+	}
+}
+
 Ref<AudioStreamPlayback> AudioStreamOGGVorbis::instance_playback() {
 
+	if (stream_file != String()) {
+
+		Ref<AudioStreamPlaybackOGGVorbisStream> ovs;
+		ovs.instance();
+		ovs->vorbis_stream = Ref<AudioStreamOGGVorbis>(this);
+		ovs->file = FileAccess::open(stream_file, FileAccess::READ);
+		ERR_FAIL_COND_V_MSG(!ovs->file, Ref<AudioStreamPlaybackOGGVorbisStream>(), "Cannot open file '" + stream_file + "'.");
+		ovs->ogg_alloc.alloc_buffer = (char *)AudioServer::get_singleton()->audio_data_alloc(decode_mem_size);
+		ovs->ogg_alloc.alloc_buffer_length_in_bytes = decode_mem_size;
+
+		ovs->thread_sem = Semaphore::create();
+		if (ovs->thread_sem) {
+			ovs->thread = Thread::create(AudioStreamPlaybackOGGVorbisStream::_decoder_thread, ovs.ptr());
+		}
+
+		ovs->_request_seek(0); //start buffering right away, most playbacks begin at the start
+		return ovs;
+	}
+
 	Ref<AudioStreamPlaybackOGGVorbis> ovs;
 
 	ERR_FAIL_COND_V(data == NULL, ovs);
@@ -166,6 +623,10 @@ void AudioStreamOGGVorbis::clear_data() {
 void AudioStreamOGGVorbis::set_data(const PoolVector<uint8_t> &p_data) {
 
 	int src_data_len = p_data.size();
+	if (src_data_len == 0) {
+		clear_data();
+		return;
+	}
 #define MAX_TEST_MEM (1 << 20)
 
 	uint32_t alloc_try = 1024;
@@ -208,6 +669,8 @@ void AudioStreamOGGVorbis::set_data(const PoolVector<uint8_t> &p_data) {
 
 			// free any existing data
 			clear_data();
+			stream_file = String();
+			stream_offset = 0;
 
 			data = AudioServer::get_singleton()->audio_data_alloc(src_data_len, src_datar.ptr());
 			data_len = src_data_len;
@@ -232,6 +695,118 @@ PoolVector<uint8_t> AudioStreamOGGVorbis::get_data() const {
 	return vdata;
 }
 
+void AudioStreamOGGVorbis::set_stream_file(const String &p_file) {
+
+	if (p_file == String()) {
+		stream_file = String();
+		return;
+	}
+
+	FileAccessRef f = FileAccess::open(p_file, FileAccess::READ);
+	ERR_FAIL_COND_MSG(!f, "Cannot open file '" + p_file + "'.");
+
+	//files written by the importer start with a small header, plain .ogg files are streamed as is
+	uint64_t offset = 0;
+	uint8_t magic[4];
+	if (f->get_buffer(magic, 4) == 4 && magic[0] == 'O' && magic[1] == 'S' && magic[2] == 'T' && magic[3] == 'R') {
+		offset = STREAM_HEADER_SIZE;
+	}
+
+	uint64_t file_len = f->get_len();
+	ERR_FAIL_COND_MSG(file_len <= offset, "OGG Vorbis stream '" + p_file + "' is empty.");
+
+	//find how much memory the decoder needs, reading more of the headers when required
+	Vector<uint8_t> header;
+	int header_len = MIN(file_len - offset, uint64_t(4096));
+	uint32_t alloc_try = 1024;
+	PoolVector<char> alloc_mem;
+	stb_vorbis *ogg_stream = NULL;
+	stb_vorbis_alloc ogg_alloc;
+
+	while (true) {
+
+		header.resize(header_len);
+		f->seek(offset);
+		ERR_FAIL_COND(f->get_buffer(header.ptrw(), header_len) != header_len);
+
+		alloc_mem.resize(alloc_try);
+		PoolVector<char>::Write w = alloc_mem.write();
+		ogg_alloc.alloc_buffer = w.ptr();
+		ogg_alloc.alloc_buffer_length_in_bytes = alloc_try;
+
+		int used = 0;
+		int error = 0;
+		ogg_stream = stb_vorbis_open_pushdata(header.ptr(), header_len, &used, &error, &ogg_alloc);
+		if (ogg_stream) {
+
+			stb_vorbis_info info = stb_vorbis_get_info(ogg_stream);
+			channels = info.channels;
+			sample_rate = info.sample_rate;
+			decode_mem_size = alloc_try;
+			stb_vorbis_close(ogg_stream);
+			break;
+		}
+
+		if (error == VORBIS_outofmem) {
+			ERR_FAIL_COND_MSG(alloc_try >= MAX_TEST_MEM, "Not enough memory to decode OGG Vorbis stream '" + p_file + "'.");
+			alloc_try *= 2;
+		} else if (error == VORBIS_need_more_data) {
+			ERR_FAIL_COND_MSG(uint64_t(header_len) >= file_len - offset, "Invalid OGG Vorbis stream '" + p_file + "'.");
+			header_len = MIN(file_len - offset, uint64_t(header_len) * 2);
+		} else {
+			ERR_FAIL_MSG("Invalid OGG Vorbis stream '" + p_file + "'.");
+		}
+	}
+
+	//the granule position of the last page is the length in samples
+	int tail_len = MIN(file_len - offset, uint64_t(65536 + 27 + 255));
+	Vector<uint8_t> tail;
+	tail.resize(tail_len);
+	f->seek(file_len - tail_len);
+	f->get_buffer(tail.ptrw(), tail_len);
+
+	length = 0;
+	for (int i = tail_len - 27; i >= 0; i--) {
+
+		const uint8_t *page = tail.ptr() + i;
+		if (page[0] == 'O' && page[1] == 'g' && page[2] == 'g' && page[3] == 'S' && page[4] == 0) {
+			uint64_t granule = decode_uint64(page + 6);
+			if (granule != uint64_t(-1)) {
+				length = double(granule) / sample_rate;
+				break;
+			}
+		}
+	}
+
+	clear_data();
+	stream_file = p_file;
+	stream_offset = offset;
+}
+
+String AudioStreamOGGVorbis::get_stream_file() const {
+
+	return stream_file;
+}
+
+Error AudioStreamOGGVorbis::save_stream_file(const String &p_path, const PoolVector<uint8_t> &p_data, bool p_loop, float p_loop_offset) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(!f, ERR_CANT_CREATE, "Cannot create file '" + p_path + "'.");
+
+	f->store_8('O');
+	f->store_8('S');
+	f->store_8('T');
+	f->store_8('R');
+	f->store_32(p_loop ? 1 : 0);
+	f->store_float(p_loop_offset);
+
+	PoolVector<uint8_t>::Read r = p_data.read();
+	f->store_buffer(r.ptr(), p_data.size());
+
+	memdelete(f);
+	return OK;
+}
+
 void AudioStreamOGGVorbis::set_loop(bool p_enable) {
 	loop = p_enable;
 }
@@ -259,6 +834,9 @@ void AudioStreamOGGVorbis::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_data", "data"), &AudioStreamOGGVorbis::set_data);
 	ClassDB::bind_method(D_METHOD("get_data"), &AudioStreamOGGVorbis::get_data);
 
+	ClassDB::bind_method(D_METHOD("set_stream_file", "file"), &AudioStreamOGGVorbis::set_stream_file);
+	ClassDB::bind_method(D_METHOD("get_stream_file"), &AudioStreamOGGVorbis::get_stream_file);
+
 	ClassDB::bind_method(D_METHOD("set_loop", "enable"), &AudioStreamOGGVorbis::set_loop);
 	ClassDB::bind_method(D_METHOD("has_loop"), &AudioStreamOGGVorbis::has_loop);
 
@@ -266,6 +844,7 @@ void AudioStreamOGGVorbis::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_loop_offset"), &AudioStreamOGGVorbis::get_loop_offset);
 
 	ADD_PROPERTY(PropertyInfo(Variant::POOL_BYTE_ARRAY, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR), "set_data", "get_data");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "stream_file", PROPERTY_HINT_FILE, "*.ogg"), "set_stream_file", "get_stream_file");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop"), "set_loop", "has_loop");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "loop_offset"), "set_loop_offset", "get_loop_offset");
 }
@@ -274,6 +853,7 @@ AudioStreamOGGVorbis::AudioStreamOGGVorbis() {
 
 	data = NULL;
 	data_len = 0;
+	stream_offset = 0;
 	length = 0;
 	sample_rate = 1;
 	channels = 1;
@@ -285,3 +865,58 @@ AudioStreamOGGVorbis::AudioStreamOGGVorbis() {
 AudioStreamOGGVorbis::~AudioStreamOGGVorbis() {
 	clear_data();
 }
+
+RES ResourceFormatLoaderAudioStreamOGGVorbis::load(const String &p_path, const String &p_original_path, Error *r_error) {
+
+	if (r_error) {
+		*r_error = ERR_FILE_UNRECOGNIZED;
+	}
+
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		if (r_error) {
+			*r_error = ERR_CANT_OPEN;
+		}
+		return RES();
+	}
+
+	//regular .oggstr resources are left to the binary loader
+	uint8_t magic[4];
+	if (f->get_buffer(magic, 4) != 4 || magic[0] != 'O' || magic[1] != 'S' || magic[2] != 'T' || magic[3] != 'R') {
+		return RES();
+	}
+
+	bool loop = f->get_32() & 1;
+	float loop_offset = f->get_float();
+	f->close();
+
+	Ref<AudioStreamOGGVorbis> ogg_stream;
+	ogg_stream.instance();
+	ogg_stream->set_stream_file(p_path);
+	ERR_FAIL_COND_V(ogg_stream->get_stream_file() == String(), RES());
+	ogg_stream->set_loop(loop);
+	ogg_stream->set_loop_offset(loop_offset);
+
+	if (r_error) {
+		*r_error = OK;
+	}
+
+	return ogg_stream;
+}
+
+void ResourceFormatLoaderAudioStreamOGGVorbis::get_recognized_extensions(List<String> *p_extensions) const {
+
+	p_extensions->push_back("oggstr");
+}
+
+bool ResourceFormatLoaderAudioStreamOGGVorbis::handles_type(const String &p_type) const {
+
+	return ClassDB::is_parent_class("AudioStreamOGGVorbis", p_type);
+}
+
+String ResourceFormatLoaderAudioStreamOGGVorbis::get_resource_type(const String &p_path) const {
+
+	if (p_path.get_extension().to_lower() == "oggstr")
+		return "AudioStreamOGGVorbis";
+	return "";
+}
@@ -32,6 +32,10 @@
 #define AUDIO_STREAM_STB_VORBIS_H
 
 #include "core/io/resource_loader.h"
+#include "core/os/file_access.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/ring_buffer.h"
 #include "servers/audio/audio_stream.h"
 
 #include "thirdparty/misc/stb_vorbis.h"
@@ -46,6 +50,7 @@ class AudioStreamPlaybackOGGVorbis : public AudioStreamPlaybackResampled {
 	stb_vorbis_alloc ogg_alloc;
 	uint32_t frames_mixed;
 	bool active;
+	bool seek_pending; //skipped ahead, the decoder seeks to frames_mixed on the next mix
 	int loops;
 
 	friend class AudioStreamOGGVorbis;
@@ -65,11 +70,89 @@ public:
 
 	virtual float get_playback_position() const;
 	virtual void seek(float p_time);
+	virtual void skip(float p_time);
 
-	AudioStreamPlaybackOGGVorbis() {}
+	AudioStreamPlaybackOGGVorbis() { seek_pending = false; }
 	~AudioStreamPlaybackOGGVorbis();
 };
 
+class AudioStreamPlaybackOGGVorbisStream : public AudioStreamPlaybackResampled {
+
+	GDCLASS(AudioStreamPlaybackOGGVorbisStream, AudioStreamPlaybackResampled);
+
+	enum {
+		RING_BUFFER_POWER = 15,
+		READ_CHUNK_SIZE = 16384,
+		MAX_READ_BUFFER_SIZE = 1 << 20,
+		FILL_CHUNK_SIZE = 256,
+		SEEK_BISECT_STEPS = 16,
+	};
+
+	//owned by the decoder thread
+	FileAccess *file;
+	uint64_t audio_begin; //file offset of the first audio page
+	stb_vorbis *ogg_stream;
+	stb_vorbis_alloc ogg_alloc;
+	Vector<uint8_t> read_buffer;
+	int read_pos;
+	int read_len;
+	float **frame_output;
+	int frame_ofs;
+	int frame_len;
+	uint32_t frame_skip;
+	bool decoded_since_loop;
+
+	//shared between the decoder and the mix thread
+	RingBuffer<AudioFrame> ring_buffer;
+	Thread *thread;
+	Semaphore *thread_sem;
+	volatile bool thread_exit;
+	volatile uint32_t seek_request;
+	volatile uint32_t seek_done;
+	volatile uint32_t seek_frame;
+	volatile bool decode_eof;
+
+	//owned by the mix thread
+	uint32_t frames_mixed;
+	bool mixed_since_seek;
+	bool active;
+	int loops;
+
+	friend class AudioStreamOGGVorbis;
+
+	Ref<AudioStreamOGGVorbis> vorbis_stream;
+
+	bool _feed();
+	bool _restart_decoder();
+	void _resync_decoder(uint64_t p_pos);
+	int _decode_frame();
+	int64_t _find_frame_start();
+	void _seek_decoder(uint32_t p_frame);
+	void _fill_ring_buffer();
+	void _decode_step();
+	void _request_seek(uint32_t p_frame);
+
+	static void _decoder_thread(void *p_ud);
+
+protected:
+	virtual void _mix_internal(AudioFrame *p_buffer, int p_frames);
+	virtual float get_stream_sampling_rate();
+
+public:
+	virtual void start(float p_from_pos = 0.0);
+	virtual void stop();
+	virtual bool is_playing() const;
+
+	virtual int get_loop_count() const; //times it looped
+
+	virtual float get_playback_position() const;
+	virtual void seek(float p_time);
+	virtual void skip(float p_time);
+
+	AudioStreamPlaybackOGGVorbisStream();
+	~AudioStreamPlaybackOGGVorbisStream();
+};
+
 class AudioStreamOGGVorbis : public AudioStream {
 
 	GDCLASS(AudioStreamOGGVorbis, AudioStream);
@@ -77,10 +160,19 @@ class AudioStreamOGGVorbis : public AudioStream {
 	RES_BASE_EXTENSION("oggstr");
 
 	friend class AudioStreamPlaybackOGGVorbis;
+	friend class AudioStreamPlaybackOGGVorbisStream;
+	friend class ResourceFormatLoaderAudioStreamOGGVorbis;
+
+	enum {
+		STREAM_HEADER_SIZE = 12 //magic, flags, loop offset
+	};
 
 	void *data;
 	uint32_t data_len;
 
+	String stream_file;
+	uint64_t stream_offset;
+
 	int decode_mem_size;
 	float sample_rate;
 	int channels;
@@ -105,10 +197,24 @@ public:
 	void set_data(const PoolVector<uint8_t> &p_data);
 	PoolVector<uint8_t> get_data() const;
 
+	void set_stream_file(const String &p_file);
+	String get_stream_file() const;
+
+	static Error save_stream_file(const String &p_path, const PoolVector<uint8_t> &p_data, bool p_loop, float p_loop_offset);
+
 	virtual float get_length() const; //if supported, otherwise return 0
+	virtual uint64_t get_memory_usage() const { return data_len; }
 
 	AudioStreamOGGVorbis();
 	virtual ~AudioStreamOGGVorbis();
 };
 
+class ResourceFormatLoaderAudioStreamOGGVorbis : public ResourceFormatLoader {
+public:
+	virtual RES load(const String &p_path, const String &p_original_path = "", Error *r_error = NULL);
+	virtual void get_recognized_extensions(List<String> *p_extensions) const;
+	virtual bool handles_type(const String &p_type) const;
+	virtual String get_resource_type(const String &p_path) const;
+};
+
 #endif
@@ -37,6 +37,8 @@
 #include "resource_importer_ogg_vorbis.h"
 #endif
 
+static Ref<ResourceFormatLoaderAudioStreamOGGVorbis> ogg_stream_loader;
+
 void register_stb_vorbis_types() {
 
 #ifdef TOOLS_ENABLED
@@ -47,7 +49,14 @@ void register_stb_vorbis_types() {
 	}
 #endif
 	ClassDB::register_class<AudioStreamOGGVorbis>();
+
+	//streamed files share the .oggstr extension with regular resources, so look at them first
+	ogg_stream_loader.instance();
+	ResourceLoader::add_resource_format_loader(ogg_stream_loader, true);
 }
 
 void unregister_stb_vorbis_types() {
+
+	ResourceLoader::remove_resource_format_loader(ogg_stream_loader);
+	ogg_stream_loader.unref();
 }
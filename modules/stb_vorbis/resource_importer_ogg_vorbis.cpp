@@ -74,12 +74,14 @@ void ResourceImporterOGGVorbis::get_import_options(List<ImportOption> *r_options
 
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "loop"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "loop_offset"), 0));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "stream"), false));
 }
 
 Error ResourceImporterOGGVorbis::import(const String &p_source_file, const String &p_save_path, const Map<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files, Variant *r_metadata) {
 
 	bool loop = p_options["loop"];
 	float loop_offset = p_options["loop_offset"];
+	bool stream = p_options["stream"];
 
 	FileAccess *f = FileAccess::open(p_source_file, FileAccess::READ);
 
@@ -100,6 +102,12 @@ Error ResourceImporterOGGVorbis::import(const String &p_source_file, const Strin
 
 	ogg_stream->set_data(data);
 	ERR_FAIL_COND_V(!ogg_stream->get_data().size(), ERR_FILE_CORRUPT);
+
+	if (stream) {
+		//decoded from disk while playing instead of being loaded in memory
+		return AudioStreamOGGVorbis::save_stream_file(p_save_path + ".oggstr", data, loop, loop_offset);
+	}
+
 	ogg_stream->set_loop(loop);
 	ogg_stream->set_loop_offset(loop_offset);
 
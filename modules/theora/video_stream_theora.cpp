@@ -80,14 +80,14 @@ int VideoStreamPlaybackTheora::queue_page(ogg_page *page) {
 	return 0;
 }
 
-void VideoStreamPlaybackTheora::video_write(void) {
+void VideoStreamPlaybackTheora::video_write(VideoFrame &p_frame) {
 	th_ycbcr_buffer yuv;
 	th_decode_ycbcr_out(td, yuv);
 
 	int pitch = 4;
-	frame_data.resize(size.x * size.y * pitch);
+	p_frame.data.resize(size.x * size.y * pitch);
 	{
-		PoolVector<uint8_t>::Write w = frame_data.write();
+		PoolVector<uint8_t>::Write w = p_frame.data.write();
 		char *dst = (char *)w.ptr();
 
 		//uv_offset=(ti.pic_x/2)+(yuv[1].stride)*(ti.pic_y/2);
@@ -107,12 +107,189 @@ void VideoStreamPlaybackTheora::video_write(void) {
 
 		format = Image::FORMAT_RGBA8;
 	}
+}
+
+double VideoStreamPlaybackTheora::get_frame_duration() const {
+
+	return (double)ti.fps_denominator / ti.fps_numerator;
+}
+
+void VideoStreamPlaybackTheora::_decode_packets() {
+
+	while (!decode_exit) {
+
+		decode_mutex->lock();
 
-	Ref<Image> img = memnew(Image(size.x, size.y, 0, Image::FORMAT_RGBA8, frame_data)); //zero copy image creation
+		int slot = -1;
+		for (int i = 0; i < MAX_FRAMES; i++) {
+			if (frames[i].state == FRAME_FREE) {
+				slot = i;
+				break;
+			}
+		}
+
+		if (slot == -1 || video_packets.empty()) {
+			//nothing to decode or nowhere to put it, wait for the main thread
+			decode_mutex->unlock();
+			return;
+		}
+
+		VideoPacket packet = video_packets.front()->get();
+		video_packets.pop_front();
+		frames[slot].state = FRAME_DECODING;
+		decoding = true;
+		double clock = decode_time;
+
+		decode_mutex->unlock();
+
+		ogg_packet op;
+		PoolVector<uint8_t>::Read r = packet.data.read();
+		op.packet = (unsigned char *)r.ptr();
+		op.bytes = packet.data.size();
+		op.b_o_s = packet.b_o_s;
+		op.e_o_s = packet.e_o_s;
+		op.granulepos = packet.granulepos;
+		op.packetno = packet.packetno;
+
+		/*HACK: This should be set after a seek or a gap, but we might not have
+		a granulepos for the first packet (we only have them for the last
+		packet on a page), so we just set it as often as we get it.
+		To do this right, we should back-track from the last packet on the
+		page and compute the correct granulepos for the first packet after
+		a seek or a gap.*/
+		if (op.granulepos >= 0) {
+			th_decode_ctl(td, TH_DECCTL_SET_GRANPOS, &op.granulepos,
+					sizeof(op.granulepos));
+		}
+
+		bool converted = false;
+		double frame_time = 0;
+		ogg_int64_t videobuf_granulepos;
+		if (th_decode_packetin(td, &op, &videobuf_granulepos) == 0) {
+			frame_time = th_granule_time(td, videobuf_granulepos);
+
+			//every packet must be decoded to keep the reference frames valid,
+			//but a frame that is already too old to be shown is not converted
+			if (frame_time >= clock) {
+				video_write(frames[slot]);
+				converted = true;
+			}
+		}
+
+		decode_mutex->lock();
+		if (converted) {
+			frames[slot].time = frame_time;
+			frames[slot].state = FRAME_READY;
+		} else {
+			frames[slot].state = FRAME_FREE;
+		}
+		decoding = false;
+		decode_mutex->unlock();
+	}
+}
+
+void VideoStreamPlaybackTheora::_decode_thread(void *ud) {
+
+	VideoStreamPlaybackTheora *vs = (VideoStreamPlaybackTheora *)ud;
+
+	while (!vs->decode_exit) {
+
+		vs->decode_sem->wait();
+		vs->_decode_packets();
+	}
+}
+
+void VideoStreamPlaybackTheora::_start_decoding() {
+
+	decode_exit = false;
+	decoding = false;
+	decode_time = 0;
+	video_frame_index = -1;
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		frames[i].state = FRAME_FREE;
+	}
+
+	decode_thread = Thread::create(_decode_thread, this);
+}
+
+void VideoStreamPlaybackTheora::_stop_decoding() {
+
+	if (!decode_thread)
+		return;
+
+	decode_exit = true;
+	decode_sem->post();
+	Thread::wait_to_finish(decode_thread);
+	memdelete(decode_thread);
+	decode_thread = NULL;
+
+	video_packets.clear();
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		frames[i].data = PoolVector<uint8_t>();
+		frames[i].state = FRAME_FREE;
+	}
+}
+
+bool VideoStreamPlaybackTheora::_present_frame() {
+
+	double clock = get_time();
+
+	decode_mutex->lock();
+
+	//the next frame to show is the first one that has not ended yet, if the
+	//decoder fell behind and all of them are late, show the most recent one
+	int next = -1;
+	int late = -1;
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		if (frames[i].state != FRAME_READY)
+			continue;
+		if (frames[i].time >= clock) {
+			if (next == -1 || frames[i].time < frames[next].time)
+				next = i;
+		} else if (late == -1 || frames[i].time > frames[late].time) {
+			late = i;
+		}
+	}
+
+	int show = next != -1 ? next : late;
+	if (show == next && show != -1 && frames[show].time - get_frame_duration() > clock) {
+		show = -1; //not due yet
+	}
+
+	//drop everything older than what is shown now
+	double threshold = show != -1 ? frames[show].time : clock;
+	bool freed = false;
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		if (frames[i].state == FRAME_READY && frames[i].time < threshold) {
+			frames[i].state = FRAME_FREE;
+			freed = true;
+		}
+	}
+
+	PoolVector<uint8_t> data;
+	if (show != -1) {
+		//hand the buffer over, the decoder allocates a new one for this slot
+		data = frames[show].data;
+		frames[show].data = PoolVector<uint8_t>();
+		frames[show].state = FRAME_FREE;
+		freed = true;
+	}
+
+	decode_mutex->unlock();
+
+	if (freed) {
+		decode_sem->post();
+	}
+
+	if (show == -1)
+		return false;
+
+	Ref<Image> img = memnew(Image(size.x, size.y, 0, Image::FORMAT_RGBA8, data)); //zero copy image creation
 
 	texture->set_data(img); //zero copy send to visual server
 
 	frames_pending = 1;
+	return true;
 }
 
 void VideoStreamPlaybackTheora::clear() {
@@ -120,6 +297,8 @@ void VideoStreamPlaybackTheora::clear() {
 	if (!file)
 		return;
 
+	_stop_decoding();
+
 	if (vorbis_p) {
 		ogg_stream_clear(&vo);
 		if (vorbis_p >= 3) {
@@ -155,6 +334,7 @@ void VideoStreamPlaybackTheora::clear() {
 	videobuf_time = 0;
 	theora_eos = false;
 	vorbis_eos = false;
+	video_eos = false;
 
 	if (file) {
 		memdelete(file);
@@ -200,6 +380,7 @@ void VideoStreamPlaybackTheora::set_file(const String &p_file) {
 
 	theora_eos = false;
 	vorbis_eos = false;
+	video_eos = false;
 
 	/* Ogg file open; parse the headers */
 	/* Only interested in Vorbis/Theora streams */
@@ -325,9 +506,8 @@ void VideoStreamPlaybackTheora::set_file(const String &p_file) {
 		}
 		th_decode_ctl(td, TH_DECCTL_GET_PPLEVEL_MAX, &pp_level_max,
 				sizeof(pp_level_max));
-		pp_level = 0;
+		int pp_level = 0;
 		th_decode_ctl(td, TH_DECCTL_SET_PPLEVEL, &pp_level, sizeof(pp_level));
-		pp_inc = 0;
 
 		int w;
 		int h;
@@ -338,6 +518,8 @@ void VideoStreamPlaybackTheora::set_file(const String &p_file) {
 
 		texture->create(w, h, Image::FORMAT_RGBA8, Texture::FLAG_FILTER | Texture::FLAG_VIDEO_SURFACE);
 
+		_start_decoding();
+
 	} else {
 		/* tear down the partial theora setup */
 		th_info_clear(&ti);
@@ -388,7 +570,30 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 
 	time += p_delta;
 
-	if (videobuf_time > get_time()) {
+	decode_mutex->lock();
+	decode_time = get_time();
+	decode_mutex->unlock();
+
+	_present_frame();
+
+	if (video_eos) {
+		decode_mutex->lock();
+		bool drained = video_packets.empty() && !decoding;
+		for (int i = 0; i < MAX_FRAMES; i++) {
+			drained = drained && frames[i].state == FRAME_FREE;
+		}
+		decode_mutex->unlock();
+
+		if (drained) {
+			//printf("video done, stopping\n");
+			stop();
+		}
+		return;
+	}
+
+	//keep a few frames worth of packets queued for the decoder
+	double lookahead = MAX_FRAMES * get_frame_duration();
+	if (videobuf_time > get_time() + lookahead) {
 		return; //no new frames need to be produced
 	}
 
@@ -464,40 +669,33 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 			/* theora is one in, one out... */
 			if (ogg_stream_packetout(&to, &op) > 0) {
 
-				if (false && pp_inc) {
-					pp_level += pp_inc;
-					th_decode_ctl(td, TH_DECCTL_SET_PPLEVEL, &pp_level,
-							sizeof(pp_level));
-					pp_inc = 0;
-				}
-				/*HACK: This should be set after a seek or a gap, but we might not have
-				a granulepos for the first packet (we only have them for the last
-				packet on a page), so we just set it as often as we get it.
-				To do this right, we should back-track from the last packet on the
-				page and compute the correct granulepos for the first packet after
-				a seek or a gap.*/
+				//track the frame time here (th_granule_frame only reads the
+				//stream info) so the demuxer knows how far ahead it is
 				if (op.granulepos >= 0) {
-					th_decode_ctl(td, TH_DECCTL_SET_GRANPOS, &op.granulepos,
-							sizeof(op.granulepos));
+					video_frame_index = th_granule_frame(td, op.granulepos);
+				} else {
+					video_frame_index++;
 				}
-				ogg_int64_t videobuf_granulepos;
-				if (th_decode_packetin(td, &op, &videobuf_granulepos) == 0) {
-					videobuf_time = th_granule_time(td, videobuf_granulepos);
-
-					//printf("frame time %f, play time %f, ready %i\n", (float)videobuf_time, get_time(), videobuf_ready);
-
-					/* is it already too old to be useful?  This is only actually
-					 useful cosmetically after a SIGSTOP.  Note that we have to
-					 decode the frame even if we don't show it (for now) due to
-					 keyframing.  Soon enough libtheora will be able to deal
-					 with non-keyframe seeks.  */
+				videobuf_time = (video_frame_index + 1) * get_frame_duration();
 
-					if (videobuf_time >= get_time()) {
-						frame_done = true;
-					} else {
-						/*If we are too slow, reduce the pp level.*/
-						pp_inc = pp_level > 0 ? -1 : 0;
-					}
+				VideoPacket packet;
+				packet.data.resize(op.bytes);
+				if (op.bytes) {
+					PoolVector<uint8_t>::Write w = packet.data.write();
+					copymem(w.ptr(), op.packet, op.bytes);
+				}
+				packet.b_o_s = op.b_o_s;
+				packet.e_o_s = op.e_o_s;
+				packet.granulepos = op.granulepos;
+				packet.packetno = op.packetno;
+
+				decode_mutex->lock();
+				video_packets.push_back(packet);
+				decode_mutex->unlock();
+				decode_sem->post();
+
+				if (videobuf_time >= get_time() + lookahead) {
+					frame_done = true;
 				}
 
 			} else {
@@ -509,11 +707,11 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 #ifdef THEORA_USE_THREAD_STREAMING
 		if (file && thread_eof && no_theora && theora_eos && ring_buffer.data_left() == 0) {
 #else
-		if (file && /*!videobuf_ready && */ no_theora && theora_eos) {
+		if (file && no_theora && theora_eos) {
 #endif
-			//printf("video done, stopping\n");
-			stop();
-			return;
+			//everything is demuxed, playback stops once the decoder drains
+			video_eos = true;
+			break;
 		};
 
 		if (!frame_done || !audio_done) {
@@ -524,29 +722,7 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 				queue_page(&og);
 			}
 		}
-
-		/* If playback has begun, top audio buffer off immediately. */
-		//if(stateflag) audio_write_nonblocking();
-
-		/* are we at or past time for this video frame? */
-		if (videobuf_ready && videobuf_time <= get_time()) {
-
-			//video_write();
-			//videobuf_ready=0;
-		} else {
-			//printf("frame at %f not ready (time %f), ready %i\n", (float)videobuf_time, get_time(), videobuf_ready);
-		}
-
-		float tdiff = videobuf_time - get_time();
-		/*If we have lots of extra time, increase the post-processing level.*/
-		if (tdiff > ti.fps_denominator * 0.25 / ti.fps_numerator) {
-			pp_inc = pp_level < pp_level_max ? 1 : 0;
-		} else if (tdiff < ti.fps_denominator * 0.05 / ti.fps_numerator) {
-			pp_inc = pp_level > 0 ? -1 : 0;
-		}
 	}
-
-	video_write();
 };
 
 void VideoStreamPlaybackTheora::play() {
@@ -678,6 +854,21 @@ VideoStreamPlaybackTheora::VideoStreamPlaybackTheora() {
 	frames_pending = 0;
 	videobuf_time = 0;
 	paused = false;
+	theora_eos = false;
+	vorbis_eos = false;
+	video_eos = false;
+
+	decode_mutex = Mutex::create();
+	decode_sem = Semaphore::create();
+	decode_thread = NULL;
+	decode_exit = false;
+	decoding = false;
+	decode_time = 0;
+	video_frame_index = -1;
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		frames[i].time = 0;
+		frames[i].state = FRAME_FREE;
+	}
 
 	buffering = false;
 	texture = Ref<ImageTexture>(memnew(ImageTexture));
@@ -709,6 +900,9 @@ VideoStreamPlaybackTheora::~VideoStreamPlaybackTheora() {
 
 	if (file)
 		memdelete(file);
+
+	memdelete(decode_sem);
+	memdelete(decode_mutex);
 };
 
 void VideoStreamTheora::_bind_methods() {
@@ -32,7 +32,9 @@
 #define VIDEO_STREAM_THEORA_H
 
 #include "core/io/resource_loader.h"
+#include "core/list.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/ring_buffer.h"
@@ -52,9 +54,46 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 		MAX_FRAMES = 4,
 	};
 
-	//Image frames[MAX_FRAMES];
+	enum FrameState {
+		FRAME_FREE,
+		FRAME_DECODING,
+		FRAME_READY,
+	};
+
+	struct VideoPacket {
+		PoolVector<uint8_t> data;
+		bool b_o_s;
+		bool e_o_s;
+		ogg_int64_t granulepos;
+		ogg_int64_t packetno;
+	};
+
+	struct VideoFrame {
+		PoolVector<uint8_t> data;
+		double time;
+		FrameState state;
+	};
+
+	//packets are demuxed on the main thread and decoded on decode_thread,
+	//which converts the ones still worth showing into frames
+	List<VideoPacket> video_packets;
+	VideoFrame frames[MAX_FRAMES];
+	Mutex *decode_mutex;
+	Semaphore *decode_sem;
+	Thread *decode_thread;
+	volatile bool decode_exit;
+	bool decoding;
+	double decode_time;
+	ogg_int64_t video_frame_index;
+
+	static void _decode_thread(void *ud);
+	void _decode_packets();
+	void _start_decoding();
+	void _stop_decoding();
+	bool _present_frame();
+	double get_frame_duration() const;
+
 	Image::Format format;
-	PoolVector<uint8_t> frame_data;
 	int frames_pending;
 	FileAccess *file;
 	String file_name;
@@ -63,11 +102,12 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 
 	int buffer_data();
 	int queue_page(ogg_page *page);
-	void video_write(void);
+	void video_write(VideoFrame &p_frame);
 	float get_time() const;
 
 	bool theora_eos;
 	bool vorbis_eos;
+	bool video_eos;
 
 	ogg_sync_state oy;
 	ogg_page og;
@@ -82,12 +122,10 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 	vorbis_comment vc;
 	th_pixel_fmt px_fmt;
 	double videobuf_time;
-	int pp_inc;
 
 	int theora_p;
 	int vorbis_p;
 	int pp_level_max;
-	int pp_level;
 	int videobuf_ready;
 
 	bool playing;
@@ -101,6 +101,7 @@ VideoStreamPlaybackWebm::VideoStreamPlaybackWebm() :
 		audio(NULL),
 		video_frames(NULL),
 		audio_frame(NULL),
+		demux_frame(NULL),
 		video_frames_pos(0),
 		video_frames_capacity(0),
 		num_decoded_samples(0),
@@ -114,10 +115,25 @@ VideoStreamPlaybackWebm::VideoStreamPlaybackWebm() :
 		video_frame_delay(0.0),
 		video_pos(0.0),
 		texture(memnew(ImageTexture)),
-		pcm(NULL) {}
+		pcm(NULL) {
+
+	decode_mutex = Mutex::create();
+	decode_sem = Semaphore::create();
+	decode_thread = NULL;
+	decode_exit = false;
+	decoding = false;
+	decode_time = 0.0;
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		frames[i].time = 0.0;
+		frames[i].state = FRAME_FREE;
+	}
+}
 VideoStreamPlaybackWebm::~VideoStreamPlaybackWebm() {
 
 	delete_pointers();
+
+	memdelete(decode_sem);
+	memdelete(decode_mutex);
 }
 
 bool VideoStreamPlaybackWebm::open_file(const String &p_file) {
@@ -140,9 +156,11 @@ bool VideoStreamPlaybackWebm::open_file(const String &p_file) {
 				audio = NULL;
 			}
 
-			frame_data.resize((webm->getWidth() * webm->getHeight()) << 2);
+			demux_frame = memnew(WebMFrame);
 			texture->create(webm->getWidth(), webm->getHeight(), Image::FORMAT_RGBA8, Texture::FLAG_FILTER | Texture::FLAG_VIDEO_SURFACE);
 
+			_start_decoding();
+
 			return true;
 		}
 		memdelete(video);
@@ -162,14 +180,16 @@ void VideoStreamPlaybackWebm::stop() {
 		pcm = NULL;
 
 		audio_frame = NULL;
+		demux_frame = NULL;
 		video_frames = NULL;
 
 		video = NULL;
 		audio = NULL;
 
+		video_frames_capacity = video_frames_pos = 0;
+
 		open_file(file_name); //Should not fail here...
 
-		video_frames_capacity = video_frames_pos = 0;
 		num_decoded_samples = 0;
 		samples_offset = -1;
 		video_frame_delay = video_pos = 0.0;
@@ -243,9 +263,11 @@ void VideoStreamPlaybackWebm::update(float p_delta) {
 
 	time += p_delta;
 
-	if (time < video_pos) {
-		return;
-	}
+	decode_mutex->lock();
+	decode_time = get_decode_time();
+	decode_mutex->unlock();
+
+	_present_frame();
 
 	bool audio_buffer_full = false;
 
@@ -265,10 +287,9 @@ void VideoStreamPlaybackWebm::update(float p_delta) {
 	}
 
 	const bool hasAudio = (audio && mix_callback);
-	while ((hasAudio && !audio_buffer_full && !has_enough_video_frames()) ||
-			(!hasAudio && video_frames_pos == 0)) {
+	while (!(hasAudio && audio_buffer_full) && !has_enough_video_frames()) {
 
-		if (hasAudio && !audio_buffer_full && audio_frame->isValid() &&
+		if (hasAudio && audio_frame->isValid() &&
 				audio->getPCMF(*audio_frame, pcm, num_decoded_samples) && num_decoded_samples > 0) {
 
 			const int mixed = mix_callback(mix_udata, pcm, num_decoded_samples);
@@ -279,98 +300,42 @@ void VideoStreamPlaybackWebm::update(float p_delta) {
 			}
 		}
 
-		WebMFrame *video_frame;
-		if (video_frames_pos >= video_frames_capacity) {
+		if (!webm->readFrame(demux_frame, audio_frame)) //This will invalidate frames
+			break; //Can't demux, EOS?
 
-			WebMFrame **video_frames_new = (WebMFrame **)memrealloc(video_frames, ++video_frames_capacity * sizeof(void *));
-			ERR_FAIL_COND(!video_frames_new); //Out of memory
-			(video_frames = video_frames_new)[video_frames_capacity - 1] = memnew(WebMFrame);
-		}
-		video_frame = video_frames[video_frames_pos];
+		if (demux_frame->isValid()) {
 
-		if (!webm->readFrame(video_frame, audio_frame)) //This will invalidate frames
-			break; //Can't demux, EOS?
+			//Hand the frame over to the decoder and take a spare one for the next read
+			decode_mutex->lock();
+			if (video_frames_pos >= video_frames_capacity) {
 
-		if (video_frame->isValid())
+				WebMFrame **video_frames_new = (WebMFrame **)memrealloc(video_frames, ++video_frames_capacity * sizeof(void *));
+				if (!video_frames_new) { //Out of memory
+					decode_mutex->unlock();
+					ERR_FAIL();
+				}
+				(video_frames = video_frames_new)[video_frames_capacity - 1] = memnew(WebMFrame);
+			}
+			SWAP(video_frames[video_frames_pos], demux_frame);
 			++video_frames_pos;
-	};
+			decode_mutex->unlock();
 
-	bool video_frame_done = false;
-	while (video_frames_pos > 0 && !video_frame_done) {
+			decode_sem->post();
+		}
+	};
 
-		WebMFrame *video_frame = video_frames[0];
+	if (webm->isEOS()) {
 
-		// It seems VPXDecoder::decode has to be executed even though we might skip this frame
-		if (video->decode(*video_frame)) {
-
-			VPXDecoder::IMAGE_ERROR err;
-			VPXDecoder::Image image;
-
-			if (should_process(*video_frame)) {
-
-				if ((err = video->getImage(image)) != VPXDecoder::NO_FRAME) {
-
-					if (err == VPXDecoder::NO_ERROR && image.w == webm->getWidth() && image.h == webm->getHeight()) {
-
-						PoolVector<uint8_t>::Write w = frame_data.write();
-						bool converted = false;
-
-						if (image.chromaShiftW == 0 && image.chromaShiftH == 0 && image.cs == VPX_CS_SRGB) {
-
-							uint8_t *wp = w.ptr();
-							unsigned char *rRow = image.planes[2];
-							unsigned char *gRow = image.planes[0];
-							unsigned char *bRow = image.planes[1];
-							for (int i = 0; i < image.h; i++) {
-								for (int j = 0; j < image.w; j++) {
-									*wp++ = rRow[j];
-									*wp++ = gRow[j];
-									*wp++ = bRow[j];
-									*wp++ = 255;
-								}
-								rRow += image.linesize[2];
-								gRow += image.linesize[0];
-								bRow += image.linesize[1];
-							}
-							converted = true;
-						} else if (image.chromaShiftW == 1 && image.chromaShiftH == 1) {
-
-							yuv420_2_rgb8888(w.ptr(), image.planes[0], image.planes[1], image.planes[2], image.w, image.h, image.linesize[0], image.linesize[1], image.w << 2);
-							//libyuv::I420ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
-							converted = true;
-						} else if (image.chromaShiftW == 1 && image.chromaShiftH == 0) {
-
-							yuv422_2_rgb8888(w.ptr(), image.planes[0], image.planes[1], image.planes[2], image.w, image.h, image.linesize[0], image.linesize[1], image.w << 2);
-							//libyuv::I422ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
-							converted = true;
-						} else if (image.chromaShiftW == 0 && image.chromaShiftH == 0) {
-
-							yuv444_2_rgb8888(w.ptr(), image.planes[0], image.planes[1], image.planes[2], image.w, image.h, image.linesize[0], image.linesize[1], image.w << 2);
-							//libyuv::I444ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
-							converted = true;
-						} else if (image.chromaShiftW == 2 && image.chromaShiftH == 0) {
-
-							//libyuv::I411ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2] image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
-							//converted = true;
-						}
-
-						if (converted) {
-							Ref<Image> img = memnew(Image(image.w, image.h, 0, Image::FORMAT_RGBA8, frame_data));
-							texture->set_data(img); //Zero copy send to visual server
-							video_frame_done = true;
-						}
-					}
-				}
-			}
+		decode_mutex->lock();
+		bool drained = video_frames_pos == 0 && !decoding;
+		for (int i = 0; i < MAX_FRAMES; i++) {
+			drained = drained && frames[i].state == FRAME_FREE;
 		}
+		decode_mutex->unlock();
 
-		video_pos = video_frame->time;
-		memmove(video_frames, video_frames + 1, (--video_frames_pos) * sizeof(void *));
-		video_frames[video_frames_pos] = video_frame;
+		if (drained)
+			stop();
 	}
-
-	if (video_frames_pos == 0 && webm->isEOS())
-		stop();
 }
 
 void VideoStreamPlaybackWebm::set_mix_callback(VideoStreamPlayback::AudioMixCallback p_callback, void *p_userdata) {
@@ -392,27 +357,226 @@ int VideoStreamPlaybackWebm::get_mix_rate() const {
 }
 
 inline bool VideoStreamPlaybackWebm::has_enough_video_frames() const {
-	if (video_frames_pos > 0) {
 
-		const double audio_delay = AudioServer::get_singleton()->get_output_latency();
+	MutexLock lock(decode_mutex);
+
+	//The decoder holds up to MAX_FRAMES converted frames, keep as many queued behind them
+	if (video_frames_pos >= MAX_FRAMES) {
+
 		const double video_time = video_frames[video_frames_pos - 1]->time;
-		return video_time >= time + audio_delay + delay_compensation;
+		return video_time >= decode_time;
 	}
 	return false;
 }
 
-bool VideoStreamPlaybackWebm::should_process(WebMFrame &video_frame) {
+double VideoStreamPlaybackWebm::get_decode_time() const {
+
 	const double audio_delay = AudioServer::get_singleton()->get_output_latency();
-	return video_frame.time >= time + audio_delay + delay_compensation;
+	return time + audio_delay + delay_compensation;
+}
+
+bool VideoStreamPlaybackWebm::_convert_frame(VideoFrame &p_frame) {
+
+	VPXDecoder::IMAGE_ERROR err;
+	VPXDecoder::Image image;
+
+	if ((err = video->getImage(image)) == VPXDecoder::NO_FRAME)
+		return false;
+	if (err != VPXDecoder::NO_ERROR || image.w != webm->getWidth() || image.h != webm->getHeight())
+		return false;
+
+	p_frame.data.resize((image.w * image.h) << 2);
+	PoolVector<uint8_t>::Write w = p_frame.data.write();
+
+	if (image.chromaShiftW == 0 && image.chromaShiftH == 0 && image.cs == VPX_CS_SRGB) {
+
+		uint8_t *wp = w.ptr();
+		unsigned char *rRow = image.planes[2];
+		unsigned char *gRow = image.planes[0];
+		unsigned char *bRow = image.planes[1];
+		for (int i = 0; i < image.h; i++) {
+			for (int j = 0; j < image.w; j++) {
+				*wp++ = rRow[j];
+				*wp++ = gRow[j];
+				*wp++ = bRow[j];
+				*wp++ = 255;
+			}
+			rRow += image.linesize[2];
+			gRow += image.linesize[0];
+			bRow += image.linesize[1];
+		}
+		return true;
+	} else if (image.chromaShiftW == 1 && image.chromaShiftH == 1) {
+
+		yuv420_2_rgb8888(w.ptr(), image.planes[0], image.planes[1], image.planes[2], image.w, image.h, image.linesize[0], image.linesize[1], image.w << 2);
+		//libyuv::I420ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
+		return true;
+	} else if (image.chromaShiftW == 1 && image.chromaShiftH == 0) {
+
+		yuv422_2_rgb8888(w.ptr(), image.planes[0], image.planes[1], image.planes[2], image.w, image.h, image.linesize[0], image.linesize[1], image.w << 2);
+		//libyuv::I422ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
+		return true;
+	} else if (image.chromaShiftW == 0 && image.chromaShiftH == 0) {
+
+		yuv444_2_rgb8888(w.ptr(), image.planes[0], image.planes[1], image.planes[2], image.w, image.h, image.linesize[0], image.linesize[1], image.w << 2);
+		//libyuv::I444ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
+		return true;
+	} else if (image.chromaShiftW == 2 && image.chromaShiftH == 0) {
+
+		//libyuv::I411ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2] image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
+	}
+	return false;
+}
+
+void VideoStreamPlaybackWebm::_decode_frames() {
+
+	while (!decode_exit) {
+
+		decode_mutex->lock();
+
+		int slot = -1;
+		for (int i = 0; i < MAX_FRAMES; i++) {
+			if (frames[i].state == FRAME_FREE) {
+				slot = i;
+				break;
+			}
+		}
+
+		if (slot == -1 || video_frames_pos == 0) {
+			//Nothing to decode or nowhere to put it, wait for the main thread
+			decode_mutex->unlock();
+			return;
+		}
+
+		//The main thread only appends, so the first frame stays put while it is decoded
+		WebMFrame *video_frame = video_frames[0];
+		frames[slot].state = FRAME_DECODING;
+		decoding = true;
+		const double clock = decode_time;
+
+		decode_mutex->unlock();
+
+		// It seems VPXDecoder::decode has to be executed even though we might skip this frame
+		bool converted = false;
+		if (video->decode(*video_frame) && video_frame->time >= clock) {
+			converted = _convert_frame(frames[slot]);
+		}
+
+		decode_mutex->lock();
+		if (converted) {
+			frames[slot].time = video_frame->time;
+			frames[slot].state = FRAME_READY;
+		} else {
+			frames[slot].state = FRAME_FREE;
+		}
+		memmove(video_frames, video_frames + 1, (--video_frames_pos) * sizeof(void *));
+		video_frames[video_frames_pos] = video_frame;
+		decoding = false;
+		decode_mutex->unlock();
+	}
+}
+
+void VideoStreamPlaybackWebm::_decode_thread(void *ud) {
+
+	VideoStreamPlaybackWebm *vs = (VideoStreamPlaybackWebm *)ud;
+
+	while (!vs->decode_exit) {
+
+		vs->decode_sem->wait();
+		vs->_decode_frames();
+	}
+}
+
+void VideoStreamPlaybackWebm::_start_decoding() {
+
+	decode_exit = false;
+	decoding = false;
+	decode_time = 0.0;
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		frames[i].state = FRAME_FREE;
+	}
+
+	decode_thread = Thread::create(_decode_thread, this);
+}
+
+void VideoStreamPlaybackWebm::_stop_decoding() {
+
+	if (!decode_thread)
+		return;
+
+	decode_exit = true;
+	decode_sem->post();
+	Thread::wait_to_finish(decode_thread);
+	memdelete(decode_thread);
+	decode_thread = NULL;
+
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		frames[i].data = PoolVector<uint8_t>();
+		frames[i].state = FRAME_FREE;
+	}
+}
+
+bool VideoStreamPlaybackWebm::_present_frame() {
+
+	if (time < video_pos)
+		return false;
+
+	decode_mutex->lock();
+
+	//The next frame to show is the first one that is not late, if the
+	//decoder fell behind and all of them are, show the most recent one
+	const double clock = decode_time;
+	int next = -1;
+	int late = -1;
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		if (frames[i].state != FRAME_READY)
+			continue;
+		if (frames[i].time >= clock) {
+			if (next == -1 || frames[i].time < frames[next].time)
+				next = i;
+		} else if (late == -1 || frames[i].time > frames[late].time) {
+			late = i;
+		}
+	}
+
+	const int show = next != -1 ? next : late;
+	if (show == -1) {
+		decode_mutex->unlock();
+		return false;
+	}
+
+	//Drop everything older than what is shown now
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		if (frames[i].state == FRAME_READY && frames[i].time < frames[show].time)
+			frames[i].state = FRAME_FREE;
+	}
+
+	//Hand the buffer over, the decoder allocates a new one for this slot
+	PoolVector<uint8_t> data = frames[show].data;
+	frames[show].data = PoolVector<uint8_t>();
+	frames[show].state = FRAME_FREE;
+	video_pos = frames[show].time;
+
+	decode_mutex->unlock();
+
+	decode_sem->post();
+
+	Ref<Image> img = memnew(Image(webm->getWidth(), webm->getHeight(), 0, Image::FORMAT_RGBA8, data));
+	texture->set_data(img); //Zero copy send to visual server
+	return true;
 }
 
 void VideoStreamPlaybackWebm::delete_pointers() {
 
+	_stop_decoding();
+
 	if (pcm)
 		memfree(pcm);
 
 	if (audio_frame)
 		memdelete(audio_frame);
+	if (demux_frame)
+		memdelete(demux_frame);
 	if (video_frames) {
 		for (int i = 0; i < video_frames_capacity; ++i)
 			memdelete(video_frames[i]);
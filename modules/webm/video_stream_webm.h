@@ -32,6 +32,9 @@
 #define VIDEO_STREAM_WEBM_H
 
 #include "core/io/resource_loader.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "scene/resources/video_stream.h"
 
 class WebMFrame;
@@ -43,6 +46,22 @@ class VideoStreamPlaybackWebm : public VideoStreamPlayback {
 
 	GDCLASS(VideoStreamPlaybackWebm, VideoStreamPlayback);
 
+	enum {
+		MAX_FRAMES = 4,
+	};
+
+	enum FrameState {
+		FRAME_FREE,
+		FRAME_DECODING,
+		FRAME_READY,
+	};
+
+	struct VideoFrame {
+		PoolVector<uint8_t> data;
+		double time;
+		FrameState state;
+	};
+
 	String file_name;
 	int audio_track;
 
@@ -50,9 +69,19 @@ class VideoStreamPlaybackWebm : public VideoStreamPlayback {
 	VPXDecoder *video;
 	OpusVorbisDecoder *audio;
 
-	WebMFrame **video_frames, *audio_frame;
+	WebMFrame **video_frames, *audio_frame, *demux_frame;
 	int video_frames_pos, video_frames_capacity;
 
+	//video_frames are demuxed on the main thread and decoded on
+	//decode_thread, which converts the ones still worth showing into frames
+	VideoFrame frames[MAX_FRAMES];
+	Mutex *decode_mutex;
+	Semaphore *decode_sem;
+	Thread *decode_thread;
+	volatile bool decode_exit;
+	bool decoding;
+	double decode_time;
+
 	int num_decoded_samples, samples_offset;
 	AudioMixCallback mix_callback;
 	void *mix_udata;
@@ -61,7 +90,6 @@ class VideoStreamPlaybackWebm : public VideoStreamPlayback {
 	double delay_compensation;
 	double time, video_frame_delay, video_pos;
 
-	PoolVector<uint8_t> frame_data;
 	Ref<ImageTexture> texture;
 
 	float *pcm;
@@ -99,7 +127,14 @@ public:
 
 private:
 	inline bool has_enough_video_frames() const;
-	bool should_process(WebMFrame &video_frame);
+	double get_decode_time() const;
+
+	static void _decode_thread(void *ud);
+	void _decode_frames();
+	bool _convert_frame(VideoFrame &p_frame);
+	void _start_decoding();
+	void _stop_decoding();
+	bool _present_frame();
 
 	void delete_pointers();
 };
@@ -143,6 +143,63 @@ Error webp_load_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p
 	return OK;
 }
 
+//libwebp rescales while decoding, so the full size image is never allocated
+static Error webp_load_shrunk_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p_buffer_len, int p_shrink) {
+
+	ERR_FAIL_NULL_V(p_image, ERR_INVALID_PARAMETER);
+
+	WebPDecoderConfig config;
+	if (!WebPInitDecoderConfig(&config)) {
+		ERR_FAIL_V(ERR_UNAVAILABLE);
+	}
+
+	if (WebPGetFeatures(p_buffer, p_buffer_len, &config.input) != VP8_STATUS_OK) {
+		ERR_FAIL_V(ERR_FILE_CORRUPT);
+	}
+
+	while (p_shrink > 0 && ((config.input.width >> p_shrink) == 0 || (config.input.height >> p_shrink) == 0)) {
+		p_shrink--;
+	}
+
+	const int width = config.input.width >> p_shrink;
+	const int height = config.input.height >> p_shrink;
+	const bool has_alpha = config.input.has_alpha;
+	const int pixel_size = has_alpha ? 4 : 3;
+
+	PoolVector<uint8_t> dst_image;
+	int datasize = width * height * pixel_size;
+	dst_image.resize(datasize);
+	PoolVector<uint8_t>::Write dst_w = dst_image.write();
+
+	config.options.use_scaling = 1;
+	config.options.scaled_width = width;
+	config.options.scaled_height = height;
+	config.output.colorspace = has_alpha ? MODE_RGBA : MODE_RGB;
+	config.output.is_external_memory = 1;
+	config.output.u.RGBA.rgba = dst_w.ptr();
+	config.output.u.RGBA.stride = width * pixel_size;
+	config.output.u.RGBA.size = datasize;
+
+	bool errdec = WebPDecode(p_buffer, p_buffer_len, &config) != VP8_STATUS_OK;
+	WebPFreeDecBuffer(&config.output);
+	dst_w.release();
+
+	ERR_FAIL_COND_V_MSG(errdec, ERR_FILE_CORRUPT, "Failed decoding WebP image.");
+
+	p_image->create(width, height, 0, has_alpha ? Image::FORMAT_RGBA8 : Image::FORMAT_RGB8, dst_image);
+
+	return OK;
+}
+
+static Ref<Image> _webp_mem_shrink_loader_func(const uint8_t *p_data, int p_size, int p_shrink) {
+
+	Ref<Image> img;
+	img.instance();
+	Error err = webp_load_shrunk_image_from_buffer(img.ptr(), p_data, p_size, p_shrink);
+	ERR_FAIL_COND_V(err, Ref<Image>());
+	return img;
+}
+
 static Ref<Image> _webp_mem_loader_func(const uint8_t *p_png, int p_size) {
 
 	Ref<Image> img;
@@ -177,6 +234,7 @@ void ImageLoaderWEBP::get_recognized_extensions(List<String> *p_extensions) cons
 
 ImageLoaderWEBP::ImageLoaderWEBP() {
 	Image::_webp_mem_loader_func = _webp_mem_loader_func;
+	Image::_webp_mem_shrink_loader_func = _webp_mem_shrink_loader_func;
 	Image::lossy_packer = _webp_lossy_pack;
 	Image::lossy_unpacker = _webp_lossy_unpack;
 }
@@ -45,6 +45,7 @@ private:
 
 	RingBuffer<_Packet> _packets;
 	RingBuffer<uint8_t> _payload;
+	uint32_t _held; // Payload of the packet handed out by read_packet_view().
 
 public:
 	Error write_packet(const uint8_t *p_payload, uint32_t p_size, const T *p_info) {
@@ -80,6 +81,7 @@ public:
 	}
 
 	Error read_packet(uint8_t *r_payload, int p_bytes, T *r_info, int &r_read) {
+		release_view();
 		ERR_FAIL_COND_V(_packets.data_left() < 1, ERR_UNAVAILABLE);
 		_Packet p;
 		_packets.read(&p, 1);
@@ -92,11 +94,45 @@ public:
 		return OK;
 	}
 
+	// Reads the next packet without copying when its payload is contiguous in the ring.
+	// The payload stays reserved until the next read or release_view().
+	// If the payload wraps around, r_payload is set to NULL and the packet is left
+	// in the buffer so it can be copied out with read_packet() instead.
+	Error read_packet_view(const uint8_t **r_payload, T *r_info, int &r_read) {
+		release_view();
+		ERR_FAIL_COND_V(_packets.data_left() < 1, ERR_UNAVAILABLE);
+		_Packet p;
+		_packets.copy(&p, 0, 1);
+		ERR_FAIL_COND_V(_payload.data_left() < (int)p.size, ERR_BUG);
+
+		r_read = p.size;
+		*r_payload = _payload.get_read_ptr(p.size);
+		if (!*r_payload)
+			return OK;
+
+		_packets.advance_read(1);
+		copymem(r_info, &p.info, sizeof(T));
+		_held = p.size;
+		return OK;
+	}
+
+	void release_view() {
+		if (_held) {
+			_payload.advance_read(_held);
+			_held = 0;
+		}
+	}
+
 	void discard_payload(int p_size) {
-		_packets.decrease_write(p_size);
+		_payload.decrease_write(p_size);
+	}
+
+	int payload_space_left() const {
+		return _payload.space_left();
 	}
 
 	void resize(int p_pkt_shift, int p_buf_shift) {
+		_held = 0;
 		_packets.resize(p_pkt_shift);
 		_payload.resize(p_buf_shift);
 	}
@@ -106,11 +142,13 @@ public:
 	}
 
 	void clear() {
+		_held = 0;
 		_payload.resize(0);
 		_packets.resize(0);
 	}
 
 	PacketBuffer() {
+		_held = 0;
 		clear();
 	}
 
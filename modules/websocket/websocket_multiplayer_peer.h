@@ -70,6 +70,7 @@ protected:
 	int _target_peer;
 	int _peer_id;
 	int _refusing;
+	bool _compression_enabled;
 
 	static void _bind_methods();
 
@@ -99,6 +100,8 @@ public:
 	/* WebSocketPeer */
 	virtual Error set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer, int p_out_packets) = 0;
 	virtual Ref<WebSocketPeer> get_peer(int p_peer_id) const = 0;
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
 
 	void _process_multiplayer(Ref<WebSocketPeer> p_peer, uint32_t p_peer_id);
 	void _clear();
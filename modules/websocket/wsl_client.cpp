@@ -76,14 +76,15 @@ void WSLClient::_do_handshake() {
 			if (l > 3 && r[l] == '\n' && r[l - 1] == '\r' && r[l - 2] == '\n' && r[l - 3] == '\r') {
 				r[l - 3] = '\0';
 				String protocol;
+				WSLPeer::PeerData *data = memnew(struct WSLPeer::PeerData);
 				// Response is over, verify headers and create peer.
-				if (!_verify_headers(protocol)) {
+				if (!_verify_headers(protocol, data)) {
+					memdelete(data);
 					disconnect_from_host();
 					_on_error();
 					ERR_FAIL_MSG("Invalid response headers.");
 				}
 				// Create peer.
-				WSLPeer::PeerData *data = memnew(struct WSLPeer::PeerData);
 				data->obj = this;
 				data->conn = _connection;
 				data->tcp = _tcp;
@@ -99,7 +100,7 @@ void WSLClient::_do_handshake() {
 	}
 }
 
-bool WSLClient::_verify_headers(String &r_protocol) {
+bool WSLClient::_verify_headers(String &r_protocol, WSLPeer::PeerData *r_data) {
 	String s = (char *)_resp_buf;
 	Vector<String> psa = s.split("\r\n");
 	int len = psa.size();
@@ -150,6 +151,13 @@ bool WSLClient::_verify_headers(String &r_protocol) {
 		if (!valid)
 			return false;
 	}
+	if (headers.has("sec-websocket-extensions")) {
+		// The server must not enable extensions we did not offer.
+		ERR_FAIL_COND_V_MSG(!_deflate_offered, false, "Unexpected WebSocket extensions '" + headers["sec-websocket-extensions"] + "'.");
+		if (!WSLPeer::verify_deflate_response(headers["sec-websocket-extensions"], r_data->deflate_window_bits, r_data->deflate_no_context_takeover))
+			return false;
+		r_data->deflate = true;
+	}
 	return true;
 }
 
@@ -206,6 +214,10 @@ Error WSLClient::connect_to_host(String p_host, String p_path, uint16_t p_port,
 		}
 		request += "\r\n";
 	}
+	_deflate_offered = _compression_enabled;
+	if (_deflate_offered) {
+		request += "Sec-WebSocket-Extensions: " + WSLPeer::get_deflate_offer() + "\r\n";
+	}
 	for (int i = 0; i < p_custom_headers.size(); i++) {
 		request += p_custom_headers[i] + "\r\n";
 	}
@@ -305,6 +317,7 @@ void WSLClient::disconnect_from_host(int p_code, String p_reason) {
 	_host = "";
 	_protocols.clear();
 	_use_ssl = false;
+	_deflate_offered = false;
 
 	_request = "";
 	_requested = 0;
@@ -66,9 +66,10 @@ private:
 	String _host;
 	Vector<String> _protocols;
 	bool _use_ssl;
+	bool _deflate_offered;
 
 	void _do_handshake();
-	bool _verify_headers(String &r_protocol);
+	bool _verify_headers(String &r_protocol, WSLPeer::PeerData *r_data);
 
 public:
 	Error set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer, int p_out_packets);
@@ -36,9 +36,14 @@
 #include "wsl_server.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
 #include "core/math/random_number_generator.h"
 #include "core/os/os.h"
 
+#include <zlib.h>
+
+#define WSL_INFLATE_CHUNK_SIZE 16384
+
 String WSLPeer::generate_key() {
 	// Random key
 	RandomNumberGenerator rng;
@@ -59,6 +64,99 @@ String WSLPeer::compute_key_response(String p_key) {
 	return CryptoCore::b64_encode_str(sha.ptr(), sha.size());
 }
 
+static bool _wsl_parse_deflate(const String &p_extension, Map<String, String> &r_params) {
+	Vector<String> parts = p_extension.split(";");
+	if (parts[0].strip_edges().to_lower() != "permessage-deflate")
+		return false;
+	for (int i = 1; i < parts.size(); i++) {
+		Vector<String> param = parts[i].split("=", false, 1);
+		if (param.size() == 0)
+			continue;
+		String name = param[0].strip_edges().to_lower();
+		String value = param.size() > 1 ? param[1].strip_edges().trim_prefix("\"").trim_suffix("\"") : "";
+		if (r_params.has(name))
+			return false; // Parameters must not be repeated.
+		r_params[name] = value;
+	}
+	return true;
+}
+
+static int _wsl_window_bits(const String &p_value, int p_min) {
+	if (!p_value.is_valid_integer())
+		return -1;
+	int bits = p_value.to_int();
+	if (bits < p_min || bits > 15)
+		return -1;
+	return bits;
+}
+
+String WSLPeer::get_deflate_offer() {
+	// We always inflate with the largest window, so the server may limit ours as it wants.
+	return "permessage-deflate; client_max_window_bits";
+}
+
+bool WSLPeer::accept_deflate_offer(const String &p_offers, String &r_response, int &r_window_bits, bool &r_no_context_takeover) {
+	Vector<String> offers = p_offers.split(",");
+	for (int i = 0; i < offers.size(); i++) {
+		Map<String, String> params;
+		if (!_wsl_parse_deflate(offers[i], params))
+			continue;
+		String response = "permessage-deflate";
+		int window_bits = 15;
+		bool no_context_takeover = false;
+		bool valid = true;
+		for (Map<String, String>::Element *E = params.front(); E && valid; E = E->next()) {
+			if (E->key() == "server_no_context_takeover" && E->get() == "") {
+				no_context_takeover = true;
+				response += "; server_no_context_takeover";
+			} else if (E->key() == "server_max_window_bits") {
+				// zlib can't deflate with 8 bits windows (it silently uses 9), decline those.
+				window_bits = _wsl_window_bits(E->get(), 9);
+				valid = window_bits != -1;
+				response += "; server_max_window_bits=" + itos(window_bits);
+			} else if (E->key() == "client_no_context_takeover" && E->get() == "") {
+				// Only affects the client, we can inflate either way.
+			} else if (E->key() == "client_max_window_bits") {
+				valid = E->get() == "" || _wsl_window_bits(E->get(), 8) != -1;
+			} else {
+				valid = false;
+			}
+		}
+		if (!valid)
+			continue;
+		r_response = response;
+		r_window_bits = window_bits;
+		r_no_context_takeover = no_context_takeover;
+		return true;
+	}
+	return false;
+}
+
+bool WSLPeer::verify_deflate_response(const String &p_response, int &r_window_bits, bool &r_no_context_takeover) {
+	Vector<String> extensions = p_response.split(",");
+	ERR_FAIL_COND_V_MSG(extensions.size() != 1, false, "Unexpected WebSocket extensions '" + p_response + "'.");
+	Map<String, String> params;
+	ERR_FAIL_COND_V_MSG(!_wsl_parse_deflate(extensions[0], params), false, "Unsupported WebSocket extension '" + p_response + "'.");
+
+	r_window_bits = 15;
+	r_no_context_takeover = false;
+	for (Map<String, String>::Element *E = params.front(); E; E = E->next()) {
+		if (E->key() == "client_no_context_takeover" && E->get() == "") {
+			r_no_context_takeover = true;
+		} else if (E->key() == "client_max_window_bits") {
+			r_window_bits = _wsl_window_bits(E->get(), 9);
+			ERR_FAIL_COND_V_MSG(r_window_bits == -1, false, "Unsupported permessage-deflate client_max_window_bits '" + E->get() + "'.");
+		} else if (E->key() == "server_no_context_takeover" && E->get() == "") {
+			// Only affects the server, we can inflate either way.
+		} else if (E->key() == "server_max_window_bits") {
+			ERR_FAIL_COND_V_MSG(_wsl_window_bits(E->get(), 8) == -1, false, "Invalid permessage-deflate server_max_window_bits '" + E->get() + "'.");
+		} else {
+			ERR_FAIL_V_MSG(false, "Invalid permessage-deflate parameter '" + E->key() + "'.");
+		}
+	}
+	return true;
+}
+
 void WSLPeer::_wsl_destroy(struct PeerData **p_data) {
 	if (!p_data || !(*p_data))
 		return;
@@ -140,6 +238,24 @@ int wsl_genmask_callback(wslay_event_context_ptr ctx, uint8_t *buf, size_t len,
 	return 0;
 }
 
+void wsl_frame_recv_start_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_frame_recv_start_arg *arg, void *user_data) {
+	struct WSLPeer::PeerData *peer_data = (struct WSLPeer::PeerData *)user_data;
+	if (!peer_data->valid || peer_data->closing) {
+		return;
+	}
+	WSLPeer *peer = (WSLPeer *)peer_data->peer;
+	peer->parse_frame_start(arg);
+}
+
+void wsl_frame_recv_chunk_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_frame_recv_chunk_arg *arg, void *user_data) {
+	struct WSLPeer::PeerData *peer_data = (struct WSLPeer::PeerData *)user_data;
+	if (!peer_data->valid || peer_data->closing) {
+		return;
+	}
+	WSLPeer *peer = (WSLPeer *)peer_data->peer;
+	peer->parse_frame_chunk(arg);
+}
+
 void wsl_msg_recv_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_msg_recv_arg *arg, void *user_data) {
 	struct WSLPeer::PeerData *peer_data = (struct WSLPeer::PeerData *)user_data;
 	if (!peer_data->valid || peer_data->closing) {
@@ -163,8 +279,8 @@ wslay_event_callbacks wsl_callbacks = {
 	wsl_recv_callback,
 	wsl_send_callback,
 	wsl_genmask_callback,
-	NULL, /* on_frame_recv_start_callback */
-	NULL, /* on_frame_recv_callback */
+	wsl_frame_recv_start_callback,
+	wsl_frame_recv_chunk_callback,
 	NULL, /* on_frame_recv_end_callback */
 	wsl_msg_recv_callback
 };
@@ -194,26 +310,136 @@ Error WSLPeer::parse_message(const wslay_event_on_msg_recv_arg *arg) {
 		// Ping or pong
 		return ERR_SKIP;
 	}
-	_in_buffer.write_packet(arg->msg, arg->msg_length, &is_string);
+	// The payload was already written by parse_frame_chunk, only the packet info is left.
+	if (_in_msg_compressed && !_in_msg_dropped) {
+		static const uint8_t tail[4] = { 0x00, 0x00, 0xff, 0xff };
+		_inflate_payload(tail, 4);
+	}
+	if (_in_msg_dropped)
+		return ERR_SKIP;
+	if (_in_buffer.write_packet(NULL, _in_msg_size, &is_string) != OK) {
+		_in_buffer.discard_payload(_in_msg_size);
+		return ERR_OUT_OF_MEMORY;
+	}
 	return OK;
 }
 
+void WSLPeer::parse_frame_start(const wslay_event_on_frame_recv_start_arg *arg) {
+	// Control frames can be interleaved with the fragments of a message, wslay buffers those.
+	_in_frame_data = (arg->opcode & 0x8) == 0;
+	if (!_in_frame_data || arg->opcode == WSLAY_CONTINUATION_FRAME)
+		return;
+	_in_msg_compressed = wslay_get_rsv1(arg->rsv);
+	_in_msg_dropped = false;
+	_in_msg_size = 0;
+}
+
+void WSLPeer::parse_frame_chunk(const wslay_event_on_frame_recv_chunk_arg *arg) {
+	if (!_in_frame_data || _in_msg_dropped)
+		return;
+	if (_in_msg_compressed) {
+		_inflate_payload(arg->data, arg->data_length);
+	} else {
+		_write_payload(arg->data, arg->data_length);
+	}
+}
+
+void WSLPeer::_write_payload(const uint8_t *p_data, int p_size) {
+	if (_in_buffer.payload_space_left() < p_size) {
+		ERR_PRINT("Buffer payload full! Dropping data.");
+		_drop_message();
+		return;
+	}
+	_in_buffer.write_packet(p_data, p_size, NULL);
+	_in_msg_size += p_size;
+}
+
+void WSLPeer::_inflate_payload(const uint8_t *p_data, int p_size) {
+	ERR_FAIL_COND(!_inflate);
+	_inflate->next_in = (Bytef *)p_data;
+	_inflate->avail_in = p_size;
+	do {
+		_inflate->next_out = _inflate_buffer.ptrw();
+		_inflate->avail_out = _inflate_buffer.size();
+		int ret = inflate(_inflate, Z_SYNC_FLUSH);
+		if (ret == Z_STREAM_END) {
+			// The sender ended the deflate stream, the next block starts a new one.
+			inflateReset(_inflate);
+		} else if (ret == Z_BUF_ERROR) {
+			break; // Needs more input.
+		} else if (ret != Z_OK) {
+			ERR_PRINT("Invalid compressed WebSocket message, closing connection.");
+			_drop_message();
+			wslay_event_queue_close(_data->ctx, WSLAY_CODE_INVALID_FRAME_PAYLOAD_DATA, NULL, 0);
+			return;
+		}
+		int produced = _inflate_buffer.size() - _inflate->avail_out;
+		if (produced > 0) {
+			_write_payload(_inflate_buffer.ptr(), produced);
+			if (_in_msg_dropped)
+				return;
+		}
+	} while (_inflate->avail_out == 0 || _inflate->avail_in > 0);
+}
+
+void WSLPeer::_drop_message() {
+	_in_buffer.discard_payload(_in_msg_size);
+	_in_msg_size = 0;
+	_in_msg_dropped = true;
+}
+
+void WSLPeer::_free_streams() {
+	if (_deflate) {
+		deflateEnd(_deflate);
+		memdelete(_deflate);
+		_deflate = NULL;
+	}
+	if (_inflate) {
+		inflateEnd(_inflate);
+		memdelete(_inflate);
+		_inflate = NULL;
+	}
+	_deflate_buffer.clear();
+	_inflate_buffer.clear();
+}
+
 void WSLPeer::make_context(PeerData *p_data, unsigned int p_in_buf_size, unsigned int p_in_pkt_size, unsigned int p_out_buf_size, unsigned int p_out_pkt_size) {
 	ERR_FAIL_COND(_data != NULL);
 	ERR_FAIL_COND(p_data == NULL);
 
 	_in_buffer.resize(p_in_pkt_size, p_in_buf_size);
-	_packet_buffer.resize((1 << MAX(p_in_buf_size, p_out_buf_size)));
+	_max_packet_size = 1 << MAX(p_in_buf_size, p_out_buf_size);
+	_in_frame_data = false;
+	_in_msg_compressed = false;
+	_in_msg_dropped = false;
+	_in_msg_size = 0;
 
 	_data = p_data;
 	_data->peer = this;
 	_data->valid = true;
 
+	_free_streams();
+	if (_data->deflate) {
+		_deflate = memnew(z_stream);
+		memset(_deflate, 0, sizeof(z_stream));
+		deflateInit2(_deflate, Compression::zlib_level, Z_DEFLATED, -_data->deflate_window_bits, 8, Z_DEFAULT_STRATEGY);
+		_deflate_no_context_takeover = _data->deflate_no_context_takeover;
+
+		_inflate = memnew(z_stream);
+		memset(_inflate, 0, sizeof(z_stream));
+		inflateInit2(_inflate, -15); // Works for any window the peer uses.
+		_inflate_buffer.resize(WSL_INFLATE_CHUNK_SIZE);
+	}
+
 	if (_data->is_server)
 		wslay_event_context_server_init(&(_data->ctx), &wsl_callbacks, _data);
 	else
 		wslay_event_context_client_init(&(_data->ctx), &wsl_callbacks, _data);
 	wslay_event_config_set_max_recv_msg_length(_data->ctx, (1ULL << p_in_buf_size));
+	// Data frames are written to _in_buffer by the frame callbacks, skip wslay's own copy.
+	wslay_event_config_set_no_buffering(_data->ctx, 1);
+	if (_data->deflate)
+		wslay_event_config_set_allowed_rsv_bits(_data->ctx, WSLAY_RSV1_BIT);
 }
 
 void WSLPeer::set_write_mode(WriteMode p_mode) {
@@ -233,6 +459,23 @@ void WSLPeer::poll() {
 	}
 }
 
+bool WSLPeer::is_poll_needed(const Set<ObjectID> &p_active_connections) const {
+	if (!_data)
+		return false;
+
+	if (_data->destroy || _data->tcp.is_null() || !_data->tcp->is_polled_by_server())
+		return true;
+
+	// SSL may hold decrypted data the socket no longer shows.
+	if ((Object *)_data->conn.ptr() != (Object *)_data->tcp.ptr())
+		return true;
+
+	if (wslay_event_want_write(_data->ctx))
+		return true;
+
+	return p_active_connections.has(_data->tcp->get_instance_id());
+}
+
 Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 
 	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
@@ -242,7 +485,28 @@ Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 	msg.msg = p_buffer;
 	msg.msg_length = p_buffer_size;
 
-	wslay_event_queue_msg(_data->ctx, &msg);
+	if (_deflate) {
+		uLong bound = deflateBound(_deflate, p_buffer_size) + 16; // Room for the sync flush marker.
+		if ((uLong)_deflate_buffer.size() < bound)
+			_deflate_buffer.resize(bound);
+		_deflate->next_in = (Bytef *)p_buffer;
+		_deflate->avail_in = p_buffer_size;
+		_deflate->next_out = _deflate_buffer.ptrw();
+		_deflate->avail_out = _deflate_buffer.size();
+		int ret = deflate(_deflate, Z_SYNC_FLUSH);
+		ERR_FAIL_COND_V(ret != Z_OK || _deflate->avail_in != 0 || _deflate->avail_out == 0, FAILED);
+		size_t size = _deflate_buffer.size() - _deflate->avail_out;
+		ERR_FAIL_COND_V(size < 4, FAILED);
+		if (_deflate_no_context_takeover)
+			deflateReset(_deflate);
+
+		// Messages are sent without the 0x00 0x00 0xff 0xff flush marker.
+		msg.msg = _deflate_buffer.ptr();
+		msg.msg_length = size - 4;
+		wslay_event_queue_msg_ex(_data->ctx, &msg, WSLAY_RSV1_BIT);
+	} else {
+		wslay_event_queue_msg(_data->ctx, &msg);
+	}
 	if (wslay_event_send(_data->ctx) < 0) {
 		close_now();
 		return FAILED;
@@ -256,14 +520,25 @@ Error WSLPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 
 	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
 
+	// Releases the payload of the previous packet.
+	_in_buffer.release_view();
+
 	if (_in_buffer.packets_left() == 0)
 		return ERR_UNAVAILABLE;
 
 	int read = 0;
-	PoolVector<uint8_t>::Write rw = _packet_buffer.write();
-	_in_buffer.read_packet(rw.ptr(), _packet_buffer.size(), &_is_string, read);
+	const uint8_t *payload = NULL;
+	_in_buffer.read_packet_view(&payload, &_is_string, read);
+
+	if (!payload) {
+		// Wraps around the end of the ring buffer, needs a copy.
+		if (_packet_buffer.size() < read)
+			_packet_buffer.resize(read);
+		_in_buffer.read_packet(_packet_buffer.ptrw(), _packet_buffer.size(), &_is_string, read);
+		payload = _packet_buffer.ptr();
+	}
 
-	*r_buffer = rw.ptr();
+	*r_buffer = payload;
 	r_buffer_size = read;
 
 	return OK;
@@ -301,7 +576,8 @@ void WSLPeer::close(int p_code, String p_reason) {
 	}
 
 	_in_buffer.clear();
-	_packet_buffer.resize(0);
+	_packet_buffer.clear();
+	_free_streams();
 }
 
 IP_Address WSLPeer::get_connected_host() const {
@@ -332,6 +608,14 @@ void WSLPeer::invalidate() {
 WSLPeer::WSLPeer() {
 	_data = NULL;
 	_is_string = 0;
+	_in_frame_data = false;
+	_in_msg_compressed = false;
+	_in_msg_dropped = false;
+	_in_msg_size = 0;
+	_max_packet_size = 0;
+	_deflate = NULL;
+	_inflate = NULL;
+	_deflate_no_context_takeover = false;
 	close_code = -1;
 	write_mode = WRITE_MODE_BINARY;
 }
@@ -43,6 +43,8 @@
 
 #define WSL_MAX_HEADER_SIZE 4096
 
+struct z_stream_s;
+
 class WSLPeer : public WebSocketPeer {
 
 	GDCIIMPL(WSLPeer, WebSocketPeer);
@@ -60,6 +62,10 @@ public:
 		Ref<StreamPeerTCP> tcp;
 		int id;
 		wslay_event_context_ptr ctx;
+		// Negotiated permessage-deflate settings for what this peer sends.
+		bool deflate;
+		int deflate_window_bits;
+		bool deflate_no_context_takeover;
 
 		PeerData() {
 			polling = false;
@@ -71,12 +77,20 @@ public:
 			obj = NULL;
 			closing = false;
 			peer = NULL;
+			deflate = false;
+			deflate_window_bits = 15;
+			deflate_no_context_takeover = false;
 		}
 	};
 
 	static String compute_key_response(String p_key);
 	static String generate_key();
 
+	// permessage-deflate (RFC 7692) negotiation.
+	static String get_deflate_offer();
+	static bool accept_deflate_offer(const String &p_offers, String &r_response, int &r_window_bits, bool &r_no_context_takeover);
+	static bool verify_deflate_response(const String &p_response, int &r_window_bits, bool &r_no_context_takeover);
+
 private:
 	static bool _wsl_poll(struct PeerData *p_data);
 	static void _wsl_destroy(struct PeerData **p_data);
@@ -86,19 +100,39 @@ private:
 	// Our packet info is just a boolean (is_string), using uint8_t for it.
 	PacketBuffer<uint8_t> _in_buffer;
 
-	PoolVector<uint8_t> _packet_buffer;
+	// Data messages are written straight into _in_buffer as their frames arrive.
+	bool _in_frame_data;
+	bool _in_msg_compressed;
+	bool _in_msg_dropped;
+	int _in_msg_size;
+
+	// Only used for packets wrapping around the end of _in_buffer.
+	Vector<uint8_t> _packet_buffer;
+	int _max_packet_size;
+
+	z_stream_s *_deflate;
+	z_stream_s *_inflate;
+	bool _deflate_no_context_takeover;
+	Vector<uint8_t> _deflate_buffer;
+	Vector<uint8_t> _inflate_buffer;
 
 	WriteMode write_mode;
 
+	void _write_payload(const uint8_t *p_data, int p_size);
+	void _inflate_payload(const uint8_t *p_data, int p_size);
+	void _drop_message();
+	void _free_streams();
+
 public:
 	int close_code;
 	String close_reason;
 	void poll(); // Used by client and server.
+	bool is_poll_needed(const Set<ObjectID> &p_active_connections) const; // Used by server, with the connections its TCP_Server reported.
 
 	virtual int get_available_packet_count() const;
 	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size);
 	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size);
-	virtual int get_max_packet_size() const { return _packet_buffer.size(); };
+	virtual int get_max_packet_size() const { return _max_packet_size; };
 
 	virtual void close_now();
 	virtual void close(int p_code = 1000, String p_reason = "");
@@ -113,6 +147,8 @@ public:
 
 	void make_context(PeerData *p_data, unsigned int p_in_buf_size, unsigned int p_in_pkt_size, unsigned int p_out_buf_size, unsigned int p_out_pkt_size);
 	Error parse_message(const wslay_event_on_msg_recv_arg *arg);
+	void parse_frame_start(const wslay_event_on_frame_recv_start_arg *arg);
+	void parse_frame_chunk(const wslay_event_on_frame_recv_chunk_arg *arg);
 	void invalidate();
 
 	WSLPeer();
@@ -40,10 +40,13 @@ WSLServer::PendingPeer::PendingPeer() {
 	has_request = false;
 	response_sent = 0;
 	req_pos = 0;
+	deflate = false;
+	deflate_window_bits = 15;
+	deflate_no_context_takeover = false;
 	memset(req_buf, 0, sizeof(req_buf));
 }
 
-bool WSLServer::PendingPeer::_parse_request(const Vector<String> p_protocols) {
+bool WSLServer::PendingPeer::_parse_request(const Vector<String> p_protocols, bool p_compression) {
 	Vector<String> psa = String((char *)req_buf).split("\r\n");
 	int len = psa.size();
 	ERR_FAIL_COND_V_MSG(len < 4, false, "Not enough response headers, got: " + itos(len) + ", expected >= 4.");
@@ -96,10 +99,14 @@ bool WSLServer::PendingPeer::_parse_request(const Vector<String> p_protocols) {
 			return false;
 	} else if (p_protocols.size() > 0) // No protocol requested, but we need one
 		return false;
+	if (p_compression && headers.has("sec-websocket-extensions")) {
+		// Unsupported or invalid offers are simply declined.
+		deflate = WSLPeer::accept_deflate_offer(headers["sec-websocket-extensions"], extensions, deflate_window_bits, deflate_no_context_takeover);
+	}
 	return true;
 }
 
-Error WSLServer::PendingPeer::do_handshake(const Vector<String> p_protocols) {
+Error WSLServer::PendingPeer::do_handshake(const Vector<String> p_protocols, bool p_compression) {
 	if (OS::get_singleton()->get_ticks_msec() - time > WSL_SERVER_TIMEOUT)
 		return ERR_TIMEOUT;
 	if (use_ssl) {
@@ -125,7 +132,7 @@ Error WSLServer::PendingPeer::do_handshake(const Vector<String> p_protocols) {
 			int l = req_pos;
 			if (l > 3 && r[l] == '\n' && r[l - 1] == '\r' && r[l - 2] == '\n' && r[l - 3] == '\r') {
 				r[l - 3] = '\0';
-				if (!_parse_request(p_protocols)) {
+				if (!_parse_request(p_protocols, p_compression)) {
 					return FAILED;
 				}
 				String s = "HTTP/1.1 101 Switching Protocols\r\n";
@@ -134,6 +141,8 @@ Error WSLServer::PendingPeer::do_handshake(const Vector<String> p_protocols) {
 				s += "Sec-WebSocket-Accept: " + WSLPeer::compute_key_response(key) + "\r\n";
 				if (protocol != "")
 					s += "Sec-WebSocket-Protocol: " + protocol + "\r\n";
+				if (deflate)
+					s += "Sec-WebSocket-Extensions: " + extensions + "\r\n";
 				s += "\r\n";
 				response = s.utf8();
 				has_request = true;
@@ -170,10 +179,21 @@ Error WSLServer::listen(int p_port, const Vector<String> p_protocols, bool gd_mp
 
 void WSLServer::poll() {
 
+	// One wait on every connection, so idle peers can be skipped.
+	Set<ObjectID> active_connections;
+	Vector<Ref<StreamPeerTCP> > active;
+	Error poll_err = _server->poll(0, active);
+	bool skip_idle = poll_err == OK || poll_err == ERR_BUSY;
+	for (int i = 0; i < active.size(); i++) {
+		active_connections.insert(active[i]->get_instance_id());
+	}
+
 	List<int> remove_ids;
 	for (Map<int, Ref<WebSocketPeer> >::Element *E = _peer_map.front(); E; E = E->next()) {
 		Ref<WSLPeer> peer = (WSLPeer *)E->get().ptr();
-		peer->poll();
+		if (!skip_idle || peer->is_poll_needed(active_connections)) {
+			peer->poll();
+		}
 		if (!peer->is_connected_to_host()) {
 			_on_disconnect(E->key(), peer->close_code != -1);
 			remove_ids.push_back(E->key());
@@ -187,7 +207,7 @@ void WSLServer::poll() {
 	List<Ref<PendingPeer> > remove_peers;
 	for (List<Ref<PendingPeer> >::Element *E = _pending.front(); E; E = E->next()) {
 		Ref<PendingPeer> ppeer = E->get();
-		Error err = ppeer->do_handshake(_protocols);
+		Error err = ppeer->do_handshake(_protocols, _compression_enabled);
 		if (err == ERR_BUSY) {
 			continue;
 		} else if (err != OK) {
@@ -203,6 +223,9 @@ void WSLServer::poll() {
 		data->tcp = ppeer->tcp;
 		data->is_server = true;
 		data->id = id;
+		data->deflate = ppeer->deflate;
+		data->deflate_window_bits = ppeer->deflate_window_bits;
+		data->deflate_no_context_takeover = ppeer->deflate_no_context_takeover;
 
 		Ref<WSLPeer> ws_peer = memnew(WSLPeer);
 		ws_peer->make_context(data, _in_buf_size, _in_pkt_size, _out_buf_size, _out_pkt_size);
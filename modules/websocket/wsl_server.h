@@ -50,7 +50,7 @@ private:
 	class PendingPeer : public Reference {
 
 	private:
-		bool _parse_request(const Vector<String> p_protocols);
+		bool _parse_request(const Vector<String> p_protocols, bool p_compression);
 
 	public:
 		Ref<StreamPeerTCP> tcp;
@@ -62,13 +62,17 @@ private:
 		int req_pos;
 		String key;
 		String protocol;
+		String extensions;
+		bool deflate;
+		int deflate_window_bits;
+		bool deflate_no_context_takeover;
 		bool has_request;
 		CharString response;
 		int response_sent;
 
 		PendingPeer();
 
-		Error do_handshake(const Vector<String> p_protocols);
+		Error do_handshake(const Vector<String> p_protocols, bool p_compression);
 	};
 
 	int _in_buf_size;
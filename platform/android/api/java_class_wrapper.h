@@ -169,6 +169,7 @@ class JavaClass : public Reference {
 
 public:
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	virtual bool _has_custom_call() const { return true; }
 
 	JavaClass();
 };
@@ -186,6 +187,7 @@ class JavaObject : public Reference {
 
 public:
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	virtual bool _has_custom_call() const { return true; }
 
 #ifdef ANDROID_ENABLED
 	JavaObject(const Ref<JavaClass> &p_base, jobject *p_instance);
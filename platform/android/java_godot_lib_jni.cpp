@@ -411,6 +411,7 @@ class JNISingleton : public Object {
 	Map<StringName, MethodData> method_map;
 
 public:
+	virtual bool _has_custom_call() const { return true; }
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
 
 		ERR_FAIL_COND_V(!instance, Variant());
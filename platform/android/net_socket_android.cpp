@@ -70,6 +70,7 @@ NetSocket *NetSocketAndroid::_create_func() {
 
 void NetSocketAndroid::make_default() {
 	_create = _create_func;
+	NetSocketPollerPosix::make_default();
 }
 
 NetSocketAndroid::NetSocketAndroid() :
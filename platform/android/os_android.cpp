@@ -316,6 +316,7 @@ bool OS_Android::main_loop_iterate() {
 
 	if (!main_loop)
 		return false;
+	input->flush_accumulated_events();
 	return Main::iteration();
 }
 
@@ -361,7 +362,7 @@ void OS_Android::process_joy_event(OS_Android::JoypadEvent p_event) {
 
 void OS_Android::process_event(Ref<InputEvent> p_event) {
 
-	input->parse_input_event(p_event);
+	input->accumulate_input_event(p_event);
 }
 
 void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos> &p_points) {
@@ -378,7 +379,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 					ev->set_index(touch[i].id);
 					ev->set_pressed(false);
 					ev->set_position(touch[i].pos);
-					input->parse_input_event(ev);
+					input->accumulate_input_event(ev);
 				}
 			}
 
@@ -396,7 +397,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 				ev->set_index(touch[i].id);
 				ev->set_pressed(true);
 				ev->set_position(touch[i].pos);
-				input->parse_input_event(ev);
+				input->accumulate_input_event(ev);
 			}
 
 		} break;
@@ -425,7 +426,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 				ev->set_index(touch[i].id);
 				ev->set_position(p_points[idx].pos);
 				ev->set_relative(p_points[idx].pos - touch[i].pos);
-				input->parse_input_event(ev);
+				input->accumulate_input_event(ev);
 				touch.write[i].pos = p_points[idx].pos;
 			}
 
@@ -441,7 +442,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 					ev->set_index(touch[i].id);
 					ev->set_pressed(false);
 					ev->set_position(touch[i].pos);
-					input->parse_input_event(ev);
+					input->accumulate_input_event(ev);
 				}
 				touch.clear();
 			}
@@ -459,7 +460,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 					ev->set_index(tp.id);
 					ev->set_pressed(true);
 					ev->set_position(tp.pos);
-					input->parse_input_event(ev);
+					input->accumulate_input_event(ev);
 
 					break;
 				}
@@ -475,7 +476,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 					ev->set_index(touch[i].id);
 					ev->set_pressed(false);
 					ev->set_position(touch[i].pos);
-					input->parse_input_event(ev);
+					input->accumulate_input_event(ev);
 					touch.remove(i);
 
 					break;
@@ -496,7 +497,7 @@ void OS_Android::process_hover(int p_type, Point2 p_pos) {
 			ev->set_position(p_pos);
 			ev->set_global_position(p_pos);
 			ev->set_relative(p_pos - hover_prev_pos);
-			input->parse_input_event(ev);
+			input->accumulate_input_event(ev);
 			hover_prev_pos = p_pos;
 		} break;
 	}
@@ -510,7 +511,7 @@ void OS_Android::process_double_tap(Point2 p_pos) {
 	ev->set_pressed(true);
 	ev->set_doubleclick(true);
 	ev->set_button_index(1);
-	input->parse_input_event(ev);
+	input->accumulate_input_event(ev);
 }
 
 void OS_Android::process_scroll(Point2 p_pos) {
@@ -518,7 +519,7 @@ void OS_Android::process_scroll(Point2 p_pos) {
 	ev.instance();
 	ev->set_position(p_pos);
 	ev->set_delta(p_pos - scroll_prev_pos);
-	input->parse_input_event(ev);
+	input->accumulate_input_event(ev);
 	scroll_prev_pos = p_pos;
 }
 
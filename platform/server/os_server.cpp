@@ -85,7 +85,10 @@ Error OS_Server::initialize(const VideoMode &p_desired, int p_video_driver, int
 
 	video_driver_index = p_video_driver; // unused in server platform, but should still be initialized
 
-	visual_server = memnew(VisualServerRaster);
+	// Nothing is ever drawn, let the visual server and nodes skip visual-only work.
+	VisualServerRaster *vsr = memnew(VisualServerRaster);
+	vsr->set_headless(true);
+	visual_server = vsr;
 	visual_server->init();
 
 	AudioDriverManager::initialize(p_audio_driver);
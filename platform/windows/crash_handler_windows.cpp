@@ -130,6 +130,9 @@ DWORD CrashHandlerException(EXCEPTION_POINTERS *ep) {
 	if (OS::get_singleton()->get_main_loop())
 		OS::get_singleton()->get_main_loop()->notification(MainLoop::NOTIFICATION_CRASH);
 
+	// Write out log messages still queued for a background writer
+	OS::get_singleton()->flush_logs();
+
 	// Load the symbols:
 	if (!SymInitialize(process, NULL, false))
 		return EXCEPTION_CONTINUE_SEARCH;
@@ -416,6 +416,8 @@ void CanvasItem::show() {
 	if (!is_inside_tree())
 		return;
 
+	_notify_pick_changed();
+
 	_propagate_visibility_changed(true);
 	_change_notify("visible");
 }
@@ -431,6 +433,8 @@ void CanvasItem::hide() {
 	if (!is_inside_tree())
 		return;
 
+	_notify_pick_changed();
+
 	_propagate_visibility_changed(false);
 	_change_notify("visible");
 }
@@ -555,12 +559,14 @@ void CanvasItem::_enter_canvas() {
 
 	pending_update = false;
 	update();
+	_notify_pick_changed();
 
 	notification(NOTIFICATION_ENTER_CANVAS);
 }
 
 void CanvasItem::_exit_canvas() {
 
+	_notify_pick_changed();
 	notification(NOTIFICATION_EXIT_CANVAS, true); //reverse the notification
 	VisualServer::get_singleton()->canvas_item_set_parent(canvas_item, RID());
 	canvas_layer = NULL;
@@ -588,6 +594,8 @@ void CanvasItem::_notification(int p_what) {
 			if (!is_inside_tree())
 				break;
 
+			_notify_pick_changed();
+
 			if (group != "") {
 				get_tree()->call_group_flags(SceneTree::GROUP_CALL_UNIQUE, group, "_toplevel_raise_self");
 			} else {
@@ -714,6 +722,7 @@ void CanvasItem::item_rect_changed(bool p_size_changed) {
 
 	if (p_size_changed)
 		update();
+	_notify_pick_changed();
 	emit_signal(SceneStringNames::get_singleton()->item_rect_changed);
 }
 
@@ -945,6 +954,14 @@ float CanvasItem::draw_char(const Ref<Font> &p_font, const Point2 &p_pos, const
 	return p_font->draw_char(canvas_item, p_pos, p_char[0], p_next.c_str()[0], p_modulate);
 }
 
+void CanvasItem::_notify_pick_changed() {
+
+	//the viewport keeps the rects of its canvas items to find the control under the mouse
+	if (is_inside_tree()) {
+		get_viewport()->_gui_set_pick_dirty();
+	}
+}
+
 void CanvasItem::_notify_transform(CanvasItem *p_node) {
 
 	/* This check exists to avoid re-propagating the transform
@@ -1118,6 +1135,11 @@ void CanvasItem::force_update_transform() {
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
 
+void CanvasItem::reset_physics_interpolation() {
+
+	VisualServer::get_singleton()->canvas_item_reset_physics_interpolation(canvas_item);
+}
+
 void CanvasItem::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("_toplevel_raise_self"), &CanvasItem::_toplevel_raise_self);
@@ -1217,6 +1239,7 @@ void CanvasItem::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_transform_notification_enabled"), &CanvasItem::is_transform_notification_enabled);
 
 	ClassDB::bind_method(D_METHOD("force_update_transform"), &CanvasItem::force_update_transform);
+	ClassDB::bind_method(D_METHOD("reset_physics_interpolation"), &CanvasItem::reset_physics_interpolation);
 
 	ClassDB::bind_method(D_METHOD("make_canvas_position_local", "screen_point"), &CanvasItem::make_canvas_position_local);
 	ClassDB::bind_method(D_METHOD("make_input_local", "event"), &CanvasItem::make_input_local);
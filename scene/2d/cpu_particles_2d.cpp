@@ -30,6 +30,7 @@
 
 #include "cpu_particles_2d.h"
 
+#include "core/os/worker_thread_pool.h"
 #include "scene/2d/canvas_item.h"
 #include "scene/2d/particles_2d.h"
 #include "scene/resources/particles_material.h"
@@ -50,6 +51,7 @@ void CPUParticles2D::set_amount(int p_amount) {
 	ERR_FAIL_COND_MSG(p_amount < 1, "Amount of particles must be greater than 0.");
 
 	particles.resize(p_amount);
+	particle_steps.resize(p_amount);
 	{
 		PoolVector<Particle>::Write w = particles.write();
 
@@ -554,6 +556,22 @@ void CPUParticles2D::_update_internal() {
 			return;
 		}
 	}
+
+	if (VS::get_singleton()->is_headless()) {
+		// Particles are never drawn, only let one shot emitters finish on time.
+		_set_redraw(false);
+		if (emitting && one_shot) {
+			time += delta * speed_scale;
+			if (time > lifetime) {
+				time = 0;
+				cycle++;
+				set_emitting(false);
+				_change_notify();
+			}
+		}
+		return;
+	}
+
 	_set_redraw(true);
 
 	if (time == 0 && pre_process_time > 0.0) {
@@ -628,9 +646,15 @@ void CPUParticles2D::_particles_process(float p_delta) {
 
 	float system_phase = time / lifetime;
 
+	//restarts draw from the global random generator, so they are decided and emitted serially in order,
+	//the simulation step of every particle is independent and runs in parallel chunks below
+	ParticleStep *steps = particle_steps.ptrw();
+
 	for (int i = 0; i < pcount; i++) {
 
 		Particle &p = parray[i];
+		ParticleStep &step = steps[i];
+		step.action = PARTICLE_STEP_SKIP;
 
 		if (!emitting && !p.active)
 			continue;
@@ -686,6 +710,8 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			restart = true;
 		}
 
+		step.delta = local_delta;
+
 		if (restart) {
 
 			if (!emitting) {
@@ -693,6 +719,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
 				continue;
 			}
 			p.active = true;
+			step.action = PARTICLE_STEP_FINISH;
 
 			/*float tex_linear_velocity = 0;
 			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
@@ -777,7 +804,50 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			continue;
 		} else if (p.time > p.lifetime) {
 			p.active = false;
+			step.action = PARTICLE_STEP_FINISH;
 		} else {
+			step.action = PARTICLE_STEP_UPDATE;
+		}
+	}
+
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0.0); //sorts the ramp points before it is read from several threads
+	}
+
+	ParticleProcessData data;
+	data.particles = parray;
+	data.steps = steps;
+	data.emission_xform = emission_xform;
+	data.count = pcount;
+
+	int chunk_count = (pcount + PARTICLE_CHUNK_SIZE - 1) / PARTICLE_CHUNK_SIZE;
+
+	if (chunk_count > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		WorkerThreadPool::get_singleton()->parallel_for(chunk_count, this, &CPUParticles2D::_particles_process_chunk, (const ParticleProcessData *)&data);
+	} else {
+		for (int i = 0; i < chunk_count; i++) {
+			_particles_process_chunk(i, &data);
+		}
+	}
+}
+
+void CPUParticles2D::_particles_process_chunk(uint32_t p_chunk, const ParticleProcessData *p_data) {
+
+	const Transform2D &emission_xform = p_data->emission_xform;
+
+	int from = p_chunk * PARTICLE_CHUNK_SIZE;
+	int to = MIN(from + PARTICLE_CHUNK_SIZE, p_data->count);
+
+	for (int i = from; i < to; i++) {
+
+		const ParticleStep &step = p_data->steps[i];
+		if (step.action == PARTICLE_STEP_SKIP)
+			continue;
+
+		Particle &p = p_data->particles[i];
+		float local_delta = step.delta;
+
+		if (step.action == PARTICLE_STEP_UPDATE) {
 
 			uint32_t alt_seed = p.seed;
 
@@ -942,6 +1012,53 @@ void CPUParticles2D::_particles_process(float p_delta) {
 	}
 }
 
+void CPUParticles2D::_fill_particle_data_chunk(uint32_t p_chunk, const ParticleBufferData *p_data) {
+
+	const Particle *r = p_data->particles;
+
+	int from = p_chunk * PARTICLE_CHUNK_SIZE;
+	int to = MIN(from + PARTICLE_CHUNK_SIZE, p_data->count);
+
+	for (int i = from; i < to; i++) {
+
+		int idx = p_data->order ? p_data->order[i] : i;
+		float *ptr = &p_data->buffer[i * 13];
+
+		Transform2D t = r[idx].transform;
+
+		if (!local_coords) {
+			t = inv_emission_transform * t;
+		}
+
+		if (r[idx].active) {
+
+			ptr[0] = t.elements[0][0];
+			ptr[1] = t.elements[1][0];
+			ptr[2] = 0;
+			ptr[3] = t.elements[2][0];
+			ptr[4] = t.elements[0][1];
+			ptr[5] = t.elements[1][1];
+			ptr[6] = 0;
+			ptr[7] = t.elements[2][1];
+
+		} else {
+			zeromem(ptr, sizeof(float) * 8);
+		}
+
+		Color c = r[idx].color;
+		uint8_t *data8 = (uint8_t *)&ptr[8];
+		data8[0] = CLAMP(c.r * 255.0, 0, 255);
+		data8[1] = CLAMP(c.g * 255.0, 0, 255);
+		data8[2] = CLAMP(c.b * 255.0, 0, 255);
+		data8[3] = CLAMP(c.a * 255.0, 0, 255);
+
+		ptr[9] = r[idx].custom[0];
+		ptr[10] = r[idx].custom[1];
+		ptr[11] = r[idx].custom[2];
+		ptr[12] = r[idx].custom[3];
+	}
+}
+
 void CPUParticles2D::_update_particle_data_buffer() {
 #ifndef NO_THREADS
 	update_mutex->lock();
@@ -972,44 +1089,20 @@ void CPUParticles2D::_update_particle_data_buffer() {
 			}
 		}
 
-		for (int i = 0; i < pc; i++) {
-
-			int idx = order ? order[i] : i;
-
-			Transform2D t = r[idx].transform;
-
-			if (!local_coords) {
-				t = inv_emission_transform * t;
-			}
+		ParticleBufferData data;
+		data.particles = r.ptr();
+		data.order = order;
+		data.buffer = ptr;
+		data.count = pc;
 
-			if (r[idx].active) {
+		int chunk_count = (pc + PARTICLE_CHUNK_SIZE - 1) / PARTICLE_CHUNK_SIZE;
 
-				ptr[0] = t.elements[0][0];
-				ptr[1] = t.elements[1][0];
-				ptr[2] = 0;
-				ptr[3] = t.elements[2][0];
-				ptr[4] = t.elements[0][1];
-				ptr[5] = t.elements[1][1];
-				ptr[6] = 0;
-				ptr[7] = t.elements[2][1];
-
-			} else {
-				zeromem(ptr, sizeof(float) * 8);
+		if (chunk_count > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+			WorkerThreadPool::get_singleton()->parallel_for(chunk_count, this, &CPUParticles2D::_fill_particle_data_chunk, (const ParticleBufferData *)&data);
+		} else {
+			for (int i = 0; i < chunk_count; i++) {
+				_fill_particle_data_chunk(i, &data);
 			}
-
-			Color c = r[idx].color;
-			uint8_t *data8 = (uint8_t *)&ptr[8];
-			data8[0] = CLAMP(c.r * 255.0, 0, 255);
-			data8[1] = CLAMP(c.g * 255.0, 0, 255);
-			data8[2] = CLAMP(c.b * 255.0, 0, 255);
-			data8[3] = CLAMP(c.a * 255.0, 0, 255);
-
-			ptr[9] = r[idx].custom[0];
-			ptr[10] = r[idx].custom[1];
-			ptr[11] = r[idx].custom[2];
-			ptr[12] = r[idx].custom[3];
-
-			ptr += 13;
 		}
 	}
 
@@ -99,6 +99,35 @@ private:
 		uint32_t seed;
 	};
 
+	enum {
+		PARTICLE_CHUNK_SIZE = 256 //particles simulated and copied per job
+	};
+
+	enum ParticleStepAction {
+		PARTICLE_STEP_SKIP,
+		PARTICLE_STEP_FINISH, //restarted or expired, only color and transform are updated
+		PARTICLE_STEP_UPDATE,
+	};
+
+	struct ParticleStep {
+		float delta;
+		ParticleStepAction action;
+	};
+
+	struct ParticleProcessData {
+		Particle *particles;
+		const ParticleStep *steps;
+		Transform2D emission_xform;
+		int count;
+	};
+
+	struct ParticleBufferData {
+		const Particle *particles;
+		const int *order;
+		float *buffer;
+		int count;
+	};
+
 	float time;
 	float inactive_time;
 	float frame_remainder;
@@ -111,6 +140,7 @@ private:
 	PoolVector<Particle> particles;
 	PoolVector<float> particle_data;
 	PoolVector<int> particle_order;
+	Vector<ParticleStep> particle_steps;
 
 	struct SortLifetime {
 		const Particle *particles;
@@ -176,6 +206,8 @@ private:
 
 	void _update_internal();
 	void _particles_process(float p_delta);
+	void _particles_process_chunk(uint32_t p_chunk, const ParticleProcessData *p_data);
+	void _fill_particle_data_chunk(uint32_t p_chunk, const ParticleBufferData *p_data);
 	void _update_particle_data_buffer();
 
 	Mutex *update_mutex;
@@ -30,6 +30,9 @@
 
 #include "navigation_2d.h"
 
+#include "core/os/worker_thread_pool.h"
+#include "core/sort_array.h"
+
 #define USE_ENTRY_POINT
 
 void Navigation2D::_navpoly_link(int p_id) {
@@ -45,18 +48,47 @@ void Navigation2D::_navpoly_link(int p_id) {
 
 	PoolVector<Vector2>::Read r = vertices.read();
 
-	for (int i = 0; i < nm.navpoly->get_polygon_count(); i++) {
+	//polygons are connected through pointers, so they are allocated once and can't move
+	int pc = nm.navpoly->get_polygon_count();
+	int valid_count = 0;
+	for (int i = 0; i < pc; i++) {
 
-		//build
+		Vector<int> poly = nm.navpoly->get_polygon(i);
+		bool valid = true;
+		for (int j = 0; j < poly.size(); j++) {
+			if (poly[j] < 0 || poly[j] >= len) {
+				valid = false;
+				break;
+			}
+		}
+		ERR_CONTINUE(!valid);
+		valid_count++;
+	}
 
-		List<Polygon>::Element *P = nm.polygons.push_back(Polygon());
-		Polygon &p = P->get();
-		p.owner = &nm;
+	nm.polygons.resize(valid_count);
+	Polygon *polygons = nm.polygons.ptrw();
+	int polygon_count = 0;
+
+	for (int i = 0; i < pc; i++) {
+
+		//build
 
 		Vector<int> poly = nm.navpoly->get_polygon(i);
 		int plen = poly.size();
 		const int *indices = poly.ptr();
 		bool valid = true;
+		for (int j = 0; j < plen; j++) {
+			if (indices[j] < 0 || indices[j] >= len) {
+				valid = false;
+				break;
+			}
+		}
+
+		if (!valid)
+			continue;
+
+		Polygon &p = polygons[polygon_count++];
+		p.owner = &nm;
 		p.edges.resize(plen);
 
 		Vector2 center;
@@ -65,10 +97,6 @@ void Navigation2D::_navpoly_link(int p_id) {
 		for (int j = 0; j < plen; j++) {
 
 			int idx = indices[j];
-			if (idx < 0 || idx >= len) {
-				valid = false;
-				break;
-			}
 
 			Polygon::Edge e;
 			Vector2 ep = nm.xform.xform(r[idx]);
@@ -76,12 +104,14 @@ void Navigation2D::_navpoly_link(int p_id) {
 			e.point = _get_point(ep);
 			p.edges.write[j] = e;
 
-			int idxn = indices[(j + 1) % plen];
-			if (idxn < 0 || idxn >= len) {
-				valid = false;
-				break;
+			if (j == 0) {
+				p.rect.position = _get_vertex(e.point);
+			} else {
+				p.rect.expand_to(_get_vertex(e.point));
 			}
 
+			int idxn = indices[(j + 1) % plen];
+
 			Vector2 epn = nm.xform.xform(r[idxn]);
 
 			sum += (epn.x - ep.x) * (epn.y + ep.y);
@@ -89,11 +119,6 @@ void Navigation2D::_navpoly_link(int p_id) {
 
 		p.clockwise = sum > 0;
 
-		if (!valid) {
-			nm.polygons.pop_back();
-			ERR_CONTINUE(!valid);
-		}
-
 		p.center = center / plen;
 
 		//connect
@@ -134,6 +159,7 @@ void Navigation2D::_navpoly_link(int p_id) {
 	}
 
 	nm.linked = true;
+	index_dirty = true;
 }
 
 void Navigation2D::_navpoly_unlink(int p_id) {
@@ -142,9 +168,9 @@ void Navigation2D::_navpoly_unlink(int p_id) {
 	NavMesh &nm = navpoly_map[p_id];
 	ERR_FAIL_COND(!nm.linked);
 
-	for (List<Polygon>::Element *E = nm.polygons.front(); E; E = E->next()) {
+	for (int j = 0; j < nm.polygons.size(); j++) {
 
-		Polygon &p = E->get();
+		Polygon &p = nm.polygons.write[j];
 
 		int ec = p.edges.size();
 		Polygon::Edge *edges = p.edges.ptrw();
@@ -168,7 +194,7 @@ void Navigation2D::_navpoly_unlink(int p_id) {
 				C->get().A->edges.write[C->get().A_edge].C = NULL;
 				C->get().A->edges.write[C->get().A_edge].C_edge = -1;
 
-				if (C->get().A == &E->get()) {
+				if (C->get().A == &p) {
 
 					C->get().A = C->get().B;
 					C->get().A_edge = C->get().B_edge;
@@ -200,6 +226,7 @@ void Navigation2D::_navpoly_unlink(int p_id) {
 	nm.polygons.clear();
 
 	nm.linked = false;
+	index_dirty = true;
 }
 
 int Navigation2D::navpoly_add(const Ref<NavigationPolygon> &p_mesh, const Transform2D &p_xform, Object *p_owner) {
@@ -234,98 +261,337 @@ void Navigation2D::navpoly_remove(int p_id) {
 	navpoly_map.erase(p_id);
 }
 
-Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vector2 &p_end, bool p_optimize) {
+int Navigation2D::_create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int &max_alloc) {
 
-	Polygon *begin_poly = NULL;
-	Polygon *end_poly = NULL;
-	Vector2 begin_point;
-	Vector2 end_point;
-	float begin_d = 1e20;
-	float end_d = 1e20;
+	if (p_size == 1) {
 
-	//look for point inside triangle
+		return p_bb[p_from] - p_bvh;
+	} else if (p_size == 0) {
+
+		return -1;
+	}
 
+	Rect2 rect;
+	rect = p_bb[p_from]->rect;
+	for (int i = 1; i < p_size; i++) {
+
+		rect = rect.merge(p_bb[p_from + i]->rect);
+	}
+
+	if (rect.size.x > rect.size.y) {
+		SortArray<BVH *, BVHCmpX> sort_x;
+		sort_x.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
+	} else {
+		SortArray<BVH *, BVHCmpY> sort_y;
+		sort_y.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
+	}
+
+	int left = _create_bvh(p_bvh, p_bb, p_from, p_size / 2, max_alloc);
+	int right = _create_bvh(p_bvh, p_bb, p_from + p_size / 2, p_size - p_size / 2, max_alloc);
+
+	int index = max_alloc++;
+	BVH *_new = &p_bvh[index];
+	_new->rect = rect;
+	_new->center = rect.position + rect.size * 0.5;
+	_new->polygon = -1;
+	_new->left = left;
+	_new->right = right;
+
+	return index;
+}
+
+void Navigation2D::_update_index() {
+
+	if (!index_dirty)
+		return;
+
+	MutexLock lock(index_mutex);
+
+	if (!index_dirty)
+		return; //another thread did it
+
+	polygon_index.clear();
 	for (Map<int, NavMesh>::Element *E = navpoly_map.front(); E; E = E->next()) {
 
 		if (!E->get().linked)
 			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
 
-			Polygon &p = F->get();
-			if (begin_d || end_d) {
-				for (int i = 2; i < p.edges.size(); i++) {
+		Polygon *polygons = E->get().polygons.ptrw();
+		for (int i = 0; i < E->get().polygons.size(); i++) {
+			polygons[i].index = polygon_index.size();
+			polygon_index.push_back(&polygons[i]);
+		}
+	}
 
-					if (begin_d > 0) {
+	int pc = polygon_index.size();
+	bvh.resize(pc * 2);
+	bvh_root = -1;
+
+	if (pc) {
+		BVH *bw = bvh.ptrw();
+		Vector<BVH *> bwptrs;
+		bwptrs.resize(pc);
+
+		for (int i = 0; i < pc; i++) {
+			bw[i].rect = polygon_index[i]->rect;
+			bw[i].center = bw[i].rect.position + bw[i].rect.size * 0.5;
+			bw[i].left = -1;
+			bw[i].right = -1;
+			bw[i].polygon = i;
+			bwptrs.write[i] = &bw[i];
+		}
 
-						if (Geometry::is_point_in_triangle(p_start, _get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point))) {
+		int max_alloc = pc;
+		bvh_root = _create_bvh(bw, bwptrs.ptrw(), 0, pc, max_alloc);
+		bvh.resize(max_alloc);
+	}
 
-							begin_poly = &p;
-							begin_point = p_start;
-							begin_d = 0;
-							if (end_d == 0)
-								break;
-						}
-					}
+	index_dirty = false;
+}
 
-					if (end_d > 0) {
+Navigation2D::Polygon *Navigation2D::_get_closest_polygon(const Vector2 &p_point, Vector2 *r_closest) const {
 
-						if (Geometry::is_point_in_triangle(p_end, _get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point))) {
+	if (bvh_root < 0)
+		return NULL;
 
-							end_poly = &p;
-							end_point = p_end;
-							end_d = 0;
-							if (begin_d == 0)
-								break;
-						}
+	const BVH *b = bvh.ptr();
+
+	static const int max_stack = 128;
+	int stack[max_stack];
+	int sp = 0;
+
+	//look for point inside triangle
+	stack[sp++] = bvh_root;
+	while (sp) {
+
+		const BVH &n = b[stack[--sp]];
+		const Rect2 &r = n.rect;
+		if (p_point.x < r.position.x || p_point.y < r.position.y || p_point.x > r.position.x + r.size.x || p_point.y > r.position.y + r.size.y)
+			continue;
+
+		if (n.polygon >= 0) {
+
+			Polygon *p = polygon_index[n.polygon];
+			for (int i = 2; i < p->edges.size(); i++) {
+
+				if (Geometry::is_point_in_triangle(p_point, _get_vertex(p->edges[0].point), _get_vertex(p->edges[i - 1].point), _get_vertex(p->edges[i].point))) {
+
+					if (r_closest) {
+						*r_closest = p_point;
 					}
+					return p;
 				}
 			}
+		} else {
 
-			p.prev_edge = -1;
+			ERR_CONTINUE(sp + 2 > max_stack);
+			stack[sp++] = n.left;
+			stack[sp++] = n.right;
 		}
 	}
 
-	//start or end not inside triangle.. look for closest segment :|
-	if (begin_d || end_d) {
-		for (Map<int, NavMesh>::Element *E = navpoly_map.front(); E; E = E->next()) {
+	//not inside triangle.. look for closest segment :|
+	Polygon *closest_poly = NULL;
+	float closest_d = 1e20;
 
-			if (!E->get().linked)
-				continue;
-			for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
-
-				Polygon &p = F->get();
-				int es = p.edges.size();
-				for (int i = 0; i < es; i++) {
-
-					Vector2 edge[2] = {
-						_get_vertex(p.edges[i].point),
-						_get_vertex(p.edges[(i + 1) % es].point)
-					};
-
-					if (begin_d > 0) {
-						Vector2 spoint = Geometry::get_closest_point_to_segment_2d(p_start, edge);
-						float d = spoint.distance_to(p_start);
-						if (d < begin_d) {
-							begin_poly = &p;
-							begin_point = spoint;
-							begin_d = d;
-						}
-					}
+	stack[sp++] = bvh_root;
+	while (sp) {
+
+		const BVH &n = b[stack[--sp]];
+
+		//distance from the point to the rect, nothing inside can be closer
+		Vector2 clamped(CLAMP(p_point.x, n.rect.position.x, n.rect.position.x + n.rect.size.x), CLAMP(p_point.y, n.rect.position.y, n.rect.position.y + n.rect.size.y));
+		if (clamped.distance_to(p_point) >= closest_d)
+			continue;
+
+		if (n.polygon >= 0) {
+
+			Polygon *p = polygon_index[n.polygon];
+			int es = p->edges.size();
+			for (int i = 0; i < es; i++) {
 
-					if (end_d > 0) {
-						Vector2 spoint = Geometry::get_closest_point_to_segment_2d(p_end, edge);
-						float d = spoint.distance_to(p_end);
-						if (d < end_d) {
-							end_poly = &p;
-							end_point = spoint;
-							end_d = d;
-						}
+				Vector2 edge[2] = {
+					_get_vertex(p->edges[i].point),
+					_get_vertex(p->edges[(i + 1) % es].point)
+				};
+
+				Vector2 spoint = Geometry::get_closest_point_to_segment_2d(p_point, edge);
+				float d = spoint.distance_to(p_point);
+				if (d < closest_d) {
+					closest_poly = p;
+					closest_d = d;
+					if (r_closest) {
+						*r_closest = spoint;
 					}
 				}
 			}
+		} else {
+
+			ERR_CONTINUE(sp + 2 > max_stack);
+			//visit the closer child first, so the other one is more likely to be skipped
+			if (b[n.left].center.distance_squared_to(p_point) < b[n.right].center.distance_squared_to(p_point)) {
+				stack[sp++] = n.right;
+				stack[sp++] = n.left;
+			} else {
+				stack[sp++] = n.left;
+				stack[sp++] = n.right;
+			}
+		}
+	}
+
+	return closest_poly;
+}
+
+Navigation2D::PathQuery *Navigation2D::_query_acquire() {
+
+	PathQuery *query = NULL;
+
+	index_mutex->lock();
+	if (free_queries.size()) {
+		query = free_queries[free_queries.size() - 1];
+		free_queries.resize(free_queries.size() - 1);
+	}
+	index_mutex->unlock();
+
+	if (!query) {
+		query = memnew(PathQuery);
+		query->pass = 0;
+	}
+
+	int old_size = query->states.size();
+	if (old_size < polygon_index.size()) {
+		query->states.resize(polygon_index.size());
+		PathState *states = query->states.ptrw();
+		for (int i = old_size; i < polygon_index.size(); i++) {
+			states[i].open_pass = 0;
+			states[i].closed_pass = 0;
+		}
+	}
+
+	query->pass++;
+	if (query->pass == 0) {
+		//wrapped around, old stamps could look current
+		PathState *states = query->states.ptrw();
+		for (int i = 0; i < query->states.size(); i++) {
+			states[i].open_pass = 0;
+			states[i].closed_pass = 0;
+		}
+		query->pass = 1;
+	}
+
+	return query;
+}
+
+void Navigation2D::_query_release(PathQuery *p_query) {
+
+	p_query->open_list.clear();
+
+	MutexLock lock(index_mutex);
+	free_queries.push_back(p_query);
+}
+
+float Navigation2D::_get_open_cost(const PathState &p_state, const Polygon *p_polygon, const Vector2 &p_end_point) const {
+
+	float cost = p_state.distance;
+
+#ifdef USE_ENTRY_POINT
+	int es = p_polygon->edges.size();
+
+	float shortest_distance = 1e30;
+
+	for (int i = 0; i < es; i++) {
+		const Polygon::Edge &e = p_polygon->edges[i];
+
+		if (!e.C)
+			continue;
+
+		Vector2 edge[2] = {
+			_get_vertex(p_polygon->edges[i].point),
+			_get_vertex(p_polygon->edges[(i + 1) % es].point)
+		};
+
+		Vector2 edge_point = Geometry::get_closest_point_to_segment_2d(p_state.entry, edge);
+		float dist = p_state.entry.distance_to(edge_point);
+		if (dist < shortest_distance)
+			shortest_distance = dist;
+	}
+
+	cost += shortest_distance;
+#else
+	cost += p_polygon->center.distance_to(p_end_point);
+#endif
+
+	return cost;
+}
+
+Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vector2 &p_end, bool p_optimize) {
+
+	_update_index();
+
+	PathQuery *query = _query_acquire();
+	Vector<Vector2> path = _get_path(query, p_start, p_end, p_optimize);
+	_query_release(query);
+
+	return path;
+}
+
+void Navigation2D::_get_path_batch(uint32_t p_index, PathBatch *p_batch) {
+
+	PathQuery *query = _query_acquire();
+	p_batch->paths[p_index] = _get_path(query, p_batch->starts[p_index], p_batch->ends[p_index], p_batch->optimize);
+	_query_release(query);
+}
+
+Array Navigation2D::get_simple_paths(const PoolVector<Vector2> &p_starts, const PoolVector<Vector2> &p_ends, bool p_optimize) {
+
+	ERR_FAIL_COND_V(p_starts.size() != p_ends.size(), Array());
+
+	_update_index();
+
+	int count = p_starts.size();
+	Vector<Vector<Vector2> > paths;
+	paths.resize(count);
+
+	PathBatch batch;
+	batch.starts = p_starts.read();
+	batch.ends = p_ends.read();
+	batch.optimize = p_optimize;
+	batch.paths = paths.ptrw();
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && count > 1) {
+		pool->parallel_for(count, this, &Navigation2D::_get_path_batch, &batch);
+	} else {
+		for (int i = 0; i < count; i++) {
+			_get_path_batch(i, &batch);
+		}
+	}
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+
+		PoolVector<Vector2> path;
+		path.resize(paths[i].size());
+		{
+			PoolVector<Vector2>::Write w = path.write();
+			for (int j = 0; j < paths[i].size(); j++) {
+				w[j] = paths[i][j];
+			}
 		}
+		ret[i] = path;
 	}
 
+	return ret;
+}
+
+Vector<Vector2> Navigation2D::_get_path(PathQuery *p_query, const Vector2 &p_start, const Vector2 &p_end, bool p_optimize) {
+
+	Vector2 begin_point;
+	Vector2 end_point;
+	Polygon *begin_poly = _get_closest_polygon(p_start, &begin_point);
+	Polygon *end_poly = _get_closest_polygon(p_end, &end_point);
+
 	if (!begin_poly || !end_poly) {
 
 		return Vector<Vector2>(); //no path
@@ -340,32 +606,52 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 		return path;
 	}
 
+	PathState *states = p_query->states.ptrw();
+	uint32_t pass = p_query->pass;
+
 	bool found_route = false;
 
-	List<Polygon *> open_list;
+	Vector<OpenPolygon> &open_list = p_query->open_list;
+	SortArray<OpenPolygon, SortOpenPolygons> sorter;
 
-	begin_poly->entry = p_start;
+	//the begin polygon is closed right away, so it's never entered again
+	states[begin_poly->index].closed_pass = pass;
+	states[begin_poly->index].open_pass = pass;
+	states[begin_poly->index].prev_edge = -1;
+	states[begin_poly->index].distance = 0;
+	states[begin_poly->index].entry = p_start;
 
 	for (int i = 0; i < begin_poly->edges.size(); i++) {
 
-		if (begin_poly->edges[i].C) {
+		Polygon *c = begin_poly->edges[i].C;
+		if (c) {
 
-			begin_poly->edges[i].C->prev_edge = begin_poly->edges[i].C_edge;
+			PathState &cs = states[c->index];
+			cs.prev_edge = begin_poly->edges[i].C_edge;
 #ifdef USE_ENTRY_POINT
 			Vector2 edge[2] = {
 				_get_vertex(begin_poly->edges[i].point),
 				_get_vertex(begin_poly->edges[(i + 1) % begin_poly->edges.size()].point)
 			};
 
-			Vector2 entry = Geometry::get_closest_point_to_segment_2d(begin_poly->entry, edge);
-			begin_poly->edges[i].C->distance = begin_poly->entry.distance_to(entry);
-			begin_poly->edges[i].C->entry = entry;
+			Vector2 entry = Geometry::get_closest_point_to_segment_2d(p_start, edge);
+			cs.distance = p_start.distance_to(entry);
+			cs.entry = entry;
 #else
-			begin_poly->edges[i].C->distance = begin_poly->center.distance_to(begin_poly->edges[i].C->center);
+			cs.distance = begin_poly->center.distance_to(c->center);
 #endif
-			open_list.push_back(begin_poly->edges[i].C);
+			if (cs.open_pass != pass) {
+				cs.open_pass = pass;
+				cs.closed_pass = 0;
+			}
 
-			if (begin_poly->edges[i].C == end_poly) {
+			OpenPolygon op;
+			op.polygon = c;
+			op.cost = _get_open_cost(cs, c, end_point);
+			open_list.push_back(op);
+			sorter.push_heap(0, open_list.size() - 1, 0, op, open_list.ptrw());
+
+			if (c == end_poly) {
 				found_route = true;
 			}
 		}
@@ -376,97 +662,79 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 		if (open_list.size() == 0) {
 			break;
 		}
-		//check open list
-
-		List<Polygon *>::Element *least_cost_poly = NULL;
-		float least_cost = 1e30;
-
-		//this could be faster (cache previous results)
-		for (List<Polygon *>::Element *E = open_list.front(); E; E = E->next()) {
-
-			Polygon *p = E->get();
-
-			float cost = p->distance;
-
-#ifdef USE_ENTRY_POINT
-			int es = p->edges.size();
 
-			float shortest_distance = 1e30;
+		//least cost polygon is on top of the heap
+		sorter.pop_heap(0, open_list.size(), open_list.ptrw());
+		Polygon *p = open_list[open_list.size() - 1].polygon;
+		open_list.resize(open_list.size() - 1);
 
-			for (int i = 0; i < es; i++) {
-				Polygon::Edge &e = p->edges.write[i];
-
-				if (!e.C)
-					continue;
+		PathState &ps = states[p->index];
+		if (ps.closed_pass == pass)
+			continue; //an outdated entry, was opened again with a lower cost
 
-				Vector2 edge[2] = {
-					_get_vertex(p->edges[i].point),
-					_get_vertex(p->edges[(i + 1) % es].point)
-				};
+		ps.closed_pass = pass;
 
-				Vector2 edge_point = Geometry::get_closest_point_to_segment_2d(p->entry, edge);
-				float dist = p->entry.distance_to(edge_point);
-				if (dist < shortest_distance)
-					shortest_distance = dist;
-			}
-
-			cost += shortest_distance;
-#else
-			cost += p->center.distance_to(end_point);
-#endif
-			if (cost < least_cost) {
-				least_cost_poly = E;
-				least_cost = cost;
-			}
-		}
-
-		Polygon *p = least_cost_poly->get();
 		//open the neighbours for search
 		int es = p->edges.size();
 
 		for (int i = 0; i < es; i++) {
 
-			Polygon::Edge &e = p->edges.write[i];
+			const Polygon::Edge &e = p->edges[i];
 
 			if (!e.C)
 				continue;
 
+			PathState &cs = states[e.C->index];
+
 #ifdef USE_ENTRY_POINT
 			Vector2 edge[2] = {
 				_get_vertex(p->edges[i].point),
 				_get_vertex(p->edges[(i + 1) % es].point)
 			};
 
-			Vector2 edge_entry = Geometry::get_closest_point_to_segment_2d(p->entry, edge);
-			float distance = p->entry.distance_to(edge_entry) + p->distance;
+			Vector2 edge_entry = Geometry::get_closest_point_to_segment_2d(ps.entry, edge);
+			float distance = ps.entry.distance_to(edge_entry) + ps.distance;
 
 #else
 
-			float distance = p->center.distance_to(e.C->center) + p->distance;
+			float distance = p->center.distance_to(e.C->center) + ps.distance;
 
 #endif
 
-			if (e.C->prev_edge != -1) {
+			if (cs.open_pass == pass) {
 				//oh this was visited already, can we win the cost?
 
-				if (e.C->distance > distance) {
+				if (cs.distance > distance) {
 
-					e.C->prev_edge = e.C_edge;
-					e.C->distance = distance;
+					cs.prev_edge = e.C_edge;
+					cs.distance = distance;
 #ifdef USE_ENTRY_POINT
-					e.C->entry = edge_entry;
+					cs.entry = edge_entry;
 #endif
+					if (cs.closed_pass != pass) {
+						OpenPolygon op;
+						op.polygon = e.C;
+						op.cost = _get_open_cost(cs, e.C, end_point);
+						open_list.push_back(op);
+						sorter.push_heap(0, open_list.size() - 1, 0, op, open_list.ptrw());
+					}
 				}
 			} else {
 				//add to open neighbours
 
-				e.C->prev_edge = e.C_edge;
-				e.C->distance = distance;
+				cs.open_pass = pass;
+				cs.closed_pass = 0;
+				cs.prev_edge = e.C_edge;
+				cs.distance = distance;
 #ifdef USE_ENTRY_POINT
-				e.C->entry = edge_entry;
+				cs.entry = edge_entry;
 #endif
 
-				open_list.push_back(e.C);
+				OpenPolygon op;
+				op.polygon = e.C;
+				op.cost = _get_open_cost(cs, e.C, end_point);
+				open_list.push_back(op);
+				sorter.push_heap(0, open_list.size() - 1, 0, op, open_list.ptrw());
 
 				if (e.C == end_poly) {
 					//oh my reached end! stop algorithm
@@ -475,11 +743,6 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 				}
 			}
 		}
-
-		if (found_route)
-			break;
-
-		open_list.erase(least_cost_poly);
 	}
 
 	if (found_route) {
@@ -501,44 +764,24 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 				Vector2 left;
 				Vector2 right;
 
-//#define CLOCK_TANGENT(m_a,m_b,m_c) ( ((m_a)-(m_c)).cross((m_a)-(m_b)) )
 #define CLOCK_TANGENT(m_a, m_b, m_c) ((((m_a).x - (m_c).x) * ((m_b).y - (m_c).y) - ((m_b).x - (m_c).x) * ((m_a).y - (m_c).y)))
 
 				if (p == begin_poly) {
 					left = begin_point;
 					right = begin_point;
 				} else {
-					int prev = p->prev_edge;
-					int prev_n = (p->prev_edge + 1) % p->edges.size();
+					int prev = states[p->index].prev_edge;
+					int prev_n = (prev + 1) % p->edges.size();
 					left = _get_vertex(p->edges[prev].point);
 					right = _get_vertex(p->edges[prev_n].point);
 
 					if (p->clockwise) {
 						SWAP(left, right);
 					}
-					/*if (CLOCK_TANGENT(apex_point,left,(left+right)*0.5) < 0){
-						SWAP(left,right);
-					}*/
 				}
 
 				bool skip = false;
 
-				/*
-				print_line("-----\nAPEX: "+(apex_point-end_point));
-				print_line("LEFT:");
-				print_line("\tPortal: "+(portal_left-end_point));
-				print_line("\tPoint: "+(left-end_point));
-				print_line("\tLeft Tangent: "+rtos(CLOCK_TANGENT(apex_point,portal_left,left)));
-				print_line("\tLeft Distance: "+rtos(portal_left.distance_squared_to(apex_point)));
-				print_line("\tLeft Test: "+rtos(CLOCK_TANGENT(apex_point,left,portal_right)));
-				print_line("RIGHT:");
-				print_line("\tPortal: "+(portal_right-end_point));
-				print_line("\tPoint: "+(right-end_point));
-				print_line("\tRight Tangent: "+rtos(CLOCK_TANGENT(apex_point,portal_right,right)));
-				print_line("\tRight Distance: "+rtos(portal_right.distance_squared_to(apex_point)));
-				print_line("\tRight Test: "+rtos(CLOCK_TANGENT(apex_point,right,portal_left)));
-				*/
-
 				if (CLOCK_TANGENT(apex_point, portal_left, left) >= 0) {
 					//process
 					if (portal_left.is_equal_approx(apex_point) || CLOCK_TANGENT(apex_point, left, portal_right) > 0) {
@@ -575,7 +818,7 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 				}
 
 				if (p != begin_poly)
-					p = p->edges[p->prev_edge].C;
+					p = p->edges[states[p->index].prev_edge].C;
 				else
 					p = NULL;
 			}
@@ -585,8 +828,8 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 			Polygon *p = end_poly;
 
 			while (true) {
-				int prev = p->prev_edge;
-				int prev_n = (p->prev_edge + 1) % p->edges.size();
+				int prev = states[p->index].prev_edge;
+				int prev_n = (prev + 1) % p->edges.size();
 				Vector2 point = (_get_vertex(p->edges[prev].point) + _get_vertex(p->edges[prev_n].point)) * 0.5;
 				path.push_back(point);
 				p = p->edges[prev].C;
@@ -617,106 +860,19 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 
 Vector2 Navigation2D::get_closest_point(const Vector2 &p_point) {
 
-	Vector2 closest_point = Vector2();
-	float closest_point_d = 1e20;
-
-	for (Map<int, NavMesh>::Element *E = navpoly_map.front(); E; E = E->next()) {
-
-		if (!E->get().linked)
-			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
-
-			Polygon &p = F->get();
-			for (int i = 2; i < p.edges.size(); i++) {
-
-				if (Geometry::is_point_in_triangle(p_point, _get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point))) {
-
-					return p_point; //inside triangle, nothing else to discuss
-				}
-			}
-		}
-	}
-
-	for (Map<int, NavMesh>::Element *E = navpoly_map.front(); E; E = E->next()) {
-
-		if (!E->get().linked)
-			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
-
-			Polygon &p = F->get();
-			int es = p.edges.size();
-			for (int i = 0; i < es; i++) {
-
-				Vector2 edge[2] = {
-					_get_vertex(p.edges[i].point),
-					_get_vertex(p.edges[(i + 1) % es].point)
-				};
-
-				Vector2 spoint = Geometry::get_closest_point_to_segment_2d(p_point, edge);
-				float d = spoint.distance_squared_to(p_point);
-				if (d < closest_point_d) {
-
-					closest_point = spoint;
-					closest_point_d = d;
-				}
-			}
-		}
-	}
+	_update_index();
 
+	Vector2 closest_point;
+	_get_closest_polygon(p_point, &closest_point);
 	return closest_point;
 }
 
 Object *Navigation2D::get_closest_point_owner(const Vector2 &p_point) {
 
-	Object *owner = NULL;
-	Vector2 closest_point = Vector2();
-	float closest_point_d = 1e20;
-
-	for (Map<int, NavMesh>::Element *E = navpoly_map.front(); E; E = E->next()) {
-
-		if (!E->get().linked)
-			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
+	_update_index();
 
-			Polygon &p = F->get();
-			for (int i = 2; i < p.edges.size(); i++) {
-
-				if (Geometry::is_point_in_triangle(p_point, _get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point))) {
-
-					return E->get().owner;
-				}
-			}
-		}
-	}
-
-	for (Map<int, NavMesh>::Element *E = navpoly_map.front(); E; E = E->next()) {
-
-		if (!E->get().linked)
-			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
-
-			Polygon &p = F->get();
-			int es = p.edges.size();
-			for (int i = 0; i < es; i++) {
-
-				Vector2 edge[2] = {
-					_get_vertex(p.edges[i].point),
-					_get_vertex(p.edges[(i + 1) % es].point)
-				};
-
-				Vector2 spoint = Geometry::get_closest_point_to_segment_2d(p_point, edge);
-				float d = spoint.distance_squared_to(p_point);
-				if (d < closest_point_d) {
-
-					closest_point = spoint;
-					closest_point_d = d;
-					owner = E->get().owner;
-				}
-			}
-		}
-	}
-
-	return owner;
+	Polygon *p = _get_closest_polygon(p_point, NULL);
+	return p ? p->owner->owner : NULL;
 }
 
 void Navigation2D::_bind_methods() {
@@ -726,13 +882,27 @@ void Navigation2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("navpoly_remove", "id"), &Navigation2D::navpoly_remove);
 
 	ClassDB::bind_method(D_METHOD("get_simple_path", "start", "end", "optimize"), &Navigation2D::get_simple_path, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("get_simple_paths", "starts", "ends", "optimize"), &Navigation2D::get_simple_paths, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_point"), &Navigation2D::get_closest_point);
 	ClassDB::bind_method(D_METHOD("get_closest_point_owner", "to_point"), &Navigation2D::get_closest_point_owner);
 }
 
 Navigation2D::Navigation2D() {
 
+	bvh_root = -1;
+	index_dirty = false;
+	index_mutex = Mutex::create();
+
 	ERR_FAIL_COND(sizeof(Point) != 8);
 	cell_size = 1; // one pixel
 	last_id = 1;
 }
+
+Navigation2D::~Navigation2D() {
+
+	for (int i = 0; i < free_queries.size(); i++) {
+		memdelete(free_queries[i]);
+	}
+
+	memdelete(index_mutex);
+}
@@ -31,6 +31,7 @@
 #ifndef NAVIGATION_2D_H
 #define NAVIGATION_2D_H
 
+#include "core/os/mutex.h"
 #include "scene/2d/navigation_polygon.h"
 #include "scene/2d/node_2d.h"
 
@@ -93,12 +94,10 @@ class Navigation2D : public Node2D {
 		Vector<Edge> edges;
 
 		Vector2 center;
-		Vector2 entry;
-
-		float distance;
-		int prev_edge;
+		Rect2 rect;
 
 		bool clockwise;
+		int index; //in polygon_index
 
 		NavMesh *owner;
 	};
@@ -128,9 +127,89 @@ class Navigation2D : public Node2D {
 		Transform2D xform;
 		bool linked;
 		Ref<NavigationPolygon> navpoly;
-		List<Polygon> polygons;
+		Vector<Polygon> polygons; //sized once when linking, edges point into it
+	};
+
+	/**
+	 * The polygons of all linked navpolys are indexed by a BVH, rebuilt by the first query after
+	 * a change. Searches keep their state in a PathQuery instead of the polygons, so any number of
+	 * them can run at the same time, see get_simple_paths().
+	 */
+	struct BVH {
+
+		Rect2 rect;
+		Vector2 center; //used for sorting
+		int left;
+		int right;
+
+		int polygon;
+	};
+
+	struct BVHCmpX {
+
+		bool operator()(const BVH *p_left, const BVH *p_right) const {
+
+			return p_left->center.x < p_right->center.x;
+		}
+	};
+
+	struct BVHCmpY {
+
+		bool operator()(const BVH *p_left, const BVH *p_right) const {
+
+			return p_left->center.y < p_right->center.y;
+		}
 	};
 
+	struct PathState {
+		float distance;
+		int prev_edge;
+		Vector2 entry;
+		uint32_t open_pass;
+		uint32_t closed_pass;
+	};
+
+	struct OpenPolygon {
+		float cost;
+		Polygon *polygon;
+	};
+
+	struct SortOpenPolygons {
+		_FORCE_INLINE_ bool operator()(const OpenPolygon &A, const OpenPolygon &B) const { // true when A is worse than B
+			return A.cost > B.cost;
+		}
+	};
+
+	struct PathQuery {
+		Vector<PathState> states;
+		Vector<OpenPolygon> open_list;
+		uint32_t pass;
+	};
+
+	struct PathBatch {
+		PoolVector<Vector2>::Read starts;
+		PoolVector<Vector2>::Read ends;
+		bool optimize;
+		Vector<Vector2> *paths;
+	};
+
+	Vector<Polygon *> polygon_index;
+	Vector<BVH> bvh;
+	int bvh_root;
+	bool index_dirty;
+	Mutex *index_mutex;
+	Vector<PathQuery *> free_queries;
+
+	int _create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int &max_alloc);
+	void _update_index();
+	Polygon *_get_closest_polygon(const Vector2 &p_point, Vector2 *r_closest) const;
+	float _get_open_cost(const PathState &p_state, const Polygon *p_polygon, const Vector2 &p_end_point) const;
+
+	PathQuery *_query_acquire();
+	void _query_release(PathQuery *p_query);
+	Vector<Vector2> _get_path(PathQuery *p_query, const Vector2 &p_start, const Vector2 &p_end, bool p_optimize);
+	void _get_path_batch(uint32_t p_index, PathBatch *p_batch);
+
 	_FORCE_INLINE_ Point _get_point(const Vector2 &p_pos) const {
 
 		int x = int(Math::floor(p_pos.x / cell_size));
@@ -165,10 +244,12 @@ public:
 	void navpoly_remove(int p_id);
 
 	Vector<Vector2> get_simple_path(const Vector2 &p_start, const Vector2 &p_end, bool p_optimize = true);
+	Array get_simple_paths(const PoolVector<Vector2> &p_starts, const PoolVector<Vector2> &p_ends, bool p_optimize = true);
 	Vector2 get_closest_point(const Vector2 &p_point);
 	Object *get_closest_point_owner(const Vector2 &p_point);
 
 	Navigation2D();
+	~Navigation2D();
 };
 
 #endif // NAVIGATION_2D_H
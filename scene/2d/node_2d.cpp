@@ -393,6 +393,21 @@ Point2 Node2D::to_global(Point2 p_local) const {
 	return get_global_transform().xform(p_local);
 }
 
+void Node2D::_notification(int p_what) {
+
+	switch (p_what) {
+
+		case NOTIFICATION_ENTER_TREE: {
+
+			// Controls are laid out every frame, only nodes moved from physics have their transform blended.
+			if (get_tree()->is_physics_interpolation_enabled()) {
+				VisualServer::get_singleton()->canvas_item_set_interpolated(get_canvas_item(), true);
+				VisualServer::get_singleton()->canvas_item_reset_physics_interpolation(get_canvas_item());
+			}
+		} break;
+	}
+}
+
 void Node2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_position", "position"), &Node2D::set_position);
@@ -52,6 +52,7 @@ class Node2D : public CanvasItem {
 	void _update_xform_values();
 
 protected:
+	void _notification(int p_what);
 	static void _bind_methods();
 
 public:
@@ -43,7 +43,7 @@ class RayCast2D : public Node2D {
 	int against_shape;
 	Vector2 collision_point;
 	Vector2 collision_normal;
-	Set<RID> exclude;
+	BTreeSet<RID> exclude;
 	uint32_t collision_mask;
 	bool exclude_parent_body;
 
@@ -237,6 +237,9 @@ void Skeleton2D::_update_transform() {
 		}
 	}
 
+	if (VS::get_singleton()->is_headless())
+		return;
+
 	for (int i = 0; i < bones.size(); i++) {
 
 		Transform2D final_xform = bones[i].accum_transform * bones[i].rest_inverse;
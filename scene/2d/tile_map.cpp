@@ -35,6 +35,7 @@
 #include "core/method_bind_ext.gen.inc"
 #include "core/os/os.h"
 #include "scene/2d/area_2d.h"
+#include "scene/resources/rectangle_shape_2d.h"
 #include "servers/physics_2d_server.h"
 
 int TileMap::_get_quadrant_size() const {
@@ -324,6 +325,157 @@ void TileMap::_add_shape(int &shape_idx, const Quadrant &p_q, const Ref<Shape2D>
 	shape_idx++;
 }
 
+bool TileMap::MergeRectRowSort::operator()(const MergeRect &p_a, const MergeRect &p_b) const {
+
+	if (p_a.one_way_collision != p_b.one_way_collision)
+		return p_a.one_way_collision < p_b.one_way_collision;
+	if (p_a.one_way_collision_margin != p_b.one_way_collision_margin)
+		return p_a.one_way_collision_margin < p_b.one_way_collision_margin;
+	if (p_a.rect.position.y != p_b.rect.position.y)
+		return p_a.rect.position.y < p_b.rect.position.y;
+	if (p_a.rect.size.y != p_b.rect.size.y)
+		return p_a.rect.size.y < p_b.rect.size.y;
+	return p_a.rect.position.x < p_b.rect.position.x;
+}
+
+bool TileMap::MergeRectColumnSort::operator()(const MergeRect &p_a, const MergeRect &p_b) const {
+
+	if (p_a.one_way_collision != p_b.one_way_collision)
+		return p_a.one_way_collision < p_b.one_way_collision;
+	if (p_a.one_way_collision_margin != p_b.one_way_collision_margin)
+		return p_a.one_way_collision_margin < p_b.one_way_collision_margin;
+	if (p_a.rect.position.x != p_b.rect.position.x)
+		return p_a.rect.position.x < p_b.rect.position.x;
+	if (p_a.rect.size.x != p_b.rect.size.x)
+		return p_a.rect.size.x < p_b.rect.size.x;
+	return p_a.rect.position.y < p_b.rect.position.y;
+}
+
+bool TileMap::_queue_merge_rect(Vector<MergeRect> &r_rects, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata) const {
+
+	Vector2 points[4];
+
+	Ref<RectangleShape2D> rectangle = p_shape;
+	Ref<ConvexPolygonShape2D> convex = p_shape;
+	if (rectangle.is_valid()) {
+		Vector2 ext = rectangle->get_extents();
+		points[0] = Vector2(-ext.x, -ext.y);
+		points[1] = Vector2(ext.x, -ext.y);
+		points[2] = Vector2(ext.x, ext.y);
+		points[3] = Vector2(-ext.x, ext.y);
+	} else if (convex.is_valid()) {
+		Vector<Vector2> convex_points = convex->get_points();
+		if (convex_points.size() != 4)
+			return false;
+		for (int i = 0; i < 4; i++) {
+			points[i] = convex_points[i];
+		}
+	} else {
+		return false;
+	}
+
+	Rect2 rect;
+	for (int i = 0; i < 4; i++) {
+		points[i] = p_xform.xform(points[i]);
+		if (i == 0)
+			rect.position = points[0];
+		else
+			rect.expand_to(points[i]);
+	}
+
+	if (rect.size.x <= CMP_EPSILON || rect.size.y <= CMP_EPSILON)
+		return false;
+
+	//only an axis aligned rectangle has one point on each corner of its bounds
+	int corners = 0;
+	for (int i = 0; i < 4; i++) {
+		int corner = 0;
+		if (Math::is_equal_approx(points[i].x, rect.position.x + rect.size.x))
+			corner |= 1;
+		else if (!Math::is_equal_approx(points[i].x, rect.position.x))
+			return false;
+		if (Math::is_equal_approx(points[i].y, rect.position.y + rect.size.y))
+			corner |= 2;
+		else if (!Math::is_equal_approx(points[i].y, rect.position.y))
+			return false;
+		corners |= 1 << corner;
+	}
+
+	if (corners != 0xF)
+		return false;
+
+	MergeRect mr;
+	mr.rect = rect;
+	mr.metadata = p_metadata;
+	mr.one_way_collision = p_shape_data.one_way_collision;
+	mr.one_way_collision_margin = p_shape_data.one_way_collision_margin;
+	r_rects.push_back(mr);
+	return true;
+}
+
+void TileMap::_add_merged_rects(int &shape_idx, Quadrant &p_q, Vector<MergeRect> &p_rects) {
+
+	if (p_rects.empty())
+		return;
+
+	//join each row into runs first, then stack runs covering the same columns
+	Vector<MergeRect> runs;
+	p_rects.sort_custom<MergeRectRowSort>();
+	for (int i = 0; i < p_rects.size(); i++) {
+
+		const MergeRect &mr = p_rects[i];
+		if (runs.size()) {
+			MergeRect &last = runs.write[runs.size() - 1];
+			if (last.one_way_collision == mr.one_way_collision && last.one_way_collision_margin == mr.one_way_collision_margin &&
+					Math::is_equal_approx(last.rect.position.y, mr.rect.position.y) && Math::is_equal_approx(last.rect.size.y, mr.rect.size.y) &&
+					Math::is_equal_approx(last.rect.position.x + last.rect.size.x, mr.rect.position.x)) {
+				last.rect.size.x = mr.rect.position.x + mr.rect.size.x - last.rect.position.x;
+				continue;
+			}
+		}
+		runs.push_back(mr);
+	}
+
+	Vector<MergeRect> merged;
+	runs.sort_custom<MergeRectColumnSort>();
+	for (int i = 0; i < runs.size(); i++) {
+
+		const MergeRect &mr = runs[i];
+		//one way collision only makes sense on the top edge, so those are never stacked
+		if (merged.size() && !mr.one_way_collision) {
+			MergeRect &last = merged.write[merged.size() - 1];
+			if (!last.one_way_collision &&
+					Math::is_equal_approx(last.rect.position.x, mr.rect.position.x) && Math::is_equal_approx(last.rect.size.x, mr.rect.size.x) &&
+					Math::is_equal_approx(last.rect.position.y + last.rect.size.y, mr.rect.position.y)) {
+				last.rect.size.y = mr.rect.position.y + mr.rect.size.y - last.rect.position.y;
+				continue;
+			}
+		}
+		merged.push_back(mr);
+	}
+
+	for (int i = 0; i < merged.size(); i++) {
+
+		const MergeRect &mr = merged[i];
+
+		Ref<RectangleShape2D> shape;
+		shape.instance();
+		shape->set_extents(mr.rect.size / 2);
+		p_q.merged_shapes.push_back(shape);
+
+		TileSet::ShapeData shape_data;
+		shape_data.shape = shape;
+		shape_data.one_way_collision = mr.one_way_collision;
+		shape_data.one_way_collision_margin = mr.one_way_collision_margin;
+
+		Transform2D xform;
+		xform.set_origin(mr.rect.position + mr.rect.size / 2);
+
+		//the metadata of a merged shape is the first cell it covers
+		_add_shape(shape_idx, p_q, shape, shape_data, xform, mr.metadata);
+	}
+}
+
 void TileMap::update_dirty_quadrants() {
 
 	if (!pending_update)
@@ -372,7 +524,9 @@ void TileMap::update_dirty_quadrants() {
 		} else if (collision_parent) {
 			collision_parent->shape_owner_clear_shapes(q.shape_owner_id);
 		}
+		q.merged_shapes.clear();
 		int shape_idx = 0;
+		Vector<MergeRect> merge_rects;
 
 		if (navigation) {
 			for (Map<PosKey, Quadrant::NavPoly>::Element *E = q.navpoly_ids.front(); E; E = E->next()) {
@@ -393,15 +547,17 @@ void TileMap::update_dirty_quadrants() {
 
 		for (int i = 0; i < q.cells.size(); i++) {
 
-			Map<PosKey, Cell>::Element *E = tile_map.find(q.cells[i]);
-			Cell &c = E->get();
+			const PosKey &pk = q.cells[i];
+			Cell *cell = tile_map.lookup_ptr(pk);
+			ERR_CONTINUE(!cell);
+			Cell &c = *cell;
 			//moment of truth
 			if (!tile_set->has_tile(c.id))
 				continue;
 			Ref<Texture> tex = tile_set->tile_get_texture(c.id);
 			Vector2 tile_ofs = tile_set->tile_get_texture_offset(c.id);
 
-			Vector2 wofs = _map_to_world(E->key().x, E->key().y);
+			Vector2 wofs = _map_to_world(pk.x, pk.y);
 			Vector2 offset = wofs - q.pos + tofs;
 
 			if (!tex.is_valid())
@@ -577,15 +733,16 @@ void TileMap::update_dirty_quadrants() {
 							for (int k = 0; k < _shapes.size(); k++) {
 								Ref<ConvexPolygonShape2D> convex = _shapes[k];
 								if (convex.is_valid()) {
-									_add_shape(shape_idx, q, convex, shapes[j], xform, Vector2(E->key().x, E->key().y));
+									if (!collision_merge_rects || !_queue_merge_rect(merge_rects, convex, shapes[j], xform, Vector2(pk.x, pk.y)))
+										_add_shape(shape_idx, q, convex, shapes[j], xform, Vector2(pk.x, pk.y));
 #ifdef DEBUG_ENABLED
 								} else {
 									print_error("The TileSet assigned to the TileMap " + get_name() + " has an invalid convex shape.");
 #endif
 								}
 							}
-						} else {
-							_add_shape(shape_idx, q, shape, shapes[j], xform, Vector2(E->key().x, E->key().y));
+						} else if (!collision_merge_rects || !_queue_merge_rect(merge_rects, shape, shapes[j], xform, Vector2(pk.x, pk.y))) {
+							_add_shape(shape_idx, q, shape, shapes[j], xform, Vector2(pk.x, pk.y));
 						}
 					}
 				}
@@ -616,7 +773,7 @@ void TileMap::update_dirty_quadrants() {
 					Quadrant::NavPoly np;
 					np.id = pid;
 					np.xform = xform;
-					q.navpoly_ids[E->key()] = np;
+					q.navpoly_ids[pk] = np;
 
 					if (debug_navigation) {
 						RID debug_navigation_item = vs->canvas_item_create();
@@ -689,10 +846,12 @@ void TileMap::update_dirty_quadrants() {
 				Quadrant::Occluder oc;
 				oc.xform = xform;
 				oc.id = orid;
-				q.occluder_instances[E->key()] = oc;
+				q.occluder_instances[pk] = oc;
 			}
 		}
 
+		_add_merged_rects(shape_idx, q, merge_rects);
+
 		dirty_quadrant_list.remove(dirty_quadrant_list.first());
 		quadrant_order_dirty = true;
 	}
@@ -857,14 +1016,14 @@ void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_
 
 	PosKey pk(p_x, p_y);
 
-	Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	Cell *E = tile_map.lookup_ptr(pk);
 	if (!E && p_tile == INVALID_CELL)
 		return; //nothing to do
 
 	PosKey qk = pk.to_quadrant(_get_quadrant_size());
 	if (p_tile == INVALID_CELL) {
 		//erase existing
-		tile_map.erase(pk);
+		tile_map.remove(pk);
 		Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
 		ERR_FAIL_COND(!Q);
 		Quadrant &q = Q->get();
@@ -881,7 +1040,8 @@ void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_
 	Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
 
 	if (!E) {
-		E = tile_map.insert(pk, Cell());
+		tile_map.insert(pk, Cell());
+		E = tile_map.lookup_ptr(pk);
 		if (!Q) {
 			Q = _create_quadrant(qk);
 		}
@@ -890,11 +1050,11 @@ void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_
 	} else {
 		ERR_FAIL_COND(!Q); // quadrant should exist...
 
-		if (E->get().id == p_tile && E->get().flip_h == p_flip_x && E->get().flip_v == p_flip_y && E->get().transpose == p_transpose && E->get().autotile_coord_x == (uint16_t)p_autotile_coord.x && E->get().autotile_coord_y == (uint16_t)p_autotile_coord.y)
+		if (E->id == p_tile && E->flip_h == p_flip_x && E->flip_v == p_flip_y && E->transpose == p_transpose && E->autotile_coord_x == (uint16_t)p_autotile_coord.x && E->autotile_coord_y == (uint16_t)p_autotile_coord.y)
 			return; //nothing changed
 	}
 
-	Cell &c = E->get();
+	Cell &c = *E;
 
 	c.id = p_tile;
 	c.flip_h = p_flip_x;
@@ -917,7 +1077,8 @@ void TileMap::make_bitmask_area_dirty(const Vector2 &p_pos) {
 	for (int x = p_pos.x - 1; x <= p_pos.x + 1; x++) {
 		for (int y = p_pos.y - 1; y <= p_pos.y + 1; y++) {
 			PosKey p(x, y);
-			if (dirty_bitmask.find(p) == NULL) {
+			if (!dirty_bitmask_set.has(p)) {
+				dirty_bitmask_set.insert(p, true);
 				dirty_bitmask.push_back(p);
 			}
 		}
@@ -957,8 +1118,7 @@ void TileMap::update_cell_bitmask(int p_x, int p_y) {
 
 	ERR_FAIL_COND_MSG(tile_set.is_null(), "Cannot update cell bitmask if Tileset is not open.");
 	PosKey p(p_x, p_y);
-	Map<PosKey, Cell>::Element *E = tile_map.find(p);
-	if (E != NULL) {
+	if (tile_map.has(p)) {
 		int id = get_cell(p_x, p_y);
 		if (tile_set->tile_get_tile_mode(id) == TileSet::AUTO_TILE) {
 			uint16_t mask = 0;
@@ -1018,8 +1178,10 @@ void TileMap::update_cell_bitmask(int p_x, int p_y) {
 				}
 			}
 			Vector2 coord = tile_set->autotile_get_subtile_for_bitmask(id, mask, this, Vector2(p_x, p_y));
-			E->get().autotile_coord_x = (int)coord.x;
-			E->get().autotile_coord_y = (int)coord.y;
+			Cell *E = tile_map.lookup_ptr(p);
+			ERR_FAIL_COND(!E);
+			E->autotile_coord_x = (int)coord.x;
+			E->autotile_coord_y = (int)coord.y;
 
 			PosKey qk = p.to_quadrant(_get_quadrant_size());
 			Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
@@ -1027,15 +1189,18 @@ void TileMap::update_cell_bitmask(int p_x, int p_y) {
 
 		} else if (tile_set->tile_get_tile_mode(id) == TileSet::SINGLE_TILE) {
 
-			E->get().autotile_coord_x = 0;
-			E->get().autotile_coord_y = 0;
+			Cell *E = tile_map.lookup_ptr(p);
+			E->autotile_coord_x = 0;
+			E->autotile_coord_y = 0;
 		} else if (tile_set->tile_get_tile_mode(id) == TileSet::ATLAS_TILE) {
 
 			if (tile_set->autotile_get_bitmask(id, Vector2(p_x, p_y)) == TileSet::BIND_CENTER) {
 				Vector2 coord = tile_set->atlastile_get_subtile_by_priority(id, this, Vector2(p_x, p_y));
 
-				E->get().autotile_coord_x = (int)coord.x;
-				E->get().autotile_coord_y = (int)coord.y;
+				Cell *E = tile_map.lookup_ptr(p);
+				ERR_FAIL_COND(!E);
+				E->autotile_coord_x = (int)coord.x;
+				E->autotile_coord_y = (int)coord.y;
 			}
 		}
 	}
@@ -1044,80 +1209,87 @@ void TileMap::update_cell_bitmask(int p_x, int p_y) {
 void TileMap::update_dirty_bitmask() {
 
 	while (dirty_bitmask.size() > 0) {
-		update_cell_bitmask(dirty_bitmask[0].x, dirty_bitmask[0].y);
+		PosKey p = dirty_bitmask.front()->get();
 		dirty_bitmask.pop_front();
+		dirty_bitmask_set.remove(p);
+		update_cell_bitmask(p.x, p.y);
 	}
 }
 
 void TileMap::fix_invalid_tiles() {
 
 	ERR_FAIL_COND_MSG(tile_set.is_null(), "Cannot fix invalid tiles if Tileset is not open.");
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
 
-		if (!tile_set->has_tile(get_cell(E->key().x, E->key().y))) {
-			set_cell(E->key().x, E->key().y, INVALID_CELL);
+	//collected first, erasing while iterating the map would skip cells
+	Vector<PosKey> invalid;
+	for (OAHashMap<PosKey, Cell, PosKeyHasher>::Iterator it = tile_map.iter(); it.valid; it = tile_map.next_iter(it)) {
+
+		if (!tile_set->has_tile(it.value->id)) {
+			invalid.push_back(*it.key);
 		}
 	}
+
+	for (int i = 0; i < invalid.size(); i++) {
+		set_cell(invalid[i].x, invalid[i].y, INVALID_CELL);
+	}
 }
 
 int TileMap::get_cell(int p_x, int p_y) const {
 
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = tile_map.lookup_ptr(pk);
 
 	if (!E)
 		return INVALID_CELL;
 
-	return E->get().id;
+	return E->id;
 }
 bool TileMap::is_cell_x_flipped(int p_x, int p_y) const {
 
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = tile_map.lookup_ptr(pk);
 
 	if (!E)
 		return false;
 
-	return E->get().flip_h;
+	return E->flip_h;
 }
 bool TileMap::is_cell_y_flipped(int p_x, int p_y) const {
 
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = tile_map.lookup_ptr(pk);
 
 	if (!E)
 		return false;
 
-	return E->get().flip_v;
+	return E->flip_v;
 }
 bool TileMap::is_cell_transposed(int p_x, int p_y) const {
 
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = tile_map.lookup_ptr(pk);
 
 	if (!E)
 		return false;
 
-	return E->get().transpose;
+	return E->transpose;
 }
 
 void TileMap::set_cell_autotile_coord(int p_x, int p_y, const Vector2 &p_coord) {
 
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	Cell *E = tile_map.lookup_ptr(pk);
 
 	if (!E)
 		return;
 
-	Cell c = E->get();
-	c.autotile_coord_x = p_coord.x;
-	c.autotile_coord_y = p_coord.y;
-	tile_map[pk] = c;
+	E->autotile_coord_x = p_coord.x;
+	E->autotile_coord_y = p_coord.y;
 
 	PosKey qk = pk.to_quadrant(_get_quadrant_size());
 	Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
@@ -1132,21 +1304,21 @@ Vector2 TileMap::get_cell_autotile_coord(int p_x, int p_y) const {
 
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = tile_map.lookup_ptr(pk);
 
 	if (!E)
 		return Vector2();
 
-	return Vector2(E->get().autotile_coord_x, E->get().autotile_coord_y);
+	return Vector2(E->autotile_coord_x, E->autotile_coord_y);
 }
 
 void TileMap::_recreate_quadrants() {
 
 	_clear_quadrants();
 
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
+	for (OAHashMap<PosKey, Cell, PosKeyHasher>::Iterator it = tile_map.iter(); it.valid; it = tile_map.next_iter(it)) {
 
-		PosKey qk = PosKey(E->key().x, E->key().y).to_quadrant(_get_quadrant_size());
+		PosKey qk = it.key->to_quadrant(_get_quadrant_size());
 
 		Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
 		if (!Q) {
@@ -1154,7 +1326,7 @@ void TileMap::_recreate_quadrants() {
 			dirty_quadrant_list.add(&Q->get().dirty_list);
 		}
 
-		Q->get().cells.insert(E->key());
+		Q->get().cells.insert(*it.key);
 		_make_quadrant_dirty(Q, false);
 	}
 	update_dirty_quadrants();
@@ -1213,6 +1385,12 @@ void TileMap::_set_tile_data(const PoolVector<int> &p_data) {
 	int offset = (format == FORMAT_2) ? 3 : 2;
 
 	clear();
+
+	//size the map once instead of rehashing while it grows
+	uint32_t cells = c / offset;
+	if (cells * 10 / 9 + 1 > tile_map.get_capacity()) {
+		tile_map.reserve(cells * 10 / 9 + 1);
+	}
 	for (int i = 0; i < c; i += offset) {
 
 		const uint8_t *ptr = (const uint8_t *)&r[i];
@@ -1253,27 +1431,33 @@ void TileMap::_set_tile_data(const PoolVector<int> &p_data) {
 
 PoolVector<int> TileMap::_get_tile_data() const {
 
+	//saved in position order, so the data doesn't depend on the hash layout
+	Vector<PosKey> cells;
+	_get_sorted_cells(cells);
+
 	PoolVector<int> data;
-	data.resize(tile_map.size() * 3);
+	data.resize(cells.size() * 3);
 	PoolVector<int>::Write w = data.write();
 
 	// Save in highest format
 
 	int idx = 0;
-	for (const Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
+	for (int i = 0; i < cells.size(); i++) {
+		const PosKey &pk = cells[i];
+		const Cell *E = tile_map.lookup_ptr(pk);
 		uint8_t *ptr = (uint8_t *)&w[idx];
-		encode_uint16(E->key().x, &ptr[0]);
-		encode_uint16(E->key().y, &ptr[2]);
-		uint32_t val = E->get().id;
-		if (E->get().flip_h)
+		encode_uint16(pk.x, &ptr[0]);
+		encode_uint16(pk.y, &ptr[2]);
+		uint32_t val = E->id;
+		if (E->flip_h)
 			val |= (1 << 29);
-		if (E->get().flip_v)
+		if (E->flip_v)
 			val |= (1 << 30);
-		if (E->get().transpose)
+		if (E->transpose)
 			val |= (1 << 31);
 		encode_uint32(val, &ptr[4]);
-		encode_uint16(E->get().autotile_coord_x, &ptr[8]);
-		encode_uint16(E->get().autotile_coord_y, &ptr[10]);
+		encode_uint16(E->autotile_coord_x, &ptr[8]);
+		encode_uint16(E->autotile_coord_y, &ptr[10]);
 		idx += 3;
 	}
 
@@ -1349,6 +1533,21 @@ void TileMap::set_collision_use_kinematic(bool p_use_kinematic) {
 	_recreate_quadrants();
 }
 
+void TileMap::set_collision_merge_rects(bool p_enable) {
+
+	if (collision_merge_rects == p_enable)
+		return;
+
+	_clear_quadrants();
+	collision_merge_rects = p_enable;
+	_recreate_quadrants();
+}
+
+bool TileMap::get_collision_merge_rects() const {
+
+	return collision_merge_rects;
+}
+
 bool TileMap::get_collision_use_parent() const {
 
 	return use_parent;
@@ -1689,15 +1888,27 @@ bool TileMap::is_centered_textures_enabled() const {
 	return centered_textures;
 }
 
+void TileMap::_get_sorted_cells(Vector<PosKey> &r_cells) const {
+
+	r_cells.resize(tile_map.get_num_elements());
+	PosKey *w = r_cells.ptrw();
+	int i = 0;
+	for (OAHashMap<PosKey, Cell, PosKeyHasher>::Iterator it = tile_map.iter(); it.valid; it = tile_map.next_iter(it)) {
+		w[i++] = *it.key;
+	}
+	r_cells.sort();
+}
+
 Array TileMap::get_used_cells() const {
 
+	Vector<PosKey> cells;
+	_get_sorted_cells(cells);
+
 	Array a;
-	a.resize(tile_map.size());
-	int i = 0;
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
+	a.resize(cells.size());
+	for (int i = 0; i < cells.size(); i++) {
 
-		Vector2 p(E->key().x, E->key().y);
-		a[i++] = p;
+		a[i] = Vector2(cells[i].x, cells[i].y);
 	}
 
 	return a;
@@ -1705,12 +1916,14 @@ Array TileMap::get_used_cells() const {
 
 Array TileMap::get_used_cells_by_id(int p_id) const {
 
+	Vector<PosKey> cells;
+	_get_sorted_cells(cells);
+
 	Array a;
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
+	for (int i = 0; i < cells.size(); i++) {
 
-		if (E->value().id == p_id) {
-			Vector2 p(E->key().x, E->key().y);
-			a.push_back(p);
+		if (tile_map.lookup_ptr(cells[i])->id == p_id) {
+			a.push_back(Vector2(cells[i].x, cells[i].y));
 		}
 	}
 
@@ -1720,11 +1933,12 @@ Array TileMap::get_used_cells_by_id(int p_id) const {
 Rect2 TileMap::get_used_rect() { // Not const because of cache
 
 	if (used_size_cache_dirty) {
-		if (tile_map.size() > 0) {
-			used_size_cache = Rect2(tile_map.front()->key().x, tile_map.front()->key().y, 0, 0);
+		if (!tile_map.empty()) {
+			OAHashMap<PosKey, Cell, PosKeyHasher>::Iterator it = tile_map.iter();
+			used_size_cache = Rect2(it.key->x, it.key->y, 0, 0);
 
-			for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-				used_size_cache.expand_to(Vector2(E->key().x, E->key().y));
+			for (; it.valid; it = tile_map.next_iter(it)) {
+				used_size_cache.expand_to(Vector2(it.key->x, it.key->y));
 			}
 
 			used_size_cache.size += Vector2(1, 1);
@@ -1835,6 +2049,9 @@ void TileMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_collision_use_kinematic", "use_kinematic"), &TileMap::set_collision_use_kinematic);
 	ClassDB::bind_method(D_METHOD("get_collision_use_kinematic"), &TileMap::get_collision_use_kinematic);
 
+	ClassDB::bind_method(D_METHOD("set_collision_merge_rects", "enable"), &TileMap::set_collision_merge_rects);
+	ClassDB::bind_method(D_METHOD("get_collision_merge_rects"), &TileMap::get_collision_merge_rects);
+
 	ClassDB::bind_method(D_METHOD("set_collision_use_parent", "use_parent"), &TileMap::set_collision_use_parent);
 	ClassDB::bind_method(D_METHOD("get_collision_use_parent"), &TileMap::get_collision_use_parent);
 
@@ -1907,6 +2124,7 @@ void TileMap::_bind_methods() {
 	ADD_GROUP("Collision", "collision_");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_use_parent", PROPERTY_HINT_NONE, ""), "set_collision_use_parent", "get_collision_use_parent");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_use_kinematic", PROPERTY_HINT_NONE, ""), "set_collision_use_kinematic", "get_collision_use_kinematic");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_merge_rects"), "set_collision_merge_rects", "get_collision_merge_rects");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "collision_friction", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_collision_friction", "get_collision_friction");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "collision_bounce", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_collision_bounce", "get_collision_bounce");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_layer", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_collision_layer", "get_collision_layer");
@@ -1960,6 +2178,7 @@ TileMap::TileMap() {
 	use_parent = false;
 	collision_parent = NULL;
 	use_kinematic = false;
+	collision_merge_rects = false;
 	navigation = NULL;
 	y_sort_mode = false;
 	compatibility_mode = false;
@@ -31,6 +31,7 @@
 #ifndef TILE_MAP_H
 #define TILE_MAP_H
 
+#include "core/oa_hash_map.h"
 #include "core/self_list.h"
 #include "core/vset.h"
 #include "scene/2d/navigation_2d.h"
@@ -79,6 +80,7 @@ private:
 	bool use_parent;
 	CollisionObject2D *collision_parent;
 	bool use_kinematic;
+	bool collision_merge_rects;
 	Navigation2D *navigation;
 
 	union PosKey {
@@ -111,6 +113,10 @@ private:
 		}
 	};
 
+	struct PosKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const PosKey &p_key) { return hash_one_uint64(p_key.key); }
+	};
+
 	union Cell {
 
 		struct {
@@ -126,8 +132,12 @@ private:
 		Cell() { _u64t = 0; }
 	};
 
-	Map<PosKey, Cell> tile_map;
+	//hashed, so building and querying large maps doesn't walk a tree per cell
+	OAHashMap<PosKey, Cell, PosKeyHasher> tile_map;
 	List<PosKey> dirty_bitmask;
+	OAHashMap<PosKey, bool, PosKeyHasher> dirty_bitmask_set;
+
+	void _get_sorted_cells(Vector<PosKey> &r_cells) const;
 
 	struct Quadrant {
 
@@ -152,6 +162,7 @@ private:
 		Map<PosKey, Occluder> occluder_instances;
 
 		VSet<PosKey> cells;
+		Vector<Ref<Shape2D> > merged_shapes;
 
 		void operator=(const Quadrant &q) {
 			pos = q.pos;
@@ -161,6 +172,7 @@ private:
 			cells = q.cells;
 			navpoly_ids = q.navpoly_ids;
 			occluder_instances = q.occluder_instances;
+			merged_shapes = q.merged_shapes;
 		}
 		Quadrant(const Quadrant &q) :
 				dirty_list(this) {
@@ -171,6 +183,7 @@ private:
 			cells = q.cells;
 			occluder_instances = q.occluder_instances;
 			navpoly_ids = q.navpoly_ids;
+			merged_shapes = q.merged_shapes;
 		}
 		Quadrant() :
 				dirty_list(this) {}
@@ -206,6 +219,24 @@ private:
 
 	void _add_shape(int &shape_idx, const Quadrant &p_q, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata);
 
+	struct MergeRect {
+		Rect2 rect;
+		Vector2 metadata;
+		bool one_way_collision;
+		float one_way_collision_margin;
+	};
+
+	struct MergeRectRowSort {
+		bool operator()(const MergeRect &p_a, const MergeRect &p_b) const;
+	};
+
+	struct MergeRectColumnSort {
+		bool operator()(const MergeRect &p_a, const MergeRect &p_b) const;
+	};
+
+	bool _queue_merge_rect(Vector<MergeRect> &r_rects, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata) const;
+	void _add_merged_rects(int &shape_idx, Quadrant &p_q, Vector<MergeRect> &p_rects);
+
 	Map<PosKey, Quadrant>::Element *_create_quadrant(const PosKey &p_qk);
 	void _erase_quadrant(Map<PosKey, Quadrant>::Element *Q);
 	void _make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update = true);
@@ -295,6 +326,9 @@ public:
 	void set_collision_use_parent(bool p_use_parent);
 	bool get_collision_use_parent() const;
 
+	void set_collision_merge_rects(bool p_enable);
+	bool get_collision_merge_rects() const;
+
 	void set_collision_friction(float p_friction);
 	float get_collision_friction() const;
 
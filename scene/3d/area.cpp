@@ -297,8 +297,9 @@ void Area::set_monitoring(bool p_enable) {
 
 	if (monitoring) {
 
-		PhysicsServer::get_singleton()->area_set_monitor_callback(get_rid(), this, SceneStringNames::get_singleton()->_body_inout);
-		PhysicsServer::get_singleton()->area_set_area_monitor_callback(get_rid(), this, SceneStringNames::get_singleton()->_area_inout);
+		PhysicsServer::get_singleton()->area_set_monitor_batching(get_rid(), true);
+		PhysicsServer::get_singleton()->area_set_monitor_callback(get_rid(), this, SceneStringNames::get_singleton()->_body_inout_batch);
+		PhysicsServer::get_singleton()->area_set_area_monitor_callback(get_rid(), this, SceneStringNames::get_singleton()->_area_inout_batch);
 	} else {
 		PhysicsServer::get_singleton()->area_set_monitor_callback(get_rid(), NULL, StringName());
 		PhysicsServer::get_singleton()->area_set_area_monitor_callback(get_rid(), NULL, StringName());
@@ -340,6 +341,16 @@ void Area::_area_exit_tree(ObjectID p_id) {
 	}
 }
 
+void Area::_body_inout_batch(const Array &p_events) {
+
+	// Events are packed as (status, rid, instance, body_shape, area_shape).
+	ERR_FAIL_COND(p_events.size() % 5 != 0);
+
+	for (int i = 0; i < p_events.size(); i += 5) {
+		_body_inout(p_events[i], p_events[i + 1], p_events[i + 2], p_events[i + 3], p_events[i + 4]);
+	}
+}
+
 void Area::_area_inout(int p_status, const RID &p_area, int p_instance, int p_area_shape, int p_self_shape) {
 
 	bool area_in = p_status == PhysicsServer::AREA_BODY_ADDED;
@@ -410,6 +421,16 @@ void Area::_area_inout(int p_status, const RID &p_area, int p_instance, int p_ar
 	locked = false;
 }
 
+void Area::_area_inout_batch(const Array &p_events) {
+
+	// Events are packed as (status, rid, instance, area_shape, self_shape).
+	ERR_FAIL_COND(p_events.size() % 5 != 0);
+
+	for (int i = 0; i < p_events.size(); i += 5) {
+		_area_inout(p_events[i], p_events[i + 1], p_events[i + 2], p_events[i + 3], p_events[i + 4]);
+	}
+}
+
 bool Area::is_monitoring() const {
 
 	return monitoring;
@@ -674,7 +695,9 @@ void Area::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("overlaps_area", "area"), &Area::overlaps_area);
 
 	ClassDB::bind_method(D_METHOD("_body_inout"), &Area::_body_inout);
+	ClassDB::bind_method(D_METHOD("_body_inout_batch"), &Area::_body_inout_batch);
 	ClassDB::bind_method(D_METHOD("_area_inout"), &Area::_area_inout);
+	ClassDB::bind_method(D_METHOD("_area_inout_batch"), &Area::_area_inout_batch);
 
 	ClassDB::bind_method(D_METHOD("set_audio_bus_override", "enable"), &Area::set_audio_bus_override);
 	ClassDB::bind_method(D_METHOD("is_overriding_audio_bus"), &Area::is_overriding_audio_bus);
@@ -34,6 +34,7 @@
 #include "scene/3d/camera.h"
 #include "scene/3d/listener.h"
 #include "scene/main/viewport.h"
+#include "servers/audio/audio_mix.h"
 
 // Based on "A Novel Multichannel Panning Method for Standard and Arbitrary Loudspeaker Configurations" by Ramy Sadek and Chris Kyriakakis (2004)
 // Speaker-Placement Correction Amplitude Panning (SPCAP)
@@ -151,20 +152,50 @@ void AudioStreamPlayer3D::_mix_audio() {
 		buffer_size = MIN(buffer_size, 128);
 	}
 
-	// Mix if we're not paused or we're fading out
-	if ((output_count > 0 || out_of_range_mode == OUT_OF_RANGE_MIX)) {
+	float output_pitch_scale = 0.0;
+	if (output_count) {
+		//used for doppler, not realistic but good enough
+		for (int i = 0; i < output_count; i++) {
+			output_pitch_scale += outputs[i].pitch_scale;
+		}
+		output_pitch_scale /= float(output_count);
+	} else {
+		output_pitch_scale = 1.0;
+	}
+
+	//ask the voice manager whether this is worth mixing, virtual voices only move on in time
+	bool voice_fade_in = false;
+	bool voice_fade_out = false;
+	if (output_count > 0 && !stream_paused_fade_out) {
+
+		float audibility = 0;
+		for (int i = 0; i < output_count; i++) {
+			for (int k = 0; k < 4; k++) {
+				audibility = MAX(audibility, MAX(outputs[i].vol[k].l, outputs[i].vol[k].r));
+				audibility = MAX(audibility, MAX(outputs[i].reverb_vol[k].l, outputs[i].reverb_vol[k].r));
+			}
+		}
+
+		bool real = AudioServer::get_singleton()->thread_request_voice(outputs[0].bus_index, &voice, audibility);
 
-		float output_pitch_scale = 0.0;
-		if (output_count) {
-			//used for doppler, not realistic but good enough
-			for (int i = 0; i < output_count; i++) {
-				output_pitch_scale += outputs[i].pitch_scale;
+		if (!real && voice_virtual) {
+			stream_playback->skip(buffer_size / AudioServer::get_singleton()->get_mix_rate() * pitch_scale * output_pitch_scale);
+			if (!stream_playback->is_playing()) {
+				active = false;
 			}
-			output_pitch_scale /= float(output_count);
-		} else {
-			output_pitch_scale = 1.0;
+			output_ready = false;
+			stream_paused_fade_in = false;
+			return;
 		}
 
+		voice_fade_out = !real; //ramp down once before going virtual, to avoid a click
+		voice_fade_in = real && voice_virtual;
+		voice_virtual = !real;
+	}
+
+	// Mix if we're not paused or we're fading out
+	if ((output_count > 0 || out_of_range_mode == OUT_OF_RANGE_MIX)) {
+
 		stream_playback->mix(buffer, pitch_scale * output_pitch_scale, buffer_size);
 	}
 
@@ -202,10 +233,11 @@ void AudioStreamPlayer3D::_mix_audio() {
 		int buffers = AudioServer::get_singleton()->get_channel_count();
 
 		for (int k = 0; k < buffers; k++) {
-			AudioFrame target_volume = stream_paused_fade_out ? AudioFrame(0.f, 0.f) : current.vol[k];
-			AudioFrame vol_prev = stream_paused_fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].vol[k];
+			bool fade_in = stream_paused_fade_in || voice_fade_in;
+			AudioFrame target_volume = (stream_paused_fade_out || voice_fade_out) ? AudioFrame(0.f, 0.f) : current.vol[k];
+			AudioFrame vol_prev = fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].vol[k];
 			AudioFrame vol_inc = (target_volume - vol_prev) / float(buffer_size);
-			AudioFrame vol = stream_paused_fade_in ? AudioFrame(0.f, 0.f) : current.vol[k];
+			AudioFrame vol = fade_in ? AudioFrame(0.f, 0.f) : current.vol[k];
 
 			if (!AudioServer::get_singleton()->thread_has_channel_mix_buffer(current.bus_index, k))
 				continue; //may have been deleted, will be updated on process
@@ -263,20 +295,10 @@ void AudioStreamPlayer3D::_mix_audio() {
 
 				if (current.reverb_bus_index == prev_outputs[i].reverb_bus_index) {
 					AudioFrame rvol_inc = (current.reverb_vol[k] - prev_outputs[i].reverb_vol[k]) / float(buffer_size);
-					AudioFrame rvol = prev_outputs[i].reverb_vol[k];
-
-					for (int j = 0; j < buffer_size; j++) {
-
-						rtarget[j] += buffer[j] * rvol;
-						rvol += rvol_inc;
-					}
+					AudioMix::add_ramp(rtarget, buffer, buffer_size, prev_outputs[i].reverb_vol[k], rvol_inc);
 				} else {
 
-					AudioFrame rvol = current.reverb_vol[k];
-					for (int j = 0; j < buffer_size; j++) {
-
-						rtarget[j] += buffer[j] * rvol;
-					}
+					AudioMix::add_ramp(rtarget, buffer, buffer_size, current.reverb_vol[k], AudioFrame(0, 0));
 				}
 			}
 		}
@@ -391,7 +413,7 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 
 			PhysicsDirectSpaceState::ShapeResult sr[MAX_INTERSECT_AREAS];
 
-			int areas = space_state->intersect_point(global_pos, sr, MAX_INTERSECT_AREAS, Set<RID>(), area_mask, false, true);
+			int areas = space_state->intersect_point(global_pos, sr, MAX_INTERSECT_AREAS, BTreeSet<RID>(), area_mask, false, true);
 			Area *area = NULL;
 
 			for (int i = 0; i < areas; i++) {
@@ -705,6 +727,7 @@ void AudioStreamPlayer3D::play(float p_from_pos) {
 		active = true;
 		setplay = p_from_pos;
 		output_ready = false;
+		voice_virtual = false;
 		set_physics_process_internal(true);
 	}
 }
@@ -1066,6 +1089,7 @@ AudioStreamPlayer3D::AudioStreamPlayer3D() {
 	stream_paused = false;
 	stream_paused_fade_in = false;
 	stream_paused_fade_out = false;
+	voice_virtual = false;
 
 	velocity_tracker.instance();
 	AudioServer::get_singleton()->connect("bus_layout_changed", this, "_bus_layout_changed");
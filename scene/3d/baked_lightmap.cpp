@@ -33,7 +33,6 @@
 #include "core/io/resource_saver.h"
 #include "core/os/dir_access.h"
 #include "core/os/os.h"
-#include "voxel_light_baker.h"
 
 void BakedLightmapData::set_bounds(const AABB &p_bounds) {
 
@@ -336,6 +335,80 @@ bool BakedLightmap::_bake_time(void *ud, float p_secs, float p_progress) {
 	return false;
 }
 
+Ref<Image> BakedLightmap::_get_lightmap_image(const VoxelLightBaker::LightMapData &p_lightmap, uint32_t *r_tex_flags) const {
+
+	Ref<Image> image;
+	image.instance();
+
+	uint32_t tex_flags = Texture::FLAGS_DEFAULT;
+	if (hdr) {
+
+		//just save a regular image
+		PoolVector<uint8_t> data;
+		int s = p_lightmap.light.size();
+		data.resize(p_lightmap.light.size() * 2);
+		{
+
+			PoolVector<uint8_t>::Write w = data.write();
+			PoolVector<float>::Read r = p_lightmap.light.read();
+			uint16_t *hfw = (uint16_t *)w.ptr();
+			for (int i = 0; i < s; i++) {
+				hfw[i] = Math::make_half_float(r[i]);
+			}
+		}
+
+		image->create(p_lightmap.width, p_lightmap.height, false, Image::FORMAT_RGBH, data);
+
+	} else {
+
+		//just save a regular image
+		PoolVector<uint8_t> data;
+		int s = p_lightmap.light.size();
+		data.resize(p_lightmap.light.size());
+		{
+
+			PoolVector<uint8_t>::Write w = data.write();
+			PoolVector<float>::Read r = p_lightmap.light.read();
+			for (int i = 0; i < s; i += 3) {
+				Color c(r[i + 0], r[i + 1], r[i + 2]);
+				c = c.to_srgb();
+				w[i + 0] = CLAMP(c.r * 255, 0, 255);
+				w[i + 1] = CLAMP(c.g * 255, 0, 255);
+				w[i + 2] = CLAMP(c.b * 255, 0, 255);
+			}
+		}
+
+		image->create(p_lightmap.width, p_lightmap.height, false, Image::FORMAT_RGB8, data);
+
+		//This texture is saved to SRGB for two reasons:
+		// 1) first is so it looks better when doing the LINEAR->SRGB conversion (more accurate)
+		// 2) So it can be used in the GLES2 backend, which does not support linkear workflow
+		tex_flags |= Texture::FLAG_CONVERT_TO_LINEAR;
+	}
+
+	if (r_tex_flags) {
+		*r_tex_flags = tex_flags;
+	}
+	return image;
+}
+
+void BakedLightmap::_bake_preview(void *ud, const VoxelLightBaker::LightMapData &p_lightmap) {
+
+	BakeTimeData *btd = (BakeTimeData *)ud;
+	if (!btd->preview_instance.is_valid())
+		return;
+
+	uint32_t tex_flags;
+	Ref<Image> image = btd->owner->_get_lightmap_image(p_lightmap, &tex_flags);
+
+	if (btd->preview_texture.is_null()) {
+		btd->preview_texture.instance();
+	}
+	btd->preview_texture->create_from_image(image, tex_flags);
+	//shown on the next editor redraw, which happens on the next progress step
+	VS::get_singleton()->instance_set_use_lightmap(btd->preview_instance, btd->owner->get_instance(), btd->preview_texture->get_rid());
+}
+
 BakedLightmap::BakeError BakedLightmap::bake(Node *p_from_node, bool p_create_visual_debug) {
 
 	String save_path;
@@ -442,6 +515,17 @@ BakedLightmap::BakeError BakedLightmap::bake(Node *p_from_node, bool p_create_vi
 
 	baker.end_bake();
 
+	//the editor shows each lightmap while its passes converge, which needs a lightmap capture as base
+	Ref<BakedLightmapData> preview_data;
+	if (bake_step_function && is_inside_tree()) {
+		if (light_data.is_valid()) {
+			_clear_lightmaps();
+		}
+		preview_data.instance();
+		preview_data->set_bounds(AABB(-extents, extents * 2));
+		set_base(preview_data->get_rid());
+	}
+
 	Set<String> used_mesh_names;
 
 	pmc = 0;
@@ -468,13 +552,21 @@ BakedLightmap::BakeError BakedLightmap::bake(Node *p_from_node, bool p_create_vi
 		VoxelLightBaker::LightMapData lm;
 
 		Error err;
+		BakeTimeData btd;
+		btd.owner = this;
+		if (preview_data.is_valid()) {
+			btd.preview_instance = _get_user_instance(E->get().path, E->get().instance_idx);
+		}
+
 		if (bake_step_function) {
-			BakeTimeData btd;
 			btd.text = RTR("Lighting Meshes: ") + mesh_name + " (" + itos(pmc) + "/" + itos(mesh_list.size()) + ")";
 			btd.pass = step;
 			btd.last_step = 0;
-			err = baker.make_lightmap(E->get().local_xform, E->get().mesh, bake_default_texels_per_unit, lm, _bake_time, &btd);
+			err = baker.make_lightmap(E->get().local_xform, E->get().mesh, bake_default_texels_per_unit, lm, _bake_time, &btd, _bake_preview);
 			if (err != OK) {
+				if (preview_data.is_valid()) {
+					_restore_light_data();
+				}
 				bake_end_function();
 				if (err == ERR_SKIP)
 					return BAKE_ERROR_USER_ABORTED;
@@ -488,54 +580,8 @@ BakedLightmap::BakeError BakedLightmap::bake(Node *p_from_node, bool p_create_vi
 
 		if (err == OK) {
 
-			Ref<Image> image;
-			image.instance();
-
-			uint32_t tex_flags = Texture::FLAGS_DEFAULT;
-			if (hdr) {
-
-				//just save a regular image
-				PoolVector<uint8_t> data;
-				int s = lm.light.size();
-				data.resize(lm.light.size() * 2);
-				{
-
-					PoolVector<uint8_t>::Write w = data.write();
-					PoolVector<float>::Read r = lm.light.read();
-					uint16_t *hfw = (uint16_t *)w.ptr();
-					for (int i = 0; i < s; i++) {
-						hfw[i] = Math::make_half_float(r[i]);
-					}
-				}
-
-				image->create(lm.width, lm.height, false, Image::FORMAT_RGBH, data);
-
-			} else {
-
-				//just save a regular image
-				PoolVector<uint8_t> data;
-				int s = lm.light.size();
-				data.resize(lm.light.size());
-				{
-
-					PoolVector<uint8_t>::Write w = data.write();
-					PoolVector<float>::Read r = lm.light.read();
-					for (int i = 0; i < s; i += 3) {
-						Color c(r[i + 0], r[i + 1], r[i + 2]);
-						c = c.to_srgb();
-						w[i + 0] = CLAMP(c.r * 255, 0, 255);
-						w[i + 1] = CLAMP(c.g * 255, 0, 255);
-						w[i + 2] = CLAMP(c.b * 255, 0, 255);
-					}
-				}
-
-				image->create(lm.width, lm.height, false, Image::FORMAT_RGB8, data);
-
-				//This texture is saved to SRGB for two reasons:
-				// 1) first is so it looks better when doing the LINEAR->SRGB conversion (more accurate)
-				// 2) So it can be used in the GLES2 backend, which does not support linkear workflow
-				tex_flags |= Texture::FLAG_CONVERT_TO_LINEAR;
-			}
+			uint32_t tex_flags;
+			Ref<Image> image = _get_lightmap_image(lm, &tex_flags);
 
 			String image_path = save_path.plus_file(mesh_name);
 			Ref<Texture> texture;
@@ -592,12 +638,20 @@ BakedLightmap::BakeError BakedLightmap::bake(Node *p_from_node, bool p_create_vi
 				texture = tex;
 			}
 			if (err != OK) {
+				if (preview_data.is_valid()) {
+					_restore_light_data();
+				}
 				if (bake_end_function) {
 					bake_end_function();
 				}
 				ERR_FAIL_COND_V(err != OK, BAKE_ERROR_CANT_CREATE_IMAGE);
 			}
 
+			if (btd.preview_instance.is_valid()) {
+				//keep showing the final lightmap until the bake is done, the preview texture goes away with btd
+				VS::get_singleton()->instance_set_use_lightmap(btd.preview_instance, get_instance(), texture->get_rid());
+			}
+
 			new_light_data->add_user(E->get().path, texture, E->get().instance_idx);
 		}
 	}
@@ -663,6 +717,18 @@ void BakedLightmap::_notification(int p_what) {
 	}
 }
 
+RID BakedLightmap::_get_user_instance(const NodePath &p_path, int p_instance_idx) {
+
+	Node *node = get_node(p_path);
+	if (p_instance_idx >= 0) {
+		return node->call("get_bake_mesh_instance", p_instance_idx);
+	}
+
+	VisualInstance *vi = Object::cast_to<VisualInstance>(node);
+	ERR_FAIL_COND_V(!vi, RID());
+	return vi->get_instance();
+}
+
 void BakedLightmap::_assign_lightmaps() {
 
 	ERR_FAIL_COND(!light_data.is_valid());
@@ -671,17 +737,9 @@ void BakedLightmap::_assign_lightmaps() {
 		Ref<Texture> lightmap = light_data->get_user_lightmap(i);
 		ERR_CONTINUE(!lightmap.is_valid());
 
-		Node *node = get_node(light_data->get_user_path(i));
-		int instance_idx = light_data->get_user_instance(i);
-		if (instance_idx >= 0) {
-			RID instance = node->call("get_bake_mesh_instance", instance_idx);
-			if (instance.is_valid()) {
-				VS::get_singleton()->instance_set_use_lightmap(instance, get_instance(), lightmap->get_rid());
-			}
-		} else {
-			VisualInstance *vi = Object::cast_to<VisualInstance>(node);
-			ERR_CONTINUE(!vi);
-			VS::get_singleton()->instance_set_use_lightmap(vi->get_instance(), get_instance(), lightmap->get_rid());
+		RID instance = _get_user_instance(light_data->get_user_path(i), light_data->get_user_instance(i));
+		if (instance.is_valid()) {
+			VS::get_singleton()->instance_set_use_lightmap(instance, get_instance(), lightmap->get_rid());
 		}
 	}
 }
@@ -689,21 +747,24 @@ void BakedLightmap::_assign_lightmaps() {
 void BakedLightmap::_clear_lightmaps() {
 	ERR_FAIL_COND(!light_data.is_valid());
 	for (int i = 0; i < light_data->get_user_count(); i++) {
-		Node *node = get_node(light_data->get_user_path(i));
-		int instance_idx = light_data->get_user_instance(i);
-		if (instance_idx >= 0) {
-			RID instance = node->call("get_bake_mesh_instance", instance_idx);
-			if (instance.is_valid()) {
-				VS::get_singleton()->instance_set_use_lightmap(instance, get_instance(), RID());
-			}
-		} else {
-			VisualInstance *vi = Object::cast_to<VisualInstance>(node);
-			ERR_CONTINUE(!vi);
-			VS::get_singleton()->instance_set_use_lightmap(vi->get_instance(), get_instance(), RID());
+		RID instance = _get_user_instance(light_data->get_user_path(i), light_data->get_user_instance(i));
+		if (instance.is_valid()) {
+			VS::get_singleton()->instance_set_use_lightmap(instance, get_instance(), RID());
 		}
 	}
 }
 
+void BakedLightmap::_restore_light_data() {
+
+	//changing the base drops the preview capture along with its users
+	if (light_data.is_valid()) {
+		set_base(light_data->get_rid());
+		_assign_lightmaps();
+	} else {
+		set_base(RID());
+	}
+}
+
 void BakedLightmap::set_light_data(const Ref<BakedLightmapData> &p_data) {
 
 	if (light_data.is_valid()) {
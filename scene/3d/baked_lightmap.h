@@ -34,6 +34,7 @@
 #include "multimesh_instance.h"
 #include "scene/3d/light.h"
 #include "scene/3d/visual_instance.h"
+#include "scene/3d/voxel_light_baker.h"
 
 class BakedLightmapData : public Resource {
 	GDCLASS(BakedLightmapData, Resource);
@@ -147,17 +148,25 @@ private:
 
 	void _debug_bake();
 
+	RID _get_user_instance(const NodePath &p_path, int p_instance_idx);
 	void _assign_lightmaps();
 	void _clear_lightmaps();
+	void _restore_light_data();
 
-	static bool _bake_time(void *ud, float p_secs, float p_progress);
+	Ref<Image> _get_lightmap_image(const VoxelLightBaker::LightMapData &p_lightmap, uint32_t *r_tex_flags) const;
 
 	struct BakeTimeData {
 		String text;
 		int pass;
 		uint64_t last_step;
+		BakedLightmap *owner;
+		RID preview_instance;
+		Ref<ImageTexture> preview_texture;
 	};
 
+	static bool _bake_time(void *ud, float p_secs, float p_progress);
+	static void _bake_preview(void *ud, const VoxelLightBaker::LightMapData &p_lightmap);
+
 protected:
 	static void _bind_methods();
 	void _notification(int p_what);
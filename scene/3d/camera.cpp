@@ -116,6 +116,12 @@ void Camera::_notification(int p_what) {
 			if (current || first_camera)
 				viewport->_camera_set(this);
 
+			if (get_tree()->is_physics_interpolation_enabled()) {
+				VisualServer::get_singleton()->camera_set_interpolated(camera, true);
+				VisualServer::get_singleton()->camera_set_transform(camera, get_camera_transform());
+				VisualServer::get_singleton()->camera_reset_physics_interpolation(camera);
+			}
+
 		} break;
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 
@@ -142,6 +148,13 @@ void Camera::_notification(int p_what) {
 			}
 
 		} break;
+		case NOTIFICATION_RESET_PHYSICS_INTERPOLATION: {
+
+			if (get_tree()->is_physics_interpolation_enabled()) {
+				VisualServer::get_singleton()->camera_set_transform(camera, get_camera_transform());
+				VisualServer::get_singleton()->camera_reset_physics_interpolation(camera);
+			}
+		} break;
 		case NOTIFICATION_BECAME_CURRENT: {
 			if (viewport) {
 				viewport->find_world()->_register_camera(this);
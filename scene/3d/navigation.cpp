@@ -30,6 +30,9 @@
 
 #include "navigation.h"
 
+#include "core/os/worker_thread_pool.h"
+#include "core/sort_array.h"
+
 #define USE_ENTRY_POINT
 
 void Navigation::_navmesh_link(int p_id) {
@@ -46,18 +49,47 @@ void Navigation::_navmesh_link(int p_id) {
 
 	PoolVector<Vector3>::Read r = vertices.read();
 
-	for (int i = 0; i < nm.navmesh->get_polygon_count(); i++) {
+	//polygons are connected through pointers, so they are allocated once and can't move
+	int pc = nm.navmesh->get_polygon_count();
+	int valid_count = 0;
+	for (int i = 0; i < pc; i++) {
 
-		//build
+		Vector<int> poly = nm.navmesh->get_polygon(i);
+		bool valid = true;
+		for (int j = 0; j < poly.size(); j++) {
+			if (poly[j] < 0 || poly[j] >= len) {
+				valid = false;
+				break;
+			}
+		}
+		ERR_CONTINUE(!valid);
+		valid_count++;
+	}
 
-		List<Polygon>::Element *P = nm.polygons.push_back(Polygon());
-		Polygon &p = P->get();
-		p.owner = &nm;
+	nm.polygons.resize(valid_count);
+	Polygon *polygons = nm.polygons.ptrw();
+	int polygon_count = 0;
+
+	for (int i = 0; i < pc; i++) {
+
+		//build
 
 		Vector<int> poly = nm.navmesh->get_polygon(i);
 		int plen = poly.size();
 		const int *indices = poly.ptr();
 		bool valid = true;
+		for (int j = 0; j < plen; j++) {
+			if (indices[j] < 0 || indices[j] >= len) {
+				valid = false;
+				break;
+			}
+		}
+
+		if (!valid)
+			continue;
+
+		Polygon &p = polygons[polygon_count++];
+		p.owner = &nm;
 		p.edges.resize(plen);
 
 		Vector3 center;
@@ -66,10 +98,6 @@ void Navigation::_navmesh_link(int p_id) {
 		for (int j = 0; j < plen; j++) {
 
 			int idx = indices[j];
-			if (idx < 0 || idx >= len) {
-				valid = false;
-				break;
-			}
 
 			Polygon::Edge e;
 			Vector3 ep = nm.xform.xform(r[idx]);
@@ -77,6 +105,12 @@ void Navigation::_navmesh_link(int p_id) {
 			e.point = _get_point(ep);
 			p.edges.write[j] = e;
 
+			if (j == 0) {
+				p.aabb.position = _get_vertex(e.point);
+			} else {
+				p.aabb.expand_to(_get_vertex(e.point));
+			}
+
 			if (j >= 2) {
 				Vector3 epa = nm.xform.xform(r[indices[j - 2]]);
 				Vector3 epb = nm.xform.xform(r[indices[j - 1]]);
@@ -87,11 +121,6 @@ void Navigation::_navmesh_link(int p_id) {
 
 		p.clockwise = sum > 0;
 
-		if (!valid) {
-			nm.polygons.pop_back();
-			ERR_CONTINUE(!valid);
-		}
-
 		p.center = center;
 		if (plen != 0) {
 			p.center /= plen;
@@ -135,6 +164,7 @@ void Navigation::_navmesh_link(int p_id) {
 	}
 
 	nm.linked = true;
+	index_dirty = true;
 }
 
 void Navigation::_navmesh_unlink(int p_id) {
@@ -143,9 +173,9 @@ void Navigation::_navmesh_unlink(int p_id) {
 	NavMesh &nm = navmesh_map[p_id];
 	ERR_FAIL_COND(!nm.linked);
 
-	for (List<Polygon>::Element *E = nm.polygons.front(); E; E = E->next()) {
+	for (int j = 0; j < nm.polygons.size(); j++) {
 
-		Polygon &p = E->get();
+		Polygon &p = nm.polygons.write[j];
 
 		int ec = p.edges.size();
 		Polygon::Edge *edges = p.edges.ptrw();
@@ -169,7 +199,7 @@ void Navigation::_navmesh_unlink(int p_id) {
 				C->get().A->edges.write[C->get().A_edge].C = NULL;
 				C->get().A->edges.write[C->get().A_edge].C_edge = -1;
 
-				if (C->get().A == &E->get()) {
+				if (C->get().A == &p) {
 
 					C->get().A = C->get().B;
 					C->get().A_edge = C->get().B_edge;
@@ -201,6 +231,7 @@ void Navigation::_navmesh_unlink(int p_id) {
 	nm.polygons.clear();
 
 	nm.linked = false;
+	index_dirty = true;
 }
 
 int Navigation::navmesh_add(const Ref<NavigationMesh> &p_mesh, const Transform &p_xform, Object *p_owner) {
@@ -235,7 +266,216 @@ void Navigation::navmesh_remove(int p_id) {
 	navmesh_map.erase(p_id);
 }
 
-void Navigation::_clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vector3 &p_to_point, Polygon *p_to_poly) {
+int Navigation::_create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int &max_alloc) {
+
+	if (p_size == 1) {
+
+		return p_bb[p_from] - p_bvh;
+	} else if (p_size == 0) {
+
+		return -1;
+	}
+
+	AABB aabb;
+	aabb = p_bb[p_from]->aabb;
+	for (int i = 1; i < p_size; i++) {
+
+		aabb.merge_with(p_bb[p_from + i]->aabb);
+	}
+
+	int li = aabb.get_longest_axis_index();
+
+	switch (li) {
+
+		case Vector3::AXIS_X: {
+			SortArray<BVH *, BVHCmpX> sort_x;
+			sort_x.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
+		} break;
+		case Vector3::AXIS_Y: {
+			SortArray<BVH *, BVHCmpY> sort_y;
+			sort_y.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
+		} break;
+		case Vector3::AXIS_Z: {
+			SortArray<BVH *, BVHCmpZ> sort_z;
+			sort_z.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
+		} break;
+	}
+
+	int left = _create_bvh(p_bvh, p_bb, p_from, p_size / 2, max_alloc);
+	int right = _create_bvh(p_bvh, p_bb, p_from + p_size / 2, p_size - p_size / 2, max_alloc);
+
+	int index = max_alloc++;
+	BVH *_new = &p_bvh[index];
+	_new->aabb = aabb;
+	_new->center = aabb.position + aabb.size * 0.5;
+	_new->polygon = -1;
+	_new->left = left;
+	_new->right = right;
+
+	return index;
+}
+
+void Navigation::_update_index() {
+
+	if (!index_dirty)
+		return;
+
+	MutexLock lock(index_mutex);
+
+	if (!index_dirty)
+		return; //another thread did it
+
+	polygon_index.clear();
+	for (Map<int, NavMesh>::Element *E = navmesh_map.front(); E; E = E->next()) {
+
+		if (!E->get().linked)
+			continue;
+
+		Polygon *polygons = E->get().polygons.ptrw();
+		for (int i = 0; i < E->get().polygons.size(); i++) {
+			polygons[i].index = polygon_index.size();
+			polygon_index.push_back(&polygons[i]);
+		}
+	}
+
+	int pc = polygon_index.size();
+	bvh.resize(pc * 2);
+	bvh_root = -1;
+
+	if (pc) {
+		BVH *bw = bvh.ptrw();
+		Vector<BVH *> bwptrs;
+		bwptrs.resize(pc);
+
+		for (int i = 0; i < pc; i++) {
+			bw[i].aabb = polygon_index[i]->aabb;
+			bw[i].center = bw[i].aabb.position + bw[i].aabb.size * 0.5;
+			bw[i].left = -1;
+			bw[i].right = -1;
+			bw[i].polygon = i;
+			bwptrs.write[i] = &bw[i];
+		}
+
+		int max_alloc = pc;
+		bvh_root = _create_bvh(bw, bwptrs.ptrw(), 0, pc, max_alloc);
+		bvh.resize(max_alloc);
+	}
+
+	index_dirty = false;
+}
+
+Navigation::Polygon *Navigation::_get_closest_polygon(const Vector3 &p_point, Vector3 *r_closest, Vector3 *r_normal) const {
+
+	if (bvh_root < 0)
+		return NULL;
+
+	Polygon *closest_poly = NULL;
+	float closest_d = 1e20;
+
+	const BVH *b = bvh.ptr();
+
+	static const int max_stack = 128;
+	int stack[max_stack];
+	int sp = 0;
+	stack[sp++] = bvh_root;
+
+	while (sp) {
+
+		const BVH &n = b[stack[--sp]];
+
+		//distance from the point to the box, nothing inside can be closer
+		Vector3 clamped = p_point;
+		for (int i = 0; i < 3; i++) {
+			clamped[i] = CLAMP(clamped[i], n.aabb.position[i], n.aabb.position[i] + n.aabb.size[i]);
+		}
+		if (clamped.distance_to(p_point) >= closest_d)
+			continue;
+
+		if (n.polygon >= 0) {
+
+			Polygon *p = polygon_index[n.polygon];
+			for (int i = 2; i < p->edges.size(); i++) {
+
+				Face3 f(_get_vertex(p->edges[0].point), _get_vertex(p->edges[i - 1].point), _get_vertex(p->edges[i].point));
+				Vector3 spoint = f.get_closest_point_to(p_point);
+				float d = spoint.distance_to(p_point);
+				if (d < closest_d) {
+					closest_d = d;
+					closest_poly = p;
+					if (r_closest) {
+						*r_closest = spoint;
+					}
+					if (r_normal) {
+						*r_normal = f.get_plane().normal;
+					}
+				}
+			}
+		} else {
+
+			ERR_CONTINUE(sp + 2 > max_stack);
+			//visit the closer child first, so the other one is more likely to be skipped
+			if (b[n.left].center.distance_squared_to(p_point) < b[n.right].center.distance_squared_to(p_point)) {
+				stack[sp++] = n.right;
+				stack[sp++] = n.left;
+			} else {
+				stack[sp++] = n.left;
+				stack[sp++] = n.right;
+			}
+		}
+	}
+
+	return closest_poly;
+}
+
+Navigation::PathQuery *Navigation::_query_acquire() {
+
+	PathQuery *query = NULL;
+
+	index_mutex->lock();
+	if (free_queries.size()) {
+		query = free_queries[free_queries.size() - 1];
+		free_queries.resize(free_queries.size() - 1);
+	}
+	index_mutex->unlock();
+
+	if (!query) {
+		query = memnew(PathQuery);
+		query->pass = 0;
+	}
+
+	int old_size = query->states.size();
+	if (old_size < polygon_index.size()) {
+		query->states.resize(polygon_index.size());
+		PathState *states = query->states.ptrw();
+		for (int i = old_size; i < polygon_index.size(); i++) {
+			states[i].open_pass = 0;
+			states[i].closed_pass = 0;
+		}
+	}
+
+	query->pass++;
+	if (query->pass == 0) {
+		//wrapped around, old stamps could look current
+		PathState *states = query->states.ptrw();
+		for (int i = 0; i < query->states.size(); i++) {
+			states[i].open_pass = 0;
+			states[i].closed_pass = 0;
+		}
+		query->pass = 1;
+	}
+
+	return query;
+}
+
+void Navigation::_query_release(PathQuery *p_query) {
+
+	p_query->open_list.clear();
+
+	MutexLock lock(index_mutex);
+	free_queries.push_back(p_query);
+}
+
+void Navigation::_clip_path(const PathQuery *p_query, Vector<Vector3> &path, Polygon *from_poly, const Vector3 &p_to_point, Polygon *p_to_poly) {
 
 	Vector3 from = path[path.size() - 1];
 
@@ -250,7 +490,7 @@ void Navigation::_clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vec
 
 	while (from_poly != p_to_poly) {
 
-		int pe = from_poly->prev_edge;
+		int pe = p_query->states[from_poly->index].prev_edge;
 		Vector3 a = _get_vertex(from_poly->edges[pe].point);
 		Vector3 b = _get_vertex(from_poly->edges[(pe + 1) % from_poly->edges.size()].point);
 
@@ -271,44 +511,72 @@ void Navigation::_clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vec
 
 Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector3 &p_end, bool p_optimize) {
 
-	Polygon *begin_poly = NULL;
-	Polygon *end_poly = NULL;
-	Vector3 begin_point;
-	Vector3 end_point;
-	float begin_d = 1e20;
-	float end_d = 1e20;
+	_update_index();
 
-	for (Map<int, NavMesh>::Element *E = navmesh_map.front(); E; E = E->next()) {
+	PathQuery *query = _query_acquire();
+	Vector<Vector3> path = _get_path(query, p_start, p_end, p_optimize);
+	_query_release(query);
 
-		if (!E->get().linked)
-			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
-
-			Polygon &p = F->get();
-			for (int i = 2; i < p.edges.size(); i++) {
-
-				Face3 f(_get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point));
-				Vector3 spoint = f.get_closest_point_to(p_start);
-				float dpoint = spoint.distance_to(p_start);
-				if (dpoint < begin_d) {
-					begin_d = dpoint;
-					begin_poly = &p;
-					begin_point = spoint;
-				}
+	return path;
+}
 
-				spoint = f.get_closest_point_to(p_end);
-				dpoint = spoint.distance_to(p_end);
-				if (dpoint < end_d) {
-					end_d = dpoint;
-					end_poly = &p;
-					end_point = spoint;
-				}
-			}
+void Navigation::_get_path_batch(uint32_t p_index, PathBatch *p_batch) {
+
+	PathQuery *query = _query_acquire();
+	p_batch->paths[p_index] = _get_path(query, p_batch->starts[p_index], p_batch->ends[p_index], p_batch->optimize);
+	_query_release(query);
+}
+
+Array Navigation::get_simple_paths(const PoolVector<Vector3> &p_starts, const PoolVector<Vector3> &p_ends, bool p_optimize) {
+
+	ERR_FAIL_COND_V(p_starts.size() != p_ends.size(), Array());
+
+	_update_index();
+
+	int count = p_starts.size();
+	Vector<Vector<Vector3> > paths;
+	paths.resize(count);
+
+	PathBatch batch;
+	batch.starts = p_starts.read();
+	batch.ends = p_ends.read();
+	batch.optimize = p_optimize;
+	batch.paths = paths.ptrw();
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && count > 1) {
+		pool->parallel_for(count, this, &Navigation::_get_path_batch, &batch);
+	} else {
+		for (int i = 0; i < count; i++) {
+			_get_path_batch(i, &batch);
+		}
+	}
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
 
-			p.prev_edge = -1;
+		PoolVector<Vector3> path;
+		path.resize(paths[i].size());
+		{
+			PoolVector<Vector3>::Write w = path.write();
+			for (int j = 0; j < paths[i].size(); j++) {
+				w[j] = paths[i][j];
+			}
 		}
+		ret[i] = path;
 	}
 
+	return ret;
+}
+
+Vector<Vector3> Navigation::_get_path(PathQuery *p_query, const Vector3 &p_start, const Vector3 &p_end, bool p_optimize) {
+
+	Vector3 begin_point;
+	Vector3 end_point;
+	Polygon *begin_poly = _get_closest_polygon(p_start, &begin_point, NULL);
+	Polygon *end_poly = _get_closest_polygon(p_end, &end_point, NULL);
+
 	if (!begin_poly || !end_poly) {
 
 		return Vector<Vector3>(); //no path
@@ -323,28 +591,54 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 		return path;
 	}
 
+	PathState *states = p_query->states.ptrw();
+	uint32_t pass = p_query->pass;
+
 	bool found_route = false;
 
-	List<Polygon *> open_list;
+	Vector<OpenPolygon> &open_list = p_query->open_list;
+	SortArray<OpenPolygon, SortOpenPolygons> sorter;
+
+	//the begin polygon is closed right away, so it's never entered again
+	states[begin_poly->index].closed_pass = pass;
+	states[begin_poly->index].open_pass = pass;
+	states[begin_poly->index].prev_edge = -1;
+	states[begin_poly->index].distance = 0;
+	states[begin_poly->index].entry = begin_point;
 
 	for (int i = 0; i < begin_poly->edges.size(); i++) {
 
-		if (begin_poly->edges[i].C) {
+		Polygon *c = begin_poly->edges[i].C;
+		if (c) {
 
-			begin_poly->edges[i].C->prev_edge = begin_poly->edges[i].C_edge;
+			PathState &cs = states[c->index];
+			cs.prev_edge = begin_poly->edges[i].C_edge;
 #ifdef USE_ENTRY_POINT
 			Vector3 edge[2] = {
 				_get_vertex(begin_poly->edges[i].point),
 				_get_vertex(begin_poly->edges[(i + 1) % begin_poly->edges.size()].point)
 			};
 
-			Vector3 entry = Geometry::get_closest_point_to_segment(begin_poly->entry, edge);
-			begin_poly->edges[i].C->distance = begin_point.distance_to(entry);
-			begin_poly->edges[i].C->entry = entry;
+			Vector3 entry = Geometry::get_closest_point_to_segment(begin_point, edge);
+			cs.distance = begin_point.distance_to(entry);
+			cs.entry = entry;
+#else
+			cs.distance = begin_poly->center.distance_to(c->center);
+#endif
+			if (cs.open_pass != pass) {
+				cs.open_pass = pass;
+				cs.closed_pass = 0;
+			}
+
+			OpenPolygon op;
+			op.polygon = c;
+#ifdef USE_ENTRY_POINT
+			op.cost = cs.distance + cs.entry.distance_to(end_point);
 #else
-			begin_poly->edges[i].C->distance = begin_poly->center.distance_to(begin_poly->edges[i].C->center);
+			op.cost = cs.distance + c->center.distance_to(end_point);
 #endif
-			open_list.push_back(begin_poly->edges[i].C);
+			open_list.push_back(op);
+			sorter.push_heap(0, open_list.size() - 1, 0, op, open_list.ptrw());
 		}
 	}
 
@@ -353,29 +647,18 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 		if (open_list.size() == 0) {
 			break;
 		}
-		//check open list
 
-		List<Polygon *>::Element *least_cost_poly = NULL;
-		float least_cost = 1e30;
+		//least cost polygon is on top of the heap
+		sorter.pop_heap(0, open_list.size(), open_list.ptrw());
+		Polygon *p = open_list[open_list.size() - 1].polygon;
+		open_list.resize(open_list.size() - 1);
 
-		//this could be faster (cache previous results)
-		for (List<Polygon *>::Element *E = open_list.front(); E; E = E->next()) {
+		PathState &ps = states[p->index];
+		if (ps.closed_pass == pass)
+			continue; //an outdated entry, was opened again with a lower cost
 
-			Polygon *p = E->get();
+		ps.closed_pass = pass;
 
-			float cost = p->distance;
-#ifdef USE_ENTRY_POINT
-			cost += p->entry.distance_to(end_point);
-#else
-			cost += p->center.distance_to(end_point);
-#endif
-			if (cost < least_cost) {
-				least_cost_poly = E;
-				least_cost = cost;
-			}
-		}
-
-		Polygon *p = least_cost_poly->get();
 		//open the neighbours for search
 
 		if (p == end_poly) {
@@ -386,47 +669,68 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 
 		for (int i = 0; i < p->edges.size(); i++) {
 
-			Polygon::Edge &e = p->edges.write[i];
+			const Polygon::Edge &e = p->edges[i];
 
 			if (!e.C)
 				continue;
 
+			PathState &cs = states[e.C->index];
+
 #ifdef USE_ENTRY_POINT
 			Vector3 edge[2] = {
 				_get_vertex(p->edges[i].point),
 				_get_vertex(p->edges[(i + 1) % p->edges.size()].point)
 			};
 
-			Vector3 entry = Geometry::get_closest_point_to_segment(p->entry, edge);
-			float distance = p->entry.distance_to(entry) + p->distance;
+			Vector3 entry = Geometry::get_closest_point_to_segment(ps.entry, edge);
+			float distance = ps.entry.distance_to(entry) + ps.distance;
 #else
-			float distance = p->center.distance_to(e.C->center) + p->distance;
+			float distance = p->center.distance_to(e.C->center) + ps.distance;
 #endif
 
-			if (e.C->prev_edge != -1) {
+			if (cs.open_pass == pass) {
 				//oh this was visited already, can we win the cost?
 
-				if (e.C->distance > distance) {
+				if (cs.distance > distance) {
 
-					e.C->prev_edge = e.C_edge;
-					e.C->distance = distance;
+					cs.prev_edge = e.C_edge;
+					cs.distance = distance;
 #ifdef USE_ENTRY_POINT
-					e.C->entry = entry;
+					cs.entry = entry;
 #endif
+					if (cs.closed_pass != pass) {
+						OpenPolygon op;
+						op.polygon = e.C;
+#ifdef USE_ENTRY_POINT
+						op.cost = distance + entry.distance_to(end_point);
+#else
+						op.cost = distance + e.C->center.distance_to(end_point);
+#endif
+						open_list.push_back(op);
+						sorter.push_heap(0, open_list.size() - 1, 0, op, open_list.ptrw());
+					}
 				}
 			} else {
 				//add to open neighbours
 
-				e.C->prev_edge = e.C_edge;
-				e.C->distance = distance;
+				cs.open_pass = pass;
+				cs.closed_pass = 0;
+				cs.prev_edge = e.C_edge;
+				cs.distance = distance;
 #ifdef USE_ENTRY_POINT
-				e.C->entry = entry;
+				cs.entry = entry;
+#endif
+				OpenPolygon op;
+				op.polygon = e.C;
+#ifdef USE_ENTRY_POINT
+				op.cost = distance + entry.distance_to(end_point);
+#else
+				op.cost = distance + e.C->center.distance_to(end_point);
 #endif
-				open_list.push_back(e.C);
+				open_list.push_back(op);
+				sorter.push_heap(0, open_list.size() - 1, 0, op, open_list.ptrw());
 			}
 		}
-
-		open_list.erase(least_cost_poly);
 	}
 
 	if (found_route) {
@@ -456,8 +760,8 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 					left = begin_point;
 					right = begin_point;
 				} else {
-					int prev = p->prev_edge;
-					int prev_n = (p->prev_edge + 1) % p->edges.size();
+					int prev = states[p->index].prev_edge;
+					int prev_n = (prev + 1) % p->edges.size();
 					left = _get_vertex(p->edges[prev].point);
 					right = _get_vertex(p->edges[prev_n].point);
 
@@ -476,7 +780,7 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 						portal_left = left;
 					} else {
 
-						_clip_path(path, apex_poly, portal_right, right_poly);
+						_clip_path(p_query, path, apex_poly, portal_right, right_poly);
 
 						apex_point = portal_right;
 						p = right_poly;
@@ -496,7 +800,7 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 						portal_right = right;
 					} else {
 
-						_clip_path(path, apex_poly, portal_left, left_poly);
+						_clip_path(p_query, path, apex_poly, portal_left, left_poly);
 
 						apex_point = portal_left;
 						p = left_poly;
@@ -509,7 +813,7 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 				}
 
 				if (p != begin_poly)
-					p = p->edges[p->prev_edge].C;
+					p = p->edges[states[p->index].prev_edge].C;
 				else
 					p = NULL;
 			}
@@ -525,11 +829,11 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 
 			path.push_back(end_point);
 			while (true) {
-				int prev = p->prev_edge;
+				int prev = states[p->index].prev_edge;
 #ifdef USE_ENTRY_POINT
-				Vector3 point = p->entry;
+				Vector3 point = states[p->index].entry;
 #else
-				int prev_n = (p->prev_edge + 1) % p->edges.size();
+				int prev_n = (prev + 1) % p->edges.size();
 				Vector3 point = (_get_vertex(p->edges[prev].point) + _get_vertex(p->edges[prev_n].point)) * 0.5;
 #endif
 				path.push_back(point);
@@ -555,45 +859,42 @@ Vector3 Navigation::get_closest_point_to_segment(const Vector3 &p_from, const Ve
 	Vector3 closest_point;
 	float closest_point_d = 1e20;
 
-	for (Map<int, NavMesh>::Element *E = navmesh_map.front(); E; E = E->next()) {
+	_update_index();
 
-		if (!E->get().linked)
-			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
+	for (int j = 0; j < polygon_index.size(); j++) {
 
-			Polygon &p = F->get();
-			for (int i = 2; i < p.edges.size(); i++) {
+		const Polygon &p = *polygon_index[j];
+		for (int i = 2; i < p.edges.size(); i++) {
 
-				Face3 f(_get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point));
-				Vector3 inters;
-				if (f.intersects_segment(p_from, p_to, &inters)) {
+			Face3 f(_get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point));
+			Vector3 inters;
+			if (f.intersects_segment(p_from, p_to, &inters)) {
 
-					if (!use_collision) {
-						closest_point = inters;
-						use_collision = true;
-						closest_point_d = p_from.distance_to(inters);
-					} else if (closest_point_d > inters.distance_to(p_from)) {
+				if (!use_collision) {
+					closest_point = inters;
+					use_collision = true;
+					closest_point_d = p_from.distance_to(inters);
+				} else if (closest_point_d > inters.distance_to(p_from)) {
 
-						closest_point = inters;
-						closest_point_d = p_from.distance_to(inters);
-					}
+					closest_point = inters;
+					closest_point_d = p_from.distance_to(inters);
 				}
 			}
+		}
 
-			if (!use_collision) {
+		if (!use_collision) {
 
-				for (int i = 0; i < p.edges.size(); i++) {
+			for (int i = 0; i < p.edges.size(); i++) {
 
-					Vector3 a, b;
+				Vector3 a, b;
 
-					Geometry::get_closest_points_between_segments(p_from, p_to, _get_vertex(p.edges[i].point), _get_vertex(p.edges[(i + 1) % p.edges.size()].point), a, b);
+				Geometry::get_closest_points_between_segments(p_from, p_to, _get_vertex(p.edges[i].point), _get_vertex(p.edges[(i + 1) % p.edges.size()].point), a, b);
 
-					float d = a.distance_to(b);
-					if (d < closest_point_d) {
+				float d = a.distance_to(b);
+				if (d < closest_point_d) {
 
-						closest_point_d = d;
-						closest_point = b;
-					}
+					closest_point_d = d;
+					closest_point = b;
 				}
 			}
 		}
@@ -604,90 +905,28 @@ Vector3 Navigation::get_closest_point_to_segment(const Vector3 &p_from, const Ve
 
 Vector3 Navigation::get_closest_point(const Vector3 &p_point) {
 
-	Vector3 closest_point;
-	float closest_point_d = 1e20;
-
-	for (Map<int, NavMesh>::Element *E = navmesh_map.front(); E; E = E->next()) {
-
-		if (!E->get().linked)
-			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
-
-			Polygon &p = F->get();
-			for (int i = 2; i < p.edges.size(); i++) {
-
-				Face3 f(_get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point));
-				Vector3 inters = f.get_closest_point_to(p_point);
-				float d = inters.distance_to(p_point);
-				if (d < closest_point_d) {
-					closest_point = inters;
-					closest_point_d = d;
-				}
-			}
-		}
-	}
+	_update_index();
 
+	Vector3 closest_point;
+	_get_closest_polygon(p_point, &closest_point, NULL);
 	return closest_point;
 }
 
 Vector3 Navigation::get_closest_point_normal(const Vector3 &p_point) {
 
-	Vector3 closest_point;
-	Vector3 closest_normal;
-	float closest_point_d = 1e20;
-
-	for (Map<int, NavMesh>::Element *E = navmesh_map.front(); E; E = E->next()) {
-
-		if (!E->get().linked)
-			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
-
-			Polygon &p = F->get();
-			for (int i = 2; i < p.edges.size(); i++) {
-
-				Face3 f(_get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point));
-				Vector3 inters = f.get_closest_point_to(p_point);
-				float d = inters.distance_to(p_point);
-				if (d < closest_point_d) {
-					closest_point = inters;
-					closest_point_d = d;
-					closest_normal = f.get_plane().normal;
-				}
-			}
-		}
-	}
+	_update_index();
 
+	Vector3 closest_normal;
+	_get_closest_polygon(p_point, NULL, &closest_normal);
 	return closest_normal;
 }
 
 Object *Navigation::get_closest_point_owner(const Vector3 &p_point) {
 
-	Vector3 closest_point;
-	Object *owner = NULL;
-	float closest_point_d = 1e20;
-
-	for (Map<int, NavMesh>::Element *E = navmesh_map.front(); E; E = E->next()) {
+	_update_index();
 
-		if (!E->get().linked)
-			continue;
-		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
-
-			Polygon &p = F->get();
-			for (int i = 2; i < p.edges.size(); i++) {
-
-				Face3 f(_get_vertex(p.edges[0].point), _get_vertex(p.edges[i - 1].point), _get_vertex(p.edges[i].point));
-				Vector3 inters = f.get_closest_point_to(p_point);
-				float d = inters.distance_to(p_point);
-				if (d < closest_point_d) {
-					closest_point = inters;
-					closest_point_d = d;
-					owner = E->get().owner;
-				}
-			}
-		}
-	}
-
-	return owner;
+	Polygon *p = _get_closest_polygon(p_point, NULL, NULL);
+	return p ? p->owner->owner : NULL;
 }
 
 void Navigation::set_up_vector(const Vector3 &p_up) {
@@ -707,6 +946,7 @@ void Navigation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("navmesh_remove", "id"), &Navigation::navmesh_remove);
 
 	ClassDB::bind_method(D_METHOD("get_simple_path", "start", "end", "optimize"), &Navigation::get_simple_path, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("get_simple_paths", "starts", "ends", "optimize"), &Navigation::get_simple_paths, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("get_closest_point_to_segment", "start", "end", "use_collision"), &Navigation::get_closest_point_to_segment, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_point"), &Navigation::get_closest_point);
 	ClassDB::bind_method(D_METHOD("get_closest_point_normal", "to_point"), &Navigation::get_closest_point_normal);
@@ -720,8 +960,21 @@ void Navigation::_bind_methods() {
 
 Navigation::Navigation() {
 
+	bvh_root = -1;
+	index_dirty = false;
+	index_mutex = Mutex::create();
+
 	ERR_FAIL_COND(sizeof(Point) != 8);
 	cell_size = 0.01; //one centimeter
 	last_id = 1;
 	up = Vector3(0, 1, 0);
 }
+
+Navigation::~Navigation() {
+
+	for (int i = 0; i < free_queries.size(); i++) {
+		memdelete(free_queries[i]);
+	}
+
+	memdelete(index_mutex);
+}
@@ -31,6 +31,7 @@
 #ifndef NAVIGATION_H
 #define NAVIGATION_H
 
+#include "core/os/mutex.h"
 #include "scene/3d/navigation_mesh.h"
 #include "scene/3d/spatial.h"
 
@@ -94,11 +95,10 @@ class Navigation : public Spatial {
 		Vector<Edge> edges;
 
 		Vector3 center;
-		Vector3 entry;
+		AABB aabb;
 
-		float distance;
-		int prev_edge;
 		bool clockwise;
+		int index; //in polygon_index
 
 		NavMesh *owner;
 	};
@@ -128,8 +128,94 @@ class Navigation : public Spatial {
 		Transform xform;
 		bool linked;
 		Ref<NavigationMesh> navmesh;
-		List<Polygon> polygons;
+		Vector<Polygon> polygons; //sized once when linking, edges point into it
+	};
+
+	/**
+	 * The polygons of all linked navmeshes are indexed by a BVH, rebuilt by the first query after
+	 * a change. Searches keep their state in a PathQuery instead of the polygons, so any number of
+	 * them can run at the same time, see get_simple_paths().
+	 */
+	struct BVH {
+
+		AABB aabb;
+		Vector3 center; //used for sorting
+		int left;
+		int right;
+
+		int polygon;
+	};
+
+	struct BVHCmpX {
+
+		bool operator()(const BVH *p_left, const BVH *p_right) const {
+
+			return p_left->center.x < p_right->center.x;
+		}
+	};
+
+	struct BVHCmpY {
+
+		bool operator()(const BVH *p_left, const BVH *p_right) const {
+
+			return p_left->center.y < p_right->center.y;
+		}
 	};
+	struct BVHCmpZ {
+
+		bool operator()(const BVH *p_left, const BVH *p_right) const {
+
+			return p_left->center.z < p_right->center.z;
+		}
+	};
+
+	struct PathState {
+		float distance;
+		int prev_edge;
+		Vector3 entry;
+		uint32_t open_pass;
+		uint32_t closed_pass;
+	};
+
+	struct OpenPolygon {
+		float cost;
+		Polygon *polygon;
+	};
+
+	struct SortOpenPolygons {
+		_FORCE_INLINE_ bool operator()(const OpenPolygon &A, const OpenPolygon &B) const { // true when A is worse than B
+			return A.cost > B.cost;
+		}
+	};
+
+	struct PathQuery {
+		Vector<PathState> states;
+		Vector<OpenPolygon> open_list;
+		uint32_t pass;
+	};
+
+	struct PathBatch {
+		PoolVector<Vector3>::Read starts;
+		PoolVector<Vector3>::Read ends;
+		bool optimize;
+		Vector<Vector3> *paths;
+	};
+
+	Vector<Polygon *> polygon_index;
+	Vector<BVH> bvh;
+	int bvh_root;
+	bool index_dirty;
+	Mutex *index_mutex;
+	Vector<PathQuery *> free_queries;
+
+	int _create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int &max_alloc);
+	void _update_index();
+	Polygon *_get_closest_polygon(const Vector3 &p_point, Vector3 *r_closest, Vector3 *r_normal) const;
+
+	PathQuery *_query_acquire();
+	void _query_release(PathQuery *p_query);
+	Vector<Vector3> _get_path(PathQuery *p_query, const Vector3 &p_start, const Vector3 &p_end, bool p_optimize);
+	void _get_path_batch(uint32_t p_index, PathBatch *p_batch);
 
 	_FORCE_INLINE_ Point _get_point(const Vector3 &p_pos) const {
 
@@ -158,7 +244,7 @@ class Navigation : public Spatial {
 	int last_id;
 
 	Vector3 up;
-	void _clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vector3 &p_to_point, Polygon *p_to_poly);
+	void _clip_path(const PathQuery *p_query, Vector<Vector3> &path, Polygon *from_poly, const Vector3 &p_to_point, Polygon *p_to_poly);
 
 protected:
 	static void _bind_methods();
@@ -173,12 +259,14 @@ public:
 	void navmesh_remove(int p_id);
 
 	Vector<Vector3> get_simple_path(const Vector3 &p_start, const Vector3 &p_end, bool p_optimize = true);
+	Array get_simple_paths(const PoolVector<Vector3> &p_starts, const PoolVector<Vector3> &p_ends, bool p_optimize = true);
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool &p_use_collision = false);
 	Vector3 get_closest_point(const Vector3 &p_point);
 	Vector3 get_closest_point_normal(const Vector3 &p_point);
 	Object *get_closest_point_owner(const Vector3 &p_point);
 
 	Navigation();
+	~Navigation();
 };
 
 #endif // NAVIGATION_H
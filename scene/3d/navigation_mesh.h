@@ -98,6 +98,7 @@ protected:
 	float verts_per_poly;
 	float detail_sample_distance;
 	float detail_sample_max_error;
+	int tile_size;
 
 	SamplePartitionType partition_type;
 	ParsedGeometryType parsed_geometry_type;
@@ -169,6 +170,9 @@ public:
 	void set_detail_sample_max_error(float p_value);
 	float get_detail_sample_max_error() const;
 
+	void set_tile_size(int p_value);
+	int get_tile_size() const;
+
 	void set_filter_low_hanging_obstacles(bool p_value);
 	bool get_filter_low_hanging_obstacles() const;
 
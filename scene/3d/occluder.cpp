@@ -0,0 +1,142 @@
+/*************************************************************************/
+/*  occluder.cpp                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "occluder.h"
+
+#include "core/core_string_names.h"
+#include "servers/visual_server.h"
+
+void Occluder::_update_visibility() {
+
+	if (!is_inside_tree())
+		return;
+
+	VS::get_singleton()->occluder_set_enabled(occluder, is_visible_in_tree());
+}
+
+void Occluder::_mesh_changed() {
+
+	PoolVector<Vector3> faces;
+
+	if (mesh.is_valid()) {
+
+		PoolVector<Face3> mesh_faces = mesh->get_faces();
+		faces.resize(mesh_faces.size() * 3);
+
+		PoolVector<Face3>::Read r = mesh_faces.read();
+		PoolVector<Vector3>::Write w = faces.write();
+		for (int i = 0; i < mesh_faces.size(); i++) {
+			for (int j = 0; j < 3; j++) {
+				w[i * 3 + j] = r[i].vertex[j];
+			}
+		}
+	}
+
+	VS::get_singleton()->occluder_set_faces(occluder, faces);
+	update_configuration_warning();
+}
+
+void Occluder::_notification(int p_what) {
+
+	switch (p_what) {
+
+		case NOTIFICATION_ENTER_WORLD: {
+
+			ERR_FAIL_COND(get_world().is_null());
+			VS::get_singleton()->occluder_set_scenario(occluder, get_world()->get_scenario());
+			VS::get_singleton()->occluder_set_transform(occluder, get_global_transform());
+			_update_visibility();
+		} break;
+		case NOTIFICATION_TRANSFORM_CHANGED: {
+
+			VS::get_singleton()->occluder_set_transform(occluder, get_global_transform());
+		} break;
+		case NOTIFICATION_EXIT_WORLD: {
+
+			VS::get_singleton()->occluder_set_scenario(occluder, RID());
+		} break;
+		case NOTIFICATION_VISIBILITY_CHANGED: {
+
+			_update_visibility();
+		} break;
+	}
+}
+
+void Occluder::set_mesh(const Ref<Mesh> &p_mesh) {
+
+	if (mesh == p_mesh)
+		return;
+
+	if (mesh.is_valid()) {
+		mesh->disconnect(CoreStringNames::get_singleton()->changed, this, "_mesh_changed");
+	}
+
+	mesh = p_mesh;
+
+	if (mesh.is_valid()) {
+		mesh->connect(CoreStringNames::get_singleton()->changed, this, "_mesh_changed");
+	}
+
+	_mesh_changed();
+}
+
+Ref<Mesh> Occluder::get_mesh() const {
+
+	return mesh;
+}
+
+String Occluder::get_configuration_warning() const {
+
+	if (mesh.is_null()) {
+		return TTR("A mesh must be set for this node to occlude anything.");
+	}
+
+	return String();
+}
+
+void Occluder::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("set_mesh", "mesh"), &Occluder::set_mesh);
+	ClassDB::bind_method(D_METHOD("get_mesh"), &Occluder::get_mesh);
+	ClassDB::bind_method(D_METHOD("_mesh_changed"), &Occluder::_mesh_changed);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "mesh", PROPERTY_HINT_RESOURCE_TYPE, "Mesh"), "set_mesh", "get_mesh");
+}
+
+Occluder::Occluder() {
+
+	occluder = VS::get_singleton()->occluder_create();
+	set_notify_transform(true);
+}
+
+Occluder::~Occluder() {
+
+	VS::get_singleton()->free(occluder);
+}
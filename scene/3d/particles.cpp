@@ -238,6 +238,33 @@ bool Particles::get_fractional_delta() const {
 	return fractional_delta;
 }
 
+void Particles::set_collision_heightfield(const Ref<Texture> &p_texture) {
+	collision_heightfield = p_texture;
+	VS::get_singleton()->particles_set_collision_heightfield(particles, collision_heightfield.is_valid() ? collision_heightfield->get_rid() : RID(), collision_aabb);
+}
+
+Ref<Texture> Particles::get_collision_heightfield() const {
+	return collision_heightfield;
+}
+
+void Particles::set_collision_aabb(const AABB &p_aabb) {
+	collision_aabb = p_aabb;
+	VS::get_singleton()->particles_set_collision_heightfield(particles, collision_heightfield.is_valid() ? collision_heightfield->get_rid() : RID(), collision_aabb);
+}
+
+AABB Particles::get_collision_aabb() const {
+	return collision_aabb;
+}
+
+void Particles::set_collision_bounce(float p_bounce) {
+	collision_bounce = p_bounce;
+	VS::get_singleton()->particles_set_collision_bounce(particles, p_bounce);
+}
+
+float Particles::get_collision_bounce() const {
+	return collision_bounce;
+}
+
 String Particles::get_configuration_warning() const {
 
 	if (OS::get_singleton()->get_current_video_driver() == OS::VIDEO_DRIVER_GLES2) {
@@ -374,6 +401,13 @@ void Particles::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_draw_order"), &Particles::get_draw_order);
 
+	ClassDB::bind_method(D_METHOD("set_collision_heightfield", "texture"), &Particles::set_collision_heightfield);
+	ClassDB::bind_method(D_METHOD("get_collision_heightfield"), &Particles::get_collision_heightfield);
+	ClassDB::bind_method(D_METHOD("set_collision_aabb", "aabb"), &Particles::set_collision_aabb);
+	ClassDB::bind_method(D_METHOD("get_collision_aabb"), &Particles::get_collision_aabb);
+	ClassDB::bind_method(D_METHOD("set_collision_bounce", "bounce"), &Particles::set_collision_bounce);
+	ClassDB::bind_method(D_METHOD("get_collision_bounce"), &Particles::get_collision_bounce);
+
 	ClassDB::bind_method(D_METHOD("set_draw_passes", "passes"), &Particles::set_draw_passes);
 	ClassDB::bind_method(D_METHOD("set_draw_pass_mesh", "pass", "mesh"), &Particles::set_draw_pass_mesh);
 
@@ -400,6 +434,10 @@ void Particles::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "draw_order", PROPERTY_HINT_ENUM, "Index,Lifetime,View Depth"), "set_draw_order", "get_draw_order");
 	ADD_GROUP("Process Material", "");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "process_material", PROPERTY_HINT_RESOURCE_TYPE, "ShaderMaterial,ParticlesMaterial"), "set_process_material", "get_process_material");
+	ADD_GROUP("Collision", "collision_");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "collision_heightfield", PROPERTY_HINT_RESOURCE_TYPE, "Texture"), "set_collision_heightfield", "get_collision_heightfield");
+	ADD_PROPERTY(PropertyInfo(Variant::AABB, "collision_aabb"), "set_collision_aabb", "get_collision_aabb");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "collision_bounce", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_collision_bounce", "get_collision_bounce");
 	ADD_GROUP("Draw Passes", "draw_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "draw_passes", PROPERTY_HINT_RANGE, "0," + itos(MAX_DRAW_PASSES) + ",1"), "set_draw_passes", "get_draw_passes");
 	for (int i = 0; i < MAX_DRAW_PASSES; i++) {
@@ -433,6 +471,8 @@ Particles::Particles() {
 	set_draw_passes(1);
 	set_draw_order(DRAW_ORDER_INDEX);
 	set_speed_scale(1);
+	set_collision_aabb(AABB(Vector3(-4, -4, -4), Vector3(8, 8, 8)));
+	set_collision_bounce(0);
 }
 
 Particles::~Particles() {
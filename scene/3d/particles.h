@@ -67,6 +67,10 @@ private:
 
 	Ref<Material> process_material;
 
+	Ref<Texture> collision_heightfield;
+	AABB collision_aabb;
+	float collision_bounce;
+
 	DrawOrder draw_order;
 
 	Vector<Ref<Mesh> > draw_passes;
@@ -110,6 +114,15 @@ public:
 	void set_fractional_delta(bool p_enable);
 	bool get_fractional_delta() const;
 
+	void set_collision_heightfield(const Ref<Texture> &p_texture);
+	Ref<Texture> get_collision_heightfield() const;
+
+	void set_collision_aabb(const AABB &p_aabb);
+	AABB get_collision_aabb() const;
+
+	void set_collision_bounce(float p_bounce);
+	float get_collision_bounce() const;
+
 	void set_draw_order(DrawOrder p_order);
 	DrawOrder get_draw_order() const;
 
@@ -234,10 +234,20 @@ void Skeleton::_notification(int p_what) {
 
 			const int *order = process_order.ptr();
 
+			// unless everything changed, only recompute dirty bones and their children
+			bool full_update = all_bones_dirty;
+			bool overrides_reset = false;
+
 			for (int i = 0; i < len; i++) {
 
 				Bone &b = bonesptr[order[i]];
 
+				if (!full_update && !b.pose_dirty) {
+					if (b.parent < 0 || !bonesptr[b.parent].pose_dirty)
+						continue;
+				}
+				b.pose_dirty = true;
+
 				if (b.global_pose_override_amount >= 0.999) {
 					b.pose_global = b.global_pose_override;
 				} else {
@@ -298,6 +308,8 @@ void Skeleton::_notification(int p_what) {
 				}
 
 				if (b.global_pose_override_reset) {
+					if (b.global_pose_override_amount != 0.0)
+						overrides_reset = true;
 					b.global_pose_override_amount = 0.0;
 				}
 
@@ -311,25 +323,47 @@ void Skeleton::_notification(int p_what) {
 				}
 			}
 
-			//update skins
-			for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+			//update skins, unless nothing is ever drawn
+			if (!vs->is_headless()) {
+				for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+
+					SkinReference *skin_ref = E->get();
+					const Skin *skin = skin_ref->skin.operator->();
+					RID skeleton = skin_ref->skeleton;
+					uint32_t bind_count = skin->get_bind_count();
+					bool full_skin_update = full_update;
+
+					if (skin_ref->bind_count != bind_count) {
+						VS::get_singleton()->skeleton_allocate(skeleton, bind_count);
+						skin_ref->bind_count = bind_count;
+						skin_ref->bind_transforms.resize(bind_count);
+						full_skin_update = true;
+					}
 
-				const Skin *skin = E->get()->skin.operator->();
-				RID skeleton = E->get()->skeleton;
-				uint32_t bind_count = skin->get_bind_count();
+					Transform *bind_transforms = skin_ref->bind_transforms.ptrw();
+					bool changed = false;
 
-				if (E->get()->bind_count != bind_count) {
-					VS::get_singleton()->skeleton_allocate(skeleton, bind_count);
-					E->get()->bind_count = bind_count;
-				}
+					for (uint32_t i = 0; i < bind_count; i++) {
+						uint32_t bone_index = skin->get_bind_bone(i);
+						ERR_CONTINUE(bone_index >= (uint32_t)len);
+						if (!full_skin_update && !bonesptr[bone_index].pose_dirty)
+							continue;
+						bind_transforms[i] = bonesptr[bone_index].pose_global * skin->get_bind_pose(i);
+						changed = true;
+					}
 
-				for (uint32_t i = 0; i < bind_count; i++) {
-					uint32_t bone_index = skin->get_bind_bone(i);
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					vs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
+					if (changed) {
+						vs->skeleton_set_bone_transforms(skeleton, skin_ref->bind_transforms);
+					}
 				}
 			}
 
+			for (int i = 0; i < len; i++) {
+				bonesptr[i].pose_dirty = false;
+			}
+
+			// bones that stopped being overridden must be recomputed on the next update
+			all_bones_dirty = overrides_reset;
 			dirty = false;
 		} break;
 	}
@@ -341,7 +375,7 @@ void Skeleton::set_bone_global_pose_override(int p_bone, const Transform &p_pose
 	bones.write[p_bone].global_pose_override_amount = p_amount;
 	bones.write[p_bone].global_pose_override = p_pose;
 	bones.write[p_bone].global_pose_override_reset = !p_persistent;
-	_make_dirty();
+	_make_bone_dirty(p_bone);
 }
 
 Transform Skeleton::get_bone_global_pose(int p_bone) const {
@@ -436,6 +470,7 @@ void Skeleton::set_bone_disable_rest(int p_bone, bool p_disable) {
 
 	ERR_FAIL_INDEX(p_bone, bones.size());
 	bones.write[p_bone].disable_rest = p_disable;
+	_make_bone_dirty(p_bone);
 }
 
 bool Skeleton::is_bone_rest_disabled(int p_bone) const {
@@ -456,7 +491,7 @@ void Skeleton::set_bone_rest(int p_bone, const Transform &p_rest) {
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
 	bones.write[p_bone].rest = p_rest;
-	_make_dirty();
+	_make_bone_dirty(p_bone);
 }
 Transform Skeleton::get_bone_rest(int p_bone) const {
 
@@ -470,7 +505,7 @@ void Skeleton::set_bone_enabled(int p_bone, bool p_enabled) {
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
 	bones.write[p_bone].enabled = p_enabled;
-	_make_dirty();
+	_make_bone_dirty(p_bone);
 }
 bool Skeleton::is_bone_enabled(int p_bone) const {
 
@@ -492,6 +527,7 @@ void Skeleton::bind_child_node_to_bone(int p_bone, Node *p_node) {
 	}
 
 	bones.write[p_bone].nodes_bound.push_back(id);
+	_make_bone_dirty(p_bone);
 }
 void Skeleton::unbind_child_node_from_bone(int p_bone, Node *p_node) {
 
@@ -528,8 +564,9 @@ void Skeleton::set_bone_pose(int p_bone, const Transform &p_pose) {
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
 	bones.write[p_bone].pose = p_pose;
+	bones.write[p_bone].pose_dirty = true;
 	if (is_inside_tree()) {
-		_make_dirty();
+		_make_bone_dirty(p_bone);
 	}
 }
 Transform Skeleton::get_bone_pose(int p_bone) const {
@@ -546,7 +583,7 @@ void Skeleton::set_bone_custom_pose(int p_bone, const Transform &p_custom_pose)
 	bones.write[p_bone].custom_pose_enable = (p_custom_pose != Transform());
 	bones.write[p_bone].custom_pose = p_custom_pose;
 
-	_make_dirty();
+	_make_bone_dirty(p_bone);
 }
 
 Transform Skeleton::get_bone_custom_pose(int p_bone) const {
@@ -555,8 +592,21 @@ Transform Skeleton::get_bone_custom_pose(int p_bone) const {
 	return bones[p_bone].custom_pose;
 }
 
+void Skeleton::_make_bone_dirty(int p_bone) {
+
+	bones.write[p_bone].pose_dirty = true;
+
+	if (dirty)
+		return;
+
+	MessageQueue::get_singleton()->push_notification(this, NOTIFICATION_UPDATE_SKELETON);
+	dirty = true;
+}
+
 void Skeleton::_make_dirty() {
 
+	all_bones_dirty = true;
+
 	if (dirty)
 		return;
 
@@ -849,6 +899,7 @@ void Skeleton::_bind_methods() {
 Skeleton::Skeleton() {
 
 	dirty = false;
+	all_bones_dirty = true;
 	process_order_dirty = true;
 }
 
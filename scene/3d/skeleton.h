@@ -51,6 +51,7 @@ class SkinReference : public Reference {
 	RID skeleton;
 	Ref<Skin> skin;
 	uint32_t bind_count = 0;
+	Vector<Transform> bind_transforms; //last uploaded, only changed binds are recomputed
 	void _skin_changed();
 
 protected:
@@ -101,9 +102,12 @@ private:
 
 		List<uint32_t> nodes_bound;
 
+		bool pose_dirty; //pose_global needs updating, also set on the children while updating
+
 		Bone() {
 			parent = -1;
 			enabled = true;
+			pose_dirty = true;
 			disable_rest = false;
 			custom_pose_enable = false;
 			global_pose_override_amount = 0;
@@ -120,7 +124,9 @@ private:
 	bool process_order_dirty;
 
 	void _make_dirty();
+	void _make_bone_dirty(int p_bone);
 	bool dirty;
+	bool all_bones_dirty;
 
 	// bind helpers
 	Array _get_bound_child_nodes_to_bone(int p_bone) const {
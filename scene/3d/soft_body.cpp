@@ -88,6 +88,31 @@ void SoftBodyVisualServerHandler::set_normal(int p_vertex_id, const void *p_vect
 	copymem(&write_buffer[p_vertex_id * stride + offset_normal], p_vector3, sizeof(float) * 3);
 }
 
+void SoftBodyVisualServerHandler::set_vertices(const Vector3 *p_vertices, const Vector3 *p_normals, const int *p_vertex_map, int p_vertex_count) {
+	ERR_FAIL_COND(p_vertex_count * stride > (uint32_t)buffer.size());
+
+	uint8_t *dst_vertices = write_buffer.ptr() + offset_vertices;
+	uint8_t *dst_normals = write_buffer.ptr() + offset_normal;
+
+	for (int i = 0; i < p_vertex_count; ++i) {
+		const Vector3 &vertex = p_vertices[p_vertex_map[i]];
+		const Vector3 &normal = p_normals[p_vertex_map[i]];
+
+		float *v = reinterpret_cast<float *>(dst_vertices);
+		v[0] = vertex.x;
+		v[1] = vertex.y;
+		v[2] = vertex.z;
+
+		float *n = reinterpret_cast<float *>(dst_normals);
+		n[0] = normal.x;
+		n[1] = normal.y;
+		n[2] = normal.z;
+
+		dst_vertices += stride;
+		dst_normals += stride;
+	}
+}
+
 void SoftBodyVisualServerHandler::set_aabb(const AABB &p_aabb) {
 	VS::get_singleton()->mesh_set_custom_aabb(mesh, p_aabb);
 }
@@ -60,6 +60,8 @@ private:
 public:
 	void set_vertex(int p_vertex_id, const void *p_vector3);
 	void set_normal(int p_vertex_id, const void *p_vector3);
+	// Writes the position and normal of every surface vertex, p_vertex_map gives the source of each one.
+	void set_vertices(const Vector3 *p_vertices, const Vector3 *p_normals, const int *p_vertex_map, int p_vertex_count);
 	void set_aabb(const AABB &p_aabb);
 };
 
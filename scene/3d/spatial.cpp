@@ -85,6 +85,13 @@ void Spatial::_notify_dirty() {
 	}
 }
 
+void Spatial::_xform_change_eligibility_changed() {
+
+	//subtrees invalidated before may now skip nodes that would be queued
+	if (is_inside_tree())
+		get_tree()->xform_change_version++;
+}
+
 void Spatial::_update_local_transform() const {
 	data.local_transform.basis.set_euler_scale(data.rotation, data.scale);
 
@@ -96,10 +103,9 @@ void Spatial::_propagate_transform_changed(Spatial *p_origin) {
 		return;
 	}
 
-	/*
-	if (data.dirty&DIRTY_GLOBAL)
-		return; //already dirty
-	*/
+	//the whole subtree is still dirty and queued since it was last invalidated, nothing changed below
+	if ((data.dirty & DIRTY_GLOBAL) && data.propagated_version == get_tree()->xform_change_version)
+		return;
 
 	data.children_lock++;
 
@@ -117,6 +123,7 @@ void Spatial::_propagate_transform_changed(Spatial *p_origin) {
 		get_tree()->xform_change_list.add(&xform_change);
 	}
 	data.dirty |= DIRTY_GLOBAL;
+	data.propagated_version = get_tree()->xform_change_version;
 
 	data.children_lock--;
 }
@@ -156,6 +163,7 @@ void Spatial::_notification(int p_what) {
 			notification(NOTIFICATION_EXIT_WORLD, true);
 			if (xform_change.in_list())
 				get_tree()->xform_change_list.remove(&xform_change);
+			get_tree()->xform_change_version++;
 			if (data.C)
 				data.parent->data.children.erase(data.C);
 			data.parent = NULL;
@@ -426,6 +434,7 @@ void Spatial::set_gizmo(const Ref<SpatialGizmo> &p_gizmo) {
 	if (data.gizmo.is_valid() && is_inside_world())
 		data.gizmo->free();
 	data.gizmo = p_gizmo;
+	_xform_change_eligibility_changed();
 	if (data.gizmo.is_valid() && is_inside_world()) {
 
 		data.gizmo->create();
@@ -496,6 +505,7 @@ void Spatial::set_as_toplevel(bool p_enabled) {
 
 		data.toplevel = p_enabled;
 		data.toplevel_active = p_enabled;
+		_xform_change_eligibility_changed();
 
 	} else {
 		data.toplevel = p_enabled;
@@ -544,7 +554,9 @@ void Spatial::show() {
 	if (!is_inside_tree())
 		return;
 
+	get_tree()->begin_instance_batch();
 	_propagate_visibility_changed();
+	get_tree()->end_instance_batch();
 }
 
 void Spatial::hide() {
@@ -557,7 +569,9 @@ void Spatial::hide() {
 	if (!is_inside_tree())
 		return;
 
+	get_tree()->begin_instance_batch();
 	_propagate_visibility_changed();
+	get_tree()->end_instance_batch();
 }
 
 bool Spatial::is_visible_in_tree() const {
@@ -712,6 +726,7 @@ Vector3 Spatial::to_global(Vector3 p_local) const {
 
 void Spatial::set_notify_transform(bool p_enable) {
 	data.notify_transform = p_enable;
+	_xform_change_eligibility_changed();
 }
 
 bool Spatial::is_transform_notification_enabled() const {
@@ -732,10 +747,19 @@ void Spatial::force_update_transform() {
 		return; //nothing to update
 	}
 	get_tree()->xform_change_list.remove(&xform_change);
+	get_tree()->xform_change_version++;
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
 
+void Spatial::reset_physics_interpolation() {
+
+	// Children follow this node, so a teleport must stop blending them as well.
+	if (is_inside_tree()) {
+		propagate_notification(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
+	}
+}
+
 void Spatial::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_transform", "local"), &Spatial::set_transform);
@@ -759,6 +783,7 @@ void Spatial::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_world"), &Spatial::get_world);
 
 	ClassDB::bind_method(D_METHOD("force_update_transform"), &Spatial::force_update_transform);
+	ClassDB::bind_method(D_METHOD("reset_physics_interpolation"), &Spatial::reset_physics_interpolation);
 
 	ClassDB::bind_method(D_METHOD("_update_gizmo"), &Spatial::_update_gizmo);
 
@@ -802,6 +827,7 @@ void Spatial::_bind_methods() {
 	BIND_CONSTANT(NOTIFICATION_ENTER_WORLD);
 	BIND_CONSTANT(NOTIFICATION_EXIT_WORLD);
 	BIND_CONSTANT(NOTIFICATION_VISIBILITY_CHANGED);
+	BIND_CONSTANT(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
 
 	//ADD_PROPERTY( PropertyInfo(Variant::TRANSFORM,"transform/global",PROPERTY_HINT_NONE, "", PROPERTY_USAGE_EDITOR ), "set_global_transform", "get_global_transform") ;
 	ADD_GROUP("Transform", "");
@@ -823,6 +849,7 @@ Spatial::Spatial() :
 		xform_change(this) {
 
 	data.dirty = DIRTY_NONE;
+	data.propagated_version = 0;
 	data.children_lock = 0;
 
 	data.ignore_notification = false;
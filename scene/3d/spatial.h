@@ -71,6 +71,7 @@ class Spatial : public Node {
 		mutable Vector3 scale;
 
 		mutable int dirty;
+		uint64_t propagated_version; //SceneTree::xform_change_version when the subtree was last invalidated
 
 		Viewport *viewport;
 
@@ -100,12 +101,16 @@ class Spatial : public Node {
 
 	void _update_gizmo();
 	void _notify_dirty();
+	void _xform_change_eligibility_changed();
 	void _propagate_transform_changed(Spatial *p_origin);
 
 	void _propagate_visibility_changed();
 
 protected:
-	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) { data.ignore_notification = p_ignore; }
+	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) {
+		data.ignore_notification = p_ignore;
+		_xform_change_eligibility_changed();
+	}
 
 	_FORCE_INLINE_ void _update_local_transform() const;
 
@@ -120,6 +125,7 @@ public:
 		NOTIFICATION_EXIT_WORLD = 42,
 		NOTIFICATION_VISIBILITY_CHANGED = 43,
 		NOTIFICATION_LOCAL_TRANSFORM_CHANGED = 44,
+		NOTIFICATION_RESET_PHYSICS_INTERPOLATION = 45,
 	};
 
 	Spatial *get_parent_spatial() const;
@@ -200,6 +206,8 @@ public:
 
 	void force_update_transform();
 
+	void reset_physics_interpolation();
+
 	Spatial();
 	~Spatial();
 };
@@ -37,7 +37,7 @@ class SpringArm : public Spatial {
 	GDCLASS(SpringArm, Spatial);
 
 	Ref<Shape> shape;
-	Set<RID> excluded_objects;
+	BTreeSet<RID> excluded_objects;
 	float spring_length;
 	float current_spring_length;
 	bool keep_child_basis;
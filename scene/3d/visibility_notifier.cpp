@@ -67,9 +67,7 @@ void VisibilityNotifier::set_aabb(const AABB &p_aabb) {
 		return;
 	aabb = p_aabb;
 
-	if (is_inside_world()) {
-		get_world()->_update_notifier(this, get_global_transform().xform(aabb));
-	}
+	VS::get_singleton()->visibility_notifier_set_aabb(base, aabb);
 
 	_change_notify("aabb");
 	update_gizmo();
@@ -85,14 +83,17 @@ void VisibilityNotifier::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_ENTER_WORLD: {
 
-			get_world()->_register_notifier(this, get_global_transform().xform(aabb));
+			VS::get_singleton()->instance_set_scenario(instance, get_world()->get_scenario());
+			VS::get_singleton()->instance_set_transform(instance, get_global_transform());
+			get_world()->_register_notifier(this);
 		} break;
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 
-			get_world()->_update_notifier(this, get_global_transform().xform(aabb));
+			VS::get_singleton()->instance_set_transform(instance, get_global_transform());
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 
+			VS::get_singleton()->instance_set_scenario(instance, RID());
 			get_world()->_remove_notifier(this);
 		} break;
 	}
@@ -121,6 +122,18 @@ VisibilityNotifier::VisibilityNotifier() {
 
 	aabb = AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2));
 	set_notify_transform(true);
+
+	base = VS::get_singleton()->visibility_notifier_create();
+	VS::get_singleton()->visibility_notifier_set_aabb(base, aabb);
+	instance = VS::get_singleton()->instance_create();
+	VS::get_singleton()->instance_attach_object_instance_id(instance, get_instance_id());
+	VS::get_singleton()->instance_set_base(instance, base);
+}
+
+VisibilityNotifier::~VisibilityNotifier() {
+
+	VS::get_singleton()->free(instance);
+	VS::get_singleton()->free(base);
 }
 
 //////////////////////////////////////
@@ -132,6 +145,11 @@ void VisibilityEnabler::_screen_enter() {
 		_change_node_state(E->key(), true);
 	}
 
+	if (enabler[ENABLER_PARENT_PHYSICS_PROCESS] && get_parent())
+		get_parent()->set_physics_process(true);
+	if (enabler[ENABLER_PARENT_PROCESS] && get_parent())
+		get_parent()->set_process(true);
+
 	visible = true;
 }
 
@@ -142,6 +160,11 @@ void VisibilityEnabler::_screen_exit() {
 		_change_node_state(E->key(), false);
 	}
 
+	if (enabler[ENABLER_PARENT_PHYSICS_PROCESS] && get_parent())
+		get_parent()->set_physics_process(false);
+	if (enabler[ENABLER_PARENT_PROCESS] && get_parent())
+		get_parent()->set_process(false);
+
 	visible = false;
 }
 
@@ -197,6 +220,11 @@ void VisibilityEnabler::_notification(int p_what) {
 			from = from->get_parent();
 
 		_find_nodes(from);
+
+		if (enabler[ENABLER_PARENT_PHYSICS_PROCESS] && get_parent())
+			get_parent()->set_physics_process(false);
+		if (enabler[ENABLER_PARENT_PROCESS] && get_parent())
+			get_parent()->set_process(false);
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
@@ -251,9 +279,13 @@ void VisibilityEnabler::_bind_methods() {
 
 	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "pause_animations"), "set_enabler", "is_enabler_enabled", ENABLER_PAUSE_ANIMATIONS);
 	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "freeze_bodies"), "set_enabler", "is_enabler_enabled", ENABLER_FREEZE_BODIES);
+	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "process_parent"), "set_enabler", "is_enabler_enabled", ENABLER_PARENT_PROCESS);
+	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "physics_process_parent"), "set_enabler", "is_enabler_enabled", ENABLER_PARENT_PHYSICS_PROCESS);
 
 	BIND_ENUM_CONSTANT(ENABLER_PAUSE_ANIMATIONS);
 	BIND_ENUM_CONSTANT(ENABLER_FREEZE_BODIES);
+	BIND_ENUM_CONSTANT(ENABLER_PARENT_PROCESS);
+	BIND_ENUM_CONSTANT(ENABLER_PARENT_PHYSICS_PROCESS);
 	BIND_ENUM_CONSTANT(ENABLER_MAX);
 }
 
@@ -272,6 +304,8 @@ VisibilityEnabler::VisibilityEnabler() {
 
 	for (int i = 0; i < ENABLER_MAX; i++)
 		enabler[i] = true;
+	enabler[ENABLER_PARENT_PROCESS] = false;
+	enabler[ENABLER_PARENT_PHYSICS_PROCESS] = false;
 
 	visible = false;
 }
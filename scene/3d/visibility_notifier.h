@@ -42,6 +42,10 @@ class VisibilityNotifier : public Spatial {
 
 	AABB aabb;
 
+	// Visibility is tested by VisualServer while it culls, through an instance of this base.
+	RID base;
+	RID instance;
+
 protected:
 	virtual void _screen_enter() {}
 	virtual void _screen_exit() {}
@@ -59,6 +63,7 @@ public:
 	bool is_on_screen() const;
 
 	VisibilityNotifier();
+	~VisibilityNotifier();
 };
 
 class VisibilityEnabler : public VisibilityNotifier {
@@ -69,6 +74,8 @@ public:
 	enum Enabler {
 		ENABLER_PAUSE_ANIMATIONS,
 		ENABLER_FREEZE_BODIES,
+		ENABLER_PARENT_PROCESS,
+		ENABLER_PARENT_PHYSICS_PROCESS,
 		ENABLER_MAX
 	};
 
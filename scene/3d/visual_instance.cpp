@@ -45,7 +45,7 @@ void VisualInstance::_update_visibility() {
 		return;
 
 	_change_notify("visible");
-	VS::get_singleton()->instance_set_visible(get_instance(), is_visible_in_tree());
+	get_tree()->queue_instance_visible(get_instance(), is_visible_in_tree());
 }
 
 void VisualInstance::_notification(int p_what) {
@@ -64,11 +64,17 @@ void VisualInstance::_notification(int p_what) {
 			VisualServer::get_singleton()->instance_set_scenario(instance, get_world()->get_scenario());
 			_update_visibility();
 
+			if (get_tree()->is_physics_interpolation_enabled()) {
+				VisualServer::get_singleton()->instance_set_interpolated(instance, true);
+				VisualServer::get_singleton()->instance_set_transform(instance, get_global_transform());
+				VisualServer::get_singleton()->instance_reset_physics_interpolation(instance);
+			}
+
 		} break;
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 
 			Transform gt = get_global_transform();
-			VisualServer::get_singleton()->instance_set_transform(instance, gt);
+			get_tree()->queue_instance_transform(instance, gt);
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 
@@ -81,6 +87,13 @@ void VisualInstance::_notification(int p_what) {
 
 			_update_visibility();
 		} break;
+		case NOTIFICATION_RESET_PHYSICS_INTERPOLATION: {
+
+			if (get_tree()->is_physics_interpolation_enabled()) {
+				VisualServer::get_singleton()->instance_set_transform(instance, get_global_transform());
+				VisualServer::get_singleton()->instance_reset_physics_interpolation(instance);
+			}
+		} break;
 	}
 }
 
@@ -31,7 +31,7 @@
 #include "voxel_light_baker.h"
 
 #include "core/os/os.h"
-#include "core/os/threaded_array_processor.h"
+#include "core/os/worker_thread_pool.h"
 
 #include <stdlib.h>
 
@@ -641,6 +641,9 @@ void VoxelLightBaker::plot_mesh(const Transform &p_xform, Ref<Mesh> &p_mesh, con
 					continue;
 				//plot
 				_plot_face(0, 0, 0, 0, 0, vtxs, normal, uvs, material, po2_bounds);
+				for (int k = 0; k < 3; k++) {
+					bake_faces.push_back(to_cell_space.xform(vtxs[k]));
+				}
 			}
 
 		} else {
@@ -674,6 +677,9 @@ void VoxelLightBaker::plot_mesh(const Transform &p_xform, Ref<Mesh> &p_mesh, con
 					continue;
 				//plot face
 				_plot_face(0, 0, 0, 0, 0, vtxs, normal, uvs, material, po2_bounds);
+				for (int k = 0; k < 3; k++) {
+					bake_faces.push_back(to_cell_space.xform(vtxs[k]));
+				}
 			}
 		}
 	}
@@ -1668,11 +1674,12 @@ _ALWAYS_INLINE_ uint32_t xorshift32(uint32_t *state) {
 	return x;
 }
 
-Vector3 VoxelLightBaker::_compute_ray_trace_at_pos(const Vector3 &p_pos, const Vector3 &p_normal) {
+#define RAY_TRACE_PASS_SAMPLES 16
+#define LIGHTMAP_ROW_BLOCK 32
 
-	int samples_per_quality[3] = { 48, 128, 512 };
+static const int ray_trace_samples_per_quality[3] = { 48, 128, 512 };
 
-	int samples = samples_per_quality[bake_quality];
+Vector3 VoxelLightBaker::_compute_ray_trace_at_pos(const Vector3 &p_pos, const Vector3 &p_normal, uint32_t &r_rng_state, int p_samples) {
 
 	//create a basis in Z
 	Vector3 v0 = Math::abs(p_normal.z) < 0.999 ? Vector3(0, 0, 1) : Vector3(0, 1, 0);
@@ -1680,120 +1687,217 @@ Vector3 VoxelLightBaker::_compute_ray_trace_at_pos(const Vector3 &p_pos, const V
 	Vector3 bitangent = tangent.cross(p_normal).normalized();
 	Basis normal_xform = Basis(tangent, bitangent, p_normal).transposed();
 
-	float bias = 1.5;
-	int max_level = cell_subdiv - 1;
-	int size = 1 << max_level;
+	//move the origin off the surface, so rays don't hit the face they start from
+	Vector3 from = p_pos + p_normal * 0.05;
 
 	Vector3 accum;
-	float spread = Math::deg2rad(80.0);
 
 	const Light *light = bake_light.ptr();
 	const Cell *cells = bake_cells.ptr();
 
-	uint32_t local_rng_state = rand(); //needs to be fixed again
-
-	for (int i = 0; i < samples; i++) {
+	for (int i = 0; i < p_samples; i++) {
 
-		float random_angle1 = (((xorshift32(&local_rng_state) % 65535) / 65535.0) * 2.0 - 1.0) * spread;
-		Vector3 axis(0, sin(random_angle1), cos(random_angle1));
-		float random_angle2 = ((xorshift32(&local_rng_state) % 65535) / 65535.0) * Math_PI * 2.0;
-		Basis rot(Vector3(0, 0, 1), random_angle2);
-		axis = rot.xform(axis);
+		//cosine weighted direction in the hemisphere
+		float u1 = (xorshift32(&r_rng_state) & 0xFFFF) / 65535.0;
+		float u2 = (xorshift32(&r_rng_state) & 0xFFFF) / 65535.0;
+		float phi = u1 * Math_TAU;
+		float r = Math::sqrt(u2);
+		Vector3 axis(Math::cos(phi) * r, Math::sin(phi) * r, Math::sqrt(MAX(0.0, 1.0 - u2)));
 
 		Vector3 direction = normal_xform.xform(axis).normalized();
 
-		Vector3 advance = direction * _get_normal_advance(direction);
+		Vector3 hit_pos;
+		Vector3 hit_normal;
+		if (!bake_mesh->intersect_ray(from, direction, hit_pos, hit_normal))
+			continue;
 
-		Vector3 pos = p_pos /*+ Vector3(0.5, 0.5, 0.5)*/ + advance * bias;
+		//the voxel plotted for the face that was hit may be on either side of it
+		Vector3 hit_cell = hit_pos - direction * 0.25;
+		uint32_t cell = _find_cell_at_pos(cells, int(Math::floor(hit_cell.x)), int(Math::floor(hit_cell.y)), int(Math::floor(hit_cell.z)));
+		if (cell == CHILD_EMPTY) {
+			hit_cell = hit_pos + direction * 0.25;
+			cell = _find_cell_at_pos(cells, int(Math::floor(hit_cell.x)), int(Math::floor(hit_cell.y)), int(Math::floor(hit_cell.z)));
+		}
 
-		uint32_t cell = CHILD_EMPTY;
+		if (unlikely(cell == CHILD_EMPTY))
+			continue;
 
-		while (cell == CHILD_EMPTY) {
+		for (int j = 0; j < 6; j++) {
+			//anisotropic read light
+			float amount = direction.dot(aniso_normal[j]);
+			if (amount <= 0)
+				continue;
+			accum.x += light[cell].accum[j][0] * amount;
+			accum.y += light[cell].accum[j][1] * amount;
+			accum.z += light[cell].accum[j][2] * amount;
+		}
+		accum.x += cells[cell].emission[0];
+		accum.y += cells[cell].emission[1];
+		accum.z += cells[cell].emission[2];
+	}
 
-			int x = int(pos.x);
-			int y = int(pos.y);
-			int z = int(pos.z);
+	return accum;
+}
 
-			int ofs_x = 0;
-			int ofs_y = 0;
-			int ofs_z = 0;
-			int half = size / 2;
+void VoxelLightBaker::_lightmap_process_rows(int p_rows, void (VoxelLightBaker::*p_method)(uint32_t, const LightMapPass *), const LightMapPass *p_pass) {
 
-			if (x < 0 || x >= size)
-				break;
-			if (y < 0 || y >= size)
-				break;
-			if (z < 0 || z >= size)
-				break;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_rows > 1 && pool && pool->get_thread_count() > 0) {
+		pool->parallel_for(p_rows, this, p_method, p_pass);
+	} else {
+		for (int i = 0; i < p_rows; i++) {
+			(this->*p_method)(i, p_pass);
+		}
+	}
+}
 
-			//int level_limit = max_level;
+void VoxelLightBaker::_lightmap_bake_row(uint32_t p_row, const LightMapPass *p_pass) {
 
-			cell = 0; //start from root
-			for (int j = 0; j < max_level; j++) {
+	if (bake_mode == BAKE_MODE_RAY_TRACE && bake_mesh.is_null())
+		return; //nothing was plotted, nothing to trace against
 
-				const Cell *bc = &cells[cell];
+	int row = p_pass->from_row + p_row;
+	LightMap *line = &p_pass->lightmap[row * p_pass->width];
 
-				int child = 0;
-				if (x >= ofs_x + half) {
-					child |= 1;
-					ofs_x += half;
-				}
-				if (y >= ofs_y + half) {
-					child |= 2;
-					ofs_y += half;
-				}
-				if (z >= ofs_z + half) {
-					child |= 4;
-					ofs_z += half;
-				}
+	for (int i = 0; i < p_pass->width; i++) {
 
-				cell = bc->children[child];
-				if (unlikely(cell == CHILD_EMPTY))
-					break;
+		LightMap *pixel = &line[i];
+		if (pixel->pos == Vector3())
+			continue;
+		switch (bake_mode) {
+			case BAKE_MODE_CONE_TRACE: {
+				pixel->light = _compute_pixel_light_at_pos(pixel->pos, pixel->normal);
+			} break;
+			case BAKE_MODE_RAY_TRACE: {
+				//seed from texel and pass, so the result does not depend on which thread takes the row
+				uint32_t rng_state = hash_djb2_one_32(p_pass->pass, hash_djb2_one_32(row * p_pass->width + i));
+				if (rng_state == 0)
+					rng_state = 1;
+				pixel->light += _compute_ray_trace_at_pos(pixel->pos, pixel->normal, rng_state, p_pass->samples);
+			} break;
+		}
+	}
+}
 
-				half >>= 1;
-			}
+void VoxelLightBaker::_lightmap_direct_row(uint32_t p_row, const LightMapPass *p_pass) {
 
-			pos += advance;
-		}
+	const Cell *cells = bake_cells.ptr();
+	const Light *light = bake_light.ptr();
+	int size = 1 << (cell_subdiv - 1);
 
-		if (unlikely(cell != CHILD_EMPTY)) {
-			for (int j = 0; j < 6; j++) {
-				//anisotropic read light
-				float amount = direction.dot(aniso_normal[j]);
-				if (amount <= 0)
-					continue;
-				accum.x += light[cell].accum[j][0] * amount;
-				accum.y += light[cell].accum[j][1] * amount;
-				accum.z += light[cell].accum[j][2] * amount;
+	for (int j = 0; j < p_pass->width; j++) {
+
+		LightMap *pixel = &p_pass->lightmap[p_row * p_pass->width + j];
+		if (pixel->pos == Vector3())
+			continue; //unused, skipe
+
+		int x = int(pixel->pos.x) - 1;
+		int y = int(pixel->pos.y) - 1;
+		int z = int(pixel->pos.z) - 1;
+		Color accum;
+
+		int found = 0;
+
+		for (int k = 0; k < 8; k++) {
+
+			int ofs_x = x;
+			int ofs_y = y;
+			int ofs_z = z;
+
+			if (k & 1)
+				ofs_x++;
+			if (k & 2)
+				ofs_y++;
+			if (k & 4)
+				ofs_z++;
+
+			if (ofs_x < 0 || ofs_x >= size)
+				continue;
+			if (ofs_y < 0 || ofs_y >= size)
+				continue;
+			if (ofs_z < 0 || ofs_z >= size)
+				continue;
+
+			uint32_t cell = _find_cell_at_pos(cells, ofs_x, ofs_y, ofs_z);
+
+			if (cell == CHILD_EMPTY)
+				continue;
+			for (int l = 0; l < 6; l++) {
+				float s = pixel->normal.dot(aniso_normal[l]);
+				if (s < 0)
+					s = 0;
+				accum.r += light[cell].direct_accum[l][0] * s;
+				accum.g += light[cell].direct_accum[l][1] * s;
+				accum.b += light[cell].direct_accum[l][2] * s;
 			}
-			accum.x += cells[cell].emission[0];
-			accum.y += cells[cell].emission[1];
-			accum.z += cells[cell].emission[2];
+			found++;
+		}
+		if (found) {
+			accum /= found;
+			pixel->direct = Vector3(accum.r, accum.g, accum.b);
 		}
 	}
+}
 
-	// Make sure we don't reset this thread's RNG state
+void VoxelLightBaker::_lightmap_denoise_row(uint32_t p_row, const LightMapPass *p_pass) {
 
-	return accum / samples;
-}
+	//one a-trous step of a B3 spline kernel, weights drop across normal and surface changes
+	static const float kernel[3] = { 3.0 / 8.0, 1.0 / 4.0, 1.0 / 16.0 };
 
-void VoxelLightBaker::_lightmap_bake_point(uint32_t p_x, LightMap *p_line) {
+	int width = p_pass->width;
+	int height = p_pass->height;
+	int step = p_pass->denoise_step;
+	const LightMap *lightmap = p_pass->lightmap;
+	const Vector3 *src = p_pass->denoise_src;
+	Vector3 *dst = p_pass->denoise_dst;
 
-	LightMap *pixel = &p_line[p_x];
-	if (pixel->pos == Vector3())
-		return;
-	switch (bake_mode) {
-		case BAKE_MODE_CONE_TRACE: {
-			pixel->light = _compute_pixel_light_at_pos(pixel->pos, pixel->normal) * energy;
-		} break;
-		case BAKE_MODE_RAY_TRACE: {
-			pixel->light = _compute_ray_trace_at_pos(pixel->pos, pixel->normal) * energy;
-		} break;
+	for (int j = 0; j < width; j++) {
+
+		int ofs = p_row * width + j;
+		const LightMap &center = lightmap[ofs];
+		if (center.normal == Vector3()) {
+			dst[ofs] = src[ofs];
+			continue;
+		}
+
+		Vector3 accum;
+		float total = 0;
+
+		for (int y = -2; y <= 2; y++) {
+
+			int sy = int(p_row) + y * step;
+			if (sy < 0 || sy >= height)
+				continue;
+
+			for (int x = -2; x <= 2; x++) {
+
+				int sx = j + x * step;
+				if (sx < 0 || sx >= width)
+					continue;
+
+				const LightMap &sample = lightmap[sy * width + sx];
+				if (sample.normal == Vector3())
+					continue;
+
+				float n = MAX(0.0, center.normal.dot(sample.normal));
+				n *= n;
+				n *= n;
+				n *= n;
+				n *= n;
+				n *= n; //pow 32
+				float plane = center.normal.dot(sample.pos - center.pos); //distance off the surface, in cells
+				float weight = kernel[ABS(x)] * kernel[ABS(y)] * n * Math::exp(-plane * plane * 4.0);
+
+				accum += src[sy * width + sx] * weight;
+				total += weight;
+			}
+		}
+
+		dst[ofs] = total > 0 ? accum / total : src[ofs];
 	}
 }
 
-Error VoxelLightBaker::make_lightmap(const Transform &p_xform, Ref<Mesh> &p_mesh, float default_texels_per_unit, LightMapData &r_lightmap, bool (*p_bake_time_func)(void *, float, float), void *p_bake_time_ud) {
+Error VoxelLightBaker::make_lightmap(const Transform &p_xform, Ref<Mesh> &p_mesh, float default_texels_per_unit, LightMapData &r_lightmap, bool (*p_bake_time_func)(void *, float, float), void *p_bake_time_ud, void (*p_preview_func)(void *, const LightMapData &)) {
 
 	//transfer light information to a lightmap
 	Ref<Mesh> mesh = p_mesh;
@@ -1911,157 +2015,109 @@ Error VoxelLightBaker::make_lightmap(const Transform &p_xform, Ref<Mesh> &p_mesh
 		}
 	}
 
-	//step 3 perform voxel cone trace on lightmap pixels
+	//step 3 compute direct light, then trace indirect light in passes, rows are spread over the worker pool
 	{
 		LightMap *lightmap_ptr = lightmap.ptrw();
+
+		LightMapPass pass_data;
+		pass_data.lightmap = lightmap_ptr;
+		pass_data.width = width;
+		pass_data.height = height;
+		pass_data.from_row = 0;
+		pass_data.pass = 0;
+		pass_data.samples = 0;
+		pass_data.denoise_src = NULL;
+		pass_data.denoise_dst = NULL;
+		pass_data.denoise_step = 0;
+
+		//direct light is kept apart, so the denoiser does not blur its shadows
+		_lightmap_process_rows(height, &VoxelLightBaker::_lightmap_direct_row, &pass_data);
+
+		int samples = bake_mode == BAKE_MODE_RAY_TRACE ? ray_trace_samples_per_quality[bake_quality] : 1;
+		int passes = (samples + RAY_TRACE_PASS_SAMPLES - 1) / RAY_TRACE_PASS_SAMPLES;
+		int samples_done = 0;
+		int total_rows = passes * height;
+		int rows_done = 0;
 		uint64_t begin_time = OS::get_singleton()->get_ticks_usec();
-		volatile int lines = 0;
 
-		// make sure our OS-level rng is seeded
+		for (int i = 0; i < passes; i++) {
 
-		for (int i = 0; i < height; i++) {
+			pass_data.pass = i;
+			pass_data.samples = MIN(RAY_TRACE_PASS_SAMPLES, samples - samples_done);
 
-			thread_process_array(width, this, &VoxelLightBaker::_lightmap_bake_point, &lightmap_ptr[i * width]);
+			//rows go in blocks, so progress is reported and the bake can be aborted in between
+			for (int j = 0; j < height; j += LIGHTMAP_ROW_BLOCK) {
 
-			lines = MAX(lines, i); //for multithread
-			if (p_bake_time_func) {
-				uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin_time;
-				float elapsed_sec = double(elapsed) / 1000000.0;
-				float remaining = lines < 1 ? 0 : (elapsed_sec / lines) * (height - lines - 1);
-				if (p_bake_time_func(p_bake_time_ud, remaining, lines / float(height))) {
-					return ERR_SKIP;
-				}
-			}
-		}
+				int rows = MIN(LIGHTMAP_ROW_BLOCK, height - j);
+				pass_data.from_row = j;
+				_lightmap_process_rows(rows, &VoxelLightBaker::_lightmap_bake_row, &pass_data);
+				rows_done += rows;
 
-		if (bake_mode == BAKE_MODE_RAY_TRACE) {
-			//blur
-			//gauss kernel, 7 step sigma 2
-			static const float gauss_kernel[4] = { 0.214607f, 0.189879f, 0.131514f, 0.071303f };
-			//horizontal pass
-			for (int i = 0; i < height; i++) {
-				for (int j = 0; j < width; j++) {
-					if (lightmap_ptr[i * width + j].normal == Vector3()) {
-						continue; //empty
-					}
-					float gauss_sum = gauss_kernel[0];
-					Vector3 accum = lightmap_ptr[i * width + j].light * gauss_kernel[0];
-					for (int k = 1; k < 4; k++) {
-						int new_x = j + k;
-						if (new_x >= width || lightmap_ptr[i * width + new_x].normal == Vector3())
-							break;
-						gauss_sum += gauss_kernel[k];
-						accum += lightmap_ptr[i * width + new_x].light * gauss_kernel[k];
+				if (p_bake_time_func) {
+					uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin_time;
+					float elapsed_sec = double(elapsed) / 1000000.0;
+					float remaining = (elapsed_sec / rows_done) * (total_rows - rows_done);
+					if (p_bake_time_func(p_bake_time_ud, remaining, rows_done / float(total_rows))) {
+						return ERR_SKIP;
 					}
-					for (int k = 1; k < 4; k++) {
-						int new_x = j - k;
-						if (new_x < 0 || lightmap_ptr[i * width + new_x].normal == Vector3())
-							break;
-						gauss_sum += gauss_kernel[k];
-						accum += lightmap_ptr[i * width + new_x].light * gauss_kernel[k];
-					}
-
-					lightmap_ptr[i * width + j].pos = accum /= gauss_sum;
 				}
 			}
-			//vertical pass
-			for (int i = 0; i < height; i++) {
-				for (int j = 0; j < width; j++) {
-					if (lightmap_ptr[i * width + j].normal == Vector3())
-						continue; //empty, don't write over it anyway
-					float gauss_sum = gauss_kernel[0];
-					Vector3 accum = lightmap_ptr[i * width + j].pos * gauss_kernel[0];
-					for (int k = 1; k < 4; k++) {
-						int new_y = i + k;
-						if (new_y >= height || lightmap_ptr[new_y * width + j].normal == Vector3())
-							break;
-						gauss_sum += gauss_kernel[k];
-						accum += lightmap_ptr[new_y * width + j].pos * gauss_kernel[k];
-					}
-					for (int k = 1; k < 4; k++) {
-						int new_y = i - k;
-						if (new_y < 0 || lightmap_ptr[new_y * width + j].normal == Vector3())
-							break;
-						gauss_sum += gauss_kernel[k];
-						accum += lightmap_ptr[new_y * width + j].pos * gauss_kernel[k];
-					}
 
-					lightmap_ptr[i * width + j].light = accum /= gauss_sum;
+			samples_done += pass_data.samples;
+
+			if (p_preview_func && i < passes - 1) {
+				//show what converged so far, without denoising
+				LightMapData preview;
+				preview.width = width;
+				preview.height = height;
+				preview.light.resize(lightmap.size() * 3);
+				{
+					PoolVector<float>::Write w = preview.light.write();
+					float scale = energy / samples_done;
+					for (int k = 0; k < lightmap.size(); k++) {
+						Vector3 l = lightmap_ptr[k].light * scale + lightmap_ptr[k].direct;
+						w[k * 3 + 0] = l.x;
+						w[k * 3 + 1] = l.y;
+						w[k * 3 + 2] = l.z;
+					}
 				}
+				p_preview_func(p_bake_time_ud, preview);
 			}
 		}
 
-		//add directional light (do this after blur)
-		{
-			const Cell *cells = bake_cells.ptr();
-			const Light *light = bake_light.ptr();
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-			for (int i = 0; i < height; i++) {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1)
-#endif
-				for (int j = 0; j < width; j++) {
+		for (int i = 0; i < lightmap.size(); i++) {
+			lightmap_ptr[i].light *= energy / samples;
+		}
 
-					//if (i == 125 && j == 280) {
-
-					LightMap *pixel = &lightmap_ptr[i * width + j];
-					if (pixel->pos == Vector3())
-						continue; //unused, skipe
-
-					int x = int(pixel->pos.x) - 1;
-					int y = int(pixel->pos.y) - 1;
-					int z = int(pixel->pos.z) - 1;
-					Color accum;
-					int size = 1 << (cell_subdiv - 1);
-
-					int found = 0;
-
-					for (int k = 0; k < 8; k++) {
-
-						int ofs_x = x;
-						int ofs_y = y;
-						int ofs_z = z;
-
-						if (k & 1)
-							ofs_x++;
-						if (k & 2)
-							ofs_y++;
-						if (k & 4)
-							ofs_z++;
-
-						if (x < 0 || x >= size)
-							continue;
-						if (y < 0 || y >= size)
-							continue;
-						if (z < 0 || z >= size)
-							continue;
-
-						uint32_t cell = _find_cell_at_pos(cells, ofs_x, ofs_y, ofs_z);
-
-						if (cell == CHILD_EMPTY)
-							continue;
-						for (int l = 0; l < 6; l++) {
-							float s = pixel->normal.dot(aniso_normal[l]);
-							if (s < 0)
-								s = 0;
-							accum.r += light[cell].direct_accum[l][0] * s;
-							accum.g += light[cell].direct_accum[l][1] * s;
-							accum.b += light[cell].direct_accum[l][2] * s;
-						}
-						found++;
-					}
-					if (found) {
-						accum /= found;
-						pixel->light.x += accum.r;
-						pixel->light.y += accum.g;
-						pixel->light.z += accum.b;
-					}
-				}
+		if (bake_mode == BAKE_MODE_RAY_TRACE) {
+			//denoise with steps of 1, 2 and 4 texels, replaces the old blur and keeps pos intact for the passes below
+			Vector<Vector3> denoise_buffers[2];
+			denoise_buffers[0].resize(lightmap.size());
+			denoise_buffers[1].resize(lightmap.size());
+			Vector3 *src = denoise_buffers[0].ptrw();
+			Vector3 *dst = denoise_buffers[1].ptrw();
+
+			for (int i = 0; i < lightmap.size(); i++) {
+				src[i] = lightmap_ptr[i].light;
+			}
+
+			for (int i = 0; i < 3; i++) {
+				pass_data.denoise_src = src;
+				pass_data.denoise_dst = dst;
+				pass_data.denoise_step = 1 << i;
+				_lightmap_process_rows(height, &VoxelLightBaker::_lightmap_denoise_row, &pass_data);
+				SWAP(src, dst);
+			}
+
+			for (int i = 0; i < lightmap.size(); i++) {
+				lightmap_ptr[i].light = src[i];
 			}
 		}
 
+		for (int i = 0; i < lightmap.size(); i++) {
+			lightmap_ptr[i].light += lightmap_ptr[i].direct;
+		}
+
 		{
 			//fill gaps with neighbour vertices to avoid filter fades to black on edges
 
@@ -2160,6 +2216,8 @@ void VoxelLightBaker::begin_bake(int p_subdiv, const AABB &p_bounds) {
 	original_bounds = p_bounds;
 	cell_subdiv = p_subdiv;
 	bake_cells.resize(1);
+	bake_faces.clear();
+	bake_mesh.unref();
 	material_cache.clear();
 
 	//find out the actual real bounds, power of 2, which gets the highest subdivision
@@ -2199,6 +2257,21 @@ void VoxelLightBaker::begin_bake(int p_subdiv, const AABB &p_bounds) {
 
 void VoxelLightBaker::end_bake() {
 	_fixup_plot(0, 0);
+
+	if (bake_mode == BAKE_MODE_RAY_TRACE && bake_faces.size()) {
+		//lightmap rays are traced against the actual faces, voxels are only used to look up light
+		PoolVector<Vector3> faces;
+		faces.resize(bake_faces.size());
+		{
+			PoolVector<Vector3>::Write w = faces.write();
+			for (int i = 0; i < bake_faces.size(); i++) {
+				w[i] = bake_faces[i];
+			}
+		}
+		bake_mesh.instance();
+		bake_mesh->create(faces);
+	}
+	bake_faces.clear();
 }
 
 //create the data for visual server
@@ -2483,4 +2556,6 @@ VoxelLightBaker::VoxelLightBaker() {
 	bake_texture_size = 128;
 	propagation = 0.85;
 	energy = 1.0;
+	bake_quality = BAKE_QUALITY_MEDIUM;
+	bake_mode = BAKE_MODE_CONE_TRACE;
 }
@@ -31,6 +31,7 @@
 #ifndef VOXEL_LIGHT_BAKER_H
 #define VOXEL_LIGHT_BAKER_H
 
+#include "core/math/triangle_mesh.h"
 #include "scene/3d/mesh_instance.h"
 #include "scene/resources/multimesh.h"
 
@@ -87,6 +88,9 @@ private:
 	Vector<Cell> bake_cells;
 	int cell_subdiv;
 
+	Vector<Vector3> bake_faces; //plotted triangles in cell space, used to build bake_mesh
+	Ref<TriangleMesh> bake_mesh; //only for ray trace mode
+
 	struct Light {
 		int x, y, z;
 		float accum[6][3]; //rgb anisotropic
@@ -149,18 +153,34 @@ private:
 
 	struct LightMap {
 		Vector3 light;
+		Vector3 direct;
 		Vector3 pos;
 		Vector3 normal;
 	};
 
+	struct LightMapPass {
+		LightMap *lightmap;
+		int width;
+		int height;
+		int from_row;
+		int pass;
+		int samples;
+		const Vector3 *denoise_src;
+		Vector3 *denoise_dst;
+		int denoise_step;
+	};
+
 	void _plot_triangle(Vector2 *vertices, Vector3 *positions, Vector3 *normals, LightMap *pixels, int width, int height);
 
 	_FORCE_INLINE_ void _sample_baked_octree_filtered_and_anisotropic(const Vector3 &p_posf, const Vector3 &p_direction, float p_level, Vector3 &r_color, float &r_alpha);
 	_FORCE_INLINE_ Vector3 _voxel_cone_trace(const Vector3 &p_pos, const Vector3 &p_normal, float p_aperture);
 	_FORCE_INLINE_ Vector3 _compute_pixel_light_at_pos(const Vector3 &p_pos, const Vector3 &p_normal);
-	_FORCE_INLINE_ Vector3 _compute_ray_trace_at_pos(const Vector3 &p_pos, const Vector3 &p_normal);
+	_FORCE_INLINE_ Vector3 _compute_ray_trace_at_pos(const Vector3 &p_pos, const Vector3 &p_normal, uint32_t &r_rng_state, int p_samples);
 
-	void _lightmap_bake_point(uint32_t p_x, LightMap *p_line);
+	void _lightmap_process_rows(int p_rows, void (VoxelLightBaker::*p_method)(uint32_t, const LightMapPass *), const LightMapPass *p_pass);
+	void _lightmap_bake_row(uint32_t p_row, const LightMapPass *p_pass);
+	void _lightmap_direct_row(uint32_t p_row, const LightMapPass *p_pass);
+	void _lightmap_denoise_row(uint32_t p_row, const LightMapPass *p_pass);
 
 public:
 	void begin_bake(int p_subdiv, const AABB &p_bounds);
@@ -177,7 +197,7 @@ public:
 		PoolVector<float> light;
 	};
 
-	Error make_lightmap(const Transform &p_xform, Ref<Mesh> &p_mesh, float default_texels_per_unit, LightMapData &r_lightmap, bool (*p_bake_time_func)(void *, float, float) = NULL, void *p_bake_time_ud = NULL);
+	Error make_lightmap(const Transform &p_xform, Ref<Mesh> &p_mesh, float default_texels_per_unit, LightMapData &r_lightmap, bool (*p_bake_time_func)(void *, float, float) = NULL, void *p_bake_time_ud = NULL, void (*p_preview_func)(void *, const LightMapData &) = NULL);
 
 	PoolVector<int> create_gi_probe_data();
 	Ref<MultiMesh> create_debug_multimesh(DebugMode p_mode = DEBUG_ALBEDO);
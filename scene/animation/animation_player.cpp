@@ -241,10 +241,12 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 	Animation *a = p_anim->animation.operator->();
 
 	p_anim->node_cache.resize(a->get_track_count());
+	p_anim->playback_cache.resize(a->get_track_count());
 
 	for (int i = 0; i < a->get_track_count(); i++) {
 
 		p_anim->node_cache.write[i] = NULL;
+		p_anim->playback_cache.write[i] = TrackPlaybackCache();
 		RES resource;
 		Vector<StringName> leftover_path;
 		Node *child = parent->get_node_and_resource(a->track_get_path(i), resource, leftover_path);
@@ -324,6 +326,8 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 				}
 				p_anim->node_cache[i]->property_anim[a->track_get_path(i).get_concatenated_subnames()] = pa;
 			}
+
+			p_anim->playback_cache.write[i].property_anim = &p_anim->node_cache[i]->property_anim[a->track_get_path(i).get_concatenated_subnames()];
 		}
 
 		if (a->track_get_type(i) == Animation::TYPE_BEZIER && leftover_path.size()) {
@@ -337,6 +341,8 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 
 				p_anim->node_cache[i]->bezier_anim[a->track_get_path(i).get_concatenated_subnames()] = ba;
 			}
+
+			p_anim->playback_cache.write[i].bezier_anim = &p_anim->node_cache[i]->bezier_anim[a->track_get_path(i).get_concatenated_subnames()];
 		}
 	}
 }
@@ -362,6 +368,8 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 		if (!nc)
 			continue; // no node cache for this track, skip it
 
+		TrackPlaybackCache *pc = &p_anim->playback_cache.write[i];
+
 		if (!a->track_is_enabled(i))
 			continue; // do nothing if the track is disabled
 
@@ -379,7 +387,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				Quat rot;
 				Vector3 scale;
 
-				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
+				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale, &pc->key_hint);
 				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 				if (err != OK)
@@ -408,10 +416,8 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				//StringName property=a->track_get_path(i).get_property();
 
-				Map<StringName, TrackNodeCache::PropertyAnim>::Element *E = nc->property_anim.find(a->track_get_path(i).get_concatenated_subnames());
-				ERR_CONTINUE(!E); //should it continue, or create a new one?
-
-				TrackNodeCache::PropertyAnim *pa = &E->get();
+				TrackNodeCache::PropertyAnim *pa = pc->property_anim;
+				ERR_CONTINUE(!pa); //should it continue, or create a new one?
 
 				Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
 
@@ -459,7 +465,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE || (p_delta == 0 && update_mode == Animation::UPDATE_DISCRETE)) { //delta == 0 means seek
 
-					Variant value = a->value_track_interpolate(i, p_time);
+					Variant value = a->value_track_interpolate(i, p_time, &pc->key_hint);
 
 					if (value == Variant())
 						continue;
@@ -585,12 +591,10 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				if (!nc->node)
 					continue;
 
-				Map<StringName, TrackNodeCache::BezierAnim>::Element *E = nc->bezier_anim.find(a->track_get_path(i).get_concatenated_subnames());
-				ERR_CONTINUE(!E); //should it continue, or create a new one?
-
-				TrackNodeCache::BezierAnim *ba = &E->get();
+				TrackNodeCache::BezierAnim *ba = pc->bezier_anim;
+				ERR_CONTINUE(!ba); //should it continue, or create a new one?
 
-				float bezier = a->bezier_track_interpolate(i, p_time);
+				float bezier = a->bezier_track_interpolate(i, p_time, &pc->key_hint);
 				if (ba->accum_pass != accum_pass) {
 					ERR_CONTINUE(cache_update_bezier_size >= NODE_CACHE_UPDATE_MAX);
 					cache_update_bezier[cache_update_bezier_size++] = ba;
@@ -1075,9 +1079,10 @@ Ref<Animation> AnimationPlayer::get_animation(const StringName &p_name) const {
 
 	ERR_FAIL_COND_V(!animation_set.has(p_name), Ref<Animation>());
 
-	const AnimationData &data = animation_set[p_name];
+	Ref<Animation> animation = animation_set[p_name].animation;
+	animation->ensure_loaded(); //could have been loaded lazily
 
-	return data.animation;
+	return animation;
 }
 void AnimationPlayer::get_animation_list(List<StringName> *p_animations) const {
 
@@ -1205,6 +1210,7 @@ void AnimationPlayer::play(const StringName &p_name, float p_custom_blend, float
 	}
 
 	c.current.from = &animation_set[name];
+	c.current.from->animation->ensure_loaded();
 
 	if (c.assigned != name) { // reset
 		c.current.pos = p_from_end ? c.current.from->animation->get_length() : 0;
@@ -1281,6 +1287,7 @@ void AnimationPlayer::set_assigned_animation(const String &p_anim) {
 		ERR_FAIL_COND(!animation_set.has(p_anim));
 		playback.current.pos = 0;
 		playback.current.from = &animation_set[p_anim];
+		playback.current.from->animation->ensure_loaded();
 		playback.assigned = p_anim;
 	}
 }
@@ -1327,6 +1334,7 @@ void AnimationPlayer::seek(float p_time, bool p_update) {
 		if (playback.assigned) {
 			ERR_FAIL_COND(!animation_set.has(playback.assigned));
 			playback.current.from = &animation_set[playback.assigned];
+			playback.current.from->animation->ensure_loaded();
 		}
 		ERR_FAIL_COND(!playback.current.from);
 	}
@@ -1344,6 +1352,7 @@ void AnimationPlayer::seek_delta(float p_time, float p_delta) {
 		if (playback.assigned) {
 			ERR_FAIL_COND(!animation_set.has(playback.assigned));
 			playback.current.from = &animation_set[playback.assigned];
+			playback.current.from->animation->ensure_loaded();
 		}
 		ERR_FAIL_COND(!playback.current.from);
 	}
@@ -1413,6 +1422,7 @@ void AnimationPlayer::clear_caches() {
 	for (Map<StringName, AnimationData>::Element *E = animation_set.front(); E; E = E->next()) {
 
 		E->get().node_cache.clear();
+		E->get().playback_cache.clear();
 	}
 
 	cache_update_size = 0;
@@ -187,10 +187,24 @@ private:
 	float speed_scale;
 	float default_blend_time;
 
+	// per track state resolved once with the node caches, so playback needs no lookups
+	struct TrackPlaybackCache {
+
+		TrackNodeCache::PropertyAnim *property_anim;
+		TrackNodeCache::BezierAnim *bezier_anim;
+		int key_hint;
+
+		TrackPlaybackCache() :
+				property_anim(NULL),
+				bezier_anim(NULL),
+				key_hint(-1) {}
+	};
+
 	struct AnimationData {
 		String name;
 		StringName next;
 		Vector<TrackNodeCache *> node_cache;
+		Vector<TrackPlaybackCache> playback_cache;
 		Ref<Animation> animation;
 	};
 
@@ -33,6 +33,7 @@
 #include "animation_blend_tree.h"
 #include "core/engine.h"
 #include "core/method_bind_ext.gen.inc"
+#include "core/os/worker_thread_pool.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
 
@@ -743,6 +744,174 @@ void AnimationTree::_clear_caches() {
 	cache_valid = false;
 }
 
+void AnimationTree::_queue_track_blend(TrackCache *p_track, const AnimationNode::AnimationState *p_state, int p_track_idx, float p_blend) {
+
+	if (p_track->blend_pass != process_pass) {
+		p_track->blend_pass = process_pass;
+		p_track->blend_count = 0;
+		if (blended_track_count == blended_tracks.size()) {
+			blended_tracks.resize(MAX(16, blended_tracks.size() * 2));
+		}
+		blended_tracks.write[blended_track_count++] = p_track;
+	}
+
+	if (track_blend_count == track_blends.size()) {
+		track_blends.resize(MAX(64, track_blends.size() * 2));
+	}
+
+	TrackBlend &tb = track_blends.write[track_blend_count++];
+	tb.track = p_track;
+	tb.state = p_state;
+	tb.track_idx = p_track_idx;
+	tb.blend = p_blend;
+	p_track->blend_count++;
+}
+
+void AnimationTree::_blend_track(uint32_t p_index, void *p_userdata) {
+
+	TrackCache *track = blended_tracks[p_index];
+	const TrackBlend *blends = &sorted_track_blends[track->blend_offset];
+
+	for (int k = 0; k < track->blend_count; k++) {
+
+		const AnimationNode::AnimationState &as = *blends[k].state;
+		const Ref<Animation> &a = as.animation;
+		float time = as.time;
+		float delta = as.delta;
+		int i = blends[k].track_idx;
+		float blend = blends[k].blend;
+
+		switch (track->type) {
+
+			case Animation::TYPE_TRANSFORM: {
+
+				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+
+				if (track->root_motion) {
+
+					if (t->process_pass != process_pass) {
+
+						t->process_pass = process_pass;
+						t->loc = Vector3();
+						t->rot = Quat();
+						t->rot_blend_accum = 0;
+						t->scale = Vector3(1, 1, 1);
+					}
+
+					float prev_time = time - delta;
+					if (prev_time < 0) {
+						if (!a->has_loop()) {
+							prev_time = 0;
+						} else {
+							prev_time = a->get_length() + prev_time;
+						}
+					}
+
+					Vector3 loc[2];
+					Quat rot[2];
+					Vector3 scale[2];
+
+					if (prev_time > time) {
+
+						Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
+						if (err != OK) {
+							continue;
+						}
+
+						a->transform_track_interpolate(i, a->get_length(), &loc[1], &rot[1], &scale[1]);
+
+						t->loc += (loc[1] - loc[0]) * blend;
+						t->scale += (scale[1] - scale[0]) * blend;
+						Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
+						t->rot = (t->rot * q).normalized();
+
+						prev_time = 0;
+					}
+
+					Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
+					if (err != OK) {
+						continue;
+					}
+
+					a->transform_track_interpolate(i, time, &loc[1], &rot[1], &scale[1]);
+
+					t->loc += (loc[1] - loc[0]) * blend;
+					t->scale += (scale[1] - scale[0]) * blend;
+					Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
+					t->rot = (t->rot * q).normalized();
+
+					prev_time = 0;
+
+				} else {
+					Vector3 loc;
+					Quat rot;
+					Vector3 scale;
+
+					Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale);
+					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
+
+					if (t->process_pass != process_pass) {
+
+						t->process_pass = process_pass;
+						t->loc = loc;
+						t->rot = rot;
+						t->rot_blend_accum = 0;
+						t->scale = scale;
+					}
+
+					if (err != OK)
+						continue;
+
+					t->loc = t->loc.linear_interpolate(loc, blend);
+					if (t->rot_blend_accum == 0) {
+						t->rot = rot;
+						t->rot_blend_accum = blend;
+					} else {
+						float rot_total = t->rot_blend_accum + blend;
+						t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
+						t->rot_blend_accum = rot_total;
+					}
+					t->scale = t->scale.linear_interpolate(scale, blend);
+				}
+
+			} break;
+			case Animation::TYPE_VALUE: {
+
+				TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
+
+				Variant value = a->value_track_interpolate(i, time);
+
+				if (value == Variant())
+					continue;
+
+				if (t->process_pass != process_pass) {
+					t->value = value;
+					t->process_pass = process_pass;
+				}
+
+				Variant::interpolate(t->value, value, blend, t->value);
+
+			} break;
+			case Animation::TYPE_BEZIER: {
+
+				TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
+
+				float bezier = a->bezier_track_interpolate(i, time);
+
+				if (t->process_pass != process_pass) {
+					t->value = bezier;
+					t->process_pass = process_pass;
+				}
+
+				t->value = Math::lerp(t->value, bezier, blend);
+
+			} break;
+			default: {
+			} break;
+		}
+	}
+}
+
 void AnimationTree::_process_graph(float p_delta) {
 
 	_update_properties(); //if properties need updating, update them
@@ -845,6 +1014,9 @@ void AnimationTree::_process_graph(float p_delta) {
 
 		bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 
+		track_blend_count = 0;
+		blended_track_count = 0;
+
 		for (List<AnimationNode::AnimationState>::Element *E = state.animation_states.front(); E; E = E->next()) {
 
 			const AnimationNode::AnimationState &as = E->get();
@@ -881,118 +1053,21 @@ void AnimationTree::_process_graph(float p_delta) {
 
 					case Animation::TYPE_TRANSFORM: {
 
-						TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
-
-						if (track->root_motion) {
-
-							if (t->process_pass != process_pass) {
-
-								t->process_pass = process_pass;
-								t->loc = Vector3();
-								t->rot = Quat();
-								t->rot_blend_accum = 0;
-								t->scale = Vector3(1, 1, 1);
-							}
-
-							float prev_time = time - delta;
-							if (prev_time < 0) {
-								if (!a->has_loop()) {
-									prev_time = 0;
-								} else {
-									prev_time = a->get_length() + prev_time;
-								}
-							}
-
-							Vector3 loc[2];
-							Quat rot[2];
-							Vector3 scale[2];
-
-							if (prev_time > time) {
-
-								Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
-								if (err != OK) {
-									continue;
-								}
-
-								a->transform_track_interpolate(i, a->get_length(), &loc[1], &rot[1], &scale[1]);
-
-								t->loc += (loc[1] - loc[0]) * blend;
-								t->scale += (scale[1] - scale[0]) * blend;
-								Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
-								t->rot = (t->rot * q).normalized();
-
-								prev_time = 0;
-							}
-
-							Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
-							if (err != OK) {
-								continue;
-							}
-
-							a->transform_track_interpolate(i, time, &loc[1], &rot[1], &scale[1]);
-
-							t->loc += (loc[1] - loc[0]) * blend;
-							t->scale += (scale[1] - scale[0]) * blend;
-							Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
-							t->rot = (t->rot * q).normalized();
-
-							prev_time = 0;
-
-						} else {
-							Vector3 loc;
-							Quat rot;
-							Vector3 scale;
-
-							Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale);
-							//ERR_CONTINUE(err!=OK); //used for testing, should be removed
-
-							if (t->process_pass != process_pass) {
-
-								t->process_pass = process_pass;
-								t->loc = loc;
-								t->rot = rot;
-								t->rot_blend_accum = 0;
-								t->scale = scale;
-							}
-
-							if (err != OK)
-								continue;
-
-							t->loc = t->loc.linear_interpolate(loc, blend);
-							if (t->rot_blend_accum == 0) {
-								t->rot = rot;
-								t->rot_blend_accum = blend;
-							} else {
-								float rot_total = t->rot_blend_accum + blend;
-								t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
-								t->rot_blend_accum = rot_total;
-							}
-							t->scale = t->scale.linear_interpolate(scale, blend);
-						}
+						_queue_track_blend(track, &as, i, blend);
 
 					} break;
 					case Animation::TYPE_VALUE: {
 
-						TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
-
 						Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
 
 						if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE) { //delta == 0 means seek
 
-							Variant value = a->value_track_interpolate(i, time);
-
-							if (value == Variant())
-								continue;
-
-							if (t->process_pass != process_pass) {
-								t->value = value;
-								t->process_pass = process_pass;
-							}
-
-							Variant::interpolate(t->value, value, blend, t->value);
+							_queue_track_blend(track, &as, i, blend);
 
 						} else if (delta != 0) {
 
+							TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
+
 							List<int> indices;
 							a->value_track_get_key_indices(i, time, delta, &indices);
 
@@ -1037,16 +1112,7 @@ void AnimationTree::_process_graph(float p_delta) {
 					} break;
 					case Animation::TYPE_BEZIER: {
 
-						TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
-
-						float bezier = a->bezier_track_interpolate(i, time);
-
-						if (t->process_pass != process_pass) {
-							t->value = bezier;
-							t->process_pass = process_pass;
-						}
-
-						t->value = Math::lerp(t->value, bezier, blend);
+						_queue_track_blend(track, &as, i, blend);
 
 					} break;
 					case Animation::TYPE_AUDIO: {
@@ -1222,6 +1288,36 @@ void AnimationTree::_process_graph(float p_delta) {
 		}
 	}
 
+	{
+		// group the queued blends per track cache, keeping their order, so each cache can be blended on its own thread
+
+		if (sorted_track_blends.size() < track_blend_count) {
+			sorted_track_blends.resize(track_blends.size());
+		}
+
+		int ofs = 0;
+		for (int i = 0; i < blended_track_count; i++) {
+			TrackCache *track = blended_tracks[i];
+			track->blend_offset = ofs;
+			ofs += track->blend_count;
+			track->blend_count = 0;
+		}
+
+		TrackBlend *sorted = sorted_track_blends.ptrw();
+		for (int i = 0; i < track_blend_count; i++) {
+			TrackCache *track = track_blends[i].track;
+			sorted[track->blend_offset + track->blend_count++] = track_blends[i];
+		}
+
+		if (blended_track_count > 1 && track_blend_count >= PARALLEL_BLEND_MIN && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+			WorkerThreadPool::get_singleton()->parallel_for(blended_track_count, this, &AnimationTree::_blend_track, (void *)NULL);
+		} else {
+			for (int i = 0; i < blended_track_count; i++) {
+				_blend_track(i, NULL);
+			}
+		}
+	}
+
 	{
 		// finally, set the tracks
 		const NodePath *K = NULL;
@@ -1585,6 +1681,8 @@ AnimationTree::AnimationTree() {
 	started = true;
 	properties_dirty = true;
 	last_animation_player = 0;
+	track_blend_count = 0;
+	blended_track_count = 0;
 }
 
 AnimationTree::~AnimationTree() {
@@ -178,6 +178,9 @@ private:
 		bool root_motion;
 		uint64_t setup_pass;
 		uint64_t process_pass;
+		uint64_t blend_pass;
+		int blend_offset;
+		int blend_count;
 		Animation::TrackType type;
 		Object *object;
 		ObjectID object_id;
@@ -186,6 +189,9 @@ private:
 			root_motion = false;
 			setup_pass = 0;
 			process_pass = 0;
+			blend_pass = 0;
+			blend_offset = 0;
+			blend_count = 0;
 			object = NULL;
 			object_id = 0;
 		}
@@ -258,6 +264,27 @@ private:
 	HashMap<NodePath, TrackCache *> track_cache;
 	Set<TrackCache *> playing_caches;
 
+	enum {
+		PARALLEL_BLEND_MIN = 64 // less blends than this are not worth the threads
+	};
+
+	// transform, continuous value and bezier blends of a pass, they only touch their own track cache
+	struct TrackBlend {
+		TrackCache *track;
+		const AnimationNode::AnimationState *state;
+		int track_idx;
+		float blend;
+	};
+
+	Vector<TrackBlend> track_blends;
+	int track_blend_count;
+	Vector<TrackBlend> sorted_track_blends;
+	Vector<TrackCache *> blended_tracks;
+	int blended_track_count;
+
+	void _queue_track_blend(TrackCache *p_track, const AnimationNode::AnimationState *p_state, int p_track_idx, float p_blend);
+	void _blend_track(uint32_t p_index, void *p_userdata);
+
 	Ref<AnimationNode> root;
 
 	AnimationProcessMode process_mode;
@@ -240,6 +240,7 @@ void Tween::_bind_methods() {
 
 	// Bind interpolation and follow methods
 	ClassDB::bind_method(D_METHOD("interpolate_property", "object", "property", "initial_val", "final_val", "duration", "trans_type", "ease_type", "delay"), &Tween::interpolate_property, DEFVAL(TRANS_LINEAR), DEFVAL(EASE_IN_OUT), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("interpolate_properties", "objects", "property", "initial_val", "final_val", "duration", "trans_type", "ease_type", "delay"), &Tween::interpolate_properties, DEFVAL(TRANS_LINEAR), DEFVAL(EASE_IN_OUT), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("interpolate_method", "object", "method", "initial_val", "final_val", "duration", "trans_type", "ease_type", "delay"), &Tween::interpolate_method, DEFVAL(TRANS_LINEAR), DEFVAL(EASE_IN_OUT), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("interpolate_callback", "object", "duration", "callback", "arg1", "arg2", "arg3", "arg4", "arg5"), &Tween::interpolate_callback, DEFVAL(Variant()), DEFVAL(Variant()), DEFVAL(Variant()), DEFVAL(Variant()), DEFVAL(Variant()));
 	ClassDB::bind_method(D_METHOD("interpolate_deferred_callback", "object", "duration", "callback", "arg1", "arg2", "arg3", "arg4", "arg5"), &Tween::interpolate_deferred_callback, DEFVAL(Variant()), DEFVAL(Variant()), DEFVAL(Variant()), DEFVAL(Variant()), DEFVAL(Variant()));
@@ -419,31 +420,61 @@ Variant &Tween::_get_delta_val(InterpolateData &p_data) {
 	return p_data.initial_val;
 }
 
+real_t Tween::_get_ease(const InterpolateData &p_data) {
+	// Every equation is linear in its initial and delta values, so evaluate the curve once
+	// from 0 to 1 and scale each component by it instead of easing them one by one
+	return _run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, 0, 1, p_data.duration);
+}
+
 Variant Tween::_run_equation(InterpolateData &p_data) {
+	// Get the eased progress of the tween
+	real_t ease = _get_ease(p_data);
+
+	// Plain values were split into lanes when the tween was built, no Variant math needed
+	if (p_data.lanes > 0) {
+		real_t r[4];
+		for (int j = 0; j < p_data.lanes; j++) {
+			r[j] = p_data.initial_lanes[j] + p_data.delta_lanes[j] * ease;
+		}
+
+		switch (p_data.initial_val.get_type()) {
+			case Variant::REAL:
+				return r[0];
+			case Variant::VECTOR2:
+				return Vector2(r[0], r[1]);
+			case Variant::VECTOR3:
+				return Vector3(r[0], r[1], r[2]);
+			case Variant::COLOR:
+				return Color(r[0], r[1], r[2], r[3]);
+			default:
+				break;
+		}
+	}
+
 	// Get the initial and delta values from the data
 	Variant initial_val = _get_initial_val(p_data);
 	Variant &delta_val = _get_delta_val(p_data);
 	Variant result;
 
 #define APPLY_EQUATION(element) \
-	r.element = _run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, i.element, d.element, p_data.duration);
+	r.element = i.element + d.element * ease;
 
 	// What type of data are we interpolating?
 	switch (initial_val.get_type()) {
 
 		case Variant::BOOL:
 			// Run the boolean specific equation (checking if it is at least 0.5)
-			result = (_run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, initial_val, delta_val, p_data.duration)) >= 0.5;
+			result = ((real_t)initial_val + (real_t)delta_val * ease) >= 0.5;
 			break;
 
 		case Variant::INT:
 			// Run the integer specific equation
-			result = (int)_run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, (int)initial_val, (int)delta_val, p_data.duration);
+			result = (int)((int)initial_val + (int)delta_val * ease);
 			break;
 
 		case Variant::REAL:
 			// Run the REAL specific equation
-			result = _run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, (real_t)initial_val, (real_t)delta_val, p_data.duration);
+			result = (real_t)initial_val + (real_t)delta_val * ease;
 			break;
 
 		case Variant::VECTOR2: {
@@ -597,6 +628,43 @@ bool Tween::_apply_tween_value(InterpolateData &p_data, Variant &value) {
 		case INTER_PROPERTY:
 		case FOLLOW_PROPERTY:
 		case TARGETING_PROPERTY: {
+			// Call the setter directly if it was resolved when building the tween
+			if (p_data.setter) {
+#ifdef PTRCALL_ENABLED
+				switch (value.get_type()) {
+					case Variant::REAL: {
+						double v = value;
+						const void *arg[1] = { &v };
+						p_data.setter->ptrcall(object, arg, NULL);
+					} break;
+					case Variant::VECTOR2: {
+						Vector2 v = value;
+						const void *arg[1] = { &v };
+						p_data.setter->ptrcall(object, arg, NULL);
+					} break;
+					case Variant::VECTOR3: {
+						Vector3 v = value;
+						const void *arg[1] = { &v };
+						p_data.setter->ptrcall(object, arg, NULL);
+					} break;
+					case Variant::COLOR: {
+						Color v = value;
+						const void *arg[1] = { &v };
+						p_data.setter->ptrcall(object, arg, NULL);
+					} break;
+					default: {
+						ERR_FAIL_V(false);
+					}
+				}
+				return true;
+#else
+				Variant::CallError error;
+				const Variant *arg[1] = { &value };
+				p_data.setter->call(object, arg, 1, error);
+				return error.error == Variant::CallError::CALL_OK;
+#endif
+			}
+
 			// Simply set the property on the object
 			bool valid = false;
 			object->set_indexed(p_data.key, value, &valid);
@@ -693,7 +761,7 @@ void Tween::_tween_process(float p_delta) {
 		else if (prev_delaying) {
 			// We can apply the tween's value to the data and emit that the tween has started
 			_apply_tween_value(data, data.initial_val);
-			emit_signal("tween_started", object, NodePath(Vector<StringName>(), data.key, false));
+			emit_signal("tween_started", object, data.key_path);
 		}
 
 		// Are we at the end of the tween?
@@ -749,7 +817,7 @@ void Tween::_tween_process(float p_delta) {
 			_apply_tween_value(data, result);
 
 			// Emit that the tween has taken a step
-			emit_signal("tween_step", object, NodePath(Vector<StringName>(), data.key, false), data.elapsed, result);
+			emit_signal("tween_step", object, data.key_path, data.elapsed, result);
 		}
 
 		// Is the tween now finished?
@@ -760,7 +828,7 @@ void Tween::_tween_process(float p_delta) {
 
 			// Mark the tween as completed and emit the signal
 			data.elapsed = 0;
-			emit_signal("tween_completed", object, NodePath(Vector<StringName>(), data.key, false));
+			emit_signal("tween_completed", object, data.key_path);
 
 			// If we are not repeating the tween, remove it
 			if (!repeat)
@@ -1003,6 +1071,7 @@ void Tween::_push_interpolate_data(InterpolateData &p_data) {
 
 	// Add the new interpolation
 	p_data.uid = ++uid;
+	p_data.key_path = NodePath(Vector<StringName>(), p_data.key, false);
 	interpolates.push_back(p_data);
 
 	pending_update--;
@@ -1275,11 +1344,89 @@ bool Tween::_build_interpolation(InterpolateType p_interpolation_type, Object *p
 	if (!_calc_delta_val(data.initial_val, data.final_val, data.delta_val))
 		return false;
 
+	_prepare_fast_path(data, p_object);
+
 	// Add this interpolation to the total
 	_push_interpolate_data(data);
 	return true;
 }
 
+void Tween::_prepare_fast_path(InterpolateData &p_data, Object *p_object) {
+
+	// Only tweens with fixed initial and delta values can be split into lanes
+	if (p_data.type != INTER_PROPERTY && p_data.type != INTER_METHOD)
+		return;
+
+	Variant::Type type = p_data.initial_val.get_type();
+	switch (type) {
+		case Variant::REAL: {
+			p_data.initial_lanes[0] = p_data.initial_val;
+			p_data.delta_lanes[0] = p_data.delta_val;
+			p_data.lanes = 1;
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 i = p_data.initial_val;
+			Vector2 d = p_data.delta_val;
+			p_data.initial_lanes[0] = i.x;
+			p_data.initial_lanes[1] = i.y;
+			p_data.delta_lanes[0] = d.x;
+			p_data.delta_lanes[1] = d.y;
+			p_data.lanes = 2;
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 i = p_data.initial_val;
+			Vector3 d = p_data.delta_val;
+			for (int j = 0; j < 3; j++) {
+				p_data.initial_lanes[j] = i[j];
+				p_data.delta_lanes[j] = d[j];
+			}
+			p_data.lanes = 3;
+		} break;
+		case Variant::COLOR: {
+			Color i = p_data.initial_val;
+			Color d = p_data.delta_val;
+			for (int j = 0; j < 4; j++) {
+				p_data.initial_lanes[j] = i.components[j];
+				p_data.delta_lanes[j] = d.components[j];
+			}
+			p_data.lanes = 4;
+		} break;
+		default: {
+			return;
+		}
+	}
+
+	// Properties of the native class itself can be set through their setter, skipping the
+	// lookups of set_indexed() on every step. Subproperties and scripts with their own _set() can't.
+	if (p_data.type != INTER_PROPERTY || p_data.key.size() != 1)
+		return;
+
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (script_instance && script_instance->has_method("_set"))
+		return;
+
+	StringName class_name = p_object->get_class_name();
+	bool valid = false;
+	if (ClassDB::get_property_type(class_name, p_data.key[0], &valid) != type || !valid)
+		return;
+	if (ClassDB::get_property_index(class_name, p_data.key[0]) != -1)
+		return;
+
+	StringName setter_name = ClassDB::get_property_setter(class_name, p_data.key[0]);
+	if (setter_name == StringName())
+		return;
+
+	MethodBind *setter = ClassDB::get_method(class_name, setter_name);
+	if (!setter || setter->is_vararg() || setter->get_argument_count() != 1)
+		return;
+#ifdef DEBUG_METHODS_ENABLED
+	if (setter->get_argument_type(0) != type)
+		return;
+#endif
+
+	p_data.setter = setter;
+}
+
 bool Tween::interpolate_property(Object *p_object, NodePath p_property, Variant p_initial_val, Variant p_final_val, real_t p_duration, TransitionType p_trans_type, EaseType p_ease_type, real_t p_delay) {
 	// If we are busy updating, call this function again later
 	if (pending_update != 0) {
@@ -1303,6 +1450,24 @@ bool Tween::interpolate_property(Object *p_object, NodePath p_property, Variant
 	return result;
 }
 
+bool Tween::interpolate_properties(Array p_objects, NodePath p_property, Variant p_initial_val, Variant p_final_val, real_t p_duration, TransitionType p_trans_type, EaseType p_ease_type, real_t p_delay) {
+	// If we are busy updating, call this function again later
+	if (pending_update != 0) {
+		_add_pending_command("interpolate_properties", p_objects, p_property, p_initial_val, p_final_val, p_duration, p_trans_type, p_ease_type, p_delay);
+		return true;
+	}
+
+	// Tween the same property on every object, each one keeps its own current value if no initial value is given
+	bool result = true;
+	for (int i = 0; i < p_objects.size(); i++) {
+		Object *object = p_objects[i];
+		ERR_CONTINUE_MSG(object == NULL, "Invalid object provided to Tween.");
+
+		result = interpolate_property(object, p_property, p_initial_val, p_final_val, p_duration, p_trans_type, p_ease_type, p_delay) && result;
+	}
+	return result;
+}
+
 bool Tween::interpolate_method(Object *p_object, StringName p_method, Variant p_initial_val, Variant p_final_val, real_t p_duration, TransitionType p_trans_type, EaseType p_ease_type, real_t p_delay) {
 	// If we are busy updating, call this function again later
 	if (pending_update != 0) {
@@ -101,11 +101,18 @@ private:
 		int args;
 		Variant arg[5];
 		int uid;
+		NodePath key_path; // The key as passed to the signals, built once.
+		MethodBind *setter; // Resolved setter of a plain native property, NULL to go through set_indexed().
+		int lanes; // Components eased without Variant math, 0 when the value type needs the generic path.
+		real_t initial_lanes[4];
+		real_t delta_lanes[4];
 		InterpolateData() {
 			active = false;
 			finish = false;
 			call_deferred = false;
 			uid = 0;
+			setter = NULL;
+			lanes = 0;
 		}
 	};
 
@@ -132,6 +139,8 @@ private:
 	static interpolater interpolaters[TRANS_COUNT][EASE_COUNT];
 
 	real_t _run_equation(TransitionType p_trans_type, EaseType p_ease_type, real_t t, real_t b, real_t c, real_t d);
+	real_t _get_ease(const InterpolateData &p_data);
+	void _prepare_fast_path(InterpolateData &p_data, Object *p_object);
 	Variant &_get_delta_val(InterpolateData &p_data);
 	Variant _get_initial_val(const InterpolateData &p_data) const;
 	Variant _get_final_val(const InterpolateData &p_data) const;
@@ -180,6 +189,7 @@ public:
 	real_t get_runtime() const;
 
 	bool interpolate_property(Object *p_object, NodePath p_property, Variant p_initial_val, Variant p_final_val, real_t p_duration, TransitionType p_trans_type = TRANS_LINEAR, EaseType p_ease_type = EASE_IN_OUT, real_t p_delay = 0);
+	bool interpolate_properties(Array p_objects, NodePath p_property, Variant p_initial_val, Variant p_final_val, real_t p_duration, TransitionType p_trans_type = TRANS_LINEAR, EaseType p_ease_type = EASE_IN_OUT, real_t p_delay = 0);
 	bool interpolate_method(Object *p_object, StringName p_method, Variant p_initial_val, Variant p_final_val, real_t p_duration, TransitionType p_trans_type = TRANS_LINEAR, EaseType p_ease_type = EASE_IN_OUT, real_t p_delay = 0);
 	bool interpolate_callback(Object *p_object, real_t p_duration, String p_callback, VARIANT_ARG_DECLARE);
 	bool interpolate_deferred_callback(Object *p_object, real_t p_duration, String p_callback, VARIANT_ARG_DECLARE);
@@ -805,6 +805,23 @@ void ScriptDebuggerRemote::_poll_events() {
 			profiling = false;
 			_send_profiling_data(false);
 			print_line("PROFILING END!");
+		} else if (command == "start_sampling") {
+
+			int interval = cmd[1];
+			for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+				ScriptServer::get_language(i)->profiling_sampling_start(interval);
+			}
+			profiling_samples = true;
+			last_samples_time = OS::get_singleton()->get_ticks_msec();
+
+		} else if (command == "stop_sampling") {
+
+			for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+				ScriptServer::get_language(i)->profiling_sampling_stop();
+			}
+			profiling_samples = false;
+			_send_profiling_samples();
+
 		} else if (command == "start_network_profiling") {
 
 			multiplayer->profiling_start();
@@ -980,9 +997,17 @@ void ScriptDebuggerRemote::idle_poll() {
 			for (int i = 0; i < max; i++) {
 				arr[i] = performance->call("get_monitor", i);
 			}
+			Array custom_names = performance->call("get_custom_monitor_names");
+			Array custom_values;
+			custom_values.resize(custom_names.size());
+			for (int i = 0; i < custom_names.size(); i++) {
+				custom_values[i] = performance->call("get_custom_monitor", custom_names[i]);
+			}
 			packet_peer_stream->put_var("performance");
-			packet_peer_stream->put_var(1);
+			packet_peer_stream->put_var(3);
 			packet_peer_stream->put_var(arr);
+			packet_peer_stream->put_var(custom_names);
+			packet_peer_stream->put_var(custom_values);
 		}
 	}
 
@@ -996,6 +1021,14 @@ void ScriptDebuggerRemote::idle_poll() {
 		}
 	}
 
+	if (profiling_samples) {
+		uint64_t pt = OS::get_singleton()->get_ticks_msec();
+		if (pt - last_samples_time > 100) {
+			last_samples_time = pt;
+			_send_profiling_samples();
+		}
+	}
+
 	if (profiling_network) {
 		uint64_t pt = OS::get_singleton()->get_ticks_msec();
 		if (pt - last_net_bandwidth_time > 200) {
@@ -1019,6 +1052,25 @@ void ScriptDebuggerRemote::idle_poll() {
 	_poll_events();
 }
 
+void ScriptDebuggerRemote::_send_profiling_samples() {
+
+	Map<String, uint32_t> samples;
+	for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+		ScriptServer::get_language(i)->profiling_get_samples(samples);
+	}
+
+	if (samples.empty()) {
+		return;
+	}
+
+	packet_peer_stream->put_var("profile_samples");
+	packet_peer_stream->put_var(samples.size() * 2);
+	for (Map<String, uint32_t>::Element *E = samples.front(); E; E = E->next()) {
+		packet_peer_stream->put_var(E->key());
+		packet_peer_stream->put_var(E->get());
+	}
+}
+
 void ScriptDebuggerRemote::_send_network_profiling_data() {
 	ERR_FAIL_COND(multiplayer.is_null());
 
@@ -1230,6 +1282,7 @@ ScriptDebuggerRemote::ResourceUsageFunc ScriptDebuggerRemote::resource_usage_fun
 ScriptDebuggerRemote::ScriptDebuggerRemote() :
 		profiling(false),
 		profiling_network(false),
+		profiling_samples(false),
 		max_frame_functions(16),
 		skip_profile_frame(false),
 		reload_all_scripts(false),
@@ -1238,6 +1291,7 @@ ScriptDebuggerRemote::ScriptDebuggerRemote() :
 		last_perf_time(0),
 		last_net_prof_time(0),
 		last_net_bandwidth_time(0),
+		last_samples_time(0),
 		performance(Engine::get_singleton()->get_singleton_object("Performance")),
 		requested_quit(false),
 		mutex(Mutex::create()),
@@ -63,6 +63,7 @@ class ScriptDebuggerRemote : public ScriptDebugger {
 
 	bool profiling;
 	bool profiling_network;
+	bool profiling_samples;
 	int max_frame_functions;
 	bool skip_profile_frame;
 	bool reload_all_scripts;
@@ -73,6 +74,7 @@ class ScriptDebuggerRemote : public ScriptDebugger {
 	uint64_t last_perf_time;
 	uint64_t last_net_prof_time;
 	uint64_t last_net_bandwidth_time;
+	uint64_t last_samples_time;
 	Object *performance;
 	bool requested_quit;
 	Mutex *mutex;
@@ -135,6 +137,7 @@ class ScriptDebuggerRemote : public ScriptDebugger {
 	void _send_profiling_data(bool p_for_frame);
 	void _send_network_profiling_data();
 	void _send_network_bandwidth_usage();
+	void _send_profiling_samples();
 
 	struct FrameData {
 
@@ -30,6 +30,8 @@
 
 #include "container.h"
 #include "core/message_queue.h"
+#include "core/os/thread.h"
+#include "scene/main/scene_tree.h"
 #include "scene/scene_string_names.h"
 
 void Container::_child_minsize_changed() {
@@ -123,13 +125,7 @@ void Container::fit_child_in_rect(Control *p_child, const Rect2 &p_rect) {
 		}
 	}
 
-	for (int i = 0; i < 4; i++)
-		p_child->set_anchor(Margin(i), ANCHOR_BEGIN);
-
-	p_child->set_position(r.position);
-	p_child->set_size(r.size);
-	p_child->set_rotation(0);
-	p_child->set_scale(Vector2(1, 1));
+	p_child->_set_container_rect(r);
 }
 
 void Container::queue_sort() {
@@ -140,7 +136,11 @@ void Container::queue_sort() {
 	if (pending_sort)
 		return;
 
-	MessageQueue::get_singleton()->push_call(this, "_sort_children");
+	if (Thread::get_caller_id() == Thread::get_main_id()) {
+		get_tree()->_queue_container_sort(&sort_item);
+	} else {
+		MessageQueue::get_singleton()->push_call(this, "_sort_children");
+	}
 	pending_sort = true;
 }
 
@@ -194,7 +194,8 @@ void Container::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("sort_children"));
 }
 
-Container::Container() {
+Container::Container() :
+		sort_item(this) {
 
 	pending_sort = false;
 }
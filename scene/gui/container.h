@@ -38,6 +38,8 @@ class Container : public Control {
 	GDCLASS(Container, Control);
 
 	bool pending_sort;
+	SelfList<Container> sort_item;
+	friend class SceneTree;
 	void _sort_children();
 	void _child_minsize_changed();
 
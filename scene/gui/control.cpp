@@ -47,6 +47,8 @@
 #include "editor/plugins/canvas_item_editor_plugin.h"
 #endif
 
+uint32_t Control::theme_tree_version = 1;
+
 #ifdef TOOLS_ENABLED
 Dictionary Control::_edit_get_state() const {
 
@@ -486,6 +488,11 @@ void Control::_notification(int p_notification) {
 
 			data.parent = Object::cast_to<Control>(get_parent());
 
+			if (data.theme.is_valid()) {
+				//the owner chain above this theme may differ now, lookups that fell through it are stale
+				theme_tree_version++;
+			}
+
 			if (is_set_as_toplevel()) {
 				data.SI = get_viewport()->_gui_add_subwindow_control(this);
 
@@ -641,6 +648,7 @@ void Control::_notification(int p_notification) {
 		} break;
 		case NOTIFICATION_THEME_CHANGED: {
 
+			_clear_theme_cache();
 			minimum_size_changed();
 			update();
 		} break;
@@ -700,6 +708,12 @@ bool Control::has_point(const Point2 &p_point) const {
 	return Rect2(Point2(), get_size()).has_point(p_point);
 }
 
+bool Control::has_point_outside_rect() const {
+
+	//the viewport skips controls by their rect when looking for the one under the mouse, so anything overriding has_point() must say so
+	return get_script_instance() && get_script_instance()->has_method(SceneStringNames::get_singleton()->has_point);
+}
+
 void Control::set_drag_forwarding(Control *p_target) {
 
 	if (p_target)
@@ -824,12 +838,25 @@ Ref<Texture> Control::get_icon(const StringName &p_name, const StringName &p_typ
 
 	StringName type = p_type ? p_type : get_class_name();
 
+	_validate_theme_cache();
+	ThemeItemKey key(p_name, type);
+	const Ref<Texture> *cached = data.icon_cache.getptr(key);
+	if (cached)
+		return *cached;
+
+	Ref<Texture> icon = _get_theme_icon(p_name, type);
+	data.icon_cache.set(key, icon);
+	return icon;
+}
+
+Ref<Texture> Control::_get_theme_icon(const StringName &p_name, const StringName &p_type) const {
+
 	// try with custom themes
 	Control *theme_owner = data.theme_owner;
 
 	while (theme_owner) {
 
-		StringName class_name = type;
+		StringName class_name = p_type;
 
 		while (class_name != StringName()) {
 			if (theme_owner->data.theme->has_icon(p_name, class_name)) {
@@ -848,12 +875,12 @@ Ref<Texture> Control::get_icon(const StringName &p_name, const StringName &p_typ
 	}
 
 	if (Theme::get_project_default().is_valid()) {
-		if (Theme::get_project_default()->has_icon(p_name, type)) {
-			return Theme::get_project_default()->get_icon(p_name, type);
+		if (Theme::get_project_default()->has_icon(p_name, p_type)) {
+			return Theme::get_project_default()->get_icon(p_name, p_type);
 		}
 	}
 
-	return Theme::get_default()->get_icon(p_name, type);
+	return Theme::get_default()->get_icon(p_name, p_type);
 }
 
 Ref<Shader> Control::get_shader(const StringName &p_name, const StringName &p_type) const {
@@ -866,12 +893,25 @@ Ref<Shader> Control::get_shader(const StringName &p_name, const StringName &p_ty
 
 	StringName type = p_type ? p_type : get_class_name();
 
+	_validate_theme_cache();
+	ThemeItemKey key(p_name, type);
+	const Ref<Shader> *cached = data.shader_cache.getptr(key);
+	if (cached)
+		return *cached;
+
+	Ref<Shader> shader = _get_theme_shader(p_name, type);
+	data.shader_cache.set(key, shader);
+	return shader;
+}
+
+Ref<Shader> Control::_get_theme_shader(const StringName &p_name, const StringName &p_type) const {
+
 	// try with custom themes
 	Control *theme_owner = data.theme_owner;
 
 	while (theme_owner) {
 
-		StringName class_name = type;
+		StringName class_name = p_type;
 
 		while (class_name != StringName()) {
 			if (theme_owner->data.theme->has_shader(p_name, class_name)) {
@@ -890,12 +930,12 @@ Ref<Shader> Control::get_shader(const StringName &p_name, const StringName &p_ty
 	}
 
 	if (Theme::get_project_default().is_valid()) {
-		if (Theme::get_project_default()->has_shader(p_name, type)) {
-			return Theme::get_project_default()->get_shader(p_name, type);
+		if (Theme::get_project_default()->has_shader(p_name, p_type)) {
+			return Theme::get_project_default()->get_shader(p_name, p_type);
 		}
 	}
 
-	return Theme::get_default()->get_shader(p_name, type);
+	return Theme::get_default()->get_shader(p_name, p_type);
 }
 
 Ref<StyleBox> Control::get_stylebox(const StringName &p_name, const StringName &p_type) const {
@@ -908,10 +948,23 @@ Ref<StyleBox> Control::get_stylebox(const StringName &p_name, const StringName &
 
 	StringName type = p_type ? p_type : get_class_name();
 
+	_validate_theme_cache();
+	ThemeItemKey key(p_name, type);
+	const Ref<StyleBox> *cached = data.style_cache.getptr(key);
+	if (cached)
+		return *cached;
+
+	Ref<StyleBox> style = _get_theme_stylebox(p_name, type);
+	data.style_cache.set(key, style);
+	return style;
+}
+
+Ref<StyleBox> Control::_get_theme_stylebox(const StringName &p_name, const StringName &p_type) const {
+
 	// try with custom themes
 	Control *theme_owner = data.theme_owner;
 
-	StringName class_name = type;
+	StringName class_name = p_type;
 
 	while (theme_owner) {
 
@@ -923,7 +976,7 @@ Ref<StyleBox> Control::get_stylebox(const StringName &p_name, const StringName &
 			class_name = ClassDB::get_parent_class_nocheck(class_name);
 		}
 
-		class_name = type;
+		class_name = p_type;
 
 		Control *parent = Object::cast_to<Control>(theme_owner->get_parent());
 
@@ -934,15 +987,15 @@ Ref<StyleBox> Control::get_stylebox(const StringName &p_name, const StringName &
 	}
 
 	while (class_name != StringName()) {
-		if (Theme::get_project_default().is_valid() && Theme::get_project_default()->has_stylebox(p_name, type))
-			return Theme::get_project_default()->get_stylebox(p_name, type);
+		if (Theme::get_project_default().is_valid() && Theme::get_project_default()->has_stylebox(p_name, p_type))
+			return Theme::get_project_default()->get_stylebox(p_name, p_type);
 
 		if (Theme::get_default()->has_stylebox(p_name, class_name))
 			return Theme::get_default()->get_stylebox(p_name, class_name);
 
 		class_name = ClassDB::get_parent_class_nocheck(class_name);
 	}
-	return Theme::get_default()->get_stylebox(p_name, type);
+	return Theme::get_default()->get_stylebox(p_name, p_type);
 }
 Ref<Font> Control::get_font(const StringName &p_name, const StringName &p_type) const {
 
@@ -954,12 +1007,25 @@ Ref<Font> Control::get_font(const StringName &p_name, const StringName &p_type)
 
 	StringName type = p_type ? p_type : get_class_name();
 
+	_validate_theme_cache();
+	ThemeItemKey key(p_name, type);
+	const Ref<Font> *cached = data.font_cache.getptr(key);
+	if (cached)
+		return *cached;
+
+	Ref<Font> font = _get_theme_font(p_name, type);
+	data.font_cache.set(key, font);
+	return font;
+}
+
+Ref<Font> Control::_get_theme_font(const StringName &p_name, const StringName &p_type) const {
+
 	// try with custom themes
 	Control *theme_owner = data.theme_owner;
 
 	while (theme_owner) {
 
-		StringName class_name = type;
+		StringName class_name = p_type;
 
 		while (class_name != StringName()) {
 			if (theme_owner->data.theme->has_font(p_name, class_name)) {
@@ -979,7 +1045,7 @@ Ref<Font> Control::get_font(const StringName &p_name, const StringName &p_type)
 			theme_owner = NULL;
 	}
 
-	return Theme::get_default()->get_font(p_name, type);
+	return Theme::get_default()->get_font(p_name, p_type);
 }
 Color Control::get_color(const StringName &p_name, const StringName &p_type) const {
 
@@ -990,12 +1056,26 @@ Color Control::get_color(const StringName &p_name, const StringName &p_type) con
 	}
 
 	StringName type = p_type ? p_type : get_class_name();
+
+	_validate_theme_cache();
+	ThemeItemKey key(p_name, type);
+	const Color *cached = data.color_cache.getptr(key);
+	if (cached)
+		return *cached;
+
+	Color color = _get_theme_color(p_name, type);
+	data.color_cache.set(key, color);
+	return color;
+}
+
+Color Control::_get_theme_color(const StringName &p_name, const StringName &p_type) const {
+
 	// try with custom themes
 	Control *theme_owner = data.theme_owner;
 
 	while (theme_owner) {
 
-		StringName class_name = type;
+		StringName class_name = p_type;
 
 		while (class_name != StringName()) {
 			if (theme_owner->data.theme->has_color(p_name, class_name)) {
@@ -1014,11 +1094,11 @@ Color Control::get_color(const StringName &p_name, const StringName &p_type) con
 	}
 
 	if (Theme::get_project_default().is_valid()) {
-		if (Theme::get_project_default()->has_color(p_name, type)) {
-			return Theme::get_project_default()->get_color(p_name, type);
+		if (Theme::get_project_default()->has_color(p_name, p_type)) {
+			return Theme::get_project_default()->get_color(p_name, p_type);
 		}
 	}
-	return Theme::get_default()->get_color(p_name, type);
+	return Theme::get_default()->get_color(p_name, p_type);
 }
 
 int Control::get_constant(const StringName &p_name, const StringName &p_type) const {
@@ -1030,12 +1110,26 @@ int Control::get_constant(const StringName &p_name, const StringName &p_type) co
 	}
 
 	StringName type = p_type ? p_type : get_class_name();
+
+	_validate_theme_cache();
+	ThemeItemKey key(p_name, type);
+	const int *cached = data.constant_cache.getptr(key);
+	if (cached)
+		return *cached;
+
+	int constant = _get_theme_constant(p_name, type);
+	data.constant_cache.set(key, constant);
+	return constant;
+}
+
+int Control::_get_theme_constant(const StringName &p_name, const StringName &p_type) const {
+
 	// try with custom themes
 	Control *theme_owner = data.theme_owner;
 
 	while (theme_owner) {
 
-		StringName class_name = type;
+		StringName class_name = p_type;
 
 		while (class_name != StringName()) {
 			if (theme_owner->data.theme->has_constant(p_name, class_name)) {
@@ -1054,11 +1148,11 @@ int Control::get_constant(const StringName &p_name, const StringName &p_type) co
 	}
 
 	if (Theme::get_project_default().is_valid()) {
-		if (Theme::get_project_default()->has_constant(p_name, type)) {
-			return Theme::get_project_default()->get_constant(p_name, type);
+		if (Theme::get_project_default()->has_constant(p_name, p_type)) {
+			return Theme::get_project_default()->get_constant(p_name, p_type);
 		}
 	}
-	return Theme::get_default()->get_constant(p_name, type);
+	return Theme::get_default()->get_constant(p_name, p_type);
 }
 
 bool Control::has_icon_override(const StringName &p_name) const {
@@ -1823,6 +1917,47 @@ void Control::set_position(const Size2 &p_point, bool p_keep_margins) {
 	_size_changed();
 }
 
+void Control::_set_container_rect(const Rect2 &p_rect) {
+
+	//what resetting the anchors, position, size, rotation and scale one by one ends up with, but resized once and only notified on change
+	Size2 new_size = p_rect.size;
+	Size2 min = get_combined_minimum_size();
+	if (new_size.x < min.x)
+		new_size.x = min.x;
+	if (new_size.y < min.y)
+		new_size.y = min.y;
+
+	bool anchors_changed = false;
+	for (int i = 0; i < 4; i++) {
+		if (data.anchor[i] != ANCHOR_BEGIN) {
+			data.anchor[i] = ANCHOR_BEGIN;
+			anchors_changed = true;
+		}
+	}
+
+	data.margin[MARGIN_LEFT] = p_rect.position.x;
+	data.margin[MARGIN_TOP] = p_rect.position.y;
+	data.margin[MARGIN_RIGHT] = p_rect.position.x + new_size.x;
+	data.margin[MARGIN_BOTTOM] = p_rect.position.y + new_size.y;
+
+	if (anchors_changed) {
+		update();
+		_change_notify("anchor_left");
+		_change_notify("anchor_right");
+		_change_notify("anchor_top");
+		_change_notify("anchor_bottom");
+	}
+
+	_size_changed();
+
+	if (data.rotation != 0) {
+		set_rotation(0);
+	}
+	if (data.scale != Vector2(1, 1)) {
+		set_scale(Vector2(1, 1));
+	}
+}
+
 void Control::_set_size(const Size2 &p_size) {
 	set_size(p_size);
 }
@@ -2256,6 +2391,18 @@ void Control::_theme_changed() {
 	_propagate_theme_changed(this, this, false);
 }
 
+void Control::_clear_theme_cache() const {
+
+	data.icon_cache.clear();
+	data.shader_cache.clear();
+	data.style_cache.clear();
+	data.font_cache.clear();
+	data.color_cache.clear();
+	data.constant_cache.clear();
+	data.theme_cache_version = Theme::get_change_version();
+	data.theme_cache_tree_version = theme_tree_version;
+}
+
 void Control::set_theme(const Ref<Theme> &p_theme) {
 
 	if (data.theme == p_theme)
@@ -2266,6 +2413,7 @@ void Control::set_theme(const Ref<Theme> &p_theme) {
 	}
 
 	data.theme = p_theme;
+	theme_tree_version++;
 	if (!p_theme.is_null()) {
 
 		data.theme_owner = this;
@@ -3102,6 +3250,8 @@ Control::Control() {
 	data.MI = NULL;
 	data.RI = NULL;
 	data.theme_owner = NULL;
+	data.theme_cache_version = 0;
+	data.theme_cache_tree_version = 0;
 	data.modal_exclusive = false;
 	data.default_cursor = CURSOR_ARROW;
 	data.h_size_flags = SIZE_FILL;
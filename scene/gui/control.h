@@ -141,6 +141,19 @@ private:
 		}
 	};
 
+	struct ThemeItemKey {
+		StringName name;
+		StringName type;
+
+		static _FORCE_INLINE_ uint32_t hash(const ThemeItemKey &p_key) { return hash_djb2_one_32(p_key.type.hash(), p_key.name.hash()); }
+		bool operator==(const ThemeItemKey &p_key) const { return name == p_key.name && type == p_key.type; }
+
+		ThemeItemKey() {}
+		ThemeItemKey(const StringName &p_name, const StringName &p_type) :
+				name(p_name),
+				type(p_type) {}
+	};
+
 	struct Data {
 
 		Point2 pos_cache;
@@ -205,8 +218,20 @@ private:
 		HashMap<StringName, Color> color_override;
 		HashMap<StringName, int> constant_override;
 
+		//resolved theme lookups, cleared when the theme (or the owner chain) changes
+		mutable HashMap<ThemeItemKey, Ref<Texture>, ThemeItemKey> icon_cache;
+		mutable HashMap<ThemeItemKey, Ref<Shader>, ThemeItemKey> shader_cache;
+		mutable HashMap<ThemeItemKey, Ref<StyleBox>, ThemeItemKey> style_cache;
+		mutable HashMap<ThemeItemKey, Ref<Font>, ThemeItemKey> font_cache;
+		mutable HashMap<ThemeItemKey, Color, ThemeItemKey> color_cache;
+		mutable HashMap<ThemeItemKey, int, ThemeItemKey> constant_cache;
+		mutable uint32_t theme_cache_version;
+		mutable uint32_t theme_cache_tree_version;
+
 	} data;
 
+	static uint32_t theme_tree_version; //bumped when a theme is assigned or a themed control moves in the tree
+
 	// used internally
 	Control *_find_control_at_pos(CanvasItem *p_node, const Point2 &p_pos, const Transform2D &p_xform, Transform2D &r_inv_xform);
 
@@ -221,6 +246,20 @@ private:
 	void _propagate_theme_changed(CanvasItem *p_at, Control *p_owner, bool p_assign = true);
 	void _theme_changed();
 
+	void _clear_theme_cache() const;
+	_FORCE_INLINE_ void _validate_theme_cache() const {
+		if (data.theme_cache_version != Theme::get_change_version() || data.theme_cache_tree_version != theme_tree_version) {
+			_clear_theme_cache();
+		}
+	}
+
+	Ref<Texture> _get_theme_icon(const StringName &p_name, const StringName &p_type) const;
+	Ref<Shader> _get_theme_shader(const StringName &p_name, const StringName &p_type) const;
+	Ref<StyleBox> _get_theme_stylebox(const StringName &p_name, const StringName &p_type) const;
+	Ref<Font> _get_theme_font(const StringName &p_name, const StringName &p_type) const;
+	Color _get_theme_color(const StringName &p_name, const StringName &p_type) const;
+	int _get_theme_constant(const StringName &p_name, const StringName &p_type) const;
+
 	void _change_notify_margins();
 	void _update_minimum_size();
 
@@ -245,6 +284,9 @@ private:
 
 	void _update_minimum_size_cache();
 
+	friend class Container;
+	void _set_container_rect(const Rect2 &p_rect);
+
 protected:
 	virtual void add_child_notify(Node *p_child);
 	virtual void remove_child_notify(Node *p_child);
@@ -309,6 +351,7 @@ public:
 	virtual Size2 get_minimum_size() const;
 	virtual Size2 get_combined_minimum_size() const;
 	virtual bool has_point(const Point2 &p_point) const;
+	virtual bool has_point_outside_rect() const; //true if has_point() may accept points outside of the control's rect
 	virtual bool clips_input() const;
 	virtual void set_drag_forwarding(Control *p_target);
 	virtual Variant get_drag_data(const Point2 &p_point);
@@ -72,6 +72,7 @@ protected:
 	virtual void _fix_size();
 	virtual void _close_pressed() {}
 	virtual bool has_point(const Point2 &p_point) const;
+	virtual bool has_point_outside_rect() const { return true; }
 	void _notification(int p_what);
 	static void _bind_methods();
 
@@ -48,6 +48,7 @@ class GraphEditFilter : public Control {
 	friend class GraphEdit;
 	GraphEdit *ge;
 	virtual bool has_point(const Point2 &p_point) const;
+	virtual bool has_point_outside_rect() const { return true; }
 
 public:
 	GraphEditFilter(GraphEdit *p_edit);
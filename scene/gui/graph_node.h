@@ -111,6 +111,7 @@ protected:
 
 public:
 	bool has_point(const Point2 &p_point) const;
+	bool has_point_outside_rect() const { return comment; }
 
 	void set_slot(int p_idx, bool p_enable_left, int p_type_left, const Color &p_color_left, bool p_enable_right, int p_type_right, const Color &p_color_right, const Ref<Texture> &p_custom_left = Ref<Texture>(), const Ref<Texture> &p_custom_right = Ref<Texture>());
 	void clear_slot(int p_idx);
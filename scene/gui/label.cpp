@@ -294,7 +294,10 @@ void Label::_notification(int p_what) {
 	}
 	if (p_what == NOTIFICATION_RESIZED) {
 
-		word_cache_dirty = true;
+		//words only break differently if the wrap width changed
+		if (autowrap && _get_autowrap_width() != word_cache_width) {
+			word_cache_dirty = true;
+		}
 	}
 }
 
@@ -376,6 +379,12 @@ int Label::get_visible_line_count() const {
 	return lines_visible;
 }
 
+int Label::_get_autowrap_width() const {
+
+	Ref<StyleBox> style = get_stylebox("normal");
+	return MAX(get_size().width, get_custom_minimum_size().width) - style->get_minimum_size().width;
+}
+
 void Label::regenerate_word_cache() {
 
 	while (word_cache) {
@@ -387,10 +396,11 @@ void Label::regenerate_word_cache() {
 
 	int width;
 	if (autowrap) {
-		Ref<StyleBox> style = get_stylebox("normal");
-		width = MAX(get_size().width, get_custom_minimum_size().width) - style->get_minimum_size().width;
+		width = _get_autowrap_width();
+		word_cache_width = width;
 	} else {
 		width = get_longest_line_width();
+		word_cache_width = -1;
 	}
 
 	Ref<Font> font = get_font("font");
@@ -699,6 +709,7 @@ Label::Label(const String &p_text) {
 	xl_text = "";
 	word_cache = NULL;
 	word_cache_dirty = true;
+	word_cache_width = -1;
 	autowrap = false;
 	line_count = 0;
 	set_v_size_flags(0);
@@ -88,6 +88,8 @@ private:
 	};
 
 	bool word_cache_dirty;
+	int word_cache_width; //wrap width the cache was built for, -1 without autowrap
+	int _get_autowrap_width() const;
 	void regenerate_word_cache();
 
 	float percent_visible;
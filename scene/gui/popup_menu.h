@@ -114,6 +114,7 @@ class PopupMenu : public Popup {
 
 protected:
 	virtual bool has_point(const Point2 &p_point) const;
+	virtual bool has_point_outside_rect() const { return true; }
 
 	friend class MenuButton;
 	void _notification(int p_what);
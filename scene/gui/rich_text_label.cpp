@@ -179,6 +179,9 @@ int RichTextLabel::_process_line(ItemFrame *p_frame, const Vector2 &p_ofs, int &
 		l.char_count = 0;
 		l.minimum_width = 0;
 		l.maximum_width = 0;
+		l.layout_width = p_width;
+		l.unwrapped_width = 0;
+		l.width_dependent = false;
 	}
 
 	int wofs = margin;
@@ -222,8 +225,8 @@ int RichTextLabel::_process_line(ItemFrame *p_frame, const Vector2 &p_ofs, int &
 			int used = wofs - margin;                                                                                                                           \
 			switch (align) {                                                                                                                                    \
 				case ALIGN_LEFT: l.offset_caches.push_back(0); break;                                                                                           \
-				case ALIGN_CENTER: l.offset_caches.push_back(((p_width - margin) - used) / 2); break;                                                           \
-				case ALIGN_RIGHT: l.offset_caches.push_back(((p_width - margin) - used)); break;                                                                \
+				case ALIGN_CENTER: l.offset_caches.push_back(((p_width - margin) - used) / 2); l.width_dependent = true; break;                                 \
+				case ALIGN_RIGHT: l.offset_caches.push_back(((p_width - margin) - used)); l.width_dependent = true; break;                                      \
 				case ALIGN_FILL: l.offset_caches.push_back(line_wrapped ? ((p_width - margin) - used) : 0); break;                                              \
 			}                                                                                                                                                   \
 			l.height_caches.push_back(line_height);                                                                                                             \
@@ -257,6 +260,7 @@ int RichTextLabel::_process_line(ItemFrame *p_frame, const Vector2 &p_ofs, int &
 	if (p_mode == PROCESS_CACHE) {                                                                                                          \
 		l.maximum_width = MAX(l.maximum_width, MIN(p_width, wofs + m_width));                                                               \
 		l.minimum_width = MAX(l.minimum_width, m_width);                                                                                    \
+		l.unwrapped_width = MAX(l.unwrapped_width, wofs + m_width);                                                                         \
 	}                                                                                                                                       \
 	if (wofs + m_width > p_width) {                                                                                                         \
 		line_wrapped = true;                                                                                                                \
@@ -652,6 +656,9 @@ int RichTextLabel::_process_line(ItemFrame *p_frame, const Vector2 &p_ofs, int &
 			case ITEM_TABLE: {
 
 				lh = 0;
+				if (p_mode == PROCESS_CACHE) {
+					l.width_dependent = true; //columns are fitted to the width
+				}
 				ItemTable *table = static_cast<ItemTable *>(it);
 				int hseparation = get_constant("table_hseparation");
 				int vseparation = get_constant("table_vseparation");
@@ -892,7 +899,7 @@ void RichTextLabel::_update_scroll() {
 			vscroll->hide();
 		}
 
-		main->first_invalid_line = 0; //invalidate ALL
+		main->width_changed = true;
 		_validate_line_caches(main);
 	}
 }
@@ -945,7 +952,8 @@ void RichTextLabel::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_RESIZED: {
 
-			main->first_invalid_line = 0; //invalidate ALL
+			//only lines whose layout depends on the width are processed again
+			main->width_changed = true;
 			update();
 
 		} break;
@@ -1067,7 +1075,7 @@ Control::CursorShape RichTextLabel::get_cursor_shape(const Point2 &p_pos) const
 	if (selection.click)
 		return CURSOR_IBEAM;
 
-	if (main->first_invalid_line < main->lines.size())
+	if (main->first_invalid_line < main->lines.size() || main->width_changed)
 		return CURSOR_ARROW; //invalid
 
 	int line = 0;
@@ -1086,7 +1094,7 @@ void RichTextLabel::_gui_input(Ref<InputEvent> p_event) {
 	Ref<InputEventMouseButton> b = p_event;
 
 	if (b.is_valid()) {
-		if (main->first_invalid_line < main->lines.size())
+		if (main->first_invalid_line < main->lines.size() || main->width_changed)
 			return;
 
 		if (b->get_button_index() == BUTTON_LEFT) {
@@ -1247,7 +1255,7 @@ void RichTextLabel::_gui_input(Ref<InputEvent> p_event) {
 	Ref<InputEventMouseMotion> m = p_event;
 
 	if (m.is_valid()) {
-		if (main->first_invalid_line < main->lines.size())
+		if (main->first_invalid_line < main->lines.size() || main->width_changed)
 			return;
 
 		int line = 0;
@@ -1492,7 +1500,7 @@ bool RichTextLabel::_find_layout_subitem(Item *from, Item *to) {
 
 void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 
-	if (p_frame->first_invalid_line == p_frame->lines.size())
+	if (p_frame->first_invalid_line == p_frame->lines.size() && !p_frame->width_changed)
 		return;
 
 	//validate invalid lines
@@ -1507,10 +1515,24 @@ void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 
 	Ref<Font> base_font = get_font("normal_font");
 
-	for (int i = p_frame->first_invalid_line; i < p_frame->lines.size(); i++) {
+	int width = text_rect.get_size().width - scroll_w;
+	int from = p_frame->width_changed ? 0 : p_frame->first_invalid_line;
+
+	for (int i = from; i < p_frame->lines.size(); i++) {
+
+		if (i < p_frame->first_invalid_line) {
+			//unchanged text keeps its layout if it fits without wrapping at both widths
+			const Line &l = p_frame->lines[i];
+			if (l.layout_width == width || (!l.width_dependent && l.unwrapped_width <= l.layout_width && l.unwrapped_width <= width)) {
+				p_frame->lines.write[i].height_accum_cache = l.height_cache;
+				if (i > 0)
+					p_frame->lines.write[i].height_accum_cache += p_frame->lines[i - 1].height_accum_cache;
+				continue;
+			}
+		}
 
 		int y = 0;
-		_process_line(p_frame, text_rect.get_position(), y, text_rect.get_size().width - scroll_w, i, PROCESS_CACHE, base_font, Color(), font_color_shadow, use_outline, shadow_ofs);
+		_process_line(p_frame, text_rect.get_position(), y, width, i, PROCESS_CACHE, base_font, Color(), font_color_shadow, use_outline, shadow_ofs);
 		p_frame->lines.write[i].height_cache = y;
 		p_frame->lines.write[i].height_accum_cache = y;
 
@@ -1523,6 +1545,7 @@ void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 		total_height = p_frame->lines[p_frame->lines.size() - 1].height_accum_cache + get_stylebox("normal")->get_minimum_size().height;
 
 	main->first_invalid_line = p_frame->lines.size();
+	main->width_changed = false;
 
 	updating_scroll = true;
 	vscroll->set_max(total_height);
@@ -96,10 +96,16 @@ private:
 		int char_count;
 		int minimum_width;
 		int maximum_width;
+		int layout_width; //width the caches were built for
+		int unwrapped_width; //widest extent before wrapping
+		bool width_dependent; //aligned or holds a table, so any other width needs a new layout
 
 		Line() {
 			from = NULL;
 			char_count = 0;
+			layout_width = -1;
+			unwrapped_width = 0;
+			width_dependent = true;
 		}
 	};
 
@@ -131,6 +137,7 @@ private:
 		bool cell;
 		Vector<Line> lines;
 		int first_invalid_line;
+		bool width_changed; //lines before first_invalid_line are unchanged, but may wrap differently
 		ItemFrame *parent_frame;
 
 		ItemFrame() {
@@ -138,6 +145,7 @@ private:
 			parent_frame = NULL;
 			cell = false;
 			parent_line = 0;
+			width_changed = false;
 		}
 	};
 
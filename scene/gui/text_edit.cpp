@@ -115,11 +115,13 @@ static int _find_first_non_whitespace_column_of_line(const String &line) {
 void TextEdit::Text::set_font(const Ref<Font> &p_font) {
 
 	font = p_font;
+	max_width_cache = -1;
 }
 
 void TextEdit::Text::set_indent_size(int p_indent_size) {
 
 	indent_size = p_indent_size;
+	max_width_cache = -1;
 }
 
 void TextEdit::Text::_update_line_cache(int p_line) const {
@@ -137,6 +139,11 @@ void TextEdit::Text::_update_line_cache(int p_line) const {
 
 	text.write[p_line].width_cache = w;
 
+	// Growing the widest line never requires a full rescan.
+	if (max_width_cache != -1 && w > max_width_cache && !text[p_line].hidden) {
+		max_width_cache = w;
+	}
+
 	text.write[p_line].wrap_amount_cache = -1;
 
 	// Update regions.
@@ -255,11 +262,21 @@ int TextEdit::Text::get_line_wrap_amount(int p_line) const {
 	return text[p_line].wrap_amount_cache;
 }
 
+void TextEdit::Text::_line_width_removed(int p_line) const {
+
+	// Only losing (or changing) the widest line can make the maximum shrink.
+	int w = text[p_line].width_cache;
+	if (max_width_cache != -1 && !text[p_line].hidden && (w == -1 || w >= max_width_cache)) {
+		max_width_cache = -1;
+	}
+}
+
 void TextEdit::Text::clear_width_cache() {
 
 	for (int i = 0; i < text.size(); i++) {
 		text.write[i].width_cache = -1;
 	}
+	max_width_cache = -1;
 }
 
 void TextEdit::Text::clear_wrap_cache() {
@@ -278,17 +295,27 @@ void TextEdit::Text::clear_info_icons() {
 void TextEdit::Text::clear() {
 
 	text.clear();
+	max_width_cache = -1;
 	insert(0, "");
 }
 
 int TextEdit::Text::get_max_width(bool p_exclude_hidden) const {
-	// Quite some work, but should be fast enough.
 
+	if (p_exclude_hidden && max_width_cache != -1) {
+		return max_width_cache;
+	}
+
+	// Quite some work, so the result for visible lines is kept until a
+	// change could make it shrink.
 	int max = 0;
 	for (int i = 0; i < text.size(); i++) {
 		if (!p_exclude_hidden || !is_hidden(i))
 			max = MAX(max, get_line_width(i));
 	}
+
+	if (p_exclude_hidden) {
+		max_width_cache = max;
+	}
 	return max;
 }
 
@@ -296,28 +323,89 @@ void TextEdit::Text::set(int p_line, const String &p_text) {
 
 	ERR_FAIL_INDEX(p_line, text.size());
 
+	_line_width_removed(p_line);
+
 	text.write[p_line].width_cache = -1;
 	text.write[p_line].wrap_amount_cache = -1;
 	text.write[p_line].data = p_text;
+
+	// Measure the new text right away so a valid maximum stays valid.
+	if (max_width_cache != -1 && !text[p_line].hidden) {
+		_update_line_cache(p_line);
+	}
 }
 
 void TextEdit::Text::insert(int p_at, const String &p_text) {
 
-	Line line;
-	line.marked = false;
-	line.safe = false;
-	line.breakpoint = false;
-	line.bookmark = false;
-	line.hidden = false;
-	line.has_info = false;
-	line.width_cache = -1;
-	line.wrap_amount_cache = -1;
-	line.data = p_text;
-	text.insert(p_at, line);
+	Vector<String> lines;
+	lines.push_back(p_text);
+	insert(p_at, lines);
 }
+
+void TextEdit::Text::insert(int p_at, const Vector<String> &p_text) {
+
+	ERR_FAIL_INDEX(p_at, text.size() + 1);
+
+	int count = p_text.size();
+	if (count == 0) {
+		return;
+	}
+
+	// Shift the following lines once for the whole block, inserting line by
+	// line is quadratic on large pastes.
+	int old_size = text.size();
+	text.resize(old_size + count);
+	Line *w = text.ptrw();
+	for (int i = old_size - 1; i >= p_at; i--) {
+		w[i + count] = w[i];
+	}
+
+	for (int i = 0; i < count; i++) {
+		Line &line = w[p_at + i];
+		line.marked = false;
+		line.safe = false;
+		line.breakpoint = false;
+		line.bookmark = false;
+		line.hidden = false;
+		line.has_info = false;
+		line.width_cache = -1;
+		line.wrap_amount_cache = -1;
+		line.region_info.clear();
+		line.info_icon = Ref<Texture>();
+		line.info = String();
+		line.data = p_text[i];
+	}
+
+	if (max_width_cache != -1) {
+		for (int i = 0; i < count; i++) {
+			_update_line_cache(p_at + i);
+		}
+	}
+}
+
 void TextEdit::Text::remove(int p_at) {
 
-	text.remove(p_at);
+	remove(p_at, 1);
+}
+
+void TextEdit::Text::remove(int p_from, int p_count) {
+
+	ERR_FAIL_COND(p_from < 0 || p_count < 0 || p_from + p_count > text.size());
+
+	if (p_count == 0) {
+		return;
+	}
+
+	for (int i = p_from; i < p_from + p_count; i++) {
+		_line_width_removed(i);
+	}
+
+	int size = text.size();
+	Line *w = text.ptrw();
+	for (int i = p_from + p_count; i < size; i++) {
+		w[i - p_count] = w[i];
+	}
+	text.resize(size - p_count);
 }
 
 int TextEdit::Text::get_char_width(CharType c, CharType next_c, int px) const {
@@ -3878,15 +3966,17 @@ void TextEdit::_base_insert_text(int p_line, int p_char, const String &p_text, i
 
 	/* STEP 1: Remove \r from source text and separate in substrings. */
 
-	Vector<String> substrings = p_text.replace("\r", "").split("\n");
+	String clean_text = p_text.replace("\r", "");
+	Vector<String> substrings = clean_text.split("\n");
 
 	/* STEP 2: Fire breakpoint_toggled signals. */
 
 	// Is this just a new empty line?
-	bool shift_first_line = p_char == 0 && p_text.replace("\r", "") == "\n";
+	bool shift_first_line = p_char == 0 && clean_text == "\n";
 
-	int i = p_line + !shift_first_line;
+	// Breakpoints only move when lines are added.
 	int lines = substrings.size() - 1;
+	int i = lines > 0 ? p_line + !shift_first_line : text.size();
 	for (; i < text.size(); i++) {
 		if (text.is_breakpoint(i)) {
 			if ((i - lines < p_line || !text.is_breakpoint(i - lines)) || (i - lines == p_line && !shift_first_line))
@@ -3907,21 +3997,14 @@ void TextEdit::_base_insert_text(int p_line, int p_char, const String &p_text, i
 	String preinsert_text = text[p_line].substr(0, p_char);
 	String postinsert_text = text[p_line].substr(p_char, text[p_line].size());
 
-	for (int j = 0; j < substrings.size(); j++) {
-		// Insert the substrings.
-
-		if (j == 0) {
-
-			text.set(p_line, preinsert_text + substrings[j]);
-		} else {
-
-			text.insert(p_line + j, substrings[j]);
-		}
-
-		if (j == substrings.size() - 1) {
-
-			text.set(p_line + j, text[p_line + j] + postinsert_text);
-		}
+	// Insert the substrings, all the new lines at once.
+	if (lines == 0) {
+		text.set(p_line, preinsert_text + substrings[0] + postinsert_text);
+	} else {
+		text.set(p_line, preinsert_text + substrings[0]);
+		substrings.write[lines] += postinsert_text;
+		substrings.remove(0);
+		text.insert(p_line + 1, substrings);
 	}
 
 	if (shift_first_line) {
@@ -3938,7 +4021,7 @@ void TextEdit::_base_insert_text(int p_line, int p_char, const String &p_text, i
 
 	text.set_line_wrap_amount(p_line, -1);
 
-	r_end_line = p_line + substrings.size() - 1;
+	r_end_line = p_line + lines;
 	r_end_column = text[r_end_line].length() - postinsert_text.length();
 
 	if (!text_changed_dirty && !setting_text) {
@@ -3987,7 +4070,8 @@ void TextEdit::_base_remove_text(int p_from_line, int p_from_column, int p_to_li
 
 	int lines = p_to_line - p_from_line;
 
-	for (int i = p_from_line + 1; i < text.size(); i++) {
+	// Breakpoints only move when lines are removed.
+	for (int i = lines > 0 ? p_from_line + 1 : text.size(); i < text.size(); i++) {
 		if (text.is_breakpoint(i)) {
 			if (i + lines >= text.size() || !text.is_breakpoint(i + lines))
 				emit_signal("breakpoint_toggled", i);
@@ -3996,9 +4080,7 @@ void TextEdit::_base_remove_text(int p_from_line, int p_from_column, int p_to_li
 		}
 	}
 
-	for (int i = p_from_line; i < p_to_line; i++) {
-		text.remove(p_from_line + 1);
-	}
+	text.remove(p_from_line + 1, lines);
 	text.set(p_from_line, pre_text + post_text);
 
 	text.set_line_wrap_amount(p_from_line, -1);
@@ -4125,22 +4207,30 @@ void TextEdit::_insert_text_at_cursor(const String &p_text) {
 	update();
 }
 
-void TextEdit::_line_edited_from(int p_line) {
-	int cache_size = color_region_cache.size();
-	for (int i = p_line; i < cache_size; i++) {
-		color_region_cache.erase(i);
+template <class T>
+static void _erase_cache_from(Map<int, T> &r_cache, int p_line) {
+
+	// Only visit the entries that actually exist past the edit.
+	typename Map<int, T>::Element *E = r_cache.find_closest(p_line);
+	if (!E) {
+		E = r_cache.front();
+	} else if (E->key() < p_line) {
+		E = E->next();
 	}
 
-	if (syntax_highlighting_cache.size() > 0) {
-		cache_size = syntax_highlighting_cache.back()->key();
-		for (int i = p_line - 1; i <= cache_size; i++) {
-			if (syntax_highlighting_cache.has(i)) {
-				syntax_highlighting_cache.erase(i);
-			}
-		}
+	while (E) {
+		typename Map<int, T>::Element *N = E->next();
+		r_cache.erase(E);
+		E = N;
 	}
 }
 
+void TextEdit::_line_edited_from(int p_line) {
+
+	_erase_cache_from(color_region_cache, p_line);
+	_erase_cache_from(syntax_highlighting_cache, p_line - 1);
+}
+
 int TextEdit::get_char_count() {
 
 	int totalsize = 0;
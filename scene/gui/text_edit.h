@@ -105,8 +105,10 @@ public:
 		mutable Vector<Line> text;
 		Ref<Font> font;
 		int indent_size;
+		mutable int max_width_cache; // Widest visible line, -1 when it must be recomputed.
 
 		void _update_line_cache(int p_line) const;
+		void _line_width_removed(int p_line) const;
 
 	public:
 		void set_indent_size(int p_indent_size);
@@ -125,7 +127,12 @@ public:
 		bool is_bookmark(int p_line) const { return text[p_line].bookmark; }
 		void set_breakpoint(int p_line, bool p_breakpoint) { text.write[p_line].breakpoint = p_breakpoint; }
 		bool is_breakpoint(int p_line) const { return text[p_line].breakpoint; }
-		void set_hidden(int p_line, bool p_hidden) { text.write[p_line].hidden = p_hidden; }
+		void set_hidden(int p_line, bool p_hidden) {
+			if (text[p_line].hidden != p_hidden) {
+				text.write[p_line].hidden = p_hidden;
+				max_width_cache = -1;
+			}
+		}
 		bool is_hidden(int p_line) const { return text[p_line].hidden; }
 		void set_safe(int p_line, bool p_safe) { text.write[p_line].safe = p_safe; }
 		bool is_safe(int p_line) const { return text[p_line].safe; }
@@ -142,14 +149,19 @@ public:
 		const Ref<Texture> &get_info_icon(int p_line) const { return text[p_line].info_icon; }
 		const String &get_info(int p_line) const { return text[p_line].info; }
 		void insert(int p_at, const String &p_text);
+		void insert(int p_at, const Vector<String> &p_text);
 		void remove(int p_at);
+		void remove(int p_from, int p_count);
 		int size() const { return text.size(); }
 		void clear();
 		void clear_width_cache();
 		void clear_wrap_cache();
 		void clear_info_icons();
 		_FORCE_INLINE_ const String &operator[](int p_line) const { return text[p_line].data; }
-		Text() { indent_size = 4; }
+		Text() {
+			indent_size = 4;
+			max_width_cache = -1;
+		}
 	};
 
 private:
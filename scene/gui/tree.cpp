@@ -50,8 +50,11 @@ void TreeItem::move_to_top() {
 		return; //already on top
 	TreeItem *prev = get_prev();
 	prev->next = next;
+	if (parent->last_child == this)
+		parent->last_child = prev;
 	next = parent->children;
 	parent->children = this;
+	_invalidate_height();
 }
 
 void TreeItem::move_to_bottom() {
@@ -70,6 +73,8 @@ void TreeItem::move_to_bottom() {
 	}
 	last->next = this;
 	next = NULL;
+	parent->last_child = this;
+	_invalidate_height();
 }
 
 Size2 TreeItem::Cell::get_icon_size() const {
@@ -98,13 +103,23 @@ void TreeItem::Cell::draw_icon(const RID &p_where, const Point2 &p_pos, const Si
 	}
 }
 
+void TreeItem::_invalidate_height() {
+
+	row_height_version = 0;
+	for (TreeItem *item = this; item; item = item->parent) {
+		item->height_version = 0;
+	}
+}
+
 void TreeItem::_changed_notify(int p_cell) {
 
+	_invalidate_height();
 	tree->item_changed(p_cell, this);
 }
 
 void TreeItem::_changed_notify() {
 
+	_invalidate_height();
 	tree->item_changed(-1, this);
 }
 
@@ -461,6 +476,7 @@ void TreeItem::remove_child(TreeItem *p_item) {
 
 	ERR_FAIL_NULL(p_item);
 	TreeItem **c = &children;
+	TreeItem *prev = NULL;
 
 	while (*c) {
 
@@ -469,11 +485,15 @@ void TreeItem::remove_child(TreeItem *p_item) {
 			TreeItem *aux = *c;
 
 			*c = (*c)->next;
+			if (last_child == aux)
+				last_child = prev;
 
 			aux->parent = NULL;
+			_invalidate_height();
 			return;
 		}
 
+		prev = *c;
 		c = &(*c)->next;
 	}
 
@@ -687,6 +707,7 @@ void TreeItem::set_custom_as_button(int p_column, bool p_button) {
 
 	ERR_FAIL_INDEX(p_column, cells.size());
 	cells.write[p_column].custom_button = p_button;
+	_changed_notify(p_column);
 }
 
 bool TreeItem::is_custom_set_as_button(int p_column) const {
@@ -893,6 +914,8 @@ void TreeItem::clear_children() {
 	}
 
 	children = 0;
+	last_child = 0;
+	_invalidate_height();
 };
 
 TreeItem::TreeItem(Tree *p_tree) {
@@ -905,6 +928,12 @@ TreeItem::TreeItem(Tree *p_tree) {
 	parent = 0; // parent item
 	next = 0; // next in list
 	children = 0; //child items
+	last_child = 0;
+
+	row_height_cache = 0;
+	height_cache = 0;
+	row_height_version = 0;
+	height_version = 0;
 }
 
 TreeItem::~TreeItem() {
@@ -993,10 +1022,32 @@ void Tree::update_cache() {
 	cache.title_button_color = get_color("title_button_color");
 
 	v_scroll->set_custom_step(cache.font->get_height());
+
+	//this runs on every draw, only drop the cached heights if what they were measured with changed
+	int font_height = cache.font->get_height();
+	int check_height = cache.checked.is_valid() ? cache.checked->get_height() : 0;
+	int custom_button_height = cache.custom_button.is_valid() ? cache.custom_button->get_minimum_size().height : 0;
+	if (font_height != cache.row_font_height || check_height != cache.row_check_height || custom_button_height != cache.row_custom_button_height || cache.vseparation != cache.row_vseparation) {
+		cache.row_font_height = font_height;
+		cache.row_check_height = check_height;
+		cache.row_custom_button_height = custom_button_height;
+		cache.row_vseparation = cache.vseparation;
+		height_version++;
+	}
 }
 
 int Tree::compute_item_height(TreeItem *p_item) const {
 
+	if (p_item->row_height_version != height_version) {
+		p_item->row_height_cache = _compute_item_height(p_item);
+		p_item->row_height_version = height_version;
+	}
+
+	return p_item->row_height_cache;
+}
+
+int Tree::_compute_item_height(TreeItem *p_item) const {
+
 	if (p_item == root && hide_root)
 		return 0;
 
@@ -1056,6 +1107,9 @@ int Tree::compute_item_height(TreeItem *p_item) const {
 
 int Tree::get_item_height(TreeItem *p_item) const {
 
+	if (p_item->height_version == height_version)
+		return p_item->height_cache;
+
 	int height = compute_item_height(p_item);
 	height += cache.vseparation;
 
@@ -1071,6 +1125,9 @@ int Tree::get_item_height(TreeItem *p_item) const {
 		}
 	}
 
+	p_item->height_cache = height;
+	p_item->height_version = height_version;
+
 	return height;
 }
 
@@ -1518,7 +1575,11 @@ int Tree::draw_item(const Point2i &p_pos, const Point2 &p_draw_ofs, const Size2
 			}
 
 			if (htotal >= 0) {
-				int child_h = draw_item(children_pos, p_draw_ofs, p_draw_size, c);
+				//subtrees scrolled out above the view are only measured, from the cached heights
+				int child_h = get_item_height(c);
+				if (children_pos.y + child_h - cache.offset.y > 0) {
+					child_h = draw_item(children_pos, p_draw_ofs, p_draw_size, c);
+				}
 
 				if (child_h < 0) {
 					if (cache.draw_relationship_lines == 0) {
@@ -3098,23 +3159,30 @@ TreeItem *Tree::create_item(TreeItem *p_parent, int p_idx) {
 		ti->cells.resize(columns.size());
 
 		TreeItem *prev = NULL;
-		TreeItem *c = p_parent->children;
-		int idx = 0;
+		if (p_idx < 0) {
+			prev = p_parent->last_child;
+		} else {
+			TreeItem *c = p_parent->children;
+			int idx = 0;
 
-		while (c) {
-			if (idx++ == p_idx) {
-				ti->next = c;
-				break;
+			while (c) {
+				if (idx++ == p_idx) {
+					ti->next = c;
+					break;
+				}
+				prev = c;
+				c = c->next;
 			}
-			prev = c;
-			c = c->next;
 		}
 
 		if (prev)
 			prev->next = ti;
 		else
 			p_parent->children = ti;
+		if (!ti->next)
+			p_parent->last_child = ti;
 		ti->parent = p_parent;
+		p_parent->_invalidate_height();
 
 	} else {
 
@@ -3255,6 +3323,8 @@ void Tree::clear() {
 void Tree::set_hide_root(bool p_enabled) {
 
 	hide_root = p_enabled;
+	if (root)
+		root->_invalidate_height();
 	update();
 }
 
@@ -3398,6 +3468,7 @@ void Tree::set_columns(int p_columns) {
 
 	if (root)
 		propagate_set_columns(root);
+	height_version++;
 	if (selected_col >= p_columns)
 		selected_col = p_columns - 1;
 	update();
@@ -3697,7 +3768,15 @@ TreeItem *Tree::_find_item_at_pos(TreeItem *p_item, const Point2 &p_pos, int &r_
 	TreeItem *n = p_item->get_children();
 	while (n) {
 
-		int ch;
+		int ch = get_item_height(n);
+		if (pos.y >= ch) {
+			//the position is past this whole subtree
+			pos.y -= ch;
+			h += ch;
+			n = n->get_next();
+			continue;
+		}
+
 		TreeItem *r = _find_item_at_pos(n, pos, r_column, ch, section);
 		pos.y -= ch;
 		h += ch;
@@ -3997,6 +4076,12 @@ void Tree::_bind_methods() {
 
 Tree::Tree() {
 
+	height_version = 1;
+	cache.row_font_height = -1;
+	cache.row_check_height = -1;
+	cache.row_custom_button_height = -1;
+	cache.row_vseparation = -1;
+
 	selected_col = 0;
 	columns.resize(1);
 	selected_item = NULL;
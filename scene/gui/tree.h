@@ -145,10 +145,19 @@ private:
 	TreeItem *parent; // parent item
 	TreeItem *next; // next in list
 	TreeItem *children; //child items
+	TreeItem *last_child; //so appending does not need to walk the children
 	Tree *tree; //tree (for reference)
 
+	//heights measured by the tree, valid while the versions match the tree's height_version
+	int row_height_cache;
+	int height_cache; //row plus visible children
+	uint32_t row_height_version;
+	uint32_t height_version;
+
 	TreeItem(Tree *p_tree);
 
+	void _invalidate_height();
+
 	void _changed_notify(int p_cell);
 	void _changed_notify();
 	void _cell_selected(int p_cell);
@@ -372,7 +381,11 @@ private:
 	bool range_up_last;
 	void _range_click_timeout();
 
+	//bumped when something every row's height depends on changes, items compare it with their cached heights
+	uint32_t height_version;
+
 	int compute_item_height(TreeItem *p_item) const;
+	int _compute_item_height(TreeItem *p_item) const;
 	int get_item_height(TreeItem *p_item) const;
 	//void draw_item_text(String p_text,const Ref<Texture>& p_icon,int p_icon_max_w,bool p_tool,Rect2i p_rect,const Color& p_color);
 	void draw_item_rect(const TreeItem::Cell &p_cell, const Rect2i &p_rect, const Color &p_color, const Color &p_icon_color);
@@ -400,6 +413,10 @@ private:
 	struct Cache {
 
 		Ref<Font> font;
+		int row_font_height; //what the cached row heights were measured with
+		int row_check_height;
+		int row_custom_button_height;
+		int row_vseparation;
 		Ref<Font> tb_font;
 		Ref<StyleBox> bg;
 		Ref<StyleBox> selected;
@@ -30,11 +30,118 @@
 
 #include "http_request.h"
 
+// Parallel downloads are only worth it for large bodies.
+#define HTTP_REQUEST_MIN_PART_SIZE (1 << 20)
+
+// Servers usually drop idle keep-alive connections after a few seconds.
+#define HTTP_REQUEST_POOL_IDLE_MSEC 10000
+#define HTTP_REQUEST_POOL_MAX_PER_HOST 4
+
+Mutex *HTTPRequest::pool_mutex = NULL;
+HashMap<String, List<HTTPRequest::PooledConnection> > HTTPRequest::pool;
+
 void HTTPRequest::_redirect_request(const String &p_new_url) {
 }
 
+String HTTPRequest::_get_pool_key() const {
+
+	return url + ":" + itos(port) + (use_ssl ? (validate_ssl ? ":ssl" : ":ssl_unverified") : "");
+}
+
+bool HTTPRequest::_acquire_pooled_connection() {
+
+	MutexLock lock(pool_mutex);
+
+	List<PooledConnection> *idle = pool.getptr(_get_pool_key());
+	if (!idle)
+		return false;
+
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	while (idle->size() && now - idle->front()->get().last_used > HTTP_REQUEST_POOL_IDLE_MSEC) {
+		idle->front()->get().client->close();
+		idle->pop_front();
+	}
+
+	while (idle->size()) {
+		// Most recently used first, it is the least likely to be closed.
+		Ref<HTTPClient> pooled = idle->back()->get().client;
+		idle->pop_back();
+
+		pooled->poll();
+		if (pooled->get_status() != HTTPClient::STATUS_CONNECTED) {
+			pooled->close();
+			continue;
+		}
+
+		pooled->set_blocking_mode(use_threads);
+		pooled->set_read_chunk_size(client->get_read_chunk_size());
+		client = pooled;
+		pooled_connection = true;
+		return true;
+	}
+
+	return false;
+}
+
+void HTTPRequest::_release_pooled_connection() {
+
+	for (int i = 0; i < response_headers.size(); i++) {
+		if (response_headers[i].to_lower().begins_with("connection: close"))
+			return;
+	}
+
+	PooledConnection conn;
+	conn.client = client;
+	conn.last_used = OS::get_singleton()->get_ticks_msec();
+
+	{
+		MutexLock lock(pool_mutex);
+
+		String key = _get_pool_key();
+		if (!pool.has(key)) {
+			pool[key] = List<PooledConnection>();
+		}
+		List<PooledConnection> &idle = pool[key];
+		if (idle.size() >= HTTP_REQUEST_POOL_MAX_PER_HOST) {
+			idle.front()->get().client->close();
+			idle.pop_front();
+		}
+		idle.push_back(conn);
+	}
+
+	// The pooled client now belongs to the pool.
+	int chunk_size = client->get_read_chunk_size();
+	client.instance();
+	client->set_read_chunk_size(chunk_size);
+}
+
+bool HTTPRequest::_retry_connection() {
+
+	// The server may have closed the idle connection meanwhile, so try once
+	// more on a fresh one. A POST that may have reached it is not repeated.
+	if (!pooled_connection || got_response)
+		return false;
+	if (request_sent && (method == HTTPClient::METHOD_POST || method == HTTPClient::METHOD_PATCH))
+		return false;
+
+	pooled_connection = false;
+	request_sent = false;
+
+	int chunk_size = client->get_read_chunk_size();
+	client->close();
+	client.instance();
+	client->set_blocking_mode(use_threads);
+	client->set_read_chunk_size(chunk_size);
+
+	return client->connect_to_host(url, port, use_ssl, validate_ssl) == OK;
+}
+
 Error HTTPRequest::_request() {
 
+	if (use_connection_pool && _acquire_pooled_connection())
+		return OK;
+
+	pooled_connection = false;
 	return client->connect_to_host(url, port, use_ssl, validate_ssl);
 }
 
@@ -104,6 +211,22 @@ Error HTTPRequest::request(const String &p_url, const Vector<String> &p_custom_h
 
 	headers = p_custom_headers;
 
+	download_offset = 0;
+	part_end = -1;
+	body_received = 0;
+	main_done = false;
+	if (download_resume && download_to_file != String() && FileAccess::exists(download_to_file)) {
+		FileAccess *f = FileAccess::open(download_to_file, FileAccess::READ);
+		if (f) {
+			download_offset = f->get_len();
+			memdelete(f);
+		}
+		if (download_offset > 0) {
+			// Ask only for what is missing, redirects keep the header.
+			headers.push_back("Range: bytes=" + itos(download_offset) + "-");
+		}
+	}
+
 	request_data = p_request_data;
 
 	requesting = true;
@@ -169,6 +292,12 @@ void HTTPRequest::cancel_request() {
 		memdelete(file);
 		file = NULL;
 	}
+	for (int i = 0; i < parts.size(); i++) {
+		parts.write[i].client->close();
+	}
+	parts.clear();
+	part_end = -1;
+	main_done = false;
 	client->close();
 	body.resize(0);
 	got_response = false;
@@ -191,6 +320,7 @@ bool HTTPRequest::_handle_response(bool *ret_value) {
 	client->get_response_headers(&rheaders);
 	response_headers.resize(0);
 	downloaded = 0;
+	body_received = 0;
 	for (List<String>::Element *E = rheaders.front(); E; E = E->next()) {
 		response_headers.push_back(E->get());
 	}
@@ -242,10 +372,184 @@ bool HTTPRequest::_handle_response(bool *ret_value) {
 	return false;
 }
 
+bool HTTPRequest::_open_download_file() {
+
+	if (download_offset > 0) {
+		if (response_code == 206) {
+			// Append to what was downloaded before.
+			file = FileAccess::open(download_to_file, FileAccess::READ_WRITE);
+			if (file) {
+				file->seek(download_offset);
+			}
+			return file != NULL;
+		}
+		if (response_code != 200) {
+			// Keep the partial file for a later attempt, the body goes to the signal.
+			return true;
+		}
+		// The server ignored the range, start over.
+		download_offset = 0;
+	}
+
+	file = FileAccess::open(download_to_file, FileAccess::WRITE);
+	return file != NULL;
+}
+
+void HTTPRequest::_start_parts() {
+
+	if (method != HTTPClient::METHOD_GET || response_code != 200 || client->is_response_chunked())
+		return;
+	if (body_len < (int64_t)download_connections * HTTP_REQUEST_MIN_PART_SIZE)
+		return;
+
+	bool accepts_ranges = false;
+	for (int i = 0; i < response_headers.size(); i++) {
+		String header = response_headers[i].to_lower();
+		if (header.begins_with("accept-ranges:") && header.find("bytes") != -1) {
+			accepts_ranges = true;
+			break;
+		}
+	}
+	if (!accepts_ranges)
+		return;
+
+	int64_t part_size = body_len / download_connections;
+	for (int i = 1; i < download_connections; i++) {
+		DownloadPart part;
+		part.client.instance();
+		part.client->set_blocking_mode(false);
+		part.client->set_read_chunk_size(client->get_read_chunk_size());
+		part.from = part_size * i;
+		part.to = (i == download_connections - 1 ? body_len : part_size * (i + 1)) - 1;
+		part.received = 0;
+		part.request_sent = false;
+		if (part.client->connect_to_host(url, port, use_ssl, validate_ssl) != OK) {
+			// Let the main connection download everything instead.
+			for (int j = 0; j < parts.size(); j++) {
+				parts.write[j].client->close();
+			}
+			parts.clear();
+			return;
+		}
+		parts.push_back(part);
+	}
+
+	// Preallocate the file so every connection can write its own range.
+	file->seek(body_len - 1);
+	file->store_8(0);
+	file->seek(0);
+	part_end = part_size;
+}
+
+bool HTTPRequest::_update_parts() {
+
+	bool done = main_done;
+	for (int i = 0; i < parts.size(); i++) {
+
+		DownloadPart &part = parts.write[i];
+		int64_t left = part.to - part.from + 1 - part.received;
+		if (left == 0)
+			continue;
+
+		done = false;
+		switch (part.client->get_status()) {
+			case HTTPClient::STATUS_RESOLVING:
+			case HTTPClient::STATUS_CONNECTING:
+			case HTTPClient::STATUS_REQUESTING: {
+				part.client->poll();
+			} break;
+			case HTTPClient::STATUS_CONNECTED: {
+				if (part.request_sent) {
+					// Response without a body.
+					call_deferred("_request_done", RESULT_REQUEST_FAILED, response_code, response_headers, PoolByteArray());
+					return true;
+				}
+				Vector<String> part_headers = headers;
+				part_headers.push_back("Range: bytes=" + itos(part.from) + "-" + itos(part.to));
+				if (part.client->request(method, request_string, part_headers, request_data) != OK) {
+					call_deferred("_request_done", RESULT_CONNECTION_ERROR, response_code, response_headers, PoolByteArray());
+					return true;
+				}
+				part.request_sent = true;
+			} break;
+			case HTTPClient::STATUS_BODY: {
+				if (part.client->get_response_code() != 206) {
+					call_deferred("_request_done", RESULT_REQUEST_FAILED, response_code, response_headers, PoolByteArray());
+					return true;
+				}
+				part.client->poll();
+				PoolByteArray chunk = part.client->read_response_body_chunk();
+				int size = MIN((int64_t)chunk.size(), left);
+				if (size == 0)
+					break;
+				PoolByteArray::Read r = chunk.read();
+				file->seek(part.from + part.received);
+				file->store_buffer(r.ptr(), size);
+				if (file->get_error() != OK) {
+					call_deferred("_request_done", RESULT_DOWNLOAD_FILE_WRITE_ERROR, response_code, response_headers, PoolByteArray());
+					return true;
+				}
+				part.received += size;
+				downloaded += size;
+				if (part.received == part.to - part.from + 1) {
+					part.client->close();
+				}
+			} break;
+			case HTTPClient::STATUS_CANT_RESOLVE: {
+				call_deferred("_request_done", RESULT_CANT_RESOLVE, response_code, response_headers, PoolByteArray());
+				return true;
+			} break;
+			case HTTPClient::STATUS_SSL_HANDSHAKE_ERROR: {
+				call_deferred("_request_done", RESULT_SSL_HANDSHAKE_ERROR, response_code, response_headers, PoolByteArray());
+				return true;
+			} break;
+			case HTTPClient::STATUS_DISCONNECTED:
+			case HTTPClient::STATUS_CANT_CONNECT: {
+				call_deferred("_request_done", RESULT_CANT_CONNECT, response_code, response_headers, PoolByteArray());
+				return true;
+			} break;
+			case HTTPClient::STATUS_CONNECTION_ERROR: {
+				call_deferred("_request_done", RESULT_CONNECTION_ERROR, response_code, response_headers, PoolByteArray());
+				return true;
+			} break;
+		}
+	}
+
+	if (done) {
+		call_deferred("_request_done", RESULT_SUCCESS, response_code, response_headers, PoolByteArray());
+		return true;
+	}
+	return false;
+}
+
+void HTTPRequest::_store_body(const PoolByteArray &p_chunk) {
+
+	if (!stream_body) {
+		body.append_array(p_chunk);
+		return;
+	}
+
+	if (p_chunk.size() == 0)
+		return;
+
+	if (use_threads) {
+		call_deferred("emit_signal", "body_chunk_received", p_chunk);
+	} else {
+		emit_signal("body_chunk_received", p_chunk);
+	}
+}
+
 bool HTTPRequest::_update_connection() {
 
+	if (main_done) {
+		// Only the parallel parts are left.
+		return _update_parts();
+	}
+
 	switch (client->get_status()) {
 		case HTTPClient::STATUS_DISCONNECTED: {
+			if (_retry_connection())
+				return false;
 			call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PoolStringArray(), PoolByteArray());
 			return true; // End it, since it's doing something
 		} break;
@@ -300,6 +604,8 @@ bool HTTPRequest::_update_connection() {
 
 				Error err = client->request(method, request_string, headers, request_data);
 				if (err != OK) {
+					if (_retry_connection())
+						return false;
 					call_deferred("_request_done", RESULT_CONNECTION_ERROR, 0, PoolStringArray(), PoolByteArray());
 					return true;
 				}
@@ -323,6 +629,12 @@ bool HTTPRequest::_update_connection() {
 				if (_handle_response(&ret_value))
 					return ret_value;
 
+				if (download_offset > 0 && response_code == 416) {
+					// Nothing left to download, the file is already complete.
+					call_deferred("_request_done", RESULT_SUCCESS, response_code, response_headers, PoolByteArray());
+					return true;
+				}
+
 				if (!client->is_response_chunked() && client->get_response_body_length() == 0) {
 
 					call_deferred("_request_done", RESULT_SUCCESS, response_code, response_headers, PoolByteArray());
@@ -333,42 +645,71 @@ bool HTTPRequest::_update_connection() {
 				// Change your webserver configuration if you want body len.
 				body_len = client->get_response_body_length();
 
+				if (download_offset > 0 && response_code == 206) {
+					// Progress includes what was downloaded before.
+					downloaded = download_offset;
+					if (body_len >= 0) {
+						body_len += download_offset;
+					}
+				}
+
 				if (body_size_limit >= 0 && body_len > body_size_limit) {
 					call_deferred("_request_done", RESULT_BODY_SIZE_LIMIT_EXCEEDED, response_code, response_headers, PoolByteArray());
 					return true;
 				}
 
 				if (download_to_file != String()) {
-					file = FileAccess::open(download_to_file, FileAccess::WRITE);
-					if (!file) {
+					if (!_open_download_file()) {
 
 						call_deferred("_request_done", RESULT_DOWNLOAD_FILE_CANT_OPEN, response_code, response_headers, PoolByteArray());
 						return true;
 					}
+					if (file && download_connections > 1) {
+						_start_parts();
+					}
 				}
 			}
 
 			client->poll();
 
 			PoolByteArray chunk = client->read_response_body_chunk();
-			downloaded += chunk.size();
+			int size = chunk.size();
+			if (part_end >= 0 && body_received + size > part_end) {
+				// The rest of the body is downloaded by the parts.
+				size = part_end - body_received;
+			}
 
 			if (file) {
 				PoolByteArray::Read r = chunk.read();
-				file->store_buffer(r.ptr(), chunk.size());
+				if (parts.size()) {
+					file->seek(body_received);
+				}
+				file->store_buffer(r.ptr(), size);
 				if (file->get_error() != OK) {
 					call_deferred("_request_done", RESULT_DOWNLOAD_FILE_WRITE_ERROR, response_code, response_headers, PoolByteArray());
 					return true;
 				}
 			} else {
-				body.append_array(chunk);
+				_store_body(chunk);
 			}
 
+			body_received += size;
+			downloaded += size;
+
 			if (body_size_limit >= 0 && downloaded > body_size_limit) {
 				call_deferred("_request_done", RESULT_BODY_SIZE_LIMIT_EXCEEDED, response_code, response_headers, PoolByteArray());
 				return true;
 			}
 
+			if (part_end >= 0) {
+				if (body_received == part_end) {
+					// The main connection got its part, wait for the others.
+					client->close();
+					main_done = true;
+				}
+				return _update_parts();
+			}
+
 			if (body_len >= 0) {
 
 				if (downloaded == body_len) {
@@ -384,6 +725,8 @@ bool HTTPRequest::_update_connection() {
 
 		} break; // Request resulted in body: break which must be read
 		case HTTPClient::STATUS_CONNECTION_ERROR: {
+			if (_retry_connection())
+				return false;
 			call_deferred("_request_done", RESULT_CONNECTION_ERROR, 0, PoolStringArray(), PoolByteArray());
 			return true;
 		} break;
@@ -398,6 +741,10 @@ bool HTTPRequest::_update_connection() {
 
 void HTTPRequest::_request_done(int p_status, int p_code, const PoolStringArray &headers, const PoolByteArray &p_data) {
 
+	if (use_connection_pool && p_status == RESULT_SUCCESS && parts.empty() && client->get_status() == HTTPClient::STATUS_CONNECTED) {
+		_release_pooled_connection();
+	}
+
 	cancel_request();
 	emit_signal("request_completed", p_status, p_code, headers, p_data);
 }
@@ -469,6 +816,55 @@ int HTTPRequest::get_download_chunk_size() const {
 	return client->get_read_chunk_size();
 }
 
+void HTTPRequest::set_use_connection_pool(bool p_use) {
+
+	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+
+	use_connection_pool = p_use;
+}
+
+bool HTTPRequest::is_using_connection_pool() const {
+
+	return use_connection_pool;
+}
+
+void HTTPRequest::set_download_resume(bool p_enabled) {
+
+	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+
+	download_resume = p_enabled;
+}
+
+bool HTTPRequest::is_download_resume_enabled() const {
+
+	return download_resume;
+}
+
+void HTTPRequest::set_download_connections(int p_connections) {
+
+	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+	ERR_FAIL_COND(p_connections < 1 || p_connections > 16);
+
+	download_connections = p_connections;
+}
+
+int HTTPRequest::get_download_connections() const {
+
+	return download_connections;
+}
+
+void HTTPRequest::set_stream_body(bool p_enabled) {
+
+	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+
+	stream_body = p_enabled;
+}
+
+bool HTTPRequest::is_body_streamed() const {
+
+	return stream_body;
+}
+
 HTTPClient::Status HTTPRequest::get_http_client_status() const {
 	return client->get_status();
 }
@@ -483,11 +879,11 @@ int HTTPRequest::get_max_redirects() const {
 	return max_redirects;
 }
 
-int HTTPRequest::get_downloaded_bytes() const {
+int64_t HTTPRequest::get_downloaded_bytes() const {
 
 	return downloaded;
 }
-int HTTPRequest::get_body_size() const {
+int64_t HTTPRequest::get_body_size() const {
 	return body_len;
 }
 
@@ -527,6 +923,18 @@ void HTTPRequest::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_download_file", "path"), &HTTPRequest::set_download_file);
 	ClassDB::bind_method(D_METHOD("get_download_file"), &HTTPRequest::get_download_file);
 
+	ClassDB::bind_method(D_METHOD("set_use_connection_pool", "enable"), &HTTPRequest::set_use_connection_pool);
+	ClassDB::bind_method(D_METHOD("is_using_connection_pool"), &HTTPRequest::is_using_connection_pool);
+
+	ClassDB::bind_method(D_METHOD("set_download_resume", "enabled"), &HTTPRequest::set_download_resume);
+	ClassDB::bind_method(D_METHOD("is_download_resume_enabled"), &HTTPRequest::is_download_resume_enabled);
+
+	ClassDB::bind_method(D_METHOD("set_download_connections", "connections"), &HTTPRequest::set_download_connections);
+	ClassDB::bind_method(D_METHOD("get_download_connections"), &HTTPRequest::get_download_connections);
+
+	ClassDB::bind_method(D_METHOD("set_stream_body", "enabled"), &HTTPRequest::set_stream_body);
+	ClassDB::bind_method(D_METHOD("is_body_streamed"), &HTTPRequest::is_body_streamed);
+
 	ClassDB::bind_method(D_METHOD("get_downloaded_bytes"), &HTTPRequest::get_downloaded_bytes);
 	ClassDB::bind_method(D_METHOD("get_body_size"), &HTTPRequest::get_body_size);
 
@@ -543,11 +951,16 @@ void HTTPRequest::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "download_file", PROPERTY_HINT_FILE), "set_download_file", "get_download_file");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "download_chunk_size", PROPERTY_HINT_RANGE, "256,16777216"), "set_download_chunk_size", "get_download_chunk_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "download_resume"), "set_download_resume", "is_download_resume_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "download_connections", PROPERTY_HINT_RANGE, "1,16"), "set_download_connections", "get_download_connections");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "stream_body"), "set_stream_body", "is_body_streamed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "is_using_threads");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_connection_pool"), "set_use_connection_pool", "is_using_connection_pool");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "body_size_limit", PROPERTY_HINT_RANGE, "-1,2000000000"), "set_body_size_limit", "get_body_size_limit");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_redirects", PROPERTY_HINT_RANGE, "-1,64"), "set_max_redirects", "get_max_redirects");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "timeout", PROPERTY_HINT_RANGE, "0,86400"), "set_timeout", "get_timeout");
 
+	ADD_SIGNAL(MethodInfo("body_chunk_received", PropertyInfo(Variant::POOL_BYTE_ARRAY, "chunk")));
 	ADD_SIGNAL(MethodInfo("request_completed", PropertyInfo(Variant::INT, "result"), PropertyInfo(Variant::INT, "response_code"), PropertyInfo(Variant::POOL_STRING_ARRAY, "headers"), PropertyInfo(Variant::POOL_BYTE_ARRAY, "body")));
 
 	BIND_ENUM_CONSTANT(RESULT_SUCCESS);
@@ -586,6 +999,15 @@ HTTPRequest::HTTPRequest() {
 	downloaded = 0;
 	body_size_limit = -1;
 	file = NULL;
+	use_connection_pool = false;
+	pooled_connection = false;
+	download_resume = false;
+	download_connections = 1;
+	stream_body = false;
+	download_offset = 0;
+	part_end = -1;
+	body_received = 0;
+	main_done = false;
 
 	timer = memnew(Timer);
 	timer->set_one_shot(true);
@@ -594,6 +1016,25 @@ HTTPRequest::HTTPRequest() {
 	timeout = 0;
 }
 
+void HTTPRequest::initialize_connection_pool() {
+
+	pool_mutex = Mutex::create();
+}
+
+void HTTPRequest::finalize_connection_pool() {
+
+	const String *k = NULL;
+	while ((k = pool.next(k))) {
+		for (List<PooledConnection>::Element *E = pool[*k].front(); E; E = E->next()) {
+			E->get().client->close();
+		}
+	}
+	pool.clear();
+
+	memdelete(pool_mutex);
+	pool_mutex = NULL;
+}
+
 HTTPRequest::~HTTPRequest() {
 	if (file)
 		memdelete(file);
@@ -31,8 +31,10 @@
 #ifndef HTTPREQUEST_H
 #define HTTPREQUEST_H
 
+#include "core/hash_map.h"
 #include "core/io/http_client.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "node.h"
 #include "scene/main/timer.h"
@@ -73,6 +75,8 @@ private:
 
 	bool request_sent;
 	Ref<HTTPClient> client;
+	bool use_connection_pool;
+	bool pooled_connection;
 	PoolByteArray body;
 	volatile bool use_threads;
 
@@ -81,15 +85,48 @@ private:
 	PoolVector<String> response_headers;
 
 	String download_to_file;
+	bool download_resume;
+	int download_connections;
+	bool stream_body;
 
 	FileAccess *file;
 
-	int body_len;
-	volatile int downloaded;
+	int64_t body_len;
+	volatile int64_t downloaded;
 	int body_size_limit;
 
+	// Resumed downloads start writing at download_offset, parallel ones split the
+	// body between the main connection (up to part_end) and the parts.
+	struct DownloadPart {
+		Ref<HTTPClient> client;
+		int64_t from;
+		int64_t to;
+		int64_t received;
+		bool request_sent;
+	};
+
+	int64_t download_offset;
+	int64_t part_end;
+	int64_t body_received;
+	bool main_done;
+	Vector<DownloadPart> parts;
+
 	int redirections;
 
+	// Idle keep-alive connections shared by all requests, keyed by host, port and TLS settings.
+	struct PooledConnection {
+		Ref<HTTPClient> client;
+		uint64_t last_used;
+	};
+
+	static Mutex *pool_mutex;
+	static HashMap<String, List<PooledConnection> > pool;
+
+	String _get_pool_key() const;
+	bool _acquire_pooled_connection();
+	void _release_pooled_connection();
+	bool _retry_connection();
+
 	bool _update_connection();
 
 	int max_redirects;
@@ -99,6 +136,10 @@ private:
 	void _redirect_request(const String &p_new_url);
 
 	bool _handle_response(bool *ret_value);
+	bool _open_download_file();
+	void _start_parts();
+	bool _update_parts();
+	void _store_body(const PoolByteArray &p_chunk);
 
 	Error _parse_url(const String &p_url);
 	Error _request();
@@ -123,12 +164,24 @@ public:
 	void set_use_threads(bool p_use);
 	bool is_using_threads() const;
 
+	void set_use_connection_pool(bool p_use);
+	bool is_using_connection_pool() const;
+
 	void set_download_file(const String &p_file);
 	String get_download_file() const;
 
 	void set_download_chunk_size(int p_chunk_size);
 	int get_download_chunk_size() const;
 
+	void set_download_resume(bool p_enabled);
+	bool is_download_resume_enabled() const;
+
+	void set_download_connections(int p_connections);
+	int get_download_connections() const;
+
+	void set_stream_body(bool p_enabled);
+	bool is_body_streamed() const;
+
 	void set_body_size_limit(int p_bytes);
 	int get_body_size_limit() const;
 
@@ -142,8 +195,11 @@ public:
 
 	void _timeout();
 
-	int get_downloaded_bytes() const;
-	int get_body_size() const;
+	int64_t get_downloaded_bytes() const;
+	int64_t get_body_size() const;
+
+	static void initialize_connection_pool();
+	static void finalize_connection_pool();
 
 	HTTPRequest();
 	~HTTPRequest();
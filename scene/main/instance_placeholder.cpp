@@ -31,6 +31,7 @@
 #include "instance_placeholder.h"
 
 #include "core/io/resource_loader.h"
+#include "core/message_queue.h"
 #include "scene/resources/packed_scene.h"
 
 bool InstancePlaceholder::_set(const StringName &p_name, const Variant &p_value) {
@@ -117,6 +118,101 @@ void InstancePlaceholder::replace_by_instance(const Ref<PackedScene> &p_custom_s
 	create_instance(true, p_custom_scene);
 }
 
+Error InstancePlaceholder::create_instance_async(bool p_replace, const Ref<PackedScene> &p_custom_scene) {
+
+	ERR_FAIL_COND_V(!is_inside_tree(), ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V_MSG(async_request, ERR_BUSY, "An asynchronous instance is already being created for this placeholder.");
+
+	AsyncRequest *request = memnew(AsyncRequest);
+	request->placeholder = get_instance_id();
+	request->path = path;
+	request->threaded_load = false;
+	request->replace = p_replace;
+	request->name = get_name();
+	request->values = stored_values; //copied, the placeholder may still be edited while the task runs
+	request->result = NULL;
+
+	if (p_custom_scene.is_valid()) {
+		request->scene = p_custom_scene;
+	} else {
+		Error err = ResourceLoader::load_threaded_request(path, "PackedScene", true);
+		if (err != OK) {
+			memdelete(request);
+			ERR_FAIL_V_MSG(err, "Failed to request loading of the placeholder scene: " + path + ".");
+		}
+		request->threaded_load = true;
+	}
+
+	async_request = request;
+	request->task = WorkerThreadPool::get_singleton()->add_native_task(&InstancePlaceholder::_async_instance_task, request);
+
+	return OK;
+}
+
+bool InstancePlaceholder::is_instancing_async() const {
+
+	return async_request != NULL;
+}
+
+void InstancePlaceholder::_async_instance_task(void *p_userdata, uint32_t) {
+
+	//runs on a worker, the new nodes are not inside any tree so building them touches nothing shared
+	AsyncRequest *request = (AsyncRequest *)p_userdata;
+
+	if (request->threaded_load) {
+		request->scene = ResourceLoader::load_threaded_get(request->path);
+	}
+
+	if (request->scene.is_valid()) {
+		Node *scene = request->scene->instance();
+		if (scene) {
+			scene->set_name(request->name);
+			for (List<PropSet>::Element *E = request->values.front(); E; E = E->next()) {
+				scene->set(E->get().name, E->get().value);
+			}
+		}
+		request->result = scene;
+	}
+
+	//if the placeholder is gone by the time the queue is flushed the call is dropped, its destructor cleans up
+	MessageQueue::get_singleton()->push_call(request->placeholder, "_async_instance_done");
+}
+
+void InstancePlaceholder::_async_instance_done() {
+
+	ERR_FAIL_COND(!async_request);
+
+	AsyncRequest *request = async_request;
+	async_request = NULL;
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(request->task);
+
+	Node *scene = request->result;
+	bool replace = request->replace;
+	String scene_path = request->path;
+	memdelete(request);
+
+	if (!scene) {
+		ERR_PRINT("Failed to instance the placeholder scene: " + scene_path + ".");
+		emit_signal("instance_created", Variant());
+		return;
+	}
+
+	Node *base = get_parent();
+	if (base && is_inside_tree()) {
+		int pos = get_position_in_parent();
+
+		if (replace) {
+			queue_delete();
+			base->remove_child(this);
+		}
+
+		base->add_child(scene);
+		base->move_child(scene, pos);
+	}
+
+	emit_signal("instance_created", scene);
+}
+
 Dictionary InstancePlaceholder::get_stored_values(bool p_with_order) {
 
 	Dictionary ret;
@@ -139,8 +235,28 @@ void InstancePlaceholder::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_stored_values", "with_order"), &InstancePlaceholder::get_stored_values, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("create_instance", "replace", "custom_scene"), &InstancePlaceholder::create_instance, DEFVAL(false), DEFVAL(Variant()));
 	ClassDB::bind_method(D_METHOD("replace_by_instance", "custom_scene"), &InstancePlaceholder::replace_by_instance, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("create_instance_async", "replace", "custom_scene"), &InstancePlaceholder::create_instance_async, DEFVAL(false), DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("is_instancing_async"), &InstancePlaceholder::is_instancing_async);
 	ClassDB::bind_method(D_METHOD("get_instance_path"), &InstancePlaceholder::get_instance_path);
+
+	ClassDB::bind_method(D_METHOD("_async_instance_done"), &InstancePlaceholder::_async_instance_done);
+
+	ADD_SIGNAL(MethodInfo("instance_created", PropertyInfo(Variant::OBJECT, "node", PROPERTY_HINT_RESOURCE_TYPE, "Node")));
 }
 
 InstancePlaceholder::InstancePlaceholder() {
+
+	async_request = NULL;
+}
+
+InstancePlaceholder::~InstancePlaceholder() {
+
+	if (async_request) {
+		//freed before the instance was delivered, nobody else owns the nodes built for it
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(async_request->task);
+		if (async_request->result) {
+			memdelete(async_request->result);
+		}
+		memdelete(async_request);
+	}
 }
@@ -31,6 +31,7 @@
 #ifndef INSTANCE_PLACEHOLDER_H
 #define INSTANCE_PLACEHOLDER_H
 
+#include "core/os/worker_thread_pool.h"
 #include "scene/main/node.h"
 
 class PackedScene;
@@ -47,6 +48,23 @@ class InstancePlaceholder : public Node {
 
 	List<PropSet> stored_values;
 
+	struct AsyncRequest {
+		ObjectID placeholder;
+		String path;
+		Ref<PackedScene> scene;
+		bool threaded_load; //the scene was requested from the threaded loader and is fetched by the task
+		bool replace;
+		StringName name;
+		List<PropSet> values;
+		Node *result;
+		WorkerThreadPool::TaskID task;
+	};
+
+	AsyncRequest *async_request;
+
+	static void _async_instance_task(void *p_userdata, uint32_t p_index);
+	void _async_instance_done();
+
 protected:
 	bool _set(const StringName &p_name, const Variant &p_value);
 	bool _get(const StringName &p_name, Variant &r_ret) const;
@@ -63,7 +81,11 @@ public:
 	Node *create_instance(bool p_replace = false, const Ref<PackedScene> &p_custom_scene = Ref<PackedScene>());
 	void replace_by_instance(const Ref<PackedScene> &p_custom_scene = Ref<PackedScene>());
 
+	Error create_instance_async(bool p_replace = false, const Ref<PackedScene> &p_custom_scene = Ref<PackedScene>());
+	bool is_instancing_async() const;
+
 	InstancePlaceholder();
+	~InstancePlaceholder();
 };
 
 #endif // INSTANCE_PLACEHOLDER_H
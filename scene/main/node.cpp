@@ -45,6 +45,18 @@
 
 VARIANT_ENUM_CAST(Node::PauseMode);
 
+#ifdef DEBUG_ENABLED
+// sub-thread process groups run in parallel, they may only touch the nodes of their own group
+// and can't change the structure of the tree, which is shared by every group.
+#define ERR_FAIL_THREAD_GROUP_ACCESS() \
+	ERR_FAIL_COND_MSG(!is_accessible_from_caller_thread(), "Node '" + String(get_name()) + "' belongs to another process thread group and can't be changed from this thread. Use call_deferred_thread_group() instead.")
+#define ERR_FAIL_THREAD_GROUP_TREE_CHANGE() \
+	ERR_FAIL_COND_MSG(data.inside_tree && SceneTree::current_process_group, "The scene tree can't be changed while processing a sub-thread group (node '" + String(get_name()) + "'). Use call_deferred_thread_group() instead.")
+#else
+#define ERR_FAIL_THREAD_GROUP_ACCESS()
+#define ERR_FAIL_THREAD_GROUP_TREE_CHANGE()
+#endif
+
 int Node::orphan_node_count = 0;
 
 void Node::_notification(int p_notification) {
@@ -219,6 +231,20 @@ void Node::_propagate_enter_tree() {
 		E->get().group = data.tree->add_to_group(E->key(), this);
 	}
 
+	if (data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+		data.process_thread_group_owner = data.parent ? data.parent->data.process_thread_group_owner : NULL;
+		data.process_group = data.parent ? data.parent->data.process_group : &data.tree->main_process_group;
+	} else {
+		data.process_thread_group_owner = this;
+		data.process_group = data.process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD ? data.tree->_add_process_group(this) : &data.tree->main_process_group;
+	}
+
+	const bool processing[SceneTree::PROCESS_LIST_MAX] = { data.idle_process, data.idle_process_internal, data.physics_process, data.physics_process_internal };
+	for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+		if (processing[i])
+			data.tree->_process_list_add(SceneTree::ProcessList(i), this);
+	}
+
 	notification(NOTIFICATION_ENTER_TREE);
 
 	if (get_script_instance()) {
@@ -313,6 +339,16 @@ void Node::_propagate_exit_tree() {
 		E->get().group = NULL;
 	}
 
+	for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+		data.tree->_process_list_remove(SceneTree::ProcessList(i), this);
+	}
+
+	//children left already, so an owned group is empty
+	if (data.process_thread_group_owner == this && data.process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD)
+		data.tree->_remove_process_group(data.process_group);
+	data.process_thread_group_owner = NULL;
+	data.process_group = NULL;
+
 	data.viewport = NULL;
 
 	if (data.tree)
@@ -327,6 +363,7 @@ void Node::_propagate_exit_tree() {
 void Node::move_child(Node *p_child, int p_pos) {
 
 	ERR_FAIL_NULL(p_child);
+	ERR_FAIL_THREAD_GROUP_TREE_CHANGE();
 	ERR_FAIL_INDEX_MSG(p_pos, data.children.size() + 1, "Invalid new child position: " + itos(p_pos) + ".");
 	ERR_FAIL_COND_MSG(p_child->data.parent != this, "Child is not a child of this node.");
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, move_child() failed. Consider using call_deferred(\"move_child\") instead (or \"popup\" if this is from a popup).");
@@ -364,6 +401,12 @@ void Node::move_child(Node *p_child, int p_pos) {
 		if (E->get().group)
 			E->get().group->changed = true;
 	}
+	if (data.tree) {
+		for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+			if (p_child->data.process_list_pos[i] != -1)
+				data.tree->_process_list_changed(SceneTree::ProcessList(i), p_child);
+		}
+	}
 
 	data.blocked--;
 }
@@ -393,15 +436,19 @@ void Node::move_child_notify(Node *p_child) {
 
 void Node::set_physics_process(bool p_process) {
 
+	ERR_FAIL_THREAD_GROUP_ACCESS();
+
 	if (data.physics_process == p_process)
 		return;
 
 	data.physics_process = p_process;
 
-	if (data.physics_process)
-		add_to_group("physics_process", false);
-	else
-		remove_from_group("physics_process");
+	if (data.inside_tree) {
+		if (data.physics_process)
+			data.tree->_process_list_add(SceneTree::PROCESS_LIST_PHYSICS, this);
+		else
+			data.tree->_process_list_remove(SceneTree::PROCESS_LIST_PHYSICS, this);
+	}
 
 	_change_notify("physics_process");
 }
@@ -413,15 +460,19 @@ bool Node::is_physics_processing() const {
 
 void Node::set_physics_process_internal(bool p_process_internal) {
 
+	ERR_FAIL_THREAD_GROUP_ACCESS();
+
 	if (data.physics_process_internal == p_process_internal)
 		return;
 
 	data.physics_process_internal = p_process_internal;
 
-	if (data.physics_process_internal)
-		add_to_group("physics_process_internal", false);
-	else
-		remove_from_group("physics_process_internal");
+	if (data.inside_tree) {
+		if (data.physics_process_internal)
+			data.tree->_process_list_add(SceneTree::PROCESS_LIST_PHYSICS_INTERNAL, this);
+		else
+			data.tree->_process_list_remove(SceneTree::PROCESS_LIST_PHYSICS_INTERNAL, this);
+	}
 
 	_change_notify("physics_process_internal");
 }
@@ -461,6 +512,125 @@ Node::PauseMode Node::get_pause_mode() const {
 	return data.pause_mode;
 }
 
+void Node::set_process_thread_group(ProcessThreadGroup p_mode) {
+
+	ERR_FAIL_INDEX(p_mode, 3);
+	ERR_FAIL_THREAD_GROUP_TREE_CHANGE();
+
+	if (data.process_thread_group == p_mode)
+		return;
+
+	ProcessThreadGroup prev_mode = data.process_thread_group;
+	data.process_thread_group = p_mode;
+	if (!is_inside_tree())
+		return;
+
+	//the group this node owned so far, if any, is released once its nodes moved out
+	SceneTree::ProcessGroup *prev_group = NULL;
+	if (prev_mode == PROCESS_THREAD_GROUP_SUB_THREAD)
+		prev_group = data.process_group;
+
+	Node *owner = NULL;
+	SceneTree::ProcessGroup *group = NULL;
+
+	if (data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+
+		owner = data.parent ? data.parent->data.process_thread_group_owner : NULL;
+		group = data.parent ? data.parent->data.process_group : &data.tree->main_process_group;
+	} else {
+		owner = this;
+		group = data.process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD ? data.tree->_add_process_group(this) : &data.tree->main_process_group;
+	}
+
+	_propagate_process_group(owner, group);
+
+	if (prev_group)
+		data.tree->_remove_process_group(prev_group);
+}
+
+Node::ProcessThreadGroup Node::get_process_thread_group() const {
+
+	return data.process_thread_group;
+}
+
+void Node::_propagate_process_group(Node *p_owner, SceneTree::ProcessGroup *p_group) {
+
+	if (this != p_owner && data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT)
+		return;
+	data.process_thread_group_owner = p_owner;
+
+	if (data.process_group != p_group) {
+
+		bool listed[SceneTree::PROCESS_LIST_MAX];
+		for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+			listed[i] = data.process_list_pos[i] != -1;
+			data.tree->_process_list_remove(SceneTree::ProcessList(i), this);
+		}
+
+		data.process_group = p_group;
+
+		for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+			if (listed[i])
+				data.tree->_process_list_add(SceneTree::ProcessList(i), this);
+		}
+	}
+
+	for (int i = 0; i < data.children.size(); i++) {
+
+		data.children[i]->_propagate_process_group(p_owner, p_group);
+	}
+}
+
+bool Node::is_accessible_from_caller_thread() const {
+
+	if (!data.inside_tree || !SceneTree::current_process_group)
+		return true;
+
+	return data.process_group == SceneTree::current_process_group;
+}
+
+void Node::call_deferred_thread_group(const StringName &p_method, VARIANT_ARG_DECLARE) {
+
+	VARIANT_ARGPTRS;
+
+	int argc = 0;
+	for (int i = 0; i < VARIANT_ARG_MAX; i++) {
+		if (argptr[i]->get_type() == Variant::NIL)
+			break;
+		argc++;
+	}
+
+	if (!SceneTree::_push_thread_group_call(get_instance_id(), p_method, argptr, argc)) {
+		MessageQueue::get_singleton()->push_call(get_instance_id(), p_method, argptr, argc);
+	}
+}
+
+Variant Node::_call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+
+	if (p_argcount < 1) {
+		r_error.error = Variant::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+		r_error.argument = 0;
+		return Variant();
+	}
+
+	if (p_args[0]->get_type() != Variant::STRING) {
+		r_error.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
+		r_error.argument = 0;
+		r_error.expected = Variant::STRING;
+		return Variant();
+	}
+
+	r_error.error = Variant::CallError::CALL_OK;
+
+	StringName method = *p_args[0];
+
+	if (!SceneTree::_push_thread_group_call(get_instance_id(), method, &p_args[1], p_argcount - 1)) {
+		MessageQueue::get_singleton()->push_call(get_instance_id(), method, &p_args[1], p_argcount - 1);
+	}
+
+	return Variant();
+}
+
 void Node::_propagate_pause_owner(Node *p_owner) {
 
 	if (this != p_owner && data.pause_mode != PAUSE_MODE_INHERIT)
@@ -794,15 +964,19 @@ float Node::get_process_delta_time() const {
 
 void Node::set_process(bool p_idle_process) {
 
+	ERR_FAIL_THREAD_GROUP_ACCESS();
+
 	if (data.idle_process == p_idle_process)
 		return;
 
 	data.idle_process = p_idle_process;
 
-	if (data.idle_process)
-		add_to_group("idle_process", false);
-	else
-		remove_from_group("idle_process");
+	if (data.inside_tree) {
+		if (data.idle_process)
+			data.tree->_process_list_add(SceneTree::PROCESS_LIST_IDLE, this);
+		else
+			data.tree->_process_list_remove(SceneTree::PROCESS_LIST_IDLE, this);
+	}
 
 	_change_notify("idle_process");
 }
@@ -814,15 +988,19 @@ bool Node::is_processing() const {
 
 void Node::set_process_internal(bool p_idle_process_internal) {
 
+	ERR_FAIL_THREAD_GROUP_ACCESS();
+
 	if (data.idle_process_internal == p_idle_process_internal)
 		return;
 
 	data.idle_process_internal = p_idle_process_internal;
 
-	if (data.idle_process_internal)
-		add_to_group("idle_process_internal", false);
-	else
-		remove_from_group("idle_process_internal");
+	if (data.inside_tree) {
+		if (data.idle_process_internal)
+			data.tree->_process_list_add(SceneTree::PROCESS_LIST_IDLE_INTERNAL, this);
+		else
+			data.tree->_process_list_remove(SceneTree::PROCESS_LIST_IDLE_INTERNAL, this);
+	}
 
 	_change_notify("idle_process_internal");
 }
@@ -833,6 +1011,7 @@ bool Node::is_processing_internal() const {
 }
 
 void Node::set_process_priority(int p_priority) {
+	ERR_FAIL_THREAD_GROUP_ACCESS();
 	data.process_priority = p_priority;
 
 	// Make sure we are in SceneTree.
@@ -840,20 +1019,9 @@ void Node::set_process_priority(int p_priority) {
 		return;
 	}
 
-	if (is_processing()) {
-		data.tree->make_group_changed("idle_process");
-	}
-
-	if (is_processing_internal()) {
-		data.tree->make_group_changed("idle_process_internal");
-	}
-
-	if (is_physics_processing()) {
-		data.tree->make_group_changed("physics_process");
-	}
-
-	if (is_physics_processing_internal()) {
-		data.tree->make_group_changed("physics_process_internal");
+	for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+		if (data.process_list_pos[i] != -1)
+			data.tree->_process_list_changed(SceneTree::ProcessList(i), this);
 	}
 }
 
@@ -942,6 +1110,8 @@ bool Node::_validate_node_name(String &p_name) {
 
 void Node::set_name(const String &p_name) {
 
+	ERR_FAIL_THREAD_GROUP_TREE_CHANGE();
+
 	String name = p_name;
 	_validate_node_name(name);
 
@@ -1064,7 +1234,8 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 
 		name = p_child->get_class();
 		// Adjust casing according to project setting. The current type name is expected to be in PascalCase.
-		switch (ProjectSettings::get_singleton()->get("node/name_casing").operator int()) {
+		static ProjectSettings::Handle<int> name_casing("node/name_casing");
+		switch (name_casing.get()) {
 			case NAME_CASING_PASCAL_CASE:
 				break;
 			case NAME_CASING_CAMEL_CASE: {
@@ -1172,6 +1343,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 void Node::add_child(Node *p_child, bool p_legible_unique_name) {
 
 	ERR_FAIL_NULL(p_child);
+	ERR_FAIL_THREAD_GROUP_TREE_CHANGE();
 	ERR_FAIL_COND_MSG(p_child == this, "Can't add child '" + p_child->get_name() + "' to itself."); // adding to itself!
 	ERR_FAIL_COND_MSG(p_child->data.parent, "Can't add child '" + p_child->get_name() + "' to '" + get_name() + "', already has a parent '" + p_child->data.parent->get_name() + "'."); //Fail if node has a parent
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, add_node() failed. Consider using call_deferred(\"add_child\", child) instead.");
@@ -1230,6 +1402,7 @@ void Node::_propagate_validate_owner() {
 void Node::remove_child(Node *p_child) {
 
 	ERR_FAIL_NULL(p_child);
+	ERR_FAIL_THREAD_GROUP_TREE_CHANGE();
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, remove_node() failed. Consider using call_deferred(\"remove_child\", child) instead.");
 
 	int child_count = data.children.size();
@@ -1675,6 +1848,7 @@ bool Node::is_in_group(const StringName &p_identifier) const {
 void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 
 	ERR_FAIL_COND(!p_identifier.operator String().length());
+	ERR_FAIL_THREAD_GROUP_TREE_CHANGE();
 
 	if (data.grouped.has(p_identifier))
 		return;
@@ -1695,6 +1869,7 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 void Node::remove_from_group(const StringName &p_identifier) {
 
 	ERR_FAIL_COND(!data.grouped.has(p_identifier));
+	ERR_FAIL_THREAD_GROUP_TREE_CHANGE();
 
 	Map<StringName, GroupData>::Element *E = data.grouped.find(p_identifier);
 
@@ -2609,6 +2784,12 @@ void Node::print_stray_nodes() {
 
 void Node::queue_delete() {
 
+	//the delete queue belongs to the main thread
+	if (SceneTree::current_process_group) {
+		SceneTree::_push_thread_group_call(get_instance_id(), "queue_free", NULL, 0);
+		return;
+	}
+
 	if (is_inside_tree()) {
 		get_tree()->queue_delete(this);
 	} else {
@@ -2778,6 +2959,9 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_pause_mode", "mode"), &Node::set_pause_mode);
 	ClassDB::bind_method(D_METHOD("get_pause_mode"), &Node::get_pause_mode);
 	ClassDB::bind_method(D_METHOD("can_process"), &Node::can_process);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group", "mode"), &Node::set_process_thread_group);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
+	ClassDB::bind_method(D_METHOD("is_accessible_from_caller_thread"), &Node::is_accessible_from_caller_thread);
 	ClassDB::bind_method(D_METHOD("print_stray_nodes"), &Node::_print_stray_nodes);
 	ClassDB::bind_method(D_METHOD("get_position_in_parent"), &Node::get_position_in_parent);
 
@@ -2841,6 +3025,14 @@ void Node::_bind_methods() {
 		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "rpc_unreliable_id", &Node::_rpc_unreliable_id_bind, mi);
 	}
 
+	{
+		MethodInfo mi;
+		mi.name = "call_deferred_thread_group";
+		mi.arguments.push_back(PropertyInfo(Variant::STRING, "method"));
+
+		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "call_deferred_thread_group", &Node::_call_deferred_thread_group_bind, mi, varray(), false);
+	}
+
 	ClassDB::bind_method(D_METHOD("rset", "property", "value"), &Node::rset);
 	ClassDB::bind_method(D_METHOD("rset_id", "peer_id", "property", "value"), &Node::rset_id);
 	ClassDB::bind_method(D_METHOD("rset_unreliable", "property", "value"), &Node::rset_unreliable);
@@ -2884,6 +3076,10 @@ void Node::_bind_methods() {
 	BIND_ENUM_CONSTANT(PAUSE_MODE_STOP);
 	BIND_ENUM_CONSTANT(PAUSE_MODE_PROCESS);
 
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_INHERIT);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_MAIN_THREAD);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_SUB_THREAD);
+
 	BIND_ENUM_CONSTANT(DUPLICATE_SIGNALS);
 	BIND_ENUM_CONSTANT(DUPLICATE_GROUPS);
 	BIND_ENUM_CONSTANT(DUPLICATE_SCRIPTS);
@@ -2909,6 +3105,7 @@ void Node::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "multiplayer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerAPI", 0), "", "get_multiplayer");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "custom_multiplayer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerAPI", 0), "set_custom_multiplayer", "get_custom_multiplayer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
 
 	BIND_VMETHOD(MethodInfo("_process", PropertyInfo(Variant::REAL, "delta")));
 	BIND_VMETHOD(MethodInfo("_physics_process", PropertyInfo(Variant::REAL, "delta")));
@@ -2922,7 +3119,8 @@ void Node::_bind_methods() {
 }
 
 String Node::_get_name_num_separator() {
-	switch (ProjectSettings::get_singleton()->get("node/name_num_separator").operator int()) {
+	static ProjectSettings::Handle<int> name_num_separator("node/name_num_separator");
+	switch (name_num_separator.get()) {
 		case 0: return "";
 		case 1: return " ";
 		case 2: return "_";
@@ -2943,6 +3141,9 @@ Node::Node() {
 	data.process_priority = 0;
 	data.physics_process_internal = false;
 	data.idle_process_internal = false;
+	for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+		data.process_list_pos[i] = -1;
+	}
 	data.inside_tree = false;
 	data.ready_notified = false;
 
@@ -2953,6 +3154,9 @@ Node::Node() {
 	data.unhandled_key_input = false;
 	data.pause_mode = PAUSE_MODE_INHERIT;
 	data.pause_owner = NULL;
+	data.process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
+	data.process_thread_group_owner = NULL;
+	data.process_group = NULL;
 	data.network_master = 1; //server by default
 	data.path_cache = NULL;
 	data.parent_owned = false;
@@ -54,6 +54,13 @@ public:
 		PAUSE_MODE_PROCESS
 	};
 
+	enum ProcessThreadGroup {
+
+		PROCESS_THREAD_GROUP_INHERIT,
+		PROCESS_THREAD_GROUP_MAIN_THREAD,
+		PROCESS_THREAD_GROUP_SUB_THREAD
+	};
+
 	enum DuplicateFlags {
 
 		DUPLICATE_SIGNALS = 1,
@@ -117,6 +124,10 @@ private:
 		PauseMode pause_mode;
 		Node *pause_owner;
 
+		ProcessThreadGroup process_thread_group;
+		Node *process_thread_group_owner;
+		SceneTree::ProcessGroup *process_group; // group whose process lists this node is kept in while inside the tree
+
 		int network_master;
 		Map<StringName, MultiplayerAPI::RPCMode> rpc_methods;
 		Map<StringName, MultiplayerAPI::RPCMode> rpc_properties;
@@ -130,6 +141,9 @@ private:
 		bool physics_process_internal;
 		bool idle_process_internal;
 
+		// position in each SceneTree process list, -1 when not in it, below -1 when pending
+		int process_list_pos[SceneTree::PROCESS_LIST_MAX];
+
 		bool input;
 		bool unhandled_input;
 		bool unhandled_key_input;
@@ -171,6 +185,7 @@ private:
 	void _propagate_validate_owner();
 	void _print_stray_nodes();
 	void _propagate_pause_owner(Node *p_owner);
+	void _propagate_process_group(Node *p_owner, SceneTree::ProcessGroup *p_group);
 	Array _get_node_and_resource(const NodePath &p_path);
 
 	void _duplicate_signals(const Node *p_original, Node *p_copy) const;
@@ -180,6 +195,7 @@ private:
 	Array _get_children() const;
 	Array _get_groups() const;
 
+	Variant _call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 	Variant _rpc_bind(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 	Variant _rpc_unreliable_bind(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 	Variant _rpc_id_bind(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
@@ -388,6 +404,11 @@ public:
 	bool can_process() const;
 	bool can_process_notification(int p_what) const;
 
+	void set_process_thread_group(ProcessThreadGroup p_mode);
+	ProcessThreadGroup get_process_thread_group() const;
+	bool is_accessible_from_caller_thread() const;
+	void call_deferred_thread_group(const StringName &p_method, VARIANT_ARG_LIST);
+
 	void request_ready();
 
 	static void print_stray_nodes();
@@ -454,6 +475,7 @@ public:
 };
 
 VARIANT_ENUM_CAST(Node::DuplicateFlags);
+VARIANT_ENUM_CAST(Node::ProcessThreadGroup);
 
 typedef Set<Node *, Node::Comparator> NodeSet;
 
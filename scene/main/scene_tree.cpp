@@ -30,17 +30,20 @@
 
 #include "scene_tree.h"
 
+#include "core/frame_arena.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/message_queue.h"
 #include "core/os/dir_access.h"
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
 #include "main/input_default.h"
 #include "node.h"
 #include "scene/debugger/script_debugger_remote.h"
+#include "scene/gui/container.h"
 #include "scene/resources/dynamic_font.h"
 #include "scene/resources/material.h"
 #include "scene/resources/mesh.h"
@@ -98,6 +101,7 @@ SceneTreeTimer::SceneTreeTimer() {
 void SceneTree::tree_changed() {
 
 	tree_version++;
+	thread_process_groups_changed = true;
 	emit_signal(tree_changed_name);
 }
 
@@ -151,17 +155,351 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 		E->get().changed = true;
 }
 
+void SceneTree::_process_list_add(ProcessList p_list, Node *p_node) {
+
+	int &pos = p_node->data.process_list_pos[p_list];
+	ERR_FAIL_COND(pos != -1);
+
+	ProcessNodes &pl = p_node->data.process_group->lists[p_list];
+	pos = -2 - pl.pending.size();
+	pl.pending.push_back(p_node);
+}
+
+void SceneTree::_process_list_remove(ProcessList p_list, Node *p_node) {
+
+	int &pos = p_node->data.process_list_pos[p_list];
+	if (pos == -1)
+		return;
+
+	ProcessNodes &pl = p_node->data.process_group->lists[p_list];
+	if (pos >= 0) {
+		pl.nodes.write[pos] = NULL;
+	} else {
+		pl.pending.write[-2 - pos] = NULL;
+	}
+	pl.removed++;
+	pos = -1;
+}
+
+void SceneTree::_process_list_changed(ProcessList p_list, Node *p_node) {
+
+	p_node->data.process_group->lists[p_list].changed = true;
+}
+
+void SceneTree::_update_process_list(ProcessGroup *p_group, ProcessList p_list) {
+
+	ProcessNodes &pl = p_group->lists[p_list];
+	if (pl.pending.empty() && pl.removed == 0 && !pl.changed)
+		return;
+
+	Node::ComparatorWithPriority compare;
+
+	//drop the holes left by removed nodes
+	int current_count = 0;
+	Node **current = pl.nodes.ptrw();
+	for (int i = 0; i < pl.nodes.size(); i++) {
+		if (current[i])
+			current[current_count++] = current[i];
+	}
+
+	int pending_count = 0;
+	Node **pending = pl.pending.ptrw();
+	for (int i = 0; i < pl.pending.size(); i++) {
+		if (pending[i])
+			pending[pending_count++] = pending[i];
+	}
+
+	Vector<Node *> merged;
+	merged.resize(current_count + pending_count);
+	Node **dst = merged.ptrw();
+
+	if (pl.changed) {
+		//priorities or tree order changed, sort everything again
+		copymem(dst, current, current_count * sizeof(Node *));
+		copymem(dst + current_count, pending, pending_count * sizeof(Node *));
+		SortArray<Node *, Node::ComparatorWithPriority> node_sort;
+		node_sort.sort(dst, current_count + pending_count);
+	} else {
+		//the list is still sorted, only the new nodes need sorting before being merged in
+		SortArray<Node *, Node::ComparatorWithPriority> node_sort;
+		node_sort.sort(pending, pending_count);
+
+		int a = 0;
+		int b = 0;
+		int d = 0;
+		while (a < current_count && b < pending_count) {
+			if (compare(pending[b], current[a])) {
+				dst[d++] = pending[b++];
+			} else {
+				dst[d++] = current[a++];
+			}
+		}
+		while (a < current_count) {
+			dst[d++] = current[a++];
+		}
+		while (b < pending_count) {
+			dst[d++] = pending[b++];
+		}
+	}
+
+	for (int i = 0; i < merged.size(); i++) {
+		dst[i]->data.process_list_pos[p_list] = i;
+	}
+
+	pl.nodes = merged;
+	pl.pending.clear();
+	pl.removed = 0;
+	pl.changed = false;
+}
+
+void SceneTree::_notify_process_group(ProcessGroup *p_group, ProcessList p_list, int p_notification) {
+
+	_update_process_list(p_group, p_list);
+
+	ProcessNodes &pl = p_group->lists[p_list];
+
+	//nodes added while processing wait in the pending list until the next frame,
+	//removed ones are cleared in place, so no copy of the list is needed.
+	int node_count = pl.nodes.size();
+	for (int i = 0; i < node_count; i++) {
+
+		Node *n = pl.nodes[i];
+		if (!n)
+			continue;
+
+		if (!n->can_process())
+			continue;
+
+		n->notification(p_notification);
+	}
+}
+
+void SceneTree::_notify_process_list(ProcessList p_list, int p_notification) {
+
+	if (thread_process_groups.size()) {
+
+		if (thread_process_groups_changed) {
+			//keep the order deferred calls are flushed in stable
+			struct GroupSort {
+				bool operator()(const ProcessGroup *p_a, const ProcessGroup *p_b) const { return p_b->owner->is_greater_than(p_a->owner); }
+			};
+
+			SortArray<ProcessGroup *, GroupSort> group_sort;
+			group_sort.sort(thread_process_groups.ptrw(), thread_process_groups.size());
+			thread_process_groups_changed = false;
+		}
+
+		ThreadGroupPass pass;
+		pass.list = p_list;
+		pass.notification = p_notification;
+
+		processing_thread_groups = true;
+		WorkerThreadPool::get_singleton()->parallel_for(thread_process_groups.size(), this, &SceneTree::_process_thread_group, pass);
+		processing_thread_groups = false;
+
+		_flush_thread_group_calls();
+	}
+
+	_notify_process_group(&main_process_group, p_list, p_notification);
+}
+
+SceneTree::ProcessGroup *SceneTree::_add_process_group(Node *p_owner) {
+
+	ERR_FAIL_COND_V(processing_thread_groups, &main_process_group);
+
+	ProcessGroup *group = memnew(ProcessGroup);
+	group->owner = p_owner;
+	thread_process_groups.push_back(group);
+	thread_process_groups_changed = true;
+	return group;
+}
+
+void SceneTree::_remove_process_group(ProcessGroup *p_group) {
+
+	ERR_FAIL_COND(processing_thread_groups);
+
+	thread_process_groups.erase(p_group);
+
+	//calls deferred by the group are still owed to their targets
+	for (int i = 0; i < p_group->calls.size(); i++) {
+		const ThreadGroupCall &call = p_group->calls[i];
+		const Variant *args[VARIANT_ARG_MAX];
+		for (int j = 0; j < call.args.size(); j++) {
+			args[j] = &call.args[j];
+		}
+		MessageQueue::get_singleton()->push_call(call.object, call.method, args, call.args.size());
+	}
+
+	memdelete(p_group);
+}
+
+void SceneTree::_process_thread_group(uint32_t p_index, ThreadGroupPass p_pass) {
+
+	ProcessGroup *group = thread_process_groups[p_index];
+
+	//a waiting thread may run another group's task, so restore the previous one
+	ProcessGroup *prev_group = current_process_group;
+	current_process_group = group;
+	_notify_process_group(group, p_pass.list, p_pass.notification);
+	current_process_group = prev_group;
+}
+
+void SceneTree::_flush_thread_group_calls() {
+
+	for (int i = 0; i < thread_process_groups.size(); i++) {
+
+		Vector<ThreadGroupCall> calls = thread_process_groups[i]->calls;
+		thread_process_groups.write[i]->calls.clear();
+
+		for (int j = 0; j < calls.size(); j++) {
+
+			const ThreadGroupCall &call = calls[j];
+			Object *obj = ObjectDB::get_instance(call.object);
+			if (!obj)
+				continue;
+
+			const Variant *args[VARIANT_ARG_MAX];
+			for (int k = 0; k < call.args.size(); k++) {
+				args[k] = &call.args[k];
+			}
+
+			Variant::CallError ce;
+			obj->call(call.method, args, call.args.size(), ce);
+			if (ce.error != Variant::CallError::CALL_OK) {
+				ERR_PRINT("Error calling deferred method: " + Variant::get_call_error_text(obj, call.method, args, call.args.size(), ce) + ".");
+			}
+		}
+	}
+}
+
+bool SceneTree::_push_thread_group_call(ObjectID p_object, const StringName &p_method, const Variant **p_args, int p_argcount) {
+
+	if (!current_process_group)
+		return false;
+
+	ERR_FAIL_COND_V_MSG(p_argcount > VARIANT_ARG_MAX, false, "Too many arguments for a thread group call, the maximum is " + itos(VARIANT_ARG_MAX) + ".");
+
+	ThreadGroupCall call;
+	call.object = p_object;
+	call.method = p_method;
+	call.args.resize(p_argcount);
+	for (int i = 0; i < p_argcount; i++) {
+		call.args.write[i] = *p_args[i];
+	}
+	current_process_group->calls.push_back(call);
+	return true;
+}
+
 void SceneTree::flush_transform_notifications() {
 
+	begin_instance_batch();
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 
 		Node *node = n->self();
 		SelfList<Node> *nx = n->next();
 		xform_change_list.remove(n);
+		xform_change_version++;
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+	end_instance_batch();
+}
+
+void SceneTree::_queue_container_sort(SelfList<Container> *p_item) {
+
+	if (!p_item->in_list()) {
+		container_sort_list.add(p_item);
+	}
+
+	if (!container_sort_queued) {
+		MessageQueue::get_singleton()->push_call(this, "_flush_container_sorts");
+		container_sort_queued = true;
+	}
+}
+
+void SceneTree::_flush_container_sorts() {
+
+	container_sort_queued = false;
+
+	// sorting a container resizes its children, which queues the child containers again. going parents first,
+	// a child queued before its parent is still pending when the parent resizes it, so it is only sorted once.
+	Vector<Container *> sorting;
+	Vector<ObjectID> sorting_ids;
+
+	while (container_sort_list.first()) {
+
+		sorting.clear();
+		while (SelfList<Container> *E = container_sort_list.first()) {
+			sorting.push_back(E->self());
+			container_sort_list.remove(E);
+		}
+
+		sorting.sort_custom<Node::Comparator>();
+
+		//sorting may free containers
+		sorting_ids.resize(sorting.size());
+		for (int i = 0; i < sorting.size(); i++) {
+			sorting_ids.write[i] = sorting[i]->get_instance_id();
+		}
+
+		for (int i = 0; i < sorting_ids.size(); i++) {
+			Container *container = Object::cast_to<Container>(ObjectDB::get_instance(sorting_ids[i]));
+			if (container && container->pending_sort) {
+				container->_sort_children();
+			}
+		}
+	}
+}
+
+void SceneTree::begin_instance_batch() {
+
+	instance_batch_depth++;
+}
+
+void SceneTree::end_instance_batch() {
+
+	ERR_FAIL_COND(instance_batch_depth == 0);
+
+	instance_batch_depth--;
+	if (instance_batch_depth > 0)
+		return;
+
+	if (batch_xform_instances.size()) {
+		VisualServer::get_singleton()->instances_set_transforms(batch_xform_instances, batch_xforms);
+		batch_xform_instances.clear();
+		batch_xforms.clear();
+	}
+
+	if (batch_visible_instances.size()) {
+		VisualServer::get_singleton()->instances_set_visible(batch_visible_instances, batch_visible);
+		batch_visible_instances.clear();
+		batch_visible.clear();
+	}
+}
+
+void SceneTree::queue_instance_transform(RID p_instance, const Transform &p_transform) {
+
+	if (instance_batch_depth == 0) {
+		VisualServer::get_singleton()->instance_set_transform(p_instance, p_transform);
+		return;
+	}
+
+	batch_xform_instances.push_back(p_instance);
+	batch_xforms.push_back(p_transform);
+}
+
+void SceneTree::queue_instance_visible(RID p_instance, bool p_visible) {
+
+	if (instance_batch_depth == 0) {
+		VisualServer::get_singleton()->instance_set_visible(p_instance, p_visible);
+		return;
+	}
+
+	batch_visible_instances.push_back(p_instance);
+	batch_visible.push_back(p_visible);
 }
 
 void SceneTree::_flush_ugc() {
@@ -239,42 +577,58 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 
 	_update_group_order(g);
 
+	//shares the group's data, it is only copied if one of the calls changes the group
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
-	call_lock++;
+	GroupCallCache *cache = NULL;
+	const Variant **args = NULL;
+	int argc = 0;
+	VARIANT_ARGPTRS;
 
-	if (p_call_flags & GROUP_CALL_REVERSE) {
+	if ((p_call_flags & GROUP_CALL_REALTIME) && !(p_call_flags & GROUP_CALL_MULTILEVEL)) {
 
-		for (int i = node_count - 1; i >= 0; i--) {
+		UGCall key;
+		key.group = p_group;
+		key.call = p_function;
 
-			if (call_lock && call_skip.has(nodes[i]))
-				continue;
+		GroupCallCache **C = group_call_caches.getptr(key);
+		if (C) {
+			cache = *C;
+		} else {
+			cache = memnew(GroupCallCache);
+			group_call_caches.set(key, cache);
+		}
 
-			if (p_call_flags & GROUP_CALL_REALTIME) {
-				if (p_call_flags & GROUP_CALL_MULTILEVEL)
-					nodes[i]->call_multilevel(p_function, VARIANT_ARG_PASS);
-				else
-					nodes[i]->call(p_function, VARIANT_ARG_PASS);
-			} else
-				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
+		for (int i = 0; i < VARIANT_ARG_MAX; i++) {
+			if (argptr[i]->get_type() == Variant::NIL)
+				break;
+			argc++;
 		}
+		args = argptr;
+	}
 
-	} else {
+	call_lock++;
 
-		for (int i = 0; i < node_count; i++) {
+	int from = (p_call_flags & GROUP_CALL_REVERSE) ? node_count - 1 : 0;
+	int to = (p_call_flags & GROUP_CALL_REVERSE) ? -1 : node_count;
+	int step = (p_call_flags & GROUP_CALL_REVERSE) ? -1 : 1;
 
-			if (call_lock && call_skip.has(nodes[i]))
-				continue;
+	for (int i = from; i != to; i += step) {
+
+		if (call_lock && call_skip.has(nodes[i]))
+			continue;
 
-			if (p_call_flags & GROUP_CALL_REALTIME) {
-				if (p_call_flags & GROUP_CALL_MULTILEVEL)
-					nodes[i]->call_multilevel(p_function, VARIANT_ARG_PASS);
-				else
-					nodes[i]->call(p_function, VARIANT_ARG_PASS);
-			} else
-				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
+		if (cache) {
+			//nodes of the same class share a slot, a collision only resolves the method again
+			uint32_t slot = (uint32_t)(((uintptr_t)nodes[i]->get_class_name().data_unique_pointer()) >> 4) & (GROUP_CALL_CACHE_SLOTS - 1);
+			Variant::CallError error;
+			nodes[i]->call_cached(cache->slots[slot], p_function, args, argc, error);
+		} else if (p_call_flags & GROUP_CALL_REALTIME) {
+			nodes[i]->call_multilevel(p_function, VARIANT_ARG_PASS);
+		} else {
+			MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
 		}
 	}
 
@@ -294,8 +648,8 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 
 	_update_group_order(g);
 
-	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	FrameVector<Node *> nodes_copy(g.nodes);
+	Node **nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
 	call_lock++;
@@ -343,8 +697,8 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 
 	_update_group_order(g);
 
-	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	FrameVector<Node *> nodes_copy(g.nodes);
+	Node **nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
 	call_lock++;
@@ -413,6 +767,43 @@ bool SceneTree::is_input_handled() {
 	return input_handled;
 }
 
+void SceneTree::_viewports_input(const Ref<InputEvent> &p_event, bool p_unhandled) {
+
+	//called for every input event, so viewports are called directly instead of through call_group_flags
+	Map<StringName, Group>::Element *E = group_map.find(viewports_group);
+	if (!E)
+		return;
+	Group &g = E->get();
+	if (g.nodes.empty())
+		return;
+
+	_update_group_order(g);
+
+	//shares the group's data, it is only copied if an input handler changes the group
+	Vector<Node *> nodes_copy = g.nodes;
+	Node *const *nodes = nodes_copy.ptr();
+	int node_count = nodes_copy.size();
+
+	call_lock++;
+
+	for (int i = 0; i < node_count; i++) {
+
+		if (call_lock && call_skip.has(nodes[i]))
+			continue;
+
+		Viewport *viewport = static_cast<Viewport *>(nodes[i]); //only viewports join this group
+		if (p_unhandled) {
+			viewport->_vp_unhandled_input(p_event);
+		} else {
+			viewport->_vp_input(p_event);
+		}
+	}
+
+	call_lock--;
+	if (call_lock == 0)
+		call_skip.clear();
+}
+
 void SceneTree::input_event(const Ref<InputEvent> &p_event) {
 
 	if (Engine::get_singleton()->is_editor_hint() && (Object::cast_to<InputEventJoypadButton>(p_event.ptr()) || Object::cast_to<InputEventJoypadMotion>(*p_event)))
@@ -428,7 +819,7 @@ void SceneTree::input_event(const Ref<InputEvent> &p_event) {
 
 	MainLoop::input_event(ev);
 
-	call_group_flags(GROUP_CALL_REALTIME, "_viewports", "_vp_input", ev); //special one for GUI, as controls use their own process check
+	_viewports_input(ev, false); //special one for GUI, as controls use their own process check
 
 	if (ScriptDebugger::get_singleton() && ScriptDebugger::get_singleton()->is_remote()) {
 		//quit from game window using F8
@@ -445,7 +836,7 @@ void SceneTree::input_event(const Ref<InputEvent> &p_event) {
 	root_lock++;
 
 	if (!input_handled) {
-		call_group_flags(GROUP_CALL_REALTIME, "_viewports", "_vp_unhandled_input", ev); //special one for GUI, as controls use their own process check
+		_viewports_input(ev, true); //special one for GUI, as controls use their own process check
 		_flush_ugc();
 		//		input_handled = true; - no reason to set this as handled
 		root_lock--;
@@ -475,10 +866,10 @@ bool SceneTree::iteration(float p_time) {
 	MainLoop::iteration(p_time);
 	physics_process_time = p_time;
 
-	emit_signal("physics_frame");
+	emit_signal(SNAME("physics_frame"));
 
-	_notify_group_pause("physics_process_internal", Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
-	_notify_group_pause("physics_process", Node::NOTIFICATION_PHYSICS_PROCESS);
+	_notify_process_list(PROCESS_LIST_PHYSICS_INTERNAL, Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	_notify_process_list(PROCESS_LIST_PHYSICS, Node::NOTIFICATION_PHYSICS_PROCESS);
 	_flush_ugc();
 	MessageQueue::get_singleton()->flush(); //small little hack
 	flush_transform_notifications();
@@ -515,14 +906,14 @@ bool SceneTree::idle(float p_time) {
 		multiplayer->poll();
 	}
 
-	emit_signal("idle_frame");
+	emit_signal(SNAME("idle_frame"));
 
 	MessageQueue::get_singleton()->flush(); //small little hack
 
 	flush_transform_notifications();
 
-	_notify_group_pause("idle_process_internal", Node::NOTIFICATION_INTERNAL_PROCESS);
-	_notify_group_pause("idle_process", Node::NOTIFICATION_PROCESS);
+	_notify_process_list(PROCESS_LIST_IDLE_INTERNAL, Node::NOTIFICATION_INTERNAL_PROCESS);
+	_notify_process_list(PROCESS_LIST_IDLE, Node::NOTIFICATION_PROCESS);
 
 	Size2 win_size = Size2(OS::get_singleton()->get_window_size().width, OS::get_singleton()->get_window_size().height);
 
@@ -530,7 +921,7 @@ bool SceneTree::idle(float p_time) {
 
 		last_screen_size = win_size;
 		_update_root_rect();
-		emit_signal("screen_resized");
+		emit_signal(SNAME("screen_resized"));
 	}
 
 	_flush_ugc();
@@ -561,7 +952,7 @@ bool SceneTree::idle(float p_time) {
 		E->get()->set_time_left(time_left);
 
 		if (time_left < 0) {
-			E->get()->emit_signal("timeout");
+			E->get()->emit_signal(SNAME("timeout"));
 			timers.erase(E);
 		}
 		if (E == L) {
@@ -918,12 +1309,12 @@ void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p
 
 	_update_group_order(g);
 
-	//copy, so copy on write happens in case something is removed from process while being called
-	//performance is not lost because only if something is added/removed the vector is copied.
-	Vector<Node *> nodes_copy = g.nodes;
+	//copy, so nodes removed from the group while being called don't break the loop.
+	//the copy lives in the frame arena, which is cheaper than the heap copy writing to a shared Vector would do.
+	FrameVector<Node *> nodes_copy(g.nodes);
 
 	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
+	Node **nodes = nodes_copy.ptr();
 
 	Variant arg = p_input;
 	const Variant *v[1] = { &arg };
@@ -962,12 +1353,12 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 
 	_update_group_order(g, p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 
-	//copy, so copy on write happens in case something is removed from process while being called
-	//performance is not lost because only if something is added/removed the vector is copied.
-	Vector<Node *> nodes_copy = g.nodes;
+	//copy, so nodes removed from the group while being called don't break the loop.
+	//the copy lives in the frame arena, which is cheaper than the heap copy writing to a shared Vector would do.
+	FrameVector<Node *> nodes_copy(g.nodes);
 
 	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
+	Node **nodes = nodes_copy.ptr();
 
 	call_lock++;
 
@@ -1885,6 +2276,7 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reload_current_scene"), &SceneTree::reload_current_scene);
 
 	ClassDB::bind_method(D_METHOD("_change_scene"), &SceneTree::_change_scene);
+	ClassDB::bind_method(D_METHOD("_flush_container_sorts"), &SceneTree::_flush_container_sorts);
 
 	ClassDB::bind_method(D_METHOD("set_multiplayer", "multiplayer"), &SceneTree::set_multiplayer);
 	ClassDB::bind_method(D_METHOD("get_multiplayer"), &SceneTree::get_multiplayer);
@@ -1956,6 +2348,7 @@ void SceneTree::_bind_methods() {
 }
 
 SceneTree *SceneTree::singleton = NULL;
+thread_local SceneTree::ProcessGroup *SceneTree::current_process_group = NULL;
 
 SceneTree::IdleCallback SceneTree::idle_callbacks[SceneTree::MAX_IDLE_CALLBACKS];
 int SceneTree::idle_callback_count = 0;
@@ -2036,10 +2429,23 @@ SceneTree::SceneTree() {
 	collision_debug_contacts = GLOBAL_DEF("debug/shapes/collision/max_contacts_displayed", 10000);
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/shapes/collision/max_contacts_displayed", PropertyInfo(Variant::INT, "debug/shapes/collision/max_contacts_displayed", PROPERTY_HINT_RANGE, "0,20000,1")); // No negative
 
+	// Transforms edited in the editor are not set from physics ticks, so never blend them there.
+	physics_interpolation_enabled = GLOBAL_DEF("physics/common/physics_interpolation", false);
+	if (Engine::get_singleton()->is_editor_hint()) {
+		physics_interpolation_enabled = false;
+	}
+
 	tree_version = 1;
 	physics_process_time = 1;
 	idle_process_time = 1;
 
+	thread_process_groups_changed = false;
+	processing_thread_groups = false;
+
+	xform_change_version = 1;
+	instance_batch_depth = 0;
+	container_sort_queued = false;
+
 	root = NULL;
 	input_handled = false;
 	pause = false;
@@ -2049,6 +2455,7 @@ SceneTree::SceneTree() {
 	node_added_name = "node_added";
 	node_removed_name = "node_removed";
 	node_renamed_name = "node_renamed";
+	viewports_group = "_viewports";
 	ugc_locked = false;
 	call_lock = 0;
 	root_lock = 0;
@@ -2154,5 +2561,10 @@ SceneTree::~SceneTree() {
 		memdelete(root);
 	}
 
+	const UGCall *K = NULL;
+	while ((K = group_call_caches.next(K))) {
+		memdelete(group_call_caches[*K]);
+	}
+
 	if (singleton == this) singleton = NULL;
 }
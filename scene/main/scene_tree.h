@@ -39,6 +39,7 @@
 #include "scene/resources/world.h"
 #include "scene/resources/world_2d.h"
 
+class Container;
 class PackedScene;
 class Node;
 class Viewport;
@@ -91,6 +92,14 @@ public:
 		STRETCH_ASPECT_EXPAND,
 	};
 
+	enum ProcessList {
+		PROCESS_LIST_IDLE,
+		PROCESS_LIST_IDLE_INTERNAL,
+		PROCESS_LIST_PHYSICS,
+		PROCESS_LIST_PHYSICS_INTERNAL,
+		PROCESS_LIST_MAX
+	};
+
 private:
 	struct Group {
 
@@ -100,6 +109,52 @@ private:
 		Group() { changed = false; };
 	};
 
+	// processing nodes are kept out of the group map, in lists sorted by priority and tree order.
+	// new nodes are merged in on the next dispatch and removed ones leave a hole until then,
+	// so neither adding nor removing needs a full sort or a linear search.
+	struct ProcessNodes {
+
+		Vector<Node *> nodes;
+		Vector<Node *> pending;
+		int removed;
+		bool changed;
+		ProcessNodes() {
+			removed = 0;
+			changed = false;
+		}
+	};
+
+	struct ThreadGroupCall {
+
+		ObjectID object;
+		StringName method;
+		Vector<Variant> args;
+	};
+
+	// nodes are processed in the main thread group unless a node with PROCESS_THREAD_GROUP_SUB_THREAD
+	// owns a group for its subtree. sub-thread groups are processed in parallel on the WorkerThreadPool
+	// before the main thread group, and calls they defer are run on the main thread once all are done.
+	struct ProcessGroup {
+
+		Node *owner; //NULL for the main thread group
+		ProcessNodes lists[PROCESS_LIST_MAX];
+		Vector<ThreadGroupCall> calls;
+		ProcessGroup() { owner = NULL; }
+	};
+
+	struct ThreadGroupPass {
+
+		ProcessList list;
+		int notification;
+	};
+
+	ProcessGroup main_process_group;
+	Vector<ProcessGroup *> thread_process_groups;
+	bool thread_process_groups_changed;
+	bool processing_thread_groups;
+
+	static thread_local ProcessGroup *current_process_group;
+
 	Viewport *root;
 
 	uint64_t tree_version;
@@ -125,6 +180,7 @@ private:
 	StringName node_added_name;
 	StringName node_removed_name;
 	StringName node_renamed_name;
+	StringName viewports_group;
 
 	bool use_font_oversampling;
 	int64_t current_frame;
@@ -140,8 +196,25 @@ private:
 		StringName call;
 
 		bool operator<(const UGCall &p_with) const { return group == p_with.group ? call < p_with.call : group < p_with.group; }
+		bool operator==(const UGCall &p_with) const { return group == p_with.group && call == p_with.call; }
+	};
+
+	struct UGCallHasher {
+		static _FORCE_INLINE_ uint32_t hash(const UGCall &p_call) { return hash_djb2_one_32(p_call.call.hash(), p_call.group.hash()); }
+	};
+
+	enum {
+		GROUP_CALL_CACHE_SLOTS = 8 //power of two
+	};
+
+	//methods resolved by realtime call_group_flags(), per group and method. a node's class picks the slot
+	struct GroupCallCache {
+
+		MethodCallCache slots[GROUP_CALL_CACHE_SLOTS];
 	};
 
+	HashMap<UGCall, GroupCallCache *, UGCallHasher> group_call_caches;
+
 	//safety for when a node is deleted while a group is being called
 	int call_lock;
 	Set<Node *> call_skip; //skip erased nodes
@@ -159,6 +232,7 @@ private:
 	Map<UGCall, Vector<Variant> > unique_group_calls;
 	bool ugc_locked;
 	void _flush_ugc();
+	void _viewports_input(const Ref<InputEvent> &p_event, bool p_unhandled);
 
 	_FORCE_INLINE_ void _update_group_order(Group &g, bool p_use_priority = false);
 	void _update_listener();
@@ -177,6 +251,8 @@ private:
 	Ref<Material> collision_material;
 	int collision_debug_contacts;
 
+	bool physics_interpolation_enabled;
+
 	void _change_scene(Node *p_to);
 	//void _call_group(uint32_t p_call_flags,const StringName& p_group,const StringName& p_function,const Variant& p_arg1,const Variant& p_arg2);
 
@@ -207,6 +283,19 @@ private:
 	void make_group_changed(const StringName &p_group);
 
 	void _notify_group_pause(const StringName &p_group, int p_notification);
+
+	void _process_list_add(ProcessList p_list, Node *p_node);
+	void _process_list_remove(ProcessList p_list, Node *p_node);
+	void _process_list_changed(ProcessList p_list, Node *p_node);
+	void _update_process_list(ProcessGroup *p_group, ProcessList p_list);
+	void _notify_process_group(ProcessGroup *p_group, ProcessList p_list, int p_notification);
+	void _notify_process_list(ProcessList p_list, int p_notification);
+
+	ProcessGroup *_add_process_group(Node *p_owner);
+	void _remove_process_group(ProcessGroup *p_group);
+	void _process_thread_group(uint32_t p_index, ThreadGroupPass p_pass);
+	void _flush_thread_group_calls();
+	static bool _push_thread_group_call(ObjectID p_object, const StringName &p_method, const Variant **p_args, int p_argcount);
 	void _call_input_pause(const StringName &p_group, const StringName &p_method, const Ref<InputEvent> &p_input);
 	Variant _call_group_flags(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 	Variant _call_group(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
@@ -214,10 +303,25 @@ private:
 	void _flush_delete_queue();
 	//optimization
 	friend class CanvasItem;
+	friend class Container;
 	friend class Spatial;
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	uint64_t xform_change_version; //bumped whenever a node may leave xform_change_list or stop qualifying for it
+
+	//containers waiting to sort their children, sorted parents first in a single pass when the message queue is flushed
+	SelfList<Container>::List container_sort_list;
+	bool container_sort_queued;
+	void _queue_container_sort(SelfList<Container> *p_item);
+	void _flush_container_sorts();
+
+	//instance changes made by VisualInstances while a batch is open, sent to the VisualServer in bulk once it closes
+	int instance_batch_depth;
+	Vector<RID> batch_xform_instances;
+	Vector<Transform> batch_xforms;
+	Vector<RID> batch_visible_instances;
+	Vector<bool> batch_visible;
 
 	friend class ScriptDebuggerRemote;
 #ifdef DEBUG_ENABLED
@@ -291,6 +395,11 @@ public:
 
 	void flush_transform_notifications();
 
+	void begin_instance_batch();
+	void end_instance_batch();
+	void queue_instance_transform(RID p_instance, const Transform &p_transform);
+	void queue_instance_visible(RID p_instance, bool p_visible);
+
 	virtual void input_text(const String &p_text);
 	virtual void input_event(const Ref<InputEvent> &p_event);
 	virtual void init();
@@ -355,6 +464,8 @@ public:
 
 	int get_collision_debug_contact_count() { return collision_debug_contacts; }
 
+	bool is_physics_interpolation_enabled() const { return physics_interpolation_enabled; }
+
 	int64_t get_frame() const;
 	int64_t get_event_count() const;
 
@@ -199,6 +199,7 @@ Viewport::GUI::GUI() {
 	tooltip_label = NULL;
 	subwindow_visibility_dirty = false;
 	subwindow_order_dirty = false;
+	pick_dirty = true;
 }
 
 /////////////////////////////////////
@@ -448,6 +449,8 @@ void Viewport::_notification(int p_what) {
 					}
 				}
 
+				physics_picking_last_merged = false;
+
 				while (physics_picking_events.size()) {
 
 					Ref<InputEvent> ev = physics_picking_events.front()->get();
@@ -541,7 +544,7 @@ void Viewport::_notification(int p_what) {
 
 							Vector2 point = canvas_transform.affine_inverse().xform(pos);
 
-							int rc = ss2d->intersect_point_on_canvas(point, canvas_layer_id, res, 64, Set<RID>(), 0xFFFFFFFF, true, true, true);
+							int rc = ss2d->intersect_point_on_canvas(point, canvas_layer_id, res, 64, BTreeSet<RID>(), 0xFFFFFFFF, true, true, true);
 							for (int i = 0; i < rc; i++) {
 
 								if (res[i].collider_id && res[i].collider) {
@@ -636,7 +639,7 @@ void Viewport::_notification(int p_what) {
 							PhysicsDirectSpaceState *space = PhysicsServer::get_singleton()->space_get_direct_state(find_world()->get_space());
 							if (space) {
 
-								bool col = space->intersect_ray(from, from + dir * 10000, result, Set<RID>(), 0xFFFFFFFF, true, true, true);
+								bool col = space->intersect_ray(from, from + dir * 10000, result, BTreeSet<RID>(), 0xFFFFFFFF, true, true, true);
 								ObjectID new_collider = 0;
 								if (col) {
 
@@ -1495,6 +1498,7 @@ void Viewport::_gui_prepare_subwindows() {
 
 		gui.subwindow_visibility_dirty = false;
 		gui.subwindow_order_dirty = true;
+		gui.pick_dirty = true;
 	}
 
 	_gui_sort_subwindows();
@@ -1509,6 +1513,7 @@ void Viewport::_gui_sort_subwindows() {
 	gui.subwindows.sort_custom<Control::CComparator>();
 
 	gui.subwindow_order_dirty = false;
+	gui.pick_dirty = true;
 }
 
 void Viewport::_gui_sort_modal_stack() {
@@ -1524,6 +1529,7 @@ void Viewport::_gui_sort_roots() {
 	gui.roots.sort_custom<Control::CComparator>();
 
 	gui.roots_order_dirty = false;
+	gui.pick_dirty = true;
 }
 
 void Viewport::_gui_cancel_tooltip() {
@@ -1719,92 +1725,168 @@ void Viewport::_gui_call_notification(Control *p_control, int p_what) {
 Control *Viewport::_gui_find_control(const Point2 &p_global) {
 
 	_gui_prepare_subwindows();
+	_gui_sort_roots();
 
-	for (List<Control *>::Element *E = gui.subwindows.back(); E; E = E->prev()) {
+	if (!gui.pick_dirty) {
+		//canvas layers and non-control parents of the roots are not tracked, compare where the roots are instead
+		for (int i = 0; i < gui.pick_roots.size(); i++) {
+			const GUI::PickRoot &root = gui.pick_roots[i];
+			if (root.entry >= 0 && _gui_get_root_xform(root.control) != root.xform) {
+				gui.pick_dirty = true;
+				break;
+			}
+		}
+	}
 
-		Control *sw = E->get();
-		if (!sw->is_visible_in_tree())
-			continue;
+	if (gui.pick_dirty) {
+		_gui_update_pick();
+	}
 
-		Transform2D xform;
-		CanvasItem *pci = sw->get_parent_item();
-		if (pci)
-			xform = pci->get_global_transform_with_canvas();
-		else
-			xform = sw->get_canvas_transform();
+	for (int i = 0; i < gui.pick_roots.size(); i++) {
+
+		const GUI::PickRoot &root = gui.pick_roots[i];
+		if (root.entry < 0)
+			continue;
 
-		Control *ret = _gui_find_control_at_pos(sw, p_global, xform, gui.focus_inv_xform);
+		Control *ret = _gui_pick_control(root.entry, p_global, gui.focus_inv_xform);
 		if (ret)
 			return ret;
 	}
 
-	_gui_sort_roots();
+	return NULL;
+}
 
-	for (List<Control *>::Element *E = gui.roots.back(); E; E = E->prev()) {
+Transform2D Viewport::_gui_get_root_xform(Control *p_root) const {
 
-		Control *sw = E->get();
-		if (!sw->is_visible_in_tree())
-			continue;
+	CanvasItem *pci = p_root->get_parent_item();
+	if (pci)
+		return pci->get_global_transform_with_canvas();
+	else
+		return p_root->get_canvas_transform();
+}
 
-		Transform2D xform;
-		CanvasItem *pci = sw->get_parent_item();
-		if (pci)
-			xform = pci->get_global_transform_with_canvas();
-		else
-			xform = sw->get_canvas_transform();
+void Viewport::_gui_update_pick() {
 
-		Control *ret = _gui_find_control_at_pos(sw, p_global, xform, gui.focus_inv_xform);
-		if (ret)
-			return ret;
+	gui.pick_entries.clear();
+	gui.pick_roots.clear();
+
+	//subwindows first, then roots, topmost first
+	for (int pass = 0; pass < 2; pass++) {
+
+		const List<Control *> &list = pass == 0 ? gui.subwindows : gui.roots;
+		for (const List<Control *>::Element *E = list.back(); E; E = E->prev()) {
+
+			GUI::PickRoot root;
+			root.control = E->get();
+			root.entry = -1;
+			if (root.control->is_visible_in_tree()) {
+				root.xform = _gui_get_root_xform(root.control);
+				root.entry = _gui_add_pick_entries(root.control, root.xform);
+			}
+			gui.pick_roots.push_back(root);
+		}
 	}
 
-	return NULL;
+	gui.pick_dirty = false;
 }
 
-Control *Viewport::_gui_find_control_at_pos(CanvasItem *p_node, const Point2 &p_global, const Transform2D &p_xform, Transform2D &r_inv_xform) {
+int Viewport::_gui_add_pick_entries(CanvasItem *p_node, const Transform2D &p_xform) {
 
 	if (Object::cast_to<Viewport>(p_node))
-		return NULL;
-
-	//subwindows first!!
+		return -1;
 
 	if (!p_node->is_visible()) {
-		//return _find_next_visible_control_at_pos(p_node,p_global,r_inv_xform);
-		return NULL; //canvas item hidden, discard
+		return -1; //canvas item hidden, discard
 	}
 
 	Transform2D matrix = p_xform * p_node->get_transform();
 	// matrix.basis_determinant() == 0.0f implies that node does not exist on scene
 	if (matrix.basis_determinant() == 0.0f)
-		return NULL;
+		return -1;
+
+	int index = gui.pick_entries.size();
+	gui.pick_entries.push_back(GUI::PickEntry());
 
 	Control *c = Object::cast_to<Control>(p_node);
 
-	if (!c || !c->clips_input() || c->has_point(matrix.affine_inverse().xform(p_global))) {
+	Rect2 bounds;
+	bool has_bounds = false;
+	bool unbounded = false;
+	if (c) {
+		//grown a bit so a point on the edge is never lost to rounding
+		bounds = matrix.xform(Rect2(Point2(), c->get_size())).grow(1.0);
+		has_bounds = true;
+		unbounded = c->has_point_outside_rect();
+	}
 
-		for (int i = p_node->get_child_count() - 1; i >= 0; i--) {
+	for (int i = p_node->get_child_count() - 1; i >= 0; i--) {
 
-			if (p_node == gui.tooltip_popup)
-				continue;
+		CanvasItem *ci = Object::cast_to<CanvasItem>(p_node->get_child(i));
+		if (!ci || ci->is_set_as_toplevel())
+			continue;
 
-			CanvasItem *ci = Object::cast_to<CanvasItem>(p_node->get_child(i));
-			if (!ci || ci->is_set_as_toplevel())
-				continue;
+		int child = _gui_add_pick_entries(ci, matrix);
+		if (child < 0)
+			continue;
+
+		const GUI::PickEntry &ce = gui.pick_entries[child];
+		if (ce.unbounded) {
+			unbounded = true;
+		} else if (ce.has_bounds) {
+			bounds = has_bounds ? bounds.merge(ce.bounds) : ce.bounds;
+			has_bounds = true;
+		}
+	}
+
+	GUI::PickEntry &entry = gui.pick_entries.write[index];
+	entry.control = c;
+	entry.inv_xform = matrix.affine_inverse();
+	entry.bounds = bounds;
+	entry.has_bounds = has_bounds;
+	entry.unbounded = unbounded;
+	entry.end = gui.pick_entries.size();
+
+	return index;
+}
+
+Control *Viewport::_gui_pick_control(int p_entry, const Point2 &p_global, Transform2D &r_inv_xform) {
+
+	const GUI::PickEntry &entry = gui.pick_entries[p_entry];
+
+	if (!entry.unbounded && !(entry.has_bounds && entry.bounds.has_point(p_global)))
+		return NULL; //no control in this subtree can contain the point
 
-			Control *ret = _gui_find_control_at_pos(ci, p_global, matrix, r_inv_xform);
-			if (ret)
-				return ret;
+	Control *c = entry.control;
+	Point2 local;
+	bool clips = false;
+	bool inside = false;
+	if (c) {
+		local = entry.inv_xform.xform(p_global);
+		clips = c->clips_input();
+		if (clips) {
+			inside = c->has_point(local);
+		}
+	}
+
+	if (!clips || inside) {
+
+		if (!c || c != gui.tooltip_popup) {
+			//children were added topmost first, the next sibling starts where a subtree ends
+			for (int i = p_entry + 1; i < entry.end; i = gui.pick_entries[i].end) {
+
+				Control *ret = _gui_pick_control(i, p_global, r_inv_xform);
+				if (ret)
+					return ret;
+			}
 		}
 	}
 
 	if (!c)
 		return NULL;
 
-	matrix.affine_invert();
-
 	//conditions for considering this as a valid control for return
-	if (c->data.mouse_filter != Control::MOUSE_FILTER_IGNORE && c->has_point(matrix.xform(p_global)) && (!gui.drag_preview || (c != gui.drag_preview && !gui.drag_preview->is_a_parent_of(c)))) {
-		r_inv_xform = matrix;
+	if (c->data.mouse_filter != Control::MOUSE_FILTER_IGNORE && (clips ? inside : c->has_point(local)) && (!gui.drag_preview || (c != gui.drag_preview && !gui.drag_preview->is_a_parent_of(c)))) {
+		r_inv_xform = entry.inv_xform;
 		return c;
 	} else
 		return NULL;
@@ -2575,6 +2657,7 @@ void Viewport::_gui_set_drag_preview(Control *p_base, Control *p_control) {
 void Viewport::_gui_remove_root_control(List<Control *>::Element *RI) {
 
 	gui.roots.erase(RI);
+	gui.pick_dirty = true;
 }
 
 void Viewport::_gui_remove_subwindow_control(List<Control *>::Element *SI) {
@@ -2588,6 +2671,7 @@ void Viewport::_gui_remove_subwindow_control(List<Control *>::Element *SI) {
 	List<Control *>::Element *E = gui.subwindows.find(control);
 	if (E)
 		gui.subwindows.erase(E);
+	gui.pick_dirty = true;
 
 	gui.all_known_subwindows.erase(SI);
 }
@@ -2848,7 +2932,26 @@ void Viewport::unhandled_input(const Ref<InputEvent> &p_event) {
 						Object::cast_to<InputEventKey>(*p_event) //to remember state
 
 						)) {
+
+			//motions queued since the last physics frame are merged into one pick, every picking query is a ray or point query
+			Ref<InputEventMouseMotion> mm = p_event;
+			if (mm.is_valid() && physics_picking_events.size()) {
+				Ref<InputEventMouseMotion> last = physics_picking_events.back()->get();
+				if (last.is_valid() && last->get_device() == mm->get_device()) {
+					if (!physics_picking_last_merged) {
+						//the queued event was also sent to everything else, merge into a copy
+						last = last->duplicate();
+						physics_picking_events.back()->get() = last;
+						physics_picking_last_merged = true;
+					}
+					if (last->accumulate(mm)) {
+						return;
+					}
+				}
+			}
+
 			physics_picking_events.push_back(p_event);
+			physics_picking_last_merged = false;
 		}
 	}
 }
@@ -2919,6 +3022,7 @@ void Viewport::set_physics_object_picking(bool p_enable) {
 	physics_object_picking = p_enable;
 	if (!physics_object_picking) {
 		physics_picking_events.clear();
+		physics_picking_last_merged = false;
 	}
 }
 
@@ -3355,6 +3459,7 @@ Viewport::Viewport() {
 	physics_object_capture = 0;
 	physics_object_over = 0;
 	physics_has_last_mousepos = false;
+	physics_picking_last_merged = false;
 	physics_last_mousepos = Vector2(Math_INF, Math_INF);
 
 	shadow_atlas_size = 0;
@@ -223,6 +223,7 @@ private:
 
 	bool physics_object_picking;
 	List<Ref<InputEvent> > physics_picking_events;
+	bool physics_picking_last_merged; //the last queued event is a copy that motions were merged into
 	ObjectID physics_object_capture;
 	ObjectID physics_object_over;
 	Transform physics_last_object_transform;
@@ -317,6 +318,27 @@ private:
 		int canvas_sort_index; //for sorting items with canvas as root
 		bool dragging;
 
+		//the visible canvas items under the subwindows and roots, flattened in the order they are hit tested.
+		//the subtree of an entry follows it, and the bounds let whole subtrees be skipped. rebuilt when any item changes.
+		struct PickEntry {
+			Control *control; //NULL for canvas items that only carry children
+			Transform2D inv_xform;
+			Rect2 bounds; //global bounds of the entry and its subtree
+			bool has_bounds;
+			bool unbounded; //has_point() of a control in the subtree may accept points outside of its rect
+			int end; //index after the subtree
+		};
+
+		struct PickRoot {
+			Control *control;
+			Transform2D xform;
+			int entry; //-1 if nothing can be hit
+		};
+
+		Vector<PickEntry> pick_entries;
+		Vector<PickRoot> pick_roots;
+		bool pick_dirty;
+
 		GUI();
 	} gui;
 
@@ -330,7 +352,10 @@ private:
 	void _gui_sort_roots();
 	void _gui_sort_modal_stack();
 	Control *_gui_find_control(const Point2 &p_global);
-	Control *_gui_find_control_at_pos(CanvasItem *p_node, const Point2 &p_global, const Transform2D &p_xform, Transform2D &r_inv_xform);
+	Transform2D _gui_get_root_xform(Control *p_root) const;
+	void _gui_update_pick();
+	int _gui_add_pick_entries(CanvasItem *p_node, const Transform2D &p_xform);
+	Control *_gui_pick_control(int p_entry, const Point2 &p_global, Transform2D &r_inv_xform);
 
 	void _gui_input_event(Ref<InputEvent> p_event);
 
@@ -344,12 +369,15 @@ private:
 	Ref<InputEvent> _make_input_local(const Ref<InputEvent> &ev);
 
 	friend class Control;
+	friend class CanvasItem;
+	friend class SceneTree;
 
 	List<Control *>::Element *_gui_add_root_control(Control *p_control);
 	List<Control *>::Element *_gui_add_subwindow_control(Control *p_control);
 
 	void _gui_set_subwindow_order_dirty();
 	void _gui_set_root_order_dirty();
+	_FORCE_INLINE_ void _gui_set_pick_dirty() { gui.pick_dirty = true; }
 
 	void _gui_remove_modal_control(List<Control *>::Element *MI);
 	void _gui_remove_from_modal_stack(List<Control *>::Element *MI, ObjectID p_prev_focus_owner);
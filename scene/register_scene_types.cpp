@@ -190,6 +190,7 @@
 #include "scene/3d/multimesh_instance.h"
 #include "scene/3d/navigation.h"
 #include "scene/3d/navigation_mesh.h"
+#include "scene/3d/occluder.h"
 #include "scene/3d/particles.h"
 #include "scene/3d/path.h"
 #include "scene/3d/physics_body.h"
@@ -245,6 +246,7 @@ void register_scene_types() {
 
 	resource_loader_text.instance();
 	ResourceLoader::add_resource_format_loader(resource_loader_text, true);
+	GLOBAL_DEF("filesystem/text_resources/use_binary_cache", false);
 
 	resource_saver_shader.instance();
 	ResourceSaver::add_resource_format_saver(resource_saver_shader, true);
@@ -265,6 +267,7 @@ void register_scene_types() {
 	ClassDB::register_class<Viewport>();
 	ClassDB::register_class<ViewportTexture>();
 	ClassDB::register_class<HTTPRequest>();
+	HTTPRequest::initialize_connection_pool();
 	ClassDB::register_class<Timer>();
 	ClassDB::register_class<CanvasLayer>();
 	ClassDB::register_class<CanvasModulate>();
@@ -406,6 +409,7 @@ void register_scene_types() {
 	ClassDB::register_class<ARVROrigin>();
 	ClassDB::register_class<InterpolatedCamera>();
 	ClassDB::register_class<MeshInstance>();
+	ClassDB::register_class<Occluder>();
 	ClassDB::register_class<ImmediateGeometry>();
 	ClassDB::register_virtual_class<SpriteBase3D>();
 	ClassDB::register_class<Sprite3D>();
@@ -784,6 +788,8 @@ void unregister_scene_types() {
 
 	DynamicFont::finish_dynamic_fonts();
 
+	HTTPRequest::finalize_connection_pool();
+
 	ResourceSaver::remove_resource_format_saver(resource_saver_text);
 	resource_saver_text.unref();
 
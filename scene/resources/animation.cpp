@@ -31,6 +31,7 @@
 #include "animation.h"
 #include "scene/scene_string_names.h"
 
+#include "core/io/marshalls.h"
 #include "core/math/geometry.h"
 
 #define ANIM_MIN_LENGTH 0.001
@@ -91,6 +92,54 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 			if (track_get_type(track) == TYPE_TRANSFORM) {
 
 				TransformTrack *tt = static_cast<TransformTrack *>(tracks[track]);
+
+				if (p_value.get_type() == Variant::DICTIONARY) {
+
+					Dictionary d = p_value;
+					ERR_FAIL_COND_V(!d.has("channels") || !d.has("times") || !d.has("data"), false);
+
+					CompressedTransformKeys &ck = tt->compressed_keys;
+					ck.channels = d["channels"];
+					ck.stride = 0;
+					for (int i = 0; i < 3; i++) {
+						if (ck.channels & (1 << i))
+							ck.stride += 3;
+					}
+					ck.loc_min = d["loc_min"];
+					ck.loc_size = d["loc_size"];
+					ck.rot = d["rot"];
+					ck.scale_min = d["scale_min"];
+					ck.scale_size = d["scale_size"];
+
+					PoolVector<float> times = d["times"];
+					ERR_FAIL_COND_V(times.size() % 2, false);
+					PoolVector<uint8_t> data = d["data"];
+					int key_count = times.size() / 2;
+					ERR_FAIL_COND_V(data.size() != key_count * ck.stride * 2, false);
+
+					ck.keys.resize(key_count);
+					PoolVector<float>::Read rt = times.read();
+					for (int i = 0; i < key_count; i++) {
+						ck.keys.write[i].time = rt[i * 2 + 0];
+						ck.keys.write[i].transition = rt[i * 2 + 1];
+					}
+
+					ck.data.resize(key_count * ck.stride);
+					PoolVector<uint8_t>::Read rd = data.read();
+					uint16_t *w = ck.data.ptrw();
+					for (int i = 0; i < ck.data.size(); i++) {
+						w[i] = decode_uint16(&rd[i * 2]);
+					}
+
+					tt->transforms.clear();
+					tt->compressed = true;
+
+					return true;
+				}
+
+				tt->compressed = false;
+				tt->compressed_keys = CompressedTransformKeys();
+
 				PoolVector<float> values = p_value;
 				int vcount = values.size();
 				ERR_FAIL_COND_V(vcount % 12, false); // should be multiple of 11
@@ -373,6 +422,45 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 
 			if (track_get_type(track) == TYPE_TRANSFORM) {
 
+				const TransformTrack *tt = static_cast<const TransformTrack *>(tracks[track]);
+
+				if (tt->compressed) {
+
+					const CompressedTransformKeys &ck = tt->compressed_keys;
+
+					PoolVector<float> times;
+					times.resize(ck.keys.size() * 2);
+					{
+						PoolVector<float>::Write w = times.write();
+						for (int i = 0; i < ck.keys.size(); i++) {
+							w[i * 2 + 0] = ck.keys[i].time;
+							w[i * 2 + 1] = ck.keys[i].transition;
+						}
+					}
+
+					PoolVector<uint8_t> data;
+					data.resize(ck.data.size() * 2);
+					{
+						PoolVector<uint8_t>::Write w = data.write();
+						for (int i = 0; i < ck.data.size(); i++) {
+							encode_uint16(ck.data[i], &w[i * 2]);
+						}
+					}
+
+					Dictionary d;
+					d["channels"] = ck.channels;
+					d["times"] = times;
+					d["data"] = data;
+					d["loc_min"] = ck.loc_min;
+					d["loc_size"] = ck.loc_size;
+					d["rot"] = ck.rot;
+					d["scale_min"] = ck.scale_min;
+					d["scale_size"] = ck.scale_size;
+
+					r_ret = d;
+					return true;
+				}
+
 				PoolVector<real_t> keys;
 				int kk = track_get_key_count(track);
 				keys.resize(kk * 12);
@@ -851,6 +939,21 @@ Error Animation::transform_track_get_key(int p_track, int p_key, Vector3 *r_loc,
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
+
+	if (tt->compressed) {
+
+		ERR_FAIL_INDEX_V(p_key, tt->compressed_keys.keys.size(), ERR_INVALID_PARAMETER);
+		TransformKey tk = _decode_compressed_key(tt->compressed_keys, p_key);
+		if (r_loc)
+			*r_loc = tk.loc;
+		if (r_rot)
+			*r_rot = tk.rot;
+		if (r_scale)
+			*r_scale = tk.scale;
+
+		return OK;
+	}
+
 	ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
 
 	if (r_loc)
@@ -870,6 +973,7 @@ int Animation::transform_track_insert_key(int p_track, float p_time, const Vecto
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, -1);
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
+	_decompress_transform_track(tt);
 
 	TKey<TransformKey> tkey;
 	tkey.time = p_time;
@@ -898,6 +1002,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_decompress_transform_track(tt);
 			ERR_FAIL_INDEX(p_idx, tt->transforms.size());
 			tt->transforms.remove(p_idx);
 
@@ -951,6 +1056,15 @@ int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				const Vector<Key> &keys = tt->compressed_keys.keys;
+				int k = _find(keys, p_time);
+				if (k < 0 || k >= keys.size())
+					return -1;
+				if (keys[k].time != p_time && p_exact)
+					return -1;
+				return k;
+			}
 			int k = _find(tt->transforms, p_time);
 			if (k < 0 || k >= tt->transforms.size())
 				return -1;
@@ -1136,6 +1250,8 @@ int Animation::track_get_key_count(int p_track) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed)
+				return tt->compressed_keys.keys.size();
 			return tt->transforms.size();
 		} break;
 		case TYPE_VALUE: {
@@ -1179,6 +1295,20 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+
+			if (tt->compressed) {
+
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_keys.keys.size(), Variant());
+				TransformKey tk = _decode_compressed_key(tt->compressed_keys, p_key_idx);
+
+				Dictionary d;
+				d["location"] = tk.loc;
+				d["rotation"] = tk.rot;
+				d["scale"] = tk.scale;
+
+				return d;
+			}
+
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
 
 			Dictionary d;
@@ -1255,6 +1385,10 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_keys.keys.size(), -1);
+				return tt->compressed_keys.keys[p_key_idx].time;
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].time;
 		} break;
@@ -1308,6 +1442,7 @@ void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_decompress_transform_track(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			TKey<TransformKey> key = tt->transforms[p_key_idx];
 			key.time = p_time;
@@ -1380,6 +1515,10 @@ float Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_keys.keys.size(), -1);
+				return tt->compressed_keys.keys[p_key_idx].transition;
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].transition;
 		} break;
@@ -1424,6 +1563,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_decompress_transform_track(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 
 			Dictionary d = p_value;
@@ -1510,6 +1650,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_decompress_transform_track(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			tt->transforms.write[p_key_idx].transition = p_transition;
 		} break;
@@ -1538,12 +1679,25 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 }
 
 template <class K>
-int Animation::_find(const Vector<K> &p_keys, float p_time) const {
+int Animation::_find(const Vector<K> &p_keys, float p_time, int p_hint) const {
 
 	int len = p_keys.size();
 	if (len == 0)
 		return -2;
 
+	if (p_hint >= 0 && p_hint < len) {
+		// when playing forward the key is most likely the same as last time, or the next one
+		const K *keys = &p_keys[0];
+		int max = MIN(p_hint + 2, len);
+		for (int i = p_hint; i < max; i++) {
+
+			if (p_time < keys[i].time && !Math::is_equal_approx(p_time, keys[i].time))
+				break;
+			if (i + 1 == len || (p_time < keys[i + 1].time && !Math::is_equal_approx(p_time, keys[i + 1].time)))
+				return i;
+		}
+	}
+
 	int low = 0;
 	int high = len - 1;
 	int middle = 0;
@@ -1573,6 +1727,21 @@ int Animation::_find(const Vector<K> &p_keys, float p_time) const {
 	return middle;
 }
 
+template <class K>
+int Animation::_find_last(const Vector<K> &p_keys) const {
+
+	int len = p_keys.size();
+	if (len == 0)
+		return -2;
+
+	// keys are rarely past the end, avoid the search in that case
+	float last = p_keys[len - 1].time;
+	if (last <= length || Math::is_equal_approx(last, length))
+		return len - 1;
+
+	return _find(p_keys, length);
+}
+
 Animation::TransformKey Animation::_interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const {
 
 	TransformKey ret;
@@ -1719,27 +1888,30 @@ float Animation::_cubic_interpolate(const float &p_pre_a, const float &p_a, cons
 	return _interpolate(p_a, p_b, p_c);
 }
 
-template <class T>
-T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const {
+template <class K>
+bool Animation::_find_interpolation(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *r_key_hint, int &r_len, int &r_idx, int &r_next, float &r_c) const {
 
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	int len = _find_last(p_keys) + 1; // try to find last key (there may be more past the end)
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
 		// meaning no keys, or only key time is larger than length
-		if (p_ok)
-			*p_ok = false;
-		return T();
+		return false;
 	} else if (len == 1) { // one key found (0+1), return it
 
-		if (p_ok)
-			*p_ok = true;
-		return p_keys[0].value;
+		r_len = len;
+		r_idx = 0;
+		r_next = 0;
+		r_c = 0;
+		return true;
 	}
 
-	int idx = _find(p_keys, p_time);
+	int idx = _find(p_keys, p_time, r_key_hint ? *r_key_hint : -1);
+
+	ERR_FAIL_COND_V(idx == -2, false);
 
-	ERR_FAIL_COND_V(idx == -2, T());
+	if (r_key_hint)
+		*r_key_hint = idx;
 
 	bool result = true;
 	int next = 0;
@@ -1819,6 +1991,23 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 		}
 	}
 
+	r_len = len;
+	r_idx = idx;
+	r_next = next;
+	r_c = c;
+	return result;
+}
+
+template <class T>
+T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_key_hint) const {
+
+	int len = 0;
+	int idx = 0;
+	int next = 0;
+	float c = 0;
+
+	bool result = _find_interpolation(p_keys, p_time, p_loop_wrap, r_key_hint, len, idx, next, c);
+
 	if (p_ok)
 		*p_ok = result;
 	if (!result)
@@ -1863,7 +2052,232 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 	// do a barrel roll
 }
 
-Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const {
+static _FORCE_INLINE_ uint16_t _quantize_unit(float p_value) {
+
+	return (uint16_t)CLAMP((int)Math::round(p_value * 65535.0), 0, 65535);
+}
+
+static _FORCE_INLINE_ void _quantize_vector3(const Vector3 &p_value, const Vector3 &p_min, const Vector3 &p_size, uint16_t *r_data) {
+
+	for (int i = 0; i < 3; i++) {
+		r_data[i] = p_size[i] > 0 ? _quantize_unit((p_value[i] - p_min[i]) / p_size[i]) : 0;
+	}
+}
+
+static _FORCE_INLINE_ Vector3 _dequantize_vector3(const uint16_t *p_data, const Vector3 &p_min, const Vector3 &p_size) {
+
+	return Vector3(
+			p_min.x + p_size.x * (p_data[0] * (1.0 / 65535.0)),
+			p_min.y + p_size.y * (p_data[1] * (1.0 / 65535.0)),
+			p_min.z + p_size.z * (p_data[2] * (1.0 / 65535.0)));
+}
+
+static _FORCE_INLINE_ void _quantize_quat(const Quat &p_value, uint16_t *r_data) {
+
+	Quat q = p_value.normalized();
+	real_t c[4] = { q.x, q.y, q.z, q.w };
+
+	int largest = 0;
+	for (int i = 1; i < 4; i++) {
+		if (Math::abs(c[i]) > Math::abs(c[largest]))
+			largest = i;
+	}
+
+	// q and -q are the same rotation, keep the largest component positive so it can be rebuilt
+	real_t sign = c[largest] < 0 ? -1 : 1;
+
+	int j = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest)
+			continue;
+		// the smallest three are within +-sqrt(1/2), map them to 15 bits
+		float v = (c[i] * sign * Math_SQRT2 + 1.0) * 0.5;
+		r_data[j++] = (uint16_t)CLAMP((int)Math::round(v * 32767.0), 0, 32767);
+	}
+
+	r_data[0] |= (largest & 1) << 15;
+	r_data[1] |= (largest >> 1) << 15;
+}
+
+static _FORCE_INLINE_ Quat _dequantize_quat(const uint16_t *p_data) {
+
+	int largest = (p_data[0] >> 15) | ((p_data[1] >> 15) << 1);
+
+	real_t c[4];
+	real_t sum = 0;
+	int j = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest)
+			continue;
+		real_t v = ((p_data[j++] & 0x7FFF) * (2.0 / 32767.0) - 1.0) * Math_SQRT12;
+		c[i] = v;
+		sum += v * v;
+	}
+	c[largest] = Math::sqrt(MAX(0.0, 1.0 - sum));
+
+	return Quat(c[0], c[1], c[2], c[3]).normalized();
+}
+
+Animation::TransformKey Animation::_decode_compressed_key(const CompressedTransformKeys &p_keys, int p_key) const {
+
+	TransformKey tk;
+	const uint16_t *data = &p_keys.data[p_key * p_keys.stride];
+
+	if (p_keys.channels & CompressedTransformKeys::CHANNEL_LOC) {
+		tk.loc = _dequantize_vector3(data, p_keys.loc_min, p_keys.loc_size);
+		data += 3;
+	} else {
+		tk.loc = p_keys.loc_min;
+	}
+
+	if (p_keys.channels & CompressedTransformKeys::CHANNEL_ROT) {
+		tk.rot = _dequantize_quat(data);
+		data += 3;
+	} else {
+		tk.rot = p_keys.rot;
+	}
+
+	if (p_keys.channels & CompressedTransformKeys::CHANNEL_SCALE) {
+		tk.scale = _dequantize_vector3(data, p_keys.scale_min, p_keys.scale_size);
+	} else {
+		tk.scale = p_keys.scale_min;
+	}
+
+	return tk;
+}
+
+Animation::TransformKey Animation::_interpolate_compressed(const CompressedTransformKeys &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_key_hint) const {
+
+	int len = 0;
+	int idx = 0;
+	int next = 0;
+	float c = 0;
+
+	bool result = _find_interpolation(p_keys.keys, p_time, p_loop_wrap, r_key_hint, len, idx, next, c);
+
+	if (p_ok)
+		*p_ok = result;
+	if (!result)
+		return TransformKey();
+
+	float tr = p_keys.keys[idx].transition;
+
+	if (tr == 0 || idx == next || p_interp == INTERPOLATION_NEAREST) {
+		return _decode_compressed_key(p_keys, idx);
+	}
+
+	if (tr != 1.0) {
+
+		c = Math::ease(c, tr);
+	}
+
+	if (p_interp == INTERPOLATION_CUBIC) {
+		int pre = idx - 1;
+		if (pre < 0)
+			pre = 0;
+		int post = next + 1;
+		if (post >= len)
+			post = next;
+
+		return _cubic_interpolate(_decode_compressed_key(p_keys, pre), _decode_compressed_key(p_keys, idx), _decode_compressed_key(p_keys, next), _decode_compressed_key(p_keys, post), c);
+	}
+
+	return _interpolate(_decode_compressed_key(p_keys, idx), _decode_compressed_key(p_keys, next), c);
+}
+
+void Animation::_compress_transform_track(TransformTrack *p_track) {
+
+	if (p_track->compressed || p_track->transforms.empty())
+		return;
+
+	const Vector<TKey<TransformKey> > &transforms = p_track->transforms;
+	int key_count = transforms.size();
+
+	CompressedTransformKeys ck;
+	ck.keys.resize(key_count);
+
+	AABB loc_range(transforms[0].value.loc, Vector3());
+	AABB scale_range(transforms[0].value.scale, Vector3());
+	Quat rot = transforms[0].value.rot;
+
+	for (int i = 0; i < key_count; i++) {
+
+		const TKey<TransformKey> &tk = transforms[i];
+		ck.keys.write[i].time = tk.time;
+		ck.keys.write[i].transition = tk.transition;
+
+		loc_range.expand_to(tk.value.loc);
+		scale_range.expand_to(tk.value.scale);
+		if (tk.value.rot != rot)
+			ck.channels |= CompressedTransformKeys::CHANNEL_ROT;
+	}
+
+	ck.loc_min = loc_range.position;
+	ck.loc_size = loc_range.size;
+	ck.rot = rot;
+	ck.scale_min = scale_range.position;
+	ck.scale_size = scale_range.size;
+
+	if (loc_range.size != Vector3())
+		ck.channels |= CompressedTransformKeys::CHANNEL_LOC;
+	if (scale_range.size != Vector3())
+		ck.channels |= CompressedTransformKeys::CHANNEL_SCALE;
+
+	ck.stride = 0;
+	for (int i = 0; i < 3; i++) {
+		if (ck.channels & (1 << i))
+			ck.stride += 3;
+	}
+
+	ck.data.resize(key_count * ck.stride);
+	uint16_t *w = ck.data.ptrw();
+
+	for (int i = 0; i < key_count; i++) {
+
+		const TransformKey &tk = transforms[i].value;
+
+		if (ck.channels & CompressedTransformKeys::CHANNEL_LOC) {
+			_quantize_vector3(tk.loc, ck.loc_min, ck.loc_size, w);
+			w += 3;
+		}
+		if (ck.channels & CompressedTransformKeys::CHANNEL_ROT) {
+			_quantize_quat(tk.rot, w);
+			w += 3;
+		}
+		if (ck.channels & CompressedTransformKeys::CHANNEL_SCALE) {
+			_quantize_vector3(tk.scale, ck.scale_min, ck.scale_size, w);
+			w += 3;
+		}
+	}
+
+	p_track->compressed_keys = ck;
+	p_track->compressed = true;
+	p_track->transforms.clear();
+}
+
+void Animation::_decompress_transform_track(TransformTrack *p_track) {
+
+	if (!p_track->compressed)
+		return;
+
+	const CompressedTransformKeys &ck = p_track->compressed_keys;
+	int key_count = ck.keys.size();
+
+	p_track->transforms.resize(key_count);
+
+	for (int i = 0; i < key_count; i++) {
+
+		TKey<TransformKey> &tk = p_track->transforms.write[i];
+		tk.time = ck.keys[i].time;
+		tk.transition = ck.keys[i].transition;
+		tk.value = _decode_compressed_key(ck, i);
+	}
+
+	p_track->compressed = false;
+	p_track->compressed_keys = CompressedTransformKeys();
+}
+
+Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_key_hint) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
@@ -1873,7 +2287,11 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 
 	bool ok = false;
 
-	TransformKey tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok);
+	TransformKey tk;
+	if (tt->compressed)
+		tk = _interpolate_compressed(tt->compressed_keys, p_time, tt->interpolation, tt->loop_wrap, &ok, r_key_hint);
+	else
+		tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok, r_key_hint);
 
 	if (!ok)
 		return ERR_UNAVAILABLE;
@@ -1890,7 +2308,7 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 	return OK;
 }
 
-Variant Animation::value_track_interpolate(int p_track, float p_time) const {
+Variant Animation::value_track_interpolate(int p_track, float p_time, int *r_key_hint) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
 	Track *t = tracks[p_track];
@@ -1899,7 +2317,7 @@ Variant Animation::value_track_interpolate(int p_track, float p_time) const {
 
 	bool ok = false;
 
-	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok);
+	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok, r_key_hint);
 
 	if (ok) {
 
@@ -2065,8 +2483,13 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 				case TYPE_TRANSFORM: {
 
 					const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-					_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
-					_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					if (tt->compressed) {
+						_track_get_key_indices_in_range(tt->compressed_keys.keys, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->compressed_keys.keys, 0, to_time, p_indices);
+					} else {
+						_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					}
 
 				} break;
 				case TYPE_VALUE: {
@@ -2125,7 +2548,10 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 		case TYPE_TRANSFORM: {
 
 			const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-			_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			if (tt->compressed)
+				_track_get_key_indices_in_range(tt->compressed_keys.keys, from_time, to_time, p_indices);
+			else
+				_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
 
 		} break;
 		case TYPE_VALUE: {
@@ -2383,7 +2809,7 @@ static _FORCE_INLINE_ Vector2 _bezier_interp(real_t t, const Vector2 &start, con
 	return start * omt3 + control_1 * omt2 * t * 3.0 + control_2 * omt * t2 * 3.0 + end * t3;
 }
 
-float Animation::bezier_track_interpolate(int p_track, float p_time) const {
+float Animation::bezier_track_interpolate(int p_track, float p_time, int *r_key_hint) const {
 	//this uses a different interpolation scheme
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
 	Track *track = tracks[p_track];
@@ -2391,7 +2817,7 @@ float Animation::bezier_track_interpolate(int p_track, float p_time) const {
 
 	BezierTrack *bt = static_cast<BezierTrack *>(track);
 
-	int len = _find(bt->values, length) + 1; // try to find last key (there may be more past the end)
+	int len = _find_last(bt->values) + 1; // try to find last key (there may be more past the end)
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
@@ -2400,10 +2826,13 @@ float Animation::bezier_track_interpolate(int p_track, float p_time) const {
 		return bt->values[0].value.value;
 	}
 
-	int idx = _find(bt->values, p_time);
+	int idx = _find(bt->values, p_time, r_key_hint ? *r_key_hint : -1);
 
 	ERR_FAIL_COND_V(idx == -2, 0);
 
+	if (r_key_hint)
+		*r_key_hint = idx;
+
 	//there really is no looping interpolation on bezier
 
 	if (idx < 0) {
@@ -2780,6 +3209,8 @@ void Animation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("track_get_interpolation_loop_wrap", "track_idx"), &Animation::track_get_interpolation_loop_wrap);
 
 	ClassDB::bind_method(D_METHOD("transform_track_interpolate", "track_idx", "time_sec"), &Animation::_transform_track_interpolate);
+	ClassDB::bind_method(D_METHOD("transform_track_compress", "track_idx"), &Animation::transform_track_compress);
+	ClassDB::bind_method(D_METHOD("transform_track_is_compressed", "track_idx"), &Animation::transform_track_is_compressed);
 	ClassDB::bind_method(D_METHOD("value_track_set_update_mode", "track_idx", "mode"), &Animation::value_track_set_update_mode);
 	ClassDB::bind_method(D_METHOD("value_track_get_update_mode", "track_idx"), &Animation::value_track_get_update_mode);
 
@@ -2799,7 +3230,7 @@ void Animation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bezier_track_get_key_in_handle", "track_idx", "key_idx"), &Animation::bezier_track_get_key_in_handle);
 	ClassDB::bind_method(D_METHOD("bezier_track_get_key_out_handle", "track_idx", "key_idx"), &Animation::bezier_track_get_key_out_handle);
 
-	ClassDB::bind_method(D_METHOD("bezier_track_interpolate", "track_idx", "time"), &Animation::bezier_track_interpolate);
+	ClassDB::bind_method(D_METHOD("bezier_track_interpolate", "track_idx", "time"), &Animation::_bezier_track_interpolate);
 
 	ClassDB::bind_method(D_METHOD("audio_track_insert_key", "track_idx", "time", "stream", "start_offset", "end_offset"), &Animation::audio_track_insert_key, DEFVAL(0), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("audio_track_set_key_stream", "track_idx", "key_idx", "stream"), &Animation::audio_track_set_key_stream);
@@ -2823,6 +3254,7 @@ void Animation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_step"), &Animation::get_step);
 
 	ClassDB::bind_method(D_METHOD("clear"), &Animation::clear);
+	ClassDB::bind_method(D_METHOD("compress"), &Animation::compress);
 	ClassDB::bind_method(D_METHOD("copy_track", "track_idx", "to_animation"), &Animation::copy_track);
 
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "length", PROPERTY_HINT_RANGE, "0.001,99999,0.001"), "set_length", "get_length");
@@ -3034,6 +3466,7 @@ void Animation::_transform_track_optimize(int p_idx, float p_allowed_linear_err,
 	ERR_FAIL_INDEX(p_idx, tracks.size());
 	ERR_FAIL_COND(tracks[p_idx]->type != TYPE_TRANSFORM);
 	TransformTrack *tt = static_cast<TransformTrack *>(tracks[p_idx]);
+	_decompress_transform_track(tt);
 	bool prev_erased = false;
 	TKey<TransformKey> first_erased;
 
@@ -3081,6 +3514,33 @@ void Animation::optimize(float p_allowed_linear_err, float p_allowed_angular_err
 	}
 }
 
+void Animation::transform_track_compress(int p_track) {
+
+	ERR_FAIL_INDEX(p_track, tracks.size());
+	ERR_FAIL_COND(tracks[p_track]->type != TYPE_TRANSFORM);
+
+	_compress_transform_track(static_cast<TransformTrack *>(tracks[p_track]));
+	emit_changed();
+}
+
+bool Animation::transform_track_is_compressed(int p_track) const {
+
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+	ERR_FAIL_COND_V(tracks[p_track]->type != TYPE_TRANSFORM, false);
+
+	return static_cast<const TransformTrack *>(tracks[p_track])->compressed;
+}
+
+void Animation::compress() {
+
+	for (int i = 0; i < tracks.size(); i++) {
+
+		if (tracks[i]->type == TYPE_TRANSFORM)
+			_compress_transform_track(static_cast<TransformTrack *>(tracks[i]));
+	}
+	emit_changed();
+}
+
 Animation::Animation() {
 
 	step = 0.1;
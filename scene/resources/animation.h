@@ -101,13 +101,48 @@ private:
 		Vector3 scale;
 	};
 
+	/* COMPRESSED TRANSFORM KEYS */
+
+	// components are quantized to 16 bits within the range of the track, channels that
+	// never change are stored once. rotations keep the three smallest components, the
+	// index of the largest one goes in the top bits of the first two.
+	struct CompressedTransformKeys {
+
+		enum {
+			CHANNEL_LOC = 1,
+			CHANNEL_ROT = 2,
+			CHANNEL_SCALE = 4
+		};
+
+		Vector<Key> keys; // time and transition
+		Vector<uint16_t> data; // stride components per key
+		uint32_t channels; // channels stored per key, the others are constant
+		int stride;
+		Vector3 loc_min; // the value if constant
+		Vector3 loc_size;
+		Quat rot; // the value if constant
+		Vector3 scale_min; // the value if constant
+		Vector3 scale_size;
+
+		CompressedTransformKeys() {
+			channels = 0;
+			stride = 0;
+		}
+	};
+
 	/* TRANSFORM TRACK */
 
 	struct TransformTrack : public Track {
 
 		Vector<TKey<TransformKey> > transforms;
 
-		TransformTrack() { type = TYPE_TRANSFORM; }
+		bool compressed; // keys are in compressed_keys instead of transforms
+		CompressedTransformKeys compressed_keys;
+
+		TransformTrack() {
+			type = TYPE_TRANSFORM;
+			compressed = false;
+		}
 	};
 
 	/* PROPERTY VALUE TRACK */
@@ -200,7 +235,10 @@ private:
 	int _insert(float p_time, T &p_keys, const V &p_value);
 
 	template <class K>
-	inline int _find(const Vector<K> &p_keys, float p_time) const;
+	inline int _find(const Vector<K> &p_keys, float p_time, int p_hint = -1) const;
+
+	template <class K>
+	inline int _find_last(const Vector<K> &p_keys) const;
 
 	_FORCE_INLINE_ Animation::TransformKey _interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const;
 
@@ -215,8 +253,16 @@ private:
 	_FORCE_INLINE_ Variant _cubic_interpolate(const Variant &p_pre_a, const Variant &p_a, const Variant &p_b, const Variant &p_post_b, float p_c) const;
 	_FORCE_INLINE_ float _cubic_interpolate(const float &p_pre_a, const float &p_a, const float &p_b, const float &p_post_b, float p_c) const;
 
+	template <class K>
+	_FORCE_INLINE_ bool _find_interpolation(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *r_key_hint, int &r_len, int &r_idx, int &r_next, float &r_c) const;
+
 	template <class T>
-	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const;
+	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_key_hint = NULL) const;
+
+	TransformKey _interpolate_compressed(const CompressedTransformKeys &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_key_hint) const;
+	TransformKey _decode_compressed_key(const CompressedTransformKeys &p_keys, int p_key) const;
+	void _compress_transform_track(TransformTrack *p_track);
+	void _decompress_transform_track(TransformTrack *p_track);
 
 	template <class T>
 	_FORCE_INLINE_ void _track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, List<int> *p_indices) const;
@@ -254,6 +300,9 @@ private:
 		}
 		return idxr;
 	}
+	float _bezier_track_interpolate(int p_track, float p_time) const {
+		return bezier_track_interpolate(p_track, p_time);
+	}
 	PoolVector<int> _method_track_get_key_indices(int p_track, float p_time, float p_delta) const {
 
 		List<int> idxs;
@@ -325,7 +374,7 @@ public:
 	Vector2 bezier_track_get_key_in_handle(int p_track, int p_index) const;
 	Vector2 bezier_track_get_key_out_handle(int p_track, int p_index) const;
 
-	float bezier_track_interpolate(int p_track, float p_time) const;
+	float bezier_track_interpolate(int p_track, float p_time, int *r_key_hint = NULL) const;
 
 	int audio_track_insert_key(int p_track, float p_time, const RES &p_stream, float p_start_offset = 0, float p_end_offset = 0);
 	void audio_track_set_key_stream(int p_track, int p_key, const RES &p_stream);
@@ -342,9 +391,10 @@ public:
 	void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
 	bool track_get_interpolation_loop_wrap(int p_track) const;
 
-	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const;
+	// r_key_hint is an optional per caller cursor, it makes key lookup constant time when playing forward
+	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_key_hint = NULL) const;
 
-	Variant value_track_interpolate(int p_track, float p_time) const;
+	Variant value_track_interpolate(int p_track, float p_time, int *r_key_hint = NULL) const;
 	void value_track_get_key_indices(int p_track, float p_time, float p_delta, List<int> *p_indices) const;
 	void value_track_set_update_mode(int p_track, UpdateMode p_mode);
 	UpdateMode value_track_get_update_mode(int p_track) const;
@@ -368,8 +418,14 @@ public:
 
 	void clear();
 
+	virtual bool is_lazy_load_supported() const { return true; } //players fetch it through get_animation() or play()
+
 	void optimize(float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
 
+	void transform_track_compress(int p_track);
+	bool transform_track_is_compressed(int p_track) const;
+	void compress();
+
 	Animation();
 	~Animation();
 };
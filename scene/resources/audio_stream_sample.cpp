@@ -90,6 +90,81 @@ void AudioStreamPlaybackSample::seek(float p_time) {
 	offset = uint64_t(p_time * base->mix_rate) << MIX_FRAC_BITS;
 }
 
+void AudioStreamPlaybackSample::skip(float p_time) {
+
+	if (!base->data || !active)
+		return;
+
+	if (base->format == AudioStreamSample::FORMAT_IMA_ADPCM) {
+		//decoder state can't jump ahead, decode into a scratch buffer instead
+		AudioFrame scratch[256];
+		int frames = p_time * AudioServer::get_singleton()->get_mix_rate();
+		while (frames > 0 && active) {
+			int amount = MIN(frames, 256);
+			mix(scratch, 1.0, amount);
+			frames -= amount;
+		}
+		return;
+	}
+
+	int len = base->data_bytes;
+	if (base->format == AudioStreamSample::FORMAT_16_BITS) {
+		len /= 2;
+	}
+	if (base->stereo) {
+		len /= 2;
+	}
+
+	int64_t loop_begin_fp = ((int64_t)base->loop_begin << MIX_FRAC_BITS);
+	int64_t loop_end_fp = ((int64_t)base->loop_end << MIX_FRAC_BITS);
+	int64_t loop_len_fp = loop_end_fp - loop_begin_fp;
+	int64_t length_fp = ((int64_t)len << MIX_FRAC_BITS);
+	int64_t amount = int64_t(p_time * base->mix_rate * MIX_FRAC_LEN);
+
+	if (base->loop_mode != AudioStreamSample::LOOP_DISABLED && loop_len_fp <= 0) {
+		return; //broken loop points, mix() will stop it
+	}
+
+	//same wrapping as in mix(), but in one step
+	switch (base->loop_mode) {
+		case AudioStreamSample::LOOP_DISABLED: {
+			offset += amount;
+			if (offset >= length_fp) {
+				active = false;
+			}
+		} break;
+		case AudioStreamSample::LOOP_FORWARD: {
+			offset += amount;
+			if (offset >= loop_end_fp) {
+				offset = loop_begin_fp + (offset - loop_begin_fp) % loop_len_fp;
+			}
+		} break;
+		case AudioStreamSample::LOOP_PING_PONG: {
+			//position along a forward and back cycle, starting at loop begin
+			int64_t cycle = sign > 0 ? offset - loop_begin_fp + amount : 2 * loop_len_fp - (offset - loop_begin_fp) + amount;
+			if (sign > 0 && cycle < loop_len_fp) {
+				offset += amount;
+				break;
+			}
+			cycle %= 2 * loop_len_fp;
+			if (cycle < loop_len_fp) {
+				offset = loop_begin_fp + cycle;
+				sign = 1;
+			} else {
+				offset = loop_begin_fp + 2 * loop_len_fp - cycle;
+				sign = -1;
+			}
+		} break;
+		case AudioStreamSample::LOOP_BACKWARD: {
+			sign = -1;
+			offset -= amount;
+			if (offset < loop_begin_fp) {
+				offset = loop_end_fp - (loop_begin_fp - offset) % loop_len_fp;
+			}
+		} break;
+	}
+}
+
 template <class Depth, bool is_stereo, bool is_ima_adpcm>
 void AudioStreamPlaybackSample::do_resample(const Depth *p_src, AudioFrame *p_dst, int64_t &offset, int32_t &increment, uint32_t amount, IMA_ADPCM_State *ima_adpcm) {
 
@@ -211,8 +286,8 @@ void AudioStreamPlaybackSample::do_resample(const Depth *p_src, AudioFrame *p_ds
 			final_r = final; //copy to right channel if stereo
 		}
 
-		p_dst->l = final / 32767.0;
-		p_dst->r = final_r / 32767.0;
+		p_dst->l = final * (1.0f / 32767.0f);
+		p_dst->r = final_r * (1.0f / 32767.0f);
 		p_dst++;
 
 		offset += increment;
@@ -74,6 +74,7 @@ public:
 
 	virtual float get_playback_position() const;
 	virtual void seek(float p_time);
+	virtual void skip(float p_time);
 
 	virtual void mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames);
 
@@ -137,6 +138,7 @@ public:
 	bool is_stereo() const;
 
 	virtual float get_length() const; //if supported, otherwise return 0
+	virtual uint64_t get_memory_usage() const { return data_bytes; }
 
 	void set_data(const PoolVector<uint8_t> &p_data);
 	PoolVector<uint8_t> get_data() const;
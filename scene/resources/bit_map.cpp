@@ -31,6 +31,39 @@
 #include "bit_map.h"
 
 #include "core/io/image_loader.h"
+#include "core/os/worker_thread_pool.h"
+
+// Below this amount of pixels, waking up worker threads costs more than it saves.
+#define PARALLEL_MIN_PIXELS 16384
+#define ROWS_PER_BAND 64
+#define COLUMNS_PER_CHUNK 64
+
+static _FORCE_INLINE_ bool get_bit_fast(const uint8_t *p_bits, int p_width, int p_x, int p_y) {
+
+	int ofs = p_width * p_y + p_x;
+	return (p_bits[ofs / 8] & (1 << (ofs % 8))) != 0;
+}
+
+static _FORCE_INLINE_ void set_bit_fast(uint8_t *p_bits, int p_width, int p_x, int p_y, bool p_value) {
+
+	int ofs = p_width * p_y + p_x;
+	if (p_value)
+		p_bits[ofs / 8] |= (1 << (ofs % 8));
+	else
+		p_bits[ofs / 8] &= ~(1 << (ofs % 8));
+}
+
+static void run_jobs(uint32_t p_count, uint32_t p_pixels, WorkerThreadPool::TaskFunc p_func, void *p_job) {
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_count > 1 && p_pixels >= PARALLEL_MIN_PIXELS && pool && pool->get_thread_count() > 0) {
+		pool->wait_for_task_completion(pool->add_native_group_task(p_func, p_job, p_count));
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_func(p_job, i);
+		}
+	}
+}
 
 void BitMap::create(const Size2 &p_size) {
 
@@ -171,7 +204,7 @@ Dictionary BitMap::_get_data() const {
 	return d;
 }
 
-Vector<Vector2> BitMap::_march_square(const Rect2i &rect, const Point2i &start) const {
+static Vector<Vector2> march_square(const uint8_t *p_bits, int p_width, int p_height, const Rect2i &rect, const Point2i &start) {
 
 	int stepx = 0;
 	int stepy = 0;
@@ -198,13 +231,13 @@ Vector<Vector2> BitMap::_march_square(const Rect2i &rect, const Point2i &start)
 			+---+---+
 			*/
 			Point2i tl = Point2i(curx - 1, cury - 1);
-			sv += (rect.has_point(tl) && get_bit(tl)) ? 1 : 0;
+			sv += (rect.has_point(tl) && get_bit_fast(p_bits, p_width, tl.x, tl.y)) ? 1 : 0;
 			Point2i tr = Point2i(curx, cury - 1);
-			sv += (rect.has_point(tr) && get_bit(tr)) ? 2 : 0;
+			sv += (rect.has_point(tr) && get_bit_fast(p_bits, p_width, tr.x, tr.y)) ? 2 : 0;
 			Point2i bl = Point2i(curx - 1, cury);
-			sv += (rect.has_point(bl) && get_bit(bl)) ? 4 : 0;
+			sv += (rect.has_point(bl) && get_bit_fast(p_bits, p_width, bl.x, bl.y)) ? 4 : 0;
 			Point2i br = Point2i(curx, cury);
-			sv += (rect.has_point(br) && get_bit(br)) ? 8 : 0;
+			sv += (rect.has_point(br) && get_bit_fast(p_bits, p_width, br.x, br.y)) ? 8 : 0;
 			ERR_FAIL_COND_V(sv == 0 || sv == 15, Vector<Vector2>());
 		}
 
@@ -331,7 +364,7 @@ Vector<Vector2> BitMap::_march_square(const Rect2i &rect, const Point2i &start)
 		prevx = stepx;
 		prevy = stepy;
 
-		ERR_FAIL_COND_V((int)count > width * height, _points);
+		ERR_FAIL_COND_V((int)count > p_width * p_height, _points);
 	} while (curx != startx || cury != starty);
 	return _points;
 }
@@ -417,80 +450,100 @@ static Vector<Vector2> reduce(const Vector<Vector2> &points, const Rect2i &rect,
 	return result;
 }
 
-struct FillBitsStackEntry {
-	Point2i pos;
-	int i;
-	int j;
+struct PolygonJob {
+	const uint8_t *bits;
+	int width;
+	int height;
+	Rect2i rect;
+	float epsilon;
+	int *parents;
+	Vector<int> *band_roots;
+	const int *roots;
+	Vector<Vector2> *polygons;
 };
 
-static void fill_bits(const BitMap *p_src, Ref<BitMap> &p_map, const Point2i &p_pos, const Rect2i &rect) {
-
-	// Using a custom stack to work iteratively to avoid stack overflow on big bitmaps
-	PoolVector<FillBitsStackEntry> stack;
-	// Tracking size since we won't be shrinking the stack vector
-	int stack_size = 0;
+// Every set pixel of the rect points to a previous pixel of its 8-connected area, so the roots
+// are the first pixel of each area in scan order, which is where its outline is traced from.
+static _FORCE_INLINE_ int find_area_root(int *p_parents, int p_index) {
 
-	Point2i pos = p_pos;
-	int next_i = 0;
-	int next_j = 0;
+	while (p_parents[p_index] != p_index) {
+		p_parents[p_index] = p_parents[p_parents[p_index]];
+		p_index = p_parents[p_index];
+	}
+	return p_index;
+}
 
-	bool reenter = true;
-	bool popped = false;
-	do {
-		if (reenter) {
-			next_i = pos.x - 1;
-			next_j = pos.y - 1;
-			reenter = false;
-		}
+static _FORCE_INLINE_ void merge_areas(int *p_parents, int p_a, int p_b) {
 
-		for (int i = next_i; i <= pos.x + 1; i++) {
-			for (int j = next_j; j <= pos.y + 1; j++) {
-				if (popped) {
-					// The next loop over j must start normally
-					next_j = pos.y;
-					popped = false;
-					// Skip because an iteration was already executed with current counter values
-					continue;
-				}
+	int a = find_area_root(p_parents, p_a);
+	int b = find_area_root(p_parents, p_b);
+	if (a < b) {
+		p_parents[b] = a;
+	} else if (b < a) {
+		p_parents[a] = b;
+	}
+}
 
-				if (i < rect.position.x || i >= rect.position.x + rect.size.x)
-					continue;
-				if (j < rect.position.y || j >= rect.position.y + rect.size.y)
-					continue;
+static void merge_with_row_above(int *p_parents, int p_index, int p_x, int p_width) {
 
-				if (p_map->get_bit(Vector2(i, j)))
-					continue;
+	int above = p_index - p_width;
+	if (p_x > 0 && p_parents[above - 1] >= 0)
+		merge_areas(p_parents, p_index, above - 1);
+	if (p_parents[above] >= 0)
+		merge_areas(p_parents, p_index, above);
+	if (p_x < p_width - 1 && p_parents[above + 1] >= 0)
+		merge_areas(p_parents, p_index, above + 1);
+}
 
-				else if (p_src->get_bit(Vector2(i, j))) {
-					p_map->set_bit(Vector2(i, j), true);
+// Bands are labeled independently, their first rows are merged with the band above afterwards.
+static void label_band(void *p_job, uint32_t p_band) {
 
-					FillBitsStackEntry se = { pos, i, j };
-					stack.resize(MAX(stack_size + 1, stack.size()));
-					stack.set(stack_size, se);
-					stack_size++;
+	PolygonJob *job = (PolygonJob *)p_job;
+	const Rect2i &r = job->rect;
+	int *parents = job->parents;
 
-					pos = Point2i(i, j);
-					reenter = true;
-					break;
-				}
-			}
-			if (reenter) {
-				break;
+	int from = p_band * ROWS_PER_BAND;
+	int to = MIN(from + ROWS_PER_BAND, r.size.height);
+	for (int y = from; y < to; y++) {
+		for (int x = 0; x < r.size.width; x++) {
+			int index = y * r.size.width + x;
+			if (!get_bit_fast(job->bits, job->width, r.position.x + x, r.position.y + y)) {
+				parents[index] = -1;
+				continue;
 			}
+
+			parents[index] = index;
+			if (x > 0 && parents[index - 1] >= 0)
+				merge_areas(parents, index, index - 1);
+			if (y > from)
+				merge_with_row_above(parents, index, x, r.size.width);
 		}
-		if (!reenter) {
-			if (stack_size) {
-				FillBitsStackEntry se = stack.get(stack_size - 1);
-				stack_size--;
-				pos = se.pos;
-				next_i = se.i;
-				next_j = se.j;
-				popped = true;
-			}
+	}
+}
+
+static void find_band_roots(void *p_job, uint32_t p_band) {
+
+	PolygonJob *job = (PolygonJob *)p_job;
+	const Rect2i &r = job->rect;
+
+	int from = p_band * ROWS_PER_BAND * r.size.width;
+	int to = MIN((int)(p_band + 1) * ROWS_PER_BAND, r.size.height) * r.size.width;
+	for (int i = from; i < to; i++) {
+		if (job->parents[i] == i) {
+			job->band_roots[p_band].push_back(i);
 		}
-	} while (reenter || popped);
+	}
+}
+
+static void trace_polygon(void *p_job, uint32_t p_index) {
+
+	PolygonJob *job = (PolygonJob *)p_job;
+	const Rect2i &r = job->rect;
 
-	print_verbose("BitMap: Max stack size: " + itos(stack.size()));
+	int root = job->roots[p_index];
+	Point2i start = r.position + Point2i(root % r.size.width, root / r.size.width);
+	Vector<Vector2> polygon = march_square(job->bits, job->width, job->height, r, start);
+	job->polygons[p_index] = reduce(polygon, r, job->epsilon);
 }
 
 Vector<Vector<Vector2> > BitMap::clip_opaque_to_polygons(const Rect2 &p_rect, float p_epsilon) const {
@@ -498,36 +551,165 @@ Vector<Vector<Vector2> > BitMap::clip_opaque_to_polygons(const Rect2 &p_rect, fl
 	Rect2i r = Rect2i(0, 0, width, height).clip(p_rect);
 	print_verbose("BitMap: Rect: " + r);
 
-	Point2i from;
-	Ref<BitMap> fill;
-	fill.instance();
-	fill->create(get_size());
-
 	Vector<Vector<Vector2> > polygons;
-	for (int i = r.position.y; i < r.position.y + r.size.height; i++) {
-		for (int j = r.position.x; j < r.position.x + r.size.width; j++) {
-			if (!fill->get_bit(Point2(j, i)) && get_bit(Point2(j, i))) {
+	if (r.size.width <= 0 || r.size.height <= 0) {
+		return polygons;
+	}
 
-				fill_bits(this, fill, Point2i(j, i), r);
+	int pixels = r.size.width * r.size.height;
+	int bands = (r.size.height + ROWS_PER_BAND - 1) / ROWS_PER_BAND;
+
+	Vector<int> parents;
+	parents.resize(pixels);
+	Vector<Vector<int> > band_roots;
+	band_roots.resize(bands);
+
+	PolygonJob job;
+	job.bits = bitmask.ptr();
+	job.width = width;
+	job.height = height;
+	job.rect = r;
+	job.epsilon = p_epsilon;
+	job.parents = parents.ptrw();
+	job.band_roots = band_roots.ptrw();
+
+	run_jobs(bands, pixels, &label_band, &job);
+
+	for (int i = 1; i < bands; i++) {
+		int first = i * ROWS_PER_BAND * r.size.width;
+		for (int x = 0; x < r.size.width; x++) {
+			if (job.parents[first + x] >= 0) {
+				merge_with_row_above(job.parents, first + x, x, r.size.width);
+			}
+		}
+	}
 
-				Vector<Vector2> polygon = _march_square(r, Point2i(j, i));
-				print_verbose("BitMap: Pre reduce: " + itos(polygon.size()));
-				polygon = reduce(polygon, r, p_epsilon);
-				print_verbose("BitMap: Post reduce: " + itos(polygon.size()));
+	run_jobs(bands, pixels, &find_band_roots, &job);
 
-				if (polygon.size() < 3) {
-					print_verbose("Invalid polygon, skipped");
-					continue;
-				}
+	Vector<int> roots;
+	for (int i = 0; i < bands; i++) {
+		roots.append_array(band_roots[i]);
+	}
 
-				polygons.push_back(polygon);
-			}
+	Vector<Vector<Vector2> > traced;
+	traced.resize(roots.size());
+	job.roots = roots.ptr();
+	job.polygons = traced.ptrw();
+
+	run_jobs(roots.size(), pixels, &trace_polygon, &job);
+
+	for (int i = 0; i < traced.size(); i++) {
+		if (traced[i].size() < 3) {
+			print_verbose("Invalid polygon, skipped");
+			continue;
 		}
+		polygons.push_back(traced[i]);
 	}
 
 	return polygons;
 }
 
+struct GrowJob {
+	const uint8_t *bits;
+	int width;
+	Rect2i rect;
+	bool bit_value;
+	int radius;
+	int *distances;
+};
+
+// First pass of the distance transform, vertical distance to the nearest pixel that already
+// has the wanted value, anything past the radius is clamped to radius + 1.
+static void grow_columns(void *p_job, uint32_t p_chunk) {
+
+	GrowJob *job = (GrowJob *)p_job;
+	const Rect2i &r = job->rect;
+	int *distances = job->distances;
+	int w = r.size.width;
+	int far = job->radius + 1;
+
+	int from = p_chunk * COLUMNS_PER_CHUNK;
+	int to = MIN(from + COLUMNS_PER_CHUNK, w);
+	for (int y = 0; y < r.size.height; y++) {
+		int *row = distances + y * w;
+		for (int x = from; x < to; x++) {
+			if (get_bit_fast(job->bits, job->width, r.position.x + x, r.position.y + y) == job->bit_value) {
+				row[x] = 0;
+			} else {
+				row[x] = y > 0 ? MIN(row[x - w] + 1, far) : far;
+			}
+		}
+	}
+	for (int y = r.size.height - 2; y >= 0; y--) {
+		int *row = distances + y * w;
+		for (int x = from; x < to; x++) {
+			row[x] = MIN(row[x], row[x + w] + 1);
+		}
+	}
+}
+
+// Second pass, lower envelope of the parabolas of the row (Felzenszwalb & Huttenlocher),
+// leaves 1 in the row where a pixel with the wanted value is within the radius.
+static void grow_row(void *p_job, uint32_t p_row) {
+
+	GrowJob *job = (GrowJob *)p_job;
+	const Rect2i &r = job->rect;
+	int w = r.size.width;
+	int *row = job->distances + p_row * w;
+	int64_t radius_squared = (int64_t)job->radius * job->radius;
+
+	Vector<int> sites;
+	sites.resize(w);
+	Vector<int> heights;
+	heights.resize(w);
+	Vector<double> bounds;
+	bounds.resize(w);
+	int *s = sites.ptrw();
+	int *g = heights.ptrw();
+	double *z = bounds.ptrw();
+
+	int count = 0;
+	for (int q = 0; q < w; q++) {
+		if (row[q] > job->radius)
+			continue;
+
+		int64_t fq = (int64_t)row[q] * row[q] + (int64_t)q * q;
+		double boundary = -1e30;
+		while (count > 0) {
+			int v = s[count - 1];
+			int64_t fv = (int64_t)g[count - 1] * g[count - 1] + (int64_t)v * v;
+			boundary = (double)(fq - fv) / (2.0 * (q - v));
+			if (boundary > z[count - 1])
+				break;
+			count--;
+		}
+		if (count == 0)
+			boundary = -1e30;
+
+		s[count] = q;
+		g[count] = row[q];
+		z[count] = boundary;
+		count++;
+	}
+
+	int k = 0;
+	for (int x = 0; x < w; x++) {
+		bool found = false;
+		if (count > 0) {
+			while (k + 1 < count && z[k + 1] < x)
+				k++;
+			int64_t dx = x - s[k];
+			found = dx * dx + (int64_t)g[k] * g[k] <= radius_squared;
+		}
+		if (!found && !job->bit_value) {
+			// outside of rectangle counts as bit not set
+			int border = MIN(MIN(x + 1, w - x), MIN((int)p_row + 1, r.size.height - (int)p_row));
+			found = border <= job->radius;
+		}
+		row[x] = found ? 1 : 0;
+	}
+}
+
 void BitMap::grow_mask(int p_pixels, const Rect2 &p_rect) {
 
 	if (p_pixels == 0) {
@@ -538,47 +720,31 @@ void BitMap::grow_mask(int p_pixels, const Rect2 &p_rect) {
 	p_pixels = Math::abs(p_pixels);
 
 	Rect2i r = Rect2i(0, 0, width, height).clip(p_rect);
+	if (r.size.width <= 0 || r.size.height <= 0) {
+		return;
+	}
 
-	Ref<BitMap> copy;
-	copy.instance();
-	copy->create(get_size());
-	copy->bitmask = bitmask;
-
-	for (int i = r.position.y; i < r.position.y + r.size.height; i++) {
-		for (int j = r.position.x; j < r.position.x + r.size.width; j++) {
-			if (bit_value == get_bit(Point2(j, i)))
-				continue;
-
-			bool found = false;
-
-			for (int y = i - p_pixels; y <= i + p_pixels; y++) {
-				for (int x = j - p_pixels; x <= j + p_pixels; x++) {
-
-					bool outside = false;
-
-					if ((x < p_rect.position.x) || (x >= p_rect.position.x + p_rect.size.x) || (y < p_rect.position.y) || (y >= p_rect.position.y + p_rect.size.y)) {
-						// outside of rectangle counts as bit not set
-						if (!bit_value)
-							outside = true;
-						else
-							continue;
-					}
-
-					float d = Point2(j, i).distance_to(Point2(x, y)) - CMP_EPSILON;
-					if (d > p_pixels)
-						continue;
-
-					if (outside || (bit_value == copy->get_bit(Point2(x, y)))) {
-						found = true;
-						break;
-					}
-				}
-				if (found)
-					break;
-			}
-
-			if (found) {
-				set_bit(Point2(j, i), bit_value);
+	int pixels = r.size.width * r.size.height;
+	Vector<int> distances;
+	distances.resize(pixels);
+
+	GrowJob job;
+	job.bits = bitmask.ptr();
+	job.width = width;
+	job.rect = r;
+	job.bit_value = bit_value;
+	job.radius = p_pixels;
+	job.distances = distances.ptrw();
+
+	run_jobs((r.size.width + COLUMNS_PER_CHUNK - 1) / COLUMNS_PER_CHUNK, pixels, &grow_columns, &job);
+	run_jobs(r.size.height, pixels, &grow_row, &job);
+
+	uint8_t *bits = bitmask.ptrw();
+	const int *found = distances.ptr();
+	for (int y = 0; y < r.size.height; y++) {
+		for (int x = 0; x < r.size.width; x++) {
+			if (found[y * r.size.width + x]) {
+				set_bit_fast(bits, width, r.position.x + x, r.position.y + y, bit_value);
 			}
 		}
 	}
@@ -44,6 +44,83 @@ static _FORCE_INLINE_ T _bezier_interp(real_t t, T start, T control_1, T control
 	return start * omt3 + control_1 * omt2 * t * 3.0 + control_2 * omt * t2 * 3.0 + end * t3;
 }
 
+//baked points are spaced evenly by the bake interval (only the last segment may be shorter),
+//so the segment holding an offset is found by division, no search needed
+static _FORCE_INLINE_ void _get_baked_segment(real_t p_offset, int p_count, real_t p_interval, real_t p_max_ofs, int &r_idx, real_t &r_frac) {
+
+	int last = p_count - 2;
+
+	if (p_offset <= 0) {
+		r_idx = 0;
+		r_frac = 0;
+		return;
+	}
+	if (p_offset >= p_max_ofs) {
+		r_idx = last;
+		r_frac = 1;
+		return;
+	}
+
+	int idx = MIN((int)Math::floor((double)p_offset / (double)p_interval), last);
+	real_t length = idx == last ? p_max_ofs - last * p_interval : p_interval;
+
+	r_idx = idx;
+	r_frac = length > 0 ? MIN((p_offset - idx * p_interval) / length, (real_t)1.0) : 0;
+}
+
+template <class T>
+static _FORCE_INLINE_ T _interpolate_baked_point(const T *p_points, int p_count, real_t p_offset, real_t p_interval, real_t p_max_ofs, bool p_cubic) {
+
+	if (p_count == 1 || p_offset < 0)
+		return p_points[0];
+	if (p_offset >= p_max_ofs)
+		return p_points[p_count - 1];
+
+	int idx;
+	real_t frac;
+	_get_baked_segment(p_offset, p_count, p_interval, p_max_ofs, idx, frac);
+
+	if (p_cubic) {
+
+		T pre = idx > 0 ? p_points[idx - 1] : p_points[idx];
+		T post = (idx < (p_count - 2)) ? p_points[idx + 2] : p_points[idx + 1];
+		return p_points[idx].cubic_interpolate(p_points[idx + 1], pre, post, frac);
+	} else {
+		return p_points[idx].linear_interpolate(p_points[idx + 1], frac);
+	}
+}
+
+//rotation turning one baked up vector into the next, axis in the normal and angle in d
+static _FORCE_INLINE_ Plane _get_up_rotation(const Vector3 &p_up, const Vector3 &p_next_up, const Vector3 &p_forward) {
+
+	Vector3 axis = p_up.cross(p_next_up);
+
+	if (axis.length_squared() < CMP_EPSILON2)
+		axis = p_forward;
+	else
+		axis.normalize();
+
+	return Plane(axis, p_up.angle_to(p_next_up));
+}
+
+static _FORCE_INLINE_ Vector3 _interpolate_baked_up(const Vector3 *p_ups, const Plane *p_rotations, int p_count, real_t p_offset, real_t p_interval, real_t p_max_ofs) {
+
+	if (p_count == 1)
+		return p_ups[0];
+
+	int idx;
+	real_t frac;
+	_get_baked_segment(p_offset, p_count, p_interval, p_max_ofs, idx, frac);
+
+	if (frac <= 0)
+		return p_ups[idx];
+	if (frac >= 1)
+		return p_ups[idx + 1];
+
+	const Plane &rotation = p_rotations[idx];
+	return p_ups[idx].rotated(rotation.normal, rotation.d * frac);
+}
+
 const char *Curve::SIGNAL_RANGE_CHANGED = "range_changed";
 
 Curve::Curve() {
@@ -767,37 +844,35 @@ Vector2 Curve2D::interpolate_baked(float p_offset, bool p_cubic) const {
 	int pc = baked_point_cache.size();
 	ERR_FAIL_COND_V_MSG(pc == 0, Vector2(), "No points in Curve2D.");
 
-	if (pc == 1)
-		return baked_point_cache.get(0);
-
-	int bpc = baked_point_cache.size();
 	PoolVector2Array::Read r = baked_point_cache.read();
+	return _interpolate_baked_point(r.ptr(), pc, p_offset, bake_interval, baked_max_ofs, p_cubic);
+}
 
-	if (p_offset < 0)
-		return r[0];
-	if (p_offset >= baked_max_ofs)
-		return r[bpc - 1];
+PoolVector2Array Curve2D::interpolate_baked_array(const PoolRealArray &p_offsets, bool p_cubic) const {
 
-	int idx = Math::floor((double)p_offset / (double)bake_interval);
-	float frac = Math::fmod(p_offset, (float)bake_interval);
+	if (baked_cache_dirty)
+		_bake();
 
-	if (idx >= bpc - 1) {
-		return r[bpc - 1];
-	} else if (idx == bpc - 2) {
-		if (frac > 0)
-			frac /= Math::fmod(baked_max_ofs, bake_interval);
-	} else {
-		frac /= bake_interval;
-	}
+	PoolVector2Array ret;
 
-	if (p_cubic) {
+	//validate//
+	int pc = baked_point_cache.size();
+	ERR_FAIL_COND_V_MSG(pc == 0, ret, "No points in Curve2D.");
 
-		Vector2 pre = idx > 0 ? r[idx - 1] : r[idx];
-		Vector2 post = (idx < (bpc - 2)) ? r[idx + 2] : r[idx + 1];
-		return r[idx].cubic_interpolate(r[idx + 1], pre, post, frac);
-	} else {
-		return r[idx].linear_interpolate(r[idx + 1], frac);
+	int count = p_offsets.size();
+	ret.resize(count);
+
+	PoolRealArray::Read ro = p_offsets.read();
+	PoolVector2Array::Read r = baked_point_cache.read();
+	PoolVector2Array::Write w = ret.write();
+
+	for (int i = 0; i < count; i++) {
+		w[i] = _interpolate_baked_point(r.ptr(), pc, ro[i], bake_interval, baked_max_ofs, p_cubic);
 	}
+
+	w = PoolVector2Array::Write();
+
+	return ret;
 }
 
 PoolVector2Array Curve2D::get_baked_points() const {
@@ -997,6 +1072,7 @@ void Curve2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_baked_length"), &Curve2D::get_baked_length);
 	ClassDB::bind_method(D_METHOD("interpolate_baked", "offset", "cubic"), &Curve2D::interpolate_baked, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("interpolate_baked_array", "offsets", "cubic"), &Curve2D::interpolate_baked_array, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_baked_points"), &Curve2D::get_baked_points);
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_point"), &Curve2D::get_closest_point);
 	ClassDB::bind_method(D_METHOD("get_closest_offset", "to_point"), &Curve2D::get_closest_offset);
@@ -1040,7 +1116,7 @@ void Curve3D::add_point(const Vector3 &p_pos, const Vector3 &p_in, const Vector3
 	else
 		points.push_back(n);
 
-	baked_cache_dirty = true;
+	_mark_baked_dirty();
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 void Curve3D::set_point_position(int p_index, const Vector3 &p_pos) {
@@ -1048,7 +1124,7 @@ void Curve3D::set_point_position(int p_index, const Vector3 &p_pos) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].pos = p_pos;
-	baked_cache_dirty = true;
+	_mark_baked_dirty();
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 Vector3 Curve3D::get_point_position(int p_index) const {
@@ -1062,7 +1138,7 @@ void Curve3D::set_point_tilt(int p_index, float p_tilt) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].tilt = p_tilt;
-	baked_cache_dirty = true;
+	_mark_baked_dirty();
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 float Curve3D::get_point_tilt(int p_index) const {
@@ -1076,7 +1152,7 @@ void Curve3D::set_point_in(int p_index, const Vector3 &p_in) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].in = p_in;
-	baked_cache_dirty = true;
+	_mark_baked_dirty();
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 Vector3 Curve3D::get_point_in(int p_index) const {
@@ -1090,7 +1166,7 @@ void Curve3D::set_point_out(int p_index, const Vector3 &p_out) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].out = p_out;
-	baked_cache_dirty = true;
+	_mark_baked_dirty();
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -1104,7 +1180,7 @@ void Curve3D::remove_point(int p_index) {
 
 	ERR_FAIL_INDEX(p_index, points.size());
 	points.remove(p_index);
-	baked_cache_dirty = true;
+	_mark_baked_dirty();
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -1112,7 +1188,7 @@ void Curve3D::clear_points() {
 
 	if (!points.empty()) {
 		points.clear();
-		baked_cache_dirty = true;
+		_mark_baked_dirty();
 		emit_signal(CoreStringNames::get_singleton()->changed);
 	}
 }
@@ -1166,43 +1242,36 @@ void Curve3D::_bake_segment3d(Map<float, Vector3> &r_bake, float p_begin, float
 	}
 }
 
-void Curve3D::_bake() const {
-
-	if (!baked_cache_dirty)
-		return;
+void Curve3D::_bake_points(const Vector<Point> &p_points, float p_bake_interval, bool p_up_vector_enabled, BakeData &r_data) {
 
-	baked_max_ofs = 0;
-	baked_cache_dirty = false;
+	r_data.max_ofs = 0;
 
-	if (points.size() == 0) {
-		baked_point_cache.resize(0);
-		baked_tilt_cache.resize(0);
-		baked_up_vector_cache.resize(0);
+	if (p_points.size() == 0) {
 		return;
 	}
 
-	if (points.size() == 1) {
+	if (p_points.size() == 1) {
 
-		baked_point_cache.resize(1);
-		baked_point_cache.set(0, points[0].pos);
-		baked_tilt_cache.resize(1);
-		baked_tilt_cache.set(0, points[0].tilt);
+		r_data.points.resize(1);
+		r_data.points.set(0, p_points[0].pos);
+		r_data.tilts.resize(1);
+		r_data.tilts.set(0, p_points[0].tilt);
 
-		if (up_vector_enabled) {
+		if (p_up_vector_enabled) {
 
-			baked_up_vector_cache.resize(1);
-			baked_up_vector_cache.set(0, Vector3(0, 1, 0));
-		} else
-			baked_up_vector_cache.resize(0);
+			r_data.up_vectors.resize(1);
+			r_data.up_vectors.set(0, Vector3(0, 1, 0));
+			r_data.tilted_up_vectors = r_data.up_vectors;
+		}
 
 		return;
 	}
 
-	Vector3 pos = points[0].pos;
+	Vector3 pos = p_points[0].pos;
 	List<Plane> pointlist;
-	pointlist.push_back(Plane(pos, points[0].tilt));
+	pointlist.push_back(Plane(pos, p_points[0].tilt));
 
-	for (int i = 0; i < points.size() - 1; i++) {
+	for (int i = 0; i < p_points.size() - 1; i++) {
 
 		float step = 0.1; // at least 10 substeps ought to be enough?
 		float p = 0;
@@ -1213,10 +1282,10 @@ void Curve3D::_bake() const {
 			if (np > 1.0)
 				np = 1.0;
 
-			Vector3 npp = _bezier_interp(np, points[i].pos, points[i].pos + points[i].out, points[i + 1].pos + points[i + 1].in, points[i + 1].pos);
+			Vector3 npp = _bezier_interp(np, p_points[i].pos, p_points[i].pos + p_points[i].out, p_points[i + 1].pos + p_points[i + 1].in, p_points[i + 1].pos);
 			float d = pos.distance_to(npp);
 
-			if (d > bake_interval) {
+			if (d > p_bake_interval) {
 				// OK! between P and NP there _has_ to be Something, let's go searching!
 
 				int iterations = 10; //lots of detail!
@@ -1227,10 +1296,10 @@ void Curve3D::_bake() const {
 
 				for (int j = 0; j < iterations; j++) {
 
-					npp = _bezier_interp(mid, points[i].pos, points[i].pos + points[i].out, points[i + 1].pos + points[i + 1].in, points[i + 1].pos);
+					npp = _bezier_interp(mid, p_points[i].pos, p_points[i].pos + p_points[i].out, p_points[i + 1].pos + p_points[i + 1].in, p_points[i + 1].pos);
 					d = pos.distance_to(npp);
 
-					if (bake_interval < d)
+					if (p_bake_interval < d)
 						hi = mid;
 					else
 						low = mid;
@@ -1241,7 +1310,7 @@ void Curve3D::_bake() const {
 				p = mid;
 				Plane post;
 				post.normal = pos;
-				post.d = Math::lerp(points[i].tilt, points[i + 1].tilt, mid);
+				post.d = Math::lerp(p_points[i].tilt, p_points[i + 1].tilt, mid);
 				pointlist.push_back(post);
 			} else {
 
@@ -1250,22 +1319,24 @@ void Curve3D::_bake() const {
 		}
 	}
 
-	Vector3 lastpos = points[points.size() - 1].pos;
-	float lastilt = points[points.size() - 1].tilt;
+	Vector3 lastpos = p_points[p_points.size() - 1].pos;
+	float lastilt = p_points[p_points.size() - 1].tilt;
 
 	float rem = pos.distance_to(lastpos);
-	baked_max_ofs = (pointlist.size() - 1) * bake_interval + rem;
+	r_data.max_ofs = (pointlist.size() - 1) * p_bake_interval + rem;
 	pointlist.push_back(Plane(lastpos, lastilt));
 
-	baked_point_cache.resize(pointlist.size());
-	PoolVector3Array::Write w = baked_point_cache.write();
+	int count = pointlist.size();
+
+	r_data.points.resize(count);
+	PoolVector3Array::Write w = r_data.points.write();
 	int idx = 0;
 
-	baked_tilt_cache.resize(pointlist.size());
-	PoolRealArray::Write wt = baked_tilt_cache.write();
+	r_data.tilts.resize(count);
+	PoolRealArray::Write wt = r_data.tilts.write();
 
-	baked_up_vector_cache.resize(up_vector_enabled ? pointlist.size() : 0);
-	PoolVector3Array::Write up_write = baked_up_vector_cache.write();
+	r_data.up_vectors.resize(p_up_vector_enabled ? count : 0);
+	PoolVector3Array::Write up_write = r_data.up_vectors.write();
 
 	Vector3 sideways;
 	Vector3 up;
@@ -1280,7 +1351,7 @@ void Curve3D::_bake() const {
 		w[idx] = E->get().normal;
 		wt[idx] = E->get().d;
 
-		if (!up_vector_enabled) {
+		if (!p_up_vector_enabled) {
 			idx++;
 			continue;
 		}
@@ -1311,6 +1382,105 @@ void Curve3D::_bake() const {
 
 		idx++;
 	}
+
+	if (!p_up_vector_enabled)
+		return;
+
+	//tilt the up vectors around the forward direction of their point and precompute the rotation
+	//between consecutive ones, so sampling an up vector is a single rotation
+
+	r_data.tilted_up_vectors.resize(count);
+	PoolVector3Array::Write tilted_write = r_data.tilted_up_vectors.write();
+
+	for (int i = 0; i < count; i++) {
+
+		forward = i < count - 1 ? (w[i + 1] - w[i]).normalized() : (w[i] - w[i - 1]).normalized();
+		tilted_write[i] = wt[i] != 0 ? up_write[i].rotated(forward, wt[i]) : up_write[i];
+	}
+
+	r_data.up_rotations.resize(count - 1);
+	r_data.tilted_up_rotations.resize(count - 1);
+	Plane *rotation_write = r_data.up_rotations.ptrw();
+	Plane *tilted_rotation_write = r_data.tilted_up_rotations.ptrw();
+
+	for (int i = 0; i < count - 1; i++) {
+
+		forward = (w[i + 1] - w[i]).normalized();
+		rotation_write[i] = _get_up_rotation(up_write[i], up_write[i + 1], forward);
+		tilted_rotation_write[i] = _get_up_rotation(tilted_write[i], tilted_write[i + 1], forward);
+	}
+}
+
+void Curve3D::_bake_task(void *p_userdata, uint32_t p_index) {
+
+	BakeTask *task = (BakeTask *)p_userdata;
+	_bake_points(task->points, task->bake_interval, task->up_vector_enabled, task->data);
+}
+
+void Curve3D::_set_baked(const BakeData &p_data) const {
+
+	baked_point_cache = p_data.points;
+	baked_tilt_cache = p_data.tilts;
+	baked_up_vector_cache = p_data.up_vectors;
+	baked_tilted_up_vector_cache = p_data.tilted_up_vectors;
+	baked_up_rotation_cache = p_data.up_rotations;
+	baked_tilted_up_rotation_cache = p_data.tilted_up_rotations;
+	baked_max_ofs = p_data.max_ofs;
+	baked_cache_dirty = false;
+}
+
+void Curve3D::_finish_bake_task(bool p_adopt) const {
+
+	if (!bake_task)
+		return;
+
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(bake_task->task);
+
+	if (p_adopt && bake_task->version == bake_version)
+		_set_baked(bake_task->data);
+
+	memdelete(bake_task);
+	bake_task = NULL;
+}
+
+void Curve3D::_mark_baked_dirty() {
+
+	baked_cache_dirty = true;
+	bake_version++;
+
+	//large curves rebake on the worker pool so the next sample after an edit doesn't have to bake them,
+	//one bake is in flight at a time and a result that went stale meanwhile is dropped for a synchronous bake
+	if (bake_task) {
+		if (!WorkerThreadPool::get_singleton()->is_task_completed(bake_task->task))
+			return;
+		_finish_bake_task(false);
+	}
+
+	if (baked_point_cache.size() < BACKGROUND_BAKE_MIN_POINTS || !WorkerThreadPool::get_singleton())
+		return;
+
+	bake_task = memnew(BakeTask);
+	bake_task->points = points;
+	bake_task->bake_interval = bake_interval;
+	bake_task->up_vector_enabled = up_vector_enabled;
+	bake_task->version = bake_version;
+	bake_task->task = WorkerThreadPool::get_singleton()->add_native_task(&Curve3D::_bake_task, bake_task);
+}
+
+void Curve3D::_bake() const {
+
+	if (!baked_cache_dirty)
+		return;
+
+	if (bake_task) {
+		_finish_bake_task(true);
+		if (!baked_cache_dirty)
+			return;
+	}
+
+	BakeData data;
+	_bake_points(points, bake_interval, up_vector_enabled, data);
+	_set_baked(data);
 }
 
 float Curve3D::get_baked_length() const {
@@ -1329,37 +1499,8 @@ Vector3 Curve3D::interpolate_baked(float p_offset, bool p_cubic) const {
 	int pc = baked_point_cache.size();
 	ERR_FAIL_COND_V_MSG(pc == 0, Vector3(), "No points in Curve3D.");
 
-	if (pc == 1)
-		return baked_point_cache.get(0);
-
-	int bpc = baked_point_cache.size();
 	PoolVector3Array::Read r = baked_point_cache.read();
-
-	if (p_offset < 0)
-		return r[0];
-	if (p_offset >= baked_max_ofs)
-		return r[bpc - 1];
-
-	int idx = Math::floor((double)p_offset / (double)bake_interval);
-	float frac = Math::fmod(p_offset, bake_interval);
-
-	if (idx >= bpc - 1) {
-		return r[bpc - 1];
-	} else if (idx == bpc - 2) {
-		if (frac > 0)
-			frac /= Math::fmod(baked_max_ofs, bake_interval);
-	} else {
-		frac /= bake_interval;
-	}
-
-	if (p_cubic) {
-
-		Vector3 pre = idx > 0 ? r[idx - 1] : r[idx];
-		Vector3 post = (idx < (bpc - 2)) ? r[idx + 2] : r[idx + 1];
-		return r[idx].cubic_interpolate(r[idx + 1], pre, post, frac);
-	} else {
-		return r[idx].linear_interpolate(r[idx + 1], frac);
-	}
+	return _interpolate_baked_point(r.ptr(), pc, p_offset, bake_interval, baked_max_ofs, p_cubic);
 }
 
 float Curve3D::interpolate_baked_tilt(float p_offset) const {
@@ -1374,25 +1515,16 @@ float Curve3D::interpolate_baked_tilt(float p_offset) const {
 	if (pc == 1)
 		return baked_tilt_cache.get(0);
 
-	int bpc = baked_tilt_cache.size();
 	PoolRealArray::Read r = baked_tilt_cache.read();
 
 	if (p_offset < 0)
 		return r[0];
 	if (p_offset >= baked_max_ofs)
-		return r[bpc - 1];
+		return r[pc - 1];
 
-	int idx = Math::floor((double)p_offset / (double)bake_interval);
-	float frac = Math::fmod(p_offset, bake_interval);
-
-	if (idx >= bpc - 1) {
-		return r[bpc - 1];
-	} else if (idx == bpc - 2) {
-		if (frac > 0)
-			frac /= Math::fmod(baked_max_ofs, bake_interval);
-	} else {
-		frac /= bake_interval;
-	}
+	int idx;
+	real_t frac;
+	_get_baked_segment(p_offset, pc, bake_interval, baked_max_ofs, idx, frac);
 
 	return Math::lerp(r[idx], r[idx + 1], frac);
 }
@@ -1407,38 +1539,65 @@ Vector3 Curve3D::interpolate_baked_up_vector(float p_offset, bool p_apply_tilt)
 	int count = baked_up_vector_cache.size();
 	ERR_FAIL_COND_V_MSG(count == 0, Vector3(0, 1, 0), "No up vectors in Curve3D.");
 
-	if (count == 1)
-		return baked_up_vector_cache.get(0);
+	PoolVector3Array::Read r = (p_apply_tilt ? baked_tilted_up_vector_cache : baked_up_vector_cache).read();
+	const Vector<Plane> &rotations = p_apply_tilt ? baked_tilted_up_rotation_cache : baked_up_rotation_cache;
+
+	return _interpolate_baked_up(r.ptr(), rotations.ptr(), count, p_offset, bake_interval, baked_max_ofs);
+}
 
-	PoolVector3Array::Read r = baked_up_vector_cache.read();
-	PoolVector3Array::Read rp = baked_point_cache.read();
-	PoolRealArray::Read rt = baked_tilt_cache.read();
+PoolVector3Array Curve3D::interpolate_baked_array(const PoolRealArray &p_offsets, bool p_cubic) const {
 
-	float offset = CLAMP(p_offset, 0.0f, baked_max_ofs);
+	if (baked_cache_dirty)
+		_bake();
 
-	int idx = Math::floor((double)offset / (double)bake_interval);
-	float frac = Math::fmod(offset, bake_interval) / bake_interval;
+	PoolVector3Array ret;
 
-	if (idx == count - 1)
-		return p_apply_tilt ? r[idx].rotated((rp[idx] - rp[idx - 1]).normalized(), rt[idx]) : r[idx];
+	//validate//
+	int pc = baked_point_cache.size();
+	ERR_FAIL_COND_V_MSG(pc == 0, ret, "No points in Curve3D.");
 
-	Vector3 forward = (rp[idx + 1] - rp[idx]).normalized();
-	Vector3 up = r[idx];
-	Vector3 up1 = r[idx + 1];
+	int count = p_offsets.size();
+	ret.resize(count);
 
-	if (p_apply_tilt) {
-		up.rotate(forward, rt[idx]);
-		up1.rotate(idx + 2 >= count ? forward : (rp[idx + 2] - rp[idx + 1]).normalized(), rt[idx + 1]);
+	PoolRealArray::Read ro = p_offsets.read();
+	PoolVector3Array::Read r = baked_point_cache.read();
+	PoolVector3Array::Write w = ret.write();
+
+	for (int i = 0; i < count; i++) {
+		w[i] = _interpolate_baked_point(r.ptr(), pc, ro[i], bake_interval, baked_max_ofs, p_cubic);
 	}
 
-	Vector3 axis = up.cross(up1);
+	w = PoolVector3Array::Write();
 
-	if (axis.length_squared() < CMP_EPSILON2)
-		axis = forward;
-	else
-		axis.normalize();
+	return ret;
+}
+
+PoolVector3Array Curve3D::interpolate_baked_up_vector_array(const PoolRealArray &p_offsets, bool p_apply_tilt) const {
+
+	if (baked_cache_dirty)
+		_bake();
+
+	PoolVector3Array ret;
+
+	//validate//
+	int pc = baked_up_vector_cache.size();
+	ERR_FAIL_COND_V_MSG(pc == 0, ret, "No up vectors in Curve3D.");
+
+	int count = p_offsets.size();
+	ret.resize(count);
+
+	PoolRealArray::Read ro = p_offsets.read();
+	PoolVector3Array::Read r = (p_apply_tilt ? baked_tilted_up_vector_cache : baked_up_vector_cache).read();
+	const Vector<Plane> &rotations = p_apply_tilt ? baked_tilted_up_rotation_cache : baked_up_rotation_cache;
+	PoolVector3Array::Write w = ret.write();
 
-	return up.rotated(axis, up.angle_to(up1) * frac);
+	for (int i = 0; i < count; i++) {
+		w[i] = _interpolate_baked_up(r.ptr(), rotations.ptr(), pc, ro[i], bake_interval, baked_max_ofs);
+	}
+
+	w = PoolVector3Array::Write();
+
+	return ret;
 }
 
 PoolVector3Array Curve3D::get_baked_points() const {
@@ -1543,7 +1702,7 @@ float Curve3D::get_closest_offset(const Vector3 &p_to_point) const {
 void Curve3D::set_bake_interval(float p_tolerance) {
 
 	bake_interval = p_tolerance;
-	baked_cache_dirty = true;
+	_mark_baked_dirty();
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -1555,7 +1714,7 @@ float Curve3D::get_bake_interval() const {
 void Curve3D::set_up_vector_enabled(bool p_enable) {
 
 	up_vector_enabled = p_enable;
-	baked_cache_dirty = true;
+	_mark_baked_dirty();
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -1612,7 +1771,7 @@ void Curve3D::_set_data(const Dictionary &p_data) {
 		points.write[i].tilt = rt[i];
 	}
 
-	baked_cache_dirty = true;
+	_mark_baked_dirty();
 }
 
 PoolVector3Array Curve3D::tessellate(int p_max_stages, float p_tolerance) const {
@@ -1681,6 +1840,8 @@ void Curve3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_baked_length"), &Curve3D::get_baked_length);
 	ClassDB::bind_method(D_METHOD("interpolate_baked", "offset", "cubic"), &Curve3D::interpolate_baked, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("interpolate_baked_up_vector", "offset", "apply_tilt"), &Curve3D::interpolate_baked_up_vector, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("interpolate_baked_array", "offsets", "cubic"), &Curve3D::interpolate_baked_array, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("interpolate_baked_up_vector_array", "offsets", "apply_tilt"), &Curve3D::interpolate_baked_up_vector_array, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_baked_points"), &Curve3D::get_baked_points);
 	ClassDB::bind_method(D_METHOD("get_baked_tilts"), &Curve3D::get_baked_tilts);
 	ClassDB::bind_method(D_METHOD("get_baked_up_vectors"), &Curve3D::get_baked_up_vectors);
@@ -1701,9 +1862,16 @@ void Curve3D::_bind_methods() {
 Curve3D::Curve3D() {
 	baked_cache_dirty = false;
 	baked_max_ofs = 0;
+	bake_version = 0;
+	bake_task = NULL;
 	/*	add_point(Vector3(-1,0,0));
 	add_point(Vector3(0,2,0));
 	add_point(Vector3(0,3,5));*/
 	bake_interval = 0.2;
 	up_vector_enabled = true;
 }
+
+Curve3D::~Curve3D() {
+
+	_finish_bake_task(false);
+}
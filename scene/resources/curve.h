@@ -31,6 +31,7 @@
 #ifndef CURVE_H
 #define CURVE_H
 
+#include "core/os/worker_thread_pool.h"
 #include "core/resource.h"
 
 // y(x) curve
@@ -202,6 +203,7 @@ public:
 
 	float get_baked_length() const;
 	Vector2 interpolate_baked(float p_offset, bool p_cubic = false) const;
+	PoolVector2Array interpolate_baked_array(const PoolRealArray &p_offsets, bool p_cubic = false) const;
 	PoolVector2Array get_baked_points() const; //useful for going through
 	Vector2 get_closest_point(const Vector2 &p_to_point) const;
 	float get_closest_offset(const Vector2 &p_to_point) const;
@@ -233,12 +235,50 @@ class Curve3D : public Resource {
 		Vector3 point;
 	};
 
+	struct BakeData {
+
+		PoolVector3Array points;
+		PoolRealArray tilts;
+		PoolVector3Array up_vectors;
+		PoolVector3Array tilted_up_vectors;
+		Vector<Plane> up_rotations; //per segment, normal is the axis and d the angle turning one up vector into the next
+		Vector<Plane> tilted_up_rotations;
+		float max_ofs;
+
+		BakeData() { max_ofs = 0; }
+	};
+
+	struct BakeTask {
+
+		Vector<Point> points;
+		float bake_interval;
+		bool up_vector_enabled;
+		uint64_t version;
+		BakeData data;
+		WorkerThreadPool::TaskID task;
+	};
+
+	enum {
+		BACKGROUND_BAKE_MIN_POINTS = 4096 //curves that baked to at least this many points rebake on the worker pool when edited
+	};
+
 	mutable bool baked_cache_dirty;
 	mutable PoolVector3Array baked_point_cache;
 	mutable PoolRealArray baked_tilt_cache;
 	mutable PoolVector3Array baked_up_vector_cache;
+	mutable PoolVector3Array baked_tilted_up_vector_cache;
+	mutable Vector<Plane> baked_up_rotation_cache;
+	mutable Vector<Plane> baked_tilted_up_rotation_cache;
 	mutable float baked_max_ofs;
 
+	uint64_t bake_version;
+	mutable BakeTask *bake_task;
+
+	static void _bake_points(const Vector<Point> &p_points, float p_bake_interval, bool p_up_vector_enabled, BakeData &r_data);
+	static void _bake_task(void *p_userdata, uint32_t p_index);
+	void _set_baked(const BakeData &p_data) const;
+	void _finish_bake_task(bool p_adopt) const;
+	void _mark_baked_dirty();
 	void _bake() const;
 
 	float bake_interval;
@@ -277,6 +317,8 @@ public:
 	Vector3 interpolate_baked(float p_offset, bool p_cubic = false) const;
 	float interpolate_baked_tilt(float p_offset) const;
 	Vector3 interpolate_baked_up_vector(float p_offset, bool p_apply_tilt = false) const;
+	PoolVector3Array interpolate_baked_array(const PoolRealArray &p_offsets, bool p_cubic = false) const;
+	PoolVector3Array interpolate_baked_up_vector_array(const PoolRealArray &p_offsets, bool p_apply_tilt = false) const;
 	PoolVector3Array get_baked_points() const; //useful for going through
 	PoolRealArray get_baked_tilts() const; //useful for going through
 	PoolVector3Array get_baked_up_vectors() const;
@@ -286,6 +328,7 @@ public:
 	PoolVector3Array tessellate(int p_max_stages = 5, float p_tolerance = 4) const; //useful for display
 
 	Curve3D();
+	~Curve3D();
 };
 
 #endif // CURVE_H
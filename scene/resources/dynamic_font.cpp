@@ -30,6 +30,7 @@
 
 #ifdef FREETYPE_ENABLED
 #include "dynamic_font.h"
+#include "core/message_queue.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 
@@ -245,11 +246,21 @@ float DynamicFontAtSize::get_descent() const {
 	return descent;
 }
 
-const Pair<const DynamicFontAtSize::Character *, DynamicFontAtSize *> DynamicFontAtSize::_find_char_with_font(CharType p_char, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks) const {
+DynamicFontAtSize::Character DynamicFontAtSize::_get_char(CharType p_char) {
+
+	//copied out under the lock, a prerasterize task may be growing char_map
+	_THREAD_SAFE_METHOD_
+
+	_update_char(p_char);
 	const Character *chr = char_map.getptr(p_char);
-	ERR_FAIL_COND_V(!chr, (Pair<const Character *, DynamicFontAtSize *>(NULL, NULL)));
+	ERR_FAIL_COND_V(!chr, Character::not_found());
+	return *chr;
+}
+
+const Pair<DynamicFontAtSize::Character, DynamicFontAtSize *> DynamicFontAtSize::_find_char_with_font(CharType p_char, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks) const {
+	Character chr = const_cast<DynamicFontAtSize *>(this)->_get_char(p_char);
 
-	if (!chr->found) {
+	if (!chr.found) {
 
 		//not found, try in fallbacks
 		for (int i = 0; i < p_fallbacks.size(); i++) {
@@ -258,39 +269,32 @@ const Pair<const DynamicFontAtSize::Character *, DynamicFontAtSize *> DynamicFon
 			if (!fb->valid)
 				continue;
 
-			fb->_update_char(p_char);
-			const Character *fallback_chr = fb->char_map.getptr(p_char);
-			ERR_CONTINUE(!fallback_chr);
-
-			if (!fallback_chr->found)
+			Character fallback_chr = fb->_get_char(p_char);
+			if (!fallback_chr.found)
 				continue;
 
-			return Pair<const Character *, DynamicFontAtSize *>(fallback_chr, fb);
+			return Pair<Character, DynamicFontAtSize *>(fallback_chr, fb);
 		}
 
 		//not found, try 0xFFFD to display 'not found'.
-		const_cast<DynamicFontAtSize *>(this)->_update_char(0xFFFD);
-		chr = char_map.getptr(0xFFFD);
-		ERR_FAIL_COND_V(!chr, (Pair<const Character *, DynamicFontAtSize *>(NULL, NULL)));
+		chr = const_cast<DynamicFontAtSize *>(this)->_get_char(0xFFFD);
 	}
 
-	return Pair<const Character *, DynamicFontAtSize *>(chr, const_cast<DynamicFontAtSize *>(this));
+	return Pair<Character, DynamicFontAtSize *>(chr, const_cast<DynamicFontAtSize *>(this));
 }
 
 Size2 DynamicFontAtSize::get_char_size(CharType p_char, CharType p_next, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks) const {
 
 	if (!valid)
 		return Size2(1, 1);
-	const_cast<DynamicFontAtSize *>(this)->_update_char(p_char);
 
-	Pair<const Character *, DynamicFontAtSize *> char_pair_with_font = _find_char_with_font(p_char, p_fallbacks);
-	const Character *ch = char_pair_with_font.first;
-	ERR_FAIL_COND_V(!ch, Size2());
+	Pair<Character, DynamicFontAtSize *> char_pair_with_font = _find_char_with_font(p_char, p_fallbacks);
+	const Character &ch = char_pair_with_font.first;
 
 	Size2 ret(0, get_height());
 
-	if (ch->found) {
-		ret.x = ch->advance;
+	if (ch.found) {
+		ret.x = ch.advance;
 	}
 
 	return ret;
@@ -298,6 +302,8 @@ Size2 DynamicFontAtSize::get_char_size(CharType p_char, CharType p_next, const V
 
 void DynamicFontAtSize::set_texture_flags(uint32_t p_flags) {
 
+	_THREAD_SAFE_METHOD_
+
 	texture_flags = p_flags;
 	for (int i = 0; i < textures.size(); i++) {
 		Ref<ImageTexture> &tex = textures.write[i].texture;
@@ -311,18 +317,15 @@ float DynamicFontAtSize::draw_char(RID p_canvas_item, const Point2 &p_pos, CharT
 	if (!valid)
 		return 0;
 
-	const_cast<DynamicFontAtSize *>(this)->_update_char(p_char);
-
-	Pair<const Character *, DynamicFontAtSize *> char_pair_with_font = _find_char_with_font(p_char, p_fallbacks);
-	const Character *ch = char_pair_with_font.first;
+	Pair<Character, DynamicFontAtSize *> char_pair_with_font = _find_char_with_font(p_char, p_fallbacks);
+	const Character &ch = char_pair_with_font.first;
 	DynamicFontAtSize *font = char_pair_with_font.second;
 
-	ERR_FAIL_COND_V(!ch, 0.0);
-
 	float advance = 0.0;
 
 	// use normal character size if there's no outline character
-	if (p_outline && !ch->found) {
+	if (p_outline && !ch.found) {
+		_THREAD_SAFE_METHOD_
 		FT_GlyphSlot slot = face->glyph;
 		int error = FT_Load_Char(face, p_char, FT_HAS_COLOR(face) ? FT_LOAD_COLOR : FT_LOAD_DEFAULT);
 		if (!error) {
@@ -335,23 +338,23 @@ float DynamicFontAtSize::draw_char(RID p_canvas_item, const Point2 &p_pos, CharT
 		}
 	}
 
-	if (ch->found) {
-		ERR_FAIL_COND_V(ch->texture_idx < -1 || ch->texture_idx >= font->textures.size(), 0);
+	if (ch.found) {
 
-		if (!p_advance_only && ch->texture_idx != -1) {
+		if (!p_advance_only && ch.texture_idx != -1) {
 			Point2 cpos = p_pos;
-			cpos.x += ch->h_align;
+			cpos.x += ch.h_align;
 			cpos.y -= font->get_ascent();
-			cpos.y += ch->v_align;
+			cpos.y += ch.v_align;
 			Color modulate = p_modulate;
 			if (FT_HAS_COLOR(face)) {
 				modulate.r = modulate.g = modulate.b = 1.0;
 			}
-			RID texture = font->textures[ch->texture_idx].texture->get_rid();
-			VisualServer::get_singleton()->canvas_item_add_texture_rect_region(p_canvas_item, Rect2(cpos, ch->rect.size), texture, ch->rect_uv, modulate, false, RID(), false);
+			RID texture = font->_get_texture_rid(ch.texture_idx);
+			ERR_FAIL_COND_V(!texture.is_valid(), 0);
+			VisualServer::get_singleton()->canvas_item_add_texture_rect_region(p_canvas_item, Rect2(cpos, ch.rect.size), texture, ch.rect_uv, modulate, false, RID(), false);
 		}
 
-		advance = ch->advance;
+		advance = ch.advance;
 	}
 
 	return advance;
@@ -400,7 +403,7 @@ DynamicFontAtSize::TexturePosition DynamicFontAtSize::_find_texture_pos_for_glyp
 
 		const CharTexture &ct = textures[i];
 
-		if (ct.texture->get_format() != p_image_format)
+		if (ct.format != p_image_format)
 			continue;
 
 		if (mw > ct.texture_size || mh > ct.texture_size) //too big for this texture
@@ -450,6 +453,8 @@ DynamicFontAtSize::TexturePosition DynamicFontAtSize::_find_texture_pos_for_glyp
 
 		CharTexture tex;
 		tex.texture_size = texsize;
+		tex.format = p_image_format;
+		tex.dirty = false;
 		tex.imgdata.resize(texsize * texsize * p_color_size); //grayscale alpha
 
 		{
@@ -526,17 +531,13 @@ DynamicFontAtSize::Character DynamicFontAtSize::_bitmap_to_character(FT_Bitmap b
 		}
 	}
 
-	//blit to image and texture
-	{
-
-		Ref<Image> img = memnew(Image(tex.texture_size, tex.texture_size, 0, require_format, tex.imgdata));
-
-		if (tex.texture.is_null()) {
-			tex.texture.instance();
-			tex.texture->create_from_image(img, Texture::FLAG_VIDEO_SURFACE | texture_flags);
-		} else {
-			tex.texture->set_data(img); //update
-		}
+	//uploading the whole texture for every new glyph hitches, so it's done once
+	//for all the glyphs added until the next message queue flush (also the only
+	//safe place when rasterizing from a prerasterize task)
+	tex.dirty = true;
+	if (!textures_flush_queued) {
+		textures_flush_queued = true;
+		MessageQueue::get_singleton()->push_call(get_instance_id(), "_flush_textures");
 	}
 
 	// update height array
@@ -637,7 +638,73 @@ void DynamicFontAtSize::_update_char(CharType p_char) {
 	char_map[p_char] = character;
 }
 
+void DynamicFontAtSize::_upload_texture(int p_idx) {
+
+	CharTexture &tex = textures.write[p_idx];
+
+	Ref<Image> img = memnew(Image(tex.texture_size, tex.texture_size, 0, tex.format, tex.imgdata));
+
+	if (tex.texture.is_null()) {
+		tex.texture.instance();
+		tex.texture->create_from_image(img, Texture::FLAG_VIDEO_SURFACE | texture_flags);
+	} else {
+		tex.texture->set_data(img); //update
+	}
+
+	tex.dirty = false;
+}
+
+void DynamicFontAtSize::_flush_textures() {
+
+	_THREAD_SAFE_METHOD_
+
+	textures_flush_queued = false;
+	for (int i = 0; i < textures.size(); i++) {
+		if (textures[i].dirty) {
+			_upload_texture(i);
+		}
+	}
+}
+
+RID DynamicFontAtSize::_get_texture_rid(int p_idx) {
+
+	_THREAD_SAFE_METHOD_
+
+	ERR_FAIL_INDEX_V(p_idx, textures.size(), RID());
+
+	//a new texture has no RID to draw with until its first upload
+	if (textures[p_idx].texture.is_null()) {
+		_upload_texture(p_idx);
+	}
+
+	return textures[p_idx].texture->get_rid();
+}
+
+void DynamicFontAtSize::prerasterize(CharType p_from, CharType p_to, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks) {
+
+	if (!valid || p_from > p_to)
+		return;
+
+	//locks per glyph in _get_char(), so drawing from the main thread only waits for one at a time
+	CharType c = p_from;
+	while (true) {
+		_find_char_with_font(c, p_fallbacks);
+		if (c == p_to) {
+			break; //checked before incrementing, so p_to being the largest code point can't wrap
+		}
+		c++;
+	}
+}
+
+void DynamicFontAtSize::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("_flush_textures"), &DynamicFontAtSize::_flush_textures);
+}
+
 void DynamicFontAtSize::update_oversampling() {
+
+	_THREAD_SAFE_METHOD_
+
 	if (oversampling == font_oversampling || !valid)
 		return;
 
@@ -659,6 +726,7 @@ DynamicFontAtSize::DynamicFontAtSize() {
 	texture_flags = 0;
 	oversampling = font_oversampling;
 	scale_color_font = 1;
+	textures_flush_queued = false;
 }
 
 DynamicFontAtSize::~DynamicFontAtSize() {
@@ -675,6 +743,10 @@ DynamicFontAtSize::~DynamicFontAtSize() {
 void DynamicFont::_reload_cache() {
 
 	ERR_FAIL_COND(cache_id.size < 1);
+
+	//pending tasks hold the sizes about to be replaced
+	_finish_prerasterize_tasks(true);
+
 	if (!data.is_valid()) {
 		data_at_size.unref();
 		outline_data_at_size.unref();
@@ -899,6 +971,75 @@ float DynamicFont::draw_char(RID p_canvas_item, const Point2 &p_pos, CharType p_
 	return font_at_size->draw_char(p_canvas_item, p_pos, p_char, p_next, color, fallbacks, advance_only, p_outline) + spacing_char;
 }
 
+void DynamicFont::_prerasterize_task(void *p_userdata, uint32_t p_index) {
+
+	PrerasterizeTask *task = (PrerasterizeTask *)p_userdata;
+
+	if (task->font.is_valid()) {
+		task->font->prerasterize(task->from, task->to, task->fallbacks);
+	}
+	if (task->outline_font.is_valid()) {
+		task->outline_font->prerasterize(task->from, task->to, task->outline_fallbacks);
+	}
+}
+
+void DynamicFont::_finish_prerasterize_tasks(bool p_wait) {
+
+	List<PrerasterizeTask *>::Element *E = prerasterize_tasks.front();
+	while (E) {
+		List<PrerasterizeTask *>::Element *N = E->next();
+		PrerasterizeTask *task = E->get();
+
+		if (p_wait || WorkerThreadPool::get_singleton()->is_task_completed(task->task)) {
+			//freed here rather than in the task, so the last reference to a size is never dropped off the main thread
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task->task);
+			memdelete(task);
+			prerasterize_tasks.erase(E);
+		}
+
+		E = N;
+	}
+}
+
+void DynamicFont::prerasterize_range(int p_from, int p_to, bool p_threaded) {
+
+	ERR_FAIL_COND(p_from < 0 || p_to < p_from || p_to > 0xFFFF);
+
+	if (!data_at_size.is_valid())
+		return;
+
+	_finish_prerasterize_tasks(false);
+
+	PrerasterizeTask *task = memnew(PrerasterizeTask);
+	task->font = data_at_size;
+	task->fallbacks = fallback_data_at_size;
+	if (outline_cache_id.outline_size > 0) {
+		task->outline_font = outline_data_at_size;
+		task->outline_fallbacks = fallback_outline_data_at_size;
+	}
+	task->from = p_from;
+	task->to = p_to;
+
+	if (!p_threaded) {
+		_prerasterize_task(task, 0);
+		memdelete(task);
+		return;
+	}
+
+	task->task = WorkerThreadPool::get_singleton()->add_native_task(&DynamicFont::_prerasterize_task, task);
+	prerasterize_tasks.push_back(task);
+}
+
+bool DynamicFont::is_prerasterizing() const {
+
+	for (const List<PrerasterizeTask *>::Element *E = prerasterize_tasks.front(); E; E = E->next()) {
+		if (!WorkerThreadPool::get_singleton()->is_task_completed(E->get()->task)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void DynamicFont::set_fallback(int p_idx, const Ref<DynamicFontData> &p_data) {
 
 	ERR_FAIL_COND(p_data.is_null());
@@ -1017,6 +1158,9 @@ void DynamicFont::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("remove_fallback", "idx"), &DynamicFont::remove_fallback);
 	ClassDB::bind_method(D_METHOD("get_fallback_count"), &DynamicFont::get_fallback_count);
 
+	ClassDB::bind_method(D_METHOD("prerasterize_range", "from", "to", "threaded"), &DynamicFont::prerasterize_range, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_prerasterizing"), &DynamicFont::is_prerasterizing);
+
 	ADD_GROUP("Settings", "");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "size", PROPERTY_HINT_RANGE, "1,1024,1"), "set_size", "get_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "outline_size", PROPERTY_HINT_RANGE, "0,1024,1"), "set_outline_size", "get_outline_size");
@@ -1059,6 +1203,7 @@ DynamicFont::DynamicFont() :
 }
 
 DynamicFont::~DynamicFont() {
+	_finish_prerasterize_tasks(true);
 	if (dynamic_font_mutex) {
 		dynamic_font_mutex->lock();
 		dynamic_fonts->remove(&font_list);
@@ -35,6 +35,7 @@
 #include "core/io/resource_loader.h"
 #include "core/os/mutex.h"
 #include "core/os/thread_safe.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/pair.h"
 #include "scene/resources/font.h"
 
@@ -133,11 +134,14 @@ class DynamicFontAtSize : public Reference {
 
 		PoolVector<uint8_t> imgdata;
 		int texture_size;
+		Image::Format format;
 		Vector<int> offsets;
 		Ref<ImageTexture> texture;
+		bool dirty; //imgdata has glyphs the texture doesn't show yet
 	};
 
 	Vector<CharTexture> textures;
+	bool textures_flush_queued;
 
 	struct Character {
 
@@ -163,7 +167,7 @@ class DynamicFontAtSize : public Reference {
 		int y;
 	};
 
-	const Pair<const Character *, DynamicFontAtSize *> _find_char_with_font(CharType p_char, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks) const;
+	const Pair<Character, DynamicFontAtSize *> _find_char_with_font(CharType p_char, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks) const;
 	Character _make_outline_char(CharType p_char);
 	TexturePosition _find_texture_pos_for_glyph(int p_color_size, Image::Format p_image_format, int p_width, int p_height);
 	Character _bitmap_to_character(FT_Bitmap bitmap, int yofs, int xofs, float advance);
@@ -174,6 +178,11 @@ class DynamicFontAtSize : public Reference {
 	HashMap<CharType, Character> char_map;
 
 	_FORCE_INLINE_ void _update_char(CharType p_char);
+	Character _get_char(CharType p_char);
+
+	void _upload_texture(int p_idx);
+	void _flush_textures();
+	RID _get_texture_rid(int p_idx);
 
 	friend class DynamicFontData;
 	Ref<DynamicFontData> font;
@@ -182,6 +191,9 @@ class DynamicFontAtSize : public Reference {
 	static HashMap<String, Vector<uint8_t> > _fontdata;
 	Error _load();
 
+protected:
+	static void _bind_methods();
+
 public:
 	static float font_oversampling;
 
@@ -197,6 +209,8 @@ public:
 	void set_texture_flags(uint32_t p_flags);
 	void update_oversampling();
 
+	void prerasterize(CharType p_from, CharType p_to, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks);
+
 	DynamicFontAtSize();
 	~DynamicFontAtSize();
 };
@@ -235,6 +249,21 @@ private:
 
 	Color outline_color;
 
+	struct PrerasterizeTask {
+		Ref<DynamicFontAtSize> font;
+		Vector<Ref<DynamicFontAtSize> > fallbacks;
+		Ref<DynamicFontAtSize> outline_font;
+		Vector<Ref<DynamicFontAtSize> > outline_fallbacks;
+		CharType from;
+		CharType to;
+		WorkerThreadPool::TaskID task;
+	};
+
+	List<PrerasterizeTask *> prerasterize_tasks;
+
+	static void _prerasterize_task(void *p_userdata, uint32_t p_index);
+	void _finish_prerasterize_tasks(bool p_wait);
+
 protected:
 	void _reload_cache();
 
@@ -285,6 +314,9 @@ public:
 
 	virtual float draw_char(RID p_canvas_item, const Point2 &p_pos, CharType p_char, CharType p_next = 0, const Color &p_modulate = Color(1, 1, 1), bool p_outline = false) const;
 
+	void prerasterize_range(int p_from, int p_to, bool p_threaded = true);
+	bool is_prerasterizing() const;
+
 	SelfList<DynamicFont> font_list;
 
 	static Mutex *dynamic_font_mutex;
@@ -448,6 +448,26 @@ bool Environment::is_ssr_rough() const {
 	return ssr_roughness;
 }
 
+void Environment::set_ssr_resolution(EffectResolution p_resolution) {
+
+	ssr_resolution = p_resolution;
+	VS::get_singleton()->environment_set_ssr_resolution(environment, VS::EnvironmentEffectResolution(ssr_resolution), ssr_temporal_accumulation);
+}
+Environment::EffectResolution Environment::get_ssr_resolution() const {
+
+	return ssr_resolution;
+}
+
+void Environment::set_ssr_temporal_accumulation(bool p_enable) {
+
+	ssr_temporal_accumulation = p_enable;
+	VS::get_singleton()->environment_set_ssr_resolution(environment, VS::EnvironmentEffectResolution(ssr_resolution), ssr_temporal_accumulation);
+}
+bool Environment::is_ssr_temporal_accumulation_enabled() const {
+
+	return ssr_temporal_accumulation;
+}
+
 void Environment::set_ssao_enabled(bool p_enable) {
 
 	ssao_enabled = p_enable;
@@ -574,6 +594,26 @@ float Environment::get_ssao_edge_sharpness() const {
 	return ssao_edge_sharpness;
 }
 
+void Environment::set_ssao_resolution(EffectResolution p_resolution) {
+
+	ssao_resolution = p_resolution;
+	VS::get_singleton()->environment_set_ssao_resolution(environment, VS::EnvironmentEffectResolution(ssao_resolution), ssao_temporal_accumulation);
+}
+Environment::EffectResolution Environment::get_ssao_resolution() const {
+
+	return ssao_resolution;
+}
+
+void Environment::set_ssao_temporal_accumulation(bool p_enable) {
+
+	ssao_temporal_accumulation = p_enable;
+	VS::get_singleton()->environment_set_ssao_resolution(environment, VS::EnvironmentEffectResolution(ssao_resolution), ssao_temporal_accumulation);
+}
+bool Environment::is_ssao_temporal_accumulation_enabled() const {
+
+	return ssao_temporal_accumulation;
+}
+
 void Environment::set_glow_enabled(bool p_enabled) {
 
 	glow_enabled = p_enabled;
@@ -1102,6 +1142,12 @@ void Environment::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_ssr_rough", "rough"), &Environment::set_ssr_rough);
 	ClassDB::bind_method(D_METHOD("is_ssr_rough"), &Environment::is_ssr_rough);
 
+	ClassDB::bind_method(D_METHOD("set_ssr_resolution", "resolution"), &Environment::set_ssr_resolution);
+	ClassDB::bind_method(D_METHOD("get_ssr_resolution"), &Environment::get_ssr_resolution);
+
+	ClassDB::bind_method(D_METHOD("set_ssr_temporal_accumulation", "enable"), &Environment::set_ssr_temporal_accumulation);
+	ClassDB::bind_method(D_METHOD("is_ssr_temporal_accumulation_enabled"), &Environment::is_ssr_temporal_accumulation_enabled);
+
 	ADD_GROUP("SS Reflections", "ss_reflections_");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "ss_reflections_enabled"), "set_ssr_enabled", "is_ssr_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "ss_reflections_max_steps", PROPERTY_HINT_RANGE, "1,512,1"), "set_ssr_max_steps", "get_ssr_max_steps");
@@ -1109,6 +1155,8 @@ void Environment::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "ss_reflections_fade_out", PROPERTY_HINT_EXP_EASING), "set_ssr_fade_out", "get_ssr_fade_out");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "ss_reflections_depth_tolerance", PROPERTY_HINT_RANGE, "0.1,128,0.1"), "set_ssr_depth_tolerance", "get_ssr_depth_tolerance");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "ss_reflections_roughness"), "set_ssr_rough", "is_ssr_rough");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "ss_reflections_resolution", PROPERTY_HINT_ENUM, "Full,Half,Quarter"), "set_ssr_resolution", "get_ssr_resolution");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "ss_reflections_temporal_accumulation"), "set_ssr_temporal_accumulation", "is_ssr_temporal_accumulation_enabled");
 
 	ClassDB::bind_method(D_METHOD("set_ssao_enabled", "enabled"), &Environment::set_ssao_enabled);
 	ClassDB::bind_method(D_METHOD("is_ssao_enabled"), &Environment::is_ssao_enabled);
@@ -1146,6 +1194,12 @@ void Environment::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_ssao_edge_sharpness", "edge_sharpness"), &Environment::set_ssao_edge_sharpness);
 	ClassDB::bind_method(D_METHOD("get_ssao_edge_sharpness"), &Environment::get_ssao_edge_sharpness);
 
+	ClassDB::bind_method(D_METHOD("set_ssao_resolution", "resolution"), &Environment::set_ssao_resolution);
+	ClassDB::bind_method(D_METHOD("get_ssao_resolution"), &Environment::get_ssao_resolution);
+
+	ClassDB::bind_method(D_METHOD("set_ssao_temporal_accumulation", "enable"), &Environment::set_ssao_temporal_accumulation);
+	ClassDB::bind_method(D_METHOD("is_ssao_temporal_accumulation_enabled"), &Environment::is_ssao_temporal_accumulation_enabled);
+
 	ADD_GROUP("SSAO", "ssao_");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "ssao_enabled"), "set_ssao_enabled", "is_ssao_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "ssao_radius", PROPERTY_HINT_RANGE, "0.1,128,0.1"), "set_ssao_radius", "get_ssao_radius");
@@ -1159,6 +1213,8 @@ void Environment::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "ssao_quality", PROPERTY_HINT_ENUM, "Low,Medium,High"), "set_ssao_quality", "get_ssao_quality");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "ssao_blur", PROPERTY_HINT_ENUM, "Disabled,1x1,2x2,3x3"), "set_ssao_blur", "get_ssao_blur");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "ssao_edge_sharpness", PROPERTY_HINT_RANGE, "0,32,0.01"), "set_ssao_edge_sharpness", "get_ssao_edge_sharpness");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "ssao_resolution", PROPERTY_HINT_ENUM, "Full,Half,Quarter"), "set_ssao_resolution", "get_ssao_resolution");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "ssao_temporal_accumulation"), "set_ssao_temporal_accumulation", "is_ssao_temporal_accumulation_enabled");
 
 	ClassDB::bind_method(D_METHOD("set_dof_blur_far_enabled", "enabled"), &Environment::set_dof_blur_far_enabled);
 	ClassDB::bind_method(D_METHOD("is_dof_blur_far_enabled"), &Environment::is_dof_blur_far_enabled);
@@ -1306,6 +1362,10 @@ void Environment::_bind_methods() {
 	BIND_ENUM_CONSTANT(SSAO_QUALITY_LOW);
 	BIND_ENUM_CONSTANT(SSAO_QUALITY_MEDIUM);
 	BIND_ENUM_CONSTANT(SSAO_QUALITY_HIGH);
+
+	BIND_ENUM_CONSTANT(EFFECT_RESOLUTION_FULL);
+	BIND_ENUM_CONSTANT(EFFECT_RESOLUTION_HALF);
+	BIND_ENUM_CONSTANT(EFFECT_RESOLUTION_QUARTER);
 }
 
 Environment::Environment() :
@@ -1313,6 +1373,7 @@ Environment::Environment() :
 		tone_mapper(TONE_MAPPER_LINEAR),
 		ssao_blur(SSAO_BLUR_3x3),
 		ssao_quality(SSAO_QUALITY_MEDIUM),
+		ssao_resolution(EFFECT_RESOLUTION_FULL),
 		glow_blend_mode(GLOW_BLEND_MODE_ADDITIVE),
 		dof_blur_far_quality(DOF_BLUR_QUALITY_LOW),
 		dof_blur_near_quality(DOF_BLUR_QUALITY_LOW) {
@@ -1353,6 +1414,8 @@ Environment::Environment() :
 	ssr_fade_out = 2.0;
 	ssr_depth_tolerance = 0.2;
 	ssr_roughness = true;
+	ssr_resolution = EFFECT_RESOLUTION_HALF;
+	ssr_temporal_accumulation = false;
 
 	ssao_enabled = false;
 	ssao_radius = 1;
@@ -1365,6 +1428,8 @@ Environment::Environment() :
 	ssao_blur = SSAO_BLUR_3x3;
 	set_ssao_edge_sharpness(4);
 	set_ssao_quality(SSAO_QUALITY_MEDIUM);
+	ssao_resolution = EFFECT_RESOLUTION_FULL;
+	ssao_temporal_accumulation = false;
 
 	glow_enabled = false;
 	glow_levels = (1 << 2) | (1 << 4);
@@ -86,6 +86,12 @@ public:
 		SSAO_QUALITY_HIGH
 	};
 
+	enum EffectResolution {
+		EFFECT_RESOLUTION_FULL,
+		EFFECT_RESOLUTION_HALF,
+		EFFECT_RESOLUTION_QUARTER
+	};
+
 private:
 	RID environment;
 
@@ -122,6 +128,8 @@ private:
 	float ssr_fade_out;
 	float ssr_depth_tolerance;
 	bool ssr_roughness;
+	EffectResolution ssr_resolution;
+	bool ssr_temporal_accumulation;
 
 	bool ssao_enabled;
 	float ssao_radius;
@@ -135,6 +143,8 @@ private:
 	SSAOBlur ssao_blur;
 	float ssao_edge_sharpness;
 	SSAOQuality ssao_quality;
+	EffectResolution ssao_resolution;
+	bool ssao_temporal_accumulation;
 
 	bool glow_enabled;
 	int glow_levels;
@@ -267,6 +277,12 @@ public:
 	void set_ssr_rough(bool p_enable);
 	bool is_ssr_rough() const;
 
+	void set_ssr_resolution(EffectResolution p_resolution);
+	EffectResolution get_ssr_resolution() const;
+
+	void set_ssr_temporal_accumulation(bool p_enable);
+	bool is_ssr_temporal_accumulation_enabled() const;
+
 	void set_ssao_enabled(bool p_enable);
 	bool is_ssao_enabled() const;
 
@@ -303,6 +319,12 @@ public:
 	void set_ssao_edge_sharpness(float p_edge_sharpness);
 	float get_ssao_edge_sharpness() const;
 
+	void set_ssao_resolution(EffectResolution p_resolution);
+	EffectResolution get_ssao_resolution() const;
+
+	void set_ssao_temporal_accumulation(bool p_enable);
+	bool is_ssao_temporal_accumulation_enabled() const;
+
 	void set_glow_enabled(bool p_enabled);
 	bool is_glow_enabled() const;
 
@@ -417,5 +439,6 @@ VARIANT_ENUM_CAST(Environment::GlowBlendMode)
 VARIANT_ENUM_CAST(Environment::DOFBlurQuality)
 VARIANT_ENUM_CAST(Environment::SSAOQuality)
 VARIANT_ENUM_CAST(Environment::SSAOBlur)
+VARIANT_ENUM_CAST(Environment::EffectResolution)
 
 #endif // ENVIRONMENT_H
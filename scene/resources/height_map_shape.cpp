@@ -170,6 +170,41 @@ void HeightMapShape::set_map_data(PoolRealArray p_new) {
 	_change_notify("map_data");
 }
 
+void HeightMapShape::update_map_data_region(int p_x, int p_z, int p_width, int p_depth, PoolRealArray p_data) {
+
+	ERR_FAIL_COND(p_width <= 0 || p_depth <= 0);
+	ERR_FAIL_COND(p_x < 0 || p_z < 0);
+	ERR_FAIL_COND(p_x + p_width > map_width || p_z + p_depth > map_depth);
+	ERR_FAIL_COND(p_data.size() != p_width * p_depth);
+
+	{
+		PoolRealArray::Write w = map_data.write();
+		PoolRealArray::Read r = p_data.read();
+
+		for (int z = 0; z < p_depth; z++) {
+			for (int x = 0; x < p_width; x++) {
+				float val = r[z * p_width + x];
+				w[(p_z + z) * map_width + p_x + x] = val;
+				// heights outside the region are unknown here, so bounds can only grow
+				if (min_height > val)
+					min_height = val;
+				if (max_height < val)
+					max_height = val;
+			}
+		}
+	}
+
+	// only send the region, so the physics server doesn't rebuild the whole map
+	Dictionary d;
+	d["region"] = Rect2(p_x, p_z, p_width, p_depth);
+	d["heights"] = p_data;
+	PhysicsServer::get_singleton()->shape_set_data(get_shape(), d);
+	Shape::_update_shape();
+
+	notify_change_to_owners();
+	_change_notify("map_data");
+}
+
 PoolRealArray HeightMapShape::get_map_data() const {
 	return map_data;
 }
@@ -181,6 +216,7 @@ void HeightMapShape::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_map_depth"), &HeightMapShape::get_map_depth);
 	ClassDB::bind_method(D_METHOD("set_map_data", "data"), &HeightMapShape::set_map_data);
 	ClassDB::bind_method(D_METHOD("get_map_data"), &HeightMapShape::get_map_data);
+	ClassDB::bind_method(D_METHOD("update_map_data_region", "x", "z", "width", "depth", "data"), &HeightMapShape::update_map_data_region);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_width", PROPERTY_HINT_RANGE, "1,4096,1"), "set_map_width", "get_map_width");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_depth", PROPERTY_HINT_RANGE, "1,4096,1"), "set_map_depth", "get_map_depth");
@@ -53,6 +53,7 @@ public:
 	int get_map_depth() const;
 	void set_map_data(PoolRealArray p_new);
 	PoolRealArray get_map_data() const;
+	void update_map_data_region(int p_x, int p_z, int p_width, int p_depth, PoolRealArray p_data);
 
 	virtual Vector<Vector3> get_debug_mesh_lines();
 
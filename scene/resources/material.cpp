@@ -31,6 +31,8 @@
 #include "material.h"
 
 #include "core/engine.h"
+#include "core/io/marshalls.h"
+#include "core/os/file_access.h"
 
 #ifdef TOOLS_ENABLED
 #include "editor/editor_settings.h"
@@ -293,6 +295,7 @@ ShaderMaterial::~ShaderMaterial() {
 Mutex *SpatialMaterial::material_mutex = NULL;
 SelfList<SpatialMaterial>::List *SpatialMaterial::dirty_materials = NULL;
 Map<SpatialMaterial::MaterialKey, SpatialMaterial::ShaderData> SpatialMaterial::shader_map;
+Vector<SpatialMaterial::MaterialKey> SpatialMaterial::precompiled_keys;
 SpatialMaterial::ShaderNames *SpatialMaterial::shader_names = NULL;
 
 void SpatialMaterial::init_shaders() {
@@ -369,6 +372,99 @@ void SpatialMaterial::init_shaders() {
 	shader_names->texture_names[TEXTURE_DETAIL_MASK] = "texture_detail_mask";
 	shader_names->texture_names[TEXTURE_DETAIL_ALBEDO] = "texture_detail_albedo";
 	shader_names->texture_names[TEXTURE_DETAIL_NORMAL] = "texture_detail_normal";
+
+	if (!Engine::get_singleton()->is_editor_hint()) {
+		_load_shader_variants();
+	}
+}
+
+#define SHADER_VARIANTS_MAGIC 0x52564D53 // "SMVR"
+#define SHADER_VARIANTS_VERSION 1
+
+String SpatialMaterial::get_shader_variants_path() {
+
+	return "res://.spatial_material_variants";
+}
+
+Vector<uint8_t> SpatialMaterial::encode_shader_variants(const Map<uint64_t, String> &p_variants) {
+
+	Vector<uint8_t> data;
+	int len = 16;
+	for (const Map<uint64_t, String>::Element *E = p_variants.front(); E; E = E->next()) {
+		len += 12 + E->get().utf8().length();
+	}
+	data.resize(len);
+
+	uint8_t *w = data.ptrw();
+	w += encode_uint32(SHADER_VARIANTS_MAGIC, w);
+	w += encode_uint32(SHADER_VARIANTS_VERSION, w);
+	w += encode_uint32(VS::get_singleton()->is_low_end() ? 1 : 0, w); // Generated code differs per renderer.
+	w += encode_uint32(p_variants.size(), w);
+	for (const Map<uint64_t, String>::Element *E = p_variants.front(); E; E = E->next()) {
+		CharString cs = E->get().utf8();
+		w += encode_uint64(E->key(), w);
+		w += encode_uint32(cs.length(), w);
+		copymem(w, cs.get_data(), cs.length());
+		w += cs.length();
+	}
+
+	return data;
+}
+
+void SpatialMaterial::_load_shader_variants() {
+
+	String path = get_shader_variants_path();
+	if (!FileAccess::exists(path)) {
+		return;
+	}
+
+	FileAccess *f = FileAccess::open(path, FileAccess::READ);
+	ERR_FAIL_COND_MSG(!f, "Can't open SpatialMaterial shader variants file: " + path + ".");
+
+	if (f->get_32() != SHADER_VARIANTS_MAGIC || f->get_32() != SHADER_VARIANTS_VERSION) {
+		memdelete(f);
+		ERR_FAIL_MSG("Unrecognized SpatialMaterial shader variants file: " + path + ".");
+	}
+
+	if (f->get_32() != (VS::get_singleton()->is_low_end() ? 1U : 0U)) {
+		//recorded with the other renderer, materials will generate their own code
+		memdelete(f);
+		return;
+	}
+
+	uint32_t count = f->get_32();
+	for (uint32_t i = 0; i < count && !f->eof_reached(); i++) {
+
+		MaterialKey mk;
+		mk.key = f->get_64();
+		uint32_t len = f->get_32();
+		if (len > f->get_len() - f->get_position()) {
+			ERR_PRINT("Truncated SpatialMaterial shader variants file: " + path + ".");
+			break;
+		}
+
+		Vector<uint8_t> buf;
+		buf.resize(len);
+		f->get_buffer(buf.ptrw(), len);
+
+		if (mk.invalid_key || shader_map.has(mk)) {
+			continue;
+		}
+
+		String code;
+		code.parse_utf8((const char *)buf.ptr(), len);
+
+		//created upfront so the shader is compiled before any material needs it
+		ShaderData shader_data;
+		shader_data.shader = VS::get_singleton()->shader_create();
+		shader_data.users = 1;
+		VS::get_singleton()->shader_set_code(shader_data.shader, code);
+
+		shader_map[mk] = shader_data;
+		precompiled_keys.push_back(mk);
+	}
+
+	memdelete(f);
 }
 
 Ref<SpatialMaterial> SpatialMaterial::materials_for_2d[SpatialMaterial::MAX_MATERIALS_FOR_2D];
@@ -379,6 +475,19 @@ void SpatialMaterial::finish_shaders() {
 		materials_for_2d[i].unref();
 	}
 
+	for (int i = 0; i < precompiled_keys.size(); i++) {
+		const MaterialKey &mk = precompiled_keys[i];
+		if (!shader_map.has(mk)) {
+			continue;
+		}
+		shader_map[mk].users--;
+		if (shader_map[mk].users == 0) {
+			VS::get_singleton()->free(shader_map[mk].shader);
+			shader_map.erase(mk);
+		}
+	}
+	precompiled_keys.clear();
+
 #ifndef NO_THREADS
 	memdelete(material_mutex);
 #endif
@@ -417,6 +526,21 @@ void SpatialMaterial::_update_shader() {
 
 	//must create a shader!
 
+	String code = _get_shader_code();
+
+	ShaderData shader_data;
+	shader_data.shader = VS::get_singleton()->shader_create();
+	shader_data.users = 1;
+
+	VS::get_singleton()->shader_set_code(shader_data.shader, code);
+
+	shader_map[mk] = shader_data;
+
+	VS::get_singleton()->material_set_shader(_get_material(), shader_data.shader);
+}
+
+String SpatialMaterial::_get_shader_code() const {
+
 	String code = "shader_type spatial;\nrender_mode ";
 	switch (blend_mode) {
 		case BLEND_MODE_MIX: code += "blend_mix"; break;
@@ -1049,15 +1173,7 @@ void SpatialMaterial::_update_shader() {
 
 	code += "}\n";
 
-	ShaderData shader_data;
-	shader_data.shader = VS::get_singleton()->shader_create();
-	shader_data.users = 1;
-
-	VS::get_singleton()->shader_set_code(shader_data.shader, code);
-
-	shader_map[mk] = shader_data;
-
-	VS::get_singleton()->material_set_shader(_get_material(), shader_data.shader);
+	return code;
 }
 
 void SpatialMaterial::flush_changes() {
@@ -1915,6 +2031,16 @@ SpatialMaterial::EmissionOperator SpatialMaterial::get_emission_operator() const
 	return emission_op;
 }
 
+uint64_t SpatialMaterial::get_shader_variant() const {
+
+	return _compute_key().key;
+}
+
+String SpatialMaterial::get_shader_variant_code() const {
+
+	return _get_shader_code();
+}
+
 RID SpatialMaterial::get_shader_rid() const {
 
 	ERR_FAIL_COND_V(!shader_map.has(current_key), RID());
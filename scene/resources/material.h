@@ -277,6 +277,7 @@ private:
 	};
 
 	static Map<MaterialKey, ShaderData> shader_map;
+	static Vector<MaterialKey> precompiled_keys;
 
 	MaterialKey current_key;
 
@@ -368,6 +369,8 @@ private:
 	SelfList<SpatialMaterial> element;
 
 	void _update_shader();
+	String _get_shader_code() const;
+	static void _load_shader_variants();
 	_FORCE_INLINE_ void _queue_shader_change();
 	_FORCE_INLINE_ bool _is_shader_dirty() const;
 
@@ -628,6 +631,12 @@ public:
 	static void finish_shaders();
 	static void flush_changes();
 
+	// Variants recorded when exporting, their shaders are created at startup and kept alive.
+	static String get_shader_variants_path();
+	static Vector<uint8_t> encode_shader_variants(const Map<uint64_t, String> &p_variants);
+	uint64_t get_shader_variant() const;
+	String get_shader_variant_code() const;
+
 	static RID get_material_rid_for_2d(bool p_shaded, bool p_transparent, bool p_double_sided, bool p_cut_alpha, bool p_opaque_prepass, bool p_billboard = false, bool p_billboard_y = false);
 
 	RID get_shader_rid() const;
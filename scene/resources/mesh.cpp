@@ -30,6 +30,7 @@
 
 #include "mesh.h"
 
+#include "core/os/worker_thread_pool.h"
 #include "core/pair.h"
 #include "scene/resources/concave_polygon_shape.h"
 #include "scene/resources/convex_polygon_shape.h"
@@ -551,28 +552,27 @@ void Mesh::clear_cache() const {
 	debug_lines.clear();
 }
 
-Vector<Ref<Shape> > Mesh::convex_decompose() const {
-
-	ERR_FAIL_COND_V(!convex_composition_function, Vector<Ref<Shape> >());
+static Vector<Face3> _mesh_faces_to_vector(const PoolVector<Face3> &p_faces) {
 
-	PoolVector<Face3> faces = get_faces();
 	Vector<Face3> f3;
-	f3.resize(faces.size());
-	PoolVector<Face3>::Read f = faces.read();
+	f3.resize(p_faces.size());
+	PoolVector<Face3>::Read f = p_faces.read();
 	for (int i = 0; i < f3.size(); i++) {
 		f3.write[i] = f[i];
 	}
+	return f3;
+}
 
-	Vector<Vector<Face3> > decomposed = convex_composition_function(f3);
+static Vector<Ref<Shape> > _mesh_create_convex_shapes(const Vector<Vector<Face3> > &p_decomposed) {
 
 	Vector<Ref<Shape> > ret;
 
-	for (int i = 0; i < decomposed.size(); i++) {
+	for (int i = 0; i < p_decomposed.size(); i++) {
 		Set<Vector3> points;
-		for (int j = 0; j < decomposed[i].size(); j++) {
-			points.insert(decomposed[i][j].vertex[0]);
-			points.insert(decomposed[i][j].vertex[1]);
-			points.insert(decomposed[i][j].vertex[2]);
+		for (int j = 0; j < p_decomposed[i].size(); j++) {
+			points.insert(p_decomposed[i][j].vertex[0]);
+			points.insert(p_decomposed[i][j].vertex[1]);
+			points.insert(p_decomposed[i][j].vertex[2]);
 		}
 
 		PoolVector<Vector3> convex_points;
@@ -594,6 +594,57 @@ Vector<Ref<Shape> > Mesh::convex_decompose() const {
 	return ret;
 }
 
+Vector<Ref<Shape> > Mesh::convex_decompose() const {
+
+	ERR_FAIL_COND_V(!convex_composition_function, Vector<Ref<Shape> >());
+
+	Vector<Vector<Face3> > decomposed = convex_composition_function(_mesh_faces_to_vector(get_faces()));
+
+	return _mesh_create_convex_shapes(decomposed);
+}
+
+struct MeshConvexDecomposition {
+
+	Vector<Face3> faces;
+	Vector<Vector<Face3> > decomposed;
+};
+
+static void _mesh_convex_decompose_task(void *p_userdata, uint32_t p_index) {
+
+	MeshConvexDecomposition *decompositions = (MeshConvexDecomposition *)p_userdata;
+	decompositions[p_index].decomposed = Mesh::convex_composition_function(decompositions[p_index].faces);
+}
+
+Vector<Vector<Ref<Shape> > > Mesh::convex_decompose_multiple(const Vector<Ref<Mesh> > &p_meshes) {
+
+	ERR_FAIL_COND_V(!convex_composition_function, Vector<Vector<Ref<Shape> > >());
+
+	//faces and shapes go through the servers, so only the decomposition runs on the pool
+	Vector<MeshConvexDecomposition> decompositions;
+	decompositions.resize(p_meshes.size());
+	for (int i = 0; i < p_meshes.size(); i++) {
+		ERR_CONTINUE(p_meshes[i].is_null());
+		decompositions.write[i].faces = _mesh_faces_to_vector(p_meshes[i]->get_faces());
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && decompositions.size() > 1) {
+		pool->wait_for_task_completion(pool->add_native_group_task(&_mesh_convex_decompose_task, decompositions.ptrw(), decompositions.size()));
+	} else {
+		for (int i = 0; i < decompositions.size(); i++) {
+			_mesh_convex_decompose_task(decompositions.ptrw(), i);
+		}
+	}
+
+	Vector<Vector<Ref<Shape> > > ret;
+	ret.resize(decompositions.size());
+	for (int i = 0; i < decompositions.size(); i++) {
+		ret.write[i] = _mesh_create_convex_shapes(decompositions[i].decomposed);
+	}
+
+	return ret;
+}
+
 Mesh::Mesh() {
 }
 
@@ -702,6 +753,18 @@ bool ArrayMesh::_set(const StringName &p_name, const Variant &p_value) {
 		if (d.has("name")) {
 			surface_set_name(idx, d["name"]);
 		}
+		if (d.has("lods")) {
+			//pairs of edge length and indices, already sorted
+			Array lods = d["lods"];
+			ERR_FAIL_COND_V(lods.size() & 1, false);
+			for (int i = 0; i < lods.size(); i += 2) {
+				Surface::LOD lod;
+				lod.edge_length = lods[i];
+				lod.indices = lods[i + 1];
+				surfaces.write[idx].lods.push_back(lod);
+			}
+			_surface_update_lods(idx);
+		}
 
 		return true;
 	}
@@ -779,6 +842,15 @@ bool ArrayMesh::_get(const StringName &p_name, Variant &r_ret) const {
 	if (n != "")
 		d["name"] = n;
 
+	if (surfaces[idx].lods.size()) {
+		Array lods;
+		for (int i = 0; i < surfaces[idx].lods.size(); i++) {
+			lods.push_back(surfaces[idx].lods[i].edge_length);
+			lods.push_back(surfaces[idx].lods[i].indices);
+		}
+		d["lods"] = lods;
+	}
+
 	r_ret = d;
 
 	return true;
@@ -825,12 +897,36 @@ void ArrayMesh::add_surface(uint32_t p_format, PrimitiveType p_primitive, const
 	Surface s;
 	s.aabb = p_aabb;
 	s.is_2d = p_format & ARRAY_FLAG_USE_2D_VERTICES;
+	s.memory = p_array.size() + p_index_array.size();
+	for (int i = 0; i < p_blend_shapes.size(); i++) {
+		s.memory += p_blend_shapes[i].size();
+	}
 	surfaces.push_back(s);
 	_recompute_aabb();
 
 	VisualServer::get_singleton()->mesh_add_surface(mesh, p_format, (VS::PrimitiveType)p_primitive, p_array, p_vertex_count, p_index_array, p_index_count, p_aabb, p_blend_shapes, p_bone_aabbs);
 }
 
+//uncompressed size of the arrays, close enough to what the server keeps
+static uint64_t _get_arrays_memory(const Array &p_arrays) {
+
+	uint64_t memory = 0;
+	for (int i = 0; i < p_arrays.size(); i++) {
+		const Variant &v = p_arrays[i];
+		switch (v.get_type()) {
+			case Variant::POOL_BYTE_ARRAY: memory += PoolVector<uint8_t>(v).size(); break;
+			case Variant::POOL_INT_ARRAY: memory += PoolVector<int>(v).size() * sizeof(int); break;
+			case Variant::POOL_REAL_ARRAY: memory += PoolVector<real_t>(v).size() * sizeof(real_t); break;
+			case Variant::POOL_VECTOR2_ARRAY: memory += PoolVector<Vector2>(v).size() * sizeof(Vector2); break;
+			case Variant::POOL_VECTOR3_ARRAY: memory += PoolVector<Vector3>(v).size() * sizeof(Vector3); break;
+			case Variant::POOL_COLOR_ARRAY: memory += PoolVector<Color>(v).size() * sizeof(Color); break;
+			default: {
+			}
+		}
+	}
+	return memory;
+}
+
 void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, const Array &p_arrays, const Array &p_blend_shapes, uint32_t p_flags) {
 
 	ERR_FAIL_COND(p_arrays.size() != ARRAY_MAX);
@@ -860,6 +956,10 @@ void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, const Array &
 
 		s.aabb = aabb;
 		s.is_2d = arr.get_type() == Variant::POOL_VECTOR2_ARRAY;
+		s.memory = _get_arrays_memory(p_arrays);
+		for (int i = 0; i < p_blend_shapes.size(); i++) {
+			s.memory += _get_arrays_memory(p_blend_shapes[i]);
+		}
 		surfaces.push_back(s);
 
 		_recompute_aabb();
@@ -1004,6 +1104,314 @@ String ArrayMesh::surface_get_name(int p_idx) const {
 	return surfaces[p_idx].name;
 }
 
+void ArrayMesh::_surface_update_lods(int p_idx) {
+
+	Surface &s = surfaces.write[p_idx];
+
+	//same index size the server uses for the surface
+	int index_size = VS::get_singleton()->mesh_surface_get_array_len(mesh, p_idx) >= (1 << 16) ? 4 : 2;
+
+	Vector<float> edge_lengths;
+	Vector<PoolVector<uint8_t> > index_arrays;
+	s.lod_memory = 0;
+
+	for (int i = 0; i < s.lods.size(); i++) {
+
+		const PoolVector<int> &indices = s.lods[i].indices;
+		PoolVector<uint8_t> data;
+		data.resize(indices.size() * index_size);
+		{
+			PoolVector<int>::Read r = indices.read();
+			PoolVector<uint8_t>::Write w = data.write();
+			if (index_size == 4) {
+				copymem(w.ptr(), r.ptr(), indices.size() * 4);
+			} else {
+				uint16_t *w16 = (uint16_t *)w.ptr();
+				for (int j = 0; j < indices.size(); j++) {
+					w16[j] = r[j];
+				}
+			}
+		}
+
+		edge_lengths.push_back(s.lods[i].edge_length);
+		index_arrays.push_back(data);
+		s.lod_memory += data.size();
+	}
+
+	VS::get_singleton()->mesh_surface_set_lods(mesh, p_idx, edge_lengths, index_arrays);
+}
+
+void ArrayMesh::surface_add_lod(int p_idx, float p_edge_length, const PoolVector<int> &p_indices) {
+
+	ERR_FAIL_INDEX(p_idx, surfaces.size());
+	ERR_FAIL_COND(p_indices.size() == 0 || p_indices.size() % 3 != 0);
+	ERR_FAIL_COND_MSG(surface_get_primitive_type(p_idx) != PRIMITIVE_TRIANGLES || !(surface_get_format(p_idx) & ARRAY_FORMAT_INDEX), "LODs can only be added to indexed triangle surfaces.");
+
+	int vertex_count = surface_get_array_len(p_idx);
+	{
+		PoolVector<int>::Read r = p_indices.read();
+		for (int i = 0; i < p_indices.size(); i++) {
+			ERR_FAIL_INDEX(r[i], vertex_count);
+		}
+	}
+
+	Surface::LOD lod;
+	lod.edge_length = p_edge_length;
+	lod.indices = p_indices;
+
+	Vector<Surface::LOD> &lods = surfaces.write[p_idx].lods;
+	int pos = 0;
+	while (pos < lods.size() && lods[pos].edge_length <= p_edge_length) {
+		pos++;
+	}
+	lods.insert(pos, lod);
+
+	_surface_update_lods(p_idx);
+	emit_changed();
+}
+
+void ArrayMesh::surface_clear_lods(int p_idx) {
+
+	ERR_FAIL_INDEX(p_idx, surfaces.size());
+
+	if (surfaces[p_idx].lods.empty()) {
+		return;
+	}
+
+	surfaces.write[p_idx].lods.clear();
+	_surface_update_lods(p_idx);
+	emit_changed();
+}
+
+int ArrayMesh::surface_get_lod_count(int p_idx) const {
+
+	ERR_FAIL_INDEX_V(p_idx, surfaces.size(), 0);
+	return surfaces[p_idx].lods.size();
+}
+
+float ArrayMesh::surface_get_lod_edge_length(int p_idx, int p_lod) const {
+
+	ERR_FAIL_INDEX_V(p_idx, surfaces.size(), 0);
+	ERR_FAIL_INDEX_V(p_lod, surfaces[p_idx].lods.size(), 0);
+	return surfaces[p_idx].lods[p_lod].edge_length;
+}
+
+PoolVector<int> ArrayMesh::surface_get_lod_indices(int p_idx, int p_lod) const {
+
+	ERR_FAIL_INDEX_V(p_idx, surfaces.size(), PoolVector<int>());
+	ERR_FAIL_INDEX_V(p_lod, surfaces[p_idx].lods.size(), PoolVector<int>());
+	return surfaces[p_idx].lods[p_lod].indices;
+}
+
+void ArrayMesh::generate_lods() {
+
+	//each level aims at half the triangles of the previous one
+	const int max_lods = 8;
+	const int min_index_count = 36;
+	const float max_error = 0.25;
+
+	for (int i = 0; i < surfaces.size(); i++) {
+
+		Surface &s = surfaces.write[i];
+		s.lods.clear();
+
+		if (s.is_2d || blend_shapes.size() || surface_get_primitive_type(i) != PRIMITIVE_TRIANGLES || !(surface_get_format(i) & ARRAY_FORMAT_INDEX)) {
+			_surface_update_lods(i);
+			continue;
+		}
+
+		Array arrays = surface_get_arrays(i);
+		PoolVector<Vector3> vertices = arrays[ARRAY_VERTEX];
+		PoolVector<int> indices = arrays[ARRAY_INDEX];
+		float extent = s.aabb.get_longest_axis_size();
+
+		int index_count = indices.size();
+
+		while (s.lods.size() < max_lods) {
+
+			int target = (index_count / 2) / 3 * 3;
+			if (target < min_index_count) {
+				break;
+			}
+
+			//always simplify from the original, so errors don't accumulate between levels
+			float error = 0;
+			PoolVector<int> lod_indices = SurfaceTool::simplify_indices(vertices, indices, target, max_error, &error);
+
+			if (lod_indices.size() == 0 || lod_indices.size() > index_count * 0.9) {
+				break; //not worth another level
+			}
+
+			Surface::LOD lod;
+			lod.edge_length = error * extent;
+			lod.indices = SurfaceTool::optimize_indices_for_cache(lod_indices, vertices.size());
+			s.lods.push_back(lod);
+
+			index_count = lod_indices.size();
+		}
+
+		_surface_update_lods(i);
+	}
+
+	emit_changed();
+}
+
+template <class T>
+static PoolVector<T> _array_mesh_remap_vertices(const PoolVector<T> &p_array, const PoolVector<int> &p_remap) {
+
+	int vertex_count = p_remap.size();
+	if (vertex_count == 0 || p_array.size() % vertex_count != 0) {
+		return p_array;
+	}
+
+	//tangents, bones and weights hold several values per vertex
+	int stride = p_array.size() / vertex_count;
+
+	PoolVector<T> result;
+	result.resize(p_array.size());
+	{
+		typename PoolVector<T>::Read r = p_array.read();
+		PoolVector<int>::Read rm = p_remap.read();
+		typename PoolVector<T>::Write w = result.write();
+
+		for (int i = 0; i < vertex_count; i++) {
+			for (int j = 0; j < stride; j++) {
+				w[rm[i] * stride + j] = r[i * stride + j];
+			}
+		}
+	}
+
+	return result;
+}
+
+static void _array_mesh_remap_arrays(Array &r_arrays, const PoolVector<int> &p_remap) {
+
+	for (int i = 0; i < r_arrays.size(); i++) {
+
+		if (i == Mesh::ARRAY_INDEX) {
+			continue;
+		}
+
+		switch (r_arrays[i].get_type()) {
+			case Variant::POOL_VECTOR3_ARRAY: {
+				r_arrays[i] = _array_mesh_remap_vertices<Vector3>(r_arrays[i], p_remap);
+			} break;
+			case Variant::POOL_VECTOR2_ARRAY: {
+				r_arrays[i] = _array_mesh_remap_vertices<Vector2>(r_arrays[i], p_remap);
+			} break;
+			case Variant::POOL_COLOR_ARRAY: {
+				r_arrays[i] = _array_mesh_remap_vertices<Color>(r_arrays[i], p_remap);
+			} break;
+			case Variant::POOL_REAL_ARRAY: {
+				r_arrays[i] = _array_mesh_remap_vertices<real_t>(r_arrays[i], p_remap);
+			} break;
+			case Variant::POOL_INT_ARRAY: {
+				r_arrays[i] = _array_mesh_remap_vertices<int>(r_arrays[i], p_remap);
+			} break;
+			default: {
+			}
+		}
+	}
+}
+
+static PoolVector<int> _array_mesh_remap_indices(const PoolVector<int> &p_indices, const PoolVector<int> &p_remap) {
+
+	PoolVector<int> result;
+	result.resize(p_indices.size());
+
+	PoolVector<int>::Read r = p_indices.read();
+	PoolVector<int>::Read rm = p_remap.read();
+	PoolVector<int>::Write w = result.write();
+	for (int i = 0; i < p_indices.size(); i++) {
+		w[i] = rm[r[i]];
+	}
+
+	return result;
+}
+
+void ArrayMesh::optimize_surfaces() {
+
+	//how much vertex cache efficiency may be traded for less overdraw
+	const float overdraw_threshold = 1.05;
+
+	struct OptimizedSurface {
+		PrimitiveType primitive;
+		uint32_t format;
+		Array arrays;
+		Array blend_shapes;
+		Surface source;
+	};
+
+	Vector<OptimizedSurface> optimized;
+	bool changed = false;
+
+	for (int i = 0; i < surfaces.size(); i++) {
+
+		OptimizedSurface os;
+		os.primitive = surface_get_primitive_type(i);
+		os.format = surface_get_format(i);
+		os.arrays = surface_get_arrays(i);
+		os.blend_shapes = surface_get_blend_shape_arrays(i);
+		os.source = surfaces[i];
+
+		if (!os.source.is_2d && os.primitive == PRIMITIVE_TRIANGLES && (os.format & ARRAY_FORMAT_INDEX)) {
+
+			PoolVector<Vector3> vertices = os.arrays[ARRAY_VERTEX];
+			PoolVector<int> indices = os.arrays[ARRAY_INDEX];
+			int vertex_count = vertices.size();
+
+			indices = SurfaceTool::optimize_indices_for_cache(indices, vertex_count);
+			indices = SurfaceTool::optimize_indices_for_overdraw(vertices, indices, overdraw_threshold);
+
+			PoolVector<int> remap = SurfaceTool::optimize_vertex_fetch_remap(indices, vertex_count);
+			ERR_CONTINUE(remap.size() != vertex_count);
+
+			os.arrays[ARRAY_INDEX] = _array_mesh_remap_indices(indices, remap);
+			_array_mesh_remap_arrays(os.arrays, remap);
+
+			for (int j = 0; j < os.blend_shapes.size(); j++) {
+				Array shape = os.blend_shapes[j];
+				_array_mesh_remap_arrays(shape, remap);
+				os.blend_shapes[j] = shape;
+			}
+
+			//lods share the vertices, so they follow the new layout and get their own cache order
+			for (int j = 0; j < os.source.lods.size(); j++) {
+				PoolVector<int> lod_indices = _array_mesh_remap_indices(os.source.lods[j].indices, remap);
+				os.source.lods.write[j].indices = SurfaceTool::optimize_indices_for_cache(lod_indices, vertex_count);
+			}
+
+			changed = true;
+		}
+
+		optimized.push_back(os);
+	}
+
+	if (!changed) {
+		return;
+	}
+
+	while (get_surface_count()) {
+		surface_remove(0);
+	}
+
+	for (int i = 0; i < optimized.size(); i++) {
+
+		const OptimizedSurface &os = optimized[i];
+
+		add_surface_from_arrays(os.primitive, os.arrays, os.blend_shapes, os.format);
+		int idx = get_surface_count() - 1;
+
+		surface_set_material(idx, os.source.material);
+		surface_set_name(idx, os.source.name);
+
+		if (os.source.lods.size()) {
+			surfaces.write[idx].lods = os.source.lods;
+			_surface_update_lods(idx);
+		}
+	}
+}
+
 void ArrayMesh::surface_update_region(int p_surface, int p_offset, const PoolVector<uint8_t> &p_data) {
 
 	ERR_FAIL_INDEX(p_surface, surfaces.size());
@@ -1056,6 +1464,15 @@ RID ArrayMesh::get_rid() const {
 
 	return mesh;
 }
+
+uint64_t ArrayMesh::get_memory_usage() const {
+
+	uint64_t memory = 0;
+	for (int i = 0; i < surfaces.size(); i++) {
+		memory += surfaces[i].memory + surfaces[i].lod_memory;
+	}
+	return memory;
+}
 AABB ArrayMesh::get_aabb() const {
 
 	return aabb;
@@ -1105,19 +1522,56 @@ struct ArrayMeshLightmapSurface {
 	uint32_t format;
 };
 
-Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texel_size) {
-
-	ERR_FAIL_COND_V(!array_mesh_lightmap_unwrap_callback, ERR_UNCONFIGURED);
-	ERR_FAIL_COND_V_MSG(blend_shapes.size() != 0, ERR_UNAVAILABLE, "Can't unwrap mesh with blend shapes.");
+struct ArrayMeshLightmapUnwrap {
 
+	float texel_size;
 	Vector<float> vertices;
 	Vector<float> normals;
 	Vector<int> indices;
 	Vector<int> face_materials;
-	Vector<float> uv;
 	Vector<Pair<int, int> > uv_index;
-
 	Vector<ArrayMeshLightmapSurface> surfaces;
+
+	bool ok;
+	float *gen_uvs;
+	int *gen_vertices;
+	int *gen_indices;
+	int gen_vertex_count;
+	int gen_index_count;
+	int size_x;
+	int size_y;
+
+	//only touches the data gathered above, so it can run on any thread
+	void unwrap() {
+		ok = array_mesh_lightmap_unwrap_callback(texel_size, vertices.ptr(), normals.ptr(), vertices.size() / 3, indices.ptr(), face_materials.ptr(), indices.size(), &gen_uvs, &gen_vertices, &gen_vertex_count, &gen_indices, &gen_index_count, &size_x, &size_y);
+	}
+
+	ArrayMeshLightmapUnwrap() :
+			texel_size(0.05),
+			ok(false),
+			gen_uvs(NULL),
+			gen_vertices(NULL),
+			gen_indices(NULL),
+			gen_vertex_count(0),
+			gen_index_count(0),
+			size_x(0),
+			size_y(0) {}
+};
+
+Error ArrayMesh::_lightmap_unwrap_prepare(const Transform &p_base_transform, float p_texel_size, ArrayMeshLightmapUnwrap &r_unwrap) const {
+
+	ERR_FAIL_COND_V(!array_mesh_lightmap_unwrap_callback, ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V_MSG(blend_shapes.size() != 0, ERR_UNAVAILABLE, "Can't unwrap mesh with blend shapes.");
+
+	r_unwrap.texel_size = p_texel_size;
+
+	Vector<float> &vertices = r_unwrap.vertices;
+	Vector<float> &normals = r_unwrap.normals;
+	Vector<int> &indices = r_unwrap.indices;
+	Vector<int> &face_materials = r_unwrap.face_materials;
+	Vector<Pair<int, int> > &uv_index = r_unwrap.uv_index;
+
+	Vector<ArrayMeshLightmapSurface> &surfaces = r_unwrap.surfaces;
 	for (int i = 0; i < get_surface_count(); i++) {
 		ArrayMeshLightmapSurface s;
 		s.primitive = surface_get_primitive_type(i);
@@ -1188,22 +1642,22 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 		surfaces.push_back(s);
 	}
 
-	//unwrap
-
-	float *gen_uvs;
-	int *gen_vertices;
-	int *gen_indices;
-	int gen_vertex_count;
-	int gen_index_count;
-	int size_x;
-	int size_y;
+	return OK;
+}
 
-	bool ok = array_mesh_lightmap_unwrap_callback(p_texel_size, vertices.ptr(), normals.ptr(), vertices.size() / 3, indices.ptr(), face_materials.ptr(), indices.size(), &gen_uvs, &gen_vertices, &gen_vertex_count, &gen_indices, &gen_index_count, &size_x, &size_y);
+Error ArrayMesh::_lightmap_unwrap_apply(ArrayMeshLightmapUnwrap &p_unwrap) {
 
-	if (!ok) {
+	if (!p_unwrap.ok) {
 		return ERR_CANT_CREATE;
 	}
 
+	const Vector<Pair<int, int> > &uv_index = p_unwrap.uv_index;
+	const Vector<ArrayMeshLightmapSurface> &surfaces = p_unwrap.surfaces;
+	float *gen_uvs = p_unwrap.gen_uvs;
+	int *gen_vertices = p_unwrap.gen_vertices;
+	int *gen_indices = p_unwrap.gen_indices;
+	int gen_index_count = p_unwrap.gen_index_count;
+
 	//remove surfaces
 	while (get_surface_count()) {
 		surface_remove(0);
@@ -1277,11 +1731,67 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 		surfaces_tools.write[i]->commit(Ref<ArrayMesh>((ArrayMesh *)this), surfaces[i].format);
 	}
 
-	set_lightmap_size_hint(Size2(size_x, size_y));
+	set_lightmap_size_hint(Size2(p_unwrap.size_x, p_unwrap.size_y));
 
 	return OK;
 }
 
+Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texel_size) {
+
+	ArrayMeshLightmapUnwrap unwrap;
+	Error err = _lightmap_unwrap_prepare(p_base_transform, p_texel_size, unwrap);
+	if (err != OK) {
+		return err;
+	}
+
+	unwrap.unwrap();
+
+	return _lightmap_unwrap_apply(unwrap);
+}
+
+static void _array_mesh_lightmap_unwrap_task(void *p_userdata, uint32_t p_index) {
+
+	ArrayMeshLightmapUnwrap **unwraps = (ArrayMeshLightmapUnwrap **)p_userdata;
+	unwraps[p_index]->unwrap();
+}
+
+Vector<Error> ArrayMesh::lightmap_unwrap_multiple(const Vector<Ref<ArrayMesh> > &p_meshes, const Vector<Transform> &p_base_transforms, float p_texel_size) {
+
+	ERR_FAIL_COND_V(p_meshes.size() != p_base_transforms.size(), Vector<Error>());
+
+	Vector<Error> errors;
+	errors.resize(p_meshes.size());
+
+	//gathering and rebuilding the surfaces goes through the visual server, so only the unwrapper runs on the pool
+	Vector<ArrayMeshLightmapUnwrap> unwraps;
+	unwraps.resize(p_meshes.size());
+	Vector<ArrayMeshLightmapUnwrap *> pending;
+	for (int i = 0; i < p_meshes.size(); i++) {
+		errors.write[i] = p_meshes[i].is_valid() ? p_meshes[i]->_lightmap_unwrap_prepare(p_base_transforms[i], p_texel_size, unwraps.write[i]) : ERR_INVALID_PARAMETER;
+		if (errors[i] == OK) {
+			pending.push_back(&unwraps.write[i]);
+		}
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && pending.size() > 1) {
+		pool->wait_for_task_completion(pool->add_native_group_task(&_array_mesh_lightmap_unwrap_task, pending.ptrw(), pending.size()));
+	} else {
+		for (int i = 0; i < pending.size(); i++) {
+			pending.write[i]->unwrap();
+		}
+	}
+
+	for (int i = 0; i < p_meshes.size(); i++) {
+		if (errors[i] == OK) {
+			Ref<ArrayMesh> mesh = p_meshes[i];
+			errors.write[i] = mesh->_lightmap_unwrap_apply(unwraps.write[i]);
+		}
+	}
+
+	return errors;
+}
+
 void ArrayMesh::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("add_blend_shape", "name"), &ArrayMesh::add_blend_shape);
@@ -1301,6 +1811,13 @@ void ArrayMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("surface_find_by_name", "name"), &ArrayMesh::surface_find_by_name);
 	ClassDB::bind_method(D_METHOD("surface_set_name", "surf_idx", "name"), &ArrayMesh::surface_set_name);
 	ClassDB::bind_method(D_METHOD("surface_get_name", "surf_idx"), &ArrayMesh::surface_get_name);
+	ClassDB::bind_method(D_METHOD("surface_add_lod", "surf_idx", "edge_length", "indices"), &ArrayMesh::surface_add_lod);
+	ClassDB::bind_method(D_METHOD("surface_clear_lods", "surf_idx"), &ArrayMesh::surface_clear_lods);
+	ClassDB::bind_method(D_METHOD("surface_get_lod_count", "surf_idx"), &ArrayMesh::surface_get_lod_count);
+	ClassDB::bind_method(D_METHOD("surface_get_lod_edge_length", "surf_idx", "lod"), &ArrayMesh::surface_get_lod_edge_length);
+	ClassDB::bind_method(D_METHOD("surface_get_lod_indices", "surf_idx", "lod"), &ArrayMesh::surface_get_lod_indices);
+	ClassDB::bind_method(D_METHOD("generate_lods"), &ArrayMesh::generate_lods);
+	ClassDB::bind_method(D_METHOD("optimize_surfaces"), &ArrayMesh::optimize_surfaces);
 	ClassDB::bind_method(D_METHOD("create_trimesh_shape"), &ArrayMesh::create_trimesh_shape);
 	ClassDB::bind_method(D_METHOD("create_convex_shape"), &ArrayMesh::create_convex_shape);
 	ClassDB::bind_method(D_METHOD("create_outline", "margin"), &ArrayMesh::create_outline);
@@ -151,10 +151,14 @@ public:
 	static ConvexDecompositionFunc convex_composition_function;
 
 	Vector<Ref<Shape> > convex_decompose() const;
+	//decomposes several meshes at once, running the decomposition itself on the WorkerThreadPool
+	static Vector<Vector<Ref<Shape> > > convex_decompose_multiple(const Vector<Ref<Mesh> > &p_meshes);
 
 	Mesh();
 };
 
+struct ArrayMeshLightmapUnwrap;
+
 class ArrayMesh : public Mesh {
 
 	GDCLASS(ArrayMesh, Mesh);
@@ -166,6 +170,20 @@ private:
 		AABB aabb;
 		Ref<Material> material;
 		bool is_2d;
+		uint64_t memory; //bytes of the vertex, index and blend shape data given to the server
+
+		struct LOD {
+			float edge_length; //object space error, lods are sorted from finest to coarsest
+			PoolVector<int> indices;
+		};
+
+		Vector<LOD> lods;
+		uint64_t lod_memory;
+
+		Surface() :
+				is_2d(false),
+				memory(0),
+				lod_memory(0) {}
 	};
 	Vector<Surface> surfaces;
 	RID mesh;
@@ -175,6 +193,10 @@ private:
 	AABB custom_aabb;
 
 	void _recompute_aabb();
+	void _surface_update_lods(int p_idx);
+
+	Error _lightmap_unwrap_prepare(const Transform &p_base_transform, float p_texel_size, ArrayMeshLightmapUnwrap &r_unwrap) const;
+	Error _lightmap_unwrap_apply(ArrayMeshLightmapUnwrap &p_unwrap);
 
 protected:
 	virtual bool _is_generated() const { return false; }
@@ -220,6 +242,15 @@ public:
 	void surface_set_name(int p_idx, const String &p_name);
 	String surface_get_name(int p_idx) const;
 
+	void surface_add_lod(int p_idx, float p_edge_length, const PoolVector<int> &p_indices);
+	void surface_clear_lods(int p_idx);
+	int surface_get_lod_count(int p_idx) const;
+	float surface_get_lod_edge_length(int p_idx, int p_lod) const;
+	PoolVector<int> surface_get_lod_indices(int p_idx, int p_lod) const;
+
+	void generate_lods();
+	void optimize_surfaces();
+
 	void add_surface_from_mesh_data(const Geometry::MeshData &p_mesh_data);
 
 	void set_custom_aabb(const AABB &p_custom);
@@ -227,10 +258,13 @@ public:
 
 	AABB get_aabb() const;
 	virtual RID get_rid() const;
+	virtual uint64_t get_memory_usage() const;
 
 	void regen_normalmaps();
 
 	Error lightmap_unwrap(const Transform &p_base_transform = Transform(), float p_texel_size = 0.05);
+	//unwraps several meshes at once, running the unwrapper itself on the WorkerThreadPool
+	static Vector<Error> lightmap_unwrap_multiple(const Vector<Ref<ArrayMesh> > &p_meshes, const Vector<Transform> &p_base_transforms, float p_texel_size = 0.05);
 
 	virtual void reload_from_file();
 
@@ -46,6 +46,52 @@ bool SceneState::can_instance() const {
 	return nodes.size() > 0;
 }
 
+const SceneState::InstancePlan *SceneState::_get_instance_plan() const {
+
+	InstancePlan *plan = instance_plan.get();
+	if (plan)
+		return plan;
+
+	plan = memnew(InstancePlan);
+
+	int nc = nodes.size();
+	plan->create.resize(nc);
+	plan->property_offsets.resize(nc);
+
+	int property_count = 0;
+	for (int i = 0; i < nc; i++) {
+
+		const NodeData &n = nodes[i];
+
+		ClassDB::InstanceFunc create = NULL;
+		if (!(i == 0 && base_scene_idx >= 0) && n.instance < 0 && n.type != TYPE_INSTANCED && n.type >= 0 && n.type < names.size() && ClassDB::is_parent_class(names[n.type], "Node")) {
+			create = ClassDB::get_instance_func(names[n.type]);
+		}
+		plan->create.write[i] = create;
+		plan->property_offsets.write[i] = property_count;
+		property_count += n.properties.size();
+	}
+
+	if (property_count) {
+		plan->property_caches = memnew_arr(MethodCallCache, property_count);
+	}
+
+	//another thread may have built it meanwhile, keep the first one
+	if (!instance_plan.compare_exchange(NULL, plan)) {
+		memdelete(plan);
+		plan = instance_plan.get();
+	}
+
+	return plan;
+}
+
+void SceneState::_clear_instance_plan() {
+
+	InstancePlan *plan = instance_plan.exchange(NULL);
+	if (plan)
+		memdelete(plan);
+}
+
 Node *SceneState::instance(GenEditState p_edit_state) const {
 
 	// nodes where instancing failed (because something is missing)
@@ -84,6 +130,9 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 	Map<Ref<Resource>, Ref<Resource> > resources_local_to_scene;
 
+	//the editor may enable and disable classes, so it always takes the generic path
+	const InstancePlan *plan = (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) ? _get_instance_plan() : NULL;
+
 	for (int i = 0; i < nc; i++) {
 
 		const NodeData &n = nd[i];
@@ -149,6 +198,10 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 				}
 #endif
 			}
+		} else if (plan && plan->create[i]) {
+			//node belongs to this scene, its constructor was resolved in the plan
+			node = static_cast<Node *>(plan->create[i]());
+
 		} else if (ClassDB::is_class_enabled(snames[n.type])) {
 			//node belongs to this scene and must be created
 			Object *obj = ClassDB::instance(snames[n.type]);
@@ -189,6 +242,7 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 			if (nprop_count) {
 
 				const NodeData::Property *nprops = &n.properties[0];
+				MethodCallCache *prop_caches = plan ? plan->property_caches + plan->property_offsets[i] : NULL;
 
 				for (int j = 0; j < nprop_count; j++) {
 
@@ -250,7 +304,11 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
 						}
-						node->set(snames[nprops[j].name], value, &valid);
+						if (prop_caches) {
+							node->set_cached(prop_caches[j], snames[nprops[j].name], value, &valid);
+						} else {
+							node->set(snames[nprops[j].name], value, &valid);
+						}
 					}
 				}
 			}
@@ -924,6 +982,7 @@ String SceneState::get_path() const {
 
 void SceneState::clear() {
 
+	_clear_instance_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1097,6 +1156,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_clear_instance_plan();
+
 	const int node_count = p_dictionary["node_count"];
 	const PoolVector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -1564,6 +1625,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.instance = p_instance;
 	nd.index = p_index;
 
+	_clear_instance_plan();
 	nodes.push_back(nd);
 
 	return nodes.size() - 1;
@@ -1577,6 +1639,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	NodeData::Property prop;
 	prop.name = p_name;
 	prop.value = p_value;
+	_clear_instance_plan();
 	nodes.write[p_node].properties.push_back(prop);
 }
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -1588,6 +1651,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 void SceneState::set_base_scene(int p_idx) {
 
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instance_plan();
 	base_scene_idx = p_idx;
 }
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, const Vector<int> &p_binds) {
@@ -1653,12 +1717,18 @@ void SceneState::_bind_methods() {
 	BIND_ENUM_CONSTANT(GEN_EDIT_STATE_MAIN);
 }
 
-SceneState::SceneState() {
+SceneState::SceneState() :
+		instance_plan(NULL) {
 
 	base_scene_idx = -1;
 	last_modified_time = 0;
 }
 
+SceneState::~SceneState() {
+
+	_clear_instance_plan();
+}
+
 ////////////////
 
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
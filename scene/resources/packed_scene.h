@@ -92,6 +92,26 @@ class SceneState : public Reference {
 
 	Vector<ConnectionData> connections;
 
+	// what instance() can resolve once for all runtime instances: the constructor of every
+	// node it creates from its type and a setter cache per stored property
+	struct InstancePlan {
+
+		Vector<ClassDB::InstanceFunc> create; //per node, NULL when not created from its type
+		Vector<int> property_offsets; //per node, index of its first property in property_caches
+		MethodCallCache *property_caches;
+
+		InstancePlan() { property_caches = NULL; }
+		~InstancePlan() {
+			if (property_caches)
+				memdelete_arr(property_caches);
+		}
+	};
+
+	mutable SafePointer<InstancePlan> instance_plan;
+
+	const InstancePlan *_get_instance_plan() const;
+	void _clear_instance_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
@@ -190,6 +210,7 @@ public:
 	uint64_t get_last_modified_time() const { return last_modified_time; }
 
 	SceneState();
+	~SceneState();
 };
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
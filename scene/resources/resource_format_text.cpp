@@ -32,6 +32,7 @@
 
 #include "core/io/resource_format_binary.h"
 #include "core/os/dir_access.h"
+#include "core/os/thread.h"
 #include "core/project_settings.h"
 #include "core/version.h"
 
@@ -722,6 +723,7 @@ void ResourceInteractiveLoaderText::get_dependencies(FileAccess *p_f, List<Strin
 
 Error ResourceInteractiveLoaderText::rename_dependencies(FileAccess *p_f, const String &p_path, const Map<String, String> &p_map) {
 
+	stream.readahead_enabled = false; //tag positions in the file are used below
 	open(p_f, true);
 	ERR_FAIL_COND_V(error != OK, error);
 	ignore_resource_parsing = true;
@@ -1217,11 +1219,57 @@ String ResourceInteractiveLoaderText::recognize(FileAccess *p_f) {
 
 /////////////////////
 
+Ref<ResourceInteractiveLoader> ResourceFormatLoaderText::_load_binary_cache(const String &p_path, const String &p_original_path, Error *r_error) {
+
+	String local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	if (!local_path.begins_with("res://")) {
+		return Ref<ResourceInteractiveLoader>();
+	}
+
+	String cache_path = "res://.import/" + local_path.get_file() + "-" + local_path.md5_text() + (local_path.get_extension() == "tscn" ? ".scn" : ".res");
+
+	//strictly newer, so an edit within the same second as the conversion is not missed
+	if (FileAccess::get_modified_time(cache_path) <= FileAccess::get_modified_time(p_path)) {
+
+		DirAccess *da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+		if (!da->dir_exists("res://.import")) {
+			da->make_dir_recursive("res://.import");
+		}
+
+		//convert aside and move it in place, so concurrent loads never see a partial file
+		String temp_path = cache_path + ".tmp" + itos(Thread::get_caller_id());
+		if (convert_file_to_binary(p_path, temp_path) != OK) {
+			memdelete(da);
+			return Ref<ResourceInteractiveLoader>();
+		}
+
+		if (da->file_exists(cache_path)) {
+			da->remove(cache_path);
+		}
+		Error err = da->rename(temp_path, cache_path);
+		memdelete(da);
+		if (err != OK) {
+			return Ref<ResourceInteractiveLoader>();
+		}
+	}
+
+	Ref<ResourceFormatLoaderBinary> binary_loader;
+	binary_loader.instance();
+	return binary_loader->load_interactive(cache_path, p_original_path != "" ? p_original_path : local_path, r_error);
+}
+
 Ref<ResourceInteractiveLoader> ResourceFormatLoaderText::load_interactive(const String &p_path, const String &p_original_path, Error *r_error) {
 
 	if (r_error)
 		*r_error = ERR_CANT_OPEN;
 
+	if (GLOBAL_GET("filesystem/text_resources/use_binary_cache")) {
+		Ref<ResourceInteractiveLoader> cached = _load_binary_cache(p_path, p_original_path, r_error);
+		if (cached.is_valid()) {
+			return cached;
+		}
+	}
+
 	Error err;
 	FileAccess *f = FileAccess::open(p_path, FileAccess::READ, &err);
 
@@ -1395,6 +1443,8 @@ void ResourceFormatSaverTextInstance::_find_resources(const Variant &p_variant,
 			if (resource_set.has(res))
 				return;
 
+			res->ensure_loaded();
+
 			List<PropertyInfo> property_list;
 
 			res->get_property_list(&property_list);
@@ -1459,7 +1509,9 @@ void ResourceFormatSaverTextInstance::_find_resources(const Variant &p_variant,
 	}
 }
 
-Error ResourceFormatSaverTextInstance::save(const String &p_path, const RES &p_resource, uint32_t p_flags) {
+Error ResourceFormatSaverTextInstance::save(const String &p_path, const RES &p_resource, uint32_t p_flags, VariantWriter::PoolArrayCache *p_pool_array_cache) {
+
+	pool_array_cache = p_pool_array_cache;
 
 	if (p_path.ends_with(".tscn")) {
 		packed_scene = p_resource;
@@ -1660,7 +1712,7 @@ Error ResourceFormatSaverTextInstance::save(const String &p_path, const RES &p_r
 					continue;
 
 				String vars;
-				VariantWriter::write_to_string(value, vars, _write_resources, this);
+				VariantWriter::write_to_string(value, vars, _write_resources, this, pool_array_cache);
 				f->store_string(name.property_name_encode() + " = " + vars + "\n");
 			}
 		}
@@ -1731,7 +1783,7 @@ Error ResourceFormatSaverTextInstance::save(const String &p_path, const RES &p_r
 			for (int j = 0; j < state->get_node_property_count(i); j++) {
 
 				String vars;
-				VariantWriter::write_to_string(state->get_node_property_value(i, j), vars, _write_resources, this);
+				VariantWriter::write_to_string(state->get_node_property_value(i, j), vars, _write_resources, this, pool_array_cache);
 
 				f->store_string(String(state->get_node_property_name(i, j)).property_name_encode() + " = " + vars + "\n");
 			}
@@ -1787,7 +1839,18 @@ Error ResourceFormatSaverText::save(const String &p_path, const RES &p_resource,
 	}
 
 	ResourceFormatSaverTextInstance saver;
-	return saver.save(p_path, p_resource, p_flags);
+
+	// Another thread may be saving; it's fine to write the arrays again in that case.
+	if (!pool_array_cache_mutex || pool_array_cache_mutex->try_lock() != OK) {
+		return saver.save(p_path, p_resource, p_flags);
+	}
+
+	pool_array_cache.begin_pass();
+	Error err = saver.save(p_path, p_resource, p_flags, &pool_array_cache);
+	pool_array_cache.end_pass();
+	pool_array_cache_mutex->unlock();
+
+	return err;
 }
 
 bool ResourceFormatSaverText::recognize(const RES &p_resource) const {
@@ -1805,4 +1868,11 @@ void ResourceFormatSaverText::get_recognized_extensions(const RES &p_resource, L
 ResourceFormatSaverText *ResourceFormatSaverText::singleton = NULL;
 ResourceFormatSaverText::ResourceFormatSaverText() {
 	singleton = this;
+	pool_array_cache_mutex = Mutex::create();
+}
+
+ResourceFormatSaverText::~ResourceFormatSaverText() {
+	if (pool_array_cache_mutex) {
+		memdelete(pool_array_cache_mutex);
+	}
 }
@@ -128,6 +128,9 @@ public:
 };
 
 class ResourceFormatLoaderText : public ResourceFormatLoader {
+
+	Ref<ResourceInteractiveLoader> _load_binary_cache(const String &p_path, const String &p_original_path, Error *r_error);
+
 public:
 	static ResourceFormatLoaderText *singleton;
 	virtual Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_original_path = "", Error *r_error = NULL);
@@ -154,6 +157,7 @@ class ResourceFormatSaverTextInstance {
 	bool bundle_resources;
 	bool skip_editor;
 	FileAccess *f;
+	VariantWriter::PoolArrayCache *pool_array_cache;
 
 	struct NonPersistentKey { //for resource properties generated on the fly
 		RES base;
@@ -182,10 +186,15 @@ class ResourceFormatSaverTextInstance {
 	String _write_resource(const RES &res);
 
 public:
-	Error save(const String &p_path, const RES &p_resource, uint32_t p_flags = 0);
+	Error save(const String &p_path, const RES &p_resource, uint32_t p_flags = 0, VariantWriter::PoolArrayCache *p_pool_array_cache = NULL);
 };
 
 class ResourceFormatSaverText : public ResourceFormatSaver {
+
+	// Scenes are saved over and over in the editor, mostly with their big arrays unchanged.
+	VariantWriter::PoolArrayCache pool_array_cache;
+	Mutex *pool_array_cache_mutex;
+
 public:
 	static ResourceFormatSaverText *singleton;
 	virtual Error save(const String &p_path, const RES &p_resource, uint32_t p_flags = 0);
@@ -193,6 +202,7 @@ public:
 	virtual void get_recognized_extensions(const RES &p_resource, List<String> *p_extensions) const;
 
 	ResourceFormatSaverText();
+	~ResourceFormatSaverText();
 };
 
 #endif // RESOURCE_FORMAT_TEXT_H
@@ -44,9 +44,7 @@ void Shape::add_vertices_to_array(PoolVector<Vector3> &array, const Transform &p
 		int base = array.size();
 		array.resize(base + toadd.size());
 		PoolVector<Vector3>::Write w = array.write();
-		for (int i = 0; i < toadd.size(); i++) {
-			w[i + base] = p_xform.xform(toadd[i]);
-		}
+		p_xform.xform_array(toadd.ptr(), w.ptr() + base, toadd.size());
 	}
 }
 
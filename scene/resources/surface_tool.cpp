@@ -479,26 +479,53 @@ void SurfaceTool::index() {
 	if (index_array.size())
 		return; //already indexed
 
-	HashMap<Vertex, int, VertexHasher> indices;
-	List<Vertex> new_vertices;
+	//open addressed table of positions in new_vertices, each vertex is hashed once and full compares only happen on equal hashes
+	int vertex_count = vertex_array.size();
+	uint32_t table_size = next_power_of_2(MAX(vertex_count * 2, 1));
+	uint32_t table_mask = table_size - 1;
+
+	Vector<int> table;
+	table.resize(table_size);
+	for (uint32_t i = 0; i < table_size; i++) {
+		table.write[i] = -1;
+	}
+
+	Vector<Vertex> new_vertices;
+	Vector<uint32_t> new_hashes;
+	new_vertices.resize(vertex_count);
+	new_hashes.resize(vertex_count);
+	int new_count = 0;
 
 	for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next()) {
 
-		int *idxptr = indices.getptr(E->get());
-		int idx;
-		if (!idxptr) {
-			idx = indices.size();
-			new_vertices.push_back(E->get());
-			indices[E->get()] = idx;
-		} else {
-			idx = *idxptr;
+		const Vertex &vertex = E->get();
+		uint32_t hash = VertexHasher::hash(vertex);
+		uint32_t pos = hash & table_mask;
+		int idx = -1;
+
+		while (table[pos] != -1) {
+			int existing = table[pos];
+			if (new_hashes[existing] == hash && new_vertices[existing] == vertex) {
+				idx = existing;
+				break;
+			}
+			pos = (pos + 1) & table_mask;
+		}
+
+		if (idx == -1) {
+			idx = new_count++;
+			new_vertices.write[idx] = vertex;
+			new_hashes.write[idx] = hash;
+			table.write[pos] = idx;
 		}
 
 		index_array.push_back(idx);
 	}
 
 	vertex_array.clear();
-	vertex_array = new_vertices;
+	for (int i = 0; i < new_count; i++) {
+		vertex_array.push_back(new_vertices[i]);
+	}
 
 	format |= Mesh::ARRAY_FORMAT_INDEX;
 }
@@ -1063,6 +1090,770 @@ void SurfaceTool::clear() {
 	material.unref();
 }
 
+//simplification, collapses edges in order of quadric error while keeping the vertex array untouched
+
+struct SimplifyQuadric {
+
+	double a00, a01, a02, a11, a12, a22;
+	double b0, b1, b2;
+	double c;
+	double weight;
+
+	void add_plane(const Vector3 &p_normal, double p_d, double p_weight) {
+
+		a00 += p_weight * p_normal.x * p_normal.x;
+		a01 += p_weight * p_normal.x * p_normal.y;
+		a02 += p_weight * p_normal.x * p_normal.z;
+		a11 += p_weight * p_normal.y * p_normal.y;
+		a12 += p_weight * p_normal.y * p_normal.z;
+		a22 += p_weight * p_normal.z * p_normal.z;
+		b0 += p_weight * p_normal.x * p_d;
+		b1 += p_weight * p_normal.y * p_d;
+		b2 += p_weight * p_normal.z * p_d;
+		c += p_weight * p_d * p_d;
+		weight += p_weight;
+	}
+
+	void add(const SimplifyQuadric &p_quadric) {
+
+		a00 += p_quadric.a00;
+		a01 += p_quadric.a01;
+		a02 += p_quadric.a02;
+		a11 += p_quadric.a11;
+		a12 += p_quadric.a12;
+		a22 += p_quadric.a22;
+		b0 += p_quadric.b0;
+		b1 += p_quadric.b1;
+		b2 += p_quadric.b2;
+		c += p_quadric.c;
+		weight += p_quadric.weight;
+	}
+
+	//squared distance to the planes, averaged by area
+	double get_error(const Vector3 &p_pos) const {
+
+		if (weight <= 0.0) {
+			return 0.0;
+		}
+
+		double x = p_pos.x;
+		double y = p_pos.y;
+		double z = p_pos.z;
+
+		double error = a00 * x * x + a11 * y * y + a22 * z * z;
+		error += 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z);
+		error += 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+
+		return MAX(error, 0.0) / weight;
+	}
+
+	SimplifyQuadric() {
+		a00 = a01 = a02 = a11 = a12 = a22 = 0.0;
+		b0 = b1 = b2 = 0.0;
+		c = 0.0;
+		weight = 0.0;
+	}
+};
+
+struct SimplifyCollapse {
+
+	int from;
+	int to;
+	double error;
+
+	bool operator<(const SimplifyCollapse &p_collapse) const {
+		return error < p_collapse.error;
+	}
+};
+
+struct SimplifyPositionHasher {
+
+	static _FORCE_INLINE_ uint32_t hash(const Vector3 &p_pos) {
+		uint32_t h = hash_djb2_one_float(p_pos.x);
+		h = hash_djb2_one_float(p_pos.y, h);
+		return hash_djb2_one_float(p_pos.z, h);
+	}
+};
+
+PoolVector<int> SurfaceTool::simplify_indices(const PoolVector<Vector3> &p_vertices, const PoolVector<int> &p_indices, int p_target_index_count, float p_max_error, float *r_error) {
+
+	if (r_error) {
+		*r_error = 0;
+	}
+
+	ERR_FAIL_COND_V(p_indices.size() % 3 != 0, p_indices);
+
+	int vertex_count = p_vertices.size();
+	if (vertex_count == 0 || p_indices.size() <= p_target_index_count) {
+		return p_indices;
+	}
+
+	//work on positions scaled to a unit extent, so errors are relative to the mesh size
+	Vector<Vector3> positions;
+	positions.resize(vertex_count);
+	{
+		PoolVector<Vector3>::Read r = p_vertices.read();
+
+		AABB aabb;
+		aabb.position = r[0];
+		for (int i = 1; i < vertex_count; i++) {
+			aabb.expand_to(r[i]);
+		}
+
+		float extent = MAX(aabb.get_longest_axis_size(), CMP_EPSILON);
+		for (int i = 0; i < vertex_count; i++) {
+			positions.write[i] = (r[i] - aabb.position) / extent;
+		}
+	}
+
+	Vector<int> indices;
+	indices.resize(p_indices.size());
+	{
+		PoolVector<int>::Read r = p_indices.read();
+		for (int i = 0; i < p_indices.size(); i++) {
+			ERR_FAIL_INDEX_V(r[i], vertex_count, p_indices);
+			indices.write[i] = r[i];
+		}
+	}
+
+	//vertices sharing their position with others (uv or normal seams) or lying on open borders stay in place
+	Vector<bool> locked;
+	locked.resize(vertex_count);
+	{
+		HashMap<Vector3, int, SimplifyPositionHasher> position_map;
+		Vector<int> canonical;
+		canonical.resize(vertex_count);
+
+		for (int i = 0; i < vertex_count; i++) {
+
+			locked.write[i] = false;
+
+			const int *existing = position_map.getptr(positions[i]);
+			if (existing) {
+				canonical.write[i] = *existing;
+				locked.write[i] = true;
+				locked.write[*existing] = true;
+			} else {
+				position_map.set(positions[i], i);
+				canonical.write[i] = i;
+			}
+		}
+
+		HashMap<uint64_t, int> edge_uses;
+
+		for (int pass = 0; pass < 2; pass++) {
+
+			for (int i = 0; i < indices.size(); i += 3) {
+				for (int j = 0; j < 3; j++) {
+
+					int a = indices[i + j];
+					int b = indices[i + (j + 1) % 3];
+					uint32_t ca = canonical[a];
+					uint32_t cb = canonical[b];
+					uint64_t key = ca < cb ? (uint64_t(ca) << 32) | cb : (uint64_t(cb) << 32) | ca;
+
+					if (pass == 0) {
+						int *uses = edge_uses.getptr(key);
+						if (uses) {
+							(*uses)++;
+						} else {
+							edge_uses.set(key, 1);
+						}
+					} else if (edge_uses[key] == 1) {
+						locked.write[a] = true;
+						locked.write[b] = true;
+					}
+				}
+			}
+		}
+	}
+
+	Vector<SimplifyQuadric> quadrics;
+	quadrics.resize(vertex_count);
+
+	for (int i = 0; i < indices.size(); i += 3) {
+
+		const Vector3 &p0 = positions[indices[i + 0]];
+		Vector3 normal = (positions[indices[i + 1]] - p0).cross(positions[indices[i + 2]] - p0);
+		float area = normal.length();
+		if (area <= 0.0) {
+			continue;
+		}
+		normal /= area;
+		double d = -normal.dot(p0);
+
+		for (int j = 0; j < 3; j++) {
+			quadrics.write[indices[i + j]].add_plane(normal, d, area * 0.5);
+		}
+	}
+
+	double max_error = double(p_max_error) * double(p_max_error);
+	double result_error = 0.0;
+
+	Vector<int> remap;
+	Vector<bool> touched;
+	Vector<int> vertex_triangle_offsets;
+	Vector<int> vertex_triangles;
+	Vector<SimplifyCollapse> collapses;
+
+	remap.resize(vertex_count);
+	touched.resize(vertex_count);
+	vertex_triangle_offsets.resize(vertex_count + 1);
+
+	while (indices.size() > p_target_index_count) {
+
+		int triangle_count = indices.size() / 3;
+		const int *idx = indices.ptr();
+
+		//triangles around each vertex
+		for (int i = 0; i <= vertex_count; i++) {
+			vertex_triangle_offsets.write[i] = 0;
+		}
+		for (int i = 0; i < indices.size(); i++) {
+			vertex_triangle_offsets.write[idx[i] + 1]++;
+		}
+		for (int i = 0; i < vertex_count; i++) {
+			vertex_triangle_offsets.write[i + 1] += vertex_triangle_offsets[i];
+		}
+		vertex_triangles.resize(indices.size());
+		for (int i = 0; i < vertex_count; i++) {
+			remap.write[i] = vertex_triangle_offsets[i]; //used as insertion cursor for now
+		}
+		for (int i = 0; i < indices.size(); i++) {
+			vertex_triangles.write[remap.write[idx[i]]++] = i / 3;
+		}
+
+		//candidates, interior edges show up once per direction so only one is needed
+		collapses.clear();
+		for (int i = 0; i < indices.size(); i += 3) {
+			for (int j = 0; j < 3; j++) {
+
+				int a = idx[i + j];
+				int b = idx[i + (j + 1) % 3];
+				if (a > b || (locked[a] && locked[b])) {
+					continue;
+				}
+
+				SimplifyQuadric q = quadrics[a];
+				q.add(quadrics[b]);
+
+				SimplifyCollapse collapse;
+				if (!locked[a]) {
+					collapse.from = a;
+					collapse.to = b;
+					collapse.error = q.get_error(positions[b]);
+					collapses.push_back(collapse);
+				}
+				if (!locked[b]) {
+					collapse.from = b;
+					collapse.to = a;
+					collapse.error = q.get_error(positions[a]);
+					collapses.push_back(collapse);
+				}
+			}
+		}
+
+		if (collapses.empty()) {
+			break;
+		}
+
+		collapses.sort();
+
+		for (int i = 0; i < vertex_count; i++) {
+			remap.write[i] = i;
+			touched.write[i] = false;
+		}
+
+		int triangles_to_remove = MAX((indices.size() - p_target_index_count) / 3, 1);
+		int removed = 0;
+		int collapsed = 0;
+
+		for (int i = 0; i < collapses.size(); i++) {
+
+			const SimplifyCollapse &collapse = collapses[i];
+
+			if (collapse.error > max_error || removed >= triangles_to_remove) {
+				break;
+			}
+			if (touched[collapse.from] || touched[collapse.to]) {
+				continue;
+			}
+
+			//moving the vertex must not flip any of the triangles that remain
+			bool flips = false;
+			int shared = 0;
+
+			for (int j = vertex_triangle_offsets[collapse.from]; j < vertex_triangle_offsets[collapse.from + 1]; j++) {
+
+				const int *tri = &idx[vertex_triangles[j] * 3];
+				if (tri[0] == collapse.to || tri[1] == collapse.to || tri[2] == collapse.to) {
+					shared++;
+					continue;
+				}
+
+				Vector3 p[3];
+				for (int k = 0; k < 3; k++) {
+					p[k] = positions[tri[k]];
+				}
+				Vector3 normal = (p[1] - p[0]).cross(p[2] - p[0]);
+				for (int k = 0; k < 3; k++) {
+					if (tri[k] == collapse.from) {
+						p[k] = positions[collapse.to];
+					}
+				}
+				Vector3 new_normal = (p[1] - p[0]).cross(p[2] - p[0]);
+
+				if (normal.dot(new_normal) <= 0.0) {
+					flips = true;
+					break;
+				}
+			}
+
+			if (flips) {
+				continue;
+			}
+
+			remap.write[collapse.from] = collapse.to;
+			quadrics.write[collapse.to].add(quadrics[collapse.from]);
+
+			//neighbours are frozen for the rest of the pass, their triangles were checked against old positions
+			for (int j = vertex_triangle_offsets[collapse.from]; j < vertex_triangle_offsets[collapse.from + 1]; j++) {
+				const int *tri = &idx[vertex_triangles[j] * 3];
+				for (int k = 0; k < 3; k++) {
+					touched.write[tri[k]] = true;
+				}
+			}
+
+			removed += shared;
+			collapsed++;
+			result_error = MAX(result_error, collapse.error);
+		}
+
+		if (collapsed == 0) {
+			break;
+		}
+
+		//apply the collapses and drop the triangles that became degenerate
+		Vector<int> new_indices;
+		new_indices.resize(indices.size());
+		int new_count = 0;
+
+		for (int i = 0; i < triangle_count; i++) {
+
+			int a = remap[idx[i * 3 + 0]];
+			int b = remap[idx[i * 3 + 1]];
+			int c = remap[idx[i * 3 + 2]];
+
+			if (a == b || b == c || c == a) {
+				continue;
+			}
+
+			new_indices.write[new_count++] = a;
+			new_indices.write[new_count++] = b;
+			new_indices.write[new_count++] = c;
+		}
+
+		new_indices.resize(new_count);
+		indices = new_indices;
+	}
+
+	if (r_error) {
+		*r_error = Math::sqrt(result_error);
+	}
+
+	PoolVector<int> result;
+	result.resize(indices.size());
+	{
+		PoolVector<int>::Write w = result.write();
+		for (int i = 0; i < indices.size(); i++) {
+			w[i] = indices[i];
+		}
+	}
+
+	return result;
+}
+
+//size of the LRU cache modelled when ordering for post transform cache reuse
+static const int FORSYTH_CACHE_SIZE = 32;
+
+static _FORCE_INLINE_ float _forsyth_vertex_score(int p_cache_pos, int p_remaining) {
+
+	if (p_remaining == 0) {
+		return -1.0; //no triangles left to use it
+	}
+
+	float score = 0.0;
+	if (p_cache_pos >= 0) {
+		if (p_cache_pos < 3) {
+			score = 0.75; //used by the last triangle, fixed so strips are not favoured over fans
+		} else {
+			score = Math::pow(1.0f - float(p_cache_pos - 3) / float(FORSYTH_CACHE_SIZE - 3), 1.5f);
+		}
+	}
+
+	//vertices with few triangles left are finished first, so they don't linger as lone stragglers
+	return score + 2.0f * Math::pow(float(p_remaining), -0.5f);
+}
+
+PoolVector<int> SurfaceTool::optimize_indices_for_cache(const PoolVector<int> &p_indices, int p_vertex_count) {
+
+	ERR_FAIL_COND_V(p_indices.size() % 3 != 0, p_indices);
+
+	int index_count = p_indices.size();
+	int triangle_count = index_count / 3;
+	if (triangle_count < 2) {
+		return p_indices;
+	}
+
+	Vector<int> indices;
+	indices.resize(index_count);
+	{
+		PoolVector<int>::Read r = p_indices.read();
+		for (int i = 0; i < index_count; i++) {
+			ERR_FAIL_INDEX_V(r[i], p_vertex_count, p_indices);
+			indices.write[i] = r[i];
+		}
+	}
+
+	Vector<int> vertex_triangle_offsets;
+	Vector<int> vertex_triangles;
+	Vector<int> remaining;
+	Vector<int> cache_pos;
+	Vector<float> vertex_score;
+
+	vertex_triangle_offsets.resize(p_vertex_count + 1);
+	vertex_triangles.resize(index_count);
+	remaining.resize(p_vertex_count);
+	cache_pos.resize(p_vertex_count);
+	vertex_score.resize(p_vertex_count);
+
+	for (int i = 0; i < p_vertex_count; i++) {
+		remaining.write[i] = 0;
+		cache_pos.write[i] = -1;
+	}
+	for (int i = 0; i < index_count; i++) {
+		remaining.write[indices[i]]++;
+	}
+	vertex_triangle_offsets.write[0] = 0;
+	for (int i = 0; i < p_vertex_count; i++) {
+		vertex_triangle_offsets.write[i + 1] = vertex_triangle_offsets[i] + remaining[i];
+		vertex_score.write[i] = _forsyth_vertex_score(-1, remaining[i]);
+	}
+	{
+		Vector<int> cursor;
+		cursor.resize(p_vertex_count);
+		for (int i = 0; i < p_vertex_count; i++) {
+			cursor.write[i] = vertex_triangle_offsets[i];
+		}
+		for (int i = 0; i < index_count; i++) {
+			vertex_triangles.write[cursor.write[indices[i]]++] = i / 3;
+		}
+	}
+
+	Vector<bool> emitted;
+	emitted.resize(triangle_count);
+	for (int i = 0; i < triangle_count; i++) {
+		emitted.write[i] = false;
+	}
+
+	//the cache holds three extra entries, the ones pushed out by the triangle just emitted
+	int cache[FORSYTH_CACHE_SIZE + 3];
+	int cache_count = 0;
+
+	PoolVector<int> result;
+	result.resize(index_count);
+	PoolVector<int>::Write w = result.write();
+	int result_count = 0;
+
+	int next_unemitted = 0;
+	int best = 0;
+
+	while (result_count < index_count) {
+
+		if (best == -1) {
+			//nothing in the cache has triangles left, continue from the original order
+			while (emitted[next_unemitted]) {
+				next_unemitted++;
+			}
+			best = next_unemitted;
+		}
+
+		emitted.write[best] = true;
+
+		const int *tri = &indices[best * 3];
+		int new_cache[FORSYTH_CACHE_SIZE + 3];
+		int new_cache_count = 0;
+
+		for (int j = 0; j < 3; j++) {
+
+			int v = tri[j];
+			w[result_count++] = v;
+			remaining.write[v]--;
+
+			bool cached = false;
+			for (int k = 0; k < new_cache_count; k++) {
+				if (new_cache[k] == v) {
+					cached = true;
+					break;
+				}
+			}
+			if (!cached) {
+				new_cache[new_cache_count++] = v;
+			}
+		}
+
+		for (int k = 0; k < cache_count; k++) {
+			int v = cache[k];
+			if (v != tri[0] && v != tri[1] && v != tri[2]) {
+				new_cache[new_cache_count++] = v;
+			}
+		}
+
+		for (int k = 0; k < new_cache_count; k++) {
+			int v = new_cache[k];
+			cache_pos.write[v] = k < FORSYTH_CACHE_SIZE ? k : -1;
+			vertex_score.write[v] = _forsyth_vertex_score(cache_pos[v], remaining[v]);
+		}
+
+		//only triangles touching the cache changed their score, the best of them goes next
+		best = -1;
+		float best_score = -1.0;
+
+		for (int k = 0; k < new_cache_count && k < FORSYTH_CACHE_SIZE; k++) {
+
+			int v = new_cache[k];
+			for (int j = vertex_triangle_offsets[v]; j < vertex_triangle_offsets[v + 1]; j++) {
+
+				int t = vertex_triangles[j];
+				if (emitted[t]) {
+					continue;
+				}
+
+				const int *other = &indices[t * 3];
+				float score = vertex_score[other[0]] + vertex_score[other[1]] + vertex_score[other[2]];
+				if (score > best_score) {
+					best_score = score;
+					best = t;
+				}
+			}
+		}
+
+		cache_count = MIN(new_cache_count, FORSYTH_CACHE_SIZE);
+		for (int k = 0; k < cache_count; k++) {
+			cache[k] = new_cache[k];
+		}
+	}
+
+	return result;
+}
+
+//size of the FIFO cache modelled when splitting into clusters, smaller than real hardware to stay conservative
+static const int OVERDRAW_CACHE_SIZE = 16;
+
+struct OverdrawCacheSim {
+
+	Vector<uint32_t> stamps;
+	uint32_t time;
+
+	_FORCE_INLINE_ int triangle_misses(const int *p_tri) {
+
+		int misses = 0;
+		for (int i = 0; i < 3; i++) {
+			if (time - stamps[p_tri[i]] > uint32_t(OVERDRAW_CACHE_SIZE)) {
+				stamps.write[p_tri[i]] = time++;
+				misses++;
+			}
+		}
+		return misses;
+	}
+
+	_FORCE_INLINE_ void flush() {
+		time += OVERDRAW_CACHE_SIZE + 1;
+	}
+
+	OverdrawCacheSim(int p_vertex_count) {
+		stamps.resize(p_vertex_count);
+		for (int i = 0; i < p_vertex_count; i++) {
+			stamps.write[i] = 0;
+		}
+		time = OVERDRAW_CACHE_SIZE + 1;
+	}
+};
+
+struct OverdrawCluster {
+
+	int from;
+	int to;
+	float sort_key;
+
+	bool operator<(const OverdrawCluster &p_cluster) const {
+		return sort_key > p_cluster.sort_key; //outermost first
+	}
+};
+
+PoolVector<int> SurfaceTool::optimize_indices_for_overdraw(const PoolVector<Vector3> &p_vertices, const PoolVector<int> &p_indices, float p_threshold) {
+
+	ERR_FAIL_COND_V(p_indices.size() % 3 != 0, p_indices);
+
+	int vertex_count = p_vertices.size();
+	int index_count = p_indices.size();
+	int triangle_count = index_count / 3;
+	if (triangle_count < 2) {
+		return p_indices;
+	}
+
+	{
+		PoolVector<int>::Read r = p_indices.read();
+		for (int i = 0; i < index_count; i++) {
+			ERR_FAIL_INDEX_V(r[i], vertex_count, p_indices);
+		}
+	}
+
+	PoolVector<int>::Read idx = p_indices.read();
+	PoolVector<Vector3>::Read pos = p_vertices.read();
+
+	//hard boundaries are where the cache order already restarts, reordering those clusters costs nothing
+	Vector<int> hard_boundaries;
+	{
+		OverdrawCacheSim cache(vertex_count);
+		for (int i = 0; i < triangle_count; i++) {
+			if (cache.triangle_misses(&idx[i * 3]) == 3 || i == 0) {
+				hard_boundaries.push_back(i);
+			}
+		}
+	}
+	hard_boundaries.push_back(triangle_count);
+
+	//soft boundaries split further wherever the cluster so far stays within the threshold of its whole cluster's miss ratio
+	Vector<OverdrawCluster> clusters;
+	{
+		OverdrawCacheSim cache(vertex_count);
+
+		for (int i = 0; i < hard_boundaries.size() - 1; i++) {
+
+			int from = hard_boundaries[i];
+			int to = hard_boundaries[i + 1];
+
+			cache.flush();
+			int cluster_misses = 0;
+			for (int j = from; j < to; j++) {
+				cluster_misses += cache.triangle_misses(&idx[j * 3]);
+			}
+			float cluster_threshold = p_threshold * float(cluster_misses) / float(to - from);
+
+			cache.flush();
+			int running_misses = 0;
+			int running_from = from;
+
+			for (int j = from; j < to; j++) {
+
+				running_misses += cache.triangle_misses(&idx[j * 3]);
+
+				if (j + 1 < to && float(running_misses) / float(j + 1 - running_from) <= cluster_threshold) {
+					OverdrawCluster cluster;
+					cluster.from = running_from;
+					cluster.to = j + 1;
+					clusters.push_back(cluster);
+
+					cache.flush();
+					running_misses = 0;
+					running_from = j + 1;
+				}
+			}
+
+			OverdrawCluster cluster;
+			cluster.from = running_from;
+			cluster.to = to;
+			clusters.push_back(cluster);
+		}
+	}
+
+	if (clusters.size() < 2) {
+		return p_indices;
+	}
+
+	Vector3 mesh_centroid;
+	for (int i = 0; i < index_count; i++) {
+		mesh_centroid += pos[idx[i]];
+	}
+	mesh_centroid /= index_count;
+
+	//clusters facing away from the middle of the mesh go first, they are the likeliest to occlude the rest
+	for (int i = 0; i < clusters.size(); i++) {
+
+		OverdrawCluster &cluster = clusters.write[i];
+
+		Vector3 centroid;
+		Vector3 normal;
+		float area = 0.0;
+
+		for (int j = cluster.from; j < cluster.to; j++) {
+
+			const Vector3 &p0 = pos[idx[j * 3 + 0]];
+			const Vector3 &p1 = pos[idx[j * 3 + 1]];
+			const Vector3 &p2 = pos[idx[j * 3 + 2]];
+
+			Vector3 n = (p1 - p0).cross(p2 - p0);
+			float a = n.length();
+
+			centroid += (p0 + p1 + p2) * (a / 3.0);
+			normal += n;
+			area += a;
+		}
+
+		if (area > 0.0) {
+			centroid /= area;
+		}
+
+		float normal_length = normal.length();
+		cluster.sort_key = normal_length > 0.0 ? (centroid - mesh_centroid).dot(normal / normal_length) : 0.0;
+	}
+
+	clusters.sort();
+
+	PoolVector<int> result;
+	result.resize(index_count);
+	{
+		PoolVector<int>::Write w = result.write();
+		int result_count = 0;
+		for (int i = 0; i < clusters.size(); i++) {
+			for (int j = clusters[i].from * 3; j < clusters[i].to * 3; j++) {
+				w[result_count++] = idx[j];
+			}
+		}
+	}
+
+	return result;
+}
+
+PoolVector<int> SurfaceTool::optimize_vertex_fetch_remap(const PoolVector<int> &p_indices, int p_vertex_count) {
+
+	PoolVector<int> remap;
+	remap.resize(p_vertex_count);
+
+	PoolVector<int>::Write w = remap.write();
+	for (int i = 0; i < p_vertex_count; i++) {
+		w[i] = -1;
+	}
+
+	//vertices are laid out in the order they are first used, unused ones are kept at the end
+	int next = 0;
+	PoolVector<int>::Read r = p_indices.read();
+	for (int i = 0; i < p_indices.size(); i++) {
+		ERR_FAIL_INDEX_V(r[i], p_vertex_count, PoolVector<int>());
+		if (w[r[i]] == -1) {
+			w[r[i]] = next++;
+		}
+	}
+	for (int i = 0; i < p_vertex_count; i++) {
+		if (w[i] == -1) {
+			w[i] = next++;
+		}
+	}
+
+	return remap;
+}
+
 void SurfaceTool::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("begin", "primitive"), &SurfaceTool::begin);
@@ -140,6 +140,14 @@ public:
 	void append_from(const Ref<Mesh> &p_existing, int p_surface, const Transform &p_xform);
 	Ref<ArrayMesh> commit(const Ref<ArrayMesh> &p_existing = Ref<ArrayMesh>(), uint32_t p_flags = Mesh::ARRAY_COMPRESS_DEFAULT);
 
+	static PoolVector<int> simplify_indices(const PoolVector<Vector3> &p_vertices, const PoolVector<int> &p_indices, int p_target_index_count, float p_max_error, float *r_error = NULL);
+
+	//triangle orders for post transform cache reuse (Forsyth) and for less overdraw (Tipsify style cluster sort, allowed to lose up to p_threshold of cache efficiency)
+	static PoolVector<int> optimize_indices_for_cache(const PoolVector<int> &p_indices, int p_vertex_count);
+	static PoolVector<int> optimize_indices_for_overdraw(const PoolVector<Vector3> &p_vertices, const PoolVector<int> &p_indices, float p_threshold = 1.05);
+	//old vertex index to new vertex index, placing vertices in the order the indices first fetch them
+	static PoolVector<int> optimize_vertex_fetch_remap(const PoolVector<int> &p_indices, int p_vertex_count);
+
 	SurfaceTool();
 };
 
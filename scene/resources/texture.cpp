@@ -31,9 +31,13 @@
 #include "texture.h"
 
 #include "core/core_string_names.h"
+#include "core/engine.h"
 #include "core/io/image_loader.h"
 #include "core/method_bind_ext.gen.inc"
+#include "core/message_queue.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
+#include "core/project_settings.h"
 #include "mesh.h"
 #include "scene/resources/bit_map.h"
 #include "servers/camera/camera_feed.h"
@@ -288,6 +292,14 @@ RID ImageTexture::get_rid() const {
 	return texture;
 }
 
+uint64_t ImageTexture::get_memory_usage() const {
+
+	if (w == 0 || h == 0) {
+		return 0;
+	}
+	return Image::get_image_data_size(w, h, format, flags & FLAG_MIPMAPS);
+}
+
 bool ImageTexture::has_alpha() const {
 
 	return (format == Image::FORMAT_LA8 || format == Image::FORMAT_RGBA8);
@@ -548,6 +560,13 @@ Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_
 		VS::get_singleton()->texture_set_detect_normal_callback(texture, NULL, NULL);
 	}
 #endif
+
+	return _load_image(f, df, tw, th, image, p_size_limit);
+}
+
+//reads the mipmaps stored after the header and closes f, only mipmaps fitting p_size_limit are read when the texture was imported for streaming
+Error StreamTexture::_load_image(FileAccess *f, uint32_t df, int tw, int th, Ref<Image> &image, int p_size_limit) {
+
 	if (!(df & FORMAT_BIT_STREAM)) {
 		p_size_limit = 0;
 	}
@@ -714,12 +733,86 @@ Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_
 	return ERR_BUG; //unreachable
 }
 
+Error StreamTexture::_load_stream_image(const String &p_path, int p_size_limit, Ref<Image> &image) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V(!f, ERR_CANT_OPEN);
+
+	uint8_t header[4];
+	f->get_buffer(header, 4);
+	if (header[0] != 'G' || header[1] != 'D' || header[2] != 'S' || header[3] != 'T') {
+		memdelete(f);
+		ERR_FAIL_V(ERR_FILE_CORRUPT);
+	}
+
+	int tw = f->get_16();
+	f->get_16();
+	int th = f->get_16();
+	f->get_16();
+	f->get_32(); //texture flags
+	uint32_t df = f->get_32();
+
+	return _load_image(f, df, tw, th, image, p_size_limit);
+}
+
+struct StreamTextureRequest {
+	ObjectID texture;
+	String path;
+	int size_limit;
+	int mipmap;
+};
+
+void StreamTexture::_requested_stream(void *p_ud, int p_mipmap) {
+
+	//called by the renderer, the mipmaps are read on a worker and handed back on the main thread
+	StreamTexture *st = (StreamTexture *)p_ud;
+
+	StreamTextureRequest *request = memnew(StreamTextureRequest);
+	request->texture = st->get_instance_id();
+	request->path = st->path_to_file;
+	request->size_limit = MAX(MAX(st->stream_width >> p_mipmap, 1), MAX(st->stream_height >> p_mipmap, 1));
+	request->mipmap = p_mipmap;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	pool->release_task(pool->add_native_task(&StreamTexture::_stream_task, request));
+}
+
+void StreamTexture::_stream_task(void *p_userdata, uint32_t) {
+
+	StreamTextureRequest *request = (StreamTextureRequest *)p_userdata;
+
+	Ref<Image> image;
+	image.instance();
+	if (_load_stream_image(request->path, request->size_limit, image) == OK) {
+		MessageQueue::get_singleton()->push_call(request->texture, "_stream_loaded", image, request->mipmap);
+	}
+
+	memdelete(request);
+}
+
+void StreamTexture::_stream_loaded(const Ref<Image> &p_image, int p_mipmap) {
+
+	if (stream_mipmap < 0) {
+		return; //reloaded without streaming since the request was made
+	}
+
+	VS::get_singleton()->texture_set_stream_data(texture, p_image, p_mipmap);
+	stream_mipmap = p_mipmap;
+}
+
 Error StreamTexture::load(const String &p_path) {
 
 	int lw, lh, lwc, lhc, lflags;
 	Ref<Image> image;
 	image.instance();
-	Error err = _load_data(p_path, lw, lh, lwc, lhc, lflags, image);
+
+	//textures imported for streaming only load their small mipmaps here, the renderer asks for the rest when drawing them
+	int size_limit = 0;
+	if (GLOBAL_GET("rendering/texture_streaming/enabled") && !Engine::get_singleton()->is_editor_hint()) {
+		size_limit = GLOBAL_GET("rendering/texture_streaming/min_resident_size");
+	}
+
+	Error err = _load_data(p_path, lw, lh, lwc, lhc, lflags, image, size_limit);
 	if (err)
 		return err;
 
@@ -727,8 +820,28 @@ Error StreamTexture::load(const String &p_path) {
 		//temporarily set path if no path set for resource, helps find errors
 		VisualServer::get_singleton()->texture_set_path(texture, p_path);
 	}
-	VS::get_singleton()->texture_allocate(texture, image->get_width(), image->get_height(), 0, image->get_format(), VS::TEXTURE_TYPE_2D, lflags);
-	VS::get_singleton()->texture_set_data(texture, image);
+
+	int mipmap = 0;
+	while (MAX(lw >> mipmap, 1) > image->get_width() || MAX(lh >> mipmap, 1) > image->get_height()) {
+		mipmap++;
+	}
+
+	path_to_file = p_path;
+
+	if (mipmap > 0 && image->has_mipmaps() && (lflags & FLAG_MIPMAPS)) {
+		stream_width = lw;
+		stream_height = lh;
+		stream_mipmap = mipmap;
+		VS::get_singleton()->texture_allocate(texture, lw, lh, 0, image->get_format(), VS::TEXTURE_TYPE_2D, lflags);
+		VS::get_singleton()->texture_set_stream_data(texture, image, mipmap);
+		VS::get_singleton()->texture_set_stream_callback(texture, _requested_stream, this);
+	} else {
+		stream_mipmap = -1;
+		VS::get_singleton()->texture_set_stream_callback(texture, NULL, NULL);
+		VS::get_singleton()->texture_allocate(texture, image->get_width(), image->get_height(), 0, image->get_format(), VS::TEXTURE_TYPE_2D, lflags);
+		VS::get_singleton()->texture_set_data(texture, image);
+	}
+
 	if (lwc || lhc) {
 		VS::get_singleton()->texture_set_size_override(texture, lwc, lhc, 0);
 	} else {
@@ -737,7 +850,6 @@ Error StreamTexture::load(const String &p_path) {
 	w = lwc ? lwc : lw;
 	h = lhc ? lhc : lh;
 	flags = lflags;
-	path_to_file = p_path;
 	format = image->get_format();
 
 	_change_notify();
@@ -762,6 +874,14 @@ RID StreamTexture::get_rid() const {
 	return texture;
 }
 
+uint64_t StreamTexture::get_memory_usage() const {
+
+	if (w == 0 || h == 0) {
+		return 0;
+	}
+	return Image::get_image_data_size(w, h, format, flags & FLAG_MIPMAPS);
+}
+
 void StreamTexture::draw(RID p_canvas_item, const Point2 &p_pos, const Color &p_modulate, bool p_transpose, const Ref<Texture> &p_normal_map) const {
 
 	if ((w | h) == 0)
@@ -791,6 +911,14 @@ bool StreamTexture::has_alpha() const {
 
 Ref<Image> StreamTexture::get_data() const {
 
+	if (stream_mipmap > 0) {
+		//only part of the chain is on the GPU, read the whole image back from the file
+		Ref<Image> image;
+		image.instance();
+		ERR_FAIL_COND_V(_load_stream_image(path_to_file, 0, image) != OK, Ref<Image>());
+		return image;
+	}
+
 	return VS::get_singleton()->texture_get_data(texture);
 }
 
@@ -860,6 +988,7 @@ void StreamTexture::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("load", "path"), &StreamTexture::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &StreamTexture::get_load_path);
+	ClassDB::bind_method(D_METHOD("_stream_loaded", "image", "mipmap"), &StreamTexture::_stream_loaded);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.stex"), "load", "get_load_path");
 }
@@ -870,6 +999,9 @@ StreamTexture::StreamTexture() {
 	flags = 0;
 	w = 0;
 	h = 0;
+	stream_width = 0;
+	stream_height = 0;
+	stream_mipmap = -1;
 
 	texture = VS::get_singleton()->texture_create();
 }
@@ -2291,6 +2423,14 @@ RID TextureLayered::get_rid() const {
 	return texture;
 }
 
+uint64_t TextureLayered::get_memory_usage() const {
+
+	if (width == 0 || height == 0) {
+		return 0;
+	}
+	return uint64_t(Image::get_image_data_size(width, height, format, flags & FLAG_MIPMAPS)) * depth;
+}
+
 void TextureLayered::set_path(const String &p_path, bool p_take_over) {
 	if (texture.is_valid()) {
 		VS::get_singleton()->texture_set_path(texture, p_path);
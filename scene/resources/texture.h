@@ -33,6 +33,7 @@
 
 #include "core/io/resource_loader.h"
 #include "core/math/rect2.h"
+#include "core/os/file_access.h"
 #include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
 #include "core/os/thread_safe.h"
@@ -141,6 +142,7 @@ public:
 	int get_height() const;
 
 	virtual RID get_rid() const;
+	virtual uint64_t get_memory_usage() const;
 
 	bool has_alpha() const;
 	virtual void draw(RID p_canvas_item, const Point2 &p_pos, const Color &p_modulate = Color(1, 1, 1), bool p_transpose = false, const Ref<Texture> &p_normal_map = Ref<Texture>()) const;
@@ -186,6 +188,8 @@ public:
 
 private:
 	Error _load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, int &flags, Ref<Image> &image, int p_size_limit = 0);
+	static Error _load_image(FileAccess *f, uint32_t df, int tw, int th, Ref<Image> &image, int p_size_limit);
+	static Error _load_stream_image(const String &p_path, int p_size_limit, Ref<Image> &image);
 	String path_to_file;
 	RID texture;
 	Image::Format format;
@@ -193,6 +197,13 @@ private:
 	int w, h;
 	mutable Ref<BitMap> alpha_cache;
 
+	int stream_width, stream_height;
+	int stream_mipmap; //first mipmap on the GPU when streaming, -1 if the texture is not streamed
+
+	static void _requested_stream(void *p_ud, int p_mipmap);
+	static void _stream_task(void *p_userdata, uint32_t p_index);
+	void _stream_loaded(const Ref<Image> &p_image, int p_mipmap);
+
 	virtual void reload_from_file();
 
 	static void _requested_3d(void *p_ud);
@@ -218,6 +229,7 @@ public:
 	int get_width() const;
 	int get_height() const;
 	virtual RID get_rid() const;
+	virtual uint64_t get_memory_usage() const;
 
 	virtual void set_path(const String &p_path, bool p_take_over);
 
@@ -508,6 +520,7 @@ public:
 	void set_data_partial(const Ref<Image> &p_image, int p_x_ofs, int p_y_ofs, int p_z, int p_mipmap = 0);
 
 	virtual RID get_rid() const;
+	virtual uint64_t get_memory_usage() const;
 	virtual void set_path(const String &p_path, bool p_take_over = false);
 
 	TextureLayered(bool p_3d = false);
@@ -37,6 +37,12 @@ void Theme::_emit_theme_changed() {
 	emit_changed();
 }
 
+void Theme::_items_changed() {
+
+	change_version++;
+	emit_changed();
+}
+
 PoolVector<String> Theme::_get_icon_list(const String &p_type) const {
 
 	PoolVector<String> ilret;
@@ -312,7 +318,7 @@ void Theme::set_default_theme_font(const Ref<Font> &p_default_font) {
 	}
 
 	_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 Ref<Font> Theme::get_default_theme_font() const {
@@ -325,6 +331,7 @@ Ref<Theme> Theme::default_theme;
 Ref<Texture> Theme::default_icon;
 Ref<StyleBox> Theme::default_style;
 Ref<Font> Theme::default_font;
+uint32_t Theme::change_version = 1;
 
 Ref<Theme> Theme::get_default() {
 
@@ -334,6 +341,7 @@ Ref<Theme> Theme::get_default() {
 void Theme::set_default(const Ref<Theme> &p_default) {
 
 	default_theme = p_default;
+	change_version++;
 }
 
 Ref<Theme> Theme::get_project_default() {
@@ -344,19 +352,23 @@ Ref<Theme> Theme::get_project_default() {
 void Theme::set_project_default(const Ref<Theme> &p_project_default) {
 
 	project_default_theme = p_project_default;
+	change_version++;
 }
 
 void Theme::set_default_icon(const Ref<Texture> &p_icon) {
 
 	default_icon = p_icon;
+	change_version++;
 }
 void Theme::set_default_style(const Ref<StyleBox> &p_style) {
 
 	default_style = p_style;
+	change_version++;
 }
 void Theme::set_default_font(const Ref<Font> &p_font) {
 
 	default_font = p_font;
+	change_version++;
 }
 
 void Theme::set_icon(const StringName &p_name, const StringName &p_type, const Ref<Texture> &p_icon) {
@@ -377,7 +389,7 @@ void Theme::set_icon(const StringName &p_name, const StringName &p_type, const R
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_items_changed();
 	}
 }
 Ref<Texture> Theme::get_icon(const StringName &p_name, const StringName &p_type) const {
@@ -407,7 +419,7 @@ void Theme::clear_icon(const StringName &p_name, const StringName &p_type) {
 	icon_map[p_type].erase(p_name);
 
 	_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 void Theme::get_icon_list(StringName p_type, List<StringName> *p_list) const {
@@ -432,7 +444,7 @@ void Theme::set_shader(const StringName &p_name, const StringName &p_type, const
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_items_changed();
 	}
 }
 
@@ -454,7 +466,7 @@ void Theme::clear_shader(const StringName &p_name, const StringName &p_type) {
 
 	shader_map[p_type].erase(p_name);
 	_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 void Theme::get_shader_list(const StringName &p_type, List<StringName> *p_list) const {
@@ -490,7 +502,7 @@ void Theme::set_stylebox(const StringName &p_name, const StringName &p_type, con
 
 	if (new_value)
 		_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 Ref<StyleBox> Theme::get_stylebox(const StringName &p_name, const StringName &p_type) const {
@@ -520,7 +532,7 @@ void Theme::clear_stylebox(const StringName &p_name, const StringName &p_type) {
 	style_map[p_type].erase(p_name);
 
 	_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 void Theme::get_stylebox_list(StringName p_type, List<StringName> *p_list) const {
@@ -565,7 +577,7 @@ void Theme::set_font(const StringName &p_name, const StringName &p_type, const R
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_items_changed();
 	}
 }
 Ref<Font> Theme::get_font(const StringName &p_name, const StringName &p_type) const {
@@ -594,7 +606,7 @@ void Theme::clear_font(const StringName &p_name, const StringName &p_type) {
 
 	font_map[p_type].erase(p_name);
 	_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 void Theme::get_font_list(StringName p_type, List<StringName> *p_list) const {
@@ -620,7 +632,7 @@ void Theme::set_color(const StringName &p_name, const StringName &p_type, const
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_items_changed();
 	}
 }
 
@@ -644,7 +656,7 @@ void Theme::clear_color(const StringName &p_name, const StringName &p_type) {
 
 	color_map[p_type].erase(p_name);
 	_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 void Theme::get_color_list(StringName p_type, List<StringName> *p_list) const {
@@ -669,7 +681,7 @@ void Theme::set_constant(const StringName &p_name, const StringName &p_type, int
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_items_changed();
 	}
 }
 
@@ -694,7 +706,7 @@ void Theme::clear_constant(const StringName &p_name, const StringName &p_type) {
 
 	constant_map[p_type].erase(p_name);
 	_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 void Theme::get_constant_list(StringName p_type, List<StringName> *p_list) const {
@@ -762,7 +774,7 @@ void Theme::clear() {
 	constant_map.clear();
 
 	_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 void Theme::copy_default_theme() {
@@ -817,7 +829,7 @@ void Theme::copy_theme(const Ref<Theme> &p_other) {
 	shader_map = p_other->shader_map;
 
 	_change_notify();
-	emit_changed();
+	_items_changed();
 }
 
 void Theme::get_type_list(List<StringName> *p_list) const {
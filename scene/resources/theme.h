@@ -44,6 +44,7 @@ class Theme : public Resource {
 	RES_BASE_EXTENSION("theme");
 
 	void _emit_theme_changed();
+	void _items_changed();
 
 	HashMap<StringName, HashMap<StringName, Ref<Texture> > > icon_map;
 	HashMap<StringName, HashMap<StringName, Ref<StyleBox> > > style_map;
@@ -71,11 +72,15 @@ protected:
 	static Ref<StyleBox> default_style;
 	static Ref<Font> default_font;
 
+	static uint32_t change_version; //bumped whenever an item is added, removed or replaced in any theme
+
 	Ref<Font> default_theme_font;
 
 	static void _bind_methods();
 
 public:
+	static uint32_t get_change_version() { return change_version; }
+
 	static Ref<Theme> get_default();
 	static void set_default(const Ref<Theme> &p_default);
 
@@ -30,76 +30,43 @@
 
 #include "world.h"
 
-#include "core/math/camera_matrix.h"
-#include "core/math/octree.h"
 #include "scene/3d/camera.h"
 #include "scene/3d/visibility_notifier.h"
 #include "scene/scene_string_names.h"
 
 struct SpatialIndexer {
 
-	Octree<VisibilityNotifier> octree;
+	//visibility itself is computed by VisualServer while culling each rendered camera, this only dispatches its events
 
-	struct NotifierData {
+	Set<VisibilityNotifier *> notifiers;
 
-		AABB aabb;
-		OctreeElementID id;
-	};
+	Map<RID, Camera *> cameras; //current cameras, by their server camera
 
-	Map<VisibilityNotifier *, NotifierData> notifiers;
-	struct CameraData {
+	//what each server camera saw last, kept even while its node is not current so it can be restored
+	Map<RID, Set<VisibilityNotifier *> > visible;
 
-		Map<VisibilityNotifier *, uint64_t> notifiers;
-	};
-
-	Map<Camera *, CameraData> cameras;
-
-	enum {
-		VISIBILITY_CULL_MAX = 32768
-	};
-
-	Vector<VisibilityNotifier *> cull;
-
-	bool changed;
-	uint64_t pass;
 	uint64_t last_frame;
 
-	void _notifier_add(VisibilityNotifier *p_notifier, const AABB &p_rect) {
+	void _notifier_add(VisibilityNotifier *p_notifier) {
 
 		ERR_FAIL_COND(notifiers.has(p_notifier));
-		notifiers[p_notifier].aabb = p_rect;
-		notifiers[p_notifier].id = octree.create(p_notifier, p_rect);
-		changed = true;
-	}
-
-	void _notifier_update(VisibilityNotifier *p_notifier, const AABB &p_rect) {
-
-		Map<VisibilityNotifier *, NotifierData>::Element *E = notifiers.find(p_notifier);
-		ERR_FAIL_COND(!E);
-		if (E->get().aabb == p_rect)
-			return;
-
-		E->get().aabb = p_rect;
-		octree.move(E->get().id, E->get().aabb);
-		changed = true;
+		notifiers.insert(p_notifier);
 	}
 
 	void _notifier_remove(VisibilityNotifier *p_notifier) {
 
-		Map<VisibilityNotifier *, NotifierData>::Element *E = notifiers.find(p_notifier);
-		ERR_FAIL_COND(!E);
-
-		octree.erase(E->get().id);
+		ERR_FAIL_COND(!notifiers.has(p_notifier));
 		notifiers.erase(p_notifier);
 
 		List<Camera *> removed;
-		for (Map<Camera *, CameraData>::Element *F = cameras.front(); F; F = F->next()) {
+		for (Map<RID, Set<VisibilityNotifier *> >::Element *E = visible.front(); E; E = E->next()) {
 
-			Map<VisibilityNotifier *, uint64_t>::Element *G = F->get().notifiers.find(p_notifier);
+			if (!E->get().erase(p_notifier))
+				continue;
 
-			if (G) {
-				F->get().notifiers.erase(G);
-				removed.push_back(F->key());
+			Map<RID, Camera *>::Element *C = cameras.find(E->key());
+			if (C) {
+				removed.push_back(C->get());
 			}
 		}
 
@@ -108,105 +75,91 @@ struct SpatialIndexer {
 			p_notifier->_exit_camera(removed.front()->get());
 			removed.pop_front();
 		}
-
-		changed = true;
 	}
 
 	void _add_camera(Camera *p_camera) {
 
-		ERR_FAIL_COND(cameras.has(p_camera));
-		CameraData vd;
-		cameras[p_camera] = vd;
-		changed = true;
+		RID rid = p_camera->get_camera();
+		ERR_FAIL_COND(cameras.has(rid));
+		cameras[rid] = p_camera;
+
+		Map<RID, Set<VisibilityNotifier *> >::Element *E = visible.find(rid);
+		if (!E)
+			return;
+
+		for (Set<VisibilityNotifier *>::Element *F = E->get().front(); F; F = F->next()) {
+			F->get()->_enter_camera(p_camera);
+		}
 	}
 
 	void _update_camera(Camera *p_camera) {
 
-		Map<Camera *, CameraData>::Element *E = cameras.find(p_camera);
-		ERR_FAIL_COND(!E);
-		changed = true;
+		ERR_FAIL_COND(!cameras.has(p_camera->get_camera()));
 	}
 
 	void _remove_camera(Camera *p_camera) {
-		ERR_FAIL_COND(!cameras.has(p_camera));
-		List<VisibilityNotifier *> removed;
-		for (Map<VisibilityNotifier *, uint64_t>::Element *E = cameras[p_camera].notifiers.front(); E; E = E->next()) {
 
-			removed.push_back(E->key());
-		}
+		RID rid = p_camera->get_camera();
+		ERR_FAIL_COND(!cameras.has(rid));
+		cameras.erase(rid);
 
-		while (!removed.empty()) {
-			removed.front()->get()->_exit_camera(p_camera);
-			removed.pop_front();
-		}
+		Map<RID, Set<VisibilityNotifier *> >::Element *E = visible.find(rid);
+		if (!E)
+			return;
 
-		cameras.erase(p_camera);
+		for (Set<VisibilityNotifier *>::Element *F = E->get().front(); F; F = F->next()) {
+			F->get()->_exit_camera(p_camera);
+		}
 	}
 
-	void _update(uint64_t p_frame) {
+	void _update(RID p_scenario, uint64_t p_frame) {
 
 		if (p_frame == last_frame)
 			return;
 		last_frame = p_frame;
 
-		if (!changed)
-			return;
-
-		for (Map<Camera *, CameraData>::Element *E = cameras.front(); E; E = E->next()) {
-
-			pass++;
+		//everything that changed during the last draw comes in a single batch
+		Vector<VS::VisibilityNotifierEvent> events = VS::get_singleton()->scenario_get_visibility_notifier_events(p_scenario);
 
-			Camera *c = E->key();
+		for (int i = 0; i < events.size(); i++) {
 
-			Vector<Plane> planes = c->get_frustum();
+			const VS::VisibilityNotifierEvent &event = events[i];
 
-			int culled = octree.cull_convex(planes, cull.ptrw(), cull.size());
+			VisibilityNotifier *notifier = Object::cast_to<VisibilityNotifier>(ObjectDB::get_instance(event.notifier));
+			if (!notifier || !notifiers.has(notifier))
+				continue; //gone, or left this world before the event was read
 
-			VisibilityNotifier **ptr = cull.ptrw();
+			Map<RID, Camera *>::Element *C = cameras.find(event.camera);
 
-			List<VisibilityNotifier *> added;
-			List<VisibilityNotifier *> removed;
+			if (event.entered) {
 
-			for (int i = 0; i < culled; i++) {
+				Set<VisibilityNotifier *> &camera_visible = visible[event.camera];
+				if (camera_visible.has(notifier))
+					continue;
+				camera_visible.insert(notifier);
 
-				//notifiers in frustum
-
-				Map<VisibilityNotifier *, uint64_t>::Element *H = E->get().notifiers.find(ptr[i]);
-				if (!H) {
-
-					E->get().notifiers.insert(ptr[i], pass);
-					added.push_back(ptr[i]);
-				} else {
-					H->get() = pass;
+				if (C) {
+					notifier->_enter_camera(C->get());
 				}
-			}
+			} else {
 
-			for (Map<VisibilityNotifier *, uint64_t>::Element *F = E->get().notifiers.front(); F; F = F->next()) {
-
-				if (F->get() != pass)
-					removed.push_back(F->key());
-			}
-
-			while (!added.empty()) {
-				added.front()->get()->_enter_camera(E->key());
-				added.pop_front();
-			}
+				Map<RID, Set<VisibilityNotifier *> >::Element *E = visible.find(event.camera);
+				if (!E || !E->get().erase(notifier))
+					continue;
+				if (E->get().empty()) {
+					visible.erase(E);
+				}
 
-			while (!removed.empty()) {
-				E->get().notifiers.erase(removed.front()->get());
-				removed.front()->get()->_exit_camera(E->key());
-				removed.pop_front();
+				if (C) {
+					notifier->_exit_camera(C->get());
+				}
 			}
 		}
-		changed = false;
 	}
 
 	SpatialIndexer() {
 
-		pass = 0;
 		last_frame = 0;
-		changed = false;
-		cull.resize(VISIBILITY_CULL_MAX);
 	}
 };
 
@@ -230,17 +183,10 @@ void World::_remove_camera(Camera *p_camera) {
 #endif
 }
 
-void World::_register_notifier(VisibilityNotifier *p_notifier, const AABB &p_rect) {
-
-#ifndef _3D_DISABLED
-	indexer->_notifier_add(p_notifier, p_rect);
-#endif
-}
-
-void World::_update_notifier(VisibilityNotifier *p_notifier, const AABB &p_rect) {
+void World::_register_notifier(VisibilityNotifier *p_notifier) {
 
 #ifndef _3D_DISABLED
-	indexer->_notifier_update(p_notifier, p_rect);
+	indexer->_notifier_add(p_notifier);
 #endif
 }
 
@@ -254,7 +200,7 @@ void World::_remove_notifier(VisibilityNotifier *p_notifier) {
 void World::_update(uint64_t p_frame) {
 
 #ifndef _3D_DISABLED
-	indexer->_update(p_frame);
+	indexer->_update(scenario, p_frame);
 #endif
 }
 
@@ -312,8 +258,8 @@ PhysicsDirectSpaceState *World::get_direct_space_state() {
 
 void World::get_camera_list(List<Camera *> *r_cameras) {
 
-	for (Map<Camera *, SpatialIndexer::CameraData>::Element *E = indexer->cameras.front(); E; E = E->next()) {
-		r_cameras->push_back(E->key());
+	for (Map<RID, Camera *>::Element *E = indexer->cameras.front(); E; E = E->next()) {
+		r_cameras->push_back(E->get());
 	}
 }
 
@@ -0,0 +1,239 @@
+/*************************************************************************/
+/*  audio_mix.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "audio_mix.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_MIX_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define AUDIO_MIX_NEON
+#include <arm_neon.h>
+#endif
+
+// AudioFrame arrays are read and written as packed floats, two frames per vector.
+#define AUDIO_MIX_FLOATS(m_frames, m_idx) (&(m_frames)[m_idx].l)
+
+void AudioMix::add(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames) {
+
+	int i = 0;
+#if defined(AUDIO_MIX_SSE2)
+	for (; i + 4 <= p_frames; i += 4) {
+		__m128 a = _mm_add_ps(_mm_loadu_ps(AUDIO_MIX_FLOATS(p_dst, i)), _mm_loadu_ps(AUDIO_MIX_FLOATS(p_src, i)));
+		__m128 b = _mm_add_ps(_mm_loadu_ps(AUDIO_MIX_FLOATS(p_dst, i + 2)), _mm_loadu_ps(AUDIO_MIX_FLOATS(p_src, i + 2)));
+		_mm_storeu_ps(AUDIO_MIX_FLOATS(p_dst, i), a);
+		_mm_storeu_ps(AUDIO_MIX_FLOATS(p_dst, i + 2), b);
+	}
+#elif defined(AUDIO_MIX_NEON)
+	for (; i + 4 <= p_frames; i += 4) {
+		float32x4_t a = vaddq_f32(vld1q_f32(AUDIO_MIX_FLOATS(p_dst, i)), vld1q_f32(AUDIO_MIX_FLOATS(p_src, i)));
+		float32x4_t b = vaddq_f32(vld1q_f32(AUDIO_MIX_FLOATS(p_dst, i + 2)), vld1q_f32(AUDIO_MIX_FLOATS(p_src, i + 2)));
+		vst1q_f32(AUDIO_MIX_FLOATS(p_dst, i), a);
+		vst1q_f32(AUDIO_MIX_FLOATS(p_dst, i + 2), b);
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i];
+	}
+}
+
+void AudioMix::add_ramp(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, const AudioFrame &p_vol, const AudioFrame &p_vol_inc) {
+
+	AudioFrame vol = p_vol;
+	int i = 0;
+#if defined(AUDIO_MIX_SSE2) || defined(AUDIO_MIX_NEON)
+	if (p_frames >= 2) {
+		float v[4] = { vol.l, vol.r, vol.l + p_vol_inc.l, vol.r + p_vol_inc.r };
+		float inc[4] = { p_vol_inc.l * 2, p_vol_inc.r * 2, p_vol_inc.l * 2, p_vol_inc.r * 2 };
+#if defined(AUDIO_MIX_SSE2)
+		__m128 vv = _mm_loadu_ps(v);
+		__m128 vinc = _mm_loadu_ps(inc);
+		for (; i + 2 <= p_frames; i += 2) {
+			__m128 d = _mm_add_ps(_mm_loadu_ps(AUDIO_MIX_FLOATS(p_dst, i)), _mm_mul_ps(_mm_loadu_ps(AUDIO_MIX_FLOATS(p_src, i)), vv));
+			_mm_storeu_ps(AUDIO_MIX_FLOATS(p_dst, i), d);
+			vv = _mm_add_ps(vv, vinc);
+		}
+		_mm_storeu_ps(v, vv);
+#else
+		float32x4_t vv = vld1q_f32(v);
+		float32x4_t vinc = vld1q_f32(inc);
+		for (; i + 2 <= p_frames; i += 2) {
+			float32x4_t d = vmlaq_f32(vld1q_f32(AUDIO_MIX_FLOATS(p_dst, i)), vld1q_f32(AUDIO_MIX_FLOATS(p_src, i)), vv);
+			vst1q_f32(AUDIO_MIX_FLOATS(p_dst, i), d);
+			vv = vaddq_f32(vv, vinc);
+		}
+		vst1q_f32(v, vv);
+#endif
+		vol = AudioFrame(v[0], v[1]);
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i] * vol;
+		vol += p_vol_inc;
+	}
+}
+
+void AudioMix::scale_ramp(AudioFrame *p_buffer, int p_frames, float p_vol, float p_vol_inc) {
+
+	float vol = p_vol;
+	int i = 0;
+#if defined(AUDIO_MIX_SSE2) || defined(AUDIO_MIX_NEON)
+	if (p_frames >= 2) {
+		float v[4] = { vol, vol, vol + p_vol_inc, vol + p_vol_inc };
+#if defined(AUDIO_MIX_SSE2)
+		__m128 vv = _mm_loadu_ps(v);
+		__m128 vinc = _mm_set1_ps(p_vol_inc * 2);
+		for (; i + 2 <= p_frames; i += 2) {
+			_mm_storeu_ps(AUDIO_MIX_FLOATS(p_buffer, i), _mm_mul_ps(_mm_loadu_ps(AUDIO_MIX_FLOATS(p_buffer, i)), vv));
+			vv = _mm_add_ps(vv, vinc);
+		}
+		_mm_storeu_ps(v, vv);
+#else
+		float32x4_t vv = vld1q_f32(v);
+		float32x4_t vinc = vdupq_n_f32(p_vol_inc * 2);
+		for (; i + 2 <= p_frames; i += 2) {
+			vst1q_f32(AUDIO_MIX_FLOATS(p_buffer, i), vmulq_f32(vld1q_f32(AUDIO_MIX_FLOATS(p_buffer, i)), vv));
+			vv = vaddq_f32(vv, vinc);
+		}
+		vst1q_f32(v, vv);
+#endif
+		vol = v[0];
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_buffer[i] *= vol;
+		vol += p_vol_inc;
+	}
+}
+
+AudioFrame AudioMix::scale_peak(AudioFrame *p_buffer, int p_frames, float p_vol) {
+
+	AudioFrame peak = AudioFrame(0, 0);
+	int i = 0;
+#if defined(AUDIO_MIX_SSE2) || defined(AUDIO_MIX_NEON)
+	float p[4];
+#if defined(AUDIO_MIX_SSE2)
+	__m128 vv = _mm_set1_ps(p_vol);
+	__m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	__m128 vpeak = _mm_setzero_ps();
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 d = _mm_mul_ps(_mm_loadu_ps(AUDIO_MIX_FLOATS(p_buffer, i)), vv);
+		_mm_storeu_ps(AUDIO_MIX_FLOATS(p_buffer, i), d);
+		vpeak = _mm_max_ps(vpeak, _mm_and_ps(d, abs_mask));
+	}
+	_mm_storeu_ps(p, vpeak);
+#else
+	float32x4_t vv = vdupq_n_f32(p_vol);
+	float32x4_t vpeak = vdupq_n_f32(0);
+	for (; i + 2 <= p_frames; i += 2) {
+		float32x4_t d = vmulq_f32(vld1q_f32(AUDIO_MIX_FLOATS(p_buffer, i)), vv);
+		vst1q_f32(AUDIO_MIX_FLOATS(p_buffer, i), d);
+		vpeak = vmaxq_f32(vpeak, vabsq_f32(d));
+	}
+	vst1q_f32(p, vpeak);
+#endif
+	peak = AudioFrame(MAX(p[0], p[2]), MAX(p[1], p[3]));
+#endif
+	for (; i < p_frames; i++) {
+		p_buffer[i] *= p_vol;
+		peak.l = MAX(peak.l, ABS(p_buffer[i].l));
+		peak.r = MAX(peak.r, ABS(p_buffer[i].r));
+	}
+	return peak;
+}
+
+void AudioMix::resample_cubic(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, uint64_t &r_offset, uint64_t p_increment, int p_frac_bits) {
+
+	uint64_t offset = r_offset;
+	const uint64_t frac_mask = (uint64_t(1) << p_frac_bits) - 1;
+	const float frac_scale = 1.0f / float(uint64_t(1) << p_frac_bits);
+
+	int i = 0;
+#if defined(AUDIO_MIX_SSE2) || defined(AUDIO_MIX_NEON)
+	//two output frames per iteration, one in each half of the vectors
+	for (; i + 2 <= p_frames; i += 2) {
+
+		uint64_t offset_b = offset + p_increment;
+		const float *a = AUDIO_MIX_FLOATS(p_src, offset >> p_frac_bits);
+		const float *b = AUDIO_MIX_FLOATS(p_src, offset_b >> p_frac_bits);
+		float mu_a = (offset & frac_mask) * frac_scale;
+		float mu_b = (offset_b & frac_mask) * frac_scale;
+
+#if defined(AUDIO_MIX_SSE2)
+		__m128 a01 = _mm_loadu_ps(a);
+		__m128 a23 = _mm_loadu_ps(a + 4);
+		__m128 b01 = _mm_loadu_ps(b);
+		__m128 b23 = _mm_loadu_ps(b + 4);
+		__m128 y0 = _mm_movelh_ps(a01, b01);
+		__m128 y1 = _mm_movehl_ps(b01, a01);
+		__m128 y2 = _mm_movelh_ps(a23, b23);
+		__m128 y3 = _mm_movehl_ps(b23, a23);
+		__m128 mu = _mm_setr_ps(mu_a, mu_a, mu_b, mu_b);
+
+		__m128 a0 = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(y3, y2), y0), y1);
+		__m128 a1 = _mm_sub_ps(_mm_sub_ps(y0, y1), a0);
+		__m128 a2 = _mm_sub_ps(y2, y0);
+		__m128 res = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(a0, mu), a1), mu), a2), mu), y1);
+		_mm_storeu_ps(AUDIO_MIX_FLOATS(p_dst, i), res);
+#else
+		float32x4_t a01 = vld1q_f32(a);
+		float32x4_t a23 = vld1q_f32(a + 4);
+		float32x4_t b01 = vld1q_f32(b);
+		float32x4_t b23 = vld1q_f32(b + 4);
+		float32x4_t y0 = vcombine_f32(vget_low_f32(a01), vget_low_f32(b01));
+		float32x4_t y1 = vcombine_f32(vget_high_f32(a01), vget_high_f32(b01));
+		float32x4_t y2 = vcombine_f32(vget_low_f32(a23), vget_low_f32(b23));
+		float32x4_t y3 = vcombine_f32(vget_high_f32(a23), vget_high_f32(b23));
+		float32x4_t mu = vcombine_f32(vdup_n_f32(mu_a), vdup_n_f32(mu_b));
+
+		float32x4_t a0 = vaddq_f32(vsubq_f32(vsubq_f32(y3, y2), y0), y1);
+		float32x4_t a1 = vsubq_f32(vsubq_f32(y0, y1), a0);
+		float32x4_t a2 = vsubq_f32(y2, y0);
+		float32x4_t res = vmlaq_f32(y1, vmlaq_f32(a2, vmlaq_f32(a1, a0, mu), mu), mu);
+		vst1q_f32(AUDIO_MIX_FLOATS(p_dst, i), res);
+#endif
+		offset = offset_b + p_increment;
+	}
+#endif
+	for (; i < p_frames; i++) {
+
+		const AudioFrame *y = &p_src[offset >> p_frac_bits];
+		float mu = (offset & frac_mask) * frac_scale;
+
+		AudioFrame a0 = y[3] - y[2] - y[0] + y[1];
+		AudioFrame a1 = y[0] - y[1] - a0;
+		AudioFrame a2 = y[2] - y[0];
+
+		p_dst[i] = ((a0 * mu + a1) * mu + a2) * mu + y[1];
+		offset += p_increment;
+	}
+
+	r_offset = offset;
+}
@@ -0,0 +1,53 @@
+/*************************************************************************/
+/*  audio_mix.h                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef AUDIO_MIX_H
+#define AUDIO_MIX_H
+
+#include "core/math/audio_frame.h"
+
+// Mixing kernels shared by the audio server and the stream players.
+// They are vectorized with SSE2 or NEON where available, two frames at a time.
+class AudioMix {
+public:
+	// p_dst += p_src
+	static void add(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames);
+	// p_dst += p_src * vol, with vol starting at p_vol and moving by p_vol_inc every frame
+	static void add_ramp(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, const AudioFrame &p_vol, const AudioFrame &p_vol_inc);
+	// p_buffer *= vol, with vol starting at p_vol and moving by p_vol_inc every frame
+	static void scale_ramp(AudioFrame *p_buffer, int p_frames, float p_vol, float p_vol_inc);
+	// p_buffer *= p_vol, returns the absolute peak of each channel after scaling
+	static AudioFrame scale_peak(AudioFrame *p_buffer, int p_frames, float p_vol);
+	// Cubic interpolation of p_src at the fixed point position r_offset (p_frac_bits fractional bits), which moves by
+	// p_increment every frame. Frame n reads p_src[(r_offset >> p_frac_bits) + 0..3], the caller keeps that within bounds.
+	static void resample_cubic(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, uint64_t &r_offset, uint64_t p_increment, int p_frac_bits);
+};
+
+#endif // AUDIO_MIX_H
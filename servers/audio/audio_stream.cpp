@@ -32,6 +32,15 @@
 
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "servers/audio/audio_mix.h"
+
+//////////////////////////////
+
+void AudioStreamPlayback::skip(float p_time) {
+
+	//streams that can move on without seeking every mix should override this
+	seek(get_playback_position() + p_time);
+}
 
 //////////////////////////////
 
@@ -54,26 +63,20 @@ void AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale,
 
 	uint64_t mix_increment = uint64_t(((get_stream_sampling_rate() * p_rate_scale) / double(target_rate * global_rate_scale)) * double(FP_LEN));
 
-	for (int i = 0; i < p_frames; i++) {
+	int i = 0;
+	while (i < p_frames) {
+
+		//resample as many frames as the internal buffer still covers
+		int todo = p_frames - i;
+		if (mix_increment > 0) {
+			uint64_t left = (uint64_t(INTERNAL_BUFFER_LEN) << FP_BITS) - mix_offset;
+			todo = MIN(uint64_t(todo), (left + mix_increment - 1) / mix_increment);
+		}
 
-		uint32_t idx = CUBIC_INTERP_HISTORY + uint32_t(mix_offset >> FP_BITS);
 		//standard cubic interpolation (great quality/performance ratio)
 		//this used to be moved to a LUT for greater performance, but nowadays CPU speed is generally faster than memory.
-		float mu = (mix_offset & FP_MASK) / float(FP_LEN);
-		AudioFrame y0 = internal_buffer[idx - 3];
-		AudioFrame y1 = internal_buffer[idx - 2];
-		AudioFrame y2 = internal_buffer[idx - 1];
-		AudioFrame y3 = internal_buffer[idx - 0];
-
-		float mu2 = mu * mu;
-		AudioFrame a0 = y3 - y2 - y0 + y1;
-		AudioFrame a1 = y0 - y1 - a0;
-		AudioFrame a2 = y2 - y0;
-		AudioFrame a3 = y1;
-
-		p_buffer[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3);
-
-		mix_offset += mix_increment;
+		AudioMix::resample_cubic(p_buffer + i, internal_buffer + CUBIC_INTERP_HISTORY - 3, todo, mix_offset, mix_increment, FP_BITS);
+		i += todo;
 
 		while ((mix_offset >> FP_BITS) >= INTERNAL_BUFFER_LEN) {
 
@@ -354,6 +357,12 @@ void AudioStreamPlaybackRandomPitch::seek(float p_time) {
 	}
 }
 
+void AudioStreamPlaybackRandomPitch::skip(float p_time) {
+	if (playing.is_valid()) {
+		playing->skip(p_time * pitch_scale);
+	}
+}
+
 void AudioStreamPlaybackRandomPitch::mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) {
 	if (playing.is_valid()) {
 		playing->mix(p_buffer, p_rate_scale * pitch_scale, p_frames);
@@ -0,0 +1,360 @@
+/*************************************************************************/
+/*  audio_effect_convolution_reverb.cpp                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "audio_effect_convolution_reverb.h"
+#include "servers/audio/effects/fft.h"
+#include "servers/audio_server.h"
+
+// Uniformly partitioned convolution with overlap-save. Every partition of B frames is transformed with a 2B point FFT,
+// the left and right channels packed as the real and imaginary parts of one complex signal and split apart afterwards.
+// Spectra are stored planar, real parts of bins 0..B of the left then the right channel, followed by the imaginary parts.
+
+void AudioEffectConvolutionReverbInstance::_reset() {
+
+	impulse_version = base->impulse_version;
+	partition_size = base->impulse_partition_size;
+	partition_count = base->impulse_partitions;
+
+	int bins = (partition_size + 1) * 2;
+
+	input.resize(partition_size * 2);
+	output.resize(partition_size);
+	fft_buffer.resize(partition_size * 8);
+	history.resize(partition_count * bins * 2);
+	accum.resize(bins * 2);
+
+	AudioFrame *in = input.ptrw();
+	for (int i = 0; i < input.size(); i++) {
+		in[i] = AudioFrame(0, 0);
+	}
+	AudioFrame *out = output.ptrw();
+	for (int i = 0; i < output.size(); i++) {
+		out[i] = AudioFrame(0, 0);
+	}
+	float *h = history.ptrw();
+	for (int i = 0; i < history.size(); i++) {
+		h[i] = 0;
+	}
+
+	block_pos = 0;
+	history_pos = 0;
+}
+
+void AudioEffectConvolutionReverbInstance::_process_block() {
+
+	int b = partition_size;
+	int n = b * 2;
+	int bins = (b + 1) * 2;
+
+	//transform the last two blocks of input
+	float *fft = fft_buffer.ptrw();
+	const AudioFrame *in = input.ptr();
+	for (int i = 0; i < n; i++) {
+		fft[i * 2 + 0] = in[i].l;
+		fft[i * 2 + 1] = in[i].r;
+	}
+	smbFft(fft, n, -1);
+
+	//split the channels, this doubles both spectra which the impulse scale accounts for
+	float *x = history.ptrw() + history_pos * bins * 2;
+	for (int k = 0; k <= b; k++) {
+
+		int nk = (n - k) & (n - 1);
+		float ar = fft[k * 2 + 0];
+		float ai = fft[k * 2 + 1];
+		float br = fft[nk * 2 + 0];
+		float bi = -fft[nk * 2 + 1];
+
+		x[k] = ar + br;
+		x[bins + k] = ai + bi;
+		x[b + 1 + k] = ai - bi;
+		x[bins + b + 1 + k] = br - ar;
+	}
+
+	//multiply and accumulate every partition of the impulse with the input it lines up with
+	float *yr = accum.ptrw();
+	float *yi = yr + bins;
+	for (int k = 0; k < bins; k++) {
+		yr[k] = 0;
+		yi[k] = 0;
+	}
+
+	const float *h = base->impulse_spectrum.ptr();
+	for (int p = 0; p < partition_count; p++) {
+
+		int slot = history_pos - p;
+		if (slot < 0) {
+			slot += partition_count;
+		}
+
+		const float *xr = history.ptr() + slot * bins * 2;
+		const float *xi = xr + bins;
+		const float *hr = h + p * bins * 2;
+		const float *hi = hr + bins;
+
+		for (int k = 0; k < bins; k++) {
+			yr[k] += xr[k] * hr[k] - xi[k] * hi[k];
+			yi[k] += xr[k] * hi[k] + xi[k] * hr[k];
+		}
+	}
+
+	history_pos++;
+	if (history_pos == partition_count) {
+		history_pos = 0;
+	}
+
+	//pack both channels back as left + i * right and rebuild the mirrored half
+	for (int k = 0; k <= b; k++) {
+		fft[k * 2 + 0] = yr[k] - yi[b + 1 + k];
+		fft[k * 2 + 1] = yi[k] + yr[b + 1 + k];
+	}
+	for (int k = b + 1; k < n; k++) {
+		int m = n - k;
+		fft[k * 2 + 0] = yr[m] + yi[b + 1 + m];
+		fft[k * 2 + 1] = yr[b + 1 + m] - yi[m];
+	}
+	smbFft(fft, n, 1);
+
+	//only the second half is free of circular wrap-around
+	AudioFrame *out = output.ptrw();
+	for (int i = 0; i < b; i++) {
+		out[i] = AudioFrame(fft[(b + i) * 2 + 0], fft[(b + i) * 2 + 1]);
+	}
+
+	AudioFrame *inw = input.ptrw();
+	for (int i = 0; i < b; i++) {
+		inw[i] = inw[b + i];
+	}
+}
+
+void AudioEffectConvolutionReverbInstance::process(const AudioFrame *p_src_frames, AudioFrame *p_dst_frames, int p_frame_count) {
+
+	if (impulse_version != base->impulse_version) {
+		_reset();
+	}
+
+	float dry = base->dry;
+	float wet = base->wet;
+
+	if (partition_count == 0) {
+		for (int i = 0; i < p_frame_count; i++) {
+			p_dst_frames[i] = p_src_frames[i] * dry;
+		}
+		return;
+	}
+
+	//the wet signal comes out one partition late
+	for (int i = 0; i < p_frame_count; i++) {
+
+		p_dst_frames[i] = p_src_frames[i] * dry + output[block_pos] * wet;
+		input.write[partition_size + block_pos] = p_src_frames[i];
+
+		block_pos++;
+		if (block_pos == partition_size) {
+			_process_block();
+			block_pos = 0;
+		}
+	}
+}
+
+AudioEffectConvolutionReverbInstance::AudioEffectConvolutionReverbInstance() {
+
+	impulse_version = 0;
+	partition_size = 0;
+	partition_count = 0;
+	block_pos = 0;
+	history_pos = 0;
+}
+
+int AudioEffectConvolutionReverb::get_partition_frames(PartitionSize p_size) {
+
+	static const int partition_frames[PARTITION_SIZE_MAX] = { 256, 512, 1024, 2048 };
+	ERR_FAIL_INDEX_V(p_size, PARTITION_SIZE_MAX, 0);
+	return partition_frames[p_size];
+}
+
+void AudioEffectConvolutionReverb::_update_impulse() {
+
+	int b = get_partition_frames(partition_size);
+	int n = b * 2;
+	int bins = (b + 1) * 2;
+
+	Vector<float> spectrum;
+	int partitions = 0;
+
+	Vector<AudioFrame> frames;
+	if (impulse.is_valid() && impulse->get_length() > 0) {
+
+		//let the sample playback convert whatever format and rate the impulse has to the mix rate
+		Ref<AudioStreamPlayback> playback = impulse->instance_playback();
+		int frame_count = int(impulse->get_length() * AudioServer::get_singleton()->get_mix_rate());
+		if (playback.is_valid() && frame_count > 0) {
+			frames.resize(frame_count);
+			playback->start();
+			playback->mix(frames.ptrw(), 1.0, frame_count);
+			partitions = (frame_count + b - 1) / b;
+		}
+	}
+
+	if (partitions) {
+
+		spectrum.resize(partitions * bins * 2);
+		float *s = spectrum.ptrw();
+
+		Vector<float> fft_buffer;
+		fft_buffer.resize(n * 2);
+		float *fft = fft_buffer.ptrw();
+
+		//halves the doubled split of the input spectra and normalizes the inverse transform
+		float scale = 0.5 / n;
+
+		for (int p = 0; p < partitions; p++) {
+
+			for (int i = 0; i < n; i++) {
+				int idx = p * b + i;
+				bool inside = i < b && idx < frames.size();
+				fft[i * 2 + 0] = inside ? frames[idx].l : 0;
+				fft[i * 2 + 1] = inside ? frames[idx].r : 0;
+			}
+			smbFft(fft, n, -1);
+
+			float *hr = s + p * bins * 2;
+			float *hi = hr + bins;
+			for (int k = 0; k <= b; k++) {
+
+				int nk = (n - k) & (n - 1);
+				float ar = fft[k * 2 + 0];
+				float ai = fft[k * 2 + 1];
+				float br = fft[nk * 2 + 0];
+				float bi = -fft[nk * 2 + 1];
+
+				hr[k] = (ar + br) * 0.5 * scale;
+				hi[k] = (ai + bi) * 0.5 * scale;
+				hr[b + 1 + k] = (ai - bi) * 0.5 * scale;
+				hi[b + 1 + k] = (br - ar) * 0.5 * scale;
+			}
+		}
+	}
+
+	AudioServer::get_singleton()->lock();
+	impulse_spectrum = spectrum;
+	impulse_partitions = partitions;
+	impulse_partition_size = b;
+	impulse_version++;
+	AudioServer::get_singleton()->unlock();
+}
+
+void AudioEffectConvolutionReverb::set_impulse(const Ref<AudioStreamSample> &p_impulse) {
+
+	impulse = p_impulse;
+	_update_impulse();
+}
+
+Ref<AudioStreamSample> AudioEffectConvolutionReverb::get_impulse() const {
+
+	return impulse;
+}
+
+void AudioEffectConvolutionReverb::set_partition_size(PartitionSize p_size) {
+
+	ERR_FAIL_INDEX(p_size, PARTITION_SIZE_MAX);
+	partition_size = p_size;
+	_update_impulse();
+}
+
+AudioEffectConvolutionReverb::PartitionSize AudioEffectConvolutionReverb::get_partition_size() const {
+
+	return partition_size;
+}
+
+void AudioEffectConvolutionReverb::set_dry(float p_dry) {
+
+	dry = p_dry;
+}
+
+float AudioEffectConvolutionReverb::get_dry() const {
+
+	return dry;
+}
+
+void AudioEffectConvolutionReverb::set_wet(float p_wet) {
+
+	wet = p_wet;
+}
+
+float AudioEffectConvolutionReverb::get_wet() const {
+
+	return wet;
+}
+
+Ref<AudioEffectInstance> AudioEffectConvolutionReverb::instance() {
+
+	Ref<AudioEffectConvolutionReverbInstance> ins;
+	ins.instance();
+	ins->base = Ref<AudioEffectConvolutionReverb>(this);
+	ins->_reset();
+	return ins;
+}
+
+void AudioEffectConvolutionReverb::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("set_impulse", "impulse"), &AudioEffectConvolutionReverb::set_impulse);
+	ClassDB::bind_method(D_METHOD("get_impulse"), &AudioEffectConvolutionReverb::get_impulse);
+
+	ClassDB::bind_method(D_METHOD("set_partition_size", "size"), &AudioEffectConvolutionReverb::set_partition_size);
+	ClassDB::bind_method(D_METHOD("get_partition_size"), &AudioEffectConvolutionReverb::get_partition_size);
+
+	ClassDB::bind_method(D_METHOD("set_dry", "amount"), &AudioEffectConvolutionReverb::set_dry);
+	ClassDB::bind_method(D_METHOD("get_dry"), &AudioEffectConvolutionReverb::get_dry);
+
+	ClassDB::bind_method(D_METHOD("set_wet", "amount"), &AudioEffectConvolutionReverb::set_wet);
+	ClassDB::bind_method(D_METHOD("get_wet"), &AudioEffectConvolutionReverb::get_wet);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "impulse", PROPERTY_HINT_RESOURCE_TYPE, "AudioStreamSample"), "set_impulse", "get_impulse");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "partition_size", PROPERTY_HINT_ENUM, "256,512,1024,2048"), "set_partition_size", "get_partition_size");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "dry", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_dry", "get_dry");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "wet", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_wet", "get_wet");
+
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_256);
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_512);
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_1024);
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_2048);
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_MAX);
+}
+
+AudioEffectConvolutionReverb::AudioEffectConvolutionReverb() {
+
+	partition_size = PARTITION_SIZE_512;
+	dry = 1.0;
+	wet = 0.5;
+	impulse_partitions = 0;
+	impulse_partition_size = get_partition_frames(partition_size);
+	impulse_version = 0;
+}
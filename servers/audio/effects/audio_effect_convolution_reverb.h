@@ -0,0 +1,120 @@
+/*************************************************************************/
+/*  audio_effect_convolution_reverb.h                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef AUDIO_EFFECT_CONVOLUTION_REVERB_H
+#define AUDIO_EFFECT_CONVOLUTION_REVERB_H
+
+#include "scene/resources/audio_stream_sample.h"
+#include "servers/audio/audio_effect.h"
+
+class AudioEffectConvolutionReverb;
+
+class AudioEffectConvolutionReverbInstance : public AudioEffectInstance {
+	GDCLASS(AudioEffectConvolutionReverbInstance, AudioEffectInstance);
+
+	friend class AudioEffectConvolutionReverb;
+	Ref<AudioEffectConvolutionReverb> base;
+
+	uint32_t impulse_version;
+	int partition_size;
+	int partition_count;
+
+	Vector<AudioFrame> input; //previous and current block
+	Vector<AudioFrame> output; //wet signal of the previous block
+	int block_pos;
+
+	Vector<float> fft_buffer;
+	Vector<float> history; //spectra of the last partition_count input blocks
+	Vector<float> accum;
+	int history_pos;
+
+	void _reset();
+	void _process_block();
+
+public:
+	virtual void process(const AudioFrame *p_src_frames, AudioFrame *p_dst_frames, int p_frame_count);
+
+	AudioEffectConvolutionReverbInstance();
+};
+
+class AudioEffectConvolutionReverb : public AudioEffect {
+	GDCLASS(AudioEffectConvolutionReverb, AudioEffect);
+
+public:
+	enum PartitionSize {
+		PARTITION_SIZE_256,
+		PARTITION_SIZE_512,
+		PARTITION_SIZE_1024,
+		PARTITION_SIZE_2048,
+		PARTITION_SIZE_MAX
+	};
+
+private:
+	friend class AudioEffectConvolutionReverbInstance;
+
+	Ref<AudioStreamSample> impulse;
+	PartitionSize partition_size;
+	float dry;
+	float wet;
+
+	//spectra of every impulse partition, swapped under the audio lock
+	Vector<float> impulse_spectrum;
+	int impulse_partitions;
+	int impulse_partition_size;
+	uint32_t impulse_version;
+
+	void _update_impulse();
+
+protected:
+	static void _bind_methods();
+
+public:
+	static int get_partition_frames(PartitionSize p_size);
+
+	void set_impulse(const Ref<AudioStreamSample> &p_impulse);
+	Ref<AudioStreamSample> get_impulse() const;
+
+	void set_partition_size(PartitionSize p_size);
+	PartitionSize get_partition_size() const;
+
+	void set_dry(float p_dry);
+	float get_dry() const;
+
+	void set_wet(float p_wet);
+	float get_wet() const;
+
+	Ref<AudioEffectInstance> instance();
+
+	AudioEffectConvolutionReverb();
+};
+
+VARIANT_ENUM_CAST(AudioEffectConvolutionReverb::PartitionSize)
+
+#endif // AUDIO_EFFECT_CONVOLUTION_REVERB_H
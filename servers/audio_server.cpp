@@ -35,6 +35,7 @@
 #include "core/project_settings.h"
 #include "scene/resources/audio_stream_sample.h"
 #include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_mix.h"
 #include "servers/audio/effects/audio_effect_compressor.h"
 #ifdef TOOLS_ENABLED
 
@@ -338,141 +339,257 @@ void AudioServer::_mix_step() {
 		E->get().callback(E->get().userdata);
 	}
 
-	for (int i = buses.size() - 1; i >= 0; i--) {
-		//go bus by bus
-		Bus *bus = buses[i];
+	//rank the voices players asked for, the result is used on the next mix
+	_update_voices();
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+	mix_solo_mode = solo_mode;
 
-			if (bus->channels[k].active && !bus->channels[k].used) {
-				//buffer was not used, but it's still active, so it must be cleaned
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+	//find out where every bus sends to, and group them in levels that can be mixed in parallel
+	int bus_count = buses.size();
+	mix_send.resize(bus_count);
+	mix_first_source.resize(bus_count);
+	mix_next_source.resize(bus_count);
+	mix_level.resize(bus_count);
+	mix_level_buses.resize(bus_count);
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
+	int *send = mix_send.ptrw();
+	int *first_source = mix_first_source.ptrw();
+	int *next_source = mix_next_source.ptrw();
+	int *level = mix_level.ptrw();
 
-					buf[j] = AudioFrame(0, 0);
+	for (int i = 0; i < bus_count; i++) {
+
+		send[i] = -1;
+		first_source[i] = -1;
+		next_source[i] = -1;
+		level[i] = 0;
+
+		if (i > 0) {
+			//everything has a send save for master bus
+			Bus *bus = buses[i];
+			send[i] = 0;
+			if (bus_map.has(bus->send)) {
+				Bus *target = bus_map[bus->send];
+				if (target->index_cache < bus->index_cache) { //otherwise invalid, send to master
+					send[i] = target->index_cache;
 				}
 			}
-		}
 
-		//process effects
-		if (!bus->bypass) {
-			for (int j = 0; j < bus->effects.size(); j++) {
+			//pushing to the front leaves the sources of each bus in descending index order, as they were mixed before
+			next_source[i] = first_source[send[i]];
+			first_source[send[i]] = i;
+		}
+	}
 
-				if (!bus->effects[j].enabled)
-					continue;
+	int level_count = 1;
+	for (int i = bus_count - 1; i > 0; i--) {
+		level[send[i]] = MAX(level[send[i]], level[i] + 1);
+		level_count = MAX(level_count, level[send[i]] + 1);
+	}
 
-#ifdef DEBUG_ENABLED
-				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
-#endif
+	mix_level_ofs.resize(level_count + 1);
+	int *level_ofs = mix_level_ofs.ptrw();
+	for (int i = 0; i <= level_count; i++) {
+		level_ofs[i] = 0;
+	}
+	for (int i = 0; i < bus_count; i++) {
+		level_ofs[level[i] + 1]++;
+	}
+	for (int i = 0; i < level_count; i++) {
+		level_ofs[i + 1] += level_ofs[i];
+	}
 
-				for (int k = 0; k < bus->channels.size(); k++) {
+	int *level_buses = mix_level_buses.ptrw();
+	for (int i = bus_count - 1; i >= 0; i--) {
+		level_buses[level_ofs[level[i]]++] = i;
+	}
+	for (int i = level_count; i > 0; i--) {
+		level_ofs[i] = level_ofs[i - 1];
+	}
+	level_ofs[0] = 0;
 
-					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
-						continue;
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
-				}
+	for (int i = 0; i < level_count; i++) {
 
-				//swap buffers, so internal buffer always has the right data
-				for (int k = 0; k < bus->channels.size(); k++) {
+		int from = level_ofs[i];
+		int count = level_ofs[i + 1] - from;
 
-					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
-						continue;
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
-				}
+		if (count > 1 && mix_thread_count > 0) {
+			mix_work_buses = &level_buses[from];
+			mix_work_count = count;
+			mix_work_next = 0;
 
-#ifdef DEBUG_ENABLED
-				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
-#endif
+			int wake = MIN(mix_thread_count, count - 1);
+			for (int j = 0; j < wake; j++) {
+				mix_work_semaphore->post();
+			}
+			_mix_work(0);
+			for (int j = 0; j < wake; j++) {
+				mix_done_semaphore->wait();
+			}
+		} else {
+			for (int j = 0; j < count; j++) {
+				_mix_bus(level_buses[from + j], 0);
 			}
 		}
+	}
+
+	mix_frames += buffer_size;
+	mix_count++;
+	to_mix = buffer_size;
+}
 
-		//process send
+void AudioServer::_update_voices() {
 
-		Bus *send = NULL;
+	for (int i = 0; i < buses.size(); i++) {
 
-		if (i > 0) {
-			//everything has a send save for master bus
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { //invalid, send to master
-					send = buses[0];
-				}
-			}
+		Bus *bus = buses[i];
+		int count = bus->voice_request_count;
+		if (count == 0)
+			continue;
+
+		Voice **requests = bus->voice_requests.ptrw();
+
+		if (count > bus->voice_limit) {
+			SortArray<Voice *, VoiceSort> sorter;
+			sorter.nth_element(0, count, bus->voice_limit, requests);
 		}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+		for (int j = 0; j < count; j++) {
+			requests[j]->real = j < bus->voice_limit;
+			requests[j]->ranked_mix = mix_count;
+		}
+
+		bus->voice_request_count = 0;
+	}
+}
+
+void AudioServer::_mix_thread_func(void *p_user) {
+
+	MixThread *mt = (MixThread *)p_user;
+	AudioServer *as = mt->server;
+
+	while (true) {
+		as->mix_work_semaphore->wait();
+		if (as->exit_mix_threads) {
+			break;
+		}
+		as->_mix_work(mt->index + 1);
+		as->mix_done_semaphore->post();
+	}
+}
+
+void AudioServer::_mix_work(int p_thread) {
 
-			if (!bus->channels[k].active)
+	while (true) {
+		uint32_t work = atomic_increment(&mix_work_next) - 1;
+		if (work >= mix_work_count) {
+			break;
+		}
+		_mix_bus(mix_work_buses[work], p_thread);
+	}
+}
+
+void AudioServer::_mix_bus(int p_bus, int p_thread) {
+
+	Bus *bus = buses[p_bus];
+
+	//gather sends, every source is done mixing by now
+	for (int i = mix_first_source[p_bus]; i != -1; i = mix_next_source[i]) {
+
+		Bus *source = buses[i];
+
+		for (int k = 0; k < source->channels.size(); k++) {
+
+			if (!source->channels[k].active)
 				continue;
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+			AudioMix::add(thread_get_channel_mix_buffer(p_bus, k), source->channels[k].buffer.ptr(), buffer_size);
+		}
+	}
 
-			AudioFrame peak = AudioFrame(0, 0);
+	for (int k = 0; k < bus->channels.size(); k++) {
 
-			float volume = Math::db2linear(bus->volume_db);
+		if (bus->channels[k].active && !bus->channels[k].used) {
+			//buffer was not used, but it's still active, so it must be cleaned
+			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
+			for (uint32_t j = 0; j < buffer_size; j++) {
+
+				buf[j] = AudioFrame(0, 0);
 			}
+		}
+	}
 
-			//apply volume and compute peak
-			for (uint32_t j = 0; j < buffer_size; j++) {
+	//process effects
+	if (!bus->bypass) {
 
-				buf[j] *= volume;
+		Vector<AudioFrame> *temp = &temp_buffer.write[p_thread * channel_count];
 
-				float l = ABS(buf[j].l);
-				if (l > peak.l) {
-					peak.l = l;
-				}
-				float r = ABS(buf[j].r);
-				if (r > peak.r) {
-					peak.r = r;
-				}
-			}
+		for (int j = 0; j < bus->effects.size(); j++) {
+
+			if (!bus->effects[j].enabled)
+				continue;
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + 0.0000000001), Math::linear2db(peak.r + 0.0000000001));
+#ifdef DEBUG_ENABLED
+			uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+#endif
 
-			if (!bus->channels[k].used) {
-				//see if any audio is contained, because channel was not used
+			for (int k = 0; k < bus->channels.size(); k++) {
 
-				if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
-				}
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
+					continue;
+				bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp[k].ptrw(), buffer_size);
 			}
 
-			if (send) {
-				//if not master bus, send
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+			//swap buffers, so internal buffer always has the right data
+			for (int k = 0; k < bus->channels.size(); k++) {
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
+					continue;
+				SWAP(bus->channels.write[k].buffer, temp[k]);
 			}
+
+#ifdef DEBUG_ENABLED
+			bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+#endif
 		}
 	}
 
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
-}
+	for (int k = 0; k < bus->channels.size(); k++) {
 
-bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
-	if (p_bus < 0 || p_bus >= buses.size())
-		return false;
-	if (p_buffer < 0 || p_buffer >= buses[p_bus]->channels.size())
-		return false;
-	return true;
+		if (!bus->channels[k].active)
+			continue;
+
+		AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+
+		float volume = Math::db2linear(bus->volume_db);
+
+		if (mix_solo_mode) {
+			if (!bus->soloed) {
+				volume = 0.0;
+			}
+		} else {
+			if (bus->mute) {
+				volume = 0.0;
+			}
+		}
+
+		//apply volume and compute peak
+		AudioFrame peak = AudioMix::scale_peak(buf, buffer_size, volume);
+
+		bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + 0.0000000001), Math::linear2db(peak.r + 0.0000000001));
+
+		if (!bus->channels[k].used) {
+			//see if any audio is contained, because channel was not used
+
+			if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
+				bus->channels.write[k].last_mix_with_audio = mix_frames;
+			} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
+				bus->channels.write[k].active = false;
+				continue; //went inactive, don't send.
+			}
+		}
+	}
 }
 
 AudioFrame *AudioServer::thread_get_channel_mix_buffer(int p_bus, int p_buffer) {
@@ -494,6 +611,36 @@ AudioFrame *AudioServer::thread_get_channel_mix_buffer(int p_bus, int p_buffer)
 	return data;
 }
 
+bool AudioServer::thread_request_voice(int p_bus, Voice *p_voice, float p_audibility) {
+
+	ERR_FAIL_INDEX_V(p_bus, buses.size(), true);
+
+	Bus *bus = buses[p_bus];
+	p_voice->audibility = p_audibility;
+
+	if (p_audibility < Math::db2linear(bus->voice_threshold_db)) {
+		p_voice->real = false; //too quiet to matter, no need to rank it
+		return false;
+	}
+
+	if (bus->voice_limit <= 0) {
+		p_voice->real = true;
+		return true;
+	}
+
+	//ranked along with the other voices of this bus once all players mixed
+	if (bus->voice_request_count == bus->voice_requests.size()) {
+		bus->voice_requests.resize(MAX(16, bus->voice_requests.size() * 2));
+	}
+	bus->voice_requests.write[bus->voice_request_count++] = p_voice;
+
+	if (p_voice->ranked_mix + 1 != mix_count) {
+		p_voice->real = true; //not ranked last mix (new or quiet until now), don't hold it back
+	}
+
+	return p_voice->real;
+}
+
 int AudioServer::thread_get_mix_buffer_size() const {
 
 	return buffer_size;
@@ -811,6 +958,36 @@ bool AudioServer::is_bus_bypassing_effects(int p_bus) const {
 	return buses[p_bus]->bypass;
 }
 
+void AudioServer::set_bus_voice_limit(int p_bus, int p_limit) {
+
+	ERR_FAIL_INDEX(p_bus, buses.size());
+
+	MARK_EDITED
+
+	buses[p_bus]->voice_limit = MAX(p_limit, 0);
+}
+int AudioServer::get_bus_voice_limit(int p_bus) const {
+
+	ERR_FAIL_INDEX_V(p_bus, buses.size(), 0);
+
+	return buses[p_bus]->voice_limit;
+}
+
+void AudioServer::set_bus_voice_threshold_db(int p_bus, float p_threshold_db) {
+
+	ERR_FAIL_INDEX(p_bus, buses.size());
+
+	MARK_EDITED
+
+	buses[p_bus]->voice_threshold_db = p_threshold_db;
+}
+float AudioServer::get_bus_voice_threshold_db(int p_bus) const {
+
+	ERR_FAIL_INDEX_V(p_bus, buses.size(), 0);
+
+	return buses[p_bus]->voice_threshold_db;
+}
+
 void AudioServer::_update_bus_effects(int p_bus) {
 
 	for (int i = 0; i < buses[p_bus]->channels.size(); i++) {
@@ -955,7 +1132,7 @@ float AudioServer::get_global_rate_scale() const {
 
 void AudioServer::init_channels_and_buffers() {
 	channel_count = get_channel_count();
-	temp_buffer.resize(channel_count);
+	temp_buffer.resize((mix_thread_count + 1) * channel_count);
 
 	for (int i = 0; i < temp_buffer.size(); i++) {
 		temp_buffer.write[i].resize(buffer_size);
@@ -976,6 +1153,38 @@ void AudioServer::init() {
 	ProjectSettings::get_singleton()->set_custom_property_info("audio/channel_disable_time", PropertyInfo(Variant::REAL, "audio/channel_disable_time", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"));
 	buffer_size = 1024; //hardcoded for now
 
+	int thread_count = GLOBAL_DEF_RST("audio/mix_threads", -1);
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/mix_threads", PropertyInfo(Variant::INT, "audio/mix_threads", PROPERTY_HINT_RANGE, "-1,16,1"));
+#ifndef NO_THREADS
+	if (thread_count < 0) {
+		thread_count = MIN(OS::get_singleton()->get_processor_count() - 1, 3);
+	}
+	if (thread_count > 0) {
+		mix_work_semaphore = Semaphore::create();
+		mix_done_semaphore = Semaphore::create();
+		if (!mix_work_semaphore || !mix_done_semaphore) {
+			thread_count = 0; //platform without semaphores, mix on the audio thread only
+		}
+	}
+#else
+	thread_count = 0;
+#endif
+
+	if (thread_count > 0) {
+		exit_mix_threads = false;
+		mix_thread_count = thread_count;
+		mix_threads = memnew_arr(MixThread, mix_thread_count);
+		Thread::Settings settings;
+		settings.priority = Thread::PRIORITY_REALTIME;
+		settings.affinity_mask = Thread::get_performance_core_mask();
+		for (int i = 0; i < mix_thread_count; i++) {
+			mix_threads[i].server = this;
+			mix_threads[i].index = i;
+			settings.name = "AudioMix " + itos(i);
+			mix_threads[i].thread = Thread::create(&_mix_thread_func, &mix_threads[i], settings);
+		}
+	}
+
 	init_channels_and_buffers();
 
 	mix_count = 0;
@@ -1077,6 +1286,29 @@ void AudioServer::finish() {
 		AudioDriverManager::get_driver(i)->finish();
 	}
 
+	if (mix_threads) {
+		exit_mix_threads = true;
+		for (int i = 0; i < mix_thread_count; i++) {
+			mix_work_semaphore->post();
+		}
+		for (int i = 0; i < mix_thread_count; i++) {
+			Thread::wait_to_finish(mix_threads[i].thread);
+			memdelete(mix_threads[i].thread);
+		}
+		memdelete_arr(mix_threads);
+		mix_threads = NULL;
+	}
+	mix_thread_count = 0;
+
+	if (mix_work_semaphore) {
+		memdelete(mix_work_semaphore);
+		mix_work_semaphore = NULL;
+	}
+	if (mix_done_semaphore) {
+		memdelete(mix_done_semaphore);
+		mix_done_semaphore = NULL;
+	}
+
 	for (int i = 0; i < buses.size(); i++) {
 		memdelete(buses[i]);
 	}
@@ -1232,6 +1464,8 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 		bus->mute = p_bus_layout->buses[i].mute;
 		bus->bypass = p_bus_layout->buses[i].bypass;
 		bus->volume_db = p_bus_layout->buses[i].volume_db;
+		bus->voice_limit = p_bus_layout->buses[i].voice_limit;
+		bus->voice_threshold_db = p_bus_layout->buses[i].voice_threshold_db;
 
 		for (int j = 0; j < p_bus_layout->buses[i].effects.size(); j++) {
 
@@ -1276,6 +1510,8 @@ Ref<AudioBusLayout> AudioServer::generate_bus_layout() const {
 		state->buses.write[i].solo = buses[i]->solo;
 		state->buses.write[i].bypass = buses[i]->bypass;
 		state->buses.write[i].volume_db = buses[i]->volume_db;
+		state->buses.write[i].voice_limit = buses[i]->voice_limit;
+		state->buses.write[i].voice_threshold_db = buses[i]->voice_threshold_db;
 		for (int j = 0; j < buses[i]->effects.size(); j++) {
 			AudioBusLayout::Bus::Effect fx;
 			fx.effect = buses[i]->effects[j].effect;
@@ -1347,6 +1583,12 @@ void AudioServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_bus_bypass_effects", "bus_idx", "enable"), &AudioServer::set_bus_bypass_effects);
 	ClassDB::bind_method(D_METHOD("is_bus_bypassing_effects", "bus_idx"), &AudioServer::is_bus_bypassing_effects);
 
+	ClassDB::bind_method(D_METHOD("set_bus_voice_limit", "bus_idx", "limit"), &AudioServer::set_bus_voice_limit);
+	ClassDB::bind_method(D_METHOD("get_bus_voice_limit", "bus_idx"), &AudioServer::get_bus_voice_limit);
+
+	ClassDB::bind_method(D_METHOD("set_bus_voice_threshold_db", "bus_idx", "threshold_db"), &AudioServer::set_bus_voice_threshold_db);
+	ClassDB::bind_method(D_METHOD("get_bus_voice_threshold_db", "bus_idx"), &AudioServer::get_bus_voice_threshold_db);
+
 	ClassDB::bind_method(D_METHOD("add_bus_effect", "bus_idx", "effect", "at_position"), &AudioServer::add_bus_effect, DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("remove_bus_effect", "bus_idx", "effect_idx"), &AudioServer::remove_bus_effect);
 
@@ -1413,6 +1655,15 @@ AudioServer::AudioServer() {
 	mix_time = 0;
 	mix_size = 0;
 	global_rate_scale = 1;
+	mix_solo_mode = false;
+	mix_threads = NULL;
+	mix_thread_count = 0;
+	mix_work_semaphore = NULL;
+	mix_done_semaphore = NULL;
+	exit_mix_threads = false;
+	mix_work_buses = NULL;
+	mix_work_count = 0;
+	mix_work_next = 0;
 }
 
 AudioServer::~AudioServer() {
@@ -1448,6 +1699,10 @@ bool AudioBusLayout::_set(const StringName &p_name, const Variant &p_value) {
 			bus.volume_db = p_value;
 		} else if (what == "send") {
 			bus.send = p_value;
+		} else if (what == "voice_limit") {
+			bus.voice_limit = p_value;
+		} else if (what == "voice_threshold_db") {
+			bus.voice_threshold_db = p_value;
 		} else if (what == "effect") {
 			int which = s.get_slice("/", 3).to_int();
 			if (bus.effects.size() <= which) {
@@ -1501,6 +1756,10 @@ bool AudioBusLayout::_get(const StringName &p_name, Variant &r_ret) const {
 			r_ret = bus.volume_db;
 		} else if (what == "send") {
 			r_ret = bus.send;
+		} else if (what == "voice_limit") {
+			r_ret = bus.voice_limit;
+		} else if (what == "voice_threshold_db") {
+			r_ret = bus.voice_threshold_db;
 		} else if (what == "effect") {
 			int which = s.get_slice("/", 3).to_int();
 			if (which < 0 || which >= bus.effects.size()) {
@@ -1537,6 +1796,8 @@ void AudioBusLayout::_get_property_list(List<PropertyInfo> *p_list) const {
 		p_list->push_back(PropertyInfo(Variant::BOOL, "bus/" + itos(i) + "/bypass_fx", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::REAL, "bus/" + itos(i) + "/volume_db", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::REAL, "bus/" + itos(i) + "/send", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		p_list->push_back(PropertyInfo(Variant::INT, "bus/" + itos(i) + "/voice_limit", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		p_list->push_back(PropertyInfo(Variant::REAL, "bus/" + itos(i) + "/voice_threshold_db", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 
 		for (int j = 0; j < buses[i].effects.size(); j++) {
 			p_list->push_back(PropertyInfo(Variant::OBJECT, "bus/" + itos(i) + "/effect/" + itos(j) + "/effect", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
@@ -34,6 +34,8 @@
 #include "core/math/audio_frame.h"
 #include "core/object.h"
 #include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/variant.h"
 #include "servers/audio/audio_effect.h"
 
@@ -164,6 +166,19 @@ public:
 
 	typedef void (*AudioCallback)(void *p_userdata);
 
+	//owned by players, see thread_request_voice()
+	struct Voice {
+		float audibility;
+		bool real;
+		uint64_t ranked_mix;
+
+		Voice() {
+			audibility = 0;
+			real = true;
+			ranked_mix = 0;
+		}
+	};
+
 private:
 	uint64_t mix_time;
 	int mix_size;
@@ -222,12 +237,60 @@ private:
 		float volume_db;
 		StringName send;
 		int index_cache;
+
+		int voice_limit; //0 for no limit
+		float voice_threshold_db; //quieter voices go virtual
+		Vector<Voice *> voice_requests; //only valid during a mix step
+		int voice_request_count;
+
+		Bus() {
+			voice_limit = 0;
+			voice_threshold_db = -100;
+			voice_request_count = 0;
+		}
 	};
 
-	Vector<Vector<AudioFrame> > temp_buffer; //temp_buffer for each level
+	Vector<Vector<AudioFrame> > temp_buffer; //temp_buffer for each mix thread and channel
 	Vector<Bus *> buses;
 	Map<StringName, Bus *> bus_map;
 
+	//buses are mixed level by level, a bus only after every bus sending to it
+	Vector<int> mix_send; //bus each bus sends to, -1 for master
+	Vector<int> mix_first_source; //buses sending to each bus, linked in descending index order
+	Vector<int> mix_next_source;
+	Vector<int> mix_level;
+	Vector<int> mix_level_buses; //bus indices grouped by level
+	Vector<int> mix_level_ofs;
+	bool mix_solo_mode;
+
+	struct MixThread {
+		AudioServer *server;
+		int index;
+		Thread *thread;
+	};
+
+	MixThread *mix_threads;
+	int mix_thread_count;
+	Semaphore *mix_work_semaphore;
+	Semaphore *mix_done_semaphore;
+	volatile bool exit_mix_threads;
+	const int *mix_work_buses;
+	uint32_t mix_work_count;
+	volatile uint32_t mix_work_next;
+
+	struct VoiceSort {
+		_FORCE_INLINE_ bool operator()(const Voice *p_a, const Voice *p_b) const {
+			//voices that are already real win ties with some margin, so they don't trade places every mix
+			return p_a->audibility * (p_a->real ? 1.4 : 1.0) > p_b->audibility * (p_b->real ? 1.4 : 1.0);
+		}
+	};
+
+	void _update_voices();
+
+	static void _mix_thread_func(void *p_user);
+	void _mix_work(int p_thread);
+	void _mix_bus(int p_bus, int p_thread);
+
 	void _update_bus_effects(int p_bus);
 
 	static AudioServer *singleton;
@@ -282,6 +345,7 @@ public:
 	AudioFrame *thread_get_channel_mix_buffer(int p_bus, int p_buffer);
 	int thread_get_mix_buffer_size() const;
 	int thread_find_bus_index(const StringName &p_name);
+	bool thread_request_voice(int p_bus, Voice *p_voice, float p_audibility);
 
 	void set_bus_count(int p_count);
 	int get_bus_count() const;
@@ -312,6 +376,12 @@ public:
 	void set_bus_bypass_effects(int p_bus, bool p_enable);
 	bool is_bus_bypassing_effects(int p_bus) const;
 
+	void set_bus_voice_limit(int p_bus, int p_limit);
+	int get_bus_voice_limit(int p_bus) const;
+
+	void set_bus_voice_threshold_db(int p_bus, float p_threshold_db);
+	float get_bus_voice_threshold_db(int p_bus) const;
+
 	void add_bus_effect(int p_bus, const Ref<AudioEffect> &p_effect, int p_at_pos = -1);
 	void remove_bus_effect(int p_bus, int p_effect);
 
@@ -405,11 +475,16 @@ class AudioBusLayout : public Resource {
 		float volume_db;
 		StringName send;
 
+		int voice_limit;
+		float voice_threshold_db;
+
 		Bus() {
 			solo = false;
 			mute = false;
 			bypass = false;
 			volume_db = 0;
+			voice_limit = 0;
+			voice_threshold_db = -100;
 		}
 	};
 
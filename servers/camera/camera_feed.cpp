@@ -141,6 +141,8 @@ CameraFeed::CameraFeed() {
 	datatype = CameraFeed::FEED_RGB;
 	position = CameraFeed::FEED_UNSPECIFIED;
 	transform = Transform2D(1.0, 0.0, 0.0, -1.0, 0.0, 1.0);
+	frame_buffer_index[CameraServer::FEED_Y_IMAGE] = 0;
+	frame_buffer_index[CameraServer::FEED_CBCR_IMAGE] = 0;
 
 	// create a texture object
 	VisualServer *vs = VisualServer::get_singleton();
@@ -158,6 +160,8 @@ CameraFeed::CameraFeed(String p_name, FeedPosition p_position) {
 	datatype = CameraFeed::FEED_NOIMAGE;
 	position = p_position;
 	transform = Transform2D(1.0, 0.0, 0.0, -1.0, 0.0, 1.0);
+	frame_buffer_index[CameraServer::FEED_Y_IMAGE] = 0;
+	frame_buffer_index[CameraServer::FEED_CBCR_IMAGE] = 0;
 
 	// create a texture object
 	VisualServer *vs = VisualServer::get_singleton();
@@ -184,7 +188,7 @@ void CameraFeed::set_RGB_img(Ref<Image> p_rgb_img) {
 			base_width = new_width;
 			base_height = new_height;
 
-			vs->texture_allocate(texture[CameraServer::FEED_RGBA_IMAGE], new_width, new_height, 0, Image::FORMAT_RGB8, VS::TEXTURE_TYPE_2D, VS::TEXTURE_FLAGS_DEFAULT);
+			vs->texture_allocate(texture[CameraServer::FEED_RGBA_IMAGE], new_width, new_height, 0, Image::FORMAT_RGB8, VS::TEXTURE_TYPE_2D, VS::TEXTURE_FLAG_FILTER | VS::TEXTURE_FLAG_USED_FOR_STREAMING);
 		}
 
 		vs->texture_set_data(texture[CameraServer::FEED_RGBA_IMAGE], p_rgb_img);
@@ -242,6 +246,76 @@ void CameraFeed::set_YCbCr_imgs(Ref<Image> p_y_img, Ref<Image> p_cbcr_img) {
 	}
 }
 
+Ref<Image> CameraFeed::_copy_plane(CameraServer::FeedImage p_which, const uint8_t *p_data, int p_width, int p_height, int p_stride, Image::Format p_format) {
+	ERR_FAIL_COND_V(!p_data, Ref<Image>());
+	ERR_FAIL_COND_V(p_width <= 0 || p_height <= 0, Ref<Image>());
+
+	int row_size = p_width * Image::get_format_pixel_size(p_format);
+	ERR_FAIL_COND_V(p_stride < row_size, Ref<Image>());
+
+	// pick the next buffer the visual server is done with, the others may still be queued for upload
+	FrameBuffer *buffer = NULL;
+	for (int i = 0; i < FRAME_BUFFER_COUNT; i++) {
+		int index = (frame_buffer_index[p_which] + i) % FRAME_BUFFER_COUNT;
+		FrameBuffer &candidate = frame_buffers[p_which][index];
+		if (candidate.image.is_null() || candidate.image->reference_get_count() == 1) {
+			buffer = &candidate;
+			frame_buffer_index[p_which] = (index + 1) % FRAME_BUFFER_COUNT;
+			break;
+		}
+	}
+
+	if (!buffer) {
+		// all of them are in flight, writing below will copy on write instead of reusing the memory
+		buffer = &frame_buffers[p_which][frame_buffer_index[p_which]];
+		frame_buffer_index[p_which] = (frame_buffer_index[p_which] + 1) % FRAME_BUFFER_COUNT;
+	}
+
+	// release our image first so the data is no longer shared and can be written in place
+	buffer->image.unref();
+	if (buffer->data.size() != row_size * p_height) {
+		buffer->data.resize(row_size * p_height);
+	}
+
+	{
+		PoolVector<uint8_t>::Write w = buffer->data.write();
+		if (p_stride == row_size) {
+			copymem(w.ptr(), p_data, row_size * p_height);
+		} else {
+			// skip the row padding the camera adds
+			for (int y = 0; y < p_height; y++) {
+				copymem(w.ptr() + y * row_size, p_data + y * p_stride, row_size);
+			}
+		}
+	}
+
+	buffer->image.instance();
+	buffer->image->create(p_width, p_height, false, p_format, buffer->data);
+
+	return buffer->image;
+}
+
+void CameraFeed::set_RGB_data(const uint8_t *p_data, int p_width, int p_height, int p_stride) {
+	if (active) {
+		Ref<Image> rgb_img = _copy_plane(CameraServer::FEED_RGBA_IMAGE, p_data, p_width, p_height, p_stride, Image::FORMAT_RGB8);
+		ERR_FAIL_COND(rgb_img.is_null());
+
+		set_RGB_img(rgb_img);
+	}
+}
+
+void CameraFeed::set_YCbCr_planes(const uint8_t *p_y_data, int p_y_width, int p_y_height, int p_y_stride, const uint8_t *p_cbcr_data, int p_cbcr_width, int p_cbcr_height, int p_cbcr_stride) {
+	if (active) {
+		Ref<Image> y_img = _copy_plane(CameraServer::FEED_Y_IMAGE, p_y_data, p_y_width, p_y_height, p_y_stride, Image::FORMAT_R8);
+		ERR_FAIL_COND(y_img.is_null());
+
+		Ref<Image> cbcr_img = _copy_plane(CameraServer::FEED_CBCR_IMAGE, p_cbcr_data, p_cbcr_width, p_cbcr_height, p_cbcr_stride, Image::FORMAT_RG8);
+		ERR_FAIL_COND(cbcr_img.is_null());
+
+		set_YCbCr_imgs(y_img, cbcr_img);
+	}
+}
+
 void CameraFeed::allocate_texture(int p_width, int p_height, Image::Format p_format, VisualServer::TextureType p_texture_type, FeedDataType p_data_type) {
 	VisualServer *vs = VisualServer::get_singleton();
 
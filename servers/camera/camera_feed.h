@@ -65,6 +65,20 @@ private:
 	int base_width;
 	int base_height;
 
+	enum {
+		FRAME_BUFFER_COUNT = 3 // a threaded visual server may still hold the previous frames while we fill the next one
+	};
+
+	struct FrameBuffer {
+		PoolVector<uint8_t> data;
+		Ref<Image> image;
+	};
+
+	FrameBuffer frame_buffers[CameraServer::FEED_IMAGES][FRAME_BUFFER_COUNT];
+	int frame_buffer_index[CameraServer::FEED_IMAGES];
+
+	Ref<Image> _copy_plane(CameraServer::FeedImage p_which, const uint8_t *p_data, int p_width, int p_height, int p_stride, Image::Format p_format);
+
 protected:
 	String name; // name of our camera feed
 	FeedDataType datatype; // type of texture data stored
@@ -103,6 +117,8 @@ public:
 	void set_RGB_img(Ref<Image> p_rgb_img);
 	void set_YCbCr_img(Ref<Image> p_ycbcr_img);
 	void set_YCbCr_imgs(Ref<Image> p_y_img, Ref<Image> p_cbcr_img);
+	void set_RGB_data(const uint8_t *p_data, int p_width, int p_height, int p_stride);
+	void set_YCbCr_planes(const uint8_t *p_y_data, int p_y_width, int p_y_height, int p_y_stride, const uint8_t *p_cbcr_data, int p_cbcr_width, int p_cbcr_height, int p_cbcr_stride);
 	void allocate_texture(int p_width, int p_height, Image::Format p_format, VisualServer::TextureType p_texture_type, FeedDataType p_data_type);
 
 	virtual bool activate_feed();
@@ -31,16 +31,27 @@
 #include "area_pair_sw.h"
 #include "collision_solver_sw.h"
 
-bool AreaPairSW::setup(real_t p_step) {
-
-	bool result = false;
+bool AreaPairSW::_test() const {
 
 	if (area->is_shape_set_as_disabled(area_shape) || body->is_shape_set_as_disabled(body_shape)) {
-		result = false;
-	} else if (area->test_collision_mask(body) && CollisionSolverSW::solve_static(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), NULL, this)) {
-		result = true;
+		return false;
 	}
 
+	return area->test_collision_mask(body) && CollisionSolverSW::solve_static(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), NULL, const_cast<AreaPairSW *>(this));
+}
+
+void AreaPairSW::prepare(real_t p_step) {
+
+	prepared_result = _test();
+	prepared = true;
+}
+
+bool AreaPairSW::setup(real_t p_step) {
+
+	//use the result computed by prepare() if any, the query update below must stay serial
+	bool result = prepared ? prepared_result : _test();
+	prepared = false;
+
 	if (result != colliding) {
 
 		if (result) {
@@ -74,6 +85,9 @@ AreaPairSW::AreaPairSW(BodySW *p_body, int p_body_shape, AreaSW *p_area, int p_a
 	body_shape = p_body_shape;
 	area_shape = p_area_shape;
 	colliding = false;
+	prepared = false;
+	prepared_result = false;
+	threaded_prepare = true;
 	body->add_constraint(this, 0);
 	area->add_constraint(this);
 	if (p_body->get_mode() == PhysicsServer::BODY_MODE_KINEMATIC)
@@ -95,15 +109,26 @@ AreaPairSW::~AreaPairSW() {
 
 ////////////////////////////////////////////////////
 
-bool Area2PairSW::setup(real_t p_step) {
+bool Area2PairSW::_test() const {
 
-	bool result = false;
 	if (area_a->is_shape_set_as_disabled(shape_a) || area_b->is_shape_set_as_disabled(shape_b)) {
-		result = false;
-	} else if (area_a->test_collision_mask(area_b) && CollisionSolverSW::solve_static(area_a->get_shape(shape_a), area_a->get_transform() * area_a->get_shape_transform(shape_a), area_b->get_shape(shape_b), area_b->get_transform() * area_b->get_shape_transform(shape_b), NULL, this)) {
-		result = true;
+		return false;
 	}
 
+	return area_a->test_collision_mask(area_b) && CollisionSolverSW::solve_static(area_a->get_shape(shape_a), area_a->get_transform() * area_a->get_shape_transform(shape_a), area_b->get_shape(shape_b), area_b->get_transform() * area_b->get_shape_transform(shape_b), NULL, const_cast<Area2PairSW *>(this));
+}
+
+void Area2PairSW::prepare(real_t p_step) {
+
+	prepared_result = _test();
+	prepared = true;
+}
+
+bool Area2PairSW::setup(real_t p_step) {
+
+	bool result = prepared ? prepared_result : _test();
+	prepared = false;
+
 	if (result != colliding) {
 
 		if (result) {
@@ -139,6 +164,9 @@ Area2PairSW::Area2PairSW(AreaSW *p_area_a, int p_shape_a, AreaSW *p_area_b, int
 	shape_a = p_shape_a;
 	shape_b = p_shape_b;
 	colliding = false;
+	prepared = false;
+	prepared_result = false;
+	threaded_prepare = true;
 	area_a->add_constraint(this);
 	area_b->add_constraint(this);
 }
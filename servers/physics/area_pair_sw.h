@@ -42,8 +42,13 @@ class AreaPairSW : public ConstraintSW {
 	int body_shape;
 	int area_shape;
 	bool colliding;
+	bool prepared;
+	bool prepared_result;
+
+	bool _test() const;
 
 public:
+	void prepare(real_t p_step);
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
 
@@ -58,8 +63,13 @@ class Area2PairSW : public ConstraintSW {
 	int shape_a;
 	int shape_b;
 	bool colliding;
+	bool prepared;
+	bool prepared_result;
+
+	bool _test() const;
 
 public:
+	void prepare(real_t p_step);
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
 
@@ -173,68 +173,81 @@ void AreaSW::set_monitorable(bool p_monitorable) {
 	_set_static(!monitorable);
 }
 
-void AreaSW::call_queries() {
+void AreaSW::_call_monitor(ObjectID &r_callback_id, const StringName &p_method, MonitorQueries &p_queries) {
 
-	if (monitor_callback_id && !monitored_bodies.empty()) {
+	Object *obj = ObjectDB::get_instance(r_callback_id);
+	if (!obj) {
+		r_callback_id = 0;
+		return;
+	}
 
-		Variant res[5];
-		Variant *resptr[5];
-		for (int i = 0; i < 5; i++)
-			resptr[i] = &res[i];
+	Variant::CallError ce;
 
-		Object *obj = ObjectDB::get_instance(monitor_callback_id);
-		if (!obj) {
-			monitored_bodies.clear();
-			monitor_callback_id = 0;
-			return;
-		}
+	if (monitor_batching) {
 
-		for (Map<BodyKey, BodyState>::Element *E = monitored_bodies.front(); E; E = E->next()) {
+		//status, rid, instance id, other shape and own shape of each event, one after the other
+		Array events;
+		events.resize(p_queries.count * 5);
+		int event_count = 0;
 
-			if (E->get().state == 0)
-				continue; //nothing happened
+		for (int i = 0; i < p_queries.count; i++) {
 
-			res[0] = E->get().state > 0 ? PhysicsServer::AREA_BODY_ADDED : PhysicsServer::AREA_BODY_REMOVED;
-			res[1] = E->key().rid;
-			res[2] = E->key().instance_id;
-			res[3] = E->key().body_shape;
-			res[4] = E->key().area_shape;
+			int state = p_queries.states[i];
+			if (state == 0)
+				continue; //nothing happened
 
-			Variant::CallError ce;
-			obj->call(monitor_callback_method, (const Variant **)resptr, 5, ce);
+			const BodyKey &key = p_queries.keys[i];
+			int base = event_count * 5;
+			events[base + 0] = state > 0 ? PhysicsServer::AREA_BODY_ADDED : PhysicsServer::AREA_BODY_REMOVED;
+			events[base + 1] = key.rid;
+			events[base + 2] = key.instance_id;
+			events[base + 3] = key.body_shape;
+			events[base + 4] = key.area_shape;
+			event_count++;
 		}
+
+		if (event_count == 0)
+			return;
+
+		events.resize(event_count * 5);
+		Variant arg = events;
+		const Variant *argptr = &arg;
+		obj->call(p_method, &argptr, 1, ce);
+		return;
 	}
 
-	monitored_bodies.clear();
+	Variant res[5];
+	Variant *resptr[5];
+	for (int i = 0; i < 5; i++)
+		resptr[i] = &res[i];
 
-	if (area_monitor_callback_id && !monitored_areas.empty()) {
+	for (int i = 0; i < p_queries.count; i++) {
 
-		Variant res[5];
-		Variant *resptr[5];
-		for (int i = 0; i < 5; i++)
-			resptr[i] = &res[i];
+		int state = p_queries.states[i];
+		if (state == 0)
+			continue; //nothing happened
 
-		Object *obj = ObjectDB::get_instance(area_monitor_callback_id);
-		if (!obj) {
-			monitored_areas.clear();
-			area_monitor_callback_id = 0;
-			return;
-		}
+		const BodyKey &key = p_queries.keys[i];
+		res[0] = state > 0 ? PhysicsServer::AREA_BODY_ADDED : PhysicsServer::AREA_BODY_REMOVED;
+		res[1] = key.rid;
+		res[2] = key.instance_id;
+		res[3] = key.body_shape;
+		res[4] = key.area_shape;
 
-		for (Map<BodyKey, BodyState>::Element *E = monitored_areas.front(); E; E = E->next()) {
+		obj->call(p_method, (const Variant **)resptr, 5, ce);
+	}
+}
 
-			if (E->get().state == 0)
-				continue; //nothing happened
+void AreaSW::call_queries() {
 
-			res[0] = E->get().state > 0 ? PhysicsServer::AREA_BODY_ADDED : PhysicsServer::AREA_BODY_REMOVED;
-			res[1] = E->key().rid;
-			res[2] = E->key().instance_id;
-			res[3] = E->key().body_shape;
-			res[4] = E->key().area_shape;
+	if (monitor_callback_id && !monitored_bodies.empty()) {
+		_call_monitor(monitor_callback_id, monitor_callback_method, monitored_bodies);
+	}
 
-			Variant::CallError ce;
-			obj->call(area_monitor_callback_method, (const Variant **)resptr, 5, ce);
-		}
+	monitored_bodies.clear();
+
+	if (area_monitor_callback_id && !monitored_areas.empty()) {
+		_call_monitor(area_monitor_callback_id, area_monitor_callback_method, monitored_areas);
 	}
 
 	monitored_areas.clear();
@@ -259,6 +272,7 @@ AreaSW::AreaSW() :
 	set_ray_pickable(false);
 	monitor_callback_id = 0;
 	area_monitor_callback_id = 0;
+	monitor_batching = false;
 	monitorable = false;
 }
 
@@ -32,6 +32,7 @@
 #define AREA_SW_H
 
 #include "collision_object_sw.h"
+#include "core/oa_hash_map.h"
 #include "core/self_list.h"
 #include "servers/physics_server.h"
 //#include "servers/physics/query_sw.h"
@@ -59,6 +60,8 @@ class AreaSW : public CollisionObjectSW {
 	ObjectID area_monitor_callback_id;
 	StringName area_monitor_callback_method;
 
+	bool monitor_batching; //one call per callback and step, with all events packed in an array
+
 	SelfList<AreaSW> monitor_query_list;
 	SelfList<AreaSW> moved_list;
 
@@ -69,6 +72,11 @@ class AreaSW : public CollisionObjectSW {
 		uint32_t body_shape;
 		uint32_t area_shape;
 
+		_FORCE_INLINE_ bool operator==(const BodyKey &p_key) const {
+
+			return rid == p_key.rid && body_shape == p_key.body_shape && area_shape == p_key.area_shape;
+		}
+
 		_FORCE_INLINE_ bool operator<(const BodyKey &p_key) const {
 
 			if (rid == p_key.rid) {
@@ -87,16 +95,62 @@ class AreaSW : public CollisionObjectSW {
 		BodyKey(AreaSW *p_body, uint32_t p_body_shape, uint32_t p_area_shape);
 	};
 
-	struct BodyState {
+	struct BodyKeyHasher {
 
-		int state;
-		_FORCE_INLINE_ void inc() { state++; }
-		_FORCE_INLINE_ void dec() { state--; }
-		_FORCE_INLINE_ BodyState() { state = 0; }
+		static _FORCE_INLINE_ uint32_t hash(const BodyKey &p_key) {
+
+			uint32_t h = hash_djb2_one_32(p_key.rid.get_id());
+			h = hash_djb2_one_32(p_key.body_shape, h);
+			return hash_djb2_one_32(p_key.area_shape, h);
+		}
 	};
 
-	Map<BodyKey, BodyState> monitored_bodies;
-	Map<BodyKey, BodyState> monitored_areas;
+	//overlap changes since the last call_queries, packed in the order they first happened
+	//a pair that enters and leaves within the same step cancels out
+	struct MonitorQueries {
+
+		OAHashMap<BodyKey, int, BodyKeyHasher> indices;
+		Vector<BodyKey> keys;
+		Vector<int> states;
+		int count;
+
+		_FORCE_INLINE_ void add(const BodyKey &p_key, int p_state) {
+
+			int *index = indices.lookup_ptr(p_key);
+			if (index) {
+				states.write[*index] += p_state;
+				return;
+			}
+
+			if (count == keys.size()) {
+				//storage is kept between steps, it only grows
+				keys.resize(MAX(count * 2, 8));
+				states.resize(keys.size());
+			}
+
+			indices.insert(p_key, count);
+			keys.write[count] = p_key;
+			states.write[count] = p_state;
+			count++;
+		}
+
+		_FORCE_INLINE_ bool empty() const { return count == 0; }
+
+		_FORCE_INLINE_ void clear() {
+
+			if (count) {
+				indices.clear();
+				count = 0;
+			}
+		}
+
+		MonitorQueries() :
+				indices(8),
+				count(0) {}
+	};
+
+	MonitorQueries monitored_bodies;
+	MonitorQueries monitored_areas;
 
 	//virtual void shape_changed_notify(ShapeSW *p_shape);
 	//virtual void shape_deleted_notify(ShapeSW *p_shape);
@@ -105,6 +159,7 @@ class AreaSW : public CollisionObjectSW {
 
 	virtual void _shapes_changed();
 	void _queue_monitor_update();
+	void _call_monitor(ObjectID &r_callback_id, const StringName &p_method, MonitorQueries &p_queries);
 
 public:
 	//_FORCE_INLINE_ const Transform& get_inverse_transform() const { return inverse_transform; }
@@ -116,6 +171,9 @@ public:
 	void set_area_monitor_callback(ObjectID p_id, const StringName &p_method);
 	_FORCE_INLINE_ bool has_area_monitor_callback() const { return area_monitor_callback_id; }
 
+	_FORCE_INLINE_ void set_monitor_batching(bool p_enable) { monitor_batching = p_enable; }
+	_FORCE_INLINE_ bool is_monitor_batching() const { return monitor_batching; }
+
 	_FORCE_INLINE_ void add_body_to_query(BodySW *p_body, uint32_t p_body_shape, uint32_t p_area_shape);
 	_FORCE_INLINE_ void remove_body_from_query(BodySW *p_body, uint32_t p_body_shape, uint32_t p_area_shape);
 
@@ -172,30 +230,26 @@ public:
 
 void AreaSW::add_body_to_query(BodySW *p_body, uint32_t p_body_shape, uint32_t p_area_shape) {
 
-	BodyKey bk(p_body, p_body_shape, p_area_shape);
-	monitored_bodies[bk].inc();
+	monitored_bodies.add(BodyKey(p_body, p_body_shape, p_area_shape), 1);
 	if (!monitor_query_list.in_list())
 		_queue_monitor_update();
 }
 void AreaSW::remove_body_from_query(BodySW *p_body, uint32_t p_body_shape, uint32_t p_area_shape) {
 
-	BodyKey bk(p_body, p_body_shape, p_area_shape);
-	monitored_bodies[bk].dec();
+	monitored_bodies.add(BodyKey(p_body, p_body_shape, p_area_shape), -1);
 	if (!monitor_query_list.in_list())
 		_queue_monitor_update();
 }
 
 void AreaSW::add_area_to_query(AreaSW *p_area, uint32_t p_area_shape, uint32_t p_self_shape) {
 
-	BodyKey bk(p_area, p_area_shape, p_self_shape);
-	monitored_areas[bk].inc();
+	monitored_areas.add(BodyKey(p_area, p_area_shape, p_self_shape), 1);
 	if (!monitor_query_list.in_list())
 		_queue_monitor_update();
 }
 void AreaSW::remove_area_from_query(AreaSW *p_area, uint32_t p_area_shape, uint32_t p_self_shape) {
 
-	BodyKey bk(p_area, p_area_shape, p_self_shape);
-	monitored_areas[bk].dec();
+	monitored_areas.add(BodyKey(p_area, p_area_shape, p_self_shape), -1);
 	if (!monitor_query_list.in_list())
 		_queue_monitor_update();
 }
@@ -49,6 +49,11 @@
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math_PI / 8)
 
+// contacts found by the narrowphase are kept while the shapes barely move relative to each other
+#define MANIFOLD_CACHE_MAX_STEPS 8 // still refresh every once in a while
+#define MANIFOLD_CACHE_LINEAR_RATIO 0.1 // of the contact recycle radius
+#define MANIFOLD_CACHE_ANGULAR_THRESHOLD 0.002 // radians, roughly
+
 void BodyPairSW::_contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata) {
 
 	BodyPairSW *pair = (BodyPairSW *)p_userdata;
@@ -211,6 +216,30 @@ bool BodyPairSW::_test_ccd(real_t p_step, BodySW *p_A, int p_shape_A, const Tran
 	return true;
 }
 
+bool BodyPairSW::_can_reuse_manifold(const ShapeSW *p_shape_A, const ShapeSW *p_shape_B, const Transform &p_relative_B) const {
+
+	if (!manifold_cache.valid || manifold_cache.steps >= MANIFOLD_CACHE_MAX_STEPS)
+		return false;
+
+	if (manifold_cache.shape_A != p_shape_A || manifold_cache.shape_B != p_shape_B)
+		return false;
+
+	// if contacts were dropped since, the manifold is no longer complete
+	if (contact_count == 0 || contact_count != manifold_cache.contact_count)
+		return false;
+
+	real_t linear_threshold = space->get_contact_recycle_radius() * MANIFOLD_CACHE_LINEAR_RATIO;
+	if (p_relative_B.origin.distance_squared_to(manifold_cache.relative_B.origin) > linear_threshold * linear_threshold)
+		return false;
+
+	for (int i = 0; i < 3; i++) {
+		if ((p_relative_B.basis.elements[i] - manifold_cache.relative_B.basis.elements[i]).length_squared() > MANIFOLD_CACHE_ANGULAR_THRESHOLD * MANIFOLD_CACHE_ANGULAR_THRESHOLD)
+			return false;
+	}
+
+	return true;
+}
+
 real_t combine_bounce(BodySW *A, BodySW *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -247,7 +276,27 @@ bool BodyPairSW::setup(real_t p_step) {
 	ShapeSW *shape_A_ptr = A->get_shape(shape_A);
 	ShapeSW *shape_B_ptr = B->get_shape(shape_B);
 
-	bool collided = CollisionSolverSW::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	Transform relative_B = xform_A.affine_inverse() * xform_B;
+
+	bool collided;
+
+	if (_can_reuse_manifold(shape_A_ptr, shape_B_ptr, relative_B)) {
+
+		// resting pair, contacts are re-projected below from their local positions
+		collided = true;
+		manifold_cache.steps++;
+	} else {
+
+		collided = CollisionSolverSW::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+
+		manifold_cache.valid = collided;
+		manifold_cache.relative_B = relative_B;
+		manifold_cache.shape_A = shape_A_ptr;
+		manifold_cache.shape_B = shape_B_ptr;
+		manifold_cache.contact_count = contact_count;
+		manifold_cache.steps = 0;
+	}
+
 	this->collided = collided;
 
 	if (!collided) {
@@ -486,6 +535,11 @@ BodyPairSW::BodyPairSW(BodySW *p_A, int p_shape_A, BodySW *p_B, int p_shape_B) :
 	B->add_constraint(this, 1);
 	contact_count = 0;
 	collided = false;
+	manifold_cache.valid = false;
+	manifold_cache.shape_A = NULL;
+	manifold_cache.shape_B = NULL;
+	manifold_cache.contact_count = 0;
+	manifold_cache.steps = 0;
 }
 
 BodyPairSW::~BodyPairSW() {
@@ -77,6 +77,18 @@ class BodyPairSW : public ConstraintSW {
 	int contact_count;
 	bool collided;
 
+	// state of the last narrowphase run, lets resting pairs skip it
+	struct ManifoldCache {
+		bool valid;
+		Transform relative_B; // shape B in shape A space
+		const ShapeSW *shape_A;
+		const ShapeSW *shape_B;
+		int contact_count;
+		int steps;
+	} manifold_cache;
+
+	_FORCE_INLINE_ bool _can_reuse_manifold(const ShapeSW *p_shape_A, const ShapeSW *p_shape_B, const Transform &p_relative_B) const;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B);
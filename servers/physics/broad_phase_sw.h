@@ -67,6 +67,9 @@ public:
 
 	virtual void update() = 0;
 
+	//whether the cull functions can be called from several threads at once
+	virtual bool supports_concurrent_queries() const { return false; }
+
 	virtual ~BroadPhaseSW();
 };
 
@@ -649,11 +649,14 @@ static void _collision_box_box(const ShapeSW *p_a, const Transform &p_transform_
 	if (!separator.test_previous_axis())
 		return;
 
+	const Vector3 axes_A[3] = { p_transform_a.basis.get_axis(0), p_transform_a.basis.get_axis(1), p_transform_a.basis.get_axis(2) };
+	const Vector3 axes_B[3] = { p_transform_b.basis.get_axis(0), p_transform_b.basis.get_axis(1), p_transform_b.basis.get_axis(2) };
+
 	// test faces of A
 
 	for (int i = 0; i < 3; i++) {
 
-		Vector3 axis = p_transform_a.basis.get_axis(i).normalized();
+		Vector3 axis = axes_A[i].normalized();
 
 		if (!separator.test_axis(axis))
 			return;
@@ -663,7 +666,7 @@ static void _collision_box_box(const ShapeSW *p_a, const Transform &p_transform_
 
 	for (int i = 0; i < 3; i++) {
 
-		Vector3 axis = p_transform_b.basis.get_axis(i).normalized();
+		Vector3 axis = axes_B[i].normalized();
 
 		if (!separator.test_axis(axis))
 			return;
@@ -674,7 +677,7 @@ static void _collision_box_box(const ShapeSW *p_a, const Transform &p_transform_
 
 		for (int j = 0; j < 3; j++) {
 
-			Vector3 axis = p_transform_a.basis.get_axis(i).cross(p_transform_b.basis.get_axis(j));
+			Vector3 axis = axes_A[i].cross(axes_B[j]);
 
 			if (Math::is_zero_approx(axis.length_squared()))
 				continue;
@@ -720,13 +723,13 @@ static void _collision_box_box(const ShapeSW *p_a, const Transform &p_transform_
 		for (int i = 0; i < 3; i++) {
 
 			//a ->b
-			Vector3 axis_a = p_transform_a.basis.get_axis(i);
+			const Vector3 &axis_a = axes_A[i];
 
 			if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized()))
 				return;
 
 			//b ->a
-			Vector3 axis_b = p_transform_b.basis.get_axis(i);
+			const Vector3 &axis_b = axes_B[i];
 
 			if (!separator.test_axis(axis_ab.cross(axis_b).cross(axis_b).normalized()))
 				return;
@@ -1297,15 +1300,20 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 	}
 
 	// A<->B edges
+
+	// edges of B are reused for every edge of A, so rotate them only once
+	Vector3 *edge_dirs_B = (Vector3 *)alloca(sizeof(Vector3) * MAX(edge_count_B, 1));
+	for (int j = 0; j < edge_count_B; j++) {
+		edge_dirs_B[j] = p_transform_b.basis.xform(vertices_B[edges_B[j].a] - vertices_B[edges_B[j].b]);
+	}
+
 	for (int i = 0; i < edge_count_A; i++) {
 
-		Vector3 e1 = p_transform_a.basis.xform(vertices_A[edges_A[i].a]) - p_transform_a.basis.xform(vertices_A[edges_A[i].b]);
+		Vector3 e1 = p_transform_a.basis.xform(vertices_A[edges_A[i].a] - vertices_A[edges_A[i].b]);
 
 		for (int j = 0; j < edge_count_B; j++) {
 
-			Vector3 e2 = p_transform_b.basis.xform(vertices_B[edges_B[j].a]) - p_transform_b.basis.xform(vertices_B[edges_B[j].b]);
-
-			Vector3 axis = e1.cross(e2).normalized();
+			Vector3 axis = e1.cross(edge_dirs_B[j]).normalized();
 
 			if (!separator.test_axis(axis))
 				return;
@@ -1314,14 +1322,24 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 
 	if (withMargin) {
 
+		Vector3 *world_vertices_A = (Vector3 *)alloca(sizeof(Vector3) * MAX(vertex_count_A, 1));
+		for (int i = 0; i < vertex_count_A; i++) {
+			world_vertices_A[i] = p_transform_a.xform(vertices_A[i]);
+		}
+
+		Vector3 *world_vertices_B = (Vector3 *)alloca(sizeof(Vector3) * MAX(vertex_count_B, 1));
+		for (int i = 0; i < vertex_count_B; i++) {
+			world_vertices_B[i] = p_transform_b.xform(vertices_B[i]);
+		}
+
 		//vertex-vertex
 		for (int i = 0; i < vertex_count_A; i++) {
 
-			Vector3 va = p_transform_a.xform(vertices_A[i]);
+			const Vector3 &va = world_vertices_A[i];
 
 			for (int j = 0; j < vertex_count_B; j++) {
 
-				if (!separator.test_axis((va - p_transform_b.xform(vertices_B[j])).normalized()))
+				if (!separator.test_axis((va - world_vertices_B[j]).normalized()))
 					return;
 			}
 		}
@@ -1335,7 +1353,7 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 
 			for (int j = 0; j < vertex_count_B; j++) {
 
-				Vector3 e3 = p_transform_b.xform(vertices_B[j]);
+				const Vector3 &e3 = world_vertices_B[j];
 
 				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized()))
 					return;
@@ -1350,7 +1368,7 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 
 			for (int j = 0; j < vertex_count_A; j++) {
 
-				Vector3 e3 = p_transform_a.xform(vertices_A[j]);
+				const Vector3 &e3 = world_vertices_A[j];
 
 				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized()))
 					return;
@@ -1398,15 +1416,19 @@ static void _collision_convex_polygon_face(const ShapeSW *p_a, const Transform &
 	}
 
 	// A<->B edges
+	const Vector3 face_edges[3] = {
+		vertex[0] - vertex[1],
+		vertex[1] - vertex[2],
+		vertex[2] - vertex[0],
+	};
+
 	for (int i = 0; i < edge_count; i++) {
 
-		Vector3 e1 = p_transform_a.xform(vertices[edges[i].a]) - p_transform_a.xform(vertices[edges[i].b]);
+		Vector3 e1 = p_transform_a.basis.xform(vertices[edges[i].a] - vertices[edges[i].b]);
 
 		for (int j = 0; j < 3; j++) {
 
-			Vector3 e2 = vertex[j] - vertex[(j + 1) % 3];
-
-			Vector3 axis = e1.cross(e2).normalized();
+			Vector3 axis = e1.cross(face_edges[j]).normalized();
 
 			if (!separator.test_axis(axis))
 				return;
@@ -1415,10 +1437,13 @@ static void _collision_convex_polygon_face(const ShapeSW *p_a, const Transform &
 
 	if (withMargin) {
 
+		Vector3 *world_vertices = (Vector3 *)alloca(sizeof(Vector3) * MAX(vertex_count, 1));
+		p_transform_a.xform_array(vertices, world_vertices, vertex_count);
+
 		//vertex-vertex
 		for (int i = 0; i < vertex_count; i++) {
 
-			Vector3 va = p_transform_a.xform(vertices[i]);
+			const Vector3 &va = world_vertices[i];
 
 			for (int j = 0; j < 3; j++) {
 
@@ -1451,7 +1476,7 @@ static void _collision_convex_polygon_face(const ShapeSW *p_a, const Transform &
 
 			for (int j = 0; j < vertex_count; j++) {
 
-				Vector3 e3 = p_transform_a.xform(vertices[j]);
+				const Vector3 &e3 = world_vertices[j];
 
 				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized()))
 					return;
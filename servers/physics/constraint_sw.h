@@ -46,12 +46,15 @@ class ConstraintSW : public RID_Data {
 	RID self;
 
 protected:
+	bool threaded_prepare; //prepare() only reads shared state, so it can run on worker threads before setup()
+
 	ConstraintSW(BodySW **p_body_ptr = NULL, int p_body_count = 0) {
 		_body_ptr = p_body_ptr;
 		_body_count = p_body_count;
 		island_step = 0;
 		priority = 1;
 		disabled_collisions_between_bodies = true;
+		threaded_prepare = false;
 	}
 
 public:
@@ -76,6 +79,9 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	_FORCE_INLINE_ bool has_threaded_prepare() const { return threaded_prepare; }
+
+	virtual void prepare(real_t p_step) {}
 	virtual bool setup(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
@@ -31,6 +31,7 @@
 #include "physics_server_sw.h"
 
 #include "broad_phase_basic.h"
+#include "broad_phase_bvh.h"
 #include "broad_phase_octree.h"
 #include "core/os/os.h"
 #include "core/script_language.h"
@@ -224,8 +225,8 @@ int PhysicsServerSW::space_get_contact_count(RID p_space) const {
 
 RID PhysicsServerSW::area_create() {
 
-	AreaSW *area = memnew(AreaSW);
-	RID rid = area_owner.make_rid(area);
+	RID rid = area_owner.make_rid();
+	AreaSW *area = area_owner.getptr(rid);
 	area->set_self(rid);
 	return rid;
 };
@@ -473,16 +474,24 @@ void PhysicsServerSW::area_set_area_monitor_callback(RID p_area, Object *p_recei
 	area->set_area_monitor_callback(p_receiver ? p_receiver->get_instance_id() : 0, p_method);
 }
 
+void PhysicsServerSW::area_set_monitor_batching(RID p_area, bool p_enable) {
+
+	AreaSW *area = area_owner.get(p_area);
+	ERR_FAIL_COND(!area);
+
+	area->set_monitor_batching(p_enable);
+}
+
 /* BODY API */
 
 RID PhysicsServerSW::body_create(BodyMode p_mode, bool p_init_sleeping) {
 
-	BodySW *body = memnew(BodySW);
+	RID rid = body_owner.make_rid();
+	BodySW *body = body_owner.getptr(rid);
 	if (p_mode != BODY_MODE_RIGID)
 		body->set_mode(p_mode);
 	if (p_init_sleeping)
 		body->set_state(BODY_STATE_SLEEPING, p_init_sleeping);
-	RID rid = body_owner.make_rid(body);
 	body->set_self(rid);
 	return rid;
 };
@@ -1349,7 +1358,6 @@ void PhysicsServerSW::free(RID p_rid) {
 		}
 
 		body_owner.free(p_rid);
-		memdelete(body);
 
 	} else if (area_owner.owns(p_rid)) {
 
@@ -1368,7 +1376,6 @@ void PhysicsServerSW::free(RID p_rid) {
 		}
 
 		area_owner.free(p_rid);
-		memdelete(area);
 	} else if (space_owner.owns(p_rid)) {
 
 		SpaceSW *space = space_owner.get(p_rid);
@@ -1574,7 +1581,11 @@ void PhysicsServerSW::_shape_col_cbk(const Vector3 &p_point_A, const Vector3 &p_
 PhysicsServerSW *PhysicsServerSW::singleton = NULL;
 PhysicsServerSW::PhysicsServerSW() {
 	singleton = this;
-	BroadPhaseSW::create_func = BroadPhaseOctree::_create;
+	if (GLOBAL_DEF("physics/3d/godot_physics/use_bvh", true)) {
+		BroadPhaseSW::create_func = BroadPhaseBVH::_create;
+	} else {
+		BroadPhaseSW::create_func = BroadPhaseOctree::_create;
+	}
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
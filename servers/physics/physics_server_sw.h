@@ -60,8 +60,8 @@ class PhysicsServerSW : public PhysicsServer {
 
 	mutable RID_Owner<ShapeSW> shape_owner;
 	mutable RID_Owner<SpaceSW> space_owner;
-	mutable RID_Owner<AreaSW> area_owner;
-	mutable RID_Owner<BodySW> body_owner;
+	mutable RID_ChunkedOwner<AreaSW> area_owner;
+	mutable RID_ChunkedOwner<BodySW> body_owner;
 	mutable RID_Owner<JointSW> joint_owner;
 
 	//void _clear_query(QuerySW *p_query);
@@ -151,6 +151,7 @@ public:
 
 	virtual void area_set_monitor_callback(RID p_area, Object *p_receiver, const StringName &p_method);
 	virtual void area_set_area_monitor_callback(RID p_area, Object *p_receiver, const StringName &p_method);
+	virtual void area_set_monitor_batching(RID p_area, bool p_enable);
 
 	/* BODY API */
 
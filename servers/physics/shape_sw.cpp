@@ -38,6 +38,11 @@
 #define _EDGE_IS_VALID_SUPPORT_THRESHOLD 0.0002
 #define _FACE_IS_VALID_SUPPORT_THRESHOLD 0.9998
 
+#define CONCAVE_BVH_LEAF_FACES 4
+#define CONCAVE_BVH_STACK_SIZE 64 // enough for any balanced 4-wide tree
+
+#define HEIGHTMAP_TILE_CELLS 16
+
 void ShapeSW::configure(const AABB &p_aabb) {
 	aabb = p_aabb;
 	configured = true;
@@ -719,15 +724,22 @@ void ConvexPolygonShapeSW::project_range(const Vector3 &p_normal, const Transfor
 
 	const Vector3 *vrts = &mesh.vertices[0];
 
-	for (int i = 0; i < vertex_count; i++) {
+	// project in local space, so vertices don't need to be transformed one by one
+	Vector3 local_normal = p_transform.basis.xform_inv(p_normal);
+
+	real_t min = local_normal.dot(vrts[0]);
+	real_t max = min;
 
-		real_t d = p_normal.dot(p_transform.xform(vrts[i]));
+	for (int i = 1; i < vertex_count; i++) {
 
-		if (i == 0 || d > r_max)
-			r_max = d;
-		if (i == 0 || d < r_min)
-			r_min = d;
+		real_t d = local_normal.dot(vrts[i]);
+		min = MIN(min, d);
+		max = MAX(max, d);
 	}
+
+	real_t distance = p_normal.dot(p_transform.origin);
+	r_min = min + distance;
+	r_max = max + distance;
 }
 
 Vector3 ConvexPolygonShapeSW::get_support(const Vector3 &p_normal) const {
@@ -988,17 +1000,15 @@ ConvexPolygonShapeSW::ConvexPolygonShapeSW() {
 
 void FaceShapeSW::project_range(const Vector3 &p_normal, const Transform &p_transform, real_t &r_min, real_t &r_max) const {
 
-	for (int i = 0; i < 3; i++) {
-
-		Vector3 v = p_transform.xform(vertex[i]);
-		real_t d = p_normal.dot(v);
+	Vector3 local_normal = p_transform.basis.xform_inv(p_normal);
 
-		if (i == 0 || d > r_max)
-			r_max = d;
+	real_t d0 = local_normal.dot(vertex[0]);
+	real_t d1 = local_normal.dot(vertex[1]);
+	real_t d2 = local_normal.dot(vertex[2]);
 
-		if (i == 0 || d < r_min)
-			r_min = d;
-	}
+	real_t distance = p_normal.dot(p_transform.origin);
+	r_min = MIN(d0, MIN(d1, d2)) + distance;
+	r_max = MAX(d0, MAX(d1, d2)) + distance;
 }
 
 Vector3 FaceShapeSW::get_support(const Vector3 &p_normal) const {
@@ -1108,16 +1118,20 @@ FaceShapeSW::FaceShapeSW() {
 
 PoolVector<Vector3> ConcavePolygonShapeSW::get_faces() const {
 
+	int face_count = face_source.size();
+
 	PoolVector<Vector3> rfaces;
-	rfaces.resize(faces.size() * 3);
+	rfaces.resize(face_count * 3);
 
-	for (int i = 0; i < faces.size(); i++) {
+	PoolVector<Vector3>::Write w = rfaces.write();
 
-		Face f = faces.get(i);
+	for (int i = 0; i < face_count; i++) {
+
+		int src = face_source[i];
 
 		for (int j = 0; j < 3; j++) {
 
-			rfaces.set(i * 3 + j, vertices.get(f.indices[j]));
+			w[src * 3 + j] = face_vertices[j][i];
 		}
 	}
 
@@ -1126,133 +1140,150 @@ PoolVector<Vector3> ConcavePolygonShapeSW::get_faces() const {
 
 void ConcavePolygonShapeSW::project_range(const Vector3 &p_normal, const Transform &p_transform, real_t &r_min, real_t &r_max) const {
 
-	int count = vertices.size();
+	int count = face_source.size();
 	if (count == 0) {
 		r_min = 0;
 		r_max = 0;
 		return;
 	}
-	PoolVector<Vector3>::Read r = vertices.read();
-	const Vector3 *vptr = r.ptr();
 
-	for (int i = 0; i < count; i++) {
+	Vector3 local_normal = p_transform.basis.xform_inv(p_normal);
+
+	r_min = r_max = local_normal.dot(face_vertices[0][0]);
+
+	for (int j = 0; j < 3; j++) {
+
+		const Vector3 *vptr = face_vertices[j].ptr();
 
-		real_t d = p_normal.dot(p_transform.xform(vptr[i]));
+		for (int i = 0; i < count; i++) {
 
-		if (i == 0 || d > r_max)
-			r_max = d;
-		if (i == 0 || d < r_min)
-			r_min = d;
+			real_t d = local_normal.dot(vptr[i]);
+
+			r_max = MAX(r_max, d);
+			r_min = MIN(r_min, d);
+		}
 	}
+
+	real_t offset = p_normal.dot(p_transform.origin);
+	r_min += offset;
+	r_max += offset;
 }
 
 Vector3 ConcavePolygonShapeSW::get_support(const Vector3 &p_normal) const {
 
-	int count = vertices.size();
+	int count = face_source.size();
 	if (count == 0)
 		return Vector3();
 
-	PoolVector<Vector3>::Read r = vertices.read();
-	const Vector3 *vptr = r.ptr();
-
 	Vector3 n = p_normal;
 
-	int vert_support_idx = -1;
-	real_t support_max = 0;
+	Vector3 support = face_vertices[0][0];
+	real_t support_max = n.dot(support);
 
-	for (int i = 0; i < count; i++) {
+	for (int j = 0; j < 3; j++) {
 
-		real_t d = n.dot(vptr[i]);
+		const Vector3 *vptr = face_vertices[j].ptr();
 
-		if (i == 0 || d > support_max) {
-			support_max = d;
-			vert_support_idx = i;
+		for (int i = 0; i < count; i++) {
+
+			real_t d = n.dot(vptr[i]);
+
+			if (d > support_max) {
+				support_max = d;
+				support = vptr[i];
+			}
 		}
 	}
 
-	return vptr[vert_support_idx];
+	return support;
 }
 
-void ConcavePolygonShapeSW::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-
-	const BVH *bvh = &p_params->bvh[p_idx];
+bool ConcavePolygonShapeSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_result, Vector3 &r_normal) const {
 
-	/*
-	if (p_params->dir.dot(bvh->aabb.get_support(-p_params->dir))>p_params->min_d)
-		return; //test against whole AABB, which isn't very costly
-	*/
+	if (bvh.empty())
+		return false;
 
-	//printf("addr: %p\n",bvh);
-	if (!bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
+	Vector3 segment = p_end - p_begin;
+	real_t length = segment.length();
+	if (length == 0)
+		return false;
 
-		return;
+	Vector3 dir = segment / length;
+	Vector3 inv_segment;
+	for (int i = 0; i < 3; i++) {
+		// avoid infinities, 0 * inf would turn the slab test into NaN
+		inv_segment[i] = segment[i] != 0 ? 1.0 / segment[i] : 1e30;
 	}
 
-	if (bvh->face_index >= 0) {
+	const BVH *nodes = bvh.ptr();
+	const Vector3 *va = face_vertices[0].ptr();
+	const Vector3 *vb = face_vertices[1].ptr();
+	const Vector3 *vc = face_vertices[2].ptr();
 
-		Vector3 res;
-		Vector3 vertices[3] = {
-			p_params->vertices[p_params->faces[bvh->face_index].indices[0]],
-			p_params->vertices[p_params->faces[bvh->face_index].indices[1]],
-			p_params->vertices[p_params->faces[bvh->face_index].indices[2]]
-		};
+	real_t min_d = 1e20;
+	real_t max_t = 1.0; // min_d along the segment, used to skip farther nodes
+	int collisions = 0;
+	Vector3 result;
+	Vector3 normal;
 
-		if (Geometry::segment_intersects_triangle(
-					p_params->from,
-					p_params->to,
-					vertices[0],
-					vertices[1],
-					vertices[2],
-					&res)) {
-
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			//TODO, seems segmen/triangle intersection is broken :(
-			if (d > 0 && d < p_params->min_d) {
-
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = Plane(vertices[0], vertices[1], vertices[2]).normal;
-				p_params->collisions++;
-			}
-		}
+	int stack[CONCAVE_BVH_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
 
-	} else {
+	while (stack_size) {
 
-		if (bvh->left >= 0)
-			_cull_segment(bvh->left, p_params);
-		if (bvh->right >= 0)
-			_cull_segment(bvh->right, p_params);
-	}
-}
+		const BVH &node = nodes[stack[--stack_size]];
 
-bool ConcavePolygonShapeSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_result, Vector3 &r_normal) const {
+		for (int i = 0; i < 4; i++) {
 
-	if (faces.size() == 0)
-		return false;
+			if (node.child[i] < 0)
+				continue;
 
-	// unlock data
-	PoolVector<Face>::Read fr = faces.read();
-	PoolVector<Vector3>::Read vr = vertices.read();
-	PoolVector<BVH>::Read br = bvh.read();
+			real_t tx0 = (node.min_x[i] - p_begin.x) * inv_segment.x;
+			real_t tx1 = (node.max_x[i] - p_begin.x) * inv_segment.x;
+			real_t ty0 = (node.min_y[i] - p_begin.y) * inv_segment.y;
+			real_t ty1 = (node.max_y[i] - p_begin.y) * inv_segment.y;
+			real_t tz0 = (node.min_z[i] - p_begin.z) * inv_segment.z;
+			real_t tz1 = (node.max_z[i] - p_begin.z) * inv_segment.z;
 
-	_SegmentCullParams params;
-	params.from = p_begin;
-	params.to = p_end;
-	params.collisions = 0;
-	params.dir = (p_end - p_begin).normalized();
+			real_t t_enter = MAX(MAX(MIN(tx0, tx1), MIN(ty0, ty1)), MAX(MIN(tz0, tz1), (real_t)0.0));
+			real_t t_exit = MIN(MIN(MAX(tx0, tx1), MAX(ty0, ty1)), MIN(MAX(tz0, tz1), max_t));
 
-	params.faces = fr.ptr();
-	params.vertices = vr.ptr();
-	params.bvh = br.ptr();
+			if (t_enter > t_exit)
+				continue;
+
+			if (node.face_count[i] == 0) {
+				stack[stack_size++] = node.child[i];
+				continue;
+			}
+
+			int from = node.child[i];
+			int to = from + node.face_count[i];
 
-	params.min_d = 1e20;
-	// cull
-	_cull_segment(0, &params);
+			for (int j = from; j < to; j++) {
 
-	if (params.collisions > 0) {
+				Vector3 res;
 
-		r_result = params.result;
-		r_normal = params.normal;
+				if (Geometry::segment_intersects_triangle(p_begin, p_end, va[j], vb[j], vc[j], &res)) {
+
+					real_t d = dir.dot(res) - dir.dot(p_begin);
+					if (d > 0 && d < min_d) {
+
+						min_d = d;
+						max_t = d / length;
+						result = res;
+						normal = face_normals[j];
+						collisions++;
+					}
+				}
+			}
+		}
+	}
+
+	if (collisions > 0) {
+
+		r_result = result;
+		r_normal = normal;
 		return true;
 	} else {
 
@@ -1270,63 +1301,69 @@ Vector3 ConcavePolygonShapeSW::get_closest_point_to(const Vector3 &p_point) cons
 	return Vector3();
 }
 
-void ConcavePolygonShapeSW::_cull(int p_idx, _CullParams *p_params) const {
-
-	const BVH *bvh = &p_params->bvh[p_idx];
+void ConcavePolygonShapeSW::cull(const AABB &p_local_aabb, Callback p_callback, void *p_userdata) const {
 
-	if (!p_params->aabb.intersects(bvh->aabb))
+	// make matrix local to concave
+	if (bvh.empty())
 		return;
 
-	if (bvh->face_index >= 0) {
+	Vector3 aabb_min = p_local_aabb.position;
+	Vector3 aabb_max = p_local_aabb.position + p_local_aabb.size;
 
-		const Face *f = &p_params->faces[bvh->face_index];
-		FaceShapeSW *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		p_params->callback(p_params->userdata, face);
+	const BVH *nodes = bvh.ptr();
+	const Vector3 *va = face_vertices[0].ptr();
+	const Vector3 *vb = face_vertices[1].ptr();
+	const Vector3 *vc = face_vertices[2].ptr();
+	const Vector3 *normals = face_normals.ptr();
 
-	} else {
+	FaceShapeSW face; // use this to send in the callback
 
-		if (bvh->left >= 0) {
+	int stack[CONCAVE_BVH_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
 
-			_cull(bvh->left, p_params);
-		}
+	while (stack_size) {
 
-		if (bvh->right >= 0) {
+		const BVH &node = nodes[stack[--stack_size]];
 
-			_cull(bvh->right, p_params);
-		}
-	}
-}
+		for (int i = 0; i < 4; i++) {
 
-void ConcavePolygonShapeSW::cull(const AABB &p_local_aabb, Callback p_callback, void *p_userdata) const {
+			if (node.child[i] < 0)
+				continue;
 
-	// make matrix local to concave
-	if (faces.size() == 0)
-		return;
+			// same rules as AABB::intersects()
+			if (aabb_min.x >= node.max_x[i] || aabb_max.x <= node.min_x[i] ||
+					aabb_min.y >= node.max_y[i] || aabb_max.y <= node.min_y[i] ||
+					aabb_min.z >= node.max_z[i] || aabb_max.z <= node.min_z[i])
+				continue;
+
+			if (node.face_count[i] == 0) {
+				stack[stack_size++] = node.child[i];
+				continue;
+			}
 
-	AABB local_aabb = p_local_aabb;
+			int from = node.child[i];
+			int to = from + node.face_count[i];
 
-	// unlock data
-	PoolVector<Face>::Read fr = faces.read();
-	PoolVector<Vector3>::Read vr = vertices.read();
-	PoolVector<BVH>::Read br = bvh.read();
+			for (int j = from; j < to; j++) {
 
-	FaceShapeSW face; // use this to send in the callback
+				const Vector3 &a = va[j];
+				const Vector3 &b = vb[j];
+				const Vector3 &c = vc[j];
 
-	_CullParams params;
-	params.aabb = local_aabb;
-	params.face = &face;
-	params.faces = fr.ptr();
-	params.vertices = vr.ptr();
-	params.bvh = br.ptr();
-	params.callback = p_callback;
-	params.userdata = p_userdata;
+				if (aabb_min.x >= MAX(MAX(a.x, b.x), c.x) || aabb_max.x <= MIN(MIN(a.x, b.x), c.x) ||
+						aabb_min.y >= MAX(MAX(a.y, b.y), c.y) || aabb_max.y <= MIN(MIN(a.y, b.y), c.y) ||
+						aabb_min.z >= MAX(MAX(a.z, b.z), c.z) || aabb_max.z <= MIN(MIN(a.z, b.z), c.z))
+					continue;
 
-	// cull
-	_cull(0, &params);
+				face.normal = normals[j];
+				face.vertex[0] = a;
+				face.vertex[1] = b;
+				face.vertex[2] = c;
+				p_callback(p_userdata, &face);
+			}
+		}
+	}
 }
 
 Vector3 ConcavePolygonShapeSW::get_moment_of_inertia(real_t p_mass) const {
@@ -1371,42 +1408,19 @@ struct _VolumeSW_BVH_CompareZ {
 	}
 };
 
-struct _VolumeSW_BVH {
-
-	AABB aabb;
-	_VolumeSW_BVH *left;
-	_VolumeSW_BVH *right;
-
-	int face_index;
-};
-
-_VolumeSW_BVH *_volume_sw_build_bvh(_VolumeSW_BVH_Element *p_elements, int p_size, int &count) {
+static AABB _volume_sw_bvh_get_aabb(const _VolumeSW_BVH_Element *p_elements, int p_size) {
 
-	_VolumeSW_BVH *bvh = memnew(_VolumeSW_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = NULL;
-		bvh->right = NULL;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-
-		bvh->face_index = -1;
+	AABB aabb = p_elements[0].aabb;
+	for (int i = 1; i < p_size; i++) {
+		aabb.merge_with(p_elements[i].aabb);
 	}
 
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
+	return aabb;
+}
 
-		if (i == 0)
-			aabb = p_elements[i].aabb;
-		else
-			aabb.merge_with(p_elements[i].aabb);
-	}
-	bvh->aabb = aabb;
-	switch (aabb.get_longest_axis_index()) {
+static void _volume_sw_bvh_sort(_VolumeSW_BVH_Element *p_elements, int p_size) {
+
+	switch (_volume_sw_bvh_get_aabb(p_elements, p_size).get_longest_axis_index()) {
 
 		case 0: {
 
@@ -1425,47 +1439,103 @@ _VolumeSW_BVH *_volume_sw_build_bvh(_VolumeSW_BVH_Element *p_elements, int p_siz
 			sort_z.sort(p_elements, p_size);
 		} break;
 	}
+}
 
-	int split = p_size / 2;
-	bvh->left = _volume_sw_build_bvh(p_elements, split, count);
-	bvh->right = _volume_sw_build_bvh(&p_elements[split], p_size - split, count);
+int ConcavePolygonShapeSW::_build_bvh(_VolumeSW_BVH_Element *p_elements, int p_size, int p_offset) {
 
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
-}
+	// split in halves twice, which gives up to four children per node
+	int child_begin[4];
+	int child_size[4];
+	int child_count = 0;
 
-void ConcavePolygonShapeSW::_fill_bvh(_VolumeSW_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
+	if (p_size <= CONCAVE_BVH_LEAF_FACES) {
 
-	int idx = p_idx;
+		child_begin[0] = 0;
+		child_size[0] = p_size;
+		child_count = 1;
+	} else {
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+		_volume_sw_bvh_sort(p_elements, p_size);
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+		int half = p_size / 2;
+		int half_begin[2] = { 0, half };
+		int half_size[2] = { half, p_size - half };
 
-	} else {
+		for (int i = 0; i < 2; i++) {
+
+			if (half_size[i] > CONCAVE_BVH_LEAF_FACES) {
+
+				_volume_sw_bvh_sort(&p_elements[half_begin[i]], half_size[i]);
 
-		p_bvh_array[p_idx].left = -1;
+				int quarter = half_size[i] / 2;
+				child_begin[child_count] = half_begin[i];
+				child_size[child_count] = quarter;
+				child_count++;
+				child_begin[child_count] = half_begin[i] + quarter;
+				child_size[child_count] = half_size[i] - quarter;
+				child_count++;
+			} else {
+
+				child_begin[child_count] = half_begin[i];
+				child_size[child_count] = half_size[i];
+				child_count++;
+			}
+		}
 	}
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
+	BVH node;
 
-	} else {
+	for (int i = 0; i < 4; i++) {
+
+		if (i >= child_count) {
+			// empty lanes never pass a bounds test
+			node.min_x[i] = node.min_y[i] = node.min_z[i] = 1e20;
+			node.max_x[i] = node.max_y[i] = node.max_z[i] = -1e20;
+			node.child[i] = -1;
+			node.face_count[i] = 0;
+			continue;
+		}
 
-		p_bvh_array[p_idx].right = -1;
+		AABB aabb = _volume_sw_bvh_get_aabb(&p_elements[child_begin[i]], child_size[i]);
+		node.min_x[i] = aabb.position.x;
+		node.min_y[i] = aabb.position.y;
+		node.min_z[i] = aabb.position.z;
+		node.max_x[i] = aabb.position.x + aabb.size.x;
+		node.max_y[i] = aabb.position.y + aabb.size.y;
+		node.max_z[i] = aabb.position.z + aabb.size.z;
+
+		if (child_size[i] <= CONCAVE_BVH_LEAF_FACES) {
+			node.child[i] = p_offset + child_begin[i];
+			node.face_count[i] = child_size[i];
+		} else {
+			node.child[i] = -1; // filled below, once the subtree exists
+			node.face_count[i] = 0;
+		}
 	}
 
-	memdelete(p_bvh_tree);
+	int idx = bvh.size();
+	bvh.push_back(node);
+
+	for (int i = 0; i < child_count; i++) {
+
+		if (child_size[i] > CONCAVE_BVH_LEAF_FACES) {
+			int child = _build_bvh(&p_elements[child_begin[i]], child_size[i], p_offset + child_begin[i]);
+			bvh.write[idx].child[i] = child;
+		}
+	}
+
+	return idx;
 }
 
 void ConcavePolygonShapeSW::_setup(PoolVector<Vector3> p_faces) {
 
+	bvh.clear();
+	for (int i = 0; i < 3; i++) {
+		face_vertices[i].clear();
+	}
+	face_normals.clear();
+	face_source.clear();
+
 	int src_face_count = p_faces.size();
 	if (src_face_count == 0) {
 		configure(AABB());
@@ -1477,20 +1547,9 @@ void ConcavePolygonShapeSW::_setup(PoolVector<Vector3> p_faces) {
 	PoolVector<Vector3>::Read r = p_faces.read();
 	const Vector3 *facesr = r.ptr();
 
-	PoolVector<_VolumeSW_BVH_Element> bvh_array;
+	Vector<_VolumeSW_BVH_Element> bvh_array;
 	bvh_array.resize(src_face_count);
-
-	PoolVector<_VolumeSW_BVH_Element>::Write bvhw = bvh_array.write();
-	_VolumeSW_BVH_Element *bvh_arrayw = bvhw.ptr();
-
-	faces.resize(src_face_count);
-	PoolVector<Face>::Write w = faces.write();
-	Face *facesw = w.ptr();
-
-	vertices.resize(src_face_count * 3);
-
-	PoolVector<Vector3>::Write vw = vertices.write();
-	Vector3 *verticesw = vw.ptr();
+	_VolumeSW_BVH_Element *bvh_arrayw = bvh_array.ptrw();
 
 	AABB _aabb;
 
@@ -1501,32 +1560,38 @@ void ConcavePolygonShapeSW::_setup(PoolVector<Vector3> p_faces) {
 		bvh_arrayw[i].aabb = face.get_aabb();
 		bvh_arrayw[i].center = bvh_arrayw[i].aabb.position + bvh_arrayw[i].aabb.size * 0.5;
 		bvh_arrayw[i].face_index = i;
-		facesw[i].indices[0] = i * 3 + 0;
-		facesw[i].indices[1] = i * 3 + 1;
-		facesw[i].indices[2] = i * 3 + 2;
-		facesw[i].normal = face.get_plane().normal;
-		verticesw[i * 3 + 0] = face.vertex[0];
-		verticesw[i * 3 + 1] = face.vertex[1];
-		verticesw[i * 3 + 2] = face.vertex[2];
 		if (i == 0)
 			_aabb = bvh_arrayw[i].aabb;
 		else
 			_aabb.merge_with(bvh_arrayw[i].aabb);
 	}
 
-	w.release();
-	vw.release();
+	// sorts the elements into leaf order
+	_build_bvh(bvh_arrayw, src_face_count, 0);
 
-	int count = 0;
-	_VolumeSW_BVH *bvh_tree = _volume_sw_build_bvh(bvh_arrayw, src_face_count, count);
+	for (int i = 0; i < 3; i++) {
+		face_vertices[i].resize(src_face_count);
+	}
+	face_normals.resize(src_face_count);
+	face_source.resize(src_face_count);
 
-	bvh.resize(count + 1);
+	Vector3 *vaw = face_vertices[0].ptrw();
+	Vector3 *vbw = face_vertices[1].ptrw();
+	Vector3 *vcw = face_vertices[2].ptrw();
+	Vector3 *normalsw = face_normals.ptrw();
+	int *sourcew = face_source.ptrw();
 
-	PoolVector<BVH>::Write bvhw2 = bvh.write();
-	BVH *bvh_arrayw2 = bvhw2.ptr();
+	for (int i = 0; i < src_face_count; i++) {
 
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+		int src = bvh_arrayw[i].face_index;
+		Face3 face(facesr[src * 3 + 0], facesr[src * 3 + 1], facesr[src * 3 + 2]);
+
+		vaw[i] = face.vertex[0];
+		vbw[i] = face.vertex[1];
+		vcw[i] = face.vertex[2];
+		normalsw[i] = face.get_plane().normal;
+		sourcew[i] = src;
+	}
 
 	configure(_aabb); // this type of shape has no margin
 }
@@ -1575,11 +1640,193 @@ Vector3 HeightMapShapeSW::get_support(const Vector3 &p_normal) const {
 	return get_aabb().get_support(p_normal);
 }
 
-bool HeightMapShapeSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+void HeightMapShapeSW::_get_cell_faces(const real_t *p_heights, int p_x, int p_z, Vector3 r_faces[2][3]) const {
+
+	// same split as Bullet, both faces point up
+	Vector3 p00 = _get_point(p_heights, p_x, p_z);
+	Vector3 p10 = _get_point(p_heights, p_x + 1, p_z);
+	Vector3 p01 = _get_point(p_heights, p_x, p_z + 1);
+	Vector3 p11 = _get_point(p_heights, p_x + 1, p_z + 1);
+
+	r_faces[0][0] = p00;
+	r_faces[0][1] = p11;
+	r_faces[0][2] = p01;
+
+	r_faces[1][0] = p00;
+	r_faces[1][1] = p10;
+	r_faces[1][2] = p11;
+}
+
+bool HeightMapShapeSW::_intersect_cell(int p_x, int p_z, _SegmentParams *p_params) const {
+
+	Vector3 faces[2][3];
+	_get_cell_faces(p_params->heights, p_x, p_z, faces);
+
+	real_t min_d = 1e20;
+	bool collided = false;
+
+	for (int i = 0; i < 2; i++) {
+
+		Vector3 res;
+		if (!Geometry::segment_intersects_triangle(p_params->from, p_params->to, faces[i][0], faces[i][1], faces[i][2], &res))
+			continue;
+
+		real_t d = p_params->dir.dot(res - p_params->from);
+		if (d > 0 && d < min_d) {
+
+			min_d = d;
+			p_params->result = res;
+			p_params->normal = Plane(faces[i][0], faces[i][1], faces[i][2]).normal;
+			collided = true;
+		}
+	}
+
+	return collided;
+}
+
+bool HeightMapShapeSW::_intersect_tile(int p_x, int p_z, real_t p_t0, real_t p_t1, _SegmentParams *p_params) const {
+
+	int cells_x = width - 1;
+	int cells_z = depth - 1;
+
+	int begin_x = p_x * HEIGHTMAP_TILE_CELLS;
+	int begin_z = p_z * HEIGHTMAP_TILE_CELLS;
+	int end_x = MIN(begin_x + HEIGHTMAP_TILE_CELLS, cells_x);
+	int end_z = MIN(begin_z + HEIGHTMAP_TILE_CELLS, cells_z);
+
+	const Vector3 &from = p_params->grid_from;
+	const Vector3 &dir = p_params->grid_dir;
+
+	// walk the cells the segment crosses, in order, so the first hit is the closest
+	Vector3 start = from + dir * p_t0;
+	int x = CLAMP((int)Math::floor(start.x), begin_x, end_x - 1);
+	int z = CLAMP((int)Math::floor(start.z), begin_z, end_z - 1);
+
+	int step_x = dir.x > 0 ? 1 : -1;
+	int step_z = dir.z > 0 ? 1 : -1;
+	real_t t_max_x = dir.x != 0 ? (x + (step_x > 0 ? 1 : 0) - from.x) / dir.x : 1e30;
+	real_t t_max_z = dir.z != 0 ? (z + (step_z > 0 ? 1 : 0) - from.z) / dir.z : 1e30;
+	real_t t_delta_x = dir.x != 0 ? Math::abs(1.0 / dir.x) : 1e30;
+	real_t t_delta_z = dir.z != 0 ? Math::abs(1.0 / dir.z) : 1e30;
+
+	while (true) {
+
+		if (_intersect_cell(x, z, p_params))
+			return true;
+
+		if (t_max_x < t_max_z) {
+			if (t_max_x > p_t1)
+				break;
+			x += step_x;
+			t_max_x += t_delta_x;
+		} else {
+			if (t_max_z > p_t1)
+				break;
+			z += step_z;
+			t_max_z += t_delta_z;
+		}
+
+		if (x < begin_x || x >= end_x || z < begin_z || z >= end_z)
+			break;
+	}
+
+	return false;
+}
+
+static _FORCE_INLINE_ bool _heightmap_clip_segment(const Vector3 &p_from, const Vector3 &p_dir, real_t p_min_x, real_t p_min_z, real_t p_max_x, real_t p_max_z, real_t &r_t0, real_t &r_t1) {
+
+	real_t t0 = 0;
+	real_t t1 = 1;
+
+	for (int i = 0; i < 3; i += 2) {
+
+		real_t min = i == 0 ? p_min_x : p_min_z;
+		real_t max = i == 0 ? p_max_x : p_max_z;
+
+		if (p_dir[i] == 0) {
+			if (p_from[i] < min || p_from[i] > max)
+				return false;
+			continue;
+		}
+
+		real_t ta = (min - p_from[i]) / p_dir[i];
+		real_t tb = (max - p_from[i]) / p_dir[i];
+		if (ta > tb)
+			SWAP(ta, tb);
+
+		t0 = MAX(t0, ta);
+		t1 = MIN(t1, tb);
+		if (t0 > t1)
+			return false;
+	}
+
+	r_t0 = t0;
+	r_t1 = t1;
+	return true;
+}
+
+bool HeightMapShapeSW::_intersect_node(int p_level, int p_x, int p_z, _SegmentParams *p_params) const {
+
+	const Level &level = levels[p_level];
+	if (p_x >= level.width || p_z >= level.depth)
+		return false;
+
+	int size = HEIGHTMAP_TILE_CELLS << p_level;
+
+	real_t t0, t1;
+	if (!_heightmap_clip_segment(p_params->grid_from, p_params->grid_dir, p_x * size, p_z * size, MIN((p_x + 1) * size, width - 1), MIN((p_z + 1) * size, depth - 1), t0, t1))
+		return false;
+
+	// the segment is above or below everything in this node
+	real_t y0 = p_params->grid_from.y + p_params->grid_dir.y * t0;
+	real_t y1 = p_params->grid_from.y + p_params->grid_dir.y * t1;
+	const Vector2 &range = level.ranges[p_z * level.width + p_x];
+	if (MAX(y0, y1) < range.x || MIN(y0, y1) > range.y)
+		return false;
+
+	if (p_level == 0)
+		return _intersect_tile(p_x, p_z, t0, t1, p_params);
+
+	// visit the child where the segment enters first and the opposite one last, so the first hit is the closest
+	int near_x = p_params->grid_dir.x < 0 ? 1 : 0;
+	int near_z = p_params->grid_dir.z < 0 ? 1 : 0;
+	const int order[4][2] = { { near_x, near_z }, { 1 - near_x, near_z }, { near_x, 1 - near_z }, { 1 - near_x, 1 - near_z } };
+
+	for (int i = 0; i < 4; i++) {
+
+		if (_intersect_node(p_level - 1, p_x * 2 + order[i][0], p_z * 2 + order[i][1], p_params))
+			return true;
+	}
 
 	return false;
 }
 
+bool HeightMapShapeSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+
+	if (levels.empty() || p_begin == p_end)
+		return false;
+
+	PoolVector<real_t>::Read r = heights.read();
+
+	_SegmentParams params;
+	params.from = p_begin;
+	params.to = p_end;
+	params.dir = (p_end - p_begin).normalized();
+	params.heights = r.ptr();
+
+	Vector3 scale(1.0 / cell_size, 1.0, 1.0 / cell_size);
+	params.grid_from = (p_begin - local_origin) * scale;
+	params.grid_from.y = p_begin.y;
+	params.grid_dir = (p_end - p_begin) * scale;
+
+	if (!_intersect_node(levels.size() - 1, 0, 0, &params))
+		return false;
+
+	r_point = params.result;
+	r_normal = params.normal;
+	return true;
+}
+
 bool HeightMapShapeSW::intersect_point(const Vector3 &p_point) const {
 	return false;
 }
@@ -1589,7 +1836,88 @@ Vector3 HeightMapShapeSW::get_closest_point_to(const Vector3 &p_point) const {
 	return Vector3();
 }
 
+void HeightMapShapeSW::_cull_node(int p_level, int p_x, int p_z, _CullParams *p_params) const {
+
+	const Level &level = levels[p_level];
+	if (p_x >= level.width || p_z >= level.depth)
+		return;
+
+	int size = HEIGHTMAP_TILE_CELLS << p_level;
+	int begin_x = MAX(p_x * size, p_params->cell_from_x);
+	int begin_z = MAX(p_z * size, p_params->cell_from_z);
+	int end_x = MIN((p_x + 1) * size - 1, p_params->cell_to_x);
+	int end_z = MIN((p_z + 1) * size - 1, p_params->cell_to_z);
+	if (begin_x > end_x || begin_z > end_z)
+		return;
+
+	const Vector2 &range = level.ranges[p_z * level.width + p_x];
+	real_t aabb_min_y = p_params->aabb.position.y;
+	real_t aabb_max_y = p_params->aabb.position.y + p_params->aabb.size.y;
+	if (aabb_max_y < range.x || aabb_min_y > range.y)
+		return;
+
+	if (p_level > 0) {
+
+		for (int i = 0; i < 4; i++) {
+			_cull_node(p_level - 1, p_x * 2 + (i & 1), p_z * 2 + (i >> 1), p_params);
+		}
+		return;
+	}
+
+	FaceShapeSW *face = p_params->face;
+
+	for (int z = begin_z; z <= end_z; z++) {
+
+		for (int x = begin_x; x <= end_x; x++) {
+
+			Vector3 faces[2][3];
+			_get_cell_faces(p_params->heights, x, z, faces);
+
+			for (int i = 0; i < 2; i++) {
+
+				real_t face_min_y = MIN(MIN(faces[i][0].y, faces[i][1].y), faces[i][2].y);
+				real_t face_max_y = MAX(MAX(faces[i][0].y, faces[i][1].y), faces[i][2].y);
+				if (aabb_max_y < face_min_y || aabb_min_y > face_max_y)
+					continue;
+
+				face->normal = Plane(faces[i][0], faces[i][1], faces[i][2]).normal;
+				face->vertex[0] = faces[i][0];
+				face->vertex[1] = faces[i][1];
+				face->vertex[2] = faces[i][2];
+				p_params->callback(p_params->userdata, face);
+			}
+		}
+	}
+}
+
 void HeightMapShapeSW::cull(const AABB &p_local_aabb, Callback p_callback, void *p_userdata) const {
+
+	if (levels.empty())
+		return;
+
+	// cells touched by the AABB
+	Vector3 from = (p_local_aabb.position - local_origin) / cell_size;
+	Vector3 to = (p_local_aabb.position + p_local_aabb.size - local_origin) / cell_size;
+
+	_CullParams params;
+	params.cell_from_x = MAX((int)Math::floor(from.x), 0);
+	params.cell_from_z = MAX((int)Math::floor(from.z), 0);
+	params.cell_to_x = MIN((int)Math::floor(to.x), width - 2);
+	params.cell_to_z = MIN((int)Math::floor(to.z), depth - 2);
+	if (params.cell_from_x > params.cell_to_x || params.cell_from_z > params.cell_to_z)
+		return;
+
+	PoolVector<real_t>::Read r = heights.read();
+
+	FaceShapeSW face; // use this to send in the callback
+
+	params.aabb = p_local_aabb;
+	params.callback = p_callback;
+	params.userdata = p_userdata;
+	params.heights = r.ptr();
+	params.face = &face;
+
+	_cull_node(levels.size() - 1, 0, 0, &params);
 }
 
 Vector3 HeightMapShapeSW::get_moment_of_inertia(real_t p_mass) const {
@@ -1603,46 +1931,180 @@ Vector3 HeightMapShapeSW::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.y * extents.y + extents.y * extents.y));
 }
 
+void HeightMapShapeSW::_update_ranges(int p_from_x, int p_from_z, int p_to_x, int p_to_z) {
+
+	if (levels.empty())
+		return;
+
+	PoolVector<real_t>::Read r = heights.read();
+
+	// a sample belongs to the cells on both of its sides
+	int tile_from_x = MAX(p_from_x - 1, 0) / HEIGHTMAP_TILE_CELLS;
+	int tile_from_z = MAX(p_from_z - 1, 0) / HEIGHTMAP_TILE_CELLS;
+	int tile_to_x = MIN(p_to_x / HEIGHTMAP_TILE_CELLS, levels[0].width - 1);
+	int tile_to_z = MIN(p_to_z / HEIGHTMAP_TILE_CELLS, levels[0].depth - 1);
+
+	Level &base = levels.write[0];
+	Vector2 *base_ranges = base.ranges.ptrw();
+
+	for (int tz = tile_from_z; tz <= tile_to_z; tz++) {
+
+		for (int tx = tile_from_x; tx <= tile_to_x; tx++) {
+
+			int begin_x = tx * HEIGHTMAP_TILE_CELLS;
+			int begin_z = tz * HEIGHTMAP_TILE_CELLS;
+			int end_x = MIN(begin_x + HEIGHTMAP_TILE_CELLS, width - 1);
+			int end_z = MIN(begin_z + HEIGHTMAP_TILE_CELLS, depth - 1);
+
+			Vector2 range(r[begin_z * width + begin_x], r[begin_z * width + begin_x]);
+
+			for (int z = begin_z; z <= end_z; z++) {
+
+				const real_t *row = &r[z * width];
+				for (int x = begin_x; x <= end_x; x++) {
+					range.x = MIN(range.x, row[x]);
+					range.y = MAX(range.y, row[x]);
+				}
+			}
+
+			base_ranges[tz * base.width + tx] = range;
+		}
+	}
+
+	for (int i = 1; i < levels.size(); i++) {
+
+		tile_from_x /= 2;
+		tile_from_z /= 2;
+		tile_to_x /= 2;
+		tile_to_z /= 2;
+
+		const Level &child = levels[i - 1];
+		Level &level = levels.write[i];
+		Vector2 *ranges = level.ranges.ptrw();
+
+		for (int tz = tile_from_z; tz <= tile_to_z; tz++) {
+
+			for (int tx = tile_from_x; tx <= tile_to_x; tx++) {
+
+				Vector2 range = child.ranges[(tz * 2) * child.width + tx * 2];
+
+				for (int j = 1; j < 4; j++) {
+
+					int cx = tx * 2 + (j & 1);
+					int cz = tz * 2 + (j >> 1);
+					if (cx >= child.width || cz >= child.depth)
+						continue;
+
+					const Vector2 &child_range = child.ranges[cz * child.width + cx];
+					range.x = MIN(range.x, child_range.x);
+					range.y = MAX(range.y, child_range.y);
+				}
+
+				ranges[tz * level.width + tx] = range;
+			}
+		}
+	}
+}
+
+void HeightMapShapeSW::_update_aabb() {
+
+	AABB aabb;
+	aabb.position = local_origin;
+	aabb.size = Vector3((width - 1) * cell_size, 0, (depth - 1) * cell_size);
+
+	if (levels.size()) {
+		const Vector2 &range = levels[levels.size() - 1].ranges[0];
+		aabb.position.y = range.x;
+		aabb.size.y = range.y - range.x;
+	} else if (heights.size()) {
+		PoolVector<real_t>::Read r = heights.read();
+		aabb.position.y = r[0];
+	}
+
+	configure(aabb);
+}
+
 void HeightMapShapeSW::_setup(PoolVector<real_t> p_heights, int p_width, int p_depth, real_t p_cell_size) {
 
 	heights = p_heights;
 	width = p_width;
 	depth = p_depth;
 	cell_size = p_cell_size;
+	local_origin = Vector3((width - 1) * cell_size * -0.5, 0, (depth - 1) * cell_size * -0.5);
 
-	PoolVector<real_t>::Read r = heights.read();
+	levels.clear();
 
-	AABB aabb;
+	int cells_x = width - 1;
+	int cells_z = depth - 1;
+
+	if (cells_x > 0 && cells_z > 0) {
 
-	for (int i = 0; i < depth; i++) {
+		Level level;
+		level.width = (cells_x + HEIGHTMAP_TILE_CELLS - 1) / HEIGHTMAP_TILE_CELLS;
+		level.depth = (cells_z + HEIGHTMAP_TILE_CELLS - 1) / HEIGHTMAP_TILE_CELLS;
 
-		for (int j = 0; j < width; j++) {
+		while (true) {
 
-			real_t h = r[i * width + j];
+			level.ranges.resize(level.width * level.depth);
+			levels.push_back(level);
+
+			if (level.width == 1 && level.depth == 1)
+				break;
 
-			Vector3 pos(j * cell_size, h, i * cell_size);
-			if (i == 0 || j == 0)
-				aabb.position = pos;
-			else
-				aabb.expand_to(pos);
+			level.width = (level.width + 1) / 2;
+			level.depth = (level.depth + 1) / 2;
 		}
+
+		_update_ranges(0, 0, width - 1, depth - 1);
 	}
 
-	configure(aabb);
+	_update_aabb();
+}
+
+void HeightMapShapeSW::_update_region(const Rect2 &p_region, const PoolVector<real_t> &p_heights) {
+
+	int region_x = p_region.position.x;
+	int region_z = p_region.position.y;
+	int region_width = p_region.size.x;
+	int region_depth = p_region.size.y;
+
+	ERR_FAIL_COND(region_width <= 0);
+	ERR_FAIL_COND(region_depth <= 0);
+	ERR_FAIL_COND(region_x < 0 || region_z < 0);
+	ERR_FAIL_COND(region_x + region_width > width || region_z + region_depth > depth);
+	ERR_FAIL_COND(p_heights.size() != region_width * region_depth);
+
+	{
+		PoolVector<real_t>::Write w = heights.write();
+		PoolVector<real_t>::Read r = p_heights.read();
+
+		for (int z = 0; z < region_depth; z++) {
+			copymem(&w[(region_z + z) * width + region_x], &r[z * region_width], region_width * sizeof(real_t));
+		}
+	}
+
+	_update_ranges(region_x, region_z, region_x + region_width - 1, region_z + region_depth - 1);
+	_update_aabb();
 }
 
 void HeightMapShapeSW::set_data(const Variant &p_data) {
 
 	ERR_FAIL_COND(p_data.get_type() != Variant::DICTIONARY);
 	Dictionary d = p_data;
+	ERR_FAIL_COND(!d.has("heights"));
+
+	if (d.has("region")) {
+		// only replace the heights inside the region, keeping the rest of the map
+		_update_region(d["region"], d["heights"]);
+		return;
+	}
+
 	ERR_FAIL_COND(!d.has("width"));
 	ERR_FAIL_COND(!d.has("depth"));
-	ERR_FAIL_COND(!d.has("cell_size"));
-	ERR_FAIL_COND(!d.has("heights"));
 
 	int width = d["width"];
 	int depth = d["depth"];
-	real_t cell_size = d["cell_size"];
+	real_t cell_size = d.has("cell_size") ? real_t(d["cell_size"]) : real_t(1.0);
 	PoolVector<real_t> heights = d["heights"];
 
 	ERR_FAIL_COND(width <= 0);
@@ -1654,12 +2116,17 @@ void HeightMapShapeSW::set_data(const Variant &p_data) {
 
 Variant HeightMapShapeSW::get_data() const {
 
-	ERR_FAIL_V(Variant());
+	Dictionary d;
+	d["width"] = width;
+	d["depth"] = depth;
+	d["cell_size"] = cell_size;
+	d["heights"] = heights;
+	return d;
 }
 
 HeightMapShapeSW::HeightMapShapeSW() {
 
 	width = 0;
 	depth = 0;
-	cell_size = 0;
+	cell_size = 1.0;
 }
@@ -285,62 +285,34 @@ public:
 	ConvexPolygonShapeSW();
 };
 
-struct _VolumeSW_BVH;
+struct _VolumeSW_BVH_Element;
 struct FaceShapeSW;
 
 struct ConcavePolygonShapeSW : public ConcaveShapeSW {
 	// always a trimesh
 
-	struct Face {
-
-		Vector3 normal;
-		int indices[3];
-	};
-
-	PoolVector<Face> faces;
-	PoolVector<Vector3> vertices;
-
+	// 4-wide tree, child bounds are stored per axis so a node tests all its children at once
 	struct BVH {
 
-		AABB aabb;
-		int left;
-		int right;
-
-		int face_index;
-	};
-
-	PoolVector<BVH> bvh;
+		real_t min_x[4];
+		real_t min_y[4];
+		real_t min_z[4];
+		real_t max_x[4];
+		real_t max_y[4];
+		real_t max_z[4];
 
-	struct _CullParams {
-
-		AABB aabb;
-		Callback callback;
-		void *userdata;
-		const Face *faces;
-		const Vector3 *vertices;
-		const BVH *bvh;
-		FaceShapeSW *face;
+		int child[4]; // node index, or first face if face_count > 0, -1 if unused
+		int face_count[4];
 	};
 
-	struct _SegmentCullParams {
-
-		Vector3 from;
-		Vector3 to;
-		const Face *faces;
-		const Vector3 *vertices;
-		const BVH *bvh;
-		Vector3 dir;
-
-		Vector3 result;
-		Vector3 normal;
-		real_t min_d;
-		int collisions;
-	};
+	Vector<BVH> bvh;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	void _cull(int p_idx, _CullParams *p_params) const;
+	// faces in tree leaf order, leaves reference contiguous ranges
+	Vector<Vector3> face_vertices[3];
+	Vector<Vector3> face_normals;
+	Vector<int> face_source; // index of the face in the data it was set up from
 
-	void _fill_bvh(_VolumeSW_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
+	int _build_bvh(_VolumeSW_BVH_Element *p_elements, int p_size, int p_offset);
 
 	void _setup(PoolVector<Vector3> p_faces);
 
@@ -372,11 +344,60 @@ struct HeightMapShapeSW : public ConcaveShapeSW {
 	int width;
 	int depth;
 	real_t cell_size;
+	Vector3 local_origin; // first sample, the map is centered like in Bullet
+
+	// min/max heights of square tiles of cells, level 0 is the finest and each level above merges 2x2
+	struct Level {
+
+		int width;
+		int depth;
+		Vector<Vector2> ranges; // x is min, y is max
+	};
+
+	Vector<Level> levels;
+
+	struct _SegmentParams {
+
+		Vector3 from;
+		Vector3 to;
+		Vector3 dir;
+		Vector3 grid_from; // segment in cell units
+		Vector3 grid_dir;
+		const real_t *heights;
+
+		Vector3 result;
+		Vector3 normal;
+	};
+
+	struct _CullParams {
+
+		AABB aabb;
+		int cell_from_x;
+		int cell_from_z;
+		int cell_to_x;
+		int cell_to_z;
+		Callback callback;
+		void *userdata;
+		const real_t *heights;
+		FaceShapeSW *face;
+	};
+
+	_FORCE_INLINE_ Vector3 _get_point(const real_t *p_heights, int p_x, int p_z) const {
+		return local_origin + Vector3(p_x * cell_size, p_heights[p_z * width + p_x], p_z * cell_size);
+	}
+
+	_FORCE_INLINE_ void _get_cell_faces(const real_t *p_heights, int p_x, int p_z, Vector3 r_faces[2][3]) const;
+
+	bool _intersect_cell(int p_x, int p_z, _SegmentParams *p_params) const;
+	bool _intersect_tile(int p_x, int p_z, real_t p_t0, real_t p_t1, _SegmentParams *p_params) const;
+	bool _intersect_node(int p_level, int p_x, int p_z, _SegmentParams *p_params) const;
+	void _cull_node(int p_level, int p_x, int p_z, _CullParams *p_params) const;
 
-	//void _cull_segment(int p_idx,_SegmentCullParams *p_params) const;
-	//void _cull(int p_idx,_CullParams *p_params) const;
+	void _update_ranges(int p_from_x, int p_from_z, int p_to_x, int p_to_z);
+	void _update_aabb();
 
 	void _setup(PoolVector<real_t> p_heights, int p_width, int p_depth, real_t p_cell_size);
+	void _update_region(const Rect2 &p_region, const PoolVector<real_t> &p_heights);
 
 public:
 	PoolVector<real_t> get_heights() const;
@@ -31,6 +31,8 @@
 #include "space_sw.h"
 
 #include "collision_solver_sw.h"
+#include "core/frame_arena.h"
+#include "core/os/threaded_array_processor.h"
 #include "core/project_settings.h"
 #include "physics_server_sw.h"
 
@@ -49,7 +51,7 @@ _FORCE_INLINE_ static bool _can_collide_with(CollisionObjectSW *p_object, uint32
 	return true;
 }
 
-int PhysicsDirectSpaceStateSW::intersect_point(const Vector3 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+int PhysicsDirectSpaceStateSW::intersect_point(const Vector3 &p_point, ShapeResult *r_results, int p_result_max, const BTreeSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	ERR_FAIL_COND_V(space->locked, false);
 	int amount = space->broadphase->cull_point(p_point, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
@@ -93,9 +95,7 @@ int PhysicsDirectSpaceStateSW::intersect_point(const Vector3 &p_point, ShapeResu
 	return cc;
 }
 
-bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
-
-	ERR_FAIL_COND_V(space->locked, false);
+bool PhysicsDirectSpaceStateSW::_intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, CollisionObjectSW **r_query_results, int *r_query_subindex_results, const BTreeSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
 
 	Vector3 begin, end;
 	Vector3 normal;
@@ -103,7 +103,7 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_query_results, SpaceSW::INTERSECTION_QUERY_MAX, r_query_subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -115,18 +115,18 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 
 	for (int i = 0; i < amount; i++) {
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+		if (!_can_collide_with(r_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
 			continue;
 
-		if (p_pick_ray && !(space->intersection_query_results[i]->is_ray_pickable()))
+		if (p_pick_ray && !(r_query_results[i]->is_ray_pickable()))
 			continue;
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
+		if (p_exclude.has(r_query_results[i]->get_self()))
 			continue;
 
-		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
+		const CollisionObjectSW *col_obj = r_query_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_query_subindex_results[i];
 		Transform inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -171,12 +171,75 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 	return true;
 }
 
-int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const BTreeSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
+
+	ERR_FAIL_COND_V(space->locked, false);
+
+	return _intersect_ray(p_from, p_to, r_result, space->intersection_query_results, space->intersection_query_subindex_results, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, p_pick_ray);
+}
+
+void PhysicsDirectSpaceStateSW::_intersect_ray_batch(uint32_t p_batch, RayBatch *p_rays) {
+
+	//each job needs its own cull buffers, the ones in the space are shared
+	CollisionObjectSW **query_results = (CollisionObjectSW **)FrameArena::alloc(sizeof(CollisionObjectSW *) * SpaceSW::INTERSECTION_QUERY_MAX);
+	int *query_subindex_results = (int *)FrameArena::alloc(sizeof(int) * SpaceSW::INTERSECTION_QUERY_MAX);
+
+	int from = p_batch * RAY_BATCH_SIZE;
+	int to = MIN(from + RAY_BATCH_SIZE, p_rays->count);
+
+	for (int i = from; i < to; i++) {
+		if (!_intersect_ray(p_rays->from[i], p_rays->to[i], p_rays->results[i], query_results, query_subindex_results, *p_rays->exclude, p_rays->collision_mask, p_rays->collide_with_bodies, p_rays->collide_with_areas, false)) {
+			p_rays->results[i].shape = -1;
+		}
+	}
+
+	//released in reverse, so the next job on this thread reuses the same memory
+	FrameArena::release(query_subindex_results, sizeof(int) * SpaceSW::INTERSECTION_QUERY_MAX);
+	FrameArena::release(query_results, sizeof(CollisionObjectSW *) * SpaceSW::INTERSECTION_QUERY_MAX);
+}
+
+int PhysicsDirectSpaceStateSW::intersect_rays(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, const BTreeSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	if (p_count >= RAY_BATCH_THREADED_MIN && space->broadphase->supports_concurrent_queries()) {
+
+		RayBatch rays;
+		rays.from = p_from;
+		rays.to = p_to;
+		rays.results = r_results;
+		rays.count = p_count;
+		rays.exclude = &p_exclude;
+		rays.collision_mask = p_collision_mask;
+		rays.collide_with_bodies = p_collide_with_bodies;
+		rays.collide_with_areas = p_collide_with_areas;
+
+		thread_process_array((p_count + RAY_BATCH_SIZE - 1) / RAY_BATCH_SIZE, this, &PhysicsDirectSpaceStateSW::_intersect_ray_batch, &rays);
+
+	} else {
+
+		for (int i = 0; i < p_count; i++) {
+			if (!_intersect_ray(p_from[i], p_to[i], r_results[i], space->intersection_query_results, space->intersection_query_subindex_results, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, false)) {
+				r_results[i].shape = -1;
+			}
+		}
+	}
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_results[i].shape >= 0)
+			hits++;
+	}
+
+	return hits;
+}
+
+int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const BTreeSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	if (p_result_max <= 0)
 		return 0;
 
-	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
+	ShapeSW *shape = PhysicsServerSW::singleton->shape_owner.get(p_shape);
 	ERR_FAIL_COND_V(!shape, 0);
 
 	AABB aabb = p_xform.xform(shape->get_aabb());
@@ -222,9 +285,9 @@ int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transfo
 	return cc;
 }
 
-bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, ShapeRestInfo *r_info) {
+bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const BTreeSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, ShapeRestInfo *r_info) {
 
-	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
+	ShapeSW *shape = PhysicsServerSW::singleton->shape_owner.get(p_shape);
 	ERR_FAIL_COND_V(!shape, false);
 
 	AABB aabb = p_xform.xform(shape->get_aabb());
@@ -328,12 +391,12 @@ bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform
 	return true;
 }
 
-bool PhysicsDirectSpaceStateSW::collide_shape(RID p_shape, const Transform &p_shape_xform, real_t p_margin, Vector3 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+bool PhysicsDirectSpaceStateSW::collide_shape(RID p_shape, const Transform &p_shape_xform, real_t p_margin, Vector3 *r_results, int p_result_max, int &r_result_count, const BTreeSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	if (p_result_max <= 0)
 		return 0;
 
-	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
+	ShapeSW *shape = PhysicsServerSW::singleton->shape_owner.get(p_shape);
 	ERR_FAIL_COND_V(!shape, 0);
 
 	AABB aabb = p_shape_xform.xform(shape->get_aabb());
@@ -403,9 +466,9 @@ static void _rest_cbk_result(const Vector3 &p_point_A, const Vector3 &p_point_B,
 	rd->best_object = rd->object;
 	rd->best_shape = rd->shape;
 }
-bool PhysicsDirectSpaceStateSW::rest_info(RID p_shape, const Transform &p_shape_xform, real_t p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+bool PhysicsDirectSpaceStateSW::rest_info(RID p_shape, const Transform &p_shape_xform, real_t p_margin, ShapeRestInfo *r_info, const BTreeSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
-	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
+	ShapeSW *shape = PhysicsServerSW::singleton->shape_owner.get(p_shape);
 	ERR_FAIL_COND_V(!shape, 0);
 
 	AABB aabb = p_shape_xform.xform(shape->get_aabb());
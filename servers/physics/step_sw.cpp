@@ -32,6 +32,8 @@
 #include "joints_sw.h"
 
 #include "core/os/os.h"
+#include "core/os/threaded_array_processor.h"
+#include "core/project_settings.h"
 
 void StepSW::_populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **p_constraint_island) {
 
@@ -107,6 +109,97 @@ void StepSW::_solve_island(ConstraintSW *p_island, int p_iterations, real_t p_de
 	}
 }
 
+void StepSW::_solve_island_batch(uint32_t p_index, SolveJobs *p_jobs) {
+
+	int from = p_jobs->batches[p_index];
+	int to = p_jobs->batches[p_index + 1];
+
+	for (int i = from; i < to; i++) {
+		_solve_island(p_jobs->islands[i], p_jobs->iterations, p_jobs->delta);
+	}
+}
+
+bool StepSW::_solve_islands_threaded(ConstraintSW *p_island_list, int p_iterations, real_t p_delta) {
+
+	if (!threaded_solving) {
+		return false;
+	}
+
+	solve_jobs.islands.clear();
+	solve_jobs.batches.clear();
+
+	int total_constraints = 0;
+	int batch_constraints = 0;
+
+	for (ConstraintSW *ci = p_island_list; ci; ci = ci->get_island_list_next()) {
+
+		if (batch_constraints == 0) {
+			solve_jobs.batches.push_back(solve_jobs.islands.size());
+		}
+
+		solve_jobs.islands.push_back(ci);
+
+		for (ConstraintSW *c = ci; c; c = c->get_island_next()) {
+			batch_constraints++;
+			total_constraints++;
+		}
+
+		if (batch_constraints >= ISLAND_BATCH_MIN_CONSTRAINTS) {
+			batch_constraints = 0;
+		}
+	}
+
+	int batch_count = solve_jobs.batches.size();
+
+	if (batch_count < 2 || total_constraints < THREADED_SOLVE_MIN_CONSTRAINTS) {
+		return false; // not worth it, caller solves inline
+	}
+
+	solve_jobs.batches.push_back(solve_jobs.islands.size());
+	solve_jobs.iterations = p_iterations;
+	solve_jobs.delta = p_delta;
+
+	thread_process_array(batch_count, this, &StepSW::_solve_island_batch, &solve_jobs);
+
+	return true;
+}
+
+void StepSW::_prepare_constraint_batch(uint32_t p_index, PrepareJobs *p_jobs) {
+
+	int from = p_index * PREPARE_BATCH_SIZE;
+	int to = MIN(from + PREPARE_BATCH_SIZE, p_jobs->constraints.size());
+
+	for (int i = from; i < to; i++) {
+		p_jobs->constraints[i]->prepare(p_jobs->delta);
+	}
+}
+
+void StepSW::_prepare_constraints_threaded(ConstraintSW *p_island_list, real_t p_delta) {
+
+	if (!threaded_area_queries) {
+		return;
+	}
+
+	prepare_jobs.constraints.clear();
+
+	for (ConstraintSW *ci = p_island_list; ci; ci = ci->get_island_list_next()) {
+		for (ConstraintSW *c = ci; c; c = c->get_island_next()) {
+			if (c->has_threaded_prepare()) {
+				prepare_jobs.constraints.push_back(c);
+			}
+		}
+	}
+
+	int count = prepare_jobs.constraints.size();
+	if (count < THREADED_PREPARE_MIN_CONSTRAINTS) {
+		return; // setup tests them inline
+	}
+
+	prepare_jobs.delta = p_delta;
+
+	thread_process_array((count + PREPARE_BATCH_SIZE - 1) / PREPARE_BATCH_SIZE, this, &StepSW::_prepare_constraint_batch, &prepare_jobs);
+}
+
 void StepSW::_check_suspend(BodySW *p_island, real_t p_delta) {
 
 	bool can_sleep = true;
@@ -230,6 +323,9 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
+	// overlap tests of area pairs are independent, run them in parallel and let setup apply the results
+	_prepare_constraints_threaded(constraint_island_list, p_delta);
+
 	{
 		ConstraintSW *ci = constraint_island_list;
 		while (ci) {
@@ -247,7 +343,9 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
+	// islands share no dynamic bodies, so they can be solved on separate threads
+	// setup stays serial, as it reports contacts and updates area monitors
+	if (!_solve_islands_threaded(constraint_island_list, p_iterations, p_delta)) {
 		ConstraintSW *ci = constraint_island_list;
 		while (ci) {
 			//iterating each island separatedly improves cache efficiency
@@ -296,4 +394,6 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 StepSW::StepSW() {
 
 	_step = 1;
+	threaded_solving = GLOBAL_DEF("physics/3d/threaded_island_solving", true);
+	threaded_area_queries = GLOBAL_DEF("physics/3d/threaded_area_queries", true);
 }
@@ -35,11 +35,39 @@
 
 class StepSW {
 
+	enum {
+		ISLAND_BATCH_MIN_CONSTRAINTS = 32, // small islands are grouped until a job has at least this many constraints
+		THREADED_SOLVE_MIN_CONSTRAINTS = 256, // below this, starting threads costs more than it saves
+		THREADED_PREPARE_MIN_CONSTRAINTS = 128, // minimum area pairs before their overlap tests are threaded
+		PREPARE_BATCH_SIZE = 32 // area pairs tested per job
+	};
+
+	struct SolveJobs {
+		Vector<ConstraintSW *> islands;
+		Vector<int> batches; // first island of each job, followed by the island count
+		int iterations;
+		real_t delta;
+	};
+
+	struct PrepareJobs {
+		Vector<ConstraintSW *> constraints;
+		real_t delta;
+	};
+
 	uint64_t _step;
 
+	bool threaded_solving;
+	bool threaded_area_queries;
+	SolveJobs solve_jobs;
+	PrepareJobs prepare_jobs;
+
 	void _populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **p_constraint_island);
 	void _setup_island(ConstraintSW *p_island, real_t p_delta);
 	void _solve_island(ConstraintSW *p_island, int p_iterations, real_t p_delta);
+	void _solve_island_batch(uint32_t p_index, SolveJobs *p_jobs);
+	bool _solve_islands_threaded(ConstraintSW *p_island_list, int p_iterations, real_t p_delta);
+	void _prepare_constraint_batch(uint32_t p_index, PrepareJobs *p_jobs);
+	void _prepare_constraints_threaded(ConstraintSW *p_island_list, real_t p_delta);
 	void _check_suspend(BodySW *p_island, real_t p_delta);
 
 public:
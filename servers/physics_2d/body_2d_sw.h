@@ -204,18 +204,30 @@ public:
 		linear_velocity += p_impulse * _inv_mass;
 	}
 
+	// impulses leave static and kinematic bodies untouched, as islands sharing them can be solved at the same time
+
 	_FORCE_INLINE_ void apply_impulse(const Vector2 &p_offset, const Vector2 &p_impulse) {
 
+		if (mode <= Physics2DServer::BODY_MODE_KINEMATIC)
+			return;
+
 		linear_velocity += p_impulse * _inv_mass;
 		angular_velocity += _inv_inertia * p_offset.cross(p_impulse);
 	}
 
 	_FORCE_INLINE_ void apply_torque_impulse(real_t p_torque) {
+
+		if (mode <= Physics2DServer::BODY_MODE_KINEMATIC)
+			return;
+
 		angular_velocity += _inv_inertia * p_torque;
 	}
 
 	_FORCE_INLINE_ void apply_bias_impulse(const Vector2 &p_pos, const Vector2 &p_j) {
 
+		if (mode <= Physics2DServer::BODY_MODE_KINEMATIC)
+			return;
+
 		biased_linear_velocity += p_j * _inv_mass;
 		biased_angular_velocity += _inv_inertia * p_pos.cross(p_j);
 	}
@@ -33,87 +33,108 @@
 
 #define LARGE_ELEMENT_FI 1.01239812
 
+bool BroadPhase2DHashGrid::_is_large(const Rect2 &p_rect) const {
+
+	Vector2 sz = (p_rect.size / cell_size * LARGE_ELEMENT_FI); //use magic number to avoid floating point issues
+	return sz.width * sz.height > large_object_min_surface;
+}
+
 void BroadPhase2DHashGrid::_pair_attempt(Element *p_elem, Element *p_with) {
 
-	Map<Element *, PairData *>::Element *E = p_elem->paired.find(p_with);
+	PairData **E = p_elem->paired.lookup_ptr(p_with);
 
 	ERR_FAIL_COND(p_elem->_static && p_with->_static);
 
 	if (!E) {
 
 		PairData *pd = memnew(PairData);
-		p_elem->paired[p_with] = pd;
-		p_with->paired[p_elem] = pd;
+		p_elem->paired.insert(p_with, pd);
+		p_with->paired.insert(p_elem, pd);
 	} else {
-		E->get()->rc++;
+		(*E)->rc++;
 	}
 }
 
-void BroadPhase2DHashGrid::_unpair_attempt(Element *p_elem, Element *p_with) {
+void BroadPhase2DHashGrid::_remove_pair(Element *p_elem, Element *p_with, PairData *p_pair) {
+
+	if (p_pair->colliding) {
+		//uncollide
+		if (unpair_callback) {
+			unpair_callback(p_elem->owner, p_elem->subindex, p_with->owner, p_with->subindex, p_pair->ud, unpair_userdata);
+		}
+	}
 
-	Map<Element *, PairData *>::Element *E = p_elem->paired.find(p_with);
+	memdelete(p_pair);
+	p_elem->paired.remove(p_with);
+	p_with->paired.remove(p_elem);
+}
 
-	ERR_FAIL_COND(!E); //this should really be paired..
+void BroadPhase2DHashGrid::_unpair_attempt(Element *p_elem, Element *p_with) {
 
-	E->get()->rc--;
+	PairData **E = p_elem->paired.lookup_ptr(p_with);
 
-	if (E->get()->rc == 0) {
+	ERR_FAIL_COND(!E); //this should really be paired..
 
-		if (E->get()->colliding) {
-			//uncollide
-			if (unpair_callback) {
-				unpair_callback(p_elem->owner, p_elem->subindex, p_with->owner, p_with->subindex, E->get()->ud, unpair_userdata);
-			}
-		}
+	PairData *pd = *E;
+	pd->rc--;
 
-		memdelete(E->get());
-		p_elem->paired.erase(E);
-		p_with->paired.erase(p_elem);
+	if (pd->rc == 0) {
+		_remove_pair(p_elem, p_with, pd);
 	}
 }
 
 void BroadPhase2DHashGrid::_check_motion(Element *p_elem) {
 
-	for (Map<Element *, PairData *>::Element *E = p_elem->paired.front(); E; E = E->next()) {
+	for (PairMap::Iterator E = p_elem->paired.iter(); E.valid; E = p_elem->paired.next_iter(E)) {
 
-		bool pairing = p_elem->aabb.intersects(E->key()->aabb);
+		Element *with = *E.key;
+		PairData *pd = *E.value;
 
-		if (pairing != E->get()->colliding) {
+		bool pairing = p_elem->aabb.intersects(with->aabb);
+
+		if (pairing != pd->colliding) {
 
 			if (pairing) {
 
 				if (pair_callback) {
-					E->get()->ud = pair_callback(p_elem->owner, p_elem->subindex, E->key()->owner, E->key()->subindex, pair_userdata);
+					pd->ud = pair_callback(p_elem->owner, p_elem->subindex, with->owner, with->subindex, pair_userdata);
 				}
 			} else {
 
 				if (unpair_callback) {
-					unpair_callback(p_elem->owner, p_elem->subindex, E->key()->owner, E->key()->subindex, E->get()->ud, unpair_userdata);
+					unpair_callback(p_elem->owner, p_elem->subindex, with->owner, with->subindex, pd->ud, unpair_userdata);
 				}
 			}
 
-			E->get()->colliding = pairing;
+			pd->colliding = pairing;
 		}
 	}
 }
 
 void BroadPhase2DHashGrid::_enter_grid(Element *p_elem, const Rect2 &p_rect, bool p_static) {
 
-	Vector2 sz = (p_rect.size / cell_size * LARGE_ELEMENT_FI); //use magic number to avoid floating point issues
-	if (sz.width * sz.height > large_object_min_surface) {
+	if (_is_large(p_rect)) {
 		//large object, do not use grid, must check against all elements
-		for (Map<ID, Element>::Element *E = element_map.front(); E; E = E->next()) {
-			if (E->key() == p_elem->self)
+		for (OAHashMap<ID, Element *>::Iterator E = element_map.iter(); E.valid; E = element_map.next_iter(E)) {
+			Element *elem = *E.value;
+			if (elem == p_elem)
 				continue; // do not pair against itself
-			if (E->get().owner == p_elem->owner)
+			if (elem->owner == p_elem->owner)
 				continue;
-			if (E->get()._static && p_static)
+			if (elem->_static && p_static)
 				continue;
 
-			_pair_attempt(p_elem, &E->get());
+			_pair_attempt(p_elem, elem);
 		}
 
-		large_elements[p_elem].inc();
+		RC *rc = large_elements.lookup_ptr(p_elem);
+		if (rc) {
+			rc->inc();
+		} else {
+			RC new_rc;
+			new_rc.inc();
+			large_elements.insert(p_elem, new_rc);
+		}
 		return;
 	}
 
@@ -129,54 +150,50 @@ void BroadPhase2DHashGrid::_enter_grid(Element *p_elem, const Rect2 &p_rect, boo
 			pk.y = j;
 
 			uint32_t idx = pk.hash() % hash_table_size;
-			PosBin *pb = hash_table[idx];
-
-			while (pb) {
-
-				if (pb->key == pk) {
-					break;
-				}
-
-				pb = pb->next;
-			}
+			PosBin *pb = _find_bin(pk, idx);
 
 			bool entered = false;
 
 			if (!pb) {
 				//does not exist, create!
-				pb = memnew(PosBin);
+				if (bin_pool) {
+					pb = bin_pool;
+					bin_pool = pb->next;
+				} else {
+					pb = memnew(PosBin);
+				}
 				pb->key = pk;
 				pb->next = hash_table[idx];
 				hash_table[idx] = pb;
 			}
 
-			if (p_static) {
-				if (pb->static_object_set[p_elem].inc() == 1) {
-					entered = true;
-				}
+			ElementSet &set = p_static ? pb->static_object_set : pb->object_set;
+			RC *rc = set.lookup_ptr(p_elem);
+			if (rc) {
+				rc->inc();
 			} else {
-				if (pb->object_set[p_elem].inc() == 1) {
-
-					entered = true;
-				}
+				RC new_rc;
+				new_rc.inc();
+				set.insert(p_elem, new_rc);
+				entered = true;
 			}
 
 			if (entered) {
 
-				for (Map<Element *, RC>::Element *E = pb->object_set.front(); E; E = E->next()) {
+				for (ElementSet::Iterator E = pb->object_set.iter(); E.valid; E = pb->object_set.next_iter(E)) {
 
-					if (E->key()->owner == p_elem->owner)
+					if ((*E.key)->owner == p_elem->owner)
 						continue;
-					_pair_attempt(p_elem, E->key());
+					_pair_attempt(p_elem, *E.key);
 				}
 
 				if (!p_static) {
 
-					for (Map<Element *, RC>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
+					for (ElementSet::Iterator E = pb->static_object_set.iter(); E.valid; E = pb->static_object_set.next_iter(E)) {
 
-						if (E->key()->owner == p_elem->owner)
+						if ((*E.key)->owner == p_elem->owner)
 							continue;
-						_pair_attempt(p_elem, E->key());
+						_pair_attempt(p_elem, *E.key);
 					}
 				}
 			}
@@ -185,34 +202,41 @@ void BroadPhase2DHashGrid::_enter_grid(Element *p_elem, const Rect2 &p_rect, boo
 
 	//pair separatedly with large elements
 
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
+	for (ElementSet::Iterator E = large_elements.iter(); E.valid; E = large_elements.next_iter(E)) {
 
-		if (E->key() == p_elem)
+		Element *elem = *E.key;
+		if (elem == p_elem)
 			continue; // do not pair against itself
-		if (E->key()->owner == p_elem->owner)
+		if (elem->owner == p_elem->owner)
 			continue;
-		if (E->key()->_static && p_static)
+		if (elem->_static && p_static)
 			continue;
 
-		_pair_attempt(E->key(), p_elem);
+		_pair_attempt(elem, p_elem);
 	}
 }
 
 void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool p_static) {
 
-	Vector2 sz = (p_rect.size / cell_size * LARGE_ELEMENT_FI);
-	if (sz.width * sz.height > large_object_min_surface) {
+	if (_is_large(p_rect)) {
 
 		//unpair all elements, instead of checking all, just check what is already paired, so we at least save from checking static vs static
-		Map<Element *, PairData *>::Element *E = p_elem->paired.front();
-		while (E) {
-			Map<Element *, PairData *>::Element *next = E->next();
-			_unpair_attempt(p_elem, E->key());
-			E = next;
+		//(unpairing removes from the table being iterated, so gather first)
+		Vector<Element *> paired;
+		paired.resize(p_elem->paired.get_num_elements());
+		int pc = 0;
+		for (PairMap::Iterator E = p_elem->paired.iter(); E.valid; E = p_elem->paired.next_iter(E)) {
+			paired.write[pc++] = *E.key;
+		}
+
+		for (int i = 0; i < pc; i++) {
+			_unpair_attempt(p_elem, paired[i]);
 		}
 
-		if (large_elements[p_elem].dec() == 0) {
-			large_elements.erase(p_elem);
+		RC *rc = large_elements.lookup_ptr(p_elem);
+		ERR_FAIL_COND(!rc);
+		if (rc->dec() == 0) {
+			large_elements.remove(p_elem);
 		}
 		return;
 	}
@@ -229,51 +253,37 @@ void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool
 			pk.y = j;
 
 			uint32_t idx = pk.hash() % hash_table_size;
-			PosBin *pb = hash_table[idx];
-
-			while (pb) {
-
-				if (pb->key == pk) {
-					break;
-				}
-
-				pb = pb->next;
-			}
+			PosBin *pb = _find_bin(pk, idx);
 
 			ERR_CONTINUE(!pb); //should exist!!
 
 			bool exited = false;
 
-			if (p_static) {
-				if (pb->static_object_set[p_elem].dec() == 0) {
-
-					pb->static_object_set.erase(p_elem);
-					exited = true;
-				}
-			} else {
-				if (pb->object_set[p_elem].dec() == 0) {
+			ElementSet &set = p_static ? pb->static_object_set : pb->object_set;
+			RC *rc = set.lookup_ptr(p_elem);
+			ERR_CONTINUE(!rc); //should exist too
+			if (rc->dec() == 0) {
 
-					pb->object_set.erase(p_elem);
-					exited = true;
-				}
+				set.remove(p_elem);
+				exited = true;
 			}
 
 			if (exited) {
 
-				for (Map<Element *, RC>::Element *E = pb->object_set.front(); E; E = E->next()) {
+				for (ElementSet::Iterator E = pb->object_set.iter(); E.valid; E = pb->object_set.next_iter(E)) {
 
-					if (E->key()->owner == p_elem->owner)
+					if ((*E.key)->owner == p_elem->owner)
 						continue;
-					_unpair_attempt(p_elem, E->key());
+					_unpair_attempt(p_elem, *E.key);
 				}
 
 				if (!p_static) {
 
-					for (Map<Element *, RC>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
+					for (ElementSet::Iterator E = pb->static_object_set.iter(); E.valid; E = pb->static_object_set.next_iter(E)) {
 
-						if (E->key()->owner == p_elem->owner)
+						if ((*E.key)->owner == p_elem->owner)
 							continue;
-						_unpair_attempt(p_elem, E->key());
+						_unpair_attempt(p_elem, *E.key);
 					}
 				}
 			}
@@ -299,21 +309,87 @@ void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool
 					ERR_CONTINUE(!px);
 				}
 
-				memdelete(pb);
+				pb->next = bin_pool;
+				bin_pool = pb;
 			}
 		}
 	}
 
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
-		if (E->key() == p_elem)
+	for (ElementSet::Iterator E = large_elements.iter(); E.valid; E = large_elements.next_iter(E)) {
+
+		Element *elem = *E.key;
+		if (elem == p_elem)
 			continue; // do not pair against itself
-		if (E->key()->owner == p_elem->owner)
+		if (elem->owner == p_elem->owner)
 			continue;
-		if (E->key()->_static && p_static)
+		if (elem->_static && p_static)
 			continue;
 
 		//unpair from large elements
-		_unpair_attempt(p_elem, E->key());
+		_unpair_attempt(p_elem, elem);
+	}
+}
+
+void BroadPhase2DHashGrid::_rebuild_grid(int p_cell_size) {
+
+	//existing pairs are kept, so objects that keep overlapping don't get unpaired and paired again,
+	//only their shared cell counts are recomputed as the elements enter the new grid
+
+	for (OAHashMap<ID, Element *>::Iterator E = element_map.iter(); E.valid; E = element_map.next_iter(E)) {
+		Element *elem = *E.value;
+		for (PairMap::Iterator P = elem->paired.iter(); P.valid; P = elem->paired.next_iter(P)) {
+			(*P.value)->rc = 0;
+		}
+	}
+
+	for (uint32_t i = 0; i < hash_table_size; i++) {
+		while (hash_table[i]) {
+			PosBin *pb = hash_table[i];
+			hash_table[i] = pb->next;
+			pb->object_set.clear();
+			pb->static_object_set.clear();
+			pb->next = bin_pool;
+			bin_pool = pb;
+		}
+	}
+
+	large_elements.clear();
+
+	cell_size = p_cell_size;
+
+	//grid elements go in first, large ones last (as if they were added after everything else)
+	for (int l = 0; l < 2; l++) {
+		for (OAHashMap<ID, Element *>::Iterator E = element_map.iter(); E.valid; E = element_map.next_iter(E)) {
+			Element *elem = *E.value;
+			if (elem->aabb == Rect2() || _is_large(elem->aabb) != (l == 1))
+				continue;
+			_enter_grid(elem, elem->aabb, elem->_static);
+		}
+	}
+
+	//pairs that no longer share any cell are dropped
+	Vector<Element *> unpaired;
+	for (OAHashMap<ID, Element *>::Iterator E = element_map.iter(); E.valid; E = element_map.next_iter(E)) {
+
+		Element *elem = *E.value;
+
+		unpaired.clear();
+		for (PairMap::Iterator P = elem->paired.iter(); P.valid; P = elem->paired.next_iter(P)) {
+			if ((*P.value)->rc == 0) {
+				unpaired.push_back(*P.key);
+			}
+		}
+
+		for (int i = 0; i < unpaired.size(); i++) {
+			PairData *pd = NULL;
+			elem->paired.lookup(unpaired[i], pd);
+			_remove_pair(elem, unpaired[i], pd);
+		}
+	}
+
+	//new pairs may already be overlapping
+	for (OAHashMap<ID, Element *>::Iterator E = element_map.iter(); E.valid; E = element_map.next_iter(E)) {
+		_check_motion(*E.value);
 	}
 }
 
@@ -321,23 +397,31 @@ BroadPhase2DHashGrid::ID BroadPhase2DHashGrid::create(CollisionObject2DSW *p_obj
 
 	current++;
 
-	Element e;
-	e.owner = p_object;
-	e._static = false;
-	e.subindex = p_subindex;
-	e.self = current;
-	e.pass = 0;
+	Element *e;
+	if (element_pool.size()) {
+		e = element_pool[element_pool.size() - 1];
+		element_pool.resize(element_pool.size() - 1);
+	} else {
+		e = memnew(Element);
+	}
+
+	e->owner = p_object;
+	e->_static = false;
+	e->aabb = Rect2();
+	e->subindex = p_subindex;
+	e->self = current;
+	e->pass = 0;
 
-	element_map[current] = e;
+	element_map.insert(current, e);
 	return current;
 }
 
 void BroadPhase2DHashGrid::move(ID p_id, const Rect2 &p_aabb) {
 
-	Map<ID, Element>::Element *E = element_map.find(p_id);
+	Element **E = element_map.lookup_ptr(p_id);
 	ERR_FAIL_COND(!E);
 
-	Element &e = E->get();
+	Element &e = **E;
 
 	if (p_aabb == e.aabb)
 		return;
@@ -360,10 +444,10 @@ void BroadPhase2DHashGrid::move(ID p_id, const Rect2 &p_aabb) {
 }
 void BroadPhase2DHashGrid::set_static(ID p_id, bool p_static) {
 
-	Map<ID, Element>::Element *E = element_map.find(p_id);
+	Element **E = element_map.lookup_ptr(p_id);
 	ERR_FAIL_COND(!E);
 
-	Element &e = E->get();
+	Element &e = **E;
 
 	if (e._static == p_static)
 		return;
@@ -380,34 +464,41 @@ void BroadPhase2DHashGrid::set_static(ID p_id, bool p_static) {
 }
 void BroadPhase2DHashGrid::remove(ID p_id) {
 
-	Map<ID, Element>::Element *E = element_map.find(p_id);
+	Element **E = element_map.lookup_ptr(p_id);
 	ERR_FAIL_COND(!E);
 
-	Element &e = E->get();
+	Element *e = *E;
 
-	if (e.aabb != Rect2())
-		_exit_grid(&e, e.aabb, e._static);
+	if (e->aabb != Rect2())
+		_exit_grid(e, e->aabb, e->_static);
 
-	element_map.erase(p_id);
+	//large elements pair with everything, including elements that never entered the grid
+	while (!e->paired.empty()) {
+		PairMap::Iterator P = e->paired.iter();
+		_remove_pair(e, *P.key, *P.value);
+	}
+
+	element_map.remove(p_id);
+	element_pool.push_back(e);
 }
 
 CollisionObject2DSW *BroadPhase2DHashGrid::get_object(ID p_id) const {
 
-	const Map<ID, Element>::Element *E = element_map.find(p_id);
+	Element *const *E = element_map.lookup_ptr(p_id);
 	ERR_FAIL_COND_V(!E, NULL);
-	return E->get().owner;
+	return (*E)->owner;
 }
 bool BroadPhase2DHashGrid::is_static(ID p_id) const {
 
-	const Map<ID, Element>::Element *E = element_map.find(p_id);
+	Element *const *E = element_map.lookup_ptr(p_id);
 	ERR_FAIL_COND_V(!E, false);
-	return E->get()._static;
+	return (*E)->_static;
 }
 int BroadPhase2DHashGrid::get_subindex(ID p_id) const {
 
-	const Map<ID, Element>::Element *E = element_map.find(p_id);
+	Element *const *E = element_map.lookup_ptr(p_id);
 	ERR_FAIL_COND_V(!E, -1);
-	return E->get().subindex;
+	return (*E)->subindex;
 }
 
 template <bool use_aabb, bool use_segment>
@@ -418,57 +509,52 @@ void BroadPhase2DHashGrid::_cull(const Point2i p_cell, const Rect2 &p_aabb, cons
 	pk.y = p_cell.y;
 
 	uint32_t idx = pk.hash() % hash_table_size;
-	PosBin *pb = hash_table[idx];
-
-	while (pb) {
-
-		if (pb->key == pk) {
-			break;
-		}
-
-		pb = pb->next;
-	}
+	PosBin *pb = _find_bin(pk, idx);
 
 	if (!pb)
 		return;
 
-	for (Map<Element *, RC>::Element *E = pb->object_set.front(); E; E = E->next()) {
+	for (ElementSet::Iterator E = pb->object_set.iter(); E.valid; E = pb->object_set.next_iter(E)) {
+
+		Element *elem = *E.key;
 
 		if (index >= p_max_results)
 			break;
-		if (E->key()->pass == pass)
+		if (elem->pass == pass)
 			continue;
 
-		E->key()->pass = pass;
+		elem->pass = pass;
 
-		if (use_aabb && !p_aabb.intersects(E->key()->aabb))
+		if (use_aabb && !p_aabb.intersects(elem->aabb))
 			continue;
 
-		if (use_segment && !E->key()->aabb.intersects_segment(p_from, p_to))
+		if (use_segment && !elem->aabb.intersects_segment(p_from, p_to))
 			continue;
 
-		p_results[index] = E->key()->owner;
-		p_result_indices[index] = E->key()->subindex;
+		p_results[index] = elem->owner;
+		p_result_indices[index] = elem->subindex;
 		index++;
 	}
 
-	for (Map<Element *, RC>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
+	for (ElementSet::Iterator E = pb->static_object_set.iter(); E.valid; E = pb->static_object_set.next_iter(E)) {
+
+		Element *elem = *E.key;
 
 		if (index >= p_max_results)
 			break;
-		if (E->key()->pass == pass)
+		if (elem->pass == pass)
 			continue;
 
-		if (use_aabb && !p_aabb.intersects(E->key()->aabb)) {
+		if (use_aabb && !p_aabb.intersects(elem->aabb)) {
 			continue;
 		}
 
-		if (use_segment && !E->key()->aabb.intersects_segment(p_from, p_to))
+		if (use_segment && !elem->aabb.intersects_segment(p_from, p_to))
 			continue;
 
-		E->key()->pass = pass;
-		p_results[index] = E->key()->owner;
-		p_result_indices[index] = E->key()->subindex;
+		elem->pass = pass;
+		p_results[index] = elem->owner;
+		p_result_indices[index] = elem->subindex;
 		index++;
 	}
 }
@@ -548,25 +634,26 @@ int BroadPhase2DHashGrid::cull_segment(const Vector2 &p_from, const Vector2 &p_t
 			break;
 	}
 
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
+	for (ElementSet::Iterator E = large_elements.iter(); E.valid; E = large_elements.next_iter(E)) {
 
+		Element *elem = *E.key;
 		if (cullcount >= p_max_results)
 			break;
-		if (E->key()->pass == pass)
+		if (elem->pass == pass)
 			continue;
 
-		E->key()->pass = pass;
+		elem->pass = pass;
 
 		/*
 		if (use_aabb && !p_aabb.intersects(E->key()->aabb))
 			continue;
 		*/
 
-		if (!E->key()->aabb.intersects_segment(p_from, p_to))
+		if (!elem->aabb.intersects_segment(p_from, p_to))
 			continue;
 
-		p_results[cullcount] = E->key()->owner;
-		p_result_indices[cullcount] = E->key()->subindex;
+		p_results[cullcount] = elem->owner;
+		p_result_indices[cullcount] = elem->subindex;
 		cullcount++;
 	}
 
@@ -589,16 +676,17 @@ int BroadPhase2DHashGrid::cull_aabb(const Rect2 &p_aabb, CollisionObject2DSW **p
 		}
 	}
 
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
+	for (ElementSet::Iterator E = large_elements.iter(); E.valid; E = large_elements.next_iter(E)) {
 
+		Element *elem = *E.key;
 		if (cullcount >= p_max_results)
 			break;
-		if (E->key()->pass == pass)
+		if (elem->pass == pass)
 			continue;
 
-		E->key()->pass = pass;
+		elem->pass = pass;
 
-		if (!p_aabb.intersects(E->key()->aabb))
+		if (!p_aabb.intersects(elem->aabb))
 			continue;
 
 		/*
@@ -606,8 +694,8 @@ int BroadPhase2DHashGrid::cull_aabb(const Rect2 &p_aabb, CollisionObject2DSW **p
 			continue;
 		*/
 
-		p_results[cullcount] = E->key()->owner;
-		p_result_indices[cullcount] = E->key()->subindex;
+		p_results[cullcount] = elem->owner;
+		p_result_indices[cullcount] = elem->subindex;
 		cullcount++;
 	}
 	return cullcount;
@@ -625,6 +713,36 @@ void BroadPhase2DHashGrid::set_unpair_callback(UnpairCallback p_unpair_callback,
 }
 
 void BroadPhase2DHashGrid::update() {
+
+	if (!auto_cell_size)
+		return;
+
+	if (++auto_cell_size_pass < AUTO_CELL_SIZE_INTERVAL)
+		return;
+
+	auto_cell_size_pass = 0;
+
+	//aim for cells about twice the size of the average object in the grid
+	real_t size_sum = 0;
+	int count = 0;
+
+	for (OAHashMap<ID, Element *>::Iterator E = element_map.iter(); E.valid; E = element_map.next_iter(E)) {
+		const Element *elem = *E.value;
+		if (elem->aabb == Rect2() || _is_large(elem->aabb))
+			continue;
+		size_sum += MAX(elem->aabb.size.width, elem->aabb.size.height);
+		count++;
+	}
+
+	if (count == 0)
+		return;
+
+	int desired = CLAMP(int(size_sum / count * 2.0), (int)AUTO_CELL_SIZE_MIN, (int)AUTO_CELL_SIZE_MAX);
+
+	//only rebuild when the size is off by more than a factor of two, to avoid flip-flopping
+	if (desired > cell_size * 2 || desired * 2 < cell_size) {
+		_rebuild_grid(next_power_of_2(desired));
+	}
 }
 
 BroadPhase2DSW *BroadPhase2DHashGrid::_create() {
@@ -645,8 +763,12 @@ BroadPhase2DHashGrid::BroadPhase2DHashGrid() {
 	large_object_min_surface = GLOBAL_DEF("physics/2d/large_object_surface_threshold_in_cells", 512);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/large_object_surface_threshold_in_cells", PropertyInfo(Variant::INT, "physics/2d/large_object_surface_threshold_in_cells", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"));
 
+	auto_cell_size = GLOBAL_DEF("physics/2d/auto_cell_size", false);
+	auto_cell_size_pass = 0;
+
 	for (uint32_t i = 0; i < hash_table_size; i++)
 		hash_table[i] = NULL;
+	bin_pool = NULL;
 	pass = 1;
 
 	current = 0;
@@ -662,7 +784,27 @@ BroadPhase2DHashGrid::~BroadPhase2DHashGrid() {
 		}
 	}
 
+	while (bin_pool) {
+		PosBin *pb = bin_pool;
+		bin_pool = pb->next;
+		memdelete(pb);
+	}
+
 	memdelete_arr(hash_table);
+
+	for (OAHashMap<ID, Element *>::Iterator E = element_map.iter(); E.valid; E = element_map.next_iter(E)) {
+		Element *elem = *E.value;
+		for (PairMap::Iterator P = elem->paired.iter(); P.valid; P = elem->paired.next_iter(P)) {
+			if ((*P.key)->self > elem->self) { //pair data is shared, free it once
+				memdelete(*P.value);
+			}
+		}
+		memdelete(elem);
+	}
+
+	for (int i = 0; i < element_pool.size(); i++) {
+		memdelete(element_pool[i]);
+	}
 }
 
 /* 3D version of voxel traversal:
@@ -32,10 +32,16 @@
 #define BROAD_PHASE_2D_HASH_GRID_H
 
 #include "broad_phase_2d_sw.h"
-#include "core/map.h"
+#include "core/oa_hash_map.h"
 
 class BroadPhase2DHashGrid : public BroadPhase2DSW {
 
+	enum {
+		AUTO_CELL_SIZE_INTERVAL = 60, //steps between cell size checks
+		AUTO_CELL_SIZE_MIN = 8,
+		AUTO_CELL_SIZE_MAX = 4096
+	};
+
 	struct PairData {
 
 		bool colliding;
@@ -48,15 +54,10 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 		}
 	};
 
-	struct Element {
+	struct Element;
 
-		ID self;
-		CollisionObject2DSW *owner;
-		bool _static;
-		Rect2 aabb;
-		int subindex;
-		uint64_t pass;
-		Map<Element *, PairData *> paired;
+	struct ElementHasher {
+		static _FORCE_INLINE_ uint32_t hash(const Element *p_elem) { return hash_one_uint64((uint64_t)p_elem); }
 	};
 
 	struct RC {
@@ -77,49 +78,44 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 		}
 	};
 
-	Map<ID, Element> element_map;
-	Map<Element *, RC> large_elements;
+	typedef OAHashMap<Element *, PairData *, ElementHasher> PairMap;
+	typedef OAHashMap<Element *, RC, ElementHasher> ElementSet;
 
-	ID current;
-
-	uint64_t pass;
+	struct Element {
 
-	struct PairKey {
+		ID self;
+		CollisionObject2DSW *owner;
+		bool _static;
+		Rect2 aabb;
+		int subindex;
+		uint64_t pass;
+		PairMap paired;
 
-		union {
-			struct {
-				ID a;
-				ID b;
-			};
-			uint64_t key;
-		};
+		Element() :
+				paired(8) {}
+	};
 
-		_FORCE_INLINE_ bool operator<(const PairKey &p_key) const {
-			return key < p_key.key;
-		}
+	OAHashMap<ID, Element *> element_map;
+	Vector<Element *> element_pool;
+	ElementSet large_elements;
 
-		PairKey() { key = 0; }
-		PairKey(ID p_a, ID p_b) {
-			if (p_a > p_b) {
-				a = p_b;
-				b = p_a;
-			} else {
-				a = p_a;
-				b = p_b;
-			}
-		}
-	};
+	ID current;
 
-	Map<PairKey, PairData> pair_map;
+	uint64_t pass;
 
 	int cell_size;
 	int large_object_min_surface;
 
+	bool auto_cell_size;
+	int auto_cell_size_pass;
+
 	PairCallback pair_callback;
 	void *pair_userdata;
 	UnpairCallback unpair_callback;
 	void *unpair_userdata;
 
+	_FORCE_INLINE_ bool _is_large(const Rect2 &p_rect) const;
+
 	void _enter_grid(Element *p_elem, const Rect2 &p_rect, bool p_static);
 	void _exit_grid(Element *p_elem, const Rect2 &p_rect, bool p_static);
 	template <bool use_aabb, bool use_segment>
@@ -155,17 +151,35 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 	struct PosBin {
 
 		PosKey key;
-		Map<Element *, RC> object_set;
-		Map<Element *, RC> static_object_set;
+		ElementSet object_set;
+		ElementSet static_object_set;
 		PosBin *next;
+
+		PosBin() :
+				object_set(8),
+				static_object_set(8) {
+			next = NULL;
+		}
 	};
 
 	uint32_t hash_table_size;
 	PosBin **hash_table;
+	PosBin *bin_pool; //emptied bins are kept here for reuse
+
+	_FORCE_INLINE_ PosBin *_find_bin(const PosKey &p_key, uint32_t p_idx) const {
+
+		PosBin *pb = hash_table[p_idx];
+		while (pb && !(pb->key == p_key)) {
+			pb = pb->next;
+		}
+		return pb;
+	}
 
 	void _pair_attempt(Element *p_elem, Element *p_with);
 	void _unpair_attempt(Element *p_elem, Element *p_with);
+	void _remove_pair(Element *p_elem, Element *p_with, PairData *p_pair);
 	void _check_motion(Element *p_elem);
+	void _rebuild_grid(int p_cell_size);
 
 public:
 	virtual ID create(CollisionObject2DSW *p_object, int p_subindex = 0);
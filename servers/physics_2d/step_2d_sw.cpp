@@ -30,6 +30,8 @@
 
 #include "step_2d_sw.h"
 #include "core/os/os.h"
+#include "core/os/threaded_array_processor.h"
+#include "core/project_settings.h"
 
 void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island) {
 
@@ -94,6 +96,61 @@ void Step2DSW::_solve_island(Constraint2DSW *p_island, int p_iterations, real_t
 	}
 }
 
+void Step2DSW::_solve_island_batch(uint32_t p_index, SolveJobs *p_jobs) {
+
+	int from = p_jobs->batches[p_index];
+	int to = p_jobs->batches[p_index + 1];
+
+	for (int i = from; i < to; i++) {
+		_solve_island(p_jobs->islands[i], p_jobs->iterations, p_jobs->delta);
+	}
+}
+
+bool Step2DSW::_solve_islands_threaded(Constraint2DSW *p_island_list, int p_iterations, real_t p_delta) {
+
+	if (!threaded_solving) {
+		return false;
+	}
+
+	solve_jobs.islands.clear();
+	solve_jobs.batches.clear();
+
+	int total_constraints = 0;
+	int batch_constraints = 0;
+
+	for (Constraint2DSW *ci = p_island_list; ci; ci = ci->get_island_list_next()) {
+
+		if (batch_constraints == 0) {
+			solve_jobs.batches.push_back(solve_jobs.islands.size());
+		}
+
+		solve_jobs.islands.push_back(ci);
+
+		for (Constraint2DSW *c = ci; c; c = c->get_island_next()) {
+			batch_constraints++;
+			total_constraints++;
+		}
+
+		if (batch_constraints >= ISLAND_BATCH_MIN_CONSTRAINTS) {
+			batch_constraints = 0;
+		}
+	}
+
+	int batch_count = solve_jobs.batches.size();
+
+	if (batch_count < 2 || total_constraints < THREADED_SOLVE_MIN_CONSTRAINTS) {
+		return false; // not worth it, caller solves inline
+	}
+
+	solve_jobs.batches.push_back(solve_jobs.islands.size());
+	solve_jobs.iterations = p_iterations;
+	solve_jobs.delta = p_delta;
+
+	thread_process_array(batch_count, this, &Step2DSW::_solve_island_batch, &solve_jobs);
+
+	return true;
+}
+
 void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 
 	bool can_sleep = true;
@@ -263,7 +320,8 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
+	// only solving is threaded, setup has side effects on areas and contact reports
+	if (!_solve_islands_threaded(constraint_island_list, p_iterations, p_delta)) {
 		Constraint2DSW *ci = constraint_island_list;
 		while (ci) {
 			//iterating each island separatedly improves cache efficiency
@@ -313,4 +371,5 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 Step2DSW::Step2DSW() {
 
 	_step = 1;
+	threaded_solving = GLOBAL_DEF("physics/2d/threaded_island_solving", true);
 }
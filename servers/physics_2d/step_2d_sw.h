@@ -35,11 +35,28 @@
 
 class Step2DSW {
 
+	enum {
+		ISLAND_BATCH_MIN_CONSTRAINTS = 32, // small islands are grouped until a job has at least this many constraints
+		THREADED_SOLVE_MIN_CONSTRAINTS = 256 // below this, starting threads costs more than it saves
+	};
+
+	struct SolveJobs {
+		Vector<Constraint2DSW *> islands;
+		Vector<int> batches; // first island of each job, followed by the island count
+		int iterations;
+		real_t delta;
+	};
+
 	uint64_t _step;
 
+	bool threaded_solving;
+	SolveJobs solve_jobs;
+
 	void _populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island);
 	bool _setup_island(Constraint2DSW *p_island, real_t p_delta);
 	void _solve_island(Constraint2DSW *p_island, int p_iterations, real_t p_delta);
+	void _solve_island_batch(uint32_t p_index, SolveJobs *p_jobs);
+	bool _solve_islands_threaded(Constraint2DSW *p_island_list, int p_iterations, real_t p_delta);
 	void _check_suspend(Body2DSW *p_island, real_t p_delta);
 
 public:
@@ -198,7 +198,7 @@ Vector<RID> Physics2DShapeQueryParameters::get_exclude() const {
 	Vector<RID> ret;
 	ret.resize(exclude.size());
 	int idx = 0;
-	for (Set<RID>::Element *E = exclude.front(); E; E = E->next()) {
+	for (BTreeSet<RID>::Element *E = exclude.front(); E; E = E->next()) {
 		ret.write[idx] = E->get();
 	}
 	return ret;
@@ -269,7 +269,7 @@ Physics2DShapeQueryParameters::Physics2DShapeQueryParameters() {
 Dictionary Physics2DDirectSpaceState::_intersect_ray(const Vector2 &p_from, const Vector2 &p_to, const Vector<RID> &p_exclude, uint32_t p_layers, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	RayResult inters;
-	Set<RID> exclude;
+	BTreeSet<RID> exclude;
 	for (int i = 0; i < p_exclude.size(); i++)
 		exclude.insert(p_exclude[i]);
 
@@ -290,6 +290,77 @@ Dictionary Physics2DDirectSpaceState::_intersect_ray(const Vector2 &p_from, cons
 	return d;
 }
 
+Dictionary Physics2DDirectSpaceState::_intersect_rays(const PoolVector2Array &p_from, const PoolVector2Array &p_to, const Vector<RID> &p_exclude, uint32_t p_layers, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	BTreeSet<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++)
+		exclude.insert(p_exclude[i]);
+
+	int count = p_from.size();
+
+	Vector<RayResult> inters;
+	inters.resize(count);
+
+	if (count) {
+		PoolVector2Array::Read from = p_from.read();
+		PoolVector2Array::Read to = p_to.read();
+		intersect_rays(from.ptr(), to.ptr(), count, inters.ptrw(), exclude, p_layers, p_collide_with_bodies, p_collide_with_areas);
+	}
+
+	PoolVector2Array positions;
+	positions.resize(count);
+	PoolVector2Array normals;
+	normals.resize(count);
+	PoolIntArray shapes;
+	shapes.resize(count);
+	Array colliders;
+	colliders.resize(count);
+	Array collider_ids;
+	collider_ids.resize(count);
+	Array rids;
+	rids.resize(count);
+	Array metadata;
+	metadata.resize(count);
+
+	if (count) {
+		PoolVector2Array::Write pw = positions.write();
+		PoolVector2Array::Write nw = normals.write();
+		PoolIntArray::Write sw = shapes.write();
+
+		for (int i = 0; i < count; i++) {
+
+			const RayResult &r = inters[i];
+			if (r.shape < 0) {
+				pw[i] = Vector2();
+				nw[i] = Vector2();
+				sw[i] = -1;
+				continue;
+			}
+
+			pw[i] = r.position;
+			nw[i] = r.normal;
+			sw[i] = r.shape;
+			colliders[i] = r.collider;
+			collider_ids[i] = r.collider_id;
+			rids[i] = r.rid;
+			metadata[i] = r.metadata;
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["shape"] = shapes;
+	d["collider"] = colliders;
+	d["collider_id"] = collider_ids;
+	d["rid"] = rids;
+	d["metadata"] = metadata;
+
+	return d;
+}
+
 Array Physics2DDirectSpaceState::_intersect_shape(const Ref<Physics2DShapeQueryParameters> &p_shape_query, int p_max_results) {
 
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
@@ -330,7 +401,7 @@ Array Physics2DDirectSpaceState::_cast_motion(const Ref<Physics2DShapeQueryParam
 
 Array Physics2DDirectSpaceState::_intersect_point_impl(const Vector2 &p_point, int p_max_results, const Vector<RID> &p_exclude, uint32_t p_layers, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_filter_by_canvas, ObjectID p_canvas_instance_id) {
 
-	Set<RID> exclude;
+	BTreeSet<RID> exclude;
 	for (int i = 0; i < p_exclude.size(); i++)
 		exclude.insert(p_exclude[i]);
 
@@ -409,6 +480,22 @@ Dictionary Physics2DDirectSpaceState::_get_rest_info(const Ref<Physics2DShapeQue
 	return r;
 }
 
+int Physics2DDirectSpaceState::intersect_rays(const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, const BTreeSet<RID> &p_exclude, uint32_t p_collision_layer, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int hits = 0;
+
+	for (int i = 0; i < p_count; i++) {
+
+		if (intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_collision_layer, p_collide_with_bodies, p_collide_with_areas)) {
+			hits++;
+		} else {
+			r_results[i].shape = -1;
+		}
+	}
+
+	return hits;
+}
+
 Physics2DDirectSpaceState::Physics2DDirectSpaceState() {
 }
 
@@ -417,6 +504,7 @@ void Physics2DDirectSpaceState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "point", "max_results", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_point, DEFVAL(32), DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_point_on_canvas", "point", "canvas_instance_id", "max_results", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_point_on_canvas, DEFVAL(32), DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_ray, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("intersect_rays", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_rays, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &Physics2DDirectSpaceState::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape"), &Physics2DDirectSpaceState::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &Physics2DDirectSpaceState::_collide_shape, DEFVAL(32));
@@ -194,7 +194,7 @@ Vector<RID> PhysicsShapeQueryParameters::get_exclude() const {
 	Vector<RID> ret;
 	ret.resize(exclude.size());
 	int idx = 0;
-	for (Set<RID>::Element *E = exclude.front(); E; E = E->next()) {
+	for (BTreeSet<RID>::Element *E = exclude.front(); E; E = E->next()) {
 		ret.write[idx] = E->get();
 	}
 	return ret;
@@ -263,7 +263,7 @@ PhysicsShapeQueryParameters::PhysicsShapeQueryParameters() {
 Dictionary PhysicsDirectSpaceState::_intersect_ray(const Vector3 &p_from, const Vector3 &p_to, const Vector<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	RayResult inters;
-	Set<RID> exclude;
+	BTreeSet<RID> exclude;
 	for (int i = 0; i < p_exclude.size(); i++)
 		exclude.insert(p_exclude[i]);
 
@@ -283,6 +283,73 @@ Dictionary PhysicsDirectSpaceState::_intersect_ray(const Vector3 &p_from, const
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState::_intersect_rays(const PoolVector3Array &p_from, const PoolVector3Array &p_to, const Vector<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	BTreeSet<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++)
+		exclude.insert(p_exclude[i]);
+
+	int count = p_from.size();
+
+	Vector<RayResult> inters;
+	inters.resize(count);
+
+	if (count) {
+		PoolVector3Array::Read from = p_from.read();
+		PoolVector3Array::Read to = p_to.read();
+		intersect_rays(from.ptr(), to.ptr(), count, inters.ptrw(), exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+	}
+
+	PoolVector3Array positions;
+	positions.resize(count);
+	PoolVector3Array normals;
+	normals.resize(count);
+	PoolIntArray shapes;
+	shapes.resize(count);
+	Array colliders;
+	colliders.resize(count);
+	Array collider_ids;
+	collider_ids.resize(count);
+	Array rids;
+	rids.resize(count);
+
+	if (count) {
+		PoolVector3Array::Write pw = positions.write();
+		PoolVector3Array::Write nw = normals.write();
+		PoolIntArray::Write sw = shapes.write();
+
+		for (int i = 0; i < count; i++) {
+
+			const RayResult &r = inters[i];
+			if (r.shape < 0) {
+				pw[i] = Vector3();
+				nw[i] = Vector3();
+				sw[i] = -1;
+				continue;
+			}
+
+			pw[i] = r.position;
+			nw[i] = r.normal;
+			sw[i] = r.shape;
+			colliders[i] = r.collider;
+			collider_ids[i] = r.collider_id;
+			rids[i] = r.rid;
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["shape"] = shapes;
+	d["collider"] = colliders;
+	d["collider_id"] = collider_ids;
+	d["rid"] = rids;
+
+	return d;
+}
+
 Array PhysicsDirectSpaceState::_intersect_shape(const Ref<PhysicsShapeQueryParameters> &p_shape_query, int p_max_results) {
 
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
@@ -356,12 +423,29 @@ Dictionary PhysicsDirectSpaceState::_get_rest_info(const Ref<PhysicsShapeQueryPa
 	return r;
 }
 
+int PhysicsDirectSpaceState::intersect_rays(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, const BTreeSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int hits = 0;
+
+	for (int i = 0; i < p_count; i++) {
+
+		if (intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+			hits++;
+		} else {
+			r_results[i].shape = -1;
+		}
+	}
+
+	return hits;
+}
+
 PhysicsDirectSpaceState::PhysicsDirectSpaceState() {
 }
 
 void PhysicsDirectSpaceState::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState::_intersect_ray, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("intersect_rays", "from", "to", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState::_intersect_rays, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &PhysicsDirectSpaceState::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape", "motion"), &PhysicsDirectSpaceState::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &PhysicsDirectSpaceState::_collide_shape, DEFVAL(32));
@@ -453,6 +537,7 @@ void PhysicsServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("area_set_monitor_callback", "area", "receiver", "method"), &PhysicsServer::area_set_monitor_callback);
 	ClassDB::bind_method(D_METHOD("area_set_area_monitor_callback", "area", "receiver", "method"), &PhysicsServer::area_set_area_monitor_callback);
+	ClassDB::bind_method(D_METHOD("area_set_monitor_batching", "area", "enable"), &PhysicsServer::area_set_monitor_batching);
 	ClassDB::bind_method(D_METHOD("area_set_monitorable", "area", "monitorable"), &PhysicsServer::area_set_monitorable);
 
 	ClassDB::bind_method(D_METHOD("area_set_ray_pickable", "area", "enable"), &PhysicsServer::area_set_ray_pickable);
@@ -725,7 +810,6 @@ void PhysicsServer::_bind_methods() {
 
 PhysicsServer::PhysicsServer() {
 
-	ERR_FAIL_COND(singleton != NULL);
 	singleton = this;
 }
 
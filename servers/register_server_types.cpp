@@ -40,6 +40,7 @@
 #include "audio/effects/audio_effect_amplify.h"
 #include "audio/effects/audio_effect_chorus.h"
 #include "audio/effects/audio_effect_compressor.h"
+#include "audio/effects/audio_effect_convolution_reverb.h"
 #include "audio/effects/audio_effect_delay.h"
 #include "audio/effects/audio_effect_distortion.h"
 #include "audio/effects/audio_effect_eq.h"
@@ -57,6 +58,7 @@
 #include "camera/camera_feed.h"
 #include "camera_server.h"
 #include "physics/physics_server_sw.h"
+#include "physics/physics_server_wrap_mt.h"
 #include "physics_2d/physics_2d_server_sw.h"
 #include "physics_2d/physics_2d_server_wrap_mt.h"
 #include "physics_2d_server.h"
@@ -89,7 +91,7 @@ static void _debugger_get_resource_usage(List<ScriptDebuggerRemote::ResourceUsag
 ShaderTypes *shader_types = NULL;
 
 PhysicsServer *_createGodotPhysicsCallback() {
-	return memnew(PhysicsServerSW);
+	return PhysicsServerWrapMT::init_server<PhysicsServerSW>();
 }
 
 Physics2DServer *_createGodotPhysics2DCallback() {
@@ -142,6 +144,7 @@ void register_server_types() {
 		ClassDB::register_class<AudioEffectAmplify>();
 
 		ClassDB::register_class<AudioEffectReverb>();
+		ClassDB::register_class<AudioEffectConvolutionReverb>();
 
 		ClassDB::register_class<AudioEffectLowPassFilter>();
 		ClassDB::register_class<AudioEffectHighPassFilter>();
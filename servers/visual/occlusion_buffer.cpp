@@ -0,0 +1,277 @@
+/*************************************************************************/
+/*  occlusion_buffer.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "occlusion_buffer.h"
+
+#include "core/os/memory.h"
+
+#define OCCLUSION_BUFFER_FAR 1e20
+
+void OcclusionBuffer::_to_clip(const Vector3 &p_view, ClipVertex &r_clip) const {
+
+	const real_t(*m)[4] = projection.matrix;
+	r_clip.x = m[0][0] * p_view.x + m[1][0] * p_view.y + m[2][0] * p_view.z + m[3][0];
+	r_clip.y = m[0][1] * p_view.x + m[1][1] * p_view.y + m[2][1] * p_view.z + m[3][1];
+	r_clip.z = m[0][2] * p_view.x + m[1][2] * p_view.y + m[2][2] * p_view.z + m[3][2];
+	r_clip.w = m[0][3] * p_view.x + m[1][3] * p_view.y + m[2][3] * p_view.z + m[3][3];
+}
+
+void OcclusionBuffer::_rasterize_triangle(const ClipVertex &p_a, const ClipVertex &p_b, const ClipVertex &p_c) {
+
+	// to screen space, depth is kept in NDC because it interpolates linearly across the screen
+	float x0 = (p_a.x / p_a.w * 0.5 + 0.5) * width;
+	float y0 = (p_a.y / p_a.w * 0.5 + 0.5) * height;
+	float z0 = p_a.z / p_a.w;
+	float x1 = (p_b.x / p_b.w * 0.5 + 0.5) * width;
+	float y1 = (p_b.y / p_b.w * 0.5 + 0.5) * height;
+	float z1 = p_b.z / p_b.w;
+	float x2 = (p_c.x / p_c.w * 0.5 + 0.5) * width;
+	float y2 = (p_c.y / p_c.w * 0.5 + 0.5) * height;
+	float z2 = p_c.z / p_c.w;
+
+	float area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+	if (Math::abs(area) < CMP_EPSILON) {
+		return;
+	}
+
+	if (area < 0) {
+		// occluders are double sided, just flip the winding
+		SWAP(x1, x2);
+		SWAP(y1, y2);
+		SWAP(z1, z2);
+		area = -area;
+	}
+
+	float min_x = CLAMP(MIN(x0, MIN(x1, x2)), -1, width + 1);
+	float max_x = CLAMP(MAX(x0, MAX(x1, x2)), -1, width + 1);
+	float min_y = CLAMP(MIN(y0, MIN(y1, y2)), -1, height + 1);
+	float max_y = CLAMP(MAX(y0, MAX(y1, y2)), -1, height + 1);
+
+	int from_x = MAX(0, (int)Math::floor(min_x));
+	int to_x = MIN(width - 1, (int)Math::floor(max_x));
+	int from_y = MAX(0, (int)Math::floor(min_y));
+	int to_y = MIN(height - 1, (int)Math::floor(max_y));
+
+	if (from_x > to_x || from_y > to_y) {
+		return;
+	}
+
+	// edge functions are positive inside, step them per pixel
+	float e0_dx = -(y2 - y1), e0_dy = x2 - x1;
+	float e1_dx = -(y0 - y2), e1_dy = x0 - x2;
+	float e2_dx = -(y1 - y0), e2_dy = x1 - x0;
+
+	float z_dx = ((z1 - z0) * (y2 - y0) - (z2 - z0) * (y1 - y0)) / area;
+	float z_dy = ((z2 - z0) * (x1 - x0) - (z1 - z0) * (x2 - x0)) / area;
+
+	float px = from_x + 0.5;
+
+	for (int y = from_y; y <= to_y; y++) {
+
+		float py = y + 0.5;
+
+		float e0 = e0_dy * (py - y1) + e0_dx * (px - x1);
+		float e1 = e1_dy * (py - y2) + e1_dx * (px - x2);
+		float e2 = e2_dy * (py - y0) + e2_dx * (px - x0);
+		float z = z0 + z_dx * (px - x0) + z_dy * (py - y0);
+
+		float *row = &depth[y * width];
+
+		// kept branchless so the compiler can vectorize it
+		for (int x = from_x; x <= to_x; x++) {
+
+			float d = row[x];
+			bool write = e0 >= 0 && e1 >= 0 && e2 >= 0 && z < d;
+			row[x] = write ? z : d;
+
+			e0 += e0_dx;
+			e1 += e1_dx;
+			e2 += e2_dx;
+			z += z_dx;
+		}
+	}
+}
+
+void OcclusionBuffer::_clip_and_rasterize(const ClipVertex *p_vertices) {
+
+	// only the near plane needs clipping (z >= -w), the rest is handled by the bounding rectangle
+	ClipVertex clipped[4];
+	int clipped_count = 0;
+
+	for (int i = 0; i < 3; i++) {
+
+		const ClipVertex &a = p_vertices[i];
+		const ClipVertex &b = p_vertices[(i + 1) % 3];
+		float da = a.z + a.w;
+		float db = b.z + b.w;
+
+		if (da >= 0) {
+			clipped[clipped_count++] = a;
+		}
+
+		if ((da >= 0) != (db >= 0)) {
+			float t = da / (da - db);
+			ClipVertex &c = clipped[clipped_count++];
+			c.x = a.x + (b.x - a.x) * t;
+			c.y = a.y + (b.y - a.y) * t;
+			c.z = a.z + (b.z - a.z) * t;
+			c.w = a.w + (b.w - a.w) * t;
+		}
+	}
+
+	for (int i = 0; i < clipped_count; i++) {
+		if (clipped[i].w <= CMP_EPSILON) {
+			return; // degenerate projection
+		}
+	}
+
+	for (int i = 2; i < clipped_count; i++) {
+		_rasterize_triangle(clipped[0], clipped[i - 1], clipped[i]);
+	}
+}
+
+void OcclusionBuffer::resize(int p_width, int p_height) {
+
+	ERR_FAIL_COND(p_width <= 0 || p_height <= 0);
+
+	if (p_width == width && p_height == height) {
+		return;
+	}
+
+	if (depth) {
+		memfree(depth);
+	}
+
+	width = p_width;
+	height = p_height;
+	depth = (float *)memalloc(sizeof(float) * width * height);
+	empty = true;
+}
+
+void OcclusionBuffer::clear(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection) {
+
+	ERR_FAIL_COND(!depth);
+
+	cam_inverse = p_cam_transform.affine_inverse();
+	projection = p_cam_projection;
+
+	int size = width * height;
+	for (int i = 0; i < size; i++) {
+		depth[i] = OCCLUSION_BUFFER_FAR;
+	}
+
+	empty = true;
+}
+
+void OcclusionBuffer::add_occluder(const Transform &p_transform, const Vector3 *p_vertices, int p_vertex_count) {
+
+	ERR_FAIL_COND(!depth);
+
+	Transform xform = cam_inverse * p_transform;
+
+	for (int i = 0; i + 2 < p_vertex_count; i += 3) {
+
+		ClipVertex triangle[3];
+		for (int j = 0; j < 3; j++) {
+			_to_clip(xform.xform(p_vertices[i + j]), triangle[j]);
+		}
+
+		_clip_and_rasterize(triangle);
+	}
+
+	empty = false;
+}
+
+bool OcclusionBuffer::is_aabb_occluded(const AABB &p_aabb) const {
+
+	if (empty) {
+		return false;
+	}
+
+	float min_x = 1e20, min_y = 1e20, min_z = 1e20;
+	float max_x = -1e20, max_y = -1e20;
+
+	for (int i = 0; i < 8; i++) {
+
+		ClipVertex c;
+		_to_clip(cam_inverse.xform(p_aabb.get_endpoint(i)), c);
+
+		if (c.w <= CMP_EPSILON || c.z + c.w < 0) {
+			return false; // crosses the near plane, never occluded
+		}
+
+		float x = (c.x / c.w * 0.5 + 0.5) * width;
+		float y = (c.y / c.w * 0.5 + 0.5) * height;
+		float z = c.z / c.w;
+
+		min_x = MIN(min_x, x);
+		max_x = MAX(max_x, x);
+		min_y = MIN(min_y, y);
+		max_y = MAX(max_y, y);
+		min_z = MIN(min_z, z);
+	}
+
+	int from_x = MAX(0, (int)Math::floor(CLAMP(min_x, -1, width + 1)));
+	int to_x = MIN(width - 1, (int)Math::floor(CLAMP(max_x, -1, width + 1)));
+	int from_y = MAX(0, (int)Math::floor(CLAMP(min_y, -1, height + 1)));
+	int to_y = MIN(height - 1, (int)Math::floor(CLAMP(max_y, -1, height + 1)));
+
+	if (from_x > to_x || from_y > to_y) {
+		return false;
+	}
+
+	// occluded only if every pixel it touches has an occluder in front of its closest point
+	for (int y = from_y; y <= to_y; y++) {
+
+		const float *row = &depth[y * width];
+		for (int x = from_x; x <= to_x; x++) {
+			if (row[x] >= min_z) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+OcclusionBuffer::OcclusionBuffer() {
+
+	width = 0;
+	height = 0;
+	depth = NULL;
+	empty = true;
+}
+
+OcclusionBuffer::~OcclusionBuffer() {
+
+	if (depth) {
+		memfree(depth);
+	}
+}
@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  occlusion_buffer.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef OCCLUSION_BUFFER_H
+#define OCCLUSION_BUFFER_H
+
+#include "core/math/aabb.h"
+#include "core/math/camera_matrix.h"
+#include "core/math/transform.h"
+
+// Low resolution software depth buffer. Occluder triangles are rasterized
+// into it from the point of view of the camera, then instance bounds are
+// tested against it to skip meshes that are fully hidden behind them.
+class OcclusionBuffer {
+
+	int width;
+	int height;
+	float *depth; // normalized device depth, smaller is closer
+
+	Transform cam_inverse;
+	CameraMatrix projection;
+
+	bool empty;
+
+	struct ClipVertex {
+		float x, y, z, w;
+	};
+
+	_FORCE_INLINE_ void _to_clip(const Vector3 &p_view, ClipVertex &r_clip) const;
+	void _rasterize_triangle(const ClipVertex &p_a, const ClipVertex &p_b, const ClipVertex &p_c);
+	void _clip_and_rasterize(const ClipVertex *p_vertices);
+
+public:
+	void resize(int p_width, int p_height);
+	int get_width() const { return width; }
+	int get_height() const { return height; }
+
+	void clear(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection);
+
+	// p_vertices is a triangle list in occluder local space
+	void add_occluder(const Transform &p_transform, const Vector3 *p_vertices, int p_vertex_count);
+
+	bool is_empty() const { return empty; }
+	bool is_aabb_occluded(const AABB &p_aabb) const;
+
+	OcclusionBuffer();
+	~OcclusionBuffer();
+};
+
+#endif // OCCLUSION_BUFFER_H
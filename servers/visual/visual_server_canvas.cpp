@@ -33,8 +33,296 @@
 #include "visual_server_raster.h"
 #include "visual_server_viewport.h"
 
+#include "core/parallel_sort_array.h"
+#include "core/project_settings.h"
+#include "core/sort_array.h"
+
 static const int z_range = VS::CANVAS_ITEM_Z_MAX - VS::CANVAS_ITEM_Z_MIN + 1;
 
+//children covering more cells than this are always visited instead
+#define CULL_INDEX_MAX_CELLS_PER_CHILD 16
+
+static _FORCE_INLINE_ void _get_cull_cells(const VisualServerCanvas::CullIndex *p_index, const Rect2 &p_rect, int &r_x0, int &r_y0, int &r_x1, int &r_y1) {
+
+	int last = p_index->cells_per_side - 1;
+	Vector2 from = (p_rect.position - p_index->bounds.position) / p_index->cell_size;
+	Vector2 to = (p_rect.position + p_rect.size - p_index->bounds.position) / p_index->cell_size;
+	r_x0 = CLAMP((int)Math::floor(from.x), 0, last);
+	r_y0 = CLAMP((int)Math::floor(from.y), 0, last);
+	r_x1 = CLAMP((int)Math::floor(to.x), 0, last);
+	r_y1 = CLAMP((int)Math::floor(to.y), 0, last);
+}
+
+void VisualServerCanvas::_mark_cull_dirty(Item *p_item) {
+
+	Item *item = p_item;
+	item->subtree_rect_dirty = true;
+
+	while (canvas_item_owner.owns(item->parent)) {
+
+		Item *parent = canvas_item_owner.getornull(item->parent);
+
+		if (parent->cull_index && !parent->cull_index_dirty && !item->cull_dynamic) {
+			//keep the stale grid entry, but always visit the item until the next rebuild
+			item->cull_dynamic = true;
+			parent->cull_index->dynamic.push_back(item->cull_slot);
+			if (parent->cull_index->dynamic.size() > parent->child_items.size() / 4) {
+				parent->cull_index_dirty = true;
+			}
+		}
+
+		//ancestors of a dirty item are always dirty already
+		if (parent->subtree_rect_dirty)
+			break;
+
+		parent->subtree_rect_dirty = true;
+		item = parent;
+	}
+}
+
+void VisualServerCanvas::_update_subtree_rect(Item *p_item) {
+
+	if (!p_item->subtree_rect_dirty)
+		return;
+
+	p_item->subtree_rect_dirty = false;
+
+	//these must be visited even when off screen, or have bounds that change without notice
+	bool unculled = p_item->vp_render || p_item->copy_back_buffer || p_item->update_when_visible || p_item->skeleton.is_valid();
+	for (int i = 0; i < p_item->commands.size() && !unculled; i++) {
+		RasterizerCanvas::Item::Command::Type type = p_item->commands[i]->type;
+		unculled = type == RasterizerCanvas::Item::Command::TYPE_MESH || type == RasterizerCanvas::Item::Command::TYPE_MULTIMESH || type == RasterizerCanvas::Item::Command::TYPE_PARTICLES;
+	}
+
+	bool empty = p_item->commands.empty() && !p_item->custom_rect;
+	Rect2 rect;
+	if (!empty) {
+		rect = p_item->get_rect();
+	}
+
+	int child_item_count = p_item->child_items.size();
+	Item **child_items = p_item->child_items.ptrw();
+	for (int i = 0; i < child_item_count; i++) {
+
+		Item *child = child_items[i];
+		_update_subtree_rect(child);
+
+		if (child->subtree_unculled) {
+			unculled = true;
+		}
+		if (child->subtree_empty)
+			continue;
+
+		Rect2 child_rect = child->xform.xform(child->subtree_rect);
+		if (empty) {
+			rect = child_rect;
+			empty = false;
+		} else {
+			rect = rect.merge(child_rect);
+		}
+	}
+
+	p_item->subtree_rect = rect;
+	p_item->subtree_empty = empty;
+	p_item->subtree_unculled = unculled;
+}
+
+void VisualServerCanvas::_build_cull_index(Item *p_item) {
+
+	if (!p_item->cull_index) {
+		p_item->cull_index = memnew(CullIndex);
+	}
+
+	CullIndex *index = p_item->cull_index;
+	p_item->cull_index_dirty = false;
+
+	int child_item_count = p_item->child_items.size();
+	Item **child_items = p_item->child_items.ptrw();
+
+	index->always.clear();
+	index->dynamic.clear();
+	index->child_rects.resize(child_item_count);
+	Rect2 *rects = index->child_rects.ptrw();
+
+	index->bounds = Rect2();
+	bool has_bounds = false;
+	for (int i = 0; i < child_item_count; i++) {
+
+		Item *child = child_items[i];
+		child->cull_slot = i;
+		child->cull_dynamic = false;
+		_update_subtree_rect(child);
+
+		if (child->subtree_unculled || child->subtree_empty)
+			continue;
+
+		rects[i] = child->xform.xform(child->subtree_rect);
+		if (has_bounds) {
+			index->bounds = index->bounds.merge(rects[i]);
+		} else {
+			index->bounds = rects[i];
+			has_bounds = true;
+		}
+	}
+
+	index->cells_per_side = CLAMP((int)Math::sqrt(child_item_count / 4.0), 1, 256);
+	index->cell_size = Vector2(MAX(index->bounds.size.x, CMP_EPSILON), MAX(index->bounds.size.y, CMP_EPSILON)) / index->cells_per_side;
+
+	int cell_count = index->cells_per_side * index->cells_per_side;
+	index->cell_start.resize(cell_count + 1);
+	int *cell_start = index->cell_start.ptrw();
+	for (int i = 0; i <= cell_count; i++) {
+		cell_start[i] = 0;
+	}
+
+	//count the children of each cell first, then fill them in place
+	for (int i = 0; i < child_item_count; i++) {
+
+		Item *child = child_items[i];
+		if (child->subtree_unculled) {
+			index->always.push_back(i);
+			continue;
+		}
+		if (child->subtree_empty)
+			continue;
+
+		int x0, y0, x1, y1;
+		_get_cull_cells(index, rects[i], x0, y0, x1, y1);
+		if ((x1 - x0 + 1) * (y1 - y0 + 1) > CULL_INDEX_MAX_CELLS_PER_CHILD) {
+			index->always.push_back(i);
+			continue;
+		}
+
+		for (int y = y0; y <= y1; y++) {
+			for (int x = x0; x <= x1; x++) {
+				cell_start[y * index->cells_per_side + x + 1]++;
+			}
+		}
+	}
+
+	for (int i = 0; i < cell_count; i++) {
+		cell_start[i + 1] += cell_start[i];
+	}
+
+	index->cell_children.resize(cell_start[cell_count]);
+	int *cell_children = index->cell_children.ptrw();
+	Vector<int> cursor = index->cell_start;
+	int *cursorw = cursor.ptrw();
+	const int *always = index->always.ptr();
+	int always_count = index->always.size();
+	int next_always = 0;
+
+	for (int i = 0; i < child_item_count; i++) {
+
+		if (next_always < always_count && always[next_always] == i) {
+			next_always++;
+			continue;
+		}
+		if (child_items[i]->subtree_empty)
+			continue;
+
+		int x0, y0, x1, y1;
+		_get_cull_cells(index, rects[i], x0, y0, x1, y1);
+		for (int y = y0; y <= y1; y++) {
+			for (int x = x0; x <= x1; x++) {
+				cell_children[cursorw[y * index->cells_per_side + x]++] = i;
+			}
+		}
+	}
+
+	index->child_pass.resize(child_item_count);
+	uint32_t *child_pass = index->child_pass.ptrw();
+	for (int i = 0; i < child_item_count; i++) {
+		child_pass[i] = 0;
+	}
+	index->pass = 0;
+}
+
+int VisualServerCanvas::_cull_children(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect) {
+
+	if (!p_item->cull_index || p_item->cull_index_dirty) {
+		_build_cull_index(p_item);
+	}
+
+	if (p_xform.basis_determinant() == 0)
+		return -1;
+
+	CullIndex *index = p_item->cull_index;
+
+	//children are drawn when their transformed rect intersects the clip size at the origin
+	Rect2 local_clip = p_xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size));
+
+	int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+	if (local_clip.intersects(index->bounds)) {
+
+		_get_cull_cells(index, local_clip, x0, y0, x1, y1);
+		//when most of the grid is visible, walking all children is cheaper
+		if ((x1 - x0 + 1) * (y1 - y0 + 1) * 2 > index->cells_per_side * index->cells_per_side)
+			return -1;
+	}
+
+	index->pass++;
+	if (index->pass == 0) {
+		uint32_t *child_pass = index->child_pass.ptrw();
+		for (int i = 0; i < index->child_pass.size(); i++) {
+			child_pass[i] = 0;
+		}
+		index->pass = 1;
+	}
+
+	uint32_t pass = index->pass;
+	uint32_t *child_pass = index->child_pass.ptrw();
+	const int *cell_start = index->cell_start.ptr();
+	const int *cell_children = index->cell_children.ptr();
+	const Rect2 *rects = index->child_rects.ptr();
+
+	index->visible_slots.clear();
+
+	for (int y = y0; y <= y1; y++) {
+		for (int x = x0; x <= x1; x++) {
+			int cell = y * index->cells_per_side + x;
+			for (int i = cell_start[cell]; i < cell_start[cell + 1]; i++) {
+				int slot = cell_children[i];
+				if (child_pass[slot] == pass || !local_clip.intersects(rects[slot]))
+					continue;
+				child_pass[slot] = pass;
+				index->visible_slots.push_back(slot);
+			}
+		}
+	}
+
+	for (int i = 0; i < index->always.size(); i++) {
+		int slot = index->always[i];
+		if (child_pass[slot] != pass) {
+			child_pass[slot] = pass;
+			index->visible_slots.push_back(slot);
+		}
+	}
+
+	for (int i = 0; i < index->dynamic.size(); i++) {
+		int slot = index->dynamic[i];
+		if (child_pass[slot] != pass) {
+			child_pass[slot] = pass;
+			index->visible_slots.push_back(slot);
+		}
+	}
+
+	//keep the draw order
+	int count = index->visible_slots.size();
+	int *slots = index->visible_slots.ptrw();
+	SortArray<int> sorter;
+	sorter.sort(slots, count);
+
+	index->visible.resize(count);
+	Item **visible = index->visible.ptrw();
+	Item **child_items = p_item->child_items.ptrw();
+	for (int i = 0; i < count; i++) {
+		visible[i] = child_items[slots[i]];
+	}
+
+	return count;
+}
+
 void VisualServerCanvas::_render_canvas_item_tree(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RasterizerCanvas::Light *p_lights) {
 
 	memset(z_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
@@ -49,31 +337,70 @@ void VisualServerCanvas::_render_canvas_item_tree(Item *p_canvas_item, const Tra
 	}
 }
 
-void _collect_ysort_children(VisualServerCanvas::Item *p_canvas_item, Transform2D p_transform, VisualServerCanvas::Item *p_material_owner, const Color p_modulate, VisualServerCanvas::Item **r_items, int &r_index) {
+void _collect_ysort_cache(VisualServerCanvas::Item *p_canvas_item, int p_parent, VisualServerCanvas::YSortCache *r_cache) {
 	int child_item_count = p_canvas_item->child_items.size();
 	VisualServerCanvas::Item **child_items = p_canvas_item->child_items.ptrw();
 	for (int i = 0; i < child_item_count; i++) {
 		if (child_items[i]->visible) {
-			if (r_items) {
-				r_items[r_index] = child_items[i];
-				child_items[i]->ysort_modulate = p_modulate;
-				child_items[i]->ysort_xform = p_transform;
-				child_items[i]->ysort_pos = p_transform.xform(child_items[i]->xform.elements[2]);
-				child_items[i]->material_owner = child_items[i]->use_parent_material ? p_material_owner : NULL;
-			}
-
-			r_index++;
+			int index = r_cache->items.size();
+			r_cache->items.push_back(child_items[i]);
+			r_cache->parents.push_back(p_parent);
 
 			if (child_items[i]->sort_y)
-				_collect_ysort_children(child_items[i],
-						p_transform * child_items[i]->xform,
-						child_items[i]->use_parent_material ? p_material_owner : child_items[i],
-						p_modulate * child_items[i]->modulate,
-						r_items, r_index);
+				_collect_ysort_cache(child_items[i], index, r_cache);
 		}
 	}
 }
 
+//propagates transform, modulate and material owner down the cached items, parents come first
+void _update_ysort_cache(VisualServerCanvas::YSortCache *p_cache, VisualServerCanvas::Item *p_material_owner) {
+	int count = p_cache->items.size();
+	VisualServerCanvas::Item *const *items = p_cache->items.ptr();
+	const int *parents = p_cache->parents.ptr();
+	VisualServerCanvas::Item **material_owners = p_cache->material_owners.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		VisualServerCanvas::Item *item = items[i];
+		int parent_index = parents[i];
+
+		if (parent_index < 0) {
+			item->ysort_xform = Transform2D();
+			item->ysort_modulate = Color(1, 1, 1, 1);
+			material_owners[i] = p_material_owner;
+		} else {
+			VisualServerCanvas::Item *parent = items[parent_index];
+			item->ysort_xform = parent->ysort_xform * parent->xform;
+			item->ysort_modulate = parent->ysort_modulate * parent->modulate;
+			material_owners[i] = parent->use_parent_material ? material_owners[parent_index] : parent;
+		}
+
+		item->ysort_pos = item->ysort_xform.xform(item->xform.elements[2]);
+		item->material_owner = item->use_parent_material ? material_owners[i] : NULL;
+	}
+}
+
+//items move little between frames, so the last order is nearly sorted; gives up past p_max_moves
+bool _ysort_insertion_sort(VisualServerCanvas::Item **p_items, int p_count, int p_max_moves) {
+	VisualServerCanvas::ItemPtrSort compare;
+	int moves = 0;
+
+	for (int i = 1; i < p_count; i++) {
+		VisualServerCanvas::Item *item = p_items[i];
+		int j = i;
+		while (j > 0 && compare(item, p_items[j - 1])) {
+			p_items[j] = p_items[j - 1];
+			j--;
+		}
+		p_items[j] = item;
+
+		moves += i - j;
+		if (moves > p_max_moves)
+			return false;
+	}
+
+	return true;
+}
+
 void _mark_ysort_dirty(VisualServerCanvas::Item *ysort_owner, RID_Owner<VisualServerCanvas::Item> &canvas_item_owner) {
 	do {
 		ysort_owner->ysort_children_count = -1;
@@ -92,6 +419,7 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 
 		ci->child_items.sort_custom<ItemIndexSort>();
 		ci->children_order_dirty = false;
+		ci->cull_index_dirty = true;
 	}
 
 	Rect2 rect = ci->get_rect();
@@ -128,19 +456,40 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 
 	if (ci->sort_y) {
 
+		if (!ci->ysort_cache) {
+			ci->ysort_cache = memnew(YSortCache);
+			ci->ysort_children_count = -1;
+		}
+
+		YSortCache *cache = ci->ysort_cache;
+		bool rebuilt = false;
+
 		if (ci->ysort_children_count == -1) {
-			ci->ysort_children_count = 0;
-			_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), NULL, ci->ysort_children_count);
+			cache->items.clear();
+			cache->parents.clear();
+			_collect_ysort_cache(ci, -1, cache);
+			cache->material_owners.resize(cache->items.size());
+			cache->sorted = cache->items;
+			ci->ysort_children_count = cache->items.size();
+			rebuilt = true;
 		}
 
+		_update_ysort_cache(cache, p_material_owner);
+
 		child_item_count = ci->ysort_children_count;
-		child_items = (Item **)alloca(child_item_count * sizeof(Item *));
+		child_items = cache->sorted.ptrw();
 
-		int i = 0;
-		_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), child_items, i);
+		if (rebuilt || !_ysort_insertion_sort(child_items, child_item_count, child_item_count * YSORT_MAX_MOVES_PER_ITEM)) {
+			ParallelSortArray<Item *, ItemPtrSort> sorter;
+			sorter.sort(child_items, child_item_count);
+		}
+	} else if (cull_index_min_children > 0 && child_item_count >= cull_index_min_children) {
 
-		SortArray<Item *, ItemPtrSort> sorter;
-		sorter.sort(child_items, child_item_count);
+		int visible_count = _cull_children(ci, xform, p_clip_rect);
+		if (visible_count >= 0) {
+			child_items = ci->cull_index->visible.ptrw();
+			child_item_count = visible_count;
+		}
 	}
 
 	if (ci->z_relative)
@@ -361,6 +710,7 @@ void VisualServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 
 			Item *item_owner = canvas_item_owner.get(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			item_owner->cull_index_dirty = true;
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -383,6 +733,7 @@ void VisualServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 			Item *item_owner = canvas_item_owner.get(p_parent);
 			item_owner->child_items.push_back(canvas_item);
 			item_owner->children_order_dirty = true;
+			item_owner->cull_index_dirty = true;
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -395,6 +746,7 @@ void VisualServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 	}
 
 	canvas_item->parent = p_parent;
+	_mark_cull_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_visible(RID p_item, bool p_visible) {
 
@@ -418,7 +770,47 @@ void VisualServerCanvas::canvas_item_set_transform(RID p_item, const Transform2D
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
+	if (canvas_item->interpolated) {
+		canvas_item->xform_curr = p_transform;
+		canvas_item->interpolation_moved = true;
+		if (!canvas_item->interpolation_item.in_list()) {
+			item_interpolation_list.add(&canvas_item->interpolation_item);
+		}
+		return;
+	}
+
 	canvas_item->xform = p_transform;
+	_mark_cull_dirty(canvas_item);
+}
+void VisualServerCanvas::canvas_item_set_interpolated(RID p_item, bool p_interpolated) {
+
+	Item *canvas_item = canvas_item_owner.getornull(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	if (canvas_item->interpolated == p_interpolated)
+		return;
+
+	canvas_item->interpolated = p_interpolated;
+	if (p_interpolated) {
+		canvas_item->xform_curr = canvas_item->xform;
+		canvas_item->xform_prev = canvas_item->xform;
+	} else {
+		item_interpolation_list.remove(&canvas_item->interpolation_item);
+		canvas_item->xform = canvas_item->xform_curr;
+		_mark_cull_dirty(canvas_item);
+	}
+}
+void VisualServerCanvas::canvas_item_reset_physics_interpolation(RID p_item) {
+
+	Item *canvas_item = canvas_item_owner.getornull(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	if (!canvas_item->interpolated)
+		return;
+
+	canvas_item->xform_prev = canvas_item->xform_curr;
+	canvas_item->xform = canvas_item->xform_curr;
+	_mark_cull_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_clip(RID p_item, bool p_clip) {
 
@@ -441,6 +833,7 @@ void VisualServerCanvas::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
+	_mark_cull_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_modulate(RID p_item, const Color &p_color) {
 
@@ -471,6 +864,7 @@ void VisualServerCanvas::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
@@ -488,6 +882,7 @@ void VisualServerCanvas::canvas_item_add_line(RID p_item, const Point2 &p_from,
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(line);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_polyline(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, float p_width, bool p_antialiased) {
@@ -573,6 +968,7 @@ void VisualServerCanvas::canvas_item_add_polyline(RID p_item, const Vector<Point
 	}
 	canvas_item->rect_dirty = true;
 	canvas_item->commands.push_back(pline);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, float p_width, bool p_antialiased) {
@@ -597,6 +993,7 @@ void VisualServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<Poin
 
 	canvas_item->rect_dirty = true;
 	canvas_item->commands.push_back(pline);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
@@ -611,6 +1008,7 @@ void VisualServerCanvas::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(rect);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
@@ -625,6 +1023,7 @@ void VisualServerCanvas::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 	circle->radius = p_radius;
 
 	canvas_item->commands.push_back(circle);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose, RID p_normal_map) {
@@ -661,6 +1060,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 	rect->normal_map = p_normal_map;
 	canvas_item->rect_dirty = true;
 	canvas_item->commands.push_back(rect);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, RID p_normal_map, bool p_clip_uv) {
@@ -710,6 +1110,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect_region(RID p_item, const R
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(rect);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, VS::NinePatchAxisMode p_x_axis_mode, VS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate, RID p_normal_map) {
@@ -734,6 +1135,7 @@ void VisualServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_r
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(style);
+	_mark_cull_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_add_primitive(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, float p_width, RID p_normal_map) {
 
@@ -751,6 +1153,7 @@ void VisualServerCanvas::canvas_item_add_primitive(RID p_item, const Vector<Poin
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(prim);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, RID p_normal_map, bool p_antialiased) {
@@ -782,6 +1185,7 @@ void VisualServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Point2
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(polygon);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count, RID p_normal_map, bool p_antialiased, bool p_antialiasing_use_indices) {
@@ -828,6 +1232,7 @@ void VisualServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vector
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(polygon);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
@@ -840,6 +1245,7 @@ void VisualServerCanvas::canvas_item_add_set_transform(RID p_item, const Transfo
 	tr->xform = p_transform;
 
 	canvas_item->commands.push_back(tr);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture, RID p_normal_map) {
@@ -856,6 +1262,7 @@ void VisualServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 	m->modulate = p_modulate;
 
 	canvas_item->commands.push_back(m);
+	_mark_cull_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture, RID p_normal) {
 
@@ -873,6 +1280,7 @@ void VisualServerCanvas::canvas_item_add_particles(RID p_item, RID p_particles,
 
 	canvas_item->rect_dirty = true;
 	canvas_item->commands.push_back(part);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture, RID p_normal_map) {
@@ -888,6 +1296,7 @@ void VisualServerCanvas::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 
 	canvas_item->rect_dirty = true;
 	canvas_item->commands.push_back(mm);
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
@@ -900,6 +1309,7 @@ void VisualServerCanvas::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 	ci->ignore = p_ignore;
 
 	canvas_item->commands.push_back(ci);
+	_mark_cull_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_sort_children_by_y(RID p_item, bool p_enable) {
 
@@ -908,6 +1318,11 @@ void VisualServerCanvas::canvas_item_set_sort_children_by_y(RID p_item, bool p_e
 
 	canvas_item->sort_y = p_enable;
 
+	if (!p_enable && canvas_item->ysort_cache) {
+		memdelete(canvas_item->ysort_cache);
+		canvas_item->ysort_cache = NULL;
+	}
+
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
 }
 void VisualServerCanvas::canvas_item_set_z_index(RID p_item, int p_z) {
@@ -933,6 +1348,7 @@ void VisualServerCanvas::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->skeleton = p_skeleton;
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_enable, const Rect2 &p_rect) {
@@ -952,6 +1368,8 @@ void VisualServerCanvas::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+
+	_mark_cull_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_clear(RID p_item) {
@@ -960,6 +1378,7 @@ void VisualServerCanvas::canvas_item_clear(RID p_item) {
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->clear();
+	_mark_cull_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_draw_index(RID p_item, int p_index) {
 
@@ -1133,6 +1552,7 @@ void VisualServerCanvas::canvas_light_set_shadow_enabled(RID p_light, bool p_ena
 		VSG::storage->free(clight->shadow_buffer);
 		clight->shadow_buffer = RID();
 	}
+	clight->shadow_hash_cache = 0;
 }
 void VisualServerCanvas::canvas_light_set_shadow_buffer_size(RID p_light, int p_size) {
 
@@ -1150,6 +1570,7 @@ void VisualServerCanvas::canvas_light_set_shadow_buffer_size(RID p_light, int p_
 	if (clight->shadow_buffer.is_valid()) {
 		VSG::storage->free(clight->shadow_buffer);
 		clight->shadow_buffer = VSG::storage->canvas_light_shadow_buffer_create(clight->shadow_buffer_size);
+		clight->shadow_hash_cache = 0;
 	}
 }
 
@@ -1233,6 +1654,7 @@ void VisualServerCanvas::canvas_light_occluder_set_polygon(RID p_occluder, RID p
 
 	occluder->polygon = p_polygon;
 	occluder->polygon_buffer = RID();
+	occluder->version++;
 
 	if (occluder->polygon.is_valid()) {
 		LightOccluderPolygon *occluder_poly = canvas_light_occluder_polygon_owner.get(p_polygon);
@@ -1319,6 +1741,7 @@ void VisualServerCanvas::canvas_occluder_polygon_set_shape_as_lines(RID p_occlud
 	VSG::storage->canvas_light_occluder_set_polylines(occluder_poly->occluder, p_shape);
 	for (Set<RasterizerCanvas::LightOccluderInstance *>::Element *E = occluder_poly->owners.front(); E; E = E->next()) {
 		E->get()->aabb_cache = occluder_poly->aabb;
+		E->get()->version++;
 	}
 }
 
@@ -1329,6 +1752,40 @@ void VisualServerCanvas::canvas_occluder_polygon_set_cull_mode(RID p_occluder_po
 	occluder_poly->cull_mode = p_mode;
 	for (Set<RasterizerCanvas::LightOccluderInstance *>::Element *E = occluder_poly->owners.front(); E; E = E->next()) {
 		E->get()->cull_cache = p_mode;
+		E->get()->version++;
+	}
+}
+
+void VisualServerCanvas::update_interpolation_tick() {
+
+	SelfList<Item> *I = item_interpolation_list.first();
+	while (I) {
+		SelfList<Item> *N = I->next();
+		Item *canvas_item = I->self();
+
+		if (canvas_item->interpolation_moved) {
+			canvas_item->xform_prev = canvas_item->xform_curr;
+			canvas_item->interpolation_moved = false;
+		} else {
+			//came to rest, stop interpolating until it moves again
+			item_interpolation_list.remove(I);
+			canvas_item->xform = canvas_item->xform_curr;
+			_mark_cull_dirty(canvas_item);
+		}
+		I = N;
+	}
+}
+
+void VisualServerCanvas::update_interpolation_frame(float p_fraction) {
+
+	for (SelfList<Item> *I = item_interpolation_list.first(); I; I = I->next()) {
+		Item *canvas_item = I->self();
+
+		Transform2D xform = canvas_item->xform_prev.interpolate_with(canvas_item->xform_curr, p_fraction);
+		if (canvas_item->xform != xform) {
+			canvas_item->xform = xform;
+			_mark_cull_dirty(canvas_item);
+		}
 	}
 }
 
@@ -1385,6 +1842,7 @@ bool VisualServerCanvas::free(RID p_rid) {
 
 				Item *item_owner = canvas_item_owner.get(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				item_owner->cull_index_dirty = true;
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -1475,6 +1933,9 @@ VisualServerCanvas::VisualServerCanvas() {
 	z_last_list = (RasterizerCanvas::Item **)memalloc(z_range * sizeof(RasterizerCanvas::Item *));
 
 	disable_scale = false;
+
+	cull_index_min_children = GLOBAL_DEF("rendering/quality/2d/cull_index_min_children", 128);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/2d/cull_index_min_children", PropertyInfo(Variant::INT, "rendering/quality/2d/cull_index_min_children", PROPERTY_HINT_RANGE, "0,4096,1"));
 }
 
 VisualServerCanvas::~VisualServerCanvas() {
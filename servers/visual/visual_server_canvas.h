@@ -36,6 +36,41 @@
 
 class VisualServerCanvas {
 public:
+	struct Item;
+
+	// Grid over the children of items that have many, so rendering only visits
+	// the children whose subtree can intersect the clip rect.
+	struct CullIndex {
+
+		Rect2 bounds;
+		int cells_per_side;
+		Vector2 cell_size;
+		Vector<int> cell_start;
+		Vector<int> cell_children;
+		Vector<int> always; // children that must always be visited
+		Vector<int> dynamic; // children changed since the grid was built
+		Vector<Rect2> child_rects;
+		Vector<uint32_t> child_pass;
+		uint32_t pass;
+		Vector<int> visible_slots;
+		Vector<Item *> visible;
+
+		CullIndex() {
+			cells_per_side = 0;
+			pass = 0;
+		}
+	};
+
+	// Y-sorted descendants of an item with sort_y, kept between frames so
+	// they are only collected again when the set of descendants changes.
+	struct YSortCache {
+
+		Vector<Item *> items; // in tree order, parents before their children
+		Vector<int> parents; // index of the sort_y parent in items, -1 for direct children
+		Vector<Item *> material_owners; // material owner passed down to each item
+		Vector<Item *> sorted; // items by position, kept sorted from the last frame
+	};
+
 	struct Item : public RasterizerCanvas::Item {
 
 		RID parent; // canvas it belongs to
@@ -52,10 +87,29 @@ public:
 		Color ysort_modulate;
 		Transform2D ysort_xform;
 		Vector2 ysort_pos;
+		YSortCache *ysort_cache;
 
 		Vector<Item *> child_items;
 
-		Item() {
+		// Bounds of this item and its descendants, in local space.
+		Rect2 subtree_rect;
+		bool subtree_rect_dirty;
+		bool subtree_empty;
+		bool subtree_unculled;
+		int cull_slot;
+		bool cull_dynamic;
+		bool cull_index_dirty;
+		CullIndex *cull_index;
+
+		//physics interpolation, xform is blended between the last two ticks
+		bool interpolated;
+		bool interpolation_moved;
+		Transform2D xform_prev;
+		Transform2D xform_curr;
+		SelfList<Item> interpolation_item;
+
+		Item() :
+				interpolation_item(this) {
 			children_order_dirty = true;
 			E = NULL;
 			z_index = 0;
@@ -68,6 +122,23 @@ public:
 			ysort_children_count = -1;
 			ysort_xform = Transform2D();
 			ysort_pos = Vector2();
+			ysort_cache = NULL;
+			subtree_rect_dirty = true;
+			subtree_empty = true;
+			subtree_unculled = false;
+			cull_slot = 0;
+			cull_dynamic = false;
+			cull_index_dirty = true;
+			cull_index = NULL;
+			interpolated = false;
+			interpolation_moved = false;
+		}
+
+		~Item() {
+			if (cull_index)
+				memdelete(cull_index);
+			if (ysort_cache)
+				memdelete(ysort_cache);
 		}
 	};
 
@@ -90,6 +161,10 @@ public:
 		}
 	};
 
+	enum {
+		YSORT_MAX_MOVES_PER_ITEM = 8 // above this, insertion sort costs more than sorting from scratch
+	};
+
 	struct LightOccluderPolygon : RID_Data {
 
 		bool active;
@@ -152,11 +227,18 @@ public:
 
 	mutable RID_Owner<Canvas> canvas_owner;
 	RID_Owner<Item> canvas_item_owner;
+	SelfList<Item>::List item_interpolation_list;
 	RID_Owner<RasterizerCanvas::Light> canvas_light_owner;
 
 	bool disable_scale;
+	int cull_index_min_children;
 
 private:
+	void _mark_cull_dirty(Item *p_item);
+	void _update_subtree_rect(Item *p_item);
+	void _build_cull_index(Item *p_item);
+	int _cull_children(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect);
+
 	void _render_canvas_item_tree(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RasterizerCanvas::Light *p_lights);
 	void _render_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner);
 	void _light_mask_canvas_items(int p_z, RasterizerCanvas::Item *p_canvas_item, RasterizerCanvas::Light *p_masked_lights);
@@ -180,6 +262,8 @@ public:
 	void canvas_item_set_light_mask(RID p_item, int p_mask);
 
 	void canvas_item_set_transform(RID p_item, const Transform2D &p_transform);
+	void canvas_item_set_interpolated(RID p_item, bool p_interpolated);
+	void canvas_item_reset_physics_interpolation(RID p_item);
 	void canvas_item_set_clip(RID p_item, bool p_clip);
 	void canvas_item_set_distance_field_mode(RID p_item, bool p_enable);
 	void canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect = Rect2());
@@ -256,6 +340,9 @@ public:
 
 	void canvas_occluder_polygon_set_cull_mode(RID p_occluder_polygon, VS::CanvasOccluderPolygonCullMode p_mode);
 
+	void update_interpolation_tick();
+	void update_interpolation_frame(float p_fraction);
+
 	bool free(RID p_rid);
 	VisualServerCanvas();
 	~VisualServerCanvas();
@@ -32,6 +32,7 @@
 
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
+#include "core/os/timeline_profiler.h"
 #include "core/project_settings.h"
 #include "core/sort_array.h"
 #include "visual_server_canvas.h"
@@ -101,14 +102,31 @@ void VisualServerRaster::draw(bool p_swap_buffers, double frame_step) {
 
 	changes = 0;
 
-	VSG::rasterizer->begin_frame(frame_step);
+	if (headless) {
+		//nothing is rendered, only keep instance bounds current for queries
+		VSG::scene->update_dirty_instances();
+	} else {
+		VSG::rasterizer->begin_frame(frame_step);
 
-	VSG::scene->update_dirty_instances(); //update scene stuff
-
-	VSG::viewport->draw_viewports();
-	VSG::scene->render_probes();
-	_draw_margins();
-	VSG::rasterizer->end_frame(p_swap_buffers);
+		{
+			TIMELINE_SCOPE("VisualServer::update_dirty_instances");
+			VSG::scene->update_dirty_instances(); //update scene stuff
+		}
+		{
+			TIMELINE_SCOPE("VisualServer::draw_viewports");
+			VSG::viewport->draw_viewports();
+		}
+		{
+			TIMELINE_SCOPE("VisualServer::render_probes");
+			VSG::scene->render_probes();
+		}
+		VSG::scene->update_visibility_notifiers();
+		_draw_margins();
+		{
+			TIMELINE_SCOPE("VisualServer::end_frame");
+			VSG::rasterizer->end_frame(p_swap_buffers);
+		}
+	}
 
 	while (frame_drawn_callbacks.front()) {
 
@@ -129,6 +147,16 @@ void VisualServerRaster::draw(bool p_swap_buffers, double frame_step) {
 }
 void VisualServerRaster::sync() {
 }
+void VisualServerRaster::tick() {
+
+	VSG::scene->update_interpolation_tick();
+	VSG::canvas->update_interpolation_tick();
+}
+void VisualServerRaster::pre_draw(float p_interpolation_fraction) {
+
+	VSG::scene->update_interpolation_frame(p_interpolation_fraction);
+	VSG::canvas->update_interpolation_frame(p_interpolation_fraction);
+}
 bool VisualServerRaster::has_changed() const {
 
 	return changes > 0;
@@ -191,11 +219,26 @@ bool VisualServerRaster::has_os_feature(const String &p_feature) const {
 	return VSG::storage->has_os_feature(p_feature);
 }
 
+void VisualServerRaster::set_headless(bool p_headless) {
+
+	headless = p_headless;
+}
+
+bool VisualServerRaster::is_headless() const {
+
+	return headless;
+}
+
 void VisualServerRaster::set_debug_generate_wireframes(bool p_generate) {
 
 	VSG::storage->set_debug_generate_wireframes(p_generate);
 }
 
+void VisualServerRaster::warm_up_shaders() {
+
+	VSG::storage->warm_up_shaders();
+}
+
 void VisualServerRaster::call_set_use_vsync(bool p_enable) {
 	OS::get_singleton()->_set_use_vsync(p_enable);
 }
@@ -217,6 +260,8 @@ VisualServerRaster::VisualServerRaster() {
 		black_margin[i] = 0;
 		black_image[i] = RID();
 	}
+
+	headless = false;
 }
 
 VisualServerRaster::~VisualServerRaster() {
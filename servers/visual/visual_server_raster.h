@@ -57,6 +57,8 @@ class VisualServerRaster : public VisualServer {
 	static int changes;
 	RID test_cube;
 
+	bool headless;
+
 	int black_margin[4];
 	RID black_image[4];
 
@@ -83,6 +85,7 @@ public:
 	}
 
 #define DISPLAY_CHANGED \
+	HEADLESS_DISCARD    \
 	changes++;          \
 	_changes_changed();
 
@@ -90,9 +93,12 @@ public:
 	_FORCE_INLINE_ static void redraw_request() { changes++; }
 
 #define DISPLAY_CHANGED \
+	HEADLESS_DISCARD    \
 	changes++;
 #endif
 
+#define HEADLESS_DISCARD
+
 #define BIND0R(m_r, m_name) \
 	m_r m_name() { return BINDBASE->m_name(); }
 #define BIND1R(m_r, m_name, m_type1) \
@@ -162,6 +168,9 @@ public:
 	BIND3(texture_set_detect_srgb_callback, RID, TextureDetectCallback, void *)
 	BIND3(texture_set_detect_normal_callback, RID, TextureDetectCallback, void *)
 
+	BIND3(texture_set_stream_callback, RID, TextureStreamCallback, void *)
+	BIND3(texture_set_stream_data, RID, const Ref<Image> &, int)
+
 	BIND2(texture_set_path, RID, const String &)
 	BIND1RC(String, texture_get_path, RID)
 	BIND1(texture_set_shrink_all_x2_on_set_data, bool)
@@ -235,6 +244,8 @@ public:
 	BIND2RC(Vector<PoolVector<uint8_t> >, mesh_surface_get_blend_shapes, RID, int)
 	BIND2RC(Vector<AABB>, mesh_surface_get_skeleton_aabb, RID, int)
 
+	BIND4(mesh_surface_set_lods, RID, int, const Vector<float> &, const Vector<PoolVector<uint8_t> > &)
+
 	BIND2(mesh_remove_surface, RID, int)
 	BIND1RC(int, mesh_get_surface_count, RID)
 
@@ -265,6 +276,7 @@ public:
 	BIND2RC(Color, multimesh_instance_get_custom_data, RID, int)
 
 	BIND2(multimesh_set_as_bulk_array, RID, const PoolVector<float> &)
+	BIND3(multimesh_set_as_bulk_array_range, RID, int, const PoolVector<float> &)
 
 	BIND2(multimesh_set_visible_instances, RID, int)
 	BIND1RC(int, multimesh_get_visible_instances, RID)
@@ -290,6 +302,7 @@ public:
 	BIND3(skeleton_allocate, RID, int, bool)
 	BIND1RC(int, skeleton_get_bone_count, RID)
 	BIND3(skeleton_bone_set_transform, RID, int, const Transform &)
+	BIND2(skeleton_set_bone_transforms, RID, const Vector<Transform> &)
 	BIND2RC(Transform, skeleton_bone_get_transform, RID, int)
 	BIND3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	BIND2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
@@ -409,6 +422,8 @@ public:
 	BIND2(particles_set_process_material, RID, RID)
 	BIND2(particles_set_fixed_fps, RID, int)
 	BIND2(particles_set_fractional_delta, RID, bool)
+	BIND3(particles_set_collision_heightfield, RID, RID, const AABB &)
+	BIND2(particles_set_collision_bounce, RID, float)
 	BIND1R(bool, particles_is_inactive, RID)
 	BIND1(particles_request_process, RID)
 	BIND1(particles_restart, RID)
@@ -432,6 +447,8 @@ public:
 	BIND4(camera_set_orthogonal, RID, float, float, float)
 	BIND5(camera_set_frustum, RID, float, Vector2, float, float)
 	BIND2(camera_set_transform, RID, const Transform &)
+	BIND2(camera_set_interpolated, RID, bool)
+	BIND1(camera_reset_physics_interpolation, RID)
 	BIND2(camera_set_cull_mask, RID, uint32_t)
 	BIND2(camera_set_environment, RID, RID)
 	BIND2(camera_set_use_vertical_aspect, RID, bool)
@@ -504,7 +521,9 @@ public:
 	BIND4(environment_set_ambient_light, RID, const Color &, float, float)
 	BIND2(environment_set_camera_feed_id, RID, int)
 	BIND7(environment_set_ssr, RID, bool, int, float, float, float, bool)
+	BIND3(environment_set_ssr_resolution, RID, EnvironmentEffectResolution, bool)
 	BIND13(environment_set_ssao, RID, bool, float, float, float, float, float, float, float, const Color &, EnvironmentSSAOQuality, EnvironmentSSAOBlur, float)
+	BIND3(environment_set_ssao_resolution, RID, EnvironmentEffectResolution, bool)
 
 	BIND6(environment_set_dof_blur_near, RID, bool, float, float, float, EnvironmentDOFBlurQuality)
 	BIND6(environment_set_dof_blur_far, RID, bool, float, float, float, EnvironmentDOFBlurQuality)
@@ -526,6 +545,7 @@ public:
 	BIND0R(RID, scenario_create)
 
 	BIND2(scenario_set_debug, RID, ScenarioDebugMode)
+	BIND2(scenario_set_spatial_partitioning, RID, ScenarioSpatialPartitioning)
 	BIND2(scenario_set_environment, RID, RID)
 	BIND3(scenario_set_reflection_atlas_size, RID, int, int)
 	BIND2(scenario_set_fallback_environment, RID, RID)
@@ -537,12 +557,18 @@ public:
 	BIND2(instance_set_scenario, RID, RID)
 	BIND2(instance_set_layer_mask, RID, uint32_t)
 	BIND2(instance_set_transform, RID, const Transform &)
+	BIND2(instance_set_interpolated, RID, bool)
+	BIND1(instance_reset_physics_interpolation, RID)
 	BIND2(instance_attach_object_instance_id, RID, ObjectID)
 	BIND3(instance_set_blend_shape_weight, RID, int, float)
 	BIND3(instance_set_surface_material, RID, int, RID)
 	BIND2(instance_set_visible, RID, bool)
 	BIND3(instance_set_use_lightmap, RID, RID, RID)
 
+	BIND2(instances_set_transforms, const Vector<RID> &, const Vector<Transform> &)
+	BIND2(instances_set_visible, const Vector<RID> &, const Vector<bool> &)
+	BIND2(instances_geometry_set_material_override, const Vector<RID> &, RID)
+
 	BIND2(instance_set_custom_aabb, RID, AABB)
 
 	BIND2(instance_attach_skeleton, RID, RID)
@@ -562,6 +588,20 @@ public:
 	BIND5(instance_geometry_set_draw_range, RID, float, float, float, float)
 	BIND2(instance_geometry_set_as_instance_lod, RID, RID)
 
+	/* OCCLUDER API */
+
+	BIND0R(RID, occluder_create)
+	BIND2(occluder_set_scenario, RID, RID)
+	BIND2(occluder_set_transform, RID, const Transform &)
+	BIND2(occluder_set_faces, RID, const PoolVector<Vector3> &)
+	BIND2(occluder_set_enabled, RID, bool)
+
+	/* VISIBILITY NOTIFIER API */
+
+	BIND0R(RID, visibility_notifier_create)
+	BIND2(visibility_notifier_set_aabb, RID, const AABB &)
+	BIND1R(Vector<VisibilityNotifierEvent>, scenario_get_visibility_notifier_events, RID)
+
 #undef BINDBASE
 //from now on, calls forwarded to this singleton
 #define BINDBASE VSG::canvas
@@ -583,6 +623,8 @@ public:
 	BIND2(canvas_item_set_update_when_visible, RID, bool)
 
 	BIND2(canvas_item_set_transform, RID, const Transform2D &)
+	BIND2(canvas_item_set_interpolated, RID, bool)
+	BIND1(canvas_item_reset_physics_interpolation, RID)
 	BIND2(canvas_item_set_clip, RID, bool)
 	BIND2(canvas_item_set_distance_field_mode, RID, bool)
 	BIND3(canvas_item_set_custom_rect, RID, bool, const Rect2 &)
@@ -591,6 +633,12 @@ public:
 
 	BIND2(canvas_item_set_draw_behind_parent, RID, bool)
 
+	//draw commands are never rendered when headless, so don't store them
+#undef HEADLESS_DISCARD
+#define HEADLESS_DISCARD \
+	if (headless)        \
+		return;
+
 	BIND6(canvas_item_add_line, RID, const Point2 &, const Point2 &, const Color &, float, bool)
 	BIND5(canvas_item_add_polyline, RID, const Vector<Point2> &, const Vector<Color> &, float, bool)
 	BIND5(canvas_item_add_multiline, RID, const Vector<Point2> &, const Vector<Color> &, float, bool)
@@ -607,6 +655,10 @@ public:
 	BIND4(canvas_item_add_particles, RID, RID, RID, RID)
 	BIND2(canvas_item_add_set_transform, RID, const Transform2D &)
 	BIND2(canvas_item_add_clip_ignore, RID, bool)
+
+#undef HEADLESS_DISCARD
+#define HEADLESS_DISCARD
+
 	BIND2(canvas_item_set_sort_children_by_y, RID, bool)
 	BIND2(canvas_item_set_z_index, RID, int)
 	BIND2(canvas_item_set_z_as_relative_to_parent, RID, bool)
@@ -672,6 +724,8 @@ public:
 
 	virtual void draw(bool p_swap_buffers, double frame_step);
 	virtual void sync();
+	virtual void tick();
+	virtual void pre_draw(float p_interpolation_fraction);
 	virtual bool has_changed() const;
 	virtual void init();
 	virtual void finish();
@@ -694,14 +748,20 @@ public:
 	virtual bool has_os_feature(const String &p_feature) const;
 	virtual void set_debug_generate_wireframes(bool p_generate);
 
+	virtual void warm_up_shaders();
+
 	virtual void call_set_use_vsync(bool p_enable);
 
 	virtual bool is_low_end() const;
 
+	void set_headless(bool p_headless);
+	virtual bool is_headless() const;
+
 	VisualServerRaster();
 	~VisualServerRaster();
 
 #undef DISPLAY_CHANGED
+#undef HEADLESS_DISCARD
 
 #undef BIND0R
 #undef BIND1RC
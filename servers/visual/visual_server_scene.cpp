@@ -30,7 +30,10 @@
 
 #include "visual_server_scene.h"
 
+#include "core/frame_arena.h"
 #include "core/os/os.h"
+#include "core/os/threaded_array_processor.h"
+#include "core/project_settings.h"
 #include "visual_server_globals.h"
 #include "visual_server_raster.h"
 
@@ -78,7 +81,48 @@ void VisualServerScene::camera_set_transform(RID p_camera, const Transform &p_tr
 
 	Camera *camera = camera_owner.get(p_camera);
 	ERR_FAIL_COND(!camera);
-	camera->transform = p_transform.orthonormalized();
+	Transform transform = p_transform.orthonormalized();
+
+	if (camera->interpolated) {
+		camera->transform_curr = transform;
+		camera->interpolation_moved = true;
+		if (!camera->interpolation_item.in_list()) {
+			camera_interpolation_list.add(&camera->interpolation_item);
+		}
+		return;
+	}
+
+	camera->transform = transform;
+}
+
+void VisualServerScene::camera_set_interpolated(RID p_camera, bool p_interpolated) {
+
+	Camera *camera = camera_owner.get(p_camera);
+	ERR_FAIL_COND(!camera);
+
+	if (camera->interpolated == p_interpolated)
+		return;
+
+	camera->interpolated = p_interpolated;
+	if (p_interpolated) {
+		camera->transform_curr = camera->transform;
+		camera->transform_prev = camera->transform;
+	} else {
+		camera->transform = camera->transform_curr;
+		camera_interpolation_list.remove(&camera->interpolation_item);
+	}
+}
+
+void VisualServerScene::camera_reset_physics_interpolation(RID p_camera) {
+
+	Camera *camera = camera_owner.get(p_camera);
+	ERR_FAIL_COND(!camera);
+
+	if (!camera->interpolated)
+		return;
+
+	camera->transform_prev = camera->transform_curr;
+	camera->transform = camera->transform_curr;
 }
 
 void VisualServerScene::camera_set_cull_mask(RID p_camera, uint32_t p_layers) {
@@ -105,7 +149,7 @@ void VisualServerScene::camera_set_use_vertical_aspect(RID p_camera, bool p_enab
 
 /* SCENARIO API */
 
-void *VisualServerScene::_instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int) {
+void *VisualServerScene::_instance_pair(void *p_self, SpatialPartitionID, Instance *p_A, int, SpatialPartitionID, Instance *p_B, int) {
 
 	//VisualServerScene *self = (VisualServerScene*)p_self;
 	Instance *A = p_A;
@@ -129,7 +173,7 @@ void *VisualServerScene::_instance_pair(void *p_self, OctreeElementID, Instance
 
 		if (geom->can_cast_shadows) {
 
-			light->shadow_dirty = true;
+			light->shadow_dirty_passes |= ((VisualServerScene *)p_self)->_light_get_shadow_passes_for_aabb(B, A->transformed_aabb);
 		}
 		geom->lighting_dirty = true;
 
@@ -184,7 +228,7 @@ void *VisualServerScene::_instance_pair(void *p_self, OctreeElementID, Instance
 
 	return NULL;
 }
-void VisualServerScene::_instance_unpair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int, void *udata) {
+void VisualServerScene::_instance_unpair(void *p_self, SpatialPartitionID, Instance *p_A, int, SpatialPartitionID, Instance *p_B, int, void *udata) {
 
 	//VisualServerScene *self = (VisualServerScene*)p_self;
 	Instance *A = p_A;
@@ -206,7 +250,7 @@ void VisualServerScene::_instance_unpair(void *p_self, OctreeElementID, Instance
 		light->geometries.erase(E);
 
 		if (geom->can_cast_shadows) {
-			light->shadow_dirty = true;
+			light->shadow_dirty_passes |= ((VisualServerScene *)p_self)->_light_get_shadow_passes_for_aabb(B, A->transformed_aabb);
 		}
 		geom->lighting_dirty = true;
 
@@ -253,6 +297,25 @@ void VisualServerScene::_instance_unpair(void *p_self, OctreeElementID, Instance
 	}
 }
 
+void VisualServerScene::_scenario_create_spatial_partitioning(Scenario *p_scenario, VS::ScenarioSpatialPartitioning p_mode) {
+
+	if (p_scenario->sps)
+		memdelete(p_scenario->sps);
+
+	switch (p_mode) {
+		case VS::SCENARIO_SPATIAL_PARTITIONING_BVH: {
+			p_scenario->sps = memnew(SpatialPartitioningScene_BVH);
+		} break;
+		default: {
+			p_scenario->sps = memnew(SpatialPartitioningScene_Octree);
+		}
+	}
+
+	p_scenario->spatial_partitioning = p_mode;
+	p_scenario->sps->set_pair_callback(_instance_pair, this);
+	p_scenario->sps->set_unpair_callback(_instance_unpair, this);
+}
+
 RID VisualServerScene::scenario_create() {
 
 	Scenario *scenario = memnew(Scenario);
@@ -260,8 +323,7 @@ RID VisualServerScene::scenario_create() {
 	RID scenario_rid = scenario_owner.make_rid(scenario);
 	scenario->self = scenario_rid;
 
-	scenario->octree.set_pair_callback(_instance_pair, this);
-	scenario->octree.set_unpair_callback(_instance_unpair, this);
+	_scenario_create_spatial_partitioning(scenario, default_spatial_partitioning);
 	scenario->reflection_probe_shadow_atlas = VSG::scene_render->shadow_atlas_create();
 	VSG::scene_render->shadow_atlas_set_size(scenario->reflection_probe_shadow_atlas, 1024); //make enough shadows for close distance, don't bother with rest
 	VSG::scene_render->shadow_atlas_set_quadrant_subdivision(scenario->reflection_probe_shadow_atlas, 0, 4);
@@ -280,6 +342,29 @@ void VisualServerScene::scenario_set_debug(RID p_scenario, VS::ScenarioDebugMode
 	scenario->debug = p_debug_mode;
 }
 
+void VisualServerScene::scenario_set_spatial_partitioning(RID p_scenario, VS::ScenarioSpatialPartitioning p_mode) {
+
+	Scenario *scenario = scenario_owner.get(p_scenario);
+	ERR_FAIL_COND(!scenario);
+	ERR_FAIL_INDEX(p_mode, VS::SCENARIO_SPATIAL_PARTITIONING_MAX);
+
+	if (scenario->spatial_partitioning == p_mode)
+		return;
+
+	// take everything out of the old structure (this unpairs it all), and queue it to be added to the new one
+	for (SelfList<Instance> *E = scenario->instances.first(); E; E = E->next()) {
+
+		Instance *instance = E->self();
+		if (instance->spatial_partition_id) {
+			scenario->sps->erase(instance->spatial_partition_id);
+			instance->spatial_partition_id = 0;
+			_instance_queue_update(instance, true, false);
+		}
+	}
+
+	_scenario_create_spatial_partitioning(scenario, p_mode);
+}
+
 void VisualServerScene::scenario_set_environment(RID p_scenario, RID p_environment) {
 
 	Scenario *scenario = scenario_owner.get(p_scenario);
@@ -319,10 +404,8 @@ void VisualServerScene::_instance_queue_update(Instance *p_instance, bool p_upda
 
 RID VisualServerScene::instance_create() {
 
-	Instance *instance = memnew(Instance);
-	ERR_FAIL_COND_V(!instance, RID());
-
-	RID instance_rid = instance_owner.make_rid(instance);
+	RID instance_rid = instance_owner.make_rid();
+	Instance *instance = instance_owner.getptr(instance_rid);
 	instance->self = instance_rid;
 
 	return instance_rid;
@@ -338,7 +421,9 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 	if (instance->base_type != VS::INSTANCE_NONE) {
 		//free anything related to that base
 
-		VSG::storage->instance_remove_dependency(instance->base, instance);
+		if (instance->base_type != VS::INSTANCE_VISIBILITY_NOTIFIER) {
+			VSG::storage->instance_remove_dependency(instance->base, instance);
+		}
 
 		if (instance->base_type == VS::INSTANCE_GI_PROBE) {
 			//if gi probe is baking, wait until done baking, else race condition may happen when removing it
@@ -357,9 +442,9 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 			}
 		}
 
-		if (scenario && instance->octree_id) {
-			scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-			instance->octree_id = 0;
+		if (scenario && instance->spatial_partition_id) {
+			scenario->sps->erase(instance->spatial_partition_id); //make dependencies generated by the spatial partitioning go away
+			instance->spatial_partition_id = 0;
 		}
 
 		switch (instance->base_type) {
@@ -389,6 +474,14 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 					instance_set_use_lightmap(lightmap_capture->users.front()->get()->self, RID(), RID());
 				}
 			} break;
+			case VS::INSTANCE_VISIBILITY_NOTIFIER: {
+
+				_visibility_notifier_clear(instance);
+				VisibilityNotifier *notifier = visibility_notifier_owner.getornull(instance->base);
+				if (notifier) {
+					notifier->instances.erase(instance);
+				}
+			} break;
 			case VS::INSTANCE_GI_PROBE: {
 
 				InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(instance->base_data);
@@ -435,7 +528,11 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 
 	if (p_base.is_valid()) {
 
-		instance->base_type = VSG::storage->get_base_type(p_base);
+		if (visibility_notifier_owner.owns(p_base)) {
+			instance->base_type = VS::INSTANCE_VISIBILITY_NOTIFIER;
+		} else {
+			instance->base_type = VSG::storage->get_base_type(p_base);
+		}
 		ERR_FAIL_COND(instance->base_type == VS::INSTANCE_NONE);
 
 		switch (instance->base_type) {
@@ -476,6 +573,14 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 				instance->base_data = lightmap_capture;
 				//lightmap_capture->instance = VSG::scene_render->lightmap_capture_instance_create(p_base);
 			} break;
+			case VS::INSTANCE_VISIBILITY_NOTIFIER: {
+
+				InstanceVisibilityNotifierData *notifier_data = memnew(InstanceVisibilityNotifierData);
+				notifier_data->owner = instance;
+				instance->base_data = notifier_data;
+
+				visibility_notifier_owner.get(p_base)->instances.insert(instance);
+			} break;
 			case VS::INSTANCE_GI_PROBE: {
 
 				InstanceGIProbeData *gi_probe = memnew(InstanceGIProbeData);
@@ -493,7 +598,9 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 			}
 		}
 
-		VSG::storage->instance_add_dependency(p_base, instance);
+		if (instance->base_type != VS::INSTANCE_VISIBILITY_NOTIFIER) {
+			VSG::storage->instance_add_dependency(p_base, instance);
+		}
 
 		instance->base = p_base;
 
@@ -510,9 +617,9 @@ void VisualServerScene::instance_set_scenario(RID p_instance, RID p_scenario) {
 
 		instance->scenario->instances.remove(&instance->scenario_item);
 
-		if (instance->octree_id) {
-			instance->scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-			instance->octree_id = 0;
+		if (instance->spatial_partition_id) {
+			instance->scenario->sps->erase(instance->spatial_partition_id); //make dependencies generated by the spatial partitioning go away
+			instance->spatial_partition_id = 0;
 		}
 
 		switch (instance->base_type) {
@@ -531,6 +638,10 @@ void VisualServerScene::instance_set_scenario(RID p_instance, RID p_scenario) {
 				InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(instance->base_data);
 				VSG::scene_render->reflection_probe_release_atlas_index(reflection_probe->instance);
 			} break;
+			case VS::INSTANCE_VISIBILITY_NOTIFIER: {
+
+				_visibility_notifier_clear(instance);
+			} break;
 			case VS::INSTANCE_GI_PROBE: {
 
 				InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(instance->base_data);
@@ -590,7 +701,25 @@ void VisualServerScene::instance_set_transform(RID p_instance, const Transform &
 	Instance *instance = instance_owner.get(p_instance);
 	ERR_FAIL_COND(!instance);
 
-	if (instance->transform == p_transform)
+	_instance_set_transform(instance, p_transform);
+}
+void VisualServerScene::instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform> &p_transforms) {
+
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform *transforms = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+
+		Instance *instance = instance_owner.getornull(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		_instance_set_transform(instance, transforms[i]);
+	}
+}
+void VisualServerScene::_instance_set_transform(Instance *p_instance, const Transform &p_transform) {
+
+	if ((p_instance->interpolated ? p_instance->transform_curr : p_instance->transform) == p_transform)
 		return; //must be checked to avoid worst evil
 
 #ifdef DEBUG_ENABLED
@@ -606,8 +735,111 @@ void VisualServerScene::instance_set_transform(RID p_instance, const Transform &
 	}
 
 #endif
-	instance->transform = p_transform;
-	_instance_queue_update(instance, true);
+
+	if (p_instance->interpolated) {
+		//the rendered transform is blended in update_interpolation_frame()
+		p_instance->transform_curr = p_transform;
+		p_instance->interpolation_moved = true;
+		if (!p_instance->interpolation_item.in_list()) {
+			_instance_interpolation_list.add(&p_instance->interpolation_item);
+		}
+		return;
+	}
+
+	p_instance->transform = p_transform;
+	_instance_queue_update(p_instance, true);
+}
+
+void VisualServerScene::instance_set_interpolated(RID p_instance, bool p_interpolated) {
+
+	Instance *instance = instance_owner.get(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	if (instance->interpolated == p_interpolated)
+		return;
+
+	instance->interpolated = p_interpolated;
+	if (p_interpolated) {
+		instance->transform_curr = instance->transform;
+		instance->transform_prev = instance->transform;
+	} else {
+		_instance_interpolation_list.remove(&instance->interpolation_item);
+		if (instance->transform != instance->transform_curr) {
+			instance->transform = instance->transform_curr;
+			_instance_queue_update(instance, true);
+		}
+	}
+}
+
+void VisualServerScene::instance_reset_physics_interpolation(RID p_instance) {
+
+	Instance *instance = instance_owner.get(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	if (!instance->interpolated)
+		return;
+
+	instance->transform_prev = instance->transform_curr;
+	if (instance->transform != instance->transform_curr) {
+		instance->transform = instance->transform_curr;
+		_instance_queue_update(instance, true);
+	}
+}
+
+void VisualServerScene::update_interpolation_tick() {
+
+	//the transforms set during the last tick become the previous ones, anything that did not move stops interpolating
+
+	SelfList<Instance> *I = _instance_interpolation_list.first();
+	while (I) {
+		SelfList<Instance> *N = I->next();
+		Instance *instance = I->self();
+
+		if (instance->interpolation_moved) {
+			instance->transform_prev = instance->transform_curr;
+			instance->interpolation_moved = false;
+		} else {
+			_instance_interpolation_list.remove(I);
+			if (instance->transform != instance->transform_curr) {
+				instance->transform = instance->transform_curr;
+				_instance_queue_update(instance, true);
+			}
+		}
+		I = N;
+	}
+
+	SelfList<Camera> *C = camera_interpolation_list.first();
+	while (C) {
+		SelfList<Camera> *N = C->next();
+		Camera *camera = C->self();
+
+		if (camera->interpolation_moved) {
+			camera->transform_prev = camera->transform_curr;
+			camera->interpolation_moved = false;
+		} else {
+			camera_interpolation_list.remove(C);
+			camera->transform = camera->transform_curr;
+		}
+		C = N;
+	}
+}
+
+void VisualServerScene::update_interpolation_frame(float p_fraction) {
+
+	for (SelfList<Instance> *I = _instance_interpolation_list.first(); I; I = I->next()) {
+		Instance *instance = I->self();
+
+		Transform transform = instance->transform_prev.interpolate_with(instance->transform_curr, p_fraction);
+		if (instance->transform != transform) {
+			instance->transform = transform;
+			_instance_queue_update(instance, true);
+		}
+	}
+
+	for (SelfList<Camera> *C = camera_interpolation_list.first(); C; C = C->next()) {
+		Camera *camera = C->self();
+		camera->transform = camera->transform_prev.interpolate_with(camera->transform_curr, p_fraction);
+	}
 }
 void VisualServerScene::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
 
@@ -657,33 +889,51 @@ void VisualServerScene::instance_set_visible(RID p_instance, bool p_visible) {
 	Instance *instance = instance_owner.get(p_instance);
 	ERR_FAIL_COND(!instance);
 
-	if (instance->visible == p_visible)
+	_instance_set_visible(instance, p_visible);
+}
+void VisualServerScene::instances_set_visible(const Vector<RID> &p_instances, const Vector<bool> &p_visible) {
+
+	ERR_FAIL_COND(p_instances.size() != p_visible.size());
+
+	const RID *instances = p_instances.ptr();
+	const bool *visible = p_visible.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+
+		Instance *instance = instance_owner.getornull(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		_instance_set_visible(instance, visible[i]);
+	}
+}
+void VisualServerScene::_instance_set_visible(Instance *p_instance, bool p_visible) {
+
+	if (p_instance->visible == p_visible)
 		return;
 
-	instance->visible = p_visible;
+	p_instance->visible = p_visible;
 
-	switch (instance->base_type) {
+	switch (p_instance->base_type) {
 		case VS::INSTANCE_LIGHT: {
-			if (VSG::storage->light_get_type(instance->base) != VS::LIGHT_DIRECTIONAL && instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_LIGHT, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
+			if (VSG::storage->light_get_type(p_instance->base) != VS::LIGHT_DIRECTIONAL && p_instance->spatial_partition_id && p_instance->scenario) {
+				p_instance->scenario->sps->set_pairable(p_instance->spatial_partition_id, p_visible, 1 << VS::INSTANCE_LIGHT, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case VS::INSTANCE_REFLECTION_PROBE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_REFLECTION_PROBE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
+			if (p_instance->spatial_partition_id && p_instance->scenario) {
+				p_instance->scenario->sps->set_pairable(p_instance->spatial_partition_id, p_visible, 1 << VS::INSTANCE_REFLECTION_PROBE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case VS::INSTANCE_LIGHTMAP_CAPTURE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_LIGHTMAP_CAPTURE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
+			if (p_instance->spatial_partition_id && p_instance->scenario) {
+				p_instance->scenario->sps->set_pairable(p_instance->spatial_partition_id, p_visible, 1 << VS::INSTANCE_LIGHTMAP_CAPTURE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case VS::INSTANCE_GI_PROBE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_GI_PROBE, p_visible ? (VS::INSTANCE_GEOMETRY_MASK | (1 << VS::INSTANCE_LIGHT)) : 0);
+			if (p_instance->spatial_partition_id && p_instance->scenario) {
+				p_instance->scenario->sps->set_pairable(p_instance->spatial_partition_id, p_visible, 1 << VS::INSTANCE_GI_PROBE, p_visible ? (VS::INSTANCE_GEOMETRY_MASK | (1 << VS::INSTANCE_LIGHT)) : 0);
 			}
 
 		} break;
@@ -787,7 +1037,7 @@ Vector<ObjectID> VisualServerScene::instances_cull_aabb(const AABB &p_aabb, RID
 
 	int culled = 0;
 	Instance *cull[1024];
-	culled = scenario->octree.cull_aabb(p_aabb, cull, 1024);
+	culled = scenario->sps->cull_aabb(p_aabb, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 
@@ -810,7 +1060,7 @@ Vector<ObjectID> VisualServerScene::instances_cull_ray(const Vector3 &p_from, co
 
 	int culled = 0;
 	Instance *cull[1024];
-	culled = scenario->octree.cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
+	culled = scenario->sps->cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 		Instance *instance = cull[i];
@@ -833,7 +1083,7 @@ Vector<ObjectID> VisualServerScene::instances_cull_convex(const Vector<Plane> &p
 	int culled = 0;
 	Instance *cull[1024];
 
-	culled = scenario->octree.cull_convex(p_convex, cull, 1024);
+	culled = scenario->sps->cull_convex(p_convex, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 
@@ -882,14 +1132,29 @@ void VisualServerScene::instance_geometry_set_material_override(RID p_instance,
 	Instance *instance = instance_owner.get(p_instance);
 	ERR_FAIL_COND(!instance);
 
-	if (instance->material_override.is_valid()) {
-		VSG::storage->material_remove_instance_owner(instance->material_override, instance);
+	_instance_geometry_set_material_override(instance, p_material);
+}
+void VisualServerScene::instances_geometry_set_material_override(const Vector<RID> &p_instances, RID p_material) {
+
+	const RID *instances = p_instances.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+
+		Instance *instance = instance_owner.getornull(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		_instance_geometry_set_material_override(instance, p_material);
 	}
-	instance->material_override = p_material;
-	instance->base_changed(false, true);
+}
+void VisualServerScene::_instance_geometry_set_material_override(Instance *p_instance, RID p_material) {
+
+	if (p_instance->material_override.is_valid()) {
+		VSG::storage->material_remove_instance_owner(p_instance->material_override, p_instance);
+	}
+	p_instance->material_override = p_material;
+	p_instance->base_changed(false, true);
 
-	if (instance->material_override.is_valid()) {
-		VSG::storage->material_add_instance_owner(instance->material_override, instance);
+	if (p_instance->material_override.is_valid()) {
+		VSG::storage->material_add_instance_owner(p_instance->material_override, p_instance);
 	}
 }
 
@@ -898,6 +1163,233 @@ void VisualServerScene::instance_geometry_set_draw_range(RID p_instance, float p
 void VisualServerScene::instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance) {
 }
 
+/* OCCLUDER API */
+
+RID VisualServerScene::occluder_create() {
+
+	Occluder *occluder = memnew(Occluder);
+	ERR_FAIL_COND_V(!occluder, RID());
+
+	RID occluder_rid = occluder_owner.make_rid(occluder);
+	occluder->self = occluder_rid;
+
+	return occluder_rid;
+}
+
+void VisualServerScene::occluder_set_scenario(RID p_occluder, RID p_scenario) {
+
+	Occluder *occluder = occluder_owner.getornull(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	if (occluder->scenario) {
+		occluder->scenario->occluders.remove(&occluder->scenario_item);
+		occluder->scenario = NULL;
+	}
+
+	if (p_scenario.is_valid()) {
+		Scenario *scenario = scenario_owner.getornull(p_scenario);
+		ERR_FAIL_COND(!scenario);
+
+		occluder->scenario = scenario;
+		scenario->occluders.add(&occluder->scenario_item);
+	}
+}
+
+void VisualServerScene::occluder_set_transform(RID p_occluder, const Transform &p_transform) {
+
+	Occluder *occluder = occluder_owner.getornull(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	occluder->transform = p_transform;
+	occluder->transformed_aabb = p_transform.xform(occluder->aabb);
+}
+
+void VisualServerScene::occluder_set_faces(RID p_occluder, const PoolVector<Vector3> &p_faces) {
+
+	Occluder *occluder = occluder_owner.getornull(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	ERR_FAIL_COND(p_faces.size() % 3);
+
+	occluder->faces = p_faces;
+	occluder->aabb = AABB();
+
+	PoolVector<Vector3>::Read r = p_faces.read();
+	for (int i = 0; i < p_faces.size(); i++) {
+		if (i == 0) {
+			occluder->aabb.position = r[i];
+		} else {
+			occluder->aabb.expand_to(r[i]);
+		}
+	}
+
+	occluder->transformed_aabb = occluder->transform.xform(occluder->aabb);
+}
+
+void VisualServerScene::occluder_set_enabled(RID p_occluder, bool p_enabled) {
+
+	Occluder *occluder = occluder_owner.getornull(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	occluder->enabled = p_enabled;
+}
+
+/* VISIBILITY NOTIFIER API */
+
+RID VisualServerScene::visibility_notifier_create() {
+
+	VisibilityNotifier *notifier = memnew(VisibilityNotifier);
+	ERR_FAIL_COND_V(!notifier, RID());
+
+	return visibility_notifier_owner.make_rid(notifier);
+}
+
+void VisualServerScene::visibility_notifier_set_aabb(RID p_notifier, const AABB &p_aabb) {
+
+	VisibilityNotifier *notifier = visibility_notifier_owner.getornull(p_notifier);
+	ERR_FAIL_COND(!notifier);
+
+	notifier->aabb = p_aabb;
+
+	for (Set<Instance *>::Element *E = notifier->instances.front(); E; E = E->next()) {
+		_instance_queue_update(E->get(), true, false);
+	}
+}
+
+Vector<VS::VisibilityNotifierEvent> VisualServerScene::scenario_get_visibility_notifier_events(RID p_scenario) {
+
+	Scenario *scenario = scenario_owner.getornull(p_scenario);
+	ERR_FAIL_COND_V(!scenario, Vector<VS::VisibilityNotifierEvent>());
+
+	Vector<VS::VisibilityNotifierEvent> events = scenario->visibility_notifier_events;
+	scenario->visibility_notifier_events.clear();
+	return events;
+}
+
+void VisualServerScene::_visibility_notifier_seen(Instance *p_instance) {
+
+	InstanceVisibilityNotifierData *notifier_data = static_cast<InstanceVisibilityNotifierData *>(p_instance->base_data);
+
+	InstanceVisibilityNotifierData::CameraPass *cameras = notifier_data->cameras.ptrw();
+	for (int i = 0; i < notifier_data->cameras.size(); i++) {
+		if (cameras[i].camera == visibility_camera) {
+			cameras[i].pass = visibility_notifier_pass;
+			return;
+		}
+	}
+
+	InstanceVisibilityNotifierData::CameraPass camera_pass;
+	camera_pass.camera = visibility_camera;
+	camera_pass.pass = visibility_notifier_pass;
+	notifier_data->cameras.push_back(camera_pass);
+
+	if (!notifier_data->visible_item.in_list()) {
+		visible_notifier_list.add(&notifier_data->visible_item);
+	}
+
+	VS::VisibilityNotifierEvent event;
+	event.notifier = p_instance->object_id;
+	event.camera = visibility_camera;
+	event.entered = true;
+	p_instance->scenario->visibility_notifier_events.push_back(event);
+}
+
+void VisualServerScene::_visibility_notifier_clear(Instance *p_instance) {
+
+	//the scene side forgets the notifier on its own when it leaves, so no exit events are sent
+	InstanceVisibilityNotifierData *notifier_data = static_cast<InstanceVisibilityNotifierData *>(p_instance->base_data);
+
+	if (notifier_data->visible_item.in_list()) {
+		visible_notifier_list.remove(&notifier_data->visible_item);
+	}
+	notifier_data->cameras.clear();
+
+	if (!p_instance->scenario) {
+		return;
+	}
+
+	Vector<VS::VisibilityNotifierEvent> &events = p_instance->scenario->visibility_notifier_events;
+	for (int i = 0; i < events.size(); i++) {
+		if (events[i].notifier == p_instance->object_id) {
+			events.remove(i);
+			i--;
+		}
+	}
+}
+
+void VisualServerScene::update_visibility_notifiers() {
+
+	//anything not seen by a camera during the frame that just rendered has exited it
+	SelfList<InstanceVisibilityNotifierData> *E = visible_notifier_list.first();
+	while (E) {
+
+		SelfList<InstanceVisibilityNotifierData> *N = E->next();
+		InstanceVisibilityNotifierData *notifier_data = E->self();
+
+		for (int i = 0; i < notifier_data->cameras.size(); i++) {
+
+			if (notifier_data->cameras[i].pass == visibility_notifier_pass) {
+				continue;
+			}
+
+			VS::VisibilityNotifierEvent event;
+			event.notifier = notifier_data->owner->object_id;
+			event.camera = notifier_data->cameras[i].camera;
+			event.entered = false;
+			notifier_data->owner->scenario->visibility_notifier_events.push_back(event);
+
+			notifier_data->cameras.remove(i);
+			i--;
+		}
+
+		if (notifier_data->cameras.empty()) {
+			visible_notifier_list.remove(E);
+		}
+
+		E = N;
+	}
+
+	visibility_notifier_pass++;
+}
+
+void VisualServerScene::_occlusion_cull(Scenario *p_scenario, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, const Vector<Plane> &p_planes) {
+
+	int height = CLAMP(int(occlusion_buffer_width / p_cam_projection.get_aspect()), 1, occlusion_buffer_width * 4);
+	occlusion_buffer.resize(occlusion_buffer_width, height);
+	occlusion_buffer.clear(p_cam_transform, p_cam_projection);
+
+	for (SelfList<Occluder> *E = p_scenario->occluders.first(); E; E = E->next()) {
+
+		Occluder *occluder = E->self();
+
+		if (!occluder->enabled || occluder->faces.size() == 0) {
+			continue;
+		}
+
+		if (!occluder->transformed_aabb.intersects_convex_shape(p_planes.ptr(), p_planes.size())) {
+			continue;
+		}
+
+		PoolVector<Vector3>::Read r = occluder->faces.read();
+		occlusion_buffer.add_occluder(occluder->transform, r.ptr(), occluder->faces.size());
+	}
+
+	if (occlusion_buffer.is_empty()) {
+		return;
+	}
+
+	// only geometry is removed, lights and probes still affect what remains visible
+	for (int i = 0; i < instance_cull_count; i++) {
+
+		Instance *ins = instance_cull_result[i];
+
+		if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && occlusion_buffer.is_aabb_occluded(ins->transformed_aabb)) {
+			instance_cull_count--;
+			SWAP(instance_cull_result[i], instance_cull_result[instance_cull_count]);
+			i--;
+		}
+	}
+}
+
 void VisualServerScene::_update_instance(Instance *p_instance) {
 
 	p_instance->version++;
@@ -907,7 +1399,7 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 		InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 		VSG::scene_render->light_instance_set_transform(light->instance, p_instance->transform);
-		light->shadow_dirty = true;
+		light->shadow_dirty_passes = InstanceLightData::SHADOW_PASSES_ALL;
 	}
 
 	if (p_instance->base_type == VS::INSTANCE_REFLECTION_PROBE) {
@@ -933,9 +1425,12 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 		//make sure lights are updated if it casts shadow
 
 		if (geom->can_cast_shadows) {
+			//only the shadow passes that saw the caster before or after the change need redrawing
+			AABB moved_aabb = p_instance->transform.xform(p_instance->aabb);
+
 			for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
 				InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
-				light->shadow_dirty = true;
+				light->shadow_dirty_passes |= _light_get_shadow_passes_for_aabb(E->get(), p_instance->transformed_aabb) | _light_get_shadow_passes_for_aabb(E->get(), moved_aabb);
 			}
 		}
 
@@ -962,7 +1457,7 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 		return;
 	}
 
-	if (p_instance->octree_id == 0) {
+	if (p_instance->spatial_partition_id == 0) {
 
 		uint32_t base_type = 1 << p_instance->base_type;
 		uint32_t pairable_mask = 0;
@@ -980,8 +1475,8 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 			pairable = true;
 		}
 
-		// not inside octree
-		p_instance->octree_id = p_instance->scenario->octree.create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
+		// not inside the spatial partitioning yet
+		p_instance->spatial_partition_id = p_instance->scenario->sps->create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
 
 	} else {
 
@@ -990,7 +1485,7 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 			return;
 		*/
 
-		p_instance->scenario->octree.move(p_instance->octree_id, new_aabb);
+		p_instance->scenario->sps->move(p_instance->spatial_partition_id, new_aabb);
 	}
 }
 
@@ -1057,6 +1552,11 @@ void VisualServerScene::_update_instance_aabb(Instance *p_instance) {
 
 			new_aabb = VSG::storage->lightmap_capture_get_bounds(p_instance->base);
 
+		} break;
+		case VisualServer::INSTANCE_VISIBILITY_NOTIFIER: {
+
+			new_aabb = visibility_notifier_owner.get(p_instance->base)->aabb;
+
 		} break;
 		default: {
 		}
@@ -1302,14 +1802,112 @@ void VisualServerScene::_update_instance_lightmap_captures(Instance *p_instance)
 	}
 }
 
-bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario) {
+int VisualServerScene::_light_shadow_cull(InstanceLightData *p_light, ShadowCullMode p_cull_mode, int &r_cull_index, Scenario *p_scenario, const Vector<Plane> &p_planes, Instance **&r_result) {
+
+	if (p_cull_mode == SHADOW_CULL_IMMEDIATE) {
+		r_result = instance_shadow_cull_result;
+		return p_scenario->sps->cull_convex(p_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+	}
+
+	ERR_FAIL_INDEX_V(r_cull_index, InstanceLightData::MAX_SHADOW_CULLS, 0);
+	InstanceLightData::ShadowCull &sc = p_light->shadow_culls[r_cull_index++];
+
+	if (p_cull_mode == SHADOW_CULL_PREPARE) {
+
+		if (!sc.result) {
+			sc.capacity = 1024;
+			sc.result = (Instance **)memalloc(sizeof(Instance *) * sc.capacity);
+		}
+
+		sc.count = p_scenario->sps->cull_convex(p_planes, sc.result, sc.capacity, VS::INSTANCE_GEOMETRY_MASK);
+
+		// filled up, grow and try again
+		while (sc.count == sc.capacity && sc.capacity < MAX_INSTANCE_CULL) {
+			sc.capacity = MIN(sc.capacity * 2, (int)MAX_INSTANCE_CULL);
+			sc.result = (Instance **)memrealloc(sc.result, sizeof(Instance *) * sc.capacity);
+			sc.count = p_scenario->sps->cull_convex(p_planes, sc.result, sc.capacity, VS::INSTANCE_GEOMETRY_MASK);
+		}
+	}
+
+	r_result = sc.result;
+	return sc.count;
+}
+
+Vector<Plane> VisualServerScene::_light_get_shadow_pass_planes(Instance *p_instance, int p_pass) const {
+
+	Transform light_transform = p_instance->transform;
+	light_transform.orthonormalize(); //scale does not count on lights
+
+	float radius = VSG::storage->light_get_param(p_instance->base, VS::LIGHT_PARAM_RANGE);
+
+	Vector<Plane> planes;
+
+	if (VSG::storage->light_get_type(p_instance->base) == VS::LIGHT_SPOT) {
+
+		float angle = VSG::storage->light_get_param(p_instance->base, VS::LIGHT_PARAM_SPOT_ANGLE);
+
+		CameraMatrix cm;
+		cm.set_perspective(angle * 2.0, 1.0, 0.01, radius);
+
+		planes = cm.get_projection_planes(light_transform);
+	} else {
+		//one hemisphere of a dual paraboloid omni light
+		float z = p_pass == 0 ? -1 : 1;
+		planes.resize(5);
+		planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
+		planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
+		planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
+		planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
+		planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
+	}
+
+	return planes;
+}
+
+uint32_t VisualServerScene::_light_get_shadow_passes_for_aabb(Instance *p_instance, const AABB &p_aabb) const {
+
+	if (!VSG::storage->light_has_shadow(p_instance->base)) {
+		return InstanceLightData::SHADOW_PASSES_ALL; //nothing to save, enabling the shadow redraws it anyway
+	}
+
+	switch (VSG::storage->light_get_type(p_instance->base)) {
+
+		case VS::LIGHT_OMNI: {
+
+			if (VSG::storage->light_omni_get_shadow_mode(p_instance->base) != VS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID && VSG::scene_render->light_instances_can_render_shadow_cube()) {
+				return InstanceLightData::SHADOW_PASSES_ALL; //cube faces are rendered and converted together
+			}
+
+			uint32_t passes = 0;
+			for (int i = 0; i < 2; i++) {
+				Vector<Plane> planes = _light_get_shadow_pass_planes(p_instance, i);
+				if (p_aabb.intersects_convex_shape(planes.ptr(), planes.size())) {
+					passes |= 1 << i;
+				}
+			}
+			return passes;
+		} break;
+		case VS::LIGHT_SPOT: {
+
+			Vector<Plane> planes = _light_get_shadow_pass_planes(p_instance, 0);
+			return p_aabb.intersects_convex_shape(planes.ptr(), planes.size()) ? 1 : 0;
+		} break;
+		default: {
+		}
+	}
+
+	return InstanceLightData::SHADOW_PASSES_ALL;
+}
+
+uint32_t VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario, ShadowCullMode p_cull_mode) {
 
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
+	uint32_t animated_passes = 0;
+	int cull_index = 0;
 
 	switch (VSG::storage->light_get_type(p_instance->base)) {
 
@@ -1328,7 +1926,8 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			if (depth_range_mode == VS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
 				//optimize min/max
 				Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
-				int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+				Instance **cull_result;
+				int cull_count = _light_shadow_cull(light, p_cull_mode, cull_index, p_scenario, planes, cull_result);
 				Plane base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
 				//check distance max and min
 
@@ -1338,13 +1937,13 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 				for (int i = 0; i < cull_count; i++) {
 
-					Instance *instance = instance_shadow_cull_result[i];
+					Instance *instance = cull_result[i];
 					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
 						continue;
 					}
 
 					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
+						animated_passes = InstanceLightData::SHADOW_PASSES_ALL;
 					}
 
 					float max, min;
@@ -1526,7 +2125,11 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 				light_frustum_planes.write[4] = Plane(z_vec, z_max + 1e6);
 				light_frustum_planes.write[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
 
-				int cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+				Instance **cull_result;
+				int cull_count = _light_shadow_cull(light, p_cull_mode, cull_index, p_scenario, light_frustum_planes, cull_result);
+
+				if (p_cull_mode == SHADOW_CULL_PREPARE)
+					continue;
 
 				// a pre pass will need to be needed to determine the actual z-near to be used
 
@@ -1535,10 +2138,10 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 				for (int j = 0; j < cull_count; j++) {
 
 					float min, max;
-					Instance *instance = instance_shadow_cull_result[j];
+					Instance *instance = cull_result[j];
 					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
 						cull_count--;
-						SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
+						SWAP(cull_result[j], cull_result[cull_count]);
 						j--;
 						continue;
 					}
@@ -1565,7 +2168,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					VSG::scene_render->light_instance_set_shadow_transform(light->instance, ortho_camera, ortho_transform, 0, distances[i + 1], i, bias_scale);
 				}
 
-				VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+				VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)cull_result, cull_count);
 			}
 
 		} break;
@@ -1580,29 +2183,31 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					//using this one ensures that raster deferred will have it
 
 					float radius = VSG::storage->light_get_param(p_instance->base, VS::LIGHT_PARAM_RANGE);
-
 					float z = i == 0 ? -1 : 1;
-					Vector<Plane> planes;
-					planes.resize(5);
-					planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
-					planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
-					planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
-					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
-					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
-
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+
+					if (!(light->shadow_redraw_passes & (1 << i))) {
+						continue; //this half is still valid in the atlas
+					}
+
+					Vector<Plane> planes = _light_get_shadow_pass_planes(p_instance, i);
+
+					Instance **cull_result;
+					int cull_count = _light_shadow_cull(light, p_cull_mode, cull_index, p_scenario, planes, cull_result);
+
+					if (p_cull_mode == SHADOW_CULL_PREPARE)
+						continue;
 					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
 
 					for (int j = 0; j < cull_count; j++) {
 
-						Instance *instance = instance_shadow_cull_result[j];
+						Instance *instance = cull_result[j];
 						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
 							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
+							SWAP(cull_result[j], cull_result[cull_count]);
 							j--;
 						} else {
 							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
+								animated_passes |= 1 << i;
 							}
 
 							instance->depth = near_plane.distance_to(instance->transform.origin);
@@ -1611,7 +2216,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					}
 
 					VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i);
-					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)cull_result, cull_count);
 				}
 			} else { //shadow cube
 
@@ -1644,19 +2249,23 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+					Instance **cull_result;
+					int cull_count = _light_shadow_cull(light, p_cull_mode, cull_index, p_scenario, planes, cull_result);
+
+					if (p_cull_mode == SHADOW_CULL_PREPARE)
+						continue;
 
 					Plane near_plane(xform.origin, -xform.basis.get_axis(2));
 					for (int j = 0; j < cull_count; j++) {
 
-						Instance *instance = instance_shadow_cull_result[j];
+						Instance *instance = cull_result[j];
 						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
 							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
+							SWAP(cull_result[j], cull_result[cull_count]);
 							j--;
 						} else {
 							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
+								animated_passes = InstanceLightData::SHADOW_PASSES_ALL;
 							}
 							instance->depth = near_plane.distance_to(instance->transform.origin);
 							instance->depth_layer = 0;
@@ -1664,11 +2273,12 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					}
 
 					VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i);
-					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)cull_result, cull_count);
 				}
 
 				//restore the regular DP matrix
-				VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, 0);
+				if (p_cull_mode != SHADOW_CULL_PREPARE)
+					VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, 0);
 			}
 
 		} break;
@@ -1680,20 +2290,24 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			CameraMatrix cm;
 			cm.set_perspective(angle * 2.0, 1.0, 0.01, radius);
 
-			Vector<Plane> planes = cm.get_projection_planes(light_transform);
-			int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+			Vector<Plane> planes = _light_get_shadow_pass_planes(p_instance, 0);
+			Instance **cull_result;
+			int cull_count = _light_shadow_cull(light, p_cull_mode, cull_index, p_scenario, planes, cull_result);
+
+			if (p_cull_mode == SHADOW_CULL_PREPARE)
+				break;
 
 			Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
 			for (int j = 0; j < cull_count; j++) {
 
-				Instance *instance = instance_shadow_cull_result[j];
+				Instance *instance = cull_result[j];
 				if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
 					cull_count--;
-					SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
+					SWAP(cull_result[j], cull_result[cull_count]);
 					j--;
 				} else {
 					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
+						animated_passes |= 1;
 					}
 					instance->depth = near_plane.distance_to(instance->transform.origin);
 					instance->depth_layer = 0;
@@ -1701,12 +2315,38 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			}
 
 			VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0);
-			VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+			VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)cull_result, cull_count);
 
 		} break;
 	}
 
-	return animated_material_found;
+	return animated_passes;
+}
+
+void VisualServerScene::_cull_job(uint32_t p_index, CullJobs *p_jobs) {
+
+	if (p_jobs->main_cull) {
+		if (p_index == 0) {
+			instance_cull_count = p_jobs->scenario->sps->cull_convex(p_jobs->planes, instance_cull_result, MAX_INSTANCE_CULL);
+			return;
+		}
+		p_index--;
+	}
+
+	_light_instance_update_shadow(p_jobs->lights[p_index], p_jobs->cam_transform, p_jobs->cam_projection, p_jobs->cam_orthogonal, p_jobs->shadow_atlas, p_jobs->scenario, SHADOW_CULL_PREPARE);
+}
+
+bool VisualServerScene::_process_cull_jobs(CullJobs *p_jobs) {
+
+	int job_count = p_jobs->light_count + (p_jobs->main_cull ? 1 : 0);
+
+	if (!threaded_culling || job_count < 2 || !p_jobs->scenario->sps->supports_threaded_cull()) {
+		return false; // not worth it (or not possible), caller culls inline
+	}
+
+	thread_process_array(job_count, this, &VisualServerScene::_cull_job, p_jobs);
+
+	return true;
 }
 
 void VisualServerScene::render_camera(RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas) {
@@ -1755,7 +2395,9 @@ void VisualServerScene::render_camera(RID p_camera, RID p_scenario, Size2 p_view
 		} break;
 	}
 
+	visibility_camera = p_camera;
 	_prepare_scene(camera->transform, camera_matrix, ortho, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+	visibility_camera = RID();
 	_render_scene(camera->transform, camera_matrix, ortho, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 #endif
 }
@@ -1834,17 +2476,29 @@ void VisualServerScene::render_camera(Ref<ARVRInterface> &p_interface, ARVRInter
 		mono_transform *= apply_z_shift;
 
 		// now prepare our scene with our adjusted transform projection matrix
-		_prepare_scene(mono_transform, combined_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		// the combined frustum is not seen from either eye, so occluders can't be trusted here
+		visibility_camera = p_camera;
+		_prepare_scene(mono_transform, combined_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), false);
+		visibility_camera = RID();
 	} else if (p_eye == ARVRInterface::EYE_MONO) {
 		// For mono render, prepare as per usual
+		visibility_camera = p_camera;
 		_prepare_scene(cam_transform, camera_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		visibility_camera = RID();
+	}
+
+	// Both eyes draw the same cull result, so the right eye reuses the render lists built for the left one
+	if (p_eye == ARVRInterface::EYE_LEFT) {
+		VSG::scene_render->set_stereo_pass(RasterizerScene::STEREO_PASS_FIRST);
+	} else if (p_eye == ARVRInterface::EYE_RIGHT) {
+		VSG::scene_render->set_stereo_pass(RasterizerScene::STEREO_PASS_SECOND);
 	}
 
 	// And render our scene...
 	_render_scene(cam_transform, camera_matrix, false, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 };
 
-void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe) {
+void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, bool p_use_occlusion) {
 	// Note, in stereo rendering:
 	// - p_cam_transform will be a transform in the middle of our two eyes
 	// - p_cam_projection is a wider frustrum that encompasses both eyes
@@ -1854,6 +2508,13 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 	render_pass++;
 	uint32_t camera_layer_mask = p_visible_layers;
 
+	if (!p_reflection_probe.is_valid() && probe_cameras.size() < MAX_PROBE_CAMERAS) {
+		ProbeCamera probe_camera;
+		probe_camera.scenario = scenario;
+		probe_camera.position = p_cam_transform.origin;
+		probe_cameras.push_back(probe_camera);
+	}
+
 	VSG::scene_render->set_scene_pass(render_pass);
 
 	//rasterizer->set_camera(camera->transform, camera_matrix,ortho);
@@ -1864,7 +2525,36 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 	float z_far = p_cam_projection.get_z_far();
 
 	/* STEP 2 - CULL */
-	instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+
+	// directional shadows don't depend on the camera cull, so their culls can run alongside it
+	Instance **directional_shadow_lights = (Instance **)FrameArena::alloc(sizeof(Instance *) * scenario->directional_lights.size());
+	int directional_shadow_light_count = 0;
+
+	if (p_shadow_atlas.is_valid()) {
+		for (List<Instance *>::Element *E = scenario->directional_lights.front(); E; E = E->next()) {
+
+			if (E->get()->visible && E->get()->base_data && VSG::storage->light_has_shadow(E->get()->base)) {
+				directional_shadow_lights[directional_shadow_light_count++] = E->get();
+			}
+		}
+	}
+
+	CullJobs cull_jobs;
+	cull_jobs.cam_transform = p_cam_transform;
+	cull_jobs.cam_projection = p_cam_projection;
+	cull_jobs.cam_orthogonal = p_cam_orthogonal;
+	cull_jobs.shadow_atlas = p_shadow_atlas;
+	cull_jobs.scenario = scenario;
+	cull_jobs.main_cull = true;
+	cull_jobs.planes = planes;
+	cull_jobs.lights = directional_shadow_lights;
+	cull_jobs.light_count = directional_shadow_light_count;
+
+	bool directional_shadows_prepared = _process_cull_jobs(&cull_jobs);
+
+	if (!directional_shadows_prepared) {
+		instance_cull_count = scenario->sps->cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+	}
 	light_cull_count = 0;
 
 	reflection_probe_cull_count = 0;
@@ -1878,8 +2568,11 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 	print_line("OTP: "+itos(p_scenario->octree.get_pair_count()));
 	*/
 
-	/* STEP 3 - PROCESS PORTALS, VALIDATE ROOMS */
-	//removed, will replace with culling
+	/* STEP 3 - OCCLUSION CULLING */
+
+	if (p_use_occlusion && scenario->occluders.first()) {
+		_occlusion_cull(scenario, p_cam_transform, p_cam_projection, planes);
+	}
 
 	/* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
 
@@ -1945,6 +2638,12 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 				gi_probe_update_list.add(&gi_probe->update_element);
 			}
 
+		} else if (ins->base_type == VS::INSTANCE_VISIBILITY_NOTIFIER && ins->visible) {
+
+			if (visibility_camera.is_valid()) {
+				_visibility_notifier_seen(ins);
+			}
+
 		} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
 
 			keep = true;
@@ -2036,7 +2735,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 	// directional lights
 	{
 
-		Instance **lights_with_shadow = (Instance **)alloca(sizeof(Instance *) * scenario->directional_lights.size());
+		Instance **lights_with_shadow = (Instance **)FrameArena::alloc(sizeof(Instance *) * scenario->directional_lights.size());
 		int directional_shadow_count = 0;
 
 		for (List<Instance *>::Element *E = scenario->directional_lights.front(); E; E = E->next()) {
@@ -2065,7 +2764,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 		for (int i = 0; i < directional_shadow_count; i++) {
 
-			_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+			_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario, directional_shadows_prepared ? SHADOW_CULL_RENDER : SHADOW_CULL_IMMEDIATE);
 		}
 	}
 
@@ -2073,6 +2772,10 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 		//SortArray<Instance*,_InstanceLightsort> sorter;
 		//sorter.sort(light_cull_result,light_cull_count);
+
+		Instance **redraw_lights = (Instance **)FrameArena::alloc(sizeof(Instance *) * light_cull_count);
+		int redraw_light_count = 0;
+
 		for (int i = 0; i < light_cull_count; i++) {
 
 			Instance *ins = light_cull_result[i];
@@ -2155,18 +2858,43 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 				}
 			}
 
-			if (light->shadow_dirty) {
+			if (light->shadow_dirty_passes) {
 				light->last_version++;
-				light->shadow_dirty = false;
+				for (int j = 0; j < InstanceLightData::MAX_SHADOW_CULLS; j++) {
+					if (light->shadow_dirty_passes & (1 << j)) {
+						light->shadow_pass_version[j] = light->last_version;
+					}
+				}
+				light->shadow_dirty_passes = 0;
 			}
 
-			bool redraw = VSG::scene_render->shadow_atlas_update_light(p_shadow_atlas, light->instance, coverage, light->last_version);
+			uint64_t drawn_version = 0;
+			bool redraw = VSG::scene_render->shadow_atlas_update_light(p_shadow_atlas, light->instance, coverage, light->last_version, drawn_version);
 
 			if (redraw) {
-				//must redraw!
-				light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+				//must redraw, but only the passes that changed since this atlas last drew the light
+				light->shadow_redraw_passes = 0;
+				for (int j = 0; j < InstanceLightData::MAX_SHADOW_CULLS; j++) {
+					if (light->shadow_pass_version[j] > drawn_version) {
+						light->shadow_redraw_passes |= 1 << j;
+					}
+				}
+
+				redraw_lights[redraw_light_count++] = ins;
 			}
 		}
+
+		cull_jobs.main_cull = false;
+		cull_jobs.lights = redraw_lights;
+		cull_jobs.light_count = redraw_light_count;
+
+		bool shadows_prepared = _process_cull_jobs(&cull_jobs);
+
+		for (int i = 0; i < redraw_light_count; i++) {
+
+			InstanceLightData *light = static_cast<InstanceLightData *>(redraw_lights[i]->base_data);
+			light->shadow_dirty_passes |= _light_instance_update_shadow(redraw_lights[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario, shadows_prepared ? SHADOW_CULL_RENDER : SHADOW_CULL_IMMEDIATE);
+		}
 	}
 }
 
@@ -3167,61 +3895,101 @@ bool VisualServerScene::_check_gi_probe(Instance *p_gi_probe) {
 	return !all_equal || probe_data->dynamic.light_cache_changes.size() != probe_data->dynamic.light_cache.size();
 }
 
+float VisualServerScene::_get_probe_camera_distance(Instance *p_probe) const {
+
+	if (probe_cameras.empty())
+		return 0;
+
+	const AABB &aabb = p_probe->transformed_aabb;
+	float closest = -1;
+
+	for (int i = 0; i < probe_cameras.size(); i++) {
+
+		if (probe_cameras[i].scenario != p_probe->scenario)
+			continue;
+
+		const Vector3 &pos = probe_cameras[i].position;
+		Vector3 nearest(CLAMP(pos.x, aabb.position.x, aabb.position.x + aabb.size.x), CLAMP(pos.y, aabb.position.y, aabb.position.y + aabb.size.y), CLAMP(pos.z, aabb.position.z, aabb.position.z + aabb.size.z));
+		float d = pos.distance_squared_to(nearest);
+		if (closest < 0 || d < closest) {
+			closest = d;
+		}
+	}
+
+	return closest < 0 ? 1e20 : closest; //probes not seen by any camera go last
+}
+
+struct _ProbeUpdateSort {
+
+	float distance;
+	void *probe;
+
+	_FORCE_INLINE_ bool operator<(const _ProbeUpdateSort &p_r) const { return distance < p_r.distance; }
+};
+
 void VisualServerScene::render_probes() {
 
-	/* REFLECTION PROBES */
+	//probes share one budget per frame, a reflection probe face or filter pass, a GI probe lighting or a mipmap upload are each one step
 
-	SelfList<InstanceReflectionProbeData> *ref_probe = reflection_probe_render_list.first();
+	int steps_left = MAX(1, probe_update_steps_per_frame);
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
 
-	bool busy = false;
+#define PROBE_BUDGET_LEFT (steps_left > 0 && (probe_update_budget_usec == 0 || OS::get_singleton()->get_ticks_usec() - begin_usec < probe_update_budget_usec))
 
-	while (ref_probe) {
+	/* REFLECTION PROBES */
 
-		SelfList<InstanceReflectionProbeData> *next = ref_probe->next();
-		RID base = ref_probe->self()->owner->base;
+	Vector<_ProbeUpdateSort> probe_order;
 
-		switch (VSG::storage->reflection_probe_get_update_mode(base)) {
+	for (SelfList<InstanceReflectionProbeData> *E = reflection_probe_render_list.first(); E; E = E->next()) {
 
-			case VS::REFLECTION_PROBE_UPDATE_ONCE: {
-				if (busy) //already rendering something
-					break;
+		_ProbeUpdateSort ps;
+		//the probe being rendered finishes first, the renderer keeps its partial cubemap in a scratch buffer shared by all probes
+		ps.distance = E->self()->render_step > 0 ? -1 : _get_probe_camera_distance(E->self()->owner);
+		ps.probe = E->self();
+		probe_order.push_back(ps);
+	}
 
-				bool done = _render_reflection_probe_step(ref_probe->self()->owner, ref_probe->self()->render_step);
-				if (done) {
-					reflection_probe_render_list.remove(ref_probe);
-				} else {
-					ref_probe->self()->render_step++;
-				}
+	probe_order.sort();
 
-				busy = true; //do not render another one of this kind
-			} break;
-			case VS::REFLECTION_PROBE_UPDATE_ALWAYS: {
+	for (int i = 0; i < probe_order.size() && PROBE_BUDGET_LEFT; i++) {
 
-				int step = 0;
-				bool done = false;
-				while (!done) {
-					done = _render_reflection_probe_step(ref_probe->self()->owner, step);
-					step++;
-				}
+		InstanceReflectionProbeData *ref_probe = static_cast<InstanceReflectionProbeData *>(probe_order[i].probe);
 
-				reflection_probe_render_list.remove(ref_probe);
-			} break;
+		bool done = false;
+		while (!done && PROBE_BUDGET_LEFT) {
+			done = _render_reflection_probe_step(ref_probe->owner, ref_probe->render_step);
+			ref_probe->render_step++;
+			steps_left--;
 		}
 
-		ref_probe = next;
+		if (done) {
+			reflection_probe_render_list.remove(&ref_probe->update_list);
+		}
 	}
 
 	/* GI PROBES */
 
-	SelfList<InstanceGIProbeData> *gi_probe = gi_probe_update_list.first();
+	probe_order.clear();
 
-	while (gi_probe) {
+	for (SelfList<InstanceGIProbeData> *E = gi_probe_update_list.first(); E; E = E->next()) {
 
-		SelfList<InstanceGIProbeData> *next = gi_probe->next();
+		_ProbeUpdateSort ps;
+		ps.distance = _get_probe_camera_distance(E->self()->owner);
+		ps.probe = E->self();
+		probe_order.push_back(ps);
+	}
+
+	probe_order.sort();
 
-		InstanceGIProbeData *probe = gi_probe->self();
+	for (int i = 0; i < probe_order.size(); i++) {
+
+		InstanceGIProbeData *probe = static_cast<InstanceGIProbeData *>(probe_order[i].probe);
 		Instance *instance_probe = probe->owner;
 
+		if (probe->dynamic.updating_stage != GI_UPDATE_STAGE_LIGHTING && !PROBE_BUDGET_LEFT) {
+			continue; //checked again next frame, nothing is lost by waiting
+		}
+
 		//check if probe must be setup, but don't do if on the lighting thread
 
 		bool force_lighting = false;
@@ -3246,6 +4014,9 @@ void VisualServerScene::render_probes() {
 
 					if (_check_gi_probe(instance_probe) || force_lighting) { //send to lighting thread
 
+						probe->dynamic.upload_mipmap = 0;
+						steps_left--;
+
 #ifndef NO_THREADS
 						probe_bake_mutex->lock();
 						probe->dynamic.updating_stage = GI_UPDATE_STAGE_LIGHTING;
@@ -3267,22 +4038,29 @@ void VisualServerScene::render_probes() {
 
 					//uint64_t us = OS::get_singleton()->get_ticks_usec();
 
-					for (int i = 0; i < (int)probe->dynamic.mipmaps_3d.size(); i++) {
+					while (probe->dynamic.upload_mipmap < (int)probe->dynamic.mipmaps_3d.size() && PROBE_BUDGET_LEFT) {
 
-						PoolVector<uint8_t>::Read r = probe->dynamic.mipmaps_3d[i].read();
-						VSG::storage->gi_probe_dynamic_data_update(probe->dynamic.probe_data, 0, probe->dynamic.grid_size[2] >> i, i, r.ptr());
+						int mipmap = probe->dynamic.upload_mipmap;
+						PoolVector<uint8_t>::Read r = probe->dynamic.mipmaps_3d[mipmap].read();
+						VSG::storage->gi_probe_dynamic_data_update(probe->dynamic.probe_data, 0, probe->dynamic.grid_size[2] >> mipmap, mipmap, r.ptr());
+						probe->dynamic.upload_mipmap++;
+						steps_left--;
 					}
 
-					probe->dynamic.updating_stage = GI_UPDATE_STAGE_CHECK;
+					if (probe->dynamic.upload_mipmap >= (int)probe->dynamic.mipmaps_3d.size()) {
+						probe->dynamic.updating_stage = GI_UPDATE_STAGE_CHECK;
+					}
 
 					//print_line("UPLOAD TIME: " + rtos((OS::get_singleton()->get_ticks_usec() - us) / 1000000.0));
 				} break;
 			}
 		}
 		//_update_gi_probe(gi_probe->self()->owner);
-
-		gi_probe = next;
 	}
+
+#undef PROBE_BUDGET_LEFT
+
+	probe_cameras.clear();
 }
 
 void VisualServerScene::_update_dirty_instance(Instance *p_instance) {
@@ -3436,7 +4214,7 @@ void VisualServerScene::_update_dirty_instance(Instance *p_instance) {
 				//ability to cast shadows change, let lights now
 				for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
 					InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
-					light->shadow_dirty = true;
+					light->shadow_dirty_passes |= _light_get_shadow_passes_for_aabb(E->get(), p_instance->transformed_aabb);
 				}
 
 				geom->can_cast_shadows = can_cast_shadows;
@@ -3480,6 +4258,9 @@ bool VisualServerScene::free(RID p_rid) {
 		while (scenario->instances.first()) {
 			instance_set_scenario(scenario->instances.first()->self()->self, RID());
 		}
+		while (scenario->occluders.first()) {
+			occluder_set_scenario(scenario->occluders.first()->self()->self, RID());
+		}
 		VSG::scene_render->free(scenario->reflection_probe_shadow_atlas);
 		VSG::scene_render->free(scenario->reflection_atlas);
 		scenario_owner.free(p_rid);
@@ -3490,8 +4271,6 @@ bool VisualServerScene::free(RID p_rid) {
 
 		update_dirty_instances();
 
-		Instance *instance = instance_owner.get(p_rid);
-
 		instance_set_use_lightmap(p_rid, RID(), RID());
 		instance_set_scenario(p_rid, RID());
 		instance_set_base(p_rid, RID());
@@ -3501,7 +4280,22 @@ bool VisualServerScene::free(RID p_rid) {
 		update_dirty_instances(); //in case something changed this
 
 		instance_owner.free(p_rid);
-		memdelete(instance);
+	} else if (occluder_owner.owns(p_rid)) {
+
+		Occluder *occluder = occluder_owner.get(p_rid);
+
+		occluder_set_scenario(p_rid, RID());
+		occluder_owner.free(p_rid);
+		memdelete(occluder);
+	} else if (visibility_notifier_owner.owns(p_rid)) {
+
+		VisibilityNotifier *notifier = visibility_notifier_owner.get(p_rid);
+
+		while (notifier->instances.front()) {
+			instance_set_base(notifier->instances.front()->get()->self, RID());
+		}
+		visibility_notifier_owner.free(p_rid);
+		memdelete(notifier);
 	} else {
 		return false;
 	}
@@ -3511,6 +4305,80 @@ bool VisualServerScene::free(RID p_rid) {
 
 VisualServerScene *VisualServerScene::singleton = NULL;
 
+/* SPATIAL PARTITIONING */
+
+VisualServerScene::SpatialPartitionID VisualServerScene::SpatialPartitioningScene_Octree::create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+	return octree.create(p_userdata, p_aabb, p_subindex, p_pairable, p_pairable_type, p_pairable_mask);
+}
+
+void VisualServerScene::SpatialPartitioningScene_Octree::erase(SpatialPartitionID p_handle) {
+	octree.erase(p_handle);
+}
+
+void VisualServerScene::SpatialPartitioningScene_Octree::move(SpatialPartitionID p_handle, const AABB &p_aabb) {
+	octree.move(p_handle, p_aabb);
+}
+
+void VisualServerScene::SpatialPartitioningScene_Octree::set_pairable(SpatialPartitionID p_handle, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+	octree.set_pairable(p_handle, p_pairable, p_pairable_type, p_pairable_mask);
+}
+
+int VisualServerScene::SpatialPartitioningScene_Octree::cull_convex(const Vector<Plane> &p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask) {
+	return octree.cull_convex(p_convex, p_result_array, p_result_max, p_mask);
+}
+
+int VisualServerScene::SpatialPartitioningScene_Octree::cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+	return octree.cull_aabb(p_aabb, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+int VisualServerScene::SpatialPartitioningScene_Octree::cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+	return octree.cull_segment(p_from, p_to, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+void VisualServerScene::SpatialPartitioningScene_Octree::set_pair_callback(PairCallback p_callback, void *p_userdata) {
+	octree.set_pair_callback(p_callback, p_userdata);
+}
+
+void VisualServerScene::SpatialPartitioningScene_Octree::set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+	octree.set_unpair_callback(p_callback, p_userdata);
+}
+
+VisualServerScene::SpatialPartitionID VisualServerScene::SpatialPartitioningScene_BVH::create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+	return bvh.create(p_userdata, p_aabb, p_subindex, p_pairable, p_pairable_type, p_pairable_mask);
+}
+
+void VisualServerScene::SpatialPartitioningScene_BVH::erase(SpatialPartitionID p_handle) {
+	bvh.erase(p_handle);
+}
+
+void VisualServerScene::SpatialPartitioningScene_BVH::move(SpatialPartitionID p_handle, const AABB &p_aabb) {
+	bvh.move(p_handle, p_aabb);
+}
+
+void VisualServerScene::SpatialPartitioningScene_BVH::set_pairable(SpatialPartitionID p_handle, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+	bvh.set_pairable(p_handle, p_pairable, p_pairable_type, p_pairable_mask);
+}
+
+int VisualServerScene::SpatialPartitioningScene_BVH::cull_convex(const Vector<Plane> &p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask) {
+	return bvh.cull_convex(p_convex, p_result_array, p_result_max, p_mask);
+}
+
+int VisualServerScene::SpatialPartitioningScene_BVH::cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+	return bvh.cull_aabb(p_aabb, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+int VisualServerScene::SpatialPartitioningScene_BVH::cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+	return bvh.cull_segment(p_from, p_to, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+void VisualServerScene::SpatialPartitioningScene_BVH::set_pair_callback(PairCallback p_callback, void *p_userdata) {
+	bvh.set_pair_callback(p_callback, p_userdata);
+}
+
+void VisualServerScene::SpatialPartitioningScene_BVH::set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+	bvh.set_unpair_callback(p_callback, p_userdata);
+}
+
 VisualServerScene::VisualServerScene() {
 
 #ifndef NO_THREADS
@@ -3521,7 +4389,14 @@ VisualServerScene::VisualServerScene() {
 #endif
 
 	render_pass = 1;
+	visibility_notifier_pass = 1;
 	singleton = this;
+
+	default_spatial_partitioning = GLOBAL_GET("rendering/quality/spatial_partitioning/use_bvh") ? VS::SCENARIO_SPATIAL_PARTITIONING_BVH : VS::SCENARIO_SPATIAL_PARTITIONING_OCTREE;
+	threaded_culling = GLOBAL_GET("rendering/threads/threaded_culling");
+	occlusion_buffer_width = MAX(16, int(GLOBAL_GET("rendering/quality/occlusion_culling/buffer_width")));
+	probe_update_steps_per_frame = GLOBAL_GET("rendering/quality/probes/update_steps_per_frame");
+	probe_update_budget_usec = uint64_t(float(GLOBAL_GET("rendering/quality/probes/update_budget_msec")) * 1000.0);
 }
 
 VisualServerScene::~VisualServerScene() {
@@ -31,8 +31,10 @@
 #ifndef VISUALSERVERSCENE_H
 #define VISUALSERVERSCENE_H
 
+#include "servers/visual/occlusion_buffer.h"
 #include "servers/visual/rasterizer.h"
 
+#include "core/math/dynamic_bvh.h"
 #include "core/math/geometry.h"
 #include "core/math/octree.h"
 #include "core/os/semaphore.h"
@@ -49,6 +51,7 @@ public:
 		MAX_REFLECTION_PROBES_CULLED = 4096,
 		MAX_ROOM_CULL = 32,
 		MAX_EXTERIOR_PORTALS = 128,
+		MAX_PROBE_CAMERAS = 64,
 	};
 
 	uint64_t render_pass;
@@ -75,8 +78,18 @@ public:
 
 		Transform transform;
 
-		Camera() {
+		//physics interpolation, transform is blended between the last two ticks
+		bool interpolated;
+		bool interpolation_moved;
+		Transform transform_prev;
+		Transform transform_curr;
+		SelfList<Camera> interpolation_item;
 
+		Camera() :
+				interpolation_item(this) {
+
+			interpolated = false;
+			interpolation_moved = false;
 			visible_layers = 0xFFFFFFFF;
 			fov = 70;
 			type = PERSPECTIVE;
@@ -89,6 +102,7 @@ public:
 	};
 
 	mutable RID_Owner<Camera> camera_owner;
+	SelfList<Camera>::List camera_interpolation_list;
 
 	virtual RID camera_create();
 	virtual void camera_set_perspective(RID p_camera, float p_fovy_degrees, float p_z_near, float p_z_far);
@@ -98,17 +112,89 @@ public:
 	virtual void camera_set_cull_mask(RID p_camera, uint32_t p_layers);
 	virtual void camera_set_environment(RID p_camera, RID p_env);
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable);
+	virtual void camera_set_interpolated(RID p_camera, bool p_interpolated);
+	virtual void camera_reset_physics_interpolation(RID p_camera);
 
-	/* SCENARIO API */
+	/* SPATIAL PARTITIONING */
 
 	struct Instance;
+	struct Occluder;
+
+	typedef uint32_t SpatialPartitionID;
+
+	// common interface for the structures a scenario can keep its instances in
+	class SpatialPartitioningScene {
+	public:
+		typedef void *(*PairCallback)(void *, SpatialPartitionID, Instance *, int, SpatialPartitionID, Instance *, int);
+		typedef void (*UnpairCallback)(void *, SpatialPartitionID, Instance *, int, SpatialPartitionID, Instance *, int, void *);
+
+		virtual SpatialPartitionID create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) = 0;
+		virtual void erase(SpatialPartitionID p_handle) = 0;
+		virtual void move(SpatialPartitionID p_handle, const AABB &p_aabb) = 0;
+		virtual void set_pairable(SpatialPartitionID p_handle, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) = 0;
+
+		virtual int cull_convex(const Vector<Plane> &p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) = 0;
+		virtual int cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF) = 0;
+		virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF) = 0;
+
+		virtual void set_pair_callback(PairCallback p_callback, void *p_userdata) = 0;
+		virtual void set_unpair_callback(UnpairCallback p_callback, void *p_userdata) = 0;
+
+		// whether several culls may run at the same time from different threads
+		virtual bool supports_threaded_cull() const = 0;
+
+		virtual ~SpatialPartitioningScene() {}
+	};
+
+	class SpatialPartitioningScene_Octree : public SpatialPartitioningScene {
+
+		Octree<Instance, true> octree;
+
+	public:
+		virtual SpatialPartitionID create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask);
+		virtual void erase(SpatialPartitionID p_handle);
+		virtual void move(SpatialPartitionID p_handle, const AABB &p_aabb);
+		virtual void set_pairable(SpatialPartitionID p_handle, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask);
+
+		virtual int cull_convex(const Vector<Plane> &p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+		virtual int cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+		virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+
+		virtual void set_pair_callback(PairCallback p_callback, void *p_userdata);
+		virtual void set_unpair_callback(UnpairCallback p_callback, void *p_userdata);
+
+		virtual bool supports_threaded_cull() const { return false; } // the octree keeps pass counters while culling
+	};
+
+	class SpatialPartitioningScene_BVH : public SpatialPartitioningScene {
+
+		DynamicBVH<Instance, true> bvh;
+
+	public:
+		virtual SpatialPartitionID create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask);
+		virtual void erase(SpatialPartitionID p_handle);
+		virtual void move(SpatialPartitionID p_handle, const AABB &p_aabb);
+		virtual void set_pairable(SpatialPartitionID p_handle, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask);
+
+		virtual int cull_convex(const Vector<Plane> &p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+		virtual int cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+		virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+
+		virtual void set_pair_callback(PairCallback p_callback, void *p_userdata);
+		virtual void set_unpair_callback(UnpairCallback p_callback, void *p_userdata);
+
+		virtual bool supports_threaded_cull() const { return true; }
+	};
+
+	/* SCENARIO API */
 
 	struct Scenario : RID_Data {
 
 		VS::ScenarioDebugMode debug;
 		RID self;
 
-		Octree<Instance, true> octree;
+		VS::ScenarioSpatialPartitioning spatial_partitioning;
+		SpatialPartitioningScene *sps;
 
 		List<Instance *> directional_lights;
 		RID environment;
@@ -117,18 +203,35 @@ public:
 		RID reflection_atlas;
 
 		SelfList<Instance>::List instances;
+		SelfList<Occluder>::List occluders;
+
+		Vector<VS::VisibilityNotifierEvent> visibility_notifier_events; //queued until the scene asks for them
+
+		Scenario() {
+			debug = VS::SCENARIO_DEBUG_DISABLED;
+			spatial_partitioning = VS::SCENARIO_SPATIAL_PARTITIONING_OCTREE;
+			sps = NULL;
+		}
 
-		Scenario() { debug = VS::SCENARIO_DEBUG_DISABLED; }
+		~Scenario() {
+			if (sps)
+				memdelete(sps);
+		}
 	};
 
 	mutable RID_Owner<Scenario> scenario_owner;
 
-	static void *_instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int);
-	static void _instance_unpair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int, void *);
+	VS::ScenarioSpatialPartitioning default_spatial_partitioning;
+
+	static void *_instance_pair(void *p_self, SpatialPartitionID, Instance *p_A, int, SpatialPartitionID, Instance *p_B, int);
+	static void _instance_unpair(void *p_self, SpatialPartitionID, Instance *p_A, int, SpatialPartitionID, Instance *p_B, int, void *);
+
+	void _scenario_create_spatial_partitioning(Scenario *p_scenario, VS::ScenarioSpatialPartitioning p_mode);
 
 	virtual RID scenario_create();
 
 	virtual void scenario_set_debug(RID p_scenario, VS::ScenarioDebugMode p_debug_mode);
+	virtual void scenario_set_spatial_partitioning(RID p_scenario, VS::ScenarioSpatialPartitioning p_mode);
 	virtual void scenario_set_environment(RID p_scenario, RID p_environment);
 	virtual void scenario_set_fallback_environment(RID p_scenario, RID p_environment);
 	virtual void scenario_set_reflection_atlas_size(RID p_scenario, int p_size, int p_subdiv);
@@ -144,7 +247,7 @@ public:
 
 		RID self;
 		//scenario stuff
-		OctreeElementID octree_id;
+		SpatialPartitionID spatial_partition_id;
 		Scenario *scenario;
 		SelfList<Instance> scenario_item;
 
@@ -171,6 +274,13 @@ public:
 
 		uint64_t version; // changes to this, and changes to base increase version
 
+		//physics interpolation, transform is blended between the last two ticks
+		bool interpolated;
+		bool interpolation_moved;
+		Transform transform_prev;
+		Transform transform_curr;
+		SelfList<Instance> interpolation_item;
+
 		InstanceBaseData *base_data;
 
 		virtual void base_removed() {
@@ -185,9 +295,10 @@ public:
 
 		Instance() :
 				scenario_item(this),
-				update_item(this) {
+				update_item(this),
+				interpolation_item(this) {
 
-			octree_id = 0;
+			spatial_partition_id = 0;
 			scenario = NULL;
 
 			update_aabb = false;
@@ -208,6 +319,9 @@ public:
 			version = 1;
 			base_data = NULL;
 
+			interpolated = false;
+			interpolation_moved = false;
+
 			custom_aabb = NULL;
 		}
 
@@ -221,7 +335,11 @@ public:
 	};
 
 	SelfList<Instance>::List _instance_update_list;
+	SelfList<Instance>::List _instance_interpolation_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_materials = false);
+	void _instance_set_transform(Instance *p_instance, const Transform &p_transform);
+	void _instance_set_visible(Instance *p_instance, bool p_visible);
+	void _instance_geometry_set_material_override(Instance *p_instance, RID p_material);
 
 	struct InstanceGeometryData : public InstanceBaseData {
 
@@ -281,11 +399,27 @@ public:
 			Instance *geometry;
 		};
 
+		enum {
+			MAX_SHADOW_CULLS = 7, // directional depth range + 4 splits, or 6 cube faces
+			SHADOW_PASSES_ALL = (1 << MAX_SHADOW_CULLS) - 1
+		};
+
+		// results of the culls done ahead of time (possibly from another thread), in the order the shadow update asks for them
+		struct ShadowCull {
+			Instance **result;
+			int capacity;
+			int count;
+		};
+
+		ShadowCull shadow_culls[MAX_SHADOW_CULLS];
+
 		RID instance;
 		uint64_t last_version;
 		List<Instance *>::Element *D; // directional light in scenario
 
-		bool shadow_dirty;
+		uint32_t shadow_dirty_passes; // shadow passes whose casters changed since last_version
+		uint32_t shadow_redraw_passes; // shadow passes the current update renders
+		uint64_t shadow_pass_version[MAX_SHADOW_CULLS]; // last_version at which each shadow pass last changed
 
 		List<PairInfo> geometries;
 
@@ -293,10 +427,26 @@ public:
 
 		InstanceLightData() {
 
-			shadow_dirty = true;
+			shadow_dirty_passes = SHADOW_PASSES_ALL;
+			shadow_redraw_passes = SHADOW_PASSES_ALL;
 			D = NULL;
 			last_version = 0;
 			baked_light = NULL;
+
+			for (int i = 0; i < MAX_SHADOW_CULLS; i++) {
+				shadow_pass_version[i] = 0;
+				shadow_culls[i].result = NULL;
+				shadow_culls[i].capacity = 0;
+				shadow_culls[i].count = 0;
+			}
+		}
+
+		~InstanceLightData() {
+
+			for (int i = 0; i < MAX_SHADOW_CULLS; i++) {
+				if (shadow_culls[i].result)
+					memfree(shadow_culls[i].result);
+			}
 		}
 	};
 
@@ -383,6 +533,7 @@ public:
 			Vector<PoolVector<CompBlockS3TC> > mipmaps_s3tc; //for s3tc
 
 			int updating_stage;
+			int upload_mipmap; //mipmaps are uploaded over several frames when the probe update budget runs out
 			float propagate;
 
 			int grid_size[3];
@@ -403,6 +554,7 @@ public:
 			invalid = true;
 			base_version = 0;
 			dynamic.updating_stage = GI_UPDATE_STAGE_CHECK;
+			dynamic.upload_mipmap = 0;
 		}
 	};
 
@@ -422,6 +574,45 @@ public:
 		}
 	};
 
+	/* VISIBILITY NOTIFIER API */
+
+	struct VisibilityNotifier : RID_Data {
+
+		AABB aabb;
+		Set<Instance *> instances;
+	};
+
+	RID_Owner<VisibilityNotifier> visibility_notifier_owner;
+
+	struct InstanceVisibilityNotifierData : public InstanceBaseData {
+
+		struct CameraPass {
+			RID camera;
+			uint64_t pass;
+		};
+
+		Instance *owner;
+		Vector<CameraPass> cameras; //cameras it is visible from, with the last notifier pass they saw it in
+		SelfList<InstanceVisibilityNotifierData> visible_item;
+
+		InstanceVisibilityNotifierData() :
+				visible_item(this) {
+			owner = NULL;
+		}
+	};
+
+	SelfList<InstanceVisibilityNotifierData>::List visible_notifier_list;
+	uint64_t visibility_notifier_pass;
+	RID visibility_camera; //camera being rendered, reflection probes and shadows don't affect notifiers
+
+	virtual RID visibility_notifier_create();
+	virtual void visibility_notifier_set_aabb(RID p_notifier, const AABB &p_aabb);
+	virtual Vector<VS::VisibilityNotifierEvent> scenario_get_visibility_notifier_events(RID p_scenario);
+
+	_FORCE_INLINE_ void _visibility_notifier_seen(Instance *p_instance);
+	void _visibility_notifier_clear(Instance *p_instance);
+	void update_visibility_notifiers();
+
 	int instance_cull_count;
 	Instance *instance_cull_result[MAX_INSTANCE_CULL];
 	Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
@@ -432,7 +623,7 @@ public:
 	RID reflection_probe_instance_cull_result[MAX_REFLECTION_PROBES_CULLED];
 	int reflection_probe_cull_count;
 
-	RID_Owner<Instance> instance_owner;
+	RID_ChunkedOwner<Instance> instance_owner;
 
 	virtual RID instance_create();
 
@@ -440,10 +631,14 @@ public:
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario);
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_transform(RID p_instance, const Transform &p_transform);
+	virtual void instance_set_interpolated(RID p_instance, bool p_interpolated);
+	virtual void instance_reset_physics_interpolation(RID p_instance);
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform> &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_material(RID p_instance, int p_surface, RID p_material);
 	virtual void instance_set_visible(RID p_instance, bool p_visible);
+	virtual void instances_set_visible(const Vector<RID> &p_instances, const Vector<bool> &p_visible);
 	virtual void instance_set_use_lightmap(RID p_instance, RID p_lightmap_instance, RID p_lightmap);
 
 	virtual void instance_set_custom_aabb(RID p_instance, AABB p_aabb);
@@ -461,18 +656,82 @@ public:
 	virtual void instance_geometry_set_flag(RID p_instance, VS::InstanceFlags p_flags, bool p_enabled);
 	virtual void instance_geometry_set_cast_shadows_setting(RID p_instance, VS::ShadowCastingSetting p_shadow_casting_setting);
 	virtual void instance_geometry_set_material_override(RID p_instance, RID p_material);
+	virtual void instances_geometry_set_material_override(const Vector<RID> &p_instances, RID p_material);
 
 	virtual void instance_geometry_set_draw_range(RID p_instance, float p_min, float p_max, float p_min_margin, float p_max_margin);
 	virtual void instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance);
 
+	/* OCCLUDER API */
+
+	struct Occluder : RID_Data {
+
+		RID self;
+		Scenario *scenario;
+		SelfList<Occluder> scenario_item;
+
+		Transform transform;
+		PoolVector<Vector3> faces;
+		AABB aabb;
+		AABB transformed_aabb;
+		bool enabled;
+
+		Occluder() :
+				scenario_item(this) {
+
+			scenario = NULL;
+			enabled = true;
+		}
+	};
+
+	RID_Owner<Occluder> occluder_owner;
+
+	OcclusionBuffer occlusion_buffer;
+	int occlusion_buffer_width;
+
+	virtual RID occluder_create();
+	virtual void occluder_set_scenario(RID p_occluder, RID p_scenario);
+	virtual void occluder_set_transform(RID p_occluder, const Transform &p_transform);
+	virtual void occluder_set_faces(RID p_occluder, const PoolVector<Vector3> &p_faces);
+	virtual void occluder_set_enabled(RID p_occluder, bool p_enabled);
+
+	void _occlusion_cull(Scenario *p_scenario, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, const Vector<Plane> &p_planes);
+
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario);
+	enum ShadowCullMode {
+		SHADOW_CULL_IMMEDIATE, // cull and render right away
+		SHADOW_CULL_PREPARE, // only cull into the light buffers, safe to run from worker threads
+		SHADOW_CULL_RENDER, // render with what the prepare pass culled
+	};
+
+	struct CullJobs {
+
+		Transform cam_transform;
+		CameraMatrix cam_projection;
+		bool cam_orthogonal;
+		RID shadow_atlas;
+		Scenario *scenario;
+
+		bool main_cull; // if true, job 0 culls the camera frustum into instance_cull_result
+		Vector<Plane> planes;
+
+		Instance **lights;
+		int light_count;
+	};
+
+	bool threaded_culling;
+
+	int _light_shadow_cull(InstanceLightData *p_light, ShadowCullMode p_cull_mode, int &r_cull_index, Scenario *p_scenario, const Vector<Plane> &p_planes, Instance **&r_result);
+	Vector<Plane> _light_get_shadow_pass_planes(Instance *p_instance, int p_pass) const;
+	uint32_t _light_get_shadow_passes_for_aabb(Instance *p_instance, const AABB &p_aabb) const;
+	_FORCE_INLINE_ uint32_t _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario, ShadowCullMode p_cull_mode = SHADOW_CULL_IMMEDIATE);
+	void _cull_job(uint32_t p_index, CullJobs *p_jobs);
+	bool _process_cull_jobs(CullJobs *p_jobs);
 
-	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe);
+	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, bool p_use_occlusion = true);
 	void _render_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass);
 	void render_empty_scene(RID p_scenario, RID p_shadow_atlas);
 
@@ -480,6 +739,9 @@ public:
 	void render_camera(Ref<ARVRInterface> &p_interface, ARVRInterface::Eyes p_eye, RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas);
 	void update_dirty_instances();
 
+	void update_interpolation_tick();
+	void update_interpolation_frame(float p_fraction);
+
 	//probes
 	struct GIProbeDataHeader {
 
@@ -526,6 +788,18 @@ public:
 	bool _check_gi_probe(Instance *p_gi_probe);
 	void _setup_gi_probe(Instance *p_instance);
 
+	struct ProbeCamera {
+		Scenario *scenario;
+		Vector3 position;
+	};
+
+	Vector<ProbeCamera> probe_cameras; //cameras drawn this frame, probes closer to them update first
+
+	int probe_update_steps_per_frame;
+	uint64_t probe_update_budget_usec;
+
+	float _get_probe_camera_distance(Instance *p_probe) const;
+
 	void render_probes();
 
 	bool free(RID p_rid);
@@ -30,11 +30,21 @@
 
 #include "visual_server_viewport.h"
 
+#include "core/hashfuncs.h"
 #include "core/project_settings.h"
 #include "visual_server_canvas.h"
 #include "visual_server_globals.h"
 #include "visual_server_scene.h"
 
+static _FORCE_INLINE_ uint64_t _hash_transform(const Transform2D &p_xform, uint64_t p_hash) {
+
+	for (int i = 0; i < 3; i++) {
+		p_hash = hash_djb2_one_64(make_uint64_t(p_xform.elements[i].x), p_hash);
+		p_hash = hash_djb2_one_64(make_uint64_t(p_xform.elements[i].y), p_hash);
+	}
+	return p_hash;
+}
+
 static Transform2D _canvas_get_transform(VisualServerViewport::Viewport *p_viewport, VisualServerCanvas::Canvas *p_canvas, VisualServerViewport::Viewport::CanvasData *p_canvas_data, const Vector2 &p_vp_size) {
 
 	Transform2D xf = p_viewport->global_transform;
@@ -178,7 +188,7 @@ void VisualServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::E
 		if (lights_with_shadow) {
 			//update shadows if any
 
-			RasterizerCanvas::LightOccluderInstance *occluders = NULL;
+			Vector<RasterizerCanvas::LightOccluderInstance *> occluders;
 
 			//make list of occluders
 			for (Map<RID, Viewport::CanvasData>::Element *E = p_viewport->canvas_map.front(); E; E = E->next()) {
@@ -193,16 +203,56 @@ void VisualServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::E
 					F->get()->xform_cache = xf * F->get()->xform;
 					if (shadow_rect.intersects_transformed(F->get()->xform_cache, F->get()->aabb_cache)) {
 
-						F->get()->next = occluders;
-						occluders = F->get();
+						occluders.push_back(F->get());
 					}
 				}
 			}
-			//update the light shadowmaps with them
+
+			//update the light shadowmaps with them, each light only gets the occluders that overlap its own rect
+			//and match its mask, and its shadowmap is only rendered again when those or the light itself changed.
+			//only the light to occluder transform matters, so for occluders in the light's canvas the canvas
+			//transform is left out of the state and scrolling the camera keeps the shadowmaps
+			RasterizerCanvas::LightOccluderInstance *const *occluder_ptr = occluders.ptr();
+			int occluder_count = occluders.size();
+
 			RasterizerCanvas::Light *light = lights_with_shadow;
 			while (light) {
 
-				VSG::canvas_render->canvas_light_shadow_buffer_update(light->shadow_buffer, light->xform_cache.affine_inverse(), light->item_shadow_mask, light->radius_cache / 1000.0, light->radius_cache * 1.1, occluders, &light->shadow_matrix_cache);
+				Rect2 light_rect = light->xform_cache.xform(light->rect_cache).expand(light->xform_cache.get_origin());
+				RasterizerCanvas::LightOccluderInstance *light_occluders = NULL;
+
+				uint64_t hash = hash_djb2_one_64(light->shadow_buffer.get_id());
+				hash = _hash_transform(light->xform, hash);
+				hash = hash_djb2_one_64(make_uint64_t(light->radius_cache), hash);
+				hash = hash_djb2_one_64(light->item_shadow_mask, hash);
+
+				for (int j = occluder_count - 1; j >= 0; j--) {
+
+					RasterizerCanvas::LightOccluderInstance *occluder = occluder_ptr[j];
+					if (!(occluder->light_mask & light->item_shadow_mask) || !light_rect.intersects_transformed(occluder->xform_cache, occluder->aabb_cache))
+						continue;
+
+					occluder->next = light_occluders;
+					light_occluders = occluder;
+
+					hash = hash_djb2_one_64(occluder->polygon_buffer.get_id(), hash);
+					hash = hash_djb2_one_64(occluder->version, hash);
+					hash = hash_djb2_one_64(occluder->cull_cache, hash);
+					if (occluder->canvas == light->canvas) {
+						hash = _hash_transform(occluder->xform, hash);
+					} else {
+						hash = _hash_transform(light->xform_cache.affine_inverse() * occluder->xform_cache, hash);
+					}
+				}
+
+				if (hash == 0)
+					hash = 1;
+
+				if (hash != light->shadow_hash_cache) {
+					VSG::canvas_render->canvas_light_shadow_buffer_update(light->shadow_buffer, light->xform_cache.affine_inverse(), light->item_shadow_mask, light->radius_cache / 1000.0, light->radius_cache * 1.1, light_occluders, &light->shadow_matrix_cache);
+					light->shadow_hash_cache = hash;
+				}
+
 				light = light->shadows_next_ptr;
 			}
 
@@ -276,7 +326,8 @@ void VisualServerViewport::draw_viewports() {
 	}
 
 	if (Engine::get_singleton()->is_editor_hint()) {
-		clear_color = GLOBAL_GET("rendering/environment/default_clear_color");
+		static ProjectSettings::Handle<Color> default_clear_color("rendering/environment/default_clear_color");
+		clear_color = default_clear_color;
 	}
 
 	//sort viewports
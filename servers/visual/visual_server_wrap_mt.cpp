@@ -29,6 +29,7 @@
 /*************************************************************************/
 
 #include "visual_server_wrap_mt.h"
+#include "core/frame_arena.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
 
@@ -42,6 +43,7 @@ void VisualServerWrapMT::thread_draw(bool p_swap_buffers, double frame_step) {
 	if (!atomic_decrement(&draw_pending)) {
 
 		visual_server->draw(p_swap_buffers, frame_step);
+		FrameArena::reset();
 	}
 }
 
@@ -97,10 +99,13 @@ void VisualServerWrapMT::draw(bool p_swap_buffers, double frame_step) {
 
 		atomic_increment(&draw_pending);
 		command_queue.push(this, &VisualServerWrapMT::thread_draw, p_swap_buffers, frame_step);
+		command_queue.submit();
 	} else {
 
 		visual_server->draw(p_swap_buffers, frame_step);
 	}
+
+	command_queue.end_frame();
 }
 
 void VisualServerWrapMT::init() {
@@ -109,6 +114,8 @@ void VisualServerWrapMT::init() {
 
 		print_verbose("VisualServerWrapMT: Creating render thread");
 		OS::get_singleton()->release_rendering_thread();
+		//calls from this thread are recorded and handed over once per frame
+		command_queue.set_recording_thread(true, Thread::get_caller_id());
 		if (create_thread) {
 			thread = Thread::create(_thread_callback, this);
 			print_verbose("VisualServerWrapMT: Starting render thread");
@@ -127,6 +134,7 @@ void VisualServerWrapMT::finish() {
 
 	if (thread) {
 
+		command_queue.set_recording_thread(false);
 		command_queue.push(this, &VisualServerWrapMT::thread_exit);
 		Thread::wait_to_finish(thread);
 		memdelete(thread);
@@ -156,6 +164,8 @@ void VisualServerWrapMT::finish() {
 	environment_free_cached_ids();
 	scenario_free_cached_ids();
 	instance_free_cached_ids();
+	occluder_free_cached_ids();
+	visibility_notifier_free_cached_ids();
 	canvas_free_cached_ids();
 	canvas_item_free_cached_ids();
 	canvas_light_occluder_free_cached_ids();
@@ -98,6 +98,9 @@ public:
 	FUNC3(texture_set_detect_srgb_callback, RID, TextureDetectCallback, void *)
 	FUNC3(texture_set_detect_normal_callback, RID, TextureDetectCallback, void *)
 
+	FUNC3(texture_set_stream_callback, RID, TextureStreamCallback, void *)
+	FUNC3(texture_set_stream_data, RID, const Ref<Image> &, int)
+
 	FUNC2(texture_set_path, RID, const String &)
 	FUNC1RC(String, texture_get_path, RID)
 	FUNC1(texture_set_shrink_all_x2_on_set_data, bool)
@@ -171,6 +174,8 @@ public:
 	FUNC2RC(Vector<PoolVector<uint8_t> >, mesh_surface_get_blend_shapes, RID, int)
 	FUNC2RC(Vector<AABB>, mesh_surface_get_skeleton_aabb, RID, int)
 
+	FUNC4(mesh_surface_set_lods, RID, int, const Vector<float> &, const Vector<PoolVector<uint8_t> > &)
+
 	FUNC2(mesh_remove_surface, RID, int)
 	FUNC1RC(int, mesh_get_surface_count, RID)
 
@@ -201,6 +206,7 @@ public:
 	FUNC2RC(Color, multimesh_instance_get_custom_data, RID, int)
 
 	FUNC2(multimesh_set_as_bulk_array, RID, const PoolVector<float> &)
+	FUNC3(multimesh_set_as_bulk_array_range, RID, int, const PoolVector<float> &)
 
 	FUNC2(multimesh_set_visible_instances, RID, int)
 	FUNC1RC(int, multimesh_get_visible_instances, RID)
@@ -226,6 +232,7 @@ public:
 	FUNC3(skeleton_allocate, RID, int, bool)
 	FUNC1RC(int, skeleton_get_bone_count, RID)
 	FUNC3(skeleton_bone_set_transform, RID, int, const Transform &)
+	FUNC2(skeleton_set_bone_transforms, RID, const Vector<Transform> &)
 	FUNC2RC(Transform, skeleton_bone_get_transform, RID, int)
 	FUNC3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	FUNC2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
@@ -343,6 +350,8 @@ public:
 	FUNC2(particles_set_process_material, RID, RID)
 	FUNC2(particles_set_fixed_fps, RID, int)
 	FUNC2(particles_set_fractional_delta, RID, bool)
+	FUNC3(particles_set_collision_heightfield, RID, RID, const AABB &)
+	FUNC2(particles_set_collision_bounce, RID, float)
 	FUNC1R(bool, particles_is_inactive, RID)
 	FUNC1(particles_request_process, RID)
 	FUNC1(particles_restart, RID)
@@ -362,6 +371,8 @@ public:
 	FUNC4(camera_set_orthogonal, RID, float, float, float)
 	FUNC5(camera_set_frustum, RID, float, Vector2, float, float)
 	FUNC2(camera_set_transform, RID, const Transform &)
+	FUNC2(camera_set_interpolated, RID, bool)
+	FUNC1(camera_reset_physics_interpolation, RID)
 	FUNC2(camera_set_cull_mask, RID, uint32_t)
 	FUNC2(camera_set_environment, RID, RID)
 	FUNC2(camera_set_use_vertical_aspect, RID, bool)
@@ -431,7 +442,9 @@ public:
 	FUNC4(environment_set_ambient_light, RID, const Color &, float, float)
 	FUNC2(environment_set_camera_feed_id, RID, int)
 	FUNC7(environment_set_ssr, RID, bool, int, float, float, float, bool)
+	FUNC3(environment_set_ssr_resolution, RID, EnvironmentEffectResolution, bool)
 	FUNC13(environment_set_ssao, RID, bool, float, float, float, float, float, float, float, const Color &, EnvironmentSSAOQuality, EnvironmentSSAOBlur, float)
+	FUNC3(environment_set_ssao_resolution, RID, EnvironmentEffectResolution, bool)
 
 	FUNC6(environment_set_dof_blur_near, RID, bool, float, float, float, EnvironmentDOFBlurQuality)
 	FUNC6(environment_set_dof_blur_far, RID, bool, float, float, float, EnvironmentDOFBlurQuality)
@@ -448,6 +461,7 @@ public:
 	FUNCRID(scenario)
 
 	FUNC2(scenario_set_debug, RID, ScenarioDebugMode)
+	FUNC2(scenario_set_spatial_partitioning, RID, ScenarioSpatialPartitioning)
 	FUNC2(scenario_set_environment, RID, RID)
 	FUNC3(scenario_set_reflection_atlas_size, RID, int, int)
 	FUNC2(scenario_set_fallback_environment, RID, RID)
@@ -459,12 +473,18 @@ public:
 	FUNC2(instance_set_scenario, RID, RID)
 	FUNC2(instance_set_layer_mask, RID, uint32_t)
 	FUNC2(instance_set_transform, RID, const Transform &)
+	FUNC2(instance_set_interpolated, RID, bool)
+	FUNC1(instance_reset_physics_interpolation, RID)
 	FUNC2(instance_attach_object_instance_id, RID, ObjectID)
 	FUNC3(instance_set_blend_shape_weight, RID, int, float)
 	FUNC3(instance_set_surface_material, RID, int, RID)
 	FUNC2(instance_set_visible, RID, bool)
 	FUNC3(instance_set_use_lightmap, RID, RID, RID)
 
+	FUNC2(instances_set_transforms, const Vector<RID> &, const Vector<Transform> &)
+	FUNC2(instances_set_visible, const Vector<RID> &, const Vector<bool> &)
+	FUNC2(instances_geometry_set_material_override, const Vector<RID> &, RID)
+
 	FUNC2(instance_set_custom_aabb, RID, AABB)
 
 	FUNC2(instance_attach_skeleton, RID, RID)
@@ -484,6 +504,20 @@ public:
 	FUNC5(instance_geometry_set_draw_range, RID, float, float, float, float)
 	FUNC2(instance_geometry_set_as_instance_lod, RID, RID)
 
+	/* OCCLUDER API */
+
+	FUNCRID(occluder)
+	FUNC2(occluder_set_scenario, RID, RID)
+	FUNC2(occluder_set_transform, RID, const Transform &)
+	FUNC2(occluder_set_faces, RID, const PoolVector<Vector3> &)
+	FUNC2(occluder_set_enabled, RID, bool)
+
+	/* VISIBILITY NOTIFIER API */
+
+	FUNCRID(visibility_notifier)
+	FUNC2(visibility_notifier_set_aabb, RID, const AABB &)
+	FUNC1R(Vector<VisibilityNotifierEvent>, scenario_get_visibility_notifier_events, RID)
+
 	/* CANVAS (2D) */
 
 	FUNCRID(canvas)
@@ -501,6 +535,8 @@ public:
 	FUNC2(canvas_item_set_update_when_visible, RID, bool)
 
 	FUNC2(canvas_item_set_transform, RID, const Transform2D &)
+	FUNC2(canvas_item_set_interpolated, RID, bool)
+	FUNC1(canvas_item_reset_physics_interpolation, RID)
 	FUNC2(canvas_item_set_clip, RID, bool)
 	FUNC2(canvas_item_set_distance_field_mode, RID, bool)
 	FUNC3(canvas_item_set_custom_rect, RID, bool, const Rect2 &)
@@ -592,12 +628,19 @@ public:
 	virtual void finish();
 	virtual void draw(bool p_swap_buffers, double frame_step);
 	virtual void sync();
+	FUNC0(tick)
+	FUNC1(pre_draw, float)
 	FUNC0RC(bool, has_changed)
 
 	/* RENDER INFO */
 
 	//this passes directly to avoid stalling
 	virtual int get_render_info(RenderInfo p_info) {
+		if (p_info == INFO_SERVER_COMMANDS_IN_FRAME) {
+			return command_queue.get_frame_command_count();
+		} else if (p_info == INFO_SERVER_COMMAND_BYTES_IN_FRAME) {
+			return command_queue.get_frame_command_bytes();
+		}
 		return visual_server->get_render_info(p_info);
 	}
 
@@ -616,8 +659,11 @@ public:
 
 	FUNC1(set_debug_generate_wireframes, bool)
 
+	FUNC0(warm_up_shaders)
+
 	virtual bool has_feature(Features p_feature) const { return visual_server->has_feature(p_feature); }
 	virtual bool has_os_feature(const String &p_feature) const { return visual_server->has_os_feature(p_feature); }
+	virtual bool is_headless() const { return visual_server->is_headless(); }
 
 	FUNC1(call_set_use_vsync, bool)
 
@@ -124,6 +124,50 @@ Array VisualServer::_instances_cull_convex_bind(const Array &p_convex, RID p_sce
 	return to_array(ids);
 }
 
+void VisualServer::_instances_set_transforms_bind(const Vector<RID> &p_instances, const Array &p_transforms) {
+
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	Vector<Transform> transforms;
+	transforms.resize(p_transforms.size());
+	Transform *w = transforms.ptrw();
+	for (int i = 0; i < p_transforms.size(); i++) {
+		const Variant &v = p_transforms[i];
+		ERR_FAIL_COND(v.get_type() != Variant::TRANSFORM);
+		w[i] = v;
+	}
+
+	instances_set_transforms(p_instances, transforms);
+}
+
+void VisualServer::_skeleton_set_bone_transforms_bind(RID p_skeleton, const Array &p_transforms) {
+
+	Vector<Transform> transforms;
+	transforms.resize(p_transforms.size());
+	Transform *w = transforms.ptrw();
+	for (int i = 0; i < p_transforms.size(); i++) {
+		const Variant &v = p_transforms[i];
+		ERR_FAIL_COND(v.get_type() != Variant::TRANSFORM);
+		w[i] = v;
+	}
+
+	skeleton_set_bone_transforms(p_skeleton, transforms);
+}
+
+void VisualServer::_instances_set_visible_bind(const Vector<RID> &p_instances, const Array &p_visible) {
+
+	ERR_FAIL_COND(p_instances.size() != p_visible.size());
+
+	Vector<bool> visible;
+	visible.resize(p_visible.size());
+	bool *w = visible.ptrw();
+	for (int i = 0; i < p_visible.size(); i++) {
+		w[i] = p_visible[i];
+	}
+
+	instances_set_visible(p_instances, visible);
+}
+
 RID VisualServer::get_test_texture() {
 
 	if (test_texture.is_valid()) {
@@ -1636,6 +1680,21 @@ Array VisualServer::_mesh_surface_get_skeleton_aabb_bind(RID p_mesh, int p_surfa
 	return arr;
 }
 
+void VisualServer::_mesh_surface_set_lods_bind(RID p_mesh, int p_surface, const PoolVector<float> &p_edge_lengths, const Array &p_index_arrays) {
+
+	ERR_FAIL_COND(p_edge_lengths.size() != p_index_arrays.size());
+
+	Vector<float> edge_lengths;
+	Vector<PoolVector<uint8_t> > index_arrays;
+	for (int i = 0; i < p_index_arrays.size(); i++) {
+		ERR_FAIL_COND(p_index_arrays[i].get_type() != Variant::POOL_BYTE_ARRAY);
+		edge_lengths.push_back(p_edge_lengths[i]);
+		index_arrays.push_back(p_index_arrays[i]);
+	}
+
+	mesh_surface_set_lods(p_mesh, p_surface, edge_lengths, index_arrays);
+}
+
 void VisualServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("force_sync"), &VisualServer::sync);
@@ -1711,6 +1770,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_primitive_type", "mesh", "surface"), &VisualServer::mesh_surface_get_primitive_type);
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_aabb", "mesh", "surface"), &VisualServer::mesh_surface_get_aabb);
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_skeleton_aabb", "mesh", "surface"), &VisualServer::_mesh_surface_get_skeleton_aabb_bind);
+	ClassDB::bind_method(D_METHOD("mesh_surface_set_lods", "mesh", "surface", "edge_lengths", "index_arrays"), &VisualServer::_mesh_surface_set_lods_bind);
 	ClassDB::bind_method(D_METHOD("mesh_remove_surface", "mesh", "index"), &VisualServer::mesh_remove_surface);
 	ClassDB::bind_method(D_METHOD("mesh_get_surface_count", "mesh"), &VisualServer::mesh_get_surface_count);
 	ClassDB::bind_method(D_METHOD("mesh_set_custom_aabb", "mesh", "aabb"), &VisualServer::mesh_set_custom_aabb);
@@ -1734,6 +1794,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("multimesh_set_visible_instances", "multimesh", "visible"), &VisualServer::multimesh_set_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_get_visible_instances", "multimesh"), &VisualServer::multimesh_get_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_set_as_bulk_array", "multimesh", "array"), &VisualServer::multimesh_set_as_bulk_array);
+	ClassDB::bind_method(D_METHOD("multimesh_set_as_bulk_array_range", "multimesh", "from_instance", "array"), &VisualServer::multimesh_set_as_bulk_array_range);
 #ifndef _3D_DISABLED
 	ClassDB::bind_method(D_METHOD("immediate_create"), &VisualServer::immediate_create);
 	ClassDB::bind_method(D_METHOD("immediate_begin", "immediate", "primitive", "texture"), &VisualServer::immediate_begin, DEFVAL(RID()));
@@ -1754,6 +1815,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("skeleton_allocate", "skeleton", "bones", "is_2d_skeleton"), &VisualServer::skeleton_allocate, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("skeleton_get_bone_count", "skeleton"), &VisualServer::skeleton_get_bone_count);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_set_transform", "skeleton", "bone", "transform"), &VisualServer::skeleton_bone_set_transform);
+	ClassDB::bind_method(D_METHOD("skeleton_set_bone_transforms", "skeleton", "transforms"), &VisualServer::_skeleton_set_bone_transforms_bind);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform", "skeleton", "bone"), &VisualServer::skeleton_bone_get_transform);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_set_transform_2d", "skeleton", "bone", "transform"), &VisualServer::skeleton_bone_set_transform_2d);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform_2d", "skeleton", "bone"), &VisualServer::skeleton_bone_get_transform_2d);
@@ -1845,6 +1907,8 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("particles_set_process_material", "particles", "material"), &VisualServer::particles_set_process_material);
 	ClassDB::bind_method(D_METHOD("particles_set_fixed_fps", "particles", "fps"), &VisualServer::particles_set_fixed_fps);
 	ClassDB::bind_method(D_METHOD("particles_set_fractional_delta", "particles", "enable"), &VisualServer::particles_set_fractional_delta);
+	ClassDB::bind_method(D_METHOD("particles_set_collision_heightfield", "particles", "texture", "aabb"), &VisualServer::particles_set_collision_heightfield);
+	ClassDB::bind_method(D_METHOD("particles_set_collision_bounce", "particles", "bounce"), &VisualServer::particles_set_collision_bounce);
 	ClassDB::bind_method(D_METHOD("particles_is_inactive", "particles"), &VisualServer::particles_is_inactive);
 	ClassDB::bind_method(D_METHOD("particles_request_process", "particles"), &VisualServer::particles_request_process);
 	ClassDB::bind_method(D_METHOD("particles_restart", "particles"), &VisualServer::particles_restart);
@@ -1862,6 +1926,8 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("camera_set_cull_mask", "camera", "layers"), &VisualServer::camera_set_cull_mask);
 	ClassDB::bind_method(D_METHOD("camera_set_environment", "camera", "env"), &VisualServer::camera_set_environment);
 	ClassDB::bind_method(D_METHOD("camera_set_use_vertical_aspect", "camera", "enable"), &VisualServer::camera_set_use_vertical_aspect);
+	ClassDB::bind_method(D_METHOD("camera_set_interpolated", "camera", "interpolated"), &VisualServer::camera_set_interpolated);
+	ClassDB::bind_method(D_METHOD("camera_reset_physics_interpolation", "camera"), &VisualServer::camera_reset_physics_interpolation);
 
 	ClassDB::bind_method(D_METHOD("viewport_create"), &VisualServer::viewport_create);
 	ClassDB::bind_method(D_METHOD("viewport_set_use_arvr", "viewport", "use_arvr"), &VisualServer::viewport_set_use_arvr);
@@ -1910,7 +1976,9 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("environment_set_tonemap", "env", "tone_mapper", "exposure", "white", "auto_exposure", "min_luminance", "max_luminance", "auto_exp_speed", "auto_exp_grey"), &VisualServer::environment_set_tonemap);
 	ClassDB::bind_method(D_METHOD("environment_set_adjustment", "env", "enable", "brightness", "contrast", "saturation", "ramp"), &VisualServer::environment_set_adjustment);
 	ClassDB::bind_method(D_METHOD("environment_set_ssr", "env", "enable", "max_steps", "fade_in", "fade_out", "depth_tolerance", "roughness"), &VisualServer::environment_set_ssr);
+	ClassDB::bind_method(D_METHOD("environment_set_ssr_resolution", "env", "resolution", "temporal"), &VisualServer::environment_set_ssr_resolution);
 	ClassDB::bind_method(D_METHOD("environment_set_ssao", "env", "enable", "radius", "intensity", "radius2", "intensity2", "bias", "light_affect", "ao_channel_affect", "color", "quality", "blur", "bilateral_sharpness"), &VisualServer::environment_set_ssao);
+	ClassDB::bind_method(D_METHOD("environment_set_ssao_resolution", "env", "resolution", "temporal"), &VisualServer::environment_set_ssao_resolution);
 	ClassDB::bind_method(D_METHOD("environment_set_fog", "env", "enable", "color", "sun_color", "sun_amount"), &VisualServer::environment_set_fog);
 
 	ClassDB::bind_method(D_METHOD("environment_set_fog_depth", "env", "enable", "depth_begin", "depth_end", "depth_curve", "transmit", "transmit_curve"), &VisualServer::environment_set_fog_depth);
@@ -1919,6 +1987,7 @@ void VisualServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("scenario_create"), &VisualServer::scenario_create);
 	ClassDB::bind_method(D_METHOD("scenario_set_debug", "scenario", "debug_mode"), &VisualServer::scenario_set_debug);
+	ClassDB::bind_method(D_METHOD("scenario_set_spatial_partitioning", "scenario", "mode"), &VisualServer::scenario_set_spatial_partitioning);
 	ClassDB::bind_method(D_METHOD("scenario_set_environment", "scenario", "environment"), &VisualServer::scenario_set_environment);
 	ClassDB::bind_method(D_METHOD("scenario_set_reflection_atlas_size", "scenario", "size", "subdiv"), &VisualServer::scenario_set_reflection_atlas_size);
 	ClassDB::bind_method(D_METHOD("scenario_set_fallback_environment", "scenario", "environment"), &VisualServer::scenario_set_fallback_environment);
@@ -1931,6 +2000,8 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_scenario", "instance", "scenario"), &VisualServer::instance_set_scenario);
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &VisualServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &VisualServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instance_set_interpolated", "instance", "interpolated"), &VisualServer::instance_set_interpolated);
+	ClassDB::bind_method(D_METHOD("instance_reset_physics_interpolation", "instance"), &VisualServer::instance_reset_physics_interpolation);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &VisualServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &VisualServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_material", "instance", "surface", "material"), &VisualServer::instance_set_surface_material);
@@ -1945,6 +2016,15 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_geometry_set_material_override", "instance", "material"), &VisualServer::instance_geometry_set_material_override);
 	ClassDB::bind_method(D_METHOD("instance_geometry_set_draw_range", "instance", "min", "max", "min_margin", "max_margin"), &VisualServer::instance_geometry_set_draw_range);
 	ClassDB::bind_method(D_METHOD("instance_geometry_set_as_instance_lod", "instance", "as_lod_of_instance"), &VisualServer::instance_geometry_set_as_instance_lod);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &VisualServer::_instances_set_transforms_bind);
+	ClassDB::bind_method(D_METHOD("instances_set_visible", "instances", "visible"), &VisualServer::_instances_set_visible_bind);
+	ClassDB::bind_method(D_METHOD("instances_geometry_set_material_override", "instances", "material"), &VisualServer::instances_geometry_set_material_override);
+
+	ClassDB::bind_method(D_METHOD("occluder_create"), &VisualServer::occluder_create);
+	ClassDB::bind_method(D_METHOD("occluder_set_scenario", "occluder", "scenario"), &VisualServer::occluder_set_scenario);
+	ClassDB::bind_method(D_METHOD("occluder_set_transform", "occluder", "transform"), &VisualServer::occluder_set_transform);
+	ClassDB::bind_method(D_METHOD("occluder_set_faces", "occluder", "faces"), &VisualServer::occluder_set_faces);
+	ClassDB::bind_method(D_METHOD("occluder_set_enabled", "occluder", "enabled"), &VisualServer::occluder_set_enabled);
 
 	ClassDB::bind_method(D_METHOD("instances_cull_aabb", "aabb", "scenario"), &VisualServer::_instances_cull_aabb_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_ray", "from", "to", "scenario"), &VisualServer::_instances_cull_ray_bind, DEFVAL(RID()));
@@ -1959,6 +2039,8 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("canvas_item_set_visible", "item", "visible"), &VisualServer::canvas_item_set_visible);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_light_mask", "item", "mask"), &VisualServer::canvas_item_set_light_mask);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_transform", "item", "transform"), &VisualServer::canvas_item_set_transform);
+	ClassDB::bind_method(D_METHOD("canvas_item_set_interpolated", "item", "interpolated"), &VisualServer::canvas_item_set_interpolated);
+	ClassDB::bind_method(D_METHOD("canvas_item_reset_physics_interpolation", "item"), &VisualServer::canvas_item_reset_physics_interpolation);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_clip", "item", "clip"), &VisualServer::canvas_item_set_clip);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_distance_field_mode", "item", "enabled"), &VisualServer::canvas_item_set_distance_field_mode);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_custom_rect", "item", "use_custom_rect", "rect"), &VisualServer::canvas_item_set_custom_rect, DEFVAL(Rect2()));
@@ -2048,6 +2130,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("has_feature", "feature"), &VisualServer::has_feature);
 	ClassDB::bind_method(D_METHOD("has_os_feature", "feature"), &VisualServer::has_os_feature);
 	ClassDB::bind_method(D_METHOD("set_debug_generate_wireframes", "generate"), &VisualServer::set_debug_generate_wireframes);
+	ClassDB::bind_method(D_METHOD("warm_up_shaders"), &VisualServer::warm_up_shaders);
 
 	BIND_CONSTANT(NO_INDEX_ARRAY);
 	BIND_CONSTANT(ARRAY_WEIGHTS_SIZE);
@@ -2200,6 +2283,9 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(SCENARIO_DEBUG_OVERDRAW);
 	BIND_ENUM_CONSTANT(SCENARIO_DEBUG_SHADELESS);
 
+	BIND_ENUM_CONSTANT(SCENARIO_SPATIAL_PARTITIONING_OCTREE);
+	BIND_ENUM_CONSTANT(SCENARIO_SPATIAL_PARTITIONING_BVH);
+
 	BIND_ENUM_CONSTANT(INSTANCE_NONE);
 	BIND_ENUM_CONSTANT(INSTANCE_MESH);
 	BIND_ENUM_CONSTANT(INSTANCE_MULTIMESH);
@@ -2209,6 +2295,7 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INSTANCE_REFLECTION_PROBE);
 	BIND_ENUM_CONSTANT(INSTANCE_GI_PROBE);
 	BIND_ENUM_CONSTANT(INSTANCE_LIGHTMAP_CAPTURE);
+	BIND_ENUM_CONSTANT(INSTANCE_VISIBILITY_NOTIFIER);
 	BIND_ENUM_CONSTANT(INSTANCE_MAX);
 	BIND_ENUM_CONSTANT(INSTANCE_GEOMETRY_MASK);
 
@@ -2251,6 +2338,10 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_2D_COMMANDS_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_SERVER_COMMANDS_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_SERVER_COMMAND_BYTES_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -2293,6 +2384,10 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(ENV_TONE_MAPPER_FILMIC);
 	BIND_ENUM_CONSTANT(ENV_TONE_MAPPER_ACES);
 
+	BIND_ENUM_CONSTANT(ENV_EFFECT_RESOLUTION_FULL);
+	BIND_ENUM_CONSTANT(ENV_EFFECT_RESOLUTION_HALF);
+	BIND_ENUM_CONSTANT(ENV_EFFECT_RESOLUTION_QUARTER);
+
 	BIND_ENUM_CONSTANT(ENV_SSAO_QUALITY_LOW);
 	BIND_ENUM_CONSTANT(ENV_SSAO_QUALITY_MEDIUM);
 	BIND_ENUM_CONSTANT(ENV_SSAO_QUALITY_HIGH);
@@ -2411,6 +2506,24 @@ VisualServer::VisualServer() {
 	GLOBAL_DEF("rendering/quality/depth_prepass/disable_for_vendors", "PowerVR,Mali,Adreno,Apple");
 
 	GLOBAL_DEF("rendering/quality/filters/use_nearest_mipmap_filter", false);
+
+	GLOBAL_DEF("rendering/quality/spatial_partitioning/use_bvh", true);
+
+	GLOBAL_DEF("rendering/quality/occlusion_culling/buffer_width", 256);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/occlusion_culling/buffer_width", PropertyInfo(Variant::INT, "rendering/quality/occlusion_culling/buffer_width", PROPERTY_HINT_RANGE, "64,1024"));
+
+	GLOBAL_DEF("rendering/threads/threaded_culling", true);
+
+	GLOBAL_DEF("rendering/quality/probes/update_steps_per_frame", 12);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/probes/update_steps_per_frame", PropertyInfo(Variant::INT, "rendering/quality/probes/update_steps_per_frame", PROPERTY_HINT_RANGE, "1,256"));
+	GLOBAL_DEF("rendering/quality/probes/update_budget_msec", 0.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/probes/update_budget_msec", PropertyInfo(Variant::REAL, "rendering/quality/probes/update_budget_msec", PROPERTY_HINT_RANGE, "0,100,0.1"));
+
+	GLOBAL_DEF_RST("rendering/texture_streaming/enabled", false);
+	GLOBAL_DEF_RST("rendering/texture_streaming/min_resident_size", 128);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/texture_streaming/min_resident_size", PropertyInfo(Variant::INT, "rendering/texture_streaming/min_resident_size", PROPERTY_HINT_RANGE, "4,4096"));
+	GLOBAL_DEF_RST("rendering/texture_streaming/memory_budget_mb", 512);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/texture_streaming/memory_budget_mb", PropertyInfo(Variant::INT, "rendering/texture_streaming/memory_budget_mb", PROPERTY_HINT_RANGE, "16,16384"));
 }
 
 VisualServer::~VisualServer() {
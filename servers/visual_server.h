@@ -150,6 +150,12 @@ public:
 	virtual void texture_set_detect_srgb_callback(RID p_texture, TextureDetectCallback p_callback, void *p_userdata) = 0;
 	virtual void texture_set_detect_normal_callback(RID p_texture, TextureDetectCallback p_callback, void *p_userdata) = 0;
 
+	typedef void (*TextureStreamCallback)(void *, int);
+
+	//streamed textures only keep some mipmaps resident, the callback asks for the chain to start at a different mipmap
+	virtual void texture_set_stream_callback(RID p_texture, TextureStreamCallback p_callback, void *p_userdata) = 0;
+	virtual void texture_set_stream_data(RID p_texture, const Ref<Image> &p_image, int p_first_mipmap) = 0;
+
 	struct TextureInfo {
 		RID texture;
 		uint32_t width;
@@ -314,6 +320,9 @@ public:
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const = 0;
 	Array _mesh_surface_get_skeleton_aabb_bind(RID p_mesh, int p_surface) const;
 
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_edge_lengths, const Vector<PoolVector<uint8_t> > &p_index_arrays) = 0; //index arrays use the surface index format, sorted from finest to coarsest
+	void _mesh_surface_set_lods_bind(RID p_mesh, int p_surface, const PoolVector<float> &p_edge_lengths, const Array &p_index_arrays);
+
 	virtual void mesh_remove_surface(RID p_mesh, int p_index) = 0;
 	virtual int mesh_get_surface_count(RID p_mesh) const = 0;
 
@@ -363,6 +372,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const = 0;
 
 	virtual void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array) = 0;
+	virtual void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) = 0; //only the given instances, unchanged ones are not uploaded again
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) = 0;
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const = 0;
@@ -389,6 +399,7 @@ public:
 	virtual void skeleton_allocate(RID p_skeleton, int p_bones, bool p_2d_skeleton = false) = 0;
 	virtual int skeleton_get_bone_count(RID p_skeleton) const = 0;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) = 0;
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms) = 0; //bones 0 to size-1, in one command
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const = 0;
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) = 0;
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const = 0;
@@ -562,6 +573,8 @@ public:
 	virtual void particles_set_process_material(RID p_particles, RID p_material) = 0;
 	virtual void particles_set_fixed_fps(RID p_particles, int p_fps) = 0;
 	virtual void particles_set_fractional_delta(RID p_particles, bool p_enable) = 0;
+	virtual void particles_set_collision_heightfield(RID p_particles, RID p_texture, const AABB &p_aabb) = 0;
+	virtual void particles_set_collision_bounce(RID p_particles, float p_bounce) = 0;
 	virtual bool particles_is_inactive(RID p_particles) = 0;
 	virtual void particles_request_process(RID p_particles) = 0;
 	virtual void particles_restart(RID p_particles) = 0;
@@ -591,6 +604,8 @@ public:
 	virtual void camera_set_cull_mask(RID p_camera, uint32_t p_layers) = 0;
 	virtual void camera_set_environment(RID p_camera, RID p_env) = 0;
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable) = 0;
+	virtual void camera_set_interpolated(RID p_camera, bool p_interpolated) = 0;
+	virtual void camera_reset_physics_interpolation(RID p_camera) = 0;
 
 	/*
 	enum ParticlesCollisionMode {
@@ -757,6 +772,14 @@ public:
 
 	virtual void environment_set_ssr(RID p_env, bool p_enable, int p_max_steps, float p_fade_in, float p_fade_out, float p_depth_tolerance, bool p_roughness) = 0;
 
+	enum EnvironmentEffectResolution {
+		ENV_EFFECT_RESOLUTION_FULL,
+		ENV_EFFECT_RESOLUTION_HALF,
+		ENV_EFFECT_RESOLUTION_QUARTER,
+	};
+
+	virtual void environment_set_ssr_resolution(RID p_env, EnvironmentEffectResolution p_resolution, bool p_temporal) = 0;
+
 	enum EnvironmentSSAOQuality {
 		ENV_SSAO_QUALITY_LOW,
 		ENV_SSAO_QUALITY_MEDIUM,
@@ -771,6 +794,7 @@ public:
 	};
 
 	virtual void environment_set_ssao(RID p_env, bool p_enable, float p_radius, float p_intensity, float p_radius2, float p_intensity2, float p_bias, float p_light_affect, float p_ao_channel_affect, const Color &p_color, EnvironmentSSAOQuality p_quality, EnvironmentSSAOBlur p_blur, float p_bilateral_sharpness) = 0;
+	virtual void environment_set_ssao_resolution(RID p_env, EnvironmentEffectResolution p_resolution, bool p_temporal) = 0;
 
 	virtual void environment_set_fog(RID p_env, bool p_enable, const Color &p_color, const Color &p_sun_color, float p_sun_amount) = 0;
 	virtual void environment_set_fog_depth(RID p_env, bool p_enable, float p_depth_begin, float p_depth_end, float p_depth_curve, bool p_transmit, float p_transmit_curve) = 0;
@@ -788,7 +812,14 @@ public:
 
 	};
 
+	enum ScenarioSpatialPartitioning {
+		SCENARIO_SPATIAL_PARTITIONING_OCTREE,
+		SCENARIO_SPATIAL_PARTITIONING_BVH,
+		SCENARIO_SPATIAL_PARTITIONING_MAX
+	};
+
 	virtual void scenario_set_debug(RID p_scenario, ScenarioDebugMode p_debug_mode) = 0;
+	virtual void scenario_set_spatial_partitioning(RID p_scenario, ScenarioSpatialPartitioning p_mode) = 0;
 	virtual void scenario_set_environment(RID p_scenario, RID p_environment) = 0;
 	virtual void scenario_set_reflection_atlas_size(RID p_scenario, int p_size, int p_subdiv) = 0;
 	virtual void scenario_set_fallback_environment(RID p_scenario, RID p_environment) = 0;
@@ -806,6 +837,7 @@ public:
 		INSTANCE_REFLECTION_PROBE,
 		INSTANCE_GI_PROBE,
 		INSTANCE_LIGHTMAP_CAPTURE,
+		INSTANCE_VISIBILITY_NOTIFIER,
 		INSTANCE_MAX,
 
 		INSTANCE_GEOMETRY_MASK = (1 << INSTANCE_MESH) | (1 << INSTANCE_MULTIMESH) | (1 << INSTANCE_IMMEDIATE) | (1 << INSTANCE_PARTICLES)
@@ -819,6 +851,8 @@ public:
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario) = 0;
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask) = 0;
 	virtual void instance_set_transform(RID p_instance, const Transform &p_transform) = 0;
+	virtual void instance_set_interpolated(RID p_instance, bool p_interpolated) = 0;
+	virtual void instance_reset_physics_interpolation(RID p_instance) = 0;
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id) = 0;
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight) = 0;
 	virtual void instance_set_surface_material(RID p_instance, int p_surface, RID p_material) = 0;
@@ -826,6 +860,15 @@ public:
 
 	virtual void instance_set_use_lightmap(RID p_instance, RID p_lightmap_instance, RID p_lightmap) = 0;
 
+	// bulk versions of the calls above, same as calling them on each instance but sent as a single command
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform> &p_transforms) = 0;
+	virtual void instances_set_visible(const Vector<RID> &p_instances, const Vector<bool> &p_visible) = 0;
+	virtual void instances_geometry_set_material_override(const Vector<RID> &p_instances, RID p_material) = 0;
+
+	void _instances_set_transforms_bind(const Vector<RID> &p_instances, const Array &p_transforms);
+	void _skeleton_set_bone_transforms_bind(RID p_skeleton, const Array &p_transforms);
+	void _instances_set_visible_bind(const Vector<RID> &p_instances, const Array &p_visible);
+
 	virtual void instance_set_custom_aabb(RID p_instance, AABB aabb) = 0;
 
 	virtual void instance_attach_skeleton(RID p_instance, RID p_skeleton) = 0;
@@ -862,6 +905,27 @@ public:
 	virtual void instance_geometry_set_draw_range(RID p_instance, float p_min, float p_max, float p_min_margin, float p_max_margin) = 0;
 	virtual void instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance) = 0;
 
+	/* OCCLUDER API */
+
+	virtual RID occluder_create() = 0;
+	virtual void occluder_set_scenario(RID p_occluder, RID p_scenario) = 0;
+	virtual void occluder_set_transform(RID p_occluder, const Transform &p_transform) = 0;
+	virtual void occluder_set_faces(RID p_occluder, const PoolVector<Vector3> &p_faces) = 0;
+	virtual void occluder_set_enabled(RID p_occluder, bool p_enabled) = 0;
+
+	/* VISIBILITY NOTIFIER API */
+
+	struct VisibilityNotifierEvent {
+		ObjectID notifier; // object attached to the notifier instance
+		RID camera;
+		bool entered;
+	};
+
+	virtual RID visibility_notifier_create() = 0;
+	virtual void visibility_notifier_set_aabb(RID p_notifier, const AABB &p_aabb) = 0;
+	// every camera enter and exit since the last call, as seen while rendering
+	virtual Vector<VisibilityNotifierEvent> scenario_get_visibility_notifier_events(RID p_scenario) = 0;
+
 	/* CANVAS (2D) */
 
 	virtual RID canvas_create() = 0;
@@ -880,6 +944,8 @@ public:
 	virtual void canvas_item_set_update_when_visible(RID p_item, bool p_update) = 0;
 
 	virtual void canvas_item_set_transform(RID p_item, const Transform2D &p_transform) = 0;
+	virtual void canvas_item_set_interpolated(RID p_item, bool p_interpolated) = 0;
+	virtual void canvas_item_reset_physics_interpolation(RID p_item) = 0;
 	virtual void canvas_item_set_clip(RID p_item, bool p_clip) = 0;
 	virtual void canvas_item_set_distance_field_mode(RID p_item, bool p_enable) = 0;
 	virtual void canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect = Rect2()) = 0;
@@ -997,6 +1063,8 @@ public:
 
 	virtual void draw(bool p_swap_buffers = true, double frame_step = 0.0) = 0;
 	virtual void sync() = 0;
+	virtual void tick() = 0; //called at the start of each physics tick
+	virtual void pre_draw(float p_interpolation_fraction) = 0; //blends interpolated transforms before drawing
 	virtual bool has_changed() const = 0;
 	virtual void init() = 0;
 	virtual void finish() = 0;
@@ -1015,6 +1083,10 @@ public:
 		INFO_VIDEO_MEM_USED,
 		INFO_TEXTURE_MEM_USED,
 		INFO_VERTEX_MEM_USED,
+		INFO_2D_COMMANDS_IN_FRAME,
+		INFO_2D_BATCHES_IN_FRAME,
+		INFO_SERVER_COMMANDS_IN_FRAME,
+		INFO_SERVER_COMMAND_BYTES_IN_FRAME,
 	};
 
 	virtual int get_render_info(RenderInfo p_info) = 0;
@@ -1049,10 +1121,14 @@ public:
 
 	virtual void set_debug_generate_wireframes(bool p_generate) = 0;
 
+	virtual void warm_up_shaders() = 0;
+
 	virtual void call_set_use_vsync(bool p_enable) = 0;
 
 	virtual bool is_low_end() const = 0;
 
+	virtual bool is_headless() const = 0;
+
 	VisualServer();
 	virtual ~VisualServer();
 };
@@ -1074,6 +1150,7 @@ VARIANT_ENUM_CAST(VisualServer::ViewportUsage);
 VARIANT_ENUM_CAST(VisualServer::ViewportRenderInfo);
 VARIANT_ENUM_CAST(VisualServer::ViewportDebugDraw);
 VARIANT_ENUM_CAST(VisualServer::ScenarioDebugMode);
+VARIANT_ENUM_CAST(VisualServer::ScenarioSpatialPartitioning);
 VARIANT_ENUM_CAST(VisualServer::InstanceType);
 VARIANT_ENUM_CAST(VisualServer::NinePatchAxisMode);
 VARIANT_ENUM_CAST(VisualServer::CanvasLightMode);
@@ -1094,6 +1171,7 @@ VARIANT_ENUM_CAST(VisualServer::EnvironmentBG);
 VARIANT_ENUM_CAST(VisualServer::EnvironmentDOFBlurQuality);
 VARIANT_ENUM_CAST(VisualServer::EnvironmentGlowBlendMode);
 VARIANT_ENUM_CAST(VisualServer::EnvironmentToneMapper);
+VARIANT_ENUM_CAST(VisualServer::EnvironmentEffectResolution);
 VARIANT_ENUM_CAST(VisualServer::EnvironmentSSAOQuality);
 VARIANT_ENUM_CAST(VisualServer::EnvironmentSSAOBlur);
 VARIANT_ENUM_CAST(VisualServer::InstanceFlags);
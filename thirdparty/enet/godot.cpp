@@ -41,6 +41,24 @@
 
 static enet_uint32 timeBase = 0;
 
+// Datagrams received or queued for sending per system call.
+#define ENET_GODOT_BATCH_SIZE 32
+
+// Incoming datagrams are read in batches and handed out one by one, outgoing ones are queued until
+// enet_socket_flush, called once ENet is done sending to every peer.
+struct ENetGodotSocket {
+	NetSocket *sock;
+
+	uint8_t recv_data[ENET_GODOT_BATCH_SIZE][ENET_PROTOCOL_MAXIMUM_MTU];
+	NetSocket::Datagram recv[ENET_GODOT_BATCH_SIZE];
+	int recv_count;
+	int recv_pos;
+
+	uint8_t send_data[ENET_GODOT_BATCH_SIZE][ENET_PROTOCOL_MAXIMUM_MTU];
+	NetSocket::Datagram send[ENET_GODOT_BATCH_SIZE];
+	int send_count;
+};
+
 int enet_initialize(void) {
 
 	return 0;
@@ -92,9 +110,20 @@ int enet_address_get_host(const ENetAddress *address, char *name, size_t nameLen
 
 ENetSocket enet_socket_create(ENetSocketType type) {
 
-	NetSocket *socket = NetSocket::create();
+	NetSocket *sock = NetSocket::create();
+	ERR_FAIL_COND_V(!sock, NULL);
 	IP::Type ip_type = IP::TYPE_ANY;
-	socket->open(NetSocket::TYPE_UDP, ip_type);
+	sock->open(NetSocket::TYPE_UDP, ip_type);
+
+	ENetGodotSocket *socket = memnew(ENetGodotSocket);
+	socket->sock = sock;
+	socket->recv_count = 0;
+	socket->recv_pos = 0;
+	socket->send_count = 0;
+	for (int i = 0; i < ENET_GODOT_BATCH_SIZE; i++) {
+		socket->recv[i].buffer = socket->recv_data[i];
+		socket->send[i].buffer = socket->send_data[i];
+	}
 
 	return socket;
 }
@@ -108,7 +137,7 @@ int enet_socket_bind(ENetSocket socket, const ENetAddress *address) {
 		ip.set_ipv6(address->host);
 	}
 
-	NetSocket *sock = (NetSocket *)socket;
+	NetSocket *sock = ((ENetGodotSocket *)socket)->sock;
 	if (sock->bind(ip, address->port) != OK) {
 		return -1;
 	}
@@ -116,78 +145,134 @@ int enet_socket_bind(ENetSocket socket, const ENetAddress *address) {
 }
 
 void enet_socket_destroy(ENetSocket socket) {
-	NetSocket *sock = (NetSocket *)socket;
+	NetSocket *sock = ((ENetGodotSocket *)socket)->sock;
 	sock->close();
 	memdelete(sock);
+	memdelete((ENetGodotSocket *)socket);
+}
+
+int enet_socket_flush(ENetSocket socket) {
+
+	ENetGodotSocket *s = (ENetGodotSocket *)socket;
+
+	int pos = 0;
+	while (pos < s->send_count) {
+
+		int sent = 0;
+		Error err = s->sock->sendto_batch(&s->send[pos], s->send_count - pos, sent);
+		if (err != OK) {
+
+			s->send_count = 0;
+			if (err == ERR_BUSY) { // Blocking call, drop the rest like a lossy link would.
+				return 0;
+			}
+
+			WARN_PRINT("Sending failed!");
+			return -1;
+		}
+		pos += sent;
+	}
+
+	s->send_count = 0;
+	return 0;
 }
 
 int enet_socket_send(ENetSocket socket, const ENetAddress *address, const ENetBuffer *buffers, size_t bufferCount) {
 
 	ERR_FAIL_COND_V(address == NULL, -1);
 
-	NetSocket *sock = (NetSocket *)socket;
+	ENetGodotSocket *s = (ENetGodotSocket *)socket;
 	IP_Address dest;
 	Error err;
 	size_t i = 0;
 
 	dest.set_ipv6(address->host);
 
-	// Create a single packet.
-	PoolVector<uint8_t> out;
-	PoolVector<uint8_t>::Write w;
 	int size = 0;
 	int pos = 0;
 	for (i = 0; i < bufferCount; i++) {
 		size += buffers[i].dataLength;
 	}
 
-	out.resize(size);
-	w = out.write();
-	for (i = 0; i < bufferCount; i++) {
-		memcpy(&w[pos], buffers[i].data, buffers[i].dataLength);
-		pos += buffers[i].dataLength;
-	}
+	if (size > ENET_PROTOCOL_MAXIMUM_MTU) {
+		// Too big to queue, keep the order by sending the queue first.
+		if (enet_socket_flush(socket) < 0) {
+			return -1;
+		}
 
-	int sent = 0;
-	err = sock->sendto((const uint8_t *)&w[0], size, sent, dest, address->port);
-	if (err != OK) {
+		// Create a single packet.
+		PoolVector<uint8_t> out;
+		PoolVector<uint8_t>::Write w;
 
-		if (err == ERR_BUSY) { // Blocking call
-			return 0;
+		out.resize(size);
+		w = out.write();
+		for (i = 0; i < bufferCount; i++) {
+			memcpy(&w[pos], buffers[i].data, buffers[i].dataLength);
+			pos += buffers[i].dataLength;
 		}
 
-		WARN_PRINT("Sending failed!");
+		int sent = 0;
+		err = s->sock->sendto((const uint8_t *)&w[0], size, sent, dest, address->port);
+		if (err != OK) {
+
+			if (err == ERR_BUSY) { // Blocking call
+				return 0;
+			}
+
+			WARN_PRINT("Sending failed!");
+			return -1;
+		}
+
+		return sent;
+	}
+
+	if (s->send_count == ENET_GODOT_BATCH_SIZE && enet_socket_flush(socket) < 0) {
 		return -1;
 	}
 
-	return sent;
+	NetSocket::Datagram &d = s->send[s->send_count++];
+	for (i = 0; i < bufferCount; i++) {
+		memcpy(&d.buffer[pos], buffers[i].data, buffers[i].dataLength);
+		pos += buffers[i].dataLength;
+	}
+	d.len = size;
+	d.ip = dest;
+	d.port = address->port;
+
+	return size;
 }
 
 int enet_socket_receive(ENetSocket socket, ENetAddress *address, ENetBuffer *buffers, size_t bufferCount) {
 
 	ERR_FAIL_COND_V(bufferCount != 1, -1);
 
-	NetSocket *sock = (NetSocket *)socket;
+	ENetGodotSocket *s = (ENetGodotSocket *)socket;
 
-	Error ret = sock->poll(NetSocket::POLL_TYPE_IN, 0);
+	if (s->recv_pos == s->recv_count) {
 
-	if (ret == ERR_BUSY)
-		return 0;
+		s->recv_pos = 0;
+		s->recv_count = 0;
+		for (int i = 0; i < ENET_GODOT_BATCH_SIZE; i++) {
+			s->recv[i].len = ENET_PROTOCOL_MAXIMUM_MTU;
+		}
 
-	if (ret != OK)
-		return -1;
+		int received = 0;
+		Error err = s->sock->recvfrom_batch(s->recv, ENET_GODOT_BATCH_SIZE, received);
+		if (err == ERR_BUSY)
+			return 0;
 
-	int read;
-	IP_Address ip;
+		if (err != OK)
+			return -1;
 
-	Error err = sock->recvfrom((uint8_t *)buffers[0].data, buffers[0].dataLength, read, ip, address->port);
-	if (err == ERR_BUSY)
-		return 0;
+		s->recv_count = received;
+	}
 
-	if (err != OK)
-		return -1;
+	const NetSocket::Datagram &d = s->recv[s->recv_pos++];
 
-	enet_address_set_ip(address, ip.get_ipv6(), 16);
+	int read = MIN((size_t)d.len, buffers[0].dataLength);
+	memcpy(buffers[0].data, d.buffer, read);
+	address->port = d.port;
+	enet_address_set_ip(address, d.ip.get_ipv6(), 16);
 
 	return read;
 }
@@ -215,7 +300,7 @@ int enet_socket_listen(ENetSocket socket, int backlog) {
 
 int enet_socket_set_option(ENetSocket socket, ENetSocketOption option, int value) {
 
-	NetSocket *sock = (NetSocket *)socket;
+	NetSocket *sock = ((ENetGodotSocket *)socket)->sock;
 
 	switch (option) {
 		case ENET_SOCKOPT_NONBLOCK: {
@@ -1631,7 +1631,10 @@ enet_protocol_send_outgoing_commands (ENetHost * host, ENetEvent * event, int ch
             enet_protocol_check_timeouts (host, currentPeer, event) == 1)
         {
             if (event != NULL && event -> type != ENET_EVENT_TYPE_NONE)
+            {
+              enet_socket_flush (host -> socket);
               return 1;
+            }
             else
               continue;
         }
@@ -1742,6 +1745,9 @@ enet_protocol_send_outgoing_commands (ENetHost * host, ENetEvent * event, int ch
         host -> totalSentPackets ++;
     }
    
+    if (enet_socket_flush (host -> socket) < 0)
+      return -1;
+
     return 0;
 }
 